@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+
+# This script generates the register-backed ChipObject mocks used to build the
+# athena HAL on desktop Linux.
+#
+# Each ChipObject class in ni-libraries gets a mock implementing every register
+# accessor with an in-memory register. Every access calls the mock FPGA's
+# register hooks, which apply the configured register latency.
+#
+# This script takes no arguments and should be invoked from either the gen
+# directory or the root directory of the project.
+
+import os
+import re
+import subprocess
+import sys
+
+# Classes whose create() is written by hand in MockFPGA.cpp because their
+# registers have behavior beyond storing values
+HANDWRITTEN = {"tAlarm", "tGlobal"}
+
+# Registers that do not read 0 after reset. The loop timings are 40 ticks of
+# the 40 MHz FPGA clock, which the HAL waits for and checks at startup.
+RESET_VALUES = {
+    ("tAI", "LoopTiming"): "40",
+    ("tPWM", "LoopTiming"): "40",
+}
+
+
+# Check that the current directory is part of a Git repository
+def inGitRepo(directory):
+    ret = subprocess.run(["git", "rev-parse"], stderr=subprocess.DEVNULL)
+    return ret.returncode == 0
+
+
+def writeLicense(out, year):
+    out.write("/*" + "-" * 76 + "*/\n")
+    line = "/* Copyright (c) " + year + " FIRST. All Rights Reserved."
+    out.write(line + " " * (78 - len(line)) + "*/\n")
+    out.write("""\
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*""" + "-" * 76 + "*/\n")
+    out.write("""
+// This file is generated by gen/hal_mockfpga.py. Do not edit.
+""")
+
+
+class Register:
+    def __init__(self, name):
+        self.name = name
+        self.elements = 0
+        self.type = None
+        self.methods = []
+
+
+class ChipObject:
+    def __init__(self, name, text):
+        self.name = name
+        self.mock = "Mock" + name[1:]
+        self.indexed = re.search(r"static \w+\* create\(unsigned char sys_index",
+                                 text) is not None
+        self.systems = int(re.search(r"kNumSystems = (\d+)", text).group(1))
+        self.unions = set(re.findall(r"typedef\s+union\s*\{.*?\}\s*(t\w+);",
+                                     text, re.S))
+        self.registers = {}
+        for body, name in re.findall(
+                r"typedef enum\s*\{([^}]*)\}\s*t(\w+)_IfaceConstants;", text):
+            reg = Register(name)
+            count = re.search(r"kNum\w+Elements = (\d+)", body)
+            if count:
+                reg.elements = int(count.group(1))
+            self.registers[name] = reg
+        for ret, method, params in re.findall(
+                r"virtual\s+([\w\s\*]+?)\s*\b(\w+)\(([^)]*)\)\s*=\s*0;", text):
+            if method in ("getSystemInterface", "getSystemIndex"):
+                continue
+            self.addMethod(ret.strip(), method, params.strip())
+
+    def addMethod(self, ret, method, params):
+        prefix = re.match(r"(read|write|strobe)", method).group(1)
+        rest = method[len(prefix):]
+        reg = max((r for r in self.registers.values()
+                   if rest == r.name or rest.startswith(r.name + "_")),
+                  key=lambda r: len(r.name))
+        field = rest[len(reg.name) + 1:] or None
+        indexed = params.startswith("unsigned char bitfield_index")
+        if field is None and prefix != "strobe":
+            valueType = ret if prefix == "read" else \
+                params.split(",")[-2].strip().rsplit(" ", 1)[0]
+            reg.type = valueType
+        reg.methods.append((prefix, ret, method, params, field, indexed))
+
+    def storageType(self, reg):
+        if "t" + reg.name in self.unions:
+            return "t" + reg.name
+        return reg.type
+
+
+def generateMethod(obj, reg, prefix, ret, method, params, field, indexed):
+    out = "  " + ret + " " + method + "(" + params + ") override {\n"
+    if prefix == "strobe":
+        out += "    hal::mockfpga::RegisterWrite(m_mutex);\n  }\n"
+        return out
+    target = "m_" + reg.name
+    if indexed:
+        out += "    if (bitfield_index >= " + str(reg.elements) + ") {\n"
+        out += "      *status = NiFpga_Status_InvalidParameter;\n"
+        out += "      return" + (" {}" if prefix == "read" else "") + ";\n"
+        out += "    }\n"
+        target += "[bitfield_index]"
+    if field:
+        target += "." + field
+    if prefix == "read":
+        out += "    auto lock = hal::mockfpga::RegisterRead(m_mutex);\n"
+        out += "    return " + target + ";\n"
+    else:
+        out += "    auto lock = hal::mockfpga::RegisterWrite(m_mutex);\n"
+        out += "    " + target + " = value;\n"
+    out += "  }\n"
+    return out
+
+
+def generateClass(obj):
+    out = "class " + obj.mock + " : public " + obj.name + " {\n"
+    out += " public:\n"
+    if obj.indexed:
+        out += "  explicit " + obj.mock + \
+            "(unsigned char index) : m_index(index) {}\n\n"
+        out += "  unsigned char getSystemIndex() override { return m_index; }\n"
+    out += "  tSystemInterface* getSystemInterface() override {\n"
+    out += "    return hal::mockfpga::GetSystemInterface();\n"
+    out += "  }\n"
+    for reg in obj.registers.values():
+        for method in reg.methods:
+            out += "\n" + generateMethod(obj, reg, *method)
+    out += "\n protected:\n"
+    out += "  wpi::mutex m_mutex;\n"
+    if obj.indexed:
+        out += "  unsigned char m_index;\n"
+    for reg in obj.registers.values():
+        if not any(m[0] != "strobe" for m in reg.methods):
+            continue
+        out += "  " + obj.storageType(reg) + " m_" + reg.name
+        if any(m[5] for m in reg.methods):
+            out += "[" + str(reg.elements) + "]"
+        out += "{" + RESET_VALUES.get((obj.name, reg.name), "") + "};\n"
+    out += "};\n"
+    return out
+
+
+def generateCreate(obj):
+    if obj.indexed:
+        out = obj.name + "* " + obj.name + \
+            "::create(unsigned char sys_index, tRioStatusCode* status) {\n"
+        out += "  if (sys_index >= " + str(obj.systems) + ") {\n"
+        out += "    *status = NiFpga_Status_InvalidParameter;\n"
+        out += "    return nullptr;\n"
+        out += "  }\n"
+        out += "  return new " + obj.mock + "(sys_index);\n"
+    else:
+        out = obj.name + "* " + obj.name + \
+            "::create(tRioStatusCode* status) {\n"
+        out += "  return new " + obj.mock + ";\n"
+    out += "}\n"
+    return out
+
+
+def main():
+    if not inGitRepo("."):
+        print("Error: not invoked within a Git repository", file=sys.stderr)
+        sys.exit(1)
+
+    # Handle running in either the root or gen directories
+    configPath = "."
+    if os.getcwd().rpartition(os.sep)[2] == "gen":
+        configPath = ".."
+
+    headerPath = configPath + \
+        "/ni-libraries/include/FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace"
+    outputPath = configPath + "/hal/src/mockfpga/native/cpp"
+
+    objects = []
+    for fileName in sorted(os.listdir(headerPath)):
+        match = re.match(r"(t\w+)\.h$", fileName)
+        if not match:
+            continue
+        with open(headerPath + "/" + fileName, "r") as header:
+            objects.append(ChipObject(match.group(1), header.read()))
+
+    with open(outputPath + "/MockChipObjects.h", "w") as out:
+        writeLicense(out, "2018")
+        out.write("""
+#pragma once
+
+#include <support/mutex.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#pragma GCC diagnostic ignored "-Wignored-qualifiers"
+
+#include <FRC_FPGA_ChipObject/RoboRIO_FRC_ChipObject_Aliases.h>
+#include <FRC_FPGA_ChipObject/tDMAManager.h>
+#include <FRC_FPGA_ChipObject/tInterruptManager.h>
+#include <FRC_FPGA_ChipObject/tSystem.h>
+#include <FRC_FPGA_ChipObject/tSystemInterface.h>
+""")
+        for obj in objects:
+            out.write("#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/" +
+                      obj.name + ".h>\n")
+        out.write("""
+#pragma GCC diagnostic pop
+
+#include "MockFPGAInternal.h"
+
+namespace hal {
+namespace mockfpga {
+
+using namespace nFPGA;
+using namespace nFPGA::nRoboRIO_FPGANamespace;
+""")
+        for obj in objects:
+            out.write("\n" + generateClass(obj))
+        out.write("""
+}  // namespace mockfpga
+}  // namespace hal
+""")
+
+    with open(outputPath + "/MockChipObjects.cpp", "w") as out:
+        writeLicense(out, "2018")
+        out.write("""
+#include "MockChipObjects.h"
+
+using namespace hal::mockfpga;
+
+namespace nFPGA {
+namespace nRoboRIO_FPGANamespace {
+""")
+        for obj in objects:
+            if obj.name not in HANDWRITTEN:
+                out.write("\n" + generateCreate(obj))
+        out.write("""
+}  // namespace nRoboRIO_FPGANamespace
+}  // namespace nFPGA
+""")
+
+
+if __name__ == "__main__":
+    main()
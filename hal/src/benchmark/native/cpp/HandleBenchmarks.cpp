@@ -0,0 +1,148 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "HAL/Types.h"
+#include "HAL/handles/DigitalHandleResource.h"
+#include "HAL/handles/IndexedHandleResource.h"
+#include "HAL/handles/LimitedHandleResource.h"
+#include "HAL/handles/UnlimitedHandleResource.h"
+#include "HALBenchmark.h"
+
+using namespace hal;
+using namespace hal::benchmark;
+
+namespace {
+struct Payload {
+  int value = 0;
+};
+
+constexpr int16_t kSize = 8;
+constexpr int kUnlimitedEntries = 16;
+}  // namespace
+
+// Each resource is measured with every thread reading the same handle, which
+// contends on one handle's lock, and with each thread reading its own
+template <typename Get>
+static void MeasureGet(const Options& options, llvm::StringRef name,
+                       const std::vector<HAL_Handle>& handles, Get get) {
+  Measure(options, name + " same", [&](int, int64_t) {
+    return get(handles[0]);
+  });
+  Measure(options, name + " distinct", [&](int thread, int64_t) {
+    return get(handles[thread % handles.size()]);
+  });
+}
+
+static void RunLimited(const Options& options) {
+  LimitedHandleResource<HAL_Handle, Payload, kSize, HAL_HandleEnum::Vendor>
+      resource;
+  std::vector<HAL_Handle> handles;
+  for (int16_t i = 0; i < kSize; i++) handles.push_back(resource.Allocate());
+
+  MeasureGet(
+      options, "LimitedHandleResource::Get", handles,
+      [&](HAL_Handle handle) { return resource.Get(handle).get(); });
+  MeasureGet(
+      options, "LimitedHandleResource::GetBorrowed", handles,
+      [&](HAL_Handle handle) { return resource.GetBorrowed(handle).get(); });
+}
+
+static void RunIndexed(const Options& options) {
+  IndexedHandleResource<HAL_Handle, Payload, kSize, HAL_HandleEnum::Vendor>
+      resource;
+  std::vector<HAL_Handle> handles;
+  for (int16_t i = 0; i < kSize; i++) {
+    int32_t status = 0;
+    handles.push_back(resource.Allocate(i, &status));
+  }
+
+  MeasureGet(
+      options, "IndexedHandleResource::Get", handles,
+      [&](HAL_Handle handle) { return resource.Get(handle).get(); });
+  MeasureGet(
+      options, "IndexedHandleResource::GetBorrowed", handles,
+      [&](HAL_Handle handle) { return resource.GetBorrowed(handle).get(); });
+}
+
+static void RunDigital(const Options& options) {
+  DigitalHandleResource<HAL_Handle, Payload, kSize> resource;
+  std::vector<HAL_Handle> handles;
+  for (int16_t i = 0; i < kSize; i++) {
+    int32_t status = 0;
+    handles.push_back(resource.Allocate(i, HAL_HandleEnum::DIO, &status));
+  }
+
+  MeasureGet(
+      options, "DigitalHandleResource::Get", handles, [&](HAL_Handle handle) {
+        return resource.Get(handle, HAL_HandleEnum::DIO).get();
+      });
+  MeasureGet(
+      options, "DigitalHandleResource::GetBorrowed", handles,
+      [&](HAL_Handle handle) {
+        return resource.GetBorrowed(handle, HAL_HandleEnum::DIO).get();
+      });
+}
+
+static void RunUnlimited(const Options& options) {
+  UnlimitedHandleResource<HAL_Handle, Payload, HAL_HandleEnum::Vendor>
+      resource;
+  std::vector<HAL_Handle> handles;
+  for (int i = 0; i < kUnlimitedEntries; i++) {
+    handles.push_back(resource.Allocate(std::make_shared<Payload>()));
+  }
+
+  MeasureGet(
+      options, "UnlimitedHandleResource::Get", handles,
+      [&](HAL_Handle handle) { return resource.Get(handle).get(); });
+
+  // One structure per thread, so the measurement is not of make_shared
+  std::vector<std::shared_ptr<Payload>> payloads;
+  int maxThreads = 1;
+  for (int threads : options.threads) {
+    maxThreads = std::max(maxThreads, threads);
+  }
+  for (int i = 0; i < maxThreads; i++) {
+    payloads.push_back(std::make_shared<Payload>());
+  }
+  Measure(options, "UnlimitedHandleResource::Allocate+Free",
+          [&](int thread, int64_t) {
+            HAL_Handle handle = resource.Allocate(payloads[thread]);
+            resource.Free(handle);
+            return handle;
+          });
+
+  Measure(options, "UnlimitedHandleResource::ForEach", [&](int, int64_t) {
+    int sum = 0;
+    resource.ForEach([&](HAL_Handle, Payload* payload) {
+      sum += payload->value + 1;
+    });
+    return sum;
+  });
+  Measure(options, "UnlimitedHandleResource::ForEachSnapshot",
+          [&](int, int64_t) {
+            int sum = 0;
+            resource.ForEachSnapshot([&](HAL_Handle, Payload* payload) {
+              sum += payload->value + 1;
+            });
+            return sum;
+          });
+}
+
+namespace hal {
+namespace benchmark {
+void RunHandleBenchmarks(const Options& options) {
+  RunLimited(options);
+  RunIndexed(options);
+  RunDigital(options);
+  RunUnlimited(options);
+}
+}  // namespace benchmark
+}  // namespace hal
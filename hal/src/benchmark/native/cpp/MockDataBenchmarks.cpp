@@ -0,0 +1,104 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HALBenchmark.h"
+
+#if !defined(__FRC_ROBORIO__) && !defined(HAL_MOCK_FPGA)
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include <llvm/SmallString.h>
+
+#include "HAL/Ports.h"
+#include "MockData/DIOData.h"
+#include "MockData/PWMData.h"
+
+using namespace hal::benchmark;
+
+namespace {
+constexpr int kMaxChannels = 32;
+
+// Callbacks count their calls per channel; each thread uses its own channel
+std::atomic<int64_t> callbackCounts[kMaxChannels];
+
+void CountCallback(const char*, void* param, const HAL_Value*) {
+  static_cast<std::atomic<int64_t>*>(param)->fetch_add(
+      1, std::memory_order_relaxed);
+}
+}  // namespace
+
+static void RunPWM(const Options& options, int callbacksPerChannel) {
+  int channels = std::min(HAL_GetNumPWMChannels(), kMaxChannels);
+  std::vector<std::pair<int32_t, int32_t>> uids;
+  for (int32_t i = 0; i < channels; i++) {
+    for (int c = 0; c < callbacksPerChannel; c++) {
+      uids.emplace_back(i, HALSIM_RegisterPWMSpeedCallback(
+                               i, CountCallback, &callbackCounts[i], false));
+    }
+  }
+
+  llvm::SmallString<64> name;
+  llvm::raw_svector_ostream os{name};
+  os << "HALSIM_SetPWMSpeed " << callbacksPerChannel << " callbacks";
+  // Alternate the value, as setting the same value does not notify
+  Measure(options, os.str(), [=](int thread, int64_t i) {
+    HALSIM_SetPWMSpeed(thread % channels, (i & 1) ? 0.5 : -0.5);
+    return i;
+  });
+
+  for (const auto& uid : uids) {
+    HALSIM_CancelPWMSpeedCallback(uid.first, uid.second);
+  }
+  for (int32_t i = 0; i < channels; i++) HALSIM_ResetPWMData(i);
+}
+
+static void RunDIO(const Options& options) {
+  int channels = std::min(HAL_GetNumDigitalChannels(), kMaxChannels);
+  std::vector<int32_t> uids;
+  for (int32_t i = 0; i < channels; i++) {
+    uids.push_back(HALSIM_RegisterDIOValueCallback(i, CountCallback,
+                                                   &callbackCounts[i], false));
+  }
+
+  Measure(options, "HALSIM_SetDIOValue 1 callback", [=](int thread, int64_t i) {
+    HALSIM_SetDIOValue(thread % channels, i & 1);
+    return i;
+  });
+  Measure(options, "HALSIM_GetDIOValue", [=](int thread, int64_t) {
+    return HALSIM_GetDIOValue(thread % channels);
+  });
+
+  for (int32_t i = 0; i < channels; i++) {
+    HALSIM_CancelDIOValueCallback(i, uids[i]);
+    HALSIM_ResetDIOData(i);
+  }
+}
+
+namespace hal {
+namespace benchmark {
+void RunMockDataBenchmarks(const Options& options) {
+  RunPWM(options, 0);
+  RunPWM(options, 1);
+  RunPWM(options, 4);
+  RunDIO(options);
+}
+}  // namespace benchmark
+}  // namespace hal
+
+#else
+
+namespace hal {
+namespace benchmark {
+// The MockData layer only exists in the simulator HAL
+void RunMockDataBenchmarks(const Options&) {}
+}  // namespace benchmark
+}  // namespace hal
+
+#endif
@@ -0,0 +1,37 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <thread>
+
+#include <llvm/raw_ostream.h>
+
+#include "HAL/HAL.h"
+#include "HALBenchmark.h"
+
+// Measures HAL handle resource and MockData latency and scaling with the
+// number of threads. Usage: halBenchmark [filter] [iterations]
+int main(int argc, char** argv) {
+  // On the roboRIO this replaces the running robot program
+  if (!HAL_Initialize(500, 0)) {
+    llvm::errs() << "FATAL ERROR: HAL could not be initialized\n";
+    return -1;
+  }
+
+  hal::benchmark::Options options;
+  if (argc > 1) options.filter = argv[1];
+  if (argc > 2) options.iterations = std::atoll(argv[2]);
+  int cores = std::thread::hardware_concurrency();
+  for (int threads = 1; threads <= std::max(cores, 2); threads *= 2) {
+    options.threads.push_back(threads);
+  }
+
+  hal::benchmark::RunHandleBenchmarks(options);
+  hal::benchmark::RunMockDataBenchmarks(options);
+  return 0;
+}
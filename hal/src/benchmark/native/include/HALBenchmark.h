@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <llvm/Format.h>
+#include <llvm/Twine.h>
+#include <llvm/raw_ostream.h>
+
+namespace hal {
+namespace benchmark {
+
+struct Options {
+  // Only benchmarks whose name contains the filter run
+  std::string filter;
+  int64_t iterations = 1000000;
+  // Thread counts to measure scaling at
+  std::vector<int> threads;
+};
+
+struct Result {
+  int threads = 0;
+  // Wall time for one operation on one thread
+  double nsPerOp = 0;
+  // Operations per second summed over all threads
+  double opsPerSecond = 0;
+};
+
+template <typename T>
+uintptr_t ToSink(T* value) {
+  return reinterpret_cast<uintptr_t>(value);
+}
+
+template <typename T>
+uintptr_t ToSink(T value) {
+  return static_cast<uintptr_t>(value);
+}
+
+/**
+ * Runs an operation iterations times on each of threads threads at once and
+ * measures the wall time, from when every thread is ready to when the last
+ * one finishes.
+ *
+ * The operation is called as op(thread, iteration) and returns a value that
+ * is folded into a per-thread sink, so the compiler cannot drop the work.
+ */
+template <typename Op>
+Result Run(int threads, int64_t iterations, Op op) {
+  std::atomic<int> ready{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> workers;
+  std::vector<uintptr_t> sinks(threads);
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back([&, t] {
+      ready++;
+      while (!go) std::this_thread::yield();
+      uintptr_t sink = 0;
+      for (int64_t i = 0; i < iterations; i++) {
+        sink ^= ToSink(op(t, i));
+      }
+      sinks[t] = sink;
+    });
+  }
+  while (ready < threads) std::this_thread::yield();
+  auto start = std::chrono::steady_clock::now();
+  go = true;
+  for (auto& worker : workers) worker.join();
+  auto end = std::chrono::steady_clock::now();
+
+  volatile uintptr_t sink = 0;
+  for (auto value : sinks) sink = sink ^ value;
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  Result result;
+  result.threads = threads;
+  result.nsPerOp = seconds * 1.0e9 / iterations;
+  result.opsPerSecond = threads * iterations / seconds;
+  return result;
+}
+
+inline bool Matches(const Options& options, const std::string& name) {
+  return options.filter.empty() ||
+         name.find(options.filter) != std::string::npos;
+}
+
+/**
+ * Runs a benchmark at each thread count in the options and prints one line
+ * per count.
+ */
+template <typename Op>
+void Measure(const Options& options, const llvm::Twine& twine, Op op) {
+  std::string name = twine.str();
+  if (!Matches(options, name)) return;
+  for (int threads : options.threads) {
+    Result result = Run(threads, options.iterations, op);
+    llvm::outs() << llvm::format("%-44s", name.c_str()) << " threads "
+                 << result.threads << ": "
+                 << llvm::format("%8.1f", result.nsPerOp) << " ns/op, "
+                 << llvm::format("%8.2f", result.opsPerSecond * 1.0e-6)
+                 << " Mops/s\n";
+  }
+}
+
+void RunHandleBenchmarks(const Options& options);
+void RunMockDataBenchmarks(const Options& options);
+
+}  // namespace benchmark
+}  // namespace hal
@@ -9,11 +9,20 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <support/mutex.h>
 
 #include "HAL/ChipObject.h"
+#include "HAL/Errors.h"
 #include "HAL/HAL.h"
 
 using namespace hal;
@@ -28,8 +37,16 @@ static constexpr uint8_t kControlTxRx = 1;
 static constexpr uint8_t kControlStart = 2;
 static constexpr uint8_t kControlStop = 4;
 
+// The highest output data rate of the device, which it starts up in
+static constexpr auto kSamplePeriod = std::chrono::microseconds(1250);
+
+// Set in the status register when a new sample of all three axes is ready
+static constexpr uint8_t kStatus_ZYXDR = 0x08;
+
 static std::unique_ptr<tAccel> accel;
 static HAL_AccelerometerRange accelerometerRange;
+// Serializes bus transfers, which the sampler makes from its own thread
+static wpi::mutex accelerometerMutex;
 
 // Register addresses
 enum Register {
@@ -87,6 +104,7 @@ namespace hal {
 
 static void writeRegister(Register reg, uint8_t data);
 static uint8_t readRegister(Register reg);
+static void readRegisters(Register reg, uint8_t* data, int32_t count);
 
 /**
  * Initialize the accelerometer.
@@ -110,9 +128,16 @@ static void initializeAccelerometer() {
   }
 }
 
+static void waitForTransfer() {
+  int32_t status = 0;
+  uint64_t initialTime = HAL_GetFPGATime(&status);
+  while (accel->readSTAT(&status) & 1) {
+    if (HAL_GetFPGATime(&status) > initialTime + 1000) break;
+  }
+}
+
 static void writeRegister(Register reg, uint8_t data) {
   int32_t status = 0;
-  uint64_t initialTime;
 
   accel->writeADDR(kSendAddress, &status);
 
@@ -122,10 +147,7 @@ static void writeRegister(Register reg, uint8_t data) {
   accel->strobeGO(&status);
 
   // Execute and wait until it's done (up to a millisecond)
-  initialTime = HAL_GetFPGATime(&status);
-  while (accel->readSTAT(&status) & 1) {
-    if (HAL_GetFPGATime(&status) > initialTime + 1000) break;
-  }
+  waitForTransfer();
 
   // Send a stop transmit/receive message with the data
   accel->writeCNTL(kControlStop | kControlTxRx, &status);
@@ -133,15 +155,11 @@ static void writeRegister(Register reg, uint8_t data) {
   accel->strobeGO(&status);
 
   // Execute and wait until it's done (up to a millisecond)
-  initialTime = HAL_GetFPGATime(&status);
-  while (accel->readSTAT(&status) & 1) {
-    if (HAL_GetFPGATime(&status) > initialTime + 1000) break;
-  }
+  waitForTransfer();
 }
 
 static uint8_t readRegister(Register reg) {
   int32_t status = 0;
-  uint64_t initialTime;
 
   // Send a start transmit/receive message with the register address
   accel->writeADDR(kSendAddress, &status);
@@ -150,10 +168,7 @@ static uint8_t readRegister(Register reg) {
   accel->strobeGO(&status);
 
   // Execute and wait until it's done (up to a millisecond)
-  initialTime = HAL_GetFPGATime(&status);
-  while (accel->readSTAT(&status) & 1) {
-    if (HAL_GetFPGATime(&status) > initialTime + 1000) break;
-  }
+  waitForTransfer();
 
   // Receive a message with the data and stop
   accel->writeADDR(kReceiveAddress, &status);
@@ -161,14 +176,40 @@ static uint8_t readRegister(Register reg) {
   accel->strobeGO(&status);
 
   // Execute and wait until it's done (up to a millisecond)
-  initialTime = HAL_GetFPGATime(&status);
-  while (accel->readSTAT(&status) & 1) {
-    if (HAL_GetFPGATime(&status) > initialTime + 1000) break;
-  }
+  waitForTransfer();
 
   return accel->readDATI(&status);
 }
 
+/**
+ * Read consecutive registers in one transfer. The device moves to the next
+ * register after each byte, and latches the output registers for the length
+ * of a read, so all the axes come from the same sample.
+ */
+static void readRegisters(Register reg, uint8_t* data, int32_t count) {
+  int32_t status = 0;
+
+  // Send a start transmit/receive message with the first register address
+  accel->writeADDR(kSendAddress, &status);
+  accel->writeCNTL(kControlStart | kControlTxRx, &status);
+  accel->writeDATO(reg, &status);
+  accel->strobeGO(&status);
+  waitForTransfer();
+
+  // Receive a message per byte, restarting on the first and stopping after
+  // the last
+  accel->writeADDR(kReceiveAddress, &status);
+  for (int32_t i = 0; i < count; i++) {
+    uint8_t control = kControlTxRx;
+    if (i == 0) control |= kControlStart;
+    if (i == count - 1) control |= kControlStop;
+    accel->writeCNTL(control, &status);
+    accel->strobeGO(&status);
+    waitForTransfer();
+    data[i] = accel->readDATI(&status);
+  }
+}
+
 /**
  * Convert a 12-bit raw acceleration value into a scaled double in units of
  * 1 g-force, taking into account the accelerometer range.
@@ -192,6 +233,139 @@ static double unpackAxis(int16_t raw) {
   }
 }
 
+static double unpackAxis(const uint8_t* data) {
+  return unpackAxis((data[0] << 4) | (data[1] >> 4));
+}
+
+namespace {
+/**
+ * Reads the accelerometer at its output data rate from a background thread,
+ * into a ring of timestamped samples.
+ *
+ * A burst of the status and output registers takes most of the sample period
+ * on the 100 kbps bus, so samples come no faster than the device makes them;
+ * the status register tells whether a sample is new.
+ */
+class AccelerometerSampler {
+ public:
+  static AccelerometerSampler& GetInstance() {
+    static AccelerometerSampler instance;
+    return instance;
+  }
+
+  ~AccelerometerSampler();
+
+  void Start(int32_t bufferSize, int32_t* status);
+  void Stop();
+  int32_t Read(HAL_AccelerometerSample* samples, int32_t count,
+               int32_t* status);
+  int64_t GetOverflowCount(int32_t* status);
+
+ private:
+  void ThreadMain();
+
+  wpi::mutex m_configMutex;
+  std::atomic_bool m_active{false};
+  std::thread m_thread;
+
+  wpi::mutex m_mutex;
+  std::vector<HAL_AccelerometerSample> m_samples;
+  size_t m_next = 0;
+  size_t m_size = 0;
+  int64_t m_overflows = 0;
+};
+}  // namespace
+
+AccelerometerSampler::~AccelerometerSampler() { Stop(); }
+
+void AccelerometerSampler::Start(int32_t bufferSize, int32_t* status) {
+  if (bufferSize < 1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  std::lock_guard<wpi::mutex> configLock(m_configMutex);
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_samples.assign(bufferSize, HAL_AccelerometerSample{});
+    m_next = 0;
+    m_size = 0;
+    m_overflows = 0;
+  }
+  if (m_active) return;
+  m_active = true;
+  m_thread = std::thread(&AccelerometerSampler::ThreadMain, this);
+}
+
+void AccelerometerSampler::Stop() {
+  std::lock_guard<wpi::mutex> configLock(m_configMutex);
+  m_active = false;
+  if (m_thread.joinable()) m_thread.join();
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_samples.clear();
+  m_size = 0;
+}
+
+int32_t AccelerometerSampler::Read(HAL_AccelerometerSample* samples,
+                                   int32_t count, int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_samples.empty()) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+
+  size_t capacity = m_samples.size();
+  size_t read = std::min<size_t>(m_size, std::max(count, 0));
+  size_t first = m_next + capacity - m_size;
+  for (size_t i = 0; i < read; i++) {
+    samples[i] = m_samples[(first + i) % capacity];
+  }
+  m_size -= read;
+  return read;
+}
+
+int64_t AccelerometerSampler::GetOverflowCount(int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_samples.empty()) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  return m_overflows;
+}
+
+void AccelerometerSampler::ThreadMain() {
+  auto next = std::chrono::steady_clock::now();
+  while (m_active) {
+    next += kSamplePeriod;
+    std::this_thread::sleep_until(next);
+
+    uint8_t data[7];
+    HAL_AccelerometerSample sample;
+    {
+      std::lock_guard<wpi::mutex> lock(accelerometerMutex);
+      initializeAccelerometer();
+      readRegisters(kReg_Status, data, sizeof(data));
+      if (!(data[0] & kStatus_ZYXDR)) continue;
+      sample.x = unpackAxis(&data[1]);
+      sample.y = unpackAxis(&data[3]);
+      sample.z = unpackAxis(&data[5]);
+    }
+    int32_t status = 0;
+    sample.timeStamp = HAL_GetFPGATime(&status);
+
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    size_t capacity = m_samples.size();
+    if (capacity == 0) continue;
+    m_samples[m_next] = sample;
+    m_next = (m_next + 1) % capacity;
+    if (m_size < capacity) {
+      m_size++;
+    } else {
+      m_overflows++;
+    }
+  }
+}
+
 }  // namespace hal
 
 extern "C" {
@@ -201,6 +375,7 @@ extern "C" {
  * mode to change any configuration.
  */
 void HAL_SetAccelerometerActive(HAL_Bool active) {
+  std::lock_guard<wpi::mutex> lock(accelerometerMutex);
   initializeAccelerometer();
 
   uint8_t ctrlReg1 = readRegister(kReg_CtrlReg1);
@@ -213,6 +388,7 @@ void HAL_SetAccelerometerActive(HAL_Bool active) {
  * The accelerometer should be in standby mode when this is called.
  */
 void HAL_SetAccelerometerRange(HAL_AccelerometerRange range) {
+  std::lock_guard<wpi::mutex> lock(accelerometerMutex);
   initializeAccelerometer();
 
   accelerometerRange = range;
@@ -228,6 +404,7 @@ void HAL_SetAccelerometerRange(HAL_AccelerometerRange range) {
  * This is a floating point value in units of 1 g-force
  */
 double HAL_GetAccelerometerX(void) {
+  std::lock_guard<wpi::mutex> lock(accelerometerMutex);
   initializeAccelerometer();
 
   int32_t raw =
@@ -241,6 +418,7 @@ double HAL_GetAccelerometerX(void) {
  * This is a floating point value in units of 1 g-force
  */
 double HAL_GetAccelerometerY(void) {
+  std::lock_guard<wpi::mutex> lock(accelerometerMutex);
   initializeAccelerometer();
 
   int32_t raw =
@@ -254,6 +432,7 @@ double HAL_GetAccelerometerY(void) {
  * This is a floating point value in units of 1 g-force
  */
 double HAL_GetAccelerometerZ(void) {
+  std::lock_guard<wpi::mutex> lock(accelerometerMutex);
   initializeAccelerometer();
 
   int32_t raw =
@@ -261,4 +440,55 @@ double HAL_GetAccelerometerZ(void) {
   return unpackAxis(raw);
 }
 
+/**
+ * Get the acceleration along all three axes, read together in one transfer
+ *
+ * These are floating point values in units of 1 g-force
+ */
+void HAL_GetAccelerometerXYZ(double* x, double* y, double* z) {
+  std::lock_guard<wpi::mutex> lock(accelerometerMutex);
+  initializeAccelerometer();
+
+  uint8_t data[6];
+  readRegisters(kReg_OutXMSB, data, sizeof(data));
+  *x = unpackAxis(&data[0]);
+  *y = unpackAxis(&data[2]);
+  *z = unpackAxis(&data[4]);
+}
+
+/**
+ * Start reading the accelerometer from a background thread at its output data
+ * rate of 800 Hz, into a ring buffer. Calling this while sampling discards the
+ * buffered samples and resizes the buffer.
+ *
+ * @param bufferSize The number of samples kept between reads; when it fills,
+ *                   the oldest samples are overwritten.
+ */
+void HAL_StartAccelerometerSampler(int32_t bufferSize, int32_t* status) {
+  AccelerometerSampler::GetInstance().Start(bufferSize, status);
+}
+
+void HAL_StopAccelerometerSampler(int32_t* status) {
+  AccelerometerSampler::GetInstance().Stop();
+}
+
+/**
+ * Read and remove the buffered samples, oldest first.
+ *
+ * @param samples Filled with the samples.
+ * @param count   Size of samples.
+ * @return The number of samples read.
+ */
+int32_t HAL_ReadAccelerometerSamples(HAL_AccelerometerSample* samples,
+                                     int32_t count, int32_t* status) {
+  return AccelerometerSampler::GetInstance().Read(samples, count, status);
+}
+
+/**
+ * Return the number of samples overwritten before they were read.
+ */
+int64_t HAL_GetAccelerometerSamplerOverflowCount(int32_t* status) {
+  return AccelerometerSampler::GetInstance().GetOverflowCount(status);
+}
+
 }  // extern "C"
@@ -12,6 +12,8 @@
 #include "AnalogInternal.h"
 #include "HAL/AnalogAccumulator.h"
 #include "HAL/AnalogInput.h"
+#include "HAL/HAL.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/handles/IndexedHandleResource.h"
 
 namespace {
@@ -252,4 +254,55 @@ int32_t HAL_GetAnalogGyroCenter(HAL_GyroHandle handle, int32_t* status) {
   return gyro->center;
 }
 
+/**
+ * Read the accumulated value, count, angle and rate of the gyro at once.
+ *
+ * The value and count come from one read of the accumulator output register,
+ * and the angle is scaled from them, so they always agree. The rate is the
+ * average value read right after the accumulator, within a sample of it, and
+ * the timestamp is the FPGA time of those reads. The handles are looked up
+ * and the scaling registers are read once for the whole snapshot.
+ */
+void HAL_GetAnalogGyroSnapshot(HAL_GyroHandle handle,
+                               HAL_AnalogGyroSnapshot* snapshot,
+                               int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterAnalog);
+  auto gyro = analogGyroHandles->Get(handle);
+  if (gyro == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto port = analogInputHandles->Get(gyro->handle);
+  if (port == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (port->accumulator == nullptr) {
+    *status = NULL_PARAMETER;
+    return;
+  }
+
+  tAccumulator::tOutput output = port->accumulator->readOutput(status);
+  int32_t average = HAL_GetAnalogAverageValue(gyro->handle, status);
+  snapshot->timestamp = HAL_GetFPGATime(status);
+  if (*status != 0) return;
+
+  double lsbWeight = port->lsbWeight * 1e-9;
+  int32_t averageBits = HAL_GetAnalogAverageBits(gyro->handle, status);
+  int32_t oversampleBits = HAL_GetAnalogOversampleBits(gyro->handle, status);
+  double sampleRate = HAL_GetAnalogSampleRate(status);
+
+  snapshot->value = output.Value;
+  snapshot->count = output.Count;
+  int64_t value =
+      output.Value -
+      static_cast<int64_t>(static_cast<double>(output.Count) * gyro->offset);
+  snapshot->angle = value * lsbWeight *
+                    static_cast<double>(1 << averageBits) /
+                    (sampleRate * gyro->voltsPerDegreePerSecond);
+  snapshot->rate =
+      (average - (static_cast<double>(gyro->center) + gyro->offset)) *
+      lsbWeight / ((1 << oversampleBits) * gyro->voltsPerDegreePerSecond);
+}
+
 }  // extern "C"
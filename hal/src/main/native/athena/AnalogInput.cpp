@@ -7,13 +7,19 @@
 
 #include "HAL/AnalogInput.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 #include <FRC_NetworkCommunication/AICalibration.h>
 #include <support/mutex.h>
 
 #include "AnalogInternal.h"
 #include "HAL/AnalogAccumulator.h"
 #include "HAL/HAL.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/handles/HandlesInternal.h"
+#include "IORecordingInternal.h"
 #include "PortsInternal.h"
 
 namespace hal {
@@ -24,6 +30,103 @@ void InitializeAnalogInput() {}
 
 using namespace hal;
 
+namespace {
+/**
+ * Keeps a copy of every channel's raw and averaged values, refreshed from a
+ * background thread, so reads while it runs are plain atomic loads instead
+ * of a select, strobe and read through the shared register window.
+ */
+class AnalogMirror {
+ public:
+  static AnalogMirror& GetInstance() {
+    static AnalogMirror instance;
+    return instance;
+  }
+
+  ~AnalogMirror() { Stop(); }
+
+  void Start(double period, int32_t* status);
+  void Stop();
+  bool IsRunning() const { return m_running; }
+
+  int32_t GetValue(uint8_t channel) const { return m_values[channel]; }
+  int32_t GetAverageValue(uint8_t channel) const {
+    return m_averageValues[channel];
+  }
+
+ private:
+  void Refresh(int32_t* status);
+  void ThreadMain();
+
+  wpi::mutex m_configMutex;
+  std::atomic_bool m_active{false};
+  // Set once the values have been read at least once
+  std::atomic_bool m_running{false};
+  // Nanoseconds; Start() may change it while the thread runs
+  std::atomic<int64_t> m_period{0};
+  std::thread m_thread;
+
+  std::atomic<int32_t> m_values[kNumAnalogInputs];
+  std::atomic<int32_t> m_averageValues[kNumAnalogInputs];
+};
+}  // namespace
+
+void AnalogMirror::Start(double period, int32_t* status) {
+  if (period <= 0.0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  std::lock_guard<wpi::mutex> configLock(m_configMutex);
+  m_period = static_cast<int64_t>(period * 1.0e9);
+  if (m_active) return;
+  Refresh(status);
+  if (*status != 0) return;
+  m_active = true;
+  m_running = true;
+  m_thread = std::thread(&AnalogMirror::ThreadMain, this);
+}
+
+void AnalogMirror::Stop() {
+  std::lock_guard<wpi::mutex> configLock(m_configMutex);
+  // Reads go back to the register window before the values go stale
+  m_running = false;
+  m_active = false;
+  if (m_thread.joinable()) m_thread.join();
+}
+
+// Read every channel, holding the register window once
+void AnalogMirror::Refresh(int32_t* status) {
+  tAI::tReadSelect readSelect;
+  std::lock_guard<wpi::mutex> lock(analogRegisterWindowMutex);
+  for (uint8_t channel = 0; channel < kNumAnalogInputs; channel++) {
+    readSelect.Channel = channel;
+    readSelect.Averaged = false;
+    analogInputSystem->writeReadSelect(readSelect, status);
+    analogInputSystem->strobeLatchOutput(status);
+    m_values[channel].store(
+        static_cast<int16_t>(analogInputSystem->readOutput(status)),
+        std::memory_order_relaxed);
+
+    readSelect.Averaged = true;
+    analogInputSystem->writeReadSelect(readSelect, status);
+    analogInputSystem->strobeLatchOutput(status);
+    m_averageValues[channel].store(
+        static_cast<int32_t>(analogInputSystem->readOutput(status)),
+        std::memory_order_relaxed);
+  }
+}
+
+void AnalogMirror::ThreadMain() {
+  auto next = std::chrono::steady_clock::now();
+  while (m_active) {
+    next += std::chrono::nanoseconds(m_period.load());
+    std::this_thread::sleep_until(next);
+    int32_t status = 0;
+    Refresh(&status);
+  }
+}
+
 extern "C" {
 
 /**
@@ -60,6 +163,10 @@ HAL_AnalogInputHandle HAL_InitializeAnalogInputPort(HAL_PortHandle portHandle,
   } else {
     analog_port->accumulator = nullptr;
   }
+  analog_port->lsbWeight = FRC_NetworkCommunication_nAICalibration_getLSBWeight(
+      0, channel, status);  // XXX: aiSystemIndex == 0?
+  analog_port->offset = FRC_NetworkCommunication_nAICalibration_getOffset(
+      0, channel, status);  // XXX: aiSystemIndex == 0?
 
   // Set default configuration
   analogInputSystem->writeScanList(channel, channel, status);
@@ -73,6 +180,8 @@ HAL_AnalogInputHandle HAL_InitializeAnalogInputPort(HAL_PortHandle portHandle,
  */
 void HAL_FreeAnalogInputPort(HAL_AnalogInputHandle analogPortHandle) {
   // no status, so no need to check for a proper free.
+  int32_t status = 0;
+  HAL_StopAnalogStream(analogPortHandle, &status);
   analogInputHandles->Free(analogPortHandle);
 }
 
@@ -225,20 +334,32 @@ int32_t HAL_GetAnalogOversampleBits(HAL_AnalogInputHandle analogPortHandle,
  */
 int32_t HAL_GetAnalogValue(HAL_AnalogInputHandle analogPortHandle,
                            int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterAnalog);
   auto port = analogInputHandles->Get(analogPortHandle);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
 
-  tAI::tReadSelect readSelect;
-  readSelect.Channel = port->channel;
-  readSelect.Averaged = false;
-
-  std::lock_guard<wpi::mutex> lock(analogRegisterWindowMutex);
-  analogInputSystem->writeReadSelect(readSelect, status);
-  analogInputSystem->strobeLatchOutput(status);
-  return static_cast<int16_t>(analogInputSystem->readOutput(status));
+  int32_t value;
+  auto& mirror = AnalogMirror::GetInstance();
+  if (mirror.IsRunning()) {
+    value = mirror.GetValue(port->channel);
+  } else {
+    tAI::tReadSelect readSelect;
+    readSelect.Channel = port->channel;
+    readSelect.Averaged = false;
+
+    std::lock_guard<wpi::mutex> lock(analogRegisterWindowMutex);
+    analogInputSystem->writeReadSelect(readSelect, status);
+    analogInputSystem->strobeLatchOutput(status);
+    value = static_cast<int16_t>(analogInputSystem->readOutput(status));
+  }
+  if (IsIORecording()) {
+    RecordIO(HAL_IORecord_kAnalogInput, port->channel, value,
+             port->lsbWeight * 1.0e-9 * value - port->offset * 1.0e-9);
+  }
+  return value;
 }
 
 /**
@@ -257,11 +378,15 @@ int32_t HAL_GetAnalogValue(HAL_AnalogInputHandle analogPortHandle,
  */
 int32_t HAL_GetAnalogAverageValue(HAL_AnalogInputHandle analogPortHandle,
                                   int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterAnalog);
   auto port = analogInputHandles->Get(analogPortHandle);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
+  auto& mirror = AnalogMirror::GetInstance();
+  if (mirror.IsRunning()) return mirror.GetAverageValue(port->channel);
+
   tAI::tReadSelect readSelect;
   readSelect.Channel = port->channel;
   readSelect.Averaged = true;
@@ -283,13 +408,150 @@ int32_t HAL_GetAnalogAverageValue(HAL_AnalogInputHandle analogPortHandle,
  */
 double HAL_GetAnalogVoltage(HAL_AnalogInputHandle analogPortHandle,
                             int32_t* status) {
+  auto port = analogInputHandles->Get(analogPortHandle);
+  if (port == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0.0;
+  }
   int32_t value = HAL_GetAnalogValue(analogPortHandle, status);
-  int32_t LSBWeight = HAL_GetAnalogLSBWeight(analogPortHandle, status);
-  int32_t offset = HAL_GetAnalogOffset(analogPortHandle, status);
-  double voltage = LSBWeight * 1.0e-9 * value - offset * 1.0e-9;
+  double voltage = port->lsbWeight * 1.0e-9 * value - port->offset * 1.0e-9;
   return voltage;
 }
 
+/**
+ * Get scaled samples straight from several channels.
+ *
+ * This reads the same values as HAL_GetAnalogVoltage(), but holds the register
+ * window for the whole batch.
+ *
+ * @param analogPortHandles Handles to the analog ports to read.
+ * @param voltages          Filled with the voltage of each port.
+ * @param count             Size of analogPortHandles and voltages.
+ */
+void HAL_GetAnalogVoltages(const HAL_AnalogInputHandle* analogPortHandles,
+                           double* voltages, int32_t count, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterAnalog);
+  std::shared_ptr<AnalogPort> ports[kNumAnalogInputs];
+  if (count < 0 || count > kNumAnalogInputs) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    ports[i] = analogInputHandles->Get(analogPortHandles[i]);
+    if (ports[i] == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return;
+    }
+  }
+
+  auto& mirror = AnalogMirror::GetInstance();
+  bool mirrored = mirror.IsRunning();
+  tAI::tReadSelect readSelect;
+  readSelect.Averaged = false;
+
+  std::unique_lock<wpi::mutex> lock(analogRegisterWindowMutex,
+                                    std::defer_lock);
+  if (!mirrored) lock.lock();
+  for (int32_t i = 0; i < count; i++) {
+    int32_t value;
+    if (mirrored) {
+      value = mirror.GetValue(ports[i]->channel);
+    } else {
+      readSelect.Channel = ports[i]->channel;
+      analogInputSystem->writeReadSelect(readSelect, status);
+      analogInputSystem->strobeLatchOutput(status);
+      value = static_cast<int16_t>(analogInputSystem->readOutput(status));
+    }
+    voltages[i] =
+        ports[i]->lsbWeight * 1.0e-9 * value - ports[i]->offset * 1.0e-9;
+    if (IsIORecording()) {
+      RecordIO(HAL_IORecord_kAnalogInput, ports[i]->channel, value,
+               voltages[i]);
+    }
+  }
+}
+
+/**
+ * Get samples from several channels, holding the register window once for
+ * the whole batch.
+ *
+ * @param analogPortHandles Handles to the analog ports to read.
+ * @param values            Filled with the value of each port.
+ * @param averaged          Whether to read the output of the oversample and
+ *                          average engine, as HAL_GetAnalogAverageValue()
+ *                          does, rather than the raw samples.
+ * @param count             Size of analogPortHandles and values.
+ */
+void HAL_GetAnalogValues(const HAL_AnalogInputHandle* analogPortHandles,
+                         int32_t* values, HAL_Bool averaged, int32_t count,
+                         int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterAnalog);
+  std::shared_ptr<AnalogPort> ports[kNumAnalogInputs];
+  if (count < 0 || count > kNumAnalogInputs) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    ports[i] = analogInputHandles->Get(analogPortHandles[i]);
+    if (ports[i] == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return;
+    }
+  }
+
+  auto& mirror = AnalogMirror::GetInstance();
+  if (mirror.IsRunning()) {
+    for (int32_t i = 0; i < count; i++) {
+      values[i] = averaged ? mirror.GetAverageValue(ports[i]->channel)
+                           : mirror.GetValue(ports[i]->channel);
+    }
+    return;
+  }
+
+  tAI::tReadSelect readSelect;
+  readSelect.Averaged = averaged;
+
+  std::lock_guard<wpi::mutex> lock(analogRegisterWindowMutex);
+  for (int32_t i = 0; i < count; i++) {
+    readSelect.Channel = ports[i]->channel;
+    analogInputSystem->writeReadSelect(readSelect, status);
+    analogInputSystem->strobeLatchOutput(status);
+    uint32_t output = analogInputSystem->readOutput(status);
+    values[i] = averaged ? static_cast<int32_t>(output)
+                         : static_cast<int16_t>(output);
+  }
+}
+
+/**
+ * Start copying the raw and averaged values of every channel in the
+ * background, so HAL_GetAnalogValue(), HAL_GetAnalogAverageValue() and the
+ * voltages computed from them no longer contend on the register window.
+ *
+ * The values read while the mirror runs are up to one period old. Calling this
+ * again while it runs changes the period.
+ *
+ * @param period The time between refreshes, in seconds.
+ */
+void HAL_StartAnalogMirror(double period, int32_t* status) {
+  initializeAnalog(status);
+  if (*status != 0) return;
+  AnalogMirror::GetInstance().Start(period, status);
+}
+
+/**
+ * Stop the analog mirror; reads go through the register window again.
+ */
+void HAL_StopAnalogMirror(int32_t* status) {
+  AnalogMirror::GetInstance().Stop();
+}
+
+/**
+ * Returns whether the analog mirror is running.
+ */
+HAL_Bool HAL_IsAnalogMirrorRunning(void) {
+  return AnalogMirror::GetInstance().IsRunning();
+}
+
 /**
  * Get a scaled sample from the output of the oversample and average engine for
  * the channel.
@@ -305,14 +567,20 @@ double HAL_GetAnalogVoltage(HAL_AnalogInputHandle analogPortHandle,
  */
 double HAL_GetAnalogAverageVoltage(HAL_AnalogInputHandle analogPortHandle,
                                    int32_t* status) {
+  auto port = analogInputHandles->Get(analogPortHandle);
+  if (port == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0.0;
+  }
   int32_t value = HAL_GetAnalogAverageValue(analogPortHandle, status);
-  int32_t LSBWeight = HAL_GetAnalogLSBWeight(analogPortHandle, status);
-  int32_t offset = HAL_GetAnalogOffset(analogPortHandle, status);
   int32_t oversampleBits =
       HAL_GetAnalogOversampleBits(analogPortHandle, status);
-  double voltage =
-      LSBWeight * 1.0e-9 * value / static_cast<double>(1 << oversampleBits) -
-      offset * 1.0e-9;
+  double voltage = port->lsbWeight * 1.0e-9 * value /
+                       static_cast<double>(1 << oversampleBits) -
+                   port->offset * 1.0e-9;
+  if (IsIORecording()) {
+    RecordIO(HAL_IORecord_kAnalogInput, port->channel, 0, voltage);
+  }
   return voltage;
 }
 
@@ -362,9 +630,7 @@ int32_t HAL_GetAnalogLSBWeight(HAL_AnalogInputHandle analogPortHandle,
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
-  int32_t lsbWeight = FRC_NetworkCommunication_nAICalibration_getLSBWeight(
-      0, port->channel, status);  // XXX: aiSystemIndex == 0?
-  return lsbWeight;
+  return port->lsbWeight;
 }
 
 /**
@@ -384,9 +650,7 @@ int32_t HAL_GetAnalogOffset(HAL_AnalogInputHandle analogPortHandle,
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
-  int32_t offset = FRC_NetworkCommunication_nAICalibration_getOffset(
-      0, port->channel, status);  // XXX: aiSystemIndex == 0?
-  return offset;
+  return port->offset;
 }
 
 }  // extern "C"
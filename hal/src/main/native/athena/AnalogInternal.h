@@ -34,6 +34,9 @@ extern bool analogSampleRateSet;
 struct AnalogPort {
   uint8_t channel;
   std::unique_ptr<tAccumulator> accumulator;
+  // Factory calibration, read once at initialization
+  int32_t lsbWeight;
+  int32_t offset;
 };
 
 extern IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort,
@@ -0,0 +1,274 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <support/mutex.h>
+
+#include "AnalogInternal.h"
+#include "HAL/AnalogInput.h"
+#include "HAL/DMA.h"
+#include "HAL/Errors.h"
+
+using namespace hal;
+
+// Samples the DMA engine can hold between reads
+static constexpr int32_t kQueueDepth = 1024;
+// Samples drained from the DMA engine per read
+static constexpr int32_t kReadBatch = 64;
+static constexpr int32_t kReadTimeoutMs = 20;
+
+namespace {
+// Ring of the latest samples of one input
+struct StreamBuffer {
+  std::vector<int32_t> values;
+  std::vector<uint64_t> timeStamps;
+  size_t next = 0;
+  size_t size = 0;
+  int64_t overflows = 0;
+};
+
+/**
+ * Captures every streamed analog input on the timer-triggered DMA engine, at
+ * the analog sample rate, and drains the captures from a background thread
+ * into a ring per input.
+ *
+ * DMA sources can only be chosen before the engine starts, so the engine is
+ * restarted whenever an input starts or stops streaming.
+ */
+class AnalogStream {
+ public:
+  static AnalogStream& GetInstance() {
+    static AnalogStream instance;
+    return instance;
+  }
+
+  ~AnalogStream();
+
+  void Start(HAL_AnalogInputHandle handle, int32_t bufferSize,
+             int32_t* status);
+  void Stop(HAL_AnalogInputHandle handle, int32_t* status);
+  int32_t Read(HAL_AnalogInputHandle handle, int32_t* values,
+               uint64_t* timeStamps, int32_t count, int32_t* status);
+  int64_t GetOverflowCount(HAL_AnalogInputHandle handle, int32_t* status);
+
+ private:
+  // m_configMutex must be held
+  void Restart(int32_t* status);
+  void StopDMA();
+
+  void ThreadMain(HAL_DMAHandle dma, std::vector<HAL_AnalogInputHandle> inputs);
+
+  wpi::mutex m_configMutex;
+  HAL_DMAHandle m_dma = HAL_kInvalidHandle;
+  std::atomic_bool m_active{false};
+  std::thread m_thread;
+
+  wpi::mutex m_mutex;
+  std::unordered_map<HAL_AnalogInputHandle, StreamBuffer> m_buffers;
+};
+}  // namespace
+
+AnalogStream::~AnalogStream() {
+  std::lock_guard<wpi::mutex> lock(m_configMutex);
+  StopDMA();
+}
+
+void AnalogStream::Start(HAL_AnalogInputHandle handle, int32_t bufferSize,
+                         int32_t* status) {
+  if (analogInputHandles->Get(handle) == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (bufferSize < 1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  std::lock_guard<wpi::mutex> configLock(m_configMutex);
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    auto& buffer = m_buffers[handle];
+    buffer.values.assign(bufferSize, 0);
+    buffer.timeStamps.assign(bufferSize, 0);
+    buffer.next = 0;
+    buffer.size = 0;
+  }
+  Restart(status);
+  if (*status != 0) {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_buffers.erase(handle);
+  }
+}
+
+void AnalogStream::Stop(HAL_AnalogInputHandle handle, int32_t* status) {
+  std::lock_guard<wpi::mutex> configLock(m_configMutex);
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (m_buffers.erase(handle) == 0) return;
+  }
+  Restart(status);
+}
+
+int32_t AnalogStream::Read(HAL_AnalogInputHandle handle, int32_t* values,
+                           uint64_t* timeStamps, int32_t count,
+                           int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_buffers.find(handle);
+  if (it == m_buffers.end()) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+
+  auto& buffer = it->second;
+  size_t capacity = buffer.values.size();
+  size_t read = std::min<size_t>(buffer.size, std::max(count, 0));
+  size_t first = buffer.next + capacity - buffer.size;
+  for (size_t i = 0; i < read; i++) {
+    values[i] = buffer.values[(first + i) % capacity];
+    timeStamps[i] = buffer.timeStamps[(first + i) % capacity];
+  }
+  buffer.size -= read;
+  return read;
+}
+
+int64_t AnalogStream::GetOverflowCount(HAL_AnalogInputHandle handle,
+                                       int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_buffers.find(handle);
+  if (it == m_buffers.end()) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  return it->second.overflows;
+}
+
+void AnalogStream::Restart(int32_t* status) {
+  StopDMA();
+
+  std::vector<HAL_AnalogInputHandle> inputs;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    for (auto& buffer : m_buffers) inputs.push_back(buffer.first);
+  }
+  if (inputs.empty()) return;
+
+  double sampleRate = HAL_GetAnalogSampleRate(status);
+  if (*status != 0) return;
+
+  m_dma = HAL_InitializeDMA(status);
+  if (*status != 0) {
+    m_dma = HAL_kInvalidHandle;
+    return;
+  }
+  HAL_SetDMARate(m_dma, static_cast<int32_t>(kTimebase / sampleRate), status);
+  for (auto input : inputs) HAL_AddDMAAnalogInput(m_dma, input, status);
+  HAL_StartDMA(m_dma, kQueueDepth, status);
+  if (*status != 0) {
+    HAL_FreeDMA(m_dma);
+    m_dma = HAL_kInvalidHandle;
+    return;
+  }
+
+  m_active = true;
+  m_thread = std::thread(&AnalogStream::ThreadMain, this, m_dma, inputs);
+}
+
+void AnalogStream::StopDMA() {
+  m_active = false;
+  if (m_thread.joinable()) m_thread.join();
+  if (m_dma == HAL_kInvalidHandle) return;
+  int32_t status = 0;
+  HAL_StopDMA(m_dma, &status);
+  HAL_FreeDMA(m_dma);
+  m_dma = HAL_kInvalidHandle;
+}
+
+void AnalogStream::ThreadMain(HAL_DMAHandle dma,
+                              std::vector<HAL_AnalogInputHandle> inputs) {
+  std::vector<HAL_DMASample> samples(kReadBatch);
+  while (m_active) {
+    int32_t status = 0;
+    int32_t remaining = 0;
+    int32_t read =
+        HAL_ReadDMASamples(dma, samples.data(), kReadBatch, kReadTimeoutMs,
+                           &remaining, &status);
+    if (status != 0 || read == 0) continue;
+
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    for (auto input : inputs) {
+      auto it = m_buffers.find(input);
+      if (it == m_buffers.end()) continue;
+      auto& buffer = it->second;
+      size_t capacity = buffer.values.size();
+      for (int32_t i = 0; i < read; i++) {
+        buffer.values[buffer.next] =
+            HAL_GetDMASampleAnalogInputRaw(&samples[i], input, &status);
+        buffer.timeStamps[buffer.next] =
+            HAL_GetDMASampleTime(&samples[i], &status);
+        buffer.next = (buffer.next + 1) % capacity;
+        if (buffer.size < capacity) {
+          buffer.size++;
+        } else {
+          buffer.overflows++;
+        }
+      }
+    }
+  }
+}
+
+extern "C" {
+
+/**
+ * Capture every conversion of an analog input, at the rate set by
+ * HAL_SetAnalogSampleRate(), into a ring buffer.
+ *
+ * Streaming uses the DMA engine, so it can not be combined with
+ * HAL_InitializeDMA(). The capture rate is read when a stream starts.
+ *
+ * @param bufferSize The number of samples kept between reads; when it fills,
+ *                   the oldest samples are overwritten.
+ */
+void HAL_StartAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                           int32_t bufferSize, int32_t* status) {
+  AnalogStream::GetInstance().Start(analogPortHandle, bufferSize, status);
+}
+
+void HAL_StopAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                          int32_t* status) {
+  AnalogStream::GetInstance().Stop(analogPortHandle, status);
+}
+
+/**
+ * Read and remove the buffered samples of a streamed analog input, oldest
+ * first.
+ *
+ * @param values     Filled with the raw values.
+ * @param timeStamps Filled with the FPGA time of each sample, in microseconds.
+ * @param count      Size of values and timeStamps.
+ * @return The number of samples read.
+ */
+int32_t HAL_ReadAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                             int32_t* values, uint64_t* timeStamps,
+                             int32_t count, int32_t* status) {
+  return AnalogStream::GetInstance().Read(analogPortHandle, values, timeStamps,
+                                          count, status);
+}
+
+/**
+ * Return the number of samples overwritten before they were read.
+ */
+int64_t HAL_GetAnalogStreamOverflowCount(HAL_AnalogInputHandle analogPortHandle,
+                                         int32_t* status) {
+  return AnalogStream::GetInstance().GetOverflowCount(analogPortHandle, status);
+}
+
+}  // extern "C"
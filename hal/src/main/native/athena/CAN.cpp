@@ -7,26 +7,57 @@
 
 #include "HAL/CAN.h"
 
+#include <cstring>
+
 #include <FRC_NetworkCommunication/CANSessionMux.h>
 
+#include "HAL/cpp/BusStatistics.h"
+#include "HAL/cpp/PerfCounters.h"
+#include "IORecordingInternal.h"
+
 namespace hal {
 namespace init {
 void InitializeCAN() {}
 }  // namespace init
 }  // namespace hal
 
+static void RecordCANMessage(uint32_t messageID, const uint8_t* data,
+                             uint8_t dataSize, uint32_t timeStamp) {
+  uint8_t buffer[12] = {0};
+  std::memcpy(buffer, data, dataSize > 8 ? 8 : dataSize);
+  std::memcpy(buffer + 8, &timeStamp, sizeof(timeStamp));
+  hal::RecordIO(HAL_IORecord_kCANMessage, dataSize,
+                static_cast<int32_t>(messageID), buffer, sizeof(buffer));
+}
+
+// The device number in a message ID, which the bus statistics are kept by
+static constexpr uint32_t kDeviceNumberMask = 0x3F;
+
 extern "C" {
 
 void HAL_CAN_SendMessage(uint32_t messageID, const uint8_t* data,
                          uint8_t dataSize, int32_t periodMs, int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterCAN);
+  hal::BusStatisticsScope busScope(HAL_kBusCAN, messageID & kDeviceNumberMask,
+                                   status);
   FRC_NetworkCommunication_CANSessionMux_sendMessage(messageID, data, dataSize,
                                                      periodMs, status);
 }
 void HAL_CAN_ReceiveMessage(uint32_t* messageID, uint32_t messageIDMask,
                             uint8_t* data, uint8_t* dataSize,
                             uint32_t* timeStamp, int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterCAN);
+  hal::BusStatisticsScope busScope(HAL_kBusCAN,
+                                   *messageID & kDeviceNumberMask);
   FRC_NetworkCommunication_CANSessionMux_receiveMessage(
       messageID, messageIDMask, data, dataSize, timeStamp, status);
+  // Polling for a message that hasn't arrived is not an error of the bus
+  if (*status != 0 && *status != HAL_ERR_CANSessionMux_MessageNotFound) {
+    busScope.SetError();
+  }
+  if (*status == 0 && hal::IsIORecording()) {
+    RecordCANMessage(*messageID, data, *dataSize, *timeStamp);
+  }
 }
 void HAL_CAN_OpenStreamSession(uint32_t* sessionHandle, uint32_t messageID,
                                uint32_t messageIDMask, uint32_t maxMessages,
@@ -41,9 +72,16 @@ void HAL_CAN_ReadStreamSession(uint32_t sessionHandle,
                                struct HAL_CANStreamMessage* messages,
                                uint32_t messagesToRead, uint32_t* messagesRead,
                                int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterCAN);
   FRC_NetworkCommunication_CANSessionMux_readStreamSession(
       sessionHandle, reinterpret_cast<tCANStreamMessage*>(messages),
       messagesToRead, messagesRead, status);
+  if (hal::IsIORecording()) {
+    for (uint32_t i = 0; i < *messagesRead; i++) {
+      RecordCANMessage(messages[i].messageID, messages[i].data,
+                       messages[i].dataSize, messages[i].timeStamp);
+    }
+  }
 }
 void HAL_CAN_GetCANStatus(float* percentBusUtilization, uint32_t* busOffCount,
                           uint32_t* txFullCount, uint32_t* receiveErrorCount,
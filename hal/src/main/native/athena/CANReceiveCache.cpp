@@ -0,0 +1,202 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "CANReceiveCache.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <support/mutex.h>
+
+#include "HAL/CAN.h"
+
+using namespace hal;
+
+// One stream session receives every frame of CTRE (manufacturer 4) PDPs and
+// PCMs (device types 8 and 9)
+static constexpr uint32_t kStreamMessageID = 0x08040000;
+static constexpr uint32_t kStreamMessageIDMask = 0x1EFF0000;
+static constexpr uint32_t kFullMessageIDMask = 0x1FFFFFFF;
+static constexpr uint32_t kMaxStreamMessages = 256;
+static constexpr uint32_t kBatchSize = 64;
+static constexpr auto kPollPeriod = std::chrono::milliseconds(5);
+
+// Must be a power of two
+static constexpr size_t kTableSize = 128;
+
+static int64_t GetTimeMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+namespace {
+/**
+ * A flat open-addressing table with one entry per registered ID.
+ *
+ * Keys are only inserted, under a mutex, so lookups need no lock. Each entry
+ * value is written by the receive thread only, guarded by a sequence counter
+ * that is odd while a write is in progress; readers copy the value and retry
+ * if the counter changed.
+ */
+class CANReceiveCache {
+ public:
+  static CANReceiveCache& GetInstance() {
+    static CANReceiveCache instance;
+    return instance;
+  }
+
+  ~CANReceiveCache();
+
+  bool Register(uint32_t arbId);
+  CANReceiveResult Get(uint32_t arbId, uint8_t* data, uint32_t* timeStamp,
+                       uint32_t* ageMs);
+
+ private:
+  struct Entry {
+    // 0 for an unused entry
+    std::atomic<uint32_t> arbId{0};
+    std::atomic<uint32_t> sequence{0};
+    uint8_t data[8];
+    uint32_t timeStamp;
+    // 0 until the first frame is received
+    int64_t receiveTime;
+  };
+
+  static size_t Hash(uint32_t arbId) {
+    return (arbId * 2654435761u) & (kTableSize - 1);
+  }
+
+  Entry* Find(uint32_t arbId);
+  void Store(const HAL_CANStreamMessage& message, int64_t now);
+  void ThreadMain();
+
+  Entry m_table[kTableSize];
+
+  wpi::mutex m_registerMutex;
+  uint32_t m_session = 0;
+  bool m_sessionOpen = false;
+  std::atomic_bool m_active{false};
+  std::thread m_thread;
+};
+}  // namespace
+
+CANReceiveCache::~CANReceiveCache() {
+  m_active = false;
+  if (m_thread.joinable()) m_thread.join();
+  if (m_sessionOpen) HAL_CAN_CloseStreamSession(m_session);
+}
+
+bool CANReceiveCache::Register(uint32_t arbId) {
+  arbId &= kFullMessageIDMask;
+  if (arbId == 0 || (arbId & kStreamMessageIDMask) != kStreamMessageID) {
+    return false;
+  }
+
+  std::lock_guard<wpi::mutex> lock(m_registerMutex);
+  if (!m_sessionOpen) {
+    int32_t status = 0;
+    HAL_CAN_OpenStreamSession(&m_session, kStreamMessageID,
+                              kStreamMessageIDMask, kMaxStreamMessages,
+                              &status);
+    if (status != 0) return false;
+    m_sessionOpen = true;
+    m_active = true;
+    m_thread = std::thread(&CANReceiveCache::ThreadMain, this);
+  }
+
+  for (size_t i = 0, index = Hash(arbId); i < kTableSize;
+       i++, index = (index + 1) & (kTableSize - 1)) {
+    uint32_t key = m_table[index].arbId.load(std::memory_order_relaxed);
+    if (key == arbId) return true;
+    if (key == 0) {
+      m_table[index].arbId.store(arbId, std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
+
+CANReceiveCache::Entry* CANReceiveCache::Find(uint32_t arbId) {
+  for (size_t i = 0, index = Hash(arbId); i < kTableSize;
+       i++, index = (index + 1) & (kTableSize - 1)) {
+    uint32_t key = m_table[index].arbId.load(std::memory_order_acquire);
+    if (key == arbId) return &m_table[index];
+    if (key == 0) return nullptr;
+  }
+  return nullptr;
+}
+
+CANReceiveResult CANReceiveCache::Get(uint32_t arbId, uint8_t* data,
+                                      uint32_t* timeStamp,
+                                      uint32_t* ageMs) {
+  Entry* entry = Find(arbId & kFullMessageIDMask);
+  if (!entry) return CANReceiveResult::kNotRegistered;
+
+  int64_t receiveTime;
+  uint32_t sequence;
+  do {
+    sequence = entry->sequence.load(std::memory_order_acquire);
+    std::memcpy(data, entry->data, sizeof(entry->data));
+    *timeStamp = entry->timeStamp;
+    receiveTime = entry->receiveTime;
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence & 1) ||
+           entry->sequence.load(std::memory_order_relaxed) != sequence);
+
+  if (receiveTime == 0) return CANReceiveResult::kNotReceived;
+  *ageMs = GetTimeMs() - receiveTime;
+  return CANReceiveResult::kReceived;
+}
+
+void CANReceiveCache::Store(const HAL_CANStreamMessage& message, int64_t now) {
+  Entry* entry = Find(message.messageID & kFullMessageIDMask);
+  if (!entry) return;
+
+  uint32_t sequence = entry->sequence.load(std::memory_order_relaxed);
+  entry->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memset(entry->data, 0, sizeof(entry->data));
+  std::memcpy(entry->data, message.data,
+              message.dataSize < 8 ? message.dataSize : 8);
+  entry->timeStamp = message.timeStamp;
+  entry->receiveTime = now;
+  entry->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void CANReceiveCache::ThreadMain() {
+  HAL_CANStreamMessage messages[kBatchSize];
+  while (m_active) {
+    int64_t now = GetTimeMs();
+    uint32_t read;
+    do {
+      read = 0;
+      int32_t status = 0;
+      HAL_CAN_ReadStreamSession(m_session, messages, kBatchSize, &read,
+                                &status);
+      if (status < 0) break;
+      for (uint32_t i = 0; i < read; i++) Store(messages[i], now);
+    } while (read == kBatchSize);
+
+    std::this_thread::sleep_for(kPollPeriod);
+  }
+}
+
+namespace hal {
+
+bool RegisterCANReceive(uint32_t arbId) {
+  return CANReceiveCache::GetInstance().Register(arbId);
+}
+
+CANReceiveResult GetCANReceive(uint32_t arbId, uint8_t* data,
+                               uint32_t* timeStamp, uint32_t* ageMs) {
+  return CANReceiveCache::GetInstance().Get(arbId, data, timeStamp, ageMs);
+}
+
+}  // namespace hal
@@ -0,0 +1,33 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace hal {
+
+enum class CANReceiveResult { kNotRegistered, kNotReceived, kReceived };
+
+/**
+ * Keeps the latest frame of a CTRE PDP or PCM arbitration ID up to date in the
+ * background. Returns false if the ID can not be cached, in which case it has
+ * to be polled.
+ */
+bool RegisterCANReceive(uint32_t arbId);
+
+/**
+ * Copies the latest cached frame of an arbitration ID. Never blocks.
+ *
+ * @param data      Filled with the 8 data bytes of the frame.
+ * @param timeStamp Set to the CAN receive time of the frame, in ms.
+ * @param ageMs     Set to the time since the frame was received, in ms.
+ */
+CANReceiveResult GetCANReceive(uint32_t arbId, uint8_t* data,
+                               uint32_t* timeStamp, uint32_t* ageMs);
+
+}  // namespace hal
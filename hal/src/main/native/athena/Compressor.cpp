@@ -8,6 +8,7 @@
 #include "HAL/Compressor.h"
 
 #include "HAL/Errors.h"
+#include "HAL/cpp/BusStatistics.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "PCMInternal.h"
 #include "PortsInternal.h"
@@ -49,6 +50,7 @@ HAL_Bool HAL_GetCompressor(HAL_CompressorHandle compressorHandle,
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetCompressor(value);
@@ -76,6 +78,7 @@ HAL_Bool HAL_GetCompressorClosedLoopControl(
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetClosedLoopControl(value);
@@ -91,6 +94,7 @@ HAL_Bool HAL_GetCompressorPressureSwitch(HAL_CompressorHandle compressorHandle,
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetPressure(value);
@@ -106,6 +110,7 @@ double HAL_GetCompressorCurrent(HAL_CompressorHandle compressorHandle,
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   float value;
 
   *status = PCM_modules[index]->GetCompressorCurrent(value);
@@ -120,6 +125,7 @@ HAL_Bool HAL_GetCompressorCurrentTooHighFault(
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetCompressorCurrentTooHighFault(value);
@@ -134,6 +140,7 @@ HAL_Bool HAL_GetCompressorCurrentTooHighStickyFault(
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetCompressorCurrentTooHighStickyFault(value);
@@ -148,6 +155,7 @@ HAL_Bool HAL_GetCompressorShortedStickyFault(
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetCompressorShortedStickyFault(value);
@@ -162,6 +170,7 @@ HAL_Bool HAL_GetCompressorShortedFault(HAL_CompressorHandle compressorHandle,
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetCompressorShortedFault(value);
@@ -176,6 +185,7 @@ HAL_Bool HAL_GetCompressorNotConnectedStickyFault(
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetCompressorNotConnectedStickyFault(value);
@@ -190,6 +200,7 @@ HAL_Bool HAL_GetCompressorNotConnectedFault(
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
   bool value;
 
   *status = PCM_modules[index]->GetCompressorNotConnectedFault(value);
@@ -197,4 +208,34 @@ HAL_Bool HAL_GetCompressorNotConnectedFault(
   return value;
 }
 
+void HAL_GetCompressorStatus(HAL_CompressorHandle compressorHandle,
+                             HAL_CompressorStatus* compressorStatus,
+                             int32_t* status) {
+  int16_t index =
+      getHandleTypedIndex(compressorHandle, HAL_HandleEnum::Compressor, 0);
+  if (index == InvalidHandleIndex) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  BusStatisticsScope busScope(HAL_kBusPCM, index, status);
+  bool on, closedLoop, pressureSwitch, currentTooHighFault,
+      currentTooHighStickyFault, shortedFault, shortedStickyFault,
+      notConnectedFault, notConnectedStickyFault;
+  float current;
+  *status = PCM_modules[index]->GetCompressorStatus(
+      on, closedLoop, pressureSwitch, current, currentTooHighFault,
+      currentTooHighStickyFault, shortedFault, shortedStickyFault,
+      notConnectedFault, notConnectedStickyFault,
+      compressorStatus->frameTimeStamps);
+  compressorStatus->enabled = on;
+  compressorStatus->closedLoopControl = closedLoop;
+  compressorStatus->pressureSwitch = pressureSwitch;
+  compressorStatus->current = current;
+  compressorStatus->currentTooHighFault = currentTooHighFault;
+  compressorStatus->currentTooHighStickyFault = currentTooHighStickyFault;
+  compressorStatus->shortedFault = shortedFault;
+  compressorStatus->shortedStickyFault = shortedStickyFault;
+  compressorStatus->notConnectedFault = notConnectedFault;
+  compressorStatus->notConnectedStickyFault = notConnectedStickyFault;
+}
 }  // extern "C"
@@ -7,23 +7,50 @@
 
 #include "HAL/Counter.h"
 
+#include <memory>
+
+#include <support/mutex.h>
+
 #include "ConstantsInternal.h"
 #include "DigitalInternal.h"
 #include "HAL/HAL.h"
+#include "HAL/Interrupts.h"
+#include "HAL/cpp/PerfCounters.h"
+#include "HAL/cpp/PulseStatistics.h"
 #include "HAL/handles/LimitedHandleResource.h"
 #include "PortsInternal.h"
 
 using namespace hal;
 
+// Edges buffered between runs of the pulse monitor handler
+static constexpr int32_t kPulseEventQueueSize = 64;
+static constexpr int32_t kPulseEventBatch = 16;
+
 namespace {
 
+// Measures every pulse of a counter's up source from the timestamps of an
+// interrupt on both of its edges
+struct PulseMonitor {
+  explicit PulseMonitor(size_t windowSize) : statistics(windowSize) {}
+
+  HAL_InterruptHandle interrupt = HAL_kInvalidHandle;
+  wpi::mutex mutex;
+  PulseStatistics statistics;
+};
+
 struct Counter {
   std::unique_ptr<tCounter> counter;
   uint8_t index;
+  HAL_Handle upSource = HAL_kInvalidHandle;
+  HAL_AnalogTriggerType upSourceTrigger = HAL_Trigger_kInWindow;
+  std::unique_ptr<PulseMonitor> pulseMonitor;
 };
 
 }  // namespace
 
+// Guards starting, stopping and reading the pulse monitors
+static wpi::mutex pulseMonitorMutex;
+
 static LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
                              HAL_HandleEnum::Counter>* counterHandles;
 
@@ -38,6 +65,47 @@ void InitializeCounter() {
 }  // namespace init
 }  // namespace hal
 
+static void PulseMonitorHandler(uint32_t mask, void* param) {
+  auto monitor = static_cast<PulseMonitor*>(param);
+  HAL_InterruptEvent events[kPulseEventBatch];
+  int32_t status = 0;
+  int32_t read;
+  std::lock_guard<wpi::mutex> lock(monitor->mutex);
+  do {
+    read = HAL_ReadInterruptEvents(monitor->interrupt, events,
+                                   kPulseEventBatch, &status);
+    for (int32_t i = 0; i < read; i++) {
+      monitor->statistics.AddEdge(
+          events[i].timestamp, events[i].edge == HAL_kInterruptRisingEdge);
+    }
+  } while (status == 0 && read == kPulseEventBatch);
+}
+
+// pulseMonitorMutex must be held
+static void StopPulseMonitor(Counter* counter) {
+  if (!counter->pulseMonitor) return;
+  int32_t status = 0;
+  // Freeing the interrupt stops its handler before the monitor is destroyed
+  HAL_CleanInterrupts(counter->pulseMonitor->interrupt, &status);
+  counter->pulseMonitor.reset();
+}
+
+static double DecodePeriod(tCounter::tTimerOutput output) {
+  double period;
+  if (output.Stalled) {
+    // Return infinity
+    double zero = 0.0;
+    period = 1.0 / zero;
+  } else {
+    // output.Period is a fixed point number that counts by 2 (24 bits, 25
+    // integer bits)
+    period = static_cast<double>(output.Period << 1) /
+             static_cast<double>(output.Count);
+  }
+  return static_cast<double>(period *
+                             2.5e-8);  // result * timebase (currently 25ns)
+}
+
 extern "C" {
 
 HAL_CounterHandle HAL_InitializeCounter(HAL_Counter_Mode mode, int32_t* index,
@@ -47,7 +115,7 @@ HAL_CounterHandle HAL_InitializeCounter(HAL_Counter_Mode mode, int32_t* index,
     *status = NO_AVAILABLE_RESOURCES;
     return HAL_kInvalidHandle;
   }
-  auto counter = counterHandles->Get(handle);
+  auto counter = counterHandles->GetBorrowed(handle);
   if (counter == nullptr) {  // would only occur on thread issues
     *status = HAL_HANDLE_ERROR;
     return HAL_kInvalidHandle;
@@ -62,12 +130,17 @@ HAL_CounterHandle HAL_InitializeCounter(HAL_Counter_Mode mode, int32_t* index,
 }
 
 void HAL_FreeCounter(HAL_CounterHandle counterHandle, int32_t* status) {
+  auto counter = counterHandles->GetBorrowed(counterHandle);
+  if (counter != nullptr) {
+    std::lock_guard<wpi::mutex> lock(pulseMonitorMutex);
+    StopPulseMonitor(counter.get());
+  }
   counterHandles->Free(counterHandle);
 }
 
 void HAL_SetCounterAverageSize(HAL_CounterHandle counterHandle, int32_t size,
                                int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -83,7 +156,7 @@ void HAL_SetCounterUpSource(HAL_CounterHandle counterHandle,
                             HAL_Handle digitalSourceHandle,
                             HAL_AnalogTriggerType analogTriggerType,
                             int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -100,6 +173,8 @@ void HAL_SetCounterUpSource(HAL_CounterHandle counterHandle,
     return;
   }
 
+  counter->upSource = digitalSourceHandle;
+  counter->upSourceTrigger = analogTriggerType;
   counter->counter->writeConfig_UpSource_Module(routingModule, status);
   counter->counter->writeConfig_UpSource_Channel(routingChannel, status);
   counter->counter->writeConfig_UpSource_AnalogTrigger(routingAnalogTrigger,
@@ -120,7 +195,7 @@ void HAL_SetCounterUpSource(HAL_CounterHandle counterHandle,
 void HAL_SetCounterUpSourceEdge(HAL_CounterHandle counterHandle,
                                 HAL_Bool risingEdge, HAL_Bool fallingEdge,
                                 int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -134,7 +209,7 @@ void HAL_SetCounterUpSourceEdge(HAL_CounterHandle counterHandle,
  */
 void HAL_ClearCounterUpSource(HAL_CounterHandle counterHandle,
                               int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -144,6 +219,7 @@ void HAL_ClearCounterUpSource(HAL_CounterHandle counterHandle,
   // Index 0 of digital is always 0.
   counter->counter->writeConfig_UpSource_Channel(0, status);
   counter->counter->writeConfig_UpSource_AnalogTrigger(false, status);
+  counter->upSource = HAL_kInvalidHandle;
 }
 
 /**
@@ -154,7 +230,7 @@ void HAL_SetCounterDownSource(HAL_CounterHandle counterHandle,
                               HAL_Handle digitalSourceHandle,
                               HAL_AnalogTriggerType analogTriggerType,
                               int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -194,7 +270,7 @@ void HAL_SetCounterDownSource(HAL_CounterHandle counterHandle,
 void HAL_SetCounterDownSourceEdge(HAL_CounterHandle counterHandle,
                                   HAL_Bool risingEdge, HAL_Bool fallingEdge,
                                   int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -208,7 +284,7 @@ void HAL_SetCounterDownSourceEdge(HAL_CounterHandle counterHandle,
  */
 void HAL_ClearCounterDownSource(HAL_CounterHandle counterHandle,
                                 int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -226,7 +302,7 @@ void HAL_ClearCounterDownSource(HAL_CounterHandle counterHandle,
  */
 void HAL_SetCounterUpDownMode(HAL_CounterHandle counterHandle,
                               int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -241,7 +317,7 @@ void HAL_SetCounterUpDownMode(HAL_CounterHandle counterHandle,
  */
 void HAL_SetCounterExternalDirectionMode(HAL_CounterHandle counterHandle,
                                          int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -255,7 +331,7 @@ void HAL_SetCounterExternalDirectionMode(HAL_CounterHandle counterHandle,
  */
 void HAL_SetCounterSemiPeriodMode(HAL_CounterHandle counterHandle,
                                   HAL_Bool highSemiPeriod, int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -274,7 +350,7 @@ void HAL_SetCounterSemiPeriodMode(HAL_CounterHandle counterHandle,
  */
 void HAL_SetCounterPulseLengthMode(HAL_CounterHandle counterHandle,
                                    double threshold, int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -295,7 +371,7 @@ void HAL_SetCounterPulseLengthMode(HAL_CounterHandle counterHandle,
  */
 int32_t HAL_GetCounterSamplesToAverage(HAL_CounterHandle counterHandle,
                                        int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -311,7 +387,7 @@ int32_t HAL_GetCounterSamplesToAverage(HAL_CounterHandle counterHandle,
  */
 void HAL_SetCounterSamplesToAverage(HAL_CounterHandle counterHandle,
                                     int32_t samplesToAverage, int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -328,7 +404,7 @@ void HAL_SetCounterSamplesToAverage(HAL_CounterHandle counterHandle,
  * counter, just sets the current value to zero.
  */
 void HAL_ResetCounter(HAL_CounterHandle counterHandle, int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -342,7 +418,8 @@ void HAL_ResetCounter(HAL_CounterHandle counterHandle, int32_t* status) {
  * current value. Next time it is read, it might have a different value.
  */
 int32_t HAL_GetCounter(HAL_CounterHandle counterHandle, int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterCounter);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -358,25 +435,13 @@ int32_t HAL_GetCounter(HAL_CounterHandle counterHandle, int32_t* status) {
  * @returns The period of the last two pulses in units of seconds.
  */
 double HAL_GetCounterPeriod(HAL_CounterHandle counterHandle, int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterCounter);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0.0;
   }
-  tCounter::tTimerOutput output = counter->counter->readTimerOutput(status);
-  double period;
-  if (output.Stalled) {
-    // Return infinity
-    double zero = 0.0;
-    period = 1.0 / zero;
-  } else {
-    // output.Period is a fixed point number that counts by 2 (24 bits, 25
-    // integer bits)
-    period = static_cast<double>(output.Period << 1) /
-             static_cast<double>(output.Count);
-  }
-  return static_cast<double>(period *
-                             2.5e-8);  // result * timebase (currently 25ns)
+  return DecodePeriod(counter->counter->readTimerOutput(status));
 }
 
 /**
@@ -389,7 +454,7 @@ double HAL_GetCounterPeriod(HAL_CounterHandle counterHandle, int32_t* status) {
  */
 void HAL_SetCounterMaxPeriod(HAL_CounterHandle counterHandle, double maxPeriod,
                              int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -413,7 +478,7 @@ void HAL_SetCounterMaxPeriod(HAL_CounterHandle counterHandle, double maxPeriod,
  */
 void HAL_SetCounterUpdateWhenEmpty(HAL_CounterHandle counterHandle,
                                    HAL_Bool enabled, int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -431,7 +496,8 @@ void HAL_SetCounterUpdateWhenEmpty(HAL_CounterHandle counterHandle,
  */
 HAL_Bool HAL_GetCounterStopped(HAL_CounterHandle counterHandle,
                                int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterCounter);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -445,7 +511,8 @@ HAL_Bool HAL_GetCounterStopped(HAL_CounterHandle counterHandle,
  */
 HAL_Bool HAL_GetCounterDirection(HAL_CounterHandle counterHandle,
                                  int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterCounter);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -463,7 +530,7 @@ HAL_Bool HAL_GetCounterDirection(HAL_CounterHandle counterHandle,
 void HAL_SetCounterReverseDirection(HAL_CounterHandle counterHandle,
                                     HAL_Bool reverseDirection,
                                     int32_t* status) {
-  auto counter = counterHandles->Get(counterHandle);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
   if (counter == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -477,4 +544,133 @@ void HAL_SetCounterReverseDirection(HAL_CounterHandle counterHandle,
   }
 }
 
+/**
+ * Read the count, direction, period and stopped state of the counter at once.
+ * The output and timer registers are each read whole instead of field by
+ * field, and the handle is only looked up once.
+ */
+void HAL_GetCounterSnapshot(HAL_CounterHandle counterHandle,
+                            HAL_CounterSnapshot* snapshot, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterCounter);
+  auto counter = counterHandles->GetBorrowed(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  tCounter::tOutput output = counter->counter->readOutput(status);
+  tCounter::tTimerOutput timerOutput =
+      counter->counter->readTimerOutput(status);
+  snapshot->timestamp = HAL_GetFPGATime(status);
+  snapshot->count = output.Value;
+  snapshot->direction = output.Direction;
+  snapshot->period = DecodePeriod(timerOutput);
+  snapshot->stopped = timerOutput.Stalled;
+}
+
+/**
+ * Measure the period and pulse width of every pulse on the up source of the
+ * counter, from an interrupt on both of its edges.
+ *
+ * This uses one of the interrupts, and works in any counter mode. Edges are
+ * timestamped by the FPGA in microseconds.
+ *
+ * @param windowSize The number of latest pulses the statistics cover, 1 to
+ *                   HAL_kMaxCounterPulseWindow.
+ */
+void HAL_StartCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                     int32_t windowSize, int32_t* status) {
+  auto counter = counterHandles->GetBorrowed(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (windowSize < 1 || windowSize > HAL_kMaxCounterPulseWindow) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  if (counter->upSource == HAL_kInvalidHandle) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+
+  std::lock_guard<wpi::mutex> lock(pulseMonitorMutex);
+  StopPulseMonitor(counter.get());
+
+  auto monitor = std::make_unique<PulseMonitor>(windowSize);
+  monitor->interrupt = HAL_InitializeInterrupts(false, status);
+  if (*status != 0) return;
+  HAL_RequestInterrupts(monitor->interrupt, counter->upSource,
+                        counter->upSourceTrigger, status);
+  HAL_SetInterruptUpSourceEdge(monitor->interrupt, true, true, status);
+  HAL_SetInterruptEventQueueSize(monitor->interrupt, kPulseEventQueueSize,
+                                 status);
+  HAL_AttachInterruptHandler(monitor->interrupt, PulseMonitorHandler,
+                             monitor.get(), status);
+  HAL_EnableInterrupts(monitor->interrupt, status);
+  if (*status != 0) {
+    int32_t cleanStatus = 0;
+    HAL_CleanInterrupts(monitor->interrupt, &cleanStatus);
+    return;
+  }
+  counter->pulseMonitor = std::move(monitor);
+}
+
+void HAL_StopCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                    int32_t* status) {
+  auto counter = counterHandles->GetBorrowed(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  std::lock_guard<wpi::mutex> lock(pulseMonitorMutex);
+  StopPulseMonitor(counter.get());
+}
+
+void HAL_GetCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                   HAL_CounterPulseStatistics* stats,
+                                   int32_t* status) {
+  auto counter = counterHandles->GetBorrowed(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  std::lock_guard<wpi::mutex> lock(pulseMonitorMutex);
+  if (!counter->pulseMonitor) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+  std::lock_guard<wpi::mutex> monitorLock(counter->pulseMonitor->mutex);
+  counter->pulseMonitor->statistics.GetStatistics(stats);
+}
+
+/**
+ * Count the measured periods or widths falling in each of binCount equal bins
+ * between min and max. Values outside of the range are counted in the first
+ * or last bin.
+ *
+ * @return The number of pulses counted.
+ */
+int32_t HAL_GetCounterPulseHistogram(HAL_CounterHandle counterHandle,
+                                     HAL_Bool widths, double min, double max,
+                                     int32_t* bins, int32_t binCount,
+                                     int32_t* status) {
+  auto counter = counterHandles->GetBorrowed(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  if (binCount < 1 || !(max > min)) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return 0;
+  }
+  std::lock_guard<wpi::mutex> lock(pulseMonitorMutex);
+  if (!counter->pulseMonitor) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  std::lock_guard<wpi::mutex> monitorLock(counter->pulseMonitor->mutex);
+  return counter->pulseMonitor->statistics.GetHistogram(widths, min, max, bins,
+                                                        binCount);
+}
+
 }  // extern "C"
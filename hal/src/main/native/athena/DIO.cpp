@@ -10,8 +10,11 @@
 #include <cmath>
 
 #include "DigitalInternal.h"
+#include "HAL/HAL.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HAL/handles/LimitedHandleResource.h"
+#include "IORecordingInternal.h"
 #include "PortsInternal.h"
 
 using namespace hal;
@@ -66,7 +69,7 @@ HAL_DigitalHandle HAL_InitializeDIOPort(HAL_PortHandle portHandle,
 
   port->channel = static_cast<uint8_t>(channel);
 
-  std::lock_guard<wpi::mutex> lock(digitalDIOMutex);
+  std::lock_guard<wpi::mutex> lock(digitalOutputEnableMutex);
 
   tDIO::tOutputEnable outputEnable = digitalSystem->readOutputEnable(status);
 
@@ -127,7 +130,7 @@ void HAL_FreeDIOPort(HAL_DigitalHandle dioPortHandle) {
   digitalChannelHandles->Free(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) return;
   int32_t status = 0;
-  std::lock_guard<wpi::mutex> lock(digitalDIOMutex);
+  std::lock_guard<wpi::mutex> lock(digitalOutputEnableMutex);
   if (port->channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
     // Unset the SPI flag
     int32_t bitToUnset = 1 << remapSPIChannel(port->channel);
@@ -231,6 +234,55 @@ void HAL_SetDigitalPWMDutyCycle(HAL_DigitalPWMHandle pwmGenerator,
   }
 }
 
+/**
+ * Configure the duty-cycle of several PWM generators at once, taking the PWM
+ * lock and reading the PWM rate once for all of them.
+ *
+ * No duty cycle is changed if any of the generators is invalid.
+ *
+ * @param pwmGenerators The generator indexes reserved by allocateDigitalPWM()
+ * @param dutyCycles    The percent duty cycle to output [0..1], one per
+ *                      generator
+ * @param count         The number of generators
+ */
+void HAL_SetDigitalPWMDutyCycles(const HAL_DigitalPWMHandle* pwmGenerators,
+                                 const double* dutyCycles, int32_t count,
+                                 int32_t* status) {
+  int32_t ids[kNumDigitalPWMOutputs];
+  if (count > kNumDigitalPWMOutputs) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    auto port = digitalPWMHandles->Get(pwmGenerators[i]);
+    if (port == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return;
+    }
+    ids[i] = *port;
+  }
+  std::lock_guard<wpi::mutex> lock(digitalPwmMutex);
+  uint16_t pwmPeriodPower = digitalSystem->readPWMPeriodPower(status);
+  for (int32_t i = 0; i < count; i++) {
+    double dutyCycle = dutyCycles[i];
+    if (dutyCycle > 1.0) dutyCycle = 1.0;
+    if (dutyCycle < 0.0) dutyCycle = 0.0;
+    double rawDutyCycle = 256.0 * dutyCycle;
+    if (rawDutyCycle > 255.5) rawDutyCycle = 255.5;
+    if (pwmPeriodPower < 4) {
+      // The resolution of the duty cycle drops close to the highest
+      // frequencies.
+      rawDutyCycle = rawDutyCycle / std::pow(2.0, 4 - pwmPeriodPower);
+    }
+    if (ids[i] < 4)
+      digitalSystem->writePWMDutyCycleA(
+          ids[i], static_cast<uint8_t>(rawDutyCycle), status);
+    else
+      digitalSystem->writePWMDutyCycleB(
+          ids[i] - 4, static_cast<uint8_t>(rawDutyCycle), status);
+  }
+}
+
 /**
  * Configure which DO channel the PWM signal is output on
  *
@@ -266,43 +318,14 @@ void HAL_SetDigitalPWMOutputChannel(HAL_DigitalPWMHandle pwmGenerator,
  */
 void HAL_SetDIO(HAL_DigitalHandle dioPortHandle, HAL_Bool value,
                 int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterDIO);
   auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
   }
-  if (value != 0 && value != 1) {
-    if (value != 0) value = 1;
-  }
-  {
-    std::lock_guard<wpi::mutex> lock(digitalDIOMutex);
-    tDIO::tDO currentDIO = digitalSystem->readDO(status);
-
-    if (port->channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
-      if (value == 0) {
-        currentDIO.SPIPort =
-            currentDIO.SPIPort & ~(1u << remapSPIChannel(port->channel));
-      } else if (value == 1) {
-        currentDIO.SPIPort =
-            currentDIO.SPIPort | (1u << remapSPIChannel(port->channel));
-      }
-    } else if (port->channel < kNumDigitalHeaders) {
-      if (value == 0) {
-        currentDIO.Headers = currentDIO.Headers & ~(1u << port->channel);
-      } else if (value == 1) {
-        currentDIO.Headers = currentDIO.Headers | (1u << port->channel);
-      }
-    } else {
-      if (value == 0) {
-        currentDIO.MXP =
-            currentDIO.MXP & ~(1u << remapMXPChannel(port->channel));
-      } else if (value == 1) {
-        currentDIO.MXP =
-            currentDIO.MXP | (1u << remapMXPChannel(port->channel));
-      }
-    }
-    digitalSystem->writeDO(currentDIO, status);
-  }
+  uint32_t bit = getDigitalOutputBit(port->channel);
+  setDigitalOutputs(bit, value ? bit : 0, status);
 }
 
 /**
@@ -319,7 +342,7 @@ void HAL_SetDIODirection(HAL_DigitalHandle dioPortHandle, HAL_Bool input,
     return;
   }
   {
-    std::lock_guard<wpi::mutex> lock(digitalDIOMutex);
+    std::lock_guard<wpi::mutex> lock(digitalOutputEnableMutex);
     tDIO::tOutputEnable currentDIO = digitalSystem->readOutputEnable(status);
 
     if (port->channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
@@ -357,6 +380,7 @@ void HAL_SetDIODirection(HAL_DigitalHandle dioPortHandle, HAL_Bool input,
  * @return The state of the specified channel
  */
 HAL_Bool HAL_GetDIO(HAL_DigitalHandle dioPortHandle, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterDIO);
   auto port = digitalChannelHandles->Get(dioPortHandle, HAL_HandleEnum::DIO);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
@@ -368,13 +392,65 @@ HAL_Bool HAL_GetDIO(HAL_DigitalHandle dioPortHandle, int32_t* status) {
   // if it == 0, then return false
   // else return true
 
+  bool value;
   if (port->channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
-    return ((currentDIO.SPIPort >> remapSPIChannel(port->channel)) & 1) != 0;
+    value = ((currentDIO.SPIPort >> remapSPIChannel(port->channel)) & 1) != 0;
   } else if (port->channel < kNumDigitalHeaders) {
-    return ((currentDIO.Headers >> port->channel) & 1) != 0;
+    value = ((currentDIO.Headers >> port->channel) & 1) != 0;
   } else {
-    return ((currentDIO.MXP >> remapMXPChannel(port->channel)) & 1) != 0;
+    value = ((currentDIO.MXP >> remapMXPChannel(port->channel)) & 1) != 0;
+  }
+  if (IsIORecording()) RecordIO(HAL_IORecord_kDIO, port->channel, value);
+  return value;
+}
+
+/**
+ * Read every digital I/O channel with a single read of the FPGA.
+ *
+ * @param timestamp Set to the FPGA time of the read, in microseconds.
+ * @return A mask with bit n set when DIO channel n is high.
+ */
+uint32_t HAL_GetAllDIO(uint64_t* timestamp, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterDIO);
+  initializeDigital(status);
+  if (*status != 0) return 0;
+
+  tDIO::tDI currentDIO = digitalSystem->readDI(status);
+  *timestamp = HAL_GetFPGATime(status);
+
+  return static_cast<uint32_t>(currentDIO.Headers) |
+         (static_cast<uint32_t>(currentDIO.MXP) << kNumDigitalHeaders) |
+         (static_cast<uint32_t>(currentDIO.SPIPort)
+          << (kNumDigitalHeaders + kNumDigitalMXPChannels));
+}
+
+/**
+ * Set several digital outputs with a single write of the FPGA.
+ *
+ * @param mask   A mask with bit n set for each DIO channel n to set.
+ * @param values The new output states, one bit per channel as in mask.
+ */
+void HAL_SetDIOMasked(uint32_t mask, uint32_t values, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterDIO);
+  if (mask >> kNumDigitalChannels) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
   }
+  initializeDigital(status);
+  if (*status != 0) return;
+
+  tDIO::tDO setMask;
+  setMask.value = 0;
+  setMask.Headers = mask;
+  setMask.MXP = mask >> kNumDigitalHeaders;
+  setMask.SPIPort = mask >> (kNumDigitalHeaders + kNumDigitalMXPChannels);
+  tDIO::tDO setValues;
+  setValues.value = 0;
+  setValues.Headers = values;
+  setValues.MXP = values >> kNumDigitalHeaders;
+  setValues.SPIPort = values >> (kNumDigitalHeaders + kNumDigitalMXPChannels);
+
+  setDigitalOutputs(setMask.value, setValues.value, status);
 }
 
 /**
@@ -491,7 +567,7 @@ void HAL_SetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t filterIndex,
     return;
   }
 
-  std::lock_guard<wpi::mutex> lock(digitalDIOMutex);
+  std::lock_guard<wpi::mutex> lock(digitalFilterMutex);
   if (port->channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
     // Channels 10-15 are SPI channels, so subtract our MXP channels
     digitalSystem->writeFilterSelectHdr(port->channel - kNumDigitalMXPChannels,
@@ -519,7 +595,7 @@ int32_t HAL_GetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t* status) {
     return 0;
   }
 
-  std::lock_guard<wpi::mutex> lock(digitalDIOMutex);
+  std::lock_guard<wpi::mutex> lock(digitalFilterMutex);
   if (port->channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
     // Channels 10-15 are SPI channels, so subtract our MXP channels
     return digitalSystem->readFilterSelectHdr(
@@ -546,7 +622,7 @@ int32_t HAL_GetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t* status) {
 void HAL_SetFilterPeriod(int32_t filterIndex, int64_t value, int32_t* status) {
   initializeDigital(status);
   if (*status != 0) return;
-  std::lock_guard<wpi::mutex> lock(digitalDIOMutex);
+  std::lock_guard<wpi::mutex> lock(digitalFilterMutex);
   digitalSystem->writeFilterPeriodHdr(filterIndex, value, status);
   if (*status == 0) {
     digitalSystem->writeFilterPeriodMXP(filterIndex, value, status);
@@ -571,7 +647,7 @@ int64_t HAL_GetFilterPeriod(int32_t filterIndex, int32_t* status) {
   uint32_t hdrPeriod = 0;
   uint32_t mxpPeriod = 0;
   {
-    std::lock_guard<wpi::mutex> lock(digitalDIOMutex);
+    std::lock_guard<wpi::mutex> lock(digitalFilterMutex);
     hdrPeriod = digitalSystem->readFilterPeriodHdr(filterIndex, status);
     if (*status == 0) {
       mxpPeriod = digitalSystem->readFilterPeriodMXP(filterIndex, status);
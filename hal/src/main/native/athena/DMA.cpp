@@ -0,0 +1,801 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/DMA.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <support/mutex.h>
+
+#include "AnalogInternal.h"
+#include "DigitalInternal.h"
+#include "EncoderInternal.h"
+#include "HAL/AnalogAccumulator.h"
+#include "HAL/ChipObject.h"
+#include "HAL/Errors.h"
+#include "HAL/HAL.h"
+#include "HAL/cpp/UnsafeDIO.h"
+#include "HAL/handles/HandlesInternal.h"
+#include "HAL/handles/LimitedHandleResource.h"
+#include "PortsInternal.h"
+
+using namespace hal;
+
+// Position of each value in the capture, in the order the FPGA writes them
+enum DMAOffsetConstants {
+  kEnable_AI0_Low = 0,
+  kEnable_AI0_High = 1,
+  kEnable_AIAveraged0_Low = 2,
+  kEnable_AIAveraged0_High = 3,
+  kEnable_AI1_Low = 4,
+  kEnable_AI1_High = 5,
+  kEnable_AIAveraged1_Low = 6,
+  kEnable_AIAveraged1_High = 7,
+  kEnable_Accumulator0 = 8,
+  kEnable_Accumulator1 = 9,
+  kEnable_DI = 10,
+  kEnable_AnalogTriggers = 11,
+  kEnable_Counters_Low = 12,
+  kEnable_Counters_High = 13,
+  kEnable_CounterTimers_Low = 14,
+  kEnable_CounterTimers_High = 15,
+  kEnable_Encoders_Low = 16,
+  kEnable_Encoders_High = 17,
+  kEnable_EncoderTimers_Low = 18,
+  kEnable_EncoderTimers_High = 19,
+};
+
+// Number of 32-bit words each value occupies in a capture
+static constexpr int32_t kChannelSize[HAL_kDMANumChannels] = {
+    2, 2, 4, 4, 2, 2, 4, 4, 3, 3, 2, 1, 4, 4, 4, 4, 4, 4, 4, 4};
+
+static constexpr int32_t kNumExternalTriggers =
+    tDMA::kNumExternalTriggersRegisters * tDMA::kNumExternalTriggersElements;
+
+namespace {
+
+struct DMA {
+  std::unique_ptr<tDMA> aDMA;
+  std::unique_ptr<tDMAManager> manager;
+  HAL_DMASample captureStore;
+  int32_t queueDepth = 0;
+
+  // staging buffer for reading several samples in one transfer
+  wpi::mutex readMutex;
+  std::vector<uint32_t> readBuffer;
+};
+
+}  // namespace
+
+static LimitedHandleResource<HAL_DMAHandle, DMA, 1, HAL_HandleEnum::DMA>*
+    dmaHandles;
+
+namespace hal {
+namespace init {
+void InitializeDMA() {
+  static LimitedHandleResource<HAL_DMAHandle, DMA, 1, HAL_HandleEnum::DMA> dH;
+  dmaHandles = &dH;
+}
+}  // namespace init
+}  // namespace hal
+
+// Returns the DMA for a handle if sources may still be added to it
+static std::shared_ptr<DMA> GetConfigurableDMA(HAL_DMAHandle handle,
+                                               int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return nullptr;
+  }
+  if (dma->manager) {
+    *status = HAL_INVALID_DMA_ADDITION;
+    return nullptr;
+  }
+  return dma;
+}
+
+// Expands the low 32 bits of FPGA time captured with a sample, given the
+// current FPGA time. Samples are assumed to be less than 2^32 us (about 71
+// minutes) old.
+static uint64_t ExpandFPGATime(uint32_t lower, uint64_t now) {
+  uint64_t upper = now >> 32;
+  // the lower word rolled over since the sample was taken
+  if (lower > static_cast<uint32_t>(now) && upper > 0) upper--;
+  return (upper << 32) + lower;
+}
+
+static uint32_t ReadDMAValue(const HAL_DMASample& dma, int valueType,
+                             int index, int32_t* status) {
+  auto offset = dma.channelOffsets[valueType];
+  if (offset == -1) {
+    *status = NiFpga_Status_ResourceNotFound;
+    return 0;
+  }
+  return dma.readBuffer[offset + index];
+}
+
+extern "C" {
+
+HAL_DMAHandle HAL_InitializeDMA(int32_t* status) {
+  initializeDigital(status);
+  if (*status != 0) return HAL_kInvalidHandle;
+
+  HAL_DMAHandle handle = dmaHandles->Allocate();
+  if (handle == HAL_kInvalidHandle) {
+    *status = NO_AVAILABLE_RESOURCES;
+    return HAL_kInvalidHandle;
+  }
+
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {  // would only occur on thread issues
+    *status = HAL_HANDLE_ERROR;
+    return HAL_kInvalidHandle;
+  }
+
+  std::memset(&dma->captureStore, 0, sizeof(dma->captureStore));
+
+  dma->aDMA.reset(tDMA::create(status));
+  if (*status != 0) {
+    dmaHandles->Free(handle);
+    return HAL_kInvalidHandle;
+  }
+
+  // start paused, with nothing captured and no external triggers
+  tDMA::tConfig config;
+  config.value = 0;
+  config.Pause = true;
+  dma->aDMA->writeConfig(config, status);
+  dma->aDMA->writeRate(1, status);
+
+  tDMA::tExternalTriggers newTrigger;
+  newTrigger.value = 0;
+  for (unsigned char reg = 0; reg < tDMA::kNumExternalTriggersRegisters;
+       reg++) {
+    for (unsigned char bit = 0; bit < tDMA::kNumExternalTriggersElements;
+         bit++) {
+      dma->aDMA->writeExternalTriggers(reg, bit, newTrigger, status);
+    }
+  }
+
+  return handle;
+}
+
+void HAL_FreeDMA(HAL_DMAHandle handle) {
+  auto dma = dmaHandles->Get(handle);
+  dmaHandles->Free(handle);
+
+  if (!dma) return;
+
+  int32_t status = 0;
+  if (dma->manager) dma->manager->stop(&status);
+}
+
+void HAL_SetDMAPause(HAL_DMAHandle handle, HAL_Bool pause, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  dma->aDMA->writeConfig_Pause(pause, status);
+}
+
+void HAL_SetDMARate(HAL_DMAHandle handle, int32_t cycles, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  if (cycles < 1) cycles = 1;
+
+  dma->aDMA->writeRate(static_cast<uint32_t>(cycles), status);
+}
+
+void HAL_AddDMAEncoder(HAL_DMAHandle handle, HAL_EncoderHandle encoderHandle,
+                       int32_t* status) {
+  // 1X and 2X encoders are implemented with counters
+  HAL_FPGAEncoderHandle fpgaEncoderHandle = HAL_kInvalidHandle;
+  HAL_CounterHandle counterHandle = HAL_kInvalidHandle;
+  if (!GetEncoderBaseHandle(encoderHandle, &fpgaEncoderHandle,
+                            &counterHandle)) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (counterHandle != HAL_kInvalidHandle) {
+    HAL_AddDMACounter(handle, counterHandle, status);
+    return;
+  }
+
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  int32_t index = getHandleIndex(fpgaEncoderHandle);
+  if (index < 4) {
+    dma->aDMA->writeConfig_Enable_Encoders_Low(true, status);
+  } else if (index < 8) {
+    dma->aDMA->writeConfig_Enable_Encoders_High(true, status);
+  } else {
+    *status = NiFpga_Status_InvalidParameter;
+  }
+}
+
+void HAL_AddDMAEncoderPeriod(HAL_DMAHandle handle,
+                             HAL_EncoderHandle encoderHandle,
+                             int32_t* status) {
+  HAL_FPGAEncoderHandle fpgaEncoderHandle = HAL_kInvalidHandle;
+  HAL_CounterHandle counterHandle = HAL_kInvalidHandle;
+  if (!GetEncoderBaseHandle(encoderHandle, &fpgaEncoderHandle,
+                            &counterHandle)) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (counterHandle != HAL_kInvalidHandle) {
+    HAL_AddDMACounterPeriod(handle, counterHandle, status);
+    return;
+  }
+
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  int32_t index = getHandleIndex(fpgaEncoderHandle);
+  if (index < 4) {
+    dma->aDMA->writeConfig_Enable_EncoderTimers_Low(true, status);
+  } else if (index < 8) {
+    dma->aDMA->writeConfig_Enable_EncoderTimers_High(true, status);
+  } else {
+    *status = NiFpga_Status_InvalidParameter;
+  }
+}
+
+void HAL_AddDMACounter(HAL_DMAHandle handle, HAL_CounterHandle counterHandle,
+                       int32_t* status) {
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  if (!isHandleType(counterHandle, HAL_HandleEnum::Counter)) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  int32_t index = getHandleIndex(counterHandle);
+  if (index < 4) {
+    dma->aDMA->writeConfig_Enable_Counters_Low(true, status);
+  } else if (index < 8) {
+    dma->aDMA->writeConfig_Enable_Counters_High(true, status);
+  } else {
+    *status = NiFpga_Status_InvalidParameter;
+  }
+}
+
+void HAL_AddDMACounterPeriod(HAL_DMAHandle handle,
+                             HAL_CounterHandle counterHandle,
+                             int32_t* status) {
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  if (!isHandleType(counterHandle, HAL_HandleEnum::Counter)) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  int32_t index = getHandleIndex(counterHandle);
+  if (index < 4) {
+    dma->aDMA->writeConfig_Enable_CounterTimers_Low(true, status);
+  } else if (index < 8) {
+    dma->aDMA->writeConfig_Enable_CounterTimers_High(true, status);
+  } else {
+    *status = NiFpga_Status_InvalidParameter;
+  }
+}
+
+void HAL_AddDMADigitalSource(HAL_DMAHandle handle,
+                             HAL_Handle digitalSourceHandle, int32_t* status) {
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  if (isHandleType(digitalSourceHandle, HAL_HandleEnum::AnalogTrigger)) {
+    dma->aDMA->writeConfig_Enable_AnalogTriggers(true, status);
+  } else if (isHandleType(digitalSourceHandle, HAL_HandleEnum::DIO)) {
+    dma->aDMA->writeConfig_Enable_DI(true, status);
+  } else {
+    *status = HAL_HANDLE_ERROR;
+  }
+}
+
+void HAL_AddDMAAnalogInput(HAL_DMAHandle handle,
+                           HAL_AnalogInputHandle aInHandle, int32_t* status) {
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  if (!isHandleType(aInHandle, HAL_HandleEnum::AnalogInput)) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  int32_t index = getHandleIndex(aInHandle);
+  if (index < 4) {
+    dma->aDMA->writeConfig_Enable_AI0_Low(true, status);
+  } else if (index < 8) {
+    dma->aDMA->writeConfig_Enable_AI0_High(true, status);
+  } else {
+    *status = NiFpga_Status_InvalidParameter;
+  }
+}
+
+void HAL_AddDMAAveragedAnalogInput(HAL_DMAHandle handle,
+                                   HAL_AnalogInputHandle aInHandle,
+                                   int32_t* status) {
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  if (!isHandleType(aInHandle, HAL_HandleEnum::AnalogInput)) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  int32_t index = getHandleIndex(aInHandle);
+  if (index < 4) {
+    dma->aDMA->writeConfig_Enable_AIAveraged0_Low(true, status);
+  } else if (index < 8) {
+    dma->aDMA->writeConfig_Enable_AIAveraged0_High(true, status);
+  } else {
+    *status = NiFpga_Status_InvalidParameter;
+  }
+}
+
+void HAL_AddDMAAnalogAccumulator(HAL_DMAHandle handle,
+                                 HAL_AnalogInputHandle aInHandle,
+                                 int32_t* status) {
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  if (!HAL_IsAccumulatorChannel(aInHandle, status)) {
+    *status = HAL_INVALID_ACCUMULATOR_CHANNEL;
+    return;
+  }
+
+  int32_t index = getHandleIndex(aInHandle);
+  if (index == static_cast<int32_t>(kAccumulatorChannels[0])) {
+    dma->aDMA->writeConfig_Enable_Accumulator0(true, status);
+  } else if (index == static_cast<int32_t>(kAccumulatorChannels[1])) {
+    dma->aDMA->writeConfig_Enable_Accumulator1(true, status);
+  } else {
+    *status = NiFpga_Status_InvalidParameter;
+  }
+}
+
+void HAL_SetDMAExternalTrigger(HAL_DMAHandle handle,
+                               HAL_Handle digitalSourceHandle,
+                               HAL_AnalogTriggerType analogTriggerType,
+                               HAL_Bool rising, HAL_Bool falling,
+                               int32_t* status) {
+  auto dma = GetConfigurableDMA(handle, status);
+  if (!dma) return;
+
+  // find a free trigger slot
+  int32_t index = 0;
+  auto triggerChannels = dma->captureStore.triggerChannels;
+  while (index < kNumExternalTriggers && ((triggerChannels >> index) & 1)) {
+    index++;
+  }
+  if (index == kNumExternalTriggers) {
+    *status = NO_AVAILABLE_RESOURCES;
+    return;
+  }
+
+  uint8_t pin = 0;
+  uint8_t module = 0;
+  bool analogTrigger = false;
+  if (!remapDigitalSource(digitalSourceHandle, analogTriggerType, pin, module,
+                          analogTrigger)) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  // samples are now clocked by the triggers rather than the timer
+  if (!dma->aDMA->readConfig_ExternalClock(status)) {
+    dma->aDMA->writeConfig_ExternalClock(true, status);
+  }
+  if (*status != 0) return;
+
+  tDMA::tExternalTriggers newTrigger;
+  newTrigger.value = 0;
+  newTrigger.FallingEdge = falling;
+  newTrigger.RisingEdge = rising;
+  newTrigger.ExternalClockSource_AnalogTrigger = analogTrigger;
+  newTrigger.ExternalClockSource_Channel = pin;
+  newTrigger.ExternalClockSource_Module = module;
+
+  dma->aDMA->writeExternalTriggers(index / tDMA::kNumExternalTriggersElements,
+                                   index % tDMA::kNumExternalTriggersElements,
+                                   newTrigger, status);
+  if (*status == 0) dma->captureStore.triggerChannels |= (1 << index);
+}
+
+void HAL_StartDMA(HAL_DMAHandle handle, int32_t queueDepth, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  if (dma->manager) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+
+  if (queueDepth < 1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  tDMA::tConfig config = dma->aDMA->readConfig(status);
+  if (*status != 0) return;
+
+  // lay out the capture from the enabled values
+  {
+    uint32_t enabled[HAL_kDMANumChannels] = {
+        config.Enable_AI0_Low,           config.Enable_AI0_High,
+        config.Enable_AIAveraged0_Low,   config.Enable_AIAveraged0_High,
+        config.Enable_AI1_Low,           config.Enable_AI1_High,
+        config.Enable_AIAveraged1_Low,   config.Enable_AIAveraged1_High,
+        config.Enable_Accumulator0,      config.Enable_Accumulator1,
+        config.Enable_DI,                config.Enable_AnalogTriggers,
+        config.Enable_Counters_Low,      config.Enable_Counters_High,
+        config.Enable_CounterTimers_Low, config.Enable_CounterTimers_High,
+        config.Enable_Encoders_Low,      config.Enable_Encoders_High,
+        config.Enable_EncoderTimers_Low, config.Enable_EncoderTimers_High};
+    int32_t accumSize = 0;
+    for (int32_t i = 0; i < HAL_kDMANumChannels; i++) {
+      if (enabled[i]) {
+        dma->captureStore.channelOffsets[i] = accumSize;
+        accumSize += kChannelSize[i];
+      } else {
+        dma->captureStore.channelOffsets[i] = -1;
+      }
+    }
+    // the FPGA appends the low word of the timestamp
+    dma->captureStore.captureSize = accumSize + 1;
+  }
+
+  dma->queueDepth = queueDepth;
+  {
+    std::lock_guard<wpi::mutex> lock(dma->readMutex);
+    dma->readBuffer.assign(
+        static_cast<size_t>(queueDepth) * dma->captureStore.captureSize, 0);
+  }
+
+  tDMAChannelDescriptor desc;
+  dma->aDMA->getSystemInterface()->getDmaDescriptor(g_DMA_index, &desc);
+  dma->manager = std::make_unique<tDMAManager>(
+      desc.channel, queueDepth * dma->captureStore.captureSize, status);
+  if (*status != 0) {
+    dma->manager.reset();
+    return;
+  }
+
+  // restart once to flush any stale data left in the FIFO
+  dma->manager->start(status);
+  dma->manager->stop(status);
+  dma->manager->start(status);
+  if (*status != 0) return;
+
+  dma->aDMA->writeConfig_Pause(false, status);
+}
+
+void HAL_StopDMA(HAL_DMAHandle handle, int32_t* status) {
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  if (dma->manager) {
+    dma->aDMA->writeConfig_Pause(true, status);
+    *status = 0;
+    dma->manager->stop(status);
+    dma->manager.reset();
+  }
+}
+
+int32_t HAL_ReadDMASamples(HAL_DMAHandle handle,
+                           struct HAL_DMASample* dmaSamples, int32_t count,
+                           int32_t timeoutMs, int32_t* remainingOut,
+                           int32_t* status) {
+  *remainingOut = 0;
+  auto dma = dmaHandles->Get(handle);
+  if (!dma) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+
+  if (!dma->manager) {
+    *status = HAL_INVALID_DMA_STATE;
+    return 0;
+  }
+
+  if (count < 1) return 0;
+
+  std::lock_guard<wpi::mutex> lock(dma->readMutex);
+  size_t captureSize = dma->captureStore.captureSize;
+  size_t remainingWords = 0;
+
+  // wait for the first sample, then take whatever else is already queued
+  dma->manager->read(dma->readBuffer.data(), captureSize, timeoutMs,
+                     &remainingWords, status);
+  if (*status == NiFpga_Status_FifoTimeout) {
+    *status = 0;
+    return 0;
+  }
+  if (*status != 0) return 0;
+
+  size_t numRead = 1 + std::min({static_cast<size_t>(count - 1),
+                                 static_cast<size_t>(dma->queueDepth - 1),
+                                 remainingWords / captureSize});
+  if (numRead > 1) {
+    dma->manager->read(dma->readBuffer.data() + captureSize,
+                       (numRead - 1) * captureSize, 0, &remainingWords,
+                       status);
+    if (*status != 0) return 0;
+  }
+  *remainingOut = static_cast<int32_t>(remainingWords / captureSize);
+
+  // every sample was taken before now, so one time read expands them all
+  uint64_t now = HAL_GetFPGATime(status);
+  if (*status != 0) return 0;
+
+  for (size_t i = 0; i < numRead; i++) {
+    const uint32_t* words = dma->readBuffer.data() + i * captureSize;
+    HAL_DMASample& sample = dmaSamples[i];
+    std::memcpy(sample.readBuffer, words, captureSize * sizeof(uint32_t));
+    std::memcpy(sample.channelOffsets, dma->captureStore.channelOffsets,
+                sizeof(sample.channelOffsets));
+    sample.captureSize = dma->captureStore.captureSize;
+    sample.triggerChannels = dma->captureStore.triggerChannels;
+    sample.timeStamp = ExpandFPGATime(words[captureSize - 1], now);
+  }
+  return static_cast<int32_t>(numRead);
+}
+
+enum HAL_DMAReadStatus HAL_ReadDMA(HAL_DMAHandle handle,
+                                   struct HAL_DMASample* dmaSample,
+                                   int32_t timeoutMs, int32_t* remainingOut,
+                                   int32_t* status) {
+  int32_t numRead =
+      HAL_ReadDMASamples(handle, dmaSample, 1, timeoutMs, remainingOut, status);
+  if (*status != 0) return HAL_DMA_ERROR;
+  return numRead == 1 ? HAL_DMA_OK : HAL_DMA_TIMEOUT;
+}
+
+uint64_t HAL_GetDMASampleTime(const struct HAL_DMASample* dmaSample,
+                              int32_t* status) {
+  return dmaSample->timeStamp;
+}
+
+int32_t HAL_GetDMASampleEncoderRaw(const struct HAL_DMASample* dmaSample,
+                                   HAL_EncoderHandle encoderHandle,
+                                   int32_t* status) {
+  HAL_FPGAEncoderHandle fpgaEncoderHandle = HAL_kInvalidHandle;
+  HAL_CounterHandle counterHandle = HAL_kInvalidHandle;
+  if (!GetEncoderBaseHandle(encoderHandle, &fpgaEncoderHandle,
+                            &counterHandle)) {
+    *status = HAL_HANDLE_ERROR;
+    return -1;
+  }
+  if (counterHandle != HAL_kInvalidHandle) {
+    return HAL_GetDMASampleCounter(dmaSample, counterHandle, status);
+  }
+
+  int32_t index = getHandleIndex(fpgaEncoderHandle);
+  uint32_t dmaWord = 0;
+  if (index < 4) {
+    dmaWord = ReadDMAValue(*dmaSample, kEnable_Encoders_Low, index, status);
+  } else if (index < 8) {
+    dmaWord =
+        ReadDMAValue(*dmaSample, kEnable_Encoders_High, index - 4, status);
+  } else {
+    *status = NiFpga_Status_ResourceNotFound;
+  }
+  if (*status != 0) return -1;
+
+  // the low bit is the direction
+  return static_cast<int32_t>(dmaWord) >> 1;
+}
+
+int32_t HAL_GetDMASampleCounter(const struct HAL_DMASample* dmaSample,
+                                HAL_CounterHandle counterHandle,
+                                int32_t* status) {
+  if (!isHandleType(counterHandle, HAL_HandleEnum::Counter)) {
+    *status = HAL_HANDLE_ERROR;
+    return -1;
+  }
+
+  int32_t index = getHandleIndex(counterHandle);
+  uint32_t dmaWord = 0;
+  if (index < 4) {
+    dmaWord = ReadDMAValue(*dmaSample, kEnable_Counters_Low, index, status);
+  } else if (index < 8) {
+    dmaWord =
+        ReadDMAValue(*dmaSample, kEnable_Counters_High, index - 4, status);
+  } else {
+    *status = NiFpga_Status_ResourceNotFound;
+  }
+  if (*status != 0) return -1;
+
+  return static_cast<int32_t>(dmaWord) >> 1;
+}
+
+int32_t HAL_GetDMASampleEncoderPeriodRaw(const struct HAL_DMASample* dmaSample,
+                                         HAL_EncoderHandle encoderHandle,
+                                         int32_t* status) {
+  HAL_FPGAEncoderHandle fpgaEncoderHandle = HAL_kInvalidHandle;
+  HAL_CounterHandle counterHandle = HAL_kInvalidHandle;
+  if (!GetEncoderBaseHandle(encoderHandle, &fpgaEncoderHandle,
+                            &counterHandle)) {
+    *status = HAL_HANDLE_ERROR;
+    return -1;
+  }
+  if (counterHandle != HAL_kInvalidHandle) {
+    return HAL_GetDMASampleCounterPeriod(dmaSample, counterHandle, status);
+  }
+
+  int32_t index = getHandleIndex(fpgaEncoderHandle);
+  uint32_t dmaWord = 0;
+  if (index < 4) {
+    dmaWord =
+        ReadDMAValue(*dmaSample, kEnable_EncoderTimers_Low, index, status);
+  } else if (index < 8) {
+    dmaWord = ReadDMAValue(*dmaSample, kEnable_EncoderTimers_High, index - 4,
+                           status);
+  } else {
+    *status = NiFpga_Status_ResourceNotFound;
+  }
+  if (*status != 0) return -1;
+
+  // the upper bits hold the stalled flag and sample count
+  return static_cast<int32_t>(dmaWord) & 0x7FFFFF;
+}
+
+int32_t HAL_GetDMASampleCounterPeriod(const struct HAL_DMASample* dmaSample,
+                                      HAL_CounterHandle counterHandle,
+                                      int32_t* status) {
+  if (!isHandleType(counterHandle, HAL_HandleEnum::Counter)) {
+    *status = HAL_HANDLE_ERROR;
+    return -1;
+  }
+
+  int32_t index = getHandleIndex(counterHandle);
+  uint32_t dmaWord = 0;
+  if (index < 4) {
+    dmaWord =
+        ReadDMAValue(*dmaSample, kEnable_CounterTimers_Low, index, status);
+  } else if (index < 8) {
+    dmaWord = ReadDMAValue(*dmaSample, kEnable_CounterTimers_High, index - 4,
+                           status);
+  } else {
+    *status = NiFpga_Status_ResourceNotFound;
+  }
+  if (*status != 0) return -1;
+
+  return static_cast<int32_t>(dmaWord) & 0x7FFFFF;
+}
+
+HAL_Bool HAL_GetDMASampleDigitalSource(const struct HAL_DMASample* dmaSample,
+                                       HAL_Handle dSourceHandle,
+                                       int32_t* status) {
+  if (isHandleType(dSourceHandle, HAL_HandleEnum::DIO)) {
+    auto readVal = ReadDMAValue(*dmaSample, kEnable_DI, 0, status);
+    if (*status != 0) return false;
+    // the DI word has the same layout as the DIO output register
+    auto mask = detail::ComputeDigitalMask(dSourceHandle, status);
+    if (*status != 0) return false;
+    return (readVal & static_cast<uint32_t>(mask)) != 0;
+  } else if (isHandleType(dSourceHandle, HAL_HandleEnum::AnalogTrigger)) {
+    auto readVal = ReadDMAValue(*dmaSample, kEnable_AnalogTriggers, 0, status);
+    if (*status != 0) return false;
+    int32_t index = getHandleIndex(dSourceHandle);
+    if (index < 0 || index >= tAnalogTrigger::kNumOutputElements) {
+      *status = HAL_HANDLE_ERROR;
+      return false;
+    }
+    // each trigger contributes one tOutput nibble
+    tAnalogTrigger::tOutput output;
+    output.value = (readVal >> (index * 4)) & 0xF;
+    return output.InHysteresis || output.OverLimit;
+  }
+  *status = HAL_HANDLE_ERROR;
+  return false;
+}
+
+int32_t HAL_GetDMASampleAnalogInputRaw(const struct HAL_DMASample* dmaSample,
+                                       HAL_AnalogInputHandle aInHandle,
+                                       int32_t* status) {
+  if (!isHandleType(aInHandle, HAL_HandleEnum::AnalogInput)) {
+    *status = HAL_HANDLE_ERROR;
+    return -1;
+  }
+
+  int32_t index = getHandleIndex(aInHandle);
+  uint32_t dmaWord = 0;
+  // two 12-bit values are packed in each word
+  if (index < 4) {
+    dmaWord = ReadDMAValue(*dmaSample, kEnable_AI0_Low, index / 2, status);
+  } else if (index < 8) {
+    dmaWord =
+        ReadDMAValue(*dmaSample, kEnable_AI0_High, (index - 4) / 2, status);
+  } else {
+    *status = NiFpga_Status_ResourceNotFound;
+  }
+  if (*status != 0) return -1;
+
+  if (index % 2) {
+    return (dmaWord >> 16) & 0xffff;
+  } else {
+    return dmaWord & 0xffff;
+  }
+}
+
+int32_t HAL_GetDMASampleAveragedAnalogInputRaw(
+    const struct HAL_DMASample* dmaSample, HAL_AnalogInputHandle aInHandle,
+    int32_t* status) {
+  if (!isHandleType(aInHandle, HAL_HandleEnum::AnalogInput)) {
+    *status = HAL_HANDLE_ERROR;
+    return -1;
+  }
+
+  int32_t index = getHandleIndex(aInHandle);
+  uint32_t dmaWord = 0;
+  if (index < 4) {
+    dmaWord =
+        ReadDMAValue(*dmaSample, kEnable_AIAveraged0_Low, index, status);
+  } else if (index < 8) {
+    dmaWord = ReadDMAValue(*dmaSample, kEnable_AIAveraged0_High, index - 4,
+                           status);
+  } else {
+    *status = NiFpga_Status_ResourceNotFound;
+  }
+  if (*status != 0) return -1;
+
+  return static_cast<int32_t>(dmaWord);
+}
+
+void HAL_GetDMASampleAnalogAccumulator(const struct HAL_DMASample* dmaSample,
+                                       HAL_AnalogInputHandle aInHandle,
+                                       int64_t* count, int64_t* value,
+                                       int32_t* status) {
+  if (!HAL_IsAccumulatorChannel(aInHandle, status)) {
+    *status = HAL_INVALID_ACCUMULATOR_CHANNEL;
+    return;
+  }
+
+  int32_t index = getHandleIndex(aInHandle);
+  int valueType;
+  if (index == static_cast<int32_t>(kAccumulatorChannels[0])) {
+    valueType = kEnable_Accumulator0;
+  } else if (index == static_cast<int32_t>(kAccumulatorChannels[1])) {
+    valueType = kEnable_Accumulator1;
+  } else {
+    *status = NiFpga_Status_ResourceNotFound;
+    return;
+  }
+
+  // the count word is followed by the 64-bit value, high word first
+  uint32_t dmaCount = ReadDMAValue(*dmaSample, valueType, 0, status);
+  uint32_t dmaValueHigh = ReadDMAValue(*dmaSample, valueType, 1, status);
+  uint32_t dmaValueLow = ReadDMAValue(*dmaSample, valueType, 2, status);
+  if (*status != 0) return;
+
+  *count = dmaCount;
+  *value = static_cast<int64_t>(
+      (static_cast<uint64_t>(dmaValueHigh) << 32) | dmaValueLow);
+}
+
+}  // extern "C"
@@ -8,6 +8,7 @@
 #include "DigitalInternal.h"
 
 #include <atomic>
+#include <mutex>
 #include <thread>
 
 #include <FRC_NetworkCommunication/LoadOut.h>
@@ -28,8 +29,15 @@ std::unique_ptr<tRelay> relaySystem;
 std::unique_ptr<tPWM> pwmSystem;
 std::unique_ptr<tSPI> spiSystem;
 
-// Create a mutex to protect changes to the digital output values
 wpi::mutex digitalDIOMutex;
+wpi::mutex digitalOutputEnableMutex;
+wpi::mutex digitalFilterMutex;
+
+// The DO register as set by setDigitalOutputs(); the register may lag it while
+// a write is in progress
+static std::atomic<uint32_t> digitalOutputShadow{0};
+
+static void commitDigitalOutputs(int32_t* status);
 
 DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
                       kNumDigitalChannels + kNumPWMHeaders>*
@@ -46,6 +54,9 @@ void InitializeDigitalInternal() {
 
 namespace detail {
 wpi::mutex& UnsafeGetDIOMutex() { return digitalDIOMutex; }
+wpi::mutex& UnsafeGetDIOOutputEnableMutex() {
+  return digitalOutputEnableMutex;
+}
 tDIO* UnsafeGetDigialSystem() { return digitalSystem.get(); }
 int32_t ComputeDigitalMask(HAL_DigitalHandle handle, int32_t* status) {
   auto port = digitalChannelHandles->Get(handle, HAL_HandleEnum::DIO);
@@ -53,16 +64,17 @@ int32_t ComputeDigitalMask(HAL_DigitalHandle handle, int32_t* status) {
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
-  tDIO::tDO output;
-  output.value = 0;
-  if (port->channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
-    output.SPIPort = (1u << remapSPIChannel(port->channel));
-  } else if (port->channel < kNumDigitalHeaders) {
-    output.Headers = (1u << port->channel);
-  } else {
-    output.MXP = (1u << remapMXPChannel(port->channel));
+  return getDigitalOutputBit(port->channel);
+}
+void UnsafeSyncDIO(int32_t mask, int32_t* status) {
+  // Keep the states the functor left on its channel
+  uint32_t actual = digitalSystem->readDO(status).value;
+  uint32_t current = digitalOutputShadow.load();
+  while (!digitalOutputShadow.compare_exchange_weak(
+      current, (current & ~mask) | (actual & mask))) {
   }
-  return output.value;
+  // Write outputs set by other threads while the lock was held
+  commitDigitalOutputs(status);
 }
 }  // namespace detail
 
@@ -80,6 +92,7 @@ void initializeDigital(int32_t* status) {
   if (initialized) return;
 
   digitalSystem.reset(tDIO::create(status));
+  digitalOutputShadow = digitalSystem->readDO(status).value;
 
   // Relay Setup
   relaySystem.reset(tRelay::create(status));
@@ -145,6 +158,64 @@ int32_t remapSPIChannel(int32_t channel) { return channel - 26; }
  */
 int32_t remapMXPChannel(int32_t channel) { return channel - 10; }
 
+/**
+ * Get the bit of the DO register for a DIO channel. The output enable register
+ * has the same layout.
+ */
+uint32_t getDigitalOutputBit(int32_t channel) {
+  tDIO::tDO output;
+  output.value = 0;
+  if (channel >= kNumDigitalHeaders + kNumDigitalMXPChannels) {
+    output.SPIPort = (1u << remapSPIChannel(channel));
+  } else if (channel < kNumDigitalHeaders) {
+    output.Headers = (1u << channel);
+  } else {
+    output.MXP = (1u << remapMXPChannel(channel));
+  }
+  return output.value;
+}
+
+/**
+ * Set outputs in the DO register, which the header, MXP and SPI port channels
+ * share.
+ *
+ * The outputs are changed in a shadow of the register with a compare and swap,
+ * so channels never wait on each other to change it, and setting an output to
+ * the state it already has doesn't touch the FPGA. The thread that finds the
+ * register unlocked writes the shadow to it until the two match; a thread that
+ * finds it locked leaves its change to that writer instead of queueing behind
+ * it.
+ *
+ * @param mask   The register bits to change.
+ * @param values The new states of the bits in mask.
+ */
+void setDigitalOutputs(uint32_t mask, uint32_t values, int32_t* status) {
+  uint32_t current = digitalOutputShadow.load();
+  uint32_t next;
+  do {
+    next = (current & ~mask) | (values & mask);
+    if (next == current) return;
+  } while (!digitalOutputShadow.compare_exchange_weak(current, next));
+  commitDigitalOutputs(status);
+}
+
+static void commitDigitalOutputs(int32_t* status) {
+  uint32_t written;
+  do {
+    std::unique_lock<wpi::mutex> lock(digitalDIOMutex, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+    do {
+      written = digitalOutputShadow.load();
+      tDIO::tDO output;
+      output.value = written;
+      digitalSystem->writeDO(output, status);
+    } while (digitalOutputShadow.load() != written);
+    lock.unlock();
+    // A change made after the last check, by a thread that found the lock
+    // still held, is ours to write
+  } while (digitalOutputShadow.load() != written);
+}
+
 int32_t remapMXPPWMChannel(int32_t channel) {
   if (channel < 14) {
     return channel - 10;  // first block of 4 pwms (MXP 0-3)
@@ -79,7 +79,11 @@ extern DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
                              kNumDigitalChannels + kNumPWMHeaders>*
     digitalChannelHandles;
 
-extern wpi::mutex digitalDIOMutex;
+// Each register shared by all DIO channels has its own lock, so setting
+// outputs never waits on a direction or filter change
+extern wpi::mutex digitalDIOMutex;  // The DO register's writes
+extern wpi::mutex digitalOutputEnableMutex;  // Output enable, special functions
+extern wpi::mutex digitalFilterMutex;  // Filter selects and periods
 
 void initializeDigital(int32_t* status);
 bool remapDigitalSource(HAL_Handle digitalSourceHandle,
@@ -88,5 +92,7 @@ bool remapDigitalSource(HAL_Handle digitalSourceHandle,
 int32_t remapSPIChannel(int32_t channel);
 int32_t remapMXPPWMChannel(int32_t channel);
 int32_t remapMXPChannel(int32_t channel);
+uint32_t getDigitalOutputBit(int32_t channel);
+void setDigitalOutputs(uint32_t mask, uint32_t values, int32_t* status);
 
 }  // namespace hal
@@ -7,12 +7,26 @@
 
 #include "HAL/Encoder.h"
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include <support/mutex.h>
+
 #include "EncoderInternal.h"
 #include "FPGAEncoder.h"
 #include "HAL/ChipObject.h"
 #include "HAL/Counter.h"
 #include "HAL/Errors.h"
+#include "HAL/cpp/EncoderVelocityEstimator.h"
+#include "HAL/cpp/MemoryPool.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/handles/LimitedClassedHandleResource.h"
+#include "IORecordingInternal.h"
 #include "PortsInternal.h"
 
 using namespace hal;
@@ -192,6 +206,26 @@ int32_t Encoder::GetSamplesToAverage(int32_t* status) const {
   }
 }
 
+void Encoder::GetSnapshot(HAL_EncoderSnapshot* snapshot,
+                          int32_t* status) const {
+  HAL_CounterSnapshot base;
+  if (m_counter) {
+    HAL_GetCounterSnapshot(m_counter, &base, status);
+    base.period /= DecodingScaleFactor();
+  } else {
+    HAL_GetFPGAEncoderSnapshot(m_encoder, &base, status);
+  }
+  if (*status != 0) return;
+  snapshot->raw = base.count;
+  snapshot->count = static_cast<int32_t>(base.count * DecodingScaleFactor());
+  snapshot->distance = base.count * DecodingScaleFactor() * m_distancePerPulse;
+  snapshot->period = base.period;
+  snapshot->rate = m_distancePerPulse / base.period;
+  snapshot->direction = base.direction;
+  snapshot->stopped = base.stopped;
+  snapshot->timestamp = base.timestamp;
+}
+
 void Encoder::SetIndexSource(HAL_Handle digitalSourceHandle,
                              HAL_AnalogTriggerType analogTriggerType,
                              HAL_EncoderIndexingType type, int32_t* status) {
@@ -224,10 +258,149 @@ double Encoder::DecodingScaleFactor() const {
 static LimitedClassedHandleResource<HAL_EncoderHandle, Encoder,
                                     kNumEncoders + kNumCounters,
                                     HAL_HandleEnum::Encoder>* encoderHandles;
+static MemoryPool* encoderPool;
+
+static constexpr double kDefaultVelocityUpdatePeriod = 0.005;
+
+namespace {
+/**
+ * Samples every encoder that has a velocity estimator from a background
+ * thread, at a fixed rate, using snapshots so each count is paired with the
+ * FPGA time it was read at.
+ */
+class EncoderVelocityEngine {
+ public:
+  static EncoderVelocityEngine& GetInstance() {
+    static EncoderVelocityEngine instance;
+    return instance;
+  }
+
+  ~EncoderVelocityEngine();
+
+  void Configure(HAL_EncoderHandle handle, std::shared_ptr<Encoder> encoder,
+                 HAL_EncoderVelocityEstimatorType type, int32_t windowSize);
+  void Remove(HAL_EncoderHandle handle);
+  void Reset(HAL_EncoderHandle handle);
+  HAL_EncoderVelocityEstimatorType GetType(HAL_EncoderHandle handle);
+  // Returns false if the encoder has no estimator; the estimate is in counts
+  bool GetEstimate(HAL_EncoderHandle handle, double* velocity,
+                   double* acceleration);
+
+  void SetUpdatePeriod(double period) { m_period = period; }
+  double GetUpdatePeriod() const { return m_period; }
+
+ private:
+  struct Entry {
+    Entry(std::shared_ptr<Encoder> encoder,
+          HAL_EncoderVelocityEstimatorType type, int32_t windowSize)
+        : encoder(std::move(encoder)), estimator(type, windowSize) {}
+
+    std::shared_ptr<Encoder> encoder;
+    EncoderVelocityEstimator estimator;
+  };
+
+  void ThreadMain();
+
+  std::atomic<double> m_period{kDefaultVelocityUpdatePeriod};
+  // Lets rate reads skip the lock while no estimator is configured
+  std::atomic_bool m_empty{true};
+
+  wpi::mutex m_mutex;
+  std::unordered_map<HAL_EncoderHandle, Entry> m_entries;
+  std::atomic_bool m_active{false};
+  std::thread m_thread;
+};
+}  // namespace
+
+EncoderVelocityEngine::~EncoderVelocityEngine() {
+  m_active = false;
+  if (m_thread.joinable()) m_thread.join();
+}
+
+void EncoderVelocityEngine::Configure(HAL_EncoderHandle handle,
+                                      std::shared_ptr<Encoder> encoder,
+                                      HAL_EncoderVelocityEstimatorType type,
+                                      int32_t windowSize) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_entries.erase(handle);
+  if (type != HAL_EncoderVelocity_kPeriod) {
+    m_entries.emplace(std::piecewise_construct, std::forward_as_tuple(handle),
+                      std::forward_as_tuple(std::move(encoder), type,
+                                            windowSize));
+  }
+  m_empty = m_entries.empty();
+
+  if (!m_active && !m_entries.empty()) {
+    m_active = true;
+    m_thread = std::thread(&EncoderVelocityEngine::ThreadMain, this);
+  }
+}
+
+void EncoderVelocityEngine::Remove(HAL_EncoderHandle handle) {
+  if (m_empty) return;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_entries.erase(handle);
+  m_empty = m_entries.empty();
+}
+
+void EncoderVelocityEngine::Reset(HAL_EncoderHandle handle) {
+  if (m_empty) return;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_entries.find(handle);
+  if (it != m_entries.end()) it->second.estimator.Reset();
+}
+
+HAL_EncoderVelocityEstimatorType EncoderVelocityEngine::GetType(
+    HAL_EncoderHandle handle) {
+  if (m_empty) return HAL_EncoderVelocity_kPeriod;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_entries.find(handle);
+  if (it == m_entries.end()) return HAL_EncoderVelocity_kPeriod;
+  return it->second.estimator.GetType();
+}
+
+bool EncoderVelocityEngine::GetEstimate(HAL_EncoderHandle handle,
+                                        double* velocity,
+                                        double* acceleration) {
+  if (m_empty) return false;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_entries.find(handle);
+  if (it == m_entries.end()) return false;
+  *velocity = it->second.estimator.GetVelocity();
+  *acceleration = it->second.estimator.GetAcceleration();
+  return true;
+}
+
+void EncoderVelocityEngine::ThreadMain() {
+  using Clock = std::chrono::steady_clock;
+  auto next = Clock::now();
+  while (m_active) {
+    auto period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(m_period.load()));
+    next += period;
+    auto now = Clock::now();
+    // Skip missed samples instead of bunching them up
+    if (next < now) next = now + period;
+    std::this_thread::sleep_until(next);
+
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    for (auto& entry : m_entries) {
+      HAL_EncoderSnapshot snapshot;
+      int32_t status = 0;
+      entry.second.encoder->GetSnapshot(&snapshot, &status);
+      if (status != 0) continue;
+      entry.second.estimator.AddSample(snapshot.timestamp * 1.0e-6,
+                                       snapshot.raw);
+    }
+  }
+}
 
 namespace hal {
 namespace init {
 void InitializeEncoder() {
+  // Constructed first so it is destroyed after the encoders
+  static MemoryPool eP(SharedBlockSize<Encoder>(), kNumEncoders + kNumCounters);
+  encoderPool = &eP;
   static LimitedClassedHandleResource<HAL_EncoderHandle, Encoder,
                                       kNumEncoders + kNumCounters,
                                       HAL_HandleEnum::Encoder>
@@ -235,6 +408,16 @@ void InitializeEncoder() {
   encoderHandles = &eH;
 }
 }  // namespace init
+
+bool GetEncoderBaseHandle(HAL_EncoderHandle handle,
+                          HAL_FPGAEncoderHandle* fpgaEncoderHandle,
+                          HAL_CounterHandle* counterHandle) {
+  auto encoder = encoderHandles->GetBorrowed(handle);
+  if (encoder == nullptr) return false;
+  *fpgaEncoderHandle = encoder->GetFPGAEncoderHandle();
+  *counterHandle = encoder->GetCounterHandle();
+  return true;
+}
 }  // namespace hal
 
 extern "C" {
@@ -243,9 +426,10 @@ HAL_EncoderHandle HAL_InitializeEncoder(
     HAL_Handle digitalSourceHandleB, HAL_AnalogTriggerType analogTriggerTypeB,
     HAL_Bool reverseDirection, HAL_EncoderEncodingType encodingType,
     int32_t* status) {
-  auto encoder = std::make_shared<Encoder>(
-      digitalSourceHandleA, analogTriggerTypeA, digitalSourceHandleB,
-      analogTriggerTypeB, reverseDirection, encodingType, status);
+  auto encoder = MakePooled<Encoder>(
+      *encoderPool, digitalSourceHandleA, analogTriggerTypeA,
+      digitalSourceHandleB, analogTriggerTypeB, reverseDirection, encodingType,
+      status);
   if (*status != 0) return HAL_kInvalidHandle;  // return in creation error
   auto handle = encoderHandles->Allocate(encoder);
   if (handle == HAL_kInvalidHandle) {
@@ -256,20 +440,28 @@ HAL_EncoderHandle HAL_InitializeEncoder(
 }
 
 void HAL_FreeEncoder(HAL_EncoderHandle encoderHandle, int32_t* status) {
+  EncoderVelocityEngine::GetInstance().Remove(encoderHandle);
   encoderHandles->Free(encoderHandle);
 }
 
 int32_t HAL_GetEncoder(HAL_EncoderHandle encoderHandle, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterEncoder);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
-  return encoder->Get(status);
+  int32_t count = encoder->Get(status);
+  if (IsIORecording()) {
+    RecordIO(HAL_IORecord_kEncoderCount, getHandleIndex(encoderHandle),
+             count);
+  }
+  return count;
 }
 
 int32_t HAL_GetEncoderRaw(HAL_EncoderHandle encoderHandle, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterEncoder);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -279,7 +471,7 @@ int32_t HAL_GetEncoderRaw(HAL_EncoderHandle encoderHandle, int32_t* status) {
 
 int32_t HAL_GetEncoderEncodingScale(HAL_EncoderHandle encoderHandle,
                                     int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -288,26 +480,33 @@ int32_t HAL_GetEncoderEncodingScale(HAL_EncoderHandle encoderHandle,
 }
 
 void HAL_ResetEncoder(HAL_EncoderHandle encoderHandle, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
   }
   encoder->Reset(status);
+  EncoderVelocityEngine::GetInstance().Reset(encoderHandle);
 }
 
 double HAL_GetEncoderPeriod(HAL_EncoderHandle encoderHandle, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterEncoder);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
-  return encoder->GetPeriod(status);
+  double period = encoder->GetPeriod(status);
+  if (IsIORecording()) {
+    RecordIO(HAL_IORecord_kEncoderPeriod, getHandleIndex(encoderHandle), 0,
+             period);
+  }
+  return period;
 }
 
 void HAL_SetEncoderMaxPeriod(HAL_EncoderHandle encoderHandle, double maxPeriod,
                              int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -317,7 +516,8 @@ void HAL_SetEncoderMaxPeriod(HAL_EncoderHandle encoderHandle, double maxPeriod,
 
 HAL_Bool HAL_GetEncoderStopped(HAL_EncoderHandle encoderHandle,
                                int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterEncoder);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -327,7 +527,8 @@ HAL_Bool HAL_GetEncoderStopped(HAL_EncoderHandle encoderHandle,
 
 HAL_Bool HAL_GetEncoderDirection(HAL_EncoderHandle encoderHandle,
                                  int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterEncoder);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -337,7 +538,8 @@ HAL_Bool HAL_GetEncoderDirection(HAL_EncoderHandle encoderHandle,
 
 double HAL_GetEncoderDistance(HAL_EncoderHandle encoderHandle,
                               int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterEncoder);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -346,17 +548,24 @@ double HAL_GetEncoderDistance(HAL_EncoderHandle encoderHandle,
 }
 
 double HAL_GetEncoderRate(HAL_EncoderHandle encoderHandle, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterEncoder);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
+  double velocity, acceleration;
+  if (EncoderVelocityEngine::GetInstance().GetEstimate(
+          encoderHandle, &velocity, &acceleration)) {
+    return velocity * encoder->DecodingScaleFactor() *
+           encoder->GetDistancePerPulse();
+  }
   return encoder->GetRate(status);
 }
 
 void HAL_SetEncoderMinRate(HAL_EncoderHandle encoderHandle, double minRate,
                            int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -366,7 +575,7 @@ void HAL_SetEncoderMinRate(HAL_EncoderHandle encoderHandle, double minRate,
 
 void HAL_SetEncoderDistancePerPulse(HAL_EncoderHandle encoderHandle,
                                     double distancePerPulse, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -377,7 +586,7 @@ void HAL_SetEncoderDistancePerPulse(HAL_EncoderHandle encoderHandle,
 void HAL_SetEncoderReverseDirection(HAL_EncoderHandle encoderHandle,
                                     HAL_Bool reverseDirection,
                                     int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -387,7 +596,7 @@ void HAL_SetEncoderReverseDirection(HAL_EncoderHandle encoderHandle,
 
 void HAL_SetEncoderSamplesToAverage(HAL_EncoderHandle encoderHandle,
                                     int32_t samplesToAverage, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -397,7 +606,7 @@ void HAL_SetEncoderSamplesToAverage(HAL_EncoderHandle encoderHandle,
 
 int32_t HAL_GetEncoderSamplesToAverage(HAL_EncoderHandle encoderHandle,
                                        int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -407,7 +616,7 @@ int32_t HAL_GetEncoderSamplesToAverage(HAL_EncoderHandle encoderHandle,
 
 double HAL_GetEncoderDecodingScaleFactor(HAL_EncoderHandle encoderHandle,
                                          int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -417,7 +626,7 @@ double HAL_GetEncoderDecodingScaleFactor(HAL_EncoderHandle encoderHandle,
 
 double HAL_GetEncoderDistancePerPulse(HAL_EncoderHandle encoderHandle,
                                       int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -427,7 +636,7 @@ double HAL_GetEncoderDistancePerPulse(HAL_EncoderHandle encoderHandle,
 
 HAL_EncoderEncodingType HAL_GetEncoderEncodingType(
     HAL_EncoderHandle encoderHandle, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return HAL_Encoder_k4X;  // default to k4X
@@ -439,7 +648,7 @@ void HAL_SetEncoderIndexSource(HAL_EncoderHandle encoderHandle,
                                HAL_Handle digitalSourceHandle,
                                HAL_AnalogTriggerType analogTriggerType,
                                HAL_EncoderIndexingType type, int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -449,7 +658,7 @@ void HAL_SetEncoderIndexSource(HAL_EncoderHandle encoderHandle,
 
 int32_t HAL_GetEncoderFPGAIndex(HAL_EncoderHandle encoderHandle,
                                 int32_t* status) {
-  auto encoder = encoderHandles->Get(encoderHandle);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -457,4 +666,74 @@ int32_t HAL_GetEncoderFPGAIndex(HAL_EncoderHandle encoderHandle,
   return encoder->GetFPGAIndex();
 }
 
+void HAL_GetEncoderSnapshot(HAL_EncoderHandle encoderHandle,
+                            HAL_EncoderSnapshot* snapshot, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterEncoder);
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
+  if (encoder == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  encoder->GetSnapshot(snapshot, status);
+}
+
+void HAL_SetEncoderVelocityEstimator(HAL_EncoderHandle encoderHandle,
+                                     HAL_EncoderVelocityEstimatorType type,
+                                     int32_t windowSize, int32_t* status) {
+  auto encoder = encoderHandles->Get(encoderHandle);
+  if (encoder == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (type < HAL_EncoderVelocity_kPeriod ||
+      type > HAL_EncoderVelocity_kAdaptiveWindow ||
+      (type != HAL_EncoderVelocity_kPeriod &&
+       (windowSize < 2 || windowSize > HAL_kMaxEncoderVelocityWindow))) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  EncoderVelocityEngine::GetInstance().Configure(encoderHandle, encoder, type,
+                                                 windowSize);
+}
+
+HAL_EncoderVelocityEstimatorType HAL_GetEncoderVelocityEstimator(
+    HAL_EncoderHandle encoderHandle, int32_t* status) {
+  if (encoderHandles->GetBorrowed(encoderHandle) == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return HAL_EncoderVelocity_kPeriod;
+  }
+  return EncoderVelocityEngine::GetInstance().GetType(encoderHandle);
+}
+
+void HAL_SetEncoderVelocityUpdatePeriod(double period, int32_t* status) {
+  if (period < 0.001 || period > 0.1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  EncoderVelocityEngine::GetInstance().SetUpdatePeriod(period);
+}
+
+double HAL_GetEncoderVelocityUpdatePeriod(void) {
+  return EncoderVelocityEngine::GetInstance().GetUpdatePeriod();
+}
+
+void HAL_GetEncoderVelocityEstimate(HAL_EncoderHandle encoderHandle,
+                                    double* velocity, double* acceleration,
+                                    int32_t* status) {
+  auto encoder = encoderHandles->GetBorrowed(encoderHandle);
+  if (encoder == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (!EncoderVelocityEngine::GetInstance().GetEstimate(
+          encoderHandle, velocity, acceleration)) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+  double scale =
+      encoder->DecodingScaleFactor() * encoder->GetDistancePerPulse();
+  *velocity *= scale;
+  *acceleration *= scale;
+}
+
 }  // extern "C"
@@ -40,6 +40,8 @@ class Encoder {
   void SetSamplesToAverage(int32_t samplesToAverage, int32_t* status);
   int32_t GetSamplesToAverage(int32_t* status) const;
 
+  void GetSnapshot(HAL_EncoderSnapshot* snapshot, int32_t* status) const;
+
   void SetIndexSource(HAL_Handle digitalSourceHandle,
                       HAL_AnalogTriggerType analogTriggerType,
                       HAL_EncoderIndexingType type, int32_t* status);
@@ -54,6 +56,10 @@ class Encoder {
 
   HAL_EncoderEncodingType GetEncodingType() const { return m_encodingType; }
 
+  HAL_FPGAEncoderHandle GetFPGAEncoderHandle() const { return m_encoder; }
+
+  HAL_CounterHandle GetCounterHandle() const { return m_counter; }
+
  private:
   void SetupCounter(HAL_Handle digitalSourceHandleA,
                     HAL_AnalogTriggerType analogTriggerTypeA,
@@ -75,4 +81,10 @@ class Encoder {
   int32_t m_encodingScale;
 };
 
+// Returns the FPGA encoder or counter backing an encoder; the other handle is
+// set to HAL_kInvalidHandle. Returns false if the encoder handle is invalid.
+bool GetEncoderBaseHandle(HAL_EncoderHandle handle,
+                          HAL_FPGAEncoderHandle* fpgaEncoderHandle,
+                          HAL_CounterHandle* counterHandle);
+
 }  // namespace hal
@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "DigitalInternal.h"
+#include "HAL/HAL.h"
 #include "HAL/handles/LimitedHandleResource.h"
 #include "PortsInternal.h"
 
@@ -40,6 +41,22 @@ void InitializeFPGAEncoder() {
 }  // namespace init
 }  // namespace hal
 
+static double DecodePeriod(tEncoder::tTimerOutput output) {
+  double value;
+  if (output.Stalled) {
+    // Return infinity
+    double zero = 0.0;
+    value = 1.0 / zero;
+  } else {
+    // output.Period is a fixed point number that counts by 2 (24 bits, 25
+    // integer bits)
+    value = static_cast<double>(output.Period << 1) /
+            static_cast<double>(output.Count);
+  }
+  double measuredPeriod = value * 2.5e-8;
+  return measuredPeriod / DECODING_SCALING_FACTOR;
+}
+
 extern "C" {
 
 HAL_FPGAEncoderHandle HAL_InitializeFPGAEncoder(
@@ -70,7 +87,7 @@ HAL_FPGAEncoderHandle HAL_InitializeFPGAEncoder(
     return HAL_kInvalidHandle;
   }
 
-  auto encoder = fpgaEncoderHandles->Get(handle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(handle);
   if (encoder == nullptr) {  // will only error on thread issue
     *status = HAL_HANDLE_ERROR;
     return HAL_kInvalidHandle;
@@ -106,7 +123,7 @@ void HAL_FreeFPGAEncoder(HAL_FPGAEncoderHandle fpgaEncoderHandle,
  */
 void HAL_ResetFPGAEncoder(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                           int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -122,7 +139,7 @@ void HAL_ResetFPGAEncoder(HAL_FPGAEncoderHandle fpgaEncoderHandle,
  */
 int32_t HAL_GetFPGAEncoder(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                            int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -142,25 +159,12 @@ int32_t HAL_GetFPGAEncoder(HAL_FPGAEncoderHandle fpgaEncoderHandle,
  */
 double HAL_GetFPGAEncoderPeriod(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                                 int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0.0;
   }
-  tEncoder::tTimerOutput output = encoder->encoder->readTimerOutput(status);
-  double value;
-  if (output.Stalled) {
-    // Return infinity
-    double zero = 0.0;
-    value = 1.0 / zero;
-  } else {
-    // output.Period is a fixed point number that counts by 2 (24 bits, 25
-    // integer bits)
-    value = static_cast<double>(output.Period << 1) /
-            static_cast<double>(output.Count);
-  }
-  double measuredPeriod = value * 2.5e-8;
-  return measuredPeriod / DECODING_SCALING_FACTOR;
+  return DecodePeriod(encoder->encoder->readTimerOutput(status));
 }
 
 /**
@@ -179,7 +183,7 @@ double HAL_GetFPGAEncoderPeriod(HAL_FPGAEncoderHandle fpgaEncoderHandle,
  */
 void HAL_SetFPGAEncoderMaxPeriod(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                                  double maxPeriod, int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -198,7 +202,7 @@ void HAL_SetFPGAEncoderMaxPeriod(HAL_FPGAEncoderHandle fpgaEncoderHandle,
  */
 HAL_Bool HAL_GetFPGAEncoderStopped(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                                    int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -212,7 +216,7 @@ HAL_Bool HAL_GetFPGAEncoderStopped(HAL_FPGAEncoderHandle fpgaEncoderHandle,
  */
 HAL_Bool HAL_GetFPGAEncoderDirection(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                                      int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return false;
@@ -229,7 +233,7 @@ HAL_Bool HAL_GetFPGAEncoderDirection(HAL_FPGAEncoderHandle fpgaEncoderHandle,
 void HAL_SetFPGAEncoderReverseDirection(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                                         HAL_Bool reverseDirection,
                                         int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -246,7 +250,7 @@ void HAL_SetFPGAEncoderReverseDirection(HAL_FPGAEncoderHandle fpgaEncoderHandle,
 void HAL_SetFPGAEncoderSamplesToAverage(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                                         int32_t samplesToAverage,
                                         int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -265,7 +269,7 @@ void HAL_SetFPGAEncoderSamplesToAverage(HAL_FPGAEncoderHandle fpgaEncoderHandle,
  */
 int32_t HAL_GetFPGAEncoderSamplesToAverage(
     HAL_FPGAEncoderHandle fpgaEncoderHandle, int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -282,7 +286,7 @@ void HAL_SetFPGAEncoderIndexSource(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                                    HAL_AnalogTriggerType analogTriggerType,
                                    HAL_Bool activeHigh, HAL_Bool edgeSensitive,
                                    int32_t* status) {
-  auto encoder = fpgaEncoderHandles->Get(fpgaEncoderHandle);
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
   if (encoder == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -307,4 +311,27 @@ void HAL_SetFPGAEncoderIndexSource(HAL_FPGAEncoderHandle fpgaEncoderHandle,
   encoder->encoder->writeConfig_IndexEdgeSensitive(edgeSensitive, status);
 }
 
+/**
+ * Read the count, direction, period and stopped state of the encoder at once.
+ * The period is compensated for the decoding type like
+ * HAL_GetFPGAEncoderPeriod().
+ */
+void HAL_GetFPGAEncoderSnapshot(HAL_FPGAEncoderHandle fpgaEncoderHandle,
+                                HAL_CounterSnapshot* snapshot,
+                                int32_t* status) {
+  auto encoder = fpgaEncoderHandles->GetBorrowed(fpgaEncoderHandle);
+  if (encoder == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  tEncoder::tOutput output = encoder->encoder->readOutput(status);
+  tEncoder::tTimerOutput timerOutput =
+      encoder->encoder->readTimerOutput(status);
+  snapshot->timestamp = HAL_GetFPGATime(status);
+  snapshot->count = output.Value;
+  snapshot->direction = output.Direction;
+  snapshot->period = DecodePeriod(timerOutput);
+  snapshot->stopped = timerOutput.Stalled;
+}
+
 }  // extern "C"
@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include "HAL/AnalogTrigger.h"
+#include "HAL/Counter.h"
 #include "HAL/Types.h"
 
 extern "C" {
@@ -45,5 +46,8 @@ void HAL_SetFPGAEncoderIndexSource(HAL_FPGAEncoderHandle fpgaEncoderHandle,
                                    HAL_AnalogTriggerType analogTriggerType,
                                    HAL_Bool activeHigh, HAL_Bool edgeSensitive,
                                    int32_t* status);
+void HAL_GetFPGAEncoderSnapshot(HAL_FPGAEncoderHandle fpgaEncoderHandle,
+                                HAL_CounterSnapshot* snapshot,
+                                int32_t* status);
 
 }  // extern "C"
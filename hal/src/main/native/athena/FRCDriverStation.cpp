@@ -5,6 +5,7 @@
 /* the project.                                                               */
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdlib>
@@ -18,6 +19,9 @@
 #include <support/mutex.h>
 
 #include "HAL/DriverStation.h"
+#include "HAL/cpp/PerfCounters.h"
+#include "IORecordingInternal.h"
+#include "UsageReportingInternal.h"
 
 static_assert(sizeof(int32_t) >= sizeof(int),
               "FRC_NetworkComm status variable is larger than 32 bits");
@@ -31,6 +35,8 @@ static wpi::mutex msgMutex;
 static wpi::condition_variable* newDSDataAvailableCond;
 static wpi::mutex newDSDataAvailableMutex;
 static int newDSDataAvailableCounter{0};
+// PerfCounterTime() of the latest packet, for the DS wake latency counter
+static std::atomic<uint64_t> newDSDataTime{0};
 
 namespace hal {
 namespace init {
@@ -99,19 +105,31 @@ int32_t HAL_SendError(HAL_Bool isError, int32_t errorCode, HAL_Bool isLVCode,
 }
 
 int32_t HAL_GetControlWord(HAL_ControlWord* controlWord) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterDriverStation);
   std::memset(controlWord, 0, sizeof(HAL_ControlWord));
-  return FRC_NetworkCommunication_getControlWord(
+  int32_t status = FRC_NetworkCommunication_getControlWord(
       reinterpret_cast<ControlWord_t*>(controlWord));
+  if (hal::IsIORecording()) {
+    int32_t word;
+    std::memcpy(&word, controlWord, sizeof(word));
+    hal::RecordIO(HAL_IORecord_kControlWord, 0, word);
+  }
+  return status;
 }
 
 HAL_AllianceStationID HAL_GetAllianceStation(int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterDriverStation);
   HAL_AllianceStationID allianceStation;
   *status = FRC_NetworkCommunication_getAllianceStation(
       reinterpret_cast<AllianceStationID_t*>(&allianceStation));
+  if (hal::IsIORecording()) {
+    hal::RecordIO(HAL_IORecord_kAllianceStation, 0, allianceStation);
+  }
   return allianceStation;
 }
 
 int32_t HAL_GetJoystickAxes(int32_t joystickNum, HAL_JoystickAxes* axes) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterDriverStation);
   HAL_JoystickAxesInt axesInt;
 
   int retVal = FRC_NetworkCommunication_getJoystickAxes(
@@ -131,19 +149,35 @@ int32_t HAL_GetJoystickAxes(int32_t joystickNum, HAL_JoystickAxes* axes) {
     }
   }
 
+  if (hal::IsIORecording()) {
+    hal::RecordIO(HAL_IORecord_kJoystickAxes, joystickNum, axes->count,
+                  axes->axes, sizeof(axes->axes));
+  }
   return retVal;
 }
 
 int32_t HAL_GetJoystickPOVs(int32_t joystickNum, HAL_JoystickPOVs* povs) {
-  return FRC_NetworkCommunication_getJoystickPOVs(
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterDriverStation);
+  int32_t retVal = FRC_NetworkCommunication_getJoystickPOVs(
       joystickNum, reinterpret_cast<JoystickPOV_t*>(povs),
       HAL_kMaxJoystickPOVs);
+  if (hal::IsIORecording()) {
+    hal::RecordIO(HAL_IORecord_kJoystickPOVs, joystickNum, povs->count,
+                  povs->povs, sizeof(povs->povs));
+  }
+  return retVal;
 }
 
 int32_t HAL_GetJoystickButtons(int32_t joystickNum,
                                HAL_JoystickButtons* buttons) {
-  return FRC_NetworkCommunication_getJoystickButtons(
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterDriverStation);
+  int32_t retVal = FRC_NetworkCommunication_getJoystickButtons(
       joystickNum, &buttons->buttons, &buttons->count);
+  if (hal::IsIORecording()) {
+    hal::RecordIO(HAL_IORecord_kJoystickButtons, joystickNum,
+                  buttons->buttons, &buttons->count, sizeof(buttons->count));
+  }
+  return retVal;
 }
 /**
  * Retrieve the Joystick Descriptor for particular slot
@@ -230,8 +264,13 @@ int32_t HAL_SetJoystickOutputs(int32_t joystickNum, int64_t outputs,
 }
 
 double HAL_GetMatchTime(int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterDriverStation);
   float matchTime;
   *status = FRC_NetworkCommunication_getMatchTime(&matchTime);
+  if (hal::IsIORecording()) {
+    hal::RecordIO(HAL_IORecord_kMatchTime, 0, 0,
+                  static_cast<double>(matchTime));
+  }
   return matchTime;
 }
 
@@ -296,8 +335,45 @@ void HAL_FreeMatchInfo(HAL_MatchInfo* info) {
   info->gameSpecificMessage = nullptr;
 }
 
+/**
+ * Read the match info without allocating. The strings are read into stack
+ * buffers of the sizes NetComm uses and truncated to fit the struct.
+ */
+int32_t HAL_GetInlineMatchInfo(HAL_InlineMatchInfo* info) {
+  char eventName[256];
+  uint8_t gameSpecificMessage[1024];
+  uint16_t gameSpecificMessageSize = sizeof(gameSpecificMessage);
+  MatchType_t matchType = MatchType_t::kMatchType_none;
+  uint16_t matchNumber = 0;
+  uint8_t replayNumber = 0;
+  int status = FRC_NetworkCommunication_getMatchInfo(
+      eventName, &matchType, &matchNumber, &replayNumber, gameSpecificMessage,
+      &gameSpecificMessageSize);
+  if (status < 0) {
+    info->eventName[0] = '\0';
+    info->gameSpecificMessage[0] = '\0';
+    info->gameSpecificMessageSize = 0;
+    return status;
+  }
+
+  eventName[sizeof(eventName) - 1] = '\0';
+  std::strncpy(info->eventName, eventName, sizeof(info->eventName) - 1);
+  info->eventName[sizeof(info->eventName) - 1] = '\0';
+  info->matchType = static_cast<HAL_MatchType>(matchType);
+  info->matchNumber = matchNumber;
+  info->replayNumber = replayNumber;
+  size_t messageSize =
+      std::min<size_t>(gameSpecificMessageSize,
+                       sizeof(info->gameSpecificMessage) - 1);
+  std::memcpy(info->gameSpecificMessage, gameSpecificMessage, messageSize);
+  info->gameSpecificMessage[messageSize] = '\0';
+  info->gameSpecificMessageSize = messageSize;
+  return status;
+}
+
 void HAL_ObserveUserProgramStarting(void) {
   FRC_NetworkCommunication_observeUserProgramStarting();
+  hal::StartUsageReporting();
 }
 
 void HAL_ObserveUserProgramDisabled(void) {
@@ -358,6 +434,11 @@ HAL_Bool HAL_WaitForDSDataTimeout(double timeout) {
       newDSDataAvailableCond->wait(lock);
     }
   }
+  uint64_t dataTime = newDSDataTime;
+  if (dataTime != 0 && hal::PerfCountersEnabled()) {
+    hal::RecordPerfSample(HAL_kPerfCounterDSWakeLatency,
+                          hal::PerfCounterTime() - dataTime);
+  }
   return true;
 }
 
@@ -368,6 +449,7 @@ static void newDataOccur(uint32_t refNum) {
   // Since we could get other values, require our specific handle
   // to signal our threads
   if (refNum != refNumber) return;
+  if (hal::PerfCountersEnabled()) newDSDataTime = hal::PerfCounterTime();
   std::lock_guard<wpi::mutex> lock(newDSDataAvailableMutex);
   // Nofify all threads
   newDSDataAvailableCounter++;
@@ -9,15 +9,18 @@
 
 #include <signal.h>  // linux for kill
 #include <sys/prctl.h>
+#include <time.h>
 #include <unistd.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <thread>
 
 #include <FRC_NetworkCommunication/FRCComm.h>
 #include <FRC_NetworkCommunication/LoadOut.h>
+#include <llvm/SmallString.h>
 #include <llvm/raw_ostream.h>
 #include <support/mutex.h>
 #include <support/timestamp.h>
@@ -28,6 +31,7 @@
 #include "HAL/Notifier.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HALInitializer.h"
+#include "UsageReportingInternal.h"
 #include "ctre/ctre.h"
 #include "visa/visa.h"
 
@@ -55,10 +59,12 @@ void InitializeHAL() {
   InitializeCounter();
   InitializeDigitalInternal();
   InitializeDIO();
+  InitializeDMA();
   InitializeEncoder();
   InitializeFPGAEncoder();
   InitializeFRCDriverStation();
   InitializeI2C();
+  InitializeIORecording();
   InitialzeInterrupts();
   InitializeNotifier();
   InitializeOSSerialPort();
@@ -152,6 +158,10 @@ const char* HAL_GetErrorMessage(int32_t code) {
       return HAL_INVALID_ACCUMULATOR_CHANNEL_MESSAGE;
     case HAL_HANDLE_ERROR:
       return HAL_HANDLE_ERROR_MESSAGE;
+    case HAL_INVALID_DMA_ADDITION:
+      return HAL_INVALID_DMA_ADDITION_MESSAGE;
+    case HAL_INVALID_DMA_STATE:
+      return HAL_INVALID_DMA_STATE_MESSAGE;
     case NULL_PARAMETER:
       return NULL_PARAMETER_MESSAGE;
     case ANALOG_TRIGGER_LIMIT_ORDER_ERROR:
@@ -204,6 +214,12 @@ const char* HAL_GetErrorMessage(int32_t code) {
       return HAL_THREAD_PRIORITY_ERROR_MESSAGE;
     case HAL_THREAD_PRIORITY_RANGE_ERROR:
       return HAL_THREAD_PRIORITY_RANGE_ERROR_MESSAGE;
+    case HAL_THREAD_AFFINITY_ERROR:
+      return HAL_THREAD_AFFINITY_ERROR_MESSAGE;
+    case HAL_MEMORY_LOCK_ERROR:
+      return HAL_MEMORY_LOCK_ERROR_MESSAGE;
+    case HAL_THREAD_USAGE_ERROR:
+      return HAL_THREAD_USAGE_ERROR_MESSAGE;
     case HAL_SERIAL_PORT_OPEN_ERROR:
       return HAL_SERIAL_PORT_OPEN_ERROR_MESSAGE;
     case HAL_SERIAL_PORT_ERROR:
@@ -271,6 +287,68 @@ uint64_t HAL_GetFPGATime(int32_t* status) {
   return (upper2 << 32) + lower;
 }
 
+// How often the fast clock is re-synced to the FPGA, in microseconds
+static constexpr int64_t kFastClockResyncPeriod = 1000000;
+
+// FPGA time minus CLOCK_MONOTONIC time, both in microseconds
+static std::atomic<int64_t> fastClockOffset{0};
+// The fast clock never returns less than this, so moving the offset back at a
+// re-sync does not make time go backwards
+static std::atomic<uint64_t> fastClockFloor{0};
+// CLOCK_MONOTONIC time of the next re-sync
+static std::atomic<int64_t> fastClockNextSync{0};
+static std::atomic<bool> fastClockSynced{false};
+
+static int64_t GetMonotonicTime() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Read the FPGA time from the CPU's monotonic clock.
+ *
+ * CLOCK_MONOTONIC is read through the vDSO without a system call or an FPGA
+ * access. It is mapped to FPGA time by an offset measured with
+ * HAL_GetFPGATime(), which is re-measured once a second by whichever caller
+ * finds it due. Between re-syncs the result differs from HAL_GetFPGATime() by
+ * the drift of the two clocks, typically a few tens of microseconds, and it
+ * never decreases.
+ *
+ * @return The current time in microseconds according to the FPGA (since FPGA
+ * reset).
+ */
+uint64_t HAL_GetFPGATimeFast(int32_t* status) {
+  int64_t now = GetMonotonicTime();
+  int64_t nextSync = fastClockNextSync.load(std::memory_order_relaxed);
+  if (now >= nextSync &&
+      fastClockNextSync.compare_exchange_strong(
+          nextSync, now + kFastClockResyncPeriod, std::memory_order_relaxed)) {
+    uint64_t fpgaTime = HAL_GetFPGATime(status);
+    if (*status != 0) {
+      fastClockNextSync.store(nextSync, std::memory_order_relaxed);
+      return 0;
+    }
+    int64_t after = GetMonotonicTime();
+    // The FPGA was read somewhere between the two monotonic reads
+    int64_t offset = static_cast<int64_t>(fpgaTime) - (now + after) / 2;
+    int64_t oldOffset = fastClockOffset.load(std::memory_order_relaxed);
+    if (fastClockSynced.load(std::memory_order_relaxed) && offset < oldOffset) {
+      fastClockFloor.store(after + oldOffset, std::memory_order_relaxed);
+    }
+    fastClockOffset.store(offset, std::memory_order_relaxed);
+    fastClockSynced.store(true, std::memory_order_release);
+    now = after;
+  } else if (!fastClockSynced.load(std::memory_order_acquire)) {
+    // The first sync is still running on another thread
+    return HAL_GetFPGATime(status);
+  }
+
+  uint64_t time = now + fastClockOffset.load(std::memory_order_relaxed);
+  uint64_t floor = fastClockFloor.load(std::memory_order_relaxed);
+  return time > floor ? time : floor;
+}
+
 /**
  * Get the state of the "USER" button on the roboRIO
  * @return true if the button is currently pressed down
@@ -317,6 +395,51 @@ void HAL_BaseInitialize(int32_t* status) {
   initialized = true;
 }
 
+// Polls for a process to exit, so startup only waits as long as the previous
+// program takes to die rather than the whole timeout
+static bool waitForExit(pid_t pid, int timeout) {
+  auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+  while (kill(pid, 0) == 0) {
+    if (std::chrono::steady_clock::now() >= deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+namespace {
+// Times the phases of HAL_Initialize() and prints them on one line, so slow
+// startups can be traced to a phase
+class StartupTrace {
+ public:
+  void Phase(const char* name) {
+    auto now = std::chrono::steady_clock::now();
+    m_out << (m_phases++ == 0 ? "HAL startup: " : ", ") << name << ' '
+          << Milliseconds(m_last, now) << "ms";
+    m_last = now;
+  }
+
+  void Print() {
+    m_out << ", total " << Milliseconds(m_start, m_last) << "ms\n";
+    llvm::outs() << m_out.str();
+  }
+
+ private:
+  static int64_t Milliseconds(std::chrono::steady_clock::time_point from,
+                              std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(to - from)
+        .count();
+  }
+
+  std::chrono::steady_clock::time_point m_start =
+      std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point m_last = m_start;
+  int m_phases = 0;
+  llvm::SmallString<128> m_buf;
+  llvm::raw_svector_ostream m_out{m_buf};
+};
+}  // namespace
+
 static bool killExistingProgram(int timeout, int mode) {
   // Kill any previous robot programs
   std::fstream fs;
@@ -332,8 +455,7 @@ static bool killExistingProgram(int timeout, int mode) {
     if (pid >= 2 && kill(pid, 0) == 0 && pid != getpid()) {
       llvm::outs() << "Killing previously running FRC program...\n";
       kill(pid, SIGTERM);  // try to kill it
-      std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
-      if (kill(pid, 0) == 0) {
+      if (!waitForExit(pid, timeout)) {
         // still not successfull
         if (mode == 0) {
           llvm::outs() << "FRC pid " << pid << " did not die within " << timeout
@@ -341,6 +463,7 @@ static bool killExistingProgram(int timeout, int mode) {
           return 0;              // just fail
         } else if (mode == 1) {  // kill -9 it
           kill(pid, SIGKILL);
+          waitForExit(pid, timeout);
         } else {
           llvm::outs() << "WARNING: FRC pid " << pid << " did not die within "
                        << timeout << "ms.\n";
@@ -371,7 +494,9 @@ HAL_Bool HAL_Initialize(int32_t timeout, int32_t mode) {
   // Second check in case another thread was waiting
   if (initialized) return true;
 
+  StartupTrace trace;
   hal::init::InitializeHAL();
+  trace.Phase("handles");
 
   setlinebuf(stdin);
   setlinebuf(stdout);
@@ -383,8 +508,10 @@ HAL_Bool HAL_Initialize(int32_t timeout, int32_t mode) {
   if (!killExistingProgram(timeout, mode)) {
     return false;
   }
+  trace.Phase("previous program");
 
   FRC_NetworkCommunication_Reserve(nullptr);
+  trace.Phase("NetComm");
 
   std::atexit([]() {
     // Unregister our new data condition variable.
@@ -394,8 +521,10 @@ HAL_Bool HAL_Initialize(int32_t timeout, int32_t mode) {
   int32_t status = 0;
   HAL_BaseInitialize(&status);
   if (status != 0) return false;
+  trace.Phase("FPGA");
 
   HAL_InitializeDriverStation();
+  trace.Phase("driver station");
 
   // Set WPI_Now to use FPGA timestamp
   wpi::SetNowImpl([]() -> uint64_t {
@@ -411,18 +540,16 @@ HAL_Bool HAL_Initialize(int32_t timeout, int32_t mode) {
     return rv;
   });
 
+  trace.Print();
   initialized = true;
   return true;
 }
 
 int64_t HAL_Report(int32_t resource, int32_t instanceNumber, int32_t context,
                    const char* feature) {
-  if (feature == nullptr) {
-    feature = "";
-  }
-
-  return FRC_NetworkCommunication_nUsageReporting_report(
-      resource, instanceNumber, context, feature);
+  // Queued, as NetComm is slow enough to hold up robot construction
+  hal::QueueUsageReport(resource, instanceNumber, context, feature);
+  return 0;
 }
 
 // TODO: HACKS
@@ -18,6 +18,8 @@
 #include "DigitalInternal.h"
 #include "HAL/DIO.h"
 #include "HAL/HAL.h"
+#include "HAL/cpp/BusStatistics.h"
+#include "HAL/cpp/PerfCounters.h"
 
 using namespace hal;
 
@@ -103,6 +105,8 @@ void HAL_InitializeI2C(HAL_I2CPort port, int32_t* status) {
 int32_t HAL_TransactionI2C(HAL_I2CPort port, int32_t deviceAddress,
                            const uint8_t* dataToSend, int32_t sendSize,
                            uint8_t* dataReceived, int32_t receiveSize) {
+  PerfCounterScope perfScope(HAL_kPerfCounterI2C);
+  BusStatisticsScope busScope(HAL_kBusI2C, port);
   if (port > 1) {
     // Set port out of range error here
     return -1;
@@ -124,10 +128,10 @@ int32_t HAL_TransactionI2C(HAL_I2CPort port, int32_t deviceAddress,
 
   if (port == 0) {
     std::lock_guard<wpi::mutex> lock(digitalI2COnBoardMutex);
-    return ioctl(i2COnBoardHandle, I2C_RDWR, &rdwr);
+    return busScope.Result(ioctl(i2COnBoardHandle, I2C_RDWR, &rdwr));
   } else {
     std::lock_guard<wpi::mutex> lock(digitalI2CMXPMutex);
-    return ioctl(i2CMXPHandle, I2C_RDWR, &rdwr);
+    return busScope.Result(ioctl(i2CMXPHandle, I2C_RDWR, &rdwr));
   }
 }
 
@@ -144,6 +148,8 @@ int32_t HAL_TransactionI2C(HAL_I2CPort port, int32_t deviceAddress,
  */
 int32_t HAL_WriteI2C(HAL_I2CPort port, int32_t deviceAddress,
                      const uint8_t* dataToSend, int32_t sendSize) {
+  PerfCounterScope perfScope(HAL_kPerfCounterI2C);
+  BusStatisticsScope busScope(HAL_kBusI2C, port);
   if (port > 1) {
     // Set port out of range error here
     return -1;
@@ -161,10 +167,10 @@ int32_t HAL_WriteI2C(HAL_I2CPort port, int32_t deviceAddress,
 
   if (port == 0) {
     std::lock_guard<wpi::mutex> lock(digitalI2COnBoardMutex);
-    return ioctl(i2COnBoardHandle, I2C_RDWR, &rdwr);
+    return busScope.Result(ioctl(i2COnBoardHandle, I2C_RDWR, &rdwr));
   } else {
     std::lock_guard<wpi::mutex> lock(digitalI2CMXPMutex);
-    return ioctl(i2CMXPHandle, I2C_RDWR, &rdwr);
+    return busScope.Result(ioctl(i2CMXPHandle, I2C_RDWR, &rdwr));
   }
 }
 
@@ -183,6 +189,8 @@ int32_t HAL_WriteI2C(HAL_I2CPort port, int32_t deviceAddress,
  */
 int32_t HAL_ReadI2C(HAL_I2CPort port, int32_t deviceAddress, uint8_t* buffer,
                     int32_t count) {
+  PerfCounterScope perfScope(HAL_kPerfCounterI2C);
+  BusStatisticsScope busScope(HAL_kBusI2C, port);
   if (port > 1) {
     // Set port out of range error here
     return -1;
@@ -200,10 +208,10 @@ int32_t HAL_ReadI2C(HAL_I2CPort port, int32_t deviceAddress, uint8_t* buffer,
 
   if (port == 0) {
     std::lock_guard<wpi::mutex> lock(digitalI2COnBoardMutex);
-    return ioctl(i2COnBoardHandle, I2C_RDWR, &rdwr);
+    return busScope.Result(ioctl(i2COnBoardHandle, I2C_RDWR, &rdwr));
   } else {
     std::lock_guard<wpi::mutex> lock(digitalI2CMXPMutex);
-    return ioctl(i2CMXPHandle, I2C_RDWR, &rdwr);
+    return busScope.Result(ioctl(i2CMXPHandle, I2C_RDWR, &rdwr));
   }
 }
 
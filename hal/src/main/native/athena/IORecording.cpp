@@ -0,0 +1,181 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/IORecording.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <support/mutex.h>
+
+#include "HAL/Errors.h"
+#include "HAL/HAL.h"
+#include "HAL/cpp/BoundedMPSCQueue.h"
+#include "IORecordingInternal.h"
+
+using namespace hal;
+
+// Records queued between writer passes; at 64 bytes each this is 512 KiB
+static constexpr size_t kQueueSize = 8192;
+// The file is grown and mapped this much at a time
+static constexpr size_t kMapSize = 1 << 20;
+static constexpr auto kWriterPeriod = std::chrono::milliseconds(10);
+
+namespace {
+class IORecorder {
+ public:
+  ~IORecorder();
+
+  bool Open(const char* path);
+  void Close();
+
+  void WriterMain();
+
+  BoundedMPSCQueue<HAL_IORecord, kQueueSize> queue;
+  std::atomic<bool> running{false};
+  std::thread writer;
+
+ private:
+  bool Write(const void* data, size_t size);
+  bool Map(size_t offset);
+
+  int m_fd = -1;
+  uint8_t* m_map = nullptr;
+  // file offset of the mapping, and the write position within it
+  size_t m_mapOffset = 0;
+  size_t m_mapPos = 0;
+};
+}  // namespace
+
+// There is a single recorder for the life of the program, so reads never
+// race with it being replaced; recordings reopen its file
+static IORecorder recorder;
+static wpi::mutex recorderMutex;
+
+namespace hal {
+std::atomic<bool> ioRecordingActive{false};
+
+void QueueIORecord(const HAL_IORecord& record) { recorder.queue.Push(record); }
+
+namespace init {
+void InitializeIORecording() {}
+}  // namespace init
+}  // namespace hal
+
+// Finishes a recording still in progress when the program exits
+IORecorder::~IORecorder() {
+  running = false;
+  if (writer.joinable()) writer.join();
+  Close();
+}
+
+bool IORecorder::Open(const char* path) {
+  m_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (m_fd < 0) return false;
+  if (!Map(0)) return false;
+
+  HAL_IORecordFileHeader header;
+  std::memcpy(header.magic, HAL_kIORecordMagic, sizeof(header.magic));
+  header.version = HAL_kIORecordVersion;
+  header.recordSize = sizeof(HAL_IORecord);
+  return Write(&header, sizeof(header));
+}
+
+bool IORecorder::Map(size_t offset) {
+  if (m_map) munmap(m_map, kMapSize);
+  m_map = nullptr;
+  if (ftruncate(m_fd, offset + kMapSize) != 0) return false;
+  void* map = mmap(nullptr, kMapSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   m_fd, offset);
+  if (map == MAP_FAILED) return false;
+  m_map = static_cast<uint8_t*>(map);
+  m_mapOffset = offset;
+  m_mapPos = 0;
+  return true;
+}
+
+bool IORecorder::Write(const void* data, size_t size) {
+  auto bytes = static_cast<const uint8_t*>(data);
+  while (size > 0) {
+    if (m_mapPos == kMapSize && !Map(m_mapOffset + kMapSize)) return false;
+    size_t chunk = kMapSize - m_mapPos;
+    if (chunk > size) chunk = size;
+    std::memcpy(m_map + m_mapPos, bytes, chunk);
+    m_mapPos += chunk;
+    bytes += chunk;
+    size -= chunk;
+  }
+  return true;
+}
+
+void IORecorder::Close() {
+  if (m_fd < 0) return;
+  size_t length = m_mapOffset + m_mapPos;
+  if (m_map) munmap(m_map, kMapSize);
+  m_map = nullptr;
+  // Drop the unused end of the last mapping
+  ftruncate(m_fd, length);
+  close(m_fd);
+  m_fd = -1;
+}
+
+void IORecorder::WriterMain() {
+  HAL_IORecord record;
+  bool ok = true;
+  for (;;) {
+    bool stop = !running;
+    while (queue.Pop(&record)) {
+      if (ok) ok = Write(&record, sizeof(record));
+    }
+    if (stop) break;
+    std::this_thread::sleep_for(kWriterPeriod);
+  }
+}
+
+// recorderMutex must be held
+static void StopRecordingLocked() {
+  if (!recorder.running) return;
+  ioRecordingActive = false;
+  recorder.running = false;
+  recorder.writer.join();
+  recorder.Close();
+}
+
+extern "C" {
+void HAL_StartIORecording(const char* path, int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(recorderMutex);
+  StopRecordingLocked();
+
+  // Discard records from reads that raced with the last stop
+  HAL_IORecord record;
+  while (recorder.queue.Pop(&record)) {
+  }
+
+  if (!recorder.Open(path)) {
+    recorder.Close();
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  recorder.running = true;
+  recorder.writer = std::thread(&IORecorder::WriterMain, &recorder);
+  ioRecordingActive = true;
+}
+
+void HAL_StopIORecording(void) {
+  std::lock_guard<wpi::mutex> lock(recorderMutex);
+  StopRecordingLocked();
+}
+
+int64_t HAL_GetIORecordingDropCount(void) {
+  return recorder.queue.GetOverflowCount();
+}
+}  // extern "C"
@@ -0,0 +1,47 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstring>
+
+#include "HAL/HAL.h"
+#include "HAL/IORecording.h"
+
+namespace hal {
+extern std::atomic<bool> ioRecordingActive;
+
+void QueueIORecord(const HAL_IORecord& record);
+
+// Callers check IsIORecording() first, so reads cost one relaxed load while
+// nothing is being recorded
+inline bool IsIORecording() {
+  return ioRecordingActive.load(std::memory_order_relaxed);
+}
+
+inline void RecordIO(HAL_IORecordKind kind, int32_t index, int32_t value,
+                     const void* data = nullptr, size_t size = 0) {
+  HAL_IORecord record;
+  int32_t status = 0;
+  record.timestamp = HAL_GetFPGATime(&status);
+  record.kind = kind;
+  record.index = static_cast<uint16_t>(index);
+  record.value = value;
+  std::memset(record.data, 0, sizeof(record.data));
+  if (size > sizeof(record.data)) size = sizeof(record.data);
+  if (size > 0) std::memcpy(record.data, data, size);
+  QueueIORecord(record);
+}
+
+inline void RecordIO(HAL_IORecordKind kind, int32_t index, int32_t value,
+                     double data) {
+  RecordIO(kind, index, value, &data, sizeof(data));
+}
+}  // namespace hal
@@ -7,13 +7,24 @@
 
 #include "HAL/Interrupts.h"
 
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
 
-#include <support/SafeThread.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
 
 #include "DigitalInternal.h"
 #include "HAL/ChipObject.h"
 #include "HAL/Errors.h"
+#include "HAL/Threads.h"
+#include "HAL/cpp/InterruptEventQueue.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/cpp/make_unique.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HAL/handles/LimitedHandleResource.h"
@@ -23,62 +34,254 @@ using namespace hal;
 
 namespace {
 
+// A threaded handler, queued on the dispatcher when its interrupt fires
+struct DispatchEntry : public std::enable_shared_from_this<DispatchEntry> {
+  HAL_InterruptHandlerFunction handler;
+  void* param;
+  std::atomic<int32_t> priority{0};
+  // The members below are guarded by the dispatcher mutex
+  uint32_t mask = 0;
+  bool queued = false;
+  bool running = false;
+};
+
 struct Interrupt {
   std::unique_ptr<tInterrupt> anInterrupt;
+  uint32_t index;
+  HAL_InterruptHandlerFunction handler;
+  void* param;
+  // Read with std::atomic_load, as the handler can run while it is replaced
+  std::shared_ptr<InterruptEventQueue> events;
+  // Set by HAL_AttachInterruptHandlerThreaded
+  std::shared_ptr<DispatchEntry> dispatch;
+  // Declared last so its handler thread stops before the members above go
   std::unique_ptr<tInterruptManager> manager;
 };
 
-// Safe thread to allow callbacks to run on their own thread
-class InterruptThread : public wpi::SafeThread {
+/**
+ * Runs every threaded interrupt handler from a fixed set of threads.
+ *
+ * Pending handlers are run highest priority first. Masks that arrive while a
+ * handler is queued are merged, and a handler never runs on two threads at
+ * once.
+ */
+class InterruptDispatcher {
  public:
-  void Main() {
-    std::unique_lock<wpi::mutex> lock(m_mutex);
-    while (m_active) {
-      m_cond.wait(lock, [&] { return !m_active || m_notify; });
-      if (!m_active) break;
-      m_notify = false;
-      HAL_InterruptHandlerFunction handler = m_handler;
-      uint32_t mask = m_mask;
-      void* param = m_param;
-      lock.unlock();  // don't hold mutex during callback execution
-      handler(mask, param);
-      lock.lock();
-    }
+  static InterruptDispatcher& GetInstance() {
+    static InterruptDispatcher instance;
+    return instance;
   }
 
-  bool m_notify = false;
-  HAL_InterruptHandlerFunction m_handler;
-  void* m_param;
-  uint32_t m_mask;
+  ~InterruptDispatcher();
+
+  void Start();
+  void Configure(int32_t threadCount, HAL_Bool realTime, int32_t priority,
+                 uint32_t cpuMask, int32_t* status);
+  void Post(DispatchEntry* entry, uint32_t mask);
+
+ private:
+  // m_mutex must be held
+  std::vector<std::shared_ptr<DispatchEntry>>::iterator FindNext();
+  void StartThreads(int32_t* status);
+  void StopThreads();
+  void ThreadMain();
+
+  wpi::mutex m_configMutex;
+  int32_t m_threadCount = 1;
+  HAL_Bool m_realTime = false;
+  int32_t m_priority = 0;
+  uint32_t m_cpuMask = 0;
+  std::vector<std::thread> m_threads;
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  bool m_active = false;
+  std::vector<std::shared_ptr<DispatchEntry>> m_pending;
 };
 
-class InterruptThreadOwner : public wpi::SafeThreadOwner<InterruptThread> {
- public:
-  void SetFunc(HAL_InterruptHandlerFunction handler, void* param) {
-    auto thr = GetThread();
-    if (!thr) return;
-    thr->m_handler = handler;
-    thr->m_param = param;
+}  // namespace
+
+InterruptDispatcher::~InterruptDispatcher() {
+  std::lock_guard<wpi::mutex> lock(m_configMutex);
+  StopThreads();
+}
+
+void InterruptDispatcher::Start() {
+  std::lock_guard<wpi::mutex> lock(m_configMutex);
+  if (!m_threads.empty()) return;
+  int32_t status = 0;
+  StartThreads(&status);
+}
+
+/**
+ * Restart the dispatch threads with new settings. Must not be called from a
+ * threaded handler.
+ */
+void InterruptDispatcher::Configure(int32_t threadCount, HAL_Bool realTime,
+                                    int32_t priority, uint32_t cpuMask,
+                                    int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(m_configMutex);
+  m_threadCount = threadCount;
+  m_realTime = realTime;
+  m_priority = priority;
+  m_cpuMask = cpuMask;
+  if (m_threads.empty()) return;
+  StopThreads();
+  StartThreads(status);
+}
+
+void InterruptDispatcher::Post(DispatchEntry* entry, uint32_t mask) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  entry->mask |= mask;
+  if (entry->queued) return;
+  entry->queued = true;
+  m_pending.emplace_back(entry->shared_from_this());
+  m_cond.notify_one();
+}
+
+std::vector<std::shared_ptr<DispatchEntry>>::iterator
+InterruptDispatcher::FindNext() {
+  auto next = m_pending.end();
+  for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+    if ((*it)->running) continue;
+    if (next == m_pending.end() || (*it)->priority > (*next)->priority) {
+      next = it;
+    }
   }
+  return next;
+}
 
-  void Notify(uint32_t mask) {
-    auto thr = GetThread();
-    if (!thr) return;
-    thr->m_mask = mask;
-    thr->m_notify = true;
-    thr->m_cond.notify_one();
+void InterruptDispatcher::StartThreads(int32_t* status) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_active = true;
   }
-};
 
-}  // namespace
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (int cpu = 0; cpu < 32; cpu++) {
+    if (m_cpuMask & (1u << cpu)) CPU_SET(cpu, &cpus);
+  }
+
+  for (int32_t i = 0; i < m_threadCount; i++) {
+    m_threads.emplace_back(&InterruptDispatcher::ThreadMain, this);
+    auto handle = m_threads.back().native_handle();
+    if (m_realTime) HAL_SetThreadPriority(&handle, true, m_priority, status);
+    if (m_cpuMask != 0 &&
+        pthread_setaffinity_np(handle, sizeof(cpus), &cpus) != 0) {
+      *status = HAL_THREAD_PRIORITY_ERROR;
+    }
+  }
+}
+
+void InterruptDispatcher::StopThreads() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_active = false;
+  }
+  m_cond.notify_all();
+  for (auto& thread : m_threads) thread.join();
+  m_threads.clear();
+}
+
+void InterruptDispatcher::ThreadMain() {
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  while (m_active) {
+    m_cond.wait(lock,
+                [&] { return !m_active || FindNext() != m_pending.end(); });
+    if (!m_active) break;
+
+    auto it = FindNext();
+    auto entry = std::move(*it);
+    m_pending.erase(it);
+    uint32_t mask = entry->mask;
+    entry->mask = 0;
+    entry->queued = false;
+    entry->running = true;
+
+    lock.unlock();  // don't hold mutex during callback execution
+    entry->handler(mask, entry->param);
+    lock.lock();
+
+    entry->running = false;
+    // It may have been queued again while it ran
+    if (entry->queued) m_cond.notify_one();
+  }
+}
 
 static void threadedInterruptHandler(uint32_t mask, void* param) {
-  static_cast<InterruptThreadOwner*>(param)->Notify(mask);
+  InterruptDispatcher::GetInstance().Post(static_cast<DispatchEntry*>(param),
+                                          mask);
+}
+
+/**
+ * Queue the edges in an asserted mask, oldest first.
+ */
+static void RecordInterruptEvents(Interrupt* anInterrupt, uint32_t mask) {
+  auto events = std::atomic_load(&anInterrupt->events);
+  if (!events) return;
+
+  int32_t status = 0;
+  bool rising = mask & (1u << anInterrupt->index);
+  bool falling = mask & (1u << (anInterrupt->index + 8u));
+  uint32_t risingTime =
+      rising ? anInterrupt->anInterrupt->readRisingTimeStamp(&status) : 0;
+  uint32_t fallingTime =
+      falling ? anInterrupt->anInterrupt->readFallingTimeStamp(&status) : 0;
+  if (status != 0) return;
+
+  // The timestamps are 32 bit microseconds, so compare them modulo rollover
+  bool fallingFirst =
+      rising && falling && static_cast<int32_t>(fallingTime - risingTime) < 0;
+  if (fallingFirst) {
+    events->Push(fallingTime * 1e-6, HAL_kInterruptFallingEdge);
+  }
+  if (rising) events->Push(risingTime * 1e-6, HAL_kInterruptRisingEdge);
+  if (falling && !fallingFirst) {
+    events->Push(fallingTime * 1e-6, HAL_kInterruptFallingEdge);
+  }
+}
+
+static void interruptHandler(uint32_t mask, void* param) {
+  auto anInterrupt = static_cast<Interrupt*>(param);
+  RecordInterruptEvents(anInterrupt, mask);
+  anInterrupt->handler(mask, anInterrupt->param);
 }
 
 static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
                              HAL_HandleEnum::Interrupt>* interruptHandles;
 
+// Watcher managers for sets of interrupts waited on together, keyed by their
+// IRQ mask. A manager is taken out of the pool while it is waited on, so
+// concurrent waits on the same set each get their own.
+static wpi::mutex multiWaitMutex;
+static std::vector<std::pair<uint32_t, std::unique_ptr<tInterruptManager>>>
+    multiWaitManagers;
+
+static std::unique_ptr<tInterruptManager> TakeMultiWaitManager(
+    uint32_t irqMask, int32_t* status) {
+  {
+    std::lock_guard<wpi::mutex> lock(multiWaitMutex);
+    for (auto it = multiWaitManagers.begin(); it != multiWaitManagers.end();
+         ++it) {
+      if (it->first == irqMask) {
+        auto manager = std::move(it->second);
+        multiWaitManagers.erase(it);
+        return manager;
+      }
+    }
+  }
+  auto manager = std::make_unique<tInterruptManager>(irqMask, true, status);
+  if (*status != 0) return nullptr;
+  return manager;
+}
+
+static void ReturnMultiWaitManager(uint32_t irqMask,
+                                   std::unique_ptr<tInterruptManager> manager) {
+  std::lock_guard<wpi::mutex> lock(multiWaitMutex);
+  multiWaitManagers.emplace_back(irqMask, std::move(manager));
+}
+
 namespace hal {
 namespace init {
 void InitialzeInterrupts() {
@@ -99,8 +302,11 @@ HAL_InterruptHandle HAL_InitializeInterrupts(HAL_Bool watcher,
     *status = NO_AVAILABLE_RESOURCES;
     return HAL_kInvalidHandle;
   }
-  auto anInterrupt = interruptHandles->Get(handle);
+  auto anInterrupt = interruptHandles->GetBorrowed(handle);
   uint32_t interruptIndex = static_cast<uint32_t>(getHandleIndex(handle));
+  anInterrupt->index = interruptIndex;
+  std::atomic_store(&anInterrupt->events,
+                    std::shared_ptr<InterruptEventQueue>());
   // Expects the calling leaf class to allocate an interrupt index.
   anInterrupt->anInterrupt.reset(tInterrupt::create(interruptIndex, status));
   anInterrupt->anInterrupt->writeConfig_WaitForAck(false, status);
@@ -132,6 +338,7 @@ int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
 
   result = anInterrupt->manager->watch(static_cast<int32_t>(timeout * 1e3),
                                        ignorePrevious, status);
+  RecordInterruptEvents(anInterrupt.get(), result);
 
   // Don't report a timeout as an error - the return code is enough to tell
   // that a timeout happened.
@@ -142,6 +349,82 @@ int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
   return result;
 }
 
+/**
+ * In synchronous mode, wait for any of several interrupts to occur.
+ *
+ * @param handles           The interrupts to wait on, at most 8.
+ * @param count             The number of handles.
+ * @param timeout           Timeout in seconds
+ * @param ignorePrevious    If true, ignore interrupts that happened before
+ *                          the call.
+ * @param risingTimestamps  If not null, entry i is set to the rising timestamp
+ *                          of handle i when it fired on a rising edge.
+ * @param fallingTimestamps If not null, entry i is set to the falling
+ *                          timestamp of handle i when it fired on a falling
+ *                          edge.
+ * @return A mask with bit i set when handle i fired on a rising edge, and bit
+ *         i + 8 set when it fired on a falling edge. 0 on timeout.
+ */
+int64_t HAL_WaitForMultipleInterrupts(const HAL_InterruptHandle* handles,
+                                      int32_t count, double timeout,
+                                      HAL_Bool ignorePrevious,
+                                      double* risingTimestamps,
+                                      double* fallingTimestamps,
+                                      int32_t* status) {
+  if (count < 1 || count > kNumInterrupts) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return 0;
+  }
+
+  std::shared_ptr<Interrupt> interrupts[kNumInterrupts];
+  uint32_t indices[kNumInterrupts];
+  uint32_t irqMask = 0;
+  for (int32_t i = 0; i < count; i++) {
+    interrupts[i] = interruptHandles->Get(handles[i]);
+    if (interrupts[i] == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return 0;
+    }
+    indices[i] = getHandleIndex(handles[i]);
+    irqMask |= (1u << indices[i]) | (1u << (indices[i] + 8u));
+  }
+
+  auto manager = TakeMultiWaitManager(irqMask, status);
+  if (!manager) return 0;
+  uint32_t result = manager->watch(static_cast<int32_t>(timeout * 1e3),
+                                   ignorePrevious, status);
+  ReturnMultiWaitManager(irqMask, std::move(manager));
+  for (int32_t i = 0; i < count; i++) {
+    RecordInterruptEvents(interrupts[i].get(), result);
+  }
+
+  // Don't report a timeout as an error - the return code is enough to tell
+  // that a timeout happened.
+  if (*status == -NiFpga_Status_IrqTimeout) {
+    *status = NiFpga_Status_Success;
+  }
+  if (*status != 0) return 0;
+
+  int64_t fired = 0;
+  for (int32_t i = 0; i < count; i++) {
+    if (result & (1u << indices[i])) {
+      fired |= 1 << i;
+      if (risingTimestamps) {
+        risingTimestamps[i] =
+            interrupts[i]->anInterrupt->readRisingTimeStamp(status) * 1e-6;
+      }
+    }
+    if (result & (1u << (indices[i] + 8u))) {
+      fired |= 1 << (i + 8);
+      if (fallingTimestamps) {
+        fallingTimestamps[i] =
+            interrupts[i]->anInterrupt->readFallingTimeStamp(status) * 1e-6;
+      }
+    }
+  }
+  return fired;
+}
+
 /**
  * Enable interrupts to occur on this input.
  * Interrupts are disabled when the RequestInterrupt call is made. This gives
@@ -150,7 +433,7 @@ int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
  */
 void HAL_EnableInterrupts(HAL_InterruptHandle interruptHandle,
                           int32_t* status) {
-  auto anInterrupt = interruptHandles->Get(interruptHandle);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
   if (anInterrupt == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -163,7 +446,7 @@ void HAL_EnableInterrupts(HAL_InterruptHandle interruptHandle,
  */
 void HAL_DisableInterrupts(HAL_InterruptHandle interruptHandle,
                            int32_t* status) {
-  auto anInterrupt = interruptHandles->Get(interruptHandle);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
   if (anInterrupt == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -178,7 +461,8 @@ void HAL_DisableInterrupts(HAL_InterruptHandle interruptHandle,
  */
 double HAL_ReadInterruptRisingTimestamp(HAL_InterruptHandle interruptHandle,
                                         int32_t* status) {
-  auto anInterrupt = interruptHandles->Get(interruptHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterInterrupt);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
   if (anInterrupt == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -194,7 +478,8 @@ double HAL_ReadInterruptRisingTimestamp(HAL_InterruptHandle interruptHandle,
  */
 double HAL_ReadInterruptFallingTimestamp(HAL_InterruptHandle interruptHandle,
                                          int32_t* status) {
-  auto anInterrupt = interruptHandles->Get(interruptHandle);
+  PerfCounterScope perfScope(HAL_kPerfCounterInterrupt);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
   if (anInterrupt == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
@@ -207,7 +492,7 @@ void HAL_RequestInterrupts(HAL_InterruptHandle interruptHandle,
                            HAL_Handle digitalSourceHandle,
                            HAL_AnalogTriggerType analogTriggerType,
                            int32_t* status) {
-  auto anInterrupt = interruptHandles->Get(interruptHandle);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
   if (anInterrupt == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -232,33 +517,85 @@ void HAL_RequestInterrupts(HAL_InterruptHandle interruptHandle,
 void HAL_AttachInterruptHandler(HAL_InterruptHandle interruptHandle,
                                 HAL_InterruptHandlerFunction handler,
                                 void* param, int32_t* status) {
-  auto anInterrupt = interruptHandles->Get(interruptHandle);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
   if (anInterrupt == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
   }
-  anInterrupt->manager->registerHandler(handler, param, status);
+  anInterrupt->handler = handler;
+  anInterrupt->param = param;
+  anInterrupt->manager->registerHandler(interruptHandler, anInterrupt.get(),
+                                        status);
 }
 
-void HAL_AttachInterruptHandlerThreaded(HAL_InterruptHandle interrupt_handle,
+void HAL_AttachInterruptHandlerThreaded(HAL_InterruptHandle interruptHandle,
                                         HAL_InterruptHandlerFunction handler,
                                         void* param, int32_t* status) {
-  InterruptThreadOwner* intr = new InterruptThreadOwner;
-  intr->Start();
-  intr->SetFunc(handler, param);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
+  if (anInterrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  auto entry = std::make_shared<DispatchEntry>();
+  entry->handler = handler;
+  entry->param = param;
+  InterruptDispatcher::GetInstance().Start();
 
-  HAL_AttachInterruptHandler(interrupt_handle, threadedInterruptHandler, intr,
-                             status);
+  // Keep the previous entry alive until the new handler is registered
+  auto previous = std::move(anInterrupt->dispatch);
+  anInterrupt->dispatch = entry;
+  HAL_AttachInterruptHandler(interruptHandle, threadedInterruptHandler,
+                             entry.get(), status);
+}
+
+/**
+ * Set the order in which the handler of this interrupt is run relative to
+ * other threaded handlers that are pending at the same time. Higher priority
+ * handlers run first; the default is 0.
+ */
+void HAL_SetInterruptHandlerPriority(HAL_InterruptHandle interruptHandle,
+                                     int32_t priority, int32_t* status) {
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
+  if (anInterrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (!anInterrupt->dispatch) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+  anInterrupt->dispatch->priority = priority;
+}
 
-  if (*status != 0) {
-    delete intr;
+/**
+ * Configure the threads that run every threaded interrupt handler.
+ *
+ * @param threadCount The number of dispatch threads, 1 or 2.
+ * @param realTime    True to run the threads at a real-time priority.
+ * @param priority    The real-time priority of the threads, 1-99.
+ * @param cpuMask     The CPUs the threads may run on, one bit per CPU; 0 for
+ *                    any CPU.
+ */
+void HAL_ConfigureInterruptDispatch(int32_t threadCount, HAL_Bool realTime,
+                                    int32_t priority, uint32_t cpuMask,
+                                    int32_t* status) {
+  if (threadCount < 1 || threadCount > HAL_kMaxInterruptDispatchThreads) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  if (realTime && (priority < 1 || priority > 99)) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
   }
+  InterruptDispatcher::GetInstance().Configure(threadCount, realTime, priority,
+                                               cpuMask, status);
 }
 
 void HAL_SetInterruptUpSourceEdge(HAL_InterruptHandle interruptHandle,
                                   HAL_Bool risingEdge, HAL_Bool fallingEdge,
                                   int32_t* status) {
-  auto anInterrupt = interruptHandles->Get(interruptHandle);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
   if (anInterrupt == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
@@ -267,4 +604,68 @@ void HAL_SetInterruptUpSourceEdge(HAL_InterruptHandle interruptHandle,
   anInterrupt->anInterrupt->writeConfig_FallingEdge(fallingEdge, status);
 }
 
+/**
+ * Queue every edge of this interrupt as it is handled, so edges that arrive
+ * faster than they are read are not lost.
+ *
+ * @param size The number of edges kept between reads; 0 stops queueing.
+ */
+void HAL_SetInterruptEventQueueSize(HAL_InterruptHandle interruptHandle,
+                                    int32_t size, int32_t* status) {
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
+  if (anInterrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (size < 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  std::atomic_store(&anInterrupt->events,
+                    size == 0 ? std::shared_ptr<InterruptEventQueue>()
+                              : std::make_shared<InterruptEventQueue>(size));
+}
+
+/**
+ * Read the queued edges of this interrupt, oldest first.
+ *
+ * @param events Buffer to copy the edges into.
+ * @param count  Size of events.
+ * @return The number of edges copied.
+ */
+int32_t HAL_ReadInterruptEvents(HAL_InterruptHandle interruptHandle,
+                                HAL_InterruptEvent* events, int32_t count,
+                                int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterInterrupt);
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
+  if (anInterrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  auto queue = std::atomic_load(&anInterrupt->events);
+  if (!queue) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  return queue->Pop(events, count);
+}
+
+/**
+ * Return the number of edges dropped because the queue was full.
+ */
+int64_t HAL_GetInterruptEventOverflowCount(HAL_InterruptHandle interruptHandle,
+                                           int32_t* status) {
+  auto anInterrupt = interruptHandles->GetBorrowed(interruptHandle);
+  if (anInterrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  auto queue = std::atomic_load(&anInterrupt->events);
+  if (!queue) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  return queue->GetOverflowCount();
+}
+
 }  // extern "C"
@@ -9,7 +9,10 @@
 
 #include <atomic>
 #include <cstdlib>  // For std::atexit()
+#include <functional>
 #include <memory>
+#include <queue>
+#include <vector>
 
 #include <support/condition_variable.h>
 #include <support/mutex.h>
@@ -17,12 +20,16 @@
 #include "HAL/ChipObject.h"
 #include "HAL/Errors.h"
 #include "HAL/HAL.h"
+#include "HAL/cpp/MemoryPool.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/cpp/make_unique.h"
 #include "HAL/handles/UnlimitedHandleResource.h"
 
 using namespace hal;
 
 static constexpr int32_t kTimerInterruptNumber = 28;
+// alarms serviced more than this many microseconds late are counted as late
+static constexpr uint64_t kLateAlarmThreshold = 1000;
 
 static wpi::mutex notifierMutex;
 static std::unique_ptr<tAlarm> notifierAlarm;
@@ -34,13 +41,33 @@ namespace {
 struct Notifier {
   uint64_t triggerTime = UINT64_MAX;
   uint64_t triggeredTime = UINT64_MAX;
+  // if not 0, alarms re-arm themselves this many microseconds later
+  uint64_t period = 0;
+  int32_t lateCount = 0;
   bool active = true;
   wpi::mutex mutex;
   wpi::condition_variable cond;
 };
 
+// A pending alarm. An entry is stale if the notifier's trigger time no
+// longer matches (it was rescheduled, cancelled, or already fired).
+struct AlarmEntry {
+  uint64_t triggerTime;
+  std::shared_ptr<Notifier> notifier;
+
+  bool operator>(const AlarmEntry& rhs) const {
+    return triggerTime > rhs.triggerTime;
+  }
+};
+
+using AlarmQueue = std::priority_queue<AlarmEntry, std::vector<AlarmEntry>,
+                                       std::greater<AlarmEntry>>;
+
 }  // namespace
 
+// deadline-ordered pending alarms, guarded by notifierMutex
+static AlarmQueue* alarmQueue;
+
 static std::atomic_flag notifierAtexitRegistered{ATOMIC_FLAG_INIT};
 static std::atomic_int notifierRefCount{0};
 
@@ -65,6 +92,18 @@ class NotifierHandleContainer
 
 static NotifierHandleContainer* notifierHandles;
 
+// Notifiers beyond this many are allocated from the heap
+static constexpr size_t kNotifierPoolSize = 64;
+static MemoryPool* notifierPool;
+
+// The first tick of a periodic alarm after currentTime, on the schedule set
+// by triggerTime
+static uint64_t NextPeriodicTrigger(uint64_t triggerTime, uint64_t period,
+                                    uint64_t currentTime) {
+  if (triggerTime > currentTime) return triggerTime;
+  return triggerTime + ((currentTime - triggerTime) / period + 1) * period;
+}
+
 static void alarmCallback(uint32_t, void*) {
   std::lock_guard<wpi::mutex> lock(notifierMutex);
   int32_t status = 0;
@@ -73,20 +112,38 @@ static void alarmCallback(uint32_t, void*) {
   // the hardware disables itself after each alarm
   closestTrigger = UINT64_MAX;
 
-  // process all notifiers
-  notifierHandles->ForEach([&](HAL_NotifierHandle handle, Notifier* notifier) {
-    if (notifier->triggerTime == UINT64_MAX) return;
+  // process expired notifiers in deadline order, stopping at the first one
+  // that is still pending
+  while (!alarmQueue->empty()) {
+    AlarmEntry entry = alarmQueue->top();
+    std::unique_lock<wpi::mutex> notifierLock(entry.notifier->mutex);
+    if (entry.notifier->triggerTime != entry.triggerTime) {
+      alarmQueue->pop();
+      continue;
+    }
     if (currentTime == 0) currentTime = HAL_GetFPGATime(&status);
-    std::unique_lock<wpi::mutex> lock(notifier->mutex);
-    if (notifier->triggerTime < currentTime) {
-      notifier->triggerTime = UINT64_MAX;
-      notifier->triggeredTime = currentTime;
-      lock.unlock();
-      notifier->cond.notify_all();
-    } else if (notifier->triggerTime < closestTrigger) {
-      closestTrigger = notifier->triggerTime;
+    if (entry.triggerTime >= currentTime) {
+      closestTrigger = entry.triggerTime;
+      break;
     }
-  });
+    alarmQueue->pop();
+    if (currentTime - entry.triggerTime > kLateAlarmThreshold) {
+      entry.notifier->lateCount++;
+    }
+    RecordPerfSample(HAL_kPerfCounterNotifierLateness,
+                     (currentTime - entry.triggerTime) * 1000);
+    if (entry.notifier->period != 0) {
+      uint64_t next = NextPeriodicTrigger(
+          entry.triggerTime, entry.notifier->period, currentTime);
+      entry.notifier->triggerTime = next;
+      alarmQueue->push(AlarmEntry{next, entry.notifier});
+    } else {
+      entry.notifier->triggerTime = UINT64_MAX;
+    }
+    entry.notifier->triggeredTime = currentTime;
+    notifierLock.unlock();
+    entry.notifier->cond.notify_all();
+  }
 
   if (notifierAlarm && closestTrigger != UINT64_MAX) {
     // Simply truncate the hardware trigger time to 32-bit.
@@ -105,8 +162,13 @@ static void cleanupNotifierAtExit() {
 namespace hal {
 namespace init {
 void InitializeNotifier() {
+  // Constructed first so it is destroyed after the notifiers
+  static MemoryPool nP(SharedBlockSize<Notifier>(), kNotifierPoolSize);
+  notifierPool = &nP;
   static NotifierHandleContainer nH;
   notifierHandles = &nH;
+  static AlarmQueue aQ;
+  alarmQueue = &aQ;
 }
 }  // namespace init
 }  // namespace hal
@@ -129,7 +191,7 @@ HAL_NotifierHandle HAL_InitializeNotifier(int32_t* status) {
     if (!notifierAlarm) notifierAlarm.reset(tAlarm::create(status));
   }
 
-  std::shared_ptr<Notifier> notifier = std::make_shared<Notifier>();
+  std::shared_ptr<Notifier> notifier = MakePooled<Notifier>(*notifierPool);
   HAL_NotifierHandle handle = notifierHandles->Allocate(notifier);
   if (handle == HAL_kInvalidHandle) {
     *status = HAL_HANDLE_ERROR;
@@ -185,16 +247,40 @@ void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
 
 void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
                              uint64_t triggerTime, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterNotifier);
   auto notifier = notifierHandles->Get(notifierHandle);
   if (!notifier) return;
 
+  // A trigger time that has already passed would only be matched by the
+  // hardware after the 32-bit timer rolls over, so fire it immediately.
+  uint64_t currentTime = HAL_GetFPGATime(status);
+  bool fired = false;
+  if (triggerTime <= currentTime) {
+    uint64_t period;
+    {
+      std::lock_guard<wpi::mutex> lock(notifier->mutex);
+      notifier->triggerTime = UINT64_MAX;
+      notifier->triggeredTime = currentTime;
+      if (currentTime - triggerTime > kLateAlarmThreshold) {
+        notifier->lateCount++;
+      }
+      period = notifier->period;
+    }
+    notifier->cond.notify_all();
+    if (period == 0) return;
+    // a periodic alarm carries on with the next tick
+    triggerTime = NextPeriodicTrigger(triggerTime, period, currentTime);
+    fired = true;
+  }
+
   {
     std::lock_guard<wpi::mutex> lock(notifier->mutex);
     notifier->triggerTime = triggerTime;
-    notifier->triggeredTime = UINT64_MAX;
+    if (!fired) notifier->triggeredTime = UINT64_MAX;
   }
 
   std::lock_guard<wpi::mutex> lock(notifierMutex);
+  alarmQueue->push(AlarmEntry{triggerTime, notifier});
   // Update alarm time if closer than current.
   if (triggerTime < closestTrigger) {
     bool wasActive = (closestTrigger != UINT64_MAX);
@@ -209,6 +295,7 @@ void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
 
 void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
                              int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterNotifier);
   auto notifier = notifierHandles->Get(notifierHandle);
   if (!notifier) return;
 
@@ -218,6 +305,16 @@ void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
   }
 }
 
+void HAL_SetNotifierPeriodic(HAL_NotifierHandle notifierHandle,
+                             uint64_t period, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterNotifier);
+  auto notifier = notifierHandles->Get(notifierHandle);
+  if (!notifier) return;
+
+  std::lock_guard<wpi::mutex> lock(notifier->mutex);
+  notifier->period = period;
+}
+
 uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
                                   int32_t* status) {
   auto notifier = notifierHandles->Get(notifierHandle);
@@ -226,7 +323,19 @@ uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
   notifier->cond.wait(lock, [&] {
     return !notifier->active || notifier->triggeredTime != UINT64_MAX;
   });
-  return notifier->active ? notifier->triggeredTime : 0;
+  if (!notifier->active) return 0;
+  uint64_t triggeredTime = notifier->triggeredTime;
+  // a periodic alarm is consumed, so the next wait blocks until the next tick
+  if (notifier->period != 0) notifier->triggeredTime = UINT64_MAX;
+  return triggeredTime;
+}
+
+int32_t HAL_GetNotifierLateAlarmCount(HAL_NotifierHandle notifierHandle,
+                                      int32_t* status) {
+  auto notifier = notifierHandles->Get(notifierHandle);
+  if (!notifier) return 0;
+  std::lock_guard<wpi::mutex> lock(notifier->mutex);
+  return notifier->lateCount;
 }
 
 }  // extern "C"
@@ -7,68 +7,204 @@
 
 #include "HAL/OSSerialPort.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <linux/serial.h>
+#include <poll.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <termios.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "HAL/Errors.h"
+#include "HAL/cpp/BusStatistics.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/cpp/SerialHelper.h"
 
-static int portHandles[4]{-1, -1, -1, -1};
-static std::chrono::milliseconds portTimeouts[4]{
-    std::chrono::milliseconds(0), std::chrono::milliseconds(0),
-    std::chrono::milliseconds(0), std::chrono::milliseconds(0)};
+namespace {
+struct OSSerialPort {
+  int fd = -1;
+  int timeoutMs = 0;
+  bool termination = false;
+  char terminator = '\n';
+  // Received bytes past a terminator, kept for the next read
+  std::vector<char> readBuffer;
+  size_t readPos = 0;
+  size_t readEnd = 0;
+  // Written bytes held back in kFlushWhenFull mode
+  bool flushOnAccess = true;
+  size_t writeBufferSize = 512;
+  std::vector<char> writeBuffer;
+};
+}  // namespace
+
+static OSSerialPort ports[4];
 
 namespace hal {
 namespace init {
 void InitializeOSSerialPort() {
-  for (int i = 0; i < 4; i++) {
-    portHandles[i] = -1;
-    portTimeouts[i] = std::chrono::milliseconds(0);
-  }
+  for (auto& port : ports) port = OSSerialPort();
 }
 }  // namespace init
 }  // namespace hal
 
-extern "C" {
+// Returns the open port, or nullptr with an error status
+static OSSerialPort* GetPort(HAL_SerialPort port, int32_t* status) {
+  if (port < 0 || port >= 4 || ports[port].fd < 0) {
+    *status = HAL_SERIAL_PORT_ERROR;
+    return nullptr;
+  }
+  return &ports[port];
+}
 
-void HAL_InitializeOSSerialPort(HAL_SerialPort port, int32_t* status) {
-  std::string portName;
+static void UpdateOptions(HAL_SerialPort port, int32_t* status,
+                          void (*update)(struct termios& options, int value),
+                          int value) {
+  auto p = GetPort(port, status);
+  if (!p) return;
+  struct termios options;
+  if (tcgetattr(p->fd, &options) != 0) {
+    *status = HAL_SERIAL_PORT_ERROR;
+    return;
+  }
+  update(options, value);
+  if (tcsetattr(p->fd, TCSANOW, &options) != 0) {
+    *status = HAL_SERIAL_PORT_ERROR;
+  }
+}
 
-  hal::SerialHelper serialHelper;
+// Returns the milliseconds left before deadline, for poll()
+static int RemainingMs(std::chrono::steady_clock::time_point deadline) {
+  auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+      deadline - std::chrono::steady_clock::now());
+  return std::max(static_cast<int>(remaining.count()), 0);
+}
 
-  portName = serialHelper.GetOSSerialPortName(port, status);
+// Waits for the fd to be ready for events. Returns false on timeout or error.
+static bool WaitReady(int fd, short events,
+                      std::chrono::steady_clock::time_point deadline,
+                      int32_t* status) {
+  for (;;) {
+    struct pollfd pfd = {fd, events, 0};
+    int ready = poll(&pfd, 1, RemainingMs(deadline));
+    if (ready > 0) {
+      if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+        *status = HAL_SERIAL_PORT_ERROR;
+        return false;
+      }
+      return true;
+    }
+    if (ready == 0) return false;
+    if (errno != EINTR) {
+      *status = HAL_SERIAL_PORT_ERROR;
+      return false;
+    }
+  }
+}
 
-  if (*status < 0) {
+// Writes all of two buffers with as few system calls as possible. Returns the
+// number of bytes written.
+static size_t WriteAll(OSSerialPort* p, const char* first, size_t firstCount,
+                       const char* second, size_t secondCount,
+                       int32_t* status) {
+  struct iovec iov[2] = {{const_cast<char*>(first), firstCount},
+                         {const_cast<char*>(second), secondCount}};
+  size_t total = firstCount + secondCount;
+  size_t written = 0;
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(p->timeoutMs);
+  while (written < total) {
+    // Skip the parts already written
+    int skip = iov[0].iov_len == 0 ? 1 : 0;
+    ssize_t count = writev(p->fd, iov + skip, 2 - skip);
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN && WaitReady(p->fd, POLLOUT, deadline, status)) {
+        continue;
+      }
+      if (errno != EAGAIN) *status = HAL_SERIAL_PORT_ERROR;
+      break;
+    }
+    written += count;
+    for (auto& vec : iov) {
+      size_t used = std::min(vec.iov_len, static_cast<size_t>(count));
+      vec.iov_base = static_cast<char*>(vec.iov_base) + used;
+      vec.iov_len -= used;
+      count -= used;
+    }
+  }
+  return written;
+}
+
+extern "C" {
+
+void HAL_InitializeOSSerialPortDirect(HAL_SerialPort port, const char* portName,
+                                      int32_t* status) {
+  if (port < 0 || port >= 4) {
+    *status = PARAMETER_OUT_OF_RANGE;
     return;
   }
 
-  int fs = open(portName.c_str(), O_RDWR | O_NOCTTY | O_NDELAY);
-  if (fs == -1) {
+  // Non-blocking, so reads and writes wait in poll() with the port timeout
+  int fd = open(portName, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+  if (fd == -1) {
     *status = HAL_SERIAL_PORT_OPEN_ERROR;
     return;
   }
-  portHandles[port] = fs;
+  ports[port] = OSSerialPort();
+  ports[port].fd = fd;
+  ports[port].readBuffer.resize(4096);
 
   struct termios options;
-  tcgetattr(fs, &options);
-  options.c_cflag = B9600 | CS8 | CLOCAL | CREAD;
-  options.c_iflag = 0;
-  options.c_oflag = 0;
-  options.c_lflag = 0;
-  tcflush(fs, TCIFLUSH);
-  tcsetattr(fs, TCSANOW, &options);
+  tcgetattr(fd, &options);
+  cfmakeraw(&options);
+  options.c_cflag |= CLOCAL | CREAD;
+  options.c_cc[VMIN] = 0;
+  options.c_cc[VTIME] = 0;
+  cfsetispeed(&options, B9600);
+  cfsetospeed(&options, B9600);
+  tcflush(fd, TCIFLUSH);
+  tcsetattr(fd, TCSANOW, &options);
+}
+
+void HAL_InitializeOSSerialPort(HAL_SerialPort port, int32_t* status) {
+  hal::SerialHelper serialHelper;
+
+  std::string portName = serialHelper.GetOSSerialPortName(port, status);
+
+  if (*status < 0) {
+    return;
+  }
+
+  HAL_InitializeOSSerialPortDirect(port, portName.c_str(), status);
+  if (*status < 0) return;
+
+  // USB serial adapters hold received bytes for up to 16 ms by default
+  if (port == HAL_SerialPort_USB1 || port == HAL_SerialPort_USB2) {
+    int32_t localStatus = 0;
+    HAL_SetOSSerialLowLatency(port, true, &localStatus);
+  }
 }
 
 void HAL_SetOSSerialBaudRate(HAL_SerialPort port, int32_t baud,
                              int32_t* status) {
-  int baudRate = -1;
+  speed_t baudRate;
   switch (baud) {
+    case 1200:
+      baudRate = B1200;
+      break;
+    case 2400:
+      baudRate = B2400;
+      break;
+    case 4800:
+      baudRate = B4800;
+      break;
     case 9600:
       baudRate = B9600;
       break;
@@ -84,28 +220,31 @@ void HAL_SetOSSerialBaudRate(HAL_SerialPort port, int32_t baud,
     case 115200:
       baudRate = B115200;
       break;
+    case 230400:
+      baudRate = B230400;
+      break;
+    case 460800:
+      baudRate = B460800;
+      break;
+    case 921600:
+      baudRate = B921600;
+      break;
     default:
       *status = PARAMETER_OUT_OF_RANGE;
       return;
   }
 
-  struct termios options;
-  tcgetattr(portHandles[port], &options);
-  auto set = cfsetospeed(&options, baudRate);
-  if (set != 0) {
-    *status = HAL_SERIAL_PORT_ERROR;
-    return;
-  }
-  set = tcsetattr(portHandles[port], TCSANOW, &options);
-  if (set != 0) {
-    *status = HAL_SERIAL_PORT_ERROR;
-    return;
-  }
+  UpdateOptions(port, status,
+                [](struct termios& options, int value) {
+                  cfsetispeed(&options, value);
+                  cfsetospeed(&options, value);
+                },
+                baudRate);
 }
 
 void HAL_SetOSSerialDataBits(HAL_SerialPort port, int32_t bits,
                              int32_t* status) {
-  int numBits = -1;
+  int numBits;
   switch (bits) {
     case 5:
       numBits = CS5;
@@ -124,121 +263,289 @@ void HAL_SetOSSerialDataBits(HAL_SerialPort port, int32_t bits,
       return;
   }
 
-  struct termios options;
-  tcgetattr(portHandles[port], &options);
-  options.c_cflag &= ~CSIZE;
-  options.c_cflag |= numBits;
-  auto set = tcsetattr(portHandles[port], TCSANOW, &options);
-  if (set != 0) {
-    *status = HAL_SERIAL_PORT_ERROR;
-    return;
-  }
+  UpdateOptions(port, status,
+                [](struct termios& options, int value) {
+                  options.c_cflag &= ~CSIZE;
+                  options.c_cflag |= value;
+                },
+                numBits);
 }
 
 void HAL_SetOSSerialParity(HAL_SerialPort port, int32_t parity,
                            int32_t* status) {
-  // Just set none parity
-  struct termios options;
-  tcgetattr(portHandles[port], &options);
-  options.c_cflag &= ~PARENB;
-  auto set = tcsetattr(portHandles[port], TCSANOW, &options);
-  if (set != 0) {
-    *status = HAL_SERIAL_PORT_ERROR;
-    return;
+  // Uses the values of SerialPort::Parity: none, odd, even, mark and space
+  tcflag_t flags;
+  switch (parity) {
+    case 0:
+      flags = 0;
+      break;
+    case 1:
+      flags = PARENB | PARODD;
+      break;
+    case 2:
+      flags = PARENB;
+      break;
+    case 3:
+      flags = PARENB | CMSPAR | PARODD;
+      break;
+    case 4:
+      flags = PARENB | CMSPAR;
+      break;
+    default:
+      *status = PARAMETER_OUT_OF_RANGE;
+      return;
   }
+
+  UpdateOptions(port, status,
+                [](struct termios& options, int value) {
+                  options.c_cflag &= ~(PARENB | PARODD | CMSPAR);
+                  options.c_cflag |= value;
+                },
+                flags);
 }
 
 void HAL_SetOSSerialStopBits(HAL_SerialPort port, int32_t stopBits,
                              int32_t* status) {
-  // Force 1 stop bit
-  struct termios options;
-  tcgetattr(portHandles[port], &options);
-  options.c_cflag &= ~CSTOPB;
-  auto set = tcsetattr(portHandles[port], TCSANOW, &options);
-  if (set != 0) {
-    *status = HAL_SERIAL_PORT_ERROR;
+  // Uses the values of SerialPort::StopBits; termios has no 1.5 stop bits
+  if (stopBits != 10 && stopBits != 20) {
+    *status = PARAMETER_OUT_OF_RANGE;
     return;
   }
+
+  UpdateOptions(port, status,
+                [](struct termios& options, int value) {
+                  if (value == 20) {
+                    options.c_cflag |= CSTOPB;
+                  } else {
+                    options.c_cflag &= ~CSTOPB;
+                  }
+                },
+                stopBits);
 }
 
 void HAL_SetOSSerialWriteMode(HAL_SerialPort port, int32_t mode,
                               int32_t* status) {
-  // No op
+  // Uses the values of SerialPort::WriteBufferMode
+  auto p = GetPort(port, status);
+  if (!p) return;
+  p->flushOnAccess = mode != 2;
+  if (p->flushOnAccess) HAL_FlushOSSerial(port, status);
 }
 
 void HAL_SetOSSerialFlowControl(HAL_SerialPort port, int32_t flow,
                                 int32_t* status) {
-  // No op
+  // Uses the values of SerialPort::FlowControl; DTR/DSR is not supported
+  if (flow != 0 && flow != 1 && flow != 2) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
+  UpdateOptions(port, status,
+                [](struct termios& options, int value) {
+                  options.c_cflag &= ~CRTSCTS;
+                  options.c_iflag &= ~(IXON | IXOFF | IXANY);
+                  if (value == 1) options.c_iflag |= IXON | IXOFF;
+                  if (value == 2) options.c_cflag |= CRTSCTS;
+                },
+                flow);
 }
 
 void HAL_SetOSSerialTimeout(HAL_SerialPort port, double timeout,
                             int32_t* status) {
-  // Convert to millis
-  int t = timeout / 1000;
-  portTimeouts[port] = std::chrono::milliseconds(t);
+  auto p = GetPort(port, status);
+  if (!p) return;
+  p->timeoutMs = std::max(static_cast<int>(timeout * 1e3), 0);
 }
 
 void HAL_EnableOSSerialTermination(HAL_SerialPort port, char terminator,
                                    int32_t* status) {
-  // \n is hardcoded for now. Will fix later
-  // Seems like a VISA only setting, need to check
+  auto p = GetPort(port, status);
+  if (!p) return;
+  p->termination = true;
+  p->terminator = terminator;
 }
 
 void HAL_DisableOSSerialTermination(HAL_SerialPort port, int32_t* status) {
-  // Seems like a VISA only setting, need to check
+  auto p = GetPort(port, status);
+  if (!p) return;
+  p->termination = false;
 }
 
 void HAL_SetOSSerialReadBufferSize(HAL_SerialPort port, int32_t size,
                                    int32_t* status) {
-  // No op
+  auto p = GetPort(port, status);
+  if (!p) return;
+  if (size < 1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  // Keeps the bytes already received
+  std::vector<char> buffer(p->readBuffer.begin() + p->readPos,
+                           p->readBuffer.begin() + p->readEnd);
+  buffer.resize(std::max(buffer.size(), static_cast<size_t>(size)));
+  p->readEnd -= p->readPos;
+  p->readPos = 0;
+  p->readBuffer.swap(buffer);
 }
 
 void HAL_SetOSSerialWriteBufferSize(HAL_SerialPort port, int32_t size,
                                     int32_t* status) {
-  // No op
+  auto p = GetPort(port, status);
+  if (!p) return;
+  if (size < 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  p->writeBufferSize = size;
+  if (p->writeBuffer.size() > p->writeBufferSize) {
+    HAL_FlushOSSerial(port, status);
+  }
+}
+
+void HAL_SetOSSerialLowLatency(HAL_SerialPort port, HAL_Bool lowLatency,
+                               int32_t* status) {
+  auto p = GetPort(port, status);
+  if (!p) return;
+  struct serial_struct serial;
+  if (ioctl(p->fd, TIOCGSERIAL, &serial) != 0) {
+    *status = HAL_SERIAL_PORT_ERROR;
+    return;
+  }
+  if (lowLatency) {
+    serial.flags |= ASYNC_LOW_LATENCY;
+  } else {
+    serial.flags &= ~ASYNC_LOW_LATENCY;
+  }
+  if (ioctl(p->fd, TIOCSSERIAL, &serial) != 0) {
+    *status = HAL_SERIAL_PORT_ERROR;
+  }
+}
+
+int32_t HAL_GetOSSerialFileDescriptor(HAL_SerialPort port, int32_t* status) {
+  auto p = GetPort(port, status);
+  if (!p) return -1;
+  return p->fd;
 }
 
 int32_t HAL_GetOSSerialBytesReceived(HAL_SerialPort port, int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterSerial);
+  auto p = GetPort(port, status);
+  if (!p) return 0;
   int bytes = 0;
-  ioctl(portHandles[port], FIONREAD, &bytes);
-  return bytes;
+  if (ioctl(p->fd, FIONREAD, &bytes) != 0) {
+    *status = HAL_SERIAL_PORT_ERROR;
+    return 0;
+  }
+  return bytes + static_cast<int32_t>(p->readEnd - p->readPos);
 }
 
 int32_t HAL_ReadOSSerial(HAL_SerialPort port, char* buffer, int32_t count,
                          int32_t* status) {
-  auto endTime = std::chrono::steady_clock::now() + portTimeouts[port];
-
-  int bytesRead = 0;
-
-  unsigned char buf[256];
-
-  do {
-    int rx = read(portHandles[port], buf, count - bytesRead);
-    std::memcpy(&buffer[bytesRead], buf, rx);
-    bytesRead += rx;
-    if (bytesRead >= count) break;
-    llvm::StringRef tmp(buffer, bytesRead);
-    auto loc = tmp.find('\n');
-    if (loc != llvm::StringRef::npos) {
-      bytesRead = loc;
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterSerial);
+  hal::BusStatisticsScope busScope(HAL_kBusSerial, port, status);
+  auto p = GetPort(port, status);
+  if (!p || count <= 0) return 0;
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(p->timeoutMs);
+  size_t total = count;
+  size_t bytesRead = 0;
+  for (;;) {
+    // Bytes left over from the last read come first
+    if (p->readPos < p->readEnd) {
+      size_t n = std::min(total - bytesRead, p->readEnd - p->readPos);
+      const char* start = p->readBuffer.data() + p->readPos;
+      bool terminated = false;
+      if (p->termination) {
+        auto end = static_cast<const char*>(std::memchr(start, p->terminator, n));
+        if (end) {
+          n = end - start + 1;
+          terminated = true;
+        }
+      }
+      std::memcpy(buffer + bytesRead, start, n);
+      bytesRead += n;
+      p->readPos += n;
+      if (terminated || bytesRead == total) break;
+    }
+    p->readPos = 0;
+    p->readEnd = 0;
+
+    // Without termination, bytes go straight to the caller
+    ssize_t rx;
+    if (p->termination) {
+      rx = read(p->fd, p->readBuffer.data(), p->readBuffer.size());
+    } else {
+      rx = read(p->fd, buffer + bytesRead, total - bytesRead);
+    }
+    if (rx > 0) {
+      if (p->termination) {
+        p->readEnd = rx;
+      } else {
+        bytesRead += rx;
+        if (bytesRead == total) break;
+      }
+      continue;
+    }
+    if (rx < 0 && errno == EINTR) continue;
+    if (rx < 0 && errno != EAGAIN) {
+      *status = HAL_SERIAL_PORT_ERROR;
       break;
     }
-  } while (std::chrono::steady_clock::now() < endTime);
-  return bytesRead;
+    // Nothing queued; a timeout returns what was read so far
+    if (!WaitReady(p->fd, POLLIN, deadline, status)) break;
+  }
+
+  return static_cast<int32_t>(bytesRead);
 }
 
 int32_t HAL_WriteOSSerial(HAL_SerialPort port, const char* buffer,
                           int32_t count, int32_t* status) {
-  return write(portHandles[port], buffer, count);
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterSerial);
+  hal::BusStatisticsScope busScope(HAL_kBusSerial, port, status);
+  auto p = GetPort(port, status);
+  if (!p || count <= 0) return 0;
+
+  auto& pending = p->writeBuffer;
+  if (!p->flushOnAccess && pending.size() + count <= p->writeBufferSize) {
+    pending.insert(pending.end(), buffer, buffer + count);
+    return count;
+  }
+
+  // Held back bytes and the new ones go out in a single writev()
+  size_t held = pending.size();
+  size_t written = WriteAll(p, pending.data(), held, buffer, count, status);
+  if (written < held) {
+    pending.erase(pending.begin(), pending.begin() + written);
+    return 0;
+  }
+  pending.clear();
+  return static_cast<int32_t>(written - held);
 }
+
 void HAL_FlushOSSerial(HAL_SerialPort port, int32_t* status) {
-  tcdrain(portHandles[port]);
+  auto p = GetPort(port, status);
+  if (!p || p->writeBuffer.empty()) return;
+  size_t written = WriteAll(p, p->writeBuffer.data(), p->writeBuffer.size(),
+                            nullptr, 0, status);
+  p->writeBuffer.erase(p->writeBuffer.begin(),
+                       p->writeBuffer.begin() + written);
 }
+
 void HAL_ClearOSSerial(HAL_SerialPort port, int32_t* status) {
-  tcflush(portHandles[port], TCIOFLUSH);
+  auto p = GetPort(port, status);
+  if (!p) return;
+  p->readPos = 0;
+  p->readEnd = 0;
+  p->writeBuffer.clear();
+  if (tcflush(p->fd, TCIOFLUSH) != 0) *status = HAL_SERIAL_PORT_ERROR;
 }
+
 void HAL_CloseOSSerial(HAL_SerialPort port, int32_t* status) {
-  close(portHandles[port]);
+  auto p = GetPort(port, status);
+  if (!p) return;
+  close(p->fd);
+  *p = OSSerialPort();
 }
 
 }  // extern "C"
@@ -11,6 +11,7 @@
 
 #include "HAL/Errors.h"
 #include "HAL/Ports.h"
+#include "HAL/cpp/BusStatistics.h"
 #include "HAL/cpp/make_unique.h"
 #include "PortsInternal.h"
 #include "ctre/PDP.h"
@@ -63,6 +64,7 @@ HAL_Bool HAL_CheckPDPChannel(int32_t channel) {
 
 double HAL_GetPDPTemperature(int32_t module, int32_t* status) {
   if (!checkPDPInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPDP, module, status);
 
   double temperature;
 
@@ -73,6 +75,7 @@ double HAL_GetPDPTemperature(int32_t module, int32_t* status) {
 
 double HAL_GetPDPVoltage(int32_t module, int32_t* status) {
   if (!checkPDPInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPDP, module, status);
 
   double voltage;
 
@@ -84,6 +87,7 @@ double HAL_GetPDPVoltage(int32_t module, int32_t* status) {
 double HAL_GetPDPChannelCurrent(int32_t module, int32_t channel,
                                 int32_t* status) {
   if (!checkPDPInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPDP, module, status);
 
   double current;
 
@@ -94,6 +98,7 @@ double HAL_GetPDPChannelCurrent(int32_t module, int32_t channel,
 
 double HAL_GetPDPTotalCurrent(int32_t module, int32_t* status) {
   if (!checkPDPInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPDP, module, status);
 
   double current;
 
@@ -104,6 +109,7 @@ double HAL_GetPDPTotalCurrent(int32_t module, int32_t* status) {
 
 double HAL_GetPDPTotalPower(int32_t module, int32_t* status) {
   if (!checkPDPInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPDP, module, status);
 
   double power;
 
@@ -114,6 +120,7 @@ double HAL_GetPDPTotalPower(int32_t module, int32_t* status) {
 
 double HAL_GetPDPTotalEnergy(int32_t module, int32_t* status) {
   if (!checkPDPInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPDP, module, status);
 
   double energy;
 
@@ -122,6 +129,26 @@ double HAL_GetPDPTotalEnergy(int32_t module, int32_t* status) {
   return energy;
 }
 
+void HAL_GetPDPAllCurrents(int32_t module, double* currents, int32_t* status) {
+  if (!checkPDPInit(module, status)) return;
+  BusStatisticsScope busScope(HAL_kBusPDP, module, status);
+
+  uint32_t timeStamps[3];
+
+  *status = pdp[module]->GetAllCurrents(currents, timeStamps);
+}
+
+void HAL_GetPDPSnapshot(int32_t module, HAL_PDPSnapshot* snapshot,
+                        int32_t* status) {
+  if (!checkPDPInit(module, status)) return;
+  BusStatisticsScope busScope(HAL_kBusPDP, module, status);
+
+  *status = pdp[module]->GetAll(
+      snapshot->currents, snapshot->voltage, snapshot->temperature,
+      snapshot->totalCurrent, snapshot->totalPower, snapshot->totalEnergy,
+      snapshot->frameTimeStamps);
+}
+
 void HAL_ResetPDPTotalEnergy(int32_t module, int32_t* status) {
   if (!checkPDPInit(module, status)) return;
 
@@ -7,10 +7,13 @@
 
 #include "HAL/PWM.h"
 
+#include <array>
+#include <atomic>
 #include <cmath>
 
 #include "ConstantsInternal.h"
 #include "DigitalInternal.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "PortsInternal.h"
 
@@ -56,9 +59,85 @@ static inline int32_t GetFullRangeScaleFactor(DigitalPort* port) {
   return GetMaxPositivePwm(port) - GetMinNegativePwm(port);
 }  ///< The scale for positions.
 
+// Raw values staged while outputs are deferred, or kNoStagedValue
+static constexpr int32_t kNoStagedValue = -1;
+static std::array<std::atomic<int32_t>, kNumPWMChannels> stagedPWMValues;
+static std::atomic_bool pwmOutputsDeferred{false};
+
+static void WritePWMRegister(int32_t channel, int32_t value, int32_t* status) {
+  if (channel < tPWM::kNumHdrRegisters) {
+    pwmSystem->writeHdr(channel, value, status);
+  } else {
+    pwmSystem->writeMXP(channel - tPWM::kNumHdrRegisters, value, status);
+  }
+}
+
+/**
+ * Write a scaled output, or stage it for HAL_CommitPWMOutputs() while outputs
+ * are deferred.
+ */
+static void SetPWMOutput(DigitalPort* port, int32_t value, int32_t* status) {
+  if (pwmOutputsDeferred) {
+    stagedPWMValues[port->channel] = value;
+  } else {
+    WritePWMRegister(port->channel, value, status);
+  }
+}
+
+/**
+ * Scale a speed to a raw value and write or stage it.
+ */
+static void SetPWMSpeed(HAL_DigitalHandle pwmPortHandle, double speed,
+                        int32_t* status) {
+  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
+  if (port == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (!port->configSet) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+
+  DigitalPort* dPort = port.get();
+
+  if (speed < -1.0) {
+    speed = -1.0;
+  } else if (speed > 1.0) {
+    speed = 1.0;
+  } else if (!std::isfinite(speed)) {
+    speed = 0.0;
+  }
+
+  // calculate the desired output pwm value by scaling the speed appropriately
+  int32_t rawValue;
+  if (speed == 0.0) {
+    rawValue = GetCenterPwm(dPort);
+  } else if (speed > 0.0) {
+    rawValue = static_cast<int32_t>(
+        speed * static_cast<double>(GetPositiveScaleFactor(dPort)) +
+        static_cast<double>(GetMinPositivePwm(dPort)) + 0.5);
+  } else {
+    rawValue = static_cast<int32_t>(
+        speed * static_cast<double>(GetNegativeScaleFactor(dPort)) +
+        static_cast<double>(GetMaxNegativePwm(dPort)) + 0.5);
+  }
+
+  if (!((rawValue >= GetMinNegativePwm(dPort)) &&
+        (rawValue <= GetMaxPositivePwm(dPort))) ||
+      rawValue == kPwmDisabled) {
+    *status = HAL_PWM_SCALE_ERROR;
+    return;
+  }
+
+  SetPWMOutput(dPort, rawValue, status);
+}
+
 namespace hal {
 namespace init {
-void InitializePWM() {}
+void InitializePWM() {
+  for (auto& value : stagedPWMValues) value = kNoStagedValue;
+}
 }  // namespace init
 }  // namespace hal
 
@@ -116,6 +195,9 @@ void HAL_FreePWMPort(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
     return;
   }
 
+  // Don't let a pending commit drive a channel that is no longer allocated
+  stagedPWMValues[port->channel] = kNoStagedValue;
+
   if (port->channel > tPWM::kNumHdrRegisters - 1) {
     int32_t bitToUnset = 1 << remapMXPPWMChannel(port->channel);
     uint16_t specialFunctions =
@@ -227,17 +309,16 @@ HAL_Bool HAL_GetPWMEliminateDeadband(HAL_DigitalHandle pwmPortHandle,
  */
 void HAL_SetPWMRaw(HAL_DigitalHandle pwmPortHandle, int32_t value,
                    int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterPWM);
   auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return;
   }
 
-  if (port->channel < tPWM::kNumHdrRegisters) {
-    pwmSystem->writeHdr(port->channel, value, status);
-  } else {
-    pwmSystem->writeMXP(port->channel - tPWM::kNumHdrRegisters, value, status);
-  }
+  // Raw writes always take effect immediately, and replace any staged value
+  stagedPWMValues[port->channel] = kNoStagedValue;
+  WritePWMRegister(port->channel, value, status);
 }
 
 /**
@@ -251,48 +332,29 @@ void HAL_SetPWMRaw(HAL_DigitalHandle pwmPortHandle, int32_t value,
  */
 void HAL_SetPWMSpeed(HAL_DigitalHandle pwmPortHandle, double speed,
                      int32_t* status) {
-  auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
-  if (port == nullptr) {
-    *status = HAL_HANDLE_ERROR;
-    return;
-  }
-  if (!port->configSet) {
-    *status = INCOMPATIBLE_STATE;
-    return;
-  }
-
-  DigitalPort* dPort = port.get();
-
-  if (speed < -1.0) {
-    speed = -1.0;
-  } else if (speed > 1.0) {
-    speed = 1.0;
-  } else if (!std::isfinite(speed)) {
-    speed = 0.0;
-  }
-
-  // calculate the desired output pwm value by scaling the speed appropriately
-  int32_t rawValue;
-  if (speed == 0.0) {
-    rawValue = GetCenterPwm(dPort);
-  } else if (speed > 0.0) {
-    rawValue = static_cast<int32_t>(
-        speed * static_cast<double>(GetPositiveScaleFactor(dPort)) +
-        static_cast<double>(GetMinPositivePwm(dPort)) + 0.5);
-  } else {
-    rawValue = static_cast<int32_t>(
-        speed * static_cast<double>(GetNegativeScaleFactor(dPort)) +
-        static_cast<double>(GetMaxNegativePwm(dPort)) + 0.5);
-  }
+  PerfCounterScope perfScope(HAL_kPerfCounterPWM);
+  SetPWMSpeed(pwmPortHandle, speed, status);
+}
 
-  if (!((rawValue >= GetMinNegativePwm(dPort)) &&
-        (rawValue <= GetMaxPositivePwm(dPort))) ||
-      rawValue == kPwmDisabled) {
-    *status = HAL_PWM_SCALE_ERROR;
-    return;
+/**
+ * Set the speeds of several PWM channels in one call.
+ *
+ * Every channel is written even if another fails, so a group of motors is
+ * never left half updated; status reports the first error. While outputs are
+ * deferred the speeds are staged like those from HAL_SetPWMSpeed().
+ *
+ * @param pwmPortHandles The channels to set
+ * @param speeds         The speed for each channel, from -1.0 to 1.0
+ * @param count          The number of channels
+ */
+void HAL_SetPWMSpeeds(const HAL_DigitalHandle* pwmPortHandles,
+                      const double* speeds, int32_t count, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterPWM);
+  for (int32_t i = 0; i < count; i++) {
+    int32_t channelStatus = 0;
+    SetPWMSpeed(pwmPortHandles[i], speeds[i], &channelStatus);
+    if (*status == 0) *status = channelStatus;
   }
-
-  HAL_SetPWMRaw(pwmPortHandle, rawValue, status);
 }
 
 /**
@@ -306,6 +368,7 @@ void HAL_SetPWMSpeed(HAL_DigitalHandle pwmPortHandle, double speed,
  */
 void HAL_SetPWMPosition(HAL_DigitalHandle pwmPortHandle, double pos,
                         int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterPWM);
   auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
@@ -334,10 +397,11 @@ void HAL_SetPWMPosition(HAL_DigitalHandle pwmPortHandle, double pos,
     return;
   }
 
-  HAL_SetPWMRaw(pwmPortHandle, rawValue, status);
+  SetPWMOutput(dPort, rawValue, status);
 }
 
 void HAL_SetPWMDisabled(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
+  // Never deferred, so motor safety can stop an output from any thread
   HAL_SetPWMRaw(pwmPortHandle, kPwmDisabled, status);
 }
 
@@ -348,12 +412,16 @@ void HAL_SetPWMDisabled(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
  * @return The raw PWM value.
  */
 int32_t HAL_GetPWMRaw(HAL_DigitalHandle pwmPortHandle, int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterPWM);
   auto port = digitalChannelHandles->Get(pwmPortHandle, HAL_HandleEnum::PWM);
   if (port == nullptr) {
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
 
+  int32_t staged = stagedPWMValues[port->channel];
+  if (staged != kNoStagedValue) return staged;
+
   if (port->channel < tPWM::kNumHdrRegisters) {
     return pwmSystem->readHdr(port->channel, status);
   } else {
@@ -495,4 +563,33 @@ uint64_t HAL_GetPWMCycleStartTime(int32_t* status) {
   return (upper2 << 32) + lower;
 }
 
+/**
+ * Defer speed and position writes until HAL_CommitPWMOutputs() is called, so
+ * the outputs computed in one loop iteration are written back to back. Raw and
+ * disabled writes still take effect immediately. Leaving deferred mode commits
+ * any staged outputs.
+ *
+ * @param deferred True to stage writes, false to write them immediately.
+ */
+void HAL_SetPWMOutputsDeferred(HAL_Bool deferred, int32_t* status) {
+  pwmOutputsDeferred = deferred;
+  if (!deferred) HAL_CommitPWMOutputs(status);
+}
+
+HAL_Bool HAL_GetPWMOutputsDeferred(void) { return pwmOutputsDeferred; }
+
+/**
+ * Write every staged PWM output.
+ */
+void HAL_CommitPWMOutputs(int32_t* status) {
+  PerfCounterScope perfScope(HAL_kPerfCounterPWM);
+  initializeDigital(status);
+  if (*status != 0) return;
+
+  for (int32_t channel = 0; channel < kNumPWMChannels; channel++) {
+    int32_t value = stagedPWMValues[channel].exchange(kNoStagedValue);
+    if (value != kNoStagedValue) WritePWMRegister(channel, value, status);
+  }
+}
+
 }  // extern "C"
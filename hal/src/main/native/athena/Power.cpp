@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "HAL/ChipObject.h"
+#include "HAL/HAL.h"
 
 using namespace hal;
 
@@ -148,4 +149,41 @@ int32_t HAL_GetUserCurrentFaults3V3(int32_t* status) {
       power->readFaultCounts_OverCurrentFaultCount3V3(status));
 }
 
+/**
+ * Get every rail voltage, current, active state and fault count
+ *
+ * The rail states and the fault counts each come from a single register read,
+ * rather than one per rail.
+ */
+void HAL_GetPowerSnapshot(HAL_PowerSnapshot* snapshot, int32_t* status) {
+  initializePower(status);
+  snapshot->timeStamp = HAL_GetFPGATime(status);
+  snapshot->vinVoltage =
+      power->readVinVoltage(status) / 4.096 * 0.025733 - 0.029;
+  snapshot->vinCurrent =
+      power->readVinCurrent(status) / 4.096 * 0.017042 - 0.071;
+  snapshot->userVoltage6V =
+      power->readUserVoltage6V(status) / 4.096 * 0.007019 - 0.014;
+  snapshot->userCurrent6V =
+      power->readUserCurrent6V(status) / 4.096 * 0.005566 - 0.009;
+  snapshot->userVoltage5V =
+      power->readUserVoltage5V(status) / 4.096 * 0.005962 - 0.013;
+  snapshot->userCurrent5V =
+      power->readUserCurrent5V(status) / 4.096 * 0.001996 - 0.002;
+  snapshot->userVoltage3V3 =
+      power->readUserVoltage3V3(status) / 4.096 * 0.004902 - 0.01;
+  snapshot->userCurrent3V3 =
+      power->readUserCurrent3V3(status) / 4.096 * 0.002486 - 0.003;
+
+  tPower::tStatus railStatus = power->readStatus(status);
+  snapshot->userActive6V = railStatus.User6V == 4;
+  snapshot->userActive5V = railStatus.User5V == 4;
+  snapshot->userActive3V3 = railStatus.User3V3 == 4;
+
+  tPower::tFaultCounts faultCounts = power->readFaultCounts(status);
+  snapshot->userCurrentFaults6V = faultCounts.OverCurrentFaultCount6V;
+  snapshot->userCurrentFaults5V = faultCounts.OverCurrentFaultCount5V;
+  snapshot->userCurrentFaults3V3 = faultCounts.OverCurrentFaultCount3V3;
+}
+
 }  // extern "C"
@@ -125,6 +125,33 @@ void HAL_SetRelay(HAL_RelayHandle relayPortHandle, HAL_Bool on,
   }
 }
 
+/**
+ * Set several relay outputs with a single write of the FPGA.
+ *
+ * @param mask   A mask with bit n set for the forward output of relay channel
+ *               n, and bit n + 4 for its reverse output.
+ * @param values The new output states, one bit per output as in mask.
+ */
+void HAL_SetRelaysMasked(uint32_t mask, uint32_t values, int32_t* status) {
+  if (mask >> kNumRelayChannels) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  initializeDigital(status);
+  if (*status != 0) return;
+
+  constexpr uint32_t kHeaderBits = (1u << kNumRelayHeaders) - 1;
+  uint8_t forwardMask = mask & kHeaderBits;
+  uint8_t reverseMask = (mask >> kNumRelayHeaders) & kHeaderBits;
+  std::lock_guard<wpi::mutex> lock(digitalRelayMutex);
+  tRelay::tValue relays = relaySystem->readValue(status);
+  if (*status != 0) return;  // bad status read
+  relays.Forward = (relays.Forward & ~forwardMask) | (values & forwardMask);
+  relays.Reverse = (relays.Reverse & ~reverseMask) |
+                   ((values >> kNumRelayHeaders) & reverseMask);
+  relaySystem->writeValue(relays, status);
+}
+
 /**
  * Get the current state of the relay channel
  */
@@ -12,16 +12,24 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include <llvm/raw_ostream.h>
+#include <support/condition_variable.h>
 #include <support/mutex.h>
 
 #include "DigitalInternal.h"
 #include "HAL/DIO.h"
 #include "HAL/HAL.h"
+#include "HAL/cpp/BusStatistics.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/cpp/make_unique.h"
 #include "HAL/handles/HandlesInternal.h"
 
@@ -60,6 +68,122 @@ static bool SPIInUseByAuto(HAL_SPIPort port) {
          (spiAutoPort == 4 && port == 4);
 }
 
+namespace {
+/**
+ * The FPGA has a single auto SPI engine. Ports that start auto transfers while
+ * it is taken get one of these instead: a thread that runs the configured
+ * transfer on the port's spidev at a fixed rate and queues the received bytes
+ * in its own buffer, with its own dropped transfer count.
+ */
+struct SoftwareSPIAuto {
+  SoftwareSPIAuto(HAL_SPIPort port, int32_t bufferSize)
+      : port(port), buffer(bufferSize) {}
+  ~SoftwareSPIAuto() { Stop(); }
+
+  void Start(double period);
+  void Stop();
+  void Transfer();
+  int32_t Read(uint8_t* data, int32_t numToRead, double timeout);
+
+  const HAL_SPIPort port;
+
+  wpi::mutex mutex;
+  wpi::condition_variable dataAvailable;
+  std::vector<uint8_t> transmit;
+  std::vector<uint8_t> buffer;
+  size_t head = 0;
+  size_t size = 0;
+  int32_t dropped = 0;
+
+  std::atomic_bool running{false};
+  std::thread thread;
+};
+}  // namespace
+
+// Indexed by port; only set for ports not using the FPGA engine. Shared so a
+// read can wait on an engine without holding spiAutoMutex.
+static std::array<std::shared_ptr<SoftwareSPIAuto>, kSpiMaxHandles>
+    spiSoftwareAuto;
+
+static SoftwareSPIAuto* GetSoftwareSPIAuto(HAL_SPIPort port) {
+  if (port < 0 || port >= kSpiMaxHandles) return nullptr;
+  return spiSoftwareAuto[port].get();
+}
+
+void SoftwareSPIAuto::Start(double period) {
+  Stop();
+  running = true;
+  auto step = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(period));
+  thread = std::thread([=] {
+    auto next = std::chrono::steady_clock::now();
+    while (running) {
+      Transfer();
+      next += step;
+      std::this_thread::sleep_until(next);
+    }
+  });
+}
+
+void SoftwareSPIAuto::Stop() {
+  running = false;
+  if (thread.joinable()) thread.join();
+}
+
+void SoftwareSPIAuto::Transfer() {
+  // largest transfer: 16 data bytes and 127 zero bytes
+  uint8_t txData[143];
+  uint8_t rxData[143];
+  size_t len;
+  {
+    std::lock_guard<wpi::mutex> lock(mutex);
+    len = transmit.size();
+    std::copy(transmit.begin(), transmit.end(), txData);
+  }
+  if (len == 0) return;
+
+  struct spi_ioc_transfer xfer;
+  std::memset(&xfer, 0, sizeof(xfer));
+  xfer.tx_buf = (__u64)txData;
+  xfer.rx_buf = (__u64)rxData;
+  xfer.len = len;
+
+  {
+    std::lock_guard<wpi::mutex> lock(spiApiMutexes[port]);
+    if (ioctl(HAL_GetSPIHandle(port), SPI_IOC_MESSAGE(1), &xfer) < 0) return;
+  }
+
+  {
+    std::lock_guard<wpi::mutex> lock(mutex);
+    // like the FPGA engine, a transfer that does not fit is skipped whole
+    if (buffer.size() - size < len) {
+      ++dropped;
+      return;
+    }
+    for (size_t i = 0; i < len; ++i)
+      buffer[(head + size + i) % buffer.size()] = rxData[i];
+    size += len;
+  }
+  dataAvailable.notify_all();
+}
+
+int32_t SoftwareSPIAuto::Read(uint8_t* data, int32_t numToRead,
+                              double timeout) {
+  std::unique_lock<wpi::mutex> lock(mutex);
+  size_t count = numToRead;
+  if (size < count && timeout > 0) {
+    dataAvailable.wait_for(lock, std::chrono::duration<double>(timeout),
+                           [&] { return size >= count; });
+  }
+  // like tDMAManager, only complete reads consume data
+  if (size < count) return size;
+  for (size_t i = 0; i < count; ++i)
+    data[i] = buffer[(head + i) % buffer.size()];
+  head = (head + count) % buffer.size();
+  size -= count;
+  return size;
+}
+
 namespace hal {
 namespace init {
 void InitializeSPI() {}
@@ -257,6 +381,8 @@ void HAL_InitializeSPI(HAL_SPIPort port, int32_t* status) {
  */
 int32_t HAL_TransactionSPI(HAL_SPIPort port, const uint8_t* dataToSend,
                            uint8_t* dataReceived, int32_t size) {
+  PerfCounterScope perfScope(HAL_kPerfCounterSPI);
+  BusStatisticsScope busScope(HAL_kBusSPI, port);
   if (port < 0 || port >= kSpiMaxHandles) {
     return -1;
   }
@@ -270,7 +396,50 @@ int32_t HAL_TransactionSPI(HAL_SPIPort port, const uint8_t* dataToSend,
   xfer.len = size;
 
   std::lock_guard<wpi::mutex> lock(spiApiMutexes[port]);
-  return ioctl(HAL_GetSPIHandle(port), SPI_IOC_MESSAGE(1), &xfer);
+  int32_t result = ioctl(HAL_GetSPIHandle(port), SPI_IOC_MESSAGE(1), &xfer);
+  return busScope.Result(result);
+}
+
+/**
+ * Execute several transfers with the device as one transaction.
+ *
+ * All segments are submitted with a single ioctl, so a burst read plus its
+ * command bytes costs one system call and one lock. Each segment can
+ * deselect the chip afterwards and add a delay.
+ *
+ * @param port The number of the port to use. 0-3 for Onboard CS0-CS2, 4 for MXP
+ * @param transfers The segments, in order
+ * @param count The number of segments [1..HAL_kSPIMaxBatchTransfers]
+ * @return Total number of bytes transferred, -1 for error
+ */
+int32_t HAL_TransactionSPIBatch(HAL_SPIPort port,
+                                const struct HAL_SPITransfer* transfers,
+                                int32_t count) {
+  PerfCounterScope perfScope(HAL_kPerfCounterSPI);
+  BusStatisticsScope busScope(HAL_kBusSPI, port);
+  if (port < 0 || port >= kSpiMaxHandles) {
+    return -1;
+  }
+
+  if (count <= 0 || count > HAL_kSPIMaxBatchTransfers) return -1;
+
+  if (SPIInUseByAuto(port)) return -1;
+
+  struct spi_ioc_transfer xfers[HAL_kSPIMaxBatchTransfers];
+  std::memset(xfers, 0, sizeof(xfers[0]) * count);
+  for (int32_t i = 0; i < count; i++) {
+    xfers[i].tx_buf = (__u64)transfers[i].dataToSend;
+    xfers[i].rx_buf = (__u64)transfers[i].dataReceived;
+    xfers[i].len = transfers[i].size;
+    xfers[i].cs_change = transfers[i].csChange ? 1 : 0;
+    xfers[i].delay_usecs = transfers[i].delayMicroseconds;
+  }
+
+  std::lock_guard<wpi::mutex> lock(spiApiMutexes[port]);
+  // SPI_IOC_MESSAGE(count), which needs a constant count
+  return busScope.Result(
+      ioctl(HAL_GetSPIHandle(port),
+            _IOC(_IOC_WRITE, SPI_IOC_MAGIC, 0, SPI_MSGSIZE(count)), xfers));
 }
 
 /**
@@ -285,6 +454,8 @@ int32_t HAL_TransactionSPI(HAL_SPIPort port, const uint8_t* dataToSend,
  */
 int32_t HAL_WriteSPI(HAL_SPIPort port, const uint8_t* dataToSend,
                      int32_t sendSize) {
+  PerfCounterScope perfScope(HAL_kPerfCounterSPI);
+  BusStatisticsScope busScope(HAL_kBusSPI, port);
   if (port < 0 || port >= kSpiMaxHandles) {
     return -1;
   }
@@ -297,7 +468,8 @@ int32_t HAL_WriteSPI(HAL_SPIPort port, const uint8_t* dataToSend,
   xfer.len = sendSize;
 
   std::lock_guard<wpi::mutex> lock(spiApiMutexes[port]);
-  return ioctl(HAL_GetSPIHandle(port), SPI_IOC_MESSAGE(1), &xfer);
+  int32_t result = ioctl(HAL_GetSPIHandle(port), SPI_IOC_MESSAGE(1), &xfer);
+  return busScope.Result(result);
 }
 
 /**
@@ -314,6 +486,8 @@ int32_t HAL_WriteSPI(HAL_SPIPort port, const uint8_t* dataToSend,
  * @return Number of bytes read. -1 for error.
  */
 int32_t HAL_ReadSPI(HAL_SPIPort port, uint8_t* buffer, int32_t count) {
+  PerfCounterScope perfScope(HAL_kPerfCounterSPI);
+  BusStatisticsScope busScope(HAL_kBusSPI, port);
   if (port < 0 || port >= kSpiMaxHandles) {
     return -1;
   }
@@ -326,7 +500,8 @@ int32_t HAL_ReadSPI(HAL_SPIPort port, uint8_t* buffer, int32_t count) {
   xfer.len = count;
 
   std::lock_guard<wpi::mutex> lock(spiApiMutexes[port]);
-  return ioctl(HAL_GetSPIHandle(port), SPI_IOC_MESSAGE(1), &xfer);
+  int32_t result = ioctl(HAL_GetSPIHandle(port), SPI_IOC_MESSAGE(1), &xfer);
+  return busScope.Result(result);
 }
 
 /**
@@ -522,13 +697,29 @@ void HAL_InitSPIAuto(HAL_SPIPort port, int32_t bufferSize, int32_t* status) {
     return;
   }
 
+  if (bufferSize <= 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+
   std::lock_guard<wpi::mutex> lock(spiAutoMutex);
-  // FPGA only has one auto SPI engine
-  if (spiAutoPort != kSpiMaxHandles) {
+  if (port == spiAutoPort || spiSoftwareAuto[port]) {
     *status = RESOURCE_IS_ALLOCATED;
     return;
   }
 
+  // FPGA only has one auto SPI engine; other ports run in software
+  if (spiAutoPort != kSpiMaxHandles) {
+    // the FPGA engine holds its SPI device while running, so the software
+    // engine has to be on the other device
+    if ((spiAutoPort < 4) == (port < 4)) {
+      *status = RESOURCE_IS_ALLOCATED;
+      return;
+    }
+    spiSoftwareAuto[port] = std::make_shared<SoftwareSPIAuto>(port, bufferSize);
+    return;
+  }
+
   // remember the initialized port for other entry points
   spiAutoPort = port;
 
@@ -554,6 +745,10 @@ void HAL_FreeSPIAuto(HAL_SPIPort port, int32_t* status) {
   }
 
   std::lock_guard<wpi::mutex> lock(spiAutoMutex);
+  if (spiSoftwareAuto[port]) {
+    spiSoftwareAuto[port].reset();
+    return;
+  }
   if (spiAutoPort != port) return;
   spiAutoPort = kSpiMaxHandles;
 
@@ -571,6 +766,10 @@ void HAL_FreeSPIAuto(HAL_SPIPort port, int32_t* status) {
 
 void HAL_StartSPIAutoRate(HAL_SPIPort port, double period, int32_t* status) {
   std::lock_guard<wpi::mutex> lock(spiAutoMutex);
+  if (auto software = GetSoftwareSPIAuto(port)) {
+    software->Start(period);
+    return;
+  }
   // FPGA only has one auto SPI engine
   if (port != spiAutoPort) {
     *status = INCOMPATIBLE_STATE;
@@ -594,6 +793,11 @@ void HAL_StartSPIAutoTrigger(HAL_SPIPort port, HAL_Handle digitalSourceHandle,
                              HAL_Bool triggerRising, HAL_Bool triggerFalling,
                              int32_t* status) {
   std::lock_guard<wpi::mutex> lock(spiAutoMutex);
+  if (GetSoftwareSPIAuto(port)) {
+    // external triggers are only routed to the FPGA engine
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
   // FPGA only has one auto SPI engine
   if (port != spiAutoPort) {
     *status = INCOMPATIBLE_STATE;
@@ -629,6 +833,10 @@ void HAL_StartSPIAutoTrigger(HAL_SPIPort port, HAL_Handle digitalSourceHandle,
 
 void HAL_StopSPIAuto(HAL_SPIPort port, int32_t* status) {
   std::lock_guard<wpi::mutex> lock(spiAutoMutex);
+  if (auto software = GetSoftwareSPIAuto(port)) {
+    software->Stop();
+    return;
+  }
   // FPGA only has one auto SPI engine
   if (port != spiAutoPort) {
     *status = INCOMPATIBLE_STATE;
@@ -659,6 +867,12 @@ void HAL_SetSPIAutoTransmitData(HAL_SPIPort port, const uint8_t* dataToSend,
   }
 
   std::lock_guard<wpi::mutex> lock(spiAutoMutex);
+  if (auto software = GetSoftwareSPIAuto(port)) {
+    std::lock_guard<wpi::mutex> softwareLock(software->mutex);
+    software->transmit.assign(dataToSend, dataToSend + dataSize);
+    software->transmit.resize(dataSize + zeroSize, 0);
+    return;
+  }
   // FPGA only has one auto SPI engine
   if (port != spiAutoPort) {
     *status = INCOMPATIBLE_STATE;
@@ -678,6 +892,10 @@ void HAL_SetSPIAutoTransmitData(HAL_SPIPort port, const uint8_t* dataToSend,
 
 void HAL_ForceSPIAutoRead(HAL_SPIPort port, int32_t* status) {
   std::lock_guard<wpi::mutex> lock(spiAutoMutex);
+  if (auto software = GetSoftwareSPIAuto(port)) {
+    software->Transfer();
+    return;
+  }
   // FPGA only has one auto SPI engine
   if (port != spiAutoPort) {
     *status = INCOMPATIBLE_STATE;
@@ -690,7 +908,16 @@ void HAL_ForceSPIAutoRead(HAL_SPIPort port, int32_t* status) {
 int32_t HAL_ReadSPIAutoReceivedData(HAL_SPIPort port, uint8_t* buffer,
                                     int32_t numToRead, double timeout,
                                     int32_t* status) {
-  std::lock_guard<wpi::mutex> lock(spiAutoMutex);
+  PerfCounterScope perfScope(HAL_kPerfCounterSPI);
+  BusStatisticsScope busScope(HAL_kBusSPI, port, status);
+  std::unique_lock<wpi::mutex> lock(spiAutoMutex);
+  if (port >= 0 && port < kSpiMaxHandles && spiSoftwareAuto[port]) {
+    // Read may wait up to timeout, so keep the engine alive by reference
+    // rather than blocking the other ports' auto calls
+    auto software = spiSoftwareAuto[port];
+    lock.unlock();
+    return software->Read(buffer, numToRead, timeout);
+  }
   // FPGA only has one auto SPI engine
   if (port != spiAutoPort) {
     *status = INCOMPATIBLE_STATE;
@@ -705,6 +932,10 @@ int32_t HAL_ReadSPIAutoReceivedData(HAL_SPIPort port, uint8_t* buffer,
 
 int32_t HAL_GetSPIAutoDroppedCount(HAL_SPIPort port, int32_t* status) {
   std::lock_guard<wpi::mutex> lock(spiAutoMutex);
+  if (auto software = GetSoftwareSPIAuto(port)) {
+    std::lock_guard<wpi::mutex> softwareLock(software->mutex);
+    return software->dropped;
+  }
   // FPGA only has one auto SPI engine
   if (port != spiAutoPort) {
     *status = INCOMPATIBLE_STATE;
@@ -9,6 +9,8 @@
 
 #include <string>
 
+#include "HAL/cpp/BusStatistics.h"
+#include "HAL/cpp/PerfCounters.h"
 #include "HAL/cpp/SerialHelper.h"
 #include "visa/visa.h"
 
@@ -119,6 +121,7 @@ void HAL_SetSerialWriteBufferSize(HAL_SerialPort port, int32_t size,
 }
 
 int32_t HAL_GetSerialBytesReceived(HAL_SerialPort port, int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterSerial);
   int32_t bytes = 0;
 
   *status = viGetAttribute(portHandles[port], VI_ATTR_ASRL_AVAIL_NUM, &bytes);
@@ -128,6 +131,8 @@ int32_t HAL_GetSerialBytesReceived(HAL_SerialPort port, int32_t* status) {
 
 int32_t HAL_ReadSerial(HAL_SerialPort port, char* buffer, int32_t count,
                        int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterSerial);
+  hal::BusStatisticsScope busScope(HAL_kBusSerial, port, status);
   uint32_t retCount = 0;
 
   *status =
@@ -145,6 +150,8 @@ int32_t HAL_ReadSerial(HAL_SerialPort port, char* buffer, int32_t count,
 
 int32_t HAL_WriteSerial(HAL_SerialPort port, const char* buffer, int32_t count,
                         int32_t* status) {
+  hal::PerfCounterScope perfScope(HAL_kPerfCounterSerial);
+  hal::BusStatisticsScope busScope(HAL_kBusSerial, port, status);
   uint32_t retCount = 0;
 
   *status =
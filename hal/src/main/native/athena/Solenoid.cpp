@@ -12,6 +12,7 @@
 #include "HAL/ChipObject.h"
 #include "HAL/Errors.h"
 #include "HAL/Ports.h"
+#include "HAL/cpp/BusStatistics.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HAL/handles/IndexedHandleResource.h"
 #include "PCMInternal.h"
@@ -102,6 +103,7 @@ HAL_Bool HAL_GetSolenoid(HAL_SolenoidHandle solenoidPortHandle,
     *status = HAL_HANDLE_ERROR;
     return false;
   }
+  BusStatisticsScope busScope(HAL_kBusPCM, port->module, status);
   bool value;
 
   *status = PCM_modules[port->module]->GetSolenoid(port->channel, value);
@@ -111,6 +113,7 @@ HAL_Bool HAL_GetSolenoid(HAL_SolenoidHandle solenoidPortHandle,
 
 int32_t HAL_GetAllSolenoids(int32_t module, int32_t* status) {
   if (!checkPCMInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPCM, module, status);
   uint8_t value;
 
   *status = PCM_modules[module]->GetAllSolenoids(value);
@@ -135,8 +138,28 @@ void HAL_SetAllSolenoids(int32_t module, int32_t state, int32_t* status) {
   *status = PCM_modules[module]->SetAllSolenoids(state);
 }
 
+void HAL_SetSolenoids(int32_t module, int32_t mask, int32_t values,
+                      int32_t* status) {
+  if (!checkPCMInit(module, status)) return;
+
+  *status = PCM_modules[module]->SetSolenoids(mask, values);
+}
+
+void HAL_BeginSolenoidTransaction(int32_t module, int32_t* status) {
+  if (!checkPCMInit(module, status)) return;
+
+  *status = PCM_modules[module]->HoldSolenoidUpdates(true);
+}
+
+void HAL_EndSolenoidTransaction(int32_t module, int32_t* status) {
+  if (!checkPCMInit(module, status)) return;
+
+  *status = PCM_modules[module]->HoldSolenoidUpdates(false);
+}
+
 int32_t HAL_GetPCMSolenoidBlackList(int32_t module, int32_t* status) {
   if (!checkPCMInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPCM, module, status);
   uint8_t value;
 
   *status = PCM_modules[module]->GetSolenoidBlackList(value);
@@ -145,6 +168,7 @@ int32_t HAL_GetPCMSolenoidBlackList(int32_t module, int32_t* status) {
 }
 HAL_Bool HAL_GetPCMSolenoidVoltageStickyFault(int32_t module, int32_t* status) {
   if (!checkPCMInit(module, status)) return 0;
+  BusStatisticsScope busScope(HAL_kBusPCM, module, status);
   bool value;
 
   *status = PCM_modules[module]->GetSolenoidStickyFault(value);
@@ -153,6 +177,7 @@ HAL_Bool HAL_GetPCMSolenoidVoltageStickyFault(int32_t module, int32_t* status) {
 }
 HAL_Bool HAL_GetPCMSolenoidVoltageFault(int32_t module, int32_t* status) {
   if (!checkPCMInit(module, status)) return false;
+  BusStatisticsScope busScope(HAL_kBusPCM, module, status);
   bool value;
 
   *status = PCM_modules[module]->GetSolenoidFault(value);
@@ -7,8 +7,18 @@
 
 #include "HAL/Threads.h"
 
+#include <alloca.h>
+#include <dirent.h>
+#include <malloc.h>
 #include <pthread.h>
 #include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 #include "HAL/Errors.h"
 
@@ -127,4 +137,183 @@ HAL_Bool HAL_SetCurrentThreadPriority(HAL_Bool realTime, int32_t priority,
   return HAL_SetThreadPriority(&thread, realTime, priority, status);
 }
 
+/**
+ * Get the CPUs the specified thread may run on.
+ *
+ * @param handle Native handle pointer to the thread
+ * @param status Error status variable. 0 on success
+ * @return A mask with bit n set if the thread may run on CPU n.
+ */
+int32_t HAL_GetThreadAffinity(NativeThreadHandle handle, int32_t* status) {
+  if (handle == nullptr) {
+    *status = NULL_PARAMETER;
+    return 0;
+  }
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (pthread_getaffinity_np(*handle, sizeof(cpus), &cpus)) {
+    *status = HAL_THREAD_AFFINITY_ERROR;
+    return 0;
+  }
+  int32_t cpuMask = 0;
+  for (int cpu = 0; cpu < 31; cpu++) {
+    if (CPU_ISSET(cpu, &cpus)) cpuMask |= 1 << cpu;
+  }
+  *status = 0;
+  return cpuMask;
+}
+
+/**
+ * Pin the specified thread to a set of CPUs.
+ *
+ * The roboRIO has two cores, so a mask of 0x2 keeps a control loop on core 1
+ * while 0x1 leaves networking and vision threads on core 0.
+ *
+ * @param handle  Native handle pointer to the thread
+ * @param cpuMask A mask with bit n set to allow the thread to run on CPU n
+ * @param status  Error status variable. 0 on success
+ * @return The success state of setting the affinity
+ */
+HAL_Bool HAL_SetThreadAffinity(NativeThreadHandle handle, int32_t cpuMask,
+                               int32_t* status) {
+  if (handle == nullptr) {
+    *status = NULL_PARAMETER;
+    return false;
+  }
+
+  int32_t numCpus = sysconf(_SC_NPROCESSORS_CONF);
+  if (cpuMask <= 0 || (numCpus < 31 && (cpuMask >> numCpus) != 0)) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return false;
+  }
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  for (int cpu = 0; cpu < 31; cpu++) {
+    if (cpuMask & (1 << cpu)) CPU_SET(cpu, &cpus);
+  }
+  if (pthread_setaffinity_np(*handle, sizeof(cpus), &cpus)) {
+    *status = HAL_THREAD_AFFINITY_ERROR;
+    return false;
+  }
+  *status = 0;
+  return true;
+}
+
+/**
+ * Pin the current thread to a set of CPUs.
+ *
+ * @param cpuMask A mask with bit n set to allow the thread to run on CPU n
+ * @param status  Error status variable. 0 on success
+ * @return The success state of setting the affinity
+ */
+HAL_Bool HAL_SetCurrentThreadAffinity(int32_t cpuMask, int32_t* status) {
+  auto thread = pthread_self();
+  return HAL_SetThreadAffinity(&thread, cpuMask, status);
+}
+
+/**
+ * Lock all current and future memory of the process into RAM, so real-time
+ * threads never wait on a page fault.
+ *
+ * Freed heap memory is kept by the process instead of returned to the
+ * system, so it stays locked when it is reused. The stack of the calling
+ * thread is touched to fault it in now; other threads should call this
+ * after they start, or fault in their own stack.
+ *
+ * @param stackPrefaultSize The number of bytes of stack to fault in
+ * @param status            Error status variable. 0 on success
+ * @return The success state of locking the memory
+ */
+HAL_Bool HAL_LockProcessMemory(int32_t stackPrefaultSize, int32_t* status) {
+  if (stackPrefaultSize < 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return false;
+  }
+  if (mlockall(MCL_CURRENT | MCL_FUTURE)) {
+    *status = HAL_MEMORY_LOCK_ERROR;
+    return false;
+  }
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+
+  if (stackPrefaultSize > 0) {
+    volatile char* stack = static_cast<char*>(alloca(stackPrefaultSize));
+    int32_t pageSize = sysconf(_SC_PAGESIZE);
+    for (int32_t i = 0; i < stackPrefaultSize; i += pageSize) stack[i] = 0;
+  }
+  *status = 0;
+  return true;
+}
+
+/**
+ * Read the CPU time used by each thread of the process from /proc/self/task.
+ *
+ * @param usage  Filled with the usage of up to count threads
+ * @param count  Size of usage
+ * @param status Error status variable. 0 on success
+ * @return The number of threads in the process, which may be more than count.
+ */
+int32_t HAL_GetThreadCPUUsage(HAL_ThreadCPUUsage* usage, int32_t count,
+                              int32_t* status) {
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) {
+    *status = HAL_THREAD_USAGE_ERROR;
+    return 0;
+  }
+
+  double ticksPerSecond = sysconf(_SC_CLK_TCK);
+  int32_t threads = 0;
+  while (dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+    if (threads >= count) {
+      threads++;
+      continue;
+    }
+
+    char path[64];
+    std::snprintf(path, sizeof(path), "/proc/self/task/%s/stat",
+                  entry->d_name);
+    std::FILE* file = std::fopen(path, "r");
+    // The thread exited since the directory was read
+    if (file == nullptr) continue;
+    char stat[512];
+    size_t size = std::fread(stat, 1, sizeof(stat) - 1, file);
+    std::fclose(file);
+    stat[size] = '\0';
+
+    // The name is in parentheses and may itself contain spaces or ')'
+    char* nameStart = std::strchr(stat, '(');
+    char* nameEnd = std::strrchr(stat, ')');
+    if (nameStart == nullptr || nameEnd == nullptr) continue;
+
+    // Fields after the name, starting from field 3 (state)
+    uint64_t utime = 0;
+    uint64_t stime = 0;
+    int processor = -1;
+    char* field = nameEnd + 2;
+    for (int i = 3; i <= 39 && field != nullptr; i++) {
+      if (i == 14) utime = std::strtoull(field, nullptr, 10);
+      if (i == 15) stime = std::strtoull(field, nullptr, 10);
+      if (i == 39) processor = std::atoi(field);
+      field = std::strchr(field, ' ');
+      if (field != nullptr) field++;
+    }
+
+    auto& thread = usage[threads++];
+    thread.threadId = std::atoi(entry->d_name);
+    size_t nameSize = std::min<size_t>(nameEnd - nameStart - 1,
+                                       sizeof(thread.name) - 1);
+    std::memcpy(thread.name, nameStart + 1, nameSize);
+    thread.name[nameSize] = '\0';
+    thread.userTime = utime / ticksPerSecond;
+    thread.systemTime = stime / ticksPerSecond;
+    thread.processor = processor;
+  }
+  closedir(dir);
+  *status = 0;
+  return threads;
+}
+
 }  // extern "C"
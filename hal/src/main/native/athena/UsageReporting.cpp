@@ -0,0 +1,121 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "UsageReportingInternal.h"
+
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "HAL/HAL.h"
+
+namespace {
+struct UsageReport {
+  int32_t resource;
+  int32_t instanceNumber;
+  int32_t context;
+  std::string feature;
+
+  bool operator<(const UsageReport& rhs) const {
+    return std::tie(resource, instanceNumber, context, feature) <
+           std::tie(rhs.resource, rhs.instanceNumber, rhs.context,
+                    rhs.feature);
+  }
+};
+
+/**
+ * Holds usage reports in memory so device constructors don't wait on NetComm.
+ *
+ * Robot construction makes hundreds of reports, many identical, during the
+ * time-critical startup. They are queued once each and sent from a background
+ * thread after the program reports it has started; whatever is still queued at
+ * exit is sent then.
+ */
+class UsageReporter {
+ public:
+  ~UsageReporter() {
+    {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_one();
+    if (m_thread.joinable()) m_thread.join();
+    Send(m_queue);
+  }
+
+  void Queue(int32_t resource, int32_t instanceNumber, int32_t context,
+             const char* feature) {
+    UsageReport report{resource, instanceNumber, context, feature};
+    {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      if (!m_reported.insert(report).second) return;
+      m_queue.emplace_back(std::move(report));
+      if (!m_started) return;
+    }
+    m_cond.notify_one();
+  }
+
+  void Start() {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (m_started) return;
+    m_started = true;
+    m_thread = std::thread(&UsageReporter::ThreadMain, this);
+  }
+
+ private:
+  void ThreadMain() {
+    std::vector<UsageReport> reports;
+    std::unique_lock<wpi::mutex> lock(m_mutex);
+    for (;;) {
+      m_cond.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+      if (m_stop) return;
+      reports.swap(m_queue);
+      lock.unlock();
+      Send(reports);
+      reports.clear();
+      lock.lock();
+    }
+  }
+
+  static void Send(const std::vector<UsageReport>& reports) {
+    for (auto& report : reports) {
+      FRC_NetworkCommunication_nUsageReporting_report(
+          report.resource, report.instanceNumber, report.context,
+          report.feature.c_str());
+    }
+  }
+
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  // Every report made, so repeats are dropped
+  std::set<UsageReport> m_reported;
+  std::vector<UsageReport> m_queue;
+  bool m_started = false;
+  bool m_stop = false;
+  std::thread m_thread;
+};
+}  // namespace
+
+static UsageReporter& GetUsageReporter() {
+  static UsageReporter reporter;
+  return reporter;
+}
+
+namespace hal {
+void QueueUsageReport(int32_t resource, int32_t instanceNumber,
+                      int32_t context, const char* feature) {
+  GetUsageReporter().Queue(resource, instanceNumber, context,
+                           feature == nullptr ? "" : feature);
+}
+
+void StartUsageReporting() { GetUsageReporter().Start(); }
+}  // namespace hal
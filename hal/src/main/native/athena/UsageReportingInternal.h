@@ -1,5 +1,5 @@
 /*----------------------------------------------------------------------------*/
-/* Copyright (c) 2017-2018 FIRST. All Rights Reserved.                        */
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
 /* Open Source Software - may be modified and shared by FRC teams. The code   */
 /* must be accompanied by the FIRST BSD license file in the root directory of */
 /* the project.                                                               */
@@ -7,21 +7,12 @@
 
 #pragma once
 
-#include <memory>
-#include <string>
-
-#include "MockData/HALValue.h"
-#include "MockData/llvm/StringRef.h"
+#include <stdint.h>
 
 namespace hal {
+void QueueUsageReport(int32_t resource, int32_t instanceNumber,
+                      int32_t context, const char* feature);
 
-class Value;
-
-void ConvertToC(const Value& in, HAL_Value* out);
-std::shared_ptr<Value> ConvertFromC(const HAL_Value& value);
-void ConvertToC(llvm::StringRef in, HALString* out);
-inline llvm::StringRef ConvertFromC(const HALString& str) {
-  return llvm::StringRef(str.str, str.len);
-}
-
+// Starts sending the queued reports to NetComm from a background thread
+void StartUsageReporting();
 }  // namespace hal
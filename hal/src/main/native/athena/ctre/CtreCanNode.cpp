@@ -2,6 +2,7 @@
 
 #include "CtreCanNode.h"
 #include "FRC_NetworkCommunication/CANSessionMux.h"
+#include "../CANReceiveCache.h"
 #include <string.h> // memset
 
 static const UINT32 kFullMessageIDMask = 0x1fffffff;
@@ -15,7 +16,8 @@ CtreCanNode::~CtreCanNode()
 }
 void CtreCanNode::RegisterRx(uint32_t arbId)
 {
-	/* no need to do anything, we just use new API to poll last received message */
+	/* received in the background when possible, GetRx() polls otherwise */
+	hal::RegisterCANReceive(arbId);
 }
 /**
  * Schedule a CAN Frame for periodic transmit.
@@ -78,20 +80,40 @@ static int64_t GetTimeMs() {
 }
 CTR_Code CtreCanNode::GetRx(uint32_t arbId,uint8_t * dataBytes, uint32_t timeoutMs)
 {
-	CTR_Code retval = CTR_OKAY;
-	int32_t status = 0;
-	uint8_t len = 0;
 	uint32_t timeStamp;
+	uint32_t ageMs;
+	return GetRx(arbId, dataBytes, timeoutMs, &timeStamp, &ageMs);
+}
+CTR_Code CtreCanNode::GetRx(uint32_t arbId,uint8_t * dataBytes, uint32_t timeoutMs, uint32_t * rxTimeStamp, uint32_t * ageMs)
+{
 	/* cap timeout at 999ms */
 	if(timeoutMs > 999)
 		timeoutMs = 999;
+	/* cached frames are a plain copy, no CAN call needed */
+	switch(hal::GetCANReceive(arbId, dataBytes, rxTimeStamp, ageMs)){
+		case hal::CANReceiveResult::kReceived:
+			return *ageMs > timeoutMs ? CTR_RxTimeout : CTR_OKAY;
+		case hal::CANReceiveResult::kNotReceived:
+			*ageMs = 0;
+			return CTR_RxTimeout;
+		case hal::CANReceiveResult::kNotRegistered:
+			break;
+	}
+
+	CTR_Code retval = CTR_OKAY;
+	int32_t status = 0;
+	uint8_t len = 0;
+	uint32_t timeStamp = 0;
 	FRC_NetworkCommunication_CANSessionMux_receiveMessage(&arbId,kFullMessageIDMask,dataBytes,&len,&timeStamp,&status);
 	std::lock_guard<wpi::mutex> lock(_lck);
 	if(status == 0){
 		/* fresh update */
 		rxEvent_t & r = _rxRxEvents[arbId]; /* lookup entry or make a default new one with all zeroes */
 		r.time = GetTimeMs();
+		r.timeStamp = timeStamp;
 		memcpy(r.bytes,  dataBytes,  8);	/* fill in databytes */
+		*rxTimeStamp = timeStamp;
+		*ageMs = 0;
 	}else{
 		/* did not get the message */
 		rxRxEvents_t::iterator i = _rxRxEvents.find(arbId);
@@ -100,13 +122,17 @@ CTR_Code CtreCanNode::GetRx(uint32_t arbId,uint8_t * dataBytes, uint32_t timeout
 			retval = CTR_RxTimeout;
 			/* fill caller's buffer with zeros */
 			memset(dataBytes,0,8);
+			*rxTimeStamp = 0;
+			*ageMs = 0;
 		}else{
 			/* we've gotten this message before but not recently */
 			memcpy(dataBytes,i->second.bytes,8);
+			*rxTimeStamp = i->second.timeStamp;
 			/* get the time now */
 			int64_t now = GetTimeMs(); /* get now */
 			/* how long has it been? */
 			int64_t temp = now - i->second.time; /* temp = now - last */
+			*ageMs = (uint32_t)temp;
 			if (temp > ((int64_t) timeoutMs)) {
 					retval = CTR_RxTimeout;
 			} else {
@@ -42,6 +42,8 @@ protected:
 			uint32_t arbId;
 			uint8_t bytes[8];
 			CTR_Code err;
+			uint32_t timeStamp;
+			uint32_t ageMs;
 			T * operator -> ()
 			{
 				return (T *)bytes;
@@ -71,6 +73,11 @@ protected:
 	void UnregisterTx(uint32_t arbId);
 
 	CTR_Code GetRx(uint32_t arbId,uint8_t * dataBytes,uint32_t timeoutMs);
+	/**
+	 * Same as above, also returning the CAN receive time of the frame in ms, or 0
+	 * if the frame has never been received, and how long ago it was received.
+	 */
+	CTR_Code GetRx(uint32_t arbId,uint8_t * dataBytes,uint32_t timeoutMs,uint32_t * timeStamp,uint32_t * ageMs);
 	void FlushTx(uint32_t arbId);
 	bool ChangeTxPeriod(uint32_t arbId, uint32_t periodMs);
 
@@ -92,7 +99,7 @@ protected:
 	template<class T> recMsg<T> GetRx(uint32_t arbId, uint32_t timeoutMs)
 	{
 		recMsg<T> retval;
-		retval.err = GetRx(arbId,retval.bytes, timeoutMs);
+		retval.err = GetRx(arbId,retval.bytes, timeoutMs, &retval.timeStamp, &retval.ageMs);
 		return retval;
 	}
 
@@ -110,8 +117,10 @@ private:
 		public:
 			uint8_t bytes[8];
 			int64_t time;
+			uint32_t timeStamp;
 			rxEvent_t()
 			{
+				timeStamp = 0;
 				bytes[0] = 0;
 				bytes[1] = 0;
 				bytes[2] = 0;
@@ -107,6 +107,8 @@ typedef struct _PcmDebug_t{
  */
 PCM::PCM(UINT8 deviceNumber): CtreCanNode(deviceNumber)
 {
+	_solenoidHoldCount = 0;
+	_solenoidsPending = false;
 	RegisterRx(STATUS_1 | deviceNumber );
 	RegisterRx(STATUS_SOL_FAULTS | deviceNumber );
 	RegisterRx(STATUS_DEBUG | deviceNumber );
@@ -136,7 +138,7 @@ CTR_Code PCM::SetSolenoid(unsigned char idx, bool en)
 		toFill->solenoidBits |= (1ul << (idx));
 	else
 		toFill->solenoidBits &= ~(1ul << (idx));
-	FlushTx(toFill);
+	FlushSolenoids();
 	return CTR_OKAY;
 }
 
@@ -149,10 +151,51 @@ CTR_Code PCM::SetAllSolenoids(UINT8 state) {
 	CtreCanNode::txTask<PcmControl_t> toFill = GetTx<PcmControl_t>(CONTROL_1 | GetDeviceNumber());
 	if(toFill.IsEmpty())return CTR_UnexpectedArbId;
 	toFill->solenoidBits = state;
-	FlushTx(toFill);
+	FlushSolenoids();
+	return CTR_OKAY;
+}
+
+/* Set the PCM solenoids selected by a mask
+ *
+ * @Return	-	CTR_Code	-	Error code (if any) for setting solenoids
+ * @Param 	-	mask			Bitfield of solenoids to set
+ * @Param 	-	values			Bitfield of the new solenoid states
+ */
+CTR_Code PCM::SetSolenoids(UINT8 mask, UINT8 values) {
+	CtreCanNode::txTask<PcmControl_t> toFill = GetTx<PcmControl_t>(CONTROL_1 | GetDeviceNumber());
+	if(toFill.IsEmpty())return CTR_UnexpectedArbId;
+	toFill->solenoidBits = (toFill->solenoidBits & ~mask) | (values & mask);
+	FlushSolenoids();
+	return CTR_OKAY;
+}
+
+/* Hold solenoid changes until a matching release, then send them all in a
+ * single control frame update. Holds may nest.
+ *
+ * @Return	-	CTR_Code	-	Error code (if any) for sending held changes
+ * @Param 	-	hold			True to hold, false to release
+ */
+CTR_Code PCM::HoldSolenoidUpdates(bool hold) {
+	if (hold) {
+		_solenoidHoldCount++;
+		return CTR_OKAY;
+	}
+	if (_solenoidHoldCount == 0) return CTR_InvalidParamValue;
+	if (--_solenoidHoldCount == 0 && _solenoidsPending) {
+		_solenoidsPending = false;
+		FlushTx(CONTROL_1 | GetDeviceNumber());
+	}
 	return CTR_OKAY;
 }
 
+void PCM::FlushSolenoids() {
+	if (_solenoidHoldCount > 0) {
+		_solenoidsPending = true;
+		return;
+	}
+	FlushTx(CONTROL_1 | GetDeviceNumber());
+}
+
 /* Clears PCM sticky faults (indicators of past faults
  *
  * @Return	-	CTR_Code	-	Error code (if any) for setting solenoid
@@ -369,6 +412,38 @@ CTR_Code PCM::GetCompressorNotConnectedFault(bool &status)
 	status = rx->Fault_CompNoCurrent;
 	return rx.err;
 }
+CTR_Code PCM::GetCompressorStatus(bool &on, bool &closedLoop,
+		bool &pressureSwitch, float &current, bool &currentTooHighFault,
+		bool &currentTooHighStickyFault, bool &shortedFault,
+		bool &shortedStickyFault, bool &notConnectedFault,
+		bool &notConnectedStickyFault, uint32_t timeStamps[2])
+{
+	CTR_Code retval;
+	{
+		GET_PCM_STATUS();
+		retval = rx.err;
+		timeStamps[0] = rx.timeStamp;
+		on = rx->compressorOn;
+		closedLoop = rx->isCloseloopEnabled;
+		pressureSwitch = rx->pressureSwitchEn;
+		uint32_t temp = rx->compressorCurrentTop6;
+		temp <<= 4;
+		temp |= rx->compressorCurrentBtm4;
+		current = temp * 0.03125; /* 5.5 fixed pt value in Amps */
+		currentTooHighFault = rx->faultCompCurrentTooHigh;
+		currentTooHighStickyFault = rx->stickyFaultCompCurrentTooHigh;
+		shortedFault = rx->Fault_dItooHigh;
+		shortedStickyFault = rx->StickyFault_dItooHigh;
+	}
+	{
+		GET_PCM_SOL_FAULTS();
+		if (rx.err != CTR_OKAY) retval = rx.err;
+		timeStamps[1] = rx.timeStamp;
+		notConnectedFault = rx->Fault_CompNoCurrent;
+		notConnectedStickyFault = rx->StickyFault_CompNoCurrent;
+	}
+	return retval;
+}
 
 /* Get solenoid fault value
  *
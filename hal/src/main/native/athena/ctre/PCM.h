@@ -23,6 +23,22 @@ public:
      */
     CTR_Code 	SetAllSolenoids(UINT8 state);
 
+    /* Set the PCM solenoids selected by a mask
+     *
+     * @Return	-	CTR_Code	-	Error code (if any) for setting solenoids
+     * @Param 	-	mask			Bitfield of solenoids to set
+     * @Param 	-	values			Bitfield of the new solenoid states
+     */
+    CTR_Code 	SetSolenoids(UINT8 mask, UINT8 values);
+
+    /* Hold solenoid changes until a matching release, then send them all in a
+     * single control frame update. Holds may nest.
+     *
+     * @Return	-	CTR_Code	-	Error code (if any) for sending held changes
+     * @Param 	-	hold			True to hold, false to release
+     */
+    CTR_Code 	HoldSolenoidUpdates(bool hold);
+
     /* Enables PCM Closed Loop Control of Compressor via pressure switch
      * @Return	-	CTR_Code	-	Error code (if any) for setting solenoid
      * @Param 	-	en		- 	Enable / Disable Closed Loop Control
@@ -126,6 +142,18 @@ public:
      */
     CTR_Code 	GetCompressorNotConnectedFault(bool &status);
 
+    /* Get every compressor signal, reading the status and solenoid fault
+     * frames once.
+     * @Return	-	CTR_Code	-	Error code (if any)
+     * @Param	-	timeStamps	-	Receive time of the status and solenoid fault
+     *								frames in ms
+     */
+    CTR_Code 	GetCompressorStatus(bool &on, bool &closedLoop, bool &pressureSwitch,
+    				float &current, bool &currentTooHighFault,
+    				bool &currentTooHighStickyFault, bool &shortedFault,
+    				bool &shortedStickyFault, bool &notConnectedFault,
+    				bool &notConnectedStickyFault, uint32_t timeStamps[2]);
+
     /* Get solenoid sticky fault value
      * @Return	-	CTR_Code	-	Error code (if any)
      * @Param	-	status		-	True if compressor had previously been shorted
@@ -194,6 +222,12 @@ public:
      */
     CTR_Code SetOneShotDurationMs(UINT8 idx,uint32_t durMs);
 
+private:
+    /* send the control frame, unless solenoid updates are held */
+    void FlushSolenoids();
+
+    int _solenoidHoldCount;
+    bool _solenoidsPending;
 };
 //------------------ C interface --------------------------------------------//
 extern "C" {
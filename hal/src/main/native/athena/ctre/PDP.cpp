@@ -77,6 +77,7 @@ PDP::PDP(UINT8 deviceNumber): CtreCanNode(deviceNumber)
 	RegisterRx(STATUS_1 | deviceNumber );
 	RegisterRx(STATUS_2 | deviceNumber );
 	RegisterRx(STATUS_3 | deviceNumber );
+	RegisterRx(STATUS_ENERGY | deviceNumber );
 }
 /* PDP D'tor
  */
@@ -181,6 +182,89 @@ CTR_Code PDP::GetTotalEnergy(double &energyJoules)
 	energyJoules *= rx->TmeasMs_likelywillbe20ms_;		/* multiplied by TmeasMs = joules */
 	return rx.err;
 }
+CTR_Code PDP::GetAllCurrents(double currents[16], uint32_t timeStamps[3])
+{
+	return ReadCurrentFrames(currents, nullptr, nullptr, timeStamps);
+}
+CTR_Code PDP::ReadCurrentFrames(double currents[16], double *voltage,
+		double *tempC, uint32_t timeStamps[3])
+{
+	uint32_t raw[16];
+	CTR_Code retval = CTR_OKAY;
+	{
+		GET_STATUS1();
+		if (rx.err != CTR_OKAY) retval = rx.err;
+		timeStamps[0] = rx.timeStamp;
+		raw[0] = ((uint32_t)rx->chan1_h8 << 2) | rx->chan1_l2;
+		raw[1] = ((uint32_t)rx->chan2_h6 << 4) | rx->chan2_l4;
+		raw[2] = ((uint32_t)rx->chan3_h4 << 6) | rx->chan3_l6;
+		raw[3] = ((uint32_t)rx->chan4_h2 << 8) | rx->chan4_l8;
+		raw[4] = ((uint32_t)rx->chan5_h8 << 2) | rx->chan5_l2;
+		raw[5] = ((uint32_t)rx->chan6_h6 << 4) | rx->chan6_l4;
+	}
+	{
+		GET_STATUS2();
+		if (rx.err != CTR_OKAY) retval = rx.err;
+		timeStamps[1] = rx.timeStamp;
+		raw[6] = ((uint32_t)rx->chan7_h8  << 2) | rx->chan7_l2;
+		raw[7] = ((uint32_t)rx->chan8_h6  << 4) | rx->chan8_l4;
+		raw[8] = ((uint32_t)rx->chan9_h4  << 6) | rx->chan9_l6;
+		raw[9] = ((uint32_t)rx->chan10_h2 << 8) | rx->chan10_l8;
+		raw[10] = ((uint32_t)rx->chan11_h8 << 2) | rx->chan11_l2;
+		raw[11] = ((uint32_t)rx->chan12_h6 << 4) | rx->chan12_l4;
+	}
+	{
+		GET_STATUS3();
+		if (rx.err != CTR_OKAY) retval = rx.err;
+		timeStamps[2] = rx.timeStamp;
+		raw[12] = ((uint32_t)rx->chan13_h8  << 2) | rx->chan13_l2;
+		raw[13] = ((uint32_t)rx->chan14_h6  << 4) | rx->chan14_l4;
+		raw[14] = ((uint32_t)rx->chan15_h4  << 6) | rx->chan15_l6;
+		raw[15] = ((uint32_t)rx->chan16_h2  << 8) | rx->chan16_l8;
+		if (voltage)
+			*voltage = (double)rx->busVoltage * 0.05 + 4.0; /* 50mV per unit plus 4V. */
+		if (tempC)
+			*tempC = (double)rx->temp * 1.03250836957542 - 67.8564500484966;
+	}
+	for (int i = 0; i < 16; ++i)
+		currents[i] = (double)raw[i] * 0.125;  /* 7.3 fixed pt value in Amps */
+	return retval;
+}
+CTR_Code PDP::GetAll(double currents[16], double &voltage, double &tempC,
+		double &totalCurrentAmps, double &powerWatts, double &energyJoules,
+		uint32_t timeStamps[4])
+{
+	CTR_Code retval = ReadCurrentFrames(currents, &voltage, &tempC, timeStamps);
+	{
+		GET_STATUS_ENERGY();
+		if (rx.err != CTR_OKAY) retval = rx.err;
+		timeStamps[3] = rx.timeStamp;
+		uint32_t raw;
+		raw = rx->TotalCurrent_125mAperunit_h8;
+		raw <<= 4;
+		raw |=  rx->TotalCurrent_125mAperunit_l4;
+		totalCurrentAmps = 0.125 * raw;
+
+		raw = rx->Power_125mWperunit_h4;
+		raw <<= 8;
+		raw |=  rx->Power_125mWperunit_m8;
+		raw <<= 4;
+		raw |=  rx->Power_125mWperunit_l4;
+		powerWatts = 0.125 * raw;
+
+		raw = rx->Energy_125mWPerUnitXTmeas_h4;
+		raw <<= 8;
+		raw |=  rx->Energy_125mWPerUnitXTmeas_mh8;
+		raw <<= 8;
+		raw |=  rx->Energy_125mWPerUnitXTmeas_ml8;
+		raw <<= 8;
+		raw |=  rx->Energy_125mWPerUnitXTmeas_l8;
+		energyJoules = 0.125 * raw; 						/* mW integrated every TmeasMs */
+		energyJoules *= 0.001;								/* convert from mW to W */
+		energyJoules *= rx->TmeasMs_likelywillbe20ms_;		/* multiplied by TmeasMs = joules */
+	}
+	return retval;
+}
 /* Clear sticky faults.
  * @Return	-	CTR_Code	-	Error code (if any)
  */
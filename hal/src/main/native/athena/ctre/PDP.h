@@ -40,6 +40,24 @@ public:
 	CTR_Code GetTotalCurrent(double &currentAmps);
 	CTR_Code GetTotalPower(double &powerWatts);
 	CTR_Code GetTotalEnergy(double &energyJoules);
+	/* Get every channel current, reading each status frame once.
+	 *
+	 * @Return	-	CTR_Code	-	Error code (if any)
+	 *
+	 * @Param	-	currents	-	Current of channels 1-16 in Amps (A)
+	 *
+	 * @Param	-	timeStamps	-	Receive time of status frames 1-3 in ms
+	 */
+	CTR_Code GetAllCurrents(double currents[16], uint32_t timeStamps[3]);
+	/* Get every current plus the status 3 and energy signals, reading each
+	 * status frame once.
+	 *
+	 * @Param	-	timeStamps	-	Receive time of status frames 1-3 and the
+	 *								energy frame in ms
+	 */
+	CTR_Code GetAll(double currents[16], double &voltage, double &tempC,
+			double &totalCurrentAmps, double &powerWatts, double &energyJoules,
+			uint32_t timeStamps[4]);
     /* Clear sticky faults.
      * @Return	-	CTR_Code	-	Error code (if any)
      */
@@ -51,6 +69,8 @@ public:
 	CTR_Code ResetEnergy();
 private:
     uint64_t ReadCurrents(uint8_t api);
+	CTR_Code ReadCurrentFrames(double currents[16], double *voltage,
+			double *tempC, uint32_t timeStamps[3]);
 };
 extern "C" {
 	void * c_PDP_Init();
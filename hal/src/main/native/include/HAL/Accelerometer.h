@@ -15,6 +15,16 @@ enum HAL_AccelerometerRange : int32_t {
   HAL_AccelerometerRange_k8G = 2,
 };
 
+/**
+ * One reading of the sampler, in g-forces.
+ */
+struct HAL_AccelerometerSample {
+  double x;
+  double y;
+  double z;
+  uint64_t timeStamp;  // FPGA time in microseconds
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -23,6 +33,13 @@ void HAL_SetAccelerometerRange(HAL_AccelerometerRange range);
 double HAL_GetAccelerometerX(void);
 double HAL_GetAccelerometerY(void);
 double HAL_GetAccelerometerZ(void);
+void HAL_GetAccelerometerXYZ(double* x, double* y, double* z);
+
+void HAL_StartAccelerometerSampler(int32_t bufferSize, int32_t* status);
+void HAL_StopAccelerometerSampler(int32_t* status);
+int32_t HAL_ReadAccelerometerSamples(struct HAL_AccelerometerSample* samples,
+                                     int32_t count, int32_t* status);
+int64_t HAL_GetAccelerometerSamplerOverflowCount(int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
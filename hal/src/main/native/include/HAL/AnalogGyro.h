@@ -11,6 +11,17 @@
 
 #include "HAL/Types.h"
 
+/**
+ * The state of an analog gyro captured by a single accumulator read.
+ */
+struct HAL_AnalogGyroSnapshot {
+  int64_t value;       // accumulated value, center removed
+  int64_t count;       // number of samples accumulated
+  double angle;        // degrees
+  double rate;         // degrees per second
+  uint64_t timestamp;  // FPGA time in microseconds the accumulator was read
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,6 +44,9 @@ double HAL_GetAnalogGyroAngle(HAL_GyroHandle handle, int32_t* status);
 double HAL_GetAnalogGyroRate(HAL_GyroHandle handle, int32_t* status);
 double HAL_GetAnalogGyroOffset(HAL_GyroHandle handle, int32_t* status);
 int32_t HAL_GetAnalogGyroCenter(HAL_GyroHandle handle, int32_t* status);
+void HAL_GetAnalogGyroSnapshot(HAL_GyroHandle handle,
+                               struct HAL_AnalogGyroSnapshot* snapshot,
+                               int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -41,10 +41,28 @@ double HAL_GetAnalogVoltage(HAL_AnalogInputHandle analogPortHandle,
                             int32_t* status);
 double HAL_GetAnalogAverageVoltage(HAL_AnalogInputHandle analogPortHandle,
                                    int32_t* status);
+void HAL_GetAnalogVoltages(const HAL_AnalogInputHandle* analogPortHandles,
+                           double* voltages, int32_t count, int32_t* status);
+void HAL_GetAnalogValues(const HAL_AnalogInputHandle* analogPortHandles,
+                         int32_t* values, HAL_Bool averaged, int32_t count,
+                         int32_t* status);
+void HAL_StartAnalogMirror(double period, int32_t* status);
+void HAL_StopAnalogMirror(int32_t* status);
+HAL_Bool HAL_IsAnalogMirrorRunning(void);
 int32_t HAL_GetAnalogLSBWeight(HAL_AnalogInputHandle analogPortHandle,
                                int32_t* status);
 int32_t HAL_GetAnalogOffset(HAL_AnalogInputHandle analogPortHandle,
                             int32_t* status);
+
+void HAL_StartAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                           int32_t bufferSize, int32_t* status);
+void HAL_StopAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                          int32_t* status);
+int32_t HAL_ReadAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                             int32_t* values, uint64_t* timeStamps,
+                             int32_t count, int32_t* status);
+int64_t HAL_GetAnalogStreamOverflowCount(HAL_AnalogInputHandle analogPortHandle,
+                                         int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
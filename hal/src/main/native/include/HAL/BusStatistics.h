@@ -0,0 +1,80 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "HAL/Types.h"
+
+enum HAL_BusType : int32_t {
+  // port is the HAL_I2CPort
+  HAL_kBusI2C = 0,
+  // port is the HAL_SPIPort
+  HAL_kBusSPI,
+  // port is the HAL_SerialPort
+  HAL_kBusSerial,
+  // port is the device number, the low 6 bits of the message ID
+  HAL_kBusCAN,
+  // port is the PCM module
+  HAL_kBusPCM,
+  // port is the PDP module
+  HAL_kBusPDP,
+  HAL_kBusTypeCount
+};
+
+// Ports counted on each bus; calls on higher ports are not counted
+#define HAL_kBusMaxPorts 64
+
+/**
+ * The calls made on one port of a bus since the statistics were last reset.
+ */
+struct HAL_BusStatistics {
+  int32_t bus;  // HAL_BusType
+  int32_t port;
+  uint64_t count;
+  // calls that returned an error
+  uint64_t errors;
+  uint64_t totalTime;  // nanoseconds
+  uint64_t maxTime;    // nanoseconds
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Enables or disables the bus statistics. They are off by default; while
+ * they are off, an instrumented call only reads one atomic flag.
+ *
+ * While on, each bus I/O call (I2C and SPI transactions, serial reads and
+ * writes, CAN messages, and PCM and PDP reads) adds its time and whether it
+ * failed to atomic counters for its port.
+ */
+void HAL_SetBusStatisticsEnabled(HAL_Bool enabled);
+HAL_Bool HAL_GetBusStatisticsEnabled(void);
+
+/**
+ * Gets the statistics of every port with at least one call, ordered by bus
+ * then port.
+ *
+ * @param statistics array to fill
+ * @param size       the size of statistics
+ * @return the number of ports with calls, which may be more than size; only
+ *         the first size are filled
+ */
+int32_t HAL_GetBusStatistics(struct HAL_BusStatistics* statistics,
+                             int32_t size);
+
+/**
+ * Zeroes the statistics of every port. A call that finishes while the
+ * statistics are being zeroed may be partly counted.
+ */
+void HAL_ResetBusStatistics(void);
+#ifdef __cplusplus
+}
+#endif
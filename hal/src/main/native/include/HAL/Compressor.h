@@ -11,6 +11,26 @@
 
 #include "HAL/Types.h"
 
+/**
+ * Every compressor value a PCM reports, decoded from a single read of each of
+ * its CAN status frames.
+ */
+struct HAL_CompressorStatus {
+  HAL_Bool enabled;
+  HAL_Bool closedLoopControl;
+  HAL_Bool pressureSwitch;
+  double current;
+  HAL_Bool currentTooHighFault;
+  HAL_Bool currentTooHighStickyFault;
+  HAL_Bool shortedFault;
+  HAL_Bool shortedStickyFault;
+  HAL_Bool notConnectedFault;
+  HAL_Bool notConnectedStickyFault;
+  // CAN receive time in ms of the status frame and of the solenoid fault frame
+  // (the not connected faults); 0 if never received
+  uint32_t frameTimeStamps[2];
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -43,6 +63,9 @@ HAL_Bool HAL_GetCompressorNotConnectedStickyFault(
     HAL_CompressorHandle compressorHandle, int32_t* status);
 HAL_Bool HAL_GetCompressorNotConnectedFault(
     HAL_CompressorHandle compressorHandle, int32_t* status);
+void HAL_GetCompressorStatus(HAL_CompressorHandle compressorHandle,
+                             struct HAL_CompressorStatus* compressorStatus,
+                             int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -19,6 +19,38 @@ enum HAL_Counter_Mode : int32_t {
   HAL_Counter_kExternalDirection = 3
 };
 
+/**
+ * The state of a counter captured by a single pair of register reads.
+ */
+struct HAL_CounterSnapshot {
+  int32_t count;
+  double period;  // seconds; infinity if stopped
+  HAL_Bool direction;
+  HAL_Bool stopped;
+  uint64_t timestamp;  // FPGA time in microseconds the registers were read
+};
+
+/**
+ * Statistics of the latest pulses on the up source of a counter. Periods run
+ * from rising edge to rising edge and widths from rising edge to falling edge,
+ * all in seconds; jitter is the standard deviation.
+ */
+struct HAL_CounterPulseStatistics {
+  int32_t count;  // number of pulses measured
+  double periodMin;
+  double periodMax;
+  double periodMean;
+  double periodJitter;
+  double widthMin;
+  double widthMax;
+  double widthMean;
+  double widthJitter;
+  double frequency;  // 1 / periodMean
+  double dutyCycle;  // widthMean / periodMean
+};
+
+#define HAL_kMaxCounterPulseWindow 4096
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -68,6 +100,21 @@ HAL_Bool HAL_GetCounterDirection(HAL_CounterHandle counterHandle,
                                  int32_t* status);
 void HAL_SetCounterReverseDirection(HAL_CounterHandle counterHandle,
                                     HAL_Bool reverseDirection, int32_t* status);
+void HAL_GetCounterSnapshot(HAL_CounterHandle counterHandle,
+                            struct HAL_CounterSnapshot* snapshot,
+                            int32_t* status);
+
+void HAL_StartCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                     int32_t windowSize, int32_t* status);
+void HAL_StopCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                    int32_t* status);
+void HAL_GetCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                   struct HAL_CounterPulseStatistics* stats,
+                                   int32_t* status);
+int32_t HAL_GetCounterPulseHistogram(HAL_CounterHandle counterHandle,
+                                     HAL_Bool widths, double min, double max,
+                                     int32_t* bins, int32_t binCount,
+                                     int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
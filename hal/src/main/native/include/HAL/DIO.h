@@ -24,6 +24,9 @@ void HAL_FreeDigitalPWM(HAL_DigitalPWMHandle pwmGenerator, int32_t* status);
 void HAL_SetDigitalPWMRate(double rate, int32_t* status);
 void HAL_SetDigitalPWMDutyCycle(HAL_DigitalPWMHandle pwmGenerator,
                                 double dutyCycle, int32_t* status);
+void HAL_SetDigitalPWMDutyCycles(const HAL_DigitalPWMHandle* pwmGenerators,
+                                 const double* dutyCycles, int32_t count,
+                                 int32_t* status);
 void HAL_SetDigitalPWMOutputChannel(HAL_DigitalPWMHandle pwmGenerator,
                                     int32_t channel, int32_t* status);
 void HAL_SetDIO(HAL_DigitalHandle dioPortHandle, HAL_Bool value,
@@ -32,6 +35,8 @@ void HAL_SetDIODirection(HAL_DigitalHandle dioPortHandle, HAL_Bool input,
                          int32_t* status);
 HAL_Bool HAL_GetDIO(HAL_DigitalHandle dioPortHandle, int32_t* status);
 HAL_Bool HAL_GetDIODirection(HAL_DigitalHandle dioPortHandle, int32_t* status);
+uint32_t HAL_GetAllDIO(uint64_t* timestamp, int32_t* status);
+void HAL_SetDIOMasked(uint32_t mask, uint32_t values, int32_t* status);
 void HAL_Pulse(HAL_DigitalHandle dioPortHandle, double pulseLength,
                int32_t* status);
 HAL_Bool HAL_IsPulsing(HAL_DigitalHandle dioPortHandle, int32_t* status);
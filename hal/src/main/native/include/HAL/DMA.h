@@ -0,0 +1,141 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "HAL/AnalogTrigger.h"
+#include "HAL/Types.h"
+
+// Number of FPGA values that can be enabled for capture
+#define HAL_kDMANumChannels 20
+// Largest capture: every channel enabled, plus the timestamp word
+#define HAL_kDMAMaxSampleSize 66
+
+enum HAL_DMAReadStatus : int32_t {
+  HAL_DMA_OK = 1,
+  HAL_DMA_TIMEOUT = 2,
+  HAL_DMA_ERROR = 3
+};
+
+/**
+ * A single DMA capture. Every enabled FPGA value is latched at the same
+ * instant, so all values in a sample share the timestamp.
+ */
+struct HAL_DMASample {
+  uint32_t readBuffer[HAL_kDMAMaxSampleSize];
+  // word offset of each channel in readBuffer, or -1 if not captured
+  int32_t channelOffsets[HAL_kDMANumChannels];
+  uint64_t timeStamp;
+  uint32_t captureSize;
+  uint8_t triggerChannels;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+HAL_DMAHandle HAL_InitializeDMA(int32_t* status);
+void HAL_FreeDMA(HAL_DMAHandle handle);
+
+void HAL_SetDMAPause(HAL_DMAHandle handle, HAL_Bool pause, int32_t* status);
+/**
+ * Captures a sample every cycles ticks of the 40 MHz FPGA clock, unless an
+ * external trigger has been set.
+ */
+void HAL_SetDMARate(HAL_DMAHandle handle, int32_t cycles, int32_t* status);
+
+// Sources can only be added before HAL_StartDMA()
+void HAL_AddDMAEncoder(HAL_DMAHandle handle, HAL_EncoderHandle encoderHandle,
+                       int32_t* status);
+void HAL_AddDMAEncoderPeriod(HAL_DMAHandle handle,
+                             HAL_EncoderHandle encoderHandle,
+                             int32_t* status);
+void HAL_AddDMACounter(HAL_DMAHandle handle, HAL_CounterHandle counterHandle,
+                       int32_t* status);
+void HAL_AddDMACounterPeriod(HAL_DMAHandle handle,
+                             HAL_CounterHandle counterHandle,
+                             int32_t* status);
+void HAL_AddDMADigitalSource(HAL_DMAHandle handle,
+                             HAL_Handle digitalSourceHandle, int32_t* status);
+void HAL_AddDMAAnalogInput(HAL_DMAHandle handle,
+                           HAL_AnalogInputHandle aInHandle, int32_t* status);
+void HAL_AddDMAAveragedAnalogInput(HAL_DMAHandle handle,
+                                   HAL_AnalogInputHandle aInHandle,
+                                   int32_t* status);
+void HAL_AddDMAAnalogAccumulator(HAL_DMAHandle handle,
+                                 HAL_AnalogInputHandle aInHandle,
+                                 int32_t* status);
+
+/**
+ * Captures a sample on an edge of a digital source instead of on the timer.
+ * Up to 8 external triggers may be set.
+ */
+void HAL_SetDMAExternalTrigger(HAL_DMAHandle handle,
+                               HAL_Handle digitalSourceHandle,
+                               HAL_AnalogTriggerType analogTriggerType,
+                               HAL_Bool rising, HAL_Bool falling,
+                               int32_t* status);
+
+/**
+ * Starts capturing. queueDepth is the number of samples the host buffer can
+ * hold before older samples are lost.
+ */
+void HAL_StartDMA(HAL_DMAHandle handle, int32_t queueDepth, int32_t* status);
+void HAL_StopDMA(HAL_DMAHandle handle, int32_t* status);
+
+/**
+ * Reads the oldest captured sample, waiting up to timeoutMs for one to
+ * arrive. remainingOut is set to the number of samples still queued.
+ */
+enum HAL_DMAReadStatus HAL_ReadDMA(HAL_DMAHandle handle,
+                                   struct HAL_DMASample* dmaSample,
+                                   int32_t timeoutMs, int32_t* remainingOut,
+                                   int32_t* status);
+
+/**
+ * Reads up to count samples with a single transfer. Waits up to timeoutMs for
+ * at least one sample, then takes every sample already queued (up to count).
+ * Returns the number of samples read.
+ */
+int32_t HAL_ReadDMASamples(HAL_DMAHandle handle,
+                           struct HAL_DMASample* dmaSamples, int32_t count,
+                           int32_t timeoutMs, int32_t* remainingOut,
+                           int32_t* status);
+
+// Sample accessors; a source that was not added sets a status
+uint64_t HAL_GetDMASampleTime(const struct HAL_DMASample* dmaSample,
+                              int32_t* status);
+int32_t HAL_GetDMASampleEncoderRaw(const struct HAL_DMASample* dmaSample,
+                                   HAL_EncoderHandle encoderHandle,
+                                   int32_t* status);
+int32_t HAL_GetDMASampleCounter(const struct HAL_DMASample* dmaSample,
+                                HAL_CounterHandle counterHandle,
+                                int32_t* status);
+int32_t HAL_GetDMASampleEncoderPeriodRaw(const struct HAL_DMASample* dmaSample,
+                                         HAL_EncoderHandle encoderHandle,
+                                         int32_t* status);
+int32_t HAL_GetDMASampleCounterPeriod(const struct HAL_DMASample* dmaSample,
+                                      HAL_CounterHandle counterHandle,
+                                      int32_t* status);
+HAL_Bool HAL_GetDMASampleDigitalSource(const struct HAL_DMASample* dmaSample,
+                                       HAL_Handle dSourceHandle,
+                                       int32_t* status);
+int32_t HAL_GetDMASampleAnalogInputRaw(const struct HAL_DMASample* dmaSample,
+                                       HAL_AnalogInputHandle aInHandle,
+                                       int32_t* status);
+int32_t HAL_GetDMASampleAveragedAnalogInputRaw(
+    const struct HAL_DMASample* dmaSample, HAL_AnalogInputHandle aInHandle,
+    int32_t* status);
+void HAL_GetDMASampleAnalogAccumulator(const struct HAL_DMASample* dmaSample,
+                                       HAL_AnalogInputHandle aInHandle,
+                                       int64_t* count, int64_t* value,
+                                       int32_t* status);
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -94,6 +94,22 @@ struct HAL_MatchInfo {
   char* gameSpecificMessage;
 };
 
+#define HAL_kMaxEventNameLength 64
+#define HAL_kMaxGameSpecificMessageLength 64
+
+/**
+ * Match info with the strings stored in the struct, so reading it does not
+ * allocate. Longer strings are truncated; both are null-terminated.
+ */
+struct HAL_InlineMatchInfo {
+  char eventName[HAL_kMaxEventNameLength];
+  HAL_MatchType matchType;
+  uint16_t matchNumber;
+  uint8_t replayNumber;
+  char gameSpecificMessage[HAL_kMaxGameSpecificMessageLength];
+  uint16_t gameSpecificMessageSize;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -121,6 +137,7 @@ double HAL_GetMatchTime(int32_t* status);
 
 int HAL_GetMatchInfo(HAL_MatchInfo* info);
 void HAL_FreeMatchInfo(HAL_MatchInfo* info);
+int32_t HAL_GetInlineMatchInfo(HAL_InlineMatchInfo* info);
 
 #ifndef HAL_USE_LABVIEW
 
@@ -23,6 +23,28 @@ enum HAL_EncoderEncodingType : int32_t {
   HAL_Encoder_k2X,
   HAL_Encoder_k4X
 };
+enum HAL_EncoderVelocityEstimatorType : int32_t {
+  HAL_EncoderVelocity_kPeriod,  // count period measured by the FPGA
+  HAL_EncoderVelocity_kTimedWindow,
+  HAL_EncoderVelocity_kLeastSquares,
+  HAL_EncoderVelocity_kAdaptiveWindow
+};
+
+#define HAL_kMaxEncoderVelocityWindow 64
+
+/**
+ * The state of an encoder captured by a single pair of register reads.
+ */
+struct HAL_EncoderSnapshot {
+  int32_t count;  // scaled by the decoding factor, as HAL_GetEncoder()
+  int32_t raw;
+  double distance;
+  double period;  // seconds; infinity if stopped
+  double rate;
+  HAL_Bool direction;
+  HAL_Bool stopped;
+  uint64_t timestamp;  // FPGA time in microseconds the registers were read
+};
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,6 +96,46 @@ double HAL_GetEncoderDistancePerPulse(HAL_EncoderHandle encoderHandle,
 
 HAL_EncoderEncodingType HAL_GetEncoderEncodingType(
     HAL_EncoderHandle encoderHandle, int32_t* status);
+
+/**
+ * Reads count, period, direction and stopped state together, so all values
+ * come from the same instant. Cheaper than calling the individual getters.
+ */
+void HAL_GetEncoderSnapshot(HAL_EncoderHandle encoderHandle,
+                            struct HAL_EncoderSnapshot* snapshot,
+                            int32_t* status);
+
+/**
+ * Estimate the rate of an encoder from counts sampled at a fixed rate instead
+ * of the FPGA count period. While enabled, HAL_GetEncoderRate() returns the
+ * estimate.
+ *
+ * @param type       The estimator; HAL_EncoderVelocity_kPeriod disables the
+ *                   estimator.
+ * @param windowSize The number of samples the estimator uses, 2 to
+ *                   HAL_kMaxEncoderVelocityWindow.
+ */
+void HAL_SetEncoderVelocityEstimator(HAL_EncoderHandle encoderHandle,
+                                     HAL_EncoderVelocityEstimatorType type,
+                                     int32_t windowSize, int32_t* status);
+HAL_EncoderVelocityEstimatorType HAL_GetEncoderVelocityEstimator(
+    HAL_EncoderHandle encoderHandle, int32_t* status);
+
+/**
+ * Set the time between the samples of every velocity estimator, in seconds.
+ */
+void HAL_SetEncoderVelocityUpdatePeriod(double period, int32_t* status);
+double HAL_GetEncoderVelocityUpdatePeriod(void);
+
+/**
+ * Get the latest estimate of an encoder, scaled by the distance per pulse.
+ *
+ * @param velocity     Set to the velocity, in distance per second.
+ * @param acceleration Set to the acceleration, in distance per second squared.
+ */
+void HAL_GetEncoderVelocityEstimate(HAL_EncoderHandle encoderHandle,
+                                    double* velocity, double* acceleration,
+                                    int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
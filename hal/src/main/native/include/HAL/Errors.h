@@ -82,6 +82,12 @@
 #define HAL_HANDLE_ERROR -1098
 #define HAL_HANDLE_ERROR_MESSAGE \
   "HAL: A handle parameter was passed incorrectly"
+#define HAL_INVALID_DMA_ADDITION -1102
+#define HAL_INVALID_DMA_ADDITION_MESSAGE \
+  "HAL: DMA sources can only be added before HAL_StartDMA()"
+#define HAL_INVALID_DMA_STATE -1103
+#define HAL_INVALID_DMA_STATE_MESSAGE \
+  "HAL: DMA must be started before samples can be read"
 
 #define HAL_SERIAL_PORT_NOT_FOUND -1123
 #define HAL_SERIAL_PORT_NOT_FOUND_MESSAGE \
@@ -103,6 +109,18 @@
 #define HAL_THREAD_PRIORITY_RANGE_ERROR_MESSAGE \
   "HAL: The priority requested to be set is invalid"
 
+#define HAL_THREAD_AFFINITY_ERROR -1154
+#define HAL_THREAD_AFFINITY_ERROR_MESSAGE \
+  "HAL: Getting or setting the CPU affinity of a thread has failed"
+
+#define HAL_MEMORY_LOCK_ERROR -1155
+#define HAL_MEMORY_LOCK_ERROR_MESSAGE \
+  "HAL: Locking the process memory has failed"
+
+#define HAL_THREAD_USAGE_ERROR -1156
+#define HAL_THREAD_USAGE_ERROR_MESSAGE \
+  "HAL: Reading the CPU usage of the threads has failed"
+
 #define VI_ERROR_SYSTEM_ERROR_MESSAGE "HAL - VISA: System Error";
 #define VI_ERROR_INV_OBJECT_MESSAGE "HAL - VISA: Invalid Object"
 #define VI_ERROR_RSRC_LOCKED_MESSAGE "HAL - VISA: Resource Locked"
@@ -17,17 +17,21 @@
 #include "HAL/AnalogInput.h"
 #include "HAL/AnalogOutput.h"
 #include "HAL/AnalogTrigger.h"
+#include "HAL/BusStatistics.h"
 #include "HAL/CAN.h"
 #include "HAL/Compressor.h"
 #include "HAL/Constants.h"
 #include "HAL/Counter.h"
 #include "HAL/DIO.h"
+#include "HAL/DMA.h"
 #include "HAL/DriverStation.h"
 #include "HAL/Errors.h"
 #include "HAL/I2C.h"
+#include "HAL/IORecording.h"
 #include "HAL/Interrupts.h"
 #include "HAL/Notifier.h"
 #include "HAL/PDP.h"
+#include "HAL/PerfCounters.h"
 #include "HAL/PWM.h"
 #include "HAL/Ports.h"
 #include "HAL/Power.h"
@@ -68,9 +72,12 @@ HAL_PortHandle HAL_GetPort(int32_t channel);
 HAL_PortHandle HAL_GetPortWithModule(int32_t module, int32_t channel);
 
 uint64_t HAL_GetFPGATime(int32_t* status);
+uint64_t HAL_GetFPGATimeFast(int32_t* status);
 
 HAL_Bool HAL_Initialize(int32_t timeout, int32_t mode);
 
+// Reports are queued and sent once the program has started, identical reports
+// only once.
 // ifdef's definition is to allow for default parameters in C++.
 #ifdef __cplusplus
 int64_t HAL_Report(int32_t resource, int32_t instanceNumber,
@@ -0,0 +1,98 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "HAL/Types.h"
+
+#define HAL_kIORecordMagic "HALIOREC"
+#define HAL_kIORecordVersion 1
+
+enum HAL_IORecordKind : uint16_t {
+  // index is the channel, value the state
+  HAL_IORecord_kDIO = 1,
+  // index is the encoder, value the count
+  HAL_IORecord_kEncoderCount = 2,
+  // index is the encoder, data the period in seconds as a double
+  HAL_IORecord_kEncoderPeriod = 3,
+  // index is the channel, value the raw sample (0 if averaged), data the
+  // voltage as a double
+  HAL_IORecord_kAnalogInput = 4,
+  // value is the HAL_ControlWord
+  HAL_IORecord_kControlWord = 5,
+  // value is the HAL_AllianceStationID
+  HAL_IORecord_kAllianceStation = 6,
+  // data is the match time as a double
+  HAL_IORecord_kMatchTime = 7,
+  // index is the joystick, value the count, data the float axes
+  HAL_IORecord_kJoystickAxes = 8,
+  // index is the joystick, value the count, data the int16_t POVs
+  HAL_IORecord_kJoystickPOVs = 9,
+  // index is the joystick, value the buttons, data[0] the count
+  HAL_IORecord_kJoystickButtons = 10,
+  // index is the data size, value the message ID, data the 8 data bytes
+  // followed by the uint32_t CAN timestamp
+  HAL_IORecord_kCANMessage = 11
+};
+
+/**
+ * One value read through the HAL. Records are fixed size so they can be
+ * queued without allocating; the meaning of index, value and data depends on
+ * the kind. Multi-byte values are in the byte order of the robot.
+ */
+struct HAL_IORecord {
+  // FPGA time of the read, in microseconds
+  uint64_t timestamp;
+  uint16_t kind;
+  uint16_t index;
+  int32_t value;
+  uint8_t data[48];
+};
+
+/**
+ * The start of a recording file. The records follow it back to back.
+ */
+struct HAL_IORecordFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t recordSize;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Starts recording every DIO, encoder, analog input, DS and CAN read result
+ * to a file, replacing any recording in progress.
+ *
+ * Reads only copy a record into a lock-free queue; a background thread
+ * writes the records into the file through a memory mapping. If the writer
+ * falls behind, records are dropped and counted rather than blocking the
+ * reading thread. Recording is only supported on the roboRIO; in simulation
+ * this does nothing, and the recording is fed back through the replay
+ * extension instead.
+ *
+ * @param path the file to write
+ */
+void HAL_StartIORecording(const char* path, int32_t* status);
+
+/**
+ * Stops recording, writing the remaining records and closing the file.
+ */
+void HAL_StopIORecording(void);
+
+/**
+ * Returns the number of records dropped because the writer fell behind,
+ * across every recording since the program started.
+ */
+int64_t HAL_GetIORecordingDropCount(void);
+#ifdef __cplusplus
+}  // extern "C"
+#endif
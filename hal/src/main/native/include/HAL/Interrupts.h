@@ -19,12 +19,33 @@ extern "C" {
 typedef void (*HAL_InterruptHandlerFunction)(uint32_t interruptAssertedMask,
                                              void* param);
 
+#define HAL_kMaxInterruptDispatchThreads 2
+
+#define HAL_kInterruptRisingEdge 0x1
+#define HAL_kInterruptFallingEdge 0x100
+
+/**
+ * One edge recorded by an interrupt event queue.
+ */
+struct HAL_InterruptEvent {
+  // In seconds, in the same time domain as HAL_ReadInterruptRisingTimestamp()
+  double timestamp;
+  // HAL_kInterruptRisingEdge or HAL_kInterruptFallingEdge
+  int32_t edge;
+};
+
 HAL_InterruptHandle HAL_InitializeInterrupts(HAL_Bool watcher, int32_t* status);
 void HAL_CleanInterrupts(HAL_InterruptHandle interruptHandle, int32_t* status);
 
 int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
                              double timeout, HAL_Bool ignorePrevious,
                              int32_t* status);
+int64_t HAL_WaitForMultipleInterrupts(const HAL_InterruptHandle* handles,
+                                      int32_t count, double timeout,
+                                      HAL_Bool ignorePrevious,
+                                      double* risingTimestamps,
+                                      double* fallingTimestamps,
+                                      int32_t* status);
 void HAL_EnableInterrupts(HAL_InterruptHandle interruptHandle, int32_t* status);
 void HAL_DisableInterrupts(HAL_InterruptHandle interruptHandle,
                            int32_t* status);
@@ -42,9 +63,21 @@ void HAL_AttachInterruptHandler(HAL_InterruptHandle interruptHandle,
 void HAL_AttachInterruptHandlerThreaded(HAL_InterruptHandle interruptHandle,
                                         HAL_InterruptHandlerFunction handler,
                                         void* param, int32_t* status);
+void HAL_SetInterruptHandlerPriority(HAL_InterruptHandle interruptHandle,
+                                     int32_t priority, int32_t* status);
+void HAL_ConfigureInterruptDispatch(int32_t threadCount, HAL_Bool realTime,
+                                    int32_t priority, uint32_t cpuMask,
+                                    int32_t* status);
 void HAL_SetInterruptUpSourceEdge(HAL_InterruptHandle interruptHandle,
                                   HAL_Bool risingEdge, HAL_Bool fallingEdge,
                                   int32_t* status);
+void HAL_SetInterruptEventQueueSize(HAL_InterruptHandle interruptHandle,
+                                    int32_t size, int32_t* status);
+int32_t HAL_ReadInterruptEvents(HAL_InterruptHandle interruptHandle,
+                                struct HAL_InterruptEvent* events,
+                                int32_t count, int32_t* status);
+int64_t HAL_GetInterruptEventOverflowCount(HAL_InterruptHandle interruptHandle,
+                                           int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -22,8 +22,14 @@ void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
                              uint64_t triggerTime, int32_t* status);
 void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
                              int32_t* status);
+// Makes each alarm re-arm itself period microseconds after its trigger time,
+// skipping ticks that have already passed; 0 makes alarms one-shot again.
+void HAL_SetNotifierPeriodic(HAL_NotifierHandle notifierHandle,
+                             uint64_t period, int32_t* status);
 uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
                                   int32_t* status);
+int32_t HAL_GetNotifierLateAlarmCount(HAL_NotifierHandle notifierHandle,
+                                      int32_t* status);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -10,12 +10,19 @@
 #include <stdint.h>
 
 #include "SerialPort.h"
+#include "HAL/Types.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * The OS serial functions drive a port through its termios device instead of
+ * NI-VISA. They take the same values as the HAL_*Serial functions.
+ */
 void HAL_InitializeOSSerialPort(HAL_SerialPort port, int32_t* status);
+void HAL_InitializeOSSerialPortDirect(HAL_SerialPort port, const char* portName,
+                                      int32_t* status);
 void HAL_SetOSSerialBaudRate(HAL_SerialPort port, int32_t baud,
                              int32_t* status);
 void HAL_SetOSSerialDataBits(HAL_SerialPort port, int32_t bits,
@@ -37,6 +44,24 @@ void HAL_SetOSSerialReadBufferSize(HAL_SerialPort port, int32_t size,
                                    int32_t* status);
 void HAL_SetOSSerialWriteBufferSize(HAL_SerialPort port, int32_t size,
                                     int32_t* status);
+
+/**
+ * Sets whether the driver passes received bytes on immediately
+ * (ASYNC_LOW_LATENCY) rather than batching them. USB ports are put in low
+ * latency mode when initialized; not every driver supports it.
+ */
+void HAL_SetOSSerialLowLatency(HAL_SerialPort port, HAL_Bool lowLatency,
+                               int32_t* status);
+
+/**
+ * Returns the file descriptor of the port, for waiting on it with poll() or
+ * select(). It is readable when HAL_ReadOSSerial() would return data without
+ * waiting, unless a terminated read left bytes buffered;
+ * HAL_GetOSSerialBytesReceived() counts those as well. The descriptor must
+ * not be read, written or closed directly.
+ */
+int32_t HAL_GetOSSerialFileDescriptor(HAL_SerialPort port, int32_t* status);
+
 int32_t HAL_GetOSSerialBytesReceived(HAL_SerialPort port, int32_t* status);
 int32_t HAL_ReadOSSerial(HAL_SerialPort port, char* buffer, int32_t count,
                          int32_t* status);
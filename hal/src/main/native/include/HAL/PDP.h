@@ -11,6 +11,24 @@
 
 #include "HAL/Types.h"
 
+#define HAL_kPDPNumChannels 16
+
+/**
+ * Every value a PDP reports, decoded from a single read of each of its CAN
+ * status frames.
+ */
+struct HAL_PDPSnapshot {
+  double currents[HAL_kPDPNumChannels];
+  double voltage;
+  double temperature;
+  double totalCurrent;
+  double totalPower;
+  double totalEnergy;
+  // CAN receive time in ms of status frames 1-3 (currents, then voltage and
+  // temperature with frame 3) and of the energy frame; 0 if never received
+  uint32_t frameTimeStamps[4];
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,6 +43,14 @@ double HAL_GetPDPChannelCurrent(int32_t module, int32_t channel,
 double HAL_GetPDPTotalCurrent(int32_t module, int32_t* status);
 double HAL_GetPDPTotalPower(int32_t module, int32_t* status);
 double HAL_GetPDPTotalEnergy(int32_t module, int32_t* status);
+/**
+ * Reads all channel currents, decoding each status frame once.
+ *
+ * @param currents Filled with HAL_kPDPNumChannels currents in amps.
+ */
+void HAL_GetPDPAllCurrents(int32_t module, double* currents, int32_t* status);
+void HAL_GetPDPSnapshot(int32_t module, struct HAL_PDPSnapshot* snapshot,
+                        int32_t* status);
 void HAL_ResetPDPTotalEnergy(int32_t module, int32_t* status);
 void HAL_ClearPDPStickyFaults(int32_t module, int32_t* status);
 #ifdef __cplusplus
@@ -40,6 +40,8 @@ void HAL_SetPWMRaw(HAL_DigitalHandle pwmPortHandle, int32_t value,
                    int32_t* status);
 void HAL_SetPWMSpeed(HAL_DigitalHandle pwmPortHandle, double speed,
                      int32_t* status);
+void HAL_SetPWMSpeeds(const HAL_DigitalHandle* pwmPortHandles,
+                      const double* speeds, int32_t count, int32_t* status);
 void HAL_SetPWMPosition(HAL_DigitalHandle pwmPortHandle, double position,
                         int32_t* status);
 void HAL_SetPWMDisabled(HAL_DigitalHandle pwmPortHandle, int32_t* status);
@@ -51,6 +53,9 @@ void HAL_SetPWMPeriodScale(HAL_DigitalHandle pwmPortHandle, int32_t squelchMask,
                            int32_t* status);
 int32_t HAL_GetPWMLoopTiming(int32_t* status);
 uint64_t HAL_GetPWMCycleStartTime(int32_t* status);
+void HAL_SetPWMOutputsDeferred(HAL_Bool deferred, int32_t* status);
+HAL_Bool HAL_GetPWMOutputsDeferred(void);
+void HAL_CommitPWMOutputs(int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include "HAL/Types.h"
+
+enum HAL_PerfCounterType : int32_t {
+  // Calls into each HAL function family, and the time spent in them
+  HAL_kPerfCounterDIO = 0,
+  HAL_kPerfCounterAnalog,
+  HAL_kPerfCounterPWM,
+  HAL_kPerfCounterEncoder,
+  HAL_kPerfCounterCounter,
+  HAL_kPerfCounterSPI,
+  HAL_kPerfCounterI2C,
+  HAL_kPerfCounterSerial,
+  HAL_kPerfCounterCAN,
+  HAL_kPerfCounterDriverStation,
+  HAL_kPerfCounterNotifier,
+  HAL_kPerfCounterInterrupt,
+  // Transitions from Java into the JNI bindings; counted only, not timed
+  HAL_kPerfCounterJNI,
+  // Samples rather than calls: how late each notifier alarm was serviced,
+  // and how long after a DS packet arrived a waiting thread woke up
+  HAL_kPerfCounterNotifierLateness,
+  HAL_kPerfCounterDSWakeLatency,
+  HAL_kPerfCounterCount
+};
+
+/**
+ * The totals of one counter over every thread, since counting was first
+ * enabled.
+ */
+struct HAL_PerfCounter {
+  uint64_t count;
+  uint64_t totalTime;  // nanoseconds
+  // The longest single call or sample since HAL_ResetPerfCounterMaximums(),
+  // in nanoseconds
+  uint64_t maxTime;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Enables or disables counting. Counting is off by default; while it is off,
+ * an instrumented call only reads one atomic flag.
+ *
+ * Each thread counts into its own block, so counting takes no locks; the
+ * blocks are only summed when the counters are read.
+ */
+void HAL_SetPerfCountersEnabled(HAL_Bool enabled);
+HAL_Bool HAL_GetPerfCountersEnabled(void);
+
+/**
+ * Sums the counters of every thread, including threads that have exited.
+ *
+ * @param counters array to fill, indexed by HAL_PerfCounterType
+ * @param size     the size of counters; at most HAL_kPerfCounterCount are
+ *                 filled
+ * @return the number of counters filled
+ */
+int32_t HAL_GetPerfCounters(struct HAL_PerfCounter* counters, int32_t size);
+
+/**
+ * Starts a new interval for the maxTime of every counter. The counts and
+ * totals keep accumulating; take differences of two readings for those.
+ */
+void HAL_ResetPerfCounterMaximums(void);
+
+/**
+ * Adds one call or sample to a counter, from the calling thread. For code
+ * outside the HAL, such as language bindings, that wants to be counted with
+ * it.
+ */
+void HAL_RecordPerfCounter(int32_t type, uint64_t time);
+#ifdef __cplusplus
+}
+#endif
@@ -11,6 +11,27 @@
 
 #include "HAL/Types.h"
 
+/**
+ * Every rail the roboRIO monitors, read together.
+ */
+struct HAL_PowerSnapshot {
+  double vinVoltage;
+  double vinCurrent;
+  double userVoltage6V;
+  double userCurrent6V;
+  double userVoltage5V;
+  double userCurrent5V;
+  double userVoltage3V3;
+  double userCurrent3V3;
+  HAL_Bool userActive6V;
+  HAL_Bool userActive5V;
+  HAL_Bool userActive3V3;
+  int32_t userCurrentFaults6V;
+  int32_t userCurrentFaults5V;
+  int32_t userCurrentFaults3V3;
+  uint64_t timeStamp;  // FPGA time in microseconds
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -29,6 +50,7 @@ double HAL_GetUserVoltage3V3(int32_t* status);
 double HAL_GetUserCurrent3V3(int32_t* status);
 HAL_Bool HAL_GetUserActive3V3(int32_t* status);
 int32_t HAL_GetUserCurrentFaults3V3(int32_t* status);
+void HAL_GetPowerSnapshot(struct HAL_PowerSnapshot* snapshot, int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
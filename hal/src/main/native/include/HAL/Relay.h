@@ -24,6 +24,7 @@ HAL_Bool HAL_CheckRelayChannel(int32_t channel);
 void HAL_SetRelay(HAL_RelayHandle relayPortHandle, HAL_Bool on,
                   int32_t* status);
 HAL_Bool HAL_GetRelay(HAL_RelayHandle relayPortHandle, int32_t* status);
+void HAL_SetRelaysMasked(uint32_t mask, uint32_t values, int32_t* status);
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -20,6 +20,23 @@ enum HAL_SPIPort : int32_t {
   HAL_SPI_kMXP
 };
 
+// Largest number of transfers HAL_TransactionSPIBatch() accepts
+#define HAL_kSPIMaxBatchTransfers 32
+
+/**
+ * One segment of a batched SPI transaction. Either buffer may be null to only
+ * receive or only send.
+ */
+struct HAL_SPITransfer {
+  const uint8_t* dataToSend;
+  uint8_t* dataReceived;
+  int32_t size;
+  // Deselect the chip between this segment and the next
+  HAL_Bool csChange;
+  // Delay after this segment, before chip select is changed
+  int32_t delayMicroseconds;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -30,6 +47,13 @@ int32_t HAL_TransactionSPI(HAL_SPIPort port, const uint8_t* dataToSend,
 int32_t HAL_WriteSPI(HAL_SPIPort port, const uint8_t* dataToSend,
                      int32_t sendSize);
 int32_t HAL_ReadSPI(HAL_SPIPort port, uint8_t* buffer, int32_t count);
+/**
+ * Executes several transfers back to back as a single transaction. Returns
+ * the total number of bytes transferred, or -1 for an error.
+ */
+int32_t HAL_TransactionSPIBatch(HAL_SPIPort port,
+                                const struct HAL_SPITransfer* transfers,
+                                int32_t count);
 void HAL_CloseSPI(HAL_SPIPort port);
 void HAL_SetSPISpeed(HAL_SPIPort port, int32_t speed);
 void HAL_SetSPIOpts(HAL_SPIPort port, HAL_Bool msbFirst,
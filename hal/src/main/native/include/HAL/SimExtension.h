@@ -0,0 +1,100 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#ifndef __FRC_ROBORIO__
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace hal {
+namespace sim {
+
+/**
+ * The version of the C++ extension interface. It is incremented whenever
+ * ExtensionHost or DeviceTables change; members are only ever added at the
+ * end, so an extension built against an older version keeps working with a
+ * newer HAL.
+ */
+constexpr int32_t kExtensionApiVersion = 1;
+
+/**
+ * Called after each step of simulated time, from the thread that stepped it.
+ *
+ * @param param the parameter given when registering
+ * @param time  the simulated FPGA time stepped to, in microseconds
+ */
+typedef void (*StepCallback)(void* param, uint64_t time);
+
+/**
+ * Direct views of the contiguous device data of one simulation context.
+ *
+ * Values are read and written without index checks, callbacks or change
+ * batch records, so whole tables can be processed in one pass. Writes made
+ * this way are seen by the robot program but not by callbacks; use the
+ * HALSIM setters for values other extensions must be notified of.
+ */
+struct DeviceTables {
+  std::atomic<double>* pwmSpeeds;
+  int32_t numPWMChannels;
+  std::atomic<int32_t>* encoderCounts;
+  int32_t numEncoders;
+};
+
+/**
+ * The interface the HAL gives to C++ extensions, for in-process extensions
+ * (physics, logging, replay) that need more than the per-field HALSIM
+ * functions.
+ */
+class ExtensionHost {
+ public:
+  /**
+   * Returns the version of this interface the HAL implements.
+   */
+  virtual int32_t GetApiVersion() const = 0;
+
+  /**
+   * Returns the device tables of the calling thread's simulation context.
+   * In a step callback, that is the context being stepped.
+   */
+  virtual DeviceTables GetDeviceTables() const = 0;
+
+  /**
+   * Registers a callback run after each step of HALSIM_StepTiming(), once the
+   * notifiers due in the step have run and before collected changes are
+   * flushed to the change batch callbacks. Returns a uid for
+   * CancelStepCallback(), or -1 if the callback is null.
+   */
+  virtual int32_t RegisterStepCallback(StepCallback callback, void* param) = 0;
+  virtual void CancelStepCallback(int32_t uid) = 0;
+
+ protected:
+  ~ExtensionHost() = default;
+};
+
+/**
+ * Returns the host passed to C++ extensions, for code linked with the HAL
+ * directly rather than loaded as an extension.
+ */
+ExtensionHost& GetExtensionHost();
+
+}  // namespace sim
+}  // namespace hal
+
+/**
+ * A C++ extension exposes HALSIM_InitExtensionCpp, which is used in place of
+ * HALSIM_InitExtension when both are present. It is passed the interface
+ * version of the HAL, which it should check against the version it needs,
+ * and the host, which stays valid for the life of the program. It returns
+ * the same codes as HALSIM_InitExtension.
+ */
+typedef int halsim_extension_init_cpp_func_t(int32_t version,
+                                             hal::sim::ExtensionHost* host);
+
+#endif
@@ -26,6 +26,19 @@ int32_t HAL_GetAllSolenoids(int32_t module, int32_t* status);
 void HAL_SetSolenoid(HAL_SolenoidHandle solenoidPortHandle, HAL_Bool value,
                      int32_t* status);
 void HAL_SetAllSolenoids(int32_t module, int32_t state, int32_t* status);
+/**
+ * Sets the solenoids selected by mask to the matching bits of values, with a
+ * single update of the PCM control frame.
+ */
+void HAL_SetSolenoids(int32_t module, int32_t mask, int32_t values,
+                      int32_t* status);
+/**
+ * Holds solenoid changes on a module until the matching
+ * HAL_EndSolenoidTransaction(), which sends them in one control frame update.
+ * Transactions may nest.
+ */
+void HAL_BeginSolenoidTransaction(int32_t module, int32_t* status);
+void HAL_EndSolenoidTransaction(int32_t module, int32_t* status);
 int32_t HAL_GetPCMSolenoidBlackList(int32_t module, int32_t* status);
 HAL_Bool HAL_GetPCMSolenoidVoltageStickyFault(int32_t module, int32_t* status);
 HAL_Bool HAL_GetPCMSolenoidVoltageFault(int32_t module, int32_t* status);
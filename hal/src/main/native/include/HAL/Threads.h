@@ -17,6 +17,45 @@
 
 #include "HAL/Types.h"
 
+/*
+ * Locks shared by real-time and normal priority threads.
+ *
+ * A real-time thread (a notifier, interrupt or control loop thread) waiting
+ * for a lock held by a normal priority thread (the main, NetworkTables or
+ * dashboard threads) waits for as long as that thread is preempted, which on
+ * a busy roboRIO is several milliseconds. On the roboRIO wpi::mutex is
+ * wpi::priority_mutex, whose holder inherits the priority of the highest
+ * priority thread waiting for it, so the wait is only as long as the critical
+ * section.
+ *
+ * Real-time threads may take these locks:
+ * - the per-handle locks of the HAL handle resources, taken by every HAL call
+ *   on a handle
+ * - Notifier's m_processMutex, taken when a notifier's alarm is processed
+ * - PIDController's m_inputMutex, m_stateMutex and m_pidWriteMutex, taken by
+ *   Calculate()
+ * - DriverStation's m_cacheDataMutex, taken by the button edge getters
+ * - the Waveform engine's lock, taken while it writes samples
+ *
+ * PIDController's m_thisMutex is only taken by the setters and is never
+ * waited on by Calculate(), which reads the configuration it guards
+ * atomically. Other locks should not be taken on real-time threads, and
+ * std::mutex, which doesn't inherit priority, should not be used for locks
+ * they take.
+ */
+
+/**
+ * CPU time used by one thread of the process, as counted by the kernel.
+ * Usage over an interval is the difference of two readings.
+ */
+struct HAL_ThreadCPUUsage {
+  int32_t threadId;
+  char name[16];
+  double userTime;    // seconds
+  double systemTime;  // seconds
+  int32_t processor;  // the CPU the thread last ran on
+};
+
 extern "C" {
 int32_t HAL_GetThreadPriority(NativeThreadHandle handle, HAL_Bool* isRealTime,
                               int32_t* status);
@@ -25,4 +64,11 @@ HAL_Bool HAL_SetThreadPriority(NativeThreadHandle handle, HAL_Bool realTime,
                                int32_t priority, int32_t* status);
 HAL_Bool HAL_SetCurrentThreadPriority(HAL_Bool realTime, int32_t priority,
                                       int32_t* status);
+int32_t HAL_GetThreadAffinity(NativeThreadHandle handle, int32_t* status);
+HAL_Bool HAL_SetThreadAffinity(NativeThreadHandle handle, int32_t cpuMask,
+                               int32_t* status);
+HAL_Bool HAL_SetCurrentThreadAffinity(int32_t cpuMask, int32_t* status);
+HAL_Bool HAL_LockProcessMemory(int32_t stackPrefaultSize, int32_t* status);
+int32_t HAL_GetThreadCPUUsage(HAL_ThreadCPUUsage* usage, int32_t count,
+                              int32_t* status);
 }  // extern "C"
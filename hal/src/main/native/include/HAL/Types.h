@@ -29,6 +29,8 @@ typedef HAL_Handle HAL_DigitalHandle;
 
 typedef HAL_Handle HAL_DigitalPWMHandle;
 
+typedef HAL_Handle HAL_DMAHandle;
+
 typedef HAL_Handle HAL_EncoderHandle;
 
 typedef HAL_Handle HAL_FPGAEncoderHandle;
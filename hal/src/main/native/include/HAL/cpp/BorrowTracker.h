@@ -0,0 +1,51 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <support/mutex.h>
+
+namespace hal {
+
+/**
+ * Tracks the readers of structures published through an atomic pointer, so a
+ * structure unpublished while borrowed is destroyed only after they are done.
+ *
+ * A borrower is counted with Enter() before it loads the pointer, and a
+ * retired structure's pointer is cleared or replaced before the count is
+ * checked, all sequentially consistent. So if Retire() sees no borrowers, no
+ * one can hold the structure; otherwise it is destroyed when the last
+ * borrower calls Exit(). Unborrowed structures are destroyed immediately.
+ */
+class BorrowTracker {
+ public:
+  BorrowTracker() = default;
+  BorrowTracker(const BorrowTracker&) = delete;
+  BorrowTracker& operator=(const BorrowTracker&) = delete;
+
+  void Enter() { m_borrowers.fetch_add(1); }
+  void Exit();
+
+  // Destroys a structure whose pointer has been unpublished, once it's
+  // unborrowed
+  void Retire(std::shared_ptr<void> structure);
+
+ private:
+  // Moves the retired structures to reclaimed if nothing is borrowed
+  void ReclaimLocked(std::vector<std::shared_ptr<void>>* reclaimed);
+
+  std::atomic<int> m_borrowers{0};
+  std::atomic<bool> m_hasRetired{false};
+  std::vector<std::shared_ptr<void>> m_retired;
+  wpi::mutex m_mutex;
+};
+
+}  // namespace hal
@@ -0,0 +1,97 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+namespace hal {
+
+/**
+ * A bounded queue written by any number of threads and drained by one reader.
+ * Neither side takes a lock; when the queue is full Push() fails and the
+ * value is counted as an overflow.
+ *
+ * Each slot carries a sequence number that tells writers when it is free and
+ * the reader when it is filled, so a writer claims a slot with a single
+ * compare-and-swap and fills it without blocking other writers.
+ */
+template <typename T, size_t Size>
+class BoundedMPSCQueue {
+  static_assert(Size >= 2 && (Size & (Size - 1)) == 0,
+                "Size must be a power of two");
+
+ public:
+  BoundedMPSCQueue() : m_slots(new Slot[Size]) {
+    for (size_t i = 0; i < Size; i++) {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedMPSCQueue(const BoundedMPSCQueue&) = delete;
+  BoundedMPSCQueue& operator=(const BoundedMPSCQueue&) = delete;
+
+  bool Push(const T& value) {
+    size_t pos = m_head.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &m_slots[pos & (Size - 1)];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (m_head.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The reader has not emptied this slot yet
+        m_overflows.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        // Another writer claimed the slot first
+        pos = m_head.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = value;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool Pop(T* value) {
+    Slot& slot = m_slots[m_tail & (Size - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != m_tail + 1) {
+      return false;
+    }
+    *value = slot.value;
+    slot.sequence.store(m_tail + Size, std::memory_order_release);
+    m_tail++;
+    return true;
+  }
+
+  int64_t GetOverflowCount() const {
+    return m_overflows.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Slot[]> m_slots;
+  std::atomic<size_t> m_head{0};
+  // Only used by the reader
+  size_t m_tail = 0;
+  std::atomic<int64_t> m_overflows{0};
+};
+
+}  // namespace hal
@@ -0,0 +1,72 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "HAL/BusStatistics.h"
+#include "HAL/cpp/PerfCounters.h"
+
+namespace hal {
+
+namespace detail {
+std::atomic<bool>& BusStatisticsEnabledFlag();
+void RecordBusCall(HAL_BusType bus, int32_t port, uint64_t time, bool error);
+}  // namespace detail
+
+inline bool BusStatisticsEnabled() {
+  return detail::BusStatisticsEnabledFlag().load(std::memory_order_relaxed);
+}
+
+/**
+ * Counts a bus call by the enclosing function, and the time until the scope
+ * ends, when the bus statistics are enabled.
+ *
+ * The call is counted as an error if the status it was given is nonzero when
+ * the scope ends, if a negative result was passed to Result(), or if
+ * SetError() was called.
+ */
+class BusStatisticsScope {
+ public:
+  BusStatisticsScope(HAL_BusType bus, int32_t port,
+                     const int32_t* status = nullptr)
+      : m_bus(bus),
+        m_port(port),
+        m_status(status),
+        m_start(BusStatisticsEnabled() ? PerfCounterTime() : 0) {}
+  ~BusStatisticsScope() {
+    if (m_start != 0) {
+      if (m_status && *m_status != 0) m_error = true;
+      detail::RecordBusCall(m_bus, m_port, PerfCounterTime() - m_start,
+                            m_error);
+    }
+  }
+
+  BusStatisticsScope(const BusStatisticsScope&) = delete;
+  BusStatisticsScope& operator=(const BusStatisticsScope&) = delete;
+
+  // For functions that return a negative value on failure:
+  // return scope.Result(ioctl(...));
+  int32_t Result(int32_t result) {
+    if (result < 0) m_error = true;
+    return result;
+  }
+
+  void SetError() { m_error = true; }
+
+ private:
+  HAL_BusType m_bus;
+  int32_t m_port;
+  const int32_t* m_status;
+  bool m_error = false;
+  uint64_t m_start;
+};
+
+}  // namespace hal
@@ -0,0 +1,139 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cmath>
+
+#include "HAL/Encoder.h"
+
+namespace hal {
+
+/**
+ * Estimates velocity and acceleration from encoder counts sampled at a fixed
+ * rate, in counts per second and counts per second squared.
+ *
+ * The timed window estimator differences the ends of the window, the least
+ * squares estimator fits a line to the whole window, and the adaptive window
+ * estimator uses the longest window whose samples all lie within one count of
+ * the line through its ends, so it is smooth at low speed and responsive at
+ * high speed. Acceleration is the least squares slope of the latest velocity
+ * estimates over the same window.
+ */
+class EncoderVelocityEstimator {
+ public:
+  EncoderVelocityEstimator(HAL_EncoderVelocityEstimatorType type,
+                           int32_t windowSize)
+      : m_type(type), m_windowSize(windowSize) {}
+
+  HAL_EncoderVelocityEstimatorType GetType() const { return m_type; }
+
+  void AddSample(double time, int32_t count) {
+    if (m_size > 0 && time <= m_times[Index(0)]) return;
+    m_times[m_next] = time;
+    m_counts[m_next] = count;
+    m_next = (m_next + 1) % kMaxSamples;
+    if (m_size < kMaxSamples) m_size++;
+
+    m_velocity = EstimateVelocity();
+    m_velocities[Index(0)] = m_velocity;
+    m_acceleration = EstimateAcceleration();
+  }
+
+  void Reset() {
+    m_size = 0;
+    m_velocity = 0.0;
+    m_acceleration = 0.0;
+  }
+
+  double GetVelocity() const { return m_velocity; }
+  double GetAcceleration() const { return m_acceleration; }
+
+ private:
+  static constexpr int32_t kMaxSamples = HAL_kMaxEncoderVelocityWindow;
+
+  // Index of the sample j before the newest
+  int32_t Index(int32_t j) const {
+    return (m_next + kMaxSamples - 1 - j) % kMaxSamples;
+  }
+
+  double Slope(int32_t j) const {
+    return (m_counts[Index(0)] - m_counts[Index(j)]) /
+           (m_times[Index(0)] - m_times[Index(j)]);
+  }
+
+  // Least squares slope of values against the sample times over n samples
+  template <typename T>
+  double FitSlope(const T* values, int32_t n) const {
+    double meanTime = 0.0;
+    double meanValue = 0.0;
+    for (int32_t j = 0; j < n; j++) {
+      meanTime += m_times[Index(j)] - m_times[Index(0)];
+      meanValue += static_cast<double>(values[Index(j)]) - values[Index(0)];
+    }
+    meanTime /= n;
+    meanValue /= n;
+    double covariance = 0.0;
+    double variance = 0.0;
+    for (int32_t j = 0; j < n; j++) {
+      double dt = m_times[Index(j)] - m_times[Index(0)] - meanTime;
+      double dv = static_cast<double>(values[Index(j)]) - values[Index(0)];
+      covariance += dt * (dv - meanValue);
+      variance += dt * dt;
+    }
+    return variance > 0.0 ? covariance / variance : 0.0;
+  }
+
+  double EstimateVelocity() const {
+    int32_t n = m_size < m_windowSize ? m_size : m_windowSize;
+    if (n < 2) return 0.0;
+
+    switch (m_type) {
+      case HAL_EncoderVelocity_kLeastSquares:
+        return FitSlope(m_counts, n);
+      case HAL_EncoderVelocity_kAdaptiveWindow: {
+        int32_t best = 1;
+        for (int32_t end = 1; end < n; end++) {
+          double slope = Slope(end);
+          bool fits = true;
+          for (int32_t j = 1; j < end && fits; j++) {
+            double expected = m_counts[Index(0)] -
+                              slope * (m_times[Index(0)] - m_times[Index(j)]);
+            fits = std::abs(m_counts[Index(j)] - expected) <= 1.0;
+          }
+          if (!fits) break;
+          best = end;
+        }
+        return Slope(best);
+      }
+      default:
+        return Slope(n - 1);
+    }
+  }
+
+  double EstimateAcceleration() const {
+    int32_t n = m_size < m_windowSize ? m_size : m_windowSize;
+    if (n < 2) return 0.0;
+    return FitSlope(m_velocities, n);
+  }
+
+  HAL_EncoderVelocityEstimatorType m_type;
+  int32_t m_windowSize;
+
+  double m_times[kMaxSamples];
+  int32_t m_counts[kMaxSamples];
+  double m_velocities[kMaxSamples];
+  int32_t m_next = 0;
+  int32_t m_size = 0;
+
+  double m_velocity = 0.0;
+  double m_acceleration = 0.0;
+};
+
+}  // namespace hal
@@ -0,0 +1,64 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include "HAL/Interrupts.h"
+
+namespace hal {
+
+/**
+ * A bounded ring of interrupt edges, written by the thread that handles the
+ * interrupt and drained by one reader. Neither side takes a lock; when the
+ * ring is full new edges are dropped and counted.
+ */
+class InterruptEventQueue {
+ public:
+  explicit InterruptEventQueue(size_t size) : m_events(size + 1) {}
+
+  void Push(double timestamp, int32_t edge) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t next = (head + 1) % m_events.size();
+    if (next == m_tail.load(std::memory_order_acquire)) {
+      m_overflows.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    m_events[head].timestamp = timestamp;
+    m_events[head].edge = edge;
+    m_head.store(next, std::memory_order_release);
+  }
+
+  int32_t Pop(HAL_InterruptEvent* events, int32_t count) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t head = m_head.load(std::memory_order_acquire);
+    int32_t read = 0;
+    while (read < count && tail != head) {
+      events[read++] = m_events[tail];
+      tail = (tail + 1) % m_events.size();
+    }
+    m_tail.store(tail, std::memory_order_release);
+    return read;
+  }
+
+  int64_t GetOverflowCount() const {
+    return m_overflows.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // One slot is always left empty to tell a full ring from an empty one
+  std::vector<HAL_InterruptEvent> m_events;
+  std::atomic<size_t> m_head{0};
+  std::atomic<size_t> m_tail{0};
+  std::atomic<int64_t> m_overflows{0};
+};
+
+}  // namespace hal
@@ -0,0 +1,165 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <support/mutex.h>
+
+namespace hal {
+
+/**
+ * A pool of fixed-size blocks carved out of one arena when the pool is
+ * constructed, so objects allocated from it never wait on the heap or take a
+ * page fault after startup.
+ *
+ * Allocations larger than a block, or made while every block is in use, fall
+ * back to the heap and are counted as overflows.
+ */
+class MemoryPool {
+ public:
+  MemoryPool(size_t blockSize, size_t blockCount)
+      : m_blockSize(RoundUp(blockSize)),
+        m_blockCount(blockCount),
+        m_arena(new unsigned char[m_blockSize * blockCount]) {
+    // Thread the free list through the blocks, and touch every page
+    for (size_t i = blockCount; i > 0; i--) {
+      void* block = m_arena.get() + (i - 1) * m_blockSize;
+      *static_cast<void**>(block) = m_free;
+      m_free = block;
+    }
+  }
+
+  MemoryPool(const MemoryPool&) = delete;
+  MemoryPool& operator=(const MemoryPool&) = delete;
+
+  void* Allocate(size_t size) {
+    if (size <= m_blockSize) {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      if (m_free != nullptr) {
+        void* block = m_free;
+        m_free = *static_cast<void**>(block);
+        m_used++;
+        return block;
+      }
+    }
+    m_overflows.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(size);
+  }
+
+  void Deallocate(void* block) {
+    if (!Owns(block)) {
+      ::operator delete(block);
+      return;
+    }
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    *static_cast<void**>(block) = m_free;
+    m_free = block;
+    m_used--;
+  }
+
+  bool Owns(const void* block) const {
+    auto begin = static_cast<const void*>(m_arena.get());
+    auto end =
+        static_cast<const void*>(m_arena.get() + m_blockSize * m_blockCount);
+    return !std::less<const void*>()(block, begin) &&
+           std::less<const void*>()(block, end);
+  }
+
+  size_t GetBlockSize() const { return m_blockSize; }
+  size_t GetBlockCount() const { return m_blockCount; }
+
+  size_t GetUsedCount() {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    return m_used;
+  }
+
+  int64_t GetOverflowCount() const {
+    return m_overflows.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Blocks hold any type and at least the free list link
+  static size_t RoundUp(size_t size) {
+    constexpr size_t align = alignof(std::max_align_t);
+    if (size < sizeof(void*)) size = sizeof(void*);
+    return (size + align - 1) / align * align;
+  }
+
+  size_t m_blockSize;
+  size_t m_blockCount;
+  std::unique_ptr<unsigned char[]> m_arena;
+
+  wpi::mutex m_mutex;
+  void* m_free = nullptr;
+  size_t m_used = 0;
+  std::atomic<int64_t> m_overflows{0};
+};
+
+/**
+ * A standard allocator drawing from a MemoryPool, mainly for
+ * std::allocate_shared() (see MakePooled()).
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+
+  explicit PoolAllocator(MemoryPool* pool) : m_pool(pool) {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) : m_pool(other.GetPool()) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(m_pool->Allocate(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) { m_pool->Deallocate(p); }
+
+  MemoryPool* GetPool() const { return m_pool; }
+
+ private:
+  MemoryPool* m_pool;
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+  return lhs.GetPool() == rhs.GetPool();
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& lhs, const PoolAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+/**
+ * The block size a MemoryPool needs so that MakePooled<T>() fits the object
+ * and its shared_ptr control block in one block.
+ */
+template <typename T>
+constexpr size_t SharedBlockSize() {
+  return sizeof(T) + 8 * sizeof(void*);
+}
+
+/**
+ * Create a shared object in a MemoryPool, the pooled version of
+ * std::make_shared().
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> MakePooled(MemoryPool& pool, Args&&... args) {
+  return std::allocate_shared<T>(PoolAllocator<T>(&pool),
+                                 std::forward<Args>(args)...);
+}
+
+}  // namespace hal
@@ -0,0 +1,67 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+
+#include "HAL/PerfCounters.h"
+
+namespace hal {
+
+namespace detail {
+std::atomic<bool>& PerfCountersEnabledFlag();
+void RecordPerfCounter(int32_t type, uint64_t time);
+}  // namespace detail
+
+inline bool PerfCountersEnabled() {
+  return detail::PerfCountersEnabledFlag().load(std::memory_order_relaxed);
+}
+
+// The clock the counters are timed with, in nanoseconds
+inline uint64_t PerfCounterTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/**
+ * Counts a call of the enclosing function, and the time until the scope
+ * ends, when counting is enabled.
+ */
+class PerfCounterScope {
+ public:
+  explicit PerfCounterScope(HAL_PerfCounterType type)
+      : m_type(type), m_start(PerfCountersEnabled() ? PerfCounterTime() : 0) {}
+  ~PerfCounterScope() {
+    if (m_start != 0) {
+      detail::RecordPerfCounter(m_type, PerfCounterTime() - m_start);
+    }
+  }
+
+  PerfCounterScope(const PerfCounterScope&) = delete;
+  PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+
+ private:
+  HAL_PerfCounterType m_type;
+  uint64_t m_start;
+};
+
+// Counts one event with no time, when counting is enabled
+inline void CountPerfEvent(HAL_PerfCounterType type) {
+  if (PerfCountersEnabled()) detail::RecordPerfCounter(type, 0);
+}
+
+// Adds a sample in nanoseconds to a counter, when counting is enabled
+inline void RecordPerfSample(HAL_PerfCounterType type, uint64_t time) {
+  if (PerfCountersEnabled()) detail::RecordPerfCounter(type, time);
+}
+
+}  // namespace hal
@@ -0,0 +1,105 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "HAL/Counter.h"
+
+namespace hal {
+
+/**
+ * Keeps the period (rising edge to rising edge) and pulse width (rising edge
+ * to falling edge) of the latest pulses of a signal, built from its edge
+ * timestamps. A pulse missing an edge is dropped rather than measured across
+ * the gap.
+ */
+class PulseStatistics {
+ public:
+  explicit PulseStatistics(size_t windowSize)
+      : m_periods(windowSize), m_widths(windowSize) {}
+
+  void AddEdge(double timestamp, bool rising) {
+    if (rising) {
+      if (m_haveRising && m_haveFalling) {
+        m_periods[m_next] = timestamp - m_rising;
+        m_widths[m_next] = m_falling - m_rising;
+        m_next = (m_next + 1) % m_periods.size();
+        if (m_size < m_periods.size()) m_size++;
+      }
+      m_rising = timestamp;
+      m_haveRising = true;
+      m_haveFalling = false;
+    } else if (m_haveRising && !m_haveFalling) {
+      m_falling = timestamp;
+      m_haveFalling = true;
+    } else {
+      // Two falling edges in a row; the rising edge between them was missed
+      m_haveRising = false;
+    }
+  }
+
+  void GetStatistics(HAL_CounterPulseStatistics* stats) const {
+    stats->count = m_size;
+    Summarize(m_periods, &stats->periodMin, &stats->periodMax,
+              &stats->periodMean, &stats->periodJitter);
+    Summarize(m_widths, &stats->widthMin, &stats->widthMax, &stats->widthMean,
+              &stats->widthJitter);
+    stats->frequency = m_size > 0 ? 1.0 / stats->periodMean : 0.0;
+    stats->dutyCycle = m_size > 0 ? stats->widthMean / stats->periodMean : 0.0;
+  }
+
+  // Values outside of [min, max) are counted in the first or last bin
+  int32_t GetHistogram(bool widths, double min, double max, int32_t* bins,
+                       int32_t binCount) const {
+    const auto& values = widths ? m_widths : m_periods;
+    std::fill(bins, bins + binCount, 0);
+    for (size_t i = 0; i < m_size; i++) {
+      auto bin = static_cast<int32_t>(
+          std::floor((values[i] - min) / (max - min) * binCount));
+      bins[std::min(std::max(bin, 0), binCount - 1)]++;
+    }
+    return m_size;
+  }
+
+ private:
+  void Summarize(const std::vector<double>& values, double* min, double* max,
+                 double* mean, double* jitter) const {
+    *min = *max = *mean = *jitter = 0.0;
+    if (m_size == 0) return;
+    *min = *max = values[0];
+    double sum = 0.0;
+    for (size_t i = 0; i < m_size; i++) {
+      *min = std::min(*min, values[i]);
+      *max = std::max(*max, values[i]);
+      sum += values[i];
+    }
+    *mean = sum / m_size;
+    double variance = 0.0;
+    for (size_t i = 0; i < m_size; i++) {
+      variance += (values[i] - *mean) * (values[i] - *mean);
+    }
+    *jitter = std::sqrt(variance / m_size);
+  }
+
+  std::vector<double> m_periods;
+  std::vector<double> m_widths;
+  size_t m_next = 0;
+  size_t m_size = 0;
+
+  double m_rising = 0.0;
+  double m_falling = 0.0;
+  bool m_haveRising = false;
+  bool m_haveFalling = false;
+};
+
+}  // namespace hal
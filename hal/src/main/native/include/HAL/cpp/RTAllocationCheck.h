@@ -0,0 +1,55 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+/*
+ * Replaces the global operator new and delete with versions that report heap
+ * allocations made from registered real-time threads (see HAL/cpp/RTMemory.h).
+ *
+ * This is a debugging aid: include it in exactly one source file of the robot
+ * program, and only in builds where the check is wanted.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "HAL/cpp/RTMemory.h"
+
+void* operator new(size_t size) {
+  hal::CheckRTAllocation(size);
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  hal::CheckRTAllocation(size);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
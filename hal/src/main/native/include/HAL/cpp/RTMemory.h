@@ -0,0 +1,66 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <atomic>
+
+namespace hal {
+
+/**
+ * Called with the size of a heap allocation made from a registered real-time
+ * thread. The handler runs on that thread; allocations it makes itself are not
+ * reported.
+ */
+using RTAllocationHandler = void (*)(size_t size);
+
+namespace detail {
+inline bool& RTThreadFlag() {
+  static thread_local bool isRTThread = false;
+  return isRTThread;
+}
+
+inline std::atomic<RTAllocationHandler>& RTAllocationHandlerStorage() {
+  static std::atomic<RTAllocationHandler> handler{nullptr};
+  return handler;
+}
+}  // namespace detail
+
+/**
+ * Mark the current thread as real-time, so heap allocations made from it are
+ * reported to the RTAllocationHandler.
+ *
+ * Allocations are only seen when one source file of the program includes
+ * HAL/cpp/RTAllocationCheck.h.
+ */
+inline void RegisterRTThread() { detail::RTThreadFlag() = true; }
+
+inline void UnregisterRTThread() { detail::RTThreadFlag() = false; }
+
+inline bool IsRTThread() { return detail::RTThreadFlag(); }
+
+inline void SetRTAllocationHandler(RTAllocationHandler handler) {
+  detail::RTAllocationHandlerStorage().store(handler);
+}
+
+/**
+ * Report a heap allocation if the current thread is a registered real-time
+ * thread. Called by the operator new of HAL/cpp/RTAllocationCheck.h.
+ */
+inline void CheckRTAllocation(size_t size) {
+  bool& isRTThread = detail::RTThreadFlag();
+  if (!isRTThread) return;
+  auto handler = detail::RTAllocationHandlerStorage().load();
+  if (handler == nullptr) return;
+  isRTThread = false;
+  handler(size);
+  isRTThread = true;
+}
+
+}  // namespace hal
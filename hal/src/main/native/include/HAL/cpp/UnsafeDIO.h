@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include <support/mutex.h>
 
 #include "HAL/ChipObject.h"
@@ -43,6 +45,8 @@ struct DIOSetProxy {
 };
 namespace detail {
 wpi::mutex& UnsafeGetDIOMutex();
+wpi::mutex& UnsafeGetDIOOutputEnableMutex();
+void UnsafeSyncDIO(int32_t mask, int32_t* status);
 tDIO* UnsafeGetDigialSystem();
 int32_t ComputeDigitalMask(HAL_DigitalHandle handle, int32_t* status);
 }  // namespace detail
@@ -50,7 +54,7 @@ int32_t ComputeDigitalMask(HAL_DigitalHandle handle, int32_t* status);
 /**
  * Unsafe digital output set function
  * This function can be used to perform fast and determinstically set digital
- * outputs. This function holds the DIO lock, so calling anyting other then
+ * outputs. This function holds the DIO locks, so calling anyting other then
  * functions on the Proxy object passed as a parameter can deadlock your
  * program.
  *
@@ -66,20 +70,29 @@ void UnsafeManipulateDIO(HAL_DigitalHandle handle, int32_t* status,
   wpi::mutex& dioMutex = detail::UnsafeGetDIOMutex();
   tDIO* dSys = detail::UnsafeGetDigialSystem();
   auto mask = detail::ComputeDigitalMask(handle, status);
-  if (status != 0) return;
-  std::lock_guard<wpi::mutex> lock(dioMutex);
+  if (*status != 0) return;
+  {
+    wpi::mutex& outputEnableMutex = detail::UnsafeGetDIOOutputEnableMutex();
+    std::lock(outputEnableMutex, dioMutex);
+    std::lock_guard<wpi::mutex> outputEnableLock(outputEnableMutex,
+                                                 std::adopt_lock);
+    std::lock_guard<wpi::mutex> lock(dioMutex, std::adopt_lock);
 
-  tDIO::tOutputEnable enableOE = dSys->readOutputEnable(status);
-  enableOE.value |= mask;
-  auto disableOE = enableOE;
-  disableOE.value &= ~mask;
-  tDIO::tDO enableDO = dSys->readDO(status);
-  enableDO.value |= mask;
-  auto disableDO = enableDO;
-  disableDO.value &= ~mask;
+    tDIO::tOutputEnable enableOE = dSys->readOutputEnable(status);
+    enableOE.value |= mask;
+    auto disableOE = enableOE;
+    disableOE.value &= ~mask;
+    tDIO::tDO enableDO = dSys->readDO(status);
+    enableDO.value |= mask;
+    auto disableDO = enableDO;
+    disableDO.value &= ~mask;
 
-  DIOSetProxy dioData{enableOE, disableOE, enableDO, disableDO, dSys};
-  func(dioData);
+    DIOSetProxy dioData{enableOE, disableOE, enableDO, disableDO, dSys};
+    func(dioData);
+  }
+  // The other channels' outputs are shadowed in the HAL, so it must learn the
+  // state the functor left
+  detail::UnsafeSyncDIO(mask, status);
 }
 
 }  // namespace hal
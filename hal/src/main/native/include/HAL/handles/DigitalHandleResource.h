@@ -10,12 +10,15 @@
 #include <stdint.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <utility>
 
 #include <support/mutex.h>
 
 #include "HAL/Errors.h"
 #include "HAL/Types.h"
+#include "HAL/cpp/MemoryPool.h"
 #include "HAL/cpp/make_unique.h"
 #include "HAL/handles/HandlesInternal.h"
 
@@ -44,11 +47,20 @@ class DigitalHandleResource : public HandleBase {
 
   THandle Allocate(int16_t index, HAL_HandleEnum enumValue, int32_t* status);
   std::shared_ptr<TStruct> Get(THandle handle, HAL_HandleEnum enumValue);
+  /* Returns the structure without taking a lock or touching the reference
+   * count. If the handle is freed while borrowed, the structure is destroyed
+   * once the returned Borrowed is, so hold it only for the length of a call.
+   */
+  Borrowed<TStruct> GetBorrowed(THandle handle, HAL_HandleEnum enumValue);
   void Free(THandle handle, HAL_HandleEnum enumValue);
   void ResetHandles() override;
 
  private:
+  // Preallocated storage for the structures, declared first to outlive them
+  MemoryPool m_pool{SharedBlockSize<TStruct>(), size};
   std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<std::atomic<TStruct*>, size> m_borrowed{};
+  BorrowTracker m_tracker;
   std::array<wpi::mutex, size> m_handleMutexes;
 };
 
@@ -66,7 +78,8 @@ THandle DigitalHandleResource<THandle, TStruct, size>::Allocate(
     *status = RESOURCE_IS_ALLOCATED;
     return HAL_kInvalidHandle;
   }
-  m_structures[index] = std::make_shared<TStruct>();
+  m_structures[index] = MakePooled<TStruct>(m_pool);
+  m_borrowed[index].store(m_structures[index].get(), std::memory_order_release);
   return static_cast<THandle>(hal::createHandle(index, enumValue, m_version));
 }
 
@@ -84,6 +97,17 @@ std::shared_ptr<TStruct> DigitalHandleResource<THandle, TStruct, size>::Get(
   return m_structures[index];
 }
 
+template <typename THandle, typename TStruct, int16_t size>
+Borrowed<TStruct> DigitalHandleResource<THandle, TStruct, size>::GetBorrowed(
+    THandle handle, HAL_HandleEnum enumValue) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = getHandleTypedIndex(handle, enumValue, m_version);
+  if (index < 0 || index >= size) {
+    return Borrowed<TStruct>();
+  }
+  return Borrowed<TStruct>(m_tracker, m_borrowed[index]);
+}
+
 template <typename THandle, typename TStruct, int16_t size>
 void DigitalHandleResource<THandle, TStruct, size>::Free(
     THandle handle, HAL_HandleEnum enumValue) {
@@ -92,14 +116,16 @@ void DigitalHandleResource<THandle, TStruct, size>::Free(
   if (index < 0 || index >= size) return;
   // lock and deallocated handle
   std::lock_guard<wpi::mutex> lock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_borrowed[index].store(nullptr);
+  m_tracker.Retire(std::move(m_structures[index]));
 }
 
 template <typename THandle, typename TStruct, int16_t size>
 void DigitalHandleResource<THandle, TStruct, size>::ResetHandles() {
   for (int i = 0; i < size; i++) {
     std::lock_guard<wpi::mutex> lock(m_handleMutexes[i]);
-    m_structures[i].reset();
+    m_borrowed[i].store(nullptr);
+    m_tracker.Retire(std::move(m_structures[i]));
   }
   HandleBase::ResetHandles();
 }
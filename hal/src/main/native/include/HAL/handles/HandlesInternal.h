@@ -9,7 +9,11 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <cstddef>
+
 #include "HAL/Types.h"
+#include "HAL/cpp/BorrowTracker.h"
 
 /* General Handle Data Layout
  * Bits 0-15:  Handle Index
@@ -26,14 +30,63 @@ namespace hal {
 class HandleBase {
  public:
   HandleBase();
-  ~HandleBase();
+  virtual ~HandleBase();
   HandleBase(const HandleBase&) = delete;
   HandleBase& operator=(const HandleBase&) = delete;
   virtual void ResetHandles();
   static void ResetGlobalHandles();
 
  protected:
-  int16_t m_version;
+  int16_t m_version = 0;
+};
+
+/**
+ * A structure borrowed from a handle resource, which stays alive until this is
+ * destroyed even if its handle is freed. It is meant to be held for the length
+ * of one HAL call.
+ */
+template <typename TStruct>
+class Borrowed {
+ public:
+  Borrowed() = default;
+  Borrowed(BorrowTracker& tracker, const std::atomic<TStruct*>& structure)
+      : m_tracker(&tracker) {
+    tracker.Enter();
+    m_structure = structure.load();
+  }
+  Borrowed(Borrowed&& other)
+      : m_tracker(other.m_tracker), m_structure(other.m_structure) {
+    other.m_tracker = nullptr;
+  }
+  ~Borrowed() {
+    if (m_tracker) m_tracker->Exit();
+  }
+
+  Borrowed(const Borrowed&) = delete;
+  Borrowed& operator=(const Borrowed&) = delete;
+  Borrowed& operator=(Borrowed&&) = delete;
+
+  TStruct* get() const { return m_structure; }
+  TStruct& operator*() const { return *m_structure; }
+  TStruct* operator->() const { return m_structure; }
+  explicit operator bool() const { return m_structure != nullptr; }
+
+  friend bool operator==(const Borrowed& lhs, std::nullptr_t) {
+    return lhs.m_structure == nullptr;
+  }
+  friend bool operator!=(const Borrowed& lhs, std::nullptr_t) {
+    return lhs.m_structure != nullptr;
+  }
+  friend bool operator==(std::nullptr_t, const Borrowed& rhs) {
+    return rhs.m_structure == nullptr;
+  }
+  friend bool operator!=(std::nullptr_t, const Borrowed& rhs) {
+    return rhs.m_structure != nullptr;
+  }
+
+ private:
+  BorrowTracker* m_tracker = nullptr;
+  TStruct* m_structure = nullptr;
 };
 
 constexpr int16_t InvalidHandleIndex = -1;
@@ -56,7 +109,8 @@ enum class HAL_HandleEnum {
   Compressor = 14,
   Solenoid = 15,
   AnalogGyro = 16,
-  Vendor = 17
+  Vendor = 17,
+  DMA = 18
 };
 
 static inline int16_t getHandleIndex(HAL_Handle handle) {
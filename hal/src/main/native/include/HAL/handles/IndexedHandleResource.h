@@ -10,12 +10,15 @@
 #include <stdint.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <utility>
 
 #include <support/mutex.h>
 
 #include "HAL/Errors.h"
 #include "HAL/Types.h"
+#include "HAL/cpp/MemoryPool.h"
 #include "HAL/cpp/make_unique.h"
 #include "HAL/handles/HandlesInternal.h"
 
@@ -45,11 +48,20 @@ class IndexedHandleResource : public HandleBase {
 
   THandle Allocate(int16_t index, int32_t* status);
   std::shared_ptr<TStruct> Get(THandle handle);
+  /* Returns the structure without taking a lock or touching the reference
+   * count. If the handle is freed while borrowed, the structure is destroyed
+   * once the returned Borrowed is, so hold it only for the length of a call.
+   */
+  Borrowed<TStruct> GetBorrowed(THandle handle);
   void Free(THandle handle);
   void ResetHandles() override;
 
  private:
+  // Preallocated storage for the structures, declared first to outlive them
+  MemoryPool m_pool{SharedBlockSize<TStruct>(), size};
   std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<std::atomic<TStruct*>, size> m_borrowed{};
+  BorrowTracker m_tracker;
   std::array<wpi::mutex, size> m_handleMutexes;
 };
 
@@ -68,7 +80,8 @@ THandle IndexedHandleResource<THandle, TStruct, size, enumValue>::Allocate(
     *status = RESOURCE_IS_ALLOCATED;
     return HAL_kInvalidHandle;
   }
-  m_structures[index] = std::make_shared<TStruct>();
+  m_structures[index] = MakePooled<TStruct>(m_pool);
+  m_borrowed[index].store(m_structures[index].get(), std::memory_order_release);
   return static_cast<THandle>(hal::createHandle(index, enumValue, m_version));
 }
 
@@ -87,6 +100,19 @@ IndexedHandleResource<THandle, TStruct, size, enumValue>::Get(THandle handle) {
   return m_structures[index];
 }
 
+template <typename THandle, typename TStruct, int16_t size,
+          HAL_HandleEnum enumValue>
+Borrowed<TStruct>
+IndexedHandleResource<THandle, TStruct, size, enumValue>::GetBorrowed(
+    THandle handle) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = getHandleTypedIndex(handle, enumValue, m_version);
+  if (index < 0 || index >= size) {
+    return Borrowed<TStruct>();
+  }
+  return Borrowed<TStruct>(m_tracker, m_borrowed[index]);
+}
+
 template <typename THandle, typename TStruct, int16_t size,
           HAL_HandleEnum enumValue>
 void IndexedHandleResource<THandle, TStruct, size, enumValue>::Free(
@@ -96,7 +122,8 @@ void IndexedHandleResource<THandle, TStruct, size, enumValue>::Free(
   if (index < 0 || index >= size) return;
   // lock and deallocated handle
   std::lock_guard<wpi::mutex> lock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_borrowed[index].store(nullptr);
+  m_tracker.Retire(std::move(m_structures[index]));
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -104,7 +131,8 @@ template <typename THandle, typename TStruct, int16_t size,
 void IndexedHandleResource<THandle, TStruct, size, enumValue>::ResetHandles() {
   for (int i = 0; i < size; i++) {
     std::lock_guard<wpi::mutex> lock(m_handleMutexes[i]);
-    m_structures[i].reset();
+    m_borrowed[i].store(nullptr);
+    m_tracker.Retire(std::move(m_structures[i]));
   }
   HandleBase::ResetHandles();
 }
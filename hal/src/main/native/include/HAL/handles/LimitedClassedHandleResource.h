@@ -10,7 +10,9 @@
 #include <stdint.h>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <utility>
 
 #include <support/mutex.h>
 
@@ -44,11 +46,18 @@ class LimitedClassedHandleResource : public HandleBase {
 
   THandle Allocate(std::shared_ptr<TStruct> toSet);
   std::shared_ptr<TStruct> Get(THandle handle);
+  /* Returns the structure without taking a lock or touching the reference
+   * count. If the handle is freed while borrowed, the structure is destroyed
+   * once the returned Borrowed is, so hold it only for the length of a call.
+   */
+  Borrowed<TStruct> GetBorrowed(THandle handle);
   void Free(THandle handle);
   void ResetHandles() override;
 
  private:
   std::array<std::shared_ptr<TStruct>, size> m_structures;
+  std::array<std::atomic<TStruct*>, size> m_borrowed{};
+  BorrowTracker m_tracker;
   std::array<wpi::mutex, size> m_handleMutexes;
   wpi::mutex m_allocateMutex;
 };
@@ -66,6 +75,7 @@ LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::Allocate(
       // and allocate it.
       std::lock_guard<wpi::mutex> lock(m_handleMutexes[i]);
       m_structures[i] = toSet;
+      m_borrowed[i].store(m_structures[i].get(), std::memory_order_release);
       return static_cast<THandle>(createHandle(i, enumValue, m_version));
     }
   }
@@ -88,6 +98,19 @@ LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::Get(
   return m_structures[index];
 }
 
+template <typename THandle, typename TStruct, int16_t size,
+          HAL_HandleEnum enumValue>
+Borrowed<TStruct>
+LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::GetBorrowed(
+    THandle handle) {
+  // get handle index, and fail early if index out of range or wrong handle
+  int16_t index = getHandleTypedIndex(handle, enumValue, m_version);
+  if (index < 0 || index >= size) {
+    return Borrowed<TStruct>();
+  }
+  return Borrowed<TStruct>(m_tracker, m_borrowed[index]);
+}
+
 template <typename THandle, typename TStruct, int16_t size,
           HAL_HandleEnum enumValue>
 void LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::Free(
@@ -98,7 +121,8 @@ void LimitedClassedHandleResource<THandle, TStruct, size, enumValue>::Free(
   // lock and deallocated handle
   std::lock_guard<wpi::mutex> allocateLock(m_allocateMutex);
   std::lock_guard<wpi::mutex> handleLock(m_handleMutexes[index]);
-  m_structures[index].reset();
+  m_borrowed[index].store(nullptr);
+  m_tracker.Retire(std::move(m_structures[index]));
 }
 
 template <typename THandle, typename TStruct, int16_t size,
@@ -109,7 +133,8 @@ void LimitedClassedHandleResource<THandle, TStruct, size,
     std::lock_guard<wpi::mutex> allocateLock(m_allocateMutex);
     for (int i = 0; i < size; i++) {
       std::lock_guard<wpi::mutex> handleLock(m_handleMutexes[i]);
-      m_structures[i].reset();
+      m_borrowed[i].store(nullptr);
+      m_tracker.Retire(std::move(m_structures[i]));
     }
   }
   HandleBase::ResetHandles();
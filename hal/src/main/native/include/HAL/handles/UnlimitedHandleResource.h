@@ -27,7 +27,8 @@ namespace hal {
  * down.
  * However, automatic array management has not been implemented, but might be in
  * the future.
- * Because we have to loop through the allocator, we must use a global mutex.
+ * Freed indices are kept in a free list, so allocation does not need to scan
+ * the array. A global mutex still protects the array and the free list.
 
  * @tparam THandle The Handle Type (Must be typedefed from HAL_Handle)
  * @tparam TStruct The struct type held by this resource
@@ -55,8 +56,24 @@ class UnlimitedHandleResource : public HandleBase {
   template <typename Functor>
   void ForEach(Functor func);
 
+  /* Calls func(THandle, TStruct*) for each handle allocated at the time of
+   * the call. The global lock is only held long enough to grab a snapshot,
+   * which is rebuilt only when handles have been allocated or freed since
+   * the previous call. Structures freed during iteration are kept alive
+   * until it completes; the cached snapshot is dropped by Free, so it never
+   * keeps a freed structure alive beyond that.
+   */
+  template <typename Functor>
+  void ForEachSnapshot(Functor func);
+
  private:
+  using Snapshot = std::vector<std::pair<THandle, std::shared_ptr<TStruct>>>;
+
   std::vector<std::shared_ptr<TStruct>> m_structures;
+  std::vector<int16_t> m_freeIndices;
+  std::shared_ptr<const Snapshot> m_snapshot;
+  uint64_t m_generation = 0;
+  uint64_t m_snapshotGeneration = 0;
   wpi::mutex m_handleMutex;
 };
 
@@ -64,18 +81,18 @@ template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 THandle UnlimitedHandleResource<THandle, TStruct, enumValue>::Allocate(
     std::shared_ptr<TStruct> structure) {
   std::lock_guard<wpi::mutex> lock(m_handleMutex);
-  size_t i;
-  for (i = 0; i < m_structures.size(); i++) {
-    if (m_structures[i] == nullptr) {
-      m_structures[i] = structure;
-      return static_cast<THandle>(createHandle(i, enumValue, m_version));
-    }
+  int16_t i;
+  if (!m_freeIndices.empty()) {
+    i = m_freeIndices.back();
+    m_freeIndices.pop_back();
+    m_structures[i] = std::move(structure);
+  } else {
+    if (m_structures.size() >= INT16_MAX) return HAL_kInvalidHandle;
+    i = static_cast<int16_t>(m_structures.size());
+    m_structures.push_back(std::move(structure));
   }
-  if (i >= INT16_MAX) return HAL_kInvalidHandle;
-
-  m_structures.push_back(structure);
-  return static_cast<THandle>(
-      createHandle(static_cast<int16_t>(i), enumValue, m_version));
+  m_generation++;
+  return static_cast<THandle>(createHandle(i, enumValue, m_version));
 }
 
 template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
@@ -95,6 +112,11 @@ UnlimitedHandleResource<THandle, TStruct, enumValue>::Free(THandle handle) {
   std::lock_guard<wpi::mutex> lock(m_handleMutex);
   if (index < 0 || index >= static_cast<int16_t>(m_structures.size()))
     return nullptr;
+  if (m_structures[index] == nullptr) return nullptr;
+  m_freeIndices.push_back(index);
+  m_generation++;
+  // drop the cached snapshot so it doesn't keep the structure alive
+  m_snapshot.reset();
   return std::move(m_structures[index]);
 }
 
@@ -102,9 +124,14 @@ template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
 void UnlimitedHandleResource<THandle, TStruct, enumValue>::ResetHandles() {
   {
     std::lock_guard<wpi::mutex> lock(m_handleMutex);
-    for (size_t i = 0; i < m_structures.size(); i++) {
-      m_structures[i].reset();
+    m_freeIndices.clear();
+    // push in reverse so the lowest indices are reused first
+    for (size_t i = m_structures.size(); i > 0; i--) {
+      m_structures[i - 1].reset();
+      m_freeIndices.push_back(static_cast<int16_t>(i - 1));
     }
+    m_snapshot.reset();
+    m_generation++;
   }
   HandleBase::ResetHandles();
 }
@@ -123,4 +150,30 @@ void UnlimitedHandleResource<THandle, TStruct, enumValue>::ForEach(
   }
 }
 
+template <typename THandle, typename TStruct, HAL_HandleEnum enumValue>
+template <typename Functor>
+void UnlimitedHandleResource<THandle, TStruct, enumValue>::ForEachSnapshot(
+    Functor func) {
+  std::shared_ptr<const Snapshot> snapshot;
+  {
+    std::lock_guard<wpi::mutex> lock(m_handleMutex);
+    if (!m_snapshot || m_snapshotGeneration != m_generation) {
+      auto newSnapshot = std::make_shared<Snapshot>();
+      for (size_t i = 0; i < m_structures.size(); i++) {
+        if (m_structures[i] != nullptr) {
+          newSnapshot->emplace_back(
+              static_cast<THandle>(createHandle(i, enumValue, m_version)),
+              m_structures[i]);
+        }
+      }
+      m_snapshot = std::move(newSnapshot);
+      m_snapshotGeneration = m_generation;
+    }
+    snapshot = m_snapshot;
+  }
+  for (auto&& entry : *snapshot) {
+    func(entry.first, entry.second.get());
+  }
+}
+
 }  // namespace hal
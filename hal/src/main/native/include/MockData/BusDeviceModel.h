@@ -0,0 +1,116 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#ifndef __FRC_ROBORIO__
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include <support/mutex.h>
+
+namespace hal {
+
+/**
+ * A simulated device on an SPI chip select or an I2C address.
+ *
+ * A model registered with SetSPIDeviceModel() or SetI2CDeviceModel() is
+ * called directly with every transfer to its device, instead of through the
+ * buffer callbacks, which still run after it. On SPI, the model also serves
+ * the auto transfers started with HAL_StartSPIAutoRate(), at the configured
+ * rate in simulated time.
+ *
+ * Models are called from the threads making the transfers.
+ */
+class BusDeviceModel {
+ public:
+  virtual ~BusDeviceModel() = default;
+
+  // The program writes data to the device
+  virtual void Write(const uint8_t* data, int32_t size) {}
+  // The program reads size bytes from the device
+  virtual void Read(uint8_t* buffer, int32_t size);
+  // A full duplex SPI transfer; by default a Write followed by a Read
+  virtual void Transaction(const uint8_t* dataToSend, uint8_t* dataReceived,
+                           int32_t size);
+};
+
+/**
+ * A device model that is a file of 8-bit registers, the way most SPI and I2C
+ * sensors work.
+ *
+ * The first byte of each write is a register address, and the bytes after it
+ * are written to consecutive registers. Reads return consecutive registers
+ * from the last address written. On SPI, the first byte of a transaction is
+ * the address, with readFlag set to read: the byte received with it is 0 and
+ * the following bytes are the registers.
+ *
+ * Subclasses emulate the device by overriding OnRead() to update registers
+ * before they are read, and OnWrite() to act on registers the program writes.
+ */
+class RegisterMapDeviceModel : public BusDeviceModel {
+ public:
+  /**
+   * @param size        The number of registers.
+   * @param readFlag    The bits of an SPI address byte that mark a read, or 0
+   *                    if a transaction both writes and reads.
+   * @param addressMask The bits of an address byte that are the address.
+   */
+  explicit RegisterMapDeviceModel(int32_t size = 256, uint8_t readFlag = 0,
+                                  uint8_t addressMask = 0xff);
+
+  uint8_t GetRegister(int32_t address) const;
+  void SetRegister(int32_t address, uint8_t value);
+  void GetRegisters(int32_t address, uint8_t* data, int32_t count) const;
+  void SetRegisters(int32_t address, const uint8_t* data, int32_t count);
+
+  void Write(const uint8_t* data, int32_t size) override;
+  void Read(uint8_t* buffer, int32_t size) override;
+  void Transaction(const uint8_t* dataToSend, uint8_t* dataReceived,
+                   int32_t size) override;
+
+ protected:
+  // Called before count registers are read, without the lock held
+  virtual void OnRead(int32_t address, int32_t count) {}
+  // Called after the program wrote count registers, without the lock held
+  virtual void OnWrite(int32_t address, int32_t count) {}
+
+ private:
+  void WriteRegisters(int32_t address, const uint8_t* data, int32_t count);
+  void ReadRegisters(int32_t address, uint8_t* data, int32_t count);
+
+  mutable wpi::mutex m_mutex;
+  std::vector<uint8_t> m_registers;
+  // the register reads start at; accesses past the end wrap around
+  int32_t m_address = 0;
+  const uint8_t m_readFlag;
+  const uint8_t m_addressMask;
+};
+
+/**
+ * Registers the model of the device on an SPI port (a chip select), or
+ * removes it if model is null. The model is kept until it is replaced or the
+ * port's data is reset.
+ */
+void SetSPIDeviceModel(int32_t port, std::shared_ptr<BusDeviceModel> model);
+std::shared_ptr<BusDeviceModel> GetSPIDeviceModel(int32_t port);
+
+/**
+ * Registers the model of the device at a 7-bit I2C address, or removes it if
+ * model is null.
+ */
+void SetI2CDeviceModel(int32_t port, int32_t address,
+                       std::shared_ptr<BusDeviceModel> model);
+std::shared_ptr<BusDeviceModel> GetI2CDeviceModel(int32_t port,
+                                                  int32_t address);
+
+}  // namespace hal
+
+#endif
@@ -0,0 +1,58 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#ifndef __FRC_ROBORIO__
+
+#include <stdint.h>
+
+#include "HAL/Types.h"
+
+/**
+ * Identifies a single simulated value that changed. The device and field
+ * strings are static names (e.g. "Encoder" and "Count"; the field matches the
+ * name passed to the per-field callback) and remain valid for the life of the
+ * program. channel is the sub-channel of the device (e.g. the solenoid of a
+ * PCM), or -1 if the field is not per-channel.
+ */
+struct HALSIM_Change {
+  const char* device;
+  int32_t index;
+  int32_t channel;
+  const char* field;
+};
+
+typedef void (*HAL_ChangeBatchCallback)(const char* name, void* param,
+                                        const struct HALSIM_Change* changes,
+                                        int32_t count);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Registers a callback that receives every simulated value change as one
+ * batch per robot loop, instead of one call per field. While any batch
+ * callback is registered, changes are collected into a dirty set (each
+ * changed field appears once per batch) and delivered when the DS sends new
+ * data, after each step of HALSIM_StepTiming(), or on HALSIM_FlushChanges().
+ */
+int32_t HALSIM_RegisterChangeBatchCallback(HAL_ChangeBatchCallback callback,
+                                           void* param);
+void HALSIM_CancelChangeBatchCallback(int32_t uid);
+
+/**
+ * Delivers all collected changes to the batch callbacks immediately.
+ */
+void HALSIM_FlushChanges(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif
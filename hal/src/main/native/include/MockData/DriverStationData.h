@@ -13,6 +13,20 @@
 #include "HAL/HAL.h"
 #include "NotifyListener.h"
 
+#define HALSIM_kNumJoysticks 6
+
+/**
+ * The driver station state that changes from one packet to the next.
+ */
+struct HALSIM_DSPacket {
+  HAL_ControlWord controlWord;
+  HAL_AllianceStationID allianceStationId;
+  double matchTime;
+  HAL_JoystickAxes axes[HALSIM_kNumJoysticks];
+  HAL_JoystickPOVs povs[HALSIM_kNumJoysticks];
+  HAL_JoystickButtons buttons[HALSIM_kNumJoysticks];
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -82,6 +96,14 @@ void HALSIM_GetJoystickOutputs(int32_t joystickNum, int64_t* outputs,
 
 void HALSIM_SetMatchInfo(const HAL_MatchInfo* info);
 
+/**
+ * Applies a whole driver station packet at once, then notifies new data once,
+ * as HALSIM_NotifyDriverStationNewData() does. A read of the control word
+ * never mixes two packets, and the callbacks of the values that changed are
+ * only called once all of the packet is applied.
+ */
+void HALSIM_SetDriverStationPacket(const HALSIM_DSPacket* packet);
+
 void HALSIM_RegisterDriverStationAllCallbacks(HAL_NotifyCallback callback,
                                               void* param,
                                               HAL_Bool initialNotify);
@@ -33,6 +33,17 @@ void HALSIM_CancelEncoderCountCallback(int32_t index, int32_t uid);
 int32_t HALSIM_GetEncoderCount(int32_t index);
 void HALSIM_SetEncoderCount(int32_t index, int32_t count);
 
+/**
+ * Copies the counts of the first count encoders, which are stored together so
+ * a physics model can read them all at once. Returns the number copied.
+ */
+int32_t HALSIM_GetAllEncoderCounts(int32_t* counts, int32_t count);
+/**
+ * Sets the counts of the first count encoders, firing the callbacks of each
+ * one that changes.
+ */
+void HALSIM_SetAllEncoderCounts(const int32_t* counts, int32_t count);
+
 int32_t HALSIM_RegisterEncoderPeriodCallback(int32_t index,
                                              HAL_NotifyCallback callback,
                                              void* param,
@@ -80,6 +91,20 @@ void HALSIM_CancelEncoderSamplesToAverageCallback(int32_t index, int32_t uid);
 int32_t HALSIM_GetEncoderSamplesToAverage(int32_t index);
 void HALSIM_SetEncoderSamplesToAverage(int32_t index, int32_t samplesToAverage);
 
+/**
+ * Returns the DIO channel of an encoder's A or B source, or -1 if the source
+ * is not a DIO (such as an analog trigger). The channels are set before the
+ * encoder becomes initialized, so an Initialized callback can read them.
+ */
+int32_t HALSIM_GetEncoderDigitalChannelA(int32_t index);
+int32_t HALSIM_GetEncoderDigitalChannelB(int32_t index);
+
+/**
+ * Returns the index of the initialized encoder with a source on the DIO
+ * channel, or -1 if there is none.
+ */
+int32_t HALSIM_FindEncoderForChannel(int32_t channel);
+
 void HALSIM_RegisterEncoderAllCallbacks(int32_t index,
                                         HAL_NotifyCallback callback,
                                         void* param, HAL_Bool initialNotify);
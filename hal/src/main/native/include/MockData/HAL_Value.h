@@ -68,4 +68,27 @@ inline HAL_Value MakeDouble(double v) {
   return value;
 }
 
+/**
+ * Returns whether two values have the same type and value, comparing them in
+ * place.
+ */
+inline HAL_Bool ValuesEqual(const struct HAL_Value* a,
+                            const struct HAL_Value* b) {
+  if (a->type != b->type) return 0;
+  switch (a->type) {
+    case HAL_BOOLEAN:
+      return a->data.v_boolean == b->data.v_boolean;
+    case HAL_DOUBLE:
+      return a->data.v_double == b->data.v_double;
+    case HAL_ENUM:
+      return a->data.v_enum == b->data.v_enum;
+    case HAL_INT:
+      return a->data.v_int == b->data.v_int;
+    case HAL_LONG:
+      return a->data.v_long == b->data.v_long;
+    default:
+      return 1;
+  }
+}
+
 #endif
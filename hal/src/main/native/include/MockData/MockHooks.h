@@ -9,10 +9,62 @@
 
 #ifndef __FRC_ROBORIO__
 
+#include <stdint.h>
+
+#include "HAL/Types.h"
+
 extern "C" {
 void HALSIM_WaitForProgramStart(void);
 void HALSIM_SetProgramStarted(void);
 void HALSIM_RestartTiming(void);
+
+/**
+ * Freezes simulated FPGA time. While paused, time only advances through
+ * HALSIM_StepTiming(), which makes simulations independent of host speed.
+ */
+void HALSIM_PauseTiming(void);
+void HALSIM_ResumeTiming(void);
+HAL_Bool HALSIM_IsTimingPaused(void);
+
+/**
+ * Advances simulated FPGA time by delta microseconds. While paused, time is
+ * advanced to each notifier deadline in turn, and the call returns once the
+ * handlers of every expired notifier have run. A DS new data event is also
+ * generated every 20 ms of simulated time. After each step the step callbacks
+ * of C++ extensions run (see HAL/SimExtension.h), then collected changes are
+ * flushed to the change batch callbacks.
+ */
+void HALSIM_StepTiming(uint64_t delta);
+
+/**
+ * Sets how fast simulated FPGA time runs relative to the wall clock while not
+ * paused (e.g. 10.0 runs ten times faster than real time).
+ */
+void HALSIM_SetTimingRate(double rate);
+
+/**
+ * Makes notifiers busy wait for the last microseconds of each alarm instead of
+ * sleeping, which trades CPU time for alarms serviced within a few
+ * microseconds of their deadline. Defaults to 0 (never busy wait).
+ */
+void HALSIM_SetNotifierSpinTime(uint64_t microseconds);
+
+/**
+ * Delivers interrupts on simulated time instead of immediately on the thread
+ * that changed the input. Each edge is delivered latency seconds, plus a
+ * uniformly distributed extra delay of up to jitter seconds, after the input
+ * changed; edges are never delivered out of order. The edge timestamps are
+ * those of the input changes. Waits for interrupts also time out on simulated
+ * time, so they can be stepped with HALSIM_StepTiming().
+ *
+ * @param seed seed of the jitter, so runs can be repeated
+ */
+void HALSIM_SetInterruptLatency(double latency, double jitter, uint32_t seed);
+
+/**
+ * Returns to delivering interrupts immediately.
+ */
+void HALSIM_ClearInterruptLatency(void);
 }  // extern "C"
 
 #endif
@@ -46,6 +46,10 @@ std::shared_ptr<hal::NotifyListenerVector> CancelCallback(
 void InvokeCallback(std::shared_ptr<hal::NotifyListenerVector> currentVector,
                     const char* name, const HAL_Value* value);
 
+void InvokeCallback(
+    const hal::AtomicListenerVector<hal::NotifyListenerVector>& currentVector,
+    const char* name, const HAL_Value* value);
+
 std::shared_ptr<hal::BufferListenerVector> RegisterCallback(
     std::shared_ptr<hal::BufferListenerVector> currentVector, const char* name,
     HAL_BufferCallback callback, void* param, int32_t* newUid);
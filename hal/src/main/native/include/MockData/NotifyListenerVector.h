@@ -9,10 +9,15 @@
 
 #ifndef __FRC_ROBORIO__
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <vector>
 
+#include <support/mutex.h>
+
+#include "HAL/cpp/BorrowTracker.h"
 #include "NotifyListener.h"
 
 namespace hal {
@@ -132,6 +137,73 @@ void HalCallbackListenerVectorImpl<ListenerType>::erase_impl(unsigned int uid) {
   m_vector[uid] = HalCallbackListener<ListenerType>();
 }
 
+// Holds the current version of a listener vector and publishes it through an
+// atomic pointer, so invoking callbacks does not touch a reference count or
+// take a lock. Callbacks are invoked through a Reader, which borrows the
+// current version. Replaced versions are retired to a BorrowTracker, since a
+// reader may still be iterating over them.
+template <typename VectorType>
+class AtomicListenerVector {
+ public:
+  // Borrows the current vector until destroyed
+  class Reader {
+   public:
+    explicit Reader(const AtomicListenerVector& holder)
+        : m_tracker(holder.m_tracker) {
+      m_tracker.Enter();
+      m_vector = holder.m_vector.load();
+    }
+    ~Reader() { m_tracker.Exit(); }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    VectorType* get() const { return m_vector; }
+    VectorType& operator*() const { return *m_vector; }
+    VectorType* operator->() const { return m_vector; }
+    explicit operator bool() const { return m_vector != nullptr; }
+
+   private:
+    BorrowTracker& m_tracker;
+    VectorType* m_vector;
+  };
+
+  AtomicListenerVector() = default;
+  AtomicListenerVector(const AtomicListenerVector&) = delete;
+  AtomicListenerVector& operator=(const AtomicListenerVector&) = delete;
+
+  AtomicListenerVector& operator=(std::shared_ptr<VectorType> vector) {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_vector.store(vector.get());
+    m_tracker.Retire(std::move(m_current));
+    m_current = std::move(vector);
+    return *this;
+  }
+
+  AtomicListenerVector& operator=(std::nullptr_t) {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_vector.store(nullptr);
+    m_tracker.Retire(std::move(m_current));
+    m_current = nullptr;
+    return *this;
+  }
+
+  // Returns an owning copy, for modifying the vector
+  operator std::shared_ptr<VectorType>() const {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    return m_current;
+  }
+
+  // Returns true if any listeners could be registered
+  explicit operator bool() const { return m_vector.load() != nullptr; }
+
+ private:
+  std::atomic<VectorType*> m_vector{nullptr};
+  mutable BorrowTracker m_tracker;
+  std::shared_ptr<VectorType> m_current;
+  mutable wpi::mutex m_mutex;
+};
+
 typedef HalCallbackListenerVectorImpl<HAL_NotifyCallback> NotifyListenerVector;
 typedef HalCallbackListenerVectorImpl<HAL_BufferCallback> BufferListenerVector;
 typedef HalCallbackListenerVectorImpl<HAL_ConstBufferCallback>
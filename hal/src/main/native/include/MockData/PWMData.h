@@ -39,6 +39,17 @@ void HALSIM_CancelPWMSpeedCallback(int32_t index, int32_t uid);
 double HALSIM_GetPWMSpeed(int32_t index);
 void HALSIM_SetPWMSpeed(int32_t index, double speed);
 
+/**
+ * Copies the speeds of the first count PWMs, which are stored together so a
+ * physics model can read them all at once. Returns the number copied.
+ */
+int32_t HALSIM_GetAllPWMSpeeds(double* speeds, int32_t count);
+/**
+ * Sets the speeds of the first count PWMs, firing the callbacks of each one
+ * that changes.
+ */
+void HALSIM_SetAllPWMSpeeds(const double* speeds, int32_t count);
+
 int32_t HALSIM_RegisterPWMPositionCallback(int32_t index,
                                            HAL_NotifyCallback callback,
                                            void* param, HAL_Bool initialNotify);
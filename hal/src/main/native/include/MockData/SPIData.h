@@ -42,6 +42,13 @@ int32_t HALSIM_RegisterSPIWriteCallback(int32_t index,
                                         void* param);
 void HALSIM_CancelSPIWriteCallback(int32_t index, int32_t uid);
 
+/**
+ * Registers a callback that serves HAL_ReadSPIAutoReceivedData() in place of
+ * the emulated auto transfer engine. Without one, auto transfers started with
+ * HAL_StartSPIAutoRate() are made at their rate on the simulated clock, each
+ * as a transaction seen by the read and write callbacks, into a buffer of the
+ * size given to HAL_InitSPIAuto().
+ */
 int32_t HALSIM_RegisterSPIReadAutoReceivedDataCallback(
     int32_t index, HAL_SpiReadAutoReceiveBufferCallback callback, void* param);
 void HALSIM_CancelSPIReadAutoReceivedDataCallback(int32_t index, int32_t uid);
@@ -0,0 +1,55 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#ifndef __FRC_ROBORIO__
+
+/**
+ * The state of one simulated robot: its device data, handles, notifiers and
+ * simulated time.
+ */
+struct HALSIM_Context;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Creates an independent simulated robot, with all of its state at the
+ * values HAL_Initialize() starts with and its own simulated time starting at
+ * zero. Contexts let many robots be simulated in parallel in one process;
+ * each thread selects the robot it acts on with HALSIM_SetThreadContext().
+ * HAL_Initialize() must have been called first.
+ */
+struct HALSIM_Context* HALSIM_CreateContext(void);
+
+/**
+ * Frees a context. No thread may still be using it; a thread that selected
+ * it must select another one first.
+ */
+void HALSIM_DestroyContext(struct HALSIM_Context* context);
+
+/**
+ * Selects the context the calling thread's HAL and HALSIM calls act on. A
+ * null context selects the default context, which every thread starts in.
+ * Threads started by the HAL on the thread's behalf (such as the interrupt
+ * scheduler) use the context that was selected when they were started;
+ * threads the program starts itself must select the context they use.
+ */
+void HALSIM_SetThreadContext(struct HALSIM_Context* context);
+
+/**
+ * Returns the context the calling thread uses.
+ */
+struct HALSIM_Context* HALSIM_GetThreadContext(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#ifndef __FRC_ROBORIO__
+
+#include <stdint.h>
+
+#include "HAL/Types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Returns the size in bytes of a saved simulation state.
+ */
+int32_t HALSIM_GetStateSize(void);
+
+/**
+ * Saves the value of every simulated device field into one flat buffer of
+ * HALSIM_GetStateSize() bytes, so a simulation can later be returned to this
+ * point with HALSIM_RestoreState(). Returns the number of bytes written, or 0
+ * if the buffer is too small.
+ *
+ * Only device data is saved: which devices the robot program has allocated
+ * (the Initialized fields), match info, simulated time and the state of the
+ * robot program itself are left alone. Restoring into the program that saved
+ * the state, after the same devices have been allocated, is the intended
+ * use.
+ */
+int32_t HALSIM_SaveState(void* buffer, int32_t size);
+
+/**
+ * Restores a state saved by HALSIM_SaveState(). Fields are set through the
+ * normal setters, so callbacks fire for every value that changes. Returns
+ * false, leaving the state untouched, if the buffer does not hold a state
+ * saved by this version of the HAL.
+ */
+HAL_Bool HALSIM_RestoreState(const void* buffer, int32_t size);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif
@@ -0,0 +1,39 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/cpp/BorrowTracker.h"
+
+#include <mutex>
+
+using namespace hal;
+
+void BorrowTracker::Exit() {
+  if (m_borrowers.fetch_sub(1) != 1 || !m_hasRetired.load()) return;
+  // The last borrower out destroys what was retired while it borrowed. If a
+  // retire holds the lock, the next retire or last borrower does it instead.
+  std::vector<std::shared_ptr<void>> reclaimed;
+  std::unique_lock<wpi::mutex> lock(m_mutex, std::try_to_lock);
+  if (!lock) return;
+  ReclaimLocked(&reclaimed);
+  lock.unlock();
+  // structure destructors run here, after unlocking
+}
+
+void BorrowTracker::Retire(std::shared_ptr<void> structure) {
+  std::vector<std::shared_ptr<void>> reclaimed;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (structure) m_retired.emplace_back(std::move(structure));
+  // flag before counting borrowers, so a borrower leaving now will see it
+  m_hasRetired.store(!m_retired.empty());
+  ReclaimLocked(&reclaimed);
+}
+
+void BorrowTracker::ReclaimLocked(
+    std::vector<std::shared_ptr<void>>* reclaimed) {
+  if (m_borrowers.load() == 0) reclaimed->swap(m_retired);
+  m_hasRetired.store(!m_retired.empty());
+}
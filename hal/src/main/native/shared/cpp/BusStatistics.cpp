@@ -0,0 +1,90 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/cpp/BusStatistics.h"
+
+using namespace hal;
+
+namespace {
+// The counters of one port. A port is usually used by one thread, but any
+// thread may call on it, so the counters are updated atomically.
+struct PortCounters {
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<uint64_t> totalTime{0};
+  std::atomic<uint64_t> maxTime{0};
+};
+}  // namespace
+
+static PortCounters counters[HAL_kBusTypeCount][HAL_kBusMaxPorts];
+
+namespace hal {
+namespace detail {
+std::atomic<bool>& BusStatisticsEnabledFlag() {
+  static std::atomic<bool> enabled{false};
+  return enabled;
+}
+
+void RecordBusCall(HAL_BusType bus, int32_t port, uint64_t time, bool error) {
+  if (bus < 0 || bus >= HAL_kBusTypeCount || port < 0 ||
+      port >= HAL_kBusMaxPorts) {
+    return;
+  }
+  PortCounters& c = counters[bus][port];
+  c.count.fetch_add(1, std::memory_order_relaxed);
+  if (error) c.errors.fetch_add(1, std::memory_order_relaxed);
+  c.totalTime.fetch_add(time, std::memory_order_relaxed);
+  uint64_t max = c.maxTime.load(std::memory_order_relaxed);
+  while (time > max && !c.maxTime.compare_exchange_weak(
+                           max, time, std::memory_order_relaxed)) {
+  }
+}
+}  // namespace detail
+}  // namespace hal
+
+extern "C" {
+
+void HAL_SetBusStatisticsEnabled(HAL_Bool enabled) {
+  detail::BusStatisticsEnabledFlag().store(enabled);
+}
+
+HAL_Bool HAL_GetBusStatisticsEnabled(void) { return BusStatisticsEnabled(); }
+
+int32_t HAL_GetBusStatistics(HAL_BusStatistics* statistics, int32_t size) {
+  int32_t count = 0;
+  for (int32_t bus = 0; bus < HAL_kBusTypeCount; bus++) {
+    for (int32_t port = 0; port < HAL_kBusMaxPorts; port++) {
+      const PortCounters& c = counters[bus][port];
+      uint64_t calls = c.count.load(std::memory_order_relaxed);
+      if (calls == 0) continue;
+      if (count < size) {
+        HAL_BusStatistics& s = statistics[count];
+        s.bus = bus;
+        s.port = port;
+        s.count = calls;
+        s.errors = c.errors.load(std::memory_order_relaxed);
+        s.totalTime = c.totalTime.load(std::memory_order_relaxed);
+        s.maxTime = c.maxTime.load(std::memory_order_relaxed);
+      }
+      count++;
+    }
+  }
+  return count;
+}
+
+void HAL_ResetBusStatistics(void) {
+  for (auto& bus : counters) {
+    for (auto& c : bus) {
+      c.count.store(0, std::memory_order_relaxed);
+      c.errors.store(0, std::memory_order_relaxed);
+      c.totalTime.store(0, std::memory_order_relaxed);
+      c.maxTime.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // extern "C"
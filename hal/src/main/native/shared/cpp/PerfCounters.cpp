@@ -0,0 +1,140 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/cpp/PerfCounters.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <support/mutex.h>
+
+using namespace hal;
+
+namespace {
+// The counters of one thread. Only the owning thread writes them; they are
+// atomic so they can be summed from another thread at any time.
+struct CounterBlock {
+  std::atomic<uint64_t> count[HAL_kPerfCounterCount]{};
+  std::atomic<uint64_t> totalTime[HAL_kPerfCounterCount]{};
+  std::atomic<uint64_t> maxTime[HAL_kPerfCounterCount]{};
+  // the maximum interval maxTime belongs to
+  std::atomic<uint32_t> maxEpoch[HAL_kPerfCounterCount]{};
+};
+
+struct Registry {
+  wpi::mutex mutex;
+  std::vector<CounterBlock*> threads;
+  // the totals of threads that have exited
+  CounterBlock retired;
+};
+
+struct ThreadCounters {
+  ThreadCounters();
+  ~ThreadCounters();
+  CounterBlock block;
+};
+}  // namespace
+
+static std::atomic<uint32_t> maxEpoch{0};
+
+// Never destroyed, as threads may exit after static destruction has started
+static Registry& GetRegistry() {
+  static Registry* registry = new Registry;
+  return *registry;
+}
+
+static void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+static uint64_t GetMax(const CounterBlock& block, int type, uint32_t epoch) {
+  if (block.maxEpoch[type].load(std::memory_order_relaxed) != epoch) return 0;
+  return block.maxTime[type].load(std::memory_order_relaxed);
+}
+
+ThreadCounters::ThreadCounters() {
+  auto& registry = GetRegistry();
+  std::lock_guard<wpi::mutex> lock(registry.mutex);
+  registry.threads.push_back(&block);
+}
+
+ThreadCounters::~ThreadCounters() {
+  auto& registry = GetRegistry();
+  std::lock_guard<wpi::mutex> lock(registry.mutex);
+  uint32_t epoch = maxEpoch.load(std::memory_order_relaxed);
+  for (int i = 0; i < HAL_kPerfCounterCount; i++) {
+    Add(registry.retired.count[i], block.count[i].load());
+    Add(registry.retired.totalTime[i], block.totalTime[i].load());
+    uint64_t max = std::max(GetMax(registry.retired, i, epoch),
+                            GetMax(block, i, epoch));
+    registry.retired.maxTime[i].store(max);
+    registry.retired.maxEpoch[i].store(epoch);
+  }
+  registry.threads.erase(std::find(registry.threads.begin(),
+                                   registry.threads.end(), &block));
+}
+
+namespace hal {
+namespace detail {
+std::atomic<bool>& PerfCountersEnabledFlag() {
+  static std::atomic<bool> enabled{false};
+  return enabled;
+}
+
+void RecordPerfCounter(int32_t type, uint64_t time) {
+  if (type < 0 || type >= HAL_kPerfCounterCount) return;
+  static thread_local ThreadCounters counters;
+  auto& block = counters.block;
+  Add(block.count[type], 1);
+  Add(block.totalTime[type], time);
+  uint32_t epoch = maxEpoch.load(std::memory_order_relaxed);
+  if (block.maxEpoch[type].load(std::memory_order_relaxed) != epoch) {
+    block.maxTime[type].store(time, std::memory_order_relaxed);
+    block.maxEpoch[type].store(epoch, std::memory_order_relaxed);
+  } else if (time > block.maxTime[type].load(std::memory_order_relaxed)) {
+    block.maxTime[type].store(time, std::memory_order_relaxed);
+  }
+}
+}  // namespace detail
+}  // namespace hal
+
+extern "C" {
+
+void HAL_SetPerfCountersEnabled(HAL_Bool enabled) {
+  detail::PerfCountersEnabledFlag().store(enabled);
+}
+
+HAL_Bool HAL_GetPerfCountersEnabled(void) { return PerfCountersEnabled(); }
+
+int32_t HAL_GetPerfCounters(HAL_PerfCounter* counters, int32_t size) {
+  int32_t count = std::min(size, static_cast<int32_t>(HAL_kPerfCounterCount));
+  if (count <= 0) return 0;
+  auto& registry = GetRegistry();
+  std::lock_guard<wpi::mutex> lock(registry.mutex);
+  uint32_t epoch = maxEpoch.load(std::memory_order_relaxed);
+  for (int32_t i = 0; i < count; i++) {
+    HAL_PerfCounter& counter = counters[i];
+    counter.count = registry.retired.count[i].load();
+    counter.totalTime = registry.retired.totalTime[i].load();
+    counter.maxTime = GetMax(registry.retired, i, epoch);
+    for (auto block : registry.threads) {
+      counter.count += block->count[i].load(std::memory_order_relaxed);
+      counter.totalTime += block->totalTime[i].load(std::memory_order_relaxed);
+      counter.maxTime = std::max(counter.maxTime, GetMax(*block, i, epoch));
+    }
+  }
+  return count;
+}
+
+void HAL_ResetPerfCounterMaximums(void) { maxEpoch.fetch_add(1); }
+
+void HAL_RecordPerfCounter(int32_t type, uint64_t time) {
+  if (PerfCountersEnabled()) detail::RecordPerfCounter(type, time);
+}
+
+}  // extern "C"
@@ -53,6 +53,7 @@ void HandleBase::ResetGlobalHandles() {
     }
   }
 }
+
 HAL_PortHandle createPortHandle(uint8_t channel, uint8_t module) {
   // set last 8 bits, then shift to first 8 bits
   HAL_PortHandle handle = static_cast<HAL_PortHandle>(HAL_HandleEnum::Port);
@@ -7,10 +7,69 @@
 
 #include "HAL/Accelerometer.h"
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <support/mutex.h>
+
+#include "HAL/Errors.h"
+#include "HAL/HAL.h"
 #include "MockData/AccelerometerDataInternal.h"
 
 using namespace hal;
 
+// The output data rate of the roboRIO accelerometer, in FPGA microseconds
+static constexpr uint64_t kSamplePeriod = 1250;
+
+namespace {
+/**
+ * Emulates the sampler on the simulated clock. Samples are taken when the
+ * program next looks at the sampler, as if each had been read at its time,
+ * with the values the sim data has then.
+ */
+struct AccelerometerSampler {
+  // Takes the samples due by now; mutex must be held
+  void Run();
+
+  wpi::mutex mutex;
+  std::vector<HAL_AccelerometerSample> samples;
+  size_t next = 0;
+  size_t size = 0;
+  int64_t overflows = 0;
+  uint64_t nextSample = 0;
+};
+}  // namespace
+
+static AccelerometerSampler sampler;
+
+void AccelerometerSampler::Run() {
+  if (samples.empty()) return;
+  int32_t status = 0;
+  uint64_t now = HAL_GetFPGATime(&status);
+  if (now < nextSample) return;
+  uint64_t due = (now - nextSample) / kSamplePeriod + 1;
+
+  // samples that would only be overwritten again aren't taken
+  size_t capacity = samples.size();
+  uint64_t skipped = due > capacity ? due - capacity : 0;
+  overflows += skipped;
+  nextSample += skipped * kSamplePeriod;
+  double x = SimAccelerometerData[0].GetX();
+  double y = SimAccelerometerData[0].GetY();
+  double z = SimAccelerometerData[0].GetZ();
+  for (uint64_t i = skipped; i < due; i++) {
+    samples[next] = HAL_AccelerometerSample{x, y, z, nextSample};
+    nextSample += kSamplePeriod;
+    next = (next + 1) % capacity;
+    if (size < capacity) {
+      size++;
+    } else {
+      overflows++;
+    }
+  }
+}
+
 namespace hal {
 namespace init {
 void InitializeAccelerometer() {}
@@ -28,4 +87,61 @@ void HAL_SetAccelerometerRange(HAL_AccelerometerRange range) {
 double HAL_GetAccelerometerX(void) { return SimAccelerometerData[0].GetX(); }
 double HAL_GetAccelerometerY(void) { return SimAccelerometerData[0].GetY(); }
 double HAL_GetAccelerometerZ(void) { return SimAccelerometerData[0].GetZ(); }
+
+void HAL_GetAccelerometerXYZ(double* x, double* y, double* z) {
+  *x = SimAccelerometerData[0].GetX();
+  *y = SimAccelerometerData[0].GetY();
+  *z = SimAccelerometerData[0].GetZ();
+}
+
+void HAL_StartAccelerometerSampler(int32_t bufferSize, int32_t* status) {
+  if (bufferSize < 1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  std::lock_guard<wpi::mutex> lock(sampler.mutex);
+  bool running = !sampler.samples.empty();
+  sampler.samples.assign(bufferSize, HAL_AccelerometerSample{});
+  sampler.next = 0;
+  sampler.size = 0;
+  sampler.overflows = 0;
+  if (!running) {
+    sampler.nextSample = HAL_GetFPGATime(status) + kSamplePeriod;
+  }
+}
+
+void HAL_StopAccelerometerSampler(int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(sampler.mutex);
+  sampler.samples.clear();
+  sampler.size = 0;
+}
+
+int32_t HAL_ReadAccelerometerSamples(HAL_AccelerometerSample* samples,
+                                     int32_t count, int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(sampler.mutex);
+  if (sampler.samples.empty()) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  sampler.Run();
+
+  size_t capacity = sampler.samples.size();
+  size_t read = std::min<size_t>(sampler.size, std::max(count, 0));
+  size_t first = sampler.next + capacity - sampler.size;
+  for (size_t i = 0; i < read; i++) {
+    samples[i] = sampler.samples[(first + i) % capacity];
+  }
+  sampler.size -= read;
+  return read;
+}
+
+int64_t HAL_GetAccelerometerSamplerOverflowCount(int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(sampler.mutex);
+  if (sampler.samples.empty()) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  sampler.Run();
+  return sampler.overflows;
+}
 }  // extern "C"
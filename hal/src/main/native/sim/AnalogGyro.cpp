@@ -13,8 +13,10 @@
 #include "AnalogInternal.h"
 #include "HAL/AnalogAccumulator.h"
 #include "HAL/AnalogInput.h"
+#include "HAL/HAL.h"
 #include "HAL/handles/IndexedHandleResource.h"
 #include "MockData/AnalogGyroDataInternal.h"
+#include "SimContextInternal.h"
 
 namespace {
 struct AnalogGyro {
@@ -25,16 +27,14 @@ struct AnalogGyro {
 
 using namespace hal;
 
-static IndexedHandleResource<HAL_GyroHandle, AnalogGyro, kNumAccumulators,
-                             HAL_HandleEnum::AnalogGyro>* analogGyroHandles;
+static SimContextLocal<IndexedHandleResource<
+    HAL_GyroHandle, AnalogGyro, kNumAccumulators, HAL_HandleEnum::AnalogGyro>>
+    analogGyroHandles;
 
 namespace hal {
 namespace init {
 void InitializeAnalogGyro() {
-  static IndexedHandleResource<HAL_GyroHandle, AnalogGyro, kNumAccumulators,
-                               HAL_HandleEnum::AnalogGyro>
-      agH;
-  analogGyroHandles = &agH;
+  analogGyroHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
@@ -142,4 +142,21 @@ double HAL_GetAnalogGyroOffset(HAL_GyroHandle handle, int32_t* status) {
 int32_t HAL_GetAnalogGyroCenter(HAL_GyroHandle handle, int32_t* status) {
   return 0;
 }
+
+// There is no accumulator, so the value and count are always 0
+void HAL_GetAnalogGyroSnapshot(HAL_GyroHandle handle,
+                               HAL_AnalogGyroSnapshot* snapshot,
+                               int32_t* status) {
+  auto gyro = analogGyroHandles->Get(handle);
+  if (gyro == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  snapshot->timestamp = HAL_GetFPGATime(status);
+  snapshot->value = 0;
+  snapshot->count = 0;
+  snapshot->angle = SimAnalogGyroData[gyro->index].GetAngle();
+  snapshot->rate = SimAnalogGyroData[gyro->index].GetRate();
+}
 }  // extern "C"
@@ -7,6 +7,8 @@
 
 #include "HAL/AnalogInput.h"
 
+#include <atomic>
+
 #include "AnalogInternal.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "MockData/AnalogInDataInternal.h"
@@ -166,6 +168,47 @@ double HAL_GetAnalogAverageVoltage(HAL_AnalogInputHandle analogPortHandle,
   double voltage = SimAnalogInData[port->channel].GetVoltage();
   return voltage;
 }
+void HAL_GetAnalogVoltages(const HAL_AnalogInputHandle* analogPortHandles,
+                           double* voltages, int32_t count, int32_t* status) {
+  if (count < 0 || count > kNumAnalogInputs) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    auto port = analogInputHandles->Get(analogPortHandles[i]);
+    if (port == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return;
+    }
+    voltages[i] = SimAnalogInData[port->channel].GetVoltage();
+  }
+}
+void HAL_GetAnalogValues(const HAL_AnalogInputHandle* analogPortHandles,
+                         int32_t* values, HAL_Bool averaged, int32_t count,
+                         int32_t* status) {
+  if (count < 0 || count > kNumAnalogInputs) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    // No averaging supported
+    values[i] = HAL_GetAnalogValue(analogPortHandles[i], status);
+    if (*status == HAL_HANDLE_ERROR) return;
+  }
+}
+
+// Simulated reads never contend, so the mirror only records that it runs
+static std::atomic_bool analogMirrorRunning{false};
+
+void HAL_StartAnalogMirror(double period, int32_t* status) {
+  if (period <= 0.0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  analogMirrorRunning = true;
+}
+void HAL_StopAnalogMirror(int32_t* status) { analogMirrorRunning = false; }
+HAL_Bool HAL_IsAnalogMirrorRunning(void) { return analogMirrorRunning; }
 int32_t HAL_GetAnalogLSBWeight(HAL_AnalogInputHandle analogPortHandle,
                                int32_t* status) {
   return 1220703;
@@ -174,4 +217,26 @@ int32_t HAL_GetAnalogOffset(HAL_AnalogInputHandle analogPortHandle,
                             int32_t* status) {
   return 0;
 }
+
+// The simulator has no DMA engine, so streams never produce samples
+void HAL_StartAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                           int32_t bufferSize, int32_t* status) {
+  auto port = analogInputHandles->Get(analogPortHandle);
+  if (port == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (bufferSize < 1) *status = PARAMETER_OUT_OF_RANGE;
+}
+void HAL_StopAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                          int32_t* status) {}
+int32_t HAL_ReadAnalogStream(HAL_AnalogInputHandle analogPortHandle,
+                             int32_t* values, uint64_t* timeStamps,
+                             int32_t count, int32_t* status) {
+  return 0;
+}
+int64_t HAL_GetAnalogStreamOverflowCount(HAL_AnalogInputHandle analogPortHandle,
+                                         int32_t* status) {
+  return 0;
+}
 }  // extern "C"
@@ -11,17 +11,16 @@
 #include "PortsInternal.h"
 
 namespace hal {
-IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort, kNumAnalogInputs,
-                      HAL_HandleEnum::AnalogInput>* analogInputHandles;
+SimContextLocal<IndexedHandleResource<
+    HAL_AnalogInputHandle, hal::AnalogPort, kNumAnalogInputs,
+    HAL_HandleEnum::AnalogInput>>
+    analogInputHandles;
 }  // namespace hal
 
 namespace hal {
 namespace init {
 void InitializeAnalogInternal() {
-  static IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort,
-                               kNumAnalogInputs, HAL_HandleEnum::AnalogInput>
-      aiH;
-  analogInputHandles = &aiH;
+  analogInputHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
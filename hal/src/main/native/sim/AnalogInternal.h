@@ -14,6 +14,7 @@
 #include "HAL/Ports.h"
 #include "HAL/handles/IndexedHandleResource.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 namespace hal {
 constexpr int32_t kTimebase = 40000000;  ///< 40 MHz clock
@@ -27,8 +28,9 @@ struct AnalogPort {
   bool isAccumulator;
 };
 
-extern IndexedHandleResource<HAL_AnalogInputHandle, hal::AnalogPort,
-                             kNumAnalogInputs, HAL_HandleEnum::AnalogInput>*
+extern SimContextLocal<IndexedHandleResource<
+    HAL_AnalogInputHandle, hal::AnalogPort, kNumAnalogInputs,
+    HAL_HandleEnum::AnalogInput>>
     analogInputHandles;
 
 int32_t GetAnalogTriggerInputIndex(HAL_AnalogTriggerHandle handle,
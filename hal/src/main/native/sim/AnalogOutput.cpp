@@ -12,6 +12,7 @@
 #include "HAL/handles/IndexedHandleResource.h"
 #include "MockData/AnalogOutDataInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 using namespace hal;
 
@@ -21,17 +22,15 @@ struct AnalogOutput {
 };
 }  // namespace
 
-static IndexedHandleResource<HAL_AnalogOutputHandle, AnalogOutput,
-                             kNumAnalogOutputs, HAL_HandleEnum::AnalogOutput>*
+static SimContextLocal<IndexedHandleResource<
+    HAL_AnalogOutputHandle, AnalogOutput, kNumAnalogOutputs,
+    HAL_HandleEnum::AnalogOutput>>
     analogOutputHandles;
 
 namespace hal {
 namespace init {
 void InitializeAnalogOutput() {
-  static IndexedHandleResource<HAL_AnalogOutputHandle, AnalogOutput,
-                               kNumAnalogOutputs, HAL_HandleEnum::AnalogOutput>
-      aoH;
-  analogOutputHandles = &aoH;
+  analogOutputHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
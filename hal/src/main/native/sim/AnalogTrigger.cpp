@@ -8,6 +8,7 @@
 #include "HAL/AnalogTrigger.h"
 
 #include "AnalogInternal.h"
+#include "DigitalSignalsInternal.h"
 #include "HAL/AnalogInput.h"
 #include "HAL/Errors.h"
 #include "HAL/handles/HandlesInternal.h"
@@ -15,29 +16,26 @@
 #include "MockData/AnalogInDataInternal.h"
 #include "MockData/AnalogTriggerDataInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 namespace {
 struct AnalogTrigger {
   HAL_AnalogInputHandle analogHandle;
   uint8_t index;
-  HAL_Bool trigState;
 };
 }  // namespace
 
 using namespace hal;
 
-static LimitedHandleResource<HAL_AnalogTriggerHandle, AnalogTrigger,
-                             kNumAnalogTriggers, HAL_HandleEnum::AnalogTrigger>*
+static SimContextLocal<LimitedHandleResource<
+    HAL_AnalogTriggerHandle, AnalogTrigger, kNumAnalogTriggers,
+    HAL_HandleEnum::AnalogTrigger>>
     analogTriggerHandles;
 
 namespace hal {
 namespace init {
 void InitializeAnalogTrigger() {
-  static LimitedHandleResource<HAL_AnalogTriggerHandle, AnalogTrigger,
-                               kNumAnalogTriggers,
-                               HAL_HandleEnum::AnalogTrigger>
-      atH;
-  analogTriggerHandles = &atH;
+  analogTriggerHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
@@ -84,8 +82,7 @@ HAL_AnalogTriggerHandle HAL_InitializeAnalogTrigger(
   *index = trigger->index;
 
   SimAnalogTriggerData[trigger->index].SetInitialized(true);
-
-  trigger->trigState = false;
+  SetAnalogTriggerInput(trigger->index, analog_port->channel);
 
   return handle;
 }
@@ -95,6 +92,7 @@ void HAL_CleanAnalogTrigger(HAL_AnalogTriggerHandle analogTriggerHandle,
   auto trigger = analogTriggerHandles->Get(analogTriggerHandle);
   analogTriggerHandles->Free(analogTriggerHandle);
   if (trigger == nullptr) return;
+  SetAnalogTriggerInput(trigger->index, -1);
   SimAnalogTriggerData[trigger->index].SetInitialized(false);
   // caller owns the analog input handle.
 }
@@ -123,13 +121,14 @@ void HAL_SetAnalogTriggerLimitsRaw(HAL_AnalogTriggerHandle analogTriggerHandle,
 
   double trigLower =
       GetAnalogValueToVoltage(trigger->analogHandle, lower, status);
-  if (status != 0) return;
+  if (*status != 0) return;
   double trigUpper =
       GetAnalogValueToVoltage(trigger->analogHandle, upper, status);
-  if (status != 0) return;
+  if (*status != 0) return;
 
   SimAnalogTriggerData[trigger->index].SetTriggerUpperBound(trigUpper);
   SimAnalogTriggerData[trigger->index].SetTriggerLowerBound(trigLower);
+  UpdateAnalogTrigger(trigger->index);
 }
 void HAL_SetAnalogTriggerLimitsVoltage(
     HAL_AnalogTriggerHandle analogTriggerHandle, double lower, double upper,
@@ -145,6 +144,7 @@ void HAL_SetAnalogTriggerLimitsVoltage(
 
   SimAnalogTriggerData[trigger->index].SetTriggerUpperBound(upper);
   SimAnalogTriggerData[trigger->index].SetTriggerLowerBound(lower);
+  UpdateAnalogTrigger(trigger->index);
 }
 void HAL_SetAnalogTriggerAveraged(HAL_AnalogTriggerHandle analogTriggerHandle,
                                   HAL_Bool useAveragedValue, int32_t* status) {
@@ -185,15 +185,8 @@ void HAL_SetAnalogTriggerFiltered(HAL_AnalogTriggerHandle analogTriggerHandle,
   triggerData->SetTriggerMode(setVal);
 }
 
-static double GetTriggerValue(AnalogTrigger* trigger, int32_t* status) {
-  auto analogIn = analogInputHandles->Get(trigger->analogHandle);
-  if (analogIn == nullptr) {
-    // Returning HAL Handle Error, but going to ignore lower down
-    *status = HAL_HANDLE_ERROR;
-    return 0.0;
-  }
-
-  return SimAnalogInData[analogIn->channel].GetVoltage();
+static bool HasTriggerInput(AnalogTrigger* trigger) {
+  return analogInputHandles->Get(trigger->analogHandle) != nullptr;
 }
 
 HAL_Bool HAL_GetAnalogTriggerInWindow(
@@ -204,17 +197,12 @@ HAL_Bool HAL_GetAnalogTriggerInWindow(
     return false;
   }
 
-  double voltage = GetTriggerValue(trigger.get(), status);
-  if (*status == HAL_HANDLE_ERROR) {
-    // Don't error if analog has been destroyed
-    *status = 0;
-    return false;
-  }
-
-  auto trigUpper = SimAnalogTriggerData[trigger->index].GetTriggerUpperBound();
-  auto trigLower = SimAnalogTriggerData[trigger->index].GetTriggerLowerBound();
+  // Don't error if analog has been destroyed
+  if (!HasTriggerInput(trigger.get())) return false;
 
-  return voltage >= trigLower && voltage <= trigUpper;
+  // The limits may have been changed through the sim data
+  UpdateAnalogTrigger(trigger->index);
+  return GetAnalogTriggerSignal(trigger->index, HAL_Trigger_kInWindow);
 }
 HAL_Bool HAL_GetAnalogTriggerTriggerState(
     HAL_AnalogTriggerHandle analogTriggerHandle, int32_t* status) {
@@ -224,25 +212,11 @@ HAL_Bool HAL_GetAnalogTriggerTriggerState(
     return false;
   }
 
-  double voltage = GetTriggerValue(trigger.get(), status);
-  if (*status == HAL_HANDLE_ERROR) {
-    // Don't error if analog has been destroyed
-    *status = 0;
-    return false;
-  }
-
-  auto trigUpper = SimAnalogTriggerData[trigger->index].GetTriggerUpperBound();
-  auto trigLower = SimAnalogTriggerData[trigger->index].GetTriggerLowerBound();
+  // Don't error if analog has been destroyed
+  if (!HasTriggerInput(trigger.get())) return false;
 
-  if (voltage < trigLower) {
-    trigger->trigState = false;
-    return false;
-  }
-  if (voltage > trigUpper) {
-    trigger->trigState = true;
-    return true;
-  }
-  return trigger->trigState;
+  UpdateAnalogTrigger(trigger->index);
+  return GetAnalogTriggerSignal(trigger->index, HAL_Trigger_kState);
 }
 HAL_Bool HAL_GetAnalogTriggerOutput(HAL_AnalogTriggerHandle analogTriggerHandle,
                                     HAL_AnalogTriggerType type,
@@ -8,6 +8,7 @@
 #include "HAL/Compressor.h"
 
 #include "HAL/Errors.h"
+#include "HAL/HAL.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "MockData/PCMDataInternal.h"
 #include "PortsInternal.h"
@@ -118,4 +119,30 @@ HAL_Bool HAL_GetCompressorNotConnectedFault(
     HAL_CompressorHandle compressorHandle, int32_t* status) {
   return false;
 }
+
+void HAL_GetCompressorStatus(HAL_CompressorHandle compressorHandle,
+                             HAL_CompressorStatus* compressorStatus,
+                             int32_t* status) {
+  int16_t index =
+      getHandleTypedIndex(compressorHandle, HAL_HandleEnum::Compressor, 0);
+  if (index == InvalidHandleIndex) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  auto& data = SimPCMData[index];
+  compressorStatus->enabled = data.GetCompressorOn();
+  compressorStatus->closedLoopControl = data.GetClosedLoopEnabled();
+  compressorStatus->pressureSwitch = data.GetPressureSwitch();
+  compressorStatus->current = data.GetCompressorCurrent();
+  compressorStatus->currentTooHighFault = false;
+  compressorStatus->currentTooHighStickyFault = false;
+  compressorStatus->shortedFault = false;
+  compressorStatus->shortedStickyFault = false;
+  compressorStatus->notConnectedFault = false;
+  compressorStatus->notConnectedStickyFault = false;
+  // every simulated frame is fresh
+  uint32_t now = HAL_GetFPGATime(status) / 1000;
+  for (auto& timeStamp : compressorStatus->frameTimeStamps) timeStamp = now;
+}
 }  // extern "C"
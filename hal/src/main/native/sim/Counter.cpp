@@ -7,90 +7,514 @@
 
 #include "HAL/Counter.h"
 
+#include <limits>
+
 #include "CounterInternal.h"
+#include "DigitalSignalsInternal.h"
 #include "HAL/Errors.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HAL/handles/LimitedHandleResource.h"
+#include "MockHooksInternal.h"
 #include "PortsInternal.h"
 
 namespace hal {
 
-LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
-                      HAL_HandleEnum::Counter>* counterHandles;
+SimContextLocal<LimitedHandleResource<
+    HAL_CounterHandle, Counter, kNumCounters, HAL_HandleEnum::Counter>>
+    counterHandles;
 }  // namespace hal
 
 namespace hal {
 namespace init {
 void InitializeCounter() {
-  static LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
-                               HAL_HandleEnum::Counter>
-      cH;
-  counterHandles = &cH;
+  counterHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
 
+using namespace hal;
+
+/*
+ * Simulated counters count the edges of the signals of their sources as the
+ * FPGA passes them on, after glitch filters and analog triggers, and time
+ * them on the simulated clock.
+ */
+
+static void AddPeriod(Counter* counter, uint64_t period) {
+  counter->periods.push_back(period);
+  while (counter->periods.size() > static_cast<size_t>(counter->averageSize)) {
+    counter->periods.pop_front();
+  }
+}
+
+static void Count(Counter* counter, int32_t delta, uint64_t time) {
+  counter->count += delta;
+  counter->direction = delta > 0;
+  // A count after a stall starts the timer over
+  if (counter->mode != HAL_Counter_kSemiperiod && counter->counted &&
+      time - counter->lastCountTime <= counter->maxPeriod) {
+    AddPeriod(counter, time - counter->lastCountTime);
+  }
+  counter->counted = true;
+  counter->lastCountTime = time;
+}
+
+static void UpSourceChanged(void* param, bool value, uint64_t time) {
+  auto counter = static_cast<Counter*>(param);
+  bool rising = value;
+  counter->up.value = value;
+  if (counter->pulseStatistics) {
+    counter->pulseStatistics->AddEdge(time * 1.0e-6, rising);
+  }
+
+  switch (counter->mode) {
+    case HAL_Counter_kTwoPulse:
+      if (rising ? counter->up.risingEdge : counter->up.fallingEdge) {
+        Count(counter, 1, time);
+      }
+      break;
+    case HAL_Counter_kExternalDirection:
+      if (rising ? counter->up.risingEdge : counter->up.fallingEdge) {
+        // The down source is high to count down
+        bool down = counter->down.value != counter->reverseDirection;
+        Count(counter, down ? -1 : 1, time);
+      }
+      break;
+    case HAL_Counter_kSemiperiod:
+      // Measures the high semi-periods if counting up on rising edges
+      if (rising == counter->up.risingEdge) {
+        counter->inPulse = true;
+        counter->pulseStart = time;
+      } else if (counter->inPulse) {
+        counter->inPulse = false;
+        Count(counter, 1, time);
+        AddPeriod(counter, time - counter->pulseStart);
+      }
+      break;
+    case HAL_Counter_kPulseLength:
+      // Short pulses count up and long pulses down
+      if (rising) {
+        counter->inPulse = true;
+        counter->pulseStart = time;
+      } else if (counter->inPulse) {
+        counter->inPulse = false;
+        bool longPulse =
+            time - counter->pulseStart >= counter->pulseLengthThreshold;
+        Count(counter, longPulse ? -1 : 1, time);
+      }
+      break;
+  }
+}
+
+static void DownSourceChanged(void* param, bool value, uint64_t time) {
+  auto counter = static_cast<Counter*>(param);
+  counter->down.value = value;
+  if (counter->mode != HAL_Counter_kTwoPulse) return;
+  if (value ? counter->down.risingEdge : counter->down.fallingEdge) {
+    Count(counter, -1, time);
+  }
+}
+
+// The signal lock must be held
+static void ResetCounterLocked(Counter* counter) {
+  counter->count = 0;
+  counter->direction = false;
+  counter->periods.clear();
+  counter->counted = false;
+  counter->inPulse = false;
+}
+
+// The signal lock must be held
+static void SetSourceLocked(Counter* counter, CounterSource* source,
+                            HAL_Handle digitalSourceHandle,
+                            HAL_AnalogTriggerType analogTriggerType,
+                            SignalCallback callback, int32_t* status) {
+  int32_t listener =
+      AddSignalListenerLocked(digitalSourceHandle, analogTriggerType, callback,
+                              counter, true, status);
+  if (*status != 0) return;
+  RemoveSignalListenerLocked(source->listener);
+  source->listener = listener;
+  source->handle = digitalSourceHandle;
+  source->triggerType = analogTriggerType;
+  source->value =
+      GetSignalValueLocked(digitalSourceHandle, analogTriggerType, status);
+}
+
+// The signal lock must be held
+static void ClearSourceLocked(CounterSource* source) {
+  RemoveSignalListenerLocked(source->listener);
+  *source = CounterSource{};
+}
+
+// The signal lock must be held; see HAL_GetCounterStopped()
+static bool IsStoppedLocked(Counter* counter, uint64_t now) {
+  bool stalled =
+      !counter->counted || now - counter->lastCountTime > counter->maxPeriod;
+  if (stalled && counter->updateWhenEmpty) counter->periods.clear();
+  return counter->periods.empty();
+}
+
+// The signal lock must be held
+static double GetPeriodLocked(Counter* counter, uint64_t now) {
+  if (IsStoppedLocked(counter, now)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  uint64_t sum = 0;
+  for (uint64_t period : counter->periods) sum += period;
+  return sum * 1.0e-6 / counter->periods.size();
+}
+
 extern "C" {
 HAL_CounterHandle HAL_InitializeCounter(HAL_Counter_Mode mode, int32_t* index,
                                         int32_t* status) {
-  return 0;
+  auto handle = counterHandles->Allocate();
+  if (handle == HAL_kInvalidHandle) {  // out of resources
+    *status = NO_AVAILABLE_RESOURCES;
+    return HAL_kInvalidHandle;
+  }
+  auto counter = counterHandles->Get(handle);
+  if (counter == nullptr) {  // would only occur on thread issues
+    *status = HAL_HANDLE_ERROR;
+    return HAL_kInvalidHandle;
+  }
+  counter->index = static_cast<uint8_t>(getHandleIndex(handle));
+  *index = counter->index;
+
+  auto lock = LockSignals();
+  counter->mode = mode;
+  return handle;
+}
+void HAL_FreeCounter(HAL_CounterHandle counterHandle, int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter != nullptr) {
+    // The listeners are gone before the counter is
+    auto lock = LockSignals();
+    ClearSourceLocked(&counter->up);
+    ClearSourceLocked(&counter->down);
+  }
+  counterHandles->Free(counterHandle);
 }
-void HAL_FreeCounter(HAL_CounterHandle counterHandle, int32_t* status) {}
 void HAL_SetCounterAverageSize(HAL_CounterHandle counterHandle, int32_t size,
-                               int32_t* status) {}
+                               int32_t* status) {
+  HAL_SetCounterSamplesToAverage(counterHandle, size, status);
+}
 void HAL_SetCounterUpSource(HAL_CounterHandle counterHandle,
                             HAL_Handle digitalSourceHandle,
                             HAL_AnalogTriggerType analogTriggerType,
-                            int32_t* status) {}
+                            int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  SetSourceLocked(counter.get(), &counter->up, digitalSourceHandle,
+                  analogTriggerType, &UpSourceChanged, status);
+  if (*status != 0) return;
+  if (counter->mode == HAL_Counter_kTwoPulse ||
+      counter->mode == HAL_Counter_kExternalDirection) {
+    counter->up.risingEdge = true;
+    counter->up.fallingEdge = false;
+  }
+  ResetCounterLocked(counter.get());
+}
 void HAL_SetCounterUpSourceEdge(HAL_CounterHandle counterHandle,
                                 HAL_Bool risingEdge, HAL_Bool fallingEdge,
-                                int32_t* status) {}
+                                int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->up.risingEdge = risingEdge;
+  counter->up.fallingEdge = fallingEdge;
+}
 void HAL_ClearCounterUpSource(HAL_CounterHandle counterHandle,
-                              int32_t* status) {}
+                              int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  ClearSourceLocked(&counter->up);
+}
 void HAL_SetCounterDownSource(HAL_CounterHandle counterHandle,
                               HAL_Handle digitalSourceHandle,
                               HAL_AnalogTriggerType analogTriggerType,
-                              int32_t* status) {}
+                              int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  if (counter->mode != HAL_Counter_kTwoPulse &&
+      counter->mode != HAL_Counter_kExternalDirection) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  SetSourceLocked(counter.get(), &counter->down, digitalSourceHandle,
+                  analogTriggerType, &DownSourceChanged, status);
+  if (*status != 0) return;
+  counter->down.risingEdge = true;
+  counter->down.fallingEdge = false;
+  ResetCounterLocked(counter.get());
+}
 void HAL_SetCounterDownSourceEdge(HAL_CounterHandle counterHandle,
                                   HAL_Bool risingEdge, HAL_Bool fallingEdge,
-                                  int32_t* status) {}
+                                  int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->down.risingEdge = risingEdge;
+  counter->down.fallingEdge = fallingEdge;
+}
 void HAL_ClearCounterDownSource(HAL_CounterHandle counterHandle,
-                                int32_t* status) {}
+                                int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  ClearSourceLocked(&counter->down);
+}
 void HAL_SetCounterUpDownMode(HAL_CounterHandle counterHandle,
-                              int32_t* status) {}
+                              int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->mode = HAL_Counter_kTwoPulse;
+}
 void HAL_SetCounterExternalDirectionMode(HAL_CounterHandle counterHandle,
-                                         int32_t* status) {}
+                                         int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->mode = HAL_Counter_kExternalDirection;
+}
 void HAL_SetCounterSemiPeriodMode(HAL_CounterHandle counterHandle,
-                                  HAL_Bool highSemiPeriod, int32_t* status) {}
+                                  HAL_Bool highSemiPeriod, int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->mode = HAL_Counter_kSemiperiod;
+  counter->up.risingEdge = highSemiPeriod;
+  counter->updateWhenEmpty = false;
+  counter->inPulse = false;
+}
 void HAL_SetCounterPulseLengthMode(HAL_CounterHandle counterHandle,
-                                   double threshold, int32_t* status) {}
+                                   double threshold, int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->mode = HAL_Counter_kPulseLength;
+  counter->pulseLengthThreshold = static_cast<uint64_t>(threshold * 1.0e6);
+  counter->inPulse = false;
+}
 int32_t HAL_GetCounterSamplesToAverage(HAL_CounterHandle counterHandle,
                                        int32_t* status) {
-  return 0;
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  auto lock = LockSignals();
+  return counter->averageSize;
 }
 void HAL_SetCounterSamplesToAverage(HAL_CounterHandle counterHandle,
                                     int32_t samplesToAverage, int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (samplesToAverage < 1 || samplesToAverage > 127) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->averageSize = samplesToAverage;
+  while (counter->periods.size() > static_cast<size_t>(samplesToAverage)) {
+    counter->periods.pop_front();
+  }
+}
+void HAL_ResetCounter(HAL_CounterHandle counterHandle, int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  ResetCounterLocked(counter.get());
 }
-void HAL_ResetCounter(HAL_CounterHandle counterHandle, int32_t* status) {}
 int32_t HAL_GetCounter(HAL_CounterHandle counterHandle, int32_t* status) {
-  return 0;
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  auto lock = LockSignals();
+  return counter->count;
 }
 double HAL_GetCounterPeriod(HAL_CounterHandle counterHandle, int32_t* status) {
-  return 0.0;
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0.0;
+  }
+  auto lock = LockSignals();
+  return GetPeriodLocked(counter.get(), GetFPGATime());
 }
 void HAL_SetCounterMaxPeriod(HAL_CounterHandle counterHandle, double maxPeriod,
-                             int32_t* status) {}
+                             int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->maxPeriod = static_cast<uint64_t>(maxPeriod * 1.0e6);
+}
 void HAL_SetCounterUpdateWhenEmpty(HAL_CounterHandle counterHandle,
-                                   HAL_Bool enabled, int32_t* status) {}
+                                   HAL_Bool enabled, int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->updateWhenEmpty = enabled;
+}
 HAL_Bool HAL_GetCounterStopped(HAL_CounterHandle counterHandle,
                                int32_t* status) {
-  return false;
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return false;
+  }
+  auto lock = LockSignals();
+  return IsStoppedLocked(counter.get(), GetFPGATime());
 }
 HAL_Bool HAL_GetCounterDirection(HAL_CounterHandle counterHandle,
                                  int32_t* status) {
-  return false;
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return false;
+  }
+  auto lock = LockSignals();
+  return counter->direction;
 }
 void HAL_SetCounterReverseDirection(HAL_CounterHandle counterHandle,
                                     HAL_Bool reverseDirection,
-                                    int32_t* status) {}
+                                    int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  // Like on the robot, only external direction mode can be reversed
+  if (counter->mode == HAL_Counter_kExternalDirection) {
+    counter->reverseDirection = reverseDirection;
+  }
+}
+void HAL_GetCounterSnapshot(HAL_CounterHandle counterHandle,
+                            HAL_CounterSnapshot* snapshot, int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  snapshot->timestamp = GetFPGATime();
+  snapshot->count = counter->count;
+  snapshot->direction = counter->direction;
+  snapshot->period = GetPeriodLocked(counter.get(), snapshot->timestamp);
+  snapshot->stopped = counter->periods.empty();
+}
+// The up source's listener measures the pulses, so no interrupt is used
+void HAL_StartCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                     int32_t windowSize, int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (windowSize < 1 || windowSize > HAL_kMaxCounterPulseWindow) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  auto lock = LockSignals();
+  if (counter->up.handle == HAL_kInvalidHandle) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+  counter->pulseStatistics = std::make_unique<PulseStatistics>(windowSize);
+}
+void HAL_StopCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                    int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  counter->pulseStatistics.reset();
+}
+void HAL_GetCounterPulseStatistics(HAL_CounterHandle counterHandle,
+                                   HAL_CounterPulseStatistics* stats,
+                                   int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  auto lock = LockSignals();
+  if (!counter->pulseStatistics) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+  counter->pulseStatistics->GetStatistics(stats);
+}
+int32_t HAL_GetCounterPulseHistogram(HAL_CounterHandle counterHandle,
+                                     HAL_Bool widths, double min, double max,
+                                     int32_t* bins, int32_t binCount,
+                                     int32_t* status) {
+  auto counter = counterHandles->Get(counterHandle);
+  if (counter == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  if (binCount < 1 || !(max > min)) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return 0;
+  }
+  auto lock = LockSignals();
+  if (!counter->pulseStatistics) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  return counter->pulseStatistics->GetHistogram(widths, min, max, bins,
+                                                binCount);
+}
 }  // extern "C"
@@ -7,17 +7,61 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+
+#include "HAL/AnalogTrigger.h"
+#include "HAL/Counter.h"
+#include "HAL/cpp/PulseStatistics.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HAL/handles/LimitedHandleResource.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 namespace hal {
 
+// An input of a counter, fed by a signal listener; see
+// DigitalSignalsInternal.h
+struct CounterSource {
+  HAL_Handle handle = HAL_kInvalidHandle;
+  HAL_AnalogTriggerType triggerType = HAL_Trigger_kInWindow;
+  int32_t listener = -1;
+  bool risingEdge = false;
+  bool fallingEdge = false;
+  bool value = false;
+};
+
+// Everything but the index is guarded by the lock from LockSignals()
 struct Counter {
   uint8_t index;
+  HAL_Counter_Mode mode = HAL_Counter_kTwoPulse;
+  CounterSource up;
+  CounterSource down;
+  bool reverseDirection = false;
+  // In microseconds
+  uint64_t pulseLengthThreshold = 0;
+
+  int32_t count = 0;
+  bool direction = false;
+
+  // The timer averages the periods of the latest counts, in microseconds
+  int32_t averageSize = 1;
+  uint64_t maxPeriod = 500000;
+  bool updateWhenEmpty = true;
+  std::deque<uint64_t> periods;
+  bool counted = false;
+  uint64_t lastCountTime = 0;
+  // In semi-period and pulse length mode, the pulse being measured
+  bool inPulse = false;
+  uint64_t pulseStart = 0;
+
+  std::unique_ptr<PulseStatistics> pulseStatistics;
 };
 
-extern LimitedHandleResource<HAL_CounterHandle, Counter, kNumCounters,
-                             HAL_HandleEnum::Counter>* counterHandles;
+extern SimContextLocal<LimitedHandleResource<
+    HAL_CounterHandle, Counter, kNumCounters, HAL_HandleEnum::Counter>>
+    counterHandles;
 
 }  // namespace hal
@@ -10,26 +10,26 @@
 #include <cmath>
 
 #include "DigitalInternal.h"
+#include "DigitalSignalsInternal.h"
+#include "HAL/HAL.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HAL/handles/LimitedHandleResource.h"
 #include "MockData/DIODataInternal.h"
 #include "MockData/DigitalPWMDataInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 using namespace hal;
 
-static LimitedHandleResource<HAL_DigitalPWMHandle, uint8_t,
-                             kNumDigitalPWMOutputs, HAL_HandleEnum::DigitalPWM>*
+static SimContextLocal<LimitedHandleResource<
+    HAL_DigitalPWMHandle, uint8_t, kNumDigitalPWMOutputs,
+    HAL_HandleEnum::DigitalPWM>>
     digitalPWMHandles;
 
 namespace hal {
 namespace init {
 void InitializeDIO() {
-  static LimitedHandleResource<HAL_DigitalPWMHandle, uint8_t,
-                               kNumDigitalPWMOutputs,
-                               HAL_HandleEnum::DigitalPWM>
-      dpH;
-  digitalPWMHandles = &dpH;
+  digitalPWMHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
@@ -160,6 +160,40 @@ void HAL_SetDigitalPWMDutyCycle(HAL_DigitalPWMHandle pwmGenerator,
   SimDigitalPWMData[id].SetDutyCycle(dutyCycle);
 }
 
+/**
+ * Configure the duty-cycle of several PWM generators at once.
+ *
+ * No duty cycle is changed if any of the generators is invalid.
+ *
+ * @param pwmGenerators The generator indexes reserved by allocateDigitalPWM()
+ * @param dutyCycles    The percent duty cycle to output [0..1], one per
+ *                      generator
+ * @param count         The number of generators
+ */
+void HAL_SetDigitalPWMDutyCycles(const HAL_DigitalPWMHandle* pwmGenerators,
+                                 const double* dutyCycles, int32_t count,
+                                 int32_t* status) {
+  int32_t ids[kNumDigitalPWMOutputs];
+  if (count > kNumDigitalPWMOutputs) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    auto port = digitalPWMHandles->Get(pwmGenerators[i]);
+    if (port == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return;
+    }
+    ids[i] = *port;
+  }
+  for (int32_t i = 0; i < count; i++) {
+    double dutyCycle = dutyCycles[i];
+    if (dutyCycle > 1.0) dutyCycle = 1.0;
+    if (dutyCycle < 0.0) dutyCycle = 0.0;
+    SimDigitalPWMData[ids[i]].SetDutyCycle(dutyCycle);
+  }
+}
+
 /**
  * Configure which DO channel the PWM signal is output on
  *
@@ -228,10 +262,42 @@ HAL_Bool HAL_GetDIO(HAL_DigitalHandle dioPortHandle, int32_t* status) {
     *status = HAL_HANDLE_ERROR;
     return false;
   }
-  HAL_Bool value = SimDIOData[port->channel].GetValue();
-  if (value > 1) value = 1;
-  if (value < 0) value = 0;
-  return value;
+  // Inputs are read after their glitch filter, like on the robot
+  return GetFilteredDigitalValue(port->channel);
+}
+
+/**
+ * Read every digital I/O channel at once.
+ *
+ * @param timestamp Set to the FPGA time of the read, in microseconds.
+ * @return A mask with bit n set when DIO channel n is high.
+ */
+uint32_t HAL_GetAllDIO(uint64_t* timestamp, int32_t* status) {
+  uint32_t values = 0;
+  for (int32_t channel = 0; channel < kNumDigitalChannels; channel++) {
+    if (SimDIOData[channel].GetInitialized() &&
+        GetFilteredDigitalValue(channel))
+      values |= 1u << channel;
+  }
+  *timestamp = HAL_GetFPGATime(status);
+  return values;
+}
+
+/**
+ * Set several digital outputs at once.
+ *
+ * @param mask   A mask with bit n set for each DIO channel n to set.
+ * @param values The new output states, one bit per channel as in mask.
+ */
+void HAL_SetDIOMasked(uint32_t mask, uint32_t values, int32_t* status) {
+  if (mask >> kNumDigitalChannels) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  for (int32_t channel = 0; channel < kNumDigitalChannels; channel++) {
+    if ((mask >> channel) & 1)
+      SimDIOData[channel].SetValue((values >> channel) & 1);
+  }
 }
 
 /**
@@ -310,8 +376,13 @@ void HAL_SetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t filterIndex,
     *status = HAL_HANDLE_ERROR;
     return;
   }
+  if (filterIndex < 0 || filterIndex > 3) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
 
-  // TODO(Thad) Figure this out
+  SetDigitalFilterSelect(port->channel, filterIndex);
+  SimDIOData[port->channel].SetFilterIndex(filterIndex);
 }
 
 /**
@@ -328,8 +399,7 @@ int32_t HAL_GetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t* status) {
     *status = HAL_HANDLE_ERROR;
     return 0;
   }
-  return 0;
-  // TODO(Thad) Figure this out
+  return GetDigitalFilterSelect(port->channel);
 }
 
 /**
@@ -344,7 +414,11 @@ int32_t HAL_GetFilterSelect(HAL_DigitalHandle dioPortHandle, int32_t* status) {
  * counted as a transition.
  */
 void HAL_SetFilterPeriod(int32_t filterIndex, int64_t value, int32_t* status) {
-  // TODO(Thad) figure this out
+  if (filterIndex < 0 || filterIndex > 2) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  SetDigitalFilterPeriod(filterIndex, value);
 }
 
 /**
@@ -360,6 +434,10 @@ void HAL_SetFilterPeriod(int32_t filterIndex, int64_t value, int32_t* status) {
  * counted as a transition.
  */
 int64_t HAL_GetFilterPeriod(int32_t filterIndex, int32_t* status) {
-  return 0;  // TODO(Thad) figure this out
+  if (filterIndex < 0 || filterIndex > 2) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return 0;
+  }
+  return GetDigitalFilterPeriod(filterIndex);
 }
 }  // extern "C"
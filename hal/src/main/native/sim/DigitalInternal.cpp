@@ -15,16 +15,13 @@
 
 namespace hal {
 
-DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                      kNumDigitalChannels + kNumPWMHeaders>*
+SimContextLocal<DigitalHandleResource<
+    HAL_DigitalHandle, DigitalPort, kNumDigitalChannels + kNumPWMHeaders>>
     digitalChannelHandles;
 
 namespace init {
 void InitializeDigitalInternal() {
-  static DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                               kNumDigitalChannels + kNumPWMHeaders>
-      dcH;
-  digitalChannelHandles = &dcH;
+  digitalChannelHandles.Initialize();
 }
 }  // namespace init
 
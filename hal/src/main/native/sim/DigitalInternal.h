@@ -17,6 +17,7 @@
 #include "HAL/handles/DigitalHandleResource.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 namespace hal {
 /**
@@ -66,8 +67,8 @@ struct DigitalPort {
   int32_t minPwm = 0;
 };
 
-extern DigitalHandleResource<HAL_DigitalHandle, DigitalPort,
-                             kNumDigitalChannels + kNumPWMHeaders>*
+extern SimContextLocal<DigitalHandleResource<
+    HAL_DigitalHandle, DigitalPort, kNumDigitalChannels + kNumPWMHeaders>>
     digitalChannelHandles;
 
 bool remapDigitalSource(HAL_Handle digitalSourceHandle,
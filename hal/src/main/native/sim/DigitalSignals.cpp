@@ -0,0 +1,470 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "DigitalSignalsInternal.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ConstantsInternal.h"
+#include "HAL/Errors.h"
+#include "HAL/Notifier.h"
+#include "HAL/handles/HandlesInternal.h"
+#include "MockData/AnalogInDataInternal.h"
+#include "MockData/AnalogTriggerDataInternal.h"
+#include "MockData/DIODataInternal.h"
+#include "MockData/SimContext.h"
+#include "MockHooksInternal.h"
+#include "PortsInternal.h"
+#include "SimContextInternal.h"
+
+using namespace hal;
+
+static constexpr int32_t kNumFilters = 3;
+// Each analog trigger has an in window, a state and two pulse outputs
+static constexpr int32_t kTriggerOutputs = 4;
+
+namespace {
+struct Listener {
+  int32_t uid;
+  // DIO channels come first, then the outputs of each analog trigger
+  int32_t signal;
+  SignalCallback callback;
+  void* param;
+  bool underLock;
+};
+
+// A listener call made once the lock is released
+struct DeferredCall {
+  SignalCallback callback;
+  void* param;
+  bool value;
+  uint64_t time;
+};
+typedef std::vector<DeferredCall> DeferredCalls;
+
+struct DigitalInput {
+  // 0 for none, or the filter number plus 1
+  int32_t filterSelect = 0;
+  // The filtered value, while a filter is selected
+  bool value = false;
+  // The input differs from the value, which changes at the deadline
+  bool pending = false;
+  uint64_t deadline = 0;
+};
+
+struct TriggerSignals {
+  int32_t analogChannel = -1;
+  bool inWindow = false;
+  bool state = false;
+};
+
+struct Signals {
+  wpi::mutex mutex;
+  DigitalInput inputs[kNumDigitalChannels];
+  // In FPGA cycles
+  int64_t filterPeriods[kNumFilters] = {0, 0, 0};
+  TriggerSignals triggers[kNumAnalogTriggers];
+  std::vector<Listener> listeners;
+  int32_t nextUid = 0;
+  // Wakes up the thread passing on filtered edges at their time
+  HAL_NotifierHandle notifier = HAL_kInvalidHandle;
+  std::thread thread;
+
+  // The notifiers of a context are destroyed first, which ends the thread
+  ~Signals() {
+    if (thread.joinable()) thread.join();
+  }
+};
+}  // namespace
+
+static SimContextLocal<Signals> signals;
+
+namespace hal {
+namespace init {
+void InitializeDigitalSignals() { signals.Initialize(); }
+}  // namespace init
+}  // namespace hal
+
+static int32_t GetSignalIndex(HAL_Handle source, HAL_AnalogTriggerType type,
+                              int32_t* status) {
+  int32_t index = getHandleIndex(source);
+  if (isHandleType(source, HAL_HandleEnum::AnalogTrigger)) {
+    if (index < 0 || index >= kNumAnalogTriggers) {
+      *status = HAL_HANDLE_ERROR;
+      return -1;
+    }
+    if (type < HAL_Trigger_kInWindow || type > HAL_Trigger_kFallingPulse) {
+      *status = PARAMETER_OUT_OF_RANGE;
+      return -1;
+    }
+    return kNumDigitalChannels + index * kTriggerOutputs + type;
+  } else if (isHandleType(source, HAL_HandleEnum::DIO)) {
+    if (index < 0 || index >= kNumDigitalChannels) {
+      *status = HAL_HANDLE_ERROR;
+      return -1;
+    }
+    return index;
+  }
+  *status = HAL_HANDLE_ERROR;
+  return -1;
+}
+
+static void Emit(Signals& s, int32_t signal, bool value, uint64_t time,
+                 DeferredCalls* deferred) {
+  for (const auto& listener : s.listeners) {
+    if (listener.signal != signal) continue;
+    if (listener.underLock) {
+      listener.callback(listener.param, value, time);
+    } else {
+      deferred->push_back(
+          DeferredCall{listener.callback, listener.param, value, time});
+    }
+  }
+}
+
+static void RunDeferred(const DeferredCalls& deferred) {
+  for (const auto& call : deferred) {
+    call.callback(call.param, call.value, call.time);
+  }
+}
+
+static uint64_t GetFilterPeriodMicros(const Signals& s, int32_t filterSelect) {
+  int64_t cycles = s.filterPeriods[filterSelect - 1];
+  if (cycles <= 0) return 0;
+  return (cycles + kSystemClockTicksPerMicrosecond - 1) /
+         kSystemClockTicksPerMicrosecond;
+}
+
+// s.mutex must be held
+static bool GetFilteredValueLocked(const Signals& s, int32_t channel) {
+  const DigitalInput& input = s.inputs[channel];
+  if (input.filterSelect == 0) return SimDIOData[channel].GetValue();
+  return input.value;
+}
+
+// Passes on the filtered edges due by now, in time order
+static void SettleLocked(Signals& s, uint64_t now, DeferredCalls* deferred) {
+  for (;;) {
+    int32_t next = -1;
+    for (int32_t i = 0; i < kNumDigitalChannels; i++) {
+      const DigitalInput& input = s.inputs[i];
+      if (!input.pending || input.deadline > now) continue;
+      if (next < 0 || input.deadline < s.inputs[next].deadline) next = i;
+    }
+    if (next < 0) return;
+    DigitalInput& input = s.inputs[next];
+    input.pending = false;
+    input.value = !input.value;
+    Emit(s, next, input.value, input.deadline, deferred);
+  }
+}
+
+static void RunFilterThread(HAL_NotifierHandle notifier);
+
+// Sets the alarm for the next filtered edge
+static void ScheduleLocked(Signals& s) {
+  bool any = false;
+  uint64_t next = 0;
+  for (const auto& input : s.inputs) {
+    if (!input.pending) continue;
+    if (!any || input.deadline < next) next = input.deadline;
+    any = true;
+  }
+  if (!any) return;
+
+  int32_t status = 0;
+  if (s.notifier == HAL_kInvalidHandle) {
+    s.notifier = HAL_InitializeNotifier(&status);
+    if (status != 0) {
+      s.notifier = HAL_kInvalidHandle;
+      return;
+    }
+    // The thread passes on this context's edges
+    if (s.thread.joinable()) s.thread.join();
+    HALSIM_Context* context = HALSIM_GetThreadContext();
+    HAL_NotifierHandle notifierHandle = s.notifier;
+    s.thread = std::thread([=] {
+      HALSIM_SetThreadContext(context);
+      RunFilterThread(notifierHandle);
+    });
+  }
+  HAL_UpdateNotifierAlarm(s.notifier, next, &status);
+}
+
+static void RunFilterThread(HAL_NotifierHandle notifier) {
+  auto& s = *signals;
+  DeferredCalls deferred;
+  for (;;) {
+    int32_t status = 0;
+    uint64_t curTime = HAL_WaitForNotifierAlarm(notifier, &status);
+    if (curTime == 0 || status != 0) {
+      std::lock_guard<wpi::mutex> lock(s.mutex);
+      s.notifier = HAL_kInvalidHandle;
+      return;
+    }
+
+    deferred.clear();
+    {
+      std::lock_guard<wpi::mutex> lock(s.mutex);
+      SettleLocked(s, curTime, &deferred);
+      ScheduleLocked(s);
+    }
+    RunDeferred(deferred);
+  }
+}
+
+// Applies a change of a DIO input to its filter
+static void ApplyInputLocked(Signals& s, int32_t channel, bool value,
+                             uint64_t now, DeferredCalls* deferred) {
+  DigitalInput& input = s.inputs[channel];
+  if (input.filterSelect == 0) {
+    Emit(s, channel, value, now, deferred);
+    return;
+  }
+  if (value == input.value) {
+    // Back before the period passed, so the pulse is dropped
+    input.pending = false;
+    return;
+  }
+  uint64_t period = GetFilterPeriodMicros(s, input.filterSelect);
+  if (period == 0) {
+    input.value = value;
+    Emit(s, channel, value, now, deferred);
+    return;
+  }
+  input.pending = true;
+  input.deadline = now + period;
+}
+
+static void ComputeTrigger(int32_t index, const TriggerSignals& trigger,
+                           bool* inWindow, bool* state) {
+  *inWindow = false;
+  *state = trigger.state;
+  if (trigger.analogChannel < 0) return;
+  double voltage = SimAnalogInData[trigger.analogChannel].GetVoltage();
+  double lower = SimAnalogTriggerData[index].GetTriggerLowerBound();
+  double upper = SimAnalogTriggerData[index].GetTriggerUpperBound();
+  *inWindow = voltage >= lower && voltage <= upper;
+  // The state only changes once the voltage leaves the window
+  if (voltage < lower) *state = false;
+  if (voltage > upper) *state = true;
+}
+
+static void UpdateTriggerLocked(Signals& s, int32_t index, uint64_t now,
+                                DeferredCalls* deferred) {
+  TriggerSignals& trigger = s.triggers[index];
+  bool inWindow;
+  bool state;
+  ComputeTrigger(index, trigger, &inWindow, &state);
+  int32_t base = kNumDigitalChannels + index * kTriggerOutputs;
+  if (inWindow != trigger.inWindow) {
+    trigger.inWindow = inWindow;
+    Emit(s, base + HAL_Trigger_kInWindow, inWindow, now, deferred);
+  }
+  if (state != trigger.state) {
+    trigger.state = state;
+    Emit(s, base + HAL_Trigger_kState, state, now, deferred);
+    int32_t pulse = base + (state ? HAL_Trigger_kRisingPulse
+                                  : HAL_Trigger_kFallingPulse);
+    Emit(s, pulse, true, now, deferred);
+    Emit(s, pulse, false, now, deferred);
+  }
+}
+
+namespace hal {
+
+std::unique_lock<wpi::mutex> LockSignals() {
+  auto& s = *signals;
+  std::unique_lock<wpi::mutex> lock(s.mutex);
+  DeferredCalls deferred;
+  for (;;) {
+    SettleLocked(s, GetFPGATime(), &deferred);
+    if (deferred.empty()) return lock;
+    lock.unlock();
+    RunDeferred(deferred);
+    deferred.clear();
+    lock.lock();
+  }
+}
+
+int32_t AddSignalListenerLocked(HAL_Handle source, HAL_AnalogTriggerType type,
+                                SignalCallback callback, void* param,
+                                bool underLock, int32_t* status) {
+  int32_t signal = GetSignalIndex(source, type, status);
+  if (signal < 0) return -1;
+  auto& s = *signals;
+  int32_t uid = s.nextUid++;
+  s.listeners.push_back(Listener{uid, signal, callback, param, underLock});
+  return uid;
+}
+
+int32_t AddSignalListener(HAL_Handle source, HAL_AnalogTriggerType type,
+                          SignalCallback callback, void* param,
+                          bool underLock, int32_t* status) {
+  std::lock_guard<wpi::mutex> lock(signals->mutex);
+  return AddSignalListenerLocked(source, type, callback, param, underLock,
+                                 status);
+}
+
+void RemoveSignalListenerLocked(int32_t uid) {
+  if (uid < 0) return;
+  auto& listeners = signals->listeners;
+  listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                                 [=](const Listener& listener) {
+                                   return listener.uid == uid;
+                                 }),
+                  listeners.end());
+}
+
+void RemoveSignalListener(int32_t uid) {
+  std::lock_guard<wpi::mutex> lock(signals->mutex);
+  RemoveSignalListenerLocked(uid);
+}
+
+bool GetSignalValueLocked(HAL_Handle source, HAL_AnalogTriggerType type,
+                          int32_t* status) {
+  int32_t signal = GetSignalIndex(source, type, status);
+  if (signal < 0) return false;
+  if (signal < kNumDigitalChannels) {
+    return GetFilteredValueLocked(*signals, signal);
+  }
+  signal -= kNumDigitalChannels;
+  const TriggerSignals& trigger = signals->triggers[signal / kTriggerOutputs];
+  switch (signal % kTriggerOutputs) {
+    case HAL_Trigger_kInWindow:
+      return trigger.inWindow;
+    case HAL_Trigger_kState:
+      return trigger.state;
+    default:
+      // Pulses are over as soon as they start
+      return false;
+  }
+}
+
+bool GetSignalValue(HAL_Handle source, HAL_AnalogTriggerType type,
+                    int32_t* status) {
+  auto lock = LockSignals();
+  return GetSignalValueLocked(source, type, status);
+}
+
+bool GetFilteredDigitalValue(int32_t channel) {
+  auto lock = LockSignals();
+  return GetFilteredValueLocked(*signals, channel);
+}
+
+void SetDigitalFilterSelect(int32_t channel, int32_t filterIndex) {
+  if (channel < 0 || channel >= kNumDigitalChannels) return;
+  auto& s = *signals;
+  DeferredCalls deferred;
+  {
+    std::lock_guard<wpi::mutex> lock(s.mutex);
+    uint64_t now = GetFPGATime();
+    SettleLocked(s, now, &deferred);
+    DigitalInput& input = s.inputs[channel];
+    bool value = GetFilteredValueLocked(s, channel);
+    input.filterSelect = filterIndex;
+    input.value = value;
+    input.pending = false;
+    // An input that changed while filtered reaches the new filter now
+    bool raw = SimDIOData[channel].GetValue();
+    if (raw != value) ApplyInputLocked(s, channel, raw, now, &deferred);
+    ScheduleLocked(s);
+  }
+  RunDeferred(deferred);
+}
+
+void ResetDigitalFilter(int32_t channel) {
+  if (channel < 0 || channel >= kNumDigitalChannels) return;
+  auto& s = *signals;
+  std::lock_guard<wpi::mutex> lock(s.mutex);
+  s.inputs[channel] = DigitalInput{};
+}
+
+int32_t GetDigitalFilterSelect(int32_t channel) {
+  if (channel < 0 || channel >= kNumDigitalChannels) return 0;
+  auto& s = *signals;
+  std::lock_guard<wpi::mutex> lock(s.mutex);
+  return s.inputs[channel].filterSelect;
+}
+
+void SetDigitalFilterPeriod(int32_t filterIndex, int64_t cycles) {
+  if (filterIndex < 0 || filterIndex >= kNumFilters) return;
+  auto& s = *signals;
+  std::lock_guard<wpi::mutex> lock(s.mutex);
+  s.filterPeriods[filterIndex] = cycles;
+}
+
+int64_t GetDigitalFilterPeriod(int32_t filterIndex) {
+  if (filterIndex < 0 || filterIndex >= kNumFilters) return 0;
+  auto& s = *signals;
+  std::lock_guard<wpi::mutex> lock(s.mutex);
+  return s.filterPeriods[filterIndex];
+}
+
+void SetAnalogTriggerInput(int32_t index, int32_t analogChannel) {
+  if (index < 0 || index >= kNumAnalogTriggers) return;
+  auto& s = *signals;
+  std::lock_guard<wpi::mutex> lock(s.mutex);
+  TriggerSignals& trigger = s.triggers[index];
+  trigger = TriggerSignals{};
+  trigger.analogChannel = analogChannel;
+  ComputeTrigger(index, trigger, &trigger.inWindow, &trigger.state);
+}
+
+void UpdateAnalogTrigger(int32_t index) {
+  if (index < 0 || index >= kNumAnalogTriggers) return;
+  auto& s = *signals;
+  DeferredCalls deferred;
+  {
+    std::lock_guard<wpi::mutex> lock(s.mutex);
+    UpdateTriggerLocked(s, index, GetFPGATime(), &deferred);
+  }
+  RunDeferred(deferred);
+}
+
+bool GetAnalogTriggerSignal(int32_t index, HAL_AnalogTriggerType type) {
+  if (index < 0 || index >= kNumAnalogTriggers) return false;
+  auto& s = *signals;
+  std::lock_guard<wpi::mutex> lock(s.mutex);
+  if (type == HAL_Trigger_kInWindow) return s.triggers[index].inWindow;
+  if (type == HAL_Trigger_kState) return s.triggers[index].state;
+  return false;
+}
+
+void DigitalInputChanged(int32_t channel, bool value) {
+  if (channel < 0 || channel >= kNumDigitalChannels) return;
+  auto& s = *signals;
+  DeferredCalls deferred;
+  {
+    std::lock_guard<wpi::mutex> lock(s.mutex);
+    uint64_t now = GetFPGATime();
+    SettleLocked(s, now, &deferred);
+    ApplyInputLocked(s, channel, value, now, &deferred);
+    ScheduleLocked(s);
+  }
+  RunDeferred(deferred);
+}
+
+void AnalogInputChanged(int32_t channel) {
+  auto& s = *signals;
+  DeferredCalls deferred;
+  {
+    std::lock_guard<wpi::mutex> lock(s.mutex);
+    uint64_t now = GetFPGATime();
+    for (int32_t i = 0; i < kNumAnalogTriggers; i++) {
+      if (s.triggers[i].analogChannel == channel) {
+        UpdateTriggerLocked(s, i, now, &deferred);
+      }
+    }
+  }
+  RunDeferred(deferred);
+}
+
+}  // namespace hal
@@ -0,0 +1,89 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <mutex>
+
+#include <support/mutex.h>
+
+#include "HAL/AnalogTrigger.h"
+#include "HAL/Types.h"
+
+/*
+ * The digital signals the FPGA routes to counters and interrupts: DIO inputs
+ * after their glitch filter, and analog trigger outputs. Inputs set through
+ * the sim data are processed here on the simulated clock, and each edge is
+ * passed straight to the listeners of its signal with its simulated time.
+ *
+ * A filtered input only changes once it has held its new value for the
+ * filter period; shorter pulses are dropped. Analog trigger states are
+ * updated on every change of their input voltage.
+ */
+
+namespace hal {
+
+// Called with the new value of a signal and the FPGA time it changed at, in
+// microseconds. Pulse outputs of analog triggers give a rising and a falling
+// edge at the same time.
+typedef void (*SignalCallback)(void* param, bool value, uint64_t time);
+
+/**
+ * Locks the signals, after passing on filtered edges that are due. Listeners
+ * added with underLock run with the lock held, so state they update can be
+ * read consistently while holding it. Listeners must not lock the signals.
+ */
+std::unique_lock<wpi::mutex> LockSignals();
+
+/**
+ * Adds a listener to a DIO handle, or an output of an analog trigger handle,
+ * as counters and interrupts take their sources. Listeners run on the thread
+ * that changed the input, or the thread passing on filtered edges. Listeners
+ * that aren't run under the lock run after it is released, and may still be
+ * called once after they are removed.
+ *
+ * @return The uid of the listener, or -1 with status set if the source is
+ *         invalid.
+ */
+int32_t AddSignalListener(HAL_Handle source, HAL_AnalogTriggerType type,
+                          SignalCallback callback, void* param,
+                          bool underLock, int32_t* status);
+void RemoveSignalListener(int32_t uid);
+
+// The value of a source, as its listeners see it
+bool GetSignalValue(HAL_Handle source, HAL_AnalogTriggerType type,
+                    int32_t* status);
+
+// The same, with the lock from LockSignals() held
+int32_t AddSignalListenerLocked(HAL_Handle source, HAL_AnalogTriggerType type,
+                                SignalCallback callback, void* param,
+                                bool underLock, int32_t* status);
+void RemoveSignalListenerLocked(int32_t uid);
+bool GetSignalValueLocked(HAL_Handle source, HAL_AnalogTriggerType type,
+                          int32_t* status);
+bool GetFilteredDigitalValue(int32_t channel);
+
+// Glitch filters; see HAL_SetFilterSelect() and HAL_SetFilterPeriod()
+void SetDigitalFilterSelect(int32_t channel, int32_t filterIndex);
+void ResetDigitalFilter(int32_t channel);
+int32_t GetDigitalFilterSelect(int32_t channel);
+void SetDigitalFilterPeriod(int32_t filterIndex, int64_t cycles);
+int64_t GetDigitalFilterPeriod(int32_t filterIndex);
+
+// Analog triggers; the input is -1 while the trigger is unused
+void SetAnalogTriggerInput(int32_t index, int32_t analogChannel);
+// Reevaluates a trigger, as after its limits change
+void UpdateAnalogTrigger(int32_t index);
+bool GetAnalogTriggerSignal(int32_t index, HAL_AnalogTriggerType type);
+
+// Called by the sim data when an input changes
+void DigitalInputChanged(int32_t channel, bool value);
+void AnalogInputChanged(int32_t channel);
+
+}  // namespace hal
@@ -21,18 +21,23 @@
 
 #include "MockData/DriverStationDataInternal.h"
 #include "MockData/MockHooks.h"
+#include "SimContextInternal.h"
 
 static wpi::mutex msgMutex;
-static wpi::condition_variable* newDSDataAvailableCond;
-static wpi::mutex newDSDataAvailableMutex;
-static int newDSDataAvailableCounter{0};
+
+namespace {
+struct NewDSData {
+  wpi::mutex mutex;
+  wpi::condition_variable cond;
+  int counter = 0;
+};
+}  // namespace
+
+static hal::SimContextLocal<NewDSData> newDSData;
 
 namespace hal {
 namespace init {
-void InitializeDriverStation() {
-  static wpi::condition_variable nddaC;
-  newDSDataAvailableCond = &nddaC;
-}
+void InitializeDriverStation() { newDSData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
@@ -94,12 +99,7 @@ int32_t HAL_SendError(HAL_Bool isError, int32_t errorCode, HAL_Bool isLVCode,
 }
 
 int32_t HAL_GetControlWord(HAL_ControlWord* controlWord) {
-  controlWord->enabled = SimDriverStationData->GetEnabled();
-  controlWord->autonomous = SimDriverStationData->GetAutonomous();
-  controlWord->test = SimDriverStationData->GetTest();
-  controlWord->eStop = SimDriverStationData->GetEStop();
-  controlWord->fmsAttached = SimDriverStationData->GetFmsAttached();
-  controlWord->dsAttached = SimDriverStationData->GetDsAttached();
+  SimDriverStationData->GetControlWord(controlWord);
   return 0;
 }
 
@@ -186,6 +186,11 @@ void HAL_FreeMatchInfo(HAL_MatchInfo* info) {
   SimDriverStationData->FreeMatchInfo(info);
 }
 
+int32_t HAL_GetInlineMatchInfo(HAL_InlineMatchInfo* info) {
+  SimDriverStationData->GetInlineMatchInfo(info);
+  return 0;
+}
+
 void HAL_ObserveUserProgramStarting(void) { HALSIM_SetProgramStarted(); }
 
 void HAL_ObserveUserProgramDisabled(void) {
@@ -232,8 +237,8 @@ bool HAL_IsNewControlData(void) {
   // worth the cycles to check.
   int currentCount = 0;
   {
-    std::unique_lock<wpi::mutex> lock(newDSDataAvailableMutex);
-    currentCount = newDSDataAvailableCounter;
+    std::unique_lock<wpi::mutex> lock(newDSData->mutex);
+    currentCount = newDSData->counter;
   }
   if (lastCount == currentCount) return false;
   lastCount = currentCount;
@@ -254,16 +259,17 @@ HAL_Bool HAL_WaitForDSDataTimeout(double timeout) {
   auto timeoutTime =
       std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
 
-  std::unique_lock<wpi::mutex> lock(newDSDataAvailableMutex);
-  int currentCount = newDSDataAvailableCounter;
-  while (newDSDataAvailableCounter == currentCount) {
+  NewDSData& data = *newDSData;
+  std::unique_lock<wpi::mutex> lock(data.mutex);
+  int currentCount = data.counter;
+  while (data.counter == currentCount) {
     if (timeout > 0) {
-      auto timedOut = newDSDataAvailableCond->wait_until(lock, timeoutTime);
+      auto timedOut = data.cond.wait_until(lock, timeoutTime);
       if (timedOut == std::cv_status::timeout) {
         return false;
       }
     } else {
-      newDSDataAvailableCond->wait(lock);
+      data.cond.wait(lock);
     }
   }
   return true;
@@ -276,10 +282,11 @@ static int32_t newDataOccur(uint32_t refNum) {
   // Since we could get other values, require our specific handle
   // to signal our threads
   if (refNum != refNumber) return 0;
-  std::lock_guard<wpi::mutex> lock(newDSDataAvailableMutex);
+  NewDSData& data = *newDSData;
+  std::lock_guard<wpi::mutex> lock(data.mutex);
   // Nofify all threads
-  newDSDataAvailableCounter++;
-  newDSDataAvailableCond->notify_all();
+  data.counter++;
+  data.cond.notify_all();
   return 0;
 }
 
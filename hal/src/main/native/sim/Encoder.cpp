@@ -7,13 +7,17 @@
 
 #include "HAL/Encoder.h"
 
+#include <atomic>
+
 #include "CounterInternal.h"
 #include "HAL/Counter.h"
 #include "HAL/Errors.h"
+#include "HAL/HAL.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HAL/handles/LimitedHandleResource.h"
 #include "MockData/EncoderDataInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 using namespace hal;
 
@@ -22,34 +26,38 @@ struct Encoder {
   HAL_Handle nativeHandle;
   HAL_EncoderEncodingType encodingType;
   double distancePerPulse;
+  HAL_EncoderVelocityEstimatorType velocityEstimator;
   uint8_t index;
 };
 struct Empty {};
 }  // namespace
 
-static LimitedHandleResource<HAL_EncoderHandle, Encoder,
-                             kNumEncoders + kNumCounters,
-                             HAL_HandleEnum::Encoder>* encoderHandles;
+static SimContextLocal<LimitedHandleResource<
+    HAL_EncoderHandle, Encoder, kNumEncoders + kNumCounters,
+    HAL_HandleEnum::Encoder>>
+    encoderHandles;
 
-static LimitedHandleResource<HAL_FPGAEncoderHandle, Empty, kNumEncoders,
-                             HAL_HandleEnum::FPGAEncoder>* fpgaEncoderHandles;
+static SimContextLocal<LimitedHandleResource<
+    HAL_FPGAEncoderHandle, Empty, kNumEncoders, HAL_HandleEnum::FPGAEncoder>>
+    fpgaEncoderHandles;
 
 namespace hal {
 namespace init {
 void InitializeEncoder() {
-  static LimitedHandleResource<HAL_FPGAEncoderHandle, Empty, kNumEncoders,
-                               HAL_HandleEnum::FPGAEncoder>
-      feH;
-  fpgaEncoderHandles = &feH;
-  static LimitedHandleResource<HAL_EncoderHandle, Encoder,
-                               kNumEncoders + kNumCounters,
-                               HAL_HandleEnum::Encoder>
-      eH;
-  encoderHandles = &eH;
+  fpgaEncoderHandles.Initialize();
+  encoderHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
 
+static std::atomic<double> velocityUpdatePeriod{0.005};
+
+// The DIO channel of an encoder source, or -1 if it isn't a DIO
+static int32_t GetDigitalChannel(HAL_Handle handle) {
+  if (!isHandleType(handle, HAL_HandleEnum::DIO)) return -1;
+  return getHandleIndex(handle);
+}
+
 extern "C" {
 HAL_EncoderHandle HAL_InitializeEncoder(
     HAL_Handle digitalSourceHandleA, HAL_AnalogTriggerType analogTriggerTypeA,
@@ -79,12 +87,16 @@ HAL_EncoderHandle HAL_InitializeEncoder(
     return HAL_kInvalidHandle;
   }
   int16_t index = getHandleIndex(handle);
+  SimEncoderData[index].SetDigitalChannels(
+      GetDigitalChannel(digitalSourceHandleA),
+      GetDigitalChannel(digitalSourceHandleB));
   SimEncoderData[index].SetInitialized(true);
   // TODO: Add encoding type to Sim data
   encoder->index = index;
   encoder->nativeHandle = nativeHandle;
   encoder->encodingType = encodingType;
   encoder->distancePerPulse = 1.0;
+  encoder->velocityEstimator = HAL_EncoderVelocity_kPeriod;
   return handle;
 }
 
@@ -338,4 +350,76 @@ HAL_EncoderEncodingType HAL_GetEncoderEncodingType(
 
   return encoder->encodingType;
 }
+
+void HAL_GetEncoderSnapshot(HAL_EncoderHandle encoderHandle,
+                            HAL_EncoderSnapshot* snapshot, int32_t* status) {
+  auto encoder = encoderHandles->Get(encoderHandle);
+  if (encoder == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+
+  auto& data = SimEncoderData[encoder->index];
+  snapshot->count = data.GetCount();
+  snapshot->raw = snapshot->count / DecodingScaleFactor(encoder.get());
+  snapshot->distance = snapshot->count * encoder->distancePerPulse;
+  snapshot->period = data.GetPeriod();
+  snapshot->rate = encoder->distancePerPulse / snapshot->period;
+  snapshot->direction = data.GetDirection();
+  snapshot->stopped = snapshot->period > data.GetMaxPeriod();
+  snapshot->timestamp = HAL_GetFPGATime(status);
+}
+
+// The simulator has no sampled counts to estimate from, so the estimator type
+// is only recorded and estimates come from the simulated period.
+void HAL_SetEncoderVelocityEstimator(HAL_EncoderHandle encoderHandle,
+                                     HAL_EncoderVelocityEstimatorType type,
+                                     int32_t windowSize, int32_t* status) {
+  auto encoder = encoderHandles->Get(encoderHandle);
+  if (encoder == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (type < HAL_EncoderVelocity_kPeriod ||
+      type > HAL_EncoderVelocity_kAdaptiveWindow ||
+      (type != HAL_EncoderVelocity_kPeriod &&
+       (windowSize < 2 || windowSize > HAL_kMaxEncoderVelocityWindow))) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  encoder->velocityEstimator = type;
+}
+HAL_EncoderVelocityEstimatorType HAL_GetEncoderVelocityEstimator(
+    HAL_EncoderHandle encoderHandle, int32_t* status) {
+  auto encoder = encoderHandles->Get(encoderHandle);
+  if (encoder == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return HAL_EncoderVelocity_kPeriod;
+  }
+  return encoder->velocityEstimator;
+}
+void HAL_SetEncoderVelocityUpdatePeriod(double period, int32_t* status) {
+  if (period < 0.001 || period > 0.1) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  velocityUpdatePeriod = period;
+}
+double HAL_GetEncoderVelocityUpdatePeriod(void) { return velocityUpdatePeriod; }
+void HAL_GetEncoderVelocityEstimate(HAL_EncoderHandle encoderHandle,
+                                    double* velocity, double* acceleration,
+                                    int32_t* status) {
+  auto encoder = encoderHandles->Get(encoderHandle);
+  if (encoder == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (encoder->velocityEstimator == HAL_EncoderVelocity_kPeriod) {
+    *status = INCOMPATIBLE_STATE;
+    return;
+  }
+  *velocity =
+      encoder->distancePerPulse / SimEncoderData[encoder->index].GetPeriod();
+  *acceleration = 0.0;
+}
 }  // extern "C"
@@ -7,10 +7,18 @@
 
 #include "HAL/Extensions.h"
 
+#include <memory>
+#include <mutex>
+
 #include <llvm/SmallString.h>
 #include <llvm/StringRef.h>
 
+#include "ExtensionsInternal.h"
 #include "HAL/HAL.h"
+#include "HAL/SimExtension.h"
+#include "MockData/EncoderDataInternal.h"
+#include "MockData/NotifyCallbackHelpers.h"
+#include "MockData/PWMDataInternal.h"
 
 #if defined(WIN32) || defined(_WIN32)
 #include <windows.h>
@@ -33,12 +41,88 @@
 #define DLCLOSE dlclose
 #endif
 
+namespace {
+typedef hal::HalCallbackListenerVectorImpl<hal::sim::StepCallback>
+    StepListenerVector;
+
+class ExtensionHostImpl : public hal::sim::ExtensionHost {
+ public:
+  int32_t GetApiVersion() const override {
+    return hal::sim::kExtensionApiVersion;
+  }
+  hal::sim::DeviceTables GetDeviceTables() const override;
+  int32_t RegisterStepCallback(hal::sim::StepCallback callback,
+                               void* param) override;
+  void CancelStepCallback(int32_t uid) override;
+
+  void InvokeStepCallbacks(uint64_t time);
+
+ private:
+  // Extensions are loaded once per process, so unlike device data the step
+  // callbacks are shared by every context
+  wpi::mutex m_registerMutex;
+  hal::AtomicListenerVector<StepListenerVector> m_stepCallbacks;
+};
+}  // namespace
+
+hal::sim::DeviceTables ExtensionHostImpl::GetDeviceTables() const {
+  hal::sim::DeviceTables tables;
+  tables.pwmSpeeds = hal::SimPWMData.GetHot().speed;
+  tables.numPWMChannels = hal::kNumPWMChannels;
+  tables.encoderCounts = hal::SimEncoderData.GetHot().count;
+  tables.numEncoders = hal::kNumEncoders;
+  return tables;
+}
+
+int32_t ExtensionHostImpl::RegisterStepCallback(
+    hal::sim::StepCallback callback, void* param) {
+  // Must return -1 on a null callback for error handling
+  if (callback == nullptr) return -1;
+  int32_t newUid = 0;
+  std::lock_guard<wpi::mutex> lock(m_registerMutex);
+  m_stepCallbacks = RegisterCallbackImpl<StepListenerVector>(
+      m_stepCallbacks, "Step", callback, param, &newUid);
+  return newUid;
+}
+
+void ExtensionHostImpl::CancelStepCallback(int32_t uid) {
+  std::lock_guard<wpi::mutex> lock(m_registerMutex);
+  std::shared_ptr<StepListenerVector> callbacks = m_stepCallbacks;
+  if (!callbacks) return;
+  m_stepCallbacks =
+      CancelCallbackImpl<StepListenerVector, hal::sim::StepCallback>(callbacks,
+                                                                     uid);
+}
+
+void ExtensionHostImpl::InvokeStepCallbacks(uint64_t time) {
+  hal::AtomicListenerVector<StepListenerVector>::Reader callbacks(
+      m_stepCallbacks);
+  if (!callbacks) return;
+  for (size_t i = 0; i < callbacks->size(); ++i) {
+    auto& listener = (*callbacks)[i];
+    if (!listener) continue;  // removed
+    listener.callback(listener.param, time);
+  }
+}
+
+static ExtensionHostImpl& GetHostImpl() {
+  // Never destroyed, since extensions may use it until the process exits
+  static ExtensionHostImpl* host = new ExtensionHostImpl;
+  return *host;
+}
+
 namespace hal {
 namespace init {
 void InitializeExtensions() {}
 }  // namespace init
+
+void InvokeStepCallbacks(uint64_t time) {
+  GetHostImpl().InvokeStepCallbacks(time);
+}
 }  // namespace hal
 
+hal::sim::ExtensionHost& hal::sim::GetExtensionHost() { return GetHostImpl(); }
+
 extern "C" {
 
 int HAL_LoadOneExtension(const char* library) {
@@ -58,10 +142,16 @@ int HAL_LoadOneExtension(const char* library) {
 #endif
   if (!handle) return rc;
 
+  auto initCpp = reinterpret_cast<halsim_extension_init_cpp_func_t*>(
+      DLSYM(handle, "HALSIM_InitExtensionCpp"));
   auto init = reinterpret_cast<halsim_extension_init_func_t*>(
       DLSYM(handle, "HALSIM_InitExtension"));
 
-  if (init) rc = (*init)();
+  if (initCpp) {
+    rc = (*initCpp)(hal::sim::kExtensionApiVersion, &hal::sim::GetExtensionHost());
+  } else if (init) {
+    rc = (*init)();
+  }
 
   if (rc != 0) DLCLOSE(handle);
   return rc;
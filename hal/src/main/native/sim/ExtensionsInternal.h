@@ -1,5 +1,5 @@
 /*----------------------------------------------------------------------------*/
-/* Copyright (c) 2017-2018 FIRST. All Rights Reserved.                        */
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
 /* Open Source Software - may be modified and shared by FRC teams. The code   */
 /* must be accompanied by the FIRST BSD license file in the root directory of */
 /* the project.                                                               */
@@ -7,13 +7,9 @@
 
 #pragma once
 
-#include "HALSimPrint.h"
+#include <stdint.h>
 
-class PrintPWM {
- public:
-  explicit PrintPWM(int port);
-  void Publish(double value);
-
- private:
-  int m_port;
-};
+namespace hal {
+// Runs the step callbacks registered by extensions
+void InvokeStepCallbacks(uint64_t time);
+}  // namespace hal
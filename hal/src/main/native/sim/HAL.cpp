@@ -24,12 +24,14 @@ namespace hal {
 namespace init {
 void InitializeHAL() {
   InitializeHandlesInternal();
+  InitializeSimContext();
   InitializeAccelerometerData();
   InitializeAnalogGyroData();
   InitializeAnalogInData();
   InitializeAnalogOutData();
   InitializeAnalogTriggerData();
   InitializeCanData();
+  InitializeChangeBatchData();
   InitializeDigitalPWMData();
   InitializeDIOData();
   InitializeDriverStationData();
@@ -48,16 +50,19 @@ void InitializeHAL() {
   InitializeAnalogInput();
   InitializeAnalogInternal();
   InitializeAnalogOutput();
+  InitializeAnalogTrigger();
   InitializeCAN();
   InitializeCompressor();
   InitializeConstants();
   InitializeCounter();
   InitializeDigitalInternal();
+  InitializeDigitalSignals();
   InitializeDIO();
   InitializeDriverStation();
   InitializeEncoder();
   InitializeExtensions();
   InitializeI2C();
+  InitializeIORecording();
   InitializeInterrupts();
   InitializeMockHooks();
   InitializeNotifier();
@@ -151,6 +156,10 @@ const char* HAL_GetErrorMessage(int32_t code) {
       return HAL_INVALID_ACCUMULATOR_CHANNEL_MESSAGE;
     case HAL_HANDLE_ERROR:
       return HAL_HANDLE_ERROR_MESSAGE;
+    case HAL_INVALID_DMA_ADDITION:
+      return HAL_INVALID_DMA_ADDITION_MESSAGE;
+    case HAL_INVALID_DMA_STATE:
+      return HAL_INVALID_DMA_STATE_MESSAGE;
     case NULL_PARAMETER:
       return NULL_PARAMETER_MESSAGE;
     case ANALOG_TRIGGER_LIMIT_ORDER_ERROR:
@@ -236,6 +245,17 @@ int64_t HAL_GetFPGARevision(int32_t* status) {
  */
 uint64_t HAL_GetFPGATime(int32_t* status) { return hal::GetFPGATime(); }
 
+/**
+ * Read the FPGA time from the CPU's monotonic clock.
+ *
+ * The simulator has no FPGA to avoid, so this is the same as HAL_GetFPGATime().
+ * That keeps it in step with simulated time when it is paused or stepped.
+ *
+ * @return The current time in microseconds according to the FPGA (since FPGA
+ * reset).
+ */
+uint64_t HAL_GetFPGATimeFast(int32_t* status) { return hal::GetFPGATime(); }
+
 /**
  * Get the state of the "USER" button on the roboRIO
  * @return true if the button is currently pressed down
@@ -16,6 +16,7 @@ extern void InitializeAnalogInData();
 extern void InitializeAnalogOutData();
 extern void InitializeAnalogTriggerData();
 extern void InitializeCanData();
+extern void InitializeChangeBatchData();
 extern void InitializeDigitalPWMData();
 extern void InitializeDIOData();
 extern void InitializeDriverStationData();
@@ -34,17 +35,20 @@ extern void InitializeAnalogGyro();
 extern void InitializeAnalogInput();
 extern void InitializeAnalogInternal();
 extern void InitializeAnalogOutput();
+extern void InitializeAnalogTrigger();
 extern void InitializeCAN();
 extern void InitializeCompressor();
 extern void InitializeConstants();
 extern void InitializeCounter();
 extern void InitializeDigitalInternal();
+extern void InitializeDigitalSignals();
 extern void InitializeDIO();
 extern void InitializeDriverStation();
 extern void InitializeEncoder();
 extern void InitializeExtensions();
 extern void InitializeHAL();
 extern void InitializeI2C();
+extern void InitializeIORecording();
 extern void InitializeInterrupts();
 extern void InitializeMockHooks();
 extern void InitializeNotifier();
@@ -55,6 +59,7 @@ extern void InitializePower();
 extern void InitializePWM();
 extern void InitializeRelay();
 extern void InitializeSerialPort();
+extern void InitializeSimContext();
 extern void InitializeSolenoid();
 extern void InitializeSPI();
 extern void InitializeThreads();
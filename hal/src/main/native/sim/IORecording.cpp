@@ -0,0 +1,22 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/IORecording.h"
+
+namespace hal {
+namespace init {
+void InitializeIORecording() {}
+}  // namespace init
+}  // namespace hal
+
+// Recordings are fed back through the replay extension in simulation, so
+// there is nothing to record here
+extern "C" {
+void HAL_StartIORecording(const char* path, int32_t* status) {}
+void HAL_StopIORecording(void) {}
+int64_t HAL_GetIORecordingDropCount(void) { return 0; }
+}  // extern "C"
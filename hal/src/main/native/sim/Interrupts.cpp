@@ -7,23 +7,30 @@
 
 #include "HAL/Interrupts.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <random>
+#include <thread>
+#include <vector>
 
 #include <support/condition_variable.h>
+#include <support/mutex.h>
 
-#include "AnalogInternal.h"
 #include "DigitalInternal.h"
+#include "DigitalSignalsInternal.h"
 #include "ErrorsInternal.h"
 #include "HAL/AnalogTrigger.h"
 #include "HAL/Errors.h"
+#include "HAL/Notifier.h"
+#include "HAL/cpp/InterruptEventQueue.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "HAL/handles/LimitedHandleResource.h"
 #include "HAL/handles/UnlimitedHandleResource.h"
-#include "MockData/AnalogInDataInternal.h"
-#include "MockData/DIODataInternal.h"
-#include "MockData/HAL_Value.h"
+#include "MockData/MockHooks.h"
 #include "MockHooksInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 using namespace hal;
 
@@ -50,38 +57,240 @@ struct Interrupt {
 
   void* callbackParam;
   HAL_InterruptHandlerFunction callbackFunction;
+
+  // Read with std::atomic_load, as callbacks can run while it is replaced
+  std::shared_ptr<InterruptEventQueue> events;
 };
 
 struct SynchronousWaitData {
   HAL_InterruptHandle interruptHandle;
   wpi::condition_variable waitCond;
   HAL_Bool waitPredicate;
+  // Shared by every interrupt of a HAL_WaitForMultipleInterrupts() call
+  wpi::condition_variable* groupCond = nullptr;
+
+  // With scheduled delivery, the edge that ended the wait and its timestamp
+  int32_t edge = 0;
+  double timestamp = 0;
+  bool edgeQueued = false;
+  // Set once the waiter has returned, so later deliveries leave it alone
+  bool done = false;
+};
+
+// An interrupt delivery waiting for its simulated time. Either an edge of an
+// asynchronous interrupt, or an edge (or with edge 0, the timeout) of a
+// synchronous wait.
+struct ScheduledInterrupt {
+  HAL_InterruptHandle interruptHandle;
+  std::shared_ptr<SynchronousWaitData> waitData;
+  int32_t edge;
+  double timestamp;
+};
+
+// Delivers interrupts on the simulated time base; see
+// HALSIM_SetInterruptLatency()
+struct InterruptScheduler {
+  wpi::mutex mutex;
+  bool enabled = false;
+  uint64_t latency = 0;
+  uint64_t jitter = 0;
+  std::mt19937 generator;
+  // Edges are never delivered before an earlier edge
+  uint64_t lastEdgeTime = 0;
+  // By delivery time; deliveries at the same time keep their order
+  std::multimap<uint64_t, ScheduledInterrupt> pending;
+  HAL_NotifierHandle notifier = HAL_kInvalidHandle;
+  std::thread thread;
+
+  // The notifiers of a context are destroyed first, which ends the thread
+  ~InterruptScheduler() {
+    if (thread.joinable()) thread.join();
+  }
 };
 }  // namespace
 
-static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
-                             HAL_HandleEnum::Interrupt>* interruptHandles;
+static void RecordInterruptEvent(Interrupt* interrupt, int32_t edge,
+                                 double timestamp) {
+  auto events = std::atomic_load(&interrupt->events);
+  if (events) events->Push(timestamp, edge);
+}
+
+static void NotifyWaiter(SynchronousWaitData* data) {
+  data->waitPredicate = true;
+  data->waitCond.notify_all();
+  if (data->groupCond) data->groupCond->notify_all();
+}
+
+static SimContextLocal<LimitedHandleResource<
+    HAL_InterruptHandle, Interrupt, kNumInterrupts, HAL_HandleEnum::Interrupt>>
+    interruptHandles;
+
+static SimContextLocal<InterruptScheduler> interruptScheduler;
 
 typedef HAL_Handle SynchronousWaitDataHandle;
-static UnlimitedHandleResource<SynchronousWaitDataHandle, SynchronousWaitData,
-                               HAL_HandleEnum::Vendor>*
+static SimContextLocal<UnlimitedHandleResource<
+    SynchronousWaitDataHandle, SynchronousWaitData, HAL_HandleEnum::Vendor>>
     synchronousInterruptHandles;
 
 namespace hal {
 namespace init {
 void InitializeInterrupts() {
-  static LimitedHandleResource<HAL_InterruptHandle, Interrupt, kNumInterrupts,
-                               HAL_HandleEnum::Interrupt>
-      iH;
-  interruptHandles = &iH;
-  static UnlimitedHandleResource<SynchronousWaitDataHandle, SynchronousWaitData,
-                                 HAL_HandleEnum::Vendor>
-      siH;
-  synchronousInterruptHandles = &siH;
+  interruptHandles.Initialize();
+  synchronousInterruptHandles.Initialize();
+  interruptScheduler.Initialize();
 }
 }  // namespace init
 }  // namespace hal
 
+// Records an edge of an asynchronous interrupt and runs its handler
+static void DeliverInterruptEdge(Interrupt* interrupt, int32_t edge,
+                                 double timestamp) {
+  int32_t mask;
+  if (edge == HAL_kInterruptFallingEdge) {
+    interrupt->fallingTimestamp = timestamp;
+    mask = 1 << (8 + interrupt->index);
+  } else {
+    interrupt->risingTimestamp = timestamp;
+    mask = 1 << (interrupt->index);
+  }
+  RecordInterruptEvent(interrupt, edge, timestamp);
+
+  // run callback
+  auto callback = interrupt->callbackFunction;
+  if (callback == nullptr) return;
+  callback(mask, interrupt->callbackParam);
+}
+
+static void ScheduleLocked(uint64_t time, ScheduledInterrupt entry) {
+  auto& scheduler = *interruptScheduler;
+  scheduler.pending.emplace(time, std::move(entry));
+  int32_t status = 0;
+  HAL_UpdateNotifierAlarm(scheduler.notifier, scheduler.pending.begin()->first,
+                          &status);
+}
+
+// Queues an edge seen at edgeTime (in microseconds) for delivery after the
+// latency. Returns false if interrupts are delivered immediately instead.
+static bool ScheduleEdge(HAL_InterruptHandle interruptHandle,
+                         std::shared_ptr<SynchronousWaitData> waitData,
+                         int32_t edge, uint64_t edgeTime) {
+  auto& scheduler = *interruptScheduler;
+  std::lock_guard<wpi::mutex> lock(scheduler.mutex);
+  if (!scheduler.enabled) return false;
+  // A wait ends at its first edge
+  if (waitData) {
+    if (waitData->edgeQueued) return true;
+    waitData->edgeQueued = true;
+  }
+
+  uint64_t time = edgeTime + scheduler.latency;
+  if (scheduler.jitter > 0) {
+    time += std::uniform_int_distribution<uint64_t>(
+        0, scheduler.jitter)(scheduler.generator);
+  }
+  time = std::max(time, scheduler.lastEdgeTime);
+  scheduler.lastEdgeTime = time;
+  ScheduleLocked(time, ScheduledInterrupt{interruptHandle, std::move(waitData),
+                                          edge, edgeTime * 1.0e-6});
+  return true;
+}
+
+static bool IsInterruptDeliveryScheduled() {
+  std::lock_guard<wpi::mutex> lock(interruptScheduler->mutex);
+  return interruptScheduler->enabled;
+}
+
+// Waits with scheduled delivery until one of the waits gets its edge, or the
+// timeout passes in simulated time; cond is notified by either. Returns false
+// on a timeout.
+static bool WaitScheduled(std::shared_ptr<SynchronousWaitData>* datas,
+                          int32_t count, wpi::condition_variable* cond,
+                          double timeout) {
+  auto& scheduler = *interruptScheduler;
+  auto timeoutData = std::make_shared<SynchronousWaitData>();
+  timeoutData->waitPredicate = false;
+  timeoutData->groupCond = cond;
+
+  std::unique_lock<wpi::mutex> lock(scheduler.mutex);
+  uint64_t timeoutTime =
+      hal::GetFPGATime() + static_cast<uint64_t>(std::max(timeout, 0.0) * 1e6);
+  ScheduleLocked(timeoutTime,
+                 ScheduledInterrupt{HAL_kInvalidHandle, timeoutData, 0, 0});
+
+  bool fired = false;
+  cond->wait(lock, [&] {
+    for (int32_t i = 0; i < count; i++) {
+      if (datas[i]->waitPredicate) fired = true;
+    }
+    return fired || timeoutData->waitPredicate;
+  });
+  for (int32_t i = 0; i < count; i++) datas[i]->done = true;
+  timeoutData->done = true;
+  return fired;
+}
+
+static void RunInterruptScheduler(HAL_NotifierHandle notifier) {
+  auto& scheduler = *interruptScheduler;
+  std::vector<ScheduledInterrupt> due;
+  for (;;) {
+    int32_t status = 0;
+    uint64_t curTime = HAL_WaitForNotifierAlarm(notifier, &status);
+    if (curTime == 0 || status != 0) {
+      // The notifier is gone; the next HALSIM_SetInterruptLatency() makes a
+      // new one
+      std::lock_guard<wpi::mutex> lock(scheduler.mutex);
+      scheduler.notifier = HAL_kInvalidHandle;
+      scheduler.enabled = false;
+      return;
+    }
+
+    due.clear();
+    {
+      std::lock_guard<wpi::mutex> lock(scheduler.mutex);
+      while (!scheduler.pending.empty() &&
+             scheduler.pending.begin()->first <= curTime) {
+        ScheduledInterrupt& entry = scheduler.pending.begin()->second;
+        if (!entry.waitData) {
+          due.emplace_back(std::move(entry));
+        } else if (!entry.waitData->done) {
+          // Waits are woken with the lock held, so a waiter that has
+          // returned is never touched
+          entry.waitData->edge = entry.edge;
+          entry.waitData->timestamp = entry.timestamp;
+          NotifyWaiter(entry.waitData.get());
+        }
+        scheduler.pending.erase(scheduler.pending.begin());
+      }
+      if (!scheduler.pending.empty()) {
+        HAL_UpdateNotifierAlarm(scheduler.notifier,
+                                scheduler.pending.begin()->first, &status);
+      }
+    }
+
+    // Handlers run without the lock, in the order their edges arrived
+    for (const auto& entry : due) {
+      auto interrupt = interruptHandles->Get(entry.interruptHandle);
+      if (interrupt) {
+        DeliverInterruptEdge(interrupt.get(), entry.edge, entry.timestamp);
+      }
+    }
+  }
+}
+
+// Reports the edge that ended a synchronous wait of a single interrupt
+static int64_t ReportWaitEdge(Interrupt* interrupt, bool falling,
+                              double timestamp) {
+  if (falling) {
+    interrupt->fallingTimestamp = timestamp;
+    RecordInterruptEvent(interrupt, HAL_kInterruptFallingEdge, timestamp);
+    return 1 << (8 + interrupt->index);
+  } else {
+    interrupt->risingTimestamp = timestamp;
+    RecordInterruptEvent(interrupt, HAL_kInterruptRisingEdge, timestamp);
+    return 1 << (interrupt->index);
+  }
+}
+
 extern "C" {
 HAL_InterruptHandle HAL_InitializeInterrupts(HAL_Bool watcher,
                                              int32_t* status) {
@@ -109,8 +318,9 @@ void HAL_CleanInterrupts(HAL_InterruptHandle interruptHandle, int32_t* status) {
   interruptHandles->Free(interruptHandle);
 }
 
-static void ProcessInterruptDigitalSynchronous(const char* name, void* param,
-                                               const struct HAL_Value* value) {
+// Handles a change of the input of a synchronous wait to value at time
+static void ProcessInterruptSynchronous(void* param, bool value,
+                                        uint64_t time) {
   // void* is a SynchronousWaitDataHandle.
   // convert to uintptr_t first, then to handle
   uintptr_t handleTmp = reinterpret_cast<uintptr_t>(param);
@@ -120,132 +330,24 @@ static void ProcessInterruptDigitalSynchronous(const char* name, void* param,
   if (interruptData == nullptr) return;
   auto interrupt = interruptHandles->Get(interruptData->interruptHandle);
   if (interrupt == nullptr) return;
-  // Have a valid interrupt
-  if (value->type != HAL_Type::HAL_BOOLEAN) return;
-  bool retVal = value->data.v_boolean;
   // If no change in interrupt, return;
-  if (retVal == interrupt->previousState) return;
-  // If its a falling change, and we dont fire on falling return
-  if (interrupt->previousState && !interrupt->fireOnDown) return;
-  // If its a rising change, and we dont fire on rising return.
-  if (!interrupt->previousState && !interrupt->fireOnUp) return;
-
-  interruptData->waitPredicate = true;
-
-  // Pulse interrupt
-  interruptData->waitCond.notify_all();
-}
-
-static double GetAnalogTriggerValue(HAL_Handle triggerHandle,
-                                    HAL_AnalogTriggerType type,
-                                    int32_t* status) {
-  return HAL_GetAnalogTriggerOutput(triggerHandle, type, status);
-}
-
-static void ProcessInterruptAnalogSynchronous(const char* name, void* param,
-                                              const struct HAL_Value* value) {
-  // void* is a SynchronousWaitDataHandle.
-  // convert to uintptr_t first, then to handle
-  uintptr_t handleTmp = reinterpret_cast<uintptr_t>(param);
-  SynchronousWaitDataHandle handle =
-      static_cast<SynchronousWaitDataHandle>(handleTmp);
-  auto interruptData = synchronousInterruptHandles->Get(handle);
-  if (interruptData == nullptr) return;
-  auto interrupt = interruptHandles->Get(interruptData->interruptHandle);
-  if (interrupt == nullptr) return;
-  // Have a valid interrupt
-  if (value->type != HAL_Type::HAL_DOUBLE) return;
-  int32_t status = 0;
-  bool retVal = GetAnalogTriggerValue(interrupt->portHandle,
-                                      interrupt->trigType, &status);
-  if (status != 0) {
-    // Interrupt and Cancel
-    interruptData->waitPredicate = true;
-    // Pulse interrupt
-    interruptData->waitCond.notify_all();
+  if (value == interrupt->previousState) return;
+  // Edges the wait doesn't fire on are skipped, so the next edge is seen
+  if ((interrupt->previousState && !interrupt->fireOnDown) ||
+      (!interrupt->previousState && !interrupt->fireOnUp)) {
+    interrupt->previousState = value;
+    return;
   }
-  // If no change in interrupt, return;
-  if (retVal == interrupt->previousState) return;
-  // If its a falling change, and we dont fire on falling return
-  if (interrupt->previousState && !interrupt->fireOnDown) return;
-  // If its a rising change, and we dont fire on rising return.
-  if (!interrupt->previousState && !interrupt->fireOnUp) return;
 
-  interruptData->waitPredicate = true;
+  int32_t edge = interrupt->previousState ? HAL_kInterruptFallingEdge
+                                          : HAL_kInterruptRisingEdge;
+  if (ScheduleEdge(HAL_kInvalidHandle, interruptData, edge, time)) return;
 
   // Pulse interrupt
-  interruptData->waitCond.notify_all();
+  NotifyWaiter(interruptData.get());
 }
 
-static int64_t WaitForInterruptDigital(HAL_InterruptHandle handle,
-                                       Interrupt* interrupt, double timeout,
-                                       bool ignorePrevious) {
-  auto data = std::make_shared<SynchronousWaitData>();
-
-  auto dataHandle = synchronousInterruptHandles->Allocate(data);
-  if (dataHandle == HAL_kInvalidHandle) {
-    // Error allocating data
-    return WaitResult::Timeout;
-  }
-
-  // auto data = synchronousInterruptHandles->Get(dataHandle);
-  data->waitPredicate = false;
-  data->interruptHandle = handle;
-
-  int32_t status = 0;
-
-  int32_t digitalIndex = GetDigitalInputChannel(interrupt->portHandle, &status);
-
-  if (status != 0) return WaitResult::Timeout;
-
-  interrupt->previousState = SimDIOData[digitalIndex].GetValue();
-
-  int32_t uid = SimDIOData[digitalIndex].RegisterValueCallback(
-      &ProcessInterruptDigitalSynchronous,
-      reinterpret_cast<void*>(static_cast<uintptr_t>(dataHandle)), false);
-
-  bool timedOut = false;
-
-  wpi::mutex waitMutex;
-
-#if defined(_MSC_VER) && _MSC_VER < 1900
-  auto timeoutTime = std::chrono::steady_clock::now() +
-                     std::chrono::duration<int64_t, std::nano>(
-                         static_cast<int64_t>(timeout * 1e9));
-#else
-  auto timeoutTime =
-      std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
-#endif
-
-  {
-    std::unique_lock<wpi::mutex> lock(waitMutex);
-    while (!data->waitPredicate) {
-      if (data->waitCond.wait_until(lock, timeoutTime) ==
-          std::cv_status::timeout) {
-        timedOut = true;
-        break;
-      }
-    }
-  }
-
-  // Cancel our callback
-  SimDIOData[digitalIndex].CancelValueCallback(uid);
-  synchronousInterruptHandles->Free(dataHandle);
-
-  // Check for what to return
-  if (timedOut) return WaitResult::Timeout;
-  // True => false, Falling
-  if (interrupt->previousState) {
-    // Set our return value and our timestamps
-    interrupt->fallingTimestamp = hal::GetFPGATimestamp();
-    return 1 << (8 + interrupt->index);
-  } else {
-    interrupt->risingTimestamp = hal::GetFPGATimestamp();
-    return 1 << (interrupt->index);
-  }
-}
-
-static int64_t WaitForInterruptAnalog(HAL_InterruptHandle handle,
+static int64_t WaitForSingleInterrupt(HAL_InterruptHandle handle,
                                       Interrupt* interrupt, double timeout,
                                       bool ignorePrevious) {
   auto data = std::make_shared<SynchronousWaitData>();
@@ -260,59 +362,59 @@ static int64_t WaitForInterruptAnalog(HAL_InterruptHandle handle,
   data->interruptHandle = handle;
 
   int32_t status = 0;
-  interrupt->previousState = GetAnalogTriggerValue(
-      interrupt->portHandle, interrupt->trigType, &status);
-
-  if (status != 0) return WaitResult::Timeout;
-
-  int32_t analogIndex =
-      GetAnalogTriggerInputIndex(interrupt->portHandle, &status);
-
-  if (status != 0) return WaitResult::Timeout;
-
-  int32_t uid = SimAnalogInData[analogIndex].RegisterVoltageCallback(
-      &ProcessInterruptAnalogSynchronous,
-      reinterpret_cast<void*>(static_cast<uintptr_t>(dataHandle)), false);
+  interrupt->previousState =
+      GetSignalValue(interrupt->portHandle, interrupt->trigType, &status);
+  int32_t uid = AddSignalListener(
+      interrupt->portHandle, interrupt->trigType, &ProcessInterruptSynchronous,
+      reinterpret_cast<void*>(static_cast<uintptr_t>(dataHandle)), false,
+      &status);
+  if (status != 0) {
+    synchronousInterruptHandles->Free(dataHandle);
+    return WaitResult::Timeout;
+  }
 
   bool timedOut = false;
+  bool falling;
+  double timestamp;
 
-  wpi::mutex waitMutex;
+  if (IsInterruptDeliveryScheduled()) {
+    timedOut = !WaitScheduled(&data, 1, &data->waitCond, timeout);
+    falling = data->edge == HAL_kInterruptFallingEdge;
+    timestamp = data->timestamp;
+  } else {
+    wpi::mutex waitMutex;
 
 #if defined(_MSC_VER) && _MSC_VER < 1900
-  auto timeoutTime = std::chrono::steady_clock::now() +
-                     std::chrono::duration<int64_t, std::nano>(
-                         static_cast<int64_t>(timeout * 1e9));
+    auto timeoutTime = std::chrono::steady_clock::now() +
+                       std::chrono::duration<int64_t, std::nano>(
+                           static_cast<int64_t>(timeout * 1e9));
 #else
-  auto timeoutTime =
-      std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
+    auto timeoutTime = std::chrono::steady_clock::now() +
+                       std::chrono::duration<double>(timeout);
 #endif
 
-  {
-    std::unique_lock<wpi::mutex> lock(waitMutex);
-    while (!data->waitPredicate) {
-      if (data->waitCond.wait_until(lock, timeoutTime) ==
-          std::cv_status::timeout) {
-        timedOut = true;
-        break;
+    {
+      std::unique_lock<wpi::mutex> lock(waitMutex);
+      while (!data->waitPredicate) {
+        if (data->waitCond.wait_until(lock, timeoutTime) ==
+            std::cv_status::timeout) {
+          timedOut = true;
+          break;
+        }
       }
     }
+    // True => false, Falling
+    falling = interrupt->previousState;
+    timestamp = hal::GetFPGATimestamp();
   }
 
   // Cancel our callback
-  SimAnalogInData[analogIndex].CancelVoltageCallback(uid);
+  RemoveSignalListener(uid);
   synchronousInterruptHandles->Free(dataHandle);
 
   // Check for what to return
   if (timedOut) return WaitResult::Timeout;
-  // True => false, Falling
-  if (interrupt->previousState) {
-    // Set our return value and our timestamps
-    interrupt->fallingTimestamp = hal::GetFPGATimestamp();
-    return 1 << (8 + interrupt->index);
-  } else {
-    interrupt->risingTimestamp = hal::GetFPGATimestamp();
-    return 1 << (interrupt->index);
-  }
+  return ReportWaitEdge(interrupt, falling, timestamp);
 }
 
 int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
@@ -330,112 +432,147 @@ int64_t HAL_WaitForInterrupt(HAL_InterruptHandle interruptHandle,
     return WaitResult::Timeout;
   }
 
-  if (interrupt->isAnalog) {
-    return WaitForInterruptAnalog(interruptHandle, interrupt.get(), timeout,
-                                  ignorePrevious);
-  } else {
-    return WaitForInterruptDigital(interruptHandle, interrupt.get(), timeout,
-                                   ignorePrevious);
+  return WaitForSingleInterrupt(interruptHandle, interrupt.get(), timeout,
+                                ignorePrevious);
+}
+
+int64_t HAL_WaitForMultipleInterrupts(const HAL_InterruptHandle* handles,
+                                      int32_t count, double timeout,
+                                      HAL_Bool ignorePrevious,
+                                      double* risingTimestamps,
+                                      double* fallingTimestamps,
+                                      int32_t* status) {
+  if (count < 1 || count > kNumInterrupts) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return WaitResult::Timeout;
+  }
+
+  std::shared_ptr<Interrupt> interrupts[kNumInterrupts];
+  for (int32_t i = 0; i < count; i++) {
+    interrupts[i] = interruptHandles->Get(handles[i]);
+    if (interrupts[i] == nullptr) {
+      *status = HAL_HANDLE_ERROR;
+      return WaitResult::Timeout;
+    }
+    // Check to make sure we are actually an interrupt in synchronous mode
+    if (!interrupts[i]->watcher) {
+      *status = NiFpga_Status_InvalidParameter;
+      return WaitResult::Timeout;
+    }
   }
+
+  wpi::condition_variable groupCond;
+  std::shared_ptr<SynchronousWaitData> datas[kNumInterrupts];
+  SynchronousWaitDataHandle dataHandles[kNumInterrupts];
+  int32_t uids[kNumInterrupts];
+  int32_t registered = 0;
+  for (; registered < count; registered++) {
+    int32_t i = registered;
+    Interrupt* interrupt = interrupts[i].get();
+    datas[i] = std::make_shared<SynchronousWaitData>();
+    datas[i]->waitPredicate = false;
+    datas[i]->interruptHandle = handles[i];
+    datas[i]->groupCond = &groupCond;
+    dataHandles[i] = synchronousInterruptHandles->Allocate(datas[i]);
+    if (dataHandles[i] == HAL_kInvalidHandle) break;
+    void* param =
+        reinterpret_cast<void*>(static_cast<uintptr_t>(dataHandles[i]));
+
+    interrupt->previousState =
+        GetSignalValue(interrupt->portHandle, interrupt->trigType, status);
+    uids[i] = AddSignalListener(interrupt->portHandle, interrupt->trigType,
+                                &ProcessInterruptSynchronous, param, false,
+                                status);
+    if (*status != 0) {
+      synchronousInterruptHandles->Free(dataHandles[i]);
+      break;
+    }
+  }
+
+  auto anyFired = [&] {
+    for (int32_t i = 0; i < registered; i++) {
+      if (datas[i]->waitPredicate) return true;
+    }
+    return false;
+  };
+
+  bool scheduled = IsInterruptDeliveryScheduled();
+  double now = hal::GetFPGATimestamp();
+  if (registered == count && scheduled) {
+    WaitScheduled(datas, count, &groupCond, timeout);
+  } else if (registered == count) {
+    wpi::mutex waitMutex;
+    auto timeoutTime = std::chrono::steady_clock::now() +
+                       std::chrono::duration<double>(timeout);
+    std::unique_lock<wpi::mutex> lock(waitMutex);
+    groupCond.wait_until(lock, timeoutTime, anyFired);
+    now = hal::GetFPGATimestamp();
+  }
+
+  // Cancel our callbacks
+  for (int32_t i = 0; i < registered; i++) {
+    RemoveSignalListener(uids[i]);
+    synchronousInterruptHandles->Free(dataHandles[i]);
+  }
+  if (registered != count) return WaitResult::Timeout;
+
+  int64_t fired = WaitResult::Timeout;
+  for (int32_t i = 0; i < count; i++) {
+    if (!datas[i]->waitPredicate) continue;
+    // True => false, Falling
+    bool falling = scheduled
+                       ? datas[i]->edge == HAL_kInterruptFallingEdge
+                       : interrupts[i]->previousState;
+    double timestamp = scheduled ? datas[i]->timestamp : now;
+    ReportWaitEdge(interrupts[i].get(), falling, timestamp);
+    if (falling) {
+      if (fallingTimestamps) fallingTimestamps[i] = timestamp;
+      fired |= 1 << (8 + i);
+    } else {
+      if (risingTimestamps) risingTimestamps[i] = timestamp;
+      fired |= 1 << i;
+    }
+  }
+  return fired;
 }
 
-static void ProcessInterruptDigitalAsynchronous(const char* name, void* param,
-                                                const struct HAL_Value* value) {
-  // void* is a HAL handle
-  // convert to uintptr_t first, then to handle
-  uintptr_t handleTmp = reinterpret_cast<uintptr_t>(param);
-  HAL_InterruptHandle handle = static_cast<HAL_InterruptHandle>(handleTmp);
-  auto interrupt = interruptHandles->Get(handle);
-  if (interrupt == nullptr) return;
-  // Have a valid interrupt
-  if (value->type != HAL_Type::HAL_BOOLEAN) return;
-  bool retVal = value->data.v_boolean;
-  // If no change in interrupt, return;
-  if (retVal == interrupt->previousState) return;
-  int32_t mask = 0;
+// Handles a change of an asynchronous interrupt's input to state at edgeTime
+static void ProcessInterruptEdge(HAL_InterruptHandle handle,
+                                 Interrupt* interrupt, bool state,
+                                 uint64_t edgeTime) {
+  // The edge is timestamped when the input changes, not when it is delivered
+  int32_t edge;
   if (interrupt->previousState) {
-    interrupt->previousState = retVal;
-    interrupt->fallingTimestamp = hal::GetFPGATimestamp();
-    mask = 1 << (8 + interrupt->index);
-    if (!interrupt->fireOnDown) return;
+    interrupt->previousState = state;
+    if (!interrupt->fireOnDown) {
+      interrupt->fallingTimestamp = edgeTime * 1.0e-6;
+      return;
+    }
+    edge = HAL_kInterruptFallingEdge;
   } else {
-    interrupt->previousState = retVal;
-    interrupt->risingTimestamp = hal::GetFPGATimestamp();
-    mask = 1 << (interrupt->index);
-    if (!interrupt->fireOnUp) return;
+    interrupt->previousState = state;
+    if (!interrupt->fireOnUp) {
+      interrupt->risingTimestamp = edgeTime * 1.0e-6;
+      return;
+    }
+    edge = HAL_kInterruptRisingEdge;
   }
 
-  // run callback
-  auto callback = interrupt->callbackFunction;
-  if (callback == nullptr) return;
-  callback(mask, interrupt->callbackParam);
+  if (ScheduleEdge(handle, nullptr, edge, edgeTime)) return;
+  DeliverInterruptEdge(interrupt, edge, edgeTime * 1.0e-6);
 }
 
-static void ProcessInterruptAnalogAsynchronous(const char* name, void* param,
-                                               const struct HAL_Value* value) {
+static void ProcessInterruptAsynchronous(void* param, bool value,
+                                         uint64_t time) {
   // void* is a HAL handle
-  // convert to intptr_t first, then to handle
+  // convert to uintptr_t first, then to handle
   uintptr_t handleTmp = reinterpret_cast<uintptr_t>(param);
   HAL_InterruptHandle handle = static_cast<HAL_InterruptHandle>(handleTmp);
   auto interrupt = interruptHandles->Get(handle);
   if (interrupt == nullptr) return;
-  // Have a valid interrupt
-  if (value->type != HAL_Type::HAL_DOUBLE) return;
-  int32_t status = 0;
-  bool retVal = GetAnalogTriggerValue(interrupt->portHandle,
-                                      interrupt->trigType, &status);
-  if (status != 0) return;
   // If no change in interrupt, return;
-  if (retVal == interrupt->previousState) return;
-  int mask = 0;
-  if (interrupt->previousState) {
-    interrupt->previousState = retVal;
-    interrupt->fallingTimestamp = hal::GetFPGATimestamp();
-    if (!interrupt->fireOnDown) return;
-    mask = 1 << (8 + interrupt->index);
-  } else {
-    interrupt->previousState = retVal;
-    interrupt->risingTimestamp = hal::GetFPGATimestamp();
-    if (!interrupt->fireOnUp) return;
-    mask = 1 << (interrupt->index);
-  }
-
-  // run callback
-  auto callback = interrupt->callbackFunction;
-  if (callback == nullptr) return;
-  callback(mask, interrupt->callbackParam);
-}
-
-static void EnableInterruptsDigital(HAL_InterruptHandle handle,
-                                    Interrupt* interrupt) {
-  int32_t status = 0;
-  int32_t digitalIndex = GetDigitalInputChannel(interrupt->portHandle, &status);
-  if (status != 0) return;
-
-  interrupt->previousState = SimDIOData[digitalIndex].GetValue();
-
-  int32_t uid = SimDIOData[digitalIndex].RegisterValueCallback(
-      &ProcessInterruptDigitalAsynchronous,
-      reinterpret_cast<void*>(static_cast<uintptr_t>(handle)), false);
-  interrupt->callbackId = uid;
-}
-
-static void EnableInterruptsAnalog(HAL_InterruptHandle handle,
-                                   Interrupt* interrupt) {
-  int32_t status = 0;
-  int32_t analogIndex =
-      GetAnalogTriggerInputIndex(interrupt->portHandle, &status);
-  if (status != 0) return;
-
-  status = 0;
-  interrupt->previousState = GetAnalogTriggerValue(
-      interrupt->portHandle, interrupt->trigType, &status);
-  if (status != 0) return;
-
-  int32_t uid = SimAnalogInData[analogIndex].RegisterVoltageCallback(
-      &ProcessInterruptAnalogAsynchronous,
-      reinterpret_cast<void*>(static_cast<uintptr_t>(handle)), false);
-  interrupt->callbackId = uid;
+  if (value == interrupt->previousState) return;
+  ProcessInterruptEdge(handle, interrupt.get(), value, time);
 }
 
 void HAL_EnableInterrupts(HAL_InterruptHandle interruptHandle,
@@ -458,11 +595,15 @@ void HAL_EnableInterrupts(HAL_InterruptHandle interruptHandle,
     return;
   }
 
-  if (interrupt->isAnalog) {
-    EnableInterruptsAnalog(interruptHandle, interrupt.get());
-  } else {
-    EnableInterruptsDigital(interruptHandle, interrupt.get());
-  }
+  int32_t signalStatus = 0;
+  interrupt->previousState = GetSignalValue(
+      interrupt->portHandle, interrupt->trigType, &signalStatus);
+  if (signalStatus != 0) return;
+  interrupt->callbackId = AddSignalListener(
+      interrupt->portHandle, interrupt->trigType,
+      &ProcessInterruptAsynchronous,
+      reinterpret_cast<void*>(static_cast<uintptr_t>(interruptHandle)), false,
+      &signalStatus);
 }
 void HAL_DisableInterrupts(HAL_InterruptHandle interruptHandle,
                            int32_t* status) {
@@ -475,20 +616,7 @@ void HAL_DisableInterrupts(HAL_InterruptHandle interruptHandle,
   // No need to disable if we are already disabled
   if (interrupt->callbackId < 0) return;
 
-  if (interrupt->isAnalog) {
-    // Do analog
-    int32_t status = 0;
-    int32_t analogIndex =
-        GetAnalogTriggerInputIndex(interrupt->portHandle, &status);
-    if (status != 0) return;
-    SimAnalogInData[analogIndex].CancelVoltageCallback(interrupt->callbackId);
-  } else {
-    int32_t status = 0;
-    int32_t digitalIndex =
-        GetDigitalInputChannel(interrupt->portHandle, &status);
-    if (status != 0) return;
-    SimDIOData[digitalIndex].CancelValueCallback(interrupt->callbackId);
-  }
+  RemoveSignalListener(interrupt->callbackId);
   interrupt->callbackId = -1;
 }
 double HAL_ReadInterruptRisingTimestamp(HAL_InterruptHandle interruptHandle,
@@ -555,6 +683,30 @@ void HAL_AttachInterruptHandlerThreaded(HAL_InterruptHandle interruptHandle,
   HAL_AttachInterruptHandler(interruptHandle, handler, param, status);
 }
 
+// Simulated handlers run on the thread that changes the input, so there is no
+// dispatch order or thread to configure.
+void HAL_SetInterruptHandlerPriority(HAL_InterruptHandle interruptHandle,
+                                     int32_t priority, int32_t* status) {
+  auto interrupt = interruptHandles->Get(interruptHandle);
+  if (interrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+}
+
+void HAL_ConfigureInterruptDispatch(int32_t threadCount, HAL_Bool realTime,
+                                    int32_t priority, uint32_t cpuMask,
+                                    int32_t* status) {
+  if (threadCount < 1 || threadCount > HAL_kMaxInterruptDispatchThreads) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  if (realTime && (priority < 1 || priority > 99)) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+}
+
 void HAL_SetInterruptUpSourceEdge(HAL_InterruptHandle interruptHandle,
                                   HAL_Bool risingEdge, HAL_Bool fallingEdge,
                                   int32_t* status) {
@@ -567,4 +719,86 @@ void HAL_SetInterruptUpSourceEdge(HAL_InterruptHandle interruptHandle,
   interrupt->fireOnDown = fallingEdge;
   interrupt->fireOnUp = risingEdge;
 }
+
+/**
+ * Queue every edge of this interrupt as it is handled, so edges that arrive
+ * faster than they are read are not lost.
+ *
+ * @param size The number of edges kept between reads; 0 stops queueing.
+ */
+void HAL_SetInterruptEventQueueSize(HAL_InterruptHandle interruptHandle,
+                                    int32_t size, int32_t* status) {
+  auto interrupt = interruptHandles->Get(interruptHandle);
+  if (interrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return;
+  }
+  if (size < 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  std::atomic_store(&interrupt->events,
+                    size == 0 ? std::shared_ptr<InterruptEventQueue>()
+                              : std::make_shared<InterruptEventQueue>(size));
+}
+
+int32_t HAL_ReadInterruptEvents(HAL_InterruptHandle interruptHandle,
+                                HAL_InterruptEvent* events, int32_t count,
+                                int32_t* status) {
+  auto interrupt = interruptHandles->Get(interruptHandle);
+  if (interrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  auto queue = std::atomic_load(&interrupt->events);
+  if (!queue) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  return queue->Pop(events, count);
+}
+
+int64_t HAL_GetInterruptEventOverflowCount(HAL_InterruptHandle interruptHandle,
+                                           int32_t* status) {
+  auto interrupt = interruptHandles->Get(interruptHandle);
+  if (interrupt == nullptr) {
+    *status = HAL_HANDLE_ERROR;
+    return 0;
+  }
+  auto queue = std::atomic_load(&interrupt->events);
+  if (!queue) {
+    *status = INCOMPATIBLE_STATE;
+    return 0;
+  }
+  return queue->GetOverflowCount();
+}
+
+void HALSIM_SetInterruptLatency(double latency, double jitter, uint32_t seed) {
+  auto& scheduler = *interruptScheduler;
+  std::lock_guard<wpi::mutex> lock(scheduler.mutex);
+  if (scheduler.notifier == HAL_kInvalidHandle) {
+    int32_t status = 0;
+    scheduler.notifier = HAL_InitializeNotifier(&status);
+    if (status != 0) return;
+    // The thread delivers to this context's interrupts
+    if (scheduler.thread.joinable()) scheduler.thread.join();
+    HALSIM_Context* context = HALSIM_GetThreadContext();
+    HAL_NotifierHandle notifier = scheduler.notifier;
+    scheduler.thread = std::thread([=] {
+      HALSIM_SetThreadContext(context);
+      RunInterruptScheduler(notifier);
+    });
+  }
+  scheduler.latency = static_cast<uint64_t>(std::max(latency, 0.0) * 1e6);
+  scheduler.jitter = static_cast<uint64_t>(std::max(jitter, 0.0) * 1e6);
+  scheduler.generator.seed(seed);
+  scheduler.enabled = true;
+}
+
+void HALSIM_ClearInterruptLatency(void) {
+  std::lock_guard<wpi::mutex> lock(interruptScheduler->mutex);
+  // Edges already queued are still delivered at their time
+  interruptScheduler->enabled = false;
+}
+
 }  // extern "C"
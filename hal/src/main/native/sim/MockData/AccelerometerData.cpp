@@ -7,20 +7,24 @@
 
 #include "../PortsInternal.h"
 #include "AccelerometerDataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeAccelerometerData() {
-  static AccelerometerData sad[1];
-  ::hal::SimAccelerometerData = sad;
-}
+void InitializeAccelerometerData() { ::hal::SimAccelerometerData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-AccelerometerData* hal::SimAccelerometerData;
+SimContextLocalArray<AccelerometerData, 1> hal::SimAccelerometerData;
+
+static void RecordChange(const AccelerometerData* data, const char* field) {
+  SimChangeBatchData->RecordChange("Accelerometer",
+                                   data - SimAccelerometerData, -1, field);
+}
+
 void AccelerometerData::ResetData() {
   m_active = false;
   m_activeCallbacks = nullptr;
@@ -66,7 +70,10 @@ HAL_Bool AccelerometerData::GetActive() { return m_active; }
 void AccelerometerData::SetActive(HAL_Bool active) {
   HAL_Bool oldValue = m_active.exchange(active);
   if (oldValue != active) {
-    InvokeActiveCallback(MakeBoolean(active));
+    RecordChange(this, "Active");
+    if (m_activeCallbacks) {
+      InvokeActiveCallback(MakeBoolean(active));
+    }
   }
 }
 
@@ -102,7 +109,10 @@ HAL_AccelerometerRange AccelerometerData::GetRange() { return m_range; }
 void AccelerometerData::SetRange(HAL_AccelerometerRange range) {
   HAL_AccelerometerRange oldValue = m_range.exchange(range);
   if (oldValue != range) {
-    InvokeRangeCallback(MakeEnum(range));
+    RecordChange(this, "Range");
+    if (m_rangeCallbacks) {
+      InvokeRangeCallback(MakeEnum(range));
+    }
   }
 }
 
@@ -138,7 +148,10 @@ double AccelerometerData::GetX() { return m_x; }
 void AccelerometerData::SetX(double x) {
   double oldValue = m_x.exchange(x);
   if (oldValue != x) {
-    InvokeXCallback(MakeDouble(x));
+    RecordChange(this, "X");
+    if (m_xCallbacks) {
+      InvokeXCallback(MakeDouble(x));
+    }
   }
 }
 
@@ -174,7 +187,10 @@ double AccelerometerData::GetY() { return m_y; }
 void AccelerometerData::SetY(double y) {
   double oldValue = m_y.exchange(y);
   if (oldValue != y) {
-    InvokeYCallback(MakeDouble(y));
+    RecordChange(this, "Y");
+    if (m_yCallbacks) {
+      InvokeYCallback(MakeDouble(y));
+    }
   }
 }
 
@@ -210,7 +226,10 @@ double AccelerometerData::GetZ() { return m_z; }
 void AccelerometerData::SetZ(double z) {
   double oldValue = m_z.exchange(z);
   if (oldValue != z) {
-    InvokeZCallback(MakeDouble(z));
+    RecordChange(this, "Z");
+    if (m_zCallbacks) {
+      InvokeZCallback(MakeDouble(z));
+    }
   }
 }
 
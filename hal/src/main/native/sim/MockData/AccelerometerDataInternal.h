@@ -12,6 +12,7 @@
 
 #include <support/mutex.h>
 
+#include "../SimContextInternal.h"
 #include "MockData/AccelerometerData.h"
 #include "MockData/NotifyListenerVector.h"
 
@@ -58,16 +59,16 @@ class AccelerometerData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_active{false};
-  std::shared_ptr<NotifyListenerVector> m_activeCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_activeCallbacks;
   std::atomic<HAL_AccelerometerRange> m_range{
       static_cast<HAL_AccelerometerRange>(0)};
-  std::shared_ptr<NotifyListenerVector> m_rangeCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_rangeCallbacks;
   std::atomic<double> m_x{0.0};
-  std::shared_ptr<NotifyListenerVector> m_xCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_xCallbacks;
   std::atomic<double> m_y{0.0};
-  std::shared_ptr<NotifyListenerVector> m_yCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_yCallbacks;
   std::atomic<double> m_z{0.0};
-  std::shared_ptr<NotifyListenerVector> m_zCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_zCallbacks;
 };
-extern AccelerometerData* SimAccelerometerData;
+extern SimContextLocalArray<AccelerometerData, 1> SimAccelerometerData;
 }  // namespace hal
@@ -7,20 +7,24 @@
 
 #include "../PortsInternal.h"
 #include "AnalogGyroDataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeAnalogGyroData() {
-  static AnalogGyroData agd[kNumAccumulators];
-  ::hal::SimAnalogGyroData = agd;
-}
+void InitializeAnalogGyroData() { ::hal::SimAnalogGyroData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-AnalogGyroData* hal::SimAnalogGyroData;
+SimContextLocalArray<AnalogGyroData, kNumAccumulators> hal::SimAnalogGyroData;
+
+static void RecordChange(const AnalogGyroData* data, const char* field) {
+  SimChangeBatchData->RecordChange("AnalogGyro", data - SimAnalogGyroData, -1,
+                                   field);
+}
+
 void AnalogGyroData::ResetData() {
   m_angle = 0.0;
   m_angleCallbacks = nullptr;
@@ -62,7 +66,10 @@ double AnalogGyroData::GetAngle() { return m_angle; }
 void AnalogGyroData::SetAngle(double angle) {
   double oldValue = m_angle.exchange(angle);
   if (oldValue != angle) {
-    InvokeAngleCallback(MakeDouble(angle));
+    RecordChange(this, "Angle");
+    if (m_angleCallbacks) {
+      InvokeAngleCallback(MakeDouble(angle));
+    }
   }
 }
 
@@ -98,7 +105,10 @@ double AnalogGyroData::GetRate() { return m_rate; }
 void AnalogGyroData::SetRate(double rate) {
   double oldValue = m_rate.exchange(rate);
   if (oldValue != rate) {
-    InvokeRateCallback(MakeDouble(rate));
+    RecordChange(this, "Rate");
+    if (m_rateCallbacks) {
+      InvokeRateCallback(MakeDouble(rate));
+    }
   }
 }
 
@@ -134,7 +144,10 @@ HAL_Bool AnalogGyroData::GetInitialized() { return m_initialized; }
 void AnalogGyroData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -12,6 +12,8 @@
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/AnalogGyroData.h"
 #include "MockData/NotifyListenerVector.h"
 
@@ -44,11 +46,11 @@ class AnalogGyroData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<double> m_angle{0.0};
-  std::shared_ptr<NotifyListenerVector> m_angleCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_angleCallbacks;
   std::atomic<double> m_rate{0.0};
-  std::shared_ptr<NotifyListenerVector> m_rateCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_rateCallbacks;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
 };
-extern AnalogGyroData* SimAnalogGyroData;
+extern SimContextLocalArray<AnalogGyroData, kNumAccumulators> SimAnalogGyroData;
 }  // namespace hal
@@ -5,22 +5,27 @@
 /* the project.                                                               */
 /*----------------------------------------------------------------------------*/
 
+#include "../DigitalSignalsInternal.h"
 #include "../PortsInternal.h"
 #include "AnalogInDataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeAnalogInData() {
-  static AnalogInData sind[kNumAnalogInputs];
-  ::hal::SimAnalogInData = sind;
-}
+void InitializeAnalogInData() { ::hal::SimAnalogInData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-AnalogInData* hal::SimAnalogInData;
+SimContextLocalArray<AnalogInData, kNumAnalogInputs> hal::SimAnalogInData;
+
+static void RecordChange(const AnalogInData* data, const char* field) {
+  SimChangeBatchData->RecordChange("AnalogIn", data - SimAnalogInData, -1,
+                                   field);
+}
+
 void AnalogInData::ResetData() {
   m_initialized = false;
   m_initializedCallbacks = nullptr;
@@ -74,7 +79,10 @@ HAL_Bool AnalogInData::GetInitialized() { return m_initialized; }
 void AnalogInData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -110,7 +118,10 @@ int32_t AnalogInData::GetAverageBits() { return m_averageBits; }
 void AnalogInData::SetAverageBits(int32_t averageBits) {
   int32_t oldValue = m_averageBits.exchange(averageBits);
   if (oldValue != averageBits) {
-    InvokeAverageBitsCallback(MakeInt(averageBits));
+    RecordChange(this, "AverageBits");
+    if (m_averageBitsCallbacks) {
+      InvokeAverageBitsCallback(MakeInt(averageBits));
+    }
   }
 }
 
@@ -145,7 +156,10 @@ int32_t AnalogInData::GetOversampleBits() { return m_oversampleBits; }
 void AnalogInData::SetOversampleBits(int32_t oversampleBits) {
   int32_t oldValue = m_oversampleBits.exchange(oversampleBits);
   if (oldValue != oversampleBits) {
-    InvokeOversampleBitsCallback(MakeInt(oversampleBits));
+    RecordChange(this, "OversampleBits");
+    if (m_oversampleBitsCallbacks) {
+      InvokeOversampleBitsCallback(MakeInt(oversampleBits));
+    }
   }
 }
 
@@ -181,7 +195,11 @@ double AnalogInData::GetVoltage() { return m_voltage; }
 void AnalogInData::SetVoltage(double voltage) {
   double oldValue = m_voltage.exchange(voltage);
   if (oldValue != voltage) {
-    InvokeVoltageCallback(MakeDouble(voltage));
+    RecordChange(this, "Voltage");
+    AnalogInputChanged(this - SimAnalogInData);
+    if (m_voltageCallbacks) {
+      InvokeVoltageCallback(MakeDouble(voltage));
+    }
   }
 }
 
@@ -221,7 +239,10 @@ HAL_Bool AnalogInData::GetAccumulatorInitialized() {
 void AnalogInData::SetAccumulatorInitialized(HAL_Bool accumulatorInitialized) {
   HAL_Bool oldValue = m_accumulatorInitialized.exchange(accumulatorInitialized);
   if (oldValue != accumulatorInitialized) {
-    InvokeAccumulatorInitializedCallback(MakeBoolean(accumulatorInitialized));
+    RecordChange(this, "AccumulatorInitialized");
+    if (m_accumulatorInitializedCallbacks) {
+      InvokeAccumulatorInitializedCallback(MakeBoolean(accumulatorInitialized));
+    }
   }
 }
 
@@ -258,7 +279,10 @@ int64_t AnalogInData::GetAccumulatorValue() { return m_accumulatorValue; }
 void AnalogInData::SetAccumulatorValue(int64_t accumulatorValue) {
   int64_t oldValue = m_accumulatorValue.exchange(accumulatorValue);
   if (oldValue != accumulatorValue) {
-    InvokeAccumulatorValueCallback(MakeLong(accumulatorValue));
+    RecordChange(this, "AccumulatorValue");
+    if (m_accumulatorValueCallbacks) {
+      InvokeAccumulatorValueCallback(MakeLong(accumulatorValue));
+    }
   }
 }
 
@@ -295,7 +319,10 @@ int64_t AnalogInData::GetAccumulatorCount() { return m_accumulatorCount; }
 void AnalogInData::SetAccumulatorCount(int64_t accumulatorCount) {
   int64_t oldValue = m_accumulatorCount.exchange(accumulatorCount);
   if (oldValue != accumulatorCount) {
-    InvokeAccumulatorCountCallback(MakeLong(accumulatorCount));
+    RecordChange(this, "AccumulatorCount");
+    if (m_accumulatorCountCallbacks) {
+      InvokeAccumulatorCountCallback(MakeLong(accumulatorCount));
+    }
   }
 }
 
@@ -332,7 +359,10 @@ int32_t AnalogInData::GetAccumulatorCenter() { return m_accumulatorCenter; }
 void AnalogInData::SetAccumulatorCenter(int32_t accumulatorCenter) {
   int32_t oldValue = m_accumulatorCenter.exchange(accumulatorCenter);
   if (oldValue != accumulatorCenter) {
-    InvokeAccumulatorCenterCallback(MakeInt(accumulatorCenter));
+    RecordChange(this, "AccumulatorCenter");
+    if (m_accumulatorCenterCallbacks) {
+      InvokeAccumulatorCenterCallback(MakeInt(accumulatorCenter));
+    }
   }
 }
 
@@ -369,7 +399,10 @@ int32_t AnalogInData::GetAccumulatorDeadband() { return m_accumulatorDeadband; }
 void AnalogInData::SetAccumulatorDeadband(int32_t accumulatorDeadband) {
   int32_t oldValue = m_accumulatorDeadband.exchange(accumulatorDeadband);
   if (oldValue != accumulatorDeadband) {
-    InvokeAccumulatorDeadbandCallback(MakeInt(accumulatorDeadband));
+    RecordChange(this, "AccumulatorDeadband");
+    if (m_accumulatorDeadbandCallbacks) {
+      InvokeAccumulatorDeadbandCallback(MakeInt(accumulatorDeadband));
+    }
   }
 }
 
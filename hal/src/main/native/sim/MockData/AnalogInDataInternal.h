@@ -12,6 +12,8 @@
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/AnalogInData.h"
 #include "MockData/NotifyListenerVector.h"
 
@@ -89,25 +91,23 @@ class AnalogInData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
   std::atomic<int32_t> m_averageBits{7};
-  std::shared_ptr<NotifyListenerVector> m_averageBitsCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_averageBitsCallbacks;
   std::atomic<int32_t> m_oversampleBits{0};
-  std::shared_ptr<NotifyListenerVector> m_oversampleBitsCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_oversampleBitsCallbacks;
   std::atomic<double> m_voltage{0.0};
-  std::shared_ptr<NotifyListenerVector> m_voltageCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_voltageCallbacks;
   std::atomic<HAL_Bool> m_accumulatorInitialized{false};
-  std::shared_ptr<NotifyListenerVector> m_accumulatorInitializedCallbacks =
-      nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_accumulatorInitializedCallbacks;
   std::atomic<int64_t> m_accumulatorValue{0};
-  std::shared_ptr<NotifyListenerVector> m_accumulatorValueCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_accumulatorValueCallbacks;
   std::atomic<int64_t> m_accumulatorCount{0};
-  std::shared_ptr<NotifyListenerVector> m_accumulatorCountCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_accumulatorCountCallbacks;
   std::atomic<int32_t> m_accumulatorCenter{0};
-  std::shared_ptr<NotifyListenerVector> m_accumulatorCenterCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_accumulatorCenterCallbacks;
   std::atomic<int32_t> m_accumulatorDeadband{0};
-  std::shared_ptr<NotifyListenerVector> m_accumulatorDeadbandCallbacks =
-      nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_accumulatorDeadbandCallbacks;
 };
-extern AnalogInData* SimAnalogInData;
+extern SimContextLocalArray<AnalogInData, kNumAnalogInputs> SimAnalogInData;
 }  // namespace hal
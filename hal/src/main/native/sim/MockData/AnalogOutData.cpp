@@ -7,20 +7,24 @@
 
 #include "../PortsInternal.h"
 #include "AnalogOutDataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeAnalogOutData() {
-  static AnalogOutData siod[kNumAnalogOutputs];
-  ::hal::SimAnalogOutData = siod;
-}
+void InitializeAnalogOutData() { ::hal::SimAnalogOutData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-AnalogOutData* hal::SimAnalogOutData;
+SimContextLocalArray<AnalogOutData, kNumAnalogOutputs> hal::SimAnalogOutData;
+
+static void RecordChange(const AnalogOutData* data, const char* field) {
+  SimChangeBatchData->RecordChange("AnalogOut", data - SimAnalogOutData, -1,
+                                   field);
+}
+
 void AnalogOutData::ResetData() {
   m_voltage = 0.0;
   m_voltageCallbacks = nullptr;
@@ -60,7 +64,10 @@ double AnalogOutData::GetVoltage() { return m_voltage; }
 void AnalogOutData::SetVoltage(double voltage) {
   double oldValue = m_voltage.exchange(voltage);
   if (oldValue != voltage) {
-    InvokeVoltageCallback(MakeDouble(voltage));
+    RecordChange(this, "Voltage");
+    if (m_voltageCallbacks) {
+      InvokeVoltageCallback(MakeDouble(voltage));
+    }
   }
 }
 
@@ -96,7 +103,10 @@ HAL_Bool AnalogOutData::GetInitialized() { return m_initialized; }
 void AnalogOutData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -12,6 +12,8 @@
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/AnalogOutData.h"
 #include "MockData/NotifyListenerVector.h"
 
@@ -37,9 +39,9 @@ class AnalogOutData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<double> m_voltage{0.0};
-  std::shared_ptr<NotifyListenerVector> m_voltageCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_voltageCallbacks;
   std::atomic<HAL_Bool> m_initialized{0};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
 };
-extern AnalogOutData* SimAnalogOutData;
+extern SimContextLocalArray<AnalogOutData, kNumAnalogOutputs> SimAnalogOutData;
 }  // namespace hal
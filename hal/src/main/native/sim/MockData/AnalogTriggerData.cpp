@@ -7,20 +7,25 @@
 
 #include "../PortsInternal.h"
 #include "AnalogTriggerDataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeAnalogTriggerData() {
-  static AnalogTriggerData satd[kNumAnalogTriggers];
-  ::hal::SimAnalogTriggerData = satd;
-}
+void InitializeAnalogTriggerData() { ::hal::SimAnalogTriggerData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-AnalogTriggerData* hal::SimAnalogTriggerData;
+SimContextLocalArray<AnalogTriggerData, kNumAnalogTriggers>
+    hal::SimAnalogTriggerData;
+
+static void RecordChange(const AnalogTriggerData* data, const char* field) {
+  SimChangeBatchData->RecordChange("AnalogTrigger",
+                                   data - SimAnalogTriggerData, -1, field);
+}
+
 void AnalogTriggerData::ResetData() {
   m_initialized = 0;
   m_initializedCallbacks = nullptr;
@@ -63,7 +68,10 @@ HAL_Bool AnalogTriggerData::GetInitialized() { return m_initialized; }
 void AnalogTriggerData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -100,7 +108,10 @@ double AnalogTriggerData::GetTriggerLowerBound() { return m_triggerLowerBound; }
 void AnalogTriggerData::SetTriggerLowerBound(double triggerLowerBound) {
   double oldValue = m_triggerLowerBound.exchange(triggerLowerBound);
   if (oldValue != triggerLowerBound) {
-    InvokeTriggerLowerBoundCallback(MakeDouble(triggerLowerBound));
+    RecordChange(this, "TriggerLowerBound");
+    if (m_triggerLowerBoundCallbacks) {
+      InvokeTriggerLowerBoundCallback(MakeDouble(triggerLowerBound));
+    }
   }
 }
 
@@ -137,7 +148,10 @@ double AnalogTriggerData::GetTriggerUpperBound() { return m_triggerUpperBound; }
 void AnalogTriggerData::SetTriggerUpperBound(double triggerUpperBound) {
   double oldValue = m_triggerUpperBound.exchange(triggerUpperBound);
   if (oldValue != triggerUpperBound) {
-    InvokeTriggerUpperBoundCallback(MakeDouble(triggerUpperBound));
+    RecordChange(this, "TriggerUpperBound");
+    if (m_triggerUpperBoundCallbacks) {
+      InvokeTriggerUpperBoundCallback(MakeDouble(triggerUpperBound));
+    }
   }
 }
 
@@ -174,7 +188,10 @@ HALSIM_AnalogTriggerMode AnalogTriggerData::GetTriggerMode() {
 void AnalogTriggerData::SetTriggerMode(HALSIM_AnalogTriggerMode triggerMode) {
   HALSIM_AnalogTriggerMode oldValue = m_triggerMode.exchange(triggerMode);
   if (oldValue != triggerMode) {
-    InvokeTriggerModeCallback(MakeEnum(triggerMode));
+    RecordChange(this, "TriggerMode");
+    if (m_triggerModeCallbacks) {
+      InvokeTriggerModeCallback(MakeEnum(triggerMode));
+    }
   }
 }
 
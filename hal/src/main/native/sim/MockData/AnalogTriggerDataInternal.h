@@ -12,6 +12,8 @@
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/AnalogTriggerData.h"
 #include "MockData/NotifyListenerVector.h"
 
@@ -53,14 +55,15 @@ class AnalogTriggerData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_initialized{0};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
   std::atomic<double> m_triggerLowerBound{0};
-  std::shared_ptr<NotifyListenerVector> m_triggerLowerBoundCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_triggerLowerBoundCallbacks;
   std::atomic<double> m_triggerUpperBound{0};
-  std::shared_ptr<NotifyListenerVector> m_triggerUpperBoundCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_triggerUpperBoundCallbacks;
   std::atomic<HALSIM_AnalogTriggerMode> m_triggerMode{
       static_cast<HALSIM_AnalogTriggerMode>(0)};
-  std::shared_ptr<NotifyListenerVector> m_triggerModeCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_triggerModeCallbacks;
 };
-extern AnalogTriggerData* SimAnalogTriggerData;
+extern SimContextLocalArray<AnalogTriggerData, kNumAnalogTriggers>
+    SimAnalogTriggerData;
 }  // namespace hal
@@ -0,0 +1,135 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "MockData/BusDeviceModel.h"
+
+#include <cstring>
+#include <utility>
+
+#include "I2CDataInternal.h"
+#include "SPIDataInternal.h"
+
+using namespace hal;
+
+void BusDeviceModel::Read(uint8_t* buffer, int32_t size) {
+  std::memset(buffer, 0, size);
+}
+
+void BusDeviceModel::Transaction(const uint8_t* dataToSend,
+                                 uint8_t* dataReceived, int32_t size) {
+  Write(dataToSend, size);
+  Read(dataReceived, size);
+}
+
+RegisterMapDeviceModel::RegisterMapDeviceModel(int32_t size, uint8_t readFlag,
+                                               uint8_t addressMask)
+    : m_registers(size > 0 ? size : 1),
+      m_readFlag(readFlag),
+      m_addressMask(addressMask) {}
+
+uint8_t RegisterMapDeviceModel::GetRegister(int32_t address) const {
+  uint8_t value;
+  GetRegisters(address, &value, 1);
+  return value;
+}
+
+void RegisterMapDeviceModel::SetRegister(int32_t address, uint8_t value) {
+  SetRegisters(address, &value, 1);
+}
+
+void RegisterMapDeviceModel::GetRegisters(int32_t address, uint8_t* data,
+                                          int32_t count) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  for (int32_t i = 0; i < count; i++) {
+    data[i] = m_registers[(address + i) % m_registers.size()];
+  }
+}
+
+void RegisterMapDeviceModel::SetRegisters(int32_t address, const uint8_t* data,
+                                          int32_t count) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  for (int32_t i = 0; i < count; i++) {
+    m_registers[(address + i) % m_registers.size()] = data[i];
+  }
+}
+
+void RegisterMapDeviceModel::Write(const uint8_t* data, int32_t size) {
+  if (size < 1) return;
+  int32_t address = data[0] & m_addressMask;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_address = address;
+  }
+  // a read command only selects the registers read next
+  if (m_readFlag != 0 && (data[0] & m_readFlag)) return;
+  if (size > 1) WriteRegisters(address, data + 1, size - 1);
+}
+
+void RegisterMapDeviceModel::Read(uint8_t* buffer, int32_t size) {
+  int32_t address;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    address = m_address;
+  }
+  ReadRegisters(address, buffer, size);
+}
+
+void RegisterMapDeviceModel::Transaction(const uint8_t* dataToSend,
+                                         uint8_t* dataReceived, int32_t size) {
+  if (m_readFlag == 0) {
+    BusDeviceModel::Transaction(dataToSend, dataReceived, size);
+    return;
+  }
+  if (size < 1) return;
+  int32_t address = dataToSend[0] & m_addressMask;
+  dataReceived[0] = 0;
+  if (dataToSend[0] & m_readFlag) {
+    ReadRegisters(address, dataReceived + 1, size - 1);
+  } else {
+    std::memset(dataReceived + 1, 0, size - 1);
+    WriteRegisters(address, dataToSend + 1, size - 1);
+  }
+}
+
+void RegisterMapDeviceModel::WriteRegisters(int32_t address,
+                                            const uint8_t* data,
+                                            int32_t count) {
+  SetRegisters(address, data, count);
+  OnWrite(address, count);
+}
+
+void RegisterMapDeviceModel::ReadRegisters(int32_t address, uint8_t* data,
+                                           int32_t count) {
+  OnRead(address, count);
+  GetRegisters(address, data, count);
+}
+
+namespace hal {
+
+void SetSPIDeviceModel(int32_t port, std::shared_ptr<BusDeviceModel> model) {
+  if (port < 0 || port >= kNumSPIDataPorts) return;
+  SimSPIData[port].SetModel(std::move(model));
+}
+
+std::shared_ptr<BusDeviceModel> GetSPIDeviceModel(int32_t port) {
+  if (port < 0 || port >= kNumSPIDataPorts) return nullptr;
+  return SimSPIData[port].GetModel();
+}
+
+void SetI2CDeviceModel(int32_t port, int32_t address,
+                       std::shared_ptr<BusDeviceModel> model) {
+  if (port < 0 || port >= kNumI2CDataPorts) return;
+  SimI2CData[port].SetModel(address, std::move(model));
+}
+
+std::shared_ptr<BusDeviceModel> GetI2CDeviceModel(int32_t port,
+                                                  int32_t address) {
+  if (port < 0 || port >= kNumI2CDataPorts) return nullptr;
+  return SimI2CData[port].GetModel(address);
+}
+
+}  // namespace hal
@@ -13,14 +13,11 @@ using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeCanData() {
-  static CanData scd;
-  ::hal::SimCanData = &scd;
-}
+void InitializeCanData() { ::hal::SimCanData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-CanData* hal::SimCanData;
+SimContextLocal<CanData> hal::SimCanData;
 void InvokeCallback(std::shared_ptr<CanSendMessageListenerVector> currentVector,
                     const char* name, uint32_t messageID, const uint8_t* data,
                     uint8_t dataSize, int32_t periodMs, int32_t* status) {
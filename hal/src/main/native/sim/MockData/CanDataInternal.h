@@ -13,6 +13,7 @@
 
 #include <support/mutex.h>
 
+#include "../SimContextInternal.h"
 #include "MockData/CanData.h"
 #include "MockData/NotifyCallbackHelpers.h"
 #include "MockData/NotifyListenerVector.h"
@@ -106,6 +107,6 @@ class CanData {
   std::shared_ptr<CanGetCANStatusListenerVector> m_getCanStatusCallback;
 };
 
-extern CanData* SimCanData;
+extern SimContextLocal<CanData> SimCanData;
 
 }  // namespace hal
@@ -0,0 +1,104 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <functional>
+
+#include "ChangeBatchInternal.h"
+#include "MockData/NotifyCallbackHelpers.h"
+
+using namespace hal;
+
+namespace hal {
+namespace init {
+void InitializeChangeBatchData() { ::hal::SimChangeBatchData.Initialize(); }
+}  // namespace init
+}  // namespace hal
+
+SimContextLocal<ChangeBatchData> hal::SimChangeBatchData;
+
+size_t ChangeBatchData::ChangeHash::operator()(
+    const HALSIM_Change& change) const {
+  size_t hash = std::hash<const char*>()(change.field);
+  hash = hash * 31 + std::hash<const char*>()(change.device);
+  hash = hash * 31 + static_cast<size_t>(change.index);
+  return hash * 31 + static_cast<size_t>(change.channel);
+}
+
+bool ChangeBatchData::ChangeEqual::operator()(const HALSIM_Change& lhs,
+                                              const HALSIM_Change& rhs) const {
+  return lhs.field == rhs.field && lhs.device == rhs.device &&
+         lhs.index == rhs.index && lhs.channel == rhs.channel;
+}
+
+void ChangeBatchData::ResetData() {
+  std::lock_guard<wpi::mutex> lock(m_changesMutex);
+  m_callbacks = nullptr;
+  m_changes.clear();
+  m_dirty.clear();
+}
+
+int32_t ChangeBatchData::RegisterCallback(HAL_ChangeBatchCallback callback,
+                                          void* param) {
+  // Must return -1 on a null callback for error handling
+  if (callback == nullptr) return -1;
+  int32_t newUid = 0;
+  std::lock_guard<wpi::mutex> lock(m_registerMutex);
+  m_callbacks = RegisterCallbackImpl<ChangeBatchListenerVector>(
+      m_callbacks, "ChangeBatch", callback, param, &newUid);
+  return newUid;
+}
+
+void ChangeBatchData::CancelCallback(int32_t uid) {
+  std::lock_guard<wpi::mutex> lock(m_registerMutex);
+  std::shared_ptr<ChangeBatchListenerVector> callbacks = m_callbacks;
+  if (!callbacks) return;
+  m_callbacks =
+      CancelCallbackImpl<ChangeBatchListenerVector, HAL_ChangeBatchCallback>(
+          callbacks, uid);
+}
+
+void ChangeBatchData::AddChange(const HALSIM_Change& change) {
+  std::lock_guard<wpi::mutex> lock(m_changesMutex);
+  if (m_dirty.insert(change).second) m_changes.push_back(change);
+}
+
+void ChangeBatchData::Flush() {
+  std::lock_guard<wpi::mutex> flushLock(m_flushMutex);
+  {
+    std::lock_guard<wpi::mutex> lock(m_changesMutex);
+    if (m_changes.empty()) return;
+    // swap rather than copy so both vectors keep their capacity
+    m_flushing.swap(m_changes);
+    m_changes.clear();
+    m_dirty.clear();
+  }
+  AtomicListenerVector<ChangeBatchListenerVector>::Reader callbacks(
+      m_callbacks);
+  if (callbacks) {
+    int32_t count = static_cast<int32_t>(m_flushing.size());
+    for (size_t i = 0; i < callbacks->size(); ++i) {
+      auto& listener = (*callbacks)[i];
+      if (!listener) continue;  // removed
+      listener.callback("ChangeBatch", listener.param, m_flushing.data(),
+                        count);
+    }
+  }
+  m_flushing.clear();
+}
+
+extern "C" {
+int32_t HALSIM_RegisterChangeBatchCallback(HAL_ChangeBatchCallback callback,
+                                           void* param) {
+  return SimChangeBatchData->RegisterCallback(callback, param);
+}
+
+void HALSIM_CancelChangeBatchCallback(int32_t uid) {
+  SimChangeBatchData->CancelCallback(uid);
+}
+
+void HALSIM_FlushChanges(void) { SimChangeBatchData->Flush(); }
+}  // extern "C"
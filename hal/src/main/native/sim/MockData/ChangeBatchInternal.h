@@ -0,0 +1,65 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include <support/mutex.h>
+
+#include "../SimContextInternal.h"
+#include "MockData/ChangeBatch.h"
+#include "MockData/NotifyListenerVector.h"
+
+namespace hal {
+typedef HalCallbackListenerVectorImpl<HAL_ChangeBatchCallback>
+    ChangeBatchListenerVector;
+
+class ChangeBatchData {
+ public:
+  int32_t RegisterCallback(HAL_ChangeBatchCallback callback, void* param);
+  void CancelCallback(int32_t uid);
+
+  // Adds a change to the dirty set; a no-op unless a batch callback is
+  // registered, so unbatched simulations pay only an atomic load
+  void RecordChange(const char* device, int32_t index, int32_t channel,
+                    const char* field) {
+    if (!m_callbacks) return;
+    AddChange(HALSIM_Change{device, index, channel, field});
+  }
+
+  void Flush();
+
+  void ResetData();
+
+ private:
+  struct ChangeHash {
+    size_t operator()(const HALSIM_Change& change) const;
+  };
+  struct ChangeEqual {
+    bool operator()(const HALSIM_Change& lhs, const HALSIM_Change& rhs) const;
+  };
+
+  void AddChange(const HALSIM_Change& change);
+
+  wpi::mutex m_registerMutex;
+  AtomicListenerVector<ChangeBatchListenerVector> m_callbacks;
+
+  wpi::mutex m_changesMutex;
+  std::vector<HALSIM_Change> m_changes;
+  std::unordered_set<HALSIM_Change, ChangeHash, ChangeEqual> m_dirty;
+
+  // serializes flushes so batches are delivered in order
+  wpi::mutex m_flushMutex;
+  std::vector<HALSIM_Change> m_flushing;
+};
+extern SimContextLocal<ChangeBatchData> SimChangeBatchData;
+}  // namespace hal
@@ -5,22 +5,26 @@
 /* the project.                                                               */
 /*----------------------------------------------------------------------------*/
 
+#include "../DigitalSignalsInternal.h"
 #include "../PortsInternal.h"
 #include "DIODataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeDIOData() {
-  static DIOData sdd[kNumDigitalChannels];
-  ::hal::SimDIOData = sdd;
-}
+void InitializeDIOData() { ::hal::SimDIOData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-DIOData* hal::SimDIOData;
+SimContextLocalArray<DIOData, kNumDigitalChannels> hal::SimDIOData;
+
+static void RecordChange(const DIOData* data, const char* field) {
+  SimChangeBatchData->RecordChange("DIO", data - SimDIOData, -1, field);
+}
+
 void DIOData::ResetData() {
   m_initialized = false;
   m_initializedCallbacks = nullptr;
@@ -66,7 +70,10 @@ HAL_Bool DIOData::GetInitialized() { return m_initialized; }
 void DIOData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -101,7 +108,11 @@ HAL_Bool DIOData::GetValue() { return m_value; }
 void DIOData::SetValue(HAL_Bool value) {
   HAL_Bool oldValue = m_value.exchange(value);
   if (oldValue != value) {
-    InvokeValueCallback(MakeBoolean(value));
+    RecordChange(this, "Value");
+    DigitalInputChanged(this - SimDIOData, value);
+    if (m_valueCallbacks) {
+      InvokeValueCallback(MakeBoolean(value));
+    }
   }
 }
 
@@ -137,7 +148,10 @@ double DIOData::GetPulseLength() { return m_pulseLength; }
 void DIOData::SetPulseLength(double pulseLength) {
   double oldValue = m_pulseLength.exchange(pulseLength);
   if (oldValue != pulseLength) {
-    InvokePulseLengthCallback(MakeDouble(pulseLength));
+    RecordChange(this, "PulseLength");
+    if (m_pulseLengthCallbacks) {
+      InvokePulseLengthCallback(MakeDouble(pulseLength));
+    }
   }
 }
 
@@ -172,7 +186,10 @@ HAL_Bool DIOData::GetIsInput() { return m_isInput; }
 void DIOData::SetIsInput(HAL_Bool isInput) {
   HAL_Bool oldValue = m_isInput.exchange(isInput);
   if (oldValue != isInput) {
-    InvokeIsInputCallback(MakeBoolean(isInput));
+    RecordChange(this, "IsInput");
+    if (m_isInputCallbacks) {
+      InvokeIsInputCallback(MakeBoolean(isInput));
+    }
   }
 }
 
@@ -208,12 +225,18 @@ int32_t DIOData::GetFilterIndex() { return m_filterIndex; }
 void DIOData::SetFilterIndex(int32_t filterIndex) {
   int32_t oldValue = m_filterIndex.exchange(filterIndex);
   if (oldValue != filterIndex) {
-    InvokeFilterIndexCallback(MakeInt(filterIndex));
+    RecordChange(this, "FilterIndex");
+    if (m_filterIndexCallbacks) {
+      InvokeFilterIndexCallback(MakeInt(filterIndex));
+    }
   }
 }
 
 extern "C" {
-void HALSIM_ResetDIOData(int32_t index) { SimDIOData[index].ResetData(); }
+void HALSIM_ResetDIOData(int32_t index) {
+  SimDIOData[index].ResetData();
+  ResetDigitalFilter(index);
+}
 
 int32_t HALSIM_RegisterDIOInitializedCallback(int32_t index,
                                               HAL_NotifyCallback callback,
@@ -12,6 +12,8 @@
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/DIOData.h"
 #include "MockData/NotifyListenerVector.h"
 
@@ -58,15 +60,15 @@ class DIOData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
   std::atomic<HAL_Bool> m_value{true};
-  std::shared_ptr<NotifyListenerVector> m_valueCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_valueCallbacks;
   std::atomic<double> m_pulseLength{0.0};
-  std::shared_ptr<NotifyListenerVector> m_pulseLengthCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_pulseLengthCallbacks;
   std::atomic<HAL_Bool> m_isInput{true};
-  std::shared_ptr<NotifyListenerVector> m_isInputCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_isInputCallbacks;
   std::atomic<int32_t> m_filterIndex{-1};
-  std::shared_ptr<NotifyListenerVector> m_filterIndexCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_filterIndexCallbacks;
 };
-extern DIOData* SimDIOData;
+extern SimContextLocalArray<DIOData, kNumDigitalChannels> SimDIOData;
 }  // namespace hal
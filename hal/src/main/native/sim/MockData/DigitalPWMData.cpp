@@ -7,20 +7,25 @@
 
 #include "../PortsInternal.h"
 #include "DigitalPWMDataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeDigitalPWMData() {
-  static DigitalPWMData sdpd[kNumDigitalPWMOutputs];
-  ::hal::SimDigitalPWMData = sdpd;
-}
+void InitializeDigitalPWMData() { ::hal::SimDigitalPWMData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-DigitalPWMData* hal::SimDigitalPWMData;
+SimContextLocalArray<DigitalPWMData, kNumDigitalPWMOutputs>
+    hal::SimDigitalPWMData;
+
+static void RecordChange(const DigitalPWMData* data, const char* field) {
+  SimChangeBatchData->RecordChange("DigitalPWM", data - SimDigitalPWMData, -1,
+                                   field);
+}
+
 void DigitalPWMData::ResetData() {
   m_initialized = false;
   m_initializedCallbacks = nullptr;
@@ -62,7 +67,10 @@ HAL_Bool DigitalPWMData::GetInitialized() { return m_initialized; }
 void DigitalPWMData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -98,7 +106,10 @@ double DigitalPWMData::GetDutyCycle() { return m_dutyCycle; }
 void DigitalPWMData::SetDutyCycle(double dutyCycle) {
   double oldValue = m_dutyCycle.exchange(dutyCycle);
   if (oldValue != dutyCycle) {
-    InvokeDutyCycleCallback(MakeDouble(dutyCycle));
+    RecordChange(this, "DutyCycle");
+    if (m_dutyCycleCallbacks) {
+      InvokeDutyCycleCallback(MakeDouble(dutyCycle));
+    }
   }
 }
 
@@ -134,7 +145,10 @@ int32_t DigitalPWMData::GetPin() { return m_pin; }
 void DigitalPWMData::SetPin(int32_t pin) {
   int32_t oldValue = m_pin.exchange(pin);
   if (oldValue != pin) {
-    InvokePinCallback(MakeInt(pin));
+    RecordChange(this, "Pin");
+    if (m_pinCallbacks) {
+      InvokePinCallback(MakeInt(pin));
+    }
   }
 }
 
@@ -12,6 +12,8 @@
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/DigitalPWMData.h"
 #include "MockData/NotifyListenerVector.h"
 
@@ -44,11 +46,12 @@ class DigitalPWMData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
   std::atomic<double> m_dutyCycle{false};
-  std::shared_ptr<NotifyListenerVector> m_dutyCycleCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_dutyCycleCallbacks;
   std::atomic<int32_t> m_pin{0};
-  std::shared_ptr<NotifyListenerVector> m_pinCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_pinCallbacks;
 };
-extern DigitalPWMData* SimDigitalPWMData;
+extern SimContextLocalArray<DigitalPWMData, kNumDigitalPWMOutputs>
+    SimDigitalPWMData;
 }  // namespace hal
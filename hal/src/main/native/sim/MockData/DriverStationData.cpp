@@ -11,6 +11,7 @@
 
 #include "DriverStationDataInternal.h"
 #include "HAL/cpp/make_unique.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 namespace hal {
@@ -32,14 +33,17 @@ using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeDriverStationData() {
-  static DriverStationData dsd;
-  ::hal::SimDriverStationData = &dsd;
-}
+void InitializeDriverStationData() { ::hal::SimDriverStationData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-DriverStationData* hal::SimDriverStationData;
+SimContextLocal<DriverStationData> hal::SimDriverStationData;
+
+static void RecordChange(const DriverStationData* data, const char* field) {
+  SimChangeBatchData->RecordChange("DriverStation",
+                                   data - SimDriverStationData, -1, field);
+}
+
 
 DriverStationData::DriverStationData() { ResetData(); }
 
@@ -113,7 +117,10 @@ HAL_Bool DriverStationData::GetEnabled() { return m_enabled; }
 void DriverStationData::SetEnabled(HAL_Bool enabled) {
   HAL_Bool oldValue = m_enabled.exchange(enabled);
   if (oldValue != enabled) {
-    InvokeEnabledCallback(MakeBoolean(enabled));
+    RecordChange(this, "Enabled");
+    if (m_enabledCallbacks) {
+      InvokeEnabledCallback(MakeBoolean(enabled));
+    }
   }
 }
 
@@ -148,7 +155,10 @@ HAL_Bool DriverStationData::GetAutonomous() { return m_autonomous; }
 void DriverStationData::SetAutonomous(HAL_Bool autonomous) {
   HAL_Bool oldValue = m_autonomous.exchange(autonomous);
   if (oldValue != autonomous) {
-    InvokeAutonomousCallback(MakeBoolean(autonomous));
+    RecordChange(this, "Autonomous");
+    if (m_autonomousCallbacks) {
+      InvokeAutonomousCallback(MakeBoolean(autonomous));
+    }
   }
 }
 
@@ -184,7 +194,10 @@ HAL_Bool DriverStationData::GetTest() { return m_test; }
 void DriverStationData::SetTest(HAL_Bool test) {
   HAL_Bool oldValue = m_test.exchange(test);
   if (oldValue != test) {
-    InvokeTestCallback(MakeBoolean(test));
+    RecordChange(this, "Test");
+    if (m_testCallbacks) {
+      InvokeTestCallback(MakeBoolean(test));
+    }
   }
 }
 
@@ -220,7 +233,10 @@ HAL_Bool DriverStationData::GetEStop() { return m_eStop; }
 void DriverStationData::SetEStop(HAL_Bool eStop) {
   HAL_Bool oldValue = m_eStop.exchange(eStop);
   if (oldValue != eStop) {
-    InvokeEStopCallback(MakeBoolean(eStop));
+    RecordChange(this, "EStop");
+    if (m_eStopCallbacks) {
+      InvokeEStopCallback(MakeBoolean(eStop));
+    }
   }
 }
 
@@ -255,7 +271,10 @@ HAL_Bool DriverStationData::GetFmsAttached() { return m_fmsAttached; }
 void DriverStationData::SetFmsAttached(HAL_Bool fmsAttached) {
   HAL_Bool oldValue = m_fmsAttached.exchange(fmsAttached);
   if (oldValue != fmsAttached) {
-    InvokeFmsAttachedCallback(MakeBoolean(fmsAttached));
+    RecordChange(this, "FmsAttached");
+    if (m_fmsAttachedCallbacks) {
+      InvokeFmsAttachedCallback(MakeBoolean(fmsAttached));
+    }
   }
 }
 
@@ -290,7 +309,10 @@ HAL_Bool DriverStationData::GetDsAttached() { return m_dsAttached; }
 void DriverStationData::SetDsAttached(HAL_Bool dsAttached) {
   HAL_Bool oldValue = m_dsAttached.exchange(dsAttached);
   if (oldValue != dsAttached) {
-    InvokeDsAttachedCallback(MakeBoolean(dsAttached));
+    RecordChange(this, "DsAttached");
+    if (m_dsAttachedCallbacks) {
+      InvokeDsAttachedCallback(MakeBoolean(dsAttached));
+    }
   }
 }
 
@@ -331,7 +353,10 @@ void DriverStationData::SetAllianceStationId(
   HAL_AllianceStationID oldValue =
       m_allianceStationId.exchange(allianceStationId);
   if (oldValue != allianceStationId) {
-    InvokeAllianceStationIdCallback(MakeEnum(allianceStationId));
+    RecordChange(this, "AllianceStationId");
+    if (m_allianceStationIdCallbacks) {
+      InvokeAllianceStationIdCallback(MakeEnum(allianceStationId));
+    }
   }
 }
 
@@ -366,10 +391,22 @@ double DriverStationData::GetMatchTime() { return m_matchTime; }
 void DriverStationData::SetMatchTime(double matchTime) {
   double oldValue = m_matchTime.exchange(matchTime);
   if (oldValue != matchTime) {
-    InvokeMatchTimeCallback(MakeDouble(matchTime));
+    RecordChange(this, "MatchTime");
+    if (m_matchTimeCallbacks) {
+      InvokeMatchTimeCallback(MakeDouble(matchTime));
+    }
   }
 }
 
+void DriverStationData::GetControlWord(HAL_ControlWord* controlWord) {
+  std::lock_guard<wpi::mutex> lock(m_joystickDataMutex);
+  controlWord->enabled = m_enabled;
+  controlWord->autonomous = m_autonomous;
+  controlWord->test = m_test;
+  controlWord->eStop = m_eStop;
+  controlWord->fmsAttached = m_fmsAttached;
+  controlWord->dsAttached = m_dsAttached;
+}
 void DriverStationData::GetJoystickAxes(int32_t joystickNum,
                                         HAL_JoystickAxes* axes) {
   std::lock_guard<wpi::mutex> lock(m_joystickDataMutex);
@@ -420,6 +457,19 @@ void DriverStationData::FreeMatchInfo(const HAL_MatchInfo* info) {
   std::free(info->eventName);
   std::free(info->gameSpecificMessage);
 }
+void DriverStationData::GetInlineMatchInfo(HAL_InlineMatchInfo* info) {
+  std::lock_guard<wpi::mutex> lock(m_matchInfoMutex);
+  size_t eventLen = m_matchInfo->eventName.copy(info->eventName,
+                                                sizeof(info->eventName) - 1);
+  info->eventName[eventLen] = '\0';
+  size_t gameLen = m_matchInfo->gameSpecificMessage.copy(
+      info->gameSpecificMessage, sizeof(info->gameSpecificMessage) - 1);
+  info->gameSpecificMessage[gameLen] = '\0';
+  info->gameSpecificMessageSize = gameLen;
+  info->matchNumber = m_matchInfo->matchNumber;
+  info->replayNumber = m_matchInfo->replayNumber;
+  info->matchType = m_matchInfo->matchType;
+}
 
 void DriverStationData::SetJoystickAxes(int32_t joystickNum,
                                         const HAL_JoystickAxes* axes) {
@@ -461,7 +511,80 @@ void DriverStationData::SetMatchInfo(const HAL_MatchInfo* info) {
   m_matchInfo->replayNumber = info->replayNumber;
 }
 
-void DriverStationData::NotifyNewData() { HAL_ReleaseDSMutex(); }
+void DriverStationData::SetPacket(const HALSIM_DSPacket* packet) {
+  const HAL_ControlWord& word = packet->controlWord;
+  HAL_ControlWord old;
+  HAL_AllianceStationID oldAllianceStationId;
+  double oldMatchTime;
+  {
+    std::lock_guard<wpi::mutex> lock(m_joystickDataMutex);
+    old.enabled = m_enabled.exchange(word.enabled);
+    old.autonomous = m_autonomous.exchange(word.autonomous);
+    old.test = m_test.exchange(word.test);
+    old.eStop = m_eStop.exchange(word.eStop);
+    old.fmsAttached = m_fmsAttached.exchange(word.fmsAttached);
+    old.dsAttached = m_dsAttached.exchange(word.dsAttached);
+    oldAllianceStationId =
+        m_allianceStationId.exchange(packet->allianceStationId);
+    oldMatchTime = m_matchTime.exchange(packet->matchTime);
+    for (int i = 0; i < HALSIM_kNumJoysticks; i++) {
+      m_joystickAxes[i] = packet->axes[i];
+      m_joystickPOVs[i] = packet->povs[i];
+      m_joystickButtons[i] = packet->buttons[i];
+    }
+  }
+
+  // The callbacks see the whole packet, whichever of them runs first
+  if (old.enabled != word.enabled) {
+    RecordChange(this, "Enabled");
+    if (m_enabledCallbacks) InvokeEnabledCallback(MakeBoolean(word.enabled));
+  }
+  if (old.autonomous != word.autonomous) {
+    RecordChange(this, "Autonomous");
+    if (m_autonomousCallbacks) {
+      InvokeAutonomousCallback(MakeBoolean(word.autonomous));
+    }
+  }
+  if (old.test != word.test) {
+    RecordChange(this, "Test");
+    if (m_testCallbacks) InvokeTestCallback(MakeBoolean(word.test));
+  }
+  if (old.eStop != word.eStop) {
+    RecordChange(this, "EStop");
+    if (m_eStopCallbacks) InvokeEStopCallback(MakeBoolean(word.eStop));
+  }
+  if (old.fmsAttached != word.fmsAttached) {
+    RecordChange(this, "FmsAttached");
+    if (m_fmsAttachedCallbacks) {
+      InvokeFmsAttachedCallback(MakeBoolean(word.fmsAttached));
+    }
+  }
+  if (old.dsAttached != word.dsAttached) {
+    RecordChange(this, "DsAttached");
+    if (m_dsAttachedCallbacks) {
+      InvokeDsAttachedCallback(MakeBoolean(word.dsAttached));
+    }
+  }
+  if (oldAllianceStationId != packet->allianceStationId) {
+    RecordChange(this, "AllianceStationId");
+    if (m_allianceStationIdCallbacks) {
+      InvokeAllianceStationIdCallback(MakeEnum(packet->allianceStationId));
+    }
+  }
+  if (oldMatchTime != packet->matchTime) {
+    RecordChange(this, "MatchTime");
+    if (m_matchTimeCallbacks) {
+      InvokeMatchTimeCallback(MakeDouble(packet->matchTime));
+    }
+  }
+
+  NotifyNewData();
+}
+void DriverStationData::NotifyNewData() {
+  // deliver the changes made during the previous robot loop
+  SimChangeBatchData->Flush();
+  HAL_ReleaseDSMutex();
+}
 
 extern "C" {
 void HALSIM_ResetDriverStationData(void) { SimDriverStationData->ResetData(); }
@@ -617,6 +740,10 @@ void HALSIM_SetMatchInfo(const HAL_MatchInfo* info) {
   SimDriverStationData->SetMatchInfo(info);
 }
 
+void HALSIM_SetDriverStationPacket(const HALSIM_DSPacket* packet) {
+  SimDriverStationData->SetPacket(packet);
+}
+
 void HALSIM_NotifyDriverStationNewData(void) {
   SimDriverStationData->NotifyNewData();
 }
@@ -13,6 +13,7 @@
 
 #include <support/mutex.h>
 
+#include "../SimContextInternal.h"
 #include "MockData/DriverStationData.h"
 #include "MockData/NotifyListenerVector.h"
 
@@ -82,6 +83,7 @@ class DriverStationData {
   double GetMatchTime();
   void SetMatchTime(double matchTime);
 
+  void GetControlWord(HAL_ControlWord* controlWord);
   void GetJoystickAxes(int32_t joystickNum, HAL_JoystickAxes* axes);
   void GetJoystickPOVs(int32_t joystickNum, HAL_JoystickPOVs* povs);
   void GetJoystickButtons(int32_t joystickNum, HAL_JoystickButtons* buttons);
@@ -91,6 +93,7 @@ class DriverStationData {
                           int32_t* leftRumble, int32_t* rightRumble);
   void GetMatchInfo(HAL_MatchInfo* info);
   void FreeMatchInfo(const HAL_MatchInfo* info);
+  void GetInlineMatchInfo(HAL_InlineMatchInfo* info);
 
   void SetJoystickAxes(int32_t joystickNum, const HAL_JoystickAxes* axes);
   void SetJoystickPOVs(int32_t joystickNum, const HAL_JoystickPOVs* povs);
@@ -101,29 +104,31 @@ class DriverStationData {
   void SetJoystickOutputs(int32_t joystickNum, int64_t outputs,
                           int32_t leftRumble, int32_t rightRumble);
   void SetMatchInfo(const HAL_MatchInfo* info);
+  void SetPacket(const HALSIM_DSPacket* packet);
 
   void NotifyNewData();
 
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_enabled{false};
-  std::shared_ptr<NotifyListenerVector> m_enabledCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_enabledCallbacks;
   std::atomic<HAL_Bool> m_autonomous{false};
-  std::shared_ptr<NotifyListenerVector> m_autonomousCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_autonomousCallbacks;
   std::atomic<HAL_Bool> m_test{false};
-  std::shared_ptr<NotifyListenerVector> m_testCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_testCallbacks;
   std::atomic<HAL_Bool> m_eStop{false};
-  std::shared_ptr<NotifyListenerVector> m_eStopCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_eStopCallbacks;
   std::atomic<HAL_Bool> m_fmsAttached{false};
-  std::shared_ptr<NotifyListenerVector> m_fmsAttachedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_fmsAttachedCallbacks;
   std::atomic<HAL_Bool> m_dsAttached{false};
-  std::shared_ptr<NotifyListenerVector> m_dsAttachedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_dsAttachedCallbacks;
   std::atomic<HAL_AllianceStationID> m_allianceStationId{
       static_cast<HAL_AllianceStationID>(0)};
-  std::shared_ptr<NotifyListenerVector> m_allianceStationIdCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_allianceStationIdCallbacks;
   std::atomic<double> m_matchTime{0.0};
-  std::shared_ptr<NotifyListenerVector> m_matchTimeCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_matchTimeCallbacks;
 
+  // Also held while a packet is applied, and while the control word is read
   wpi::mutex m_joystickDataMutex;
   wpi::mutex m_matchInfoMutex;
 
@@ -135,5 +140,5 @@ class DriverStationData {
   std::unique_ptr<HAL_JoystickDescriptor[]> m_joystickDescriptor;
   std::unique_ptr<MatchInfoDataStore> m_matchInfo;
 };
-extern DriverStationData* SimDriverStationData;
+extern SimContextLocal<DriverStationData> SimDriverStationData;
 }  // namespace hal
@@ -7,24 +7,28 @@
 
 #include "../PortsInternal.h"
 #include "EncoderDataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeEncoderData() {
-  static EncoderData sed[kNumEncoders];
-  ::hal::SimEncoderData = sed;
-}
+void InitializeEncoderData() { ::hal::SimEncoderData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-EncoderData* hal::SimEncoderData;
+SimContextLocalHotArray<EncoderData, EncoderHotData, kNumEncoders>
+    hal::SimEncoderData;
+
+static void RecordChange(const EncoderData* data, const char* field) {
+  SimChangeBatchData->RecordChange("Encoder", data - SimEncoderData, -1, field);
+}
+
 void EncoderData::ResetData() {
   m_initialized = false;
   m_initializedCallbacks = nullptr;
-  m_count = 0;
+  *m_count = 0;
   m_countCallbacks = nullptr;
   m_period = std::numeric_limits<double>::max();
   m_periodCallbacks = nullptr;
@@ -40,6 +44,8 @@ void EncoderData::ResetData() {
   m_samplesToAverageCallbacks = nullptr;
   m_distancePerPulse = 0;
   m_distancePerPulseCallbacks = nullptr;
+  m_digitalChannelA = -1;
+  m_digitalChannelB = -1;
 }
 
 int32_t EncoderData::RegisterInitializedCallback(HAL_NotifyCallback callback,
@@ -74,7 +80,10 @@ HAL_Bool EncoderData::GetInitialized() { return m_initialized; }
 void EncoderData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -105,12 +114,15 @@ void EncoderData::InvokeCountCallback(HAL_Value value) {
   InvokeCallback(m_countCallbacks, "Count", &value);
 }
 
-int32_t EncoderData::GetCount() { return m_count; }
+int32_t EncoderData::GetCount() { return *m_count; }
 
 void EncoderData::SetCount(int32_t count) {
-  int32_t oldValue = m_count.exchange(count);
+  int32_t oldValue = m_count->exchange(count);
   if (oldValue != count) {
-    InvokeCountCallback(MakeInt(count));
+    RecordChange(this, "Count");
+    if (m_countCallbacks) {
+      InvokeCountCallback(MakeInt(count));
+    }
   }
 }
 
@@ -146,7 +158,10 @@ double EncoderData::GetPeriod() { return m_period; }
 void EncoderData::SetPeriod(double period) {
   double oldValue = m_period.exchange(period);
   if (oldValue != period) {
-    InvokePeriodCallback(MakeDouble(period));
+    RecordChange(this, "Period");
+    if (m_periodCallbacks) {
+      InvokePeriodCallback(MakeDouble(period));
+    }
   }
 }
 
@@ -182,7 +197,10 @@ HAL_Bool EncoderData::GetReset() { return m_reset; }
 void EncoderData::SetReset(HAL_Bool reset) {
   HAL_Bool oldValue = m_reset.exchange(reset);
   if (oldValue != reset) {
-    InvokeResetCallback(MakeBoolean(reset));
+    RecordChange(this, "Reset");
+    if (m_resetCallbacks) {
+      InvokeResetCallback(MakeBoolean(reset));
+    }
   }
 }
 
@@ -218,7 +236,10 @@ double EncoderData::GetMaxPeriod() { return m_maxPeriod; }
 void EncoderData::SetMaxPeriod(double maxPeriod) {
   double oldValue = m_maxPeriod.exchange(maxPeriod);
   if (oldValue != maxPeriod) {
-    InvokeMaxPeriodCallback(MakeDouble(maxPeriod));
+    RecordChange(this, "MaxPeriod");
+    if (m_maxPeriodCallbacks) {
+      InvokeMaxPeriodCallback(MakeDouble(maxPeriod));
+    }
   }
 }
 
@@ -254,7 +275,10 @@ HAL_Bool EncoderData::GetDirection() { return m_direction; }
 void EncoderData::SetDirection(HAL_Bool direction) {
   HAL_Bool oldValue = m_direction.exchange(direction);
   if (oldValue != direction) {
-    InvokeDirectionCallback(MakeBoolean(direction));
+    RecordChange(this, "Direction");
+    if (m_directionCallbacks) {
+      InvokeDirectionCallback(MakeBoolean(direction));
+    }
   }
 }
 
@@ -291,7 +315,10 @@ HAL_Bool EncoderData::GetReverseDirection() { return m_reverseDirection; }
 void EncoderData::SetReverseDirection(HAL_Bool reverseDirection) {
   HAL_Bool oldValue = m_reverseDirection.exchange(reverseDirection);
   if (oldValue != reverseDirection) {
-    InvokeReverseDirectionCallback(MakeBoolean(reverseDirection));
+    RecordChange(this, "ReverseDirection");
+    if (m_reverseDirectionCallbacks) {
+      InvokeReverseDirectionCallback(MakeBoolean(reverseDirection));
+    }
   }
 }
 
@@ -328,7 +355,10 @@ int32_t EncoderData::GetSamplesToAverage() { return m_samplesToAverage; }
 void EncoderData::SetSamplesToAverage(int32_t samplesToAverage) {
   int32_t oldValue = m_samplesToAverage.exchange(samplesToAverage);
   if (oldValue != samplesToAverage) {
-    InvokeSamplesToAverageCallback(MakeInt(samplesToAverage));
+    RecordChange(this, "SamplesToAverage");
+    if (m_samplesToAverageCallbacks) {
+      InvokeSamplesToAverageCallback(MakeInt(samplesToAverage));
+    }
   }
 }
 
@@ -364,7 +394,10 @@ double EncoderData::GetDistancePerPulse() { return m_distancePerPulse; }
 void EncoderData::SetDistancePerPulse(double distancePerPulse) {
   double oldValue = m_distancePerPulse.exchange(distancePerPulse);
   if (oldValue != distancePerPulse) {
-    InvokeDistancePerPulseCallback(MakeDouble(distancePerPulse));
+    RecordChange(this, "DistancePerPulse");
+    if (m_distancePerPulseCallbacks) {
+      InvokeDistancePerPulseCallback(MakeDouble(distancePerPulse));
+    }
   }
 }
 
@@ -413,6 +446,18 @@ void HALSIM_SetEncoderCount(int32_t index, int32_t count) {
   SimEncoderData[index].SetCount(count);
 }
 
+int32_t HALSIM_GetAllEncoderCounts(int32_t* counts, int32_t count) {
+  if (count > kNumEncoders) count = kNumEncoders;
+  auto& hot = SimEncoderData.GetHot();
+  for (int32_t i = 0; i < count; i++) counts[i] = hot.count[i];
+  return count;
+}
+
+void HALSIM_SetAllEncoderCounts(const int32_t* counts, int32_t count) {
+  if (count > kNumEncoders) count = kNumEncoders;
+  for (int32_t i = 0; i < count; i++) SimEncoderData[i].SetCount(counts[i]);
+}
+
 int32_t HALSIM_RegisterEncoderPeriodCallback(int32_t index,
                                              HAL_NotifyCallback callback,
                                              void* param,
@@ -533,6 +578,25 @@ void HALSIM_SetEncoderSamplesToAverage(int32_t index,
   SimEncoderData[index].SetSamplesToAverage(samplesToAverage);
 }
 
+int32_t HALSIM_GetEncoderDigitalChannelA(int32_t index) {
+  return SimEncoderData[index].GetDigitalChannelA();
+}
+
+int32_t HALSIM_GetEncoderDigitalChannelB(int32_t index) {
+  return SimEncoderData[index].GetDigitalChannelB();
+}
+
+int32_t HALSIM_FindEncoderForChannel(int32_t channel) {
+  for (int32_t i = 0; i < kNumEncoders; i++) {
+    if (!SimEncoderData[i].GetInitialized()) continue;
+    if (SimEncoderData[i].GetDigitalChannelA() == channel ||
+        SimEncoderData[i].GetDigitalChannelB() == channel) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 void HALSIM_RegisterEncoderAllCallbacks(int32_t index,
                                         HAL_NotifyCallback callback,
                                         void* param, HAL_Bool initialNotify) {
@@ -7,18 +7,35 @@
 
 #pragma once
 
+#include <stddef.h>
+
 #include <atomic>
 #include <limits>
 #include <memory>
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/EncoderData.h"
 #include "MockData/NotifyListenerVector.h"
 
 namespace hal {
+// The counts of all encoders, kept together for HALSIM_GetAllEncoderCounts()
+// and HALSIM_SetAllEncoderCounts()
+struct EncoderHotData {
+  EncoderHotData() {
+    for (auto& c : count) c = 0;
+  }
+  std::atomic<int32_t> count[kNumEncoders];
+};
+
 class EncoderData {
  public:
+  void BindHot(EncoderHotData& hot, size_t index) {
+    m_count = &hot.count[index];
+  }
+
   int32_t RegisterInitializedCallback(HAL_NotifyCallback callback, void* param,
                                       HAL_Bool initialNotify);
   void CancelInitializedCallback(int32_t uid);
@@ -82,28 +99,40 @@ class EncoderData {
   double GetDistancePerPulse();
   void SetDistancePerPulse(double distancePerPulse);
 
+  // The DIO channels of the sources, or -1 if they aren't DIOs. They are
+  // set before Initialized, and have no callbacks of their own.
+  int32_t GetDigitalChannelA() { return m_digitalChannelA; }
+  int32_t GetDigitalChannelB() { return m_digitalChannelB; }
+  void SetDigitalChannels(int32_t channelA, int32_t channelB) {
+    m_digitalChannelA = channelA;
+    m_digitalChannelB = channelB;
+  }
+
   virtual void ResetData();
 
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
-  std::atomic<int32_t> m_count{0};
-  std::shared_ptr<NotifyListenerVector> m_countCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
+  std::atomic<int32_t>* m_count = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_countCallbacks;
   std::atomic<double> m_period{std::numeric_limits<double>::max()};
-  std::shared_ptr<NotifyListenerVector> m_periodCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_periodCallbacks;
   std::atomic<HAL_Bool> m_reset{false};
-  std::shared_ptr<NotifyListenerVector> m_resetCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_resetCallbacks;
   std::atomic<double> m_maxPeriod{0};
-  std::shared_ptr<NotifyListenerVector> m_maxPeriodCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_maxPeriodCallbacks;
   std::atomic<HAL_Bool> m_direction{false};
-  std::shared_ptr<NotifyListenerVector> m_directionCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_directionCallbacks;
   std::atomic<HAL_Bool> m_reverseDirection{false};
-  std::shared_ptr<NotifyListenerVector> m_reverseDirectionCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_reverseDirectionCallbacks;
   std::atomic<int32_t> m_samplesToAverage{0};
-  std::shared_ptr<NotifyListenerVector> m_samplesToAverageCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_samplesToAverageCallbacks;
   std::atomic<double> m_distancePerPulse{0};
-  std::shared_ptr<NotifyListenerVector> m_distancePerPulseCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_distancePerPulseCallbacks;
+  std::atomic<int32_t> m_digitalChannelA{-1};
+  std::atomic<int32_t> m_digitalChannelB{-1};
 };
-extern EncoderData* SimEncoderData;
+extern SimContextLocalHotArray<EncoderData, EncoderHotData, kNumEncoders>
+    SimEncoderData;
 }  // namespace hal
@@ -6,28 +6,35 @@
 /*----------------------------------------------------------------------------*/
 
 #include <iostream>
+#include <utility>
 
 #include "../PortsInternal.h"
 #include "I2CDataInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 
 using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeI2CData() {
-  static I2CData sid[2];
-  ::hal::SimI2CData = sid;
-}
+void InitializeI2CData() { ::hal::SimI2CData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-I2CData* hal::SimI2CData;
+SimContextLocalArray<I2CData, kNumI2CDataPorts> hal::SimI2CData;
+
+static void RecordChange(const I2CData* data, const char* field) {
+  SimChangeBatchData->RecordChange("I2C", data - SimI2CData, -1, field);
+}
+
 
 void I2CData::ResetData() {
   m_initialized = false;
   m_initializedCallbacks = nullptr;
   m_readCallbacks = nullptr;
+  for (auto& model : m_models) {
+    std::atomic_store(&model, std::shared_ptr<BusDeviceModel>());
+  }
 }
 
 I2CData::I2CData() {}
@@ -68,7 +75,10 @@ HAL_Bool I2CData::GetInitialized() { return m_initialized; }
 void I2CData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -108,15 +118,28 @@ void I2CData::CancelWriteCallback(int32_t uid) {
 
 void I2CData::Write(int32_t deviceAddress, const uint8_t* dataToSend,
                     int32_t sendSize) {
+  if (auto model = GetModel(deviceAddress)) model->Write(dataToSend, sendSize);
   std::lock_guard<wpi::mutex> lock(m_dataMutex);
   InvokeCallback(m_writeCallbacks, "Write", const_cast<uint8_t*>(dataToSend),
                  sendSize);
 }
 void I2CData::Read(int32_t deviceAddress, uint8_t* buffer, int32_t count) {
+  if (auto model = GetModel(deviceAddress)) model->Read(buffer, count);
   std::lock_guard<wpi::mutex> lock(m_dataMutex);
   InvokeCallback(m_readCallbacks, "Read", buffer, count);
 }
 
+void I2CData::SetModel(int32_t deviceAddress,
+                       std::shared_ptr<BusDeviceModel> model) {
+  if (deviceAddress < 0 || deviceAddress >= kNumI2CAddresses) return;
+  std::atomic_store(&m_models[deviceAddress], std::move(model));
+}
+
+std::shared_ptr<BusDeviceModel> I2CData::GetModel(int32_t deviceAddress) {
+  if (deviceAddress < 0 || deviceAddress >= kNumI2CAddresses) return nullptr;
+  return std::atomic_load(&m_models[deviceAddress]);
+}
+
 extern "C" {
 void HALSIM_ResetI2CData(int32_t index) { SimI2CData[index].ResetData(); }
 
@@ -13,10 +13,16 @@
 
 #include <support/mutex.h>
 
+#include "../SimContextInternal.h"
+#include "MockData/BusDeviceModel.h"
 #include "MockData/I2CData.h"
 #include "MockData/NotifyListenerVector.h"
 
 namespace hal {
+
+constexpr int32_t kNumI2CDataPorts = 2;
+constexpr int32_t kNumI2CAddresses = 128;
+
 class I2CData {
  public:
   I2CData();
@@ -39,15 +45,20 @@ class I2CData {
              int32_t sendSize);
   void Read(int32_t deviceAddress, uint8_t* buffer, int32_t count);
 
+  void SetModel(int32_t deviceAddress, std::shared_ptr<BusDeviceModel> model);
+  std::shared_ptr<BusDeviceModel> GetModel(int32_t deviceAddress);
+
   void ResetData();
 
  private:
   wpi::mutex m_registerMutex;
   wpi::mutex m_dataMutex;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
   std::shared_ptr<BufferListenerVector> m_readCallbacks = nullptr;
   std::shared_ptr<ConstBufferListenerVector> m_writeCallbacks = nullptr;
+  // indexed by 7-bit address
+  std::shared_ptr<BusDeviceModel> m_models[kNumI2CAddresses];
 };
-extern I2CData* SimI2CData;
+extern SimContextLocalArray<I2CData, kNumI2CDataPorts> SimI2CData;
 }  // namespace hal
@@ -35,6 +35,20 @@ void InvokeCallback(std::shared_ptr<NotifyListenerVector> currentVector,
   }
 }
 
+void InvokeCallback(
+    const AtomicListenerVector<NotifyListenerVector>& currentVector,
+    const char* name, const HAL_Value* value) {
+  // Borrow the published vector; it stays alive until the reader is destroyed
+  AtomicListenerVector<NotifyListenerVector>::Reader callbacks(currentVector);
+  // Return if no callbacks are assigned
+  if (!callbacks) return;
+  for (size_t i = 0; i < callbacks->size(); ++i) {
+    auto& listener = (*callbacks)[i];
+    if (!listener) continue;  // removed
+    listener.callback(name, listener.param, value);
+  }
+}
+
 std::shared_ptr<BufferListenerVector> RegisterCallback(
     std::shared_ptr<BufferListenerVector> currentVector, const char* name,
     HAL_BufferCallback callback, void* param, int32_t* newUid) {
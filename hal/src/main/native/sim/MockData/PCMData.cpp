@@ -6,6 +6,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "../PortsInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 #include "PCMDataInternal.h"
 
@@ -13,14 +14,21 @@ using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializePCMData() {
-  static PCMData spd[kNumPCMModules];
-  ::hal::SimPCMData = spd;
-}
+void InitializePCMData() { ::hal::SimPCMData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-PCMData* hal::SimPCMData;
+SimContextLocalArray<PCMData, kNumPCMModules> hal::SimPCMData;
+
+static void RecordChange(const PCMData* data, int32_t channel,
+                         const char* field) {
+  SimChangeBatchData->RecordChange("PCM", data - SimPCMData, channel, field);
+}
+
+static void RecordChange(const PCMData* data, const char* field) {
+  SimChangeBatchData->RecordChange("PCM", data - SimPCMData, -1, field);
+}
+
 void PCMData::ResetData() {
   for (int i = 0; i < kNumSolenoidChannels; i++) {
     m_solenoidInitialized[i] = false;
@@ -80,8 +88,11 @@ void PCMData::SetSolenoidInitialized(int32_t channel,
   HAL_Bool oldValue =
       m_solenoidInitialized[channel].exchange(solenoidInitialized);
   if (oldValue != solenoidInitialized) {
-    InvokeSolenoidInitializedCallback(channel,
-                                      MakeBoolean(solenoidInitialized));
+    RecordChange(this, channel, "SolenoidInitialized");
+    if (m_solenoidInitializedCallbacks[channel]) {
+      InvokeSolenoidInitializedCallback(channel,
+                                        MakeBoolean(solenoidInitialized));
+    }
   }
 }
 
@@ -122,7 +133,10 @@ HAL_Bool PCMData::GetSolenoidOutput(int32_t channel) {
 void PCMData::SetSolenoidOutput(int32_t channel, HAL_Bool solenoidOutput) {
   HAL_Bool oldValue = m_solenoidOutput[channel].exchange(solenoidOutput);
   if (oldValue != solenoidOutput) {
-    InvokeSolenoidOutputCallback(channel, MakeBoolean(solenoidOutput));
+    RecordChange(this, channel, "SolenoidOutput");
+    if (m_solenoidOutputCallbacks[channel]) {
+      InvokeSolenoidOutputCallback(channel, MakeBoolean(solenoidOutput));
+    }
   }
 }
 
@@ -160,7 +174,10 @@ HAL_Bool PCMData::GetCompressorInitialized() { return m_compressorInitialized; }
 void PCMData::SetCompressorInitialized(HAL_Bool compressorInitialized) {
   HAL_Bool oldValue = m_compressorInitialized.exchange(compressorInitialized);
   if (oldValue != compressorInitialized) {
-    InvokeCompressorInitializedCallback(MakeBoolean(compressorInitialized));
+    RecordChange(this, "CompressorInitialized");
+    if (m_compressorInitializedCallbacks) {
+      InvokeCompressorInitializedCallback(MakeBoolean(compressorInitialized));
+    }
   }
 }
 
@@ -196,7 +213,10 @@ HAL_Bool PCMData::GetCompressorOn() { return m_compressorOn; }
 void PCMData::SetCompressorOn(HAL_Bool compressorOn) {
   HAL_Bool oldValue = m_compressorOn.exchange(compressorOn);
   if (oldValue != compressorOn) {
-    InvokeCompressorOnCallback(MakeBoolean(compressorOn));
+    RecordChange(this, "CompressorOn");
+    if (m_compressorOnCallbacks) {
+      InvokeCompressorOnCallback(MakeBoolean(compressorOn));
+    }
   }
 }
 
@@ -234,7 +254,10 @@ HAL_Bool PCMData::GetClosedLoopEnabled() { return m_closedLoopEnabled; }
 void PCMData::SetClosedLoopEnabled(HAL_Bool closedLoopEnabled) {
   HAL_Bool oldValue = m_closedLoopEnabled.exchange(closedLoopEnabled);
   if (oldValue != closedLoopEnabled) {
-    InvokeClosedLoopEnabledCallback(MakeBoolean(closedLoopEnabled));
+    RecordChange(this, "ClosedLoopEnabled");
+    if (m_closedLoopEnabledCallbacks) {
+      InvokeClosedLoopEnabledCallback(MakeBoolean(closedLoopEnabled));
+    }
   }
 }
 
@@ -270,7 +293,10 @@ HAL_Bool PCMData::GetPressureSwitch() { return m_pressureSwitch; }
 void PCMData::SetPressureSwitch(HAL_Bool pressureSwitch) {
   HAL_Bool oldValue = m_pressureSwitch.exchange(pressureSwitch);
   if (oldValue != pressureSwitch) {
-    InvokePressureSwitchCallback(MakeBoolean(pressureSwitch));
+    RecordChange(this, "PressureSwitch");
+    if (m_pressureSwitchCallbacks) {
+      InvokePressureSwitchCallback(MakeBoolean(pressureSwitch));
+    }
   }
 }
 
@@ -308,7 +334,10 @@ double PCMData::GetCompressorCurrent() { return m_compressorCurrent; }
 void PCMData::SetCompressorCurrent(double compressorCurrent) {
   double oldValue = m_compressorCurrent.exchange(compressorCurrent);
   if (oldValue != compressorCurrent) {
-    InvokeCompressorCurrentCallback(MakeDouble(compressorCurrent));
+    RecordChange(this, "CompressorCurrent");
+    if (m_compressorCurrentCallbacks) {
+      InvokeCompressorCurrentCallback(MakeDouble(compressorCurrent));
+    }
   }
 }
 
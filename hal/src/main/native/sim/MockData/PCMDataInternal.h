@@ -13,6 +13,7 @@
 #include <support/mutex.h>
 
 #include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/NotifyListenerVector.h"
 #include "MockData/PCMData.h"
 
@@ -79,22 +80,21 @@ class PCMData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_solenoidInitialized[kNumSolenoidChannels];
-  std::shared_ptr<NotifyListenerVector>
+  AtomicListenerVector<NotifyListenerVector>
       m_solenoidInitializedCallbacks[kNumSolenoidChannels];
   std::atomic<HAL_Bool> m_solenoidOutput[kNumSolenoidChannels];
-  std::shared_ptr<NotifyListenerVector>
+  AtomicListenerVector<NotifyListenerVector>
       m_solenoidOutputCallbacks[kNumSolenoidChannels];
   std::atomic<HAL_Bool> m_compressorInitialized{false};
-  std::shared_ptr<NotifyListenerVector> m_compressorInitializedCallbacks =
-      nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_compressorInitializedCallbacks;
   std::atomic<HAL_Bool> m_compressorOn{false};
-  std::shared_ptr<NotifyListenerVector> m_compressorOnCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_compressorOnCallbacks;
   std::atomic<HAL_Bool> m_closedLoopEnabled{true};
-  std::shared_ptr<NotifyListenerVector> m_closedLoopEnabledCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_closedLoopEnabledCallbacks;
   std::atomic<HAL_Bool> m_pressureSwitch{false};
-  std::shared_ptr<NotifyListenerVector> m_pressureSwitchCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_pressureSwitchCallbacks;
   std::atomic<double> m_compressorCurrent{0.0};
-  std::shared_ptr<NotifyListenerVector> m_compressorCurrentCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_compressorCurrentCallbacks;
 };
-extern PCMData* SimPCMData;
+extern SimContextLocalArray<PCMData, kNumPCMModules> SimPCMData;
 }  // namespace hal
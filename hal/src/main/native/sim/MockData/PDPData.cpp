@@ -6,6 +6,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "../PortsInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 #include "PDPDataInternal.h"
 
@@ -13,14 +14,21 @@ using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializePDPData() {
-  static PDPData spd[kNumPDPModules];
-  ::hal::SimPDPData = spd;
-}
+void InitializePDPData() { ::hal::SimPDPData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-PDPData* hal::SimPDPData;
+SimContextLocalArray<PDPData, kNumPDPModules> hal::SimPDPData;
+
+static void RecordChange(const PDPData* data, int32_t channel,
+                         const char* field) {
+  SimChangeBatchData->RecordChange("PDP", data - SimPDPData, channel, field);
+}
+
+static void RecordChange(const PDPData* data, const char* field) {
+  SimChangeBatchData->RecordChange("PDP", data - SimPDPData, -1, field);
+}
+
 void PDPData::ResetData() {
   m_initialized = false;
   m_initializedCallbacks = nullptr;
@@ -66,7 +74,10 @@ HAL_Bool PDPData::GetInitialized() { return m_initialized; }
 void PDPData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -102,7 +113,10 @@ double PDPData::GetTemperature() { return m_temperature; }
 void PDPData::SetTemperature(double temperature) {
   double oldValue = m_temperature.exchange(temperature);
   if (oldValue != temperature) {
-    InvokeTemperatureCallback(MakeDouble(temperature));
+    RecordChange(this, "Temperature");
+    if (m_temperatureCallbacks) {
+      InvokeTemperatureCallback(MakeDouble(temperature));
+    }
   }
 }
 
@@ -137,7 +151,10 @@ double PDPData::GetVoltage() { return m_voltage; }
 void PDPData::SetVoltage(double voltage) {
   double oldValue = m_voltage.exchange(voltage);
   if (oldValue != voltage) {
-    InvokeVoltageCallback(MakeDouble(voltage));
+    RecordChange(this, "Voltage");
+    if (m_voltageCallbacks) {
+      InvokeVoltageCallback(MakeDouble(voltage));
+    }
   }
 }
 
@@ -174,7 +191,10 @@ double PDPData::GetCurrent(int32_t channel) { return m_current[channel]; }
 void PDPData::SetCurrent(int32_t channel, double current) {
   double oldValue = m_current[channel].exchange(current);
   if (oldValue != current) {
-    InvokeCurrentCallback(channel, MakeDouble(current));
+    RecordChange(this, channel, "Current");
+    if (m_currentCallbacks[channel]) {
+      InvokeCurrentCallback(channel, MakeDouble(current));
+    }
   }
 }
 
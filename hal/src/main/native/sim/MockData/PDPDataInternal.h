@@ -13,6 +13,7 @@
 #include <support/mutex.h>
 
 #include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/NotifyListenerVector.h"
 #include "MockData/PDPData.h"
 
@@ -52,13 +53,14 @@ class PDPData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
   std::atomic<double> m_temperature{0.0};
-  std::shared_ptr<NotifyListenerVector> m_temperatureCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_temperatureCallbacks;
   std::atomic<double> m_voltage{12.0};
-  std::shared_ptr<NotifyListenerVector> m_voltageCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_voltageCallbacks;
   std::atomic<double> m_current[kNumPDPChannels];
-  std::shared_ptr<NotifyListenerVector> m_currentCallbacks[kNumPDPChannels];
+  AtomicListenerVector<NotifyListenerVector>
+      m_currentCallbacks[kNumPDPChannels];
 };
-extern PDPData* SimPDPData;
+extern SimContextLocalArray<PDPData, kNumPDPModules> SimPDPData;
 }  // namespace hal
@@ -6,6 +6,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "../PortsInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 #include "PWMDataInternal.h"
 
@@ -13,20 +14,22 @@ using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializePWMData() {
-  static PWMData spd[kNumPWMChannels];
-  ::hal::SimPWMData = spd;
-}
+void InitializePWMData() { ::hal::SimPWMData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-PWMData* hal::SimPWMData;
+SimContextLocalHotArray<PWMData, PWMHotData, kNumPWMChannels> hal::SimPWMData;
+
+static void RecordChange(const PWMData* data, const char* field) {
+  SimChangeBatchData->RecordChange("PWM", data - SimPWMData, -1, field);
+}
+
 void PWMData::ResetData() {
   m_initialized = false;
   m_initializedCallbacks = nullptr;
   m_rawValue = 0;
   m_rawValueCallbacks = nullptr;
-  m_speed = 0;
+  *m_speed = 0;
   m_speedCallbacks = nullptr;
   m_position = 0;
   m_positionCallbacks = nullptr;
@@ -68,7 +71,10 @@ HAL_Bool PWMData::GetInitialized() { return m_initialized; }
 void PWMData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -103,7 +109,10 @@ int32_t PWMData::GetRawValue() { return m_rawValue; }
 void PWMData::SetRawValue(int32_t rawValue) {
   int32_t oldValue = m_rawValue.exchange(rawValue);
   if (oldValue != rawValue) {
-    InvokeRawValueCallback(MakeInt(rawValue));
+    RecordChange(this, "RawValue");
+    if (m_rawValueCallbacks) {
+      InvokeRawValueCallback(MakeInt(rawValue));
+    }
   }
 }
 
@@ -133,12 +142,15 @@ void PWMData::InvokeSpeedCallback(HAL_Value value) {
   InvokeCallback(m_speedCallbacks, "Speed", &value);
 }
 
-double PWMData::GetSpeed() { return m_speed; }
+double PWMData::GetSpeed() { return *m_speed; }
 
 void PWMData::SetSpeed(double speed) {
-  double oldValue = m_speed.exchange(speed);
+  double oldValue = m_speed->exchange(speed);
   if (oldValue != speed) {
-    InvokeSpeedCallback(MakeDouble(speed));
+    RecordChange(this, "Speed");
+    if (m_speedCallbacks) {
+      InvokeSpeedCallback(MakeDouble(speed));
+    }
   }
 }
 
@@ -173,7 +185,10 @@ double PWMData::GetPosition() { return m_position; }
 void PWMData::SetPosition(double position) {
   double oldValue = m_position.exchange(position);
   if (oldValue != position) {
-    InvokePositionCallback(MakeDouble(position));
+    RecordChange(this, "Position");
+    if (m_positionCallbacks) {
+      InvokePositionCallback(MakeDouble(position));
+    }
   }
 }
 
@@ -209,7 +224,10 @@ int32_t PWMData::GetPeriodScale() { return m_periodScale; }
 void PWMData::SetPeriodScale(int32_t periodScale) {
   int32_t oldValue = m_periodScale.exchange(periodScale);
   if (oldValue != periodScale) {
-    InvokePeriodScaleCallback(MakeInt(periodScale));
+    RecordChange(this, "PeriodScale");
+    if (m_periodScaleCallbacks) {
+      InvokePeriodScaleCallback(MakeInt(periodScale));
+    }
   }
 }
 
@@ -245,7 +263,10 @@ HAL_Bool PWMData::GetZeroLatch() { return m_zeroLatch; }
 void PWMData::SetZeroLatch(HAL_Bool zeroLatch) {
   HAL_Bool oldValue = m_zeroLatch.exchange(zeroLatch);
   if (oldValue != zeroLatch) {
-    InvokeZeroLatchCallback(MakeBoolean(zeroLatch));
+    RecordChange(this, "ZeroLatch");
+    if (m_zeroLatchCallbacks) {
+      InvokeZeroLatchCallback(MakeBoolean(zeroLatch));
+    }
   }
 }
 
@@ -371,6 +392,18 @@ void HALSIM_SetPWMZeroLatch(int32_t index, HAL_Bool zeroLatch) {
   SimPWMData[index].SetZeroLatch(zeroLatch);
 }
 
+int32_t HALSIM_GetAllPWMSpeeds(double* speeds, int32_t count) {
+  if (count > kNumPWMChannels) count = kNumPWMChannels;
+  auto& hot = SimPWMData.GetHot();
+  for (int32_t i = 0; i < count; i++) speeds[i] = hot.speed[i];
+  return count;
+}
+
+void HALSIM_SetAllPWMSpeeds(const double* speeds, int32_t count) {
+  if (count > kNumPWMChannels) count = kNumPWMChannels;
+  for (int32_t i = 0; i < count; i++) SimPWMData[i].SetSpeed(speeds[i]);
+}
+
 void HALSIM_RegisterPWMAllCallbacks(int32_t index, HAL_NotifyCallback callback,
                                     void* param, HAL_Bool initialNotify) {
   SimPWMData[index].RegisterInitializedCallback(callback, param, initialNotify);
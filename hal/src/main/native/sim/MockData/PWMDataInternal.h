@@ -7,17 +7,31 @@
 
 #pragma once
 
+#include <stddef.h>
+
 #include <atomic>
 #include <memory>
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/NotifyListenerVector.h"
 #include "MockData/PWMData.h"
 
 namespace hal {
+// The speeds of all PWMs, kept together for HALSIM_GetAllPWMSpeeds()
+struct PWMHotData {
+  PWMHotData() {
+    for (auto& s : speed) s = 0;
+  }
+  std::atomic<double> speed[kNumPWMChannels];
+};
+
 class PWMData {
  public:
+  void BindHot(PWMHotData& hot, size_t index) { m_speed = &hot.speed[index]; }
+
   int32_t RegisterInitializedCallback(HAL_NotifyCallback callback, void* param,
                                       HAL_Bool initialNotify);
   void CancelInitializedCallback(int32_t uid);
@@ -65,17 +79,18 @@ class PWMData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
   std::atomic<int32_t> m_rawValue{0};
-  std::shared_ptr<NotifyListenerVector> m_rawValueCallbacks = nullptr;
-  std::atomic<double> m_speed{0};
-  std::shared_ptr<NotifyListenerVector> m_speedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_rawValueCallbacks;
+  std::atomic<double>* m_speed = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_speedCallbacks;
   std::atomic<double> m_position{0};
-  std::shared_ptr<NotifyListenerVector> m_positionCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_positionCallbacks;
   std::atomic<int32_t> m_periodScale{0};
-  std::shared_ptr<NotifyListenerVector> m_periodScaleCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_periodScaleCallbacks;
   std::atomic<HAL_Bool> m_zeroLatch{false};
-  std::shared_ptr<NotifyListenerVector> m_zeroLatchCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_zeroLatchCallbacks;
 };
-extern PWMData* SimPWMData;
+extern SimContextLocalHotArray<PWMData, PWMHotData, kNumPWMChannels>
+    SimPWMData;
 }  // namespace hal
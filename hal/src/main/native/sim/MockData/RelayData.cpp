@@ -6,6 +6,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "../PortsInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 #include "RelayDataInternal.h"
 
@@ -13,14 +14,16 @@ using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeRelayData() {
-  static RelayData srd[kNumRelayHeaders];
-  ::hal::SimRelayData = srd;
-}
+void InitializeRelayData() { ::hal::SimRelayData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-RelayData* hal::SimRelayData;
+SimContextLocalArray<RelayData, kNumRelayHeaders> hal::SimRelayData;
+
+static void RecordChange(const RelayData* data, const char* field) {
+  SimChangeBatchData->RecordChange("Relay", data - SimRelayData, -1, field);
+}
+
 void RelayData::ResetData() {
   m_initializedForward = false;
   m_initializedForwardCallbacks = nullptr;
@@ -65,7 +68,10 @@ HAL_Bool RelayData::GetInitializedForward() { return m_initializedForward; }
 void RelayData::SetInitializedForward(HAL_Bool initializedForward) {
   HAL_Bool oldValue = m_initializedForward.exchange(initializedForward);
   if (oldValue != initializedForward) {
-    InvokeInitializedForwardCallback(MakeBoolean(initializedForward));
+    RecordChange(this, "InitializedForward");
+    if (m_initializedForwardCallbacks) {
+      InvokeInitializedForwardCallback(MakeBoolean(initializedForward));
+    }
   }
 }
 
@@ -102,7 +108,10 @@ HAL_Bool RelayData::GetInitializedReverse() { return m_initializedReverse; }
 void RelayData::SetInitializedReverse(HAL_Bool initializedReverse) {
   HAL_Bool oldValue = m_initializedReverse.exchange(initializedReverse);
   if (oldValue != initializedReverse) {
-    InvokeInitializedReverseCallback(MakeBoolean(initializedReverse));
+    RecordChange(this, "InitializedReverse");
+    if (m_initializedReverseCallbacks) {
+      InvokeInitializedReverseCallback(MakeBoolean(initializedReverse));
+    }
   }
 }
 
@@ -138,7 +147,10 @@ HAL_Bool RelayData::GetForward() { return m_forward; }
 void RelayData::SetForward(HAL_Bool forward) {
   HAL_Bool oldValue = m_forward.exchange(forward);
   if (oldValue != forward) {
-    InvokeForwardCallback(MakeBoolean(forward));
+    RecordChange(this, "Forward");
+    if (m_forwardCallbacks) {
+      InvokeForwardCallback(MakeBoolean(forward));
+    }
   }
 }
 
@@ -174,7 +186,10 @@ HAL_Bool RelayData::GetReverse() { return m_reverse; }
 void RelayData::SetReverse(HAL_Bool reverse) {
   HAL_Bool oldValue = m_reverse.exchange(reverse);
   if (oldValue != reverse) {
-    InvokeReverseCallback(MakeBoolean(reverse));
+    RecordChange(this, "Reverse");
+    if (m_reverseCallbacks) {
+      InvokeReverseCallback(MakeBoolean(reverse));
+    }
   }
 }
 
@@ -12,6 +12,8 @@
 
 #include <support/mutex.h>
 
+#include "../PortsInternal.h"
+#include "../SimContextInternal.h"
 #include "MockData/NotifyListenerVector.h"
 #include "MockData/RelayData.h"
 
@@ -53,13 +55,13 @@ class RelayData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_initializedForward{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedForwardCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedForwardCallbacks;
   std::atomic<HAL_Bool> m_initializedReverse{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedReverseCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedReverseCallbacks;
   std::atomic<HAL_Bool> m_forward{false};
-  std::shared_ptr<NotifyListenerVector> m_forwardCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_forwardCallbacks;
   std::atomic<HAL_Bool> m_reverse{false};
-  std::shared_ptr<NotifyListenerVector> m_reverseCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_reverseCallbacks;
 };
-extern RelayData* SimRelayData;
+extern SimContextLocalArray<RelayData, kNumRelayHeaders> SimRelayData;
 }  // namespace hal
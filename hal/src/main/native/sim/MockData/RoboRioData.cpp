@@ -6,6 +6,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "../PortsInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 #include "RoboRioDataInternal.h"
 
@@ -13,14 +14,16 @@ using namespace hal;
 
 namespace hal {
 namespace init {
-void InitializeRoboRioData() {
-  static RoboRioData srrd[1];
-  ::hal::SimRoboRioData = srrd;
-}
+void InitializeRoboRioData() { ::hal::SimRoboRioData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-RoboRioData* hal::SimRoboRioData;
+SimContextLocalArray<RoboRioData, 1> hal::SimRoboRioData;
+
+static void RecordChange(const RoboRioData* data, const char* field) {
+  SimChangeBatchData->RecordChange("RoboRio", data - SimRoboRioData, -1, field);
+}
+
 void RoboRioData::ResetData() {
   m_fPGAButton = false;
   m_fPGAButtonCallbacks = nullptr;
@@ -86,7 +89,10 @@ HAL_Bool RoboRioData::GetFPGAButton() { return m_fPGAButton; }
 void RoboRioData::SetFPGAButton(HAL_Bool fPGAButton) {
   HAL_Bool oldValue = m_fPGAButton.exchange(fPGAButton);
   if (oldValue != fPGAButton) {
-    InvokeFPGAButtonCallback(MakeBoolean(fPGAButton));
+    RecordChange(this, "FPGAButton");
+    if (m_fPGAButtonCallbacks) {
+      InvokeFPGAButtonCallback(MakeBoolean(fPGAButton));
+    }
   }
 }
 
@@ -122,7 +128,10 @@ double RoboRioData::GetVInVoltage() { return m_vInVoltage; }
 void RoboRioData::SetVInVoltage(double vInVoltage) {
   double oldValue = m_vInVoltage.exchange(vInVoltage);
   if (oldValue != vInVoltage) {
-    InvokeVInVoltageCallback(MakeDouble(vInVoltage));
+    RecordChange(this, "VInVoltage");
+    if (m_vInVoltageCallbacks) {
+      InvokeVInVoltageCallback(MakeDouble(vInVoltage));
+    }
   }
 }
 
@@ -158,7 +167,10 @@ double RoboRioData::GetVInCurrent() { return m_vInCurrent; }
 void RoboRioData::SetVInCurrent(double vInCurrent) {
   double oldValue = m_vInCurrent.exchange(vInCurrent);
   if (oldValue != vInCurrent) {
-    InvokeVInCurrentCallback(MakeDouble(vInCurrent));
+    RecordChange(this, "VInCurrent");
+    if (m_vInCurrentCallbacks) {
+      InvokeVInCurrentCallback(MakeDouble(vInCurrent));
+    }
   }
 }
 
@@ -194,7 +206,10 @@ double RoboRioData::GetUserVoltage6V() { return m_userVoltage6V; }
 void RoboRioData::SetUserVoltage6V(double userVoltage6V) {
   double oldValue = m_userVoltage6V.exchange(userVoltage6V);
   if (oldValue != userVoltage6V) {
-    InvokeUserVoltage6VCallback(MakeDouble(userVoltage6V));
+    RecordChange(this, "UserVoltage6V");
+    if (m_userVoltage6VCallbacks) {
+      InvokeUserVoltage6VCallback(MakeDouble(userVoltage6V));
+    }
   }
 }
 
@@ -230,7 +245,10 @@ double RoboRioData::GetUserCurrent6V() { return m_userCurrent6V; }
 void RoboRioData::SetUserCurrent6V(double userCurrent6V) {
   double oldValue = m_userCurrent6V.exchange(userCurrent6V);
   if (oldValue != userCurrent6V) {
-    InvokeUserCurrent6VCallback(MakeDouble(userCurrent6V));
+    RecordChange(this, "UserCurrent6V");
+    if (m_userCurrent6VCallbacks) {
+      InvokeUserCurrent6VCallback(MakeDouble(userCurrent6V));
+    }
   }
 }
 
@@ -266,7 +284,10 @@ HAL_Bool RoboRioData::GetUserActive6V() { return m_userActive6V; }
 void RoboRioData::SetUserActive6V(HAL_Bool userActive6V) {
   HAL_Bool oldValue = m_userActive6V.exchange(userActive6V);
   if (oldValue != userActive6V) {
-    InvokeUserActive6VCallback(MakeBoolean(userActive6V));
+    RecordChange(this, "UserActive6V");
+    if (m_userActive6VCallbacks) {
+      InvokeUserActive6VCallback(MakeBoolean(userActive6V));
+    }
   }
 }
 
@@ -302,7 +323,10 @@ double RoboRioData::GetUserVoltage5V() { return m_userVoltage5V; }
 void RoboRioData::SetUserVoltage5V(double userVoltage5V) {
   double oldValue = m_userVoltage5V.exchange(userVoltage5V);
   if (oldValue != userVoltage5V) {
-    InvokeUserVoltage5VCallback(MakeDouble(userVoltage5V));
+    RecordChange(this, "UserVoltage5V");
+    if (m_userVoltage5VCallbacks) {
+      InvokeUserVoltage5VCallback(MakeDouble(userVoltage5V));
+    }
   }
 }
 
@@ -338,7 +362,10 @@ double RoboRioData::GetUserCurrent5V() { return m_userCurrent5V; }
 void RoboRioData::SetUserCurrent5V(double userCurrent5V) {
   double oldValue = m_userCurrent5V.exchange(userCurrent5V);
   if (oldValue != userCurrent5V) {
-    InvokeUserCurrent5VCallback(MakeDouble(userCurrent5V));
+    RecordChange(this, "UserCurrent5V");
+    if (m_userCurrent5VCallbacks) {
+      InvokeUserCurrent5VCallback(MakeDouble(userCurrent5V));
+    }
   }
 }
 
@@ -374,7 +401,10 @@ HAL_Bool RoboRioData::GetUserActive5V() { return m_userActive5V; }
 void RoboRioData::SetUserActive5V(HAL_Bool userActive5V) {
   HAL_Bool oldValue = m_userActive5V.exchange(userActive5V);
   if (oldValue != userActive5V) {
-    InvokeUserActive5VCallback(MakeBoolean(userActive5V));
+    RecordChange(this, "UserActive5V");
+    if (m_userActive5VCallbacks) {
+      InvokeUserActive5VCallback(MakeBoolean(userActive5V));
+    }
   }
 }
 
@@ -410,7 +440,10 @@ double RoboRioData::GetUserVoltage3V3() { return m_userVoltage3V3; }
 void RoboRioData::SetUserVoltage3V3(double userVoltage3V3) {
   double oldValue = m_userVoltage3V3.exchange(userVoltage3V3);
   if (oldValue != userVoltage3V3) {
-    InvokeUserVoltage3V3Callback(MakeDouble(userVoltage3V3));
+    RecordChange(this, "UserVoltage3V3");
+    if (m_userVoltage3V3Callbacks) {
+      InvokeUserVoltage3V3Callback(MakeDouble(userVoltage3V3));
+    }
   }
 }
 
@@ -446,7 +479,10 @@ double RoboRioData::GetUserCurrent3V3() { return m_userCurrent3V3; }
 void RoboRioData::SetUserCurrent3V3(double userCurrent3V3) {
   double oldValue = m_userCurrent3V3.exchange(userCurrent3V3);
   if (oldValue != userCurrent3V3) {
-    InvokeUserCurrent3V3Callback(MakeDouble(userCurrent3V3));
+    RecordChange(this, "UserCurrent3V3");
+    if (m_userCurrent3V3Callbacks) {
+      InvokeUserCurrent3V3Callback(MakeDouble(userCurrent3V3));
+    }
   }
 }
 
@@ -482,7 +518,10 @@ HAL_Bool RoboRioData::GetUserActive3V3() { return m_userActive3V3; }
 void RoboRioData::SetUserActive3V3(HAL_Bool userActive3V3) {
   HAL_Bool oldValue = m_userActive3V3.exchange(userActive3V3);
   if (oldValue != userActive3V3) {
-    InvokeUserActive3V3Callback(MakeBoolean(userActive3V3));
+    RecordChange(this, "UserActive3V3");
+    if (m_userActive3V3Callbacks) {
+      InvokeUserActive3V3Callback(MakeBoolean(userActive3V3));
+    }
   }
 }
 
@@ -518,7 +557,10 @@ int32_t RoboRioData::GetUserFaults6V() { return m_userFaults6V; }
 void RoboRioData::SetUserFaults6V(int32_t userFaults6V) {
   int32_t oldValue = m_userFaults6V.exchange(userFaults6V);
   if (oldValue != userFaults6V) {
-    InvokeUserFaults6VCallback(MakeInt(userFaults6V));
+    RecordChange(this, "UserFaults6V");
+    if (m_userFaults6VCallbacks) {
+      InvokeUserFaults6VCallback(MakeInt(userFaults6V));
+    }
   }
 }
 
@@ -554,7 +596,10 @@ int32_t RoboRioData::GetUserFaults5V() { return m_userFaults5V; }
 void RoboRioData::SetUserFaults5V(int32_t userFaults5V) {
   int32_t oldValue = m_userFaults5V.exchange(userFaults5V);
   if (oldValue != userFaults5V) {
-    InvokeUserFaults5VCallback(MakeInt(userFaults5V));
+    RecordChange(this, "UserFaults5V");
+    if (m_userFaults5VCallbacks) {
+      InvokeUserFaults5VCallback(MakeInt(userFaults5V));
+    }
   }
 }
 
@@ -590,7 +635,10 @@ int32_t RoboRioData::GetUserFaults3V3() { return m_userFaults3V3; }
 void RoboRioData::SetUserFaults3V3(int32_t userFaults3V3) {
   int32_t oldValue = m_userFaults3V3.exchange(userFaults3V3);
   if (oldValue != userFaults3V3) {
-    InvokeUserFaults3V3Callback(MakeInt(userFaults3V3));
+    RecordChange(this, "UserFaults3V3");
+    if (m_userFaults3V3Callbacks) {
+      InvokeUserFaults3V3Callback(MakeInt(userFaults3V3));
+    }
   }
 }
 
@@ -12,6 +12,7 @@
 
 #include <support/mutex.h>
 
+#include "../SimContextInternal.h"
 #include "MockData/NotifyListenerVector.h"
 #include "MockData/RoboRioData.h"
 
@@ -128,35 +129,35 @@ class RoboRioData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_fPGAButton{false};
-  std::shared_ptr<NotifyListenerVector> m_fPGAButtonCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_fPGAButtonCallbacks;
   std::atomic<double> m_vInVoltage{0.0};
-  std::shared_ptr<NotifyListenerVector> m_vInVoltageCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_vInVoltageCallbacks;
   std::atomic<double> m_vInCurrent{0.0};
-  std::shared_ptr<NotifyListenerVector> m_vInCurrentCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_vInCurrentCallbacks;
   std::atomic<double> m_userVoltage6V{6.0};
-  std::shared_ptr<NotifyListenerVector> m_userVoltage6VCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userVoltage6VCallbacks;
   std::atomic<double> m_userCurrent6V{0.0};
-  std::shared_ptr<NotifyListenerVector> m_userCurrent6VCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userCurrent6VCallbacks;
   std::atomic<HAL_Bool> m_userActive6V{false};
-  std::shared_ptr<NotifyListenerVector> m_userActive6VCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userActive6VCallbacks;
   std::atomic<double> m_userVoltage5V{5.0};
-  std::shared_ptr<NotifyListenerVector> m_userVoltage5VCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userVoltage5VCallbacks;
   std::atomic<double> m_userCurrent5V{0.0};
-  std::shared_ptr<NotifyListenerVector> m_userCurrent5VCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userCurrent5VCallbacks;
   std::atomic<HAL_Bool> m_userActive5V{false};
-  std::shared_ptr<NotifyListenerVector> m_userActive5VCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userActive5VCallbacks;
   std::atomic<double> m_userVoltage3V3{3.3};
-  std::shared_ptr<NotifyListenerVector> m_userVoltage3V3Callbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userVoltage3V3Callbacks;
   std::atomic<double> m_userCurrent3V3{0.0};
-  std::shared_ptr<NotifyListenerVector> m_userCurrent3V3Callbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userCurrent3V3Callbacks;
   std::atomic<HAL_Bool> m_userActive3V3{false};
-  std::shared_ptr<NotifyListenerVector> m_userActive3V3Callbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userActive3V3Callbacks;
   std::atomic<int32_t> m_userFaults6V{0};
-  std::shared_ptr<NotifyListenerVector> m_userFaults6VCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userFaults6VCallbacks;
   std::atomic<int32_t> m_userFaults5V{0};
-  std::shared_ptr<NotifyListenerVector> m_userFaults5VCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userFaults5VCallbacks;
   std::atomic<int32_t> m_userFaults3V3{0};
-  std::shared_ptr<NotifyListenerVector> m_userFaults3V3Callbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_userFaults3V3Callbacks;
 };
-extern RoboRioData* SimRoboRioData;
+extern SimContextLocalArray<RoboRioData, 1> SimRoboRioData;
 }  // namespace hal
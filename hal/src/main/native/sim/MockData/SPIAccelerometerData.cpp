@@ -6,6 +6,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "../PortsInternal.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 #include "SPIAccelerometerDataInternal.h"
 
@@ -14,13 +15,18 @@ using namespace hal;
 namespace hal {
 namespace init {
 void InitializeSPIAccelerometerData() {
-  static SPIAccelerometerData ssad[5];
-  ::hal::SimSPIAccelerometerData = ssad;
+  ::hal::SimSPIAccelerometerData.Initialize();
 }
 }  // namespace init
 }  // namespace hal
 
-SPIAccelerometerData* hal::SimSPIAccelerometerData;
+SimContextLocalArray<SPIAccelerometerData, 5> hal::SimSPIAccelerometerData;
+
+static void RecordChange(const SPIAccelerometerData* data, const char* field) {
+  SimChangeBatchData->RecordChange("SPIAccelerometer",
+                                   data - SimSPIAccelerometerData, -1, field);
+}
+
 void SPIAccelerometerData::ResetData() {
   m_active = false;
   m_activeCallbacks = nullptr;
@@ -65,7 +71,10 @@ HAL_Bool SPIAccelerometerData::GetActive() { return m_active; }
 void SPIAccelerometerData::SetActive(HAL_Bool active) {
   HAL_Bool oldValue = m_active.exchange(active);
   if (oldValue != active) {
-    InvokeActiveCallback(MakeBoolean(active));
+    RecordChange(this, "Active");
+    if (m_activeCallbacks) {
+      InvokeActiveCallback(MakeBoolean(active));
+    }
   }
 }
 
@@ -101,7 +110,10 @@ int32_t SPIAccelerometerData::GetRange() { return m_range; }
 void SPIAccelerometerData::SetRange(int32_t range) {
   int32_t oldValue = m_range.exchange(range);
   if (oldValue != range) {
-    InvokeRangeCallback(MakeInt(range));
+    RecordChange(this, "Range");
+    if (m_rangeCallbacks) {
+      InvokeRangeCallback(MakeInt(range));
+    }
   }
 }
 
@@ -137,7 +149,10 @@ double SPIAccelerometerData::GetX() { return m_x; }
 void SPIAccelerometerData::SetX(double x) {
   double oldValue = m_x.exchange(x);
   if (oldValue != x) {
-    InvokeXCallback(MakeDouble(x));
+    RecordChange(this, "X");
+    if (m_xCallbacks) {
+      InvokeXCallback(MakeDouble(x));
+    }
   }
 }
 
@@ -173,7 +188,10 @@ double SPIAccelerometerData::GetY() { return m_y; }
 void SPIAccelerometerData::SetY(double y) {
   double oldValue = m_y.exchange(y);
   if (oldValue != y) {
-    InvokeYCallback(MakeDouble(y));
+    RecordChange(this, "Y");
+    if (m_yCallbacks) {
+      InvokeYCallback(MakeDouble(y));
+    }
   }
 }
 
@@ -209,7 +227,10 @@ double SPIAccelerometerData::GetZ() { return m_z; }
 void SPIAccelerometerData::SetZ(double z) {
   double oldValue = m_z.exchange(z);
   if (oldValue != z) {
-    InvokeZCallback(MakeDouble(z));
+    RecordChange(this, "Z");
+    if (m_zCallbacks) {
+      InvokeZCallback(MakeDouble(z));
+    }
   }
 }
 
@@ -12,6 +12,7 @@
 
 #include <support/mutex.h>
 
+#include "../SimContextInternal.h"
 #include "MockData/NotifyListenerVector.h"
 #include "MockData/SPIAccelerometerData.h"
 
@@ -58,15 +59,15 @@ class SPIAccelerometerData {
  private:
   wpi::mutex m_registerMutex;
   std::atomic<HAL_Bool> m_active{false};
-  std::shared_ptr<NotifyListenerVector> m_activeCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_activeCallbacks;
   std::atomic<int32_t> m_range{0};
-  std::shared_ptr<NotifyListenerVector> m_rangeCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_rangeCallbacks;
   std::atomic<double> m_x{0.0};
-  std::shared_ptr<NotifyListenerVector> m_xCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_xCallbacks;
   std::atomic<double> m_y{0.0};
-  std::shared_ptr<NotifyListenerVector> m_yCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_yCallbacks;
   std::atomic<double> m_z{0.0};
-  std::shared_ptr<NotifyListenerVector> m_zCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_zCallbacks;
 };
-extern SPIAccelerometerData* SimSPIAccelerometerData;
+extern SimContextLocalArray<SPIAccelerometerData, 5> SimSPIAccelerometerData;
 }  // namespace hal
@@ -5,9 +5,15 @@
 /* the project.                                                               */
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <thread>
+#include <utility>
 
 #include "../PortsInternal.h"
+#include "HAL/HAL.h"
+#include "ChangeBatchInternal.h"
 #include "MockData/NotifyCallbackHelpers.h"
 #include "SPIDataInternal.h"
 
@@ -30,20 +36,24 @@ void InvokeCallback(
 
 namespace hal {
 namespace init {
-void InitializeSPIData() {
-  static SPIData ssd[5];
-  ::hal::SimSPIData = ssd;
-}
+void InitializeSPIData() { ::hal::SimSPIData.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
-SPIData* hal::SimSPIData;
+SimContextLocalArray<SPIData, kNumSPIDataPorts> hal::SimSPIData;
+
+static void RecordChange(const SPIData* data, const char* field) {
+  SimChangeBatchData->RecordChange("SPI", data - SimSPIData, -1, field);
+}
+
 void SPIData::ResetData() {
   m_initialized = false;
   m_initializedCallbacks = nullptr;
   m_readCallbacks = nullptr;
   m_writeCallbacks = nullptr;
   m_autoReceiveDataCallbacks = nullptr;
+  SetModel(nullptr);
+  FreeAuto();
 }
 
 SPIData::SPIData() {}
@@ -81,7 +91,10 @@ HAL_Bool SPIData::GetInitialized() { return m_initialized; }
 void SPIData::SetInitialized(HAL_Bool initialized) {
   HAL_Bool oldValue = m_initialized.exchange(initialized);
   if (oldValue != initialized) {
-    InvokeInitializedCallback(MakeBoolean(initialized));
+    RecordChange(this, "Initialized");
+    if (m_initializedCallbacks) {
+      InvokeInitializedCallback(MakeBoolean(initialized));
+    }
   }
 }
 
@@ -142,6 +155,7 @@ void SPIData::CancelReadAutoReceivedDataCallback(int32_t uid) {
 }
 
 int32_t SPIData::Read(uint8_t* buffer, int32_t count) {
+  if (auto model = GetModel()) model->Read(buffer, count);
   std::lock_guard<wpi::mutex> lock(m_dataMutex);
   InvokeCallback(m_readCallbacks, "Read", buffer, count);
 
@@ -149,6 +163,7 @@ int32_t SPIData::Read(uint8_t* buffer, int32_t count) {
 }
 
 int32_t SPIData::Write(const uint8_t* dataToSend, int32_t sendSize) {
+  if (auto model = GetModel()) model->Write(dataToSend, sendSize);
   std::lock_guard<wpi::mutex> lock(m_dataMutex);
   InvokeCallback(m_writeCallbacks, "Write", const_cast<uint8_t*>(dataToSend),
                  sendSize);
@@ -158,6 +173,9 @@ int32_t SPIData::Write(const uint8_t* dataToSend, int32_t sendSize) {
 
 int32_t SPIData::Transaction(const uint8_t* dataToSend, uint8_t* dataReceived,
                              int32_t size) {
+  if (auto model = GetModel()) {
+    model->Transaction(dataToSend, dataReceived, size);
+  }
   std::lock_guard<wpi::mutex> lock(m_dataMutex);
   InvokeCallback(m_writeCallbacks, "Write", dataToSend, size);
   InvokeCallback(m_readCallbacks, "Read", dataReceived, size);
@@ -167,11 +185,135 @@ int32_t SPIData::Transaction(const uint8_t* dataToSend, uint8_t* dataReceived,
 
 int32_t SPIData::ReadAutoReceivedData(uint8_t* buffer, int32_t numToRead,
                                       double timeout, int32_t* status) {
-  int32_t outputCount = 0;
-  InvokeCallback(m_autoReceiveDataCallbacks, "AutoReceive",
-                 const_cast<uint8_t*>(buffer), numToRead, &outputCount);
+  // Auto receive callbacks replace the emulated engine
+  if (m_autoReceiveDataCallbacks) {
+    int32_t outputCount = 0;
+    InvokeCallback(m_autoReceiveDataCallbacks, "AutoReceive",
+                   const_cast<uint8_t*>(buffer), numToRead, &outputCount);
+    return outputCount;
+  }
+
+  std::unique_lock<wpi::mutex> lock(m_autoMutex);
+  RunAutoTransfers();
+  size_t count = numToRead;
+  if (m_autoReceived.size() < count && timeout > 0 && m_autoRunning) {
+    // Waits for timeout of simulated time, but no longer than timeout of
+    // real time, so a read while timing is paused can't hang
+    int32_t timeStatus = 0;
+    uint64_t start = HAL_GetFPGATime(&timeStatus);
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double>(timeout));
+    auto poll = std::chrono::microseconds(
+        std::min(m_autoPeriod, static_cast<uint64_t>(1000)));
+    while (m_autoReceived.size() < count &&
+           HAL_GetFPGATime(&timeStatus) - start < timeout * 1e6 &&
+           std::chrono::steady_clock::now() < deadline) {
+      lock.unlock();
+      std::this_thread::sleep_for(poll);
+      lock.lock();
+      RunAutoTransfers();
+    }
+  }
+
+  // like the FPGA, only complete reads consume data
+  if (m_autoReceived.size() < count) return m_autoReceived.size();
+  std::copy_n(m_autoReceived.begin(), count, buffer);
+  m_autoReceived.erase(m_autoReceived.begin(), m_autoReceived.begin() + count);
+  return m_autoReceived.size();
+}
+
+void SPIData::SetModel(std::shared_ptr<BusDeviceModel> model) {
+  std::atomic_store(&m_model, std::move(model));
+}
+
+std::shared_ptr<BusDeviceModel> SPIData::GetModel() {
+  return std::atomic_load(&m_model);
+}
+
+void SPIData::InitAuto(int32_t bufferSize) {
+  std::lock_guard<wpi::mutex> lock(m_autoMutex);
+  m_autoBufferSize = bufferSize;
+  m_autoReceived.clear();
+  m_autoDropped = 0;
+  m_autoRunning = false;
+}
 
-  return outputCount;
+void SPIData::FreeAuto() {
+  std::lock_guard<wpi::mutex> lock(m_autoMutex);
+  m_autoBufferSize = 0;
+  m_autoTransmit.clear();
+  m_autoReceived.clear();
+  m_autoDropped = 0;
+  m_autoRunning = false;
+}
+
+void SPIData::StartAutoRate(double period) {
+  std::lock_guard<wpi::mutex> lock(m_autoMutex);
+  m_autoPeriod = std::max(static_cast<uint64_t>(period * 1e6), uint64_t{1});
+  int32_t status = 0;
+  m_autoNextTransfer = HAL_GetFPGATime(&status) + m_autoPeriod;
+  m_autoRunning = true;
+}
+
+void SPIData::StopAuto() {
+  std::lock_guard<wpi::mutex> lock(m_autoMutex);
+  RunAutoTransfers();
+  m_autoRunning = false;
+}
+
+void SPIData::SetAutoTransmitData(const uint8_t* dataToSend, int32_t dataSize,
+                                  int32_t zeroSize) {
+  std::lock_guard<wpi::mutex> lock(m_autoMutex);
+  m_autoTransmit.assign(dataToSend, dataToSend + dataSize);
+  m_autoTransmit.resize(dataSize + zeroSize, 0);
+}
+
+void SPIData::ForceAutoRead() {
+  std::lock_guard<wpi::mutex> lock(m_autoMutex);
+  if (m_autoBufferSize == 0) return;
+  RunAutoTransfers();
+  AutoTransfer();
+}
+
+int32_t SPIData::GetAutoDroppedCount() {
+  std::lock_guard<wpi::mutex> lock(m_autoMutex);
+  RunAutoTransfers();
+  return m_autoDropped;
+}
+
+// Transfers are made when the program next looks at the engine, as if each
+// had run at its time; those that were due while the buffer was full are
+// dropped.
+void SPIData::RunAutoTransfers() {
+  if (!m_autoRunning) return;
+  int32_t status = 0;
+  uint64_t now = HAL_GetFPGATime(&status);
+  if (now < m_autoNextTransfer) return;
+  uint64_t due = (now - m_autoNextTransfer) / m_autoPeriod + 1;
+  m_autoNextTransfer += due * m_autoPeriod;
+  if (m_autoTransmit.empty()) return;
+
+  // transfers that can't fit are dropped without being made, so a long pause
+  // costs no more than filling the buffer
+  size_t space = m_autoBufferSize - m_autoReceived.size();
+  uint64_t fit = space / m_autoTransmit.size();
+  for (uint64_t i = 0; i < std::min(due, fit); i++) AutoTransfer();
+  if (due > fit) m_autoDropped += due - fit;
+}
+
+// Each transfer is a transaction, seen by the model and the callbacks
+void SPIData::AutoTransfer() {
+  size_t size = m_autoTransmit.size();
+  if (size == 0) return;
+  // like the FPGA engine, a transfer that does not fit is skipped whole
+  if (static_cast<size_t>(m_autoBufferSize) - m_autoReceived.size() < size) {
+    ++m_autoDropped;
+    return;
+  }
+  uint8_t received[143] = {0};  // 16 data bytes and 127 zero bytes at most
+  Transaction(m_autoTransmit.data(), received, size);
+  m_autoReceived.insert(m_autoReceived.end(), received, received + size);
 }
 
 extern "C" {
@@ -8,16 +8,22 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include <support/mutex.h>
 
+#include "../SimContextInternal.h"
+#include "MockData/BusDeviceModel.h"
 #include "MockData/NotifyListenerVector.h"
 #include "MockData/SPIData.h"
 
 namespace hal {
 
+constexpr int32_t kNumSPIDataPorts = 5;
+
 typedef HalCallbackListenerVectorImpl<HAL_SpiReadAutoReceiveBufferCallback>
     SpiAutoReceiveDataListenerVector;
 
@@ -51,17 +57,46 @@ class SPIData {
   int32_t ReadAutoReceivedData(uint8_t* buffer, int32_t numToRead,
                                double timeout, int32_t* status);
 
+  void SetModel(std::shared_ptr<BusDeviceModel> model);
+  std::shared_ptr<BusDeviceModel> GetModel();
+
+  // Auto transfers, emulated on the simulated clock
+  void InitAuto(int32_t bufferSize);
+  void FreeAuto();
+  void StartAutoRate(double period);
+  void StopAuto();
+  void SetAutoTransmitData(const uint8_t* dataToSend, int32_t dataSize,
+                           int32_t zeroSize);
+  void ForceAutoRead();
+  int32_t GetAutoDroppedCount();
+
   void ResetData();
 
  private:
   wpi::mutex m_registerMutex;
   wpi::mutex m_dataMutex;
   std::atomic<HAL_Bool> m_initialized{false};
-  std::shared_ptr<NotifyListenerVector> m_initializedCallbacks = nullptr;
+  AtomicListenerVector<NotifyListenerVector> m_initializedCallbacks;
   std::shared_ptr<BufferListenerVector> m_readCallbacks = nullptr;
   std::shared_ptr<ConstBufferListenerVector> m_writeCallbacks = nullptr;
   std::shared_ptr<SpiAutoReceiveDataListenerVector> m_autoReceiveDataCallbacks =
       nullptr;
+  std::shared_ptr<BusDeviceModel> m_model;
+
+  // Runs the auto transfers due by now; m_autoMutex must be held
+  void RunAutoTransfers();
+  // Appends one auto transfer, if it fits; m_autoMutex must be held
+  void AutoTransfer();
+
+  wpi::mutex m_autoMutex;
+  int32_t m_autoBufferSize = 0;
+  std::vector<uint8_t> m_autoTransmit;
+  std::deque<uint8_t> m_autoReceived;
+  int32_t m_autoDropped = 0;
+  bool m_autoRunning = false;
+  // in FPGA microseconds
+  uint64_t m_autoPeriod = 0;
+  uint64_t m_autoNextTransfer = 0;
 };
-extern SPIData* SimSPIData;
+extern SimContextLocalArray<SPIData, kNumSPIDataPorts> SimSPIData;
 }  // namespace hal
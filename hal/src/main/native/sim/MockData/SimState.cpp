@@ -0,0 +1,302 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "MockData/SimState.h"
+
+#include <cstring>
+
+#include "../PortsInternal.h"
+#include "AccelerometerDataInternal.h"
+#include "AnalogGyroDataInternal.h"
+#include "AnalogInDataInternal.h"
+#include "AnalogOutDataInternal.h"
+#include "AnalogTriggerDataInternal.h"
+#include "DIODataInternal.h"
+#include "DigitalPWMDataInternal.h"
+#include "DriverStationDataInternal.h"
+#include "EncoderDataInternal.h"
+#include "PCMDataInternal.h"
+#include "PDPDataInternal.h"
+#include "PWMDataInternal.h"
+#include "RelayDataInternal.h"
+#include "RoboRioDataInternal.h"
+#include "SPIAccelerometerDataInternal.h"
+
+using namespace hal;
+
+// Identifies a saved state; bump the version whenever the fields change
+static constexpr uint32_t kStateMagic = 0x4d495348;  // "HSIM"
+static constexpr uint32_t kStateVersion = 1;
+
+// These match the array sizes in the data sources
+static constexpr int32_t kNumAccelerometers = 1;
+static constexpr int32_t kNumSPIAccelerometers = 5;
+static constexpr int32_t kNumRoboRios = 1;
+static constexpr int32_t kNumJoysticks = 6;
+
+namespace {
+struct StateHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;
+};
+
+/**
+ * Walks every saved field, in the same order for sizing, saving and
+ * restoring. Fields are packed without padding.
+ */
+class StateVisitor {
+ public:
+  enum Mode { kSize, kSave, kRestore };
+
+  StateVisitor(Mode mode, uint8_t* buffer) : m_mode(mode), m_buffer(buffer) {}
+
+  bool IsRestoring() const { return m_mode == kRestore; }
+  size_t GetSize() const { return m_offset; }
+
+  template <typename T>
+  void Value(T& value) {
+    if (m_mode == kSave) {
+      std::memcpy(m_buffer + m_offset, &value, sizeof(T));
+    } else if (m_mode == kRestore) {
+      std::memcpy(&value, m_buffer + m_offset, sizeof(T));
+    }
+    m_offset += sizeof(T);
+  }
+
+  template <typename C, typename T>
+  void Field(C& data, T (C::*get)(), void (C::*set)(T)) {
+    T value = (data.*get)();
+    Value(value);
+    if (IsRestoring()) (data.*set)(value);
+  }
+
+  template <typename C, typename T>
+  void Field(C& data, int32_t channel, T (C::*get)(int32_t),
+             void (C::*set)(int32_t, T)) {
+    T value = (data.*get)(channel);
+    Value(value);
+    if (IsRestoring()) (data.*set)(channel, value);
+  }
+
+  template <typename C, typename T>
+  void Field(C& data, int32_t channel, void (C::*get)(int32_t, T*),
+             void (C::*set)(int32_t, const T*)) {
+    T value;
+    (data.*get)(channel, &value);
+    Value(value);
+    if (IsRestoring()) (data.*set)(channel, &value);
+  }
+
+ private:
+  Mode m_mode;
+  uint8_t* m_buffer;
+  size_t m_offset = 0;
+};
+}  // namespace
+
+static void VisitDriverStation(StateVisitor& v, DriverStationData& d) {
+  using C = DriverStationData;
+  v.Field(d, &C::GetEnabled, &C::SetEnabled);
+  v.Field(d, &C::GetAutonomous, &C::SetAutonomous);
+  v.Field(d, &C::GetTest, &C::SetTest);
+  v.Field(d, &C::GetEStop, &C::SetEStop);
+  v.Field(d, &C::GetFmsAttached, &C::SetFmsAttached);
+  v.Field(d, &C::GetDsAttached, &C::SetDsAttached);
+  v.Field(d, &C::GetAllianceStationId, &C::SetAllianceStationId);
+  v.Field(d, &C::GetMatchTime, &C::SetMatchTime);
+  for (int32_t i = 0; i < kNumJoysticks; i++) {
+    v.Field(d, i, &C::GetJoystickAxes, &C::SetJoystickAxes);
+    v.Field(d, i, &C::GetJoystickPOVs, &C::SetJoystickPOVs);
+    v.Field(d, i, &C::GetJoystickButtons, &C::SetJoystickButtons);
+    v.Field(d, i, &C::GetJoystickDescriptor, &C::SetJoystickDescriptor);
+
+    int64_t outputs;
+    int32_t leftRumble;
+    int32_t rightRumble;
+    d.GetJoystickOutputs(i, &outputs, &leftRumble, &rightRumble);
+    v.Value(outputs);
+    v.Value(leftRumble);
+    v.Value(rightRumble);
+    if (v.IsRestoring()) {
+      d.SetJoystickOutputs(i, outputs, leftRumble, rightRumble);
+    }
+  }
+}
+
+static void VisitState(StateVisitor& v) {
+  for (int32_t i = 0; i < kNumAccelerometers; i++) {
+    using C = AccelerometerData;
+    auto& d = SimAccelerometerData[i];
+    v.Field(d, &C::GetActive, &C::SetActive);
+    v.Field(d, &C::GetRange, &C::SetRange);
+    v.Field(d, &C::GetX, &C::SetX);
+    v.Field(d, &C::GetY, &C::SetY);
+    v.Field(d, &C::GetZ, &C::SetZ);
+  }
+  for (int32_t i = 0; i < kNumAccumulators; i++) {
+    using C = AnalogGyroData;
+    auto& d = SimAnalogGyroData[i];
+    v.Field(d, &C::GetAngle, &C::SetAngle);
+    v.Field(d, &C::GetRate, &C::SetRate);
+  }
+  for (int32_t i = 0; i < kNumAnalogInputs; i++) {
+    using C = AnalogInData;
+    auto& d = SimAnalogInData[i];
+    v.Field(d, &C::GetAverageBits, &C::SetAverageBits);
+    v.Field(d, &C::GetOversampleBits, &C::SetOversampleBits);
+    v.Field(d, &C::GetVoltage, &C::SetVoltage);
+    v.Field(d, &C::GetAccumulatorValue, &C::SetAccumulatorValue);
+    v.Field(d, &C::GetAccumulatorCount, &C::SetAccumulatorCount);
+    v.Field(d, &C::GetAccumulatorCenter, &C::SetAccumulatorCenter);
+    v.Field(d, &C::GetAccumulatorDeadband, &C::SetAccumulatorDeadband);
+  }
+  for (int32_t i = 0; i < kNumAnalogOutputs; i++) {
+    using C = AnalogOutData;
+    v.Field(SimAnalogOutData[i], &C::GetVoltage, &C::SetVoltage);
+  }
+  for (int32_t i = 0; i < kNumAnalogTriggers; i++) {
+    using C = AnalogTriggerData;
+    auto& d = SimAnalogTriggerData[i];
+    v.Field(d, &C::GetTriggerLowerBound, &C::SetTriggerLowerBound);
+    v.Field(d, &C::GetTriggerUpperBound, &C::SetTriggerUpperBound);
+    v.Field(d, &C::GetTriggerMode, &C::SetTriggerMode);
+  }
+  for (int32_t i = 0; i < kNumDigitalChannels; i++) {
+    using C = DIOData;
+    auto& d = SimDIOData[i];
+    v.Field(d, &C::GetValue, &C::SetValue);
+    v.Field(d, &C::GetPulseLength, &C::SetPulseLength);
+    v.Field(d, &C::GetIsInput, &C::SetIsInput);
+    v.Field(d, &C::GetFilterIndex, &C::SetFilterIndex);
+  }
+  for (int32_t i = 0; i < kNumDigitalPWMOutputs; i++) {
+    using C = DigitalPWMData;
+    auto& d = SimDigitalPWMData[i];
+    v.Field(d, &C::GetDutyCycle, &C::SetDutyCycle);
+    v.Field(d, &C::GetPin, &C::SetPin);
+  }
+  VisitDriverStation(v, *SimDriverStationData);
+  for (int32_t i = 0; i < kNumEncoders; i++) {
+    using C = EncoderData;
+    auto& d = SimEncoderData[i];
+    v.Field(d, &C::GetCount, &C::SetCount);
+    v.Field(d, &C::GetPeriod, &C::SetPeriod);
+    v.Field(d, &C::GetReset, &C::SetReset);
+    v.Field(d, &C::GetMaxPeriod, &C::SetMaxPeriod);
+    v.Field(d, &C::GetDirection, &C::SetDirection);
+    v.Field(d, &C::GetReverseDirection, &C::SetReverseDirection);
+    v.Field(d, &C::GetSamplesToAverage, &C::SetSamplesToAverage);
+    v.Field(d, &C::GetDistancePerPulse, &C::SetDistancePerPulse);
+  }
+  for (int32_t i = 0; i < kNumPCMModules; i++) {
+    using C = PCMData;
+    auto& d = SimPCMData[i];
+    for (int32_t j = 0; j < kNumSolenoidChannels; j++) {
+      v.Field(d, j, &C::GetSolenoidOutput, &C::SetSolenoidOutput);
+    }
+    v.Field(d, &C::GetCompressorOn, &C::SetCompressorOn);
+    v.Field(d, &C::GetClosedLoopEnabled, &C::SetClosedLoopEnabled);
+    v.Field(d, &C::GetPressureSwitch, &C::SetPressureSwitch);
+    v.Field(d, &C::GetCompressorCurrent, &C::SetCompressorCurrent);
+  }
+  for (int32_t i = 0; i < kNumPDPModules; i++) {
+    using C = PDPData;
+    auto& d = SimPDPData[i];
+    v.Field(d, &C::GetTemperature, &C::SetTemperature);
+    v.Field(d, &C::GetVoltage, &C::SetVoltage);
+    for (int32_t j = 0; j < kNumPDPChannels; j++) {
+      v.Field(d, j, &C::GetCurrent, &C::SetCurrent);
+    }
+  }
+  for (int32_t i = 0; i < kNumPWMChannels; i++) {
+    using C = PWMData;
+    auto& d = SimPWMData[i];
+    v.Field(d, &C::GetRawValue, &C::SetRawValue);
+    v.Field(d, &C::GetSpeed, &C::SetSpeed);
+    v.Field(d, &C::GetPosition, &C::SetPosition);
+    v.Field(d, &C::GetPeriodScale, &C::SetPeriodScale);
+    v.Field(d, &C::GetZeroLatch, &C::SetZeroLatch);
+  }
+  for (int32_t i = 0; i < kNumRelayHeaders; i++) {
+    using C = RelayData;
+    auto& d = SimRelayData[i];
+    v.Field(d, &C::GetForward, &C::SetForward);
+    v.Field(d, &C::GetReverse, &C::SetReverse);
+  }
+  for (int32_t i = 0; i < kNumRoboRios; i++) {
+    using C = RoboRioData;
+    auto& d = SimRoboRioData[i];
+    v.Field(d, &C::GetFPGAButton, &C::SetFPGAButton);
+    v.Field(d, &C::GetVInVoltage, &C::SetVInVoltage);
+    v.Field(d, &C::GetVInCurrent, &C::SetVInCurrent);
+    v.Field(d, &C::GetUserVoltage6V, &C::SetUserVoltage6V);
+    v.Field(d, &C::GetUserCurrent6V, &C::SetUserCurrent6V);
+    v.Field(d, &C::GetUserActive6V, &C::SetUserActive6V);
+    v.Field(d, &C::GetUserVoltage5V, &C::SetUserVoltage5V);
+    v.Field(d, &C::GetUserCurrent5V, &C::SetUserCurrent5V);
+    v.Field(d, &C::GetUserActive5V, &C::SetUserActive5V);
+    v.Field(d, &C::GetUserVoltage3V3, &C::SetUserVoltage3V3);
+    v.Field(d, &C::GetUserCurrent3V3, &C::SetUserCurrent3V3);
+    v.Field(d, &C::GetUserActive3V3, &C::SetUserActive3V3);
+    v.Field(d, &C::GetUserFaults6V, &C::SetUserFaults6V);
+    v.Field(d, &C::GetUserFaults5V, &C::SetUserFaults5V);
+    v.Field(d, &C::GetUserFaults3V3, &C::SetUserFaults3V3);
+  }
+  for (int32_t i = 0; i < kNumSPIAccelerometers; i++) {
+    using C = SPIAccelerometerData;
+    auto& d = SimSPIAccelerometerData[i];
+    v.Field(d, &C::GetActive, &C::SetActive);
+    v.Field(d, &C::GetRange, &C::SetRange);
+    v.Field(d, &C::GetX, &C::SetX);
+    v.Field(d, &C::GetY, &C::SetY);
+    v.Field(d, &C::GetZ, &C::SetZ);
+  }
+}
+
+static uint32_t GetStateSize() {
+  static const uint32_t size = [] {
+    StateVisitor sizer(StateVisitor::kSize, nullptr);
+    VisitState(sizer);
+    return static_cast<uint32_t>(sizeof(StateHeader) + sizer.GetSize());
+  }();
+  return size;
+}
+
+extern "C" {
+int32_t HALSIM_GetStateSize(void) { return GetStateSize(); }
+
+int32_t HALSIM_SaveState(void* buffer, int32_t size) {
+  uint32_t stateSize = GetStateSize();
+  if (size < 0 || static_cast<uint32_t>(size) < stateSize) return 0;
+
+  auto data = static_cast<uint8_t*>(buffer);
+  StateHeader header{kStateMagic, kStateVersion, stateSize};
+  std::memcpy(data, &header, sizeof(header));
+  StateVisitor saver(StateVisitor::kSave, data + sizeof(header));
+  VisitState(saver);
+  return stateSize;
+}
+
+HAL_Bool HALSIM_RestoreState(const void* buffer, int32_t size) {
+  uint32_t stateSize = GetStateSize();
+  if (size < 0 || static_cast<uint32_t>(size) < stateSize) return false;
+
+  auto data = static_cast<const uint8_t*>(buffer);
+  StateHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != kStateMagic || header.version != kStateVersion ||
+      header.size != stateSize) {
+    return false;
+  }
+  // Restoring only reads from the buffer
+  StateVisitor restorer(StateVisitor::kRestore,
+                        const_cast<uint8_t*>(data) + sizeof(header));
+  VisitState(restorer);
+  return true;
+}
+}  // extern "C"
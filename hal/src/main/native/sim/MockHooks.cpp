@@ -5,52 +5,215 @@
 /* the project.                                                               */
 /*----------------------------------------------------------------------------*/
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdio>
-#include <thread>
 
+#include <support/condition_variable.h>
+#include <support/mutex.h>
 #include <support/timestamp.h>
 
+#include "ExtensionsInternal.h"
+#include "MockData/ChangeBatch.h"
+#include "MockData/DriverStationData.h"
 #include "MockHooksInternal.h"
+#include "NotifierInternal.h"
+#include "SimContextInternal.h"
+
+// Rate at which simulated DS packets are generated while timing is paused
+static constexpr uint64_t kDSPacketPeriod = 20000;
 
 static std::atomic<bool> programStarted{false};
+static wpi::mutex programStartedMutex;
+static wpi::condition_variable programStartedCond;
+
+namespace {
+// Timing state. Simulated FPGA time is programVirtualBase plus the wall clock
+// time elapsed since programRealBase, scaled by programTimingRate. While
+// paused, time only moves when stepped. Each context starts at time zero.
+struct TimingState {
+  wpi::mutex timingMutex;
+  uint64_t programRealBase = wpi::Now();
+  uint64_t programVirtualBase = 0;
+  double programTimingRate = 1.0;
+  bool programPaused = false;
+  // serializes HALSIM_StepTiming callers
+  wpi::mutex stepMutex;
+};
+}  // namespace
 
-static std::atomic<uint64_t> programStartTime{0};
+static hal::SimContextLocal<TimingState> timing;
 
 namespace hal {
 namespace init {
-void InitializeMockHooks() {}
+void InitializeMockHooks() { timing.Initialize(); }
 }  // namespace init
 }  // namespace hal
 
+// state.timingMutex must be held
+static uint64_t GetFPGATimeLocked(TimingState& state) {
+  if (state.programPaused) return state.programVirtualBase;
+  uint64_t elapsed = wpi::Now() - state.programRealBase;
+  if (state.programTimingRate != 1.0) {
+    elapsed = static_cast<uint64_t>(elapsed * state.programTimingRate);
+  }
+  return state.programVirtualBase + elapsed;
+}
+
+// state.timingMutex must be held
+static void RebaseTimingLocked(TimingState& state) {
+  state.programVirtualBase = GetFPGATimeLocked(state);
+  state.programRealBase = wpi::Now();
+}
+
 namespace hal {
-void RestartTiming() { programStartTime = wpi::Now(); }
+void RestartTiming() {
+  TimingState& state = *timing;
+  std::lock_guard<wpi::mutex> lock(state.timingMutex);
+  state.programRealBase = wpi::Now();
+  state.programVirtualBase = 0;
+}
 
 int64_t GetFPGATime() {
-  auto now = wpi::Now();
-  auto currentTime = now - programStartTime;
-  return currentTime;
+  TimingState& state = *timing;
+  std::lock_guard<wpi::mutex> lock(state.timingMutex);
+  return GetFPGATimeLocked(state);
 }
 
 double GetFPGATimestamp() { return GetFPGATime() * 1.0e-6; }
 
-void SetProgramStarted() { programStarted = true; }
+void SetProgramStarted() {
+  {
+    std::lock_guard<wpi::mutex> lock(programStartedMutex);
+    programStarted = true;
+  }
+  programStartedCond.notify_all();
+}
+
+bool IsTimingPaused() {
+  TimingState& state = *timing;
+  std::lock_guard<wpi::mutex> lock(state.timingMutex);
+  return state.programPaused;
+}
+
+double GetTimingRate() {
+  TimingState& state = *timing;
+  std::lock_guard<wpi::mutex> lock(state.timingMutex);
+  return state.programTimingRate;
+}
+
+void PauseTiming() {
+  TimingState& state = *timing;
+  {
+    std::lock_guard<wpi::mutex> lock(state.timingMutex);
+    if (state.programPaused) return;
+    RebaseTimingLocked(state);
+    state.programPaused = true;
+  }
+  WakeupNotifiers();
+}
+
+void ResumeTiming() {
+  TimingState& state = *timing;
+  {
+    std::lock_guard<wpi::mutex> lock(state.timingMutex);
+    if (!state.programPaused) return;
+    state.programRealBase = wpi::Now();
+    state.programPaused = false;
+  }
+  WakeupNotifiers();
+}
+
+void SetTimingRate(double rate) {
+  TimingState& state = *timing;
+  if (rate <= 0) return;
+  {
+    std::lock_guard<wpi::mutex> lock(state.timingMutex);
+    RebaseTimingLocked(state);
+    state.programTimingRate = rate;
+  }
+  // waiting notifiers need to recompute how long to sleep for
+  WakeupNotifiers();
+}
+
+void StepTiming(uint64_t delta) {
+  TimingState& state = *timing;
+  std::lock_guard<wpi::mutex> stepLock(state.stepMutex);
+  uint64_t target;
+  bool paused;
+  {
+    std::lock_guard<wpi::mutex> lock(state.timingMutex);
+    paused = state.programPaused;
+    target = state.programVirtualBase + delta;
+    // when running, just skip ahead
+    if (!paused) state.programVirtualBase += delta;
+  }
+  if (!paused) {
+    WakeupNotifiers();
+    InvokeStepCallbacks(GetFPGATime());
+    return;
+  }
+
+  // Advance to each notifier deadline and DS packet in turn, letting every
+  // expired notifier run its handler before moving on, so a step produces
+  // the same sequence of events regardless of host speed.
+  for (;;) {
+    uint64_t curTime;
+    {
+      std::lock_guard<wpi::mutex> lock(state.timingMutex);
+      curTime = state.programVirtualBase;
+    }
+    if (curTime >= target) break;
+
+    uint64_t nextDSPacket = (curTime / kDSPacketPeriod + 1) * kDSPacketPeriod;
+    uint64_t stepTo = std::min(
+        std::min(GetNextNotifierTimeout(curTime), nextDSPacket), target);
+    {
+      std::lock_guard<wpi::mutex> lock(state.timingMutex);
+      // timing may have been resumed by another thread
+      if (!state.programPaused) break;
+      state.programVirtualBase = stepTo;
+    }
+    if (stepTo == nextDSPacket) HALSIM_NotifyDriverStationNewData();
+    WakeupNotifiers();
+    WaitNotifiers(stepTo);
+    InvokeStepCallbacks(stepTo);
+    HALSIM_FlushChanges();
+  }
+}
 }  // namespace hal
 
 using namespace hal;
 
 extern "C" {
 void HALSIM_WaitForProgramStart(void) {
+  // Returns as soon as the program starts, printing a reminder every 500 ms
+  // until then
+  std::unique_lock<wpi::mutex> lock(programStartedMutex);
   int count = 0;
-  while (!programStarted) {
+  while (!programStartedCond.wait_for(lock, std::chrono::milliseconds(500),
+                                      [] { return programStarted.load(); })) {
     count++;
     std::printf("Waiting for program start signal: %d\n", count);
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
   }
 }
 
 void HALSIM_SetProgramStarted(void) { SetProgramStarted(); }
 
 void HALSIM_RestartTiming(void) { RestartTiming(); }
+
+void HALSIM_PauseTiming(void) { PauseTiming(); }
+
+void HALSIM_ResumeTiming(void) { ResumeTiming(); }
+
+HAL_Bool HALSIM_IsTimingPaused(void) { return IsTimingPaused(); }
+
+void HALSIM_StepTiming(uint64_t delta) { StepTiming(delta); }
+
+void HALSIM_SetTimingRate(double rate) { SetTimingRate(rate); }
+
+void HALSIM_SetNotifierSpinTime(uint64_t microseconds) {
+  SetNotifierSpinTime(microseconds);
+}
 }  // extern "C"
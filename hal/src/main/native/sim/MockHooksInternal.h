@@ -19,4 +19,16 @@ int64_t GetFPGATime();
 double GetFPGATimestamp();
 
 void SetProgramStarted();
+
+bool IsTimingPaused();
+
+double GetTimingRate();
+
+void PauseTiming();
+
+void ResumeTiming();
+
+void SetTimingRate(double rate);
+
+void StepTiming(uint64_t delta);
 }  // namespace hal
@@ -7,30 +7,75 @@
 
 #include "HAL/Notifier.h"
 
+#include <atomic>
 #include <chrono>
+#include <cmath>
 
 #include <support/condition_variable.h>
 #include <support/mutex.h>
 #include <support/timestamp.h>
 
 #include "HAL/HAL.h"
-#include "HAL/cpp/fpga_clock.h"
 #include "HAL/cpp/make_unique.h"
 #include "HAL/handles/UnlimitedHandleResource.h"
+#include "MockHooksInternal.h"
+#include "NotifierInternal.h"
+#include "NotifierWaiter.h"
+#include "SimContextInternal.h"
 
 namespace {
 struct Notifier {
   uint64_t waitTime;
-  bool updatedAlarm = false;
+  // if not 0, alarms re-arm themselves this many microseconds later
+  uint64_t period = 0;
+  int32_t lateCount = 0;
   bool active = true;
   bool running = false;
+  // set when an alarm is returned, cleared when the waiter comes back
+  bool fired = false;
   wpi::mutex mutex;
+  // signalled when a handler returns, for HALSIM_StepTiming()
   wpi::condition_variable cond;
+  hal::NotifierWaiter waiter;
 };
 }  // namespace
 
 using namespace hal;
 
+// how long HALSIM_StepTiming() waits for a notifier handler to return
+static constexpr auto kStepTimeout = std::chrono::seconds(1);
+
+// alarms serviced more than this many microseconds late are counted as late
+static constexpr uint64_t kLateAlarmThreshold = 1000;
+
+// alarms due within this many microseconds are busy waited for
+static std::atomic<uint64_t> spinTime{0};
+
+// Wakes the notifier waiter and any thread stepping time. The state they wait
+// on must have been changed under notifier->mutex.
+static void Wakeup(Notifier* notifier) {
+  notifier->waiter.Wakeup();
+  notifier->cond.notify_all();
+}
+
+// The wall clock microseconds it takes simulated time to advance by delta,
+// rounded up so a waiter never wakes before the deadline
+static uint64_t RealTimeFor(uint64_t delta) {
+  double rate = GetTimingRate();
+  if (rate == 1.0) return delta;
+  return static_cast<uint64_t>(std::ceil(delta / rate));
+}
+
+// Busy waits until the simulated time reaches waitTime, for at most timeout
+// microseconds of wall clock time
+static void SpinUntil(uint64_t waitTime, uint64_t timeout) {
+  uint64_t end = wpi::Now() + timeout;
+  int32_t status = 0;
+  while (static_cast<uint64_t>(HAL_GetFPGATime(&status)) < waitTime &&
+         wpi::Now() < end) {
+  }
+}
+
 class NotifierHandleContainer
     : public UnlimitedHandleResource<HAL_NotifierHandle, Notifier,
                                      HAL_HandleEnum::Notifier> {
@@ -42,18 +87,25 @@ class NotifierHandleContainer
         notifier->active = false;
         notifier->running = false;
       }
-      notifier->cond.notify_all();  // wake up any waiting threads
+      Wakeup(notifier);  // wake up any waiting threads
     });
   }
 };
 
-static NotifierHandleContainer* notifierHandles;
+static SimContextLocal<NotifierHandleContainer> notifierHandles;
+
+// The first tick of a periodic alarm after curTime, on the schedule set by
+// waitTime
+static uint64_t NextPeriodicTrigger(uint64_t waitTime, uint64_t period,
+                                    uint64_t curTime) {
+  if (waitTime > curTime) return waitTime;
+  return waitTime + ((curTime - waitTime) / period + 1) * period;
+}
 
 namespace hal {
 namespace init {
 void InitializeNotifier() {
-  static NotifierHandleContainer nH;
-  notifierHandles = &nH;
+  notifierHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
@@ -79,7 +131,7 @@ void HAL_StopNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
     notifier->active = false;
     notifier->running = false;
   }
-  notifier->cond.notify_all();
+  Wakeup(notifier.get());
 }
 
 void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
@@ -92,7 +144,7 @@ void HAL_CleanNotifier(HAL_NotifierHandle notifierHandle, int32_t* status) {
     notifier->active = false;
     notifier->running = false;
   }
-  notifier->cond.notify_all();
+  Wakeup(notifier.get());
 }
 
 void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
@@ -104,11 +156,10 @@ void HAL_UpdateNotifierAlarm(HAL_NotifierHandle notifierHandle,
     std::lock_guard<wpi::mutex> lock(notifier->mutex);
     notifier->waitTime = triggerTime;
     notifier->running = true;
-    notifier->updatedAlarm = true;
   }
 
   // We wake up any waiters to change how long they're sleeping for
-  notifier->cond.notify_all();
+  Wakeup(notifier.get());
 }
 
 void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
@@ -119,37 +170,122 @@ void HAL_CancelNotifierAlarm(HAL_NotifierHandle notifierHandle,
   {
     std::lock_guard<wpi::mutex> lock(notifier->mutex);
     notifier->running = false;
+    // there's no handler to wait for after a cancel, so let a stepping
+    // thread go on
+    if (notifier->fired) {
+      notifier->fired = false;
+      notifier->cond.notify_all();
+    }
   }
 }
 
+void HAL_SetNotifierPeriodic(HAL_NotifierHandle notifierHandle,
+                             uint64_t period, int32_t* status) {
+  auto notifier = notifierHandles->Get(notifierHandle);
+  if (!notifier) return;
+
+  std::lock_guard<wpi::mutex> lock(notifier->mutex);
+  notifier->period = period;
+}
+
 uint64_t HAL_WaitForNotifierAlarm(HAL_NotifierHandle notifierHandle,
                                   int32_t* status) {
   auto notifier = notifierHandles->Get(notifierHandle);
   if (!notifier) return 0;
 
   std::unique_lock<wpi::mutex> lock(notifier->mutex);
+  if (notifier->fired) {
+    notifier->fired = false;
+    // let a stepping thread know the previous handler has returned
+    notifier->cond.notify_all();
+  }
   while (notifier->active) {
-    double waitTime;
     if (!notifier->running) {
-      waitTime = (HAL_GetFPGATime(status) * 1e-6) + 1000.0;
-      // If not running, wait 1000 seconds
-    } else {
-      waitTime = notifier->waitTime * 1e-6;
+      notifier->waiter.Wait(lock, -1);
+      continue;
     }
 
-    auto timeoutTime =
-        hal::fpga_clock::epoch() + std::chrono::duration<double>(waitTime);
-    notifier->cond.wait_until(lock, timeoutTime);
-    if (notifier->updatedAlarm) {
-      notifier->updatedAlarm = false;
+    uint64_t curTime = HAL_GetFPGATime(status);
+    if (curTime < notifier->waitTime) {
+      // While timing is paused, only HALSIM_StepTiming() moves time forward,
+      // and it wakes us up when it does.
+      if (IsTimingPaused()) {
+        notifier->waiter.Wait(lock, -1);
+        continue;
+      }
+      uint64_t timeout = RealTimeFor(notifier->waitTime - curTime);
+      uint64_t spin = spinTime;
+      if (timeout > spin) {
+        notifier->waiter.Wait(lock, timeout - spin);
+      } else {
+        uint64_t waitTime = notifier->waitTime;
+        lock.unlock();
+        SpinUntil(waitTime, timeout);
+        lock.lock();
+      }
       continue;
     }
-    if (!notifier->running) continue;
-    if (!notifier->active) break;
-    notifier->running = false;
-    return HAL_GetFPGATime(status);
+
+    notifier->fired = true;
+    if (curTime - notifier->waitTime > kLateAlarmThreshold) {
+      notifier->lateCount++;
+    }
+    if (notifier->period != 0) {
+      notifier->waitTime =
+          NextPeriodicTrigger(notifier->waitTime, notifier->period, curTime);
+    } else {
+      notifier->running = false;
+    }
+    return curTime;
   }
   return 0;
 }
 
+int32_t HAL_GetNotifierLateAlarmCount(HAL_NotifierHandle notifierHandle,
+                                      int32_t* status) {
+  auto notifier = notifierHandles->Get(notifierHandle);
+  if (!notifier) return 0;
+  std::lock_guard<wpi::mutex> lock(notifier->mutex);
+  return notifier->lateCount;
+}
+
 }  // extern "C"
+
+namespace hal {
+void SetNotifierSpinTime(uint64_t microseconds) { spinTime = microseconds; }
+
+void WakeupNotifiers() {
+  notifierHandles->ForEachSnapshot(
+      [](HAL_NotifierHandle handle, Notifier* notifier) {
+        // take the lock so a waiter can't miss the wakeup between checking
+        // the time and blocking
+        { std::lock_guard<wpi::mutex> lock(notifier->mutex); }
+        Wakeup(notifier);
+      });
+}
+
+void WaitNotifiers(uint64_t curTime) {
+  notifierHandles->ForEachSnapshot(
+      [&](HAL_NotifierHandle handle, Notifier* notifier) {
+        std::unique_lock<wpi::mutex> lock(notifier->mutex);
+        notifier->cond.wait_for(lock, kStepTimeout, [&] {
+          return !notifier->active ||
+                 (!notifier->fired &&
+                  !(notifier->running && notifier->waitTime <= curTime));
+        });
+      });
+}
+
+uint64_t GetNextNotifierTimeout(uint64_t curTime) {
+  uint64_t timeout = UINT64_MAX;
+  notifierHandles->ForEachSnapshot(
+      [&](HAL_NotifierHandle handle, Notifier* notifier) {
+        std::lock_guard<wpi::mutex> lock(notifier->mutex);
+        if (notifier->active && notifier->running &&
+            notifier->waitTime > curTime && notifier->waitTime < timeout) {
+          timeout = notifier->waitTime;
+        }
+      });
+  return timeout;
+}
+}  // namespace hal
@@ -0,0 +1,25 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace hal {
+// Sets how close to its deadline a notifier stops sleeping and busy waits.
+void SetNotifierSpinTime(uint64_t microseconds);
+
+// Wakes all notifier waiters so they re-check the simulated time.
+void WakeupNotifiers();
+
+// Waits until no notifier is due at curTime and every notifier that fired has
+// gone back to waiting (i.e. its handler has returned).
+void WaitNotifiers(uint64_t curTime);
+
+// Returns the earliest notifier deadline after curTime, or UINT64_MAX.
+uint64_t GetNextNotifierTimeout(uint64_t curTime);
+}  // namespace hal
@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "NotifierWaiter.h"
+
+#include <chrono>
+
+#ifdef __linux__
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using namespace hal;
+
+#ifdef __linux__
+
+// Resets a readable eventfd or expired timerfd
+static void Drain(int fd) {
+  uint64_t count;
+  while (read(fd, &count, sizeof(count)) < 0 && errno == EINTR) {
+  }
+}
+
+NotifierWaiter::NotifierWaiter() {
+  m_timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  m_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (m_timerFd < 0 || m_eventFd < 0) {
+    if (m_timerFd >= 0) close(m_timerFd);
+    if (m_eventFd >= 0) close(m_eventFd);
+    m_timerFd = -1;
+    m_eventFd = -1;
+  }
+}
+
+NotifierWaiter::~NotifierWaiter() {
+  if (m_timerFd >= 0) close(m_timerFd);
+  if (m_eventFd >= 0) close(m_eventFd);
+}
+
+void NotifierWaiter::Wait(std::unique_lock<wpi::mutex>& lock,
+                          int64_t timeout) {
+  if (m_timerFd < 0) {
+    if (timeout < 0) {
+      m_cond.wait(lock);
+    } else {
+      m_cond.wait_for(lock, std::chrono::microseconds(timeout));
+    }
+    return;
+  }
+
+  // An all-zero it_value disarms the timer
+  struct itimerspec spec = {};
+  if (timeout >= 0) {
+    clock_gettime(CLOCK_MONOTONIC, &spec.it_value);
+    spec.it_value.tv_sec += timeout / 1000000;
+    spec.it_value.tv_nsec += (timeout % 1000000) * 1000;
+    if (spec.it_value.tv_nsec >= 1000000000) {
+      spec.it_value.tv_sec++;
+      spec.it_value.tv_nsec -= 1000000000;
+    }
+  }
+  timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+  // A wakeup between unlocking and polling leaves the eventfd readable, so it
+  // isn't lost
+  lock.unlock();
+  struct pollfd fds[2] = {{m_eventFd, POLLIN, 0}, {m_timerFd, POLLIN, 0}};
+  while (poll(fds, 2, -1) < 0 && errno == EINTR) {
+  }
+  if (fds[0].revents & POLLIN) Drain(m_eventFd);
+  if (fds[1].revents & POLLIN) Drain(m_timerFd);
+  lock.lock();
+}
+
+void NotifierWaiter::Wakeup() {
+  if (m_eventFd < 0) {
+    m_cond.notify_all();
+    return;
+  }
+  // This can only fail if the counter would overflow, in which case the
+  // eventfd is already readable
+  uint64_t one = 1;
+  while (write(m_eventFd, &one, sizeof(one)) < 0 && errno == EINTR) {
+  }
+}
+
+#else
+
+NotifierWaiter::NotifierWaiter() {}
+
+NotifierWaiter::~NotifierWaiter() {}
+
+void NotifierWaiter::Wait(std::unique_lock<wpi::mutex>& lock,
+                          int64_t timeout) {
+  if (timeout < 0) {
+    m_cond.wait(lock);
+  } else {
+    m_cond.wait_for(lock, std::chrono::microseconds(timeout));
+  }
+}
+
+void NotifierWaiter::Wakeup() { m_cond.notify_all(); }
+
+#endif
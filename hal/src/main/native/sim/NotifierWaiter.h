@@ -0,0 +1,52 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <mutex>
+
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+namespace hal {
+/**
+ * Blocks a notifier thread until a deadline or a wakeup.
+ *
+ * On Linux this waits on a timerfd armed with an absolute CLOCK_MONOTONIC
+ * deadline, which wakes far closer to the deadline than a condition variable
+ * timed wait. Elsewhere, or if the file descriptors can't be created, it
+ * falls back to a condition variable.
+ */
+class NotifierWaiter {
+ public:
+  NotifierWaiter();
+  ~NotifierWaiter();
+
+  NotifierWaiter(const NotifierWaiter&) = delete;
+  NotifierWaiter& operator=(const NotifierWaiter&) = delete;
+
+  /**
+   * Releases lock and waits for timeout microseconds of wall clock time, or
+   * forever if timeout is negative, or until Wakeup() is called. The lock is
+   * held again on return. Spurious returns are possible.
+   */
+  void Wait(std::unique_lock<wpi::mutex>& lock, int64_t timeout);
+
+  /**
+   * Wakes the waiting thread. Call after changing the state it waits on under
+   * the lock it passes to Wait().
+   */
+  void Wakeup();
+
+ private:
+  int m_timerFd = -1;
+  int m_eventFd = -1;
+  wpi::condition_variable m_cond;
+};
+}  // namespace hal
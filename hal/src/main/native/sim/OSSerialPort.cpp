@@ -5,7 +5,7 @@
 /* the project.                                                               */
 /*----------------------------------------------------------------------------*/
 
-#include "HAL/SerialPort.h"
+#include "HAL/OSSerialPort.h"
 
 namespace hal {
 namespace init {
@@ -15,6 +15,8 @@ void InitializeOSSerialPort() {}
 
 extern "C" {
 void HAL_InitializeOSSerialPort(HAL_SerialPort port, int32_t* status) {}
+void HAL_InitializeOSSerialPortDirect(HAL_SerialPort port, const char* portName,
+                                      int32_t* status) {}
 void HAL_SetOSSerialBaudRate(HAL_SerialPort port, int32_t baud,
                              int32_t* status) {}
 void HAL_SetOSSerialDataBits(HAL_SerialPort port, int32_t bits,
@@ -36,6 +38,11 @@ void HAL_SetOSSerialReadBufferSize(HAL_SerialPort port, int32_t size,
                                    int32_t* status) {}
 void HAL_SetOSSerialWriteBufferSize(HAL_SerialPort port, int32_t size,
                                     int32_t* status) {}
+void HAL_SetOSSerialLowLatency(HAL_SerialPort port, HAL_Bool lowLatency,
+                               int32_t* status) {}
+int32_t HAL_GetOSSerialFileDescriptor(HAL_SerialPort port, int32_t* status) {
+  return -1;
+}
 int32_t HAL_GetOSSerialBytesReceived(HAL_SerialPort port, int32_t* status) {
   return 0;
 }
@@ -7,6 +7,7 @@
 
 #include "HAL/PDP.h"
 
+#include "HAL/HAL.h"
 #include "MockData/PDPDataInternal.h"
 #include "PortsInternal.h"
 
@@ -42,6 +43,23 @@ double HAL_GetPDPChannelCurrent(int32_t module, int32_t channel,
 double HAL_GetPDPTotalCurrent(int32_t module, int32_t* status) { return 0.0; }
 double HAL_GetPDPTotalPower(int32_t module, int32_t* status) { return 0.0; }
 double HAL_GetPDPTotalEnergy(int32_t module, int32_t* status) { return 0.0; }
+void HAL_GetPDPAllCurrents(int32_t module, double* currents, int32_t* status) {
+  for (int i = 0; i < kNumPDPChannels; i++) {
+    currents[i] = SimPDPData[module].GetCurrent(i);
+  }
+}
+void HAL_GetPDPSnapshot(int32_t module, HAL_PDPSnapshot* snapshot,
+                        int32_t* status) {
+  HAL_GetPDPAllCurrents(module, snapshot->currents, status);
+  snapshot->voltage = SimPDPData[module].GetVoltage();
+  snapshot->temperature = SimPDPData[module].GetTemperature();
+  snapshot->totalCurrent = 0.0;
+  snapshot->totalPower = 0.0;
+  snapshot->totalEnergy = 0.0;
+  // every simulated frame is fresh
+  uint32_t now = HAL_GetFPGATime(status) / 1000;
+  for (auto& timeStamp : snapshot->frameTimeStamps) timeStamp = now;
+}
 void HAL_ResetPDPTotalEnergy(int32_t module, int32_t* status) {}
 void HAL_ClearPDPStickyFaults(int32_t module, int32_t* status) {}
 }  // extern "C"
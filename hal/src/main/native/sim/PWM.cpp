@@ -7,6 +7,8 @@
 
 #include "HAL/PWM.h"
 
+#include <atomic>
+
 #include "ConstantsInternal.h"
 #include "DigitalInternal.h"
 #include "HAL/handles/HandlesInternal.h"
@@ -15,6 +17,10 @@
 
 using namespace hal;
 
+// Simulated outputs have no register write cost, so they are always applied
+// immediately; only the mode is tracked.
+static std::atomic_bool pwmOutputsDeferred{false};
+
 namespace hal {
 namespace init {
 void InitializePWM() {}
@@ -213,6 +219,15 @@ void HAL_SetPWMSpeed(HAL_DigitalHandle pwmPortHandle, double speed,
   SimPWMData[port->channel].SetSpeed(speed);
 }
 
+void HAL_SetPWMSpeeds(const HAL_DigitalHandle* pwmPortHandles,
+                      const double* speeds, int32_t count, int32_t* status) {
+  for (int32_t i = 0; i < count; i++) {
+    int32_t channelStatus = 0;
+    HAL_SetPWMSpeed(pwmPortHandles[i], speeds[i], &channelStatus);
+    if (*status == 0) *status = channelStatus;
+  }
+}
+
 /**
  * Set a PWM channel to the desired position value. The values range from 0 to 1
  * and
@@ -357,4 +372,12 @@ int32_t HAL_GetPWMLoopTiming(int32_t* status) { return kExpectedLoopTiming; }
  * @return The pwm cycle start time.
  */
 uint64_t HAL_GetPWMCycleStartTime(int32_t* status) { return 0; }
+
+void HAL_SetPWMOutputsDeferred(HAL_Bool deferred, int32_t* status) {
+  pwmOutputsDeferred = deferred;
+}
+
+HAL_Bool HAL_GetPWMOutputsDeferred(void) { return pwmOutputsDeferred; }
+
+void HAL_CommitPWMOutputs(int32_t* status) {}
 }  // extern "C"
@@ -7,6 +7,7 @@
 
 #include "HAL/Power.h"
 
+#include "HAL/HAL.h"
 #include "MockData/RoboRioDataInternal.h"
 
 using namespace hal;
@@ -61,4 +62,22 @@ HAL_Bool HAL_GetUserActive3V3(int32_t* status) {
 int32_t HAL_GetUserCurrentFaults3V3(int32_t* status) {
   return SimRoboRioData[0].GetUserFaults3V3();
 }
+void HAL_GetPowerSnapshot(HAL_PowerSnapshot* snapshot, int32_t* status) {
+  auto& data = SimRoboRioData[0];
+  snapshot->vinVoltage = data.GetVInVoltage();
+  snapshot->vinCurrent = data.GetVInCurrent();
+  snapshot->userVoltage6V = data.GetUserVoltage6V();
+  snapshot->userCurrent6V = data.GetUserCurrent6V();
+  snapshot->userVoltage5V = data.GetUserVoltage5V();
+  snapshot->userCurrent5V = data.GetUserCurrent5V();
+  snapshot->userVoltage3V3 = data.GetUserVoltage3V3();
+  snapshot->userCurrent3V3 = data.GetUserCurrent3V3();
+  snapshot->userActive6V = data.GetUserActive6V();
+  snapshot->userActive5V = data.GetUserActive5V();
+  snapshot->userActive3V3 = data.GetUserActive3V3();
+  snapshot->userCurrentFaults6V = data.GetUserFaults6V();
+  snapshot->userCurrentFaults5V = data.GetUserFaults5V();
+  snapshot->userCurrentFaults3V3 = data.GetUserFaults3V3();
+  snapshot->timeStamp = HAL_GetFPGATime(status);
+}
 }  // extern "C"
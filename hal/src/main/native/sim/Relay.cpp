@@ -10,6 +10,7 @@
 #include "HAL/handles/IndexedHandleResource.h"
 #include "MockData/RelayDataInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 using namespace hal;
 
@@ -20,16 +21,14 @@ struct Relay {
 };
 }  // namespace
 
-static IndexedHandleResource<HAL_RelayHandle, Relay, kNumRelayChannels,
-                             HAL_HandleEnum::Relay>* relayHandles;
+static SimContextLocal<IndexedHandleResource<
+    HAL_RelayHandle, Relay, kNumRelayChannels, HAL_HandleEnum::Relay>>
+    relayHandles;
 
 namespace hal {
 namespace init {
 void InitializeRelay() {
-  static IndexedHandleResource<HAL_RelayHandle, Relay, kNumRelayChannels,
-                               HAL_HandleEnum::Relay>
-      rH;
-  relayHandles = &rH;
+  relayHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
@@ -105,6 +104,20 @@ void HAL_SetRelay(HAL_RelayHandle relayPortHandle, HAL_Bool on,
     SimRelayData[port->channel].SetReverse(on);
 }
 
+void HAL_SetRelaysMasked(uint32_t mask, uint32_t values, int32_t* status) {
+  if (mask >> kNumRelayChannels) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  for (int32_t channel = 0; channel < kNumRelayHeaders; channel++) {
+    if ((mask >> channel) & 1)
+      SimRelayData[channel].SetForward((values >> channel) & 1);
+    int32_t reverse = channel + kNumRelayHeaders;
+    if ((mask >> reverse) & 1)
+      SimRelayData[channel].SetReverse((values >> reverse) & 1);
+  }
+}
+
 HAL_Bool HAL_GetRelay(HAL_RelayHandle relayPortHandle, int32_t* status) {
   auto port = relayHandles->Get(relayPortHandle);
   if (port == nullptr) {
@@ -7,6 +7,8 @@
 
 #include "HAL/SPI.h"
 
+#include "HAL/Errors.h"
+
 #include "MockData/SPIDataInternal.h"
 
 using namespace hal;
@@ -24,6 +26,25 @@ int32_t HAL_TransactionSPI(HAL_SPIPort port, const uint8_t* dataToSend,
                            uint8_t* dataReceived, int32_t size) {
   return SimSPIData[port].Transaction(dataToSend, dataReceived, size);
 }
+int32_t HAL_TransactionSPIBatch(HAL_SPIPort port,
+                                const struct HAL_SPITransfer* transfers,
+                                int32_t count) {
+  if (count <= 0 || count > HAL_kSPIMaxBatchTransfers) return -1;
+  int32_t total = 0;
+  for (int32_t i = 0; i < count; i++) {
+    const auto& transfer = transfers[i];
+    if (transfer.dataReceived == nullptr) {
+      total += SimSPIData[port].Write(transfer.dataToSend, transfer.size);
+    } else if (transfer.dataToSend == nullptr) {
+      total += SimSPIData[port].Read(transfer.dataReceived, transfer.size);
+    } else {
+      total += SimSPIData[port].Transaction(transfer.dataToSend,
+                                            transfer.dataReceived,
+                                            transfer.size);
+    }
+  }
+  return total;
+}
 int32_t HAL_WriteSPI(HAL_SPIPort port, const uint8_t* dataToSend,
                      int32_t sendSize) {
   return SimSPIData[port].Write(dataToSend, sendSize);
@@ -40,18 +61,38 @@ void HAL_SetSPIChipSelectActiveLow(HAL_SPIPort port, int32_t* status) {}
 int32_t HAL_GetSPIHandle(HAL_SPIPort port) { return 0; }
 void HAL_SetSPIHandle(HAL_SPIPort port, int32_t handle) {}
 
-void HAL_InitSPIAuto(HAL_SPIPort port, int32_t bufferSize, int32_t* status) {}
-void HAL_FreeSPIAuto(HAL_SPIPort port, int32_t* status) {}
-void HAL_StartSPIAutoRate(HAL_SPIPort port, double period, int32_t* status) {}
+void HAL_InitSPIAuto(HAL_SPIPort port, int32_t bufferSize, int32_t* status) {
+  if (bufferSize <= 0) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  SimSPIData[port].InitAuto(bufferSize);
+}
+void HAL_FreeSPIAuto(HAL_SPIPort port, int32_t* status) {
+  SimSPIData[port].FreeAuto();
+}
+void HAL_StartSPIAutoRate(HAL_SPIPort port, double period, int32_t* status) {
+  SimSPIData[port].StartAutoRate(period);
+}
 void HAL_StartSPIAutoTrigger(HAL_SPIPort port, HAL_Handle digitalSourceHandle,
                              HAL_AnalogTriggerType analogTriggerType,
                              HAL_Bool triggerRising, HAL_Bool triggerFalling,
                              int32_t* status) {}
-void HAL_StopSPIAuto(HAL_SPIPort port, int32_t* status) {}
+void HAL_StopSPIAuto(HAL_SPIPort port, int32_t* status) {
+  SimSPIData[port].StopAuto();
+}
 void HAL_SetSPIAutoTransmitData(HAL_SPIPort port, const uint8_t* dataToSend,
                                 int32_t dataSize, int32_t zeroSize,
-                                int32_t* status) {}
-void HAL_ForceSPIAutoRead(HAL_SPIPort port, int32_t* status) {}
+                                int32_t* status) {
+  if (dataSize < 0 || dataSize > 16 || zeroSize < 0 || zeroSize > 127) {
+    *status = PARAMETER_OUT_OF_RANGE;
+    return;
+  }
+  SimSPIData[port].SetAutoTransmitData(dataToSend, dataSize, zeroSize);
+}
+void HAL_ForceSPIAutoRead(HAL_SPIPort port, int32_t* status) {
+  SimSPIData[port].ForceAutoRead();
+}
 int32_t HAL_ReadSPIAutoReceivedData(HAL_SPIPort port, uint8_t* buffer,
                                     int32_t numToRead, double timeout,
                                     int32_t* status) {
@@ -59,5 +100,5 @@ int32_t HAL_ReadSPIAutoReceivedData(HAL_SPIPort port, uint8_t* buffer,
                                                status);
 }
 int32_t HAL_GetSPIAutoDroppedCount(HAL_SPIPort port, int32_t* status) {
-  return 0;
+  return SimSPIData[port].GetAutoDroppedCount();
 }
@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "SimContextInternal.h"
+
+#include <support/mutex.h>
+
+namespace {
+struct SimContextSlot {
+  void* (*create)();
+  void (*destroy)(void*);
+};
+}  // namespace
+
+using namespace hal;
+
+HALSIM_Context hal::defaultSimContext;
+thread_local HALSIM_Context* hal::currentSimContext = nullptr;
+
+static wpi::mutex slotsMutex;
+static std::vector<SimContextSlot>* slots;
+
+namespace hal {
+namespace init {
+void InitializeSimContext() {
+  static std::vector<SimContextSlot> s;
+  slots = &s;
+}
+}  // namespace init
+
+int RegisterSimContextSlot(void* (*create)(), void (*destroy)(void*)) {
+  std::lock_guard<wpi::mutex> lock(slotsMutex);
+  slots->push_back(SimContextSlot{create, destroy});
+  defaultSimContext.objects.push_back(create());
+  return slots->size() - 1;
+}
+}  // namespace hal
+
+extern "C" {
+HALSIM_Context* HALSIM_CreateContext(void) {
+  auto context = new HALSIM_Context;
+  // Objects are created with the new context selected, so those that reach
+  // other state on construction find their own context's
+  HALSIM_Context* previous = currentSimContext;
+  currentSimContext = context;
+  {
+    std::lock_guard<wpi::mutex> lock(slotsMutex);
+    context->objects.resize(slots->size());
+    for (size_t i = 0; i < slots->size(); i++) {
+      context->objects[i] = (*slots)[i].create();
+    }
+  }
+  currentSimContext = previous;
+  return context;
+}
+
+void HALSIM_DestroyContext(HALSIM_Context* context) {
+  if (!context || context == &defaultSimContext) return;
+  HALSIM_Context* previous = currentSimContext;
+  currentSimContext = context;
+  {
+    std::lock_guard<wpi::mutex> lock(slotsMutex);
+    for (size_t i = context->objects.size(); i-- > 0;) {
+      (*slots)[i].destroy(context->objects[i]);
+    }
+  }
+  currentSimContext = previous == context ? nullptr : previous;
+  delete context;
+}
+
+void HALSIM_SetThreadContext(HALSIM_Context* context) {
+  currentSimContext = context == &defaultSimContext ? nullptr : context;
+}
+
+HALSIM_Context* HALSIM_GetThreadContext(void) {
+  return currentSimContext ? currentSimContext : &defaultSimContext;
+}
+}  // extern "C"
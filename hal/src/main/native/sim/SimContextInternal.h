@@ -0,0 +1,109 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "MockData/SimContext.h"
+
+// The objects of every registered slot, indexed by slot
+struct HALSIM_Context {
+  std::vector<void*> objects;
+};
+
+namespace hal {
+extern HALSIM_Context defaultSimContext;
+extern thread_local HALSIM_Context* currentSimContext;
+
+// Registers a slot, creating its object in the default context; contexts
+// created later get their own object. Slots are registered from the HAL's
+// initialize functions, and destroyed in the reverse order.
+int RegisterSimContextSlot(void* (*create)(), void (*destroy)(void*));
+
+inline void* GetSimContextObject(int slot) {
+  HALSIM_Context* context = currentSimContext;
+  if (!context) context = &defaultSimContext;
+  return context->objects[slot];
+}
+
+/**
+ * A T that every simulation context has its own instance of. Used in place of
+ * a pointer to a static; the instance is that of the calling thread's
+ * context.
+ */
+template <typename T>
+class SimContextLocal {
+ public:
+  void Initialize() { m_slot = RegisterSimContextSlot(&Create, &Destroy); }
+
+  T* Get() const { return static_cast<T*>(GetSimContextObject(m_slot)); }
+  T* operator->() const { return Get(); }
+  T& operator*() const { return *Get(); }
+  operator T*() const { return Get(); }
+
+ private:
+  static void* Create() { return new T; }
+  static void Destroy(void* object) { delete static_cast<T*>(object); }
+
+  int m_slot = -1;
+};
+
+/**
+ * An array of N T that every simulation context has its own instance of.
+ * Converts to a pointer to the first element, like the array it replaces.
+ */
+template <typename T, size_t N>
+class SimContextLocalArray {
+ public:
+  void Initialize() { m_slot = RegisterSimContextSlot(&Create, &Destroy); }
+
+  T* Get() const { return static_cast<T*>(GetSimContextObject(m_slot)); }
+  operator T*() const { return Get(); }
+
+ private:
+  static void* Create() { return new T[N]; }
+  static void Destroy(void* object) { delete[] static_cast<T*>(object); }
+
+  int m_slot = -1;
+};
+
+/**
+ * A SimContextLocalArray whose elements keep their most used values in one
+ * Hot struct of arrays rather than in themselves, so reading a value of every
+ * element touches a few cache lines instead of one or more per element.
+ * Elements are bound to their slots with T::BindHot(Hot&, size_t index).
+ */
+template <typename T, typename Hot, size_t N>
+class SimContextLocalHotArray {
+ public:
+  void Initialize() { m_slot = RegisterSimContextSlot(&Create, &Destroy); }
+
+  T* Get() const { return GetBlock()->elements; }
+  Hot& GetHot() const { return GetBlock()->hot; }
+  operator T*() const { return Get(); }
+
+ private:
+  struct Block {
+    Block() {
+      for (size_t i = 0; i < N; i++) elements[i].BindHot(hot, i);
+    }
+    Hot hot;
+    T elements[N];
+  };
+
+  Block* GetBlock() const {
+    return static_cast<Block*>(GetSimContextObject(m_slot));
+  }
+  static void* Create() { return new Block; }
+  static void Destroy(void* object) { delete static_cast<Block*>(object); }
+
+  int m_slot = -1;
+};
+}  // namespace hal
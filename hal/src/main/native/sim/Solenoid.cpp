@@ -12,6 +12,7 @@
 #include "HAL/handles/IndexedHandleResource.h"
 #include "MockData/PCMDataInternal.h"
 #include "PortsInternal.h"
+#include "SimContextInternal.h"
 
 namespace {
 struct Solenoid {
@@ -22,18 +23,15 @@ struct Solenoid {
 
 using namespace hal;
 
-static IndexedHandleResource<HAL_SolenoidHandle, Solenoid,
-                             kNumPCMModules * kNumSolenoidChannels,
-                             HAL_HandleEnum::Solenoid>* solenoidHandles;
+static SimContextLocal<IndexedHandleResource<
+    HAL_SolenoidHandle, Solenoid, kNumPCMModules * kNumSolenoidChannels,
+    HAL_HandleEnum::Solenoid>>
+    solenoidHandles;
 
 namespace hal {
 namespace init {
 void InitializeSolenoid() {
-  static IndexedHandleResource<HAL_SolenoidHandle, Solenoid,
-                               kNumPCMModules * kNumSolenoidChannels,
-                               HAL_HandleEnum::Solenoid>
-      sH;
-  solenoidHandles = &sH;
+  solenoidHandles.Initialize();
 }
 }  // namespace init
 }  // namespace hal
@@ -118,6 +116,19 @@ void HAL_SetSolenoid(HAL_SolenoidHandle solenoidPortHandle, HAL_Bool value,
 
   HALSIM_SetPCMSolenoidOutput(port->module, port->channel, value);
 }
+void HAL_SetAllSolenoids(int32_t module, int32_t state, int32_t* status) {
+  HAL_SetSolenoids(module, 0xFF, state, status);
+}
+void HAL_SetSolenoids(int32_t module, int32_t mask, int32_t values,
+                      int32_t* status) {
+  for (int i = 0; i < kNumSolenoidChannels; i++) {
+    if (mask & (1 << i)) {
+      HALSIM_SetPCMSolenoidOutput(module, i, (values & (1 << i)) != 0);
+    }
+  }
+}
+void HAL_BeginSolenoidTransaction(int32_t module, int32_t* status) {}
+void HAL_EndSolenoidTransaction(int32_t module, int32_t* status) {}
 int32_t HAL_GetPCMSolenoidBlackList(int32_t module, int32_t* status) {
   return 0;
 }
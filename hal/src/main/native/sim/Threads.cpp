@@ -28,3 +28,20 @@ HAL_Bool HAL_SetCurrentThreadPriority(HAL_Bool realTime, int32_t priority,
                                       int32_t* status) {
   return true;
 }
+int32_t HAL_GetThreadAffinity(NativeThreadHandle handle, int32_t* status) {
+  return 0;
+}
+HAL_Bool HAL_SetThreadAffinity(NativeThreadHandle handle, int32_t cpuMask,
+                               int32_t* status) {
+  return true;
+}
+HAL_Bool HAL_SetCurrentThreadAffinity(int32_t cpuMask, int32_t* status) {
+  return true;
+}
+HAL_Bool HAL_LockProcessMemory(int32_t stackPrefaultSize, int32_t* status) {
+  return true;
+}
+int32_t HAL_GetThreadCPUUsage(HAL_ThreadCPUUsage* usage, int32_t count,
+                              int32_t* status) {
+  return 0;
+}
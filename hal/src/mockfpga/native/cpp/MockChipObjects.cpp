@@ -0,0 +1,106 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+// This file is generated by gen/hal_mockfpga.py. Do not edit.
+
+#include "MockChipObjects.h"
+
+using namespace hal::mockfpga;
+
+namespace nFPGA {
+namespace nRoboRIO_FPGANamespace {
+
+tAI* tAI::create(tRioStatusCode* status) {
+  return new MockAI;
+}
+
+tAO* tAO::create(tRioStatusCode* status) {
+  return new MockAO;
+}
+
+tAccel* tAccel::create(tRioStatusCode* status) {
+  return new MockAccel;
+}
+
+tAccumulator* tAccumulator::create(unsigned char sys_index, tRioStatusCode* status) {
+  if (sys_index >= 2) {
+    *status = NiFpga_Status_InvalidParameter;
+    return nullptr;
+  }
+  return new MockAccumulator(sys_index);
+}
+
+tAnalogTrigger* tAnalogTrigger::create(unsigned char sys_index, tRioStatusCode* status) {
+  if (sys_index >= 8) {
+    *status = NiFpga_Status_InvalidParameter;
+    return nullptr;
+  }
+  return new MockAnalogTrigger(sys_index);
+}
+
+tBIST* tBIST::create(tRioStatusCode* status) {
+  return new MockBIST;
+}
+
+tCounter* tCounter::create(unsigned char sys_index, tRioStatusCode* status) {
+  if (sys_index >= 8) {
+    *status = NiFpga_Status_InvalidParameter;
+    return nullptr;
+  }
+  return new MockCounter(sys_index);
+}
+
+tDIO* tDIO::create(tRioStatusCode* status) {
+  return new MockDIO;
+}
+
+tDMA* tDMA::create(tRioStatusCode* status) {
+  return new MockDMA;
+}
+
+tEncoder* tEncoder::create(unsigned char sys_index, tRioStatusCode* status) {
+  if (sys_index >= 8) {
+    *status = NiFpga_Status_InvalidParameter;
+    return nullptr;
+  }
+  return new MockEncoder(sys_index);
+}
+
+tHMB* tHMB::create(tRioStatusCode* status) {
+  return new MockHMB;
+}
+
+tInterrupt* tInterrupt::create(unsigned char sys_index, tRioStatusCode* status) {
+  if (sys_index >= 8) {
+    *status = NiFpga_Status_InvalidParameter;
+    return nullptr;
+  }
+  return new MockInterrupt(sys_index);
+}
+
+tPWM* tPWM::create(tRioStatusCode* status) {
+  return new MockPWM;
+}
+
+tPower* tPower::create(tRioStatusCode* status) {
+  return new MockPower;
+}
+
+tRelay* tRelay::create(tRioStatusCode* status) {
+  return new MockRelay;
+}
+
+tSPI* tSPI::create(tRioStatusCode* status) {
+  return new MockSPI;
+}
+
+tSysWatchdog* tSysWatchdog::create(tRioStatusCode* status) {
+  return new MockSysWatchdog;
+}
+
+}  // namespace nRoboRIO_FPGANamespace
+}  // namespace nFPGA
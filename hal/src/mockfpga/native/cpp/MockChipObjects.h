@@ -0,0 +1,2847 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+// This file is generated by gen/hal_mockfpga.py. Do not edit.
+
+#pragma once
+
+#include <support/mutex.h>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#pragma GCC diagnostic ignored "-Wignored-qualifiers"
+
+#include <FRC_FPGA_ChipObject/RoboRIO_FRC_ChipObject_Aliases.h>
+#include <FRC_FPGA_ChipObject/tDMAManager.h>
+#include <FRC_FPGA_ChipObject/tInterruptManager.h>
+#include <FRC_FPGA_ChipObject/tSystem.h>
+#include <FRC_FPGA_ChipObject/tSystemInterface.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tAI.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tAO.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tAccel.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tAccumulator.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tAlarm.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tAnalogTrigger.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tBIST.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tCounter.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tDIO.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tDMA.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tEncoder.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tGlobal.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tHMB.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tInterrupt.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tPWM.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tPower.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tRelay.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tSPI.h>
+#include <FRC_FPGA_ChipObject/nRoboRIO_FPGANamespace/tSysWatchdog.h>
+
+#pragma GCC diagnostic pop
+
+#include "MockFPGAInternal.h"
+
+namespace hal {
+namespace mockfpga {
+
+using namespace nFPGA;
+using namespace nFPGA::nRoboRIO_FPGANamespace;
+
+class MockAI : public tAI {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  signed int readOutput(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output;
+  }
+
+  void writeConfig(tConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config = value;
+  }
+
+  void writeConfig_ScanSize(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.ScanSize = value;
+  }
+
+  void writeConfig_ConvertRate(unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.ConvertRate = value;
+  }
+
+  tConfig readConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config;
+  }
+
+  unsigned char readConfig_ScanSize(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.ScanSize;
+  }
+
+  unsigned int readConfig_ConvertRate(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.ConvertRate;
+  }
+
+  unsigned int readLoopTiming(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LoopTiming;
+  }
+
+  void writeOversampleBits(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_OversampleBits[bitfield_index] = value;
+  }
+
+  unsigned char readOversampleBits(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_OversampleBits[bitfield_index];
+  }
+
+  void writeAverageBits(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AverageBits[bitfield_index] = value;
+  }
+
+  unsigned char readAverageBits(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AverageBits[bitfield_index];
+  }
+
+  void writeScanList(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ScanList[bitfield_index] = value;
+  }
+
+  unsigned char readScanList(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ScanList[bitfield_index];
+  }
+
+  void strobeLatchOutput(tRioStatusCode *status) override {
+    hal::mockfpga::RegisterWrite(m_mutex);
+  }
+
+  void writeReadSelect(tReadSelect value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ReadSelect = value;
+  }
+
+  void writeReadSelect_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ReadSelect.Channel = value;
+  }
+
+  void writeReadSelect_Averaged(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ReadSelect.Averaged = value;
+  }
+
+  tReadSelect readReadSelect(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ReadSelect;
+  }
+
+  unsigned char readReadSelect_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ReadSelect.Channel;
+  }
+
+  bool readReadSelect_Averaged(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ReadSelect.Averaged;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  signed int m_Output{};
+  tConfig m_Config{};
+  unsigned int m_LoopTiming{40};
+  unsigned char m_OversampleBits[8]{};
+  unsigned char m_AverageBits[8]{};
+  unsigned char m_ScanList[8]{};
+  tReadSelect m_ReadSelect{};
+};
+
+class MockAO : public tAO {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeMXP(unsigned char reg_index, unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_MXP = value;
+  }
+
+  unsigned short readMXP(unsigned char reg_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_MXP;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned short m_MXP{};
+};
+
+class MockAccel : public tAccel {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  unsigned char readSTAT(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_STAT;
+  }
+
+  void writeDATO(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DATO = value;
+  }
+
+  unsigned char readDATO(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DATO;
+  }
+
+  void writeCNTR(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_CNTR = value;
+  }
+
+  unsigned char readCNTR(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_CNTR;
+  }
+
+  void writeCNFG(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_CNFG = value;
+  }
+
+  unsigned char readCNFG(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_CNFG;
+  }
+
+  void writeCNTL(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_CNTL = value;
+  }
+
+  unsigned char readCNTL(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_CNTL;
+  }
+
+  unsigned char readDATI(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DATI;
+  }
+
+  void strobeGO(tRioStatusCode *status) override {
+    hal::mockfpga::RegisterWrite(m_mutex);
+  }
+
+  void writeADDR(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ADDR = value;
+  }
+
+  unsigned char readADDR(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ADDR;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned char m_STAT{};
+  unsigned char m_DATO{};
+  unsigned char m_CNTR{};
+  unsigned char m_CNFG{};
+  unsigned char m_CNTL{};
+  unsigned char m_DATI{};
+  unsigned char m_ADDR{};
+};
+
+class MockAccumulator : public tAccumulator {
+ public:
+  explicit MockAccumulator(unsigned char index) : m_index(index) {}
+
+  unsigned char getSystemIndex() override { return m_index; }
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  tOutput readOutput(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output;
+  }
+
+  signed long long readOutput_Value(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output.Value;
+  }
+
+  unsigned int readOutput_Count(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output.Count;
+  }
+
+  void writeCenter(signed int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Center = value;
+  }
+
+  signed int readCenter(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Center;
+  }
+
+  void writeDeadband(signed int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Deadband = value;
+  }
+
+  signed int readDeadband(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Deadband;
+  }
+
+  void strobeReset(tRioStatusCode *status) override {
+    hal::mockfpga::RegisterWrite(m_mutex);
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned char m_index;
+  tOutput m_Output{};
+  signed int m_Center{};
+  signed int m_Deadband{};
+};
+
+class MockAlarm : public tAlarm {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeEnable(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Enable = value;
+  }
+
+  bool readEnable(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Enable;
+  }
+
+  void writeTriggerTime(unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TriggerTime = value;
+  }
+
+  unsigned int readTriggerTime(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TriggerTime;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  bool m_Enable{};
+  unsigned int m_TriggerTime{};
+};
+
+class MockAnalogTrigger : public tAnalogTrigger {
+ public:
+  explicit MockAnalogTrigger(unsigned char index) : m_index(index) {}
+
+  unsigned char getSystemIndex() override { return m_index; }
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeSourceSelect(tSourceSelect value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_SourceSelect = value;
+  }
+
+  void writeSourceSelect_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_SourceSelect.Channel = value;
+  }
+
+  void writeSourceSelect_Averaged(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_SourceSelect.Averaged = value;
+  }
+
+  void writeSourceSelect_Filter(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_SourceSelect.Filter = value;
+  }
+
+  void writeSourceSelect_FloatingRollover(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_SourceSelect.FloatingRollover = value;
+  }
+
+  void writeSourceSelect_RolloverLimit(signed short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_SourceSelect.RolloverLimit = value;
+  }
+
+  tSourceSelect readSourceSelect(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_SourceSelect;
+  }
+
+  unsigned char readSourceSelect_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_SourceSelect.Channel;
+  }
+
+  bool readSourceSelect_Averaged(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_SourceSelect.Averaged;
+  }
+
+  bool readSourceSelect_Filter(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_SourceSelect.Filter;
+  }
+
+  bool readSourceSelect_FloatingRollover(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_SourceSelect.FloatingRollover;
+  }
+
+  signed short readSourceSelect_RolloverLimit(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_SourceSelect.RolloverLimit;
+  }
+
+  void writeUpperLimit(signed int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_UpperLimit = value;
+  }
+
+  signed int readUpperLimit(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_UpperLimit;
+  }
+
+  void writeLowerLimit(signed int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_LowerLimit = value;
+  }
+
+  signed int readLowerLimit(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LowerLimit;
+  }
+
+  tOutput readOutput(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output[bitfield_index];
+  }
+
+  bool readOutput_InHysteresis(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output[bitfield_index].InHysteresis;
+  }
+
+  bool readOutput_OverLimit(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output[bitfield_index].OverLimit;
+  }
+
+  bool readOutput_Rising(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output[bitfield_index].Rising;
+  }
+
+  bool readOutput_Falling(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 8) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output[bitfield_index].Falling;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned char m_index;
+  tSourceSelect m_SourceSelect{};
+  signed int m_UpperLimit{};
+  signed int m_LowerLimit{};
+  tOutput m_Output[8]{};
+};
+
+class MockBIST : public tBIST {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeDO0SquareTicks(unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO0SquareTicks = value;
+  }
+
+  unsigned int readDO0SquareTicks(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO0SquareTicks;
+  }
+
+  void writeEnable(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Enable = value;
+  }
+
+  bool readEnable(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Enable;
+  }
+
+  void writeDO1SquareEnable(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO1SquareEnable = value;
+  }
+
+  bool readDO1SquareEnable(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO1SquareEnable;
+  }
+
+  void writeDO0SquareEnable(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO0SquareEnable = value;
+  }
+
+  bool readDO0SquareEnable(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO0SquareEnable;
+  }
+
+  void writeDO1SquareTicks(unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO1SquareTicks = value;
+  }
+
+  unsigned int readDO1SquareTicks(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO1SquareTicks;
+  }
+
+  void writeDO(unsigned char reg_index, bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO = value;
+  }
+
+  bool readDO(unsigned char reg_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned int m_DO0SquareTicks{};
+  bool m_Enable{};
+  bool m_DO1SquareEnable{};
+  bool m_DO0SquareEnable{};
+  unsigned int m_DO1SquareTicks{};
+  bool m_DO{};
+};
+
+class MockCounter : public tCounter {
+ public:
+  explicit MockCounter(unsigned char index) : m_index(index) {}
+
+  unsigned char getSystemIndex() override { return m_index; }
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  tOutput readOutput(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output;
+  }
+
+  bool readOutput_Direction(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output.Direction;
+  }
+
+  signed int readOutput_Value(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output.Value;
+  }
+
+  void writeConfig(tConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config = value;
+  }
+
+  void writeConfig_UpSource_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.UpSource_Channel = value;
+  }
+
+  void writeConfig_UpSource_Module(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.UpSource_Module = value;
+  }
+
+  void writeConfig_UpSource_AnalogTrigger(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.UpSource_AnalogTrigger = value;
+  }
+
+  void writeConfig_DownSource_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.DownSource_Channel = value;
+  }
+
+  void writeConfig_DownSource_Module(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.DownSource_Module = value;
+  }
+
+  void writeConfig_DownSource_AnalogTrigger(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.DownSource_AnalogTrigger = value;
+  }
+
+  void writeConfig_IndexSource_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexSource_Channel = value;
+  }
+
+  void writeConfig_IndexSource_Module(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexSource_Module = value;
+  }
+
+  void writeConfig_IndexSource_AnalogTrigger(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexSource_AnalogTrigger = value;
+  }
+
+  void writeConfig_IndexActiveHigh(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexActiveHigh = value;
+  }
+
+  void writeConfig_IndexEdgeSensitive(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexEdgeSensitive = value;
+  }
+
+  void writeConfig_UpRisingEdge(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.UpRisingEdge = value;
+  }
+
+  void writeConfig_UpFallingEdge(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.UpFallingEdge = value;
+  }
+
+  void writeConfig_DownRisingEdge(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.DownRisingEdge = value;
+  }
+
+  void writeConfig_DownFallingEdge(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.DownFallingEdge = value;
+  }
+
+  void writeConfig_Mode(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Mode = value;
+  }
+
+  void writeConfig_PulseLengthThreshold(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.PulseLengthThreshold = value;
+  }
+
+  tConfig readConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config;
+  }
+
+  unsigned char readConfig_UpSource_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.UpSource_Channel;
+  }
+
+  unsigned char readConfig_UpSource_Module(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.UpSource_Module;
+  }
+
+  bool readConfig_UpSource_AnalogTrigger(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.UpSource_AnalogTrigger;
+  }
+
+  unsigned char readConfig_DownSource_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.DownSource_Channel;
+  }
+
+  unsigned char readConfig_DownSource_Module(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.DownSource_Module;
+  }
+
+  bool readConfig_DownSource_AnalogTrigger(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.DownSource_AnalogTrigger;
+  }
+
+  unsigned char readConfig_IndexSource_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexSource_Channel;
+  }
+
+  unsigned char readConfig_IndexSource_Module(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexSource_Module;
+  }
+
+  bool readConfig_IndexSource_AnalogTrigger(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexSource_AnalogTrigger;
+  }
+
+  bool readConfig_IndexActiveHigh(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexActiveHigh;
+  }
+
+  bool readConfig_IndexEdgeSensitive(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexEdgeSensitive;
+  }
+
+  bool readConfig_UpRisingEdge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.UpRisingEdge;
+  }
+
+  bool readConfig_UpFallingEdge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.UpFallingEdge;
+  }
+
+  bool readConfig_DownRisingEdge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.DownRisingEdge;
+  }
+
+  bool readConfig_DownFallingEdge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.DownFallingEdge;
+  }
+
+  unsigned char readConfig_Mode(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Mode;
+  }
+
+  unsigned short readConfig_PulseLengthThreshold(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.PulseLengthThreshold;
+  }
+
+  tTimerOutput readTimerOutput(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerOutput;
+  }
+
+  unsigned int readTimerOutput_Period(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerOutput.Period;
+  }
+
+  signed char readTimerOutput_Count(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerOutput.Count;
+  }
+
+  bool readTimerOutput_Stalled(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerOutput.Stalled;
+  }
+
+  void strobeReset(tRioStatusCode *status) override {
+    hal::mockfpga::RegisterWrite(m_mutex);
+  }
+
+  void writeTimerConfig(tTimerConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TimerConfig = value;
+  }
+
+  void writeTimerConfig_StallPeriod(unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TimerConfig.StallPeriod = value;
+  }
+
+  void writeTimerConfig_AverageSize(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TimerConfig.AverageSize = value;
+  }
+
+  void writeTimerConfig_UpdateWhenEmpty(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TimerConfig.UpdateWhenEmpty = value;
+  }
+
+  tTimerConfig readTimerConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerConfig;
+  }
+
+  unsigned int readTimerConfig_StallPeriod(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerConfig.StallPeriod;
+  }
+
+  unsigned char readTimerConfig_AverageSize(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerConfig.AverageSize;
+  }
+
+  bool readTimerConfig_UpdateWhenEmpty(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerConfig.UpdateWhenEmpty;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned char m_index;
+  tOutput m_Output{};
+  tConfig m_Config{};
+  tTimerOutput m_TimerOutput{};
+  tTimerConfig m_TimerConfig{};
+};
+
+class MockDIO : public tDIO {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeDO(tDO value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO = value;
+  }
+
+  void writeDO_Headers(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO.Headers = value;
+  }
+
+  void writeDO_SPIPort(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO.SPIPort = value;
+  }
+
+  void writeDO_Reserved(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO.Reserved = value;
+  }
+
+  void writeDO_MXP(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_DO.MXP = value;
+  }
+
+  tDO readDO(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO;
+  }
+
+  unsigned short readDO_Headers(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO.Headers;
+  }
+
+  unsigned char readDO_SPIPort(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO.SPIPort;
+  }
+
+  unsigned char readDO_Reserved(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO.Reserved;
+  }
+
+  unsigned short readDO_MXP(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DO.MXP;
+  }
+
+  void writePWMDutyCycleA(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 4) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_PWMDutyCycleA[bitfield_index] = value;
+  }
+
+  unsigned char readPWMDutyCycleA(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 4) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_PWMDutyCycleA[bitfield_index];
+  }
+
+  void writePWMDutyCycleB(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 2) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_PWMDutyCycleB[bitfield_index] = value;
+  }
+
+  unsigned char readPWMDutyCycleB(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 2) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_PWMDutyCycleB[bitfield_index];
+  }
+
+  void writeFilterSelectHdr(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 16) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_FilterSelectHdr[bitfield_index] = value;
+  }
+
+  unsigned char readFilterSelectHdr(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 16) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FilterSelectHdr[bitfield_index];
+  }
+
+  void writeOutputEnable(tOutputEnable value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_OutputEnable = value;
+  }
+
+  void writeOutputEnable_Headers(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_OutputEnable.Headers = value;
+  }
+
+  void writeOutputEnable_SPIPort(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_OutputEnable.SPIPort = value;
+  }
+
+  void writeOutputEnable_Reserved(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_OutputEnable.Reserved = value;
+  }
+
+  void writeOutputEnable_MXP(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_OutputEnable.MXP = value;
+  }
+
+  tOutputEnable readOutputEnable(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_OutputEnable;
+  }
+
+  unsigned short readOutputEnable_Headers(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_OutputEnable.Headers;
+  }
+
+  unsigned char readOutputEnable_SPIPort(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_OutputEnable.SPIPort;
+  }
+
+  unsigned char readOutputEnable_Reserved(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_OutputEnable.Reserved;
+  }
+
+  unsigned short readOutputEnable_MXP(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_OutputEnable.MXP;
+  }
+
+  void writePWMOutputSelect(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 6) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_PWMOutputSelect[bitfield_index] = value;
+  }
+
+  unsigned char readPWMOutputSelect(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 6) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_PWMOutputSelect[bitfield_index];
+  }
+
+  void writePulse(tPulse value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Pulse = value;
+  }
+
+  void writePulse_Headers(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Pulse.Headers = value;
+  }
+
+  void writePulse_SPIPort(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Pulse.SPIPort = value;
+  }
+
+  void writePulse_Reserved(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Pulse.Reserved = value;
+  }
+
+  void writePulse_MXP(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Pulse.MXP = value;
+  }
+
+  tPulse readPulse(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Pulse;
+  }
+
+  unsigned short readPulse_Headers(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Pulse.Headers;
+  }
+
+  unsigned char readPulse_SPIPort(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Pulse.SPIPort;
+  }
+
+  unsigned char readPulse_Reserved(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Pulse.Reserved;
+  }
+
+  unsigned short readPulse_MXP(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Pulse.MXP;
+  }
+
+  tDI readDI(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DI;
+  }
+
+  unsigned short readDI_Headers(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DI.Headers;
+  }
+
+  unsigned char readDI_SPIPort(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DI.SPIPort;
+  }
+
+  unsigned char readDI_Reserved(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DI.Reserved;
+  }
+
+  unsigned short readDI_MXP(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DI.MXP;
+  }
+
+  void writeEnableMXPSpecialFunction(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_EnableMXPSpecialFunction = value;
+  }
+
+  unsigned short readEnableMXPSpecialFunction(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_EnableMXPSpecialFunction;
+  }
+
+  void writeFilterSelectMXP(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 16) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_FilterSelectMXP[bitfield_index] = value;
+  }
+
+  unsigned char readFilterSelectMXP(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 16) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FilterSelectMXP[bitfield_index];
+  }
+
+  void writePulseLength(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_PulseLength = value;
+  }
+
+  unsigned char readPulseLength(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_PulseLength;
+  }
+
+  void writePWMPeriodPower(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_PWMPeriodPower = value;
+  }
+
+  unsigned short readPWMPeriodPower(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_PWMPeriodPower;
+  }
+
+  void writeFilterPeriodMXP(unsigned char reg_index, unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_FilterPeriodMXP = value;
+  }
+
+  unsigned int readFilterPeriodMXP(unsigned char reg_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FilterPeriodMXP;
+  }
+
+  void writeFilterPeriodHdr(unsigned char reg_index, unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_FilterPeriodHdr = value;
+  }
+
+  unsigned int readFilterPeriodHdr(unsigned char reg_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FilterPeriodHdr;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  tDO m_DO{};
+  unsigned char m_PWMDutyCycleA[4]{};
+  unsigned char m_PWMDutyCycleB[2]{};
+  unsigned char m_FilterSelectHdr[16]{};
+  tOutputEnable m_OutputEnable{};
+  unsigned char m_PWMOutputSelect[6]{};
+  tPulse m_Pulse{};
+  tDI m_DI{};
+  unsigned short m_EnableMXPSpecialFunction{};
+  unsigned char m_FilterSelectMXP[16]{};
+  unsigned char m_PulseLength{};
+  unsigned short m_PWMPeriodPower{};
+  unsigned int m_FilterPeriodMXP{};
+  unsigned int m_FilterPeriodHdr{};
+};
+
+class MockDMA : public tDMA {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeRate(unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Rate = value;
+  }
+
+  unsigned int readRate(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Rate;
+  }
+
+  void writeConfig(tConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config = value;
+  }
+
+  void writeConfig_Pause(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Pause = value;
+  }
+
+  void writeConfig_Enable_AI0_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AI0_Low = value;
+  }
+
+  void writeConfig_Enable_AI0_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AI0_High = value;
+  }
+
+  void writeConfig_Enable_AIAveraged0_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AIAveraged0_Low = value;
+  }
+
+  void writeConfig_Enable_AIAveraged0_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AIAveraged0_High = value;
+  }
+
+  void writeConfig_Enable_AI1_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AI1_Low = value;
+  }
+
+  void writeConfig_Enable_AI1_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AI1_High = value;
+  }
+
+  void writeConfig_Enable_AIAveraged1_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AIAveraged1_Low = value;
+  }
+
+  void writeConfig_Enable_AIAveraged1_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AIAveraged1_High = value;
+  }
+
+  void writeConfig_Enable_Accumulator0(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_Accumulator0 = value;
+  }
+
+  void writeConfig_Enable_Accumulator1(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_Accumulator1 = value;
+  }
+
+  void writeConfig_Enable_DI(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_DI = value;
+  }
+
+  void writeConfig_Enable_AnalogTriggers(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_AnalogTriggers = value;
+  }
+
+  void writeConfig_Enable_Counters_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_Counters_Low = value;
+  }
+
+  void writeConfig_Enable_Counters_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_Counters_High = value;
+  }
+
+  void writeConfig_Enable_CounterTimers_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_CounterTimers_Low = value;
+  }
+
+  void writeConfig_Enable_CounterTimers_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_CounterTimers_High = value;
+  }
+
+  void writeConfig_Enable_Encoders_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_Encoders_Low = value;
+  }
+
+  void writeConfig_Enable_Encoders_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_Encoders_High = value;
+  }
+
+  void writeConfig_Enable_EncoderTimers_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_EncoderTimers_Low = value;
+  }
+
+  void writeConfig_Enable_EncoderTimers_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enable_EncoderTimers_High = value;
+  }
+
+  void writeConfig_ExternalClock(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.ExternalClock = value;
+  }
+
+  tConfig readConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config;
+  }
+
+  bool readConfig_Pause(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Pause;
+  }
+
+  bool readConfig_Enable_AI0_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AI0_Low;
+  }
+
+  bool readConfig_Enable_AI0_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AI0_High;
+  }
+
+  bool readConfig_Enable_AIAveraged0_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AIAveraged0_Low;
+  }
+
+  bool readConfig_Enable_AIAveraged0_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AIAveraged0_High;
+  }
+
+  bool readConfig_Enable_AI1_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AI1_Low;
+  }
+
+  bool readConfig_Enable_AI1_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AI1_High;
+  }
+
+  bool readConfig_Enable_AIAveraged1_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AIAveraged1_Low;
+  }
+
+  bool readConfig_Enable_AIAveraged1_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AIAveraged1_High;
+  }
+
+  bool readConfig_Enable_Accumulator0(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_Accumulator0;
+  }
+
+  bool readConfig_Enable_Accumulator1(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_Accumulator1;
+  }
+
+  bool readConfig_Enable_DI(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_DI;
+  }
+
+  bool readConfig_Enable_AnalogTriggers(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_AnalogTriggers;
+  }
+
+  bool readConfig_Enable_Counters_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_Counters_Low;
+  }
+
+  bool readConfig_Enable_Counters_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_Counters_High;
+  }
+
+  bool readConfig_Enable_CounterTimers_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_CounterTimers_Low;
+  }
+
+  bool readConfig_Enable_CounterTimers_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_CounterTimers_High;
+  }
+
+  bool readConfig_Enable_Encoders_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_Encoders_Low;
+  }
+
+  bool readConfig_Enable_Encoders_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_Encoders_High;
+  }
+
+  bool readConfig_Enable_EncoderTimers_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_EncoderTimers_Low;
+  }
+
+  bool readConfig_Enable_EncoderTimers_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enable_EncoderTimers_High;
+  }
+
+  bool readConfig_ExternalClock(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.ExternalClock;
+  }
+
+  void writeExternalTriggers(unsigned char reg_index, unsigned char bitfield_index, tExternalTriggers value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ExternalTriggers = value;
+  }
+
+  void writeExternalTriggers_ExternalClockSource_Channel(unsigned char reg_index, unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ExternalTriggers.ExternalClockSource_Channel = value;
+  }
+
+  void writeExternalTriggers_ExternalClockSource_Module(unsigned char reg_index, unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ExternalTriggers.ExternalClockSource_Module = value;
+  }
+
+  void writeExternalTriggers_ExternalClockSource_AnalogTrigger(unsigned char reg_index, unsigned char bitfield_index, bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ExternalTriggers.ExternalClockSource_AnalogTrigger = value;
+  }
+
+  void writeExternalTriggers_RisingEdge(unsigned char reg_index, unsigned char bitfield_index, bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ExternalTriggers.RisingEdge = value;
+  }
+
+  void writeExternalTriggers_FallingEdge(unsigned char reg_index, unsigned char bitfield_index, bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ExternalTriggers.FallingEdge = value;
+  }
+
+  tExternalTriggers readExternalTriggers(unsigned char reg_index, unsigned char bitfield_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ExternalTriggers;
+  }
+
+  unsigned char readExternalTriggers_ExternalClockSource_Channel(unsigned char reg_index, unsigned char bitfield_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ExternalTriggers.ExternalClockSource_Channel;
+  }
+
+  unsigned char readExternalTriggers_ExternalClockSource_Module(unsigned char reg_index, unsigned char bitfield_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ExternalTriggers.ExternalClockSource_Module;
+  }
+
+  bool readExternalTriggers_ExternalClockSource_AnalogTrigger(unsigned char reg_index, unsigned char bitfield_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ExternalTriggers.ExternalClockSource_AnalogTrigger;
+  }
+
+  bool readExternalTriggers_RisingEdge(unsigned char reg_index, unsigned char bitfield_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ExternalTriggers.RisingEdge;
+  }
+
+  bool readExternalTriggers_FallingEdge(unsigned char reg_index, unsigned char bitfield_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ExternalTriggers.FallingEdge;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned int m_Rate{};
+  tConfig m_Config{};
+  tExternalTriggers m_ExternalTriggers{};
+};
+
+class MockEncoder : public tEncoder {
+ public:
+  explicit MockEncoder(unsigned char index) : m_index(index) {}
+
+  unsigned char getSystemIndex() override { return m_index; }
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  tOutput readOutput(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output;
+  }
+
+  bool readOutput_Direction(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output.Direction;
+  }
+
+  signed int readOutput_Value(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Output.Value;
+  }
+
+  void writeConfig(tConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config = value;
+  }
+
+  void writeConfig_ASource_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.ASource_Channel = value;
+  }
+
+  void writeConfig_ASource_Module(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.ASource_Module = value;
+  }
+
+  void writeConfig_ASource_AnalogTrigger(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.ASource_AnalogTrigger = value;
+  }
+
+  void writeConfig_BSource_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.BSource_Channel = value;
+  }
+
+  void writeConfig_BSource_Module(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.BSource_Module = value;
+  }
+
+  void writeConfig_BSource_AnalogTrigger(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.BSource_AnalogTrigger = value;
+  }
+
+  void writeConfig_IndexSource_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexSource_Channel = value;
+  }
+
+  void writeConfig_IndexSource_Module(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexSource_Module = value;
+  }
+
+  void writeConfig_IndexSource_AnalogTrigger(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexSource_AnalogTrigger = value;
+  }
+
+  void writeConfig_IndexActiveHigh(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexActiveHigh = value;
+  }
+
+  void writeConfig_IndexEdgeSensitive(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.IndexEdgeSensitive = value;
+  }
+
+  void writeConfig_Reverse(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Reverse = value;
+  }
+
+  tConfig readConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config;
+  }
+
+  unsigned char readConfig_ASource_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.ASource_Channel;
+  }
+
+  unsigned char readConfig_ASource_Module(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.ASource_Module;
+  }
+
+  bool readConfig_ASource_AnalogTrigger(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.ASource_AnalogTrigger;
+  }
+
+  unsigned char readConfig_BSource_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.BSource_Channel;
+  }
+
+  unsigned char readConfig_BSource_Module(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.BSource_Module;
+  }
+
+  bool readConfig_BSource_AnalogTrigger(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.BSource_AnalogTrigger;
+  }
+
+  unsigned char readConfig_IndexSource_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexSource_Channel;
+  }
+
+  unsigned char readConfig_IndexSource_Module(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexSource_Module;
+  }
+
+  bool readConfig_IndexSource_AnalogTrigger(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexSource_AnalogTrigger;
+  }
+
+  bool readConfig_IndexActiveHigh(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexActiveHigh;
+  }
+
+  bool readConfig_IndexEdgeSensitive(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.IndexEdgeSensitive;
+  }
+
+  bool readConfig_Reverse(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Reverse;
+  }
+
+  tTimerOutput readTimerOutput(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerOutput;
+  }
+
+  unsigned int readTimerOutput_Period(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerOutput.Period;
+  }
+
+  signed char readTimerOutput_Count(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerOutput.Count;
+  }
+
+  bool readTimerOutput_Stalled(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerOutput.Stalled;
+  }
+
+  void strobeReset(tRioStatusCode *status) override {
+    hal::mockfpga::RegisterWrite(m_mutex);
+  }
+
+  void writeTimerConfig(tTimerConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TimerConfig = value;
+  }
+
+  void writeTimerConfig_StallPeriod(unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TimerConfig.StallPeriod = value;
+  }
+
+  void writeTimerConfig_AverageSize(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TimerConfig.AverageSize = value;
+  }
+
+  void writeTimerConfig_UpdateWhenEmpty(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_TimerConfig.UpdateWhenEmpty = value;
+  }
+
+  tTimerConfig readTimerConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerConfig;
+  }
+
+  unsigned int readTimerConfig_StallPeriod(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerConfig.StallPeriod;
+  }
+
+  unsigned char readTimerConfig_AverageSize(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerConfig.AverageSize;
+  }
+
+  bool readTimerConfig_UpdateWhenEmpty(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TimerConfig.UpdateWhenEmpty;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned char m_index;
+  tOutput m_Output{};
+  tConfig m_Config{};
+  tTimerOutput m_TimerOutput{};
+  tTimerConfig m_TimerConfig{};
+};
+
+class MockGlobal : public tGlobal {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeLEDs(tLEDs value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_LEDs = value;
+  }
+
+  void writeLEDs_Comm(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_LEDs.Comm = value;
+  }
+
+  void writeLEDs_Mode(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_LEDs.Mode = value;
+  }
+
+  void writeLEDs_RSL(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_LEDs.RSL = value;
+  }
+
+  tLEDs readLEDs(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LEDs;
+  }
+
+  unsigned char readLEDs_Comm(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LEDs.Comm;
+  }
+
+  unsigned char readLEDs_Mode(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LEDs.Mode;
+  }
+
+  bool readLEDs_RSL(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LEDs.RSL;
+  }
+
+  unsigned int readLocalTimeUpper(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LocalTimeUpper;
+  }
+
+  unsigned short readVersion(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Version;
+  }
+
+  unsigned int readLocalTime(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LocalTime;
+  }
+
+  bool readUserButton(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_UserButton;
+  }
+
+  unsigned int readRevision(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Revision;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  tLEDs m_LEDs{};
+  unsigned int m_LocalTimeUpper{};
+  unsigned short m_Version{};
+  unsigned int m_LocalTime{};
+  bool m_UserButton{};
+  unsigned int m_Revision{};
+};
+
+class MockHMB : public tHMB {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeForceOnce(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ForceOnce = value;
+  }
+
+  bool readForceOnce(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ForceOnce;
+  }
+
+  void writeConfig(tConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config = value;
+  }
+
+  void writeConfig_Enables_AI0_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AI0_Low = value;
+  }
+
+  void writeConfig_Enables_AI0_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AI0_High = value;
+  }
+
+  void writeConfig_Enables_AIAveraged0_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AIAveraged0_Low = value;
+  }
+
+  void writeConfig_Enables_AIAveraged0_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AIAveraged0_High = value;
+  }
+
+  void writeConfig_Enables_AI1_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AI1_Low = value;
+  }
+
+  void writeConfig_Enables_AI1_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AI1_High = value;
+  }
+
+  void writeConfig_Enables_AIAveraged1_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AIAveraged1_Low = value;
+  }
+
+  void writeConfig_Enables_AIAveraged1_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AIAveraged1_High = value;
+  }
+
+  void writeConfig_Enables_Accumulator0(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_Accumulator0 = value;
+  }
+
+  void writeConfig_Enables_Accumulator1(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_Accumulator1 = value;
+  }
+
+  void writeConfig_Enables_DI(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_DI = value;
+  }
+
+  void writeConfig_Enables_AnalogTriggers(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_AnalogTriggers = value;
+  }
+
+  void writeConfig_Enables_Counters_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_Counters_Low = value;
+  }
+
+  void writeConfig_Enables_Counters_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_Counters_High = value;
+  }
+
+  void writeConfig_Enables_CounterTimers_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_CounterTimers_Low = value;
+  }
+
+  void writeConfig_Enables_CounterTimers_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_CounterTimers_High = value;
+  }
+
+  void writeConfig_Enables_Encoders_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_Encoders_Low = value;
+  }
+
+  void writeConfig_Enables_Encoders_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_Encoders_High = value;
+  }
+
+  void writeConfig_Enables_EncoderTimers_Low(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_EncoderTimers_Low = value;
+  }
+
+  void writeConfig_Enables_EncoderTimers_High(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Enables_EncoderTimers_High = value;
+  }
+
+  tConfig readConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config;
+  }
+
+  bool readConfig_Enables_AI0_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AI0_Low;
+  }
+
+  bool readConfig_Enables_AI0_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AI0_High;
+  }
+
+  bool readConfig_Enables_AIAveraged0_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AIAveraged0_Low;
+  }
+
+  bool readConfig_Enables_AIAveraged0_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AIAveraged0_High;
+  }
+
+  bool readConfig_Enables_AI1_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AI1_Low;
+  }
+
+  bool readConfig_Enables_AI1_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AI1_High;
+  }
+
+  bool readConfig_Enables_AIAveraged1_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AIAveraged1_Low;
+  }
+
+  bool readConfig_Enables_AIAveraged1_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AIAveraged1_High;
+  }
+
+  bool readConfig_Enables_Accumulator0(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_Accumulator0;
+  }
+
+  bool readConfig_Enables_Accumulator1(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_Accumulator1;
+  }
+
+  bool readConfig_Enables_DI(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_DI;
+  }
+
+  bool readConfig_Enables_AnalogTriggers(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_AnalogTriggers;
+  }
+
+  bool readConfig_Enables_Counters_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_Counters_Low;
+  }
+
+  bool readConfig_Enables_Counters_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_Counters_High;
+  }
+
+  bool readConfig_Enables_CounterTimers_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_CounterTimers_Low;
+  }
+
+  bool readConfig_Enables_CounterTimers_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_CounterTimers_High;
+  }
+
+  bool readConfig_Enables_Encoders_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_Encoders_Low;
+  }
+
+  bool readConfig_Enables_Encoders_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_Encoders_High;
+  }
+
+  bool readConfig_Enables_EncoderTimers_Low(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_EncoderTimers_Low;
+  }
+
+  bool readConfig_Enables_EncoderTimers_High(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Enables_EncoderTimers_High;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  bool m_ForceOnce{};
+  tConfig m_Config{};
+};
+
+class MockInterrupt : public tInterrupt {
+ public:
+  explicit MockInterrupt(unsigned char index) : m_index(index) {}
+
+  unsigned char getSystemIndex() override { return m_index; }
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  unsigned int readFallingTimeStamp(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FallingTimeStamp;
+  }
+
+  void writeConfig(tConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config = value;
+  }
+
+  void writeConfig_Source_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Source_Channel = value;
+  }
+
+  void writeConfig_Source_Module(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Source_Module = value;
+  }
+
+  void writeConfig_Source_AnalogTrigger(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Source_AnalogTrigger = value;
+  }
+
+  void writeConfig_RisingEdge(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.RisingEdge = value;
+  }
+
+  void writeConfig_FallingEdge(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.FallingEdge = value;
+  }
+
+  void writeConfig_WaitForAck(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.WaitForAck = value;
+  }
+
+  tConfig readConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config;
+  }
+
+  unsigned char readConfig_Source_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Source_Channel;
+  }
+
+  unsigned char readConfig_Source_Module(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Source_Module;
+  }
+
+  bool readConfig_Source_AnalogTrigger(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Source_AnalogTrigger;
+  }
+
+  bool readConfig_RisingEdge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.RisingEdge;
+  }
+
+  bool readConfig_FallingEdge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.FallingEdge;
+  }
+
+  bool readConfig_WaitForAck(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.WaitForAck;
+  }
+
+  unsigned int readRisingTimeStamp(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_RisingTimeStamp;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned char m_index;
+  unsigned int m_FallingTimeStamp{};
+  tConfig m_Config{};
+  unsigned int m_RisingTimeStamp{};
+};
+
+class MockPWM : public tPWM {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  unsigned int readCycleStartTime(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_CycleStartTime;
+  }
+
+  void writeConfig(tConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config = value;
+  }
+
+  void writeConfig_Period(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.Period = value;
+  }
+
+  void writeConfig_MinHigh(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Config.MinHigh = value;
+  }
+
+  tConfig readConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config;
+  }
+
+  unsigned short readConfig_Period(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.Period;
+  }
+
+  unsigned short readConfig_MinHigh(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Config.MinHigh;
+  }
+
+  unsigned int readCycleStartTimeUpper(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_CycleStartTimeUpper;
+  }
+
+  unsigned short readLoopTiming(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_LoopTiming;
+  }
+
+  void writePeriodScaleMXP(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 10) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_PeriodScaleMXP[bitfield_index] = value;
+  }
+
+  unsigned char readPeriodScaleMXP(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 10) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_PeriodScaleMXP[bitfield_index];
+  }
+
+  void writePeriodScaleHdr(unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    if (bitfield_index >= 10) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_PeriodScaleHdr[bitfield_index] = value;
+  }
+
+  unsigned char readPeriodScaleHdr(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 10) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_PeriodScaleHdr[bitfield_index];
+  }
+
+  void writeZeroLatch(unsigned char bitfield_index, bool value, tRioStatusCode *status) override {
+    if (bitfield_index >= 20) {
+      *status = NiFpga_Status_InvalidParameter;
+      return;
+    }
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ZeroLatch[bitfield_index] = value;
+  }
+
+  bool readZeroLatch(unsigned char bitfield_index, tRioStatusCode *status) override {
+    if (bitfield_index >= 20) {
+      *status = NiFpga_Status_InvalidParameter;
+      return {};
+    }
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ZeroLatch[bitfield_index];
+  }
+
+  void writeHdr(unsigned char reg_index, unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Hdr = value;
+  }
+
+  unsigned short readHdr(unsigned char reg_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Hdr;
+  }
+
+  void writeMXP(unsigned char reg_index, unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_MXP = value;
+  }
+
+  unsigned short readMXP(unsigned char reg_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_MXP;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned int m_CycleStartTime{};
+  tConfig m_Config{};
+  unsigned int m_CycleStartTimeUpper{};
+  unsigned short m_LoopTiming{40};
+  unsigned char m_PeriodScaleMXP[10]{};
+  unsigned char m_PeriodScaleHdr[10]{};
+  bool m_ZeroLatch[20]{};
+  unsigned short m_Hdr{};
+  unsigned short m_MXP{};
+};
+
+class MockPower : public tPower {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  unsigned short readUserVoltage3V3(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_UserVoltage3V3;
+  }
+
+  tStatus readStatus(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status;
+  }
+
+  unsigned char readStatus_User3V3(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status.User3V3;
+  }
+
+  unsigned char readStatus_User5V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status.User5V;
+  }
+
+  unsigned char readStatus_User6V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status.User6V;
+  }
+
+  unsigned short readUserVoltage6V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_UserVoltage6V;
+  }
+
+  unsigned short readOnChipTemperature(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_OnChipTemperature;
+  }
+
+  unsigned short readUserVoltage5V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_UserVoltage5V;
+  }
+
+  void strobeResetFaultCounts(tRioStatusCode *status) override {
+    hal::mockfpga::RegisterWrite(m_mutex);
+  }
+
+  unsigned short readIntegratedIO(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_IntegratedIO;
+  }
+
+  unsigned short readMXP_DIOVoltage(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_MXP_DIOVoltage;
+  }
+
+  unsigned short readUserCurrent3V3(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_UserCurrent3V3;
+  }
+
+  unsigned short readVinVoltage(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_VinVoltage;
+  }
+
+  unsigned short readUserCurrent6V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_UserCurrent6V;
+  }
+
+  unsigned short readUserCurrent5V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_UserCurrent5V;
+  }
+
+  unsigned short readAOVoltage(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AOVoltage;
+  }
+
+  tFaultCounts readFaultCounts(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FaultCounts;
+  }
+
+  unsigned char readFaultCounts_OverCurrentFaultCount3V3(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FaultCounts.OverCurrentFaultCount3V3;
+  }
+
+  unsigned char readFaultCounts_OverCurrentFaultCount5V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FaultCounts.OverCurrentFaultCount5V;
+  }
+
+  unsigned char readFaultCounts_OverCurrentFaultCount6V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FaultCounts.OverCurrentFaultCount6V;
+  }
+
+  unsigned char readFaultCounts_UnderVoltageFaultCount5V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_FaultCounts.UnderVoltageFaultCount5V;
+  }
+
+  unsigned short readVinCurrent(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_VinCurrent;
+  }
+
+  void writeDisable(tDisable value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Disable = value;
+  }
+
+  void writeDisable_User3V3(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Disable.User3V3 = value;
+  }
+
+  void writeDisable_User5V(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Disable.User5V = value;
+  }
+
+  void writeDisable_User6V(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Disable.User6V = value;
+  }
+
+  tDisable readDisable(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Disable;
+  }
+
+  bool readDisable_User3V3(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Disable.User3V3;
+  }
+
+  bool readDisable_User5V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Disable.User5V;
+  }
+
+  bool readDisable_User6V(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Disable.User6V;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned short m_UserVoltage3V3{};
+  tStatus m_Status{};
+  unsigned short m_UserVoltage6V{};
+  unsigned short m_OnChipTemperature{};
+  unsigned short m_UserVoltage5V{};
+  unsigned short m_IntegratedIO{};
+  unsigned short m_MXP_DIOVoltage{};
+  unsigned short m_UserCurrent3V3{};
+  unsigned short m_VinVoltage{};
+  unsigned short m_UserCurrent6V{};
+  unsigned short m_UserCurrent5V{};
+  unsigned short m_AOVoltage{};
+  tFaultCounts m_FaultCounts{};
+  unsigned short m_VinCurrent{};
+  tDisable m_Disable{};
+};
+
+class MockRelay : public tRelay {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  void writeValue(tValue value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Value = value;
+  }
+
+  void writeValue_Forward(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Value.Forward = value;
+  }
+
+  void writeValue_Reverse(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Value.Reverse = value;
+  }
+
+  tValue readValue(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Value;
+  }
+
+  unsigned char readValue_Forward(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Value.Forward;
+  }
+
+  unsigned char readValue_Reverse(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Value.Reverse;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  tValue m_Value{};
+};
+
+class MockSPI : public tSPI {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  unsigned int readDebugIntStatReadCount(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DebugIntStatReadCount;
+  }
+
+  unsigned short readDebugState(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DebugState;
+  }
+
+  void writeAutoTriggerConfig(tAutoTriggerConfig value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoTriggerConfig = value;
+  }
+
+  void writeAutoTriggerConfig_ExternalClockSource_Channel(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoTriggerConfig.ExternalClockSource_Channel = value;
+  }
+
+  void writeAutoTriggerConfig_ExternalClockSource_Module(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoTriggerConfig.ExternalClockSource_Module = value;
+  }
+
+  void writeAutoTriggerConfig_ExternalClockSource_AnalogTrigger(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoTriggerConfig.ExternalClockSource_AnalogTrigger = value;
+  }
+
+  void writeAutoTriggerConfig_RisingEdge(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoTriggerConfig.RisingEdge = value;
+  }
+
+  void writeAutoTriggerConfig_FallingEdge(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoTriggerConfig.FallingEdge = value;
+  }
+
+  void writeAutoTriggerConfig_ExternalClock(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoTriggerConfig.ExternalClock = value;
+  }
+
+  tAutoTriggerConfig readAutoTriggerConfig(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoTriggerConfig;
+  }
+
+  unsigned char readAutoTriggerConfig_ExternalClockSource_Channel(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoTriggerConfig.ExternalClockSource_Channel;
+  }
+
+  unsigned char readAutoTriggerConfig_ExternalClockSource_Module(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoTriggerConfig.ExternalClockSource_Module;
+  }
+
+  bool readAutoTriggerConfig_ExternalClockSource_AnalogTrigger(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoTriggerConfig.ExternalClockSource_AnalogTrigger;
+  }
+
+  bool readAutoTriggerConfig_RisingEdge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoTriggerConfig.RisingEdge;
+  }
+
+  bool readAutoTriggerConfig_FallingEdge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoTriggerConfig.FallingEdge;
+  }
+
+  bool readAutoTriggerConfig_ExternalClock(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoTriggerConfig.ExternalClock;
+  }
+
+  void writeAutoChipSelect(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoChipSelect = value;
+  }
+
+  unsigned char readAutoChipSelect(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoChipSelect;
+  }
+
+  unsigned int readDebugRevision(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DebugRevision;
+  }
+
+  unsigned int readTransferSkippedFullCount(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_TransferSkippedFullCount;
+  }
+
+  void writeAutoByteCount(tAutoByteCount value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoByteCount = value;
+  }
+
+  void writeAutoByteCount_TxByteCount(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoByteCount.TxByteCount = value;
+  }
+
+  void writeAutoByteCount_ZeroByteCount(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoByteCount.ZeroByteCount = value;
+  }
+
+  tAutoByteCount readAutoByteCount(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoByteCount;
+  }
+
+  unsigned char readAutoByteCount_TxByteCount(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoByteCount.TxByteCount;
+  }
+
+  unsigned char readAutoByteCount_ZeroByteCount(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoByteCount.ZeroByteCount;
+  }
+
+  unsigned int readDebugIntStat(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DebugIntStat;
+  }
+
+  unsigned int readDebugEnabled(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DebugEnabled;
+  }
+
+  void writeAutoSPI1Select(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoSPI1Select = value;
+  }
+
+  bool readAutoSPI1Select(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoSPI1Select;
+  }
+
+  unsigned char readDebugSubstate(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_DebugSubstate;
+  }
+
+  void writeAutoRate(unsigned int value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoRate = value;
+  }
+
+  unsigned int readAutoRate(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoRate;
+  }
+
+  void writeEnableDIO(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_EnableDIO = value;
+  }
+
+  unsigned char readEnableDIO(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_EnableDIO;
+  }
+
+  void writeChipSelectActiveHigh(tChipSelectActiveHigh value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ChipSelectActiveHigh = value;
+  }
+
+  void writeChipSelectActiveHigh_Hdr(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ChipSelectActiveHigh.Hdr = value;
+  }
+
+  void writeChipSelectActiveHigh_MXP(unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_ChipSelectActiveHigh.MXP = value;
+  }
+
+  tChipSelectActiveHigh readChipSelectActiveHigh(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ChipSelectActiveHigh;
+  }
+
+  unsigned char readChipSelectActiveHigh_Hdr(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ChipSelectActiveHigh.Hdr;
+  }
+
+  unsigned char readChipSelectActiveHigh_MXP(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ChipSelectActiveHigh.MXP;
+  }
+
+  void strobeAutoForceOne(tRioStatusCode *status) override {
+    hal::mockfpga::RegisterWrite(m_mutex);
+  }
+
+  void writeAutoTx(unsigned char reg_index, unsigned char bitfield_index, unsigned char value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_AutoTx = value;
+  }
+
+  unsigned char readAutoTx(unsigned char reg_index, unsigned char bitfield_index, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_AutoTx;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  unsigned int m_DebugIntStatReadCount{};
+  unsigned short m_DebugState{};
+  tAutoTriggerConfig m_AutoTriggerConfig{};
+  unsigned char m_AutoChipSelect{};
+  unsigned int m_DebugRevision{};
+  unsigned int m_TransferSkippedFullCount{};
+  tAutoByteCount m_AutoByteCount{};
+  unsigned int m_DebugIntStat{};
+  unsigned int m_DebugEnabled{};
+  bool m_AutoSPI1Select{};
+  unsigned char m_DebugSubstate{};
+  unsigned int m_AutoRate{};
+  unsigned char m_EnableDIO{};
+  tChipSelectActiveHigh m_ChipSelectActiveHigh{};
+  unsigned char m_AutoTx{};
+};
+
+class MockSysWatchdog : public tSysWatchdog {
+ public:
+  tSystemInterface* getSystemInterface() override {
+    return hal::mockfpga::GetSystemInterface();
+  }
+
+  tStatus readStatus(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status;
+  }
+
+  bool readStatus_SystemActive(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status.SystemActive;
+  }
+
+  bool readStatus_PowerAlive(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status.PowerAlive;
+  }
+
+  unsigned short readStatus_SysDisableCount(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status.SysDisableCount;
+  }
+
+  unsigned short readStatus_PowerDisableCount(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Status.PowerDisableCount;
+  }
+
+  void writeCommand(unsigned short value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Command = value;
+  }
+
+  unsigned short readCommand(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Command;
+  }
+
+  unsigned char readChallenge(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Challenge;
+  }
+
+  void writeActive(bool value, tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterWrite(m_mutex);
+    m_Active = value;
+  }
+
+  bool readActive(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Active;
+  }
+
+  unsigned int readTimer(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_Timer;
+  }
+
+  unsigned short readForcedKills(tRioStatusCode *status) override {
+    auto lock = hal::mockfpga::RegisterRead(m_mutex);
+    return m_ForcedKills;
+  }
+
+ protected:
+  wpi::mutex m_mutex;
+  tStatus m_Status{};
+  unsigned short m_Command{};
+  unsigned char m_Challenge{};
+  bool m_Active{};
+  unsigned int m_Timer{};
+  unsigned short m_ForcedKills{};
+};
+
+}  // namespace mockfpga
+}  // namespace hal
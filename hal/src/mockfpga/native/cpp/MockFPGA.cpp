@@ -0,0 +1,431 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "MockFPGA/MockFPGA.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+
+#include <support/condition_variable.h>
+
+#include "MockChipObjects.h"
+#include "MockFPGAInternal.h"
+
+using namespace hal::mockfpga;
+
+// The interrupt the alarm asserts when it expires
+static constexpr uint32_t kAlarmInterrupt = 28;
+
+// The depth reported for every DMA channel, in words
+static constexpr uint32_t kDMADepth = 1024 * 16;
+
+static int32_t GetEnvLatency(const char* name) {
+  const char* value = std::getenv(name);
+  return value ? std::atoi(value) : 0;
+}
+
+static std::atomic<int32_t> readLatency{
+    GetEnvLatency("HALMOCK_READ_LATENCY_NS")};
+static std::atomic<int32_t> writeLatency{
+    GetEnvLatency("HALMOCK_WRITE_LATENCY_NS")};
+static std::atomic<int32_t> interruptLatency{
+    GetEnvLatency("HALMOCK_INTERRUPT_LATENCY_NS")};
+
+static std::atomic<int64_t> readCount{0};
+static std::atomic<int64_t> writeCount{0};
+
+static const auto startTime = std::chrono::steady_clock::now();
+
+// Busy waits like a blocked bus access would, so the time shows up as CPU time
+// of the calling thread in a profile
+static void Spin(int32_t nanoseconds) {
+  if (nanoseconds <= 0) return;
+  auto end =
+      std::chrono::steady_clock::now() + std::chrono::nanoseconds(nanoseconds);
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+std::unique_lock<wpi::mutex> hal::mockfpga::RegisterRead(wpi::mutex& mutex) {
+  std::unique_lock<wpi::mutex> lock(mutex);
+  readCount.fetch_add(1, std::memory_order_relaxed);
+  Spin(readLatency.load(std::memory_order_relaxed));
+  return lock;
+}
+
+std::unique_lock<wpi::mutex> hal::mockfpga::RegisterWrite(wpi::mutex& mutex) {
+  std::unique_lock<wpi::mutex> lock(mutex);
+  writeCount.fetch_add(1, std::memory_order_relaxed);
+  Spin(writeLatency.load(std::memory_order_relaxed));
+  return lock;
+}
+
+uint64_t hal::mockfpga::GetFPGATime() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - startTime)
+      .count();
+}
+
+// tSystemInterface returns const values
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wignored-qualifiers"
+
+namespace {
+class MockSystemInterface : public nFPGA::tSystemInterface {
+ public:
+  const uint16_t getExpectedFPGAVersion() override { return 2018; }
+  const uint32_t getExpectedFPGARevision() override { return 0; }
+  const uint32_t* const getExpectedFPGASignature() override {
+    return m_signature;
+  }
+  void getHardwareFpgaSignature(uint32_t* guid_ptr,
+                                tRioStatusCode* status) override {
+    std::memcpy(guid_ptr, m_signature, sizeof(m_signature));
+  }
+  uint32_t getLVHandle(tRioStatusCode* status) override { return 0; }
+  uint32_t getHandle() override { return 0; }
+  void reset(tRioStatusCode* status) override {}
+  void getDmaDescriptor(int dmaChannelDescriptorIndex,
+                        tDMAChannelDescriptor* desc) override {
+    desc->channel = dmaChannelDescriptorIndex;
+    desc->baseAddress = 0;
+    desc->depth = kDMADepth;
+    desc->targetToHost = true;
+  }
+
+ private:
+  uint32_t m_signature[4] = {0, 0, 0, 0};
+};
+}  // namespace
+
+#pragma GCC diagnostic pop
+
+nFPGA::tSystemInterface* hal::mockfpga::GetSystemInterface() {
+  static MockSystemInterface systemInterface;
+  return &systemInterface;
+}
+
+// Interrupts are latched until an interrupt manager watching them takes them
+static wpi::mutex interruptMutex;
+static wpi::condition_variable interruptCond;
+static uint32_t pendingInterrupts = 0;
+
+static void AssertInterrupts(uint32_t mask) {
+  {
+    std::lock_guard<wpi::mutex> lock(interruptMutex);
+    pendingInterrupts |= mask;
+  }
+  interruptCond.notify_all();
+}
+
+// Waits for any of the interrupts in mask, then clears and returns the ones
+// asserted. Returns 0 if the timeout passes or stop is set first.
+static uint32_t WaitForInterrupts(uint32_t mask, int32_t timeoutMs,
+                                  const std::atomic<bool>& stop) {
+  std::unique_lock<wpi::mutex> lock(interruptMutex);
+  auto ready = [&] { return (pendingInterrupts & mask) != 0 || stop; };
+  if (timeoutMs < 0) {
+    interruptCond.wait(lock, ready);
+  } else if (!interruptCond.wait_for(
+                 lock, std::chrono::milliseconds(timeoutMs), ready)) {
+    return 0;
+  }
+  uint32_t asserted = pendingInterrupts & mask;
+  pendingInterrupts &= ~asserted;
+  return asserted;
+}
+
+namespace {
+// The alarm asserts its interrupt once the lower 32 bits of the FPGA time
+// reach the trigger time while it is enabled, then disables itself
+class MockAlarmImpl : public MockAlarm {
+ public:
+  MockAlarmImpl() : m_thread([=] { Run(); }) {}
+
+  ~MockAlarmImpl() override {
+    {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  void writeEnable(bool value, tRioStatusCode* status) override {
+    MockAlarm::writeEnable(value, status);
+    m_cond.notify_all();
+  }
+
+  void writeTriggerTime(unsigned int value, tRioStatusCode* status) override {
+    MockAlarm::writeTriggerTime(value, status);
+    m_cond.notify_all();
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<wpi::mutex> lock(m_mutex);
+    while (!m_stop) {
+      if (!m_Enable) {
+        m_cond.wait(lock);
+        continue;
+      }
+      int32_t remaining = static_cast<int32_t>(
+          m_TriggerTime - static_cast<uint32_t>(GetFPGATime()));
+      if (remaining > 0) {
+        m_cond.wait_for(lock, std::chrono::microseconds(remaining));
+        continue;
+      }
+      m_Enable = false;
+      lock.unlock();
+      AssertInterrupts(1u << kAlarmInterrupt);
+      lock.lock();
+    }
+  }
+
+  wpi::condition_variable m_cond;
+  bool m_stop = false;
+  std::thread m_thread;
+};
+
+// The FPGA clock counts microseconds from when the mock FPGA started
+class MockGlobalImpl : public MockGlobal {
+ public:
+  unsigned int readLocalTime(tRioStatusCode* status) override {
+    auto lock = RegisterRead(m_mutex);
+    return static_cast<uint32_t>(GetFPGATime());
+  }
+
+  unsigned int readLocalTimeUpper(tRioStatusCode* status) override {
+    auto lock = RegisterRead(m_mutex);
+    return static_cast<uint32_t>(GetFPGATime() >> 32);
+  }
+
+  unsigned short readVersion(tRioStatusCode* status) override {
+    auto lock = RegisterRead(m_mutex);
+    return GetSystemInterface()->getExpectedFPGAVersion();
+  }
+
+  unsigned int readRevision(tRioStatusCode* status) override {
+    auto lock = RegisterRead(m_mutex);
+    return GetSystemInterface()->getExpectedFPGARevision();
+  }
+};
+}  // namespace
+
+namespace nFPGA {
+namespace nRoboRIO_FPGANamespace {
+
+unsigned int g_currentTargetClass;
+
+tAlarm* tAlarm::create(tRioStatusCode* status) { return new MockAlarmImpl; }
+
+tGlobal* tGlobal::create(tRioStatusCode* status) { return new MockGlobalImpl; }
+
+}  // namespace nRoboRIO_FPGANamespace
+
+tSystem::tSystem(tRioStatusCode* status) {}
+
+tSystem::~tSystem() {}
+
+void tSystem::getFpgaGuid(uint32_t* guid_ptr, tRioStatusCode* status) {
+  GetSystemInterface()->getHardwareFpgaSignature(guid_ptr, status);
+}
+
+void tSystem::reset(tRioStatusCode* status) {}
+
+// The thread calling a registered handler, with a stop flag it shares so the
+// handler itself can disable the interrupt
+class tInterruptManager::tInterruptThread {
+ public:
+  std::thread thread;
+  std::shared_ptr<std::atomic<bool>> stop =
+      std::make_shared<std::atomic<bool>>(false);
+};
+
+tInterruptManager::tInterruptManager(uint32_t interruptMask, bool watcher,
+                                     tRioStatusCode* status)
+    : tSystem(status),
+      _handler(nullptr),
+      _interruptMask(interruptMask),
+      _thread(nullptr),
+      _rioContext(nullptr),
+      _watcher(watcher),
+      _enabled(false),
+      _userParam(nullptr) {}
+
+tInterruptManager::~tInterruptManager() {
+  tRioStatusCode status = 0;
+  disable(&status);
+}
+
+void tInterruptManager::registerHandler(tInterruptHandler handler, void* param,
+                                        tRioStatusCode* status) {
+  _handler = handler;
+  _userParam = param;
+}
+
+uint32_t tInterruptManager::watch(int32_t timeoutInMs, bool ignorePrevious,
+                                  tRioStatusCode* status) {
+  if (ignorePrevious) {
+    std::lock_guard<wpi::mutex> lock(interruptMutex);
+    pendingInterrupts &= ~_interruptMask;
+  }
+  static const std::atomic<bool> never{false};
+  uint32_t asserted = WaitForInterrupts(_interruptMask, timeoutInMs, never);
+  if (asserted == 0) {
+    if (*status == 0) *status = -NiFpga_Status_IrqTimeout;
+    return 0;
+  }
+  Spin(interruptLatency.load(std::memory_order_relaxed));
+  return asserted;
+}
+
+void tInterruptManager::enable(tRioStatusCode* status) {
+  if (_enabled) return;
+  _enabled = true;
+  if (_watcher || !_handler) return;
+
+  _thread = new tInterruptThread;
+  auto stop = _thread->stop;
+  _thread->thread = std::thread([=] {
+    for (;;) {
+      uint32_t asserted = WaitForInterrupts(_interruptMask, -1, *stop);
+      if (asserted == 0) break;
+      Spin(interruptLatency.load(std::memory_order_relaxed));
+      _handler(asserted, _userParam);
+    }
+  });
+}
+
+void tInterruptManager::disable(tRioStatusCode* status) {
+  _enabled = false;
+  if (!_thread) return;
+  {
+    std::lock_guard<wpi::mutex> lock(interruptMutex);
+    *_thread->stop = true;
+  }
+  interruptCond.notify_all();
+  if (_thread->thread.get_id() == std::this_thread::get_id()) {
+    _thread->thread.detach();
+  } else {
+    _thread->thread.join();
+  }
+  delete _thread;
+  _thread = nullptr;
+}
+
+bool tInterruptManager::isEnabled(tRioStatusCode* status) { return _enabled; }
+
+}  // namespace nFPGA
+
+// Words queued on each DMA channel for the FPGA to "transfer"
+static wpi::mutex dmaMutex;
+static wpi::condition_variable dmaCond;
+static std::map<uint32_t, std::deque<uint32_t>> dmaQueues;
+
+namespace nFPGA {
+
+tDMAManager::tDMAManager(uint32_t dmaChannel, uint32_t hostBufferSize,
+                         tRioStatusCode* status)
+    : tSystem(status),
+      _started(false),
+      _dmaChannel(dmaChannel),
+      _hostBufferSize(hostBufferSize) {}
+
+tDMAManager::~tDMAManager() {
+  tRioStatusCode status = 0;
+  stop(&status);
+}
+
+void tDMAManager::start(tRioStatusCode* status) {
+  std::lock_guard<wpi::mutex> lock(dmaMutex);
+  dmaQueues[_dmaChannel].clear();
+  _started = true;
+}
+
+void tDMAManager::stop(tRioStatusCode* status) {
+  std::lock_guard<wpi::mutex> lock(dmaMutex);
+  _started = false;
+}
+
+void tDMAManager::read(uint32_t* buf, size_t num, uint32_t timeout,
+                       size_t* remaining, tRioStatusCode* status) {
+  std::unique_lock<wpi::mutex> lock(dmaMutex);
+  auto& queue = dmaQueues[_dmaChannel];
+  if (!dmaCond.wait_for(lock, std::chrono::milliseconds(timeout),
+                        [&] { return queue.size() >= num; })) {
+    *remaining = queue.size();
+    *status = NiFpga_Status_FifoTimeout;
+    return;
+  }
+  std::copy(queue.begin(), queue.begin() + num, buf);
+  queue.erase(queue.begin(), queue.begin() + num);
+  *remaining = queue.size();
+}
+
+void tDMAManager::write(uint32_t* buf, size_t num, uint32_t timeout,
+                        size_t* remaining, tRioStatusCode* status) {
+  // The roboRIO DMA channels only transfer from the FPGA to the host
+  *status = NiFpga_Status_InvalidParameter;
+}
+
+void tDMAManager::read(uint8_t* buf, size_t num, uint32_t timeout,
+                       size_t* remaining, tRioStatusCode* status) {
+  // The roboRIO DMA FIFOs are all 32 bits wide
+  *status = NiFpga_Status_InvalidParameter;
+}
+
+void tDMAManager::write(uint8_t* buf, size_t num, uint32_t timeout,
+                        size_t* remaining, tRioStatusCode* status) {
+  *status = NiFpga_Status_InvalidParameter;
+}
+
+}  // namespace nFPGA
+
+extern "C" {
+
+void HALMOCK_SetRegisterReadLatency(int32_t nanoseconds) {
+  readLatency = nanoseconds;
+}
+
+void HALMOCK_SetRegisterWriteLatency(int32_t nanoseconds) {
+  writeLatency = nanoseconds;
+}
+
+void HALMOCK_SetInterruptLatency(int32_t nanoseconds) {
+  interruptLatency = nanoseconds;
+}
+
+int64_t HALMOCK_GetRegisterReadCount(void) { return readCount; }
+
+int64_t HALMOCK_GetRegisterWriteCount(void) { return writeCount; }
+
+void HALMOCK_ResetRegisterCounts(void) {
+  readCount = 0;
+  writeCount = 0;
+}
+
+void HALMOCK_AssertInterrupts(uint32_t mask) { AssertInterrupts(mask); }
+
+void HALMOCK_PushDMAData(int32_t channel, const uint32_t* data,
+                         int32_t count) {
+  {
+    std::lock_guard<wpi::mutex> lock(dmaMutex);
+    auto& queue = dmaQueues[channel];
+    queue.insert(queue.end(), data, data + count);
+  }
+  dmaCond.notify_all();
+}
+
+}  // extern "C"
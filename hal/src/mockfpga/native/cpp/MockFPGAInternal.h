@@ -0,0 +1,34 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <mutex>
+
+#include <support/mutex.h>
+
+namespace nFPGA {
+class tSystemInterface;
+}  // namespace nFPGA
+
+namespace hal {
+namespace mockfpga {
+
+// Lock a mock ChipObject's registers for one access, spinning for the
+// configured register latency first
+std::unique_lock<wpi::mutex> RegisterRead(wpi::mutex& mutex);
+std::unique_lock<wpi::mutex> RegisterWrite(wpi::mutex& mutex);
+
+nFPGA::tSystemInterface* GetSystemInterface();
+
+// Microseconds since the mock FPGA started
+uint64_t GetFPGATime();
+
+}  // namespace mockfpga
+}  // namespace hal
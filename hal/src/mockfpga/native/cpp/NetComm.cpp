@@ -0,0 +1,214 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+// A NetComm with no driver station attached. New driver station data is still
+// signalled periodically, so the HAL's driver station path runs as it does on
+// a connected robot.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <FRC_NetworkCommunication/AICalibration.h>
+#include <FRC_NetworkCommunication/CANSessionMux.h>
+#include <FRC_NetworkCommunication/FRCComm.h>
+#include <FRC_NetworkCommunication/NetCommRPCProxy_Occur.h>
+#include <support/mutex.h>
+
+#include "HAL/UsageReporting.h"
+#include "MockFPGA/MockFPGA.h"
+
+static constexpr int32_t kLSBWeight = 1220703;
+
+static std::atomic<int32_t> dsPeriod{20};
+static std::atomic<void (*)(uint32_t)> occurFunc{nullptr};
+static std::atomic<uint32_t> occurRef{0};
+
+static void StartDriverStationThread() {
+  static wpi::mutex startMutex;
+  static bool started = false;
+  std::lock_guard<wpi::mutex> lock(startMutex);
+  if (started) return;
+  started = true;
+  std::thread([] {
+    for (;;) {
+      int32_t period = dsPeriod;
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(period > 0 ? period : 100));
+      auto func = occurFunc.load();
+      if (period > 0 && func) func(occurRef);
+    }
+  }).detach();
+}
+
+extern "C" {
+
+void HALMOCK_SetDriverStationPeriod(int32_t milliseconds) {
+  dsPeriod = milliseconds;
+}
+
+int FRC_NetworkCommunication_Reserve(void* instance) { return 0; }
+
+int FRC_NetworkCommunication_sendError(int isError, int32_t errorCode,
+                                       int isLVCode, const char* details,
+                                       const char* location,
+                                       const char* callStack) {
+  return 0;
+}
+
+void setNewDataSem(pthread_cond_t* cond) {}
+
+int setNewDataOccurRef(uint32_t refnum) {
+  occurRef = refnum;
+  StartDriverStationThread();
+  return 0;
+}
+
+void NetCommRPCProxy_SetOccurFuncPointer(void (*Occur)(uint32_t)) {
+  occurFunc = Occur;
+}
+
+int FRC_NetworkCommunication_getControlWord(struct ControlWord_t* controlWord) {
+  std::memset(controlWord, 0, sizeof(*controlWord));
+  return 0;
+}
+
+int FRC_NetworkCommunication_getAllianceStation(
+    enum AllianceStationID_t* allianceStation) {
+  *allianceStation = kAllianceStationID_red1;
+  return 0;
+}
+
+int FRC_NetworkCommunication_getMatchInfo(char* eventName,
+                                          enum MatchType_t* matchType,
+                                          uint16_t* matchNumber,
+                                          uint8_t* replayNumber,
+                                          uint8_t* gameSpecificMessage,
+                                          uint16_t* gameSpecificMessageSize) {
+  eventName[0] = '\0';
+  *matchType = kMatchType_none;
+  *matchNumber = 0;
+  *replayNumber = 0;
+  *gameSpecificMessageSize = 0;
+  return 0;
+}
+
+int FRC_NetworkCommunication_getMatchTime(float* matchTime) {
+  *matchTime = -1;
+  return 0;
+}
+
+int FRC_NetworkCommunication_getJoystickAxes(uint8_t joystickNum,
+                                             struct JoystickAxes_t* axes,
+                                             uint8_t maxAxes) {
+  axes->count = 0;
+  return 0;
+}
+
+int FRC_NetworkCommunication_getJoystickButtons(uint8_t joystickNum,
+                                                uint32_t* buttons,
+                                                uint8_t* count) {
+  *buttons = 0;
+  *count = 0;
+  return 0;
+}
+
+int FRC_NetworkCommunication_getJoystickPOVs(uint8_t joystickNum,
+                                             struct JoystickPOV_t* povs,
+                                             uint8_t maxPOVs) {
+  povs->count = 0;
+  return 0;
+}
+
+int FRC_NetworkCommunication_setJoystickOutputs(uint8_t joystickNum,
+                                                uint32_t hidOutputs,
+                                                uint16_t leftRumble,
+                                                uint16_t rightRumble) {
+  return 0;
+}
+
+int FRC_NetworkCommunication_getJoystickDesc(uint8_t joystickNum,
+                                             uint8_t* isXBox, uint8_t* type,
+                                             char* name, uint8_t* axisCount,
+                                             uint8_t* axisTypes,
+                                             uint8_t* buttonCount,
+                                             uint8_t* povCount) {
+  *isXBox = 0;
+  *type = 0;
+  name[0] = '\0';
+  *axisCount = 0;
+  *buttonCount = 0;
+  *povCount = 0;
+  return 0;
+}
+
+int FRC_NetworkCommunication_observeUserProgramStarting(void) { return 0; }
+void FRC_NetworkCommunication_observeUserProgramDisabled(void) {}
+void FRC_NetworkCommunication_observeUserProgramAutonomous(void) {}
+void FRC_NetworkCommunication_observeUserProgramTeleop(void) {}
+void FRC_NetworkCommunication_observeUserProgramTest(void) {}
+
+uint32_t FRC_NetworkCommunication_nUsageReporting_report(uint8_t resource,
+                                                         uint8_t instanceNumber,
+                                                         uint8_t context,
+                                                         const char* feature) {
+  return 0;
+}
+
+uint32_t FRC_NetworkCommunication_nAICalibration_getLSBWeight(
+    const uint32_t aiSystemIndex, const uint32_t channel, int32_t* status) {
+  return kLSBWeight;
+}
+
+int32_t FRC_NetworkCommunication_nAICalibration_getOffset(
+    const uint32_t aiSystemIndex, const uint32_t channel, int32_t* status) {
+  return 0;
+}
+
+// There is no CAN bus: sends succeed and nothing is ever received
+
+void FRC_NetworkCommunication_CANSessionMux_sendMessage(uint32_t messageID,
+                                                        const uint8_t* data,
+                                                        uint8_t dataSize,
+                                                        int32_t periodMs,
+                                                        int32_t* status) {}
+
+void FRC_NetworkCommunication_CANSessionMux_receiveMessage(
+    uint32_t* messageID, uint32_t messageIDMask, uint8_t* data,
+    uint8_t* dataSize, uint32_t* timeStamp, int32_t* status) {
+  *status = ERR_CANSessionMux_MessageNotFound;
+}
+
+void FRC_NetworkCommunication_CANSessionMux_openStreamSession(
+    uint32_t* sessionHandle, uint32_t messageID, uint32_t messageIDMask,
+    uint32_t maxMessages, int32_t* status) {
+  static std::atomic<uint32_t> nextHandle{1};
+  *sessionHandle = nextHandle++;
+}
+
+void FRC_NetworkCommunication_CANSessionMux_closeStreamSession(
+    uint32_t sessionHandle) {}
+
+void FRC_NetworkCommunication_CANSessionMux_readStreamSession(
+    uint32_t sessionHandle, struct tCANStreamMessage* messages,
+    uint32_t messagesToRead, uint32_t* messagesRead, int32_t* status) {
+  *messagesRead = 0;
+}
+
+void FRC_NetworkCommunication_CANSessionMux_getCANStatus(
+    float* percentBusUtilization, uint32_t* busOffCount, uint32_t* txFullCount,
+    uint32_t* receiveErrorCount, uint32_t* transmitErrorCount,
+    int32_t* status) {
+  *percentBusUtilization = 0;
+  *busOffCount = 0;
+  *txFullCount = 0;
+  *receiveErrorCount = 0;
+  *transmitErrorCount = 0;
+}
+
+}  // extern "C"
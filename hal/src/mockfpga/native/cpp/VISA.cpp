@@ -0,0 +1,59 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+// A VISA with no serial ports, so opening one fails as on a roboRIO with
+// nothing plugged in
+
+#include "visa/visa.h"
+
+extern "C" {
+
+ViStatus _VI_FUNC viOpenDefaultRM(ViPSession vi) {
+  *vi = 0;
+  return VI_SUCCESS;
+}
+
+ViStatus _VI_FUNC viOpen(ViSession sesn, ViRsrc name, ViAccessMode mode,
+                         ViUInt32 timeout, ViPSession vi) {
+  return VI_ERROR_RSRC_NFOUND;
+}
+
+ViStatus _VI_FUNC viClose(ViObject vi) { return VI_SUCCESS; }
+
+ViStatus _VI_FUNC viSetAttribute(ViObject vi, ViAttr attrName,
+                                 ViAttrState attrValue) {
+  return VI_ERROR_RSRC_NFOUND;
+}
+
+ViStatus _VI_FUNC viGetAttribute(ViObject vi, ViAttr attrName,
+                                 void _VI_PTR attrValue) {
+  return VI_ERROR_RSRC_NFOUND;
+}
+
+ViStatus _VI_FUNC viRead(ViSession vi, ViPBuf buf, ViUInt32 cnt,
+                         ViPUInt32 retCnt) {
+  *retCnt = 0;
+  return VI_ERROR_RSRC_NFOUND;
+}
+
+ViStatus _VI_FUNC viWrite(ViSession vi, ViBuf buf, ViUInt32 cnt,
+                          ViPUInt32 retCnt) {
+  *retCnt = 0;
+  return VI_ERROR_RSRC_NFOUND;
+}
+
+ViStatus _VI_FUNC viClear(ViSession vi) { return VI_ERROR_RSRC_NFOUND; }
+
+ViStatus _VI_FUNC viSetBuf(ViSession vi, ViUInt16 mask, ViUInt32 size) {
+  return VI_ERROR_RSRC_NFOUND;
+}
+
+ViStatus _VI_FUNC viFlush(ViSession vi, ViUInt16 mask) {
+  return VI_ERROR_RSRC_NFOUND;
+}
+
+}  // extern "C"
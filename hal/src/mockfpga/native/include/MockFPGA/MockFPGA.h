@@ -0,0 +1,48 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Controls for the mock FPGA the athena HAL is linked against when it is built
+ * for desktop Linux with -PathenaMock.
+ *
+ * Every register access spins for the register latency, and every interrupt
+ * handler or watch() wakes up the interrupt latency after the interrupt is
+ * asserted. The latencies start at 0, or at the nanoseconds given by the
+ * HALMOCK_READ_LATENCY_NS, HALMOCK_WRITE_LATENCY_NS and
+ * HALMOCK_INTERRUPT_LATENCY_NS environment variables, so unmodified programs
+ * can be profiled with roboRIO-like timing.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void HALMOCK_SetRegisterReadLatency(int32_t nanoseconds);
+void HALMOCK_SetRegisterWriteLatency(int32_t nanoseconds);
+void HALMOCK_SetInterruptLatency(int32_t nanoseconds);
+
+int64_t HALMOCK_GetRegisterReadCount(void);
+int64_t HALMOCK_GetRegisterWriteCount(void);
+void HALMOCK_ResetRegisterCounts(void);
+
+// Asserts FPGA interrupts; bit n is interrupt n, as in tInterruptManager masks
+void HALMOCK_AssertInterrupts(uint32_t mask);
+
+// Queues words to be read from a DMA channel, as if the FPGA captured them
+void HALMOCK_PushDMAData(int32_t channel, const uint32_t* data, int32_t count);
+
+// Sets how often NetComm signals new driver station data; 0 stops it. The
+// default is 20 ms, like a connected driver station.
+void HALMOCK_SetDriverStationPeriod(int32_t milliseconds);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
@@ -0,0 +1,58 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "DigitalInternal.h"  // NOLINT(build/include_order)
+
+#include "HAL/cpp/UnsafeDIO.h"  // NOLINT(build/include_order)
+
+#include "HAL/DIO.h"
+#include "HAL/HAL.h"
+#include "MockFPGA/MockFPGA.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(UnsafeDIOTests, ManipulateSetsOutput) {
+  int32_t status = 0;
+  auto handle = HAL_InitializeDIOPort(HAL_GetPort(0), false, &status);
+  ASSERT_EQ(0, status);
+  HAL_SetDIO(handle, false, &status);
+  ASSERT_EQ(0, status);
+
+  bool called = false;
+  UnsafeManipulateDIO(handle, &status, [&](DIOSetProxy& proxy) {
+    called = true;
+    int32_t proxyStatus = 0;
+    proxy.SetOutputTrue(&proxyStatus);
+  });
+  EXPECT_EQ(0, status);
+  EXPECT_TRUE(called);
+
+  uint32_t mask = detail::ComputeDigitalMask(handle, &status);
+  tDIO* dio = detail::UnsafeGetDigialSystem();
+  EXPECT_EQ(mask, dio->readDO(&status).value & mask);
+
+  // The HAL learned the state the functor left, so setting it again doesn't
+  // touch the FPGA
+  HALMOCK_ResetRegisterCounts();
+  HAL_SetDIO(handle, true, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(0, HALMOCK_GetRegisterWriteCount());
+
+  HAL_FreeDIOPort(handle);
+}
+
+TEST(UnsafeDIOTests, ManipulateInvalidHandle) {
+  int32_t status = 0;
+  bool called = false;
+  UnsafeManipulateDIO(HAL_kInvalidHandle, &status,
+                      [&](DIOSetProxy&) { called = true; });
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+  EXPECT_FALSE(called);
+}
+
+}  // namespace hal
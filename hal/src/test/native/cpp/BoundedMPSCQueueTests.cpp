@@ -0,0 +1,71 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <thread>
+#include <vector>
+
+#include "HAL/cpp/BoundedMPSCQueue.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(BoundedMPSCQueueTests, FirstInFirstOut) {
+  BoundedMPSCQueue<int, 4> queue;
+  int value;
+  EXPECT_FALSE(queue.Pop(&value));
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 3; i++) EXPECT_TRUE(queue.Push(round * 10 + i));
+    for (int i = 0; i < 3; i++) {
+      ASSERT_TRUE(queue.Pop(&value));
+      EXPECT_EQ(round * 10 + i, value);
+    }
+    EXPECT_FALSE(queue.Pop(&value));
+  }
+}
+
+TEST(BoundedMPSCQueueTests, Overflow) {
+  BoundedMPSCQueue<int, 4> queue;
+  for (int i = 0; i < 4; i++) EXPECT_TRUE(queue.Push(i));
+  EXPECT_FALSE(queue.Push(4));
+  EXPECT_FALSE(queue.Push(5));
+  EXPECT_EQ(2, queue.GetOverflowCount());
+
+  int value;
+  ASSERT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(0, value);
+  EXPECT_TRUE(queue.Push(6));
+}
+
+TEST(BoundedMPSCQueueTests, ManyWriters) {
+  static constexpr int kWriters = 4;
+  static constexpr int kValues = 20000;
+  BoundedMPSCQueue<int, 64> queue;
+
+  std::vector<std::thread> writers;
+  for (int w = 0; w < kWriters; w++) {
+    writers.emplace_back([&queue, w] {
+      for (int i = 0; i < kValues; i++) {
+        while (!queue.Push(w * kValues + i)) std::this_thread::yield();
+      }
+    });
+  }
+
+  // Each writer's values arrive in the order it wrote them
+  std::vector<int> next(kWriters, 0);
+  int read = 0;
+  while (read < kWriters * kValues) {
+    int value;
+    if (!queue.Pop(&value)) continue;
+    int writer = value / kValues;
+    EXPECT_EQ(next[writer], value % kValues);
+    next[writer] = value % kValues + 1;
+    read++;
+  }
+  for (auto& writer : writers) writer.join();
+}
+
+}  // namespace hal
@@ -0,0 +1,79 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <thread>
+#include <vector>
+
+#include "HAL/cpp/BusStatistics.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+static std::vector<HAL_BusStatistics> GetStatistics() {
+  std::vector<HAL_BusStatistics> statistics(HAL_kBusTypeCount *
+                                            HAL_kBusMaxPorts);
+  statistics.resize(HAL_GetBusStatistics(statistics.data(),
+                                         statistics.size()));
+  return statistics;
+}
+
+TEST(BusStatisticsTests, DisabledRecordsNothing) {
+  HAL_SetBusStatisticsEnabled(false);
+  HAL_ResetBusStatistics();
+  {
+    int32_t status = -1;
+    BusStatisticsScope scope(HAL_kBusI2C, 0, &status);
+  }
+  EXPECT_TRUE(GetStatistics().empty());
+}
+
+TEST(BusStatisticsTests, CountsCallsAndErrorsPerPort) {
+  HAL_SetBusStatisticsEnabled(true);
+  HAL_ResetBusStatistics();
+  {
+    int32_t status = 0;
+    BusStatisticsScope scope(HAL_kBusCAN, 5, &status);
+  }
+  {
+    int32_t status = -44087;
+    BusStatisticsScope scope(HAL_kBusCAN, 5, &status);
+  }
+  std::thread([] {
+    BusStatisticsScope scope(HAL_kBusSPI, 4);
+    EXPECT_EQ(-1, scope.Result(-1));
+  }).join();
+  { BusStatisticsScope scope(HAL_kBusSPI, HAL_kBusMaxPorts); }
+  HAL_SetBusStatisticsEnabled(false);
+
+  auto statistics = GetStatistics();
+  ASSERT_EQ(2u, statistics.size());
+  EXPECT_EQ(HAL_kBusSPI, statistics[0].bus);
+  EXPECT_EQ(4, statistics[0].port);
+  EXPECT_EQ(1u, statistics[0].count);
+  EXPECT_EQ(1u, statistics[0].errors);
+  EXPECT_EQ(HAL_kBusCAN, statistics[1].bus);
+  EXPECT_EQ(5, statistics[1].port);
+  EXPECT_EQ(2u, statistics[1].count);
+  EXPECT_EQ(1u, statistics[1].errors);
+  EXPECT_LE(statistics[1].maxTime, statistics[1].totalTime);
+}
+
+TEST(BusStatisticsTests, ReturnsTotalWhenArrayIsSmall) {
+  HAL_SetBusStatisticsEnabled(true);
+  HAL_ResetBusStatistics();
+  { BusStatisticsScope scope(HAL_kBusPDP, 0); }
+  { BusStatisticsScope scope(HAL_kBusPCM, 0); }
+  HAL_SetBusStatisticsEnabled(false);
+
+  HAL_BusStatistics statistics;
+  EXPECT_EQ(2, HAL_GetBusStatistics(&statistics, 1));
+  EXPECT_EQ(HAL_kBusPCM, statistics.bus);
+  HAL_ResetBusStatistics();
+  EXPECT_TRUE(GetStatistics().empty());
+}
+
+}  // namespace hal
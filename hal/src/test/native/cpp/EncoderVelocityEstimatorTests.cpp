@@ -0,0 +1,63 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <cmath>
+
+#include "HAL/cpp/EncoderVelocityEstimator.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+static constexpr double kPeriod = 0.005;
+
+TEST(EncoderVelocityEstimatorTests, ConstantVelocity) {
+  for (auto type :
+       {HAL_EncoderVelocity_kTimedWindow, HAL_EncoderVelocity_kLeastSquares,
+        HAL_EncoderVelocity_kAdaptiveWindow}) {
+    EncoderVelocityEstimator estimator(type, 16);
+    for (int i = 0; i < 40; i++) estimator.AddSample(i * kPeriod, i * 10);
+    EXPECT_NEAR(2000.0, estimator.GetVelocity(), 1e-6) << type;
+    EXPECT_NEAR(0.0, estimator.GetAcceleration(), 1e-6) << type;
+  }
+}
+
+TEST(EncoderVelocityEstimatorTests, ConstantAcceleration) {
+  EncoderVelocityEstimator estimator(HAL_EncoderVelocity_kLeastSquares, 8);
+  // count = 50000 t^2, so acceleration = 100000
+  for (int i = 0; i < 40; i++) {
+    double t = i * kPeriod;
+    estimator.AddSample(t, std::lround(50000 * t * t));
+  }
+  EXPECT_NEAR(100000.0, estimator.GetAcceleration(), 2000.0);
+}
+
+TEST(EncoderVelocityEstimatorTests, AdaptiveWindowLowSpeed) {
+  // One count every 4 samples: the adaptive window spans several counts
+  // instead of jumping between 0 and a full count per sample.
+  EncoderVelocityEstimator estimator(HAL_EncoderVelocity_kAdaptiveWindow, 32);
+  for (int i = 0; i < 40; i++) estimator.AddSample(i * kPeriod, i / 4);
+  EXPECT_NEAR(50.0, estimator.GetVelocity(), 10.0);
+}
+
+TEST(EncoderVelocityEstimatorTests, Stopped) {
+  EncoderVelocityEstimator estimator(HAL_EncoderVelocity_kTimedWindow, 4);
+  for (int i = 0; i < 10; i++) estimator.AddSample(i * kPeriod, i * 10);
+  for (int i = 10; i < 20; i++) estimator.AddSample(i * kPeriod, 90);
+  EXPECT_EQ(0.0, estimator.GetVelocity());
+}
+
+TEST(EncoderVelocityEstimatorTests, Reset) {
+  EncoderVelocityEstimator estimator(HAL_EncoderVelocity_kTimedWindow, 4);
+  for (int i = 0; i < 10; i++) estimator.AddSample(i * kPeriod, i * 10);
+  estimator.Reset();
+  EXPECT_EQ(0.0, estimator.GetVelocity());
+  // The jump back to 0 after a reset is not seen as motion
+  estimator.AddSample(10 * kPeriod, 0);
+  EXPECT_EQ(0.0, estimator.GetVelocity());
+}
+
+}  // namespace hal
@@ -0,0 +1,60 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/cpp/MemoryPool.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(MemoryPoolTests, ReusesBlocks) {
+  MemoryPool pool(24, 2);
+  void* first = pool.Allocate(24);
+  void* second = pool.Allocate(16);
+  EXPECT_TRUE(pool.Owns(first));
+  EXPECT_TRUE(pool.Owns(second));
+  EXPECT_NE(first, second);
+  EXPECT_EQ(2u, pool.GetUsedCount());
+
+  pool.Deallocate(first);
+  EXPECT_EQ(first, pool.Allocate(24));
+  EXPECT_EQ(0, pool.GetOverflowCount());
+}
+
+TEST(MemoryPoolTests, OverflowFallsBackToHeap) {
+  MemoryPool pool(16, 1);
+  void* block = pool.Allocate(16);
+  // Pool empty, then too large for a block
+  void* full = pool.Allocate(16);
+  void* large = pool.Allocate(pool.GetBlockSize() + 1);
+  EXPECT_FALSE(pool.Owns(full));
+  EXPECT_FALSE(pool.Owns(large));
+  EXPECT_EQ(2, pool.GetOverflowCount());
+
+  pool.Deallocate(full);
+  pool.Deallocate(large);
+  pool.Deallocate(block);
+  EXPECT_EQ(0u, pool.GetUsedCount());
+}
+
+TEST(MemoryPoolTests, MakePooled) {
+  struct Data {
+    explicit Data(int v) : value(v) {}
+    int value;
+    double payload[4];
+  };
+  MemoryPool pool(SharedBlockSize<Data>(), 4);
+  {
+    auto data = MakePooled<Data>(pool, 5);
+    EXPECT_EQ(5, data->value);
+    EXPECT_TRUE(pool.Owns(data.get()));
+    EXPECT_EQ(1u, pool.GetUsedCount());
+  }
+  EXPECT_EQ(0u, pool.GetUsedCount());
+  EXPECT_EQ(0, pool.GetOverflowCount());
+}
+
+}  // namespace hal
@@ -0,0 +1,60 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/Accelerometer.h"
+#include "HAL/HAL.h"
+#include "MockData/AccelerometerData.h"
+#include "MockData/MockHooks.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(AccelerometerSimTests, TestSampler) {
+  HALSIM_ResetAccelerometerData(0);
+  HALSIM_SetAccelerometerX(0, 0.5);
+  HALSIM_SetAccelerometerY(0, -0.25);
+  HALSIM_SetAccelerometerZ(0, 1.0);
+
+  double x, y, z;
+  HAL_GetAccelerometerXYZ(&x, &y, &z);
+  EXPECT_EQ(0.5, x);
+  EXPECT_EQ(-0.25, y);
+  EXPECT_EQ(1.0, z);
+
+  int32_t status = 0;
+  HAL_AccelerometerSample samples[8];
+  HAL_ReadAccelerometerSamples(samples, 8, &status);
+  EXPECT_EQ(INCOMPATIBLE_STATE, status);
+  status = 0;
+  HAL_StartAccelerometerSampler(0, &status);
+  EXPECT_EQ(PARAMETER_OUT_OF_RANGE, status);
+  status = 0;
+
+  HALSIM_PauseTiming();
+  HAL_StartAccelerometerSampler(4, &status);
+  ASSERT_EQ(0, status);
+
+  // samples come at 800 Hz
+  HALSIM_StepTiming(2600);
+  EXPECT_EQ(2, HAL_ReadAccelerometerSamples(samples, 8, &status));
+  EXPECT_EQ(1250u, samples[1].timeStamp - samples[0].timeStamp);
+  EXPECT_EQ(-0.25, samples[0].y);
+  EXPECT_EQ(0, HAL_ReadAccelerometerSamples(samples, 8, &status));
+
+  // 8 samples are due, but only the last 4 are kept
+  HALSIM_StepTiming(10000);
+  EXPECT_EQ(4, HAL_GetAccelerometerSamplerOverflowCount(&status));
+  EXPECT_EQ(4, HAL_ReadAccelerometerSamples(samples, 8, &status));
+  EXPECT_EQ(0, status);
+
+  HAL_StopAccelerometerSampler(&status);
+  HAL_GetAccelerometerSamplerOverflowCount(&status);
+  EXPECT_EQ(INCOMPATIBLE_STATE, status);
+  HALSIM_ResumeTiming();
+}
+
+}  // namespace hal
@@ -0,0 +1,45 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/AnalogGyro.h"
+#include "HAL/AnalogInput.h"
+#include "HAL/HAL.h"
+#include "MockData/AnalogGyroData.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(AnalogGyroSimTests, TestAnalogGyroSnapshot) {
+  int32_t status = 0;
+  HAL_AnalogInputHandle analogHandle =
+      HAL_InitializeAnalogInputPort(HAL_GetPort(0), &status);
+  ASSERT_EQ(0, status);
+  HAL_GyroHandle gyroHandle = HAL_InitializeAnalogGyro(analogHandle, &status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_SetAnalogGyroAngle(0, 90.5);
+  HALSIM_SetAnalogGyroRate(0, -12.0);
+
+  uint64_t before = HAL_GetFPGATime(&status);
+  HAL_AnalogGyroSnapshot snapshot;
+  HAL_GetAnalogGyroSnapshot(gyroHandle, &snapshot, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_DOUBLE_EQ(HAL_GetAnalogGyroAngle(gyroHandle, &status),
+                   snapshot.angle);
+  EXPECT_DOUBLE_EQ(90.5, snapshot.angle);
+  EXPECT_DOUBLE_EQ(-12.0, snapshot.rate);
+  EXPECT_GE(snapshot.timestamp, before);
+  EXPECT_LE(snapshot.timestamp, HAL_GetFPGATime(&status));
+
+  HAL_FreeAnalogGyro(gyroHandle);
+  HAL_FreeAnalogInputPort(analogHandle);
+
+  HAL_GetAnalogGyroSnapshot(gyroHandle, &snapshot, &status);
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+}
+
+}  // namespace hal
@@ -77,4 +77,67 @@ TEST(AnalogInSimTests, TestAnalogInInitialization) {
   EXPECT_EQ(0, status);
   EXPECT_STREQ("Initialized", gTestAnalogInCallbackName.c_str());
 }
+
+TEST(AnalogInSimTests, TestAnalogInVoltages) {
+  hal::HandleBase::ResetGlobalHandles();
+
+  int32_t status = 0;
+  HAL_AnalogInputHandle handles[2];
+  handles[0] = HAL_InitializeAnalogInputPort(HAL_GetPort(2), &status);
+  handles[1] = HAL_InitializeAnalogInputPort(HAL_GetPort(3), &status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_SetAnalogInVoltage(2, 1.5);
+  HALSIM_SetAnalogInVoltage(3, 4.25);
+
+  double voltages[2];
+  HAL_GetAnalogVoltages(handles, voltages, 2, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_DOUBLE_EQ(1.5, voltages[0]);
+  EXPECT_DOUBLE_EQ(4.25, voltages[1]);
+
+  // Invalid handle
+  handles[1] = HAL_kInvalidHandle;
+  HAL_GetAnalogVoltages(handles, voltages, 2, &status);
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+
+  status = 0;
+  HAL_GetAnalogVoltages(handles, voltages, -1, &status);
+  EXPECT_EQ(PARAMETER_OUT_OF_RANGE, status);
+}
+
+TEST(AnalogInSimTests, TestAnalogInValues) {
+  hal::HandleBase::ResetGlobalHandles();
+
+  int32_t status = 0;
+  HAL_AnalogInputHandle handles[2];
+  handles[0] = HAL_InitializeAnalogInputPort(HAL_GetPort(2), &status);
+  handles[1] = HAL_InitializeAnalogInputPort(HAL_GetPort(3), &status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_SetAnalogInVoltage(2, 1.5);
+  HALSIM_SetAnalogInVoltage(3, 4.25);
+
+  int32_t values[2];
+  HAL_GetAnalogValues(handles, values, false, 2, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(HAL_GetAnalogValue(handles[0], &status), values[0]);
+  EXPECT_EQ(HAL_GetAnalogValue(handles[1], &status), values[1]);
+
+  HAL_GetAnalogValues(handles, values, true, 2, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(HAL_GetAnalogAverageValue(handles[1], &status), values[1]);
+
+  // Reads are the same while the mirror runs
+  HAL_StartAnalogMirror(0.001, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_TRUE(HAL_IsAnalogMirrorRunning());
+  HAL_GetAnalogValues(handles, values, false, 2, &status);
+  EXPECT_EQ(HAL_GetAnalogValue(handles[0], &status), values[0]);
+  HAL_StopAnalogMirror(&status);
+  EXPECT_FALSE(HAL_IsAnalogMirrorRunning());
+
+  HAL_StartAnalogMirror(0.0, &status);
+  EXPECT_EQ(PARAMETER_OUT_OF_RANGE, status);
+}
 }  // namespace hal
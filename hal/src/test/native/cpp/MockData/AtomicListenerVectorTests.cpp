@@ -0,0 +1,70 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <memory>
+
+#include "MockData/NotifyListenerVector.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+using Holder = AtomicListenerVector<NotifyListenerVector>;
+
+static void TestCallback(const char* name, void* param,
+                         const HAL_Value* value) {}
+
+static std::shared_ptr<NotifyListenerVector> MakeVector() {
+  unsigned int uid;
+  return std::make_shared<NotifyListenerVector>(nullptr, &TestCallback, &uid);
+}
+
+TEST(AtomicListenerVectorTests, ReplacedVectorIsReleased) {
+  Holder holder;
+  auto first = MakeVector();
+  std::weak_ptr<NotifyListenerVector> weakFirst = first;
+  holder = std::move(first);
+
+  holder = MakeVector();
+  EXPECT_TRUE(weakFirst.expired());
+}
+
+TEST(AtomicListenerVectorTests, ReaderKeepsVectorAlive) {
+  Holder holder;
+  auto first = MakeVector();
+  std::weak_ptr<NotifyListenerVector> weakFirst = first;
+  holder = std::move(first);
+
+  {
+    Holder::Reader reader(holder);
+    ASSERT_TRUE(reader);
+    EXPECT_EQ(weakFirst.lock().get(), reader.get());
+
+    // Replacing or clearing the vector while it is read doesn't free it
+    holder = MakeVector();
+    holder = nullptr;
+    EXPECT_FALSE(weakFirst.expired());
+    EXPECT_EQ(1u, reader->size());
+  }
+
+  // The last reader out releases it
+  EXPECT_TRUE(weakFirst.expired());
+  Holder::Reader reader(holder);
+  EXPECT_FALSE(reader);
+}
+
+TEST(AtomicListenerVectorTests, ReaderSeesLatestVector) {
+  Holder holder;
+  holder = MakeVector();
+  auto second = MakeVector();
+  NotifyListenerVector* secondPtr = second.get();
+  holder = std::move(second);
+
+  Holder::Reader reader(holder);
+  EXPECT_EQ(secondPtr, reader.get());
+}
+
+}  // namespace hal
@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <memory>
+
+#include "HAL/HAL.h"
+#include "HAL/I2C.h"
+#include "HAL/SPI.h"
+#include "MockData/BusDeviceModel.h"
+#include "MockData/I2CData.h"
+#include "MockData/MockHooks.h"
+#include "MockData/SPIData.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+// Counts reads of register 0, which it increments before each read
+class CountingDevice : public RegisterMapDeviceModel {
+ public:
+  CountingDevice() : RegisterMapDeviceModel(64, 0x80, 0x3f) {}
+
+  int writes = 0;
+
+ protected:
+  void OnRead(int32_t address, int32_t count) override {
+    if (address == 0) SetRegister(0, GetRegister(0) + 1);
+  }
+  void OnWrite(int32_t address, int32_t count) override { writes += count; }
+};
+
+TEST(BusDeviceModelTests, I2CRegisterMap) {
+  const HAL_I2CPort port = HAL_I2C_kOnboard;
+  auto device = std::make_shared<RegisterMapDeviceModel>();
+  SetI2CDeviceModel(port, 0x1d, device);
+
+  uint8_t config[] = {0x2d, 0x08, 0x09};
+  HAL_WriteI2C(port, 0x1d, config, sizeof(config));
+  EXPECT_EQ(0x08, device->GetRegister(0x2d));
+  EXPECT_EQ(0x09, device->GetRegister(0x2e));
+
+  const uint8_t data[] = {1, 2, 3, 4, 5, 6};
+  device->SetRegisters(0x32, data, sizeof(data));
+  uint8_t address = 0x32;
+  uint8_t received[6] = {0};
+  HAL_TransactionI2C(port, 0x1d, &address, 1, received, sizeof(received));
+  for (int i = 0; i < 6; i++) EXPECT_EQ(data[i], received[i]);
+
+  // another address doesn't reach the model
+  uint8_t other[] = {0x2d, 0x00};
+  HAL_WriteI2C(port, 0x53, other, sizeof(other));
+  EXPECT_EQ(0x08, device->GetRegister(0x2d));
+
+  HALSIM_ResetI2CData(port);
+  EXPECT_EQ(nullptr, GetI2CDeviceModel(port, 0x1d));
+}
+
+TEST(BusDeviceModelTests, SPIReadFlag) {
+  const HAL_SPIPort port = HAL_SPI_kOnboardCS1;
+  auto device = std::make_shared<CountingDevice>();
+  SetSPIDeviceModel(port, device);
+
+  uint8_t write[] = {0x31, 0x0b};
+  uint8_t received[3] = {0xff, 0xff, 0xff};
+  HAL_TransactionSPI(port, write, received, sizeof(write));
+  EXPECT_EQ(0x0b, device->GetRegister(0x31));
+  EXPECT_EQ(1, device->writes);
+  EXPECT_EQ(0, received[0]);
+
+  uint8_t read[] = {0x80 | 0x31, 0, 0};
+  HAL_TransactionSPI(port, read, received, sizeof(read));
+  EXPECT_EQ(0, received[0]);
+  EXPECT_EQ(0x0b, received[1]);
+  EXPECT_EQ(0, received[2]);
+
+  // a read doesn't write
+  EXPECT_EQ(1, device->writes);
+
+  HALSIM_ResetSPIData(port);
+}
+
+TEST(BusDeviceModelTests, SPIAutoTransfers) {
+  const HAL_SPIPort port = HAL_SPI_kOnboardCS2;
+  auto device = std::make_shared<CountingDevice>();
+  SetSPIDeviceModel(port, device);
+  HALSIM_PauseTiming();
+
+  int32_t status = 0;
+  // room for 4 transfers of 2 bytes
+  HAL_InitSPIAuto(port, 8, &status);
+  uint8_t command = 0x80;
+  HAL_SetSPIAutoTransmitData(port, &command, 1, 1, &status);
+  HAL_StartSPIAutoRate(port, 0.001, &status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_StepTiming(2500);
+  uint8_t buffer[8] = {0};
+  EXPECT_EQ(4, HAL_ReadSPIAutoReceivedData(port, buffer, 0, 0, &status));
+  EXPECT_EQ(0, HAL_ReadSPIAutoReceivedData(port, buffer, 4, 0, &status));
+  EXPECT_EQ(1, buffer[1]);
+  EXPECT_EQ(2, buffer[3]);
+
+  // 10 transfers are due, but only 4 fit
+  HALSIM_StepTiming(10000);
+  EXPECT_EQ(6, HAL_GetSPIAutoDroppedCount(port, &status));
+  EXPECT_EQ(0, HAL_ReadSPIAutoReceivedData(port, buffer, 8, 0, &status));
+  EXPECT_EQ(3, buffer[1]);
+  EXPECT_EQ(6, buffer[7]);
+
+  HAL_ForceSPIAutoRead(port, &status);
+  EXPECT_EQ(2, HAL_ReadSPIAutoReceivedData(port, buffer, 0, 0, &status));
+
+  HAL_StopSPIAuto(port, &status);
+  HAL_FreeSPIAuto(port, &status);
+  EXPECT_EQ(0, status);
+  HALSIM_ResumeTiming();
+  HALSIM_ResetSPIData(port);
+}
+
+}  // namespace hal
@@ -0,0 +1,79 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <string>
+#include <vector>
+
+#include "HAL/HAL.h"
+#include "MockData/ChangeBatch.h"
+#include "MockData/PCMData.h"
+#include "MockData/PWMData.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+struct TestChange {
+  std::string device;
+  int32_t index;
+  int32_t channel;
+  std::string field;
+};
+
+static std::vector<std::vector<TestChange>> gTestBatches;
+
+static void TestChangeBatchCallback(const char* name, void* param,
+                                    const struct HALSIM_Change* changes,
+                                    int32_t count) {
+  std::vector<TestChange> batch;
+  for (int32_t i = 0; i < count; i++) {
+    batch.push_back(TestChange{changes[i].device, changes[i].index,
+                               changes[i].channel, changes[i].field});
+  }
+  gTestBatches.push_back(batch);
+}
+
+TEST(ChangeBatchTests, TestChangesAreCoalesced) {
+  const int INDEX_TO_TEST = 3;
+
+  gTestBatches.clear();
+  int callbackId =
+      HALSIM_RegisterChangeBatchCallback(&TestChangeBatchCallback, nullptr);
+  ASSERT_TRUE(0 != callbackId);
+
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, 0.25);
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, 0.5);
+  HALSIM_SetPCMSolenoidOutput(0, 2, true);
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, 0.5);  // unchanged, not recorded
+  EXPECT_TRUE(gTestBatches.empty());
+
+  HALSIM_FlushChanges();
+  ASSERT_EQ(1u, gTestBatches.size());
+  auto& batch = gTestBatches[0];
+  ASSERT_EQ(2u, batch.size());
+  EXPECT_EQ("PWM", batch[0].device);
+  EXPECT_EQ(INDEX_TO_TEST, batch[0].index);
+  EXPECT_EQ(-1, batch[0].channel);
+  EXPECT_EQ("Speed", batch[0].field);
+  EXPECT_EQ("PCM", batch[1].device);
+  EXPECT_EQ(0, batch[1].index);
+  EXPECT_EQ(2, batch[1].channel);
+  EXPECT_EQ("SolenoidOutput", batch[1].field);
+
+  // Nothing changed since the last flush
+  HALSIM_FlushChanges();
+  EXPECT_EQ(1u, gTestBatches.size());
+
+  HALSIM_CancelChangeBatchCallback(callbackId);
+  HALSIM_SetPWMSpeed(INDEX_TO_TEST, 0.75);
+  HALSIM_FlushChanges();
+  EXPECT_EQ(1u, gTestBatches.size());
+
+  HALSIM_ResetPWMData(INDEX_TO_TEST);
+  HALSIM_ResetPCMData(0);
+}
+
+}  // namespace hal
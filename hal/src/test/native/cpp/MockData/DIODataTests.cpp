@@ -7,8 +7,11 @@
 
 #include "HAL/DIO.h"
 #include "HAL/HAL.h"
+#include "HAL/Interrupts.h"
 #include "HAL/handles/HandlesInternal.h"
 #include "MockData/DIOData.h"
+#include "MockData/DigitalPWMData.h"
+#include "MockData/MockHooks.h"
 #include "gtest/gtest.h"
 
 namespace hal {
@@ -78,4 +81,156 @@ TEST(DigitalIoSimTests, TestDigitalIoInitialization) {
   EXPECT_STREQ("Initialized", gTestDigitalIoCallbackName.c_str());
 }
 
+TEST(DigitalIoSimTests, TestDigitalIoMasked) {
+  const int OUTPUT_A = 2;
+  const int OUTPUT_B = 12;
+
+  hal::HandleBase::ResetGlobalHandles();
+  HALSIM_ResetDIOData(OUTPUT_A);
+  HALSIM_ResetDIOData(OUTPUT_B);
+
+  int32_t status = 0;
+  HAL_InitializeDIOPort(HAL_GetPort(OUTPUT_A), false, &status);
+  ASSERT_EQ(0, status);
+  HAL_InitializeDIOPort(HAL_GetPort(OUTPUT_B), false, &status);
+  ASSERT_EQ(0, status);
+
+  uint32_t mask = (1u << OUTPUT_A) | (1u << OUTPUT_B);
+  HAL_SetDIOMasked(mask, 1u << OUTPUT_B, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_FALSE(HALSIM_GetDIOValue(OUTPUT_A));
+  EXPECT_TRUE(HALSIM_GetDIOValue(OUTPUT_B));
+
+  uint64_t timestamp = 0;
+  EXPECT_EQ(1u << OUTPUT_B, HAL_GetAllDIO(&timestamp, &status) & mask);
+  EXPECT_EQ(0, status);
+
+  // Channels outside the mask keep their state
+  HAL_SetDIOMasked(1u << OUTPUT_A, mask, &status);
+  EXPECT_TRUE(HALSIM_GetDIOValue(OUTPUT_A));
+  EXPECT_TRUE(HALSIM_GetDIOValue(OUTPUT_B));
+
+  HAL_SetDIOMasked(1u << 31, 0, &status);
+  EXPECT_EQ(PARAMETER_OUT_OF_RANGE, status);
+}
+
+TEST(DigitalIoSimTests, TestInterruptEventQueue) {
+  const int INDEX_TO_TEST = 5;
+
+  hal::HandleBase::ResetGlobalHandles();
+  HALSIM_ResetDIOData(INDEX_TO_TEST);
+
+  int32_t status = 0;
+  HAL_DigitalHandle dioHandle =
+      HAL_InitializeDIOPort(HAL_GetPort(INDEX_TO_TEST), true, &status);
+  ASSERT_EQ(0, status);
+  HAL_InterruptHandle interrupt = HAL_InitializeInterrupts(false, &status);
+  ASSERT_EQ(0, status);
+
+  // Reading without a queue is an error
+  HAL_InterruptEvent events[4];
+  EXPECT_EQ(0, HAL_ReadInterruptEvents(interrupt, events, 4, &status));
+  EXPECT_EQ(INCOMPATIBLE_STATE, status);
+
+  status = 0;
+  HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+  HAL_RequestInterrupts(interrupt, dioHandle, HAL_Trigger_kInWindow, &status);
+  HAL_SetInterruptUpSourceEdge(interrupt, true, true, &status);
+  HAL_SetInterruptEventQueueSize(interrupt, 2, &status);
+  HAL_AttachInterruptHandler(interrupt, [](uint32_t mask, void* param) {},
+                             nullptr, &status);
+  HAL_EnableInterrupts(interrupt, &status);
+  ASSERT_EQ(0, status);
+
+  // Three edges into a queue of two drops the last one
+  HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+
+  ASSERT_EQ(2, HAL_ReadInterruptEvents(interrupt, events, 4, &status));
+  EXPECT_EQ(HAL_kInterruptRisingEdge, events[0].edge);
+  EXPECT_EQ(HAL_kInterruptFallingEdge, events[1].edge);
+  EXPECT_LE(events[0].timestamp, events[1].timestamp);
+  EXPECT_EQ(1, HAL_GetInterruptEventOverflowCount(interrupt, &status));
+  EXPECT_EQ(0, HAL_ReadInterruptEvents(interrupt, events, 4, &status));
+  EXPECT_EQ(0, status);
+
+  HAL_CleanInterrupts(interrupt, &status);
+}
+
+TEST(DigitalIoSimTests, TestInterruptLatency) {
+  const int INDEX_TO_TEST = 6;
+
+  HALSIM_ResetDIOData(INDEX_TO_TEST);
+
+  int32_t status = 0;
+  HAL_DigitalHandle dioHandle =
+      HAL_InitializeDIOPort(HAL_GetPort(INDEX_TO_TEST), true, &status);
+  ASSERT_EQ(0, status);
+  HAL_InterruptHandle interrupt = HAL_InitializeInterrupts(false, &status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+  HAL_RequestInterrupts(interrupt, dioHandle, HAL_Trigger_kInWindow, &status);
+  HAL_SetInterruptUpSourceEdge(interrupt, true, true, &status);
+  HAL_SetInterruptEventQueueSize(interrupt, 4, &status);
+  HAL_AttachInterruptHandler(interrupt, [](uint32_t mask, void* param) {},
+                             nullptr, &status);
+  HAL_EnableInterrupts(interrupt, &status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_PauseTiming();
+  HALSIM_SetInterruptLatency(0.002, 0, 0);
+  uint64_t edgeTime = HAL_GetFPGATime(&status);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+  HALSIM_StepTiming(1000);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+
+  // Nothing is delivered before the latency has passed
+  HAL_InterruptEvent events[4];
+  EXPECT_EQ(0, HAL_ReadInterruptEvents(interrupt, events, 4, &status));
+
+  // Each edge keeps the time its input changed
+  HALSIM_StepTiming(1000);
+  ASSERT_EQ(1, HAL_ReadInterruptEvents(interrupt, events, 4, &status));
+  EXPECT_EQ(HAL_kInterruptRisingEdge, events[0].edge);
+  EXPECT_DOUBLE_EQ(edgeTime * 1.0e-6, events[0].timestamp);
+  HALSIM_StepTiming(1000);
+  ASSERT_EQ(1, HAL_ReadInterruptEvents(interrupt, events, 4, &status));
+  EXPECT_EQ(HAL_kInterruptFallingEdge, events[0].edge);
+  EXPECT_DOUBLE_EQ((edgeTime + 1000) * 1.0e-6, events[0].timestamp);
+  EXPECT_DOUBLE_EQ((edgeTime + 1000) * 1.0e-6,
+                   HAL_ReadInterruptFallingTimestamp(interrupt, &status));
+
+  HALSIM_ClearInterruptLatency();
+  HALSIM_ResumeTiming();
+  HAL_CleanInterrupts(interrupt, &status);
+}
+
+TEST(DigitalIoSimTests, TestSetDigitalPWMDutyCycles) {
+  int32_t status = 0;
+  HAL_DigitalPWMHandle generators[2];
+  generators[0] = HAL_AllocateDigitalPWM(&status);
+  generators[1] = HAL_AllocateDigitalPWM(&status);
+  ASSERT_EQ(0, status);
+
+  const double dutyCycles[] = {0.25, 1.5};
+  HAL_SetDigitalPWMDutyCycles(generators, dutyCycles, 2, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(0.25, HALSIM_GetDigitalPWMDutyCycle(getHandleIndex(generators[0])));
+  EXPECT_EQ(1.0, HALSIM_GetDigitalPWMDutyCycle(getHandleIndex(generators[1])));
+
+  // nothing changes if any generator is invalid
+  const HAL_DigitalPWMHandle withInvalid[] = {generators[0],
+                                              HAL_kInvalidHandle};
+  const double zeros[] = {0, 0};
+  HAL_SetDigitalPWMDutyCycles(withInvalid, zeros, 2, &status);
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+  EXPECT_EQ(0.25, HALSIM_GetDigitalPWMDutyCycle(getHandleIndex(generators[0])));
+
+  status = 0;
+  HAL_FreeDigitalPWM(generators[0], &status);
+  HAL_FreeDigitalPWM(generators[1], &status);
+}
+
 }  // namespace hal
@@ -0,0 +1,167 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <cmath>
+
+#include "HAL/AnalogInput.h"
+#include "HAL/AnalogTrigger.h"
+#include "HAL/Counter.h"
+#include "HAL/DIO.h"
+#include "HAL/HAL.h"
+#include "MockData/AnalogInData.h"
+#include "MockData/DIOData.h"
+#include "MockData/MockHooks.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(DigitalSignalsTests, GlitchFilter) {
+  const int INDEX_TO_TEST = 8;
+  HALSIM_ResetDIOData(INDEX_TO_TEST);
+
+  int32_t status = 0;
+  HAL_DigitalHandle dioHandle =
+      HAL_InitializeDIOPort(HAL_GetPort(INDEX_TO_TEST), true, &status);
+  ASSERT_EQ(0, status);
+  HALSIM_PauseTiming();
+
+  // 100 us
+  HAL_SetFilterPeriod(0, 4000, &status);
+  HAL_SetFilterSelect(dioHandle, 1, &status);
+  ASSERT_EQ(0, status);
+  EXPECT_EQ(4000, HAL_GetFilterPeriod(0, &status));
+  EXPECT_EQ(1, HAL_GetFilterSelect(dioHandle, &status));
+
+  // A pulse shorter than the period is dropped
+  HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+  HALSIM_StepTiming(50);
+  EXPECT_TRUE(HAL_GetDIO(dioHandle, &status));
+  HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+  HALSIM_StepTiming(200);
+  EXPECT_TRUE(HAL_GetDIO(dioHandle, &status));
+
+  // A change that holds for the period passes
+  HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+  HALSIM_StepTiming(99);
+  EXPECT_TRUE(HAL_GetDIO(dioHandle, &status));
+  HALSIM_StepTiming(1);
+  EXPECT_FALSE(HAL_GetDIO(dioHandle, &status));
+
+  HAL_SetFilterSelect(dioHandle, 4, &status);
+  EXPECT_EQ(PARAMETER_OUT_OF_RANGE, status);
+  status = 0;
+  HAL_SetFilterSelect(dioHandle, 0, &status);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+  EXPECT_TRUE(HAL_GetDIO(dioHandle, &status));
+
+  HALSIM_ResumeTiming();
+  HAL_FreeDIOPort(dioHandle);
+}
+
+TEST(DigitalSignalsTests, CounterOnFilteredInput) {
+  const int INDEX_TO_TEST = 9;
+  HALSIM_ResetDIOData(INDEX_TO_TEST);
+
+  int32_t status = 0;
+  HAL_DigitalHandle dioHandle =
+      HAL_InitializeDIOPort(HAL_GetPort(INDEX_TO_TEST), true, &status);
+  int32_t index;
+  HAL_CounterHandle counter =
+      HAL_InitializeCounter(HAL_Counter_kTwoPulse, &index, &status);
+  HAL_SetCounterUpSource(counter, dioHandle, HAL_Trigger_kInWindow, &status);
+  ASSERT_EQ(0, status);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+  HALSIM_PauseTiming();
+
+  HAL_SetFilterPeriod(1, 400, &status);
+  HAL_SetFilterSelect(dioHandle, 2, &status);
+  for (int i = 0; i < 4; i++) {
+    // 2 us of bounce before each 1 ms pulse
+    HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+    HALSIM_StepTiming(2);
+    HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+    HALSIM_StepTiming(2);
+    HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+    HALSIM_StepTiming(1000);
+    HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+    HALSIM_StepTiming(8996);
+  }
+  EXPECT_EQ(4, HAL_GetCounter(counter, &status));
+  EXPECT_NEAR(0.01, HAL_GetCounterPeriod(counter, &status), 1e-9);
+  EXPECT_FALSE(HAL_GetCounterStopped(counter, &status));
+
+  // Without the filter, every bounce counts
+  HAL_SetFilterSelect(dioHandle, 0, &status);
+  HAL_ResetCounter(counter, &status);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, false);
+  HALSIM_SetDIOValue(INDEX_TO_TEST, true);
+  EXPECT_EQ(2, HAL_GetCounter(counter, &status));
+
+  // The counter stops once no count comes within the max period
+  HAL_SetCounterMaxPeriod(counter, 0.1, &status);
+  HALSIM_StepTiming(200000);
+  HAL_CounterSnapshot snapshot;
+  HAL_GetCounterSnapshot(counter, &snapshot, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(2, snapshot.count);
+  EXPECT_TRUE(snapshot.stopped);
+  EXPECT_TRUE(std::isinf(snapshot.period));
+
+  HALSIM_ResumeTiming();
+  HAL_FreeCounter(counter, &status);
+  HAL_FreeDIOPort(dioHandle);
+}
+
+TEST(DigitalSignalsTests, CounterOnAnalogTrigger) {
+  const int INDEX_TO_TEST = 2;
+  HALSIM_ResetAnalogInData(INDEX_TO_TEST);
+
+  int32_t status = 0;
+  HAL_AnalogInputHandle analogHandle =
+      HAL_InitializeAnalogInputPort(HAL_GetPort(INDEX_TO_TEST), &status);
+  int32_t index;
+  HAL_AnalogTriggerHandle trigger =
+      HAL_InitializeAnalogTrigger(analogHandle, &index, &status);
+  HAL_SetAnalogTriggerLimitsVoltage(trigger, 1.0, 2.0, &status);
+  HAL_CounterHandle up =
+      HAL_InitializeCounter(HAL_Counter_kTwoPulse, &index, &status);
+  HAL_SetCounterUpSource(up, trigger, HAL_Trigger_kRisingPulse, &status);
+  HAL_CounterHandle window =
+      HAL_InitializeCounter(HAL_Counter_kTwoPulse, &index, &status);
+  HAL_SetCounterUpSource(window, trigger, HAL_Trigger_kInWindow, &status);
+  HAL_SetCounterUpSourceEdge(window, true, true, &status);
+  ASSERT_EQ(0, status);
+
+  // Noise inside the window doesn't change the state
+  const double voltages[] = {0.5, 2.5, 1.5, 2.5, 1.2, 0.5, 1.8, 0.2};
+  for (double voltage : voltages) {
+    HALSIM_SetAnalogInVoltage(INDEX_TO_TEST, voltage);
+  }
+  EXPECT_EQ(1, HAL_GetCounter(up, &status));
+  EXPECT_EQ(6, HAL_GetCounter(window, &status));
+  EXPECT_FALSE(HAL_GetAnalogTriggerTriggerState(trigger, &status));
+
+  HALSIM_SetAnalogInVoltage(INDEX_TO_TEST, 3.0);
+  EXPECT_EQ(2, HAL_GetCounter(up, &status));
+  EXPECT_TRUE(HAL_GetAnalogTriggerTriggerState(trigger, &status));
+  EXPECT_FALSE(HAL_GetAnalogTriggerInWindow(trigger, &status));
+
+  // Moving the window can change the state too
+  HAL_SetAnalogTriggerLimitsVoltage(trigger, 3.5, 4.0, &status);
+  EXPECT_FALSE(HAL_GetAnalogTriggerTriggerState(trigger, &status));
+  HAL_SetAnalogTriggerLimitsVoltage(trigger, 1.0, 2.0, &status);
+  EXPECT_EQ(3, HAL_GetCounter(up, &status));
+  EXPECT_EQ(0, status);
+
+  HAL_FreeCounter(up, &status);
+  HAL_FreeCounter(window, &status);
+  HAL_CleanAnalogTrigger(trigger, &status);
+  HAL_FreeAnalogInputPort(analogHandle);
+}
+
+}  // namespace hal
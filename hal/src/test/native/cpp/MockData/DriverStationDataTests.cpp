@@ -113,6 +113,66 @@ TEST(DriverStationTests, JoystickTests) {
   }
 }
 
+static int packetCallbackCount = 0;
+static int16_t packetCallbackAxisCount = 0;
+
+static void TestPacketCallback(const char* name, void* param,
+                               const struct HAL_Value* value) {
+  // the rest of the packet is applied before any callback
+  HAL_JoystickAxes axes;
+  HAL_GetJoystickAxes(2, &axes);
+  packetCallbackAxisCount = axes.count;
+  packetCallbackCount++;
+}
+
+TEST(DriverStationTests, PacketTest) {
+  HALSIM_ResetDriverStationData();
+  HALSIM_DSPacket packet;
+  std::memset(&packet, 0, sizeof(packet));
+  packet.controlWord.enabled = 1;
+  packet.controlWord.autonomous = 1;
+  packet.controlWord.dsAttached = 1;
+  packet.allianceStationId = HAL_AllianceStationID_kBlue2;
+  packet.matchTime = 12.5;
+  packet.axes[2].count = 4;
+  packet.axes[2].axes[1] = 0.5;
+  packet.buttons[5].count = 10;
+  packet.buttons[5].buttons = 0x201;
+
+  packetCallbackCount = 0;
+  int32_t uid = HALSIM_RegisterDriverStationEnabledCallback(
+      &TestPacketCallback, nullptr, false);
+  HALSIM_SetDriverStationPacket(&packet);
+  EXPECT_EQ(1, packetCallbackCount);
+  EXPECT_EQ(4, packetCallbackAxisCount);
+
+  HAL_ControlWord word;
+  HAL_GetControlWord(&word);
+  EXPECT_TRUE(word.enabled);
+  EXPECT_TRUE(word.autonomous);
+  EXPECT_FALSE(word.test);
+  EXPECT_TRUE(word.dsAttached);
+  int32_t status = 0;
+  EXPECT_EQ(HAL_AllianceStationID_kBlue2, HAL_GetAllianceStation(&status));
+  EXPECT_EQ(12.5, HAL_GetMatchTime(&status));
+
+  HAL_JoystickAxes axes;
+  HAL_GetJoystickAxes(2, &axes);
+  EXPECT_EQ(4, axes.count);
+  EXPECT_EQ(0.5, axes.axes[1]);
+  HAL_JoystickButtons buttons;
+  HAL_GetJoystickButtons(5, &buttons);
+  EXPECT_EQ(10, buttons.count);
+  EXPECT_EQ(0x201u, buttons.buttons);
+
+  // an unchanged value doesn't call its callback again
+  HALSIM_SetDriverStationPacket(&packet);
+  EXPECT_EQ(1, packetCallbackCount);
+
+  HALSIM_CancelDriverStationEnabledCallback(uid);
+  HALSIM_ResetDriverStationData();
+}
+
 TEST(DriverStationTests, EventInfoTest) {
   std::string eventName = "UnitTest";
   std::string gameData = "Insert game specific info here :D";
@@ -134,6 +194,36 @@ TEST(DriverStationTests, EventInfoTest) {
   EXPECT_EQ(42, dataBack.replayNumber);
 
   HAL_FreeMatchInfo(&dataBack);
+
+  HAL_InlineMatchInfo inlineBack;
+  EXPECT_EQ(0, HAL_GetInlineMatchInfo(&inlineBack));
+  EXPECT_STREQ(eventName.c_str(), inlineBack.eventName);
+  EXPECT_STREQ(gameData.c_str(), inlineBack.gameSpecificMessage);
+  EXPECT_EQ(gameData.size(), inlineBack.gameSpecificMessageSize);
+  EXPECT_EQ(5, inlineBack.matchNumber);
+  EXPECT_EQ(HAL_MatchType::HAL_kMatchType_qualification, inlineBack.matchType);
+  EXPECT_EQ(42, inlineBack.replayNumber);
+}
+
+TEST(DriverStationTests, InlineEventInfoTruncates) {
+  std::string eventName(100, 'e');
+  std::string gameData(100, 'g');
+  HAL_MatchInfo info;
+  info.eventName = const_cast<char*>(eventName.c_str());
+  info.gameSpecificMessage = const_cast<char*>(gameData.c_str());
+  info.matchNumber = 1;
+  info.matchType = HAL_MatchType::HAL_kMatchType_practice;
+  info.replayNumber = 0;
+  HALSIM_SetMatchInfo(&info);
+
+  HAL_InlineMatchInfo inlineBack;
+  HAL_GetInlineMatchInfo(&inlineBack);
+  EXPECT_EQ(std::string(HAL_kMaxEventNameLength - 1, 'e'),
+            inlineBack.eventName);
+  EXPECT_EQ(std::string(HAL_kMaxGameSpecificMessageLength - 1, 'g'),
+            inlineBack.gameSpecificMessage);
+  EXPECT_EQ(HAL_kMaxGameSpecificMessageLength - 1,
+            inlineBack.gameSpecificMessageSize);
 }
 
 }  // namespace hal
@@ -0,0 +1,77 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/DIO.h"
+#include "HAL/Encoder.h"
+#include "HAL/HAL.h"
+#include "MockData/EncoderData.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(EncoderSimTests, TestEncoderSnapshot) {
+  int32_t status = 0;
+  HAL_DigitalHandle aHandle =
+      HAL_InitializeDIOPort(HAL_GetPort(10), true, &status);
+  ASSERT_EQ(0, status);
+  HAL_DigitalHandle bHandle =
+      HAL_InitializeDIOPort(HAL_GetPort(11), true, &status);
+  ASSERT_EQ(0, status);
+
+  HAL_EncoderHandle encoderHandle = HAL_InitializeEncoder(
+      aHandle, HAL_Trigger_kInWindow, bHandle, HAL_Trigger_kInWindow, false,
+      HAL_Encoder_k4X, &status);
+  ASSERT_EQ(0, status);
+  HAL_SetEncoderDistancePerPulse(encoderHandle, 0.5, &status);
+  int32_t index = HAL_GetEncoderFPGAIndex(encoderHandle, &status);
+  ASSERT_EQ(0, status);
+
+  HALSIM_SetEncoderCount(index, 40);
+  HALSIM_SetEncoderPeriod(index, 0.25);
+  HALSIM_SetEncoderMaxPeriod(index, 0.5);
+  HALSIM_SetEncoderDirection(index, true);
+
+  HAL_EncoderSnapshot snapshot;
+  HAL_GetEncoderSnapshot(encoderHandle, &snapshot, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(HAL_GetEncoder(encoderHandle, &status), snapshot.count);
+  EXPECT_EQ(HAL_GetEncoderRaw(encoderHandle, &status), snapshot.raw);
+  EXPECT_DOUBLE_EQ(20.0, snapshot.distance);
+  EXPECT_DOUBLE_EQ(0.25, snapshot.period);
+  EXPECT_DOUBLE_EQ(2.0, snapshot.rate);
+  EXPECT_TRUE(snapshot.direction);
+  EXPECT_FALSE(snapshot.stopped);
+
+  HALSIM_SetEncoderPeriod(index, 1.0);
+  HAL_GetEncoderSnapshot(encoderHandle, &snapshot, &status);
+  EXPECT_TRUE(snapshot.stopped);
+
+  HAL_FreeEncoder(encoderHandle, &status);
+  HAL_FreeDIOPort(aHandle);
+  HAL_FreeDIOPort(bHandle);
+}
+
+TEST(EncoderSimTests, TestAllEncoderCounts) {
+  HALSIM_ResetEncoderData(0);
+  HALSIM_ResetEncoderData(1);
+
+  int32_t counts[2] = {12, -7};
+  HALSIM_SetAllEncoderCounts(counts, 2);
+  EXPECT_EQ(12, HALSIM_GetEncoderCount(0));
+  EXPECT_EQ(-7, HALSIM_GetEncoderCount(1));
+
+  int32_t read[2] = {0, 0};
+  EXPECT_EQ(2, HALSIM_GetAllEncoderCounts(read, 2));
+  EXPECT_EQ(12, read[0]);
+  EXPECT_EQ(-7, read[1]);
+
+  HALSIM_ResetEncoderData(0);
+  HALSIM_ResetEncoderData(1);
+  EXPECT_EQ(0, HALSIM_GetEncoderCount(0));
+}
+
+}  // namespace hal
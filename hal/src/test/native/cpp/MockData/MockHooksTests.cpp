@@ -0,0 +1,119 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "HAL/HAL.h"
+#include "HAL/Notifier.h"
+#include "MockData/MockHooks.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(MockHooksTests, TestPauseTiming) {
+  int32_t status = 0;
+  HALSIM_PauseTiming();
+  EXPECT_TRUE(HALSIM_IsTimingPaused());
+
+  uint64_t startTime = HAL_GetFPGATime(&status);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(startTime, HAL_GetFPGATime(&status));
+
+  HALSIM_StepTiming(5000);
+  EXPECT_EQ(startTime + 5000, HAL_GetFPGATime(&status));
+
+  HALSIM_ResumeTiming();
+  EXPECT_FALSE(HALSIM_IsTimingPaused());
+  EXPECT_LE(startTime + 5000, HAL_GetFPGATime(&status));
+}
+
+TEST(MockHooksTests, TestStepTimingRunsNotifier) {
+  int32_t status = 0;
+  HALSIM_PauseTiming();
+
+  HAL_NotifierHandle notifier = HAL_InitializeNotifier(&status);
+  ASSERT_EQ(0, status);
+
+  // fire every 1 ms of simulated time
+  std::atomic<int> count{0};
+  uint64_t triggerTime = HAL_GetFPGATime(&status) + 1000;
+  HAL_UpdateNotifierAlarm(notifier, triggerTime, &status);
+  std::thread thread([&] {
+    int32_t status = 0;
+    uint64_t nextTime = triggerTime;
+    while (HAL_WaitForNotifierAlarm(notifier, &status) != 0) {
+      count++;
+      nextTime += 1000;
+      HAL_UpdateNotifierAlarm(notifier, nextTime, &status);
+    }
+  });
+
+  HALSIM_StepTiming(10000);
+  EXPECT_EQ(10, count);
+  HALSIM_StepTiming(500);
+  EXPECT_EQ(10, count);
+  HALSIM_StepTiming(500);
+  EXPECT_EQ(11, count);
+
+  HAL_StopNotifier(notifier, &status);
+  thread.join();
+  HAL_CleanNotifier(notifier, &status);
+  HALSIM_ResumeTiming();
+}
+
+TEST(MockHooksTests, TestStepTimingRunsPeriodicNotifier) {
+  int32_t status = 0;
+  HALSIM_PauseTiming();
+
+  HAL_NotifierHandle notifier = HAL_InitializeNotifier(&status);
+  ASSERT_EQ(0, status);
+
+  // re-armed natively every 1 ms of simulated time
+  std::atomic<int> count{0};
+  HAL_SetNotifierPeriodic(notifier, 1000, &status);
+  HAL_UpdateNotifierAlarm(notifier, HAL_GetFPGATime(&status) + 1000, &status);
+  std::thread thread([&] {
+    int32_t status = 0;
+    while (HAL_WaitForNotifierAlarm(notifier, &status) != 0) count++;
+  });
+
+  HALSIM_StepTiming(10000);
+  EXPECT_EQ(10, count);
+  HALSIM_StepTiming(500);
+  EXPECT_EQ(10, count);
+  HALSIM_StepTiming(500);
+  EXPECT_EQ(11, count);
+
+  HAL_StopNotifier(notifier, &status);
+  thread.join();
+  HAL_CleanNotifier(notifier, &status);
+  HALSIM_ResumeTiming();
+}
+
+TEST(MockHooksTests, TestNotifierNeverFiresEarly) {
+  int32_t status = 0;
+  HALSIM_SetNotifierSpinTime(100);
+
+  HAL_NotifierHandle notifier = HAL_InitializeNotifier(&status);
+  ASSERT_EQ(0, status);
+
+  for (int i = 0; i < 20; i++) {
+    uint64_t triggerTime = HAL_GetFPGATime(&status) + 2000;
+    HAL_UpdateNotifierAlarm(notifier, triggerTime, &status);
+    uint64_t fireTime = HAL_WaitForNotifierAlarm(notifier, &status);
+    EXPECT_LE(triggerTime, fireTime);
+    EXPECT_LE(triggerTime, static_cast<uint64_t>(HAL_GetFPGATime(&status)));
+  }
+
+  HAL_StopNotifier(notifier, &status);
+  HAL_CleanNotifier(notifier, &status);
+  HALSIM_SetNotifierSpinTime(0);
+}
+
+}  // namespace hal
@@ -5,6 +5,7 @@
 /* the project.                                                               */
 /*----------------------------------------------------------------------------*/
 
+#include "HAL/Compressor.h"
 #include "HAL/HAL.h"
 #include "HAL/Solenoid.h"
 #include "HAL/handles/HandlesInternal.h"
@@ -80,4 +81,48 @@ TEST(SolenoidSimTests, TestSolenoidInitialization) {
   EXPECT_STREQ("SolenoidInitialized", gTestSolenoidCallbackName.c_str());
 }
 
+TEST(SolenoidSimTests, TestSetSolenoids) {
+  const int MODULE_TO_TEST = 3;
+
+  int32_t status = 0;
+  HAL_SetAllSolenoids(MODULE_TO_TEST, 0x0F, &status);
+  EXPECT_EQ(0x0F, HAL_GetAllSolenoids(MODULE_TO_TEST, &status));
+
+  // only the masked channels change
+  HAL_BeginSolenoidTransaction(MODULE_TO_TEST, &status);
+  HAL_SetSolenoids(MODULE_TO_TEST, 0x3C, 0x30, &status);
+  HAL_EndSolenoidTransaction(MODULE_TO_TEST, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(0x33, HAL_GetAllSolenoids(MODULE_TO_TEST, &status));
+
+  HALSIM_ResetPCMData(MODULE_TO_TEST);
+}
+
+TEST(CompressorSimTests, TestCompressorStatus) {
+  const int MODULE_TO_TEST = 4;
+
+  int32_t status = 0;
+  HAL_CompressorHandle handle =
+      HAL_InitializeCompressor(MODULE_TO_TEST, &status);
+  HALSIM_SetPCMCompressorOn(MODULE_TO_TEST, true);
+  HALSIM_SetPCMClosedLoopEnabled(MODULE_TO_TEST, true);
+  HALSIM_SetPCMPressureSwitch(MODULE_TO_TEST, false);
+  HALSIM_SetPCMCompressorCurrent(MODULE_TO_TEST, 12.5);
+
+  HAL_CompressorStatus compressorStatus;
+  HAL_GetCompressorStatus(handle, &compressorStatus, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_TRUE(compressorStatus.enabled);
+  EXPECT_TRUE(compressorStatus.closedLoopControl);
+  EXPECT_FALSE(compressorStatus.pressureSwitch);
+  EXPECT_EQ(12.5, compressorStatus.current);
+  EXPECT_FALSE(compressorStatus.currentTooHighFault);
+  EXPECT_FALSE(compressorStatus.notConnectedStickyFault);
+
+  HAL_GetCompressorStatus(HAL_kInvalidHandle, &compressorStatus, &status);
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+
+  HALSIM_ResetPCMData(MODULE_TO_TEST);
+}
+
 }  // namespace hal
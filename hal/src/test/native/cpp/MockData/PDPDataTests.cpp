@@ -40,4 +40,35 @@ TEST(PdpSimTests, TestPdpInitialization) {
   EXPECT_STREQ("Initialized", gTestPdpCallbackName.c_str());
 }
 
+TEST(PdpSimTests, TestPdpSnapshot) {
+  const int INDEX_TO_TEST = 2;
+
+  int32_t status = 0;
+  HAL_InitializePDP(INDEX_TO_TEST, &status);
+  ASSERT_EQ(0, status);
+
+  for (int i = 0; i < HAL_kPDPNumChannels; i++) {
+    HALSIM_SetPDPCurrent(INDEX_TO_TEST, i, 0.5 * i);
+  }
+  HALSIM_SetPDPVoltage(INDEX_TO_TEST, 12.5);
+  HALSIM_SetPDPTemperature(INDEX_TO_TEST, 35.0);
+
+  double currents[HAL_kPDPNumChannels];
+  HAL_GetPDPAllCurrents(INDEX_TO_TEST, currents, &status);
+  EXPECT_EQ(0, status);
+
+  HAL_PDPSnapshot snapshot;
+  HAL_GetPDPSnapshot(INDEX_TO_TEST, &snapshot, &status);
+  EXPECT_EQ(0, status);
+
+  for (int i = 0; i < HAL_kPDPNumChannels; i++) {
+    EXPECT_EQ(0.5 * i, currents[i]);
+    EXPECT_EQ(0.5 * i, snapshot.currents[i]);
+  }
+  EXPECT_EQ(12.5, snapshot.voltage);
+  EXPECT_EQ(35.0, snapshot.temperature);
+
+  HALSIM_ResetPDPData(INDEX_TO_TEST);
+}
+
 }  // namespace hal
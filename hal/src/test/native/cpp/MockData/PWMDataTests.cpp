@@ -75,4 +75,62 @@ TEST(PWMSimTests, TestPwmInitialization) {
   EXPECT_EQ(0, status);
   EXPECT_STREQ("Initialized", gTestPwmCallbackName.c_str());
 }
+
+TEST(PWMSimTests, TestSetPWMSpeeds) {
+  hal::HandleBase::ResetGlobalHandles();
+  HALSIM_ResetPWMData(3);
+  HALSIM_ResetPWMData(4);
+
+  int32_t status = 0;
+  HAL_DigitalHandle handles[3];
+  handles[0] = HAL_InitializePWMPort(HAL_GetPort(3), &status);
+  handles[1] = HAL_kInvalidHandle;
+  handles[2] = HAL_InitializePWMPort(HAL_GetPort(4), &status);
+  ASSERT_EQ(0, status);
+
+  // The invalid handle is reported, but the channels after it are written
+  double speeds[3] = {0.5, 0.25, -2.0};
+  HAL_SetPWMSpeeds(handles, speeds, 3, &status);
+  EXPECT_EQ(HAL_HANDLE_ERROR, status);
+  EXPECT_DOUBLE_EQ(0.5, HALSIM_GetPWMSpeed(3));
+  EXPECT_DOUBLE_EQ(-1.0, HALSIM_GetPWMSpeed(4));
+
+  status = 0;
+  speeds[0] = -0.75;
+  speeds[2] = 0.125;
+  HAL_SetPWMSpeeds(handles, speeds, 1, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_DOUBLE_EQ(-0.75, HALSIM_GetPWMSpeed(3));
+  EXPECT_DOUBLE_EQ(-1.0, HALSIM_GetPWMSpeed(4));
+}
+
+TEST(PWMSimTests, TestAllPWMSpeeds) {
+  HALSIM_ResetPWMData(1);
+  HALSIM_ResetPWMData(2);
+
+  int callbackParam = 0;
+  gTestPwmCallbackName = "Unset";
+  HALSIM_RegisterPWMSpeedCallback(2, &TestPwmInitializationCallback,
+                                  &callbackParam, false);
+
+  double speeds[3] = {0.0, 0.5, -0.25};
+  HALSIM_SetAllPWMSpeeds(speeds, 3);
+  EXPECT_STREQ("Speed", gTestPwmCallbackName.c_str());
+  EXPECT_DOUBLE_EQ(-0.25, gTestPwmCallbackValue.data.v_double);
+
+  double read[3] = {1.0, 1.0, 1.0};
+  EXPECT_EQ(3, HALSIM_GetAllPWMSpeeds(read, 3));
+  EXPECT_DOUBLE_EQ(0.0, read[0]);
+  EXPECT_DOUBLE_EQ(0.5, read[1]);
+  EXPECT_DOUBLE_EQ(-0.25, read[2]);
+  EXPECT_DOUBLE_EQ(0.5, HALSIM_GetPWMSpeed(1));
+
+  // Counts past the last channel are clamped
+  double all[100];
+  EXPECT_GT(100, HALSIM_GetAllPWMSpeeds(all, 100));
+
+  HALSIM_ResetPWMData(1);
+  HALSIM_ResetPWMData(2);
+  EXPECT_DOUBLE_EQ(0.0, HALSIM_GetPWMSpeed(1));
+}
 }  // namespace hal
@@ -76,4 +76,30 @@ TEST(RelaySimTests, TestRelayInitialization) {
   EXPECT_STREQ("InitializedForward", gTestRelayCallbackName.c_str());
 }
 
+TEST(RelaySimTests, TestSetRelaysMasked) {
+  const int INDEX_TO_TEST = 1;
+  HALSIM_ResetRelayData(INDEX_TO_TEST);
+  HALSIM_ResetRelayData(INDEX_TO_TEST + 1);
+  HALSIM_SetRelayForward(INDEX_TO_TEST + 1, true);
+
+  int32_t status = 0;
+  // forward of the channel under test on, reverse of its neighbour on
+  uint32_t forwardBit = 1u << INDEX_TO_TEST;
+  uint32_t reverseBit = 1u << (INDEX_TO_TEST + 4);
+  HAL_SetRelaysMasked(forwardBit | reverseBit | (reverseBit << 1),
+                      forwardBit | (reverseBit << 1), &status);
+  EXPECT_EQ(0, status);
+  EXPECT_TRUE(HALSIM_GetRelayForward(INDEX_TO_TEST));
+  EXPECT_FALSE(HALSIM_GetRelayReverse(INDEX_TO_TEST));
+  // outside the mask, so left alone
+  EXPECT_TRUE(HALSIM_GetRelayForward(INDEX_TO_TEST + 1));
+  EXPECT_TRUE(HALSIM_GetRelayReverse(INDEX_TO_TEST + 1));
+
+  HAL_SetRelaysMasked(1u << 8, 0, &status);
+  EXPECT_EQ(PARAMETER_OUT_OF_RANGE, status);
+
+  HALSIM_ResetRelayData(INDEX_TO_TEST);
+  HALSIM_ResetRelayData(INDEX_TO_TEST + 1);
+}
+
 }  // namespace hal
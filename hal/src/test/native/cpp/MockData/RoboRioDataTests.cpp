@@ -0,0 +1,42 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/HAL.h"
+#include "HAL/Power.h"
+#include "MockData/MockHooks.h"
+#include "MockData/RoboRioData.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(RoboRioSimTests, TestPowerSnapshot) {
+  HALSIM_ResetRoboRioData(0);
+  HALSIM_SetRoboRioVInVoltage(0, 11.5);
+  HALSIM_SetRoboRioVInCurrent(0, 2.25);
+  HALSIM_SetRoboRioUserVoltage5V(0, 4.75);
+  HALSIM_SetRoboRioUserActive5V(0, true);
+  HALSIM_SetRoboRioUserFaults3V3(0, 3);
+  HALSIM_PauseTiming();
+
+  int32_t status = 0;
+  HAL_PowerSnapshot snapshot;
+  HAL_GetPowerSnapshot(&snapshot, &status);
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(11.5, snapshot.vinVoltage);
+  EXPECT_EQ(2.25, snapshot.vinCurrent);
+  EXPECT_EQ(4.75, snapshot.userVoltage5V);
+  EXPECT_FALSE(snapshot.userActive6V);
+  EXPECT_TRUE(snapshot.userActive5V);
+  EXPECT_EQ(3, snapshot.userCurrentFaults3V3);
+  EXPECT_EQ(0, snapshot.userCurrentFaults5V);
+  EXPECT_EQ(HAL_GetFPGATime(&status), snapshot.timeStamp);
+
+  HALSIM_ResumeTiming();
+  HALSIM_ResetRoboRioData(0);
+}
+
+}  // namespace hal
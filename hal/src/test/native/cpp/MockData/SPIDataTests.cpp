@@ -8,6 +8,7 @@
 #include "HAL/HAL.h"
 #include "HAL/SPI.h"
 #include "HAL/handles/HandlesInternal.h"
+#include "MockData/MockHooks.h"
 #include "MockData/SPIData.h"
 #include "gtest/gtest.h"
 
@@ -40,4 +41,88 @@ TEST(SpiSimTests, TestSpiInitialization) {
   EXPECT_STREQ("Initialized", gTestSpiCallbackName.c_str());
 }
 
+int gTestSpiWriteBytes;
+int gTestSpiReadBytes;
+
+void TestSpiWriteCallback(const char* name, void* param,
+                          const unsigned char* buffer, unsigned int count) {
+  gTestSpiWriteBytes += count;
+}
+
+void TestSpiReadCallback(const char* name, void* param, unsigned char* buffer,
+                         unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) buffer[i] = 0x5A;
+  gTestSpiReadBytes += count;
+}
+
+TEST(SpiSimTests, TestSpiTransactionBatch) {
+  const int INDEX_TO_TEST = 1;
+  HAL_SPIPort port = HAL_SPI_kOnboardCS1;
+
+  int32_t status = 0;
+  HAL_InitializeSPI(port, &status);
+
+  int writeId = HALSIM_RegisterSPIWriteCallback(
+      INDEX_TO_TEST, &TestSpiWriteCallback, nullptr);
+  int readId = HALSIM_RegisterSPIReadCallback(INDEX_TO_TEST,
+                                              &TestSpiReadCallback, nullptr);
+  gTestSpiWriteBytes = 0;
+  gTestSpiReadBytes = 0;
+
+  uint8_t command[2] = {0x80, 0x00};
+  uint8_t burst[6] = {0};
+  HAL_SPITransfer transfers[2] = {{command, nullptr, 2, true, 5},
+                                  {nullptr, burst, 6, false, 0}};
+  EXPECT_EQ(8, HAL_TransactionSPIBatch(port, transfers, 2));
+  EXPECT_EQ(2, gTestSpiWriteBytes);
+  EXPECT_EQ(6, gTestSpiReadBytes);
+  EXPECT_EQ(0x5A, burst[5]);
+
+  EXPECT_EQ(-1, HAL_TransactionSPIBatch(port, transfers, 0));
+
+  HALSIM_CancelSPIWriteCallback(INDEX_TO_TEST, writeId);
+  HALSIM_CancelSPIReadCallback(INDEX_TO_TEST, readId);
+}
+
+TEST(SpiSimTests, TestSpiAutoTransfers) {
+  const int INDEX_TO_TEST = 3;
+  HAL_SPIPort port = HAL_SPI_kOnboardCS3;
+
+  int32_t status = 0;
+  HAL_InitializeSPI(port, &status);
+  int readId = HALSIM_RegisterSPIReadCallback(INDEX_TO_TEST,
+                                              &TestSpiReadCallback, nullptr);
+  gTestSpiReadBytes = 0;
+  HALSIM_PauseTiming();
+
+  // room for 10 transfers of 4 bytes
+  HAL_InitSPIAuto(port, 40, &status);
+  uint8_t command[2] = {0x20, 0x00};
+  HAL_SetSPIAutoTransmitData(port, command, 2, 2, &status);
+  HAL_StartSPIAutoRate(port, 0.002, &status);
+  ASSERT_EQ(0, status);
+
+  // transfers run on the simulated clock
+  HALSIM_StepTiming(9000);
+  uint8_t buffer[40] = {0};
+  EXPECT_EQ(16, HAL_ReadSPIAutoReceivedData(port, buffer, 0, 0, &status));
+  EXPECT_EQ(16, gTestSpiReadBytes);
+
+  // a read of more than is buffered consumes nothing, and waits no longer
+  // than the timeout while timing is paused
+  EXPECT_EQ(16, HAL_ReadSPIAutoReceivedData(port, buffer, 20, 0.01, &status));
+  EXPECT_EQ(8, HAL_ReadSPIAutoReceivedData(port, buffer, 8, 0, &status));
+  EXPECT_EQ(0x5A, buffer[7]);
+
+  // the buffer holds at most 10 transfers
+  HALSIM_StepTiming(30000);
+  EXPECT_EQ(40, HAL_ReadSPIAutoReceivedData(port, buffer, 0, 0, &status));
+  EXPECT_EQ(7, HAL_GetSPIAutoDroppedCount(port, &status));
+
+  HAL_StopSPIAuto(port, &status);
+  HAL_FreeSPIAuto(port, &status);
+  HALSIM_ResumeTiming();
+  HALSIM_CancelSPIReadCallback(INDEX_TO_TEST, readId);
+}
+
 }  // namespace hal
@@ -0,0 +1,70 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <thread>
+
+#include "HAL/HAL.h"
+#include "HAL/PWM.h"
+#include "MockData/MockHooks.h"
+#include "MockData/PWMData.h"
+#include "MockData/SimContext.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(SimContextTests, TestContextsAreIndependent) {
+  const int INDEX_TO_TEST = 9;
+
+  HALSIM_Context* defaultContext = HALSIM_GetThreadContext();
+  HALSIM_Context* contexts[2] = {HALSIM_CreateContext(),
+                                 HALSIM_CreateContext()};
+  ASSERT_NE(defaultContext, contexts[0]);
+
+  // Each robot allocates the same port and drives it its own way
+  std::thread threads[2];
+  HAL_Bool initialized[2];
+  double speeds[2];
+  for (int i = 0; i < 2; i++) {
+    threads[i] = std::thread([&, i] {
+      HALSIM_SetThreadContext(contexts[i]);
+      int32_t status = 0;
+      HAL_DigitalHandle pwmHandle =
+          HAL_InitializePWMPort(HAL_GetPort(INDEX_TO_TEST), &status);
+      EXPECT_EQ(0, status);
+      HAL_SetPWMConfig(pwmHandle, 2.0, 1.501, 1.5, 1.499, 1.0, &status);
+      HAL_SetPWMSpeed(pwmHandle, i == 0 ? 0.5 : -0.25, &status);
+      initialized[i] = HALSIM_GetPWMInitialized(INDEX_TO_TEST);
+      speeds[i] = HALSIM_GetPWMSpeed(INDEX_TO_TEST);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_TRUE(initialized[0]);
+  EXPECT_TRUE(initialized[1]);
+  EXPECT_NEAR(0.5, speeds[0], 0.01);
+  EXPECT_NEAR(-0.25, speeds[1], 0.01);
+  EXPECT_FALSE(HALSIM_GetPWMInitialized(INDEX_TO_TEST));
+
+  // Stepping one robot's time leaves the others alone
+  int32_t status = 0;
+  HALSIM_SetThreadContext(contexts[0]);
+  HALSIM_PauseTiming();
+  uint64_t startTime = HAL_GetFPGATime(&status);
+  HALSIM_StepTiming(100000);
+  EXPECT_EQ(startTime + 100000, HAL_GetFPGATime(&status));
+  HALSIM_SetThreadContext(contexts[1]);
+  EXPECT_FALSE(HALSIM_IsTimingPaused());
+  EXPECT_GT(startTime + 100000, HAL_GetFPGATime(&status));
+
+  HALSIM_SetThreadContext(nullptr);
+  EXPECT_EQ(defaultContext, HALSIM_GetThreadContext());
+  EXPECT_FALSE(HALSIM_IsTimingPaused());
+  HALSIM_DestroyContext(contexts[0]);
+  HALSIM_DestroyContext(contexts[1]);
+}
+
+}  // namespace hal
@@ -0,0 +1,62 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include "HAL/HAL.h"
+#include "HAL/SimExtension.h"
+#include "MockData/EncoderData.h"
+#include "MockData/MockHooks.h"
+#include "MockData/PWMData.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(SimExtensionTests, TestDeviceTables) {
+  sim::ExtensionHost& host = sim::GetExtensionHost();
+  EXPECT_EQ(sim::kExtensionApiVersion, host.GetApiVersion());
+
+  sim::DeviceTables tables = host.GetDeviceTables();
+  ASSERT_EQ(HAL_GetNumPWMChannels(), tables.numPWMChannels);
+  ASSERT_EQ(HAL_GetNumEncoders(), tables.numEncoders);
+
+  HALSIM_SetPWMSpeed(3, 0.25);
+  EXPECT_EQ(0.25, tables.pwmSpeeds[3]);
+  tables.encoderCounts[2] = 42;
+  EXPECT_EQ(42, HALSIM_GetEncoderCount(2));
+
+  HALSIM_ResetPWMData(3);
+  HALSIM_ResetEncoderData(2);
+}
+
+static void StepCallback(void* param, uint64_t time) {
+  static_cast<std::vector<uint64_t>*>(param)->push_back(time);
+}
+
+TEST(SimExtensionTests, TestStepCallback) {
+  sim::ExtensionHost& host = sim::GetExtensionHost();
+  int32_t status = 0;
+  HALSIM_PauseTiming();
+  uint64_t startTime = HAL_GetFPGATime(&status);
+
+  std::vector<uint64_t> times;
+  int32_t uid = host.RegisterStepCallback(&StepCallback, &times);
+  ASSERT_NE(-1, uid);
+
+  HALSIM_StepTiming(5000);
+  ASSERT_FALSE(times.empty());
+  EXPECT_EQ(startTime + 5000, times.back());
+
+  host.CancelStepCallback(uid);
+  times.clear();
+  HALSIM_StepTiming(5000);
+  EXPECT_TRUE(times.empty());
+
+  HALSIM_ResumeTiming();
+}
+
+}  // namespace hal
@@ -0,0 +1,60 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <vector>
+
+#include "HAL/HAL.h"
+#include "MockData/DriverStationData.h"
+#include "MockData/EncoderData.h"
+#include "MockData/PDPData.h"
+#include "MockData/PWMData.h"
+#include "MockData/SimState.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(SimStateTests, TestSaveRestore) {
+  HALSIM_SetPWMSpeed(3, 0.5);
+  HALSIM_SetEncoderCount(2, 1234);
+  HALSIM_SetPDPCurrent(0, 5, 12.5);
+  HALSIM_SetDriverStationAutonomous(true);
+
+  std::vector<uint8_t> state(HALSIM_GetStateSize());
+  EXPECT_EQ(static_cast<int32_t>(state.size()),
+            HALSIM_SaveState(state.data(), state.size()));
+
+  HALSIM_SetPWMSpeed(3, -1.0);
+  HALSIM_SetEncoderCount(2, 0);
+  HALSIM_SetPDPCurrent(0, 5, 0);
+  HALSIM_SetDriverStationAutonomous(false);
+
+  EXPECT_TRUE(HALSIM_RestoreState(state.data(), state.size()));
+  EXPECT_EQ(0.5, HALSIM_GetPWMSpeed(3));
+  EXPECT_EQ(1234, HALSIM_GetEncoderCount(2));
+  EXPECT_EQ(12.5, HALSIM_GetPDPCurrent(0, 5));
+  EXPECT_TRUE(HALSIM_GetDriverStationAutonomous());
+
+  HALSIM_ResetPWMData(3);
+  HALSIM_ResetEncoderData(2);
+  HALSIM_ResetPDPData(0);
+  HALSIM_SetDriverStationAutonomous(false);
+}
+
+TEST(SimStateTests, TestRejectInvalidState) {
+  std::vector<uint8_t> state(HALSIM_GetStateSize());
+  EXPECT_EQ(0, HALSIM_SaveState(state.data(), state.size() - 1));
+  ASSERT_NE(0, HALSIM_SaveState(state.data(), state.size()));
+  EXPECT_FALSE(HALSIM_RestoreState(state.data(), state.size() - 1));
+
+  state[0] ^= 0xff;
+  HALSIM_SetPWMSpeed(4, 0.25);
+  EXPECT_FALSE(HALSIM_RestoreState(state.data(), state.size()));
+  EXPECT_EQ(0.25, HALSIM_GetPWMSpeed(4));
+  HALSIM_ResetPWMData(4);
+}
+
+}  // namespace hal
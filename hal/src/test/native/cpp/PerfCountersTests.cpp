@@ -0,0 +1,68 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <thread>
+
+#include "HAL/cpp/PerfCounters.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+static HAL_PerfCounter GetCounter(HAL_PerfCounterType type) {
+  HAL_PerfCounter counters[HAL_kPerfCounterCount];
+  HAL_GetPerfCounters(counters, HAL_kPerfCounterCount);
+  return counters[type];
+}
+
+TEST(PerfCountersTests, DisabledRecordsNothing) {
+  HAL_SetPerfCountersEnabled(false);
+  auto before = GetCounter(HAL_kPerfCounterSPI);
+  { PerfCounterScope scope(HAL_kPerfCounterSPI); }
+  HAL_RecordPerfCounter(HAL_kPerfCounterSPI, 100);
+  auto after = GetCounter(HAL_kPerfCounterSPI);
+  EXPECT_EQ(before.count, after.count);
+  EXPECT_EQ(before.totalTime, after.totalTime);
+}
+
+TEST(PerfCountersTests, SumsThreadsIncludingExited) {
+  HAL_SetPerfCountersEnabled(true);
+  auto before = GetCounter(HAL_kPerfCounterI2C);
+  HAL_RecordPerfCounter(HAL_kPerfCounterI2C, 10);
+  std::thread([] {
+    HAL_RecordPerfCounter(HAL_kPerfCounterI2C, 20);
+    HAL_RecordPerfCounter(HAL_kPerfCounterI2C, 30);
+  }).join();
+  auto after = GetCounter(HAL_kPerfCounterI2C);
+  HAL_SetPerfCountersEnabled(false);
+  EXPECT_EQ(before.count + 3, after.count);
+  EXPECT_EQ(before.totalTime + 60, after.totalTime);
+  EXPECT_LE(30u, after.maxTime);
+}
+
+TEST(PerfCountersTests, ResetMaximums) {
+  HAL_SetPerfCountersEnabled(true);
+  HAL_RecordPerfCounter(HAL_kPerfCounterCAN, 1000);
+  std::thread([] { HAL_RecordPerfCounter(HAL_kPerfCounterCAN, 2000); })
+      .join();
+  EXPECT_EQ(2000u, GetCounter(HAL_kPerfCounterCAN).maxTime);
+  HAL_ResetPerfCounterMaximums();
+  EXPECT_EQ(0u, GetCounter(HAL_kPerfCounterCAN).maxTime);
+  HAL_RecordPerfCounter(HAL_kPerfCounterCAN, 5);
+  HAL_SetPerfCountersEnabled(false);
+  EXPECT_EQ(5u, GetCounter(HAL_kPerfCounterCAN).maxTime);
+}
+
+TEST(PerfCountersTests, ScopeCountsCall) {
+  HAL_SetPerfCountersEnabled(true);
+  auto before = GetCounter(HAL_kPerfCounterDIO);
+  { PerfCounterScope scope(HAL_kPerfCounterDIO); }
+  CountPerfEvent(HAL_kPerfCounterDIO);
+  HAL_SetPerfCountersEnabled(false);
+  EXPECT_EQ(before.count + 2, GetCounter(HAL_kPerfCounterDIO).count);
+}
+
+}  // namespace hal
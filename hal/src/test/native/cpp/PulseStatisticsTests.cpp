@@ -0,0 +1,68 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HAL/cpp/PulseStatistics.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+TEST(PulseStatisticsTests, DutyCycleAndFrequency) {
+  PulseStatistics statistics(8);
+  // 1 kHz, 25% duty cycle, the even pulses 2 us longer than the odd ones
+  for (int i = 0; i < 20; i++) {
+    double rising = i * 1e-3;
+    statistics.AddEdge(rising, true);
+    statistics.AddEdge(rising + (i % 2 ? 250e-6 : 252e-6), false);
+  }
+
+  HAL_CounterPulseStatistics stats;
+  statistics.GetStatistics(&stats);
+  EXPECT_EQ(8, stats.count);
+  EXPECT_NEAR(1e-3, stats.periodMean, 1e-9);
+  EXPECT_NEAR(0.0, stats.periodJitter, 1e-9);
+  EXPECT_NEAR(1000.0, stats.frequency, 1e-3);
+  EXPECT_NEAR(250e-6, stats.widthMin, 1e-9);
+  EXPECT_NEAR(252e-6, stats.widthMax, 1e-9);
+  EXPECT_NEAR(251e-6, stats.widthMean, 1e-9);
+  EXPECT_NEAR(1e-6, stats.widthJitter, 1e-9);
+  EXPECT_NEAR(0.251, stats.dutyCycle, 1e-6);
+}
+
+TEST(PulseStatisticsTests, MissedEdgeDropsPulse) {
+  PulseStatistics statistics(8);
+  statistics.AddEdge(0.000, true);
+  statistics.AddEdge(0.001, true);  // falling edge missed
+  statistics.AddEdge(0.0015, false);
+  statistics.AddEdge(0.002, true);
+
+  HAL_CounterPulseStatistics stats;
+  statistics.GetStatistics(&stats);
+  EXPECT_EQ(1, stats.count);
+  EXPECT_NEAR(0.001, stats.periodMean, 1e-9);
+  EXPECT_NEAR(0.0005, stats.widthMean, 1e-9);
+}
+
+TEST(PulseStatisticsTests, Histogram) {
+  PulseStatistics statistics(16);
+  double periods[] = {0.9e-3, 1.0e-3, 1.0e-3, 1.1e-3, 5e-3};
+  double time = 0.0;
+  statistics.AddEdge(time, true);
+  for (double period : periods) {
+    statistics.AddEdge(time + period / 2, false);
+    time += period;
+    statistics.AddEdge(time, true);
+  }
+
+  int32_t bins[3];
+  EXPECT_EQ(5, statistics.GetHistogram(false, 0.85e-3, 1.15e-3, bins, 3));
+  EXPECT_EQ(1, bins[0]);
+  EXPECT_EQ(2, bins[1]);
+  // 1.1 ms and the out of range 5 ms period
+  EXPECT_EQ(2, bins[2]);
+}
+
+}  // namespace hal
@@ -0,0 +1,45 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <memory>
+#include <vector>
+
+#include "HAL/cpp/RTAllocationCheck.h"
+#include "HAL/cpp/make_unique.h"
+#include "gtest/gtest.h"
+
+namespace hal {
+
+static int rtAllocations = 0;
+// Kept out of the test so the allocations can not be elided
+static std::unique_ptr<int> allocated[3];
+
+static void CountAllocation(size_t size) {
+  rtAllocations++;
+  // Allocating from the handler must not recurse
+  std::vector<int> scratch(4);
+}
+
+TEST(RTMemoryTests, ReportsAllocationsOnRTThread) {
+  SetRTAllocationHandler(CountAllocation);
+  rtAllocations = 0;
+  allocated[0] = std::make_unique<int>(1);
+  EXPECT_EQ(0, rtAllocations);
+
+  RegisterRTThread();
+  allocated[1] = std::make_unique<int>(2);
+  int stack = 3;
+  UnregisterRTThread();
+  EXPECT_EQ(1, rtAllocations);
+  EXPECT_EQ(3, stack);
+
+  allocated[2] = std::make_unique<int>(4);
+  EXPECT_EQ(1, rtAllocations);
+  SetRTAllocationHandler(nullptr);
+}
+
+}  // namespace hal
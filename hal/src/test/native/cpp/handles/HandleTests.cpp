@@ -7,12 +7,20 @@
 
 #include "HAL/HAL.h"
 #include "HAL/handles/IndexedClassedHandleResource.h"
+#include "HAL/handles/LimitedHandleResource.h"
+#include "HAL/handles/UnlimitedHandleResource.h"
 #include "gtest/gtest.h"
 
 #define HAL_TestHandle HAL_Handle
 
 namespace {
 class MyTestClass {};
+
+struct DestroyCounter {
+  static int destroyed;
+  ~DestroyCounter() { destroyed++; }
+};
+int DestroyCounter::destroyed = 0;
 }  // namespace
 
 namespace hal {
@@ -25,4 +33,69 @@ TEST(HandleTests, ClassedHandleTest) {
   EXPECT_EQ(0, status);
 }
 
+TEST(HandleTests, BorrowedHandleTest) {
+  hal::LimitedHandleResource<HAL_TestHandle, MyTestClass, 8,
+                             HAL_HandleEnum::Vendor>
+      testClass;
+  auto handle = testClass.Allocate();
+  ASSERT_NE(HAL_kInvalidHandle, handle);
+  EXPECT_EQ(testClass.Get(handle).get(), testClass.GetBorrowed(handle).get());
+  testClass.Free(handle);
+  EXPECT_EQ(nullptr, testClass.GetBorrowed(handle));
+}
+
+TEST(HandleTests, BorrowedOutlivesFreeTest) {
+  hal::LimitedHandleResource<HAL_TestHandle, DestroyCounter, 8,
+                             HAL_HandleEnum::Vendor>
+      testClass;
+  DestroyCounter::destroyed = 0;
+  auto handle = testClass.Allocate();
+  ASSERT_NE(HAL_kInvalidHandle, handle);
+  {
+    auto borrowed = testClass.GetBorrowed(handle);
+    ASSERT_NE(nullptr, borrowed);
+    testClass.Free(handle);
+    EXPECT_EQ(0, DestroyCounter::destroyed);
+    EXPECT_EQ(nullptr, testClass.GetBorrowed(handle));
+  }
+  EXPECT_EQ(1, DestroyCounter::destroyed);
+
+  // with nothing borrowed, freeing destroys the structure immediately
+  handle = testClass.Allocate();
+  testClass.Free(handle);
+  EXPECT_EQ(2, DestroyCounter::destroyed);
+}
+
+TEST(HandleTests, UnlimitedReuseTest) {
+  hal::UnlimitedHandleResource<HAL_TestHandle, MyTestClass,
+                               HAL_HandleEnum::Vendor>
+      testClass;
+  auto first = testClass.Allocate(std::make_shared<MyTestClass>());
+  auto second = testClass.Allocate(std::make_shared<MyTestClass>());
+  testClass.Allocate(std::make_shared<MyTestClass>());
+  EXPECT_NE(nullptr, testClass.Free(second));
+  EXPECT_EQ(nullptr, testClass.Free(second));
+  EXPECT_EQ(second, testClass.Allocate(std::make_shared<MyTestClass>()));
+
+  int count = 0;
+  testClass.ForEachSnapshot([&](HAL_TestHandle, MyTestClass*) { count++; });
+  EXPECT_EQ(3, count);
+
+  testClass.Free(first);
+  count = 0;
+  testClass.ForEachSnapshot([&](HAL_TestHandle, MyTestClass*) { count++; });
+  EXPECT_EQ(2, count);
+}
+
+TEST(HandleTests, UnlimitedSnapshotReleaseTest) {
+  hal::UnlimitedHandleResource<HAL_TestHandle, MyTestClass,
+                               HAL_HandleEnum::Vendor>
+      testClass;
+  auto handle = testClass.Allocate(std::make_shared<MyTestClass>());
+  testClass.ForEachSnapshot([](HAL_TestHandle, MyTestClass*) {});
+  auto structure = testClass.Free(handle);
+  ASSERT_NE(nullptr, structure);
+  EXPECT_EQ(1, structure.use_count());
+}
+
 }  // namespace hal
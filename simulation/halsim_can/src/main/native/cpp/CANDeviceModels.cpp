@@ -0,0 +1,160 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "CANDeviceModels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <HAL/HAL.h>
+#include <HAL/Ports.h>
+#include <MockData/DriverStationData.h>
+#include <MockData/PCMData.h>
+#include <MockData/PDPData.h>
+#include <MockData/RoboRioData.h>
+
+// Frame IDs, from the CTRE drivers in the athena HAL; the module number is
+// in the low bits
+static constexpr uint32_t kPDPStatus1 = 0x8041400;
+static constexpr uint32_t kPDPStatus2 = 0x8041440;
+static constexpr uint32_t kPDPStatus3 = 0x8041480;
+static constexpr uint32_t kPDPStatusEnergy = 0x8041740;
+static constexpr uint32_t kPDPControl1 = 0x08041C00;
+
+static constexpr uint32_t kPCMStatus1 = 0x9041400;
+static constexpr uint32_t kPCMStatusSolFaults = 0x9041440;
+static constexpr uint32_t kPCMControl1 = 0x09041C00;
+
+// Scales a value to a fixed point field, clamped to its width
+static uint32_t ToRaw(double value, double scale, double offset,
+                      uint32_t max) {
+  double raw = std::round((value - offset) / scale);
+  if (raw < 0) return 0;
+  return std::min(static_cast<uint32_t>(std::min(raw, 4294967295.0)), max);
+}
+
+CANPDPModel::CANPDPModel(int32_t module) : m_module(module) {}
+
+void CANPDPModel::Attach(HALSimCAN& bus) {
+  const uint32_t statusIDs[] = {kPDPStatus1, kPDPStatus2, kPDPStatus3};
+  for (int i = 0; i < 3; i++) {
+    bus.AddPeriodicFrame(statusIDs[i] | m_module, kStatusPeriodMs,
+                         [=](uint8_t* data) { return FillStatus(i, data); });
+  }
+  bus.AddPeriodicFrame(kPDPStatusEnergy | m_module, kEnergyPeriodMs,
+                       [=](uint8_t* data) { return FillEnergy(data); });
+}
+
+void CANPDPModel::OnMessage(uint32_t messageID, const uint8_t* data,
+                            uint8_t dataSize) {
+  if (messageID == (kPDPControl1 | m_module)) m_clearEnergy = true;
+}
+
+uint8_t CANPDPModel::FillStatus(int frame, uint8_t* data) {
+  // Each frame packs six 10-bit currents (four in the last frame), in units
+  // of 0.125 A
+  uint32_t raw[6] = {0};
+  int channels = frame < 2 ? 6 : 4;
+  for (int i = 0; i < channels; i++) {
+    raw[i] = ToRaw(HALSIM_GetPDPCurrent(m_module, frame * 6 + i), 0.125, 0,
+                   1023);
+  }
+  data[0] = raw[0] >> 2;
+  data[1] = ((raw[0] & 0x03) << 6) | (raw[1] >> 4);
+  data[2] = ((raw[1] & 0x0F) << 4) | (raw[2] >> 6);
+  data[3] = ((raw[2] & 0x3F) << 2) | (raw[3] >> 8);
+  data[4] = raw[3] & 0xFF;
+  if (frame < 2) {
+    data[5] = raw[4] >> 2;
+    data[6] = ((raw[4] & 0x03) << 6) | (raw[5] >> 4);
+    data[7] = (raw[5] & 0x0F) << 4;
+  } else {
+    // Battery resistance is not simulated
+    data[5] = 0;
+    data[6] = ToRaw(HALSIM_GetPDPVoltage(m_module), 0.05, 4.0, 255);
+    data[7] = ToRaw(HALSIM_GetPDPTemperature(m_module), 1.03250836957542,
+                    -67.8564500484966, 255);
+  }
+  return 8;
+}
+
+uint8_t CANPDPModel::FillEnergy(uint8_t* data) {
+  int32_t status = 0;
+  uint64_t now = HAL_GetFPGATime(&status);
+
+  double current = 0;
+  for (int i = 0; i < HAL_GetNumPDPChannels(); i++) {
+    current += HALSIM_GetPDPCurrent(m_module, i);
+  }
+  double power = current * HALSIM_GetPDPVoltage(m_module);
+  if (m_clearEnergy.exchange(false)) m_energy = 0;
+  if (m_lastEnergyTime != 0) {
+    m_energy += power * (now - m_lastEnergyTime) * 1e-6;
+  }
+  m_lastEnergyTime = now;
+
+  // Energy is in units of 0.125 mW over the measurement period
+  uint32_t totalCurrent = ToRaw(current, 0.125, 0, 0xFFF);
+  uint32_t totalPower = ToRaw(power, 0.125, 0, 0xFFFF);
+  uint32_t energy =
+      ToRaw(m_energy, 0.125 * 0.001 * kEnergyPeriodMs, 0, 0xFFFFFFF);
+  data[0] = kEnergyPeriodMs;
+  data[1] = totalCurrent >> 4;
+  data[2] = ((totalCurrent & 0x0F) << 4) | (totalPower >> 12);
+  data[3] = (totalPower >> 4) & 0xFF;
+  data[4] = ((totalPower & 0x0F) << 4) | (energy >> 24);
+  data[5] = (energy >> 16) & 0xFF;
+  data[6] = (energy >> 8) & 0xFF;
+  data[7] = energy & 0xFF;
+  return 8;
+}
+
+CANPCMModel::CANPCMModel(int32_t module) : m_module(module) {}
+
+void CANPCMModel::Attach(HALSimCAN& bus) {
+  bus.AddPeriodicFrame(kPCMStatus1 | m_module, kStatusPeriodMs,
+                       [=](uint8_t* data) { return FillStatus(data); });
+  // No solenoid is ever blacklisted or faulted
+  bus.AddPeriodicFrame(kPCMStatusSolFaults | m_module, kFaultsPeriodMs,
+                       [](uint8_t* data) -> uint8_t { return 8; });
+}
+
+void CANPCMModel::OnMessage(uint32_t messageID, const uint8_t* data,
+                            uint8_t dataSize) {
+  if (messageID != (kPCMControl1 | m_module) || dataSize < 4) return;
+  for (int i = 0; i < HAL_GetNumSolenoidChannels(); i++) {
+    HALSIM_SetPCMSolenoidOutput(m_module, i, (data[2] >> i) & 1);
+  }
+  HALSIM_SetPCMClosedLoopEnabled(m_module, (data[3] >> 6) & 1);
+}
+
+uint8_t CANPCMModel::FillStatus(uint8_t* data) {
+  uint8_t solenoids = 0;
+  for (int i = 0; i < HAL_GetNumSolenoidChannels(); i++) {
+    if (HALSIM_GetPCMSolenoidOutput(m_module, i)) solenoids |= 1 << i;
+  }
+  bool compressorOn = HALSIM_GetPCMCompressorOn(m_module);
+  double battery = HALSIM_GetRoboRioVInVoltage(0);
+  // Solenoids are powered from the battery
+  uint32_t solenoidVoltage = ToRaw(battery, 0.03125, 0, 0x3FF);
+  uint32_t compressorCurrent =
+      ToRaw(HALSIM_GetPCMCompressorCurrent(m_module), 0.03125, 0, 0x3FF);
+
+  data[0] = solenoids;
+  data[1] = (compressorOn ? 0x01 : 0) |
+            (HALSIM_GetPCMClosedLoopEnabled(m_module) ? 0x40 : 0) |
+            (HALSIM_GetPCMPressureSwitch(m_module) ? 0x80 : 0);
+  data[2] = ToRaw(battery, 0.05, 4.0, 255);
+  data[3] = solenoidVoltage >> 2;
+  data[4] = ((solenoidVoltage & 0x03) << 6) | (compressorCurrent >> 4);
+  // The module's outputs are enabled with the robot
+  data[5] = (HALSIM_GetDriverStationEnabled() ? 0x04 : 0) |
+            (compressorOn ? 0x08 : 0) | ((compressorCurrent & 0x0F) << 4);
+  data[6] = 0;
+  data[7] = 0;
+  return 8;
+}
@@ -0,0 +1,342 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HALSimCAN.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <HAL/HAL.h>
+#include <HAL/Notifier.h>
+#include <MockData/CanData.h>
+
+// Frame lengths in bits, without stuff bits: start of frame, arbitration,
+// control, CRC, acknowledge, end of frame and interframe space
+static constexpr uint32_t kStandardFrameBits = 47;
+static constexpr uint32_t kExtendedFrameBits = 67;
+
+HALSimCAN& HALSimCAN::GetInstance() {
+  static HALSimCAN instance;
+  return instance;
+}
+
+void HALSimCAN::Initialize() {
+  int32_t status = 0;
+  m_notifier = HAL_InitializeNotifier(&status);
+  if (status != 0) return;
+
+  HALSIM_RegisterCanSendMessageCallback(SendMessageCallback, this);
+  HALSIM_RegisterCanReceiveMessageCallback(ReceiveMessageCallback, this);
+  HALSIM_RegisterCanOpenStreamCallback(OpenStreamCallback, this);
+  HALSIM_RegisterCanCloseStreamCallback(CloseStreamCallback, this);
+  HALSIM_RegisterCanReadStreamCallback(ReadStreamCallback, this);
+  HALSIM_RegisterCanGetCANStatusCallback(GetCANStatusCallback, this);
+
+  m_thread = std::thread(&HALSimCAN::ThreadMain, this);
+  m_thread.detach();
+}
+
+void HALSimCAN::AddModel(std::shared_ptr<CANDeviceModel> model) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    auto models =
+        std::make_shared<std::vector<std::shared_ptr<CANDeviceModel>>>();
+    if (m_models) *models = *m_models;
+    models->push_back(model);
+    m_models = std::move(models);
+  }
+  model->Attach(*this);
+}
+
+/**
+ * Sends a frame from a device every periodMs milliseconds of simulated time,
+ * starting one period from now. The source fills in the frame each time.
+ */
+void HALSimCAN::AddPeriodicFrame(uint32_t messageID, int32_t periodMs,
+                                 FrameSource source) {
+  if (periodMs <= 0) return;
+  int32_t status = 0;
+  uint64_t now = HAL_GetFPGATime(&status);
+  PeriodicFrame frame;
+  frame.messageID = messageID;
+  frame.period = static_cast<uint64_t>(periodMs) * 1000;
+  frame.nextTime = now + frame.period;
+  frame.fromRobot = false;
+  frame.dataSize = 0;
+  frame.source = std::move(source);
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_periodicFrames.emplace_back(std::move(frame));
+  RescheduleLocked();
+}
+
+void HALSimCAN::Receive(uint32_t messageID, const uint8_t* data,
+                        uint8_t dataSize) {
+  int32_t status = 0;
+  uint64_t now = HAL_GetFPGATime(&status);
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  Occupy(messageID, dataSize, now, false);
+  Deliver(messageID, data, dataSize, now);
+}
+
+void HALSimCAN::Send(uint32_t messageID, const uint8_t* data,
+                     uint8_t dataSize, int32_t periodMs) {
+  if (dataSize > 8) dataSize = 8;
+  int32_t status = 0;
+  uint64_t now = HAL_GetFPGATime(&status);
+  bool sent;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    auto it = std::find_if(m_periodicFrames.begin(), m_periodicFrames.end(),
+                           [=](const PeriodicFrame& frame) {
+                             return frame.fromRobot &&
+                                    frame.messageID == messageID;
+                           });
+    if (periodMs == HAL_CAN_SEND_PERIOD_STOP_REPEATING) {
+      if (it != m_periodicFrames.end()) {
+        m_periodicFrames.erase(it);
+        RescheduleLocked();
+      }
+      return;
+    }
+
+    sent = Occupy(messageID, dataSize, now, true);
+
+    if (periodMs > 0) {
+      if (it == m_periodicFrames.end()) {
+        m_periodicFrames.emplace_back();
+        it = m_periodicFrames.end() - 1;
+      }
+      it->messageID = messageID;
+      it->period = static_cast<uint64_t>(periodMs) * 1000;
+      it->nextTime = now + it->period;
+      it->fromRobot = true;
+      std::memcpy(it->data, data, dataSize);
+      it->dataSize = dataSize;
+      RescheduleLocked();
+    } else if (it != m_periodicFrames.end()) {
+      // A single send replaces a repeating frame
+      m_periodicFrames.erase(it);
+      RescheduleLocked();
+    }
+  }
+  if (sent) Dispatch(messageID, data, dataSize);
+}
+
+bool HALSimCAN::Occupy(uint32_t messageID, uint8_t dataSize, uint64_t now,
+                       bool transmit) {
+  uint32_t bits = ((messageID & HAL_CAN_IS_FRAME_11BIT) ? kStandardFrameBits
+                                                        : kExtendedFrameBits) +
+                  8 * dataSize;
+  double start = std::max(m_busFreeTime, static_cast<double>(now));
+  if (transmit && start - now > kMaxTxBacklog * 1e6) {
+    m_txFullCount++;
+    return false;
+  }
+  m_busFreeTime = start + bits / kBitRate * 1e6;
+
+  m_traffic.emplace_back(now, bits);
+  m_trafficBits += bits;
+  while (m_traffic.front().first + kUtilizationWindow * 1e6 < now) {
+    m_trafficBits -= m_traffic.front().second;
+    m_traffic.pop_front();
+  }
+  return true;
+}
+
+void HALSimCAN::Deliver(uint32_t messageID, const uint8_t* data,
+                        uint8_t dataSize, uint64_t now) {
+  if (dataSize > 8) dataSize = 8;
+  // Like the roboRIO, time stamps are in milliseconds
+  uint32_t timeStamp = static_cast<uint32_t>(now / 1000);
+
+  ReceivedFrame& frame = m_receivedFrames[messageID];
+  std::memcpy(frame.data, data, dataSize);
+  frame.dataSize = dataSize;
+  frame.timeStamp = timeStamp;
+  frame.fresh = true;
+
+  for (auto& entry : m_streamSessions) {
+    StreamSession& session = entry.second;
+    if ((messageID & session.messageIDMask) !=
+        (session.messageID & session.messageIDMask)) {
+      continue;
+    }
+    // Like the roboRIO, a full session drops its oldest messages
+    if (session.messages.size() >= session.maxMessages) {
+      session.messages.pop_front();
+      session.overrun = true;
+    }
+    HAL_CANStreamMessage message;
+    message.messageID = messageID;
+    message.timeStamp = timeStamp;
+    std::memcpy(message.data, data, dataSize);
+    message.dataSize = dataSize;
+    session.messages.push_back(message);
+  }
+}
+
+void HALSimCAN::Dispatch(uint32_t messageID, const uint8_t* data,
+                         uint8_t dataSize) {
+  std::shared_ptr<const std::vector<std::shared_ptr<CANDeviceModel>>> models;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    models = m_models;
+  }
+  if (!models) return;
+  for (auto& model : *models) model->OnMessage(messageID, data, dataSize);
+}
+
+void HALSimCAN::RescheduleLocked() {
+  int32_t status = 0;
+  if (m_periodicFrames.empty()) {
+    HAL_CancelNotifierAlarm(m_notifier, &status);
+    return;
+  }
+  uint64_t nextTime = m_periodicFrames.front().nextTime;
+  for (const auto& frame : m_periodicFrames) {
+    nextTime = std::min(nextTime, frame.nextTime);
+  }
+  HAL_UpdateNotifierAlarm(m_notifier, nextTime, &status);
+}
+
+void HALSimCAN::ThreadMain() {
+  for (;;) {
+    int32_t status = 0;
+    uint64_t curTime = HAL_WaitForNotifierAlarm(m_notifier, &status);
+    if (curTime == 0 || status != 0) break;
+
+    m_dueFrames.clear();
+    {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      for (auto& frame : m_periodicFrames) {
+        if (frame.nextTime > curTime) continue;
+        if (frame.fromRobot) {
+          if (Occupy(frame.messageID, frame.dataSize, curTime, true)) {
+            m_dueFrames.push_back(frame);
+          }
+        } else {
+          uint8_t data[8] = {0};
+          uint8_t dataSize = frame.source(data);
+          Occupy(frame.messageID, dataSize, curTime, false);
+          Deliver(frame.messageID, data, dataSize, curTime);
+        }
+        frame.nextTime += frame.period;
+        // Skip periods missed while the host was busy rather than bursting
+        if (frame.nextTime <= curTime) frame.nextTime = curTime + frame.period;
+      }
+      RescheduleLocked();
+    }
+
+    for (const auto& frame : m_dueFrames) {
+      Dispatch(frame.messageID, frame.data, frame.dataSize);
+    }
+  }
+}
+
+void HALSimCAN::SendMessageCallback(const char* name, void* param,
+                                    uint32_t messageID, const uint8_t* data,
+                                    uint8_t dataSize, int32_t periodMs,
+                                    int32_t* status) {
+  static_cast<HALSimCAN*>(param)->Send(messageID, data, dataSize, periodMs);
+  *status = 0;
+}
+
+void HALSimCAN::ReceiveMessageCallback(const char* name, void* param,
+                                       uint32_t* messageID,
+                                       uint32_t messageIDMask, uint8_t* data,
+                                       uint8_t* dataSize, uint32_t* timeStamp,
+                                       int32_t* status) {
+  auto bus = static_cast<HALSimCAN*>(param);
+  std::lock_guard<wpi::mutex> lock(bus->m_mutex);
+  for (auto& entry : bus->m_receivedFrames) {
+    ReceivedFrame& frame = entry.second;
+    if (!frame.fresh ||
+        (entry.first & messageIDMask) != (*messageID & messageIDMask)) {
+      continue;
+    }
+    *messageID = entry.first;
+    std::memcpy(data, frame.data, frame.dataSize);
+    *dataSize = frame.dataSize;
+    *timeStamp = frame.timeStamp;
+    frame.fresh = false;
+    *status = 0;
+    return;
+  }
+  *status = HAL_ERR_CANSessionMux_MessageNotFound;
+}
+
+void HALSimCAN::OpenStreamCallback(const char* name, void* param,
+                                   uint32_t* sessionHandle, uint32_t messageID,
+                                   uint32_t messageIDMask,
+                                   uint32_t maxMessages, int32_t* status) {
+  auto bus = static_cast<HALSimCAN*>(param);
+  std::lock_guard<wpi::mutex> lock(bus->m_mutex);
+  *sessionHandle = bus->m_nextSessionHandle++;
+  StreamSession& session = bus->m_streamSessions[*sessionHandle];
+  session.messageID = messageID;
+  session.messageIDMask = messageIDMask;
+  session.maxMessages = maxMessages;
+  session.overrun = false;
+  *status = 0;
+}
+
+void HALSimCAN::CloseStreamCallback(const char* name, void* param,
+                                    uint32_t sessionHandle) {
+  auto bus = static_cast<HALSimCAN*>(param);
+  std::lock_guard<wpi::mutex> lock(bus->m_mutex);
+  bus->m_streamSessions.erase(sessionHandle);
+}
+
+void HALSimCAN::ReadStreamCallback(const char* name, void* param,
+                                   uint32_t sessionHandle,
+                                   struct HAL_CANStreamMessage* messages,
+                                   uint32_t messagesToRead,
+                                   uint32_t* messagesRead, int32_t* status) {
+  auto bus = static_cast<HALSimCAN*>(param);
+  std::lock_guard<wpi::mutex> lock(bus->m_mutex);
+  *messagesRead = 0;
+  auto it = bus->m_streamSessions.find(sessionHandle);
+  if (it == bus->m_streamSessions.end()) {
+    *status = HAL_ERR_CANSessionMux_NotAllowed;
+    return;
+  }
+  StreamSession& session = it->second;
+  while (*messagesRead < messagesToRead && !session.messages.empty()) {
+    messages[(*messagesRead)++] = session.messages.front();
+    session.messages.pop_front();
+  }
+  if (session.overrun) {
+    session.overrun = false;
+    *status = HAL_ERR_CANSessionMux_SessionOverrun;
+  } else {
+    *status = 0;
+  }
+}
+
+void HALSimCAN::GetCANStatusCallback(
+    const char* name, void* param, float* percentBusUtilization,
+    uint32_t* busOffCount, uint32_t* txFullCount, uint32_t* receiveErrorCount,
+    uint32_t* transmitErrorCount, int32_t* status) {
+  auto bus = static_cast<HALSimCAN*>(param);
+  int32_t timeStatus = 0;
+  uint64_t now = HAL_GetFPGATime(&timeStatus);
+  std::lock_guard<wpi::mutex> lock(bus->m_mutex);
+  while (!bus->m_traffic.empty() &&
+         bus->m_traffic.front().first + kUtilizationWindow * 1e6 < now) {
+    bus->m_trafficBits -= bus->m_traffic.front().second;
+    bus->m_traffic.pop_front();
+  }
+  double utilization =
+      bus->m_trafficBits / (kBitRate * kUtilizationWindow) * 100;
+  *percentBusUtilization = static_cast<float>(std::min(utilization, 100.0));
+  *busOffCount = 0;
+  *txFullCount = bus->m_txFullCount;
+  *receiveErrorCount = 0;
+  *transmitErrorCount = 0;
+  *status = 0;
+}
@@ -0,0 +1,29 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <iostream>
+#include <memory>
+
+#include "CANDeviceModels.h"
+#include "HALSimCAN.h"
+
+extern "C" {
+#if defined(WIN32) || defined(_WIN32)
+__declspec(dllexport)
+#endif
+    int HALSIM_InitExtension(void) {
+  std::cout << "CAN Simulator Initializing." << std::endl;
+
+  auto& bus = HALSimCAN::GetInstance();
+  bus.Initialize();
+  // The default PDP and PCM module numbers
+  bus.AddModel(std::make_shared<CANPDPModel>(0));
+  bus.AddModel(std::make_shared<CANPCMModel>(0));
+
+  return 0;
+}
+}  // extern "C"
@@ -0,0 +1,65 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "HALSimCAN.h"
+
+/**
+ * A CTRE Power Distribution Panel, sending the status frames the real
+ * device does from its simulated MockData values. The energy frame
+ * integrates the simulated power, and is cleared by the clear stats control
+ * frame.
+ */
+class CANPDPModel : public CANDeviceModel {
+ public:
+  static constexpr int32_t kStatusPeriodMs = 25;
+  static constexpr int32_t kEnergyPeriodMs = 100;
+
+  explicit CANPDPModel(int32_t module);
+
+  void Attach(HALSimCAN& bus) override;
+  void OnMessage(uint32_t messageID, const uint8_t* data,
+                 uint8_t dataSize) override;
+
+ private:
+  uint8_t FillStatus(int frame, uint8_t* data);
+  uint8_t FillEnergy(uint8_t* data);
+
+  int32_t m_module;
+  // Energy since the last clear, in joules; only used by FillEnergy()
+  double m_energy = 0;
+  uint64_t m_lastEnergyTime = 0;
+  // Set by the clear stats control frame, consumed by FillEnergy()
+  std::atomic<bool> m_clearEnergy{false};
+};
+
+/**
+ * A CTRE Pneumatics Control Module, sending its status frames from the
+ * simulated MockData values. Control frames sent by the program set the
+ * solenoid outputs and closed loop control.
+ */
+class CANPCMModel : public CANDeviceModel {
+ public:
+  static constexpr int32_t kStatusPeriodMs = 20;
+  static constexpr int32_t kFaultsPeriodMs = 100;
+
+  explicit CANPCMModel(int32_t module);
+
+  void Attach(HALSimCAN& bus) override;
+  void OnMessage(uint32_t messageID, const uint8_t* data,
+                 uint8_t dataSize) override;
+
+ private:
+  uint8_t FillStatus(uint8_t* data);
+
+  int32_t m_module;
+};
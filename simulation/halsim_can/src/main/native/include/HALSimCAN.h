@@ -0,0 +1,174 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <HAL/CAN.h>
+#include <HAL/Types.h>
+#include <support/mutex.h>
+
+class HALSimCAN;
+
+/**
+ * A device on the simulated CAN bus.
+ */
+class CANDeviceModel {
+ public:
+  virtual ~CANDeviceModel() = default;
+
+  // Registers the frames the device sends periodically
+  virtual void Attach(HALSimCAN& bus) = 0;
+
+  // Called with every frame the robot program puts on the bus, including
+  // each repeat of a periodic frame
+  virtual void OnMessage(uint32_t messageID, const uint8_t* data,
+                         uint8_t dataSize) {}
+};
+
+/**
+ * A simulated CAN bus, connecting the robot program's CAN calls to device
+ * models.
+ *
+ * Frames the program sends are routed to every model, and repeated by the
+ * bus when sent with a period, like the roboRIO does. Frames from devices
+ * are kept for HAL_CAN_ReceiveMessage(), which like the roboRIO only returns
+ * a frame once, and queued in every matching stream session.
+ *
+ * Every frame occupies the bus for its length at kBitRate, which is counted
+ * in the utilization HAL_CAN_GetCANStatus() reports over the last
+ * kUtilizationWindow. Transmissions that would wait behind more than
+ * kMaxTxBacklog of queued traffic are dropped and counted as TX full, so a
+ * saturated bus shows up in simulation. Time is simulated FPGA time, so the
+ * accounting also holds while timing is paused.
+ *
+ * Do not load this together with halsim_replay, which also answers CAN
+ * receives. Currently, robots never terminate, so there is a single static
+ * instance that is never cleaned up.
+ */
+class HALSimCAN {
+ public:
+  // Fills the data of a periodic device frame and returns its size. Sources
+  // are called with the bus locked, so they must not call CAN functions.
+  typedef std::function<uint8_t(uint8_t* data)> FrameSource;
+
+  static constexpr double kBitRate = 1e6;
+  static constexpr double kUtilizationWindow = 0.1;
+  static constexpr double kMaxTxBacklog = 0.002;
+
+  static HALSimCAN& GetInstance();
+
+  void Initialize();
+
+  void AddModel(std::shared_ptr<CANDeviceModel> model);
+
+  // Sends a device frame every periodMs milliseconds
+  void AddPeriodicFrame(uint32_t messageID, int32_t periodMs,
+                        FrameSource source);
+
+  // Puts a frame from a device on the bus
+  void Receive(uint32_t messageID, const uint8_t* data, uint8_t dataSize);
+
+ private:
+  struct PeriodicFrame {
+    uint32_t messageID;
+    uint64_t period;
+    uint64_t nextTime;
+    // Frames the program sent with a period carry their data; device frames
+    // have a source instead
+    bool fromRobot;
+    uint8_t data[8];
+    uint8_t dataSize;
+    FrameSource source;
+  };
+
+  struct ReceivedFrame {
+    uint8_t data[8];
+    uint8_t dataSize;
+    uint32_t timeStamp;
+    bool fresh;
+  };
+
+  struct StreamSession {
+    uint32_t messageID;
+    uint32_t messageIDMask;
+    uint32_t maxMessages;
+    bool overrun;
+    std::deque<HAL_CANStreamMessage> messages;
+  };
+
+  static void SendMessageCallback(const char* name, void* param,
+                                  uint32_t messageID, const uint8_t* data,
+                                  uint8_t dataSize, int32_t periodMs,
+                                  int32_t* status);
+  static void ReceiveMessageCallback(const char* name, void* param,
+                                     uint32_t* messageID,
+                                     uint32_t messageIDMask, uint8_t* data,
+                                     uint8_t* dataSize, uint32_t* timeStamp,
+                                     int32_t* status);
+  static void OpenStreamCallback(const char* name, void* param,
+                                 uint32_t* sessionHandle, uint32_t messageID,
+                                 uint32_t messageIDMask, uint32_t maxMessages,
+                                 int32_t* status);
+  static void CloseStreamCallback(const char* name, void* param,
+                                  uint32_t sessionHandle);
+  static void ReadStreamCallback(const char* name, void* param,
+                                 uint32_t sessionHandle,
+                                 struct HAL_CANStreamMessage* messages,
+                                 uint32_t messagesToRead,
+                                 uint32_t* messagesRead, int32_t* status);
+  static void GetCANStatusCallback(const char* name, void* param,
+                                   float* percentBusUtilization,
+                                   uint32_t* busOffCount,
+                                   uint32_t* txFullCount,
+                                   uint32_t* receiveErrorCount,
+                                   uint32_t* transmitErrorCount,
+                                   int32_t* status);
+
+  void Send(uint32_t messageID, const uint8_t* data, uint8_t dataSize,
+            int32_t periodMs);
+  // Occupies the bus with a frame; returns false if a transmission was
+  // dropped because the bus is saturated. Must be called with m_mutex held.
+  bool Occupy(uint32_t messageID, uint8_t dataSize, uint64_t now,
+              bool transmit);
+  void Deliver(uint32_t messageID, const uint8_t* data, uint8_t dataSize,
+               uint64_t now);
+  void Dispatch(uint32_t messageID, const uint8_t* data, uint8_t dataSize);
+  void RescheduleLocked();
+  void ThreadMain();
+
+  wpi::mutex m_mutex;
+  // Replaced rather than modified, so frames can be dispatched to a snapshot
+  // without holding the lock
+  std::shared_ptr<const std::vector<std::shared_ptr<CANDeviceModel>>>
+      m_models;
+  std::vector<PeriodicFrame> m_periodicFrames;
+  std::map<uint32_t, ReceivedFrame> m_receivedFrames;
+  std::map<uint32_t, StreamSession> m_streamSessions;
+  uint32_t m_nextSessionHandle = 1;
+
+  // Bus time, in FPGA microseconds, until which queued frames occupy the bus
+  double m_busFreeTime = 0;
+  // Frames in the utilization window, as (time, bits)
+  std::deque<std::pair<uint64_t, uint32_t>> m_traffic;
+  uint64_t m_trafficBits = 0;
+  uint32_t m_txFullCount = 0;
+
+  HAL_NotifierHandle m_notifier = HAL_kInvalidHandle;
+  std::thread m_thread;
+  // Periodic frames from the program due in the current wakeup; only used by
+  // the thread
+  std::vector<PeriodicFrame> m_dueFrames;
+};
@@ -7,6 +7,12 @@
 
 #include "HALSimDsNt.h"
 
+#include <chrono>
+#include <cstring>
+
+// Rates above a real DS's 50 Hz are allowed for stress testing
+static constexpr double kMaxTimingHz = 1000;
+
 void HALSimDSNT::Initialize() {
   rootTable =
       nt::NetworkTableInstance::GetDefault().GetTable("sim")->GetSubTable(
@@ -21,7 +27,7 @@ void HALSimDSNT::Initialize() {
       [this](const nt::EntryNotification& ev) -> void {
         double valIn = ev.value->GetDouble();
         double val = 0;
-        val = (valIn < 1 ? 1 : valIn > 100 ? 100 : valIn);
+        val = (valIn < 1 ? 1 : valIn > kMaxTimingHz ? kMaxTimingHz : valIn);
 
         if (val != valIn) {
           this->rootTable->GetEntry("timing_hz").ForceSetDouble(val);
@@ -122,6 +128,37 @@ void HALSimDSNT::Initialize() {
       },
       NT_NotifyKind::NT_NOTIFY_UPDATE);
 
+  // PACKETS //
+
+  auto packetModeEntry = rootTable->GetEntry("packet_mode?");
+  auto packet = rootTable->GetEntry("packet");
+  statsTable = rootTable->GetSubTable("stats");
+
+  packetModeEntry.ForceSetBoolean(false);
+  packet.ForceSetRaw("");
+  statsTable->GetEntry("packets").ForceSetDouble(0);
+  statsTable->GetEntry("packet_errors").ForceSetDouble(0);
+  statsTable->GetEntry("latency_us").ForceSetDouble(0);
+  statsTable->GetEntry("max_latency_us").ForceSetDouble(0);
+
+  packetModeEntry.AddListener(
+      [this](const nt::EntryNotification& ev) -> void {
+        std::lock_guard<wpi::mutex> lock(modeMutex);
+        this->packetMode = ev.value->GetBoolean();
+        if (!this->packetMode) {
+          // hand the robot back to the mode and alliance entries
+          this->DoAllianceUpdate();
+          this->DoModeUpdate();
+        }
+      },
+      NT_NotifyKind::NT_NOTIFY_UPDATE);
+
+  packet.AddListener(
+      [this](const nt::EntryNotification& ev) -> void {
+        if (ev.value->IsRaw()) this->HandlePacket(ev.value->GetRaw());
+      },
+      NT_NotifyKind::NT_NOTIFY_UPDATE);
+
   // FINAL LOGIC //
 
   Flush();
@@ -158,6 +195,7 @@ void HALSimDSNT::UpdateModeButtons() {
 }
 
 void HALSimDSNT::DoModeUpdate() {
+  if (packetMode) return;
   HALSIM_SetDriverStationAutonomous(currentMode == HALSimDSNT_Mode::auton);
   HALSIM_SetDriverStationTest(currentMode == HALSimDSNT_Mode::test);
   HALSIM_SetDriverStationEnabled(isEnabled);
@@ -172,17 +210,89 @@ void HALSimDSNT::DoModeUpdate() {
 }
 
 void HALSimDSNT::DoAllianceUpdate() {
+  if (packetMode) return;
   HALSIM_SetDriverStationAllianceStationId(static_cast<HAL_AllianceStationID>(
       (isAllianceRed ? HAL_AllianceStationID_kRed1
                      : HAL_AllianceStationID_kBlue1) +
       (static_cast<int32_t>(allianceStation) - 1)));
 }
 
+// Reads a value, advancing data; false if it is too short. The sim only runs
+// on little endian hosts, like the packets.
+template <typename T>
+static bool ReadValue(llvm::StringRef& data, T* value) {
+  if (data.size() < sizeof(T)) return false;
+  std::memcpy(value, data.data(), sizeof(T));
+  data = data.drop_front(sizeof(T));
+  return true;
+}
+
+bool HALSimDSNT::DecodePacket(llvm::StringRef data, HALSIM_DSPacket* packet) {
+  std::memset(packet, 0, sizeof(*packet));
+  uint8_t word, station;
+  if (!ReadValue(data, &word) || !ReadValue(data, &station) ||
+      !ReadValue(data, &packet->matchTime) || station > 5) {
+    return false;
+  }
+  packet->controlWord.enabled = (word >> 0) & 1;
+  packet->controlWord.autonomous = (word >> 1) & 1;
+  packet->controlWord.test = (word >> 2) & 1;
+  packet->controlWord.eStop = (word >> 3) & 1;
+  packet->controlWord.fmsAttached = (word >> 4) & 1;
+  packet->controlWord.dsAttached = (word >> 5) & 1;
+  packet->allianceStationId = static_cast<HAL_AllianceStationID>(station);
+
+  for (int i = 0; i < HALSIM_kNumJoysticks && !data.empty(); i++) {
+    uint8_t count;
+    if (!ReadValue(data, &count) || count > HAL_kMaxJoystickAxes) return false;
+    packet->axes[i].count = count;
+    for (int j = 0; j < count; j++) {
+      if (!ReadValue(data, &packet->axes[i].axes[j])) return false;
+    }
+    if (!ReadValue(data, &count) || count > HAL_kMaxJoystickPOVs) return false;
+    packet->povs[i].count = count;
+    for (int j = 0; j < count; j++) {
+      if (!ReadValue(data, &packet->povs[i].povs[j])) return false;
+    }
+    if (!ReadValue(data, &packet->buttons[i].count) ||
+        !ReadValue(data, &packet->buttons[i].buttons)) {
+      return false;
+    }
+  }
+  return data.empty();
+}
+
+void HALSimDSNT::HandlePacket(llvm::StringRef data) {
+  if (!packetMode) return;
+  auto start = std::chrono::steady_clock::now();
+  HALSIM_DSPacket packet;
+  if (!DecodePacket(data, &packet)) {
+    statsTable->GetEntry("packet_errors").SetDouble(++packetErrors);
+    return;
+  }
+  HALSIM_SetDriverStationPacket(&packet);
+
+  // from the packet reaching us until the robot's DS thread is woken for it
+  double latencyUs = std::chrono::duration<double, std::micro>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+  if (latencyUs > maxLatencyUs) maxLatencyUs = latencyUs;
+  statsTable->GetEntry("packets").SetDouble(++packetCount);
+  statsTable->GetEntry("latency_us").SetDouble(latencyUs);
+  statsTable->GetEntry("max_latency_us").SetDouble(maxLatencyUs);
+}
+
 void HALSimDSNT::LoopFunc() {
+  auto next = std::chrono::steady_clock::now();
   while (running) {
     double dt = 1000 / timingHz;
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(static_cast<int64_t>(dt)));
+    // sleep until the next period instead of for one, so fast rates keep up
+    next += std::chrono::microseconds(static_cast<int64_t>(dt * 1000));
+    auto now = std::chrono::steady_clock::now();
+    if (next < now) next = now;
+    std::this_thread::sleep_until(next);
+    // packets carry their own match time and notify the robot themselves
+    if (packetMode) continue;
     if (isEnabled) {
       currentMatchTime = currentMatchTime + dt;
       HALSIM_SetDriverStationMatchTime(currentMatchTime);
@@ -7,31 +7,59 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <atomic>
 #include <memory>
 #include <thread>
 
 #include <MockData/DriverStationData.h>
+#include <llvm/StringRef.h>
 #include <networktables/NetworkTableInstance.h>
 #include <support/mutex.h>
 
 enum HALSimDSNT_Mode { teleop, auton, test };
 
+/*
+ * In packet mode ("packet_mode?" true), the robot is driven only by the raw
+ * "packet" entry, and each packet is applied at once with
+ * HALSIM_SetDriverStationPacket(). A packet is little endian:
+ *
+ *   uint8   control word: bit 0 enabled, 1 autonomous, 2 test, 3 e-stop,
+ *           4 FMS attached, 5 DS attached
+ *   uint8   alliance station, 0-2 for red 1-3 and 3-5 for blue 1-3
+ *   double  match time
+ *
+ * followed by up to 6 joysticks, each:
+ *
+ *   uint8   axis count, then that many float axes
+ *   uint8   POV count, then that many int16 POVs
+ *   uint8   button count, then uint32 buttons
+ *
+ * Joysticks the packet leaves out have nothing attached. The time taken to
+ * apply the packets is reported under "stats".
+ */
+
 class HALSimDSNT {
  public:
-  std::shared_ptr<nt::NetworkTable> rootTable, modeTable, allianceTable;
+  std::shared_ptr<nt::NetworkTable> rootTable, modeTable, allianceTable,
+      statsTable;
   enum HALSimDSNT_Mode currentMode;
   bool isEnabled, lastIsEnabled, isEstop;
-  std::atomic<bool> isAllianceRed, running;
+  std::atomic<bool> isAllianceRed, running, packetMode{false};
   std::atomic<double> currentMatchTime, timingHz, allianceStation;
   std::thread loopThread;
   wpi::mutex modeMutex;
+  int64_t packetCount = 0, packetErrors = 0;
+  double maxLatencyUs = 0;
 
   void Initialize();
   void HandleModePress(enum HALSimDSNT_Mode mode, bool isPressed);
   void UpdateModeButtons();
   void DoModeUpdate();
   void DoAllianceUpdate();
+  void HandlePacket(llvm::StringRef data);
+  static bool DecodePacket(llvm::StringRef data, HALSIM_DSPacket* packet);
   void LoopFunc();
   void Flush();
 };
@@ -0,0 +1,130 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HALSimHeadless.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <tuple>
+
+#include <HAL/HAL.h>
+#include <MockData/DriverStationData.h>
+#include <MockData/MockHooks.h>
+#include <llvm/SmallString.h>
+#include <llvm/SmallVector.h>
+#include <support/timestamp.h>
+
+static const char* GetModeName(HALSimHeadless::Mode mode) {
+  switch (mode) {
+    case HALSimHeadless::kAutonomous:
+      return "auto";
+    case HALSimHeadless::kTeleop:
+      return "teleop";
+    case HALSimHeadless::kTest:
+      return "test";
+    default:
+      return "disabled";
+  }
+}
+
+/**
+ * Parses a script of comma separated mode:seconds phases. Returns false,
+ * leaving the current script, if any phase is malformed.
+ */
+bool HALSimHeadless::ParseScript(llvm::StringRef script) {
+  llvm::SmallVector<llvm::StringRef, 4> parts;
+  script.split(parts, ',', -1, false);
+
+  std::vector<Phase> phases;
+  for (auto part : parts) {
+    llvm::StringRef name, seconds;
+    std::tie(name, seconds) = part.trim().split(':');
+
+    Phase phase;
+    if (name == "disabled") {
+      phase.mode = kDisabled;
+    } else if (name == "auto") {
+      phase.mode = kAutonomous;
+    } else if (name == "teleop") {
+      phase.mode = kTeleop;
+    } else if (name == "test") {
+      phase.mode = kTest;
+    } else {
+      return false;
+    }
+    llvm::SmallString<16> secondsStr(seconds);
+    char* end;
+    phase.duration = std::strtod(secondsStr.c_str(), &end);
+    if (seconds.empty() || *end != '\0' || !(phase.duration >= 0)) {
+      return false;
+    }
+    phases.push_back(phase);
+  }
+  if (phases.empty()) return false;
+
+  m_phases = std::move(phases);
+  return true;
+}
+
+void HALSimHeadless::Initialize() {
+  // Nothing may run on the wall clock from here on; time only moves when the
+  // runner steps it
+  HALSIM_PauseTiming();
+  HALSIM_SetDriverStationDsAttached(true);
+  m_thread = std::thread(&HALSimHeadless::Run, this);
+  m_thread.detach();
+}
+
+void HALSimHeadless::Run() {
+  HALSIM_WaitForProgramStart();
+
+  m_phaseWallTimes.clear();
+  uint64_t start = wpi::Now();
+  for (const auto& phase : m_phases) {
+    uint64_t phaseStart = wpi::Now();
+    RunPhase(phase);
+    m_phaseWallTimes.push_back((wpi::Now() - phaseStart) * 1.0e-6);
+  }
+  double wallTime = (wpi::Now() - start) * 1.0e-6;
+
+  HALSIM_SetDriverStationEnabled(false);
+  HALSIM_NotifyDriverStationNewData();
+
+  double simTime = 0;
+  std::printf("Headless match summary:\n");
+  for (size_t i = 0; i < m_phases.size(); i++) {
+    std::printf("  %-8s %8.3f s simulated %8.3f s wall\n",
+                GetModeName(m_phases[i].mode), m_phases[i].duration,
+                m_phaseWallTimes[i]);
+    simTime += m_phases[i].duration;
+  }
+  std::printf("  total    %8.3f s simulated %8.3f s wall (%.1fx)\n", simTime,
+              wallTime, wallTime > 0 ? simTime / wallTime : 0.0);
+  std::fflush(stdout);
+
+  // The robot program's threads never return, so static destructors must
+  // not run underneath them
+  std::_Exit(0);
+}
+
+void HALSimHeadless::RunPhase(const Phase& phase) {
+  HALSIM_SetDriverStationAutonomous(phase.mode == kAutonomous);
+  HALSIM_SetDriverStationTest(phase.mode == kTest);
+  HALSIM_SetDriverStationEnabled(phase.mode != kDisabled);
+  HALSIM_NotifyDriverStationNewData();
+
+  uint64_t duration = static_cast<uint64_t>(phase.duration * 1.0e6);
+  for (uint64_t elapsed = 0; elapsed < duration;) {
+    uint64_t step = duration - elapsed;
+    if (step > kStepPeriod) step = kStepPeriod;
+    HALSIM_SetDriverStationMatchTime(phase.mode == kDisabled
+                                         ? -1.0
+                                         : (duration - elapsed) * 1.0e-6);
+    HALSIM_StepTiming(step);
+    elapsed += step;
+  }
+}
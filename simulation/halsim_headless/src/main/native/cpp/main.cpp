@@ -0,0 +1,36 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "HALSimHeadless.h"
+
+/**
+ * Currently, robots never terminate, so we keep a single static object
+ * and it is never properly released or cleaned up.
+ */
+static HALSimHeadless headless;
+
+extern "C" {
+#if defined(WIN32) || defined(_WIN32)
+__declspec(dllexport)
+#endif
+    int HALSIM_InitExtension(void) {
+  std::cout << "Headless Simulator Initializing." << std::endl;
+
+  const char* script = std::getenv("HALSIM_HEADLESS_SCRIPT");
+  if (!script) script = HALSimHeadless::kDefaultScript;
+  if (!headless.ParseScript(script)) {
+    std::cout << "Invalid HALSIM_HEADLESS_SCRIPT: " << script << std::endl;
+    return -1;
+  }
+  headless.Initialize();
+
+  return 0;
+}
+}  // extern "C"
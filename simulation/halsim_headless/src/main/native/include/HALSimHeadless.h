@@ -0,0 +1,56 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+#include <llvm/StringRef.h>
+
+/**
+ * Runs a scripted match with simulated time advancing as fast as the robot
+ * program allows, then prints a summary and exits the process.
+ *
+ * Timing is paused when the extension loads, and once the robot program has
+ * started it is stepped in DS packet sized increments. Each step waits for
+ * the handlers of every expired HAL notifier, so TimedRobot and Notifier
+ * based code runs in lockstep; loops that only wait for DS data are woken
+ * every step but not waited for.
+ *
+ * The script is read from the HALSIM_HEADLESS_SCRIPT environment variable as
+ * comma separated mode:seconds phases, where mode is one of disabled, auto,
+ * teleop or test. The default is a standard match:
+ * "disabled:1,auto:15,disabled:1,teleop:135".
+ */
+class HALSimHeadless {
+ public:
+  enum Mode { kDisabled, kAutonomous, kTeleop, kTest };
+
+  struct Phase {
+    Mode mode;
+    double duration;
+  };
+
+  static constexpr const char* kDefaultScript =
+      "disabled:1,auto:15,disabled:1,teleop:135";
+  // The period of DS packets while timing is paused, in microseconds
+  static constexpr uint64_t kStepPeriod = 20000;
+
+  bool ParseScript(llvm::StringRef script);
+  void Initialize();
+
+ private:
+  void Run();
+  void RunPhase(const Phase& phase);
+
+  std::vector<Phase> m_phases;
+  std::vector<double> m_phaseWallTimes;
+  std::thread m_thread;
+};
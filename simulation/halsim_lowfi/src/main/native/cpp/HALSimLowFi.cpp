@@ -7,12 +7,41 @@
 
 #include "HALSimLowFi.h"
 
+#include <utility>
+
 #include <llvm/Twine.h>
 
 void HALSimLowFi::Initialize() {
   table = nt::NetworkTableInstance::GetDefault().GetTable("sim");
 }
 
+void HALSimLowFi::RegisterProvider(const std::string& device,
+                                   HALSimNTProvider* provider) {
+  providers[device] = provider;
+  if (batchCallbackUid == 0) {
+    batchCallbackUid =
+        HALSIM_RegisterChangeBatchCallback(NTProviderBatchCallback, this);
+  }
+}
+
+void HALSimLowFi::OnChanges(const struct HALSIM_Change* changes,
+                            int32_t count) {
+  for (int32_t i = 0; i < count; i++) {
+    auto it = providers.find(changes[i].device);
+    if (it == providers.end()) continue;
+    auto provider = it->second;
+    uint32_t chan = static_cast<uint32_t>(changes[i].index);
+    if (chan >= provider->cbInfos.size()) continue;
+    provider->OnFieldChanged(chan, changes[i].field);
+  }
+}
+
+void NTProviderBatchCallback(const char* name, void* param,
+                             const struct HALSIM_Change* changes,
+                             int32_t count) {
+  static_cast<HALSimLowFi*>(param)->OnChanges(changes, count);
+}
+
 void HALSimNTProvider::Inject(std::shared_ptr<HALSimLowFi> parentArg,
                               std::string tableNameArg) {
   parent = parentArg;
@@ -22,39 +51,58 @@ void HALSimNTProvider::Inject(std::shared_ptr<HALSimLowFi> parentArg,
   this->Initialize();
 }
 
-void NTProviderBaseCallback(const char* name, void* param,
-                            const struct HAL_Value* value) {
-  auto info =
-      static_cast<struct HALSimNTProvider::NTProviderCallbackInfo*>(param);
-  uint32_t chan = static_cast<uint32_t>(info->channel);
-  auto provider = info->provider;
-  auto table = info->table;
-  provider->OnCallback(chan, table);
-}
-
-void HALSimNTProvider::InitializeDefault(
-    int numChannels, HALCbRegisterIndexedFunc registerFunc) {
+void HALSimNTProvider::InitializeDefault(int numChannels,
+                                         const std::string& device) {
   this->numChannels = numChannels;
   cbInfos.reserve(numChannels);
   for (int i = 0; i < numChannels; i++) {
-    struct NTProviderCallbackInfo info = {
-        this, table->GetSubTable(tableName + llvm::Twine(i)), i};
-    cbInfos.emplace_back(info);
+    AddChannel(table->GetSubTable(tableName + llvm::Twine(i)), i);
   }
 
   for (auto& info : cbInfos) {
-    registerFunc(info.channel, NTProviderBaseCallback, &info, true);
+    OnCallback(info.channel);
     OnInitializedChannel(info.channel, info.table);
   }
+  parent->RegisterProvider(device, this);
 }
 
-void HALSimNTProvider::InitializeDefaultSingle(
-    HALCbRegisterSingleFunc registerFunc) {
-  struct NTProviderCallbackInfo info = {this, table, 0};
-  cbInfos.push_back(info);
+void HALSimNTProvider::InitializeDefaultSingle(const std::string& device) {
+  AddChannel(table, 0);
 
   for (auto& info : cbInfos) {
-    registerFunc(NTProviderBaseCallback, &info, true);
+    OnCallback(info.channel);
+  }
+  parent->RegisterProvider(device, this);
+}
+
+void HALSimNTProvider::AddChannel(
+    std::shared_ptr<nt::NetworkTable> channelTable, int channel) {
+  struct NTProviderCallbackInfo info = {this, channelTable, channel, {}};
+  auto fields = GetFields();
+  info.entries.reserve(fields.size());
+  for (auto& field : fields) {
+    info.entries.emplace_back(channelTable->GetEntry(field.key));
+  }
+  cbInfos.emplace_back(std::move(info));
+}
+
+void HALSimNTProvider::OnCallback(uint32_t channel) {
+  auto fields = GetFields();
+  auto& entries = cbInfos[channel].entries;
+  for (size_t i = 0; i < fields.size(); i++) {
+    fields[i].publish(entries[i], channel);
+  }
+}
+
+void HALSimNTProvider::OnFieldChanged(uint32_t channel,
+                                      llvm::StringRef field) {
+  // Fields not published to NetworkTables match nothing and need no update
+  auto fields = GetFields();
+  auto& entries = cbInfos[channel].entries;
+  for (size_t i = 0; i < fields.size(); i++) {
+    if (!fields[i].field || field == fields[i].field) {
+      fields[i].publish(entries[i], channel);
+    }
   }
 }
 
@@ -0,0 +1,190 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HALSimShm.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <iostream>
+#include <new>
+
+#include <HAL/HAL.h>
+#include <MockData/AnalogGyroData.h>
+#include <MockData/AnalogInData.h>
+#include <MockData/AnalogOutData.h>
+#include <MockData/DIOData.h>
+#include <MockData/DigitalPWMData.h>
+#include <MockData/DriverStationData.h>
+#include <MockData/EncoderData.h>
+#include <MockData/MockHooks.h>
+#include <MockData/PCMData.h>
+#include <MockData/PWMData.h>
+#include <MockData/RelayData.h>
+#include <MockData/RoboRioData.h>
+
+// How often the poller checks for new inputs and step requests
+static constexpr std::chrono::microseconds kPollPeriod{100};
+
+static void BatchCallback(const char* name, void* param,
+                          const struct HALSIM_Change* changes, int32_t count) {
+  static_cast<HALSimShm*>(param)->PublishOutputs();
+}
+
+HALSimShm::~HALSimShm() {
+  if (m_batchCallback >= 0) HALSIM_CancelChangeBatchCallback(m_batchCallback);
+  m_running = false;
+  if (m_poller.joinable()) m_poller.join();
+#ifndef _WIN32
+  if (m_layout) munmap(m_layout, sizeof(HALSimShmLayout));
+#endif
+}
+
+/**
+ * Creates (or reuses) the shared memory object with the given name, for
+ * example "/halsim", and starts publishing to it.
+ *
+ * @return false if the object could not be mapped; shared memory is not
+ *         supported on Windows
+ */
+bool HALSimShm::Initialize(const char* name) {
+#ifdef _WIN32
+  std::cerr << "halsim_lowfi: shared memory is not supported on Windows"
+            << std::endl;
+  return false;
+#else
+  int fd = shm_open(name, O_RDWR | O_CREAT, 0666);
+  if (fd < 0) {
+    std::cerr << "halsim_lowfi: could not open shared memory " << name
+              << std::endl;
+    return false;
+  }
+  if (ftruncate(fd, sizeof(HALSimShmLayout)) != 0) {
+    close(fd);
+    std::cerr << "halsim_lowfi: could not size shared memory " << name
+              << std::endl;
+    return false;
+  }
+  void* mem = mmap(nullptr, sizeof(HALSimShmLayout), PROT_READ | PROT_WRITE,
+                   MAP_SHARED, fd, 0);
+  close(fd);
+  if (mem == MAP_FAILED) {
+    std::cerr << "halsim_lowfi: could not map shared memory " << name
+              << std::endl;
+    return false;
+  }
+
+  // Start from a clean layout, even if an earlier run left one behind
+  m_layout = new (mem) HALSimShmLayout();
+  m_layout->magic = HALSIM_SHM_MAGIC;
+  m_layout->version = HALSIM_SHM_VERSION;
+  m_layout->size = sizeof(HALSimShmLayout);
+
+  PublishOutputs();
+  m_batchCallback = HALSIM_RegisterChangeBatchCallback(BatchCallback, this);
+  m_running = true;
+  m_poller = std::thread(&HALSimShm::PollMain, this);
+  return true;
+#endif
+}
+
+/**
+ * Copies the current outputs of the simulated devices into shared memory.
+ */
+void HALSimShm::PublishOutputs() {
+  HALSimShmOutputs outputs;
+  int32_t status = 0;
+  outputs.fpgaTime = HAL_GetFPGATime(&status);
+  for (int i = 0; i < HALSIM_SHM_NUM_PWM; i++) {
+    outputs.pwmSpeed[i] = HALSIM_GetPWMSpeed(i);
+    outputs.pwmRaw[i] = HALSIM_GetPWMRawValue(i);
+    outputs.pwmInitialized[i] = HALSIM_GetPWMInitialized(i);
+  }
+  for (int i = 0; i < HALSIM_SHM_NUM_RELAY; i++) {
+    outputs.relayForward[i] = HALSIM_GetRelayForward(i);
+    outputs.relayReverse[i] = HALSIM_GetRelayReverse(i);
+  }
+  for (int i = 0; i < HALSIM_SHM_NUM_DIGITAL_PWM; i++) {
+    outputs.digitalPWMDutyCycle[i] = HALSIM_GetDigitalPWMDutyCycle(i);
+    outputs.digitalPWMPin[i] = HALSIM_GetDigitalPWMPin(i);
+  }
+  for (int i = 0; i < HALSIM_SHM_NUM_ANALOG_OUT; i++) {
+    outputs.analogOutVoltage[i] = HALSIM_GetAnalogOutVoltage(i);
+  }
+  for (int i = 0; i < HALSIM_SHM_NUM_DIO; i++) {
+    outputs.dioValue[i] = HALSIM_GetDIOValue(i);
+    outputs.dioIsInput[i] = HALSIM_GetDIOIsInput(i);
+  }
+  for (int i = 0; i < HALSIM_SHM_NUM_PCM; i++) {
+    for (int j = 0; j < HALSIM_SHM_NUM_SOLENOID; j++) {
+      outputs.solenoidOutput[i][j] = HALSIM_GetPCMSolenoidOutput(i, j);
+    }
+  }
+  outputs.enabled = HALSIM_GetDriverStationEnabled();
+  outputs.autonomous = HALSIM_GetDriverStationAutonomous();
+  outputs.test = HALSIM_GetDriverStationTest();
+  outputs.eStop = HALSIM_GetDriverStationEStop();
+  outputs.matchTime = HALSIM_GetDriverStationMatchTime();
+
+  std::lock_guard<wpi::mutex> lock(m_outputsMutex);
+  HALSimShmWrite(m_layout->outputsSequence, m_layout->outputs, outputs);
+}
+
+void HALSimShm::ApplyInputs(const HALSimShmInputs& inputs) {
+  for (int i = 0; i < HALSIM_SHM_NUM_ENCODER; i++) {
+    HALSIM_SetEncoderCount(i, inputs.encoderCount[i]);
+    HALSIM_SetEncoderPeriod(i, inputs.encoderPeriod[i]);
+    HALSIM_SetEncoderDirection(i, inputs.encoderDirection[i]);
+  }
+  // Channels the program drives are left alone
+  for (int i = 0; i < HALSIM_SHM_NUM_DIO; i++) {
+    if (HALSIM_GetDIOIsInput(i)) HALSIM_SetDIOValue(i, inputs.dioValue[i]);
+  }
+  for (int i = 0; i < HALSIM_SHM_NUM_ANALOG_IN; i++) {
+    HALSIM_SetAnalogInVoltage(i, inputs.analogInVoltage[i]);
+  }
+  for (int i = 0; i < HALSIM_SHM_NUM_ANALOG_GYRO; i++) {
+    HALSIM_SetAnalogGyroAngle(i, inputs.analogGyroAngle[i]);
+    HALSIM_SetAnalogGyroRate(i, inputs.analogGyroRate[i]);
+  }
+  HALSIM_SetRoboRioVInVoltage(0, inputs.vInVoltage);
+}
+
+void HALSimShm::PollMain() {
+  bool paused = false;
+  uint64_t stepsDone = 0;
+  while (m_running) {
+    HALSimShmInputs inputs;
+    uint32_t seq = HALSimShmRead(m_layout->inputsSequence, m_layout->inputs,
+                                 &inputs);
+    // The inputs belong to the external simulator once it has written them
+    if (seq != m_inputsSequence) {
+      m_inputsSequence = seq;
+      ApplyInputs(inputs);
+    }
+
+    uint64_t requested =
+        m_layout->stepRequested.load(std::memory_order_acquire);
+    if (requested == stepsDone) {
+      std::this_thread::sleep_for(kPollPeriod);
+      continue;
+    }
+    if (!paused) {
+      HALSIM_PauseTiming();
+      paused = true;
+    }
+    HALSIM_StepTiming(m_layout->stepDelta);
+    PublishOutputs();
+    stepsDone = requested;
+    m_layout->stepCompleted.store(stepsDone, std::memory_order_release);
+  }
+}
@@ -12,27 +12,29 @@
 #include <MockData/AnalogOutData.h>
 
 void HALSimNTProviderAnalogIn::Initialize() {
-  InitializeDefault(HAL_GetNumAnalogInputs(),
-                    HALSIM_RegisterAnalogInAllCallbacks);
+  InitializeDefault(HAL_GetNumAnalogInputs(), "AnalogIn");
 }
 
-void HALSimNTProviderAnalogIn::OnCallback(
-    uint32_t chan, std::shared_ptr<nt::NetworkTable> table) {
-  table->GetEntry("init?").SetBoolean(HALSIM_GetAnalogInInitialized(chan));
-  table->GetEntry("avg_bits").SetDouble(HALSIM_GetAnalogInAverageBits(chan));
-  table->GetEntry("oversample_bits")
-      .SetDouble(HALSIM_GetAnalogInOversampleBits(chan));
-  table->GetEntry("voltage").SetDouble(HALSIM_GetAnalogInVoltage(chan));
-
-  auto accum = table->GetSubTable("accum");
-  accum->GetEntry("init?").SetBoolean(
-      HALSIM_GetAnalogInAccumulatorInitialized(chan));
-  accum->GetEntry("value").SetDouble(HALSIM_GetAnalogInAccumulatorValue(chan));
-  accum->GetEntry("count").SetDouble(HALSIM_GetAnalogInAccumulatorCount(chan));
-  accum->GetEntry("center").SetDouble(
-      HALSIM_GetAnalogInAccumulatorCenter(chan));
-  accum->GetEntry("deadband")
-      .SetDouble(HALSIM_GetAnalogInAccumulatorDeadband(chan));
+static const HALSimNTProvider::NTProviderField kAnalogInFields[] = {
+    {"Initialized", "init?", PublishBoolean<HALSIM_GetAnalogInInitialized>},
+    {"AverageBits", "avg_bits", PublishInteger<HALSIM_GetAnalogInAverageBits>},
+    {"OversampleBits", "oversample_bits",
+     PublishInteger<HALSIM_GetAnalogInOversampleBits>},
+    {"Voltage", "voltage", PublishDouble<HALSIM_GetAnalogInVoltage>},
+    {"AccumulatorInitialized", "accum/init?",
+     PublishBoolean<HALSIM_GetAnalogInAccumulatorInitialized>},
+    {"AccumulatorValue", "accum/value",
+     PublishInteger64<HALSIM_GetAnalogInAccumulatorValue>},
+    {"AccumulatorCount", "accum/count",
+     PublishInteger64<HALSIM_GetAnalogInAccumulatorCount>},
+    {"AccumulatorCenter", "accum/center",
+     PublishInteger<HALSIM_GetAnalogInAccumulatorCenter>},
+    {"AccumulatorDeadband", "accum/deadband",
+     PublishInteger<HALSIM_GetAnalogInAccumulatorDeadband>}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderAnalogIn::GetFields() const {
+  return kAnalogInFields;
 }
 
 void HALSimNTProviderAnalogIn::OnInitializedChannel(
@@ -45,12 +47,14 @@ void HALSimNTProviderAnalogIn::OnInitializedChannel(
 }
 
 void HALSimNTProviderAnalogOut::Initialize() {
-  InitializeDefault(HAL_GetNumAnalogOutputs(),
-                    HALSIM_RegisterAnalogOutAllCallbacks);
+  InitializeDefault(HAL_GetNumAnalogOutputs(), "AnalogOut");
 }
 
-void HALSimNTProviderAnalogOut::OnCallback(
-    uint32_t chan, std::shared_ptr<nt::NetworkTable> table) {
-  table->GetEntry("init?").SetBoolean(HALSIM_GetAnalogOutInitialized(chan));
-  table->GetEntry("voltage").SetDouble(HALSIM_GetAnalogOutVoltage(chan));
+static const HALSimNTProvider::NTProviderField kAnalogOutFields[] = {
+    {"Initialized", "init?", PublishBoolean<HALSIM_GetAnalogOutInitialized>},
+    {"Voltage", "voltage", PublishDouble<HALSIM_GetAnalogOutVoltage>}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderAnalogOut::GetFields() const {
+  return kAnalogOutFields;
 }
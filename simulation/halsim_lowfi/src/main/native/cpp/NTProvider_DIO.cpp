@@ -11,16 +11,18 @@
 #include <MockData/DIOData.h>
 
 void HALSimNTProviderDIO::Initialize() {
-  InitializeDefault(HAL_GetNumDigitalChannels(),
-                    HALSIM_RegisterDIOAllCallbacks);
+  InitializeDefault(HAL_GetNumDigitalChannels(), "DIO");
 }
 
-void HALSimNTProviderDIO::OnCallback(uint32_t chan,
-                                     std::shared_ptr<nt::NetworkTable> table) {
-  table->GetEntry("init?").SetBoolean(HALSIM_GetDIOInitialized(chan));
-  table->GetEntry("value").SetBoolean(HALSIM_GetDIOValue(chan));
-  table->GetEntry("pulse_length").SetDouble(HALSIM_GetDIOPulseLength(chan));
-  table->GetEntry("input?").SetBoolean(HALSIM_GetDIOIsInput(chan));
+static const HALSimNTProvider::NTProviderField kFields[] = {
+    {"Initialized", "init?", PublishBoolean<HALSIM_GetDIOInitialized>},
+    {"Value", "value", PublishBoolean<HALSIM_GetDIOValue>},
+    {"PulseLength", "pulse_length", PublishDouble<HALSIM_GetDIOPulseLength>},
+    {"IsInput", "input?", PublishBoolean<HALSIM_GetDIOIsInput>}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderDIO::GetFields() const {
+  return kFields;
 }
 
 void HALSimNTProviderDIO::OnInitializedChannel(
@@ -11,39 +11,28 @@
 #include <MockData/DriverStationData.h>
 
 void HALSimNTProviderDriverStation::Initialize() {
-  InitializeDefaultSingle(HALSIM_RegisterDriverStationAllCallbacks);
+  InitializeDefaultSingle("DriverStation");
 }
 
-void HALSimNTProviderDriverStation::OnCallback(
-    uint32_t chan, std::shared_ptr<nt::NetworkTable> table) {
-  bool auton = HALSIM_GetDriverStationAutonomous(),
-       test = HALSIM_GetDriverStationTest(),
-       enabled = HALSIM_GetDriverStationEnabled();
-
-  bool teleop = (!auton && !test && enabled);
-
-  table->GetEntry("enabled?").SetBoolean(enabled);
-  table->GetEntry("autonomous?").SetBoolean(auton);
-  table->GetEntry("test?").SetBoolean(test);
-  table->GetEntry("teleop?").SetBoolean(teleop);
-  table->GetEntry("estop?").SetBoolean(HALSIM_GetDriverStationEStop());
-  table->GetEntry("fms?").SetBoolean(HALSIM_GetDriverStationFmsAttached());
-  table->GetEntry("ds?").SetBoolean(HALSIM_GetDriverStationDsAttached());
-  table->GetEntry("match_time").SetDouble(HALSIM_GetDriverStationMatchTime());
-
-  // TODO: Joysticks
+static void PublishTeleop(CachedEntry& entry, uint32_t chan) {
+  entry.SetBoolean(!HALSIM_GetDriverStationAutonomous() &&
+                   !HALSIM_GetDriverStationTest() &&
+                   HALSIM_GetDriverStationEnabled());
+}
 
-  auto alliance = table->GetSubTable("alliance");
+static void PublishAllianceColor(CachedEntry& entry, uint32_t chan) {
   auto allianceValue = HALSIM_GetDriverStationAllianceStationId();
-  alliance->GetEntry("color").SetString(
-      (allianceValue == HAL_AllianceStationID_kRed1 ||
-       allianceValue == HAL_AllianceStationID_kRed2 ||
-       allianceValue == HAL_AllianceStationID_kRed3)
-          ? "red"
-          : "blue");
+  entry.SetString((allianceValue == HAL_AllianceStationID_kRed1 ||
+                   allianceValue == HAL_AllianceStationID_kRed2 ||
+                   allianceValue == HAL_AllianceStationID_kRed3)
+                      ? "red"
+                      : "blue");
+}
+
+static void PublishAllianceStation(CachedEntry& entry, uint32_t chan) {
   int station = 0;
 
-  switch (allianceValue) {
+  switch (HALSIM_GetDriverStationAllianceStationId()) {
     case HAL_AllianceStationID_kRed1:
     case HAL_AllianceStationID_kBlue1:
       station = 1;
@@ -57,5 +46,34 @@ void HALSimNTProviderDriverStation::OnCallback(
       station = 3;
       break;
   }
-  alliance->GetEntry("station").SetDouble(station);
+  entry.SetDouble(station);
+}
+
+// The driver station getters take no channel
+template <HAL_Bool (*Get)(void)>
+static void PublishFlag(CachedEntry& entry, uint32_t chan) {
+  entry.SetBoolean(Get());
+}
+
+static void PublishMatchTime(CachedEntry& entry, uint32_t chan) {
+  entry.SetDouble(HALSIM_GetDriverStationMatchTime());
+}
+
+// TODO: Joysticks
+static const HALSimNTProvider::NTProviderField kFields[] = {
+    {"Enabled", "enabled?", PublishFlag<HALSIM_GetDriverStationEnabled>},
+    {"Autonomous", "autonomous?",
+     PublishFlag<HALSIM_GetDriverStationAutonomous>},
+    {"Test", "test?", PublishFlag<HALSIM_GetDriverStationTest>},
+    {nullptr, "teleop?", PublishTeleop},
+    {"EStop", "estop?", PublishFlag<HALSIM_GetDriverStationEStop>},
+    {"FmsAttached", "fms?", PublishFlag<HALSIM_GetDriverStationFmsAttached>},
+    {"DsAttached", "ds?", PublishFlag<HALSIM_GetDriverStationDsAttached>},
+    {"MatchTime", "match_time", PublishMatchTime},
+    {"AllianceStationId", "alliance/color", PublishAllianceColor},
+    {"AllianceStationId", "alliance/station", PublishAllianceStation}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderDriverStation::GetFields() const {
+  return kFields;
 }
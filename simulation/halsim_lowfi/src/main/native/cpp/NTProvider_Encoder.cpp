@@ -11,21 +11,24 @@
 #include <MockData/EncoderData.h>
 
 void HALSimNTProviderEncoder::Initialize() {
-  InitializeDefault(HAL_GetNumEncoders(), HALSIM_RegisterEncoderAllCallbacks);
+  InitializeDefault(HAL_GetNumEncoders(), "Encoder");
 }
 
-void HALSimNTProviderEncoder::OnCallback(
-    uint32_t chan, std::shared_ptr<nt::NetworkTable> table) {
-  table->GetEntry("init?").SetBoolean(HALSIM_GetEncoderInitialized(chan));
-  table->GetEntry("count").SetDouble(HALSIM_GetEncoderCount(chan));
-  table->GetEntry("period").SetDouble(HALSIM_GetEncoderPeriod(chan));
-  table->GetEntry("reset?").SetBoolean(HALSIM_GetEncoderReset(chan));
-  table->GetEntry("max_period").SetDouble(HALSIM_GetEncoderMaxPeriod(chan));
-  table->GetEntry("direction").SetBoolean(HALSIM_GetEncoderDirection(chan));
-  table->GetEntry("reverse_direction?")
-      .SetBoolean(HALSIM_GetEncoderReverseDirection(chan));
-  table->GetEntry("samples_to_avg")
-      .SetDouble(HALSIM_GetEncoderSamplesToAverage(chan));
+static const HALSimNTProvider::NTProviderField kFields[] = {
+    {"Initialized", "init?", PublishBoolean<HALSIM_GetEncoderInitialized>},
+    {"Count", "count", PublishInteger<HALSIM_GetEncoderCount>},
+    {"Period", "period", PublishDouble<HALSIM_GetEncoderPeriod>},
+    {"Reset", "reset?", PublishBoolean<HALSIM_GetEncoderReset>},
+    {"MaxPeriod", "max_period", PublishDouble<HALSIM_GetEncoderMaxPeriod>},
+    {"Direction", "direction", PublishBoolean<HALSIM_GetEncoderDirection>},
+    {"ReverseDirection", "reverse_direction?",
+     PublishBoolean<HALSIM_GetEncoderReverseDirection>},
+    {"SamplesToAverage", "samples_to_avg",
+     PublishInteger<HALSIM_GetEncoderSamplesToAverage>}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderEncoder::GetFields() const {
+  return kFields;
 }
 
 void HALSimNTProviderEncoder::OnInitializedChannel(
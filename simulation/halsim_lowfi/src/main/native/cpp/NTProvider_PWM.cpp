@@ -11,15 +11,18 @@
 #include <MockData/PWMData.h>
 
 void HALSimNTProviderPWM::Initialize() {
-  InitializeDefault(HAL_GetNumPWMChannels(), HALSIM_RegisterPWMAllCallbacks);
+  InitializeDefault(HAL_GetNumPWMChannels(), "PWM");
 }
 
-void HALSimNTProviderPWM::OnCallback(uint32_t chan,
-                                     std::shared_ptr<nt::NetworkTable> table) {
-  table->GetEntry("init?").SetBoolean(HALSIM_GetPWMInitialized(chan));
-  table->GetEntry("speed").SetDouble(HALSIM_GetPWMSpeed(chan));
-  table->GetEntry("position").SetDouble(HALSIM_GetPWMPosition(chan));
-  table->GetEntry("raw").SetDouble(HALSIM_GetPWMRawValue(chan));
-  table->GetEntry("period_scale").SetDouble(HALSIM_GetPWMPeriodScale(chan));
-  table->GetEntry("zero_latch?").SetBoolean(HALSIM_GetPWMZeroLatch(chan));
+static const HALSimNTProvider::NTProviderField kFields[] = {
+    {"Initialized", "init?", PublishBoolean<HALSIM_GetPWMInitialized>},
+    {"Speed", "speed", PublishDouble<HALSIM_GetPWMSpeed>},
+    {"Position", "position", PublishDouble<HALSIM_GetPWMPosition>},
+    {"RawValue", "raw", PublishInteger<HALSIM_GetPWMRawValue>},
+    {"PeriodScale", "period_scale", PublishInteger<HALSIM_GetPWMPeriodScale>},
+    {"ZeroLatch", "zero_latch?", PublishBoolean<HALSIM_GetPWMZeroLatch>}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderPWM::GetFields() const {
+  return kFields;
 }
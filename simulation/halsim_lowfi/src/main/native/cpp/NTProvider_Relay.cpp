@@ -11,15 +11,18 @@
 #include <MockData/RelayData.h>
 
 void HALSimNTProviderRelay::Initialize() {
-  InitializeDefault(HAL_GetNumRelayHeaders(), HALSIM_RegisterRelayAllCallbacks);
+  InitializeDefault(HAL_GetNumRelayHeaders(), "Relay");
 }
 
-void HALSimNTProviderRelay::OnCallback(
-    uint32_t chan, std::shared_ptr<nt::NetworkTable> table) {
-  table->GetEntry("init_fwd?")
-      .SetBoolean(HALSIM_GetRelayInitializedForward(chan));
-  table->GetEntry("init_rvs?")
-      .SetBoolean(HALSIM_GetRelayInitializedReverse(chan));
-  table->GetEntry("fwd?").SetBoolean(HALSIM_GetRelayForward(chan));
-  table->GetEntry("rvs?").SetBoolean(HALSIM_GetRelayReverse(chan));
+static const HALSimNTProvider::NTProviderField kFields[] = {
+    {"InitializedForward", "init_fwd?",
+     PublishBoolean<HALSIM_GetRelayInitializedForward>},
+    {"InitializedReverse", "init_rvs?",
+     PublishBoolean<HALSIM_GetRelayInitializedReverse>},
+    {"Forward", "fwd?", PublishBoolean<HALSIM_GetRelayForward>},
+    {"Reverse", "rvs?", PublishBoolean<HALSIM_GetRelayReverse>}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderRelay::GetFields() const {
+  return kFields;
 }
@@ -11,33 +11,41 @@
 #include <MockData/RoboRioData.h>
 
 void HALSimNTProviderRoboRIO::Initialize() {
-  InitializeDefault(1, HALSIM_RegisterRoboRioAllCallbacks);
+  InitializeDefault(1, "RoboRio");
 }
 
-void HALSimNTProviderRoboRIO::OnCallback(
-    uint32_t chan, std::shared_ptr<nt::NetworkTable> table) {
-  table->GetEntry("fpga_button?").SetBoolean(HALSIM_GetRoboRioFPGAButton(chan));
-
-  table->GetEntry("vin_voltage").SetDouble(HALSIM_GetRoboRioVInVoltage(chan));
-  table->GetEntry("vin_current").SetDouble(HALSIM_GetRoboRioVInCurrent(chan));
-
-  auto t6v = table->GetSubTable("6V");
-  t6v->GetEntry("voltage").SetDouble(HALSIM_GetRoboRioUserVoltage6V(chan));
-  t6v->GetEntry("current").SetDouble(HALSIM_GetRoboRioUserCurrent6V(chan));
-  t6v->GetEntry("active?").SetBoolean(HALSIM_GetRoboRioUserActive6V(chan));
-  t6v->GetEntry("faults").SetDouble(HALSIM_GetRoboRioUserFaults6V(chan));
-
-  auto t5v = table->GetSubTable("5V");
-  t5v->GetEntry("voltage").SetDouble(HALSIM_GetRoboRioUserVoltage5V(chan));
-  t5v->GetEntry("current").SetDouble(HALSIM_GetRoboRioUserCurrent5V(chan));
-  t5v->GetEntry("active?").SetBoolean(HALSIM_GetRoboRioUserActive5V(chan));
-  t5v->GetEntry("faults").SetDouble(HALSIM_GetRoboRioUserFaults5V(chan));
-
-  auto t3v3 = table->GetSubTable("3V3");
-  t3v3->GetEntry("voltage").SetDouble(HALSIM_GetRoboRioUserVoltage3V3(chan));
-  t3v3->GetEntry("current").SetDouble(HALSIM_GetRoboRioUserCurrent3V3(chan));
-  t3v3->GetEntry("active?").SetBoolean(HALSIM_GetRoboRioUserActive3V3(chan));
-  t3v3->GetEntry("faults").SetDouble(HALSIM_GetRoboRioUserFaults3V3(chan));
+static const HALSimNTProvider::NTProviderField kFields[] = {
+    {"FPGAButton", "fpga_button?", PublishBoolean<HALSIM_GetRoboRioFPGAButton>},
+    {"VInVoltage", "vin_voltage", PublishDouble<HALSIM_GetRoboRioVInVoltage>},
+    {"VInCurrent", "vin_current", PublishDouble<HALSIM_GetRoboRioVInCurrent>},
+    {"UserVoltage6V", "6V/voltage",
+     PublishDouble<HALSIM_GetRoboRioUserVoltage6V>},
+    {"UserCurrent6V", "6V/current",
+     PublishDouble<HALSIM_GetRoboRioUserCurrent6V>},
+    {"UserActive6V", "6V/active?",
+     PublishBoolean<HALSIM_GetRoboRioUserActive6V>},
+    {"UserFaults6V", "6V/faults",
+     PublishInteger<HALSIM_GetRoboRioUserFaults6V>},
+    {"UserVoltage5V", "5V/voltage",
+     PublishDouble<HALSIM_GetRoboRioUserVoltage5V>},
+    {"UserCurrent5V", "5V/current",
+     PublishDouble<HALSIM_GetRoboRioUserCurrent5V>},
+    {"UserActive5V", "5V/active?",
+     PublishBoolean<HALSIM_GetRoboRioUserActive5V>},
+    {"UserFaults5V", "5V/faults",
+     PublishInteger<HALSIM_GetRoboRioUserFaults5V>},
+    {"UserVoltage3V3", "3V3/voltage",
+     PublishDouble<HALSIM_GetRoboRioUserVoltage3V3>},
+    {"UserCurrent3V3", "3V3/current",
+     PublishDouble<HALSIM_GetRoboRioUserCurrent3V3>},
+    {"UserActive3V3", "3V3/active?",
+     PublishBoolean<HALSIM_GetRoboRioUserActive3V3>},
+    {"UserFaults3V3", "3V3/faults",
+     PublishInteger<HALSIM_GetRoboRioUserFaults3V3>}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderRoboRIO::GetFields() const {
+  return kFields;
 }
 
 void HALSimNTProviderRoboRIO::OnInitializedChannel(
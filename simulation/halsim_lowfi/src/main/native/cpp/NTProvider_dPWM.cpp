@@ -11,13 +11,15 @@
 #include <MockData/DigitalPWMData.h>
 
 void HALSimNTProviderDigitalPWM::Initialize() {
-  InitializeDefault(HAL_GetNumDigitalPWMOutputs(),
-                    HALSIM_RegisterDigitalPWMAllCallbacks);
+  InitializeDefault(HAL_GetNumDigitalPWMOutputs(), "DigitalPWM");
 }
 
-void HALSimNTProviderDigitalPWM::OnCallback(
-    uint32_t chan, std::shared_ptr<nt::NetworkTable> table) {
-  table->GetEntry("init?").SetBoolean(HALSIM_GetDigitalPWMInitialized(chan));
-  table->GetEntry("dio_pin").SetDouble(HALSIM_GetDigitalPWMPin(chan));
-  table->GetEntry("duty_cycle").SetDouble(HALSIM_GetDigitalPWMDutyCycle(chan));
+static const HALSimNTProvider::NTProviderField kFields[] = {
+    {"Initialized", "init?", PublishBoolean<HALSIM_GetDigitalPWMInitialized>},
+    {"Pin", "dio_pin", PublishInteger<HALSIM_GetDigitalPWMPin>},
+    {"DutyCycle", "duty_cycle", PublishDouble<HALSIM_GetDigitalPWMDutyCycle>}};
+
+llvm::ArrayRef<HALSimNTProvider::NTProviderField>
+HALSimNTProviderDigitalPWM::GetFields() const {
+  return kFields;
 }
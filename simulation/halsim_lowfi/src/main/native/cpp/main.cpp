@@ -5,9 +5,11 @@
 /* the project.                                                               */
 /*----------------------------------------------------------------------------*/
 
+#include <cstdlib>
 #include <iostream>
 
 #include <HALSimLowFi.h>
+#include <HALSimShm.h>
 #include <NTProvider_Analog.h>
 #include <NTProvider_DIO.h>
 #include <NTProvider_DriverStation.h>
@@ -18,6 +20,7 @@
 #include <NTProvider_dPWM.h>
 
 static HALSimLowFi halsim_lowfi;
+static HALSimShm halsim_shm;
 
 static HALSimNTProviderPWM pwm_provider;
 static HALSimNTProviderDigitalPWM dpwm_provider;
@@ -34,6 +37,16 @@ extern "C" {
 __declspec(dllexport)
 #endif
     int HALSIM_InitExtension(void) {
+  // Shared memory replaces NetworkTables when HALSIM_LOWFI_SHM names the
+  // object to publish to
+  const char* shmName = std::getenv("HALSIM_LOWFI_SHM");
+  if (shmName && *shmName) {
+    std::cout << "Shared Memory LowFi Simulator Initializing." << std::endl;
+    if (!halsim_shm.Initialize(shmName)) return -1;
+    std::cout << "Shared Memory LowFi Simulator Initialized!" << std::endl;
+    return 0;
+  }
+
   std::cout << "NetworkTables LowFi Simulator Initializing." << std::endl;
   halsim_lowfi.Initialize();
   halsim_lowfi.table->GetInstance().StartServer("networktables.ini");
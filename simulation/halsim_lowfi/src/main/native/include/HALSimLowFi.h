@@ -8,44 +8,118 @@
 #pragma once
 
 #include <cinttypes>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
-#include <MockData/NotifyListener.h>
+#include <HAL/Types.h>
+#include <MockData/ChangeBatch.h>
+#include <MockData/HAL_Value.h>
+#include <llvm/ArrayRef.h>
+#include <llvm/StringRef.h>
 #include <networktables/NetworkTableInstance.h>
 
+class HALSimNTProvider;
+
+/**
+ * A NetworkTables entry that remembers the value last published to it.
+ *
+ * Providers republish every field of a channel when any of them changes, and
+ * NetworkTables allocates a value for each set; an unchanged value is instead
+ * skipped after an in-place comparison, so the usual callback costs no
+ * allocation. Only the simulation publishes these entries, so the cache
+ * doesn't go stale.
+ */
+class CachedEntry {
+ public:
+  explicit CachedEntry(nt::NetworkTableEntry entry) : m_entry(entry) {}
+
+  void SetBoolean(bool value) {
+    if (Update(MakeBoolean(value))) m_entry.SetBoolean(value);
+  }
+
+  void SetDouble(double value) {
+    if (Update(MakeDouble(value))) m_entry.SetDouble(value);
+  }
+
+  void SetString(llvm::StringRef value) {
+    if (m_valid && m_value.type == HAL_UNASSIGNED && m_string == value) return;
+    // Assigning reuses the string's buffer once it's large enough
+    m_string.assign(value.data(), value.size());
+    m_value.type = HAL_UNASSIGNED;
+    m_valid = true;
+    m_entry.SetString(value);
+  }
+
+  nt::NetworkTableEntry& GetEntry() { return m_entry; }
+
+ private:
+  bool Update(const HAL_Value& value) {
+    if (m_valid && ValuesEqual(&m_value, &value)) return false;
+    m_value = value;
+    m_valid = true;
+    return true;
+  }
+
+  nt::NetworkTableEntry m_entry;
+  bool m_valid = false;
+  // The last value, or HAL_UNASSIGNED for the string in m_string
+  HAL_Value m_value{};
+  std::string m_string;
+};
+
 class HALSimLowFi {
  public:
   std::shared_ptr<nt::NetworkTable> table;
   void Initialize();
-};
+  // Routes batched changes to a MockData device to the given provider
+  void RegisterProvider(const std::string& device, HALSimNTProvider* provider);
+  void OnChanges(const struct HALSIM_Change* changes, int32_t count);
 
-typedef void (*HALCbRegisterIndexedFunc)(int32_t index,
-                                         HAL_NotifyCallback callback,
-                                         void* param, HAL_Bool initialNotify);
-typedef void (*HALCbRegisterSingleFunc)(HAL_NotifyCallback callback,
-                                        void* param, HAL_Bool initialNotify);
+ private:
+  std::map<std::string, HALSimNTProvider*> providers;
+  int32_t batchCallbackUid = 0;
+};
 
-void NTProviderBaseCallback(const char* name, void* param,
-                            const struct HAL_Value* value);
+void NTProviderBatchCallback(const char* name, void* param,
+                             const struct HALSIM_Change* changes,
+                             int32_t count);
 
 class HALSimNTProvider {
  public:
+  // A value published for each channel
+  struct NTProviderField {
+    // The MockData field it is read from, as named in change batches, or
+    // nullptr for a value derived from several fields; those are republished
+    // on every change to the channel.
+    const char* field;
+    // The entry key, relative to the channel table; may name a subtable
+    const char* key;
+    void (*publish)(CachedEntry& entry, uint32_t channel);
+  };
+
   struct NTProviderCallbackInfo {
     HALSimNTProvider* provider;
     std::shared_ptr<nt::NetworkTable> table;
     int channel;
+    // The entries of GetFields(), in the same order, resolved once at
+    // initialization
+    std::vector<CachedEntry> entries;
   };
 
   void Inject(std::shared_ptr<HALSimLowFi> parent, std::string table);
   // Initialize is called by inject.
   virtual void Initialize() = 0;
-  virtual void InitializeDefault(int numChannels,
-                                 HALCbRegisterIndexedFunc registerFunc);
-  virtual void InitializeDefaultSingle(HALCbRegisterSingleFunc registerFunc);
-  virtual void OnCallback(uint32_t channel,
-                          std::shared_ptr<nt::NetworkTable> table) = 0;
+  // device is the MockData device name used in change batches
+  virtual void InitializeDefault(int numChannels, const std::string& device);
+  virtual void InitializeDefaultSingle(const std::string& device);
+  // The values the provider publishes for each channel
+  virtual llvm::ArrayRef<NTProviderField> GetFields() const = 0;
+  // Publishes every value of a channel.
+  void OnCallback(uint32_t channel);
+  // Publishes the values of a channel read from a changed field.
+  void OnFieldChanged(uint32_t channel, llvm::StringRef field);
   virtual void OnInitializedChannel(uint32_t channel,
                                     std::shared_ptr<nt::NetworkTable> table);
 
@@ -55,4 +129,28 @@ class HALSimNTProvider {
   std::shared_ptr<HALSimLowFi> parent;
   std::shared_ptr<nt::NetworkTable> table;
   std::vector<NTProviderCallbackInfo> cbInfos;
+
+ private:
+  void AddChannel(std::shared_ptr<nt::NetworkTable> channelTable, int channel);
 };
+
+// Publishers for NTProviderField, from MockData getters
+template <HAL_Bool (*Get)(int32_t)>
+void PublishBoolean(CachedEntry& entry, uint32_t channel) {
+  entry.SetBoolean(Get(channel));
+}
+
+template <double (*Get)(int32_t)>
+void PublishDouble(CachedEntry& entry, uint32_t channel) {
+  entry.SetDouble(Get(channel));
+}
+
+template <int32_t (*Get)(int32_t)>
+void PublishInteger(CachedEntry& entry, uint32_t channel) {
+  entry.SetDouble(Get(channel));
+}
+
+template <int64_t (*Get)(int32_t)>
+void PublishInteger64(CachedEntry& entry, uint32_t channel) {
+  entry.SetDouble(Get(channel));
+}
@@ -0,0 +1,49 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+
+#include <MockData/ChangeBatch.h>
+#include <support/mutex.h>
+
+#include "HALSimShmLayout.h"
+
+/**
+ * Publishes the simulated devices in a POSIX shared memory object, for
+ * external simulators that need faster coupling than NetworkTables.
+ *
+ * Outputs are republished after every change batch. A polling thread
+ * applies new inputs as the external simulator writes them, and runs the
+ * steps it requests; the first step request pauses timing, so from then on
+ * simulated time only advances when the simulator asks.
+ */
+class HALSimShm {
+ public:
+  ~HALSimShm();
+
+  bool Initialize(const char* name);
+
+  void PublishOutputs();
+
+ private:
+  void PollMain();
+  void ApplyInputs(const HALSimShmInputs& inputs);
+
+  HALSimShmLayout* m_layout = nullptr;
+  // Serializes the change batch callback and the poller, which both publish
+  // the outputs
+  wpi::mutex m_outputsMutex;
+  uint32_t m_inputsSequence = 0;
+  int32_t m_batchCallback = -1;
+  std::atomic<bool> m_running{false};
+  std::thread m_poller;
+};
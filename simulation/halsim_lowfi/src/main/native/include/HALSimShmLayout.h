@@ -0,0 +1,118 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstring>
+
+/**
+ * The layout of the shared memory published by halsim_lowfi when
+ * HALSIM_LOWFI_SHM names a POSIX shared memory object. External simulators
+ * include this header, map the object and use the functions below.
+ *
+ * Each block has a single writer: the robot program writes the outputs, the
+ * external simulator writes the inputs. Readers copy a block under its
+ * seqlock, retrying if the writer was in the middle of an update, so neither
+ * side ever blocks the other.
+ */
+
+#define HALSIM_SHM_MAGIC 0x4d485348u  // "HSHM"
+#define HALSIM_SHM_VERSION 1
+
+#define HALSIM_SHM_NUM_PWM 20
+#define HALSIM_SHM_NUM_RELAY 4
+#define HALSIM_SHM_NUM_DIGITAL_PWM 6
+#define HALSIM_SHM_NUM_DIO 26
+#define HALSIM_SHM_NUM_ANALOG_IN 8
+#define HALSIM_SHM_NUM_ANALOG_OUT 2
+#define HALSIM_SHM_NUM_ENCODER 8
+#define HALSIM_SHM_NUM_ANALOG_GYRO 2
+#define HALSIM_SHM_NUM_PCM 2
+#define HALSIM_SHM_NUM_SOLENOID 8
+
+// Written by the robot program after every change batch and step
+struct HALSimShmOutputs {
+  uint64_t fpgaTime;
+  double pwmSpeed[HALSIM_SHM_NUM_PWM];
+  int32_t pwmRaw[HALSIM_SHM_NUM_PWM];
+  uint8_t pwmInitialized[HALSIM_SHM_NUM_PWM];
+  uint8_t relayForward[HALSIM_SHM_NUM_RELAY];
+  uint8_t relayReverse[HALSIM_SHM_NUM_RELAY];
+  double digitalPWMDutyCycle[HALSIM_SHM_NUM_DIGITAL_PWM];
+  int32_t digitalPWMPin[HALSIM_SHM_NUM_DIGITAL_PWM];
+  double analogOutVoltage[HALSIM_SHM_NUM_ANALOG_OUT];
+  // Values of DIO channels the program drives as outputs
+  uint8_t dioValue[HALSIM_SHM_NUM_DIO];
+  uint8_t dioIsInput[HALSIM_SHM_NUM_DIO];
+  uint8_t solenoidOutput[HALSIM_SHM_NUM_PCM][HALSIM_SHM_NUM_SOLENOID];
+  uint8_t enabled;
+  uint8_t autonomous;
+  uint8_t test;
+  uint8_t eStop;
+  double matchTime;
+};
+
+// Written by the external simulator; applied before every step
+struct HALSimShmInputs {
+  int32_t encoderCount[HALSIM_SHM_NUM_ENCODER];
+  double encoderPeriod[HALSIM_SHM_NUM_ENCODER];
+  uint8_t encoderDirection[HALSIM_SHM_NUM_ENCODER];
+  // Values of DIO channels the program reads as inputs
+  uint8_t dioValue[HALSIM_SHM_NUM_DIO];
+  double analogInVoltage[HALSIM_SHM_NUM_ANALOG_IN];
+  double analogGyroAngle[HALSIM_SHM_NUM_ANALOG_GYRO];
+  double analogGyroRate[HALSIM_SHM_NUM_ANALOG_GYRO];
+  double vInVoltage;
+};
+
+struct HALSimShmLayout {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t size;
+
+  std::atomic<uint32_t> outputsSequence;
+  HALSimShmOutputs outputs;
+
+  std::atomic<uint32_t> inputsSequence;
+  HALSimShmInputs inputs;
+
+  // To step the simulation, the external simulator writes stepDelta (in
+  // microseconds of simulated time) and then increments stepRequested. The
+  // robot program applies the inputs, runs the step with timing paused,
+  // publishes the outputs and sets stepCompleted to stepRequested.
+  uint64_t stepDelta;
+  std::atomic<uint64_t> stepRequested;
+  std::atomic<uint64_t> stepCompleted;
+};
+
+// Writes a block; only its single writer may call this
+template <typename T>
+inline void HALSimShmWrite(std::atomic<uint32_t>& sequence, T& block,
+                           const T& value) {
+  uint32_t seq = sequence.load(std::memory_order_relaxed);
+  sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(&block, &value, sizeof(T));
+  sequence.store(seq + 2, std::memory_order_release);
+}
+
+// Reads a consistent copy of a block. Returns the sequence it was read at,
+// which changes whenever the block is written.
+template <typename T>
+inline uint32_t HALSimShmRead(const std::atomic<uint32_t>& sequence,
+                              const T& block, T* value) {
+  for (;;) {
+    uint32_t before = sequence.load(std::memory_order_acquire);
+    if (before & 1) continue;
+    std::memcpy(value, &block, sizeof(T));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) == before) return before;
+  }
+}
@@ -14,6 +14,5 @@
 class HALSimNTProviderDriverStation : public HALSimNTProvider {
  public:
   void Initialize() override;
-  void OnCallback(uint32_t channel,
-                  std::shared_ptr<nt::NetworkTable> table) override;
+  llvm::ArrayRef<NTProviderField> GetFields() const override;
 };
@@ -14,8 +14,7 @@
 class HALSimNTProviderEncoder : public HALSimNTProvider {
  public:
   void Initialize() override;
-  void OnCallback(uint32_t channel,
-                  std::shared_ptr<nt::NetworkTable> table) override;
+  llvm::ArrayRef<NTProviderField> GetFields() const override;
   void OnInitializedChannel(uint32_t channel,
                             std::shared_ptr<nt::NetworkTable> table) override;
 };
@@ -0,0 +1,100 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HALSimPhysics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <HAL/HAL.h>
+#include <HAL/Notifier.h>
+#include <HAL/Ports.h>
+#include <MockData/DriverStationData.h>
+#include <MockData/PWMData.h>
+
+HALSimPhysics& HALSimPhysics::GetInstance() {
+  static HALSimPhysics instance;
+  return instance;
+}
+
+void HALSimPhysics::Initialize() {
+  int32_t status = 0;
+  m_notifier = HAL_InitializeNotifier(&status);
+  if (status != 0) return;
+  m_pwmSpeeds.resize(HAL_GetNumPWMChannels());
+  m_thread = std::thread(&HALSimPhysics::ThreadMain, this);
+  m_thread.detach();
+}
+
+void HALSimPhysics::AddModel(std::shared_ptr<PhysicsModel> model) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_models.emplace_back(std::move(model));
+}
+
+void HALSimPhysics::RemoveModel(const std::shared_ptr<PhysicsModel>& model) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_models.erase(std::remove(m_models.begin(), m_models.end(), model),
+                 m_models.end());
+}
+
+void HALSimPhysics::ResetModels() {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  for (auto& model : m_models) model->Reset();
+}
+
+/**
+ * Sets the period models are stepped at, in seconds. It takes effect at the
+ * next step.
+ */
+void HALSimPhysics::SetStepPeriod(double period) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_stepPeriod = period;
+}
+
+double HALSimPhysics::GetStepPeriod() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_stepPeriod;
+}
+
+/**
+ * Steps every model once by dt seconds. This is what the stepping thread
+ * calls each period; tests may call it directly instead.
+ */
+void HALSimPhysics::Step(double dt) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+
+  // Read every output once, so all models see the same instant
+  if (HALSIM_GetDriverStationEnabled()) {
+    for (size_t i = 0; i < m_pwmSpeeds.size(); i++) {
+      m_pwmSpeeds[i] = HALSIM_GetPWMSpeed(i);
+    }
+  } else {
+    std::fill(m_pwmSpeeds.begin(), m_pwmSpeeds.end(), 0.0);
+  }
+
+  for (auto& model : m_models) model->Step(m_pwmSpeeds, dt);
+}
+
+void HALSimPhysics::ThreadMain() {
+  int32_t status = 0;
+  uint64_t period = std::llround(GetStepPeriod() * 1e6);
+  uint64_t expirationTime = HAL_GetFPGATime(&status) + period;
+  for (;;) {
+    HAL_UpdateNotifierAlarm(m_notifier, expirationTime, &status);
+    uint64_t curTime = HAL_WaitForNotifierAlarm(m_notifier, &status);
+    if (curTime == 0 || status != 0) break;
+
+    // Step by the fixed period rather than the measured time, so results do
+    // not depend on how late the thread woke up
+    Step(period * 1e-6);
+
+    period = std::llround(GetStepPeriod() * 1e6);
+    expirationTime += period;
+    // Skip steps missed while the host was busy rather than catching up
+    if (expirationTime <= curTime) expirationTime = curTime + period;
+  }
+}
@@ -0,0 +1,163 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "PhysicsModels.h"
+
+#include <cmath>
+#include <limits>
+
+#include <ADXRS450_SpiGyroWrapperData.h>
+#include <MockData/AnalogGyroData.h>
+#include <MockData/EncoderData.h>
+
+static constexpr double kPi = 3.14159265358979323846;
+
+// The fraction of the way a first-order response moves toward its target in
+// dt seconds
+static double ResponseFactor(double dt, double timeConstant) {
+  if (timeConstant <= 0) return 1.0;
+  return 1.0 - std::exp(-dt / timeConstant);
+}
+
+double PhysicsMotorGroup::Get(const std::vector<double>& pwmSpeeds) const {
+  if (pwms.empty()) return 0.0;
+  double sum = 0;
+  for (int32_t pwm : pwms) {
+    if (pwm >= 0 && pwm < static_cast<int32_t>(pwmSpeeds.size())) {
+      sum += pwmSpeeds[pwm];
+    }
+  }
+  double speed = sum / pwms.size();
+  return inverted ? -speed : speed;
+}
+
+PhysicsEncoder::PhysicsEncoder(int32_t index, double countsPerUnit,
+                               bool inverted)
+    : m_index(index), m_countsPerUnit(countsPerUnit), m_inverted(inverted) {}
+
+void PhysicsEncoder::Set(double position, double velocity) {
+  if (m_index < 0 || !HALSIM_GetEncoderInitialized(m_index)) return;
+
+  if (m_inverted) {
+    position = -position;
+    velocity = -velocity;
+  }
+
+  // Keep counting from wherever the robot program set the count
+  int32_t current = HALSIM_GetEncoderCount(m_index);
+  int32_t count = std::lround(position * m_countsPerUnit);
+  if (m_written && current != m_lastCount) {
+    m_offset = current - count;
+  }
+  m_lastCount = count + m_offset;
+  m_written = true;
+
+  HALSIM_SetEncoderCount(m_index, m_lastCount);
+  double countsPerSecond = velocity * m_countsPerUnit;
+  HALSIM_SetEncoderPeriod(m_index,
+                          countsPerSecond == 0
+                              ? std::numeric_limits<double>::max()
+                              : 1.0 / countsPerSecond);
+  HALSIM_SetEncoderDirection(m_index, countsPerSecond >= 0);
+}
+
+void PhysicsEncoder::Reset() {
+  m_written = false;
+  m_offset = 0;
+}
+
+PhysicsMechanism::PhysicsMechanism(PhysicsMotorGroup motors, double maxSpeed,
+                                   double timeConstant, PhysicsEncoder encoder)
+    : m_motors(std::move(motors)),
+      m_maxSpeed(maxSpeed),
+      m_timeConstant(timeConstant),
+      m_encoder(encoder) {}
+
+void PhysicsMechanism::Step(const std::vector<double>& pwmSpeeds, double dt) {
+  double target = m_motors.Get(pwmSpeeds) * m_maxSpeed;
+  double velocity = m_velocity;
+  velocity += (target - velocity) * ResponseFactor(dt, m_timeConstant);
+  double position = m_position + velocity * dt;
+  m_velocity = velocity;
+  m_position = position;
+  m_encoder.Set(position, velocity);
+}
+
+void PhysicsMechanism::Reset() {
+  m_velocity = 0;
+  m_position = 0;
+  m_encoder.Reset();
+}
+
+double PhysicsMechanism::GetPosition() const { return m_position; }
+
+double PhysicsMechanism::GetVelocity() const { return m_velocity; }
+
+PhysicsDrivetrain::PhysicsDrivetrain(const Config& config) : m_config(config) {
+  if (config.adxrs450Port >= 0) {
+    m_adxrs450 =
+        std::make_unique<hal::ADXRS450_SpiGyroWrapper>(config.adxrs450Port);
+  }
+}
+
+// Located here and not in header due to ADXRS450_SpiGyroWrapper forward
+// declaration.
+PhysicsDrivetrain::~PhysicsDrivetrain() {}
+
+void PhysicsDrivetrain::Step(const std::vector<double>& pwmSpeeds, double dt) {
+  double factor = ResponseFactor(dt, m_config.timeConstant);
+  double leftTarget = m_config.left.Get(pwmSpeeds) * m_config.maxSpeed;
+  double rightTarget = m_config.right.Get(pwmSpeeds) * m_config.maxSpeed;
+  m_leftVelocity += (leftTarget - m_leftVelocity) * factor;
+  m_rightVelocity += (rightTarget - m_rightVelocity) * factor;
+
+  double leftPosition = m_leftPosition + m_leftVelocity * dt;
+  double rightPosition = m_rightPosition + m_rightVelocity * dt;
+  m_leftPosition = leftPosition;
+  m_rightPosition = rightPosition;
+
+  // Turning right (left side faster) is a positive, clockwise rate
+  double rate = (m_leftVelocity - m_rightVelocity) / m_config.trackWidth *
+                180.0 / kPi;
+  m_heading = m_heading + rate * dt;
+
+  m_config.leftEncoder.Set(leftPosition, m_leftVelocity);
+  m_config.rightEncoder.Set(rightPosition, m_rightVelocity);
+  WriteGyros(rate);
+}
+
+void PhysicsDrivetrain::Reset() {
+  m_leftVelocity = 0;
+  m_rightVelocity = 0;
+  m_leftPosition = 0;
+  m_rightPosition = 0;
+  m_heading = 0;
+  m_config.leftEncoder.Reset();
+  m_config.rightEncoder.Reset();
+  m_gyroOffset = 0;
+  m_lastGyroAngle = 0;
+}
+
+double PhysicsDrivetrain::GetLeftPosition() const { return m_leftPosition; }
+
+double PhysicsDrivetrain::GetRightPosition() const { return m_rightPosition; }
+
+double PhysicsDrivetrain::GetHeading() const { return m_heading; }
+
+void PhysicsDrivetrain::WriteGyros(double rate) {
+  if (m_config.analogGyro >= 0) {
+    // Keep turning from wherever the robot program reset the gyro to
+    double current = HALSIM_GetAnalogGyroAngle(m_config.analogGyro);
+    if (current != m_lastGyroAngle) m_gyroOffset = current - m_heading;
+    m_lastGyroAngle = m_heading + m_gyroOffset;
+    HALSIM_SetAnalogGyroAngle(m_config.analogGyro, m_lastGyroAngle);
+    HALSIM_SetAnalogGyroRate(m_config.analogGyro, rate);
+  }
+  // The wrapper sends the change in angle to the robot's accumulator, so a
+  // reset on the robot side needs no rebasing here
+  if (m_adxrs450) m_adxrs450->SetAngle(m_heading);
+}
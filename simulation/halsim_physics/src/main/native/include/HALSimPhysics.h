@@ -0,0 +1,75 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <HAL/Types.h>
+#include <support/mutex.h>
+
+/**
+ * A model of a part of the robot, stepped by HALSimPhysics.
+ */
+class PhysicsModel {
+ public:
+  virtual ~PhysicsModel() = default;
+
+  // Advances the model by dt seconds, driven by the given speeds of every
+  // PWM channel, and writes its simulated sensors
+  virtual void Step(const std::vector<double>& pwmSpeeds, double dt) = 0;
+
+  // Returns the model to rest at its starting position
+  virtual void Reset() = 0;
+};
+
+/**
+ * Steps physics models at a fixed period, in lockstep with the robot loop.
+ *
+ * The models are stepped from a HAL notifier. While simulated timing is
+ * paused, HALSIM_StepTiming() waits for each step to finish before advancing
+ * time further, so a simulation produces the same results on any host. Each
+ * step reads every PWM speed once (all zero while the robot is disabled),
+ * steps every model with the period as its dt, and lets the models write
+ * their sensors.
+ *
+ * Currently, robots never terminate, so there is a single static instance
+ * that is never cleaned up.
+ */
+class HALSimPhysics {
+ public:
+  static constexpr double kDefaultStepPeriod = 0.005;
+
+  static HALSimPhysics& GetInstance();
+
+  void Initialize();
+
+  void AddModel(std::shared_ptr<PhysicsModel> model);
+  void RemoveModel(const std::shared_ptr<PhysicsModel>& model);
+  void ResetModels();
+
+  void SetStepPeriod(double period);
+  double GetStepPeriod() const;
+
+  void Step(double dt);
+
+ private:
+  void ThreadMain();
+
+  mutable wpi::mutex m_mutex;
+  std::vector<std::shared_ptr<PhysicsModel>> m_models;
+  // Reused every step, so stepping does not allocate
+  std::vector<double> m_pwmSpeeds;
+  double m_stepPeriod = kDefaultStepPeriod;
+
+  HAL_NotifierHandle m_notifier = HAL_kInvalidHandle;
+  std::thread m_thread;
+};
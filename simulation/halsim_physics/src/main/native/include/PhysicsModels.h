@@ -0,0 +1,130 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "HALSimPhysics.h"
+
+namespace hal {
+class ADXRS450_SpiGyroWrapper;
+}  // namespace hal
+
+/**
+ * Motors driven together by PWM outputs. Their speed is the average of the
+ * speeds of the channels.
+ */
+struct PhysicsMotorGroup {
+  std::vector<int32_t> pwms;
+  bool inverted = false;
+
+  double Get(const std::vector<double>& pwmSpeeds) const;
+};
+
+/**
+ * A simulated encoder written by a model.
+ *
+ * The index is that of the SimEncoderData, which is the order the robot
+ * program created its encoders in. When the robot program resets or changes
+ * the count, the model's position is rebased so the count moves on from the
+ * new value.
+ */
+class PhysicsEncoder {
+ public:
+  PhysicsEncoder() = default;
+  PhysicsEncoder(int32_t index, double countsPerUnit, bool inverted = false);
+
+  void Set(double position, double velocity);
+  void Reset();
+
+ private:
+  int32_t m_index = -1;
+  double m_countsPerUnit = 1;
+  bool m_inverted = false;
+  bool m_written = false;
+  int32_t m_lastCount = 0;
+  int32_t m_offset = 0;
+};
+
+/**
+ * A mechanism driven by one motor group with a first-order response: a
+ * flywheel, or an elevator or arm whose load does not depend on position.
+ * Speed is in units per second and position in units, as set by the
+ * encoder's counts per unit.
+ */
+class PhysicsMechanism : public PhysicsModel {
+ public:
+  PhysicsMechanism(PhysicsMotorGroup motors, double maxSpeed,
+                   double timeConstant, PhysicsEncoder encoder);
+
+  void Step(const std::vector<double>& pwmSpeeds, double dt) override;
+  void Reset() override;
+
+  double GetPosition() const;
+  double GetVelocity() const;
+
+ private:
+  PhysicsMotorGroup m_motors;
+  double m_maxSpeed;
+  double m_timeConstant;
+  PhysicsEncoder m_encoder;
+  std::atomic<double> m_position{0};
+  std::atomic<double> m_velocity{0};
+};
+
+/**
+ * A differential drivetrain whose sides each have a first-order response.
+ * Distances are in meters and the heading in degrees, clockwise positive as
+ * WPILib gyros report it.
+ */
+class PhysicsDrivetrain : public PhysicsModel {
+ public:
+  struct Config {
+    PhysicsMotorGroup left;
+    PhysicsMotorGroup right;
+    // Speed of a side at full output, in meters per second
+    double maxSpeed = 4.0;
+    // Time for a side to reach 63% of a new speed, in seconds
+    double timeConstant = 0.1;
+    // Distance between the left and right wheels, in meters
+    double trackWidth = 0.6;
+    PhysicsEncoder leftEncoder;
+    PhysicsEncoder rightEncoder;
+    // The heading is written to the AnalogGyroData of this index, and to an
+    // ADXRS450 simulated on this SPI port; -1 for none
+    int32_t analogGyro = -1;
+    int32_t adxrs450Port = -1;
+  };
+
+  explicit PhysicsDrivetrain(const Config& config);
+  ~PhysicsDrivetrain() override;
+
+  void Step(const std::vector<double>& pwmSpeeds, double dt) override;
+  void Reset() override;
+
+  double GetLeftPosition() const;
+  double GetRightPosition() const;
+  double GetHeading() const;
+
+ private:
+  void WriteGyros(double rate);
+
+  Config m_config;
+  std::unique_ptr<hal::ADXRS450_SpiGyroWrapper> m_adxrs450;
+  double m_leftVelocity = 0;
+  double m_rightVelocity = 0;
+  std::atomic<double> m_leftPosition{0};
+  std::atomic<double> m_rightPosition{0};
+  std::atomic<double> m_heading{0};
+  double m_lastGyroAngle = 0;
+  double m_gyroOffset = 0;
+};
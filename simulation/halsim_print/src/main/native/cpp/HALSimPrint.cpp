@@ -0,0 +1,154 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2017-2018 FIRST. All Rights Reserved.                        */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HALSimPrint.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <HAL/Ports.h>
+
+#include "MockData/DIOData.h"
+#include "MockData/EncoderData.h"
+#include "MockData/PCMData.h"
+#include "MockData/PWMData.h"
+#include "MockData/RelayData.h"
+
+// How often the writer thread prints what was queued
+static constexpr std::chrono::milliseconds kWritePeriod{10};
+
+static void ChangeBatchCallback(const char* name, void* param,
+                                const struct HALSIM_Change* changes,
+                                int32_t count) {
+  static_cast<HALSimPrint*>(param)->OnChanges(changes, count);
+}
+
+static void AddChannels(std::vector<PrintChannel>* channels, int count,
+                        const char* prefix, const char* suffix,
+                        bool integral) {
+  channels->reserve(count);
+  for (int i = 0; i < count; i++) {
+    channels->emplace_back(prefix + std::to_string(i) + suffix, integral);
+  }
+}
+
+HALSimPrint::~HALSimPrint() {
+  m_running = false;
+  if (m_writer.joinable()) m_writer.join();
+}
+
+void HALSimPrint::Initialize() {
+  AddChannels(&m_pwms, HAL_GetNumPWMChannels(), "PWM ", "", false);
+  AddChannels(&m_dios, HAL_GetNumDigitalChannels(), "DIO ", "", true);
+  AddChannels(&m_relayForwards, HAL_GetNumRelayHeaders(), "Relay ",
+              " forward", true);
+  AddChannels(&m_relayReverses, HAL_GetNumRelayHeaders(), "Relay ",
+              " reverse", true);
+  AddChannels(&m_encoders, HAL_GetNumEncoders(), "Encoder ", "", true);
+
+  int modules = HAL_GetNumPCMModules();
+  m_solenoidsPerModule = HAL_GetNumSolenoidChannels();
+  m_solenoids.reserve(modules * m_solenoidsPerModule);
+  for (int i = 0; i < modules; i++) {
+    for (int j = 0; j < m_solenoidsPerModule; j++) {
+      m_solenoids.emplace_back(
+          "Solenoid " + std::to_string(i) + "." + std::to_string(j), true);
+    }
+  }
+
+  m_running = true;
+  m_writer = std::thread(&HALSimPrint::WriterMain, this);
+  HALSIM_RegisterChangeBatchCallback(ChangeBatchCallback, this);
+}
+
+void HALSimPrint::OnChanges(const struct HALSIM_Change* changes,
+                            int32_t count) {
+  for (int32_t i = 0; i < count; i++) {
+    const char* device = changes[i].device;
+    const char* field = changes[i].field;
+    int32_t index = changes[i].index;
+    if (index < 0) continue;
+    size_t idx = static_cast<size_t>(index);
+
+    Event event;
+    if (std::strcmp(device, "PWM") == 0 && std::strcmp(field, "Speed") == 0) {
+      if (idx >= m_pwms.size()) continue;
+      event = Event{&m_pwms[idx], HALSIM_GetPWMSpeed(index)};
+    } else if (std::strcmp(device, "DIO") == 0 &&
+               std::strcmp(field, "Value") == 0) {
+      if (idx >= m_dios.size()) continue;
+      event = Event{&m_dios[idx], double(HALSIM_GetDIOValue(index))};
+    } else if (std::strcmp(device, "Relay") == 0 &&
+               std::strcmp(field, "Forward") == 0) {
+      if (idx >= m_relayForwards.size()) continue;
+      event = Event{&m_relayForwards[idx],
+                    double(HALSIM_GetRelayForward(index))};
+    } else if (std::strcmp(device, "Relay") == 0 &&
+               std::strcmp(field, "Reverse") == 0) {
+      if (idx >= m_relayReverses.size()) continue;
+      event = Event{&m_relayReverses[idx],
+                    double(HALSIM_GetRelayReverse(index))};
+    } else if (std::strcmp(device, "PCM") == 0 &&
+               std::strcmp(field, "SolenoidOutput") == 0) {
+      int32_t channel = changes[i].channel;
+      if (channel < 0 || channel >= m_solenoidsPerModule) continue;
+      size_t solenoid = idx * m_solenoidsPerModule + channel;
+      if (solenoid >= m_solenoids.size()) continue;
+      event = Event{&m_solenoids[solenoid],
+                    double(HALSIM_GetPCMSolenoidOutput(index, channel))};
+    } else if (std::strcmp(device, "Encoder") == 0 &&
+               std::strcmp(field, "Count") == 0) {
+      if (idx >= m_encoders.size()) continue;
+      event = Event{&m_encoders[idx], double(HALSIM_GetEncoderCount(index))};
+    } else {
+      continue;
+    }
+    // Overflows are counted by the queue and reported by the writer
+    m_events.Push(event);
+  }
+}
+
+void HALSimPrint::WriterMain() {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<PrintChannel*> pending;
+  int64_t reportedOverflows = 0;
+  std::string out;
+
+  while (m_running) {
+    std::this_thread::sleep_for(kWritePeriod);
+    double now = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+
+    Event event;
+    while (m_events.Pop(&event)) {
+      if (event.channel->SetValue(event.value)) {
+        pending.push_back(event.channel);
+      }
+    }
+
+    out.clear();
+    size_t kept = 0;
+    for (auto channel : pending) {
+      if (channel->Print(now, kMinPrintPeriod, &out)) {
+        pending[kept++] = channel;
+      }
+    }
+    pending.resize(kept);
+
+    int64_t overflows = m_events.GetOverflowCount();
+    if (overflows != reportedOverflows) {
+      out += "halsim_print: dropped " +
+             std::to_string(overflows - reportedOverflows) + " changes\n";
+      reportedOverflows = overflows;
+    }
+
+    if (!out.empty()) std::cout << out << std::flush;
+  }
+}
@@ -0,0 +1,44 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2017-2018 FIRST. All Rights Reserved.                        */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "PrintChannel.h"
+
+#include <cstdio>
+#include <utility>
+
+PrintChannel::PrintChannel(std::string label, bool integral)
+    : m_label(std::move(label)), m_integral(integral) {}
+
+bool PrintChannel::SetValue(double value) {
+  m_value = value;
+  if (m_pending) return false;
+  m_pending = true;
+  return true;
+}
+
+bool PrintChannel::Print(double now, double minPeriod, std::string* out) {
+  if (m_printed && m_value == m_printedValue) {
+    // Changed back before it was printed
+    m_pending = false;
+    return false;
+  }
+  if (m_printed && now - m_printTime < minPeriod) return true;
+
+  char buf[32];
+  if (m_integral) {
+    std::snprintf(buf, sizeof(buf), ": %d\n", static_cast<int>(m_value));
+  } else {
+    std::snprintf(buf, sizeof(buf), ": %g\n", m_value);
+  }
+  *out += m_label;
+  *out += buf;
+  m_printed = true;
+  m_printedValue = m_value;
+  m_printTime = now;
+  m_pending = false;
+  return false;
+}
@@ -7,14 +7,11 @@
 
 #include <iostream>
 
-#include <HAL/Ports.h>
-
 #include "HALSimPrint.h"
-#include "PrintPWM.h"
 
 /**
- * Currently, robots never terminate, so we keep a single static object
- * and it is never properly released or cleaned up.
+ * Currently, robots never terminate, so we keep a single static object; its
+ * destructor only stops the writer thread at exit.
  */
 static HALSimPrint halsim;
 
@@ -25,9 +22,7 @@ __declspec(dllexport)
     int HALSIM_InitExtension(void) {
   std::cout << "Print Simulator Initializing." << std::endl;
 
-  int pwmCount = HAL_GetNumPWMChannels();
-  halsim.m_pwms.reserve(pwmCount);
-  for (int i = 0; i < pwmCount; i++) halsim.m_pwms.emplace_back(i);
+  halsim.Initialize();
 
   return 0;
 }
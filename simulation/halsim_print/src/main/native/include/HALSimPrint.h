@@ -7,11 +7,52 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
 #include <vector>
 
-class PrintPWM;
+#include "HAL/cpp/BoundedMPSCQueue.h"
+#include "MockData/ChangeBatch.h"
+#include "PrintChannel.h"
 
+/**
+ * Prints simulated outputs as they change.
+ *
+ * The change batch callback only queues the new values; a writer thread
+ * formats and prints them, so console output never stalls the robot loop.
+ * Each channel prints on change, at most once per kMinPrintPeriod.
+ */
 class HALSimPrint {
  public:
-  std::vector<PrintPWM> m_pwms;
+  static constexpr double kMinPrintPeriod = 0.1;
+
+  ~HALSimPrint();
+
+  void Initialize();
+
+  // Queues the values that changed during the last robot loop
+  void OnChanges(const struct HALSIM_Change* changes, int32_t count);
+
+ private:
+  struct Event {
+    PrintChannel* channel;
+    double value;
+  };
+
+  void WriterMain();
+
+  std::vector<PrintChannel> m_pwms;
+  std::vector<PrintChannel> m_dios;
+  std::vector<PrintChannel> m_relayForwards;
+  std::vector<PrintChannel> m_relayReverses;
+  // Solenoids of every PCM, by module then channel
+  std::vector<PrintChannel> m_solenoids;
+  int m_solenoidsPerModule = 0;
+  std::vector<PrintChannel> m_encoders;
+
+  hal::BoundedMPSCQueue<Event, 1024> m_events;
+  std::atomic<bool> m_running{false};
+  std::thread m_writer;
 };
@@ -0,0 +1,37 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2017-2018 FIRST. All Rights Reserved.                        */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <string>
+
+/**
+ * A value printed by halsim_print. Each channel prints only when its value
+ * changes, and at most once per minimum period; a change held back by the
+ * period is printed once the period has passed, so the last value is never
+ * lost.
+ */
+class PrintChannel {
+ public:
+  PrintChannel(std::string label, bool integral);
+
+  // Records a new value; returns true if the channel was not already pending
+  bool SetValue(double value);
+
+  // Appends the pending value to out if the channel may print at time now
+  // (in seconds). Returns true if the channel is still pending afterwards.
+  bool Print(double now, double minPeriod, std::string* out);
+
+ private:
+  std::string m_label;
+  bool m_integral;
+  bool m_pending = false;
+  bool m_printed = false;
+  double m_value = 0;
+  double m_printedValue = 0;
+  double m_printTime = 0;
+};
@@ -0,0 +1,253 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "HALSimReplay.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <HAL/DriverStation.h>
+#include <HAL/HAL.h>
+#include <HAL/Notifier.h>
+#include <MockData/AnalogInData.h>
+#include <MockData/CanData.h>
+#include <MockData/DIOData.h>
+#include <MockData/DriverStationData.h>
+#include <MockData/EncoderData.h>
+#include <MockData/MockHooks.h>
+
+/**
+ * Reads a recording into memory. Returns false if the file cannot be read or
+ * was not written by a compatible HAL.
+ */
+bool HALSimReplay::Load(const char* path) {
+  std::FILE* file = std::fopen(path, "rb");
+  if (!file) return false;
+
+  HAL_IORecordFileHeader header;
+  bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+            std::memcmp(header.magic, HAL_kIORecordMagic,
+                        sizeof(header.magic)) == 0 &&
+            header.version == HAL_kIORecordVersion &&
+            header.recordSize == sizeof(HAL_IORecord);
+  if (ok) {
+    HAL_IORecord record;
+    m_records.clear();
+    while (std::fread(&record, sizeof(record), 1, file) == 1) {
+      m_records.push_back(record);
+    }
+  }
+  std::fclose(file);
+
+  // Reads on different threads can be queued slightly out of order
+  std::stable_sort(m_records.begin(), m_records.end(),
+                   [](const HAL_IORecord& lhs, const HAL_IORecord& rhs) {
+                     return lhs.timestamp < rhs.timestamp;
+                   });
+  return ok;
+}
+
+void HALSimReplay::Initialize() {
+  int32_t status = 0;
+  m_notifier = HAL_InitializeNotifier(&status);
+  if (status != 0) return;
+
+  HALSIM_RegisterCanReceiveMessageCallback(ReceiveMessageCallback, this);
+  HALSIM_RegisterCanOpenStreamCallback(OpenStreamCallback, this);
+  HALSIM_RegisterCanCloseStreamCallback(CloseStreamCallback, this);
+  HALSIM_RegisterCanReadStreamCallback(ReadStreamCallback, this);
+
+  m_thread = std::thread(&HALSimReplay::Run, this);
+  m_thread.detach();
+}
+
+void HALSimReplay::Run() {
+  HALSIM_WaitForProgramStart();
+  if (m_records.empty()) return;
+
+  int32_t status = 0;
+  // Recorded times are shifted so the recording starts with the program
+  uint64_t start = HAL_GetFPGATime(&status);
+  uint64_t recordStart = m_records.front().timestamp;
+
+  size_t next = 0;
+  while (next < m_records.size()) {
+    uint64_t nextTime = start + (m_records[next].timestamp - recordStart);
+    HAL_UpdateNotifierAlarm(m_notifier, nextTime, &status);
+    uint64_t curTime = HAL_WaitForNotifierAlarm(m_notifier, &status);
+    if (curTime == 0 || status != 0) return;
+
+    // Apply everything that was read by now, in recorded order
+    while (next < m_records.size() &&
+           start + (m_records[next].timestamp - recordStart) <= curTime) {
+      Apply(m_records[next++]);
+    }
+  }
+  std::printf("Replay finished after %zu records\n", m_records.size());
+}
+
+void HALSimReplay::Apply(const HAL_IORecord& record) {
+  double data;
+  std::memcpy(&data, record.data, sizeof(data));
+
+  switch (record.kind) {
+    case HAL_IORecord_kDIO:
+      HALSIM_SetDIOValue(record.index, record.value != 0);
+      break;
+    case HAL_IORecord_kEncoderCount:
+      HALSIM_SetEncoderCount(record.index, record.value);
+      break;
+    case HAL_IORecord_kEncoderPeriod:
+      HALSIM_SetEncoderPeriod(record.index, data);
+      break;
+    case HAL_IORecord_kAnalogInput:
+      HALSIM_SetAnalogInVoltage(record.index, data);
+      break;
+    case HAL_IORecord_kControlWord: {
+      HAL_ControlWord word;
+      std::memcpy(&word, &record.value, sizeof(word));
+      HALSIM_SetDriverStationEnabled(word.enabled);
+      HALSIM_SetDriverStationAutonomous(word.autonomous);
+      HALSIM_SetDriverStationTest(word.test);
+      HALSIM_SetDriverStationEStop(word.eStop);
+      HALSIM_SetDriverStationFmsAttached(word.fmsAttached);
+      HALSIM_SetDriverStationDsAttached(word.dsAttached);
+      // The control word is read once per DS packet
+      HALSIM_NotifyDriverStationNewData();
+      break;
+    }
+    case HAL_IORecord_kAllianceStation:
+      HALSIM_SetDriverStationAllianceStationId(
+          static_cast<HAL_AllianceStationID>(record.value));
+      break;
+    case HAL_IORecord_kMatchTime:
+      HALSIM_SetDriverStationMatchTime(data);
+      break;
+    case HAL_IORecord_kJoystickAxes: {
+      HAL_JoystickAxes axes;
+      axes.count = record.value;
+      std::memcpy(axes.axes, record.data, sizeof(axes.axes));
+      HALSIM_SetJoystickAxes(record.index, &axes);
+      break;
+    }
+    case HAL_IORecord_kJoystickPOVs: {
+      HAL_JoystickPOVs povs;
+      povs.count = record.value;
+      std::memcpy(povs.povs, record.data, sizeof(povs.povs));
+      HALSIM_SetJoystickPOVs(record.index, &povs);
+      break;
+    }
+    case HAL_IORecord_kJoystickButtons: {
+      HAL_JoystickButtons buttons;
+      buttons.buttons = record.value;
+      buttons.count = record.data[0];
+      HALSIM_SetJoystickButtons(record.index, &buttons);
+      break;
+    }
+    case HAL_IORecord_kCANMessage:
+      ApplyCANMessage(record);
+      break;
+    default:
+      break;
+  }
+}
+
+void HALSimReplay::ApplyCANMessage(const HAL_IORecord& record) {
+  auto messageID = static_cast<uint32_t>(record.value);
+  CANFrame frame;
+  frame.dataSize = record.index > 8 ? 8 : record.index;
+  std::memcpy(frame.data, record.data, sizeof(frame.data));
+  std::memcpy(&frame.timeStamp, record.data + 8, sizeof(frame.timeStamp));
+
+  std::lock_guard<wpi::mutex> lock(m_canMutex);
+  m_canFrames[messageID] = frame;
+  for (auto& entry : m_streamSessions) {
+    StreamSession& session = entry.second;
+    if ((messageID & session.messageIDMask) !=
+        (session.messageID & session.messageIDMask)) {
+      continue;
+    }
+    // Like the roboRIO, a full session drops its oldest messages
+    if (session.messages.size() >= session.maxMessages) {
+      session.messages.pop_front();
+    }
+    HAL_CANStreamMessage message;
+    message.messageID = messageID;
+    message.timeStamp = frame.timeStamp;
+    std::memcpy(message.data, frame.data, sizeof(message.data));
+    message.dataSize = frame.dataSize;
+    session.messages.push_back(message);
+  }
+}
+
+void HALSimReplay::ReceiveMessageCallback(const char* name, void* param,
+                                          uint32_t* messageID,
+                                          uint32_t messageIDMask,
+                                          uint8_t* data, uint8_t* dataSize,
+                                          uint32_t* timeStamp,
+                                          int32_t* status) {
+  auto replay = static_cast<HALSimReplay*>(param);
+  std::lock_guard<wpi::mutex> lock(replay->m_canMutex);
+  for (const auto& entry : replay->m_canFrames) {
+    if ((entry.first & messageIDMask) != (*messageID & messageIDMask)) {
+      continue;
+    }
+    const CANFrame& frame = entry.second;
+    *messageID = entry.first;
+    std::memcpy(data, frame.data, frame.dataSize);
+    *dataSize = frame.dataSize;
+    *timeStamp = frame.timeStamp;
+    *status = 0;
+    return;
+  }
+  *status = HAL_ERR_CANSessionMux_MessageNotFound;
+}
+
+void HALSimReplay::OpenStreamCallback(const char* name, void* param,
+                                      uint32_t* sessionHandle,
+                                      uint32_t messageID,
+                                      uint32_t messageIDMask,
+                                      uint32_t maxMessages, int32_t* status) {
+  auto replay = static_cast<HALSimReplay*>(param);
+  std::lock_guard<wpi::mutex> lock(replay->m_canMutex);
+  *sessionHandle = replay->m_nextSessionHandle++;
+  StreamSession& session = replay->m_streamSessions[*sessionHandle];
+  session.messageID = messageID;
+  session.messageIDMask = messageIDMask;
+  session.maxMessages = maxMessages;
+  *status = 0;
+}
+
+void HALSimReplay::CloseStreamCallback(const char* name, void* param,
+                                       uint32_t sessionHandle) {
+  auto replay = static_cast<HALSimReplay*>(param);
+  std::lock_guard<wpi::mutex> lock(replay->m_canMutex);
+  replay->m_streamSessions.erase(sessionHandle);
+}
+
+void HALSimReplay::ReadStreamCallback(const char* name, void* param,
+                                      uint32_t sessionHandle,
+                                      struct HAL_CANStreamMessage* messages,
+                                      uint32_t messagesToRead,
+                                      uint32_t* messagesRead,
+                                      int32_t* status) {
+  auto replay = static_cast<HALSimReplay*>(param);
+  std::lock_guard<wpi::mutex> lock(replay->m_canMutex);
+  *messagesRead = 0;
+  auto it = replay->m_streamSessions.find(sessionHandle);
+  if (it == replay->m_streamSessions.end()) {
+    *status = HAL_ERR_CANSessionMux_MessageNotFound;
+    return;
+  }
+  auto& queue = it->second.messages;
+  while (*messagesRead < messagesToRead && !queue.empty()) {
+    messages[(*messagesRead)++] = queue.front();
+    queue.pop_front();
+  }
+  *status = 0;
+}
@@ -0,0 +1,39 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "HALSimReplay.h"
+
+/**
+ * Currently, robots never terminate, so we keep a single static object
+ * and it is never properly released or cleaned up.
+ */
+static HALSimReplay replay;
+
+extern "C" {
+#if defined(WIN32) || defined(_WIN32)
+__declspec(dllexport)
+#endif
+    int HALSIM_InitExtension(void) {
+  std::cout << "Replay Simulator Initializing." << std::endl;
+
+  const char* path = std::getenv("HALSIM_REPLAY_FILE");
+  if (!path) {
+    std::cout << "HALSIM_REPLAY_FILE is not set" << std::endl;
+    return -1;
+  }
+  if (!replay.Load(path)) {
+    std::cout << "Could not read recording " << path << std::endl;
+    return -1;
+  }
+  replay.Initialize();
+
+  return 0;
+}
+}  // extern "C"
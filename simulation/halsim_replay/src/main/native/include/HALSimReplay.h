@@ -0,0 +1,85 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <HAL/CAN.h>
+#include <HAL/IORecording.h>
+#include <HAL/Types.h>
+#include <support/mutex.h>
+
+/**
+ * Feeds a recording made with HAL_StartIORecording() back through the
+ * simulated devices.
+ *
+ * Once the robot program starts, each record is applied when simulated time
+ * reaches its offset from the start of the recording: DIO values, encoder
+ * counts and periods, analog voltages and DS state are written to MockData,
+ * and CAN frames are returned to the program's receive calls and stream
+ * sessions. Records are applied from a HAL notifier, so replay stays in
+ * lockstep with the robot loop while timing is paused.
+ *
+ * Devices are matched by index, so the program must allocate them in the
+ * same order as the one that was recorded.
+ */
+class HALSimReplay {
+ public:
+  bool Load(const char* path);
+  void Initialize();
+
+ private:
+  struct CANFrame {
+    uint8_t data[8];
+    uint8_t dataSize;
+    uint32_t timeStamp;
+  };
+
+  struct StreamSession {
+    uint32_t messageID;
+    uint32_t messageIDMask;
+    uint32_t maxMessages;
+    std::deque<HAL_CANStreamMessage> messages;
+  };
+
+  static void ReceiveMessageCallback(const char* name, void* param,
+                                     uint32_t* messageID,
+                                     uint32_t messageIDMask, uint8_t* data,
+                                     uint8_t* dataSize, uint32_t* timeStamp,
+                                     int32_t* status);
+  static void OpenStreamCallback(const char* name, void* param,
+                                 uint32_t* sessionHandle, uint32_t messageID,
+                                 uint32_t messageIDMask, uint32_t maxMessages,
+                                 int32_t* status);
+  static void CloseStreamCallback(const char* name, void* param,
+                                  uint32_t sessionHandle);
+  static void ReadStreamCallback(const char* name, void* param,
+                                 uint32_t sessionHandle,
+                                 struct HAL_CANStreamMessage* messages,
+                                 uint32_t messagesToRead,
+                                 uint32_t* messagesRead, int32_t* status);
+
+  void Run();
+  void Apply(const HAL_IORecord& record);
+  void ApplyCANMessage(const HAL_IORecord& record);
+
+  std::vector<HAL_IORecord> m_records;
+  HAL_NotifierHandle m_notifier = HAL_kInvalidHandle;
+  std::thread m_thread;
+
+  wpi::mutex m_canMutex;
+  // The latest frame of each message ID
+  std::map<uint32_t, CANFrame> m_canFrames;
+  std::map<uint32_t, StreamSession> m_streamSessions;
+  uint32_t m_nextSessionHandle = 1;
+};
@@ -0,0 +1,116 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "VisionBenchmark.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <opencv2/imgcodecs/imgcodecs.hpp>
+#include <opencv2/videoio/videoio.hpp>
+#include <support/timestamp.h>
+
+using namespace frc;
+
+/**
+ * Loads the frames to replay.
+ *
+ * @param path A directory of images, replayed in name order, or a video file
+ * @return False if no frame could be loaded
+ */
+bool VisionBenchmark::LoadFrames(llvm::StringRef path) {
+  m_frames.clear();
+
+  std::vector<cv::String> files;
+  try {
+    cv::glob(path.str(), files, false);
+  } catch (const cv::Exception&) {
+    files.clear();
+  }
+  std::sort(files.begin(), files.end());
+  for (const auto& file : files) {
+    cv::Mat frame = cv::imread(file);
+    if (!frame.empty()) m_frames.push_back(frame);
+  }
+
+  if (m_frames.empty()) {
+    cv::VideoCapture capture(path.str());
+    cv::Mat frame;
+    while (capture.read(frame)) m_frames.push_back(frame.clone());
+  }
+  return !m_frames.empty();
+}
+
+/**
+ * Returns the number of frames loaded.
+ */
+int VisionBenchmark::GetFrameCount() const { return m_frames.size(); }
+
+/**
+ * Sets the function that returns the number of heap allocations made so far,
+ * to measure the allocations per frame. Without one, none are reported.
+ *
+ * @param counter The allocation counter
+ */
+void VisionBenchmark::SetAllocationCounter(std::function<uint64_t()> counter) {
+  m_allocationCounter = std::move(counter);
+}
+
+/**
+ * Runs the pipeline over every frame the given number of times.
+ *
+ * One unmeasured pass runs first, so buffers the pipeline allocates for its
+ * first frames are not counted. Each frame is copied into a working image
+ * before it is processed, outside the measurement, so pipelines that modify
+ * their input still see the recorded frames.
+ *
+ * @param pipeline The pipeline to run
+ * @param passes   The number of measured passes over the frames
+ */
+VisionBenchmarkResult VisionBenchmark::Run(VisionPipeline& pipeline,
+                                           int passes) {
+  VisionBenchmarkResult result;
+  cv::Mat image;
+  for (const auto& frame : m_frames) {
+    frame.copyTo(image);
+    pipeline.Process(image);
+  }
+
+  std::vector<double> times;
+  times.reserve(m_frames.size() * passes);
+  uint64_t allocations = 0;
+  for (int pass = 0; pass < passes; pass++) {
+    for (const auto& frame : m_frames) {
+      frame.copyTo(image);
+      uint64_t startAllocations =
+          m_allocationCounter ? m_allocationCounter() : 0;
+      uint64_t start = wpi::Now();
+      pipeline.Process(image);
+      times.push_back((wpi::Now() - start) * 1.0e-6);
+      if (m_allocationCounter)
+        allocations += m_allocationCounter() - startAllocations;
+    }
+  }
+  if (times.empty()) return result;
+
+  double total = 0;
+  for (double time : times) total += time;
+  std::sort(times.begin(), times.end());
+  auto percentile = [&](double fraction) {
+    size_t index = static_cast<size_t>(fraction * (times.size() - 1) + 0.5);
+    return times[index];
+  };
+
+  result.frames = times.size();
+  result.fps = total > 0 ? times.size() / total : 0;
+  result.latencyMedian = percentile(0.5);
+  result.latency90 = percentile(0.9);
+  result.latency99 = percentile(0.99);
+  result.latencyMax = times.back();
+  result.allocationsPerFrame = static_cast<double>(allocations) / times.size();
+  return result;
+}
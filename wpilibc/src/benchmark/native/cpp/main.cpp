@@ -0,0 +1,145 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <HAL/cpp/make_unique.h>
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include "VisionBenchmark.h"
+#include "vision/VisionKernels.h"
+#include "vision/VisionPipeline.h"
+
+// Every heap allocation of the process goes through these, so the benchmark
+// can report the allocations a pipeline makes per frame
+static std::atomic<uint64_t> allocationCount{0};
+
+void* operator new(size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+
+namespace {
+
+// Finds green retroreflective targets with the VisionKernels fast paths
+class KernelsPipeline : public frc::VisionPipeline {
+ public:
+  void Process(cv::Mat& mat) override {
+    frc::HSVThreshold(mat, m_mask, kRange);
+    frc::Erode3x3(m_mask, m_mask);
+    frc::Dilate3x3(m_mask, m_mask);
+    frc::FindComponentBoxes(m_mask, m_boxes, kMinArea);
+  }
+
+  static const frc::HSVRange kRange;
+  static constexpr int kMinArea = 20;
+
+ private:
+  cv::Mat m_mask;
+  std::vector<frc::ComponentBox> m_boxes;
+};
+
+static frc::HSVRange MakeGreenRange() {
+  frc::HSVRange range;
+  range.hueLow = 50;
+  range.hueHigh = 90;
+  range.satLow = 100;
+  range.satHigh = 255;
+  range.valLow = 100;
+  range.valHigh = 255;
+  return range;
+}
+
+const frc::HSVRange KernelsPipeline::kRange = MakeGreenRange();
+
+// The same work with the equivalent OpenCV calls
+class OpenCVPipeline : public frc::VisionPipeline {
+ public:
+  void Process(cv::Mat& mat) override {
+    const auto& range = KernelsPipeline::kRange;
+    cv::cvtColor(mat, m_hsv, cv::COLOR_BGR2HSV);
+    cv::inRange(m_hsv, cv::Scalar(range.hueLow, range.satLow, range.valLow),
+                cv::Scalar(range.hueHigh, range.satHigh, range.valHigh),
+                m_mask);
+    cv::erode(m_mask, m_mask, cv::Mat());
+    cv::dilate(m_mask, m_mask, cv::Mat());
+    cv::findContours(m_mask, m_contours, cv::RETR_EXTERNAL,
+                     cv::CHAIN_APPROX_SIMPLE);
+    m_boxes.clear();
+    for (const auto& contour : m_contours) {
+      if (cv::contourArea(contour) >= KernelsPipeline::kMinArea)
+        m_boxes.push_back(cv::boundingRect(contour));
+    }
+  }
+
+ private:
+  cv::Mat m_hsv;
+  cv::Mat m_mask;
+  std::vector<std::vector<cv::Point>> m_contours;
+  std::vector<cv::Rect> m_boxes;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::cerr << "usage: " << argv[0] << " <frame directory or video> [passes]"
+              << " [pipeline]" << std::endl;
+    return 1;
+  }
+  int passes = argc > 2 ? std::atoi(argv[2]) : 5;
+  std::string only = argc > 3 ? argv[3] : "";
+
+  // Add pipelines to benchmark here
+  std::vector<std::pair<std::string, std::unique_ptr<frc::VisionPipeline>>>
+      pipelines;
+  pipelines.emplace_back("kernels", std::make_unique<KernelsPipeline>());
+  pipelines.emplace_back("opencv", std::make_unique<OpenCVPipeline>());
+
+  frc::VisionBenchmark benchmark;
+  if (!benchmark.LoadFrames(argv[1])) {
+    std::cerr << "could not load frames from " << argv[1] << std::endl;
+    return 1;
+  }
+  benchmark.SetAllocationCounter([] { return allocationCount.load(); });
+  std::cout << "Loaded " << benchmark.GetFrameCount() << " frames, running "
+            << passes << " passes" << std::endl;
+
+  std::cout << std::fixed << std::setprecision(2);
+  for (auto& pipeline : pipelines) {
+    if (!only.empty() && pipeline.first != only) continue;
+    auto result = benchmark.Run(*pipeline.second, passes);
+    std::cout << pipeline.first << ": " << result.frames << " frames, "
+              << result.fps << " fps, latency median "
+              << result.latencyMedian * 1000 << " ms, 90% "
+              << result.latency90 * 1000 << " ms, 99% "
+              << result.latency99 * 1000 << " ms, max "
+              << result.latencyMax * 1000 << " ms, "
+              << result.allocationsPerFrame << " allocations/frame"
+              << std::endl;
+  }
+  return 0;
+}
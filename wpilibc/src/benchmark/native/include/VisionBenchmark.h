@@ -0,0 +1,55 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <vector>
+
+#include <llvm/StringRef.h>
+#include <opencv2/core/core.hpp>
+
+#include "vision/VisionPipeline.h"
+
+namespace frc {
+
+/**
+ * The measurements of one VisionBenchmark run. Times are in seconds.
+ */
+struct VisionBenchmarkResult {
+  int frames = 0;
+  double fps = 0;
+  double latencyMedian = 0;
+  double latency90 = 0;
+  double latency99 = 0;
+  double latencyMax = 0;
+  double allocationsPerFrame = 0;
+};
+
+/**
+ * Replays recorded frames through a vision pipeline as fast as it runs.
+ *
+ * The frames are decoded into memory up front, so the measurements only
+ * cover the pipeline itself.
+ */
+class VisionBenchmark {
+ public:
+  bool LoadFrames(llvm::StringRef path);
+  int GetFrameCount() const;
+
+  void SetAllocationCounter(std::function<uint64_t()> counter);
+
+  VisionBenchmarkResult Run(VisionPipeline& pipeline, int passes);
+
+ private:
+  std::vector<cv::Mat> m_frames;
+  std::function<uint64_t()> m_allocationCounter;
+};
+
+}  // namespace frc
@@ -0,0 +1,253 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <HAL/HAL.h>
+#include <MockData/EncoderData.h>
+#include <MockData/PWMData.h>
+#include <llvm/Format.h>
+#include <llvm/StringRef.h>
+#include <llvm/raw_ostream.h>
+#include <support/mutex.h>
+
+#include "Commands/Command.h"
+#include "Commands/Scheduler.h"
+#include "Encoder.h"
+#include "Notifier.h"
+#include "PIDController.h"
+#include "Spark.h"
+#include "TimedRobot.h"
+
+// Measures the time from a sensor change to the motor output it causes,
+// through the simulator HAL. Each configuration reads an encoder every loop
+// and writes a speed proportional to its count; the benchmark changes the
+// count through HALSIM_SetEncoderCount and timestamps the PWM speed callback
+// that carries the matching speed.
+//
+// Usage: wpilibcLatencyBenchmark [samples] [max p99 latency in ms]
+// Exits with 1 if any configuration's 99th percentile exceeds the maximum.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kPeriod = 0.005;
+constexpr int kDefaultSamples = 1000;
+// Speed per encoder count; the count of a speed is recovered by dividing
+constexpr double kScale = 1.0e-5;
+constexpr int kMaxSamples = 90000;
+
+struct Stats {
+  int samples = 0;
+  int missed = 0;
+  double min = 0;
+  double median = 0;
+  double p90 = 0;
+  double p99 = 0;
+  double max = 0;
+  double jitter = 0;
+};
+
+// Injects encoder counts and records when each one reaches the PWM output
+class LatencyProbe {
+ public:
+  LatencyProbe(int encoderIndex, int pwmChannel)
+      : m_encoderIndex(encoderIndex), m_pwmChannel(pwmChannel) {
+    m_callback = HALSIM_RegisterPWMSpeedCallback(m_pwmChannel, OnSpeed, this,
+                                                 false);
+  }
+
+  ~LatencyProbe() { HALSIM_CancelPWMSpeedCallback(m_pwmChannel, m_callback); }
+
+  LatencyProbe(const LatencyProbe&) = delete;
+  LatencyProbe& operator=(const LatencyProbe&) = delete;
+
+  // Injects samples counts, waiting 1.5 to 2.5 loop periods between them so
+  // the loop reads every one and the phase against the loop varies
+  Stats Run(int samples) {
+    {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      m_injected.assign(samples + 1, Clock::time_point{});
+      m_latencies.assign(samples + 1, -1.0);
+    }
+    uint32_t random = 12345;
+    for (int count = 1; count <= samples; count++) {
+      {
+        std::lock_guard<wpi::mutex> lock(m_mutex);
+        m_injected[count] = Clock::now();
+      }
+      HALSIM_SetEncoderCount(m_encoderIndex, count);
+      random = random * 1103515245u + 12345u;
+      double wait = kPeriod * (1.5 + (random >> 16) / 65536.0);
+      std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+    // Let the last sample through before resetting
+    std::this_thread::sleep_for(std::chrono::duration<double>(4 * kPeriod));
+    HALSIM_SetEncoderCount(m_encoderIndex, 0);
+
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    return Summarize();
+  }
+
+ private:
+  static void OnSpeed(const char*, void* param, const HAL_Value* value) {
+    auto now = Clock::now();
+    auto probe = static_cast<LatencyProbe*>(param);
+    auto count = std::lround(-value->data.v_double / kScale);
+    std::lock_guard<wpi::mutex> lock(probe->m_mutex);
+    if (count <= 0 || count >= static_cast<long>(probe->m_latencies.size()))
+      return;
+    double& latency = probe->m_latencies[count];
+    if (latency < 0) {
+      latency = std::chrono::duration<double>(now - probe->m_injected[count])
+                    .count();
+    }
+  }
+
+  // m_mutex must be held
+  Stats Summarize() const {
+    std::vector<double> latencies;
+    Stats stats;
+    for (size_t i = 1; i < m_latencies.size(); i++) {
+      if (m_latencies[i] < 0) {
+        stats.missed++;
+      } else {
+        latencies.push_back(m_latencies[i]);
+      }
+    }
+    stats.samples = latencies.size();
+    if (latencies.empty()) return stats;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double fraction) {
+      return latencies[static_cast<size_t>(fraction * (latencies.size() - 1))];
+    };
+    stats.min = latencies.front();
+    stats.median = percentile(0.5);
+    stats.p90 = percentile(0.9);
+    stats.p99 = percentile(0.99);
+    stats.max = latencies.back();
+    double mean = 0;
+    for (double latency : latencies) mean += latency;
+    mean /= latencies.size();
+    double variance = 0;
+    for (double latency : latencies) {
+      variance += (latency - mean) * (latency - mean);
+    }
+    stats.jitter = std::sqrt(variance / latencies.size());
+    return stats;
+  }
+
+  int m_encoderIndex;
+  int m_pwmChannel;
+  int32_t m_callback;
+  wpi::mutex m_mutex;
+  std::vector<Clock::time_point> m_injected;
+  std::vector<double> m_latencies;
+};
+
+class StepCommand : public frc::Command {
+ public:
+  explicit StepCommand(std::function<void()> step) : m_step(std::move(step)) {
+    SetRunWhenDisabled(true);
+  }
+
+ protected:
+  void Execute() override { m_step(); }
+  bool IsFinished() override { return false; }
+
+ private:
+  std::function<void()> m_step;
+};
+
+class LatencyRobot : public frc::TimedRobot {
+ public:
+  explicit LatencyRobot(std::function<void()> step) : m_step(std::move(step)) {
+    SetPeriod(kPeriod);
+  }
+
+  void RobotInit() override {}
+  void DisabledPeriodic() override {}
+  void RobotPeriodic() override { m_step(); }
+
+ private:
+  std::function<void()> m_step;
+};
+
+bool Report(llvm::StringRef name, const Stats& stats, double maxP99) {
+  auto ms = [](double seconds) { return llvm::format("%7.3f", seconds * 1e3); };
+  llvm::outs() << llvm::format("%-14s", name.str().c_str()) << " min "
+               << ms(stats.min) << " median " << ms(stats.median) << " p90 "
+               << ms(stats.p90) << " p99 " << ms(stats.p99) << " max "
+               << ms(stats.max) << " jitter " << ms(stats.jitter) << " ms, "
+               << stats.samples << " samples, " << stats.missed
+               << " missed\n";
+  llvm::outs().flush();
+  return stats.samples > 0 && stats.missed == 0 &&
+         (maxP99 <= 0 || stats.p99 * 1e3 <= maxP99);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (!HAL_Initialize(500, 0)) {
+    llvm::errs() << "FATAL ERROR: HAL could not be initialized\n";
+    return -1;
+  }
+  int samples = argc > 1 ? std::atoi(argv[1]) : kDefaultSamples;
+  samples = std::min(std::max(samples, 1), kMaxSamples);
+  double maxP99 = argc > 2 ? std::atof(argv[2]) : 0;
+
+  frc::Encoder encoder(0, 1);
+  frc::Spark motor(0);
+  LatencyProbe probe(encoder.GetFPGAIndex(), motor.GetChannel());
+  auto step = [&] { motor.Set(-encoder.Get() * kScale); };
+  bool passed = true;
+
+  {
+    frc::Notifier notifier(step);
+    notifier.StartPeriodic(kPeriod);
+    passed &= Report("Notifier", probe.Run(samples), maxP99);
+    notifier.Stop();
+  }
+
+  {
+    // P alone gives the same output as step: kScale * (0 - count)
+    frc::PIDController controller(kScale, 0, 0, &encoder, &motor, kPeriod);
+    controller.SetSetpoint(0);
+    controller.Enable();
+    passed &= Report("PIDController", probe.Run(samples), maxP99);
+    controller.Disable();
+  }
+
+  {
+    StepCommand command(step);
+    frc::Scheduler::GetInstance()->AddCommand(&command);
+    frc::Notifier notifier([] { frc::Scheduler::GetInstance()->Run(); });
+    notifier.StartPeriodic(kPeriod);
+    passed &= Report("Scheduler", probe.Run(samples), maxP99);
+    notifier.Stop();
+    command.Cancel();
+    frc::Scheduler::GetInstance()->Run();
+  }
+
+  // StartCompetition() never returns, so the robot is measured last and the
+  // process ends without unwinding while its loop is still running
+  static LatencyRobot robot(step);
+  std::thread([] { robot.StartCompetition(); }).detach();
+  passed &= Report("TimedRobot", probe.Run(samples), maxP99);
+  std::quick_exit(passed ? 0 : 1);
+}
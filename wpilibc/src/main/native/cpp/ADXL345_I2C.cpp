@@ -7,12 +7,29 @@
 
 #include "ADXL345_I2C.h"
 
+#include <algorithm>
+
 #include <HAL/HAL.h>
 
 #include "SmartDashboard/SendableBuilder.h"
+#include "Timer.h"
+#include "WPIErrors.h"
 
 using namespace frc;
 
+// Returns the BW_RATE code of the slowest output data rate of at least
+// sampleRate, and sets sampleRate to that rate
+static int RateCode(double* sampleRate) {
+  int code = 0x06;
+  double rate = 6.25;
+  while (code < 0x0F && rate < *sampleRate) {
+    code++;
+    rate *= 2;
+  }
+  *sampleRate = rate;
+  return code;
+}
+
 /**
  * Constructs the ADXL345 Accelerometer over I2C.
  *
@@ -74,6 +91,70 @@ ADXL345_I2C::AllAxes ADXL345_I2C::GetAccelerations() {
   return data;
 }
 
+/**
+ * Buffer samples in the on-chip FIFO, to be read in batches by ReadFIFO().
+ *
+ * @param sampleRate The output data rate in Hz; the next supported rate at or
+ *                   above it (6.25 Hz to 3200 Hz, doubling) is used. Above
+ *                   800 Hz the I2C bus can not keep up with the FIFO.
+ * @param watermark  The number of FIFO entries, 1 to 31, that raise the
+ *                   watermark interrupt pin of the device.
+ */
+void ADXL345_I2C::StartFIFO(double sampleRate, int watermark) {
+  if (watermark < 1 || watermark >= kFIFODepth) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "watermark");
+    return;
+  }
+  int rateCode = RateCode(&sampleRate);
+  m_sampleRate = sampleRate;
+
+  m_i2c.Write(kBWRateRegister, rateCode);
+  m_i2c.Write(kFIFOCtlRegister, kFIFOCtl_Stream | watermark);
+}
+
+/**
+ * Stop buffering samples in the FIFO.
+ */
+void ADXL345_I2C::StopFIFO() { m_i2c.Write(kFIFOCtlRegister, kFIFOCtl_Bypass); }
+
+/**
+ * Read the samples buffered in the FIFO, oldest first.
+ *
+ * Each entry takes one 6 byte I2C read. The device only samples at its
+ * output data rate, so each timestamp is the read time less one sample period
+ * per newer sample, including samples left in the FIFO.
+ *
+ * @param samples Buffer for the samples.
+ * @param count   Size of samples.
+ * @return The number of samples read.
+ */
+int ADXL345_I2C::ReadFIFO(Sample* samples, int count) {
+  uint8_t status = 0;
+  if (m_i2c.Read(kFIFOStatusRegister, 1, &status)) return 0;
+  int available = status & 0x3f;
+  int entries = std::min({available, count, kFIFODepth});
+  if (entries <= 0) return 0;
+
+  int16_t rawData[kFIFODepth][3];
+  for (int i = 0; i < entries; i++) {
+    // Each read pops one entry
+    if (m_i2c.Read(kDataRegister, sizeof(rawData[i]),
+                   reinterpret_cast<uint8_t*>(rawData[i]))) {
+      entries = i;
+      break;
+    }
+  }
+  double now = Timer::GetFPGATimestamp();
+
+  for (int i = 0; i < entries; i++) {
+    samples[i].XAxis = rawData[i][0] * kGsPerLSB;
+    samples[i].YAxis = rawData[i][1] * kGsPerLSB;
+    samples[i].ZAxis = rawData[i][2] * kGsPerLSB;
+    samples[i].timestamp = now - (available - 1 - i) / m_sampleRate;
+  }
+  return entries;
+}
+
 void ADXL345_I2C::InitSendable(SendableBuilder& builder) {
   builder.SetSmartDashboardType("3AxisAccelerometer");
   auto x = builder.GetEntry("X").GetHandle();
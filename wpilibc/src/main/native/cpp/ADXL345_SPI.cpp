@@ -7,12 +7,29 @@
 
 #include "ADXL345_SPI.h"
 
+#include <algorithm>
+
 #include <HAL/HAL.h>
 
 #include "SmartDashboard/SendableBuilder.h"
+#include "Timer.h"
+#include "WPIErrors.h"
 
 using namespace frc;
 
+// Returns the BW_RATE code of the slowest output data rate of at least
+// sampleRate, and sets sampleRate to that rate
+static int RateCode(double* sampleRate) {
+  int code = 0x06;
+  double rate = 6.25;
+  while (code < 0x0F && rate < *sampleRate) {
+    code++;
+    rate *= 2;
+  }
+  *sampleRate = rate;
+  return code;
+}
+
 /**
  * Constructor.
  *
@@ -101,6 +118,86 @@ ADXL345_SPI::AllAxes ADXL345_SPI::GetAccelerations() {
   return data;
 }
 
+/**
+ * Buffer samples in the on-chip FIFO, to be read in batches by ReadFIFO().
+ *
+ * @param sampleRate The output data rate in Hz; the next supported rate at or
+ *                   above it (6.25 Hz to 3200 Hz, doubling) is used.
+ * @param watermark  The number of FIFO entries, 1 to 31, that raise the
+ *                   watermark interrupt pin of the device.
+ */
+void ADXL345_SPI::StartFIFO(double sampleRate, int watermark) {
+  if (watermark < 1 || watermark >= kFIFODepth) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "watermark");
+    return;
+  }
+  int rateCode = RateCode(&sampleRate);
+  m_sampleRate = sampleRate;
+
+  uint8_t commands[2];
+  commands[0] = kBWRateRegister;
+  commands[1] = static_cast<uint8_t>(rateCode);
+  m_spi.Transaction(commands, commands, 2);
+  commands[0] = kFIFOCtlRegister;
+  commands[1] = static_cast<uint8_t>(kFIFOCtl_Stream | watermark);
+  m_spi.Transaction(commands, commands, 2);
+}
+
+/**
+ * Stop buffering samples in the FIFO.
+ */
+void ADXL345_SPI::StopFIFO() {
+  uint8_t commands[2];
+  commands[0] = kFIFOCtlRegister;
+  commands[1] = kFIFOCtl_Bypass;
+  m_spi.Transaction(commands, commands, 2);
+}
+
+/**
+ * Read the samples buffered in the FIFO, oldest first.
+ *
+ * All entries are drained in a single SPI batch. The device only samples at
+ * its output data rate, so each timestamp is the read time less one sample
+ * period per newer sample, including samples left in the FIFO.
+ *
+ * @param samples Buffer for the samples.
+ * @param count   Size of samples.
+ * @return The number of samples read.
+ */
+int ADXL345_SPI::ReadFIFO(Sample* samples, int count) {
+  uint8_t status[2] = {kAddress_Read | kFIFOStatusRegister, 0};
+  m_spi.Transaction(status, status, 2);
+  int available = status[1] & 0x3f;
+  int entries = std::min({available, count, kFIFODepth});
+  if (entries <= 0) return 0;
+
+  uint8_t buffers[kFIFODepth][7];
+  SPI::Transfer transfers[kFIFODepth];
+  for (int i = 0; i < entries; i++) {
+    std::fill(buffers[i], buffers[i] + 7, 0);
+    buffers[i][0] = kAddress_Read | kAddress_MultiByte | kDataRegister;
+    // Each read pops one entry; the FIFO needs 5 us between them
+    transfers[i] = SPI::Transfer{buffers[i], buffers[i], 7, true, 5};
+  }
+  if (m_spi.TransactionBatch(llvm::ArrayRef<SPI::Transfer>(transfers,
+                                                           entries)) < 0) {
+    return 0;
+  }
+  double now = Timer::GetFPGATimestamp();
+
+  for (int i = 0; i < entries; i++) {
+    // Sensor is little endian... swap bytes
+    samples[i].XAxis =
+        static_cast<int16_t>(buffers[i][2] << 8 | buffers[i][1]) * kGsPerLSB;
+    samples[i].YAxis =
+        static_cast<int16_t>(buffers[i][4] << 8 | buffers[i][3]) * kGsPerLSB;
+    samples[i].ZAxis =
+        static_cast<int16_t>(buffers[i][6] << 8 | buffers[i][5]) * kGsPerLSB;
+    samples[i].timestamp = now - (available - 1 - i) / m_sampleRate;
+  }
+  return entries;
+}
+
 void ADXL345_SPI::InitSendable(SendableBuilder& builder) {
   builder.SetSmartDashboardType("3AxisAccelerometer");
   auto x = builder.GetEntry("X").GetHandle();
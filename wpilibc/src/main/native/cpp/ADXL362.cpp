@@ -7,25 +7,45 @@
 
 #include "ADXL362.h"
 
+#include <algorithm>
+
 #include <HAL/HAL.h>
 
 #include "DriverStation.h"
 #include "SmartDashboard/SendableBuilder.h"
+#include "Timer.h"
+#include "WPIErrors.h"
 
 using namespace frc;
 
 static constexpr int kRegWrite = 0x0A;
 static constexpr int kRegRead = 0x0B;
+static constexpr int kRegReadFIFO = 0x0D;
 
 static constexpr int kPartIdRegister = 0x02;
+static constexpr int kFIFOEntriesRegister = 0x0C;
 static constexpr int kDataRegister = 0x0E;
+static constexpr int kFIFOControlRegister = 0x28;
+static constexpr int kFIFOSamplesRegister = 0x29;
 static constexpr int kFilterCtlRegister = 0x2C;
 static constexpr int kPowerCtlRegister = 0x2D;
 
 // static constexpr int kFilterCtl_Range2G = 0x00;
 // static constexpr int kFilterCtl_Range4G = 0x40;
 // static constexpr int kFilterCtl_Range8G = 0x80;
+static constexpr int kFilterCtl_ODR_12_5Hz = 0x00;
 static constexpr int kFilterCtl_ODR_100Hz = 0x03;
+static constexpr int kFilterCtl_ODR_400Hz = 0x05;
+
+static constexpr int kFIFOControl_Disabled = 0x00;
+static constexpr int kFIFOControl_Stream = 0x02;
+static constexpr int kFIFOControl_AboveHalf = 0x08;
+
+// FIFO entries are 16 bits: the axis in bits 15:14, the value in bits 13:0
+static constexpr int kFIFOAxisTemperature = 3;
+static constexpr int kFIFOMaxEntries = 511;
+// Entries drained per transaction; a whole number of X, Y, Z samples
+static constexpr int kFIFOReadEntries = 510;
 
 static constexpr int kPowerCtl_UltraLowNoise = 0x20;
 // static constexpr int kPowerCtl_AutoSleep = 0x04;
@@ -44,7 +64,8 @@ ADXL362::ADXL362(Range range) : ADXL362(SPI::Port::kOnboardCS1, range) {}
  * @param port  The SPI port the accelerometer is attached to
  * @param range The range (+ or -) that the accelerometer will measure.
  */
-ADXL362::ADXL362(SPI::Port port, Range range) : m_spi(port) {
+ADXL362::ADXL362(SPI::Port port, Range range)
+    : m_spi(port), m_odrCode(kFilterCtl_ODR_100Hz) {
   m_spi.SetClockRate(3000000);
   m_spi.SetMSBFirst();
   m_spi.SetSampleDataOnFalling();
@@ -97,8 +118,7 @@ void ADXL362::SetRange(Range range) {
   // Specify the data format to read
   commands[0] = kRegWrite;
   commands[1] = kFilterCtlRegister;
-  commands[2] =
-      kFilterCtl_ODR_100Hz | static_cast<uint8_t>((range & 0x03) << 6);
+  commands[2] = m_odrCode | static_cast<uint8_t>((range & 0x03) << 6);
   m_spi.Write(commands, 3);
 }
 
@@ -161,6 +181,107 @@ ADXL362::AllAxes ADXL362::GetAccelerations() {
   return data;
 }
 
+/**
+ * Buffer samples in the on-chip FIFO, to be read in batches by ReadFIFO().
+ *
+ * @param sampleRate The output data rate in Hz; the next supported rate at or
+ *                   above it (12.5 Hz to 400 Hz, doubling) is used.
+ * @param watermark  The number of samples, 1 to 170, that raise the watermark
+ *                   interrupt pin of the device.
+ */
+void ADXL362::StartFIFO(double sampleRate, int watermark) {
+  if (m_gsPerLSB == 0.0) return;
+  if (watermark < 1 || watermark * 3 > kFIFOMaxEntries) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "watermark");
+    return;
+  }
+  m_odrCode = kFilterCtl_ODR_12_5Hz;
+  m_sampleRate = 12.5;
+  while (m_odrCode < kFilterCtl_ODR_400Hz && m_sampleRate < sampleRate) {
+    m_odrCode++;
+    m_sampleRate *= 2;
+  }
+  m_fifoAxesRead = 0;
+
+  // Keep the range bits of the filter control register
+  uint8_t commands[3] = {kRegRead, kFilterCtlRegister, 0};
+  m_spi.Transaction(commands, commands, 3);
+  uint8_t filterCtl = (commands[2] & ~0x07) | m_odrCode;
+  commands[0] = kRegWrite;
+  commands[1] = kFilterCtlRegister;
+  commands[2] = filterCtl;
+  m_spi.Write(commands, 3);
+
+  int entries = watermark * 3;
+  uint8_t fifo[4] = {
+      kRegWrite, kFIFOControlRegister,
+      static_cast<uint8_t>(kFIFOControl_Stream |
+                           (entries > 0xff ? kFIFOControl_AboveHalf : 0)),
+      static_cast<uint8_t>(entries & 0xff)};
+  m_spi.Write(fifo, 4);
+}
+
+/**
+ * Stop buffering samples in the FIFO.
+ */
+void ADXL362::StopFIFO() {
+  if (m_gsPerLSB == 0.0) return;
+  uint8_t commands[3] = {kRegWrite, kFIFOControlRegister,
+                         kFIFOControl_Disabled};
+  m_spi.Write(commands, 3);
+}
+
+/**
+ * Read the samples buffered in the FIFO, oldest first.
+ *
+ * The FIFO is drained in a single SPI transaction. The device only samples at
+ * its output data rate, so each timestamp is the read time less one sample
+ * period per newer sample, including samples left in the FIFO.
+ *
+ * @param samples Buffer for the samples.
+ * @param count   Size of samples.
+ * @return The number of samples read.
+ */
+int ADXL362::ReadFIFO(Sample* samples, int count) {
+  if (m_gsPerLSB == 0.0) return 0;
+
+  uint8_t status[4] = {kRegRead, kFIFOEntriesRegister, 0, 0};
+  m_spi.Transaction(status, status, 4);
+  int available = status[2] | (status[3] & 0x03) << 8;
+  int entries = std::min({available, count * 3, kFIFOReadEntries});
+  if (entries <= 0) return 0;
+
+  uint8_t buffer[1 + kFIFOReadEntries * 2] = {kRegReadFIFO};
+  if (m_spi.Transaction(buffer, buffer, 1 + entries * 2) < 0) return 0;
+  double now = Timer::GetFPGATimestamp();
+
+  int read = 0;
+  for (int i = 0; i < entries; i++) {
+    int entry = buffer[2 + i * 2] << 8 | buffer[1 + i * 2];
+    int axis = entry >> 14;
+    if (axis == kFIFOAxisTemperature) continue;
+    // Sign extend the 14 bit value
+    m_fifoAxes[axis] = static_cast<int16_t>(entry << 2) / 4 * m_gsPerLSB;
+    m_fifoAxesRead |= 1 << axis;
+    if (axis != 2) continue;
+
+    // A sample is complete at its Z axis, unless the read started mid-sample
+    if (m_fifoAxesRead == 0x7) {
+      samples[read].XAxis = m_fifoAxes[0];
+      samples[read].YAxis = m_fifoAxes[1];
+      samples[read].ZAxis = m_fifoAxes[2];
+      read++;
+    }
+    m_fifoAxesRead = 0;
+  }
+
+  int remaining = (available - entries) / 3;
+  for (int i = 0; i < read; i++) {
+    samples[i].timestamp = now - (read - 1 - i + remaining) / m_sampleRate;
+  }
+  return read;
+}
+
 void ADXL362::InitSendable(SendableBuilder& builder) {
   builder.SetSmartDashboardType("3AxisAccelerometer");
   auto x = builder.GetEntry("X").GetHandle();
@@ -7,16 +7,39 @@
 
 #include "ADXRS450_Gyro.h"
 
+#include <cmath>
+
 #include <HAL/HAL.h>
 
+#include "CalibrationService.h"
 #include "DriverStation.h"
+#include "Notifier.h"
+#include "RobotController.h"
+#include "StartupProfiler.h"
 #include "Timer.h"
+#include "WPIErrors.h"
 
 using namespace frc;
 
 static constexpr double kSamplePeriod = 0.0005;
+static constexpr double kCalibrationSettleTime = 0.1;
 static constexpr double kCalibrationSampleTime = 5.0;
 static constexpr double kDegreePerSecondPerLSB = 0.0125;
+static constexpr double kTemperaturePeriod = 1.0;
+
+// Bias tracking: samples within kStationaryRate of the bias while disabled
+// move the bias by kBiasTrackingGain of the difference, a time constant of
+// about 5 seconds at the sample rate
+static constexpr double kStationaryRate = 0.5;  // degrees per second
+static constexpr double kBiasTrackingGain = 1.0e-4;
+static constexpr uint64_t kDisabledTimeout = static_cast<uint64_t>(
+    2 * CalibrationService::kDisabledPeriod * 1.0e6);
+
+// Sensor data responses: status bits, and the rate in bits 25:10
+static constexpr uint32_t kDataValidMask = 0x0c00000eu;
+static constexpr uint32_t kDataValidValue = 0x04000000u;
+static constexpr int kDataShift = 10;
+static constexpr int kDataSize = 16;
 
 static constexpr int kRateRegister = 0x00;
 static constexpr int kTemRegister = 0x02;
@@ -40,7 +63,16 @@ static constexpr int kSNLowRegister = 0x10;
  * turned on while it's sitting at rest before the competition starts.
  */
 void ADXRS450_Gyro::Calibrate() {
-  Wait(0.1);
+  StartupProfiler::Scope profile(
+      "ADXRS450_Gyro::Calibrate",
+      "use kTimestamped mode, which calibrates in the background");
+  if (m_mode == kTimestamped) {
+    StartCalibration();
+    while (IsCalibrating()) Wait(0.02);
+    return;
+  }
+
+  Wait(kCalibrationSettleTime);
 
   m_spi.SetAccumulatorCenter(0);
   m_spi.ResetAccumulator();
@@ -60,8 +92,10 @@ ADXRS450_Gyro::ADXRS450_Gyro() : ADXRS450_Gyro(SPI::kOnboardCS0) {}
  * Gyro constructor on the specified SPI port.
  *
  * @param port The SPI port the gyro is attached to.
+ * @param mode How the rate samples are integrated.
  */
-ADXRS450_Gyro::ADXRS450_Gyro(SPI::Port port) : m_spi(port) {
+ADXRS450_Gyro::ADXRS450_Gyro(SPI::Port port, IntegrationMode mode)
+    : m_spi(port), m_mode(mode) {
   m_spi.SetClockRate(3000000);
   m_spi.SetMSBFirst();
   m_spi.SetSampleDataOnRising();
@@ -74,15 +108,54 @@ ADXRS450_Gyro::ADXRS450_Gyro(SPI::Port port) : m_spi(port) {
     return;
   }
 
-  m_spi.InitAccumulator(kSamplePeriod, 0x20000000u, 4, 0x0c00000eu, 0x04000000u,
-                        10u, 16u, true, true);
+  m_spi.InitAccumulator(kSamplePeriod, 0x20000000u, 4, kDataValidMask,
+                        kDataValidValue, kDataShift, kDataSize, true, true);
+
+  if (m_mode == kTimestamped) {
+    m_spi.SetAccumulatorDecoder(
+        [this](llvm::ArrayRef<uint8_t> transfer, uint64_t timestamp) {
+          ProcessSample(transfer, timestamp);
+        });
+    UpdateTemperature();
+    m_temperatureNotifier =
+        std::make_unique<Notifier>(&ADXRS450_Gyro::UpdateTemperature, this);
+    m_temperatureNotifier->StartPeriodic(kTemperaturePeriod);
+    StartCalibration();
 
-  Calibrate();
+    CalibrationService::Job job;
+    job.calibrate = [this] {
+      // The calibration runs on the SPI stream; give up if it stalls
+      double deadline = Timer::GetFPGATimestamp() + kCalibrationSettleTime +
+                        kCalibrationSampleTime + 1.0;
+      while (IsCalibrating() && !m_closing &&
+             Timer::GetFPGATimestamp() < deadline) {
+        Wait(0.02);
+      }
+    };
+    job.progress = [this] { return GetCalibrationProgress(); };
+    job.whileDisabled = [this] {
+      m_disabledTime = RobotController::GetFPGATime();
+      // Process the samples even if nothing reads the angle while disabled
+      m_spi.GetAccumulatorCount();
+    };
+    m_calibrationJob = CalibrationService::GetInstance().AddJob(job);
+  } else {
+    Calibrate();
+  }
 
   HAL_Report(HALUsageReporting::kResourceType_ADXRS450, port);
   SetName("ADXRS450_Gyro", port);
 }
 
+ADXRS450_Gyro::~ADXRS450_Gyro() {
+  if (m_calibrationJob != 0) {
+    m_closing = true;
+    CalibrationService::GetInstance().RemoveJob(m_calibrationJob);
+  }
+  if (m_temperatureNotifier) m_temperatureNotifier->Stop();
+  m_spi.SetAccumulatorDecoder(nullptr);
+}
+
 static bool CalcParity(int v) {
   bool parity = false;
   while (v != 0) {
@@ -123,7 +196,14 @@ uint16_t ADXRS450_Gyro::ReadRegister(int reg) {
  * significant drift in the gyro and it needs to be recalibrated after it has
  * been running.
  */
-void ADXRS450_Gyro::Reset() { m_spi.ResetAccumulator(); }
+void ADXRS450_Gyro::Reset() {
+  if (m_mode == kTimestamped) {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_angle = 0.0;
+    return;
+  }
+  m_spi.ResetAccumulator();
+}
 
 /**
  * Return the actual angle in degrees that the robot is currently facing.
@@ -138,6 +218,12 @@ void ADXRS450_Gyro::Reset() { m_spi.ResetAccumulator(); }
  *         integration of the returned rate from the gyro.
  */
 double ADXRS450_Gyro::GetAngle() const {
+  if (m_mode == kTimestamped) {
+    // Process the samples received since the last update
+    m_spi.GetAccumulatorCount();
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    return m_angle;
+  }
   return m_spi.GetAccumulatorValue() * kDegreePerSecondPerLSB * kSamplePeriod;
 }
 
@@ -149,6 +235,172 @@ double ADXRS450_Gyro::GetAngle() const {
  * @return the current rate in degrees per second
  */
 double ADXRS450_Gyro::GetRate() const {
+  if (m_mode == kTimestamped) {
+    m_spi.GetAccumulatorCount();
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    return m_rate;
+  }
   return static_cast<double>(m_spi.GetAccumulatorLastValue()) *
          kDegreePerSecondPerLSB;
 }
+
+/**
+ * Start calibrating in the background. Only available in kTimestamped mode.
+ *
+ * The angle holds still until the calibration is done, so the robot must not
+ * move in the meantime; see GetCalibrationProgress().
+ */
+void ADXRS450_Gyro::StartCalibration() {
+  if (m_mode != kTimestamped) {
+    wpi_setWPIErrorWithContext(IncompatibleMode, "requires kTimestamped");
+    return;
+  }
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_calibrating = true;
+  m_calibrationStart = 0;
+  m_calibrationProgress = 0.0;
+  m_calibrationSum = 0;
+  m_calibrationCount = 0;
+  m_calibrationTemperatureSum = 0.0;
+  m_calibrationTemperatureCount = 0;
+}
+
+/**
+ * Return true while a calibration started by StartCalibration() is running.
+ */
+bool ADXRS450_Gyro::IsCalibrating() const {
+  m_spi.GetAccumulatorCount();
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_calibrating;
+}
+
+/**
+ * Return the fraction of the calibration done, from 0 to 1.
+ */
+double ADXRS450_Gyro::GetCalibrationProgress() const {
+  m_spi.GetAccumulatorCount();
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_calibrationProgress;
+}
+
+/**
+ * Track the bias while the robot is disabled and the gyro is still. Only used
+ * in kTimestamped mode.
+ *
+ * While the CalibrationService reports the robot disabled, samples within
+ * half a degree per second of the bias slowly move the bias toward them, so
+ * drift that builds up while the robot waits for a match is removed. The
+ * robot must not be turned slowly while disabled with tracking enabled.
+ *
+ * @param enabled Whether to track the bias
+ */
+void ADXRS450_Gyro::SetBiasTracking(bool enabled) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_biasTracking = enabled;
+}
+
+/**
+ * Correct the bias for the change in temperature since the last calibration.
+ * Only used in kTimestamped mode.
+ *
+ * The temperature is read once a second; each read pauses the SPI stream for
+ * a single transfer.
+ *
+ * @param coefficient The change in the bias, in degrees per second per degree
+ *                    Celsius. 0 disables the correction.
+ */
+void ADXRS450_Gyro::SetTemperatureCoefficient(double coefficient) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_temperatureCoefficient = coefficient / kDegreePerSecondPerLSB;
+}
+
+/**
+ * Return the latest temperature of the sensor in degrees Celsius, in
+ * kTimestamped mode.
+ */
+double ADXRS450_Gyro::GetTemperature() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_temperature;
+}
+
+// m_mutex must be held
+double ADXRS450_Gyro::GetBias() const {
+  if (!m_haveTemperature) return m_bias;
+  return m_bias +
+         m_temperatureCoefficient * (m_temperature - m_biasTemperature);
+}
+
+void ADXRS450_Gyro::ProcessSample(llvm::ArrayRef<uint8_t> transfer,
+                                  uint64_t timestamp) {
+  uint32_t resp = (static_cast<uint32_t>(transfer[0]) << 24) |
+                  (static_cast<uint32_t>(transfer[1]) << 16) |
+                  (static_cast<uint32_t>(transfer[2]) << 8) | transfer[3];
+  if ((resp & kDataValidMask) != kDataValidValue) return;
+  int32_t data = static_cast<int16_t>((resp >> kDataShift) & 0xffff);
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_calibrating) {
+    if (m_calibrationStart == 0) m_calibrationStart = timestamp;
+    double elapsed =
+        (timestamp - m_calibrationStart) * 1.0e-6 - kCalibrationSettleTime;
+    if (elapsed < 0.0) return;
+    m_calibrationSum += data;
+    m_calibrationCount++;
+    m_calibrationProgress = elapsed / kCalibrationSampleTime;
+    if (m_calibrationProgress < 1.0) return;
+
+    m_bias = static_cast<double>(m_calibrationSum) / m_calibrationCount;
+    if (m_calibrationTemperatureCount > 0) {
+      m_biasTemperature =
+          m_calibrationTemperatureSum / m_calibrationTemperatureCount;
+    } else {
+      m_biasTemperature = m_temperature;
+    }
+    m_calibrationProgress = 1.0;
+    m_calibrating = false;
+    m_angle = 0.0;
+    m_rate = 0.0;
+    m_lastTimestamp = timestamp;
+    return;
+  }
+
+  if (m_biasTracking) {
+    uint64_t disabledTime = m_disabledTime;
+    double error = data - GetBias();
+    if (disabledTime != 0 && timestamp < disabledTime + kDisabledTimeout &&
+        disabledTime < timestamp + kDisabledTimeout &&
+        std::abs(error) * kDegreePerSecondPerLSB < kStationaryRate) {
+      m_bias += kBiasTrackingGain * error;
+    }
+  }
+
+  // Trapezoidal integration over the actual time between the samples
+  double rate = (data - GetBias()) * kDegreePerSecondPerLSB;
+  if (m_lastTimestamp != 0) {
+    m_angle += 0.5 * (rate + m_rate) * (timestamp - m_lastTimestamp) * 1.0e-6;
+  }
+  m_rate = rate;
+  m_lastTimestamp = timestamp;
+}
+
+/**
+ * Read the temperature register. Register reads are refused while the SPI
+ * stream is running, so it is stopped for the read.
+ */
+void ADXRS450_Gyro::UpdateTemperature() {
+  m_spi.StopAuto();
+  uint16_t reg = ReadRegister(kTemRegister);
+  m_spi.StartAutoRate(kSamplePeriod);
+  if (reg == 0) return;
+
+  // 10 bit two's complement in bits 15:6, 5 LSB per degree from 45 C
+  double temperature = 45.0 + (static_cast<int16_t>(reg) >> 6) / 5.0;
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_temperature = temperature;
+  m_haveTemperature = true;
+  if (m_calibrating) {
+    m_calibrationTemperatureSum += temperature;
+    m_calibrationTemperatureCount++;
+  }
+}
@@ -7,13 +7,17 @@
 
 #include "AnalogGyro.h"
 
+#include <algorithm>
 #include <climits>
+#include <utility>
 
 #include <HAL/AnalogGyro.h>
 #include <HAL/Errors.h>
 #include <HAL/HAL.h>
 
 #include "AnalogInput.h"
+#include "CalibrationService.h"
+#include "StartupProfiler.h"
 #include "Timer.h"
 #include "WPIErrors.h"
 
@@ -24,9 +28,10 @@ using namespace frc;
  *
  * @param channel The analog channel the gyro is connected to. Gyros can only
  *                be used on on-board Analog Inputs 0-1.
+ * @param mode    Whether to calibrate in the constructor or in the background
  */
-AnalogGyro::AnalogGyro(int channel)
-    : AnalogGyro(std::make_shared<AnalogInput>(channel)) {
+AnalogGyro::AnalogGyro(int channel, CalibrationMode mode)
+    : AnalogGyro(std::make_shared<AnalogInput>(channel), mode) {
   AddChild(m_analog);
 }
 
@@ -41,10 +46,12 @@ AnalogGyro::AnalogGyro(int channel)
  *
  * @param channel A pointer to the AnalogInput object that the gyro is
  *                connected to.
+ * @param mode    Whether to calibrate in the constructor or in the background
  */
-AnalogGyro::AnalogGyro(AnalogInput* channel)
+AnalogGyro::AnalogGyro(AnalogInput* channel, CalibrationMode mode)
     : AnalogGyro(
-          std::shared_ptr<AnalogInput>(channel, NullDeleter<AnalogInput>())) {}
+          std::shared_ptr<AnalogInput>(channel, NullDeleter<AnalogInput>()),
+          mode) {}
 
 /**
  * Gyro constructor with a precreated AnalogInput object.
@@ -55,14 +62,20 @@ AnalogGyro::AnalogGyro(AnalogInput* channel)
  *
  * @param channel A pointer to the AnalogInput object that the gyro is
  *                connected to.
+ * @param mode    Whether to calibrate in the constructor or in the background
  */
-AnalogGyro::AnalogGyro(std::shared_ptr<AnalogInput> channel)
+AnalogGyro::AnalogGyro(std::shared_ptr<AnalogInput> channel,
+                       CalibrationMode mode)
     : m_analog(channel) {
   if (channel == nullptr) {
     wpi_setWPIError(NullParameter);
   } else {
     InitGyro();
-    Calibrate();
+    if (mode == kBackgroundCalibration) {
+      StartCalibration();
+    } else {
+      Calibrate();
+    }
   }
 }
 
@@ -115,7 +128,12 @@ AnalogGyro::AnalogGyro(std::shared_ptr<AnalogInput> channel, int center,
  * AnalogGyro Destructor
  *
  */
-AnalogGyro::~AnalogGyro() { HAL_FreeAnalogGyro(m_gyroHandle); }
+AnalogGyro::~AnalogGyro() {
+  if (m_calibrationJob != 0) {
+    CalibrationService::GetInstance().RemoveJob(m_calibrationJob);
+  }
+  HAL_FreeAnalogGyro(m_gyroHandle);
+}
 
 /**
  * Reset the gyro.
@@ -128,6 +146,7 @@ void AnalogGyro::Reset() {
   if (StatusIsFatal()) return;
   int32_t status = 0;
   HAL_ResetAnalogGyro(m_gyroHandle, &status);
+  InvalidateReadCache();
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -169,9 +188,66 @@ void AnalogGyro::InitGyro() {
 
 void AnalogGyro::Calibrate() {
   if (StatusIsFatal()) return;
+  StartupProfiler::Scope profile(
+      "AnalogGyro::Calibrate",
+      "use kBackgroundCalibration, or a preset center and offset");
+  RunCalibration();
+}
+
+/**
+ * Queue a calibration on the CalibrationService, which runs it while the
+ * robot is disabled. GetAngle() and GetRate() return 0 until it is done, and
+ * the robot must not move in the meantime.
+ */
+void AnalogGyro::StartCalibration() {
+  if (StatusIsFatal()) return;
+  m_calibrationStart = 0.0;
+  m_calibrating = true;
+  auto& service = CalibrationService::GetInstance();
+  if (m_calibrationJob != 0) {
+    service.Recalibrate(m_calibrationJob);
+    return;
+  }
+  CalibrationService::Job job;
+  job.calibrate = [this] {
+    // Calibrate() may have been called since the calibration was queued
+    if (m_calibrating) RunCalibration();
+  };
+  job.progress = [this] { return GetCalibrationProgress(); };
+  m_calibrationJob = service.AddJob(std::move(job));
+}
+
+/**
+ * Return true while a calibration started by StartCalibration() is queued or
+ * running.
+ */
+bool AnalogGyro::IsCalibrating() const { return m_calibrating; }
+
+/**
+ * Return the fraction of the calibration done, from 0 to 1.
+ */
+double AnalogGyro::GetCalibrationProgress() const {
+  if (!m_calibrating) return 1.0;
+  double start = m_calibrationStart;
+  if (start == 0.0) return 0.0;
+  return std::min(
+      (Timer::GetFPGATimestamp() - start) / kCalibrationSampleTime, 1.0);
+}
+
+void AnalogGyro::RunCalibration() {
+  std::lock_guard<wpi::mutex> lock(m_calibrationMutex);
+  m_calibrating = true;
+  m_calibrationStart = Timer::GetFPGATimestamp();
   int32_t status = 0;
   HAL_CalibrateAnalogGyro(m_gyroHandle, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  InvalidateReadCache();
+  m_calibrating = false;
+}
+
+void AnalogGyro::InvalidateReadCache() {
+  m_angleCache.Invalidate();
+  m_rateCache.Invalidate();
 }
 
 /**
@@ -187,11 +263,13 @@ void AnalogGyro::Calibrate() {
  *         integration of the returned rate from the gyro.
  */
 double AnalogGyro::GetAngle() const {
-  if (StatusIsFatal()) return 0.0;
-  int32_t status = 0;
-  double value = HAL_GetAnalogGyroAngle(m_gyroHandle, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
-  return value;
+  if (StatusIsFatal() || m_calibrating) return 0.0;
+  return m_angleCache.Get([=] {
+    int32_t status = 0;
+    double value = HAL_GetAnalogGyroAngle(m_gyroHandle, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return value;
+  });
 }
 
 /**
@@ -202,11 +280,38 @@ double AnalogGyro::GetAngle() const {
  * @return the current rate in degrees per second
  */
 double AnalogGyro::GetRate() const {
-  if (StatusIsFatal()) return 0.0;
+  if (StatusIsFatal() || m_calibrating) return 0.0;
+  return m_rateCache.Get([=] {
+    int32_t status = 0;
+    double value = HAL_GetAnalogGyroRate(m_gyroHandle, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return value;
+  });
+}
+
+/**
+ * Get the angle, rate and accumulator state of the gyro together.
+ *
+ * The angle and rate come from one read of the FPGA accumulator, so they
+ * agree with each other, and are stamped with the FPGA time of the read. This
+ * is one HAL call instead of the several GetAngle() and GetRate() make.
+ *
+ * @return The state of the gyro.
+ */
+AnalogGyro::Snapshot AnalogGyro::GetSnapshot() const {
+  Snapshot snapshot{0.0, 0.0, 0, 0, 0.0};
+  if (StatusIsFatal() || m_calibrating) return snapshot;
   int32_t status = 0;
-  double value = HAL_GetAnalogGyroRate(m_gyroHandle, &status);
+  HAL_AnalogGyroSnapshot halSnapshot;
+  HAL_GetAnalogGyroSnapshot(m_gyroHandle, &halSnapshot, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
-  return value;
+  if (status != 0) return snapshot;
+  snapshot.angle = halSnapshot.angle;
+  snapshot.rate = halSnapshot.rate;
+  snapshot.value = halSnapshot.value;
+  snapshot.count = halSnapshot.count;
+  snapshot.timestamp = halSnapshot.timestamp * 1.0e-6;
+  return snapshot;
 }
 
 /**
@@ -250,6 +355,7 @@ void AnalogGyro::SetSensitivity(double voltsPerDegreePerSecond) {
   int32_t status = 0;
   HAL_SetAnalogGyroVoltsPerDegreePerSecond(m_gyroHandle,
                                            voltsPerDegreePerSecond, &status);
+  InvalidateReadCache();
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -266,5 +372,6 @@ void AnalogGyro::SetDeadband(double volts) {
   if (StatusIsFatal()) return;
   int32_t status = 0;
   HAL_SetAnalogGyroDeadband(m_gyroHandle, volts, &status);
+  InvalidateReadCache();
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
@@ -7,10 +7,14 @@
 
 #include "AnalogInput.h"
 
+#include <algorithm>
+#include <string>
+
 #include <HAL/AnalogAccumulator.h>
 #include <HAL/AnalogInput.h>
 #include <HAL/HAL.h>
 #include <HAL/Ports.h>
+#include <llvm/SmallVector.h>
 
 #include "SmartDashboard/SendableBuilder.h"
 #include "Timer.h"
@@ -46,6 +50,10 @@ AnalogInput::AnalogInput(int channel) {
 
   HAL_Report(HALUsageReporting::kResourceType_AnalogChannel, channel);
   SetName("AnalogInput", channel);
+  std::string logName = ("AnalogInput/" + llvm::Twine(channel)).str();
+  m_voltageLog.Init(DeviceLogClass::kAnalogInput, logName + "/Voltage");
+  m_averageVoltageLog.Init(DeviceLogClass::kAnalogInput,
+                           logName + "/AverageVoltage");
 }
 
 /**
@@ -67,10 +75,12 @@ AnalogInput::~AnalogInput() {
  */
 int AnalogInput::GetValue() const {
   if (StatusIsFatal()) return 0;
-  int32_t status = 0;
-  int value = HAL_GetAnalogValue(m_port, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
-  return value;
+  return m_valueCache.Get([=] {
+    int32_t status = 0;
+    int value = HAL_GetAnalogValue(m_port, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return value;
+  });
 }
 
 /**
@@ -89,10 +99,12 @@ int AnalogInput::GetValue() const {
  */
 int AnalogInput::GetAverageValue() const {
   if (StatusIsFatal()) return 0;
-  int32_t status = 0;
-  int value = HAL_GetAnalogAverageValue(m_port, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
-  return value;
+  return m_averageValueCache.Get([=] {
+    int32_t status = 0;
+    int value = HAL_GetAnalogAverageValue(m_port, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return value;
+  });
 }
 
 /**
@@ -105,12 +117,36 @@ int AnalogInput::GetAverageValue() const {
  */
 double AnalogInput::GetVoltage() const {
   if (StatusIsFatal()) return 0.0;
-  int32_t status = 0;
-  double voltage = HAL_GetAnalogVoltage(m_port, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  double voltage = m_voltageCache.Get([=] {
+    int32_t status = 0;
+    double value = HAL_GetAnalogVoltage(m_port, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return value;
+  });
+  m_voltageLog.Log(voltage);
   return voltage;
 }
 
+/**
+ * Get scaled samples straight from several channels in one HAL call.
+ *
+ * @param inputs   The inputs to read.
+ * @param voltages Filled with the voltage of each input, in the order of
+ *                 inputs.
+ */
+void AnalogInput::GetVoltages(llvm::ArrayRef<const AnalogInput*> inputs,
+                              double* voltages) {
+  llvm::SmallVector<HAL_AnalogInputHandle, 8> handles;
+  for (auto input : inputs) handles.push_back(input->m_port);
+
+  int32_t status = 0;
+  HAL_GetAnalogVoltages(handles.data(), voltages, handles.size(), &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+  for (size_t i = 0; i < inputs.size(); i++) {
+    inputs[i]->m_voltageLog.Log(voltages[i]);
+  }
+}
+
 /**
  * Get a scaled sample from the output of the oversample and average engine for
  * this channel.
@@ -127,9 +163,13 @@ double AnalogInput::GetVoltage() const {
  */
 double AnalogInput::GetAverageVoltage() const {
   if (StatusIsFatal()) return 0.0;
-  int32_t status = 0;
-  double voltage = HAL_GetAnalogAverageVoltage(m_port, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  double voltage = m_averageVoltageCache.Get([=] {
+    int32_t status = 0;
+    double value = HAL_GetAnalogAverageVoltage(m_port, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return value;
+  });
+  m_averageVoltageLog.Log(voltage);
   return voltage;
 }
 
@@ -163,6 +203,13 @@ int AnalogInput::GetOffset() const {
   return offset;
 }
 
+void AnalogInput::InvalidateReadCache() {
+  m_valueCache.Invalidate();
+  m_averageValueCache.Invalidate();
+  m_voltageCache.Invalidate();
+  m_averageVoltageCache.Invalidate();
+}
+
 /**
  * Get the channel number.
  *
@@ -186,6 +233,7 @@ int AnalogInput::GetChannel() const {
  */
 void AnalogInput::SetAverageBits(int bits) {
   if (StatusIsFatal()) return;
+  InvalidateReadCache();
   int32_t status = 0;
   HAL_SetAnalogAverageBits(m_port, bits, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -218,6 +266,7 @@ int AnalogInput::GetAverageBits() const {
  */
 void AnalogInput::SetOversampleBits(int bits) {
   if (StatusIsFatal()) return;
+  InvalidateReadCache();
   int32_t status = 0;
   HAL_SetAnalogOversampleBits(m_port, bits, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -240,6 +289,99 @@ int AnalogInput::GetOversampleBits() const {
   return oversampleBits;
 }
 
+/**
+ * Configure the averaging engine of this channel for a noise and latency
+ * trade-off, instead of setting SetAverageBits() and SetOversampleBits()
+ * directly.
+ *
+ * The profile applies to GetFilteredVoltage(). kLowNoise adds a moving
+ * average in software over the readings returned by GetFilteredVoltage(), so
+ * it should be called once per loop. The sample rate is shared by all
+ * channels and isn't changed; GetFilterGroupDelay() uses the current one.
+ *
+ * @param profile The filtering preset.
+ */
+void AnalogInput::SetFilterProfile(FilterProfile profile) {
+  if (StatusIsFatal()) return;
+  int bits = 0;
+  switch (profile) {
+    case kNone:
+    case kLowLatency:
+      bits = 0;
+      break;
+    case kBalanced:
+      bits = 2;
+      break;
+    case kLowNoise:
+      bits = 4;
+      break;
+  }
+  // Each oversample bit doubles the window as much as an average bit, and
+  // GetAverageVoltage() divides both out
+  SetAverageBits(bits);
+  SetOversampleBits(bits);
+
+  std::lock_guard<wpi::mutex> lock(m_softwareFilterMutex);
+  m_filterProfile = profile;
+  m_softwareFilter.Reset();
+  m_lastFilterTime = 0.0;
+  m_filterPeriod = 0.0;
+}
+
+/**
+ * Get the filtering preset set by SetFilterProfile().
+ */
+AnalogInput::FilterProfile AnalogInput::GetFilterProfile() const {
+  std::lock_guard<wpi::mutex> lock(m_softwareFilterMutex);
+  return m_filterProfile;
+}
+
+/**
+ * Get the voltage through the filtering preset set by SetFilterProfile().
+ *
+ * @return The filtered voltage, or GetVoltage() without a preset.
+ */
+double AnalogInput::GetFilteredVoltage() const {
+  std::lock_guard<wpi::mutex> lock(m_softwareFilterMutex);
+  if (m_filterProfile == kNone) return GetVoltage();
+  double voltage = GetAverageVoltage();
+  if (m_filterProfile != kLowNoise) return voltage;
+
+  double now = Timer::GetFPGATimestamp();
+  if (m_lastFilterTime != 0.0) {
+    double period = now - m_lastFilterTime;
+    m_filterPeriod = m_filterPeriod == 0.0
+                         ? period
+                         : m_filterPeriod + 0.1 * (period - m_filterPeriod);
+  }
+  m_lastFilterTime = now;
+  return m_softwareFilter.Calculate(voltage);
+}
+
+/**
+ * Get the average age of the signal returned by GetFilteredVoltage(), so
+ * controllers can compensate for it.
+ *
+ * The hardware averages blocks of samples rather than a sliding window, so
+ * its delay is half the block plus half the time between block updates. The
+ * software stage adds half its window, measured in the time between calls to
+ * GetFilteredVoltage().
+ *
+ * @return The group delay in seconds.
+ */
+double AnalogInput::GetFilterGroupDelay() const {
+  FilterProfile profile = GetFilterProfile();
+  if (profile == kNone) return 0.0;
+
+  int samples = 1 << (GetAverageBits() + GetOversampleBits());
+  double delay = (2.0 * samples - 1.0) / (2.0 * GetSampleRate());
+  if (profile == kLowNoise) {
+    std::lock_guard<wpi::mutex> lock(m_softwareFilterMutex);
+    delay += (kSoftwareTaps - 1) / 2.0 * m_filterPeriod;
+  }
+  return delay;
+}
+
 /**
  * Is the channel attached to an accumulator.
  *
@@ -399,6 +541,101 @@ double AnalogInput::GetSampleRate() {
   return sampleRate;
 }
 
+/**
+ * Start copying every analog channel in the background, so reads from any
+ * thread no longer wait on each other.
+ *
+ * Reads are serialized through one register window in the FPGA. While the
+ * mirror runs, GetValue(), GetAverageValue() and the voltages instead read
+ * copies refreshed every period, which are up to one period old.
+ *
+ * @param period The time between refreshes, in seconds.
+ */
+void AnalogInput::StartMirror(double period) {
+  int32_t status = 0;
+  HAL_StartAnalogMirror(period, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Stop copying the analog channels in the background.
+ */
+void AnalogInput::StopMirror() {
+  int32_t status = 0;
+  HAL_StopAnalogMirror(&status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Start capturing every conversion of this channel, at the rate set by
+ * SetSampleRate(), without polling.
+ *
+ * Streaming uses the DMA engine, so it can not be combined with DMA. The
+ * capture rate is read when a stream starts.
+ *
+ * @param bufferSize The number of samples kept between calls to ReadStream();
+ *                   when it fills, the oldest samples are overwritten.
+ */
+void AnalogInput::StartStreaming(int bufferSize) {
+  if (StatusIsFatal()) return;
+  int32_t status = 0;
+  HAL_StartAnalogStream(m_port, bufferSize, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Stop capturing the conversions of this channel.
+ */
+void AnalogInput::StopStreaming() {
+  if (StatusIsFatal()) return;
+  int32_t status = 0;
+  HAL_StopAnalogStream(m_port, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Read and remove the samples captured since the last call, oldest first.
+ *
+ * @param voltages   Filled with the sample voltages.
+ * @param timestamps Filled with the FPGA time of each sample, in seconds.
+ * @param count      Size of voltages and timestamps.
+ * @return The number of samples read.
+ */
+int AnalogInput::ReadStream(double* voltages, double* timestamps, int count) {
+  if (StatusIsFatal()) return 0;
+  int32_t status = 0;
+  double lsbWeight = HAL_GetAnalogLSBWeight(m_port, &status) * 1.0e-9;
+  double offset = HAL_GetAnalogOffset(m_port, &status) * 1.0e-9;
+
+  int32_t values[64];
+  uint64_t timeStamps[64];
+  int read = 0;
+  while (read < count && status == 0) {
+    int chunk = std::min(count - read, 64);
+    int32_t got =
+        HAL_ReadAnalogStream(m_port, values, timeStamps, chunk, &status);
+    for (int32_t i = 0; i < got; i++) {
+      voltages[read + i] = lsbWeight * values[i] - offset;
+      timestamps[read + i] = timeStamps[i] * 1.0e-6;
+    }
+    read += got;
+    if (got < chunk) break;
+  }
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return read;
+}
+
+/**
+ * Returns the number of samples overwritten before they were read.
+ */
+int64_t AnalogInput::GetStreamOverflowCount() const {
+  if (StatusIsFatal()) return 0;
+  int32_t status = 0;
+  int64_t count = HAL_GetAnalogStreamOverflowCount(m_port, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return count;
+}
+
 /**
  * Get the Average value for the PID Source base object.
  *
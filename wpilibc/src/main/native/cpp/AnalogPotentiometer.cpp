@@ -65,15 +65,26 @@ AnalogPotentiometer::AnalogPotentiometer(std::shared_ptr<AnalogInput> input,
 /**
  * Get the current reading of the potentiometer.
  *
+ * The voltage is filtered by the input's AnalogInput::SetFilterProfile().
+ *
  * @return The current position of the potentiometer (in the units used for
  *         fullRange and offset).
  */
 double AnalogPotentiometer::Get() const {
-  return (m_analog_input->GetVoltage() / RobotController::GetVoltage5V()) *
+  return (m_analog_input->GetFilteredVoltage() /
+          RobotController::GetVoltage5V()) *
              m_fullRange +
          m_offset;
 }
 
+void AnalogPotentiometer::SetFilterProfile(AnalogInput::FilterProfile profile) {
+  m_analog_input->SetFilterProfile(profile);
+}
+
+double AnalogPotentiometer::GetFilterGroupDelay() const {
+  return m_analog_input->GetFilterGroupDelay();
+}
+
 /**
  * Implement the PIDSource interface.
  *
@@ -0,0 +1,361 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "AsyncI2C.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <thread>
+
+#include <HAL/HAL.h>
+#include <HAL/I2C.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "Timer.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+/**
+ * Runs the transactions of every AsyncI2C on one port.
+ */
+class AsyncI2C::Worker {
+ public:
+  static Worker& GetInstance(HAL_I2CPort port);
+
+  explicit Worker(HAL_I2CPort port);
+  ~Worker();
+
+  void Submit(std::function<void()> job);
+  void Add(std::shared_ptr<PeriodicRead> read);
+  void Remove(const PeriodicRead* read);
+
+ private:
+  void ThreadMain();
+
+  HAL_I2CPort m_port;
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::deque<std::function<void()>> m_jobs;
+  std::vector<std::shared_ptr<PeriodicRead>> m_periodicReads;
+  bool m_active = true;
+  std::thread m_thread;
+};
+
+struct AsyncI2C::PeriodicRead {
+  void Update();
+
+  HAL_I2CPort port;
+  int deviceAddress;
+  uint8_t registerAddress;
+  std::chrono::steady_clock::duration period;
+  // guarded by the worker's mutex
+  std::chrono::steady_clock::time_point nextTime;
+
+  // Only the worker writes the buffers, and only the one that is not front
+  std::vector<uint8_t> buffers[2];
+  double timestamps[2] = {0, 0};
+  // buffer holding the latest complete read, or -1 before the first one
+  int front = -1;
+  mutable wpi::mutex mutex;
+};
+
+AsyncI2C::Worker& AsyncI2C::Worker::GetInstance(HAL_I2CPort port) {
+  if (port == HAL_I2C_kMXP) {
+    static Worker mxp(HAL_I2C_kMXP);
+    return mxp;
+  }
+  static Worker onboard(HAL_I2C_kOnboard);
+  return onboard;
+}
+
+AsyncI2C::Worker::Worker(HAL_I2CPort port) : m_port(port) {
+  // Hold the port open for as long as jobs may be queued on it
+  int32_t status = 0;
+  HAL_InitializeI2C(m_port, &status);
+
+  m_thread = std::thread(&Worker::ThreadMain, this);
+}
+
+AsyncI2C::Worker::~Worker() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_active = false;
+  }
+  m_cond.notify_all();
+  if (m_thread.joinable()) m_thread.join();
+
+  HAL_CloseI2C(m_port);
+}
+
+void AsyncI2C::Worker::Submit(std::function<void()> job) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_jobs.emplace_back(std::move(job));
+  }
+  m_cond.notify_all();
+}
+
+void AsyncI2C::Worker::Add(std::shared_ptr<PeriodicRead> read) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    read->nextTime = std::chrono::steady_clock::now();
+    m_periodicReads.emplace_back(std::move(read));
+  }
+  m_cond.notify_all();
+}
+
+/**
+ * Stop scheduling a periodic read. A read already in progress keeps its
+ * PeriodicRead alive until it completes.
+ */
+void AsyncI2C::Worker::Remove(const PeriodicRead* read) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_periodicReads.erase(
+      std::remove_if(m_periodicReads.begin(), m_periodicReads.end(),
+                     [=](const std::shared_ptr<PeriodicRead>& entry) {
+                       return entry.get() == read;
+                     }),
+      m_periodicReads.end());
+}
+
+void AsyncI2C::Worker::ThreadMain() {
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  while (m_active) {
+    if (!m_jobs.empty()) {
+      auto job = std::move(m_jobs.front());
+      m_jobs.pop_front();
+      lock.unlock();
+      job();
+      lock.lock();
+      continue;
+    }
+
+    std::shared_ptr<PeriodicRead> next;
+    for (const auto& read : m_periodicReads) {
+      if (!next || read->nextTime < next->nextTime) next = read;
+    }
+    if (!next) {
+      m_cond.wait(lock);
+      continue;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (next->nextTime > now) {
+      m_cond.wait_until(lock, next->nextTime);
+      continue;
+    }
+
+    // Skip reads that were missed rather than running them back to back
+    next->nextTime += next->period;
+    if (next->nextTime < now) next->nextTime = now + next->period;
+
+    lock.unlock();
+    next->Update();
+    lock.lock();
+  }
+}
+
+void AsyncI2C::PeriodicRead::Update() {
+  int back;
+  {
+    std::lock_guard<wpi::mutex> lock(mutex);
+    back = front == 0 ? 1 : 0;
+  }
+
+  auto& buffer = buffers[back];
+  int32_t status =
+      HAL_TransactionI2C(port, deviceAddress, &registerAddress,
+                         sizeof(registerAddress), buffer.data(), buffer.size());
+  if (status < 0) return;
+  timestamps[back] = Timer::GetFPGATimestamp();
+
+  std::lock_guard<wpi::mutex> lock(mutex);
+  front = back;
+}
+
+/**
+ * Constructor.
+ *
+ * @param port          The I2C port to which the device is connected.
+ * @param deviceAddress The address of the device on the I2C bus.
+ */
+AsyncI2C::AsyncI2C(I2C::Port port, int deviceAddress)
+    : m_port(static_cast<HAL_I2CPort>(port)),
+      m_deviceAddress(deviceAddress),
+      m_worker(&Worker::GetInstance(m_port)) {
+  HAL_Report(HALUsageReporting::kResourceType_I2C, deviceAddress);
+}
+
+/**
+ * Destructor.
+ *
+ * Stops the periodic read. Transactions already queued still run.
+ */
+AsyncI2C::~AsyncI2C() { StopPeriodicRead(); }
+
+/**
+ * Queue a generic transaction.
+ *
+ * @param dataToSend  Data to send as part of the transaction. It is copied, so
+ *                    the caller's buffer may be reused immediately.
+ * @param receiveSize Number of bytes to read from the device.
+ * @param callback    Called from the port's worker thread with the result.
+ */
+void AsyncI2C::Transaction(llvm::ArrayRef<uint8_t> dataToSend, int receiveSize,
+                           Callback callback) {
+  if (receiveSize < 0) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "receiveSize");
+    return;
+  }
+
+  std::vector<uint8_t> send(dataToSend.begin(), dataToSend.end());
+  HAL_I2CPort port = m_port;
+  int deviceAddress = m_deviceAddress;
+  m_worker->Submit([=] {
+    Result result;
+    result.data.resize(receiveSize);
+    int32_t status =
+        HAL_TransactionI2C(port, deviceAddress, send.data(), send.size(),
+                           result.data.data(), receiveSize);
+    result.aborted = status < 0;
+    if (callback) callback(result);
+  });
+}
+
+/**
+ * Queue a generic transaction.
+ *
+ * @param dataToSend  Data to send as part of the transaction. It is copied, so
+ *                    the caller's buffer may be reused immediately.
+ * @param receiveSize Number of bytes to read from the device.
+ * @return A future that becomes ready once the transaction has run.
+ */
+std::future<AsyncI2C::Result> AsyncI2C::Transaction(
+    llvm::ArrayRef<uint8_t> dataToSend, int receiveSize) {
+  auto promise = std::make_shared<std::promise<Result>>();
+  auto future = promise->get_future();
+  Transaction(dataToSend, receiveSize,
+              [=](const Result& result) { promise->set_value(result); });
+  return future;
+}
+
+/**
+ * Queue a write of a single byte to a register on the device.
+ *
+ * @param registerAddress The address of the register on the device to be
+ *                        written.
+ * @param data            The byte to write to the register on the device.
+ * @return A future that becomes ready once the write has run.
+ */
+std::future<AsyncI2C::Result> AsyncI2C::Write(int registerAddress,
+                                              uint8_t data) {
+  auto promise = std::make_shared<std::promise<Result>>();
+  auto future = promise->get_future();
+  HAL_I2CPort port = m_port;
+  int deviceAddress = m_deviceAddress;
+  m_worker->Submit([=] {
+    uint8_t buffer[2];
+    buffer[0] = registerAddress;
+    buffer[1] = data;
+    Result result;
+    result.aborted =
+        HAL_WriteI2C(port, deviceAddress, buffer, sizeof(buffer)) < 0;
+    promise->set_value(result);
+  });
+  return future;
+}
+
+/**
+ * Queue a read of consecutive registers from the device.
+ *
+ * @param registerAddress The register to read first in the transaction.
+ * @param count           The number of bytes to read in the transaction.
+ * @return A future that becomes ready once the read has run.
+ */
+std::future<AsyncI2C::Result> AsyncI2C::Read(int registerAddress, int count) {
+  if (count < 1) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "count");
+    std::promise<Result> promise;
+    promise.set_value(Result());
+    return promise.get_future();
+  }
+  uint8_t regAddr = registerAddress;
+  return Transaction(regAddr, count);
+}
+
+/**
+ * Read consecutive registers from the device every period from the port's
+ * worker thread. Replaces any periodic read already running on this object.
+ *
+ * @param registerAddress The register to read first in each transaction.
+ * @param count           The number of bytes to read in each transaction.
+ * @param period          The time between reads, in seconds.
+ */
+void AsyncI2C::StartPeriodicRead(int registerAddress, int count,
+                                 double period) {
+  if (count < 1) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "count");
+    return;
+  }
+  if (period <= 0) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "period");
+    return;
+  }
+
+  StopPeriodicRead();
+
+  auto read = std::make_shared<PeriodicRead>();
+  read->port = m_port;
+  read->deviceAddress = m_deviceAddress;
+  read->registerAddress = registerAddress;
+  read->period =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(period));
+  read->buffers[0].resize(count);
+  read->buffers[1].resize(count);
+  m_periodicRead = read;
+  m_worker->Add(std::move(read));
+}
+
+void AsyncI2C::StopPeriodicRead() {
+  if (!m_periodicRead) return;
+  m_worker->Remove(m_periodicRead.get());
+  m_periodicRead.reset();
+}
+
+/**
+ * Copy out the latest complete periodic read. This never waits on the bus.
+ *
+ * @param data      Buffer to copy the registers into.
+ * @param count     Size of data; at most the count given to
+ *                  StartPeriodicRead() bytes are copied.
+ * @param timestamp If not null, set to the FPGA time of the read, in seconds.
+ * @return False if no periodic read is running or none has completed yet.
+ */
+bool AsyncI2C::GetPeriodicRead(uint8_t* data, int count,
+                               double* timestamp) const {
+  if (data == nullptr) {
+    wpi_setWPIErrorWithContext(NullParameter, "data");
+    return false;
+  }
+  if (count < 0) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "count");
+    return false;
+  }
+  if (!m_periodicRead) return false;
+
+  const auto& read = *m_periodicRead;
+  std::lock_guard<wpi::mutex> lock(read.mutex);
+  if (read.front < 0) return false;
+  const auto& buffer = read.buffers[read.front];
+  std::copy_n(buffer.begin(), std::min<size_t>(count, buffer.size()), data);
+  if (timestamp) *timestamp = read.timestamps[read.front];
+  return true;
+}
@@ -7,6 +7,8 @@
 
 #include "BuiltInAccelerometer.h"
 
+#include <algorithm>
+
 #include <HAL/Accelerometer.h>
 #include <HAL/HAL.h>
 
@@ -54,6 +56,76 @@ double BuiltInAccelerometer::GetY() { return HAL_GetAccelerometerY(); }
  */
 double BuiltInAccelerometer::GetZ() { return HAL_GetAccelerometerZ(); }
 
+/**
+ * Get the acceleration of the roboRIO along all three axes, read together.
+ *
+ * @return An object containing the acceleration measured on each axis in
+ *         g-forces
+ */
+BuiltInAccelerometer::AllAxes BuiltInAccelerometer::GetAccelerations() {
+  AllAxes data;
+  HAL_GetAccelerometerXYZ(&data.XAxis, &data.YAxis, &data.ZAxis);
+  return data;
+}
+
+/**
+ * Start reading the accelerometer in the background at its output data rate
+ * of 800 Hz, so short events like collisions aren't missed between polls.
+ *
+ * @param bufferSize The number of samples kept between calls to
+ *                   ReadSamples(); when it fills, the oldest samples are
+ *                   overwritten.
+ */
+void BuiltInAccelerometer::StartSampling(int bufferSize) {
+  int32_t status = 0;
+  HAL_StartAccelerometerSampler(bufferSize, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Stop reading the accelerometer in the background.
+ */
+void BuiltInAccelerometer::StopSampling() {
+  int32_t status = 0;
+  HAL_StopAccelerometerSampler(&status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Read and remove the samples taken since the last call, oldest first.
+ *
+ * @param samples Filled with the samples.
+ * @param count   Size of samples.
+ * @return The number of samples read.
+ */
+int BuiltInAccelerometer::ReadSamples(Sample* samples, int count) {
+  int32_t status = 0;
+  HAL_AccelerometerSample raw[64];
+  int read = 0;
+  while (read < count && status == 0) {
+    int chunk = std::min(count - read, 64);
+    int32_t got = HAL_ReadAccelerometerSamples(raw, chunk, &status);
+    for (int32_t i = 0; i < got; i++) {
+      samples[read + i] = Sample{raw[i].x, raw[i].y, raw[i].z,
+                                 raw[i].timeStamp * 1.0e-6};
+    }
+    read += got;
+    if (got < chunk) break;
+  }
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return read;
+}
+
+/**
+ * Returns the number of samples overwritten before they were read.
+ */
+int64_t BuiltInAccelerometer::GetSampleOverflowCount() const {
+  int32_t status = 0;
+  int64_t count = HAL_GetAccelerometerSamplerOverflowCount(&status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return count;
+}
+
 void BuiltInAccelerometer::InitSendable(SendableBuilder& builder) {
   builder.SetSmartDashboardType("3AxisAccelerometer");
   builder.AddDoubleProperty("X", [=]() { return GetX(); }, nullptr);
@@ -15,3 +15,7 @@ ButtonScheduler::ButtonScheduler(bool last, Trigger* button, Command* orders)
     : m_pressedLast(last), m_button(button), m_command(orders) {}
 
 void ButtonScheduler::Start() { Scheduler::GetInstance()->AddButton(this); }
+
+Trigger* ButtonScheduler::GetTrigger() const { return m_button; }
+
+bool ButtonScheduler::IsEdgeTriggered() const { return true; }
@@ -27,3 +27,5 @@ void HeldButtonScheduler::Execute() {
     }
   }
 }
+
+bool HeldButtonScheduler::IsEdgeTriggered() const { return false; }
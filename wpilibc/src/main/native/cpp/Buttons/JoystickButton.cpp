@@ -13,3 +13,9 @@ JoystickButton::JoystickButton(GenericHID* joystick, int buttonNumber)
     : m_joystick(joystick), m_buttonNumber(buttonNumber) {}
 
 bool JoystickButton::Get() { return m_joystick->GetRawButton(m_buttonNumber); }
+
+bool JoystickButton::GetJoystickButton(int* stick, int* button) const {
+  *stick = m_joystick->GetPort();
+  *button = m_buttonNumber;
+  return true;
+}
@@ -10,6 +10,8 @@
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableInstance.h>
 
+#include "Timer.h"
+
 using namespace frc;
 
 NetworkButton::NetworkButton(const llvm::Twine& tableName,
@@ -19,8 +21,73 @@ NetworkButton::NetworkButton(const llvm::Twine& tableName,
 
 NetworkButton::NetworkButton(std::shared_ptr<nt::NetworkTable> table,
                              const llvm::Twine& field)
-    : m_entry(table->GetEntry(field)) {}
+    : m_entry(table->GetEntry(field)) {
+  m_entryListener = m_entry.AddListener(
+      [=](const nt::EntryNotification& event) {
+        UpdateValue(event.value && event.value->IsBoolean() &&
+                    event.value->GetBoolean());
+      },
+      NT_NOTIFY_IMMEDIATE | NT_NOTIFY_NEW | NT_NOTIFY_UPDATE |
+          NT_NOTIFY_DELETE);
+  // A server can have several clients, so the instance is asked whether any
+  // remain rather than trusting the event
+  m_connectionListener = m_entry.GetInstance().AddConnectionListener(
+      [=](const nt::ConnectionNotification& event) {
+        m_connected = m_entry.GetInstance().IsConnected();
+      },
+      true);
+}
 
+NetworkButton::~NetworkButton() {
+  m_entry.RemoveListener(m_entryListener);
+  nt::NetworkTableInstance::RemoveConnectionListener(m_connectionListener);
+}
+
+/**
+ * Returns the state of the entry, or false while no dashboard is connected.
+ *
+ * This only reads state cached by NetworkTables listeners.
+ */
 bool NetworkButton::Get() {
-  return m_entry.GetInstance().IsConnected() && m_entry.GetBoolean(false);
+  if (!m_connected) return false;
+  bool value = m_value;
+  if (value != m_debounced) {
+    double period = m_debouncePeriod;
+    if (period <= 0.0 || Timer::GetFPGATimestamp() - m_changeTime >= period) {
+      m_debounced = value;
+    }
+  }
+  if (m_latching && m_pressed.exchange(false)) return true;
+  return m_debounced;
+}
+
+/**
+ * Sets how long the entry must keep a new state before Get() reports it.
+ *
+ * @param seconds The debounce period; 0 reports changes immediately.
+ */
+void NetworkButton::SetDebouncePeriod(double seconds) {
+  m_debouncePeriod = seconds;
+}
+
+/**
+ * Sets whether a press is held until Get() sees it.
+ *
+ * When latching, Get() returns true once for each press made since its last
+ * call, however short, so a dashboard button tapped between two Scheduler
+ * loops still triggers its command. Latched presses aren't debounced.
+ *
+ * @param latching True to latch presses
+ */
+void NetworkButton::SetLatching(bool latching) {
+  m_pressed = false;
+  m_latching = latching;
+}
+
+// Called by the NetworkTables listener thread
+void NetworkButton::UpdateValue(bool value) {
+  if (m_value == value) return;
+  m_changeTime = Timer::GetFPGATimestamp();
+  m_value = value;
+  if (value) m_pressed = true;
 }
@@ -17,6 +17,26 @@ using namespace frc;
 
 bool Trigger::Grab() { return Get() || m_sendablePressed; }
 
+/**
+ * If this trigger follows a single joystick button, gets that button.
+ *
+ * The Scheduler uses this in button edge detection mode to only poll the
+ * trigger when the button changes. Triggers that read anything else return
+ * false and are polled every time.
+ *
+ * @param stick  Set to the joystick port.
+ * @param button Set to the button number, starting at 1.
+ * @return True if the trigger follows a joystick button.
+ */
+bool Trigger::GetJoystickButton(int*, int*) const {
+  return false;
+}
+
+/**
+ * Returns whether the trigger is pressed from the dashboard.
+ */
+bool Trigger::GetDashboardPressed() const { return m_sendablePressed; }
+
 void Trigger::WhenActive(Command* command) {
   auto pbs = new PressedButtonScheduler(Grab(), this, command);
   pbs->Start();
@@ -0,0 +1,156 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "CANStreamReader.h"
+
+#include <algorithm>
+
+#include <HAL/HAL.h>
+
+#include "Notifier.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+// Messages read from a session per HAL call
+static constexpr uint32_t kBatchSize = 32;
+
+/**
+ * Constructor.
+ *
+ * @param period      The time between reads of the sessions, in seconds.
+ * @param historySize The number of messages kept for each message ID.
+ */
+CANStreamReader::CANStreamReader(double period, int historySize)
+    : m_historySize(historySize) {
+  if (m_historySize < 1) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "historySize");
+    m_historySize = 1;
+  }
+
+  m_notifier = std::make_unique<Notifier>(&CANStreamReader::Update, this);
+  m_notifier->StartPeriodic(period);
+}
+
+CANStreamReader::~CANStreamReader() {
+  m_notifier->Stop();
+
+  for (auto session : m_sessions) HAL_CAN_CloseStreamSession(session);
+}
+
+/**
+ * Open a stream session receiving every message whose ID matches messageID
+ * in the bits set in messageIDMask.
+ *
+ * @param messageID     The message ID to match.
+ * @param messageIDMask The bits of the message ID to compare.
+ * @param maxMessages   The number of messages the session buffers between
+ *                      reads; older messages are lost on overrun.
+ * @return True if the session was opened.
+ */
+bool CANStreamReader::AddFilter(uint32_t messageID, uint32_t messageIDMask,
+                                uint32_t maxMessages) {
+  uint32_t session = 0;
+  int32_t status = 0;
+  HAL_CAN_OpenStreamSession(&session, messageID, messageIDMask, maxMessages,
+                            &status);
+  if (status != 0) {
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return false;
+  }
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_sessions.push_back(session);
+  return true;
+}
+
+/**
+ * Get the latest message received with an ID.
+ *
+ * @param messageID The message ID.
+ * @param message   Set to the message.
+ * @return False if no message with this ID has been received.
+ */
+bool CANStreamReader::GetLatest(uint32_t messageID, Message* message) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_history.find(messageID);
+  if (it == m_history.end()) return false;
+  const auto& history = it->second;
+  size_t capacity = history.messages.size();
+  *message = history.messages[(history.next + capacity - 1) % capacity];
+  return true;
+}
+
+/**
+ * Get the latest messages received with an ID, oldest first.
+ *
+ * @param messageID The message ID.
+ * @param messages  Buffer to copy the messages into.
+ * @param count     Size of messages.
+ * @return The number of messages copied.
+ */
+int CANStreamReader::GetHistory(uint32_t messageID, Message* messages,
+                                int count) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_history.find(messageID);
+  if (it == m_history.end()) return 0;
+
+  const auto& history = it->second;
+  size_t capacity = history.messages.size();
+  size_t copied = std::min<size_t>(history.size, std::max(count, 0));
+  size_t first = history.next + capacity - copied;
+  for (size_t i = 0; i < copied; i++)
+    messages[i] = history.messages[(first + i) % capacity];
+  return copied;
+}
+
+/**
+ * Returns the number of messages received.
+ */
+int64_t CANStreamReader::GetMessageCount() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_messageCount;
+}
+
+/**
+ * Returns the number of reads in which a session reported lost messages.
+ */
+int64_t CANStreamReader::GetOverrunCount() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_overrunCount;
+}
+
+/**
+ * Drain every session. This should only be called by the Notifier.
+ */
+void CANStreamReader::Update() {
+  Message messages[kBatchSize];
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  for (auto session : m_sessions) {
+    uint32_t read;
+    do {
+      read = 0;
+      int32_t status = 0;
+      HAL_CAN_ReadStreamSession(session, messages, kBatchSize, &read, &status);
+      if (status == HAL_ERR_CANSessionMux_SessionOverrun) {
+        m_overrunCount++;
+      } else if (status < 0) {
+        break;
+      }
+
+      for (uint32_t i = 0; i < read; i++) {
+        auto& history = m_history[messages[i].messageID];
+        if (history.messages.empty()) history.messages.resize(m_historySize);
+        history.messages[history.next] = messages[i];
+        history.next = (history.next + 1) % history.messages.size();
+        if (history.size < history.messages.size()) history.size++;
+      }
+      m_messageCount += read;
+    } while (read == kBatchSize);
+  }
+}
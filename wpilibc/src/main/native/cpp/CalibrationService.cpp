@@ -0,0 +1,188 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "CalibrationService.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "DriverStation.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+/**
+ * Returns the calibration service, starting its thread on first use.
+ */
+CalibrationService& CalibrationService::GetInstance() {
+  static CalibrationService instance;
+  return instance;
+}
+
+CalibrationService::~CalibrationService() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  if (m_thread.joinable()) m_thread.join();
+}
+
+/**
+ * Adds a calibration job. It runs the next time the service is idle while the
+ * robot is disabled.
+ *
+ * @param job The job; calibrate must be set
+ * @return A handle to the job, or 0 if it was not added
+ */
+int CalibrationService::AddJob(Job job) {
+  if (!job.calibrate) {
+    wpi_setWPIErrorWithContext(NullParameter, "calibrate");
+    return 0;
+  }
+  int id;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    id = m_nextId++;
+    m_jobs.push_back({id, std::move(job), false, 0});
+    if (!m_thread.joinable()) {
+      m_thread = std::thread(&CalibrationService::ThreadMain, this);
+    }
+  }
+  m_cond.notify_all();
+  return id;
+}
+
+/**
+ * Removes a job, waiting for it to return if it is running. Must be called
+ * before anything the job's functions use is destroyed, and not from a job.
+ *
+ * @param job The handle returned by AddJob()
+ */
+void CalibrationService::RemoveJob(int job) {
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  auto it = Find(job);
+  if (it != m_jobs.end()) m_jobs.erase(it);
+  m_cond.wait(lock, [=] { return m_running != job; });
+}
+
+/**
+ * Calibrates a job again. It is not ready until the new calibration is done.
+ *
+ * @param job The handle returned by AddJob()
+ */
+void CalibrationService::Recalibrate(int job) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    auto it = Find(job);
+    if (it == m_jobs.end()) return;
+    it->ready = false;
+    it->generation++;
+  }
+  m_cond.notify_all();
+}
+
+/**
+ * Returns whether a job has finished calibrating.
+ *
+ * @param job The handle returned by AddJob()
+ */
+bool CalibrationService::IsReady(int job) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = Find(job);
+  return it != m_jobs.end() && it->ready;
+}
+
+/**
+ * Returns whether every job has finished calibrating.
+ */
+bool CalibrationService::IsReady() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return std::all_of(m_jobs.begin(), m_jobs.end(),
+                     [](const Entry& entry) { return entry.ready; });
+}
+
+/**
+ * Returns the fraction of all calibration done, from 0 to 1.
+ */
+double CalibrationService::GetProgress() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_jobs.empty()) return 1.0;
+  double sum = 0.0;
+  for (const auto& entry : m_jobs) {
+    if (entry.ready) {
+      sum += 1.0;
+    } else if (entry.id == m_running && entry.job.progress) {
+      sum += std::min(std::max(entry.job.progress(), 0.0), 1.0);
+    }
+  }
+  return sum / m_jobs.size();
+}
+
+void CalibrationService::ThreadMain() {
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  while (!m_stop) {
+    lock.unlock();
+    bool disabled = DriverStation::GetInstance().IsDisabled();
+    lock.lock();
+    if (m_stop) break;
+
+    if (disabled) {
+      auto pending = std::find_if(m_jobs.begin(), m_jobs.end(),
+                                  [](const Entry& entry) {
+                                    return !entry.ready;
+                                  });
+      if (pending != m_jobs.end()) {
+        int id = pending->id;
+        int generation = pending->generation;
+        auto calibrate = pending->job.calibrate;
+        RunJob(lock, id, calibrate);
+        auto it = Find(id);
+        if (it != m_jobs.end() && it->generation == generation) {
+          it->ready = true;
+        }
+        continue;
+      }
+
+      // Each job is looked up again, as the list may change while unlocked
+      for (size_t i = 0; i < m_jobs.size(); i++) {
+        if (!m_jobs[i].job.whileDisabled) continue;
+        auto whileDisabled = m_jobs[i].job.whileDisabled;
+        int id = m_jobs[i].id;
+        RunJob(lock, id, whileDisabled);
+        auto it = Find(id);
+        if (it == m_jobs.end()) break;
+        i = it - m_jobs.begin();
+      }
+    }
+
+    m_cond.wait_for(lock, std::chrono::duration<double>(kDisabledPeriod));
+  }
+}
+
+void CalibrationService::RunJob(std::unique_lock<wpi::mutex>& lock, int id,
+                                const std::function<void()>& func) {
+  m_running = id;
+  lock.unlock();
+  func();
+  lock.lock();
+  m_running = 0;
+  m_cond.notify_all();
+}
+
+std::vector<CalibrationService::Entry>::iterator CalibrationService::Find(
+    int id) {
+  return std::find_if(m_jobs.begin(), m_jobs.end(),
+                      [=](const Entry& entry) { return entry.id == id; });
+}
+
+std::vector<CalibrationService::Entry>::const_iterator CalibrationService::Find(
+    int id) const {
+  return std::find_if(m_jobs.begin(), m_jobs.end(),
+                      [=](const Entry& entry) { return entry.id == id; });
+}
@@ -7,17 +7,136 @@
 
 #include "CameraServer.h"
 
+#include <algorithm>
+#include <thread>
+
 #include <HAL/HAL.h>
 #include <llvm/SmallString.h>
 #include <llvm/raw_ostream.h>
 #include <networktables/NetworkTableInstance.h>
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+#include <support/timestamp.h>
 
+#include "NotifierExecutor.h"
+#include "RobotController.h"
+#include "StartupProfiler.h"
 #include "Utility.h"
 #include "WPIErrors.h"
 #include "ntcore_cpp.h"
 
 using namespace frc;
 
+// Video events arriving within this many seconds of each other are published
+// together
+static constexpr double kPublishCoalescePeriod = 0.1;
+
+// Printed when opening a USB camera slows down startup
+static constexpr const char* kCameraStartupHint =
+    "start cameras from another thread";
+
+/**
+ * Converts the frames of a server's source to the server's stream profile.
+ *
+ * The input sink grabs from the server's source on a thread of its own, and
+ * the server sends the converted frames put to the output source.
+ */
+class CameraServer::ProfiledStream {
+ public:
+  ProfiledStream(llvm::StringRef serverName, CS_Sink server,
+                 const StreamProfile& profile);
+  ~ProfiledStream();
+
+  CS_Sink GetServer() const { return m_server; }
+  CS_Source GetInput() const { return m_input; }
+  CS_Source GetOutput() const { return m_output.GetHandle(); }
+  const StreamProfile& GetProfile() const { return m_profile; }
+
+  void SetInput(CS_Source source);
+
+ private:
+  void ThreadMain();
+
+  CS_Sink m_server;
+  StreamProfile m_profile;
+  CS_Source m_input = 0;
+  cs::CvSink m_sink;
+  cs::CvSource m_output;
+  std::atomic_bool m_active{true};
+  std::thread m_thread;
+};
+
+CameraServer::ProfiledStream::ProfiledStream(llvm::StringRef serverName,
+                                             CS_Sink server,
+                                             const StreamProfile& profile)
+    : m_server(server),
+      m_profile(profile),
+      m_sink(serverName.str() + " profile input"),
+      m_output(serverName.str() + " profile", cs::VideoMode::kMJPEG,
+               profile.width, profile.height, profile.maxFPS) {
+  m_thread = std::thread(&ProfiledStream::ThreadMain, this);
+}
+
+CameraServer::ProfiledStream::~ProfiledStream() {
+  m_active = false;
+  // GrabFrame() times out, so the thread sees the flag even without frames
+  m_thread.join();
+}
+
+void CameraServer::ProfiledStream::SetInput(CS_Source source) {
+  CS_Status status = 0;
+  m_input = source;
+  cs::SetSinkSource(m_sink.GetHandle(), source, &status);
+  if (source == 0) return;
+
+  // Describe the stream as the input's mode with the profile applied
+  auto mode = cs::GetSourceVideoMode(source, &status);
+  if (m_profile.width > 0 && m_profile.height > 0) {
+    mode.width = m_profile.width;
+    mode.height = m_profile.height;
+  }
+  if (m_profile.maxFPS > 0 && (mode.fps == 0 || mode.fps > m_profile.maxFPS))
+    mode.fps = m_profile.maxFPS;
+  mode.pixelFormat = cs::VideoMode::kMJPEG;
+  cs::SetSourceVideoMode(m_output.GetHandle(), mode, &status);
+}
+
+void CameraServer::ProfiledStream::ThreadMain() {
+  // Reused every frame, so steady-state conversion does not allocate
+  cv::Mat frame;
+  cv::Mat gray;
+  cv::Mat resized;
+
+  uint64_t period = m_profile.maxFPS > 0 ? 1000000 / m_profile.maxFPS : 0;
+  uint64_t nextFrameTime = 0;
+  bool resize = m_profile.width > 0 && m_profile.height > 0;
+
+  while (m_active) {
+    // Times out while the input is missing or disconnected
+    uint64_t frameTime = m_sink.GrabFrame(frame);
+    if (frameTime == 0) continue;
+
+    // Allow half a period of jitter, so capping a 30 fps camera at 15 fps
+    // sends every other frame rather than every third
+    if (frameTime + period / 2 < nextFrameTime) continue;
+    nextFrameTime = std::max(nextFrameTime + period, frameTime);
+
+    cv::Mat* image = &frame;
+    // Convert before resizing, so only one channel is resized
+    if (m_profile.grayscale && image->channels() == 3) {
+      cv::cvtColor(*image, gray, cv::COLOR_BGR2GRAY);
+      image = &gray;
+    }
+    if (resize &&
+        (image->cols != m_profile.width || image->rows != m_profile.height)) {
+      cv::resize(*image, resized, cv::Size(m_profile.width, m_profile.height),
+                 0, 0, cv::INTER_AREA);
+      image = &resized;
+    }
+    m_output.PutFrame(*image);
+  }
+}
+
 CameraServer* CameraServer::GetInstance() {
   static CameraServer instance;
   return &instance;
@@ -55,10 +174,12 @@ static llvm::StringRef MakeSourceValue(CS_Source source,
   return llvm::StringRef{buf.begin(), buf.size()};
 }
 
-static std::string MakeStreamValue(llvm::StringRef address, int port) {
+static std::string MakeStreamValue(llvm::StringRef address, int port,
+                                   int compression = -1) {
   std::string rv;
   llvm::raw_string_ostream stream(rv);
   stream << "mjpg:http://" << address << ':' << port << "/?action=stream";
+  if (compression >= 0) stream << "&compression=" << compression;
   stream.flush();
   return rv;
 }
@@ -69,6 +190,7 @@ std::shared_ptr<nt::NetworkTable> CameraServer::GetSourceTable(
   return m_tables.lookup(source);
 }
 
+// Must be called with m_mutex held
 std::vector<std::string> CameraServer::GetSinkStreamValues(CS_Sink sink) {
   CS_Status status = 0;
 
@@ -79,19 +201,25 @@ std::vector<std::string> CameraServer::GetSinkStreamValues(CS_Sink sink) {
   // Get port
   int port = cs::GetMjpegServerPort(sink, &status);
 
+  // The server encodes with the quality its clients ask for in the URL
+  int quality = -1;
+  if (ProfiledStream* stream = FindProfiledStream(sink))
+    quality = stream->GetProfile().quality;
+
   // Generate values
   std::vector<std::string> values;
   auto listenAddress = cs::GetMjpegServerListenAddress(sink, &status);
   if (!listenAddress.empty()) {
     // If a listen address is specified, only use that
-    values.emplace_back(MakeStreamValue(listenAddress, port));
+    values.emplace_back(MakeStreamValue(listenAddress, port, quality));
   } else {
     // Otherwise generate for hostname and all interface addresses
-    values.emplace_back(MakeStreamValue(cs::GetHostname() + ".local", port));
+    values.emplace_back(
+        MakeStreamValue(cs::GetHostname() + ".local", port, quality));
 
     for (const auto& addr : m_addresses) {
       if (addr == "127.0.0.1") continue;  // ignore localhost
-      values.emplace_back(MakeStreamValue(addr, port));
+      values.emplace_back(MakeStreamValue(addr, port, quality));
     }
   }
 
@@ -133,8 +261,12 @@ void CameraServer::UpdateStreamValues() {
     CS_Status status = 0;
     CS_Sink sink = i.second.GetHandle();
 
-    // Get the source's subtable (if none exists, we're done)
+    // Get the source's subtable (if none exists, we're done). A profiled
+    // server is published under the camera its profile reads from.
     CS_Source source = cs::GetSinkSource(sink, &status);
+    if (ProfiledStream* stream = FindProfiledStream(sink)) {
+      if (source == stream->GetOutput()) source = stream->GetInput();
+    }
     if (source == 0) continue;
     auto table = m_tables.lookup(source);
     if (table) {
@@ -143,7 +275,9 @@ void CameraServer::UpdateStreamValues() {
 
       // Set table value
       auto values = GetSinkStreamValues(sink);
-      if (!values.empty()) table->GetEntry("streams").SetStringArray(values);
+      if (!values.empty()) {
+        PublishStreamValues(table.get(), source, std::move(values));
+      }
     }
   }
 
@@ -156,11 +290,23 @@ void CameraServer::UpdateStreamValues() {
     if (table) {
       // Set table value
       auto values = GetSourceStreamValues(source);
-      if (!values.empty()) table->GetEntry("streams").SetStringArray(values);
+      if (!values.empty()) {
+        PublishStreamValues(table.get(), source, std::move(values));
+      }
     }
   }
 }
 
+// Must be called with m_mutex held
+void CameraServer::PublishStreamValues(nt::NetworkTable* table,
+                                       CS_Source source,
+                                       std::vector<std::string> values) {
+  auto& published = m_publishedStreams[source];
+  if (values == published) return;
+  table->GetEntry("streams").SetStringArray(values);
+  published = std::move(values);
+}
+
 static std::string PixelFormatToString(int pixelFormat) {
   switch (pixelFormat) {
     case cs::VideoMode::PixelFormat::kMJPEG:
@@ -195,6 +341,76 @@ static std::vector<std::string> GetSourceModeValues(int source) {
   return rv;
 }
 
+void CameraServer::PublishModeValues(CS_Source source) {
+  // Formatting every mode is slow, so it is done once per modes update
+  auto values = GetSourceModeValues(source);
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto table = m_tables.lookup(source);
+  if (!table) return;
+  auto& published = m_publishedModes[source];
+  if (values == published) return;
+  table->GetEntry("modes").SetStringArray(values);
+  published = std::move(values);
+}
+
+// Must be called with m_mutex held
+void CameraServer::SchedulePublish() {
+  if (m_publishPending) return;
+  m_publishPending = true;
+  m_publishNotifier->StartSingle(kPublishCoalescePeriod);
+}
+
+/**
+ * Publishes the stream URLs and video modes that changed since the last call,
+ * once for however many video events asked for them.
+ */
+void CameraServer::PublishPending() {
+  bool streamsDirty;
+  std::vector<CS_Source> dirtyModes;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_publishPending = false;
+    streamsDirty = m_streamsDirty;
+    m_streamsDirty = false;
+    dirtyModes.swap(m_dirtyModes);
+  }
+
+  if (streamsDirty) {
+    auto addresses = cs::GetNetworkInterfaces();
+    {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      m_addresses = std::move(addresses);
+    }
+    UpdateStreamValues();
+  }
+  std::sort(dirtyModes.begin(), dirtyModes.end());
+  dirtyModes.erase(std::unique(dirtyModes.begin(), dirtyModes.end()),
+                   dirtyModes.end());
+  for (CS_Source source : dirtyModes) PublishModeValues(source);
+}
+
+// Must be called with m_mutex held
+CameraServer::ProfiledStream* CameraServer::FindProfiledStream(CS_Sink sink) {
+  for (auto& i : m_profiledStreams) {
+    if (i.second->GetServer() == sink) return i.second.get();
+  }
+  return nullptr;
+}
+
+/**
+ * Keeps a profiled server reading from its profile's output after its source
+ * is changed, by moving the new source to the profile's input.
+ */
+void CameraServer::RouteProfiledStream(CS_Sink sink) {
+  CS_Status status = 0;
+  CS_Source source = cs::GetSinkSource(sink, &status);
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  ProfiledStream* stream = FindProfiledStream(sink);
+  if (!stream || source == stream->GetOutput()) return;
+  stream->SetInput(source);
+  cs::SetSinkSource(sink, stream->GetOutput(), &status);
+}
+
 static inline llvm::StringRef Concatenate(llvm::StringRef lhs,
                                           llvm::StringRef rhs,
                                           llvm::SmallVectorImpl<char>& buf) {
@@ -271,6 +487,14 @@ CameraServer::CameraServer()
   // - "modes" (string array): Available video modes
   // - "Property/{Property}" - Property values
   // - "PropertyInfo/{Property}" - Property supporting information
+  //
+  // The video mode lists and the stream URLs of every source are expensive
+  // to build and change in bursts (for example while cameras enumerate at
+  // startup), so those video events only mark them dirty and PublishPending()
+  // publishes what changed shortly after.
+
+  m_publishNotifier = std::make_unique<Notifier>(
+      NotifierExecutor::GetInstance(), [this] { PublishPending(); });
 
   // Listener for video events
   m_videoListener = cs::VideoListener{
@@ -293,12 +517,14 @@ CameraServer::CameraServer()
                                                     &status));
             table->GetEntry("connected")
                 .SetBoolean(cs::IsSourceConnected(event.sourceHandle, &status));
-            table->GetEntry("streams").SetStringArray(
-                GetSourceStreamValues(event.sourceHandle));
+            auto streams = GetSourceStreamValues(event.sourceHandle);
+            table->GetEntry("streams").SetStringArray(streams);
             auto mode = cs::GetSourceVideoMode(event.sourceHandle, &status);
             table->GetEntry("mode").SetDefaultString(VideoModeToString(mode));
-            table->GetEntry("modes").SetStringArray(
-                GetSourceModeValues(event.sourceHandle));
+            std::lock_guard<wpi::mutex> lock(m_mutex);
+            m_publishedStreams[event.sourceHandle] = std::move(streams);
+            m_dirtyModes.push_back(event.sourceHandle);
+            SchedulePublish();
             break;
           }
           case cs::VideoEvent::kSourceDestroyed: {
@@ -310,6 +536,9 @@ CameraServer::CameraServer()
               table->GetEntry("modes").SetStringArray(
                   std::vector<std::string>{});
             }
+            std::lock_guard<wpi::mutex> lock(m_mutex);
+            m_publishedStreams.erase(event.sourceHandle);
+            m_publishedModes.erase(event.sourceHandle);
             break;
           }
           case cs::VideoEvent::kSourceConnected: {
@@ -330,10 +559,9 @@ CameraServer::CameraServer()
             break;
           }
           case cs::VideoEvent::kSourceVideoModesUpdated: {
-            auto table = GetSourceTable(event.sourceHandle);
-            if (table)
-              table->GetEntry("modes").SetStringArray(
-                  GetSourceModeValues(event.sourceHandle));
+            std::lock_guard<wpi::mutex> lock(m_mutex);
+            m_dirtyModes.push_back(event.sourceHandle);
+            SchedulePublish();
             break;
           }
           case cs::VideoEvent::kSourceVideoModeChanged: {
@@ -368,8 +596,11 @@ CameraServer::CameraServer()
           case cs::VideoEvent::kSinkCreated:
           case cs::VideoEvent::kSinkDestroyed:
           case cs::VideoEvent::kNetworkInterfacesChanged: {
-            m_addresses = cs::GetNetworkInterfaces();
-            UpdateStreamValues();
+            if (event.kind == cs::VideoEvent::kSinkSourceChanged)
+              RouteProfiledStream(event.sinkHandle);
+            std::lock_guard<wpi::mutex> lock(m_mutex);
+            m_streamsDirty = true;
+            SchedulePublish();
             break;
           }
           default:
@@ -435,6 +666,10 @@ CameraServer::CameraServer()
       },
       NT_NOTIFY_IMMEDIATE | NT_NOTIFY_UPDATE);
 }
+
+// Located here and not in header due to ProfiledStream forward declaration.
+CameraServer::~CameraServer() {}
+
 #ifdef __linux__
 cs::UsbCamera CameraServer::StartAutomaticCapture() {
   cs::UsbCamera camera = StartAutomaticCapture(m_defaultUsbDevice++);
@@ -448,6 +683,8 @@ cs::UsbCamera CameraServer::StartAutomaticCapture(int dev) {
   llvm::raw_svector_ostream name{buf};
   name << "USB Camera " << dev;
 
+  StartupProfiler::Scope profile("CameraServer::StartAutomaticCapture",
+                                 kCameraStartupHint);
   cs::UsbCamera camera{name.str(), dev};
   StartAutomaticCapture(camera);
   HAL_Report(HALUsageReporting::kResourceType_PCVideoServer,
@@ -457,6 +694,8 @@ cs::UsbCamera CameraServer::StartAutomaticCapture(int dev) {
 
 cs::UsbCamera CameraServer::StartAutomaticCapture(llvm::StringRef name,
                                                   int dev) {
+  StartupProfiler::Scope profile("CameraServer::StartAutomaticCapture",
+                                 kCameraStartupHint);
   cs::UsbCamera camera{name, dev};
   StartAutomaticCapture(camera);
   HAL_Report(HALUsageReporting::kResourceType_PCVideoServer,
@@ -466,6 +705,8 @@ cs::UsbCamera CameraServer::StartAutomaticCapture(llvm::StringRef name,
 
 cs::UsbCamera CameraServer::StartAutomaticCapture(llvm::StringRef name,
                                                   llvm::StringRef path) {
+  StartupProfiler::Scope profile("CameraServer::StartAutomaticCapture",
+                                 kCameraStartupHint);
   cs::UsbCamera camera{name, path};
   StartAutomaticCapture(camera);
   HAL_Report(HALUsageReporting::kResourceType_PCVideoServer,
@@ -592,6 +833,55 @@ cs::CvSink CameraServer::GetVideo(llvm::StringRef name) {
   return GetVideo(source);
 }
 
+std::shared_ptr<SharedVideoSink> CameraServer::GetSharedVideo() {
+  cs::VideoSource source;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (m_primarySourceName.empty()) {
+      wpi_setWPIErrorWithContext(CameraServerError, "no camera available");
+      return nullptr;
+    }
+    auto it = m_sources.find(m_primarySourceName);
+    if (it == m_sources.end()) {
+      wpi_setWPIErrorWithContext(CameraServerError, "no camera available");
+      return nullptr;
+    }
+    source = it->second;
+  }
+  return GetSharedVideo(source);
+}
+
+std::shared_ptr<SharedVideoSink> CameraServer::GetSharedVideo(
+    const cs::VideoSource& camera) {
+  std::string cameraName = camera.GetName();
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto& weakSink = m_sharedSinks[cameraName];
+  auto sink = weakSink.lock();
+  if (!sink) {
+    sink = std::make_shared<SharedVideoSink>("shared_" + cameraName, camera);
+    weakSink = sink;
+  }
+  return sink;
+}
+
+std::shared_ptr<SharedVideoSink> CameraServer::GetSharedVideo(
+    llvm::StringRef name) {
+  cs::VideoSource source;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    auto it = m_sources.find(name);
+    if (it == m_sources.end()) {
+      llvm::SmallString<64> buf;
+      llvm::raw_svector_ostream err{buf};
+      err << "could not find camera " << name;
+      wpi_setWPIErrorWithContext(CameraServerError, err.str());
+      return nullptr;
+    }
+    source = it->second;
+  }
+  return GetSharedVideo(source);
+}
+
 cs::CvSource CameraServer::PutVideo(llvm::StringRef name, int width,
                                     int height) {
   cs::CvSource source{name, cs::VideoMode::kMJPEG, width, height, 30};
@@ -599,6 +889,20 @@ cs::CvSource CameraServer::PutVideo(llvm::StringRef name, int width,
   return source;
 }
 
+cs::CvSource CameraServer::PutVideo(llvm::StringRef name, int width,
+                                    int height, const StreamProfile& profile) {
+  cs::CvSource source{name, cs::VideoMode::kMJPEG, width, height, 30};
+  llvm::SmallString<64> serverName{"serve_"};
+  serverName += name;
+
+  // Set the source before the profile, so the raw stream is never served
+  AddCamera(source);
+  auto server = AddServer(serverName);
+  server.SetSource(source);
+  SetStreamProfile(serverName, profile);
+  return source;
+}
+
 cs::MjpegServer CameraServer::AddServer(llvm::StringRef name) {
   int port;
   {
@@ -614,14 +918,75 @@ cs::MjpegServer CameraServer::AddServer(llvm::StringRef name, int port) {
   return server;
 }
 
+cs::MjpegServer CameraServer::AddServer(llvm::StringRef name,
+                                        const StreamProfile& profile) {
+  auto server = AddServer(name);
+  SetStreamProfile(name, profile);
+  return server;
+}
+
+cs::MjpegServer CameraServer::AddServer(llvm::StringRef name, int port,
+                                        const StreamProfile& profile) {
+  auto server = AddServer(name, port);
+  SetStreamProfile(name, profile);
+  return server;
+}
+
 void CameraServer::AddServer(const cs::VideoSink& server) {
   std::lock_guard<wpi::mutex> lock(m_mutex);
   m_sinks.emplace_second(server.GetName(), server);
 }
 
+void CameraServer::SetStreamProfile(llvm::StringRef name,
+                                    const StreamProfile& profile) {
+  // Declared before the lock, so the old profile's thread is joined after the
+  // lock is released
+  std::unique_ptr<ProfiledStream> oldStream;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_sinks.find(name);
+  if (it == m_sinks.end()) {
+    llvm::SmallString<64> buf;
+    llvm::raw_svector_ostream err{buf};
+    err << "could not find server " << name;
+    wpi_setWPIErrorWithContext(CameraServerError, err.str());
+    return;
+  }
+  auto kind = it->second.GetKind();
+  if (kind != cs::VideoSink::kMjpeg) {
+    llvm::SmallString<64> buf;
+    llvm::raw_svector_ostream err{buf};
+    err << "expected MJPEG server, but got " << kind;
+    wpi_setWPIErrorWithContext(CameraServerError, err.str());
+    return;
+  }
+
+  CS_Status status = 0;
+  CS_Sink sink = it->second.GetHandle();
+  auto& stream = m_profiledStreams[name];
+  // A server that already has a profile reads from the old profile's output
+  CS_Source source =
+      stream ? stream->GetInput() : cs::GetSinkSource(sink, &status);
+  auto newStream = std::make_unique<ProfiledStream>(name, sink, profile);
+  newStream->SetInput(source);
+  cs::SetSinkSource(sink, newStream->GetOutput(), &status);
+  oldStream = std::move(stream);
+  stream = std::move(newStream);
+
+  m_streamsDirty = true;
+  SchedulePublish();
+}
+
 void CameraServer::RemoveServer(llvm::StringRef name) {
+  // Declared before the lock, so the profile's thread is joined after the
+  // lock is released
+  std::unique_ptr<ProfiledStream> stream;
   std::lock_guard<wpi::mutex> lock(m_mutex);
   m_sinks.erase(name);
+  auto it = m_profiledStreams.find(name);
+  if (it != m_profiledStreams.end()) {
+    stream = std::move(it->second);
+    m_profiledStreams.erase(it);
+  }
 }
 
 cs::VideoSink CameraServer::GetServer() {
@@ -675,3 +1040,14 @@ void CameraServer::SetSize(int size) {
   else if (size == kSize640x480)
     it->second.SetResolution(640, 480);
 }
+
+uint64_t CameraServer::FrameTimeToFPGATime(uint64_t frameTime) {
+  // The offset between the clocks; zero on the roboRIO, where they are the same
+  int64_t offset = static_cast<int64_t>(RobotController::GetFPGATime()) -
+                   static_cast<int64_t>(wpi::Now());
+  return static_cast<uint64_t>(static_cast<int64_t>(frameTime) + offset);
+}
+
+double CameraServer::FrameTimeToFPGATimestamp(uint64_t frameTime) {
+  return FrameTimeToFPGATime(frameTime) * 1.0e-6;
+}
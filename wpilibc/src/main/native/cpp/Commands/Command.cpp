@@ -89,6 +89,39 @@ void Command::SetTimeout(double timeout) {
     m_timeout = timeout;
 }
 
+/**
+ * Sets how long one run of this command should take.
+ *
+ * The Scheduler times each Run() of the command, which calls Execute() and
+ * IsFinished(). A run over the budget is counted and reported through the
+ * Scheduler's watchdog, so a command that delays the ones behind it is named.
+ *
+ * @param budget the budget (in seconds), or a negative number for none
+ */
+void Command::SetExecutionBudget(double budget) { m_executionBudget = budget; }
+
+/**
+ * Returns the execution budget (in seconds), or -1 if there is none.
+ */
+double Command::GetExecutionBudget() const { return m_executionBudget; }
+
+/**
+ * Returns how long the last Run() took (in seconds), as timed by the
+ * Scheduler.
+ */
+double Command::GetLastExecutionTime() const { return m_lastExecutionTime; }
+
+/**
+ * Returns how long the longest Run() took (in seconds), as timed by the
+ * Scheduler.
+ */
+double Command::GetMaxExecutionTime() const { return m_maxExecutionTime; }
+
+/**
+ * Returns how many runs went over the execution budget.
+ */
+int Command::GetBudgetOverruns() const { return m_budgetOverruns; }
+
 /**
  * Returns the time since this command was initialized (in seconds).
  *
@@ -128,7 +161,9 @@ void Command::Requires(Subsystem* subsystem) {
  * This will call Interrupted() or End().
  */
 void Command::Removed() {
+  WaitForBackground();
   if (m_initialized) {
+    _Removing();
     if (IsCanceled()) {
       Interrupted();
       _Interrupted();
@@ -179,7 +214,14 @@ bool Command::Run() {
     Initialize();
   }
   _Execute();
-  Execute();
+  if (!m_backgroundExecution) {
+    Execute();
+  } else if (!m_backgroundWork.IsValid() || m_backgroundWork.IsReady()) {
+    // The previous background work is done, so Execute() can use its results
+    Execute();
+    m_backgroundWork =
+        Executor::GetInstance().Submit([this] { ExecuteBackground(); });
+  }
   return !IsFinished();
 }
 
@@ -195,6 +237,31 @@ void Command::Initialize() {}
  */
 void Command::Execute() {}
 
+/**
+ * Run ExecuteBackground() on the shared Executor instead of blocking the
+ * Scheduler.
+ *
+ * Each time Run() finds the previous background work done, it calls Execute()
+ * to consume its results and start the next, then queues ExecuteBackground().
+ * While the work is still running, Execute() is skipped for that tick.
+ * IsFinished() is called every tick. The command waits for outstanding work
+ * before End() or Interrupted() is called.
+ *
+ * ExecuteBackground() runs concurrently with the command's other methods, so
+ * they must only share data with it from Execute().
+ *
+ * @param enabled Whether to run ExecuteBackground() in the background.
+ */
+void Command::SetBackgroundExecution(bool enabled) {
+  m_backgroundExecution = enabled;
+}
+
+/**
+ * The heavy part of the command's work, called on an Executor worker after
+ * each Execute() when SetBackgroundExecution() is enabled.
+ */
+void Command::ExecuteBackground() {}
+
 /**
  * Called when the command ended peacefully. This is where you may want to wrap
  * up loose ends, like shutting off a motor that was being used in the command.
@@ -221,6 +288,12 @@ void Command::_Execute() {}
 
 void Command::_End() { m_completed = true; }
 
+/**
+ * Called when an initialized command is removed, before End() or
+ * Interrupted(), so subclasses can stop work done outside of Execute() first.
+ */
+void Command::_Removing() {}
+
 /**
  * Called to indicate that the timer should start.
  *
@@ -228,6 +301,18 @@ void Command::_End() { m_completed = true; }
  */
 void Command::StartTiming() { m_startTime = Timer::GetFPGATimestamp(); }
 
+void Command::RecordExecutionTime(double time) {
+  m_lastExecutionTime = time;
+  if (time > m_maxExecutionTime) m_maxExecutionTime = time;
+  if (m_executionBudget >= 0.0 && time > m_executionBudget) m_budgetOverruns++;
+}
+
+void Command::WaitForBackground() {
+  if (!m_backgroundWork.IsValid()) return;
+  m_backgroundWork.Wait();
+  m_backgroundWork = Future<void>();
+}
+
 /**
  * Returns whether or not the TimeSinceInitialized() method returns a number
  * which is greater than or equal to the timeout for the command.
@@ -247,7 +332,7 @@ bool Command::IsTimedOut() const {
  * @return The requirements (as an std::set of Subsystem pointers) of this
  *         command
  */
-Command::SubsystemSet Command::GetRequirements() const {
+const Command::SubsystemSet& Command::GetRequirements() const {
   return m_requirements;
 }
 
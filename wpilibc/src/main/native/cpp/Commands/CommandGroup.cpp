@@ -39,13 +39,8 @@ void CommandGroup::AddSequential(Command* command) {
 
   command->SetParent(this);
 
-  m_commands.push_back(
+  AddEntry(
       CommandGroupEntry(command, CommandGroupEntry::kSequence_InSequence));
-  // Iterate through command->GetRequirements() and call Requires() on each
-  // required subsystem
-  Command::SubsystemSet requirements = command->GetRequirements();
-  for (auto iter = requirements.begin(); iter != requirements.end(); iter++)
-    Requires(*iter);
 }
 
 /**
@@ -78,13 +73,8 @@ void CommandGroup::AddSequential(Command* command, double timeout) {
 
   command->SetParent(this);
 
-  m_commands.push_back(CommandGroupEntry(
-      command, CommandGroupEntry::kSequence_InSequence, timeout));
-  // Iterate through command->GetRequirements() and call Requires() on each
-  // required subsystem
-  Command::SubsystemSet requirements = command->GetRequirements();
-  for (auto iter = requirements.begin(); iter != requirements.end(); iter++)
-    Requires(*iter);
+  AddEntry(CommandGroupEntry(command, CommandGroupEntry::kSequence_InSequence,
+                             timeout));
 }
 
 /**
@@ -114,13 +104,8 @@ void CommandGroup::AddParallel(Command* command) {
 
   command->SetParent(this);
 
-  m_commands.push_back(
+  AddEntry(
       CommandGroupEntry(command, CommandGroupEntry::kSequence_BranchChild));
-  // Iterate through command->GetRequirements() and call Requires() on each
-  // required subsystem
-  Command::SubsystemSet requirements = command->GetRequirements();
-  for (auto iter = requirements.begin(); iter != requirements.end(); iter++)
-    Requires(*iter);
 }
 
 /**
@@ -160,13 +145,8 @@ void CommandGroup::AddParallel(Command* command, double timeout) {
 
   command->SetParent(this);
 
-  m_commands.push_back(CommandGroupEntry(
-      command, CommandGroupEntry::kSequence_BranchChild, timeout));
-  // Iterate through command->GetRequirements() and call Requires() on each
-  // required subsystem
-  Command::SubsystemSet requirements = command->GetRequirements();
-  for (auto iter = requirements.begin(); iter != requirements.end(); iter++)
-    Requires(*iter);
+  AddEntry(CommandGroupEntry(command, CommandGroupEntry::kSequence_BranchChild,
+                             timeout));
 }
 
 void CommandGroup::_Initialize() { m_currentCommandIndex = -1; }
@@ -204,7 +184,7 @@ void CommandGroup::_Execute() {
         cmd = entry.m_command;
         if (firstRun) {
           cmd->StartRunning();
-          CancelConflicts(cmd);
+          CancelConflicts(entry);
           firstRun = false;
         }
         break;
@@ -215,27 +195,27 @@ void CommandGroup::_Execute() {
         break;
 
       case CommandGroupEntry::kSequence_BranchChild:
-        m_currentCommandIndex++;
-        CancelConflicts(entry.m_command);
+        CancelConflicts(entry);
         entry.m_command->StartRunning();
-        m_children.push_back(entry);
+        m_children.push_back(m_currentCommandIndex);
+        m_currentCommandIndex++;
         break;
     }
   }
 
-  // Run Children
-  for (auto iter = m_children.begin(); iter != m_children.end();) {
-    entry = *iter;
-    Command* child = entry.m_command;
-    if (entry.IsTimedOut()) child->_Cancel();
+  // Run Children, compacting the finished ones out in place
+  size_t kept = 0;
+  for (size_t i = 0; i < m_children.size(); i++) {
+    const CommandGroupEntry& child = m_commands[m_children[i]];
+    if (child.IsTimedOut()) child.m_command->_Cancel();
 
-    if (!child->Run()) {
-      child->Removed();
-      iter = m_children.erase(iter);
+    if (!child.m_command->Run()) {
+      child.m_command->Removed();
     } else {
-      iter++;
+      m_children[kept++] = m_children[i];
     }
   }
+  m_children.resize(kept);
 }
 
 void CommandGroup::_End() {
@@ -248,8 +228,8 @@ void CommandGroup::_End() {
     cmd->Removed();
   }
 
-  for (auto iter = m_children.begin(); iter != m_children.end(); iter++) {
-    Command* cmd = iter->m_command;
+  for (size_t index : m_children) {
+    Command* cmd = m_commands[index].m_command;
     cmd->_Cancel();
     cmd->Removed();
   }
@@ -284,31 +264,69 @@ bool CommandGroup::IsInterruptible() const {
     if (!cmd->IsInterruptible()) return false;
   }
 
-  for (auto iter = m_children.cbegin(); iter != m_children.cend(); iter++) {
-    if (!iter->m_command->IsInterruptible()) return false;
+  for (size_t index : m_children) {
+    if (!m_commands[index].m_command->IsInterruptible()) return false;
   }
 
   return true;
 }
 
-void CommandGroup::CancelConflicts(Command* command) {
-  for (auto childIter = m_children.begin(); childIter != m_children.end();) {
-    Command* child = childIter->m_command;
-    bool erased = false;
-
-    Command::SubsystemSet requirements = command->GetRequirements();
-    for (auto requirementIter = requirements.begin();
-         requirementIter != requirements.end(); requirementIter++) {
-      if (child->DoesRequire(*requirementIter)) {
-        child->_Cancel();
-        child->Removed();
-        childIter = m_children.erase(childIter);
-        erased = true;
-        break;
-      }
+/**
+ * Adds an entry, and adds its command's requirements to the group.
+ */
+void CommandGroup::AddEntry(const CommandGroupEntry& entry) {
+  m_commands.push_back(entry);
+  m_commands.back().m_requirementMask = GetRequirementMask(entry.m_command);
+  // Iterate through command->GetRequirements() and call Requires() on each
+  // required subsystem
+  const auto& requirements = entry.m_command->GetRequirements();
+  for (auto iter = requirements.begin(); iter != requirements.end(); iter++)
+    Requires(*iter);
+  m_children.reserve(m_commands.size());
+}
+
+/**
+ * Returns the mask of the subsystems a command requires, assigning bits to
+ * subsystems the group has not seen yet. Conflicts between commands are then
+ * a single AND while the group runs.
+ */
+uint64_t CommandGroup::GetRequirementMask(Command* command) {
+  uint64_t mask = 0;
+  for (Subsystem* subsystem : command->GetRequirements()) {
+    size_t bit = 0;
+    while (bit < m_subsystems.size() && m_subsystems[bit] != subsystem) bit++;
+    if (bit == m_subsystems.size()) m_subsystems.push_back(subsystem);
+    if (bit < 64) {
+      mask |= uint64_t{1} << bit;
+    } else {
+      m_masksValid = false;
+    }
+  }
+  return mask;
+}
+
+bool CommandGroup::Conflicts(const CommandGroupEntry& a,
+                             const CommandGroupEntry& b) const {
+  if (m_masksValid) return (a.m_requirementMask & b.m_requirementMask) != 0;
+
+  for (Subsystem* subsystem : a.m_command->GetRequirements()) {
+    if (b.m_command->DoesRequire(subsystem)) return true;
+  }
+  return false;
+}
+
+void CommandGroup::CancelConflicts(const CommandGroupEntry& entry) {
+  size_t kept = 0;
+  for (size_t i = 0; i < m_children.size(); i++) {
+    const CommandGroupEntry& child = m_commands[m_children[i]];
+    if (Conflicts(entry, child)) {
+      child.m_command->_Cancel();
+      child.m_command->Removed();
+    } else {
+      m_children[kept++] = m_children[i];
     }
-    if (!erased) childIter++;
   }
+  m_children.resize(kept);
 }
 
 int CommandGroup::GetSize() const { return m_children.size(); }
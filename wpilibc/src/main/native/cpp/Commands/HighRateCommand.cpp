@@ -0,0 +1,89 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Commands/HighRateCommand.h"
+
+using namespace frc;
+
+/**
+ * Creates a new high-rate command with a default name.
+ *
+ * @param period The time between calls of HighRateExecute(), in seconds
+ */
+HighRateCommand::HighRateCommand(double period)
+    : HighRateCommand("", period) {}
+
+/**
+ * Creates a new high-rate command with the given name.
+ *
+ * @param name   The name for this command
+ * @param period The time between calls of HighRateExecute(), in seconds
+ */
+HighRateCommand::HighRateCommand(const llvm::Twine& name, double period)
+    : Command(name), m_period(period), m_notifier([=] { Run(); }) {}
+
+HighRateCommand::~HighRateCommand() { Stop(); }
+
+/**
+ * Returns the time between calls of HighRateExecute(), in seconds.
+ */
+double HighRateCommand::GetPeriod() const { return m_period; }
+
+/**
+ * Returns whether Finish() has been called since the command started.
+ */
+bool HighRateCommand::IsFinished() { return m_finished; }
+
+/**
+ * Makes the default IsFinished() return true, so the command ends on the next
+ * run of the Scheduler. May be called from either thread.
+ */
+void HighRateCommand::Finish() { m_finished = true; }
+
+/**
+ * Returns the mutex HighRateExecute() runs with. Hold it while touching state
+ * shared with the high-rate loop.
+ */
+wpi::mutex& HighRateCommand::GetMutex() { return m_mutex; }
+
+void HighRateCommand::_Initialize() {
+  Command::_Initialize();
+  m_finished = false;
+  m_started = false;
+}
+
+void HighRateCommand::_Execute() {
+  Command::_Execute();
+  // Started on the first execute, so Initialize() has run before the first
+  // HighRateExecute()
+  if (m_started) return;
+  m_started = true;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_active = true;
+  }
+  m_notifier.StartPeriodic(m_period);
+}
+
+void HighRateCommand::_Removing() {
+  Command::_Removing();
+  Stop();
+}
+
+void HighRateCommand::Run() {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_active) HighRateExecute();
+}
+
+void HighRateCommand::Stop() {
+  {
+    // Waits for a HighRateExecute() in progress; later alarms do nothing
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_active = false;
+  }
+  m_notifier.Stop();
+}
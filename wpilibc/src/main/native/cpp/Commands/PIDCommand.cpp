@@ -7,6 +7,7 @@
 
 #include "Commands/PIDCommand.h"
 
+#include "Commands/Scheduler.h"
 #include "SmartDashboard/SendableBuilder.h"
 
 using namespace frc;
@@ -41,6 +42,12 @@ PIDCommand::PIDCommand(double p, double i, double d, double period) {
   m_controller = std::make_shared<PIDController>(p, i, d, this, this, period);
 }
 
+PIDCommand::~PIDCommand() {
+  if (m_controller->IsSynchronous()) {
+    Scheduler::GetInstance()->RemoveController(m_controller.get());
+  }
+}
+
 void PIDCommand::_Initialize() { m_controller->Enable(); }
 
 void PIDCommand::_End() { m_controller->Disable(); }
@@ -51,6 +58,24 @@ void PIDCommand::SetSetpointRelative(double deltaSetpoint) {
   SetSetpoint(GetSetpoint() + deltaSetpoint);
 }
 
+/**
+ * Sets whether the internal PIDController is updated by the Scheduler instead
+ * of its own thread.
+ *
+ * When synchronous, the controller runs in each Scheduler::Run() while the
+ * command is running, before the commands execute, at the Scheduler's rate
+ * rather than its period.
+ *
+ * @param synchronous true to update the controller from the Scheduler
+ */
+void PIDCommand::SetSynchronous(bool synchronous) {
+  if (synchronous) {
+    Scheduler::GetInstance()->AddController(m_controller.get());
+  } else {
+    Scheduler::GetInstance()->RemoveController(m_controller.get());
+  }
+}
+
 void PIDCommand::PIDWrite(double output) { UsePIDOutput(output); }
 
 double PIDCommand::PIDGet(PIDSourceType pidSource) { return ReturnPIDInput(); }
@@ -7,6 +7,7 @@
 
 #include "Commands/PIDSubsystem.h"
 
+#include "Commands/Scheduler.h"
 #include "PIDController.h"
 
 using namespace frc;
@@ -114,6 +115,12 @@ PIDSubsystem::PIDSubsystem(double p, double i, double d, double f,
   AddChild("PIDController", m_controller);
 }
 
+PIDSubsystem::~PIDSubsystem() {
+  if (m_controller->IsSynchronous()) {
+    Scheduler::GetInstance()->RemoveController(m_controller.get());
+  }
+}
+
 /**
  * Enables the internal PIDController.
  */
@@ -124,6 +131,26 @@ void PIDSubsystem::Enable() { m_controller->Enable(); }
  */
 void PIDSubsystem::Disable() { m_controller->Disable(); }
 
+/**
+ * Sets whether the internal PIDController is updated by the Scheduler instead
+ * of its own thread.
+ *
+ * When synchronous, the controller runs in each Scheduler::Run(), right after
+ * the subsystems' Periodic() methods and before the commands, so
+ * ReturnPIDInput() and UsePIDOutput() run on the same thread as the rest of
+ * the subsystem. The controller then runs at the Scheduler's rate rather than
+ * its period.
+ *
+ * @param synchronous true to update the controller from the Scheduler
+ */
+void PIDSubsystem::SetSynchronous(bool synchronous) {
+  if (synchronous) {
+    Scheduler::GetInstance()->AddController(m_controller.get());
+  } else {
+    Scheduler::GetInstance()->RemoveController(m_controller.get());
+  }
+}
+
 /**
  * Returns the PIDController used by this PIDSubsystem.
  *
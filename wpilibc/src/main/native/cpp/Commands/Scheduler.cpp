@@ -8,17 +8,24 @@
 #include "Commands/Scheduler.h"
 
 #include <algorithm>
-#include <set>
 
 #include "Buttons/ButtonScheduler.h"
+#include "Buttons/Trigger.h"
 #include "Commands/Subsystem.h"
 #include "HLUsageReporting.h"
+#include "Internal/TelemetryTransaction.h"
+#include "PIDController.h"
 #include "SmartDashboard/SendableBuilder.h"
+#include "Timer.h"
+#include "Tracing.h"
 #include "WPIErrors.h"
 
 using namespace frc;
 
-Scheduler::Scheduler() {
+// The timeout of the watchdog until it is changed with GetWatchdog()
+static constexpr double kDefaultWatchdogTimeout = 0.02;
+
+Scheduler::Scheduler() : m_watchdog(kDefaultWatchdogTimeout, nullptr) {
   HLUsageReporting::ReportScheduler();
   SetName("Scheduler");
 }
@@ -35,6 +42,18 @@ Scheduler* Scheduler::GetInstance() {
 
 void Scheduler::SetEnabled(bool enabled) { m_enabled = enabled; }
 
+/**
+ * Sets how often the running commands are published to and cancel requests
+ * read from the dashboard. Changes made between updates are published
+ * together.
+ *
+ * @param period The time between dashboard updates in seconds, or 0 to
+ *               update every time the dashboard values are updated
+ */
+void Scheduler::SetDashboardUpdatePeriod(double period) {
+  m_dashboardPeriod = period;
+}
+
 /**
  * Add a command to be scheduled later.
  *
@@ -45,15 +64,47 @@ void Scheduler::SetEnabled(bool enabled) { m_enabled = enabled; }
  */
 void Scheduler::AddCommand(Command* command) {
   std::lock_guard<wpi::mutex> lock(m_additionsMutex);
-  if (std::find(m_additions.begin(), m_additions.end(), command) !=
-      m_additions.end())
-    return;
+  if (command->m_pendingAddition) return;
+  command->m_pendingAddition = true;
   m_additions.push_back(command);
 }
 
 void Scheduler::AddButton(ButtonScheduler* button) {
+  ButtonEntry entry;
+  entry.scheduler = button;
+  Trigger* trigger = button->GetTrigger();
+  if (!trigger->GetJoystickButton(&entry.stick, &entry.button) ||
+      entry.stick < 0 || entry.stick >= DriverStation::kJoystickPorts ||
+      entry.button < 1 || entry.button > 32) {
+    entry.stick = -1;
+  }
+  entry.pressed = trigger->Grab();
   std::lock_guard<wpi::mutex> lock(m_buttonsMutex);
-  m_buttons.push_back(button);
+  m_buttons.push_back(entry);
+}
+
+/**
+ * Sets whether buttons bound to joystick buttons are only polled when their
+ * button changes.
+ *
+ * With edge detection, the joystick buttons are read once for each new Driver
+ * Station packet and compared with the previous packet; a button's scheduler
+ * is only executed when its button (or its dashboard state) changed. Triggers
+ * that are not joystick buttons, and WhileHeld() bindings, which restart their
+ * command every loop, are still executed every time.
+ *
+ * @param enabled True to enable edge detection
+ */
+void Scheduler::SetButtonEdgeDetection(bool enabled) {
+  std::lock_guard<wpi::mutex> lock(m_buttonsMutex);
+  if (enabled && !m_buttonEdgeDetection) {
+    // Start from the current state, which every scheduler has seen
+    for (auto& entry : m_buttons) {
+      entry.pressed = entry.scheduler->GetTrigger()->Grab();
+    }
+    m_buttonPacket = 0;
+  }
+  m_buttonEdgeDetection = enabled;
 }
 
 void Scheduler::ProcessCommandAddition(Command* command) {
@@ -67,12 +118,11 @@ void Scheduler::ProcessCommandAddition(Command* command) {
   }
 
   // Only add if not already in
-  auto found = m_commands.find(command);
-  if (found == m_commands.end()) {
+  if (command->m_schedulerIndex < 0) {
     // Check that the requirements can be had
-    Command::SubsystemSet requirements = command->GetRequirements();
-    for (Command::SubsystemSet::iterator iter = requirements.begin();
-         iter != requirements.end(); iter++) {
+    const auto& requirements = command->GetRequirements();
+    for (auto iter = requirements.begin(); iter != requirements.end();
+         iter++) {
       Subsystem* lock = *iter;
       if (lock->GetCurrentCommand() != nullptr &&
           !lock->GetCurrentCommand()->IsInterruptible())
@@ -81,8 +131,8 @@ void Scheduler::ProcessCommandAddition(Command* command) {
 
     // Give it the requirements
     m_adding = true;
-    for (Command::SubsystemSet::iterator iter = requirements.begin();
-         iter != requirements.end(); iter++) {
+    for (auto iter = requirements.begin(); iter != requirements.end();
+         iter++) {
       Subsystem* lock = *iter;
       if (lock->GetCurrentCommand() != nullptr) {
         lock->GetCurrentCommand()->Cancel();
@@ -92,7 +142,9 @@ void Scheduler::ProcessCommandAddition(Command* command) {
     }
     m_adding = false;
 
-    m_commands.insert(command);
+    command->m_schedulerIndex = static_cast<int>(m_commands.size());
+    command->m_epochName = command->GetName();
+    m_commands.push_back(command);
 
     command->StartRunning();
     m_runningCommandsChanged = true;
@@ -103,10 +155,11 @@ void Scheduler::ProcessCommandAddition(Command* command) {
  * Runs a single iteration of the loop.
  *
  * This method should be called often in order to have a functioning
- * Command system. The loop has five stages:
+ * Command system. The loop has these stages:
  *
  * <ol>
  *   <li>Poll the Buttons</li>
+ *   <li>Run the Subsystems' Periodic() and the synchronous PIDControllers</li>
  *   <li>Execute/Remove the Commands</li>
  *   <li>Send values to SmartDashboard</li>
  *   <li>Add Commands</li>
@@ -114,16 +167,15 @@ void Scheduler::ProcessCommandAddition(Command* command) {
  * </ol>
  */
 void Scheduler::Run() {
-  // Get button input (going backwards preserves button priority)
-  {
-    if (!m_enabled) return;
+  FRC_TRACE_SCOPE("Scheduler::Run");
+  if (!m_enabled) return;
 
-    std::lock_guard<wpi::mutex> lock(m_buttonsMutex);
-    for (auto rButtonIter = m_buttons.rbegin(); rButtonIter != m_buttons.rend();
-         rButtonIter++) {
-      (*rButtonIter)->Execute();
-    }
-  }
+  double start = Timer::GetFPGATimestamp();
+  m_watchdog.Reset();
+
+  RunButtons();
+  double buttonsEnd = Timer::GetFPGATimestamp();
+  m_watchdog.AddEpoch("buttons");
 
   // Call every subsystem's periodic method
   for (auto subsystemIter = m_subsystems.begin();
@@ -131,30 +183,52 @@ void Scheduler::Run() {
     Subsystem* subsystem = *subsystemIter;
     subsystem->Periodic();
   }
-
-  m_runningCommandsChanged = false;
-
-  // Loop through the commands
-  for (auto commandIter = m_commands.begin();
-       commandIter != m_commands.end();) {
-    Command* command = *commandIter;
-    // Increment before potentially removing to keep the iterator valid
-    ++commandIter;
-    if (!command->Run()) {
+  double subsystemsEnd = Timer::GetFPGATimestamp();
+  m_watchdog.AddEpoch("subsystems");
+
+  // Step the synchronous PID controllers on the state Periodic() left
+  for (auto controller : m_controllers) controller->Update();
+  double controllersEnd = Timer::GetFPGATimestamp();
+  m_watchdog.AddEpoch("controllers");
+
+  // Loop through the commands. Commands started meanwhile go to the additions
+  // list, so indexing up to the current size stays valid.
+  m_runningCommands = true;
+  for (size_t i = 0; i < m_commands.size(); i++) {
+    Command* command = m_commands[i];
+    if (command == nullptr) continue;
+    double commandStart = Timer::GetFPGATimestamp();
+    bool running = command->Run();
+    double commandTime = Timer::GetFPGATimestamp() - commandStart;
+    command->RecordExecutionTime(commandTime);
+    // Each command is its own epoch, so an overrun names the slow command.
+    // The name is copied once when the command is added, not every loop.
+    m_watchdog.AddEpoch(command->m_epochName);
+    double budget = command->GetExecutionBudget();
+    if (budget >= 0.0 && commandTime > budget) {
+      m_watchdog.ReportBudgetOverrun(command->GetName(), commandTime, budget);
+    }
+    if (!running) {
       Remove(command);
       m_runningCommandsChanged = true;
     }
   }
+  m_runningCommands = false;
+  CompactCommands();
+  double commandsEnd = Timer::GetFPGATimestamp();
 
   // Add the new things
   {
     std::lock_guard<wpi::mutex> lock(m_additionsMutex);
     for (auto additionsIter = m_additions.begin();
          additionsIter != m_additions.end(); additionsIter++) {
+      (*additionsIter)->m_pendingAddition = false;
       ProcessCommandAddition(*additionsIter);
     }
     m_additions.clear();
   }
+  double additionsEnd = Timer::GetFPGATimestamp();
+  m_watchdog.AddEpoch("additions");
 
   // Add in the defaults
   for (auto subsystemIter = m_subsystems.begin();
@@ -165,8 +239,41 @@ void Scheduler::Run() {
     }
     lock->ConfirmCommand();
   }
+  double end = Timer::GetFPGATimestamp();
+  m_watchdog.AddEpoch("defaults");
+  m_watchdog.Disable();
+
+  m_stats.iterations++;
+  m_stats.runningCommands = static_cast<int>(m_commands.size());
+  m_stats.subsystems = static_cast<int>(m_subsystems.size());
+  m_stats.buttonsTime = buttonsEnd - start;
+  m_stats.subsystemsTime = subsystemsEnd - buttonsEnd;
+  m_stats.controllersTime = controllersEnd - subsystemsEnd;
+  m_stats.commandsTime = commandsEnd - controllersEnd;
+  m_stats.additionsTime = additionsEnd - commandsEnd;
+  m_stats.defaultsTime = end - additionsEnd;
+  m_stats.totalTime = end - start;
+  m_stats.maxTotalTime = std::max(m_stats.maxTotalTime, m_stats.totalTime);
 }
 
+/**
+ * Returns counters and per-stage timings of Run().
+ */
+Scheduler::Stats Scheduler::GetStats() const { return m_stats; }
+
+/**
+ * Clears the iteration count and the maximum iteration time.
+ */
+void Scheduler::ResetStats() { m_stats = Stats(); }
+
+/**
+ * Returns the watchdog of Run().
+ *
+ * It records the stages of Run() and the execution of each command, and
+ * reports them when one call to Run() takes longer than its timeout.
+ */
+Watchdog& Scheduler::GetWatchdog() { return m_watchdog; }
+
 /**
  * Registers a Subsystem to this Scheduler, so that the Scheduler might know if
  * a default Command needs to be run.
@@ -180,7 +287,43 @@ void Scheduler::RegisterSubsystem(Subsystem* subsystem) {
     wpi_setWPIErrorWithContext(NullParameter, "subsystem");
     return;
   }
-  m_subsystems.insert(subsystem);
+  if (std::find(m_subsystems.begin(), m_subsystems.end(), subsystem) ==
+      m_subsystems.end())
+    m_subsystems.push_back(subsystem);
+}
+
+/**
+ * Adds a PIDController to be updated on each Run(), right after the
+ * subsystems' Periodic() methods.
+ *
+ * The controller is made synchronous, so it no longer runs on its own thread.
+ * PIDSubsystem and PIDCommand call this from their SetSynchronous().
+ *
+ * @param controller the controller, which must be removed before it's
+ *                   destroyed
+ */
+void Scheduler::AddController(PIDController* controller) {
+  if (controller == nullptr) {
+    wpi_setWPIErrorWithContext(NullParameter, "controller");
+    return;
+  }
+  controller->SetSynchronous(true);
+  if (std::find(m_controllers.begin(), m_controllers.end(), controller) ==
+      m_controllers.end())
+    m_controllers.push_back(controller);
+}
+
+/**
+ * Stops updating a PIDController added by AddController() and returns it to
+ * its own thread.
+ *
+ * @param controller the controller
+ */
+void Scheduler::RemoveController(PIDController* controller) {
+  auto it = std::find(m_controllers.begin(), m_controllers.end(), controller);
+  if (it == m_controllers.end()) return;
+  m_controllers.erase(it);
+  controller->SetSynchronous(false);
 }
 
 /**
@@ -194,20 +337,86 @@ void Scheduler::Remove(Command* command) {
     return;
   }
 
-  if (!m_commands.erase(command)) return;
+  if (command->m_schedulerIndex < 0) return;
+  m_commands[command->m_schedulerIndex] = nullptr;
+  command->m_schedulerIndex = -1;
+  m_commandsRemoved = true;
 
-  Command::SubsystemSet requirements = command->GetRequirements();
+  const auto& requirements = command->GetRequirements();
   for (auto iter = requirements.begin(); iter != requirements.end(); iter++) {
     Subsystem* lock = *iter;
     lock->SetCurrentCommand(nullptr);
   }
 
   command->Removed();
+
+  if (!m_runningCommands) CompactCommands();
 }
 
 void Scheduler::RemoveAll() {
-  while (m_commands.size() > 0) {
-    Remove(*m_commands.begin());
+  bool runningCommands = m_runningCommands;
+  m_runningCommands = true;
+  for (size_t i = 0; i < m_commands.size(); i++) {
+    if (m_commands[i] != nullptr) Remove(m_commands[i]);
+  }
+  m_runningCommands = runningCommands;
+  if (!m_runningCommands) CompactCommands();
+}
+
+/**
+ * Drops the null slots left by Remove() and renumbers the commands after
+ * them.
+ */
+void Scheduler::CompactCommands() {
+  if (!m_commandsRemoved) return;
+  m_commandsRemoved = false;
+
+  size_t size = 0;
+  for (size_t i = 0; i < m_commands.size(); i++) {
+    Command* command = m_commands[i];
+    if (command == nullptr) continue;
+    command->m_schedulerIndex = static_cast<int>(size);
+    m_commands[size++] = command;
+  }
+  m_commands.resize(size);
+}
+
+/**
+ * Gets button input (going backwards preserves button priority).
+ */
+void Scheduler::RunButtons() {
+  std::lock_guard<wpi::mutex> lock(m_buttonsMutex);
+  if (!m_buttonEdgeDetection) {
+    for (auto rButtonIter = m_buttons.rbegin(); rButtonIter != m_buttons.rend();
+         rButtonIter++) {
+      rButtonIter->scheduler->Execute();
+    }
+    return;
+  }
+
+  auto& ds = DriverStation::GetInstance();
+  uint64_t packet = ds.GetPacketNumber();
+  if (packet != m_buttonPacket) {
+    m_buttonPacket = packet;
+    auto state = ds.GetJoystickState();
+    for (int i = 0; i < DriverStation::kJoystickPorts; i++) {
+      m_stickButtons[i] = state.buttons[i].buttons;
+    }
+  }
+
+  for (auto rButtonIter = m_buttons.rbegin(); rButtonIter != m_buttons.rend();
+       rButtonIter++) {
+    auto& entry = *rButtonIter;
+    if (entry.stick < 0 || !entry.scheduler->IsEdgeTriggered()) {
+      entry.scheduler->Execute();
+      continue;
+    }
+    bool pressed = (m_stickButtons[entry.stick] >> (entry.button - 1)) & 1;
+    pressed = pressed || entry.scheduler->GetTrigger()->GetDashboardPressed();
+    if (pressed != entry.pressed) {
+      entry.pressed = pressed;
+      entry.scheduler->Execute();
+    }
   }
 }
 
@@ -218,6 +427,7 @@ void Scheduler::ResetAll() {
   RemoveAll();
   m_subsystems.clear();
   m_buttons.clear();
+  for (auto command : m_additions) command->m_pendingAddition = false;
   m_additions.clear();
   m_commands.clear();
   m_namesEntry = nt::NetworkTableEntry();
@@ -231,6 +441,11 @@ void Scheduler::InitSendable(SendableBuilder& builder) {
   m_idsEntry = builder.GetEntry("Ids");
   m_cancelEntry = builder.GetEntry("Cancel");
   builder.SetUpdateTable([=]() {
+    // Publish at the dashboard rate rather than every robot loop
+    double now = Timer::GetFPGATimestamp();
+    if (now - m_lastDashboardUpdate < m_dashboardPeriod) return;
+    m_lastDashboardUpdate = now;
+
     // Get the list of possible commands to cancel
     auto new_toCancel = m_cancelEntry.GetValue();
     if (new_toCancel)
@@ -253,18 +468,22 @@ void Scheduler::InitSendable(SendableBuilder& builder) {
       m_cancelEntry.SetDoubleArray(toCancel);
     }
 
-    // Set the running commands
+    // Set the running commands. A name is only fetched again when a
+    // different command moves into its slot.
     if (m_runningCommandsChanged) {
-      commands.resize(0);
-      ids.resize(0);
-      for (auto commandIter = m_commands.begin();
-           commandIter != m_commands.end(); ++commandIter) {
-        Command* c = *commandIter;
-        commands.push_back(c->GetName());
-        ids.push_back(c->GetID());
+      commands.resize(m_commands.size());
+      ids.resize(m_commands.size(), -1);
+      for (size_t i = 0; i < m_commands.size(); i++) {
+        Command* c = m_commands[i];
+        if (ids[i] != c->GetID() || commands[i].empty()) {
+          commands[i] = c->GetName();
+          ids[i] = c->GetID();
+        }
       }
-      m_namesEntry.SetStringArray(commands);
-      m_idsEntry.SetDoubleArray(ids);
+      detail::SetTelemetryValue(m_namesEntry,
+                                nt::Value::MakeStringArray(commands));
+      detail::SetTelemetryValue(m_idsEntry, nt::Value::MakeDoubleArray(ids));
+      m_runningCommandsChanged = false;
     }
   });
 }
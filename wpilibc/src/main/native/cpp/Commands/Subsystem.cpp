@@ -51,7 +51,7 @@ void Subsystem::SetDefaultCommand(Command* command) {
     m_defaultCommand = nullptr;
   } else {
     bool found = false;
-    Command::SubsystemSet requirements = command->GetRequirements();
+    const auto& requirements = command->GetRequirements();
     for (auto iter = requirements.begin(); iter != requirements.end(); iter++) {
       if (*iter == this) {
         found = true;
@@ -282,6 +282,27 @@ bool Compressor::GetCompressorNotConnectedFault() const {
   return value;
 }
 
+/**
+ * Read every compressor value at once, decoding each of the PCM's status
+ * frames once. Prefer this to the other getters when reading several values
+ * each loop, as for a dashboard.
+ *
+ * @return The values, with the CAN receive time of each status frame
+ */
+HAL_CompressorStatus Compressor::GetStatus() const {
+  HAL_CompressorStatus compressorStatus = {};
+  if (StatusIsFatal()) return compressorStatus;
+  int32_t status = 0;
+
+  HAL_GetCompressorStatus(m_compressorHandle, &compressorStatus, &status);
+
+  if (status) {
+    wpi_setWPIError(Timeout);
+  }
+
+  return compressorStatus;
+}
+
 /**
  * Clear ALL sticky faults inside PCM that Compressor is wired to.
  *
@@ -0,0 +1,563 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "ConfigStore.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include "WPIErrors.h"
+
+using namespace frc;
+
+constexpr uint32_t ConfigStore::kVersion;
+
+namespace {
+struct RawHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t count;
+  uint32_t stringSize;
+};
+}  // namespace
+
+struct ConfigStore::RawEntry {
+  uint32_t keyOffset;
+  uint16_t keyLength;
+  uint8_t type;
+  uint8_t padding;
+  union {
+    double doubleValue;
+    int64_t integerValue;
+    struct {
+      uint32_t offset;
+      uint32_t length;
+    } stringValue;
+  };
+};
+
+static_assert(sizeof(RawHeader) == 16, "config file header must be 16 bytes");
+
+static const char kMagic[4] = {'F', 'R', 'C', 'C'};
+
+/**
+ * A config file mapped into memory.
+ */
+class ConfigStore::Mapping {
+ public:
+  Mapping() = default;
+  ~Mapping();
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  // Returns false with errno set if the file can't be read
+  bool Map(const std::string& path);
+  // Checks the header and that every entry is in bounds and in order
+  bool Validate();
+
+  const RawEntry* Find(llvm::StringRef key) const;
+  llvm::StringRef GetString(uint32_t offset, uint32_t length) const {
+    return llvm::StringRef(m_strings + offset, length);
+  }
+
+ private:
+  const RawHeader* GetHeader() const {
+    return reinterpret_cast<const RawHeader*>(m_data);
+  }
+  llvm::StringRef GetKey(const RawEntry& entry) const {
+    return GetString(entry.keyOffset, entry.keyLength);
+  }
+
+  const uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+  const RawEntry* m_entries = nullptr;
+  const char* m_strings = nullptr;
+#ifdef _WIN32
+  std::vector<uint8_t> m_buffer;
+#endif
+};
+
+ConfigStore::Mapping::~Mapping() {
+#ifndef _WIN32
+  if (m_data) ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+}
+
+bool ConfigStore::Mapping::Map(const std::string& path) {
+#ifndef _WIN32
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    int err = errno;
+    ::close(fd);
+    errno = err;
+    return false;
+  }
+  m_size = st.st_size;
+  // An empty file can't be mapped, and is rejected by Validate()
+  if (m_size > 0) {
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      int err = errno;
+      ::close(fd);
+      errno = err;
+      return false;
+    }
+    m_data = static_cast<const uint8_t*>(data);
+  }
+  ::close(fd);
+#else
+  // No mmap; read the file into memory instead
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) return false;
+  uint8_t buf[4096];
+  size_t count;
+  while ((count = std::fread(buf, 1, sizeof(buf), file)) > 0) {
+    m_buffer.insert(m_buffer.end(), buf, buf + count);
+  }
+  bool failed = std::ferror(file);
+  std::fclose(file);
+  if (failed) return false;
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+#endif
+  return true;
+}
+
+bool ConfigStore::Mapping::Validate() {
+  static_assert(sizeof(RawEntry) == 16, "config file entries must be 16 bytes");
+  if (m_size < sizeof(RawHeader)) return false;
+  const RawHeader* header = GetHeader();
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion) {
+    return false;
+  }
+  uint64_t entriesSize = uint64_t{header->count} * sizeof(RawEntry);
+  if (sizeof(RawHeader) + entriesSize + header->stringSize != m_size) {
+    return false;
+  }
+
+  auto entries = reinterpret_cast<const RawEntry*>(m_data + sizeof(RawHeader));
+  auto strings = reinterpret_cast<const char*>(entries + header->count);
+  uint64_t stringSize = header->stringSize;
+  for (uint32_t i = 0; i < header->count; i++) {
+    const RawEntry& entry = entries[i];
+    if (entry.keyOffset + uint64_t{entry.keyLength} > stringSize) return false;
+    switch (entry.type) {
+      case kDouble:
+      case kInteger:
+        break;
+      case kBoolean:
+        if (entry.integerValue != 0 && entry.integerValue != 1) return false;
+        break;
+      case kString:
+        if (entry.stringValue.offset + uint64_t{entry.stringValue.length} >
+            stringSize) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+    // Sorted without duplicates, for Find()
+    if (i > 0) {
+      llvm::StringRef previous(strings + entries[i - 1].keyOffset,
+                               entries[i - 1].keyLength);
+      llvm::StringRef key(strings + entry.keyOffset, entry.keyLength);
+      if (previous.compare(key) >= 0) return false;
+    }
+  }
+
+  m_entries = entries;
+  m_strings = strings;
+  return true;
+}
+
+const ConfigStore::RawEntry* ConfigStore::Mapping::Find(
+    llvm::StringRef key) const {
+  const RawEntry* begin = m_entries;
+  const RawEntry* end = m_entries + GetHeader()->count;
+  auto it = std::lower_bound(begin, end, key,
+                             [&](const RawEntry& entry, llvm::StringRef k) {
+                               return GetKey(entry).compare(k) < 0;
+                             });
+  if (it == end || GetKey(*it) != key) return nullptr;
+  return it;
+}
+
+/**
+ * Maps a config file into memory.
+ *
+ * A missing or corrupt file is reported as an error, and every key reads as
+ * its default until a valid file is loaded.
+ *
+ * @param path The config file.
+ */
+ConfigStore::ConfigStore(llvm::StringRef path) : m_path(path) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!Load()) Publish(nullptr);
+}
+
+ConfigStore::~ConfigStore() {
+  // Stop the reload thread before the members it uses are destroyed
+  m_reloadNotifier.reset();
+}
+
+/**
+ * Looks up a key, returning the handle its value is read with.
+ *
+ * Looking up a key takes a lock and a search of the file, so do it once,
+ * e.g. in the constructor of the subsystem that uses the value. A key that
+ * is not in the file still gets a handle, which reads its value if a
+ * reloaded file has it.
+ *
+ * @param key The key.
+ */
+ConfigStore::Handle ConfigStore::GetHandle(llvm::StringRef key) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_handles.find(key);
+  if (it != m_handles.end()) return Handle(it->second);
+
+  int index = m_keys.size();
+  m_keys.emplace_back(key);
+  m_handles[key] = index;
+  Publish(m_snapshot.load(std::memory_order_relaxed)->mapping);
+  return Handle(index);
+}
+
+/**
+ * Returns whether the file has a value for a key.
+ */
+bool ConfigStore::Contains(Handle handle) const {
+  return GetEntry(handle) != nullptr;
+}
+
+/**
+ * Returns the value of a key as a double.
+ *
+ * Integers are converted to doubles.
+ *
+ * @param handle       The key.
+ * @param defaultValue The value to return if the key is missing or is not a
+ *                     number.
+ */
+double ConfigStore::GetDouble(Handle handle, double defaultValue) const {
+  const RawEntry* entry = GetEntry(handle);
+  if (!entry) return defaultValue;
+  switch (entry->type) {
+    case kDouble:
+      return entry->doubleValue;
+    case kInteger:
+      return entry->integerValue;
+    default:
+      return defaultValue;
+  }
+}
+
+/**
+ * Returns the value of a key as an integer.
+ *
+ * Doubles are truncated toward zero.
+ *
+ * @param handle       The key.
+ * @param defaultValue The value to return if the key is missing or is not a
+ *                     number.
+ */
+int64_t ConfigStore::GetInteger(Handle handle, int64_t defaultValue) const {
+  const RawEntry* entry = GetEntry(handle);
+  if (!entry) return defaultValue;
+  switch (entry->type) {
+    case kDouble:
+      return static_cast<int64_t>(entry->doubleValue);
+    case kInteger:
+      return entry->integerValue;
+    default:
+      return defaultValue;
+  }
+}
+
+/**
+ * Returns the value of a boolean key.
+ *
+ * @param handle       The key.
+ * @param defaultValue The value to return if the key is missing or is not a
+ *                     boolean.
+ */
+bool ConfigStore::GetBoolean(Handle handle, bool defaultValue) const {
+  const RawEntry* entry = GetEntry(handle);
+  if (!entry || entry->type != kBoolean) return defaultValue;
+  return entry->integerValue != 0;
+}
+
+/**
+ * Returns the value of a string key.
+ *
+ * The string points into the mapped file, and stays valid until the store is
+ * destroyed, even if the file is reloaded.
+ *
+ * @param handle       The key.
+ * @param defaultValue The value to return if the key is missing or is not a
+ *                     string.
+ */
+llvm::StringRef ConfigStore::GetString(Handle handle,
+                                       llvm::StringRef defaultValue) const {
+  const Snapshot* snapshot;
+  const RawEntry* entry = GetEntry(handle, &snapshot);
+  if (!entry || entry->type != kString) return defaultValue;
+  return snapshot->mapping->GetString(entry->stringValue.offset,
+                                      entry->stringValue.length);
+}
+
+/**
+ * Maps the file again if it was replaced since it was loaded.
+ *
+ * If the new file is missing or corrupt, the error is reported and the
+ * values of the old one are kept. Listeners are called after the new values
+ * are visible.
+ *
+ * @return True if a new file was loaded.
+ */
+bool ConfigStore::Reload() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (!Load()) return false;
+  }
+  m_generation.fetch_add(1, std::memory_order_release);
+
+  std::vector<std::function<void()>> listeners;
+  {
+    std::lock_guard<wpi::mutex> lock(m_listenerMutex);
+    listeners = m_listeners;
+  }
+  for (auto& listener : listeners) {
+    if (listener) listener();
+  }
+  return true;
+}
+
+/**
+ * Checks the file for changes periodically on a separate thread, reloading
+ * it when it is replaced.
+ *
+ * @param seconds The time between checks, or 0 to stop checking.
+ */
+void ConfigStore::SetReloadPeriod(double seconds) {
+  if (seconds < 0) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "reload period");
+    return;
+  }
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (seconds == 0) {
+    if (m_reloadNotifier) m_reloadNotifier->Stop();
+    return;
+  }
+  if (!m_reloadNotifier) {
+    m_reloadNotifier =
+        std::make_unique<Notifier>(&ConfigStore::CheckForChange, this);
+  }
+  m_reloadNotifier->StartPeriodic(seconds);
+}
+
+/**
+ * Returns a count that goes up every time a new file is loaded, so a loop can
+ * tell cheaply when to recompute values derived from the config.
+ */
+uint64_t ConfigStore::GetGeneration() const {
+  return m_generation.load(std::memory_order_acquire);
+}
+
+/**
+ * Adds a function to call after a new file is loaded.
+ *
+ * Listeners are called on the thread that reloaded the file: the caller of
+ * Reload(), or the reload thread started by SetReloadPeriod().
+ *
+ * @return The listener, to pass to RemoveListener().
+ */
+int ConfigStore::AddListener(std::function<void()> listener) {
+  std::lock_guard<wpi::mutex> lock(m_listenerMutex);
+  m_listeners.emplace_back(std::move(listener));
+  return m_listeners.size() - 1;
+}
+
+/**
+ * Removes a listener added with AddListener().
+ */
+void ConfigStore::RemoveListener(int listener) {
+  std::lock_guard<wpi::mutex> lock(m_listenerMutex);
+  if (listener < 0 || static_cast<size_t>(listener) >= m_listeners.size()) {
+    return;
+  }
+  m_listeners[listener] = nullptr;
+}
+
+const ConfigStore::RawEntry* ConfigStore::GetEntry(
+    Handle handle, const Snapshot** snapshotOut) const {
+  const Snapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+  if (snapshotOut) *snapshotOut = snapshot;
+  // A handle looked up after the snapshot was published has no entry in it
+  if (handle.m_index < 0 ||
+      static_cast<size_t>(handle.m_index) >= snapshot->entries.size()) {
+    return nullptr;
+  }
+  return snapshot->entries[handle.m_index];
+}
+
+bool ConfigStore::Load() {
+  FileId id{0, 0, -1};
+  struct stat st;
+  if (::stat(m_path.c_str(), &st) == 0) {
+    id = FileId{static_cast<uint64_t>(st.st_ino),
+                static_cast<int64_t>(st.st_mtime),
+                static_cast<int64_t>(st.st_size)};
+  }
+  // Only try each version of the file once, so a bad file is reported once
+  if (id == m_loadedId) return false;
+  m_loadedId = id;
+
+  auto mapping = std::make_shared<Mapping>();
+  if (!mapping->Map(m_path)) {
+    wpi_setErrnoErrorWithContext(m_path);
+    return false;
+  }
+  if (!mapping->Validate()) {
+    wpi_setWPIErrorWithContext(ConfigFileCorrupt, m_path);
+    return false;
+  }
+  Publish(std::move(mapping));
+  return true;
+}
+
+void ConfigStore::Publish(std::shared_ptr<const Mapping> mapping) {
+  auto snapshot = std::make_unique<Snapshot>();
+  snapshot->entries.reserve(m_keys.size());
+  for (const auto& key : m_keys) {
+    snapshot->entries.push_back(mapping ? mapping->Find(key) : nullptr);
+  }
+  snapshot->mapping = std::move(mapping);
+  m_snapshot.store(snapshot.get(), std::memory_order_release);
+  m_snapshots.emplace_back(std::move(snapshot));
+}
+
+void ConfigStore::CheckForChange() { Reload(); }
+
+static void PutInt(std::vector<uint8_t>& data, uint64_t value, int size) {
+  for (int i = 0; i < size; i++) {
+    data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void ConfigStore::Writer::SetDouble(llvm::StringRef key, double value) {
+  Value& v = m_values[key];
+  v.type = kDouble;
+  v.doubleValue = value;
+}
+
+void ConfigStore::Writer::SetInteger(llvm::StringRef key, int64_t value) {
+  Value& v = m_values[key];
+  v.type = kInteger;
+  v.integerValue = value;
+}
+
+void ConfigStore::Writer::SetBoolean(llvm::StringRef key, bool value) {
+  Value& v = m_values[key];
+  v.type = kBoolean;
+  v.integerValue = value ? 1 : 0;
+}
+
+void ConfigStore::Writer::SetString(llvm::StringRef key,
+                                    llvm::StringRef value) {
+  Value& v = m_values[key];
+  v.type = kString;
+  v.stringValue = value;
+}
+
+/**
+ * Writes the values to a config file, replacing it atomically.
+ *
+ * The file is written to path + ".tmp", synced to disk, then renamed to the
+ * path, so a ConfigStore reading it sees either the old file or the new one.
+ *
+ * @param path The config file.
+ * @return False, with errno set, if the file could not be written.
+ */
+bool ConfigStore::Writer::Write(llvm::StringRef path) const {
+  std::vector<uint8_t> data(kMagic, kMagic + sizeof(kMagic));
+  PutInt(data, kVersion, 4);
+  PutInt(data, m_values.size(), 4);
+  // The string pool size, filled in once the pool is built
+  PutInt(data, 0, 4);
+
+  // Keys and string values go in the pool in order; std::map keeps the keys
+  // sorted the way Validate() checks
+  std::string strings;
+  for (const auto& value : m_values) {
+    const Value& v = value.second;
+    PutInt(data, strings.size(), 4);
+    PutInt(data, value.first.size(), 2);
+    data.push_back(v.type);
+    data.push_back(0);
+    strings += value.first;
+    switch (v.type) {
+      case kDouble: {
+        uint64_t bits;
+        std::memcpy(&bits, &v.doubleValue, sizeof(bits));
+        PutInt(data, bits, 8);
+        break;
+      }
+      case kInteger:
+      case kBoolean:
+        PutInt(data, v.integerValue, 8);
+        break;
+      case kString:
+        PutInt(data, strings.size(), 4);
+        PutInt(data, v.stringValue.size(), 4);
+        strings += v.stringValue;
+        break;
+    }
+  }
+  uint32_t stringSize = strings.size();
+  for (int i = 0; i < 4; i++) {
+    data[12 + i] = static_cast<uint8_t>(stringSize >> (8 * i));
+  }
+  data.insert(data.end(), strings.begin(), strings.end());
+
+  std::string tempPath = path.str() + ".tmp";
+  std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+  if (!file) return false;
+  bool ok = std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+            std::fflush(file) == 0;
+#ifndef _WIN32
+  ok = ok && ::fsync(::fileno(file)) == 0;
+#endif
+  int err = errno;
+  std::fclose(file);
+  if (!ok) {
+    std::remove(tempPath.c_str());
+    errno = err;
+    return false;
+  }
+#ifdef _WIN32
+  // rename() doesn't replace an existing file on Windows
+  std::remove(path.str().c_str());
+#endif
+  return std::rename(tempPath.c_str(), path.str().c_str()) == 0;
+}
@@ -592,6 +592,91 @@ bool Counter::GetDirection() const {
   return value;
 }
 
+/**
+ * Get the count, period, direction and stopped state of the counter together.
+ *
+ * The values are read from the FPGA at the same instant and are stamped with
+ * the FPGA time of the read.
+ *
+ * @return The state of the counter.
+ */
+Counter::Snapshot Counter::GetSnapshot() const {
+  Snapshot snapshot{0, 0.0, false, false, 0.0};
+  if (StatusIsFatal()) return snapshot;
+  int32_t status = 0;
+  HAL_CounterSnapshot halSnapshot;
+  HAL_GetCounterSnapshot(m_counter, &halSnapshot, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  if (status != 0) return snapshot;
+  snapshot.count = halSnapshot.count;
+  snapshot.period = halSnapshot.period;
+  snapshot.direction = halSnapshot.direction;
+  snapshot.stopped = halSnapshot.stopped;
+  snapshot.timestamp = halSnapshot.timestamp * 1.0e-6;
+  return snapshot;
+}
+
+/**
+ * Measure the period and pulse width of every pulse on the up source.
+ *
+ * Unlike GetPeriod(), which only reports the latest period, this timestamps
+ * both edges of each pulse from an interrupt and keeps the latest windowSize
+ * pulses, for the duty cycle and frequency of PWM sensors and tachometers.
+ * It uses one of the 8 interrupts.
+ *
+ * @param windowSize The number of pulses the statistics cover.
+ */
+void Counter::StartPulseStatistics(int windowSize) {
+  if (StatusIsFatal()) return;
+  int32_t status = 0;
+  HAL_StartCounterPulseStatistics(m_counter, windowSize, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Stop measuring pulses and free the interrupt.
+ */
+void Counter::StopPulseStatistics() {
+  if (StatusIsFatal()) return;
+  int32_t status = 0;
+  HAL_StopCounterPulseStatistics(m_counter, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Get the min, max, mean and jitter of the latest periods and pulse widths,
+ * and the frequency and duty cycle they give.
+ */
+Counter::PulseStatistics Counter::GetPulseStatistics() const {
+  PulseStatistics stats{};
+  if (StatusIsFatal()) return stats;
+  int32_t status = 0;
+  HAL_GetCounterPulseStatistics(m_counter, &stats, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return stats;
+}
+
+/**
+ * Count the latest periods or pulse widths in binCount equal bins.
+ *
+ * @param widths   True for pulse widths, false for periods.
+ * @param min      The start of the first bin, in seconds.
+ * @param max      The end of the last bin, in seconds. Values out of the range
+ *                 are counted in the first or last bin.
+ * @param bins     Filled with the count of each bin.
+ * @param binCount Size of bins.
+ * @return The number of pulses counted.
+ */
+int Counter::GetPulseHistogram(bool widths, double min, double max, int* bins,
+                               int binCount) const {
+  if (StatusIsFatal()) return 0;
+  int32_t status = 0;
+  int count = HAL_GetCounterPulseHistogram(m_counter, widths, min, max, bins,
+                                           binCount, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return count;
+}
+
 /**
  * Set the Counter to return reversed sensing on the direction.
  *
@@ -0,0 +1,121 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "DMASample.h"
+
+#include <HAL/AnalogInput.h>
+#include <HAL/Encoder.h>
+
+#include "AnalogInput.h"
+#include "Counter.h"
+#include "DMA.h"
+#include "DigitalSource.h"
+#include "Encoder.h"
+
+using namespace frc;
+
+/**
+ * Replaces this sample with the oldest one captured by dma.
+ *
+ * @param dma            The DMA object to read from.
+ * @param timeoutSeconds How long to wait for a sample.
+ * @param remaining      Set to the number of samples still queued.
+ */
+HAL_DMAReadStatus DMASample::Update(const DMA* dma, double timeoutSeconds,
+                                    int32_t* remaining, int32_t* status) {
+  return HAL_ReadDMA(dma->dmaHandle, this,
+                     static_cast<int32_t>(timeoutSeconds * 1000), remaining,
+                     status);
+}
+
+/**
+ * Returns the FPGA time, in microseconds, at which the sample was captured.
+ */
+uint64_t DMASample::GetTime() const {
+  int32_t status = 0;
+  return HAL_GetDMASampleTime(this, &status);
+}
+
+/**
+ * Returns the FPGA time, in seconds, at which the sample was captured.
+ */
+double DMASample::GetTimeStamp() const { return GetTime() * 1.0e-6; }
+
+int32_t DMASample::GetEncoderRaw(const Encoder* encoder,
+                                 int32_t* status) const {
+  return HAL_GetDMASampleEncoderRaw(this, encoder->m_encoder, status);
+}
+
+/**
+ * Returns the encoder distance, scaled like Encoder::GetDistance().
+ */
+double DMASample::GetEncoderDistance(const Encoder* encoder,
+                                     int32_t* status) const {
+  int32_t raw = GetEncoderRaw(encoder, status);
+  if (*status != 0) return 0.0;
+  return raw * HAL_GetEncoderDecodingScaleFactor(encoder->m_encoder, status) *
+         HAL_GetEncoderDistancePerPulse(encoder->m_encoder, status);
+}
+
+int32_t DMASample::GetEncoderPeriodRaw(const Encoder* encoder,
+                                       int32_t* status) const {
+  return HAL_GetDMASampleEncoderPeriodRaw(this, encoder->m_encoder, status);
+}
+
+int32_t DMASample::GetCounter(const Counter* counter, int32_t* status) const {
+  return HAL_GetDMASampleCounter(this, counter->m_counter, status);
+}
+
+int32_t DMASample::GetCounterPeriod(const Counter* counter,
+                                    int32_t* status) const {
+  return HAL_GetDMASampleCounterPeriod(this, counter->m_counter, status);
+}
+
+bool DMASample::GetDigitalSource(const DigitalSource* digitalSource,
+                                 int32_t* status) const {
+  return HAL_GetDMASampleDigitalSource(
+      this, digitalSource->GetPortHandleForRouting(), status);
+}
+
+int32_t DMASample::GetAnalogInputRaw(const AnalogInput* analogInput,
+                                     int32_t* status) const {
+  return HAL_GetDMASampleAnalogInputRaw(this, analogInput->m_port, status);
+}
+
+double DMASample::GetAnalogInputVoltage(const AnalogInput* analogInput,
+                                        int32_t* status) const {
+  int32_t raw = GetAnalogInputRaw(analogInput, status);
+  if (*status != 0) return 0.0;
+  int32_t LSBWeight = HAL_GetAnalogLSBWeight(analogInput->m_port, status);
+  int32_t offset = HAL_GetAnalogOffset(analogInput->m_port, status);
+  return LSBWeight * 1.0e-9 * raw - offset * 1.0e-9;
+}
+
+int32_t DMASample::GetAveragedAnalogInputRaw(const AnalogInput* analogInput,
+                                             int32_t* status) const {
+  return HAL_GetDMASampleAveragedAnalogInputRaw(this, analogInput->m_port,
+                                                status);
+}
+
+double DMASample::GetAveragedAnalogInputVoltage(const AnalogInput* analogInput,
+                                                int32_t* status) const {
+  int32_t raw = GetAveragedAnalogInputRaw(analogInput, status);
+  if (*status != 0) return 0.0;
+  int32_t LSBWeight = HAL_GetAnalogLSBWeight(analogInput->m_port, status);
+  int32_t offset = HAL_GetAnalogOffset(analogInput->m_port, status);
+  int32_t oversampleBits =
+      HAL_GetAnalogOversampleBits(analogInput->m_port, status);
+  return LSBWeight * 1.0e-9 * raw / static_cast<double>(1 << oversampleBits) -
+         offset * 1.0e-9;
+}
+
+void DMASample::GetAnalogAccumulator(const AnalogInput* analogInput,
+                                     int64_t* count, int64_t* value,
+                                     int32_t* status) const {
+  HAL_GetDMASampleAnalogAccumulator(this, analogInput->m_port, count, value,
+                                    status);
+}
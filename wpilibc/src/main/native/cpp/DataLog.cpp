@@ -0,0 +1,539 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "DataLog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+#include <llvm/SmallString.h>
+#include <llvm/raw_ostream.h>
+
+#include "RobotController.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+constexpr uint16_t DataLog::kVersion;
+constexpr double DataLog::kWritePeriod;
+constexpr uint64_t DataLog::kDefaultMaxFileSize;
+constexpr size_t DataLog::kBufferSize;
+
+// Written out in chunks of about this many bytes
+static constexpr size_t kChunkSize = 64 * 1024;
+
+static constexpr uint8_t kStartRecord = 0;
+static constexpr uint8_t kBlockRecord = 2;
+
+static void PutInt(std::vector<uint8_t>& data, uint64_t value, int size) {
+  for (int i = 0; i < size; i++) {
+    data.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+static void PutVarint(std::vector<uint8_t>& data, uint64_t value) {
+  while (value >= 0x80) {
+    data.push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  data.push_back(static_cast<uint8_t>(value));
+}
+
+// Small magnitudes of either sign become small varints
+static void PutSignedVarint(std::vector<uint8_t>& data, int64_t value) {
+  PutVarint(data, (static_cast<uint64_t>(value) << 1) ^
+                      static_cast<uint64_t>(value >> 63));
+}
+
+namespace {
+// Appends bits most significant first
+class BitWriter {
+ public:
+  explicit BitWriter(std::vector<uint8_t>& data) : m_data(data) {}
+
+  void Put(uint64_t value, int count) {
+    if (count > 32) {
+      Put(value >> 32, count - 32);
+      count = 32;
+    }
+    m_bits = (m_bits << count) | (value & ((uint64_t{1} << count) - 1));
+    m_count += count;
+    while (m_count >= 8) {
+      m_count -= 8;
+      m_data.push_back(static_cast<uint8_t>(m_bits >> m_count));
+    }
+  }
+
+  // Pads the last byte with zeros
+  void Finish() {
+    if (m_count > 0) Put(0, 8 - m_count);
+  }
+
+ private:
+  std::vector<uint8_t>& m_data;
+  uint64_t m_bits = 0;
+  int m_count = 0;
+};
+}  // namespace
+
+static void EncodeTimestamps(std::vector<uint8_t>& data,
+                             llvm::ArrayRef<uint64_t> timestamps,
+                             uint64_t& last, int64_t& lastInterval) {
+  for (uint64_t timestamp : timestamps) {
+    int64_t interval = static_cast<int64_t>(timestamp - last);
+    PutSignedVarint(data, interval - lastInterval);
+    last = timestamp;
+    lastInterval = interval;
+  }
+}
+
+static void EncodeDoubles(std::vector<uint8_t>& data,
+                          llvm::ArrayRef<uint64_t> values,
+                          uint64_t& last) {
+  BitWriter writer(data);
+  // The significant bits of the last XOR written in full; none at first
+  int leading = 64;
+  int trailing = 64;
+  for (uint64_t value : values) {
+    uint64_t x = value ^ last;
+    last = value;
+    if (x == 0) {
+      writer.Put(0, 1);
+      continue;
+    }
+    int newLeading = std::min(__builtin_clzll(x), 63);
+    int newTrailing = __builtin_ctzll(x);
+    if (newLeading >= leading && newTrailing >= trailing) {
+      writer.Put(2, 2);
+      writer.Put(x >> trailing, 64 - leading - trailing);
+    } else {
+      leading = newLeading;
+      trailing = newTrailing;
+      int significant = 64 - leading - trailing;
+      writer.Put(3, 2);
+      writer.Put(leading, 6);
+      writer.Put(significant - 1, 6);
+      writer.Put(x >> trailing, significant);
+    }
+  }
+  writer.Finish();
+}
+
+static void EncodeIntegers(std::vector<uint8_t>& data,
+                           llvm::ArrayRef<uint64_t> values,
+                           uint64_t& last) {
+  size_t i = 0;
+  while (i < values.size()) {
+    int64_t difference = static_cast<int64_t>(values[i] - last);
+    size_t run = 1;
+    last = values[i];
+    while (i + run < values.size() &&
+           static_cast<int64_t>(values[i + run] - last) == difference) {
+      last = values[i + run];
+      run++;
+    }
+    PutVarint(data, run);
+    PutSignedVarint(data, difference);
+    i += run;
+  }
+}
+
+static void EncodeBooleans(std::vector<uint8_t>& data,
+                           llvm::ArrayRef<uint64_t> values) {
+  data.push_back(static_cast<uint8_t>(values[0]));
+  size_t run = 1;
+  for (size_t i = 1; i < values.size(); i++) {
+    if (values[i] != values[i - 1]) {
+      PutVarint(data, run);
+      run = 0;
+    }
+    run++;
+  }
+  PutVarint(data, run);
+}
+
+/**
+ * Append a block record of values in the log format.
+ *
+ * @param state The state of the entry's column, which is updated to encode
+ *              the next block against. A default state makes a block that
+ *              can be decoded on its own.
+ */
+void DataLog::EncodeBlock(int entry, Type type,
+                          llvm::ArrayRef<uint64_t> timestamps,
+                          llvm::ArrayRef<uint64_t> values,
+                          EncoderState& state, std::vector<uint8_t>& data) {
+  if (values.empty()) return;
+  size_t start = data.size();
+  EncodeTimestamps(data, timestamps, state.lastTimestamp, state.lastInterval);
+  switch (type) {
+    case kDouble:
+      EncodeDoubles(data, values, state.lastValue);
+      break;
+    case kInteger:
+      EncodeIntegers(data, values, state.lastValue);
+      break;
+    case kBoolean:
+      EncodeBooleans(data, values);
+      break;
+  }
+
+  // The record header goes before the payload, whose size is now known
+  uint8_t header[23] = {kBlockRecord, static_cast<uint8_t>(entry),
+                        static_cast<uint8_t>(entry >> 8)};
+  size_t size = 3;
+  for (uint64_t value : {uint64_t{values.size()}, data.size() - start}) {
+    for (; value >= 0x80; value >>= 7) {
+      header[size++] = static_cast<uint8_t>(value) | 0x80;
+    }
+    header[size++] = static_cast<uint8_t>(value);
+  }
+  data.insert(data.begin() + start, header, header + size);
+}
+
+DataLog& DataLog::GetInstance() {
+  static DataLog instance;
+  return instance;
+}
+
+DataLog::~DataLog() { Stop(); }
+
+DataLog::ThreadBuffer::~ThreadBuffer() {
+  if (buffer) buffer->inUse.store(false, std::memory_order_release);
+}
+
+/**
+ * Start writing logged values to files.
+ *
+ * Values appended before the log is started are discarded.
+ *
+ * @param directory   The directory to create the files in, e.g. a USB drive.
+ * @param maxFileSize Size in bytes after which a new file is started.
+ */
+void DataLog::Start(llvm::StringRef directory, uint64_t maxFileSize) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_thread.joinable()) return;
+  m_directory = directory;
+  m_maxFileSize = maxFileSize;
+  m_stop = false;
+  m_running = true;
+  m_thread = std::thread([=] { ThreadMain(); });
+}
+
+/**
+ * Stop logging, writing out every value appended before the call.
+ */
+void DataLog::Stop() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (!m_thread.joinable()) return;
+    m_running = false;
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+}
+
+/**
+ * Return whether values are being logged.
+ */
+bool DataLog::IsRunning() const { return m_running; }
+
+/**
+ * Get the number of values dropped because a thread appended them faster than
+ * they could be written.
+ */
+uint64_t DataLog::GetDroppedCount() const { return m_dropped; }
+
+/**
+ * Add a listener to call with the entries and values as they are written.
+ *
+ * It is first told about every entry started so far. It is called on the
+ * writer thread and should return quickly.
+ */
+void DataLog::AddListener(Listener* listener) {
+  std::lock_guard<wpi::mutex> lock(m_listenerMutex);
+  m_newListeners.push_back(listener);
+}
+
+/**
+ * Remove a listener. Waits for a call to it in progress to return.
+ */
+void DataLog::RemoveListener(Listener* listener) {
+  std::lock_guard<wpi::mutex> lock(m_listenerMutex);
+  m_listeners.erase(
+      std::remove(m_listeners.begin(), m_listeners.end(), listener),
+      m_listeners.end());
+  m_newListeners.erase(
+      std::remove(m_newListeners.begin(), m_newListeners.end(), listener),
+      m_newListeners.end());
+}
+
+int DataLog::StartEntry(llvm::StringRef name, Type type) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_entries.size() > UINT16_MAX) {
+    wpi_setWPIErrorWithContext(NoAvailableResources, "too many log entries");
+    return -1;
+  }
+  // names are stored with a one byte length
+  m_entries.push_back({name.substr(0, UINT8_MAX), type});
+  return m_entries.size() - 1;
+}
+
+void DataLog::Append(int entry, uint64_t value, uint64_t timestamp) {
+  if (entry < 0 || !m_running.load(std::memory_order_relaxed)) return;
+  Buffer* buffer = GetThreadBuffer();
+  size_t tail = buffer->tail.load(std::memory_order_relaxed);
+  if (tail - buffer->head.load(std::memory_order_acquire) >= kBufferSize) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  Record& record = buffer->records[tail % kBufferSize];
+  record.entry = entry;
+  record.timestamp = timestamp;
+  record.value = value;
+  buffer->tail.store(tail + 1, std::memory_order_release);
+}
+
+DataLog::Buffer* DataLog::GetThreadBuffer() {
+  thread_local ThreadBuffer threadBuffer;
+  if (threadBuffer.buffer) return threadBuffer.buffer.get();
+
+  // Take over the buffer of a thread that has exited, or add a new one
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  for (auto& buffer : m_buffers) {
+    bool inUse = false;
+    if (buffer->inUse.compare_exchange_strong(inUse, true,
+                                              std::memory_order_acquire)) {
+      threadBuffer.buffer = buffer;
+      return buffer.get();
+    }
+  }
+  m_buffers.push_back(std::make_shared<Buffer>());
+  threadBuffer.buffer = m_buffers.back();
+  return threadBuffer.buffer.get();
+}
+
+void DataLog::ThreadMain() {
+  OpenFile();
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  while (!m_stop) {
+    m_cond.wait_for(lock, std::chrono::duration<double>(kWritePeriod));
+    lock.unlock();
+    WriteData();
+    lock.lock();
+  }
+  lock.unlock();
+  // pick up anything appended while stopping
+  WriteData();
+  CloseFile();
+}
+
+void DataLog::WriteData() {
+  // The values of each file are encoded against earlier values in the same
+  // file, so a new file is started before encoding rather than partway
+  if (m_file && m_fileSize >= m_maxFileSize) {
+    CloseFile();
+    OpenFile();
+  }
+
+  std::lock_guard<wpi::mutex> listenerLock(m_listenerMutex);
+  for (auto listener : m_newListeners) {
+    for (size_t i = 0; i < m_written.size(); i++) {
+      listener->EntryStarted(i, m_written[i].name, m_written[i].type);
+    }
+    m_listeners.push_back(listener);
+  }
+  m_newListeners.clear();
+
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    buffers = m_buffers;
+    // Entries are started before any of their values, which were appended
+    // after the entries were created
+    for (size_t i = m_written.size(); i < m_entries.size(); i++) {
+      const EntryInfo& info = m_entries[i];
+      m_data.push_back(kStartRecord);
+      PutInt(m_data, i, 2);
+      m_data.push_back(info.type);
+      m_data.push_back(info.name.size());
+      m_data.insert(m_data.end(), info.name.begin(), info.name.end());
+      m_written.push_back(info);
+      for (auto listener : m_listeners) {
+        listener->EntryStarted(i, info.name, info.type);
+      }
+    }
+  }
+  m_columns.resize(m_written.size());
+
+  for (auto& buffer : buffers) {
+    size_t head = buffer->head.load(std::memory_order_relaxed);
+    size_t tail = buffer->tail.load(std::memory_order_acquire);
+    for (; head != tail; head++) {
+      const Record& record = buffer->records[head % kBufferSize];
+      // an entry created since the entries were started above; its values
+      // are written next time
+      if (record.entry >= m_written.size()) break;
+      Column& column = m_columns[record.entry];
+      column.timestamps.push_back(record.timestamp);
+      column.values.push_back(record.value);
+    }
+    buffer->head.store(head, std::memory_order_release);
+  }
+
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    Column& column = m_columns[i];
+    if (column.values.empty()) continue;
+    Type type = m_written[i].type;
+    EncodeBlock(i, type, column.timestamps, column.values, column.state,
+                m_data);
+    for (auto listener : m_listeners) {
+      listener->ValuesWritten(i, type, column.timestamps, column.values);
+    }
+    // Cleared rather than freed, so steady logging doesn't allocate
+    column.timestamps.clear();
+    column.values.clear();
+    if (m_data.size() >= kChunkSize) Flush();
+  }
+  for (auto listener : m_listeners) listener->PeriodEnded();
+  Flush();
+  if (m_file) std::fflush(m_file);
+}
+
+// Writes out the values collected so far
+void DataLog::Flush() {
+  if (m_data.empty()) return;
+  if (m_file) {
+    if (std::fwrite(m_data.data(), 1, m_data.size(), m_file) !=
+        m_data.size()) {
+      wpi_setErrnoErrorWithContext("writing log file");
+      CloseFile();
+    } else {
+      m_fileSize += m_data.size();
+    }
+  }
+  m_data.clear();
+}
+
+void DataLog::OpenFile() {
+  // Name the files by the time they are opened, numbered in the order they
+  // are opened, and never overwrite an existing log
+  std::time_t now = std::time(nullptr);
+  char timeStr[32];
+  std::strftime(timeStr, sizeof(timeStr), "%Y%m%d_%H%M%S",
+                std::localtime(&now));
+  for (;;) {
+    llvm::SmallString<128> path;
+    llvm::raw_svector_ostream os(path);
+    os << m_directory << "/FRC_" << timeStr << '_' << m_fileIndex++
+       << ".frclog";
+    m_file = std::fopen(path.c_str(), "wbx");
+    if (m_file || errno != EEXIST) {
+      if (!m_file) wpi_setErrnoErrorWithContext(path.str());
+      break;
+    }
+  }
+  // Values are encoded from scratch in each file
+  for (auto& column : m_columns) column.state = EncoderState();
+  if (!m_file) return;
+
+  // The header, then every entry started so far
+  std::vector<uint8_t> header{'F', 'R', 'C', 'L', 'O', 'G'};
+  PutInt(header, kVersion, 2);
+  for (size_t i = 0; i < m_written.size(); i++) {
+    const EntryInfo& info = m_written[i];
+    header.push_back(kStartRecord);
+    PutInt(header, i, 2);
+    header.push_back(info.type);
+    header.push_back(info.name.size());
+    header.insert(header.end(), info.name.begin(), info.name.end());
+  }
+  m_fileSize = std::fwrite(header.data(), 1, header.size(), m_file);
+}
+
+void DataLog::CloseFile() {
+  if (m_file) std::fclose(m_file);
+  m_file = nullptr;
+  m_fileSize = 0;
+}
+
+DataLogEntry::DataLogEntry(llvm::StringRef name, DataLog::Type type)
+    : m_id(DataLog::GetInstance().StartEntry(name, type)) {}
+
+void DataLogEntry::AppendBits(uint64_t value, uint64_t timestamp) {
+  DataLog::GetInstance().Append(m_id, value, timestamp);
+}
+
+void DataLogEntry::AppendBits(uint64_t value) {
+  // skip reading the time if the value would be discarded
+  if (!DataLog::GetInstance().IsRunning()) return;
+  AppendBits(value, RobotController::GetFPGATime());
+}
+
+DoubleLogEntry::DoubleLogEntry(llvm::StringRef name)
+    : DataLogEntry(name, DataLog::kDouble) {}
+
+/**
+ * Append a value, timestamped with the current FPGA time.
+ */
+void DoubleLogEntry::Append(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  AppendBits(bits);
+}
+
+/**
+ * Append a value.
+ *
+ * @param timestamp FPGA time of the value in microseconds, e.g. the time a
+ *                  sensor was sampled.
+ */
+void DoubleLogEntry::Append(double value, uint64_t timestamp) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  AppendBits(bits, timestamp);
+}
+
+IntegerLogEntry::IntegerLogEntry(llvm::StringRef name)
+    : DataLogEntry(name, DataLog::kInteger) {}
+
+/**
+ * Append a value, timestamped with the current FPGA time.
+ */
+void IntegerLogEntry::Append(int64_t value) {
+  AppendBits(static_cast<uint64_t>(value));
+}
+
+/**
+ * Append a value.
+ *
+ * @param timestamp FPGA time of the value in microseconds.
+ */
+void IntegerLogEntry::Append(int64_t value, uint64_t timestamp) {
+  AppendBits(static_cast<uint64_t>(value), timestamp);
+}
+
+BooleanLogEntry::BooleanLogEntry(llvm::StringRef name)
+    : DataLogEntry(name, DataLog::kBoolean) {}
+
+/**
+ * Append a value, timestamped with the current FPGA time.
+ */
+void BooleanLogEntry::Append(bool value) { AppendBits(value ? 1 : 0); }
+
+/**
+ * Append a value.
+ *
+ * @param timestamp FPGA time of the value in microseconds.
+ */
+void BooleanLogEntry::Append(bool value, uint64_t timestamp) {
+  AppendBits(value ? 1 : 0, timestamp);
+}
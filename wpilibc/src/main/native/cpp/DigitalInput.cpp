@@ -70,10 +70,12 @@ DigitalInput::~DigitalInput() {
  */
 bool DigitalInput::Get() const {
   if (StatusIsFatal()) return false;
-  int32_t status = 0;
-  bool value = HAL_GetDIO(m_handle, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
-  return value;
+  return m_valueCache.Get([=] {
+    int32_t status = 0;
+    bool value = HAL_GetDIO(m_handle, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return value;
+  });
 }
 
 /**
@@ -0,0 +1,66 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "DigitalInputGroup.h"
+
+#include <HAL/DIO.h>
+#include <HAL/HAL.h>
+
+#include "DigitalInput.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+/**
+ * Add an input to the group.
+ *
+ * @param input The input. Its channel stays allocated by the input object.
+ * @return The index of the input in the group.
+ */
+int DigitalInputGroup::Add(const DigitalInput& input) {
+  m_channels.push_back(input.GetChannel());
+  return m_channels.size() - 1;
+}
+
+/**
+ * Sample every digital input with a single FPGA read.
+ */
+void DigitalInputGroup::Update() {
+  int32_t status = 0;
+  m_values = HAL_GetAllDIO(&m_timestamp, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Get the value of an input at the last Update().
+ *
+ * @param index The index returned by Add().
+ */
+bool DigitalInputGroup::Get(int index) const {
+  if (index < 0 || index >= static_cast<int>(m_channels.size())) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "index");
+    return false;
+  }
+  return (m_values >> m_channels[index]) & 1;
+}
+
+/**
+ * Get the values of the inputs at the last Update(), with bit i set when the
+ * input at index i is high.
+ */
+uint32_t DigitalInputGroup::GetValues() const {
+  uint32_t values = 0;
+  for (size_t i = 0; i < m_channels.size() && i < 32; i++) {
+    values |= ((m_values >> m_channels[i]) & 1u) << i;
+  }
+  return values;
+}
+
+/**
+ * Get the FPGA time of the last Update(), in seconds.
+ */
+double DigitalInputGroup::GetTimestamp() const { return m_timestamp * 1.0e-6; }
@@ -12,6 +12,7 @@
 #include <HAL/DIO.h>
 #include <HAL/HAL.h>
 #include <HAL/Ports.h>
+#include <llvm/SmallVector.h>
 
 #include "SensorBase.h"
 #include "SmartDashboard/SendableBuilder.h"
@@ -213,6 +214,30 @@ void DigitalOutput::UpdateDutyCycle(double dutyCycle) {
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
+/**
+ * Change the duty-cycle of several PWM outputs in one HAL call.
+ *
+ * Each output must have PWM enabled with EnablePWM().
+ *
+ * @param outputs    The outputs to change.
+ * @param dutyCycles The duty-cycle of each output, in the order of outputs.
+ *                   [0..1]
+ */
+void DigitalOutput::UpdateDutyCycles(llvm::ArrayRef<DigitalOutput*> outputs,
+                                     llvm::ArrayRef<double> dutyCycles) {
+  if (outputs.size() != dutyCycles.size()) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "dutyCycles");
+    return;
+  }
+  llvm::SmallVector<HAL_DigitalPWMHandle, 6> generators;
+  for (auto output : outputs) generators.push_back(output->m_pwmGenerator);
+
+  int32_t status = 0;
+  HAL_SetDigitalPWMDutyCycles(generators.data(), dutyCycles.data(),
+                              generators.size(), &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
 void DigitalOutput::InitSendable(SendableBuilder& builder) {
   builder.SetSmartDashboardType("Digital Output");
   builder.AddBooleanProperty("Value", [=]() { return Get(); },
@@ -0,0 +1,69 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "DigitalOutputGroup.h"
+
+#include <HAL/DIO.h>
+#include <HAL/HAL.h>
+
+#include "DigitalOutput.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+/**
+ * Add an output to the group. It is driven low by the next Update() unless
+ * set otherwise.
+ *
+ * @param output The output. Its channel stays allocated by the output object.
+ * @return The index of the output in the group.
+ */
+int DigitalOutputGroup::Add(const DigitalOutput& output) {
+  int channel = output.GetChannel();
+  m_channels.push_back(channel);
+  m_mask |= 1u << channel;
+  return m_channels.size() - 1;
+}
+
+/**
+ * Stage the value of one output for the next Update().
+ *
+ * @param index The index returned by Add().
+ * @param value True to drive the output high.
+ */
+void DigitalOutputGroup::Set(int index, bool value) {
+  if (index < 0 || index >= static_cast<int>(m_channels.size())) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "index");
+    return;
+  }
+  uint32_t bit = 1u << m_channels[index];
+  if (value) {
+    m_values |= bit;
+  } else {
+    m_values &= ~bit;
+  }
+}
+
+/**
+ * Stage the values of every output for the next Update().
+ *
+ * @param values The values, with bit i driving the output at index i.
+ */
+void DigitalOutputGroup::SetValues(uint32_t values) {
+  for (size_t i = 0; i < m_channels.size() && i < 32; i++) {
+    Set(i, (values >> i) & 1);
+  }
+}
+
+/**
+ * Write the staged values of every output with a single FPGA write.
+ */
+void DigitalOutputGroup::Update() {
+  int32_t status = 0;
+  HAL_SetDIOMasked(m_mask, m_values, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
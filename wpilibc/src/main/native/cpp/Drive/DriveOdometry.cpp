@@ -0,0 +1,69 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Drive/DriveOdometry.h"
+
+#include <cmath>
+
+using namespace frc;
+
+/**
+ * Creates odometry.
+ *
+ * @param pose The starting pose
+ */
+DriveOdometry::DriveOdometry(const RobotPose& pose) : m_pose(pose) {}
+
+/**
+ * Sets the pose, for example when the robot is placed at a known location.
+ */
+void DriveOdometry::Reset(const RobotPose& pose) { m_pose = pose; }
+
+const RobotPose& DriveOdometry::GetPose() const { return m_pose; }
+
+/**
+ * Integrates a displacement, in the robot frame at its previous pose.
+ *
+ * @param displacement The distance moved forward and to the left, and the
+ *                     angle turned counterclockwise in radians
+ */
+const RobotPose& DriveOdometry::Update(const ChassisSpeeds& displacement) {
+  double turn = displacement.omega;
+  // Coefficients of the arc; the series avoids dividing by a tiny angle
+  double s, c;
+  if (std::abs(turn) < 1e-9) {
+    s = 1 - turn * turn / 6;
+    c = turn / 2;
+  } else {
+    s = std::sin(turn) / turn;
+    c = (1 - std::cos(turn)) / turn;
+  }
+  double dx = displacement.vx * s - displacement.vy * c;
+  double dy = displacement.vx * c + displacement.vy * s;
+  double cosH = std::cos(m_pose.heading), sinH = std::sin(m_pose.heading);
+  m_pose.x += dx * cosH - dy * sinH;
+  m_pose.y += dx * sinH + dy * cosH;
+  m_pose.heading += turn;
+  return m_pose;
+}
+
+/**
+ * Integrates a displacement using a measured heading, such as from a gyro,
+ * in place of the displacement's own rotation.
+ *
+ * @param displacement The distance moved forward and to the left
+ * @param heading      The robot heading after the move, in radians
+ *                     counterclockwise
+ */
+const RobotPose& DriveOdometry::Update(const ChassisSpeeds& displacement,
+                                       double heading) {
+  ChassisSpeeds measured = displacement;
+  measured.omega = heading - m_pose.heading;
+  Update(measured);
+  m_pose.heading = heading;
+  return m_pose;
+}
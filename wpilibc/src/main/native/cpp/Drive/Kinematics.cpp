@@ -0,0 +1,204 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Drive/Kinematics.h"
+
+#include <cmath>
+
+#include "ErrorBase.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+constexpr double kPi = 3.14159265358979323846;
+
+/**
+ * Scales wheel speeds down together so none exceeds a maximum, keeping the
+ * ratios between them and so the direction of travel.
+ *
+ * @param wheelSpeeds The wheel speeds to scale in place
+ * @param maxSpeed    The largest allowed magnitude
+ */
+void frc::DesaturateWheelSpeeds(llvm::MutableArrayRef<double> wheelSpeeds,
+                                double maxSpeed) {
+  double maxMagnitude = 0;
+  for (double speed : wheelSpeeds) {
+    maxMagnitude = std::fmax(maxMagnitude, std::abs(speed));
+  }
+  if (maxMagnitude > maxSpeed) {
+    for (double& speed : wheelSpeeds) speed *= maxSpeed / maxMagnitude;
+  }
+}
+
+bool frc::detail::PseudoInverse(const double* a, size_t rows,
+                                double* result) {
+  // A^T A, then its inverse by cofactors
+  double m[3][3] = {};
+  for (size_t r = 0; r < rows; r++) {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) m[i][j] += a[r * 3 + i] * a[r * 3 + j];
+    }
+  }
+  double inv[3][3];
+  inv[0][0] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+  inv[0][1] = m[0][2] * m[2][1] - m[0][1] * m[2][2];
+  inv[0][2] = m[0][1] * m[1][2] - m[0][2] * m[1][1];
+  inv[1][0] = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+  inv[1][1] = m[0][0] * m[2][2] - m[0][2] * m[2][0];
+  inv[1][2] = m[0][2] * m[1][0] - m[0][0] * m[1][2];
+  inv[2][0] = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+  inv[2][1] = m[0][1] * m[2][0] - m[0][0] * m[2][1];
+  inv[2][2] = m[0][0] * m[1][1] - m[0][1] * m[1][0];
+  double det = m[0][0] * inv[0][0] + m[0][1] * inv[1][0] + m[0][2] * inv[2][0];
+  if (std::abs(det) < 1e-12) {
+    for (size_t i = 0; i < 3 * rows; i++) result[i] = 0;
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange,
+                                     "wheel positions do not determine the "
+                                     "chassis velocity");
+    return false;
+  }
+  for (int i = 0; i < 3; i++) {
+    for (size_t r = 0; r < rows; r++) {
+      double sum = 0;
+      for (int j = 0; j < 3; j++) sum += inv[i][j] * a[r * 3 + j];
+      result[i * rows + r] = sum / det;
+    }
+  }
+  return true;
+}
+
+/**
+ * Creates differential drive kinematics.
+ *
+ * @param trackWidth The distance between the left and right wheels
+ */
+DifferentialDriveKinematics::DifferentialDriveKinematics(double trackWidth)
+    : m_trackWidth(trackWidth) {}
+
+/**
+ * Returns the wheel speeds that drive the robot at a chassis velocity. The
+ * sideways component is ignored.
+ */
+DifferentialDriveKinematics::WheelSpeeds
+DifferentialDriveKinematics::ToWheelSpeeds(const ChassisSpeeds& speeds) const {
+  double turn = speeds.omega * m_trackWidth / 2;
+  return {{speeds.vx - turn, speeds.vx + turn}};
+}
+
+/**
+ * Returns the chassis velocity for measured wheel speeds.
+ */
+ChassisSpeeds DifferentialDriveKinematics::ToChassisSpeeds(
+    const WheelSpeeds& wheelSpeeds) const {
+  ChassisSpeeds speeds;
+  speeds.vx = (wheelSpeeds[0] + wheelSpeeds[1]) / 2;
+  speeds.omega = (wheelSpeeds[1] - wheelSpeeds[0]) / m_trackWidth;
+  return speeds;
+}
+
+double DifferentialDriveKinematics::GetTrackWidth() const {
+  return m_trackWidth;
+}
+
+/**
+ * Creates mecanum drive kinematics.
+ *
+ * @param trackWidth The distance between the left and right wheels
+ * @param wheelBase  The distance between the front and rear wheels
+ */
+MecanumDriveKinematics::MecanumDriveKinematics(double trackWidth,
+                                               double wheelBase)
+    : m_rotationScale((trackWidth + wheelBase) / 2) {}
+
+/**
+ * Returns the wheel speeds that drive the robot at a chassis velocity.
+ */
+MecanumDriveKinematics::WheelSpeeds MecanumDriveKinematics::ToWheelSpeeds(
+    const ChassisSpeeds& speeds) const {
+  double turn = speeds.omega * m_rotationScale;
+  return {{speeds.vx - speeds.vy - turn, speeds.vx + speeds.vy + turn,
+           speeds.vx + speeds.vy - turn, speeds.vx - speeds.vy + turn}};
+}
+
+/**
+ * Returns the chassis velocity for measured wheel speeds.
+ */
+ChassisSpeeds MecanumDriveKinematics::ToChassisSpeeds(
+    const WheelSpeeds& wheelSpeeds) const {
+  double fl = wheelSpeeds[0], fr = wheelSpeeds[1];
+  double rl = wheelSpeeds[2], rr = wheelSpeeds[3];
+  ChassisSpeeds speeds;
+  speeds.vx = (fl + fr + rl + rr) / 4;
+  speeds.vy = (-fl + fr + rl - rr) / 4;
+  speeds.omega = (-fl + fr - rl + rr) / (4 * m_rotationScale);
+  return speeds;
+}
+
+/**
+ * Creates Killough drive kinematics for wheels on an equilateral triangle.
+ *
+ * The left and right wheels are at the front corners and the back wheel at
+ * the rear corner, each the given distance from the center and driving
+ * along the triangle's side: the left wheel forward and to the right, the
+ * right wheel forward and to the left, and the back wheel to the left.
+ *
+ * @param radius The distance from the center to each wheel
+ */
+KilloughDriveKinematics::KilloughDriveKinematics(double radius)
+    : KilloughDriveKinematics(
+          {{Vector2d{radius * std::cos(kPi / 3), radius * std::sin(kPi / 3)},
+            Vector2d{radius * std::cos(kPi / 3), -radius * std::sin(kPi / 3)},
+            Vector2d{-radius, 0}}},
+          {{-kPi / 6, kPi / 6, kPi / 2}}) {}
+
+/**
+ * Creates Killough drive kinematics.
+ *
+ * @param positions   The position of each wheel relative to the center of
+ *                    rotation, with x forward and y to the left
+ * @param wheelAngles The direction each wheel drives when given a positive
+ *                    speed, in radians counterclockwise from forward
+ */
+KilloughDriveKinematics::KilloughDriveKinematics(
+    const std::array<Vector2d, kWheels>& positions,
+    const std::array<double, kWheels>& wheelAngles) {
+  for (size_t i = 0; i < kWheels; i++) {
+    double c = std::cos(wheelAngles[i]), s = std::sin(wheelAngles[i]);
+    m_inverse[i][0] = c;
+    m_inverse[i][1] = s;
+    m_inverse[i][2] = s * positions[i].x - c * positions[i].y;
+  }
+  detail::PseudoInverse(&m_inverse[0][0], kWheels, &m_forward[0][0]);
+}
+
+/**
+ * Returns the wheel speeds that drive the robot at a chassis velocity.
+ */
+KilloughDriveKinematics::WheelSpeeds KilloughDriveKinematics::ToWheelSpeeds(
+    const ChassisSpeeds& speeds) const {
+  WheelSpeeds wheelSpeeds;
+  for (size_t i = 0; i < kWheels; i++) {
+    wheelSpeeds[i] = m_inverse[i][0] * speeds.vx +
+                     m_inverse[i][1] * speeds.vy +
+                     m_inverse[i][2] * speeds.omega;
+  }
+  return wheelSpeeds;
+}
+
+/**
+ * Returns the chassis velocity for measured wheel speeds.
+ */
+ChassisSpeeds KilloughDriveKinematics::ToChassisSpeeds(
+    const WheelSpeeds& wheelSpeeds) const {
+  double result[3];
+  for (int row = 0; row < 3; row++) {
+    result[row] = m_forward[row][0] * wheelSpeeds[0] +
+                  m_forward[row][1] * wheelSpeeds[1] +
+                  m_forward[row][2] * wheelSpeeds[2];
+  }
+  return {result[0], result[1], result[2]};
+}
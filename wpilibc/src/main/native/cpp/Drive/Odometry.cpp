@@ -0,0 +1,153 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Drive/Odometry.h"
+
+#include <utility>
+
+using namespace frc;
+
+constexpr double kPi = 3.14159265358979323846;
+
+/**
+ * Creates odometry that takes its measurements from a function, and starts
+ * it. Use this for drives the other constructors do not cover, such as swerve
+ * drives.
+ *
+ * @param source Called on the odometry thread each period for the motion
+ *               since its previous call
+ * @param period The time between updates, in seconds
+ */
+Odometry::Odometry(Source source, double period)
+    : m_source(std::move(source)), m_period(period) {
+  m_notifier = std::make_unique<Notifier>(&Odometry::Update, this);
+  m_notifier->StartPeriodic(m_period);
+}
+
+/**
+ * Creates odometry for a differential drive, and starts it.
+ *
+ * @param leftEncoder  The left side encoder
+ * @param rightEncoder The right side encoder, counting up driving forward
+ * @param trackWidth   The distance between the left and right wheels, in the
+ *                     encoders' distance units
+ * @param gyro         A gyro to take the heading from, or nullptr to compute
+ *                     it from the wheels
+ * @param period       The time between updates, in seconds
+ */
+Odometry::Odometry(Encoder& leftEncoder, Encoder& rightEncoder,
+                   double trackWidth, Gyro* gyro, double period)
+    : Odometry(DifferentialDriveKinematics(trackWidth),
+               std::array<Encoder*, 2>{{&leftEncoder, &rightEncoder}}, gyro,
+               period) {}
+
+Odometry::~Odometry() {
+  // Stop the notifier before the members it uses are destroyed
+  m_notifier.reset();
+}
+
+/**
+ * Sets the pose, for example when the robot is placed at a known location,
+ * and clears the history.
+ */
+void Odometry::Reset(const RobotPose& pose) {
+  std::lock_guard<wpi::mutex> lock(m_updateMutex);
+  m_odometry.Reset(pose);
+  m_headingOffset = pose.heading - m_lastHeading;
+  m_count.store(0, std::memory_order_release);
+  Sample sample = m_latest.Load();
+  sample.pose = pose;
+  m_latest.Store(sample);
+}
+
+/**
+ * Returns the most recent pose.
+ */
+RobotPose Odometry::GetPose() const { return m_latest.Load().pose; }
+
+/**
+ * Returns the most recent velocity, in the robot frame.
+ */
+ChassisSpeeds Odometry::GetVelocity() const {
+  return m_latest.Load().velocity;
+}
+
+/**
+ * Returns the FPGA time in seconds of the most recent pose.
+ */
+double Odometry::GetTimestamp() const { return m_latest.Load().timestamp; }
+
+/**
+ * Returns the pose at an earlier time, interpolated between the poses
+ * recorded around it. Times before the history give the oldest pose, and
+ * times after the latest update give the latest pose.
+ *
+ * @param timestamp The FPGA time in seconds, e.g. the capture time of a
+ *                  camera frame
+ */
+RobotPose Odometry::GetPoseAt(double timestamp) const {
+  uint64_t count = m_count.load(std::memory_order_acquire);
+  if (count == 0) return GetPose();
+
+  // Walk back from the newest sample. The writer may overwrite the oldest
+  // samples meanwhile; stop at the first sample that is newer than the one
+  // after it, or the last few slots, which the writer may be reusing.
+  uint64_t oldest = count > kHistorySize - 2 ? count - (kHistorySize - 2) : 0;
+  Sample newer = m_history[(count - 1) % kHistorySize].Load();
+  if (timestamp >= newer.timestamp) return newer.pose;
+  for (uint64_t i = count - 1; i-- > oldest;) {
+    Sample older = m_history[i % kHistorySize].Load();
+    if (older.timestamp > newer.timestamp) break;
+    if (older.timestamp <= timestamp) {
+      double span = newer.timestamp - older.timestamp;
+      double f = span > 0 ? (timestamp - older.timestamp) / span : 0;
+      RobotPose pose;
+      pose.x = older.pose.x + (newer.pose.x - older.pose.x) * f;
+      pose.y = older.pose.y + (newer.pose.y - older.pose.y) * f;
+      pose.heading =
+          older.pose.heading + (newer.pose.heading - older.pose.heading) * f;
+      return pose;
+    }
+    newer = older;
+  }
+  return newer.pose;
+}
+
+/**
+ * Returns the time between updates, in seconds.
+ */
+double Odometry::GetPeriod() const { return m_period; }
+
+double Odometry::GyroHeading(const Gyro& gyro) {
+  // Gyros measure clockwise in degrees
+  return -gyro.GetAngle() * (kPi / 180.0);
+}
+
+void Odometry::Update() {
+  Measurement measurement = m_source();
+
+  std::lock_guard<wpi::mutex> lock(m_updateMutex);
+  if (measurement.hasHeading) {
+    if (m_resetHeading) {
+      // Start from the odometry's heading whatever the gyro reads
+      m_headingOffset = m_odometry.GetPose().heading - measurement.heading;
+      m_resetHeading = false;
+    }
+    m_lastHeading = measurement.heading;
+    m_odometry.Update(measurement.displacement,
+                      measurement.heading + m_headingOffset);
+  } else {
+    m_odometry.Update(measurement.displacement);
+  }
+
+  Sample sample{measurement.timestamp, m_odometry.GetPose(),
+                measurement.velocity};
+  m_latest.Store(sample);
+  uint64_t count = m_count.load(std::memory_order_relaxed);
+  m_history[count % kHistorySize].Store(sample);
+  m_count.store(count + 1, std::memory_order_release);
+}
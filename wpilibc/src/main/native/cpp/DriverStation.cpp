@@ -7,20 +7,26 @@
 
 #include "DriverStation.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 
 #include <HAL/HAL.h>
 #include <HAL/Power.h>
+#include <HAL/cpp/BoundedMPSCQueue.h>
 #include <HAL/cpp/Log.h>
 #include <llvm/SmallString.h>
 #include <llvm/StringRef.h>
+#include <llvm/raw_ostream.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
 #include <networktables/NetworkTableInstance.h>
 
 #include "AnalogInput.h"
+#include "Internal/DeviceLog.h"
 #include "MotorSafetyHelper.h"
 #include "Timer.h"
+#include "Tracing.h"
 #include "Utility.h"
 #include "WPIErrors.h"
 
@@ -68,12 +74,297 @@ class MatchDataSender {
     controlWord.ForceSetDouble(0);
   }
 };
+
+class DriverStationLog {
+ public:
+  DriverStationLog() {
+    constexpr auto kClass = DeviceLogClass::kDriverStation;
+    m_controlWordLog.Init(kClass, "DriverStation/ControlWord");
+    for (int stick = 0; stick < DriverStation::kJoystickPorts; stick++) {
+      std::string name = ("DriverStation/Joystick/" + llvm::Twine(stick)).str();
+      for (int i = 0; i < HAL_kMaxJoystickAxes; i++) {
+        m_axes[stick][i].Init(kClass, name + "/Axis/" + llvm::Twine(i));
+      }
+      for (int i = 0; i < HAL_kMaxJoystickPOVs; i++) {
+        m_povs[stick][i].Init(kClass, name + "/POV/" + llvm::Twine(i));
+      }
+      m_buttons[stick].Init(kClass, name + "/Buttons");
+    }
+  }
+
+  void Log(uint32_t word, const HAL_JoystickAxes* stickAxes,
+           const HAL_JoystickPOVs* stickPOVs,
+           const HAL_JoystickButtons* stickButtons) {
+    m_controlWordLog.Log(static_cast<int64_t>(word));
+    for (int stick = 0; stick < DriverStation::kJoystickPorts; stick++) {
+      for (int i = 0; i < stickAxes[stick].count; i++) {
+        m_axes[stick][i].Log(static_cast<double>(stickAxes[stick].axes[i]));
+      }
+      for (int i = 0; i < stickPOVs[stick].count; i++) {
+        m_povs[stick][i].Log(static_cast<int64_t>(stickPOVs[stick].povs[i]));
+      }
+      if (stickButtons[stick].count > 0) {
+        m_buttons[stick].Log(
+            static_cast<int64_t>(stickButtons[stick].buttons));
+      }
+    }
+  }
+
+ private:
+  DeviceLogSignal<IntegerLogEntry> m_controlWordLog;
+  DeviceLogSignal<DoubleLogEntry> m_axes[DriverStation::kJoystickPorts]
+                                        [HAL_kMaxJoystickAxes];
+  DeviceLogSignal<IntegerLogEntry> m_povs[DriverStation::kJoystickPorts]
+                                         [HAL_kMaxJoystickPOVs];
+  DeviceLogSignal<IntegerLogEntry> m_buttons[DriverStation::kJoystickPorts];
+};
 }  // namespace frc
 
+namespace {
+constexpr auto kAsyncErrorPollInterval = std::chrono::milliseconds(20);
+
+struct AsyncError {
+  static constexpr int kMaxFrames = 32;
+
+  bool isError;
+  int32_t code;
+  char details[256];
+  char location[128];
+  void* frames[kMaxFrames];
+  int frameCount;
+};
+
+/**
+ * Sends errors reported with DriverStation::ReportError(), ReportWarning()
+ * and ReportErrorAsync() from a background thread, so the reporting thread
+ * never waits on the message mutex, the console or the DS connection.
+ *
+ * Reporters copy the message into a lock-free queue, after dropping repeats of
+ * a message sent within the last second by its hash, and messages from a
+ * source (the location, or the message itself without one) that is over its
+ * rate limit. Warnings are dropped once the queue is three quarters full, so
+ * the rest of it is kept for errors. Stack traces are captured as return
+ * addresses and symbolized on the background thread, which also reports how
+ * many messages were dropped.
+ */
+class AsyncErrorReporter {
+ public:
+  static AsyncErrorReporter& GetInstance() {
+    static AsyncErrorReporter instance;
+    return instance;
+  }
+
+  ~AsyncErrorReporter();
+
+  // Returns false if the message repeats a recent one or its source is over
+  // its rate limit
+  bool Accept(const AsyncError& error);
+  void Push(const AsyncError& error);
+  frc::DriverStation::ErrorReportCounts GetCounts() const;
+
+ private:
+  AsyncErrorReporter();
+
+  void ThreadMain();
+
+  static constexpr int kQueueSize = 64;
+  static constexpr int kWarningQueueLimit = kQueueSize * 3 / 4;
+  static constexpr int kRecentSize = 32;
+  static constexpr int64_t kRepeatInterval = 1000000;  // us
+  // Each source may send a burst of this many messages, then one per interval
+  static constexpr int64_t kSourceBurst = 10;
+  static constexpr int64_t kSourceInterval = 500000;  // us
+
+  hal::BoundedMPSCQueue<AsyncError, kQueueSize> m_queue;
+  std::atomic<int> m_queued{0};
+  // Hash and send time of recent messages, indexed by the hash; a collision
+  // only lets a repeat through early
+  std::atomic<uint64_t> m_recentHashes[kRecentSize];
+  std::atomic<int64_t> m_recentTimes[kRecentSize];
+  // Hash of each source and the time its rate limit is paid off until,
+  // indexed by the hash; a colliding source takes the slot over
+  std::atomic<uint64_t> m_sourceHashes[kRecentSize];
+  std::atomic<int64_t> m_sourceTimes[kRecentSize];
+
+  std::atomic<int64_t> m_sent{0};
+  std::atomic<int64_t> m_repeats{0};
+  std::atomic<int64_t> m_rateLimited{0};
+  std::atomic<int64_t> m_droppedErrors{0};
+  std::atomic<int64_t> m_droppedWarnings{0};
+
+  std::atomic_bool m_active{true};
+  std::thread m_thread;
+};
+}  // namespace
+
+constexpr int AsyncErrorReporter::kQueueSize;
+constexpr int AsyncErrorReporter::kWarningQueueLimit;
+
+AsyncErrorReporter::AsyncErrorReporter() {
+  for (int i = 0; i < kRecentSize; i++) {
+    m_recentHashes[i] = 0;
+    m_recentTimes[i] = 0;
+    m_sourceHashes[i] = 0;
+    m_sourceTimes[i] = 0;
+  }
+  // Not a real-time thread, so it never preempts the robot loop
+  m_thread = std::thread(&AsyncErrorReporter::ThreadMain, this);
+}
+
+AsyncErrorReporter::~AsyncErrorReporter() {
+  m_active = false;
+  if (m_thread.joinable()) m_thread.join();
+}
+
+bool AsyncErrorReporter::Accept(const AsyncError& error) {
+  // FNV-1a
+  auto mix = [](uint64_t hash, llvm::StringRef str) {
+    for (char c : str) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  };
+  uint64_t detailsHash = mix(14695981039346656037ull, error.details);
+  uint64_t sourceHash = error.location[0] != '\0'
+                            ? mix(14695981039346656037ull, error.location)
+                            : detailsHash;
+  uint64_t hash = mix(detailsHash, error.location);
+  hash ^= static_cast<uint32_t>(error.code);
+  if (hash == 0) hash = 1;
+  if (sourceHash == 0) sourceHash = 1;
+
+  auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+                 .count();
+  int slot = hash % kRecentSize;
+  if (m_recentHashes[slot].load(std::memory_order_relaxed) == hash &&
+      now - m_recentTimes[slot].load(std::memory_order_relaxed) <
+          kRepeatInterval) {
+    m_repeats.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Each message adds an interval to the source's time, which may run ahead
+  // of now by at most the burst
+  int sourceSlot = sourceHash % kRecentSize;
+  int64_t paidUntil = now;
+  if (m_sourceHashes[sourceSlot].exchange(
+          sourceHash, std::memory_order_relaxed) == sourceHash) {
+    int64_t sourceTime =
+        m_sourceTimes[sourceSlot].load(std::memory_order_relaxed);
+    paidUntil = std::max(now, sourceTime);
+  }
+  if (paidUntil - now >= kSourceBurst * kSourceInterval) {
+    m_rateLimited.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  m_sourceTimes[sourceSlot].store(paidUntil + kSourceInterval,
+                                  std::memory_order_relaxed);
+
+  m_recentHashes[slot].store(hash, std::memory_order_relaxed);
+  m_recentTimes[slot].store(now, std::memory_order_relaxed);
+  return true;
+}
+
+void AsyncErrorReporter::Push(const AsyncError& error) {
+  int limit = error.isError ? kQueueSize : kWarningQueueLimit;
+  if (m_queued.fetch_add(1, std::memory_order_relaxed) >= limit ||
+      !m_queue.Push(error)) {
+    m_queued.fetch_sub(1, std::memory_order_relaxed);
+    (error.isError ? m_droppedErrors : m_droppedWarnings)
+        .fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+frc::DriverStation::ErrorReportCounts AsyncErrorReporter::GetCounts() const {
+  frc::DriverStation::ErrorReportCounts counts;
+  counts.sent = m_sent.load(std::memory_order_relaxed);
+  counts.repeats = m_repeats.load(std::memory_order_relaxed);
+  counts.rateLimited = m_rateLimited.load(std::memory_order_relaxed);
+  counts.droppedErrors = m_droppedErrors.load(std::memory_order_relaxed);
+  counts.droppedWarnings = m_droppedWarnings.load(std::memory_order_relaxed);
+  return counts;
+}
+
+void AsyncErrorReporter::ThreadMain() {
+  int64_t reportedDrops = 0;
+  AsyncError error;
+  for (;;) {
+    bool active = m_active;
+    // Drain what was queued before a shutdown too
+    while (m_queue.Pop(&error)) {
+      m_queued.fetch_sub(1, std::memory_order_relaxed);
+      std::string stack;
+      if (error.frameCount > 0) {
+        stack = GetStackTrace(error.frames, error.frameCount);
+      }
+      HAL_SendError(error.isError, error.code, 0, error.details,
+                    error.location, stack.c_str(), 1);
+      m_sent.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Repeats are expected and not reported
+    auto counts = GetCounts();
+    int64_t drops =
+        counts.rateLimited + counts.droppedErrors + counts.droppedWarnings;
+    if (drops != reportedDrops) {
+      llvm::SmallString<128> message;
+      llvm::raw_svector_ostream oss(message);
+      oss << (drops - reportedDrops) << " error messages dropped (total "
+          << counts.rateLimited << " rate limited, " << counts.droppedErrors
+          << " errors and " << counts.droppedWarnings
+          << " warnings with the queue full)";
+      HAL_SendError(0, 1, 0, oss.str().str().c_str(), "", "", 1);
+      reportedDrops = drops;
+    }
+
+    if (!active) return;
+    std::this_thread::sleep_for(kAsyncErrorPollInterval);
+  }
+}
+
+// Fill in the message, returning false if it repeats a recent one
+static bool AcceptAsyncError(AsyncError* message, bool isError, int code,
+                             const llvm::Twine& error,
+                             const llvm::Twine& location) {
+  message->isError = isError;
+  message->code = code;
+  llvm::SmallString<256> temp;
+  auto details = error.toStringRef(temp);
+  details = details.substr(0, sizeof(message->details) - 1);
+  std::memcpy(message->details, details.data(), details.size());
+  message->details[details.size()] = '\0';
+  temp.clear();
+  auto where = location.toStringRef(temp);
+  where = where.substr(0, sizeof(message->location) - 1);
+  std::memcpy(message->location, where.data(), where.size());
+  message->location[where.size()] = '\0';
+  return AsyncErrorReporter::GetInstance().Accept(*message);
+}
+
 using namespace frc;
 
 static constexpr double kJoystickUnpluggedMessageInterval = 1.0;
 
+// How long the DS thread waits for a packet before refreshing the control
+// word anyway, in seconds
+static constexpr double kControlWordRefreshTimeout = 0.05;
+
+template <typename F>
+void DriverStation::ReadLatest(F&& read) const {
+  while (true) {
+    uint64_t packet = m_packetNumber.load(std::memory_order_acquire);
+    const auto& slot = m_joystickStates[packet % kPacketHistorySize];
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    // The slot was reused for a newer packet; start over from the newest
+    if (sequence != 2 * packet) continue;
+    read(slot.state);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == sequence) return;
+  }
+}
+
 DriverStation::~DriverStation() {
   m_isRunning = false;
   // Trigger a DS mutex release in case there is no driver station running.
@@ -94,29 +385,33 @@ DriverStation& DriverStation::GetInstance() {
 /**
  * Report an error to the DriverStation messages window.
  *
- * The error is also printed to the program console.
+ * The error is also printed to the program console. Like ReportErrorAsync(),
+ * this only queues the message for a background thread, and drops repeats
+ * within a second and messages over the rate limit. Use the five argument
+ * ReportError() to send a message before returning.
  */
 void DriverStation::ReportError(const llvm::Twine& error) {
-  llvm::SmallString<128> temp;
-  HAL_SendError(1, 1, 0, error.toNullTerminatedStringRef(temp).data(), "", "",
-                1);
+  ReportErrorAsync(true, 1, error, "");
 }
 
 /**
  * Report a warning to the DriverStation messages window.
  *
- * The warning is also printed to the program console.
+ * The warning is also printed to the program console. Like
+ * ReportErrorAsync(), this only queues the message for a background thread,
+ * and drops repeats within a second and messages over the rate limit. Use the
+ * five argument ReportError() to send a message before returning.
  */
 void DriverStation::ReportWarning(const llvm::Twine& error) {
-  llvm::SmallString<128> temp;
-  HAL_SendError(0, 1, 0, error.toNullTerminatedStringRef(temp).data(), "", "",
-                1);
+  ReportErrorAsync(false, 1, error, "");
 }
 
 /**
  * Report an error to the DriverStation messages window.
  *
- * The error is also printed to the program console.
+ * The error is also printed to the program console. Unlike the other report
+ * functions, this sends the message before returning, bypassing the queue and
+ * its rate limits.
  */
 void DriverStation::ReportError(bool isError, int32_t code,
                                 const llvm::Twine& error,
@@ -131,6 +426,76 @@ void DriverStation::ReportError(bool isError, int32_t code,
                 stack.toNullTerminatedStringRef(stackTemp).data(), 1);
 }
 
+/**
+ * Report an error to the DriverStation messages window without waiting for it
+ * to be sent.
+ *
+ * The message is queued for a background thread, which prints it to the
+ * program console, symbolizes the stack trace and sends it to the DS. Repeats
+ * of a message within a second are dropped on the calling thread. So that a
+ * burst of messages can't crowd out the rest, each source (the location, or
+ * the message without one) may send a burst of 10 and then one every half
+ * second, warnings are dropped once the queue is three quarters full, and
+ * errors only when it is full. GetErrorReportCounts() counts each kind of
+ * drop. Long messages are truncated.
+ *
+ * @param stackOffset The number of callers of this function to leave out of
+ *                    the stack trace, or -1 for no stack trace.
+ */
+void DriverStation::ReportErrorAsync(bool isError, int code,
+                                     const llvm::Twine& error,
+                                     const llvm::Twine& location,
+                                     int stackOffset) {
+  AsyncError message;
+  if (!AcceptAsyncError(&message, isError, code, error, location)) return;
+
+  message.frameCount = 0;
+  if (stackOffset >= 0) {
+    // Also leave out this function and CaptureStackTrace()
+    message.frameCount = CaptureStackTrace(
+        message.frames, AsyncError::kMaxFrames, stackOffset + 2);
+  }
+  AsyncErrorReporter::GetInstance().Push(message);
+}
+
+/**
+ * Report an error to the DriverStation messages window without waiting for it
+ * to be sent, with a stack trace captured by CaptureStackTrace().
+ *
+ * @param stackFrames     The return addresses of the stack trace, which are
+ *                        symbolized on the background thread.
+ * @param stackFrameCount The number of stack frames.
+ */
+void DriverStation::ReportErrorAsync(bool isError, int code,
+                                     const llvm::Twine& error,
+                                     const llvm::Twine& location,
+                                     void* const* stackFrames,
+                                     int stackFrameCount) {
+  AsyncError message;
+  if (!AcceptAsyncError(&message, isError, code, error, location)) return;
+
+  message.frameCount = std::min(stackFrameCount, AsyncError::kMaxFrames);
+  std::copy(stackFrames, stackFrames + message.frameCount, message.frames);
+  AsyncErrorReporter::GetInstance().Push(message);
+}
+
+/**
+ * Return the number of errors and warnings dropped because the queue was
+ * full, or for warnings nearly full.
+ */
+int64_t DriverStation::GetDroppedErrorCount() {
+  auto counts = AsyncErrorReporter::GetInstance().GetCounts();
+  return counts.droppedErrors + counts.droppedWarnings;
+}
+
+/**
+ * Return how many of the reported errors and warnings were sent, and how many
+ * were dropped for each reason.
+ */
+DriverStation::ErrorReportCounts DriverStation::GetErrorReportCounts() {
+  return AsyncErrorReporter::GetInstance().GetCounts();
+}
+
 /**
  * The state of one joystick button. Button indexes begin at 1.
  *
@@ -148,17 +513,17 @@ bool DriverStation::GetStickButton(int stick, int button) {
         "ERROR: Button indexes begin at 1 in WPILib for C++ and Java");
     return false;
   }
-  std::unique_lock<wpi::mutex> lock(m_cacheDataMutex);
-  if (button > m_joystickButtons[stick].count) {
-    // Unlock early so error printing isn't locked.
-    lock.unlock();
+  HAL_JoystickButtons buttons;
+  ReadLatest(
+      [&](const JoystickState& state) { buttons = state.buttons[stick]; });
+  if (button > buttons.count) {
     ReportJoystickUnpluggedWarning(
         "Joystick Button missing, check if all controllers are "
         "plugged in");
     return false;
   }
 
-  return m_joystickButtons[stick].buttons & 1 << (button - 1);
+  return buttons.buttons & 1 << (button - 1);
 }
 
 /**
@@ -249,11 +614,15 @@ double DriverStation::GetStickAxis(int stick, int axis) {
     wpi_setWPIError(BadJoystickIndex);
     return 0;
   }
-  std::unique_lock<wpi::mutex> lock(m_cacheDataMutex);
-  if (axis >= m_joystickAxes[stick].count) {
-    // Unlock early so error printing isn't locked.
-    m_cacheDataMutex.unlock();
-    lock.release();
+  int count = 0;
+  float value = 0;
+  ReadLatest([&](const JoystickState& state) {
+    count = state.axes[stick].count;
+    if (axis < count && axis < HAL_kMaxJoystickAxes) {
+      value = state.axes[stick].axes[axis];
+    }
+  });
+  if (axis >= count) {
     if (axis >= HAL_kMaxJoystickAxes)
       wpi_setWPIError(BadJoystickAxis);
     else
@@ -262,7 +631,7 @@ double DriverStation::GetStickAxis(int stick, int axis) {
     return 0.0;
   }
 
-  return m_joystickAxes[stick].axes[axis];
+  return value;
 }
 
 /**
@@ -275,10 +644,15 @@ int DriverStation::GetStickPOV(int stick, int pov) {
     wpi_setWPIError(BadJoystickIndex);
     return -1;
   }
-  std::unique_lock<wpi::mutex> lock(m_cacheDataMutex);
-  if (pov >= m_joystickPOVs[stick].count) {
-    // Unlock early so error printing isn't locked.
-    lock.unlock();
+  int count = 0;
+  int value = -1;
+  ReadLatest([&](const JoystickState& state) {
+    count = state.povs[stick].count;
+    if (pov < count && pov < HAL_kMaxJoystickPOVs) {
+      value = state.povs[stick].povs[pov];
+    }
+  });
+  if (pov >= count) {
     if (pov >= HAL_kMaxJoystickPOVs)
       wpi_setWPIError(BadJoystickAxis);
     else
@@ -287,7 +661,7 @@ int DriverStation::GetStickPOV(int stick, int pov) {
     return -1;
   }
 
-  return m_joystickPOVs[stick].povs[pov];
+  return value;
 }
 
 /**
@@ -301,8 +675,11 @@ int DriverStation::GetStickButtons(int stick) const {
     wpi_setWPIError(BadJoystickIndex);
     return 0;
   }
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_joystickButtons[stick].buttons;
+  int value = 0;
+  ReadLatest([&](const JoystickState& state) {
+    value = state.buttons[stick].buttons;
+  });
+  return value;
 }
 
 /**
@@ -316,8 +693,11 @@ int DriverStation::GetStickAxisCount(int stick) const {
     wpi_setWPIError(BadJoystickIndex);
     return 0;
   }
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_joystickAxes[stick].count;
+  int value = 0;
+  ReadLatest([&](const JoystickState& state) {
+    value = state.axes[stick].count;
+  });
+  return value;
 }
 
 /**
@@ -331,8 +711,11 @@ int DriverStation::GetStickPOVCount(int stick) const {
     wpi_setWPIError(BadJoystickIndex);
     return 0;
   }
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_joystickPOVs[stick].count;
+  int value = 0;
+  ReadLatest([&](const JoystickState& state) {
+    value = state.povs[stick].count;
+  });
+  return value;
 }
 
 /**
@@ -346,8 +729,11 @@ int DriverStation::GetStickButtonCount(int stick) const {
     wpi_setWPIError(BadJoystickIndex);
     return 0;
   }
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_joystickButtons[stick].count;
+  int value = 0;
+  ReadLatest([&](const JoystickState& state) {
+    value = state.buttons[stick].count;
+  });
+  return value;
 }
 
 /**
@@ -410,14 +796,64 @@ int DriverStation::GetJoystickAxisType(int stick, int axis) const {
   return m_joystickDescriptor[stick].axisTypes[axis];
 }
 
+/**
+ * Returns the joystick and control data of the newest Driver Station packet.
+ *
+ * This does not lock against the DS thread, and all values in the returned
+ * state come from the same packet.
+ *
+ * @return The newest joystick state; packetNumber is 0 before the first packet
+ */
+DriverStation::JoystickState DriverStation::GetJoystickState() const {
+  JoystickState result;
+  ReadLatest([&](const JoystickState& state) { result = state; });
+  return result;
+}
+
+/**
+ * Copies the most recent Driver Station packets, oldest first.
+ *
+ * Up to kPacketHistorySize packets are kept. Gaps in packetNumber between
+ * calls show how many packets were missed.
+ *
+ * @param states Array to receive the packets.
+ * @param count  Maximum number of packets to copy.
+ * @return The number of packets copied.
+ */
+int DriverStation::GetJoystickStateHistory(JoystickState* states,
+                                           int count) const {
+  uint64_t newest = m_packetNumber.load(std::memory_order_acquire);
+  if (count > kPacketHistorySize) count = kPacketHistorySize;
+  if (static_cast<uint64_t>(count) > newest) count = static_cast<int>(newest);
+  if (count <= 0) return 0;
+  int copied = 0;
+  for (uint64_t packet = newest - count + 1; packet <= newest; packet++) {
+    const auto& slot = m_joystickStates[packet % kPacketHistorySize];
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    // Skip packets overwritten since newest was read
+    if (sequence != 2 * packet) continue;
+    states[copied] = slot.state;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+    copied++;
+  }
+  return copied;
+}
+
+/**
+ * Returns the number of Driver Station packets processed so far.
+ */
+uint64_t DriverStation::GetPacketNumber() const {
+  return m_packetNumber.load(std::memory_order_acquire);
+}
+
 /**
  * Check if the DS has enabled the robot.
  *
  * @return True if the robot is enabled and the DS is connected
  */
 bool DriverStation::IsEnabled() const {
-  HAL_ControlWord controlWord;
-  UpdateControlWord(false, controlWord);
+  HAL_ControlWord controlWord = GetControlWord();
   return controlWord.enabled && controlWord.dsAttached;
 }
 
@@ -427,8 +863,7 @@ bool DriverStation::IsEnabled() const {
  * @return True if the robot is explicitly disabled or the DS is not connected
  */
 bool DriverStation::IsDisabled() const {
-  HAL_ControlWord controlWord;
-  UpdateControlWord(false, controlWord);
+  HAL_ControlWord controlWord = GetControlWord();
   return !(controlWord.enabled && controlWord.dsAttached);
 }
 
@@ -438,8 +873,7 @@ bool DriverStation::IsDisabled() const {
  * @return True if the robot is being commanded to be in autonomous mode
  */
 bool DriverStation::IsAutonomous() const {
-  HAL_ControlWord controlWord;
-  UpdateControlWord(false, controlWord);
+  HAL_ControlWord controlWord = GetControlWord();
   return controlWord.autonomous;
 }
 
@@ -449,8 +883,7 @@ bool DriverStation::IsAutonomous() const {
  * @return True if the robot is being commanded to be in teleop mode
  */
 bool DriverStation::IsOperatorControl() const {
-  HAL_ControlWord controlWord;
-  UpdateControlWord(false, controlWord);
+  HAL_ControlWord controlWord = GetControlWord();
   return !(controlWord.autonomous || controlWord.test);
 }
 
@@ -460,8 +893,7 @@ bool DriverStation::IsOperatorControl() const {
  * @return True if the robot is being commanded to be in test mode
  */
 bool DriverStation::IsTest() const {
-  HAL_ControlWord controlWord;
-  UpdateControlWord(false, controlWord);
+  HAL_ControlWord controlWord = GetControlWord();
   return controlWord.test;
 }
 
@@ -471,8 +903,7 @@ bool DriverStation::IsTest() const {
  * @return True if the DS is connected to the robot
  */
 bool DriverStation::IsDSAttached() const {
-  HAL_ControlWord controlWord;
-  UpdateControlWord(false, controlWord);
+  HAL_ControlWord controlWord = GetControlWord();
   return controlWord.dsAttached;
 }
 
@@ -494,8 +925,7 @@ bool DriverStation::IsNewControlData() const { return HAL_IsNewControlData(); }
  *         Management System
  */
 bool DriverStation::IsFMSAttached() const {
-  HAL_ControlWord controlWord;
-  UpdateControlWord(false, controlWord);
+  HAL_ControlWord controlWord = GetControlWord();
   return controlWord.fmsAttached;
 }
 
@@ -529,28 +959,41 @@ bool DriverStation::IsBrownedOut() const {
 }
 
 std::string DriverStation::GetGameSpecificMessage() const {
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_matchInfo->gameSpecificMessage;
+  return GetGameSpecificMessageRef();
 }
 
-std::string DriverStation::GetEventName() const {
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_matchInfo->eventName;
+std::string DriverStation::GetEventName() const { return GetEventNameRef(); }
+
+/**
+ * Returns the game specific message without copying it.
+ *
+ * The reference stays valid for the life of the program, but a later call
+ * returns a different one once the DS sends a new message.
+ */
+llvm::StringRef DriverStation::GetGameSpecificMessageRef() const {
+  return m_matchInfo.load(std::memory_order_acquire)->gameSpecificMessage;
+}
+
+/**
+ * Returns the event name without copying it.
+ *
+ * The reference stays valid for the life of the program, but a later call
+ * returns a different one once the DS sends a new event name.
+ */
+llvm::StringRef DriverStation::GetEventNameRef() const {
+  return m_matchInfo.load(std::memory_order_acquire)->eventName;
 }
 
 DriverStation::MatchType DriverStation::GetMatchType() const {
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_matchInfo->matchType;
+  return m_matchInfo.load(std::memory_order_acquire)->matchType;
 }
 
 int DriverStation::GetMatchNumber() const {
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_matchInfo->matchNumber;
+  return m_matchInfo.load(std::memory_order_acquire)->matchNumber;
 }
 
 int DriverStation::GetReplayNumber() const {
-  std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-  return m_matchInfo->replayNumber;
+  return m_matchInfo.load(std::memory_order_acquire)->replayNumber;
 }
 
 /**
@@ -712,30 +1155,23 @@ void DriverStation::SendMatchData() {
       break;
   }
 
-  MatchInfoData tmpDataStore;
-  {
-    std::lock_guard<wpi::mutex> lock(m_cacheDataMutex);
-    tmpDataStore = *m_matchInfo;
-  }
-
   m_matchDataSender->alliance.SetBoolean(isRedAlliance);
   m_matchDataSender->station.SetDouble(stationNumber);
-  m_matchDataSender->eventName.SetString(tmpDataStore.eventName);
-  m_matchDataSender->gameSpecificMessage.SetString(
-      tmpDataStore.gameSpecificMessage);
-  m_matchDataSender->matchNumber.SetDouble(tmpDataStore.matchNumber);
-  m_matchDataSender->replayNumber.SetDouble(tmpDataStore.replayNumber);
-  m_matchDataSender->matchType.SetDouble(
-      static_cast<int>(tmpDataStore.matchType));
-
-  HAL_ControlWord ctlWord;
-  {
-    // Valid, as in other places we guarentee ctlWord >= int32
-    std::lock_guard<wpi::mutex> lock(m_controlWordMutex);
-    ctlWord = m_controlWordCache;
+
+  const MatchInfoData* matchInfo = m_matchInfo.load(std::memory_order_relaxed);
+  if (matchInfo != m_sentMatchInfo) {
+    m_matchDataSender->eventName.SetString(matchInfo->eventName);
+    m_matchDataSender->gameSpecificMessage.SetString(
+        matchInfo->gameSpecificMessage);
+    m_matchDataSender->matchNumber.SetDouble(matchInfo->matchNumber);
+    m_matchDataSender->replayNumber.SetDouble(matchInfo->replayNumber);
+    m_matchDataSender->matchType.SetDouble(
+        static_cast<int>(matchInfo->matchType));
+    m_sentMatchInfo = matchInfo;
   }
-  int32_t wordInt = 0;
-  std::memcpy(&wordInt, &ctlWord, sizeof(wordInt));
+
+  int32_t wordInt =
+      static_cast<int32_t>(m_controlWord.load(std::memory_order_acquire));
   m_matchDataSender->controlWord.SetDouble(wordInt);
 }
 
@@ -746,6 +1182,7 @@ void DriverStation::SendMatchData() {
  * the data will be copied from the DS polling loop.
  */
 void DriverStation::GetData() {
+  FRC_TRACE_SCOPE("DriverStation::GetData");
   // Get the status of all of the joysticks, and save to the cache
   for (uint8_t stick = 0; stick < kJoystickPorts; stick++) {
     HAL_GetJoystickAxes(stick, &m_joystickAxesCache[stick]);
@@ -753,22 +1190,18 @@ void DriverStation::GetData() {
     HAL_GetJoystickButtons(stick, &m_joystickButtonsCache[stick]);
     HAL_GetJoystickDescriptor(stick, &m_joystickDescriptorCache[stick]);
   }
-  // Grab match specific data
-  HAL_MatchInfo matchInfo;
-  auto status = HAL_GetMatchInfo(&matchInfo);
-  if (status == 0) {
-    m_matchInfoCache->eventName = matchInfo.eventName;
-    m_matchInfoCache->matchNumber = matchInfo.matchNumber;
-    m_matchInfoCache->replayNumber = matchInfo.replayNumber;
-    m_matchInfoCache->matchType =
-        static_cast<DriverStation::MatchType>(matchInfo.matchType);
-    m_matchInfoCache->gameSpecificMessage = matchInfo.gameSpecificMessage;
-  }
-  HAL_FreeMatchInfo(&matchInfo);
+  UpdateMatchInfo();
 
-  // Force a control word update, to make sure the data is the newest.
-  HAL_ControlWord controlWord;
-  UpdateControlWord(true, controlWord);
+  // Publish the control word of this packet
+  UpdateControlWord();
+  HAL_ControlWord controlWord = GetControlWord();
+
+  PublishJoystickState(controlWord);
+  if (detail::IsDeviceLoggingEnabled()) {
+    m_deviceLog->Log(m_controlWord.load(std::memory_order_relaxed),
+                     m_joystickAxesCache.get(), m_joystickPOVsCache.get(),
+                     m_joystickButtonsCache.get());
+  }
 
   {
     // Obtain a write lock on the data, swap the cached data into the
@@ -789,7 +1222,6 @@ void DriverStation::GetData() {
     m_joystickPOVs.swap(m_joystickPOVsCache);
     m_joystickButtons.swap(m_joystickButtonsCache);
     m_joystickDescriptor.swap(m_joystickDescriptorCache);
-    m_matchInfo.swap(m_matchInfoCache);
   }
 
   {
@@ -802,6 +1234,31 @@ void DriverStation::GetData() {
   SendMatchData();
 }
 
+/**
+ * Publish the joystick data just read into the cache arrays as the newest
+ * packet. Only called from the DS thread.
+ */
+void DriverStation::PublishJoystickState(const HAL_ControlWord& controlWord) {
+  uint64_t packet = m_packetNumber.load(std::memory_order_relaxed) + 1;
+  auto& slot = m_joystickStates[packet % kPacketHistorySize];
+  slot.sequence.store(2 * packet - 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  auto& state = slot.state;
+  state.packetNumber = packet;
+  state.timestamp = Timer::GetFPGATimestamp();
+  state.controlWord = controlWord;
+  std::copy(&m_joystickAxesCache[0], &m_joystickAxesCache[kJoystickPorts],
+            state.axes.begin());
+  std::copy(&m_joystickPOVsCache[0], &m_joystickPOVsCache[kJoystickPorts],
+            state.povs.begin());
+  std::copy(&m_joystickButtonsCache[0],
+            &m_joystickButtonsCache[kJoystickPorts], state.buttons.begin());
+
+  slot.sequence.store(2 * packet, std::memory_order_release);
+  m_packetNumber.store(packet, std::memory_order_release);
+}
+
 /**
  * DriverStation constructor.
  *
@@ -814,16 +1271,18 @@ DriverStation::DriverStation() {
   m_joystickButtons = std::make_unique<HAL_JoystickButtons[]>(kJoystickPorts);
   m_joystickDescriptor =
       std::make_unique<HAL_JoystickDescriptor[]>(kJoystickPorts);
-  m_matchInfo = std::make_unique<MatchInfoData>();
   m_joystickAxesCache = std::make_unique<HAL_JoystickAxes[]>(kJoystickPorts);
   m_joystickPOVsCache = std::make_unique<HAL_JoystickPOVs[]>(kJoystickPorts);
   m_joystickButtonsCache =
       std::make_unique<HAL_JoystickButtons[]>(kJoystickPorts);
   m_joystickDescriptorCache =
       std::make_unique<HAL_JoystickDescriptor[]>(kJoystickPorts);
-  m_matchInfoCache = std::make_unique<MatchInfoData>();
+  m_matchInfoHistory.emplace_back(std::make_unique<MatchInfoData>());
+  m_matchInfo = m_matchInfoHistory.back().get();
+  std::memset(&m_lastMatchInfo, 0, sizeof(m_lastMatchInfo));
 
   m_matchDataSender = std::make_unique<MatchDataSender>();
+  m_deviceLog = std::make_unique<DriverStationLog>();
 
   // All joysticks should default to having zero axes, povs and buttons, so
   // uninitialized memory doesn't get sent to speed controllers.
@@ -845,7 +1304,17 @@ DriverStation::DriverStation() {
     m_joystickButtonsPressed[i] = 0;
     m_joystickButtonsReleased[i] = 0;
   }
+  for (auto& slot : m_joystickStates) {
+    std::memset(&slot.state.controlWord, 0, sizeof(slot.state.controlWord));
+    for (int i = 0; i < kJoystickPorts; i++) {
+      slot.state.axes[i].count = 0;
+      slot.state.povs[i].count = 0;
+      slot.state.buttons[i].count = 0;
+      slot.state.buttons[i].buttons = 0;
+    }
+  }
 
+  UpdateControlWord();
   m_dsThread = std::thread(&DriverStation::Run, this);
 }
 
@@ -878,7 +1347,11 @@ void DriverStation::Run() {
   m_isRunning = true;
   int safetyCounter = 0;
   while (m_isRunning) {
-    HAL_WaitForDSData();
+    if (!HAL_WaitForDSDataTimeout(kControlWordRefreshTimeout)) {
+      // No packet; the DS may have disconnected
+      UpdateControlWord();
+      continue;
+    }
     GetData();
 
     if (IsDisabled()) safetyCounter = 0;
@@ -895,23 +1368,61 @@ void DriverStation::Run() {
 }
 
 /**
- * Gets ControlWord data from the cache. If 50ms has passed, or the force
- * parameter is set, the cached data is updated. Otherwise the data is just
- * copied from the cache.
- *
- * @param force True to force an update to the cache, otherwise update if 50ms
- *              have passed.
- * @param controlWord Structure to put the return control word data into.
+ * Reads the match info from the HAL and publishes a new snapshot of it if it
+ * changed. The HAL call does not allocate, so only a change does.
  */
-void DriverStation::UpdateControlWord(bool force,
-                                      HAL_ControlWord& controlWord) const {
-  auto now = std::chrono::steady_clock::now();
-  std::lock_guard<wpi::mutex> lock(m_controlWordMutex);
-  // Update every 50 ms or on force.
-  if ((now - m_lastControlWordUpdate > std::chrono::milliseconds(50)) ||
-      force) {
-    HAL_GetControlWord(&m_controlWordCache);
-    m_lastControlWordUpdate = now;
+void DriverStation::UpdateMatchInfo() {
+  HAL_InlineMatchInfo info;
+  if (HAL_GetInlineMatchInfo(&info) != 0) return;
+
+  const HAL_InlineMatchInfo& last = m_lastMatchInfo;
+  if (info.matchType == last.matchType &&
+      info.matchNumber == last.matchNumber &&
+      info.replayNumber == last.replayNumber &&
+      std::strcmp(info.eventName, last.eventName) == 0 &&
+      info.gameSpecificMessageSize == last.gameSpecificMessageSize &&
+      std::memcmp(info.gameSpecificMessage, last.gameSpecificMessage,
+                  info.gameSpecificMessageSize) == 0) {
+    return;
   }
-  controlWord = m_controlWordCache;
+  m_lastMatchInfo = info;
+
+  auto matchInfo = std::make_unique<MatchInfoData>();
+  matchInfo->eventName = info.eventName;
+  matchInfo->gameSpecificMessage.assign(info.gameSpecificMessage,
+                                        info.gameSpecificMessageSize);
+  matchInfo->matchNumber = info.matchNumber;
+  matchInfo->replayNumber = info.replayNumber;
+  matchInfo->matchType = static_cast<DriverStation::MatchType>(info.matchType);
+  m_matchInfo.store(matchInfo.get(), std::memory_order_release);
+  m_matchInfoHistory.emplace_back(std::move(matchInfo));
+}
+
+static_assert(sizeof(HAL_ControlWord) == sizeof(uint32_t),
+              "HAL_ControlWord must fit the atomic control word");
+
+/**
+ * Reads the control word from the HAL and publishes it for the mode queries.
+ *
+ * Called by the DS thread for every packet, and when packets stop arriving so
+ * a disconnected DS is still noticed.
+ */
+void DriverStation::UpdateControlWord() {
+  HAL_ControlWord controlWord;
+  std::memset(&controlWord, 0, sizeof(controlWord));
+  HAL_GetControlWord(&controlWord);
+  uint32_t word;
+  std::memcpy(&word, &controlWord, sizeof(word));
+  m_controlWord.store(word, std::memory_order_release);
+}
+
+/**
+ * Returns the latest control word published by the DS thread. This is a
+ * single atomic load, so the mode queries never block.
+ */
+HAL_ControlWord DriverStation::GetControlWord() const {
+  uint32_t word = m_controlWord.load(std::memory_order_acquire);
+  HAL_ControlWord controlWord;
+  std::memcpy(&controlWord, &word, sizeof(controlWord));
+  return controlWord;
 }
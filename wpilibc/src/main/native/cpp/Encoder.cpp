@@ -7,6 +7,8 @@
 
 #include "Encoder.h"
 
+#include <string>
+
 #include <HAL/HAL.h>
 
 #include "DigitalInput.h"
@@ -46,6 +48,11 @@ void Encoder::InitEncoder(bool reverseDirection, EncodingType encodingType) {
   HAL_Report(HALUsageReporting::kResourceType_Encoder, GetFPGAIndex(),
              encodingType);
   SetName("Encoder", m_aSource->GetChannel());
+  std::string logName =
+      ("Encoder/" + llvm::Twine(m_aSource->GetChannel())).str();
+  m_countLog.Init(DeviceLogClass::kEncoder, logName + "/Count");
+  m_distanceLog.Init(DeviceLogClass::kEncoder, logName + "/Distance");
+  m_rateLog.Init(DeviceLogClass::kEncoder, logName + "/Rate");
 }
 
 /**
@@ -186,6 +193,7 @@ int Encoder::GetEncodingScale() const {
  */
 int Encoder::GetRaw() const {
   if (StatusIsFatal()) return 0;
+  if (ReadCache::IsCaching()) return GetCachedSnapshot().raw;
   int32_t status = 0;
   int value = HAL_GetEncoderRaw(m_encoder, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -203,9 +211,15 @@ int Encoder::GetRaw() const {
  */
 int Encoder::Get() const {
   if (StatusIsFatal()) return 0;
-  int32_t status = 0;
-  int value = HAL_GetEncoder(m_encoder, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  int value;
+  if (ReadCache::IsCaching()) {
+    value = GetCachedSnapshot().count;
+  } else {
+    int32_t status = 0;
+    value = HAL_GetEncoder(m_encoder, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  }
+  m_countLog.Log(static_cast<int64_t>(value));
   return value;
 }
 
@@ -216,6 +230,7 @@ int Encoder::Get() const {
  */
 void Encoder::Reset() {
   if (StatusIsFatal()) return;
+  InvalidateReadCache();
   int32_t status = 0;
   HAL_ResetEncoder(m_encoder, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -234,6 +249,7 @@ void Encoder::Reset() {
  */
 double Encoder::GetPeriod() const {
   if (StatusIsFatal()) return 0.0;
+  if (ReadCache::IsCaching()) return GetCachedSnapshot().period;
   int32_t status = 0;
   double value = HAL_GetEncoderPeriod(m_encoder, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -258,6 +274,7 @@ double Encoder::GetPeriod() const {
  */
 void Encoder::SetMaxPeriod(double maxPeriod) {
   if (StatusIsFatal()) return;
+  InvalidateReadCache();
   int32_t status = 0;
   HAL_SetEncoderMaxPeriod(m_encoder, maxPeriod, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -274,6 +291,7 @@ void Encoder::SetMaxPeriod(double maxPeriod) {
  */
 bool Encoder::GetStopped() const {
   if (StatusIsFatal()) return true;
+  if (ReadCache::IsCaching()) return GetCachedSnapshot().stopped;
   int32_t status = 0;
   bool value = HAL_GetEncoderStopped(m_encoder, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -287,12 +305,30 @@ bool Encoder::GetStopped() const {
  */
 bool Encoder::GetDirection() const {
   if (StatusIsFatal()) return false;
+  if (ReadCache::IsCaching()) return GetCachedSnapshot().direction;
   int32_t status = 0;
   bool value = HAL_GetEncoderDirection(m_encoder, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
   return value;
 }
 
+// While reads are cached, every value but the rate comes from one snapshot
+// latched each loop, so reading several costs one HAL call
+HAL_EncoderSnapshot Encoder::GetCachedSnapshot() const {
+  return m_snapshotCache.Get([=] {
+    HAL_EncoderSnapshot snapshot{};
+    int32_t status = 0;
+    HAL_GetEncoderSnapshot(m_encoder, &snapshot, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return snapshot;
+  });
+}
+
+void Encoder::InvalidateReadCache() {
+  m_snapshotCache.Invalidate();
+  m_rateCache.Invalidate();
+}
+
 /**
  * The scale needed to convert a raw counter value into a number of encoder
  * pulses.
@@ -305,6 +341,34 @@ double Encoder::DecodingScaleFactor() const {
   return val;
 }
 
+/**
+ * Get the count, distance, rate, direction and stopped state of the encoder
+ * together.
+ *
+ * The values are read from the FPGA at the same instant and are stamped with
+ * the FPGA time of the read, which makes them suitable for latency
+ * compensation. This is also cheaper than calling each getter in turn.
+ *
+ * @return The state of the encoder.
+ */
+Encoder::Snapshot Encoder::GetSnapshot() const {
+  Snapshot snapshot{0, 0.0, 0.0, 0.0, false, false, 0.0};
+  if (StatusIsFatal()) return snapshot;
+  int32_t status = 0;
+  HAL_EncoderSnapshot halSnapshot;
+  HAL_GetEncoderSnapshot(m_encoder, &halSnapshot, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  if (status != 0) return snapshot;
+  snapshot.count = halSnapshot.count;
+  snapshot.distance = halSnapshot.distance;
+  snapshot.rate = halSnapshot.rate;
+  snapshot.period = halSnapshot.period;
+  snapshot.direction = halSnapshot.direction;
+  snapshot.stopped = halSnapshot.stopped;
+  snapshot.timestamp = halSnapshot.timestamp * 1.0e-6;
+  return snapshot;
+}
+
 /**
  * Get the distance the robot has driven since the last reset.
  *
@@ -313,9 +377,15 @@ double Encoder::DecodingScaleFactor() const {
  */
 double Encoder::GetDistance() const {
   if (StatusIsFatal()) return 0.0;
-  int32_t status = 0;
-  double value = HAL_GetEncoderDistance(m_encoder, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  double value;
+  if (ReadCache::IsCaching()) {
+    value = GetCachedSnapshot().distance;
+  } else {
+    int32_t status = 0;
+    value = HAL_GetEncoderDistance(m_encoder, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  }
+  m_distanceLog.Log(value);
   return value;
 }
 
@@ -329,9 +399,14 @@ double Encoder::GetDistance() const {
  */
 double Encoder::GetRate() const {
   if (StatusIsFatal()) return 0.0;
-  int32_t status = 0;
-  double value = HAL_GetEncoderRate(m_encoder, &status);
-  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  // Not from the snapshot, whose rate doesn't use the velocity estimator
+  double value = m_rateCache.Get([=] {
+    int32_t status = 0;
+    double rate = HAL_GetEncoderRate(m_encoder, &status);
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+    return rate;
+  });
+  m_rateLog.Log(value);
   return value;
 }
 
@@ -343,6 +418,7 @@ double Encoder::GetRate() const {
  */
 void Encoder::SetMinRate(double minRate) {
   if (StatusIsFatal()) return;
+  InvalidateReadCache();
   int32_t status = 0;
   HAL_SetEncoderMinRate(m_encoder, minRate, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -367,6 +443,7 @@ void Encoder::SetMinRate(double minRate) {
  */
 void Encoder::SetDistancePerPulse(double distancePerPulse) {
   if (StatusIsFatal()) return;
+  InvalidateReadCache();
   int32_t status = 0;
   HAL_SetEncoderDistancePerPulse(m_encoder, distancePerPulse, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -395,6 +472,7 @@ double Encoder::GetDistancePerPulse() const {
  */
 void Encoder::SetReverseDirection(bool reverseDirection) {
   if (StatusIsFatal()) return;
+  InvalidateReadCache();
   int32_t status = 0;
   HAL_SetEncoderReverseDirection(m_encoder, reverseDirection, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -416,6 +494,7 @@ void Encoder::SetSamplesToAverage(int samplesToAverage) {
         "Average counter values must be between 1 and 127");
     return;
   }
+  InvalidateReadCache();
   int32_t status = 0;
   HAL_SetEncoderSamplesToAverage(m_encoder, samplesToAverage, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -437,6 +516,60 @@ int Encoder::GetSamplesToAverage() const {
   return result;
 }
 
+/**
+ * Select how GetRate() is computed.
+ *
+ * kPeriod uses the count period measured by the FPGA. The other estimators
+ * sample the count at a fixed rate in the background (see
+ * SetVelocityUpdatePeriod()) and fit the latest windowSize samples, which is
+ * much less noisy at low speed:
+ * - kTimedWindow differences the first and last sample of the window.
+ * - kLeastSquares fits a line to the whole window.
+ * - kAdaptiveWindow shrinks the window as the speed rises, for low noise at
+ *   low speed without lag at high speed.
+ *
+ * @param estimator  The estimator.
+ * @param windowSize The number of samples to fit, from 2 to 64.
+ */
+void Encoder::SetVelocityEstimator(VelocityEstimator estimator,
+                                   int windowSize) {
+  if (StatusIsFatal()) return;
+  InvalidateReadCache();
+  int32_t status = 0;
+  HAL_SetEncoderVelocityEstimator(
+      m_encoder, static_cast<HAL_EncoderVelocityEstimatorType>(estimator),
+      windowSize, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Get the acceleration estimated by the velocity estimator.
+ *
+ * @return The acceleration in distance per second squared, or 0 when the
+ *         velocity estimator is kPeriod.
+ */
+double Encoder::GetAcceleration() const {
+  if (StatusIsFatal()) return 0.0;
+  int32_t status = 0;
+  double velocity = 0.0;
+  double acceleration = 0.0;
+  HAL_GetEncoderVelocityEstimate(m_encoder, &velocity, &acceleration, &status);
+  if (status == INCOMPATIBLE_STATE) return 0.0;
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return acceleration;
+}
+
+/**
+ * Set the time between the count samples of every velocity estimator.
+ *
+ * @param period The period in seconds, from 0.001 to 0.1.
+ */
+void Encoder::SetVelocityUpdatePeriod(double period) {
+  int32_t status = 0;
+  HAL_SetEncoderVelocityUpdatePeriod(period, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
 /**
  * Implement the PIDSource interface.
  *
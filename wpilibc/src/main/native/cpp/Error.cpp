@@ -7,7 +7,10 @@
 
 #include "Error.h"
 
+#include <algorithm>
+
 #include <llvm/Path.h>
+#include <llvm/SmallString.h>
 
 #include "DriverStation.h"
 #include "Timer.h"
@@ -16,13 +19,16 @@
 using namespace frc;
 
 void Error::Clone(const Error& error) {
-  m_code = error.m_code;
+  m_code = error.m_code.load();
   m_message = error.m_message;
   m_filename = error.m_filename;
   m_function = error.m_function;
   m_lineNumber = error.m_lineNumber;
   m_originatingObject = error.m_originatingObject;
   m_timestamp = error.m_timestamp;
+  m_stackFrameCount = error.m_stackFrameCount;
+  std::copy(error.m_stackFrames, error.m_stackFrames + m_stackFrameCount,
+            m_stackFrames);
 }
 
 Error::Code Error::GetCode() const { return m_code; }
@@ -41,34 +47,52 @@ const ErrorBase* Error::GetOriginatingObject() const {
 
 double Error::GetTimestamp() const { return m_timestamp; }
 
+/**
+ * Return the stack trace of where the error was last reported.
+ *
+ * Only the return addresses are captured when the error is set; they are
+ * symbolized by this call.
+ */
+std::string Error::GetStackTrace() const {
+  return frc::GetStackTrace(m_stackFrames, m_stackFrameCount);
+}
+
 void Error::Set(Code code, const llvm::Twine& contextMessage,
                 llvm::StringRef filename, llvm::StringRef function,
                 int lineNumber, const ErrorBase* originatingObject) {
   bool report = true;
+  double now = GetTime();
 
-  if (code == m_code && GetTime() - m_timestamp < 1) {
+  if (code == m_code && now - m_timestamp < 1) {
     report = false;
   }
 
+  // Assign in place so a repeated error reuses the string storage
   m_code = code;
-  m_message = contextMessage.str();
-  m_filename = filename;
-  m_function = function;
+  llvm::SmallString<128> buf;
+  auto message = contextMessage.toStringRef(buf);
+  m_message.assign(message.data(), message.size());
+  m_filename.assign(filename.data(), filename.size());
+  m_function.assign(function.data(), function.size());
   m_lineNumber = lineNumber;
   m_originatingObject = originatingObject;
 
   if (report) {
-    m_timestamp = GetTime();
+    m_timestamp = now;
+    // Only walk the stack here, leaving out CaptureStackTrace(), this function
+    // and the ErrorBase setter; the thread that sends the report symbolizes it
+    m_stackFrameCount = CaptureStackTrace(m_stackFrames, kMaxStackFrames, 3);
     Report();
   }
 }
 
 void Error::Report() {
-  DriverStation::ReportError(
+  // Errors are often raised from control loops, so don't wait on the DS
+  DriverStation::ReportErrorAsync(
       true, m_code, m_message,
       m_function + llvm::Twine(" [") + llvm::sys::path::filename(m_filename) +
           llvm::Twine(':') + llvm::Twine(m_lineNumber) + llvm::Twine(']'),
-      GetStackTrace(4));
+      m_stackFrames, m_stackFrameCount);
 }
 
 void Error::Clear() {
@@ -79,4 +103,5 @@ void Error::Clear() {
   m_lineNumber = 0;
   m_originatingObject = nullptr;
   m_timestamp = 0.0;
+  m_stackFrameCount = 0;
 }
@@ -26,6 +26,20 @@ Error ErrorBase::_globalError;
 
 ErrorBase::ErrorBase() { HAL_Initialize(500, 0); }
 
+/**
+ * Copy an error to the global error if there is not one already set.
+ *
+ * The global error is checked before taking its mutex, so errors on objects
+ * only contend for the mutex until the first one is recorded.
+ */
+void ErrorBase::CloneToGlobalError(const Error& error) {
+  if (_globalError.GetCode() != 0) return;
+  std::lock_guard<wpi::mutex> mutex(_globalErrorMutex);
+  if (_globalError.GetCode() == 0) {
+    _globalError.Clone(error);
+  }
+}
+
 /**
  * @brief Retrieve the current error.
  *
@@ -67,10 +81,7 @@ void ErrorBase::SetErrnoError(const llvm::Twine& contextMessage,
               this);
 
   // Update the global error if there is not one already set.
-  std::lock_guard<wpi::mutex> mutex(_globalErrorMutex);
-  if (_globalError.GetCode() == 0) {
-    _globalError.Clone(m_error);
-  }
+  CloneToGlobalError(m_error);
 }
 
 /**
@@ -93,10 +104,7 @@ void ErrorBase::SetImaqError(int success, const llvm::Twine& contextMessage,
                 function, lineNumber, this);
 
     // Update the global error if there is not one already set.
-    std::lock_guard<wpi::mutex> mutex(_globalErrorMutex);
-    if (_globalError.GetCode() == 0) {
-      _globalError.Clone(m_error);
-    }
+    CloneToGlobalError(m_error);
   }
 }
 
@@ -118,10 +126,7 @@ void ErrorBase::SetError(Error::Code code, const llvm::Twine& contextMessage,
     m_error.Set(code, contextMessage, filename, function, lineNumber, this);
 
     // Update the global error if there is not one already set.
-    std::lock_guard<wpi::mutex> mutex(_globalErrorMutex);
-    if (_globalError.GetCode() == 0) {
-      _globalError.Clone(m_error);
-    }
+    CloneToGlobalError(m_error);
   }
 }
 
@@ -153,10 +158,7 @@ void ErrorBase::SetErrorRange(Error::Code code, int32_t minRange,
                 filename, function, lineNumber, this);
 
     // Update the global error if there is not one already set.
-    std::lock_guard<wpi::mutex> mutex(_globalErrorMutex);
-    if (_globalError.GetCode() == 0) {
-      _globalError.Clone(m_error);
-    }
+    CloneToGlobalError(m_error);
   }
 }
 
@@ -178,10 +180,7 @@ void ErrorBase::SetWPIError(const llvm::Twine& errorMessage, Error::Code code,
               lineNumber, this);
 
   // Update the global error if there is not one already set.
-  std::lock_guard<wpi::mutex> mutex(_globalErrorMutex);
-  if (_globalError.GetCode() == 0) {
-    _globalError.Clone(m_error);
-  }
+  CloneToGlobalError(m_error);
 }
 
 void ErrorBase::CloneError(const ErrorBase& rhs) const {
@@ -0,0 +1,194 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Executor.h"
+
+#include <algorithm>
+#include <exception>
+
+#include "DriverStation.h"
+#include "Threads.h"
+
+using namespace frc;
+
+static std::atomic<int> reservedCores{Executor::kDefaultReservedCores};
+
+static wpi::mutex mainLoopMutex;
+static std::vector<std::function<void()>> mainLoopTasks;
+
+// The executor and worker index of the current thread, if it is a worker
+static thread_local Executor* currentExecutor = nullptr;
+static thread_local size_t currentWorker = 0;
+
+/**
+ * Returns the shared executor, creating it if it does not exist.
+ *
+ * It has one worker per core less the cores reserved for real-time threads,
+ * and at least one.
+ */
+Executor& Executor::GetInstance() {
+  static Executor instance(std::max(
+      1, static_cast<int>(std::thread::hardware_concurrency()) -
+             reservedCores.load()));
+  return instance;
+}
+
+/**
+ * Sets the number of cores left to the robot's real-time threads. It must be
+ * called before the first use of GetInstance() to take effect.
+ *
+ * @param cores The number of cores the shared executor leaves free.
+ */
+void Executor::SetReservedCores(int cores) { reservedCores = cores; }
+
+/**
+ * Creates a pool with its own workers.
+ *
+ * @param threads The number of worker threads.
+ */
+Executor::Executor(int threads) {
+  for (int i = 0; i < std::max(threads, 1); i++) {
+    m_workers.emplace_back(new Worker);
+  }
+  for (size_t i = 0; i < m_workers.size(); i++) {
+    auto& thread = m_workers[i]->thread;
+    thread = std::thread(&Executor::WorkerMain, this, i);
+    // Threads inherit the scheduling of their creator, which may be real-time
+    SetThreadPriority(thread, false, 0);
+  }
+}
+
+/**
+ * Stops the workers once their current tasks return. Queued tasks are
+ * dropped.
+ */
+Executor::~Executor() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_sleepMutex);
+    m_stop = true;
+  }
+  m_sleepCond.notify_all();
+  for (auto& worker : m_workers) worker->thread.join();
+}
+
+/**
+ * Returns the number of worker threads.
+ */
+int Executor::GetThreadCount() const {
+  return static_cast<int>(m_workers.size());
+}
+
+/**
+ * Runs a task in the pool, without a result.
+ *
+ * @param task The task; it may be called on any worker. If it throws, the
+ *             exception is reported and the worker goes on to the next task.
+ */
+void Executor::Post(std::function<void()> task) {
+  // Work posted by a worker stays with it unless another is idle
+  size_t index = currentExecutor == this
+                     ? currentWorker
+                     : m_nextWorker.fetch_add(1) % m_workers.size();
+  // Counted before it's queued, so m_pending never falls below the number of
+  // queued tasks
+  {
+    std::lock_guard<wpi::mutex> lock(m_sleepMutex);
+    m_pending++;
+  }
+  {
+    std::lock_guard<wpi::mutex> lock(m_workers[index]->mutex);
+    m_workers[index]->tasks.emplace_back(std::move(task));
+  }
+  m_sleepCond.notify_one();
+}
+
+/**
+ * Queues a task for the robot's main loop, to run in the next call to
+ * RunMainLoopTasks().
+ *
+ * @param task The task; it may be queued from any thread.
+ */
+void Executor::PostToMainLoop(std::function<void()> task) {
+  std::lock_guard<wpi::mutex> lock(mainLoopMutex);
+  mainLoopTasks.emplace_back(std::move(task));
+}
+
+/**
+ * Runs the tasks queued by PostToMainLoop() and Future::ThenOnMainLoop(), in
+ * the order they were queued.
+ *
+ * IterativeRobotBase calls this at the start of each loop; other robot loops
+ * should call it periodically.
+ */
+void Executor::RunMainLoopTasks() {
+  // Swapping keeps the buffers of both vectors, so steady use doesn't allocate
+  static std::vector<std::function<void()>> tasks;
+  {
+    std::lock_guard<wpi::mutex> lock(mainLoopMutex);
+    if (mainLoopTasks.empty()) return;
+    tasks.swap(mainLoopTasks);
+  }
+  for (auto& task : tasks) task();
+  tasks.clear();
+}
+
+void Executor::WorkerMain(size_t index) {
+  currentExecutor = this;
+  currentWorker = index;
+
+  std::function<void()> task;
+  for (;;) {
+    {
+      std::unique_lock<wpi::mutex> lock(m_sleepMutex);
+      m_sleepCond.wait(lock, [&] { return m_stop || m_pending > 0; });
+      if (m_stop) return;
+    }
+    if (!TryPop(index, &task) && !TrySteal(index, &task)) {
+      // The task is still being queued, or another worker took it first
+      std::this_thread::yield();
+      continue;
+    }
+    {
+      std::lock_guard<wpi::mutex> lock(m_sleepMutex);
+      m_pending--;
+    }
+    // Submit() and Then() tasks store their exceptions in their Futures; one
+    // escaping a posted task is reported rather than ending the worker
+    try {
+      task();
+    } catch (const std::exception& e) {
+      DriverStation::ReportError(
+          llvm::Twine("Unhandled exception in Executor task: ") + e.what());
+    } catch (...) {
+      DriverStation::ReportError("Unhandled exception in Executor task");
+    }
+    task = nullptr;
+  }
+}
+
+// Take the newest task of the worker's own queue
+bool Executor::TryPop(size_t index, std::function<void()>* task) {
+  Worker& worker = *m_workers[index];
+  std::lock_guard<wpi::mutex> lock(worker.mutex);
+  if (worker.tasks.empty()) return false;
+  *task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+// Take the oldest task of another worker's queue
+bool Executor::TrySteal(size_t thief, std::function<void()>* task) {
+  for (size_t i = 1; i < m_workers.size(); i++) {
+    Worker& worker = *m_workers[(thief + i) % m_workers.size()];
+    std::lock_guard<wpi::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) continue;
+    *task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,57 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "FeedforwardModel.h"
+
+#include <cmath>
+
+using namespace frc;
+
+/**
+ * @param kS The output that overcomes static friction
+ * @param kV The output per unit of velocity
+ * @param kA The output per unit of acceleration
+ */
+SimpleMotorFeedforward::SimpleMotorFeedforward(double kS, double kV, double kA)
+    : m_kS(kS), m_kV(kV), m_kA(kA) {}
+
+double SimpleMotorFeedforward::Calculate(double position, double velocity,
+                                         double acceleration) const {
+  double sign = velocity > 0 ? 1.0 : velocity < 0 ? -1.0 : 0.0;
+  return m_kS * sign + m_kV * velocity + m_kA * acceleration;
+}
+
+/**
+ * @param kS The output that overcomes static friction
+ * @param kG The output that holds the carriage still
+ * @param kV The output per unit of velocity
+ * @param kA The output per unit of acceleration
+ */
+ElevatorFeedforward::ElevatorFeedforward(double kS, double kG, double kV,
+                                         double kA)
+    : SimpleMotorFeedforward(kS, kV, kA), m_kG(kG) {}
+
+double ElevatorFeedforward::Calculate(double position, double velocity,
+                                      double acceleration) const {
+  return m_kG +
+         SimpleMotorFeedforward::Calculate(position, velocity, acceleration);
+}
+
+/**
+ * @param kS   The output that overcomes static friction
+ * @param kCos The output that holds the arm still when horizontal
+ * @param kV   The output per radian per second
+ * @param kA   The output per radian per second squared
+ */
+ArmFeedforward::ArmFeedforward(double kS, double kCos, double kV, double kA)
+    : SimpleMotorFeedforward(kS, kV, kA), m_kCos(kCos) {}
+
+double ArmFeedforward::Calculate(double position, double velocity,
+                                 double acceleration) const {
+  return m_kCos * std::cos(position) +
+         SimpleMotorFeedforward::Calculate(position, velocity, acceleration);
+}
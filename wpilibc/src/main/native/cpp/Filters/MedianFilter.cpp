@@ -0,0 +1,104 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Filters/MedianFilter.h"
+
+#include <cassert>
+#include <iterator>
+
+using namespace frc;
+
+/**
+ * Create a median filter.
+ *
+ * @param source The PIDSource object that is used to get values
+ * @param size   The number of samples in the moving window
+ */
+MedianFilter::MedianFilter(PIDSource& source, int size)
+    : Filter(source), m_window(size), m_size(size) {
+  assert(size > 0);
+}
+
+/**
+ * Create a median filter.
+ *
+ * @param source The PIDSource object that is used to get values
+ * @param size   The number of samples in the moving window
+ */
+MedianFilter::MedianFilter(std::shared_ptr<PIDSource> source, int size)
+    : Filter(source), m_window(size), m_size(size) {
+  assert(size > 0);
+}
+
+/**
+ * Adds a sample to the window, dropping the oldest one if the window is full,
+ * and returns the new median.
+ *
+ * This lets the filter be used on values that don't come from a PIDSource.
+ *
+ * @param input The newest sample
+ * @return The median of the window
+ */
+double MedianFilter::Calculate(double input) {
+  if (m_window.size() == m_size) {
+    double oldest = m_window[m_size - 1];
+    if (!m_lower.empty() && oldest <= *m_lower.rbegin()) {
+      m_lower.erase(m_lower.find(oldest));
+    } else {
+      m_upper.erase(m_upper.find(oldest));
+    }
+  }
+  m_window.push_front(input);
+
+  // Every value in the lower half is no greater than any in the upper half
+  if (!m_upper.empty() && input >= *m_upper.begin()) {
+    m_upper.insert(input);
+  } else {
+    m_lower.insert(input);
+  }
+  Rebalance();
+
+  return Get();
+}
+
+double MedianFilter::Get() const {
+  if (m_lower.empty()) return 0.0;
+
+  if (m_lower.size() > m_upper.size()) return *m_lower.rbegin();
+  return (*m_lower.rbegin() + *m_upper.begin()) / 2.0;
+}
+
+void MedianFilter::Reset() {
+  m_window.reset();
+  m_lower.clear();
+  m_upper.clear();
+}
+
+/**
+ * Calculates the next value of the filter
+ *
+ * @return The filtered value at this step
+ */
+double MedianFilter::PIDGet(PIDSourceType pidSource) {
+  return Calculate(PIDGetSource());
+}
+
+/**
+ * Moves values between the halves so the lower half holds the extra value
+ * when the window is odd, and the halves are the same size otherwise.
+ */
+void MedianFilter::Rebalance() {
+  if (m_lower.size() > m_upper.size() + 1) {
+    auto largest = std::prev(m_lower.end());
+    m_upper.insert(*largest);
+    m_lower.erase(largest);
+  } else if (m_upper.size() > m_lower.size()) {
+    auto smallest = m_upper.begin();
+    m_lower.insert(*smallest);
+    m_upper.erase(smallest);
+  }
+}
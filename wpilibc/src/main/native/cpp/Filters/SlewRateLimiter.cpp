@@ -0,0 +1,72 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Filters/SlewRateLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Timer.h"
+
+using namespace frc;
+
+/**
+ * Create a slew rate limiter.
+ *
+ * @param source    The PIDSource object that is used to get values
+ * @param rateLimit The largest change in value allowed per second
+ */
+SlewRateLimiter::SlewRateLimiter(PIDSource& source, double rateLimit)
+    : Filter(source), m_rateLimit(std::fabs(rateLimit)) {}
+
+/**
+ * Create a slew rate limiter.
+ *
+ * @param source    The PIDSource object that is used to get values
+ * @param rateLimit The largest change in value allowed per second
+ */
+SlewRateLimiter::SlewRateLimiter(std::shared_ptr<PIDSource> source,
+                                 double rateLimit)
+    : Filter(source), m_rateLimit(std::fabs(rateLimit)) {}
+
+/**
+ * Moves the output toward input by no more than the rate limit allows for the
+ * time since the last call.
+ *
+ * This lets the limiter be used on values that don't come from a PIDSource.
+ * The first call after construction or Reset() returns input unchanged.
+ *
+ * @param input The value to follow
+ * @return The rate-limited value
+ */
+double SlewRateLimiter::Calculate(double input) {
+  double now = Timer::GetFPGATimestamp();
+  if (m_prevTime == 0.0) {
+    m_output = input;
+  } else {
+    double maxStep = m_rateLimit * (now - m_prevTime);
+    m_output += std::max(-maxStep, std::min(input - m_output, maxStep));
+  }
+  m_prevTime = now;
+  return m_output;
+}
+
+double SlewRateLimiter::Get() const { return m_output; }
+
+void SlewRateLimiter::Reset() {
+  m_output = 0.0;
+  m_prevTime = 0.0;
+}
+
+/**
+ * Calculates the next value of the filter
+ *
+ * @return The filtered value at this step
+ */
+double SlewRateLimiter::PIDGet(PIDSourceType pidSource) {
+  return Calculate(PIDGetSource());
+}
@@ -0,0 +1,250 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "FusedGyro.h"
+
+#include <cmath>
+
+#include "Encoder.h"
+#include "Notifier.h"
+#include "SmartDashboard/SendableBuilder.h"
+#include "WPIErrors.h"
+#include "interfaces/Accelerometer.h"
+
+using namespace frc;
+
+static constexpr double kRadiansToDegrees = 180.0 / 3.14159265358979323846;
+
+FusedGyro::FusedGyro(Gyro& gyro, FilterType type, double period)
+    : m_gyro(gyro),
+      m_type(type),
+      m_period(period),
+      m_plant({1.0, -period, 0.0, 1.0}, {period, 0.0}, {1.0, 0.0}, {0.0},
+              period) {
+  SetNoise(0.1, 0.01, 2.0);
+}
+
+/**
+ * Construct a gyro whose angle is the robot's tilt about one axis, corrected
+ * by the direction of gravity measured by an accelerometer.
+ *
+ * The gyro's axis must be the tilt axis. Acceleration other than gravity, as
+ * from driving, is seen as tilt, so the time constant or reference noise
+ * should be long enough to ride through it.
+ *
+ * @param gyro          The rate gyro about the tilt axis.
+ * @param accelerometer The accelerometer, with Z up when level.
+ * @param axis          kRoll for tilt about the X axis, kPitch for the Y axis.
+ * @param type          The filter fusing the two.
+ * @param period        The update period in seconds.
+ */
+FusedGyro::FusedGyro(Gyro& gyro, Accelerometer& accelerometer, TiltAxis axis,
+                     FilterType type, double period)
+    : FusedGyro(gyro, type, period) {
+  m_accelerometer = &accelerometer;
+  m_axis = axis;
+  Start();
+}
+
+/**
+ * Construct a gyro whose angle is the robot's heading, corrected by the
+ * heading of a differential drivetrain measured by its encoders.
+ *
+ * Wheel slip is seen as rotation, so the time constant or reference noise
+ * should be long enough to ride through it.
+ *
+ * @param gyro         The yaw rate gyro.
+ * @param leftEncoder  The left side encoder, counting up driving forward.
+ * @param rightEncoder The right side encoder, counting up driving forward.
+ * @param trackWidth   The effective distance between the wheels, in the
+ *                     encoders' distance units.
+ * @param type         The filter fusing the two.
+ * @param period       The update period in seconds.
+ */
+FusedGyro::FusedGyro(Gyro& gyro, Encoder& leftEncoder, Encoder& rightEncoder,
+                     double trackWidth, FilterType type, double period)
+    : FusedGyro(gyro, type, period) {
+  if (trackWidth <= 0.0) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange,
+                               "track width must be positive");
+    trackWidth = 1.0;
+  }
+  m_leftEncoder = &leftEncoder;
+  m_rightEncoder = &rightEncoder;
+  m_trackWidth = trackWidth;
+  Start();
+}
+
+FusedGyro::~FusedGyro() {
+  // Stop the updates before the filter they use is destroyed
+  m_notifier.reset();
+}
+
+/**
+ * Return the fused angle in degrees.
+ *
+ * The heading is continuous like other gyros; the tilt is within -180 to 180.
+ */
+double FusedGyro::GetAngle() const { return m_estimate.Load().angle; }
+
+/**
+ * Return the gyro's rate less the estimated bias, in degrees per second.
+ */
+double FusedGyro::GetRate() const { return m_estimate.Load().rate; }
+
+/**
+ * Return the estimated bias of the gyro's rate, in degrees per second.
+ */
+double FusedGyro::GetBias() const { return m_estimate.Load().bias; }
+
+/**
+ * Reset the angle to the reference.
+ *
+ * The heading is reset to zero. The tilt is reset to the accelerometer's,
+ * since the direction of gravity is absolute.
+ */
+void FusedGyro::Reset() {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_accelerometer == nullptr) {
+    m_headingOffset = 0.0;
+    m_headingOffset = GetReference();
+  }
+  ResetFilter(GetReference());
+}
+
+/**
+ * Calibrate the underlying gyro, then reset the angle to the reference.
+ */
+void FusedGyro::Calibrate() {
+  m_gyro.Calibrate();
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_bias = 0.0;
+  }
+  Reset();
+}
+
+/**
+ * Set the time constant of the complementary filter.
+ *
+ * Over timescales shorter than this the angle follows the gyro, and over
+ * longer ones the reference.
+ *
+ * @param timeConstant The time constant in seconds.
+ */
+void FusedGyro::SetTimeConstant(double timeConstant) {
+  if (timeConstant <= 0.0) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange,
+                               "time constant must be positive");
+    return;
+  }
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_timeConstant = timeConstant;
+}
+
+/**
+ * Set how fast the complementary filter's bias estimate follows the
+ * difference between the gyro and the reference.
+ *
+ * @param gain The bias correction in degrees per second, per degree of error
+ *             per second. Zero disables bias estimation.
+ */
+void FusedGyro::SetBiasGain(double gain) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_biasGain = gain;
+}
+
+/**
+ * Set the noise of the Kalman filter's model, and reset its estimate to the
+ * current angle and bias.
+ *
+ * @param gyroNoise      The standard deviation of the gyro's rate, in degrees
+ *                       per second.
+ * @param biasDrift      The standard deviation of the bias's change, in
+ *                       degrees per second per second.
+ * @param referenceNoise The standard deviation of the reference angle, in
+ *                       degrees.
+ */
+void FusedGyro::SetNoise(double gyroNoise, double biasDrift,
+                         double referenceNoise) {
+  using Filter = KalmanFilter<2, 1, 1>;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_kalman = std::make_unique<Filter>(
+      m_plant,
+      Filter::MakeProcessNoise({{gyroNoise * m_period, biasDrift * m_period}}),
+      Filter::MakeMeasurementNoise({{referenceNoise}}));
+  m_kalman->SetXhat(Vector<2>{m_angle, m_bias});
+}
+
+void FusedGyro::InitSendable(SendableBuilder& builder) {
+  GyroBase::InitSendable(builder);
+  builder.AddDoubleProperty("Bias", [=]() { return GetBias(); }, nullptr);
+}
+
+void FusedGyro::Start() {
+  Reset();
+  m_notifier = std::make_unique<Notifier>(&FusedGyro::Update, this);
+  m_notifier->StartPeriodic(m_period);
+}
+
+// The reference angle in degrees; m_mutex must be held
+double FusedGyro::GetReference() {
+  if (m_accelerometer != nullptr) {
+    double x = m_accelerometer->GetX();
+    double y = m_accelerometer->GetY();
+    double z = m_accelerometer->GetZ();
+    if (m_axis == kRoll) return std::atan2(y, z) * kRadiansToDegrees;
+    return std::atan2(-x, std::sqrt(y * y + z * z)) * kRadiansToDegrees;
+  }
+  double difference =
+      m_rightEncoder->GetDistance() - m_leftEncoder->GetDistance();
+  return difference / m_trackWidth * kRadiansToDegrees - m_headingOffset;
+}
+
+void FusedGyro::Update() {
+  double rate = m_gyro.GetRate();
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  double reference = GetReference();
+
+  if (m_type == kKalman) {
+    Vector<1> u{rate};
+    m_kalman->Predict(u);
+    // Correct towards the nearest equivalent of a wrapped tilt
+    if (m_accelerometer != nullptr) {
+      reference += 360.0 * std::round((m_kalman->Xhat(0) - reference) / 360.0);
+    }
+    m_kalman->Correct(u, Vector<1>{reference});
+    m_angle = m_kalman->Xhat(0);
+    m_bias = m_kalman->Xhat(1);
+  } else {
+    double predicted = m_angle + (rate - m_bias) * m_period;
+    if (m_accelerometer != nullptr) {
+      reference += 360.0 * std::round((predicted - reference) / 360.0);
+    }
+    double alpha = m_timeConstant / (m_timeConstant + m_period);
+    double error = reference - predicted;
+    m_angle = predicted + (1.0 - alpha) * error;
+    // A gyro reading high leaves the prediction ahead of the reference
+    m_bias -= m_biasGain * error * m_period;
+  }
+
+  if (m_accelerometer != nullptr) {
+    m_angle = std::remainder(m_angle, 360.0);
+    if (m_type == kKalman) m_kalman->SetXhat(Vector<2>{m_angle, m_bias});
+  }
+
+  m_estimate.Store(Estimate{m_angle, rate - m_bias, m_bias});
+}
+
+// m_mutex must be held
+void FusedGyro::ResetFilter(double angle) {
+  m_angle = angle;
+  m_kalman->Reset();
+  m_kalman->SetXhat(Vector<2>{m_angle, m_bias});
+  m_estimate.Store(Estimate{m_angle, m_estimate.Load().rate, m_bias});
+}
@@ -78,6 +78,91 @@ double GenericHID::GetRawAxis(int axis) const {
  */
 int GenericHID::GetPOV(int pov) const { return m_ds.GetStickPOV(m_port, pov); }
 
+/**
+ * Copies the inputs of the HID from the latest Driver Station packet.
+ *
+ * This reads the packet once without locking, rather than once for each
+ * input read.
+ *
+ * @return The inputs of the HID, all missing if the port is invalid.
+ */
+GenericHID::Snapshot GenericHID::GetSnapshot() const {
+  Snapshot snapshot{};
+  if (m_port < 0 || m_port >= DriverStation::kJoystickPorts) {
+    wpi_setWPIError(BadJoystickIndex);
+    return snapshot;
+  }
+  auto state = m_ds.GetJoystickState();
+  snapshot.packetNumber = state.packetNumber;
+  snapshot.timestamp = state.timestamp;
+  snapshot.axes = state.axes[m_port];
+  snapshot.povs = state.povs[m_port];
+  snapshot.buttons = state.buttons[m_port];
+  return snapshot;
+}
+
+/**
+ * Get the button value (starting at button 1).
+ *
+ * @param button The button number to be read (starting at 1)
+ * @return The state of the button, or false if the HID doesn't have it.
+ */
+bool GenericHID::Snapshot::GetRawButton(int button) const {
+  if (button < 1 || button > buttons.count || button > 32) return false;
+  return buttons.buttons & 1u << (button - 1);
+}
+
+/**
+ * Whether the button was pressed between an earlier snapshot and this one.
+ * Button indexes begin at 1.
+ *
+ * Presses and releases that both come between the snapshots aren't seen.
+ *
+ * @param previous The earlier snapshot, usually from the previous loop.
+ * @param button   The button index, beginning at 1.
+ * @return Whether the button is down now but wasn't in previous.
+ */
+bool GenericHID::Snapshot::GetRawButtonPressed(const Snapshot& previous,
+                                               int button) const {
+  return GetRawButton(button) && !previous.GetRawButton(button);
+}
+
+/**
+ * Whether the button was released between an earlier snapshot and this one.
+ * Button indexes begin at 1.
+ *
+ * @param previous The earlier snapshot, usually from the previous loop.
+ * @param button   The button index, beginning at 1.
+ * @return Whether the button was down in previous but isn't now.
+ */
+bool GenericHID::Snapshot::GetRawButtonReleased(const Snapshot& previous,
+                                                int button) const {
+  return !GetRawButton(button) && previous.GetRawButton(button);
+}
+
+/**
+ * Get the value of the axis.
+ *
+ * @param axis The axis to read, starting at 0.
+ * @return The value of the axis, or 0 if the HID doesn't have it.
+ */
+double GenericHID::Snapshot::GetRawAxis(int axis) const {
+  if (axis < 0 || axis >= axes.count || axis >= HAL_kMaxJoystickAxes) return 0;
+  return axes.axes[axis];
+}
+
+/**
+ * Get the angle in degrees of a POV on the HID.
+ *
+ * @param pov The index of the POV to read (starting at 0)
+ * @return the angle of the POV in degrees, or -1 if the POV is not pressed or
+ *         the HID doesn't have it.
+ */
+int GenericHID::Snapshot::GetPOV(int pov) const {
+  if (pov < 0 || pov >= povs.count || pov >= HAL_kMaxJoystickPOVs) return -1;
+  return povs.povs[pov];
+}
+
 /**
  * Get the number of axes for the HID.
  *
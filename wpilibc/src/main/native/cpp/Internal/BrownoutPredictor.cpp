@@ -0,0 +1,102 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Internal/BrownoutPredictor.h"
+
+#include <cmath>
+#include <limits>
+
+#include <HAL/Power.h>
+
+using namespace frc;
+using namespace frc::detail;
+
+constexpr double BrownoutPredictor::kBrownoutVoltage;
+
+BrownoutPredictor& BrownoutPredictor::GetInstance() {
+  static BrownoutPredictor instance;
+  return instance;
+}
+
+BrownoutPredictor::~BrownoutPredictor() { Stop(); }
+
+void BrownoutPredictor::Start(double period, double timeConstant) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(period));
+  m_timeConstant = timeConstant;
+  if (m_thread.joinable()) return;
+  m_stop = false;
+  m_prediction = BrownoutPrediction();
+  m_thread = std::thread([=] { ThreadMain(); });
+}
+
+void BrownoutPredictor::Stop() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (!m_thread.joinable()) return;
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+}
+
+BrownoutPrediction BrownoutPredictor::GetPrediction() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_prediction;
+}
+
+void BrownoutPredictor::ThreadMain() {
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  auto deadline = std::chrono::steady_clock::now();
+  while (!m_stop) {
+    if (m_cond.wait_until(lock, deadline) != std::cv_status::timeout) {
+      continue;
+    }
+    auto now = std::chrono::steady_clock::now();
+    // Skip the deadlines missed rather than sampling back to back
+    deadline += m_period;
+    if (deadline < now) deadline = now + m_period;
+    lock.unlock();
+    Sample();
+    lock.lock();
+  }
+}
+
+void BrownoutPredictor::Sample() {
+  int32_t status = 0;
+  HAL_PowerSnapshot power;
+  HAL_GetPowerSnapshot(&power, &status);
+  if (status != 0) return;
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  BrownoutPrediction& prediction = m_prediction;
+  if (prediction.sampleCount == 0) {
+    prediction.voltage = power.vinVoltage;
+    prediction.voltageSlope = 0;
+  } else {
+    double dt = (power.timeStamp - prediction.power.timeStamp) * 1.0e-6;
+    if (dt <= 0) return;
+    double gain =
+        m_timeConstant > 0 ? 1 - std::exp(-dt / m_timeConstant) : 1.0;
+    double lastVoltage = prediction.voltage;
+    prediction.voltage += gain * (power.vinVoltage - lastVoltage);
+    double slope = (prediction.voltage - lastVoltage) / dt;
+    prediction.voltageSlope += gain * (slope - prediction.voltageSlope);
+  }
+  prediction.power = power;
+  prediction.sampleCount++;
+
+  double margin = prediction.voltage - kBrownoutVoltage;
+  if (margin <= 0) {
+    prediction.timeToBrownout = 0;
+  } else if (prediction.voltageSlope < 0) {
+    prediction.timeToBrownout = margin / -prediction.voltageSlope;
+  } else {
+    prediction.timeToBrownout = std::numeric_limits<double>::infinity();
+  }
+}
@@ -0,0 +1,35 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Internal/DeviceLog.h"
+
+using namespace frc;
+
+static constexpr int kDeviceLogClassCount =
+    static_cast<int>(DeviceLogClass::kPowerDistributionPanel) + 1;
+
+static std::atomic<bool> deviceLoggingEnabled{false};
+static std::atomic<uint32_t> deviceLoggingDecimation[kDeviceLogClassCount] = {
+    {1}, {1}, {1}, {1}, {1}, {1}};
+
+bool detail::IsDeviceLoggingEnabled() {
+  return deviceLoggingEnabled.load(std::memory_order_relaxed);
+}
+
+uint32_t detail::GetDeviceLoggingDecimation(DeviceLogClass deviceClass) {
+  return deviceLoggingDecimation[static_cast<int>(deviceClass)].load(
+      std::memory_order_relaxed);
+}
+
+void detail::SetDeviceLoggingEnabled(bool enabled) {
+  deviceLoggingEnabled = enabled;
+}
+
+void detail::SetDeviceLoggingDecimation(DeviceLogClass deviceClass,
+                                        uint32_t decimation) {
+  deviceLoggingDecimation[static_cast<int>(deviceClass)] = decimation;
+}
@@ -0,0 +1,336 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Internal/HealthSampler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
+#include <HAL/CAN.h>
+#include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableInstance.h>
+
+using namespace frc;
+using namespace frc::detail;
+
+constexpr size_t HealthSampler::kWindow;
+
+#ifdef __linux__
+// Reads the first line of a file, without the newline
+static bool ReadLine(const char* path, char* buf, size_t size) {
+  std::FILE* file = std::fopen(path, "r");
+  if (file == nullptr) return false;
+  bool ok = std::fgets(buf, size, file) != nullptr;
+  std::fclose(file);
+  if (ok) buf[std::strcspn(buf, "\n")] = '\0';
+  return ok;
+}
+
+// Reads a value in kB from /proc/meminfo, in bytes
+static uint64_t ReadMemInfo(const char* buf, const char* key) {
+  const char* line = std::strstr(buf, key);
+  if (line == nullptr) return 0;
+  return std::strtoull(line + std::strlen(key), nullptr, 10) * 1024;
+}
+#endif
+
+template <typename T, size_t N>
+static double Average(const static_circular_buffer<T, N>& history) {
+  if (history.size() == 0) return 0;
+  double sum = 0;
+  for (T value : history.first_span()) sum += value;
+  for (T value : history.second_span()) sum += value;
+  return sum / history.size();
+}
+
+template <typename T, size_t N>
+static T Max(const static_circular_buffer<T, N>& history) {
+  T max = 0;
+  for (T value : history.first_span()) max = std::max(max, value);
+  for (T value : history.second_span()) max = std::max(max, value);
+  return max;
+}
+
+template <typename T, size_t N>
+static T Min(const static_circular_buffer<T, N>& history) {
+  if (history.size() == 0) return 0;
+  T min = history[0];
+  for (T value : history.first_span()) min = std::min(min, value);
+  for (T value : history.second_span()) min = std::min(min, value);
+  return min;
+}
+
+HealthSampler& HealthSampler::GetInstance() {
+  static HealthSampler instance;
+  return instance;
+}
+
+HealthSampler::HealthSampler() {
+  m_table = nt::NetworkTableInstance::GetDefault().GetTable("RobotHealth");
+  m_cpuEntry = m_table->GetEntry("CPU");
+  m_averageCPUEntry = m_table->GetEntry("AverageCPU");
+  m_maxCPUEntry = m_table->GetEntry("MaxCPU");
+  m_threadNamesEntry = m_table->GetEntry("ThreadNames");
+  m_threadCPUEntry = m_table->GetEntry("ThreadCPU");
+  m_memoryAvailableEntry = m_table->GetEntry("MemoryAvailable");
+  m_minMemoryAvailableEntry = m_table->GetEntry("MinMemoryAvailable");
+  m_processMemoryEntry = m_table->GetEntry("ProcessMemory");
+  m_latencyEntry = m_table->GetEntry("WakeupLatency");
+  m_maxLatencyEntry = m_table->GetEntry("MaxWakeupLatency");
+  m_canEntry = m_table->GetEntry("CANUtilization");
+  m_maxCANEntry = m_table->GetEntry("MaxCANUtilization");
+  m_canErrorsEntry = m_table->GetEntry("CANErrors");
+}
+
+HealthSampler::~HealthSampler() { Stop(); }
+
+void HealthSampler::Start(double period) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(period));
+  if (m_thread.joinable()) return;
+  m_stop = false;
+  m_thread = std::thread([=] { ThreadMain(); });
+}
+
+void HealthSampler::Stop() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (!m_thread.joinable()) return;
+    m_stop = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+}
+
+RobotHealth HealthSampler::GetHealth() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_health;
+}
+
+void HealthSampler::ThreadMain() {
+  // The first sample only sets the starting CPU times
+  m_lastSampleTime = std::chrono::steady_clock::now();
+  SampleCPU(nullptr);
+  SampleThreads(0, nullptr);
+
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  auto deadline = m_lastSampleTime + m_period;
+  while (!m_stop) {
+    if (m_cond.wait_until(lock, deadline) != std::cv_status::timeout) {
+      continue;
+    }
+    auto now = std::chrono::steady_clock::now();
+    double latency = std::chrono::duration<double>(now - deadline).count();
+    // Skip the deadlines missed rather than sampling back to back
+    deadline += m_period;
+    if (deadline < now) deadline = now + m_period;
+    lock.unlock();
+    Sample(latency);
+    lock.lock();
+  }
+}
+
+void HealthSampler::Sample(double latency) {
+  RobotHealth health;
+  auto now = std::chrono::steady_clock::now();
+  double elapsed =
+      std::chrono::duration<double>(now - m_lastSampleTime).count();
+  m_lastSampleTime = now;
+
+  SampleCPU(&health.cpuPercent);
+  SampleThreads(elapsed, &health.threads);
+  health.wakeupLatency = latency;
+
+#ifdef __linux__
+  char buf[1024];
+  std::FILE* file = std::fopen("/proc/meminfo", "r");
+  if (file != nullptr) {
+    size_t size = std::fread(buf, 1, sizeof(buf) - 1, file);
+    buf[size] = '\0';
+    std::fclose(file);
+    health.memoryTotal = ReadMemInfo(buf, "MemTotal:");
+    health.memoryAvailable = ReadMemInfo(buf, "MemAvailable:");
+  }
+  if (ReadLine("/proc/self/statm", buf, sizeof(buf))) {
+    unsigned long long resident = 0;
+    std::sscanf(buf, "%*u %llu", &resident);
+    health.processMemory = resident * sysconf(_SC_PAGESIZE);
+  }
+#endif
+
+  int32_t status = 0;
+  uint32_t busOffCount = 0;
+  uint32_t txFullCount = 0;
+  uint32_t receiveErrorCount = 0;
+  uint32_t transmitErrorCount = 0;
+  HAL_CAN_GetCANStatus(&health.can.percentBusUtilization, &busOffCount,
+                       &txFullCount, &receiveErrorCount, &transmitErrorCount,
+                       &status);
+  if (status == 0) {
+    health.can.busOffCount = busOffCount;
+    health.can.txFullCount = txFullCount;
+    health.can.receiveErrorCount = receiveErrorCount;
+    health.can.transmitErrorCount = transmitErrorCount;
+  } else {
+    health.can = {};
+  }
+
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    // full histories drop their oldest sample
+    m_cpuHistory.push_back(health.cpuPercent);
+    m_latencyHistory.push_back(health.wakeupLatency);
+    m_canHistory.push_back(health.can.percentBusUtilization);
+    m_memoryHistory.push_back(health.memoryAvailable);
+
+    health.sampleCount = m_health.sampleCount + 1;
+    health.averageCPUPercent = Average(m_cpuHistory);
+    health.maxCPUPercent = Max(m_cpuHistory);
+    health.averageWakeupLatency = Average(m_latencyHistory);
+    health.maxWakeupLatency = Max(m_latencyHistory);
+    health.averageCANUtilization = Average(m_canHistory);
+    health.maxCANUtilization = Max(m_canHistory);
+    health.minMemoryAvailable = Min(m_memoryHistory);
+    m_health = health;
+  }
+
+  Publish(health);
+}
+
+// Gets the percent of all cores busy since the previous call from /proc/stat
+bool HealthSampler::SampleCPU(double* percent) {
+#ifdef __linux__
+  char buf[256];
+  if (!ReadLine("/proc/stat", buf, sizeof(buf))) return false;
+  // cpu user nice system idle iowait irq softirq steal
+  unsigned long long ticks[8] = {};
+  if (std::sscanf(buf, "cpu %llu %llu %llu %llu %llu %llu %llu %llu",
+                  &ticks[0], &ticks[1], &ticks[2], &ticks[3], &ticks[4],
+                  &ticks[5], &ticks[6], &ticks[7]) < 4) {
+    return false;
+  }
+  uint64_t total = 0;
+  for (auto t : ticks) total += t;
+  uint64_t idle = ticks[3] + ticks[4];
+
+  uint64_t totalDelta = total - m_lastTotalTicks;
+  uint64_t idleDelta = idle - m_lastIdleTicks;
+  m_lastTotalTicks = total;
+  m_lastIdleTicks = idle;
+  if (percent != nullptr && totalDelta > 0) {
+    *percent = 100.0 * (totalDelta - idleDelta) / totalDelta;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Gets the percent of a core each thread of the program used in the elapsed
+// seconds since the previous call, from /proc/self/task/<tid>/stat
+void HealthSampler::SampleThreads(double elapsed,
+                                  std::vector<ThreadCPULoad>* threads) {
+#ifdef __linux__
+  static const double kTicksPerSecond = sysconf(_SC_CLK_TCK);
+  uint64_t sample = ++m_threadSample;
+
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) return;
+  while (struct dirent* entry = readdir(dir)) {
+    int id = std::atoi(entry->d_name);
+    if (id <= 0) continue;
+
+    char path[64];
+    char buf[512];
+    std::snprintf(path, sizeof(path), "/proc/self/task/%d/stat", id);
+    if (!ReadLine(path, buf, sizeof(buf))) continue;
+
+    // tid (name) state ... with utime and stime the 14th and 15th fields;
+    // the name may itself hold spaces and parentheses
+    char* nameStart = std::strchr(buf, '(');
+    char* nameEnd = std::strrchr(buf, ')');
+    if (nameStart == nullptr || nameEnd == nullptr) continue;
+    unsigned long long utime = 0;
+    unsigned long long stime = 0;
+    if (std::sscanf(nameEnd + 1,
+                    " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu",
+                    &utime, &stime) != 2) {
+      continue;
+    }
+    uint64_t ticks = utime + stime;
+
+    auto times = m_threadTimes.find(id);
+    if (times == m_threadTimes.end()) {
+      m_threadTimes[id] = {std::string(nameStart + 1, nameEnd), ticks, sample};
+      continue;
+    }
+    uint64_t delta = ticks - times->second.ticks;
+    times->second.name.assign(nameStart + 1, nameEnd);
+    times->second.ticks = ticks;
+    times->second.sample = sample;
+    if (threads != nullptr && elapsed > 0) {
+      threads->emplace_back();
+      ThreadCPULoad& load = threads->back();
+      load.name = times->second.name;
+      load.id = id;
+      load.percent = 100.0 * delta / kTicksPerSecond / elapsed;
+    }
+  }
+  closedir(dir);
+
+  // Forget the threads that have exited
+  for (auto it = m_threadTimes.begin(); it != m_threadTimes.end();) {
+    if (it->second.sample != sample) {
+      it = m_threadTimes.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (threads != nullptr) {
+    std::sort(threads->begin(), threads->end(),
+              [](const ThreadCPULoad& a, const ThreadCPULoad& b) {
+                return a.percent > b.percent;
+              });
+  }
+#endif
+}
+
+void HealthSampler::Publish(const RobotHealth& health) {
+  m_cpuEntry.SetDouble(health.cpuPercent);
+  m_averageCPUEntry.SetDouble(health.averageCPUPercent);
+  m_maxCPUEntry.SetDouble(health.maxCPUPercent);
+
+  m_threadNames.resize(0);
+  m_threadPercents.resize(0);
+  for (const auto& thread : health.threads) {
+    m_threadNames.push_back(thread.name);
+    m_threadPercents.push_back(thread.percent);
+  }
+  m_threadNamesEntry.SetStringArray(m_threadNames);
+  m_threadCPUEntry.SetDoubleArray(m_threadPercents);
+
+  m_memoryAvailableEntry.SetDouble(health.memoryAvailable);
+  m_minMemoryAvailableEntry.SetDouble(health.minMemoryAvailable);
+  m_processMemoryEntry.SetDouble(health.processMemory);
+  m_latencyEntry.SetDouble(health.wakeupLatency);
+  m_maxLatencyEntry.SetDouble(health.maxWakeupLatency);
+  m_canEntry.SetDouble(health.can.percentBusUtilization);
+  m_maxCANEntry.SetDouble(health.maxCANUtilization);
+  m_canErrorsEntry.SetDouble(health.can.busOffCount +
+                             health.can.txFullCount +
+                             health.can.receiveErrorCount +
+                             health.can.transmitErrorCount);
+}
@@ -0,0 +1,79 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Internal/TelemetryTransaction.h"
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+#include <llvm/DenseMap.h>
+#include <networktables/NetworkTableInstance.h>
+#include <support/mutex.h>
+
+#include "ntcore_cpp.h"
+
+using namespace frc;
+
+namespace {
+struct Transaction {
+  std::atomic<bool> open{false};
+  wpi::mutex mutex;
+  // the latest value staged for each entry
+  llvm::DenseMap<NT_Entry, std::shared_ptr<nt::Value>> staged;
+  // swapped with staged on commit, so both keep their buckets
+  llvm::DenseMap<NT_Entry, std::shared_ptr<nt::Value>> committing;
+};
+}  // namespace
+
+static Transaction& GetTransaction() {
+  static Transaction transaction;
+  return transaction;
+}
+
+// Transactions are begun and committed by the robot loop thread; values may
+// be staged from any thread
+void detail::BeginTelemetryTransaction() { GetTransaction().open = true; }
+
+void detail::CommitTelemetryTransaction() {
+  Transaction& transaction = GetTransaction();
+  {
+    std::lock_guard<wpi::mutex> lock(transaction.mutex);
+    transaction.open = false;
+    std::swap(transaction.staged, transaction.committing);
+  }
+  for (auto& value : transaction.committing) {
+    nt::SetEntryValue(value.first, value.second);
+  }
+  transaction.committing.clear();
+  nt::NetworkTableInstance::GetDefault().Flush();
+}
+
+bool detail::SetTelemetryValue(nt::NetworkTableEntry entry,
+                               std::shared_ptr<nt::Value> value) {
+  Transaction& transaction = GetTransaction();
+  if (!value || !transaction.open.load(std::memory_order_acquire)) {
+    return entry.SetValue(value);
+  }
+  NT_Type type = entry.GetType();
+  if (type != NT_UNASSIGNED && type != value->type()) return false;
+  std::lock_guard<wpi::mutex> lock(transaction.mutex);
+  // committed while the type was checked
+  if (!transaction.open) return entry.SetValue(value);
+  transaction.staged[entry.GetHandle()] = std::move(value);
+  return true;
+}
+
+std::shared_ptr<nt::Value> detail::GetStagedTelemetryValue(
+    nt::NetworkTableEntry entry) {
+  Transaction& transaction = GetTransaction();
+  if (!transaction.open.load(std::memory_order_acquire)) return nullptr;
+  std::lock_guard<wpi::mutex> lock(transaction.mutex);
+  auto it = transaction.staged.find(entry.GetHandle());
+  if (it == transaction.staged.end()) return nullptr;
+  return it->second;
+}
@@ -40,6 +40,57 @@ void InterruptableSensorBase::RequestInterrupts(
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
+/**
+ * Request one of the 8 interrupts asynchronously on this digital input, with
+ * the handler run on a dispatch thread shared by every threaded interrupt.
+ *
+ * When several handlers are pending at once, higher priority handlers run
+ * first. The dispatch threads are set up with ConfigureInterruptDispatch().
+ * The default is interrupt on rising edges only.
+ *
+ * @param handler  The handler.
+ * @param param    Passed to the handler.
+ * @param priority The dispatch order of the handler; higher runs first.
+ */
+void InterruptableSensorBase::RequestInterruptsThreaded(
+    HAL_InterruptHandlerFunction handler, void* param, int priority) {
+  if (StatusIsFatal()) return;
+
+  wpi_assert(m_interrupt == HAL_kInvalidHandle);
+  AllocateInterrupts(false);
+  if (StatusIsFatal()) return;  // if allocate failed, out of interrupts
+
+  int32_t status = 0;
+  HAL_RequestInterrupts(
+      m_interrupt, GetPortHandleForRouting(),
+      static_cast<HAL_AnalogTriggerType>(GetAnalogTriggerTypeForRouting()),
+      &status);
+  SetUpSourceEdge(true, false);
+  HAL_AttachInterruptHandlerThreaded(m_interrupt, handler, param, &status);
+  HAL_SetInterruptHandlerPriority(m_interrupt, priority, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Configure the threads shared by every threaded interrupt handler, so the
+ * latency of all of them is tuned in one place.
+ *
+ * @param threadCount The number of dispatch threads, 1 or 2.
+ * @param realTime    True to run the threads at a real-time priority.
+ * @param priority    The real-time priority of the threads, 1-99.
+ * @param cpuMask     The CPUs the threads may run on, one bit per CPU; 0 for
+ *                    any CPU.
+ */
+void InterruptableSensorBase::ConfigureInterruptDispatch(int threadCount,
+                                                         bool realTime,
+                                                         int priority,
+                                                         uint32_t cpuMask) {
+  int32_t status = 0;
+  HAL_ConfigureInterruptDispatch(threadCount, realTime, priority, cpuMask,
+                                 &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
 /**
  * Request one of the 8 interrupts synchronously on this digital input.
  *
@@ -116,6 +167,41 @@ InterruptableSensorBase::WaitResult InterruptableSensorBase::WaitForInterrupt(
   return static_cast<WaitResult>(falling | rising);
 }
 
+/**
+ * In synchronous mode, wait for an interrupt on any of several sensors, so one
+ * thread can serve all of them.
+ *
+ * Each sensor must have requested synchronous interrupts. After an interrupt,
+ * ReadRisingTimestamp() and ReadFallingTimestamp() of the sensors that fired
+ * return the time of their edges.
+ *
+ * @param sensors        The sensors to wait on, at most 8.
+ * @param timeout        Timeout in seconds
+ * @param ignorePrevious If true, ignore interrupts that happened before
+ *                       WaitForMultipleInterrupts was called.
+ * @return A mask with bit i set when sensors[i] saw a rising edge and bit
+ *         i + 8 set when it saw a falling edge; 0 on timeout.
+ */
+int InterruptableSensorBase::WaitForMultipleInterrupts(
+    llvm::ArrayRef<InterruptableSensorBase*> sensors, double timeout,
+    bool ignorePrevious) {
+  HAL_InterruptHandle handles[8];
+  if (sensors.empty() || sensors.size() > 8) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "sensors");
+    return kTimeout;
+  }
+  for (size_t i = 0; i < sensors.size(); i++) {
+    handles[i] = sensors[i]->m_interrupt;
+  }
+
+  int32_t status = 0;
+  int64_t result = HAL_WaitForMultipleInterrupts(
+      handles, sensors.size(), timeout, ignorePrevious, nullptr, nullptr,
+      &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+  return result;
+}
+
 /**
  * Enable interrupts to occur on this input.
  *
@@ -199,3 +285,48 @@ void InterruptableSensorBase::SetUpSourceEdge(bool risingEdge,
     wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
   }
 }
+
+/**
+ * Queue the rising and falling edges of this interrupt as they are handled.
+ *
+ * ReadRisingTimestamp() and ReadFallingTimestamp() only return the latest
+ * edge, so edges that arrive faster than they are read are lost. With a queue,
+ * ReadEvents() returns every edge since the previous call.
+ *
+ * @param size The number of edges kept between reads; 0 stops queueing.
+ */
+void InterruptableSensorBase::SetEventQueueSize(int size) {
+  if (StatusIsFatal()) return;
+  wpi_assert(m_interrupt != HAL_kInvalidHandle);
+  int32_t status = 0;
+  HAL_SetInterruptEventQueueSize(m_interrupt, size, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Read the queued edges, oldest first.
+ *
+ * @param events Buffer to copy the edges into.
+ * @param count  Size of events.
+ * @return The number of edges copied.
+ */
+int InterruptableSensorBase::ReadEvents(Event* events, int count) {
+  if (StatusIsFatal()) return 0;
+  wpi_assert(m_interrupt != HAL_kInvalidHandle);
+  int32_t status = 0;
+  int read = HAL_ReadInterruptEvents(m_interrupt, events, count, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return read;
+}
+
+/**
+ * Return the number of edges dropped because the queue was full.
+ */
+int64_t InterruptableSensorBase::GetEventOverflowCount() {
+  if (StatusIsFatal()) return 0;
+  wpi_assert(m_interrupt != HAL_kInvalidHandle);
+  int32_t status = 0;
+  int64_t count = HAL_GetInterruptEventOverflowCount(m_interrupt, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return count;
+}
@@ -10,6 +10,7 @@
 #include <HAL/HAL.h>
 
 #include "DriverStation.h"
+#include "StartupProfiler.h"
 
 using namespace frc;
 
@@ -25,7 +26,10 @@ IterativeRobot::IterativeRobot() {
  * the DS packets.
  */
 void IterativeRobot::StartCompetition() {
+  StartupProfiler::Mark("robot constructor");
   RobotInit();
+  StartupProfiler::Mark("RobotInit");
+  StartupProfiler::Finish();
 
   // Tell the DS that the robot is ready to be enabled
   HAL_ObserveUserProgramStarting();
@@ -13,11 +13,28 @@
 #include <llvm/raw_ostream.h>
 
 #include "Commands/Scheduler.h"
+#include "Executor.h"
 #include "LiveWindow/LiveWindow.h"
+#include "PWM.h"
+#include "ReadCache.h"
 #include "SmartDashboard/SmartDashboard.h"
+#include "Tracing.h"
 
 using namespace frc;
 
+// The loop period assumed by the profiler and the watchdog until a subclass
+// sets another
+static constexpr double kDefaultLoopPeriod = 0.02;
+
+IterativeRobotBase::IterativeRobotBase()
+    : m_loopProfiler(kDefaultLoopPeriod),
+      m_watchdog(kDefaultLoopPeriod, nullptr) {
+  // The watchdog reports overruns while they happen, with the stage that is
+  // still running, so the profiler does not report them again at loop end
+  m_loopProfiler.SetOverrunReporting(false);
+  m_loopProfiler.SetWatchdog(&m_watchdog);
+}
+
 /**
  * Robot-wide initialization code should go here.
  *
@@ -148,7 +165,37 @@ void IterativeRobotBase::TestPeriodic() {
   }
 }
 
+/**
+ * Returns the profiler that times each stage of the main loop.
+ *
+ * The stages recorded are the mode's periodic function ("DisabledPeriodic",
+ * "AutonomousPeriodic", "TeleopPeriodic" or "TestPeriodic", including its
+ * Init() when the mode changes), "RobotPeriodic", "SmartDashboard" and
+ * "LiveWindow".
+ */
+LoopProfiler& IterativeRobotBase::GetLoopProfiler() { return m_loopProfiler; }
+
+/**
+ * Returns the watchdog of the main loop.
+ *
+ * It is reset at the top of every iteration with the loop period as its
+ * timeout, and is fed the stage times measured by the loop profiler. When an
+ * iteration overruns, it prints the stages run so far and the time spent in
+ * the current one.
+ */
+Watchdog& IterativeRobotBase::GetWatchdog() { return m_watchdog; }
+
 void IterativeRobotBase::LoopFunc() {
+  FRC_TRACE_SCOPE("IterativeRobotBase::LoopFunc");
+  m_loopProfiler.StartLoop();
+  // Sensor values read from here on are latched until the next loop
+  ReadCache::StartLoop();
+  // Everything published during the loop is sent together at the end
+  SmartDashboard::BeginTransaction();
+  // Apply the results of background work finished since the last loop
+  Executor::RunMainLoopTasks();
+  m_loopProfiler.AddEpoch("MainLoopTasks");
+
   // Call the appropriate function depending upon the current robot mode
   if (IsDisabled()) {
     // Call DisabledInit() if we are now just entering disabled mode from
@@ -160,6 +207,7 @@ void IterativeRobotBase::LoopFunc() {
     }
     HAL_ObserveUserProgramDisabled();
     DisabledPeriodic();
+    m_loopProfiler.AddEpoch("DisabledPeriodic");
   } else if (IsAutonomous()) {
     // Call AutonomousInit() if we are now just entering autonomous mode from
     // either a different mode or from power-on.
@@ -170,6 +218,7 @@ void IterativeRobotBase::LoopFunc() {
     }
     HAL_ObserveUserProgramAutonomous();
     AutonomousPeriodic();
+    m_loopProfiler.AddEpoch("AutonomousPeriodic");
   } else if (IsOperatorControl()) {
     // Call TeleopInit() if we are now just entering teleop mode from
     // either a different mode or from power-on.
@@ -181,6 +230,7 @@ void IterativeRobotBase::LoopFunc() {
     }
     HAL_ObserveUserProgramTeleop();
     TeleopPeriodic();
+    m_loopProfiler.AddEpoch("TeleopPeriodic");
   } else {
     // Call TestInit() if we are now just entering test mode from
     // either a different mode or from power-on.
@@ -191,8 +241,16 @@ void IterativeRobotBase::LoopFunc() {
     }
     HAL_ObserveUserProgramTest();
     TestPeriodic();
+    m_loopProfiler.AddEpoch("TestPeriodic");
   }
   RobotPeriodic();
+  m_loopProfiler.AddEpoch("RobotPeriodic");
+  if (PWM::GetOutputsDeferred()) PWM::CommitOutputs();
   SmartDashboard::UpdateValues();
+  m_loopProfiler.AddEpoch("SmartDashboard");
   LiveWindow::GetInstance()->UpdateValues();
+  m_loopProfiler.AddEpoch("LiveWindow");
+
+  m_loopProfiler.EndLoop();
+  SmartDashboard::CommitTransaction();
 }
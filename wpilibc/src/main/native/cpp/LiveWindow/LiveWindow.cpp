@@ -8,9 +8,11 @@
 #include "LiveWindow/LiveWindow.h"
 
 #include <algorithm>
+#include <vector>
 
 #include <llvm/DenseMap.h>
 #include <llvm/SmallString.h>
+#include <llvm/StringMap.h>
 #include <llvm/raw_ostream.h>
 #include <networktables/NetworkTable.h>
 #include <networktables/NetworkTableEntry.h>
@@ -19,6 +21,8 @@
 
 #include "Commands/Scheduler.h"
 #include "SmartDashboard/SendableBuilderImpl.h"
+#include "Timer.h"
+#include "Tracing.h"
 
 using namespace frc;
 
@@ -33,26 +37,74 @@ struct LiveWindow::Impl {
     SendableBuilderImpl builder;
     bool firstTime = true;
     bool telemetryEnabled = true;
+    // Seconds between telemetry updates; negative uses the default period
+    double updatePeriod = -1;
+    double lastUpdate = 0;
   };
 
+  Component& GetComponent(void* sendable);
+  // These create the tables the first time they are used; updateMutex must
+  // be held
+  std::shared_ptr<nt::NetworkTable> GetTable();
+  nt::NetworkTableEntry GetEnabledEntry();
+  std::shared_ptr<nt::NetworkTable> GetSubsystemTable(llvm::StringRef name);
+
   wpi::mutex mutex;
 
-  llvm::DenseMap<void*, Component> components;
+  // Held while UpdateValues() updates components outside of mutex. Remove()
+  // and SetEnabled() take it first, so a component being updated is never
+  // removed or switched out of LiveWindow mode mid-update.
+  wpi::mutex updateMutex;
+
+  // Components are shared so UpdateValues() can keep a snapshot of them
+  // while others are added and removed
+  llvm::DenseMap<void*, std::shared_ptr<Component>> components;
+  std::vector<std::shared_ptr<Component>> updates;
 
+  // Nothing is created in NetworkTables until LiveWindow is enabled or a
+  // dashboard connects
   std::shared_ptr<nt::NetworkTable> liveWindowTable;
-  std::shared_ptr<nt::NetworkTable> statusTable;
   nt::NetworkTableEntry enabledEntry;
+  // Subsystem tables by name, so components of the same subsystem share one
+  llvm::StringMap<std::shared_ptr<nt::NetworkTable>> subsystemTables;
 
   bool startLiveWindow = false;
   bool liveWindowEnabled = false;
   bool telemetryEnabled = true;
+  double updatePeriod = 0;
 };
 
-LiveWindow::Impl::Impl()
-    : liveWindowTable(
-          nt::NetworkTableInstance::GetDefault().GetTable("LiveWindow")) {
-  statusTable = liveWindowTable->GetSubTable(".status");
-  enabledEntry = statusTable->GetEntry("LW Enabled");
+LiveWindow::Impl::Impl() = default;
+
+LiveWindow::Impl::Component& LiveWindow::Impl::GetComponent(void* sendable) {
+  auto& comp = components[sendable];
+  if (!comp) comp = std::make_shared<Component>();
+  return *comp;
+}
+
+std::shared_ptr<nt::NetworkTable> LiveWindow::Impl::GetTable() {
+  if (!liveWindowTable) {
+    liveWindowTable =
+        nt::NetworkTableInstance::GetDefault().GetTable("LiveWindow");
+  }
+  return liveWindowTable;
+}
+
+nt::NetworkTableEntry LiveWindow::Impl::GetEnabledEntry() {
+  if (!enabledEntry) {
+    enabledEntry = GetTable()->GetEntry(".status/LW Enabled");
+  }
+  return enabledEntry;
+}
+
+std::shared_ptr<nt::NetworkTable> LiveWindow::Impl::GetSubsystemTable(
+    llvm::StringRef name) {
+  auto& table = subsystemTables[name];
+  if (!table) {
+    table = GetTable()->GetSubTable(name);
+    table->GetEntry(".type").SetString("LW Subsystem");
+  }
+  return table;
 }
 
 /**
@@ -69,7 +121,7 @@ LiveWindow* LiveWindow::GetInstance() {
 /**
  * LiveWindow constructor.
  *
- * Allocate the necessary tables.
+ * The tables are allocated once LiveWindow is enabled or a dashboard connects.
  */
 LiveWindow::LiveWindow() : m_impl(new Impl) {}
 
@@ -84,6 +136,7 @@ bool LiveWindow::IsEnabled() const {
  * If it changes to enabled, start livewindow running otherwise stop it
  */
 void LiveWindow::SetEnabled(bool enabled) {
+  std::lock_guard<wpi::mutex> updateLock(m_impl->updateMutex);
   std::lock_guard<wpi::mutex> lock(m_impl->mutex);
   if (m_impl->liveWindowEnabled == enabled) return;
   Scheduler* scheduler = Scheduler::GetInstance();
@@ -92,13 +145,13 @@ void LiveWindow::SetEnabled(bool enabled) {
     scheduler->RemoveAll();
   } else {
     for (auto& i : m_impl->components) {
-      i.getSecond().builder.StopLiveWindowMode();
+      i.getSecond()->builder.StopLiveWindowMode();
     }
     scheduler->SetEnabled(true);
   }
   m_impl->startLiveWindow = enabled;
   m_impl->liveWindowEnabled = enabled;
-  m_impl->enabledEntry.SetBoolean(enabled);
+  m_impl->GetEnabledEntry().SetBoolean(enabled);
 }
 
 /**
@@ -225,7 +278,7 @@ void LiveWindow::AddActuator(const llvm::Twine& type, int module, int channel,
  */
 void LiveWindow::Add(std::shared_ptr<Sendable> sendable) {
   std::lock_guard<wpi::mutex> lock(m_impl->mutex);
-  auto& comp = m_impl->components[sendable.get()];
+  auto& comp = m_impl->GetComponent(sendable.get());
   comp.sendable = sendable;
 }
 
@@ -256,7 +309,7 @@ void LiveWindow::AddChild(Sendable* parent, std::shared_ptr<Sendable> child) {
  */
 void LiveWindow::AddChild(Sendable* parent, void* child) {
   std::lock_guard<wpi::mutex> lock(m_impl->mutex);
-  auto& comp = m_impl->components[child];
+  auto& comp = m_impl->GetComponent(child);
   comp.parent = parent;
   comp.telemetryEnabled = false;
 }
@@ -267,6 +320,7 @@ void LiveWindow::AddChild(Sendable* parent, void* child) {
  * @param sendable component to remove
  */
 void LiveWindow::Remove(Sendable* sendable) {
+  std::lock_guard<wpi::mutex> updateLock(m_impl->updateMutex);
   std::lock_guard<wpi::mutex> lock(m_impl->mutex);
   m_impl->components.erase(sendable);
 }
@@ -281,7 +335,7 @@ void LiveWindow::EnableTelemetry(Sendable* sendable) {
   // Re-enable global setting in case DisableAllTelemetry() was called.
   m_impl->telemetryEnabled = true;
   auto i = m_impl->components.find(sendable);
-  if (i != m_impl->components.end()) i->getSecond().telemetryEnabled = true;
+  if (i != m_impl->components.end()) i->getSecond()->telemetryEnabled = true;
 }
 
 /**
@@ -292,7 +346,7 @@ void LiveWindow::EnableTelemetry(Sendable* sendable) {
 void LiveWindow::DisableTelemetry(Sendable* sendable) {
   std::lock_guard<wpi::mutex> lock(m_impl->mutex);
   auto i = m_impl->components.find(sendable);
-  if (i != m_impl->components.end()) i->getSecond().telemetryEnabled = false;
+  if (i != m_impl->components.end()) i->getSecond()->telemetryEnabled = false;
 }
 
 /**
@@ -301,7 +355,33 @@ void LiveWindow::DisableTelemetry(Sendable* sendable) {
 void LiveWindow::DisableAllTelemetry() {
   std::lock_guard<wpi::mutex> lock(m_impl->mutex);
   m_impl->telemetryEnabled = false;
-  for (auto& i : m_impl->components) i.getSecond().telemetryEnabled = false;
+  for (auto& i : m_impl->components) i.getSecond()->telemetryEnabled = false;
+}
+
+/**
+ * Set how often telemetry is sent for components that don't have their own
+ * update period. In LiveWindow mode every component is updated every time.
+ *
+ * @param period seconds between updates, or 0 to update every time
+ *               UpdateValues() is called
+ */
+void LiveWindow::SetUpdatePeriod(double period) {
+  std::lock_guard<wpi::mutex> lock(m_impl->mutex);
+  m_impl->updatePeriod = period;
+}
+
+/**
+ * Set how often telemetry is sent for a single component, overriding the
+ * default update period.
+ *
+ * @param sendable component
+ * @param period   seconds between updates, or 0 to update every time
+ *                 UpdateValues() is called
+ */
+void LiveWindow::SetUpdatePeriod(Sendable* sendable, double period) {
+  std::lock_guard<wpi::mutex> lock(m_impl->mutex);
+  auto i = m_impl->components.find(sendable);
+  if (i != m_impl->components.end()) i->getSecond()->updatePeriod = period;
 }
 
 /**
@@ -311,41 +391,70 @@ void LiveWindow::DisableAllTelemetry() {
  * SmartDashboard widgets.
  */
 void LiveWindow::UpdateValues() {
-  std::lock_guard<wpi::mutex> lock(m_impl->mutex);
-  // Only do this if either LiveWindow mode or telemetry is enabled.
-  if (!m_impl->liveWindowEnabled && !m_impl->telemetryEnabled) return;
-
-  for (auto& i : m_impl->components) {
-    auto& comp = i.getSecond();
-    if (comp.sendable && !comp.parent &&
-        (m_impl->liveWindowEnabled || comp.telemetryEnabled)) {
-      if (comp.firstTime) {
-        // By holding off creating the NetworkTable entries, it allows the
-        // components to be redefined. This allows default sensor and actuator
-        // values to be created that are replaced with the custom names from
-        // users calling setName.
-        auto name = comp.sendable->GetName();
-        if (name.empty()) continue;
-        auto subsystem = comp.sendable->GetSubsystem();
-        auto ssTable = m_impl->liveWindowTable->GetSubTable(subsystem);
-        std::shared_ptr<NetworkTable> table;
-        // Treat name==subsystem as top level of subsystem
-        if (name == subsystem)
-          table = ssTable;
-        else
-          table = ssTable->GetSubTable(name);
-        table->GetEntry(".name").SetString(name);
-        comp.builder.SetTable(table);
-        comp.sendable->InitSendable(comp.builder);
-        ssTable->GetEntry(".type").SetString("LW Subsystem");
-
-        comp.firstTime = false;
+  FRC_TRACE_SCOPE("LiveWindow::UpdateValues");
+  std::lock_guard<wpi::mutex> updateLock(m_impl->updateMutex);
+  bool liveWindowEnabled;
+  bool startLiveWindow;
+  {
+    std::lock_guard<wpi::mutex> lock(m_impl->mutex);
+    // Only do this if either LiveWindow mode or telemetry is enabled.
+    if (!m_impl->liveWindowEnabled && !m_impl->telemetryEnabled) return;
+
+    // Telemetry has no one to go to until a dashboard connects
+    liveWindowEnabled = m_impl->liveWindowEnabled;
+    if (!liveWindowEnabled &&
+        !nt::NetworkTableInstance::GetDefault().IsConnected())
+      return;
+
+    // Take a snapshot of the components that are due, so they are updated
+    // without blocking Add() and the other registry calls
+    double now = Timer::GetFPGATimestamp();
+    m_impl->updates.clear();
+    for (auto& i : m_impl->components) {
+      auto& comp = *i.getSecond();
+      if (!comp.sendable || comp.parent) continue;
+      if (!liveWindowEnabled) {
+        if (!comp.telemetryEnabled) continue;
+        double period =
+            comp.updatePeriod < 0 ? m_impl->updatePeriod : comp.updatePeriod;
+        if (!comp.firstTime && now - comp.lastUpdate < period) continue;
       }
+      comp.lastUpdate = now;
+      m_impl->updates.push_back(i.getSecond());
+    }
+
+    startLiveWindow = m_impl->startLiveWindow;
+    m_impl->startLiveWindow = false;
+  }
 
-      if (m_impl->startLiveWindow) comp.builder.StartLiveWindowMode();
-      comp.builder.UpdateTable();
+  for (auto& compPtr : m_impl->updates) {
+    auto& comp = *compPtr;
+    if (comp.firstTime) {
+      // By holding off creating the NetworkTable entries, it allows the
+      // components to be redefined. This allows default sensor and actuator
+      // values to be created that are replaced with the custom names from
+      // users calling setName.
+      auto name = comp.sendable->GetName();
+      if (name.empty()) continue;
+      auto subsystem = comp.sendable->GetSubsystem();
+      auto ssTable = m_impl->GetSubsystemTable(subsystem);
+      std::shared_ptr<NetworkTable> table;
+      // Treat name==subsystem as top level of subsystem
+      if (name == subsystem)
+        table = ssTable;
+      else
+        table = ssTable->GetSubTable(name);
+      table->GetEntry(".name").SetString(name);
+      comp.builder.SetTable(table);
+      comp.sendable->InitSendable(comp.builder);
+
+      comp.firstTime = false;
     }
+
+    if (startLiveWindow) comp.builder.StartLiveWindowMode();
+    comp.builder.UpdateTable();
   }
 
-  m_impl->startLiveWindow = false;
+  // Don't keep removed components alive until the next update
+  m_impl->updates.clear();
 }
@@ -0,0 +1,380 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "LogStreamServer.h"
+
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <sys/socket.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+
+#include <support/Logger.h>
+#include <tcpsockets/NetworkStream.h>
+#include <tcpsockets/TCPAcceptor.h>
+
+#include "WPIErrors.h"
+
+using namespace frc;
+
+constexpr int LogStreamServer::kDefaultPort;
+constexpr double LogStreamServer::kDefaultBandwidth;
+constexpr double LogStreamServer::kMaxQueueTime;
+constexpr double LogStreamServer::kSendPeriod;
+
+// Blocks are moved out of a client's queue, where they can still be dropped,
+// about this many bytes at a time
+static constexpr size_t kSendChunk = 4096;
+
+static constexpr uint8_t kStartRecord = 0;
+static constexpr uint8_t kGapRecord = 3;
+
+static constexpr uint8_t kSubscribeCommand = 0;
+static constexpr uint8_t kUnsubscribeCommand = 1;
+
+static wpi::Logger logger;
+
+static void PutEntryStart(std::vector<uint8_t>& data, int entry,
+                          llvm::StringRef name, DataLog::Type type) {
+  data.push_back(kStartRecord);
+  data.push_back(static_cast<uint8_t>(entry));
+  data.push_back(static_cast<uint8_t>(entry >> 8));
+  data.push_back(type);
+  data.push_back(name.size());
+  data.insert(data.end(), name.begin(), name.end());
+}
+
+LogStreamServer& LogStreamServer::GetInstance() {
+  // Created first, so the DataLog is destroyed after the server stops
+  // listening to it
+  DataLog::GetInstance();
+  static LogStreamServer instance;
+  return instance;
+}
+
+LogStreamServer::~LogStreamServer() { Stop(); }
+
+/**
+ * Start accepting clients and streaming the DataLog to them.
+ *
+ * @param port      The TCP port to listen on.
+ * @param bandwidth The most bytes per second to send, shared by all clients.
+ */
+void LogStreamServer::Start(int port, double bandwidth) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (m_sendThread.joinable()) return;
+    m_acceptor = std::make_unique<wpi::TCPAcceptor>(port, "", logger);
+    if (m_acceptor->start() != 0) {
+      wpi_setWPIErrorWithContext(ResourceAlreadyAllocated,
+                                 "log stream port in use");
+      m_acceptor.reset();
+      return;
+    }
+    m_stop = false;
+    m_bandwidth = bandwidth;
+    // The DataLog tells the listener about every entry again
+    m_entries.clear();
+    m_acceptThread = std::thread(&LogStreamServer::AcceptMain, this);
+    m_sendThread = std::thread(&LogStreamServer::SendMain, this);
+  }
+  DataLog::GetInstance().AddListener(this);
+}
+
+/**
+ * Disconnect every client and stop accepting new ones.
+ */
+void LogStreamServer::Stop() {
+  // Waits for the writer thread to leave the listener, which takes m_mutex
+  DataLog::GetInstance().RemoveListener(this);
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (!m_sendThread.joinable()) return;
+    m_stop = true;
+  }
+  m_acceptor->shutdown();
+  m_cond.notify_all();
+  m_acceptThread.join();
+  m_sendThread.join();
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_clients.clear();
+  m_clientCount = 0;
+  m_acceptor.reset();
+  m_period.clear();
+  m_periodBlocks.clear();
+}
+
+/**
+ * Set the priority of an entry's values when bandwidth runs short. Entries
+ * are kNormal priority by default.
+ */
+void LogStreamServer::SetPriority(const DataLogEntry& entry,
+                                  Priority priority) {
+  if (entry.GetId() < 0) return;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  size_t id = entry.GetId();
+  if (id >= m_priorities.size()) m_priorities.resize(id + 1, kNormal);
+  m_priorities[id] = priority;
+}
+
+/**
+ * Get the number of connected clients.
+ */
+int LogStreamServer::GetClientCount() const { return m_clientCount; }
+
+/**
+ * Get the number of values dropped for all clients because their links
+ * couldn't keep up.
+ */
+uint64_t LogStreamServer::GetDroppedCount() const { return m_dropped; }
+
+void LogStreamServer::EntryStarted(int entry, llvm::StringRef name,
+                                   DataLog::Type type) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (static_cast<size_t>(entry) < m_entries.size()) return;
+  m_entries.push_back({name, type});
+  for (auto& client : m_clients) {
+    PutEntryStart(client->control, entry, name, type);
+    bool subscribed = false;
+    for (auto& prefix : client->prefixes) {
+      if (name.startswith(prefix)) subscribed = true;
+    }
+    client->subscribed.push_back(subscribed);
+    client->gaps.push_back(0);
+  }
+}
+
+void LogStreamServer::ValuesWritten(int entry, DataLog::Type type,
+                                    llvm::ArrayRef<uint64_t> timestamps,
+                                    llvm::ArrayRef<uint64_t> values) {
+  if (m_clientCount == 0) return;
+  // Encoded on their own, so any block can be dropped
+  DataLog::EncoderState state;
+  size_t offset = m_period.size();
+  DataLog::EncodeBlock(entry, type, timestamps, values, state, m_period);
+  m_periodBlocks.push_back({entry, kNormal,
+                            static_cast<uint32_t>(values.size()), nullptr,
+                            offset, m_period.size() - offset});
+}
+
+void LogStreamServer::PeriodEnded() {
+  if (m_periodBlocks.empty()) return;
+  auto data = std::make_shared<std::vector<uint8_t>>(std::move(m_period));
+  m_period.clear();
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    for (auto& block : m_periodBlocks) {
+      block.data = data;
+      if (static_cast<size_t>(block.entry) < m_priorities.size()) {
+        block.priority = m_priorities[block.entry];
+      }
+      for (auto& client : m_clients) {
+        if (static_cast<size_t>(block.entry) < client->subscribed.size() &&
+            client->subscribed[block.entry]) {
+          Enqueue(*client, block);
+        }
+      }
+    }
+  }
+  m_periodBlocks.clear();
+  m_cond.notify_one();
+}
+
+void LogStreamServer::AcceptMain() {
+  for (;;) {
+    auto stream = m_acceptor->accept();
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (m_stop) return;
+    if (stream) AddClient(std::move(stream));
+  }
+}
+
+void LogStreamServer::SendMain() {
+  // Bytes that may be sent now, shared by all clients
+  double budget = 0;
+  auto last = std::chrono::steady_clock::now();
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  while (!m_stop) {
+    m_cond.wait_for(lock, std::chrono::duration<double>(kSendPeriod));
+    if (m_stop) break;
+
+    auto now = std::chrono::steady_clock::now();
+    budget += m_bandwidth * std::chrono::duration<double>(now - last).count();
+    budget = std::min(budget, m_bandwidth * kSendPeriod * 4);
+    last = now;
+
+    // Each client gets an equal share, so one slow link doesn't starve the
+    // others
+    double share = m_clients.empty() ? 0 : budget / m_clients.size();
+    for (size_t i = 0; i < m_clients.size();) {
+      double clientBudget = share;
+      if (!Receive(*m_clients[i]) || !Send(*m_clients[i], clientBudget)) {
+        m_clients.erase(m_clients.begin() + i);
+        continue;
+      }
+      budget -= share - clientBudget;
+      i++;
+    }
+    m_clientCount = m_clients.size();
+  }
+}
+
+void LogStreamServer::AddClient(std::unique_ptr<wpi::NetworkStream> stream) {
+  stream->setBlocking(false);
+#ifndef _WIN32
+  int fd = stream->getNativeHandle();
+  // A small kernel buffer keeps waiting data in the queue, where the lowest
+  // priority blocks can still be dropped
+  int sendBuffer = 16384;
+  setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+  // Low priority (DSCP CS1) for routers that take it into account
+  int tos = 0x20;
+  setsockopt(fd, IPPROTO_IP, IP_TOS, &tos, sizeof(tos));
+#endif
+
+  auto client = std::make_unique<Client>();
+  client->stream = std::move(stream);
+  std::vector<uint8_t>& control = client->control;
+  control = {'F', 'R', 'C', 'L', 'O', 'G'};
+  control.push_back(static_cast<uint8_t>(DataLog::kVersion));
+  control.push_back(static_cast<uint8_t>(DataLog::kVersion >> 8));
+  for (size_t i = 0; i < m_entries.size(); i++) {
+    PutEntryStart(control, i, m_entries[i].name, m_entries[i].type);
+  }
+  client->subscribed.resize(m_entries.size(), false);
+  client->gaps.resize(m_entries.size(), 0);
+  m_clients.push_back(std::move(client));
+  m_clientCount = m_clients.size();
+}
+
+// Queues a block, dropping blocks when the client's link can't keep up
+void LogStreamServer::Enqueue(Client& client, const Block& block) {
+  size_t maxBytes = static_cast<size_t>(m_bandwidth * kMaxQueueTime);
+  if (block.priority == kLow && client.queuedBytes + block.size > maxBytes / 2) {
+    Drop(client, block);
+    return;
+  }
+  client.queue.push_back(block);
+  client.queuedBytes += block.size;
+
+  for (int priority = kLow; priority <= kHigh; priority++) {
+    for (auto it = client.queue.begin();
+         it != client.queue.end() && client.queuedBytes > maxBytes;) {
+      if (it->priority != priority) {
+        ++it;
+        continue;
+      }
+      client.queuedBytes -= it->size;
+      Drop(client, *it);
+      it = client.queue.erase(it);
+    }
+  }
+}
+
+void LogStreamServer::Drop(Client& client, const Block& block) {
+  client.gaps[block.entry] += block.count;
+  client.hasGaps = true;
+  m_dropped += block.count;
+}
+
+// Handles the commands received from a client. Returns false if the client
+// disconnected or sent an invalid command.
+bool LogStreamServer::Receive(Client& client) {
+  std::vector<uint8_t>& received = client.received;
+  for (;;) {
+    char buffer[256];
+    wpi::NetworkStream::Error error;
+    size_t count = client.stream->receive(buffer, sizeof(buffer), &error);
+    if (count == 0) {
+      if (error != wpi::NetworkStream::kWouldBlock) return false;
+      break;
+    }
+    received.insert(received.end(), buffer, buffer + count);
+  }
+
+  size_t pos = 0;
+  while (pos < received.size()) {
+    if (received[pos] == kSubscribeCommand) {
+      if (pos + 2 > received.size() ||
+          pos + 2 + received[pos + 1] > received.size()) {
+        break;
+      }
+      Subscribe(client, llvm::StringRef(
+                            reinterpret_cast<const char*>(&received[pos + 2]),
+                            received[pos + 1]));
+      pos += 2 + received[pos + 1];
+    } else if (received[pos] == kUnsubscribeCommand) {
+      client.prefixes.clear();
+      std::fill(client.subscribed.begin(), client.subscribed.end(), false);
+      pos++;
+    } else {
+      return false;
+    }
+  }
+  received.erase(received.begin(), received.begin() + pos);
+  return true;
+}
+
+void LogStreamServer::Subscribe(Client& client, llvm::StringRef prefix) {
+  client.prefixes.push_back(prefix);
+  for (size_t i = 0; i < m_entries.size(); i++) {
+    if (llvm::StringRef(m_entries[i].name).startswith(prefix)) {
+      client.subscribed[i] = true;
+    }
+  }
+}
+
+// Sends as much as the budget allows, taking what is sent out of it. Returns
+// false if the client disconnected.
+bool LogStreamServer::Send(Client& client, double& budget) {
+  std::vector<uint8_t>& sending = client.sending;
+  if (client.sent == sending.size()) {
+    sending.clear();
+    client.sent = 0;
+    sending.insert(sending.end(), client.control.begin(),
+                   client.control.end());
+    client.control.clear();
+    if (client.hasGaps) {
+      for (size_t i = 0; i < client.gaps.size(); i++) {
+        uint64_t count = client.gaps[i];
+        if (count == 0) continue;
+        sending.push_back(kGapRecord);
+        sending.push_back(static_cast<uint8_t>(i));
+        sending.push_back(static_cast<uint8_t>(i >> 8));
+        for (; count >= 0x80; count >>= 7) {
+          sending.push_back(static_cast<uint8_t>(count) | 0x80);
+        }
+        sending.push_back(static_cast<uint8_t>(count));
+        client.gaps[i] = 0;
+      }
+      client.hasGaps = false;
+    }
+    while (!client.queue.empty() && sending.size() < kSendChunk) {
+      const Block& block = client.queue.front();
+      auto begin = block.data->begin() + block.offset;
+      sending.insert(sending.end(), begin, begin + block.size);
+      client.queuedBytes -= block.size;
+      client.queue.pop_front();
+    }
+  }
+
+  size_t count = std::min(sending.size() - client.sent,
+                          static_cast<size_t>(std::max(budget, 0.0)));
+  if (count == 0) return true;
+  wpi::NetworkStream::Error error;
+  size_t written = client.stream->send(
+      reinterpret_cast<const char*>(sending.data() + client.sent), count,
+      &error);
+  if (written == 0 && error != wpi::NetworkStream::kWouldBlock) return false;
+  client.sent += written;
+  budget -= written;
+  return true;
+}
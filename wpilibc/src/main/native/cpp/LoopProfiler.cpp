@@ -0,0 +1,229 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "LoopProfiler.h"
+
+#include <algorithm>
+
+#include <llvm/SmallString.h>
+#include <llvm/raw_ostream.h>
+#include <networktables/NetworkTable.h>
+#include <networktables/NetworkTableInstance.h>
+
+#include "DriverStation.h"
+#include "Internal/TelemetryTransaction.h"
+#include "Timer.h"
+#include "Tracing.h"
+#include "Watchdog.h"
+
+using namespace frc;
+
+// Minimum time between two overrun messages, in seconds
+static constexpr double kOverrunReportInterval = 1.0;
+
+/**
+ * Creates a loop profiler.
+ *
+ * @param period The period the loop is meant to run at, in seconds
+ */
+LoopProfiler::LoopProfiler(double period) : m_period(period) {
+  m_table = nt::NetworkTableInstance::GetDefault().GetTable("LoopProfiler");
+  m_loopTimeEntry = m_table->GetEntry("LoopTime");
+  m_maxLoopTimeEntry = m_table->GetEntry("MaxLoopTime");
+  m_overrunsEntry = m_table->GetEntry("Overruns");
+  m_stageNamesEntry = m_table->GetEntry("StageNames");
+  m_stageTimesEntry = m_table->GetEntry("StageTimes");
+  m_histogramEntry = m_table->GetEntry("Histogram");
+  m_histogramValues.resize(kHistogramBuckets);
+}
+
+void LoopProfiler::SetPeriod(double period) { m_period = period; }
+
+double LoopProfiler::GetPeriod() const { return m_period; }
+
+/**
+ * Sets whether the stage times are reported to the Driver Station when the
+ * loop overruns its period. At most one report is made per second.
+ */
+void LoopProfiler::SetOverrunReporting(bool enabled) {
+  m_reportOverruns = enabled;
+}
+
+/**
+ * Attaches a watchdog to the profiled loop.
+ *
+ * StartLoop() resets it, AddEpoch() records each stage time in it as well and
+ * EndLoop() disables it.
+ *
+ * @param watchdog The watchdog, which must outlive the loop, or nullptr to
+ *                 detach it
+ */
+void LoopProfiler::SetWatchdog(Watchdog* watchdog) { m_watchdog = watchdog; }
+
+/**
+ * Marks the start of a loop iteration.
+ */
+void LoopProfiler::StartLoop() {
+  m_loopStart = Timer::GetFPGATimestamp();
+  m_epochStart = m_loopStart;
+  if (m_watchdog) m_watchdog->Reset();
+}
+
+/**
+ * Records the time since the previous epoch (or the start of the loop) as the
+ * time taken by the named stage.
+ *
+ * @param name The name of the stage that just finished
+ */
+void LoopProfiler::AddEpoch(llvm::StringRef name) {
+  double now = Timer::GetFPGATimestamp();
+  double time = now - m_epochStart;
+  m_epochStart = now;
+
+  auto stage = std::find_if(m_stages.begin(), m_stages.end(),
+                            [&](const Stage& s) { return s.name == name; });
+  if (stage == m_stages.end()) {
+    m_stages.emplace_back();
+    stage = m_stages.end() - 1;
+    stage->name = name;
+    m_stagesChanged = true;
+  }
+  stage->time = time;
+  stage->maxTime = std::max(stage->maxTime, time);
+
+  if (m_watchdog) m_watchdog->AddEpoch(name, time);
+}
+
+/**
+ * Marks the end of a loop iteration, updating the loop statistics and
+ * publishing them.
+ */
+void LoopProfiler::EndLoop() {
+  if (m_watchdog) m_watchdog->Disable();
+  m_loopTime = Timer::GetFPGATimestamp() - m_loopStart;
+  m_maxLoopTime = std::max(m_maxLoopTime, m_loopTime);
+  m_loopCount++;
+
+  int bucket = m_period > 0
+                   ? static_cast<int>(m_loopTime / (m_period / 4))
+                   : kHistogramBuckets - 1;
+  m_histogram[std::min(bucket, kHistogramBuckets - 1)]++;
+
+  if (m_loopTime > m_period) {
+    m_overrunCount++;
+    Tracing::ReportOverrun();
+    if (m_reportOverruns &&
+        m_loopStart - m_lastOverrunReport >= kOverrunReportInterval) {
+      m_lastOverrunReport = m_loopStart;
+      ReportOverrun();
+    }
+  }
+
+  Publish();
+}
+
+/**
+ * Returns the time the latest loop iteration took, in seconds.
+ */
+double LoopProfiler::GetLoopTime() const { return m_loopTime; }
+
+/**
+ * Returns the longest time a loop iteration has taken since the profiler was
+ * created or reset, in seconds.
+ */
+double LoopProfiler::GetMaxLoopTime() const { return m_maxLoopTime; }
+
+/**
+ * Returns the time the named stage took in the latest loop iteration, in
+ * seconds, or 0 if no such stage has been recorded.
+ */
+double LoopProfiler::GetStageTime(llvm::StringRef name) const {
+  const Stage* stage = FindStage(name);
+  return stage ? stage->time : 0.0;
+}
+
+/**
+ * Returns the longest time the named stage has taken since the profiler was
+ * created or reset, in seconds.
+ */
+double LoopProfiler::GetMaxStageTime(llvm::StringRef name) const {
+  const Stage* stage = FindStage(name);
+  return stage ? stage->maxTime : 0.0;
+}
+
+uint64_t LoopProfiler::GetLoopCount() const { return m_loopCount; }
+
+/**
+ * Returns the number of loop iterations that took longer than the period.
+ */
+uint64_t LoopProfiler::GetOverrunCount() const { return m_overrunCount; }
+
+/**
+ * Returns the number of loop iterations whose time fell in each quarter of a
+ * period. The last bucket counts every iteration of 1.75 periods or longer.
+ */
+std::array<uint64_t, LoopProfiler::kHistogramBuckets>
+LoopProfiler::GetHistogram() const {
+  return m_histogram;
+}
+
+/**
+ * Clears the counters, the histogram and the maximum times.
+ */
+void LoopProfiler::Reset() {
+  m_maxLoopTime = 0;
+  m_loopCount = 0;
+  m_overrunCount = 0;
+  m_histogram.fill(0);
+  for (auto& stage : m_stages) stage.maxTime = 0;
+}
+
+const LoopProfiler::Stage* LoopProfiler::FindStage(llvm::StringRef name) const {
+  for (const auto& stage : m_stages) {
+    if (stage.name == name) return &stage;
+  }
+  return nullptr;
+}
+
+void LoopProfiler::ReportOverrun() const {
+  llvm::SmallString<256> buf;
+  llvm::raw_svector_ostream msg(buf);
+  msg << "Loop time of " << m_period << "s overrun (" << m_loopTime << "s):";
+  for (const auto& stage : m_stages) {
+    msg << " " << stage.name << " " << stage.time << "s;";
+  }
+  DriverStation::ReportWarning(msg.str());
+}
+
+void LoopProfiler::Publish() {
+  detail::SetTelemetryValue(m_loopTimeEntry, nt::Value::MakeDouble(m_loopTime));
+  detail::SetTelemetryValue(m_maxLoopTimeEntry,
+                            nt::Value::MakeDouble(m_maxLoopTime));
+  detail::SetTelemetryValue(m_overrunsEntry,
+                            nt::Value::MakeDouble(m_overrunCount));
+
+  if (m_stagesChanged) {
+    m_stageNames.resize(0);
+    for (const auto& stage : m_stages) m_stageNames.push_back(stage.name);
+    detail::SetTelemetryValue(m_stageNamesEntry,
+                              nt::Value::MakeStringArray(m_stageNames));
+    m_stagesChanged = false;
+  }
+
+  m_stageTimes.resize(m_stages.size());
+  for (size_t i = 0; i < m_stages.size(); i++) {
+    m_stageTimes[i] = m_stages[i].time;
+  }
+  detail::SetTelemetryValue(m_stageTimesEntry,
+                            nt::Value::MakeDoubleArray(m_stageTimes));
+
+  for (int i = 0; i < kHistogramBuckets; i++) {
+    m_histogramValues[i] = m_histogram[i];
+  }
+  detail::SetTelemetryValue(m_histogramEntry,
+                            nt::Value::MakeDoubleArray(m_histogramValues));
+}
@@ -0,0 +1,236 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "MotionProfile/DrivePath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "ErrorBase.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+// Points each spline is sampled at to measure it
+static constexpr int kSamplesPerSegment = 200;
+
+namespace {
+// A point along the path, at arc length distance from the start
+struct PathPoint {
+  double distance;
+  double x;
+  double y;
+  double heading;
+  double curvature;
+  // the distance travelled by each side of the drivetrain
+  double left;
+  double right;
+  // the speed along the path
+  double velocity;
+  double time;
+};
+}  // namespace
+
+// Samples the cubic Hermite spline from a to b, whose tangents are the
+// waypoint headings scaled by the distance between the waypoints
+static void SampleSegment(const Waypoint& a, const Waypoint& b, bool first,
+                          std::vector<PathPoint>& points) {
+  double scale = std::hypot(b.x - a.x, b.y - a.y);
+  double ax = std::cos(a.heading) * scale, ay = std::sin(a.heading) * scale;
+  double bx = std::cos(b.heading) * scale, by = std::sin(b.heading) * scale;
+  for (int i = first ? 0 : 1; i <= kSamplesPerSegment; i++) {
+    double u = static_cast<double>(i) / kSamplesPerSegment;
+    double u2 = u * u, u3 = u2 * u;
+    // Hermite basis functions and their first and second derivatives
+    double h00 = 2 * u3 - 3 * u2 + 1, h10 = u3 - 2 * u2 + u;
+    double h01 = -2 * u3 + 3 * u2, h11 = u3 - u2;
+    double d00 = 6 * u2 - 6 * u, d10 = 3 * u2 - 4 * u + 1;
+    double d01 = -6 * u2 + 6 * u, d11 = 3 * u2 - 2 * u;
+    double s00 = 12 * u - 6, s10 = 6 * u - 4;
+    double s01 = -12 * u + 6, s11 = 6 * u - 2;
+
+    PathPoint point{};
+    point.x = h00 * a.x + h10 * ax + h01 * b.x + h11 * bx;
+    point.y = h00 * a.y + h10 * ay + h01 * b.y + h11 * by;
+    double dx = d00 * a.x + d10 * ax + d01 * b.x + d11 * bx;
+    double dy = d00 * a.y + d10 * ay + d01 * b.y + d11 * by;
+    double ddx = s00 * a.x + s10 * ax + s01 * b.x + s11 * bx;
+    double ddy = s00 * a.y + s10 * ay + s01 * b.y + s11 * by;
+    double speed2 = dx * dx + dy * dy;
+    point.heading = std::atan2(dy, dx);
+    point.curvature =
+        speed2 > 0 ? (dx * ddy - dy * ddx) / (speed2 * std::sqrt(speed2)) : 0;
+    points.push_back(point);
+  }
+}
+
+static double Lerp(double a, double b, double fraction) {
+  return a + (b - a) * fraction;
+}
+
+/**
+ * Generates a path through waypoints.
+ *
+ * @param waypoints       The poses to pass through, at least two
+ * @param trackWidth      The distance between the left and right wheels
+ * @param maxVelocity     The maximum velocity of either side, in distance
+ *                        units per second
+ * @param maxAcceleration The maximum acceleration along the path, in distance
+ *                        units per second squared
+ * @param period          The time between setpoints, in seconds
+ */
+DrivePath DrivePath::Generate(llvm::ArrayRef<Waypoint> waypoints,
+                              double trackWidth, double maxVelocity,
+                              double maxAcceleration, double period) {
+  if (waypoints.size() < 2) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange,
+                                     "a path needs two waypoints");
+    return {};
+  }
+  if (trackWidth < 0 || maxVelocity <= 0 || maxAcceleration <= 0 ||
+      period <= 0) {
+    wpi_setGlobalWPIErrorWithContext(
+        ParameterOutOfRange,
+        "drive path constraints and period must be positive");
+    return {};
+  }
+
+  std::vector<PathPoint> points;
+  points.reserve((waypoints.size() - 1) * kSamplesPerSegment + 1);
+  for (size_t i = 0; i + 1 < waypoints.size(); i++) {
+    SampleSegment(waypoints[i], waypoints[i + 1], i == 0, points);
+  }
+
+  // Measure the path and each side, and unwrap the headings
+  double halfWidth = trackWidth / 2;
+  for (size_t i = 1; i < points.size(); i++) {
+    PathPoint& p = points[i];
+    const PathPoint& prev = points[i - 1];
+    double ds = std::hypot(p.x - prev.x, p.y - prev.y);
+    double curvature = (p.curvature + prev.curvature) / 2;
+    p.distance = prev.distance + ds;
+    p.left = prev.left + ds * (1 - curvature * halfWidth);
+    p.right = prev.right + ds * (1 + curvature * halfWidth);
+    p.heading = prev.heading + std::remainder(p.heading - prev.heading,
+                                              2 * 3.14159265358979323846);
+  }
+
+  // Limit the speed so the outer side stays within the maximum velocity,
+  // then accelerate forward from rest and backward from the final rest
+  for (auto& p : points) {
+    p.velocity = maxVelocity / (1 + std::abs(p.curvature) * halfWidth);
+  }
+  points.front().velocity = 0;
+  points.back().velocity = 0;
+  for (size_t i = 1; i < points.size(); i++) {
+    double ds = points[i].distance - points[i - 1].distance;
+    points[i].velocity = std::min(
+        points[i].velocity,
+        std::sqrt(points[i - 1].velocity * points[i - 1].velocity +
+                  2 * maxAcceleration * ds));
+  }
+  for (size_t i = points.size() - 1; i-- > 0;) {
+    double ds = points[i + 1].distance - points[i].distance;
+    points[i].velocity = std::min(
+        points[i].velocity,
+        std::sqrt(points[i + 1].velocity * points[i + 1].velocity +
+                  2 * maxAcceleration * ds));
+  }
+  for (size_t i = 1; i < points.size(); i++) {
+    double ds = points[i].distance - points[i - 1].distance;
+    double v = (points[i].velocity + points[i - 1].velocity) / 2;
+    points[i].time = points[i - 1].time + (v > 0 ? ds / v : 0);
+  }
+
+  // Resample at the period
+  DrivePath path;
+  path.m_period = period;
+  path.m_length = points.back().distance;
+  double duration = points.back().time;
+  size_t count = static_cast<size_t>(std::ceil(duration / period)) + 1;
+  path.m_setpoints.reserve(count);
+  size_t segment = 0;
+  for (size_t k = 0; k < count; k++) {
+    double t = std::min(k * period, duration);
+    while (segment + 2 < points.size() && points[segment + 1].time <= t) {
+      segment++;
+    }
+    const PathPoint& a = points[segment];
+    const PathPoint& b = points[segment + 1];
+    double span = b.time - a.time;
+    double f = span > 0 ? std::min(1.0, (t - a.time) / span) : 1.0;
+    double velocity = Lerp(a.velocity, b.velocity, f);
+    double curvature = Lerp(a.curvature, b.curvature, f);
+
+    DrivePathSetpoint setpoint;
+    setpoint.x = Lerp(a.x, b.x, f);
+    setpoint.y = Lerp(a.y, b.y, f);
+    setpoint.heading = Lerp(a.heading, b.heading, f);
+    setpoint.left.position = Lerp(a.left, b.left, f);
+    setpoint.right.position = Lerp(a.right, b.right, f);
+    setpoint.left.velocity = velocity * (1 - curvature * halfWidth);
+    setpoint.right.velocity = velocity * (1 + curvature * halfWidth);
+    path.m_setpoints.push_back(setpoint);
+  }
+  path.m_setpoints.back().left.velocity = 0;
+  path.m_setpoints.back().right.velocity = 0;
+
+  // Accelerations from the change in velocity around each setpoint
+  auto& setpoints = path.m_setpoints;
+  for (size_t k = 0; k < setpoints.size(); k++) {
+    size_t prev = k > 0 ? k - 1 : k;
+    size_t next = k + 1 < setpoints.size() ? k + 1 : k;
+    double dt = (next - prev) * period;
+    if (dt == 0) continue;
+    setpoints[k].left.acceleration =
+        (setpoints[next].left.velocity - setpoints[prev].left.velocity) / dt;
+    setpoints[k].right.acceleration =
+        (setpoints[next].right.velocity - setpoints[prev].right.velocity) /
+        dt;
+  }
+  return path;
+}
+
+/**
+ * Generates a path on a new thread.
+ *
+ * @see Generate()
+ */
+std::future<DrivePath> DrivePath::GenerateAsync(std::vector<Waypoint> waypoints,
+                                                double trackWidth,
+                                                double maxVelocity,
+                                                double maxAcceleration,
+                                                double period) {
+  // std::async moves the waypoints into the new thread's state
+  return std::async(std::launch::async, &DrivePath::Generate,
+                    std::move(waypoints), trackWidth, maxVelocity,
+                    maxAcceleration, period);
+}
+
+/**
+ * Returns the time between setpoints, in seconds.
+ */
+double DrivePath::GetPeriod() const { return m_period; }
+
+/**
+ * Returns the time from the first setpoint to the last, in seconds.
+ */
+double DrivePath::GetDuration() const {
+  return m_setpoints.empty() ? 0 : (m_setpoints.size() - 1) * m_period;
+}
+
+/**
+ * Returns the length of the path through the robot center.
+ */
+double DrivePath::GetLength() const { return m_length; }
+
+size_t DrivePath::GetSize() const { return m_setpoints.size(); }
+
+llvm::ArrayRef<DrivePathSetpoint> DrivePath::GetSetpoints() const {
+  return m_setpoints;
+}
@@ -0,0 +1,241 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "MotionProfile/MappedTrajectory.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+#include "ErrorBase.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+namespace {
+struct RawHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t type;
+  uint32_t count;
+  double period;
+  double length;
+};
+
+template <typename Profile>
+struct TrajectoryTraits;
+
+template <>
+struct TrajectoryTraits<MotionProfile> {
+  static constexpr uint32_t kType = 1;
+  static double GetLength(const MotionProfile& profile) {
+    auto setpoints = profile.GetSetpoints();
+    return setpoints.empty() ? 0 : setpoints.back().position;
+  }
+};
+
+template <>
+struct TrajectoryTraits<DrivePath> {
+  static constexpr uint32_t kType = 2;
+  static double GetLength(const DrivePath& path) { return path.GetLength(); }
+};
+}  // namespace
+
+// Setpoints are read from the file as they are laid out in memory
+static_assert(sizeof(RawHeader) == 32, "trajectory header must be 32 bytes");
+static_assert(sizeof(MotionSetpoint) == 3 * sizeof(double) &&
+                  std::is_standard_layout<MotionSetpoint>::value,
+              "MotionSetpoint must be three packed doubles");
+static_assert(sizeof(DrivePathSetpoint) == 9 * sizeof(double) &&
+                  std::is_standard_layout<DrivePathSetpoint>::value,
+              "DrivePathSetpoint must be nine packed doubles");
+
+static const char kMagic[4] = {'F', 'R', 'C', 'T'};
+
+template <typename Profile>
+constexpr uint32_t MappedTrajectory<Profile>::kVersion;
+
+/**
+ * Maps a trajectory file written by Write().
+ *
+ * @param path The trajectory file
+ * @return The trajectory, or null if the file can't be read or is corrupt
+ */
+template <typename Profile>
+std::shared_ptr<const MappedTrajectory<Profile>>
+MappedTrajectory<Profile>::Load(llvm::StringRef path) {
+  std::shared_ptr<MappedTrajectory> trajectory(new MappedTrajectory);
+  if (!trajectory->Map(path.str())) {
+    wpi_setGlobalWPIErrorWithContext(TrajectoryFileError,
+                                     path + ": " + std::strerror(errno));
+    return nullptr;
+  }
+
+  auto header = reinterpret_cast<const RawHeader*>(trajectory->m_data);
+  if (trajectory->m_size < sizeof(RawHeader) ||
+      std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion ||
+      header->type != TrajectoryTraits<Profile>::kType ||
+      sizeof(RawHeader) + uint64_t{header->count} * sizeof(Setpoint) !=
+          trajectory->m_size ||
+      !(header->period > 0)) {
+    wpi_setGlobalWPIErrorWithContext(TrajectoryFileError, path);
+    return nullptr;
+  }
+
+  trajectory->m_period = header->period;
+  trajectory->m_length = header->length;
+  trajectory->m_setpoints = llvm::ArrayRef<Setpoint>(
+      reinterpret_cast<const Setpoint*>(trajectory->m_data +
+                                        sizeof(RawHeader)),
+      header->count);
+  return trajectory;
+}
+
+/**
+ * Writes a profile to a trajectory file for Load().
+ *
+ * The file is written to path + ".tmp", then renamed to the path, so a
+ * program loading it sees either the old file or the new one.
+ *
+ * @param path    The trajectory file
+ * @param profile The profile to write
+ * @return False, with errno set, if the file could not be written
+ */
+template <typename Profile>
+bool MappedTrajectory<Profile>::Write(llvm::StringRef path,
+                                      const Profile& profile) {
+  auto setpoints = profile.GetSetpoints();
+  RawHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.type = TrajectoryTraits<Profile>::kType;
+  header.count = setpoints.size();
+  header.period = profile.GetPeriod();
+  header.length = TrajectoryTraits<Profile>::GetLength(profile);
+
+  std::string tempPath = path.str() + ".tmp";
+  std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+  if (!file) return false;
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+            std::fwrite(setpoints.data(), sizeof(Setpoint), setpoints.size(),
+                        file) == setpoints.size() &&
+            std::fflush(file) == 0;
+  int err = errno;
+  std::fclose(file);
+  if (!ok) {
+    std::remove(tempPath.c_str());
+    errno = err;
+    return false;
+  }
+#ifdef _WIN32
+  // rename() doesn't replace an existing file on Windows
+  std::remove(path.str().c_str());
+#endif
+  return std::rename(tempPath.c_str(), path.str().c_str()) == 0;
+}
+
+template <typename Profile>
+MappedTrajectory<Profile>::~MappedTrajectory() {
+#ifndef _WIN32
+  if (m_data) ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+}
+
+/**
+ * Returns the time between setpoints, in seconds.
+ */
+template <typename Profile>
+double MappedTrajectory<Profile>::GetPeriod() const {
+  return m_period;
+}
+
+/**
+ * Returns the time from the first setpoint to the last, in seconds.
+ */
+template <typename Profile>
+double MappedTrajectory<Profile>::GetDuration() const {
+  return m_setpoints.empty() ? 0 : (m_setpoints.size() - 1) * m_period;
+}
+
+/**
+ * Returns the distance covered by the profile, or the length of the path
+ * through the robot center.
+ */
+template <typename Profile>
+double MappedTrajectory<Profile>::GetLength() const {
+  return m_length;
+}
+
+template <typename Profile>
+size_t MappedTrajectory<Profile>::GetSize() const {
+  return m_setpoints.size();
+}
+
+template <typename Profile>
+llvm::ArrayRef<typename MappedTrajectory<Profile>::Setpoint>
+MappedTrajectory<Profile>::GetSetpoints() const {
+  return m_setpoints;
+}
+
+template <typename Profile>
+bool MappedTrajectory<Profile>::Map(const std::string& path) {
+#ifndef _WIN32
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    int err = errno;
+    ::close(fd);
+    errno = err;
+    return false;
+  }
+  m_size = st.st_size;
+  // An empty file can't be mapped, and is rejected by Load()
+  if (m_size > 0) {
+    void* data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      int err = errno;
+      ::close(fd);
+      errno = err;
+      return false;
+    }
+    m_data = static_cast<const uint8_t*>(data);
+  }
+  ::close(fd);
+#else
+  // No mmap; read the file into memory instead
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) return false;
+  uint8_t buf[4096];
+  size_t count;
+  while ((count = std::fread(buf, 1, sizeof(buf), file)) > 0) {
+    m_buffer.insert(m_buffer.end(), buf, buf + count);
+  }
+  bool failed = std::ferror(file);
+  std::fclose(file);
+  if (failed) return false;
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+#endif
+  return true;
+}
+
+namespace frc {
+template class MappedTrajectory<MotionProfile>;
+template class MappedTrajectory<DrivePath>;
+}  // namespace frc
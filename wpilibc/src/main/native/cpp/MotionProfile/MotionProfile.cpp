@@ -0,0 +1,254 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "MotionProfile/MotionProfile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "ErrorBase.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+namespace {
+// The times and peak velocity of a rest to rest trapezoid profile covering
+// a positive distance
+struct TrapezoidShape {
+  TrapezoidShape(double distance, double maxVelocity, double maxAcceleration)
+      : distance(distance), acceleration(maxAcceleration) {
+    accelTime = maxVelocity / maxAcceleration;
+    if (distance < maxVelocity * accelTime) {
+      // Never reaches the maximum velocity
+      accelTime = std::sqrt(distance / maxAcceleration);
+      peakVelocity = maxAcceleration * accelTime;
+      cruiseTime = 0;
+    } else {
+      peakVelocity = maxVelocity;
+      cruiseTime = (distance - maxVelocity * accelTime) / maxVelocity;
+    }
+    totalTime = 2 * accelTime + cruiseTime;
+  }
+
+  MotionSetpoint Calculate(double t) const {
+    MotionSetpoint setpoint;
+    if (t < accelTime) {
+      setpoint.acceleration = acceleration;
+      setpoint.velocity = acceleration * t;
+      setpoint.position = 0.5 * acceleration * t * t;
+    } else if (t < accelTime + cruiseTime) {
+      setpoint.velocity = peakVelocity;
+      setpoint.position = 0.5 * acceleration * accelTime * accelTime +
+                          peakVelocity * (t - accelTime);
+    } else if (t < totalTime) {
+      double remaining = totalTime - t;
+      setpoint.acceleration = -acceleration;
+      setpoint.velocity = acceleration * remaining;
+      setpoint.position =
+          distance - 0.5 * acceleration * remaining * remaining;
+    } else {
+      setpoint.position = distance;
+    }
+    return setpoint;
+  }
+
+  double distance;
+  double acceleration;
+  double accelTime;
+  double cruiseTime;
+  double peakVelocity;
+  double totalTime;
+};
+}  // namespace
+
+static bool CheckConstraints(double maxVelocity, double maxAcceleration,
+                             double period) {
+  if (maxVelocity <= 0 || maxAcceleration <= 0 || period <= 0) {
+    wpi_setGlobalWPIErrorWithContext(
+        ParameterOutOfRange,
+        "motion profile constraints and period must be positive");
+    return false;
+  }
+  return true;
+}
+
+static std::vector<MotionSetpoint> SampleTrapezoid(
+    const TrapezoidShape& profile, double period) {
+  size_t count =
+      static_cast<size_t>(std::ceil(profile.totalTime / period)) + 1;
+  std::vector<MotionSetpoint> setpoints;
+  setpoints.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    setpoints.push_back(profile.Calculate(i * period));
+  }
+  return setpoints;
+}
+
+static void Negate(std::vector<MotionSetpoint>& setpoints) {
+  for (auto& setpoint : setpoints) {
+    setpoint.position = -setpoint.position;
+    setpoint.velocity = -setpoint.velocity;
+    setpoint.acceleration = -setpoint.acceleration;
+  }
+}
+
+/**
+ * Creates a profile from setpoints sampled every period.
+ *
+ * @param period    The time between setpoints, in seconds
+ * @param setpoints The setpoints, the first at time 0
+ */
+MotionProfile::MotionProfile(double period,
+                             std::vector<MotionSetpoint> setpoints)
+    : m_period(period), m_setpoints(std::move(setpoints)) {}
+
+/**
+ * Generates a trapezoidal profile: constant acceleration up to the maximum
+ * velocity, a cruise, then constant deceleration to a stop.
+ *
+ * @param distance        The distance to move; may be negative
+ * @param maxVelocity     The maximum velocity, in distance units per second
+ * @param maxAcceleration The maximum acceleration, in distance units per
+ *                        second squared
+ * @param period          The time between setpoints, in seconds
+ */
+MotionProfile MotionProfile::Trapezoid(double distance, double maxVelocity,
+                                       double maxAcceleration, double period) {
+  if (!CheckConstraints(maxVelocity, maxAcceleration, period)) return {};
+  TrapezoidShape shape(std::abs(distance), maxVelocity, maxAcceleration);
+  auto setpoints = SampleTrapezoid(shape, period);
+  if (distance < 0) Negate(setpoints);
+  return MotionProfile(period, std::move(setpoints));
+}
+
+/**
+ * Generates an S-curve profile, which also limits jerk so the acceleration
+ * ramps up and down rather than stepping.
+ *
+ * The profile is the trapezoidal profile smoothed with a moving average as
+ * long as the time to ramp to the maximum acceleration. Averaging keeps the
+ * velocity and acceleration within their limits and the final position
+ * exact, at the cost of taking that much longer than the trapezoid.
+ *
+ * @param distance        The distance to move; may be negative
+ * @param maxVelocity     The maximum velocity, in distance units per second
+ * @param maxAcceleration The maximum acceleration, in distance units per
+ *                        second squared
+ * @param maxJerk         The maximum jerk, in distance units per second cubed
+ * @param period          The time between setpoints, in seconds
+ */
+MotionProfile MotionProfile::SCurve(double distance, double maxVelocity,
+                                    double maxAcceleration, double maxJerk,
+                                    double period) {
+  if (!CheckConstraints(maxVelocity, maxAcceleration, period)) return {};
+  if (maxJerk <= 0) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "maxJerk");
+    return {};
+  }
+  TrapezoidShape shape(std::abs(distance), maxVelocity, maxAcceleration);
+  auto trapezoid = SampleTrapezoid(shape, period);
+
+  size_t window = std::max<size_t>(
+      1, static_cast<size_t>(std::ceil(maxAcceleration / maxJerk / period)));
+  const MotionSetpoint& last = trapezoid.back();
+  std::vector<MotionSetpoint> setpoints;
+  setpoints.reserve(trapezoid.size() + window - 1);
+  // Running sums over the window; samples before the start are at rest at 0
+  // and samples after the end at rest at the target
+  MotionSetpoint sum;
+  for (size_t i = 0; i < trapezoid.size() + window - 1; i++) {
+    const MotionSetpoint& in = i < trapezoid.size() ? trapezoid[i] : last;
+    sum.position += in.position;
+    sum.velocity += in.velocity;
+    sum.acceleration += in.acceleration;
+    if (i >= window) {
+      const MotionSetpoint& out = trapezoid[i - window];
+      sum.position -= out.position;
+      sum.velocity -= out.velocity;
+      sum.acceleration -= out.acceleration;
+    }
+    MotionSetpoint setpoint;
+    setpoint.position = sum.position / window;
+    setpoint.velocity = sum.velocity / window;
+    setpoint.acceleration = sum.acceleration / window;
+    setpoints.push_back(setpoint);
+  }
+  // Remove the rounding left in the running sums
+  setpoints.back() = last;
+  if (distance < 0) Negate(setpoints);
+  return MotionProfile(period, std::move(setpoints));
+}
+
+/**
+ * Generates a trapezoidal profile on a new thread.
+ *
+ * @see Trapezoid()
+ */
+std::future<MotionProfile> MotionProfile::TrapezoidAsync(
+    double distance, double maxVelocity, double maxAcceleration,
+    double period) {
+  return std::async(std::launch::async, [=] {
+    return Trapezoid(distance, maxVelocity, maxAcceleration, period);
+  });
+}
+
+/**
+ * Generates an S-curve profile on a new thread.
+ *
+ * @see SCurve()
+ */
+std::future<MotionProfile> MotionProfile::SCurveAsync(double distance,
+                                                      double maxVelocity,
+                                                      double maxAcceleration,
+                                                      double maxJerk,
+                                                      double period) {
+  return std::async(std::launch::async, [=] {
+    return SCurve(distance, maxVelocity, maxAcceleration, maxJerk, period);
+  });
+}
+
+/**
+ * Returns the time between setpoints, in seconds.
+ */
+double MotionProfile::GetPeriod() const { return m_period; }
+
+/**
+ * Returns the time from the first setpoint to the last, in seconds.
+ */
+double MotionProfile::GetDuration() const {
+  return m_setpoints.empty() ? 0 : (m_setpoints.size() - 1) * m_period;
+}
+
+size_t MotionProfile::GetSize() const { return m_setpoints.size(); }
+
+llvm::ArrayRef<MotionSetpoint> MotionProfile::GetSetpoints() const {
+  return m_setpoints;
+}
+
+/**
+ * Returns the setpoint at a time, interpolating between the two setpoints
+ * around it. Times outside the profile give its first or last setpoint.
+ *
+ * @param time The time since the start of the profile, in seconds
+ */
+MotionSetpoint MotionProfile::Sample(double time) const {
+  if (m_setpoints.empty()) return {};
+  double index = time / m_period;
+  if (index <= 0) return m_setpoints.front();
+  if (index >= m_setpoints.size() - 1) return m_setpoints.back();
+  size_t i = static_cast<size_t>(index);
+  double fraction = index - i;
+  const MotionSetpoint& a = m_setpoints[i];
+  const MotionSetpoint& b = m_setpoints[i + 1];
+  MotionSetpoint setpoint;
+  setpoint.position = a.position + (b.position - a.position) * fraction;
+  setpoint.velocity = a.velocity + (b.velocity - a.velocity) * fraction;
+  setpoint.acceleration =
+      a.acceleration + (b.acceleration - a.acceleration) * fraction;
+  return setpoint;
+}
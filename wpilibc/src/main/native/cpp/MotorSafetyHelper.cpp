@@ -7,8 +7,11 @@
 
 #include "MotorSafetyHelper.h"
 
+#include <algorithm>
+
 #include <llvm/SmallString.h>
 #include <llvm/raw_ostream.h>
+#include <support/mutex.h>
 
 #include "DriverStation.h"
 #include "MotorSafety.h"
@@ -17,8 +20,39 @@
 
 using namespace frc;
 
-std::set<MotorSafetyHelper*> MotorSafetyHelper::m_helperList;
-wpi::mutex MotorSafetyHelper::m_listMutex;
+struct MotorSafetyHelper::Slot {
+  // The FPGA clock value when this motor has expired
+  std::atomic<double> stopTime{0};
+
+  // True if motor safety is enabled for this motor
+  std::atomic<bool> enabled{false};
+
+  // The helper owning the slot, or nullptr if the slot is free. Guarded by
+  // GetSlotMutex(), which CheckMotors() holds while it checks the helper.
+  MotorSafetyHelper* helper = nullptr;
+};
+
+// Guards claiming and releasing slots
+static wpi::mutex& GetSlotMutex() {
+  static wpi::mutex mutex;
+  return mutex;
+}
+
+// One past the highest slot ever claimed
+static std::atomic<size_t>& GetSlotsEnd() {
+  static std::atomic<size_t> end{0};
+  return end;
+}
+
+MotorSafetyHelper::Slot* MotorSafetyHelper::GetSlots() {
+  static Slot slots[kMaxHelpers];
+  return slots;
+}
+
+std::vector<MotorSafetyHelper::Slot*>& MotorSafetyHelper::GetOverflowSlots() {
+  static std::vector<Slot*> slots;
+  return slots;
+}
 
 /**
  * The constructor for a MotorSafetyHelper object.
@@ -33,18 +67,44 @@ wpi::mutex MotorSafetyHelper::m_listMutex;
  *                   This is used to call the Stop() method on the motor.
  */
 MotorSafetyHelper::MotorSafetyHelper(MotorSafety* safeObject)
-    : m_safeObject(safeObject) {
-  m_enabled = false;
-  m_expiration = DEFAULT_SAFETY_EXPIRATION;
-  m_stopTime = Timer::GetFPGATimestamp();
+    : m_expiration(DEFAULT_SAFETY_EXPIRATION),
+      m_slot(nullptr),
+      m_safeObject(safeObject) {
+  std::lock_guard<wpi::mutex> lock(GetSlotMutex());
+  Slot* slots = GetSlots();
+  auto& slotsEnd = GetSlotsEnd();
+  size_t end = slotsEnd.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < end; i++) {
+    if (slots[i].helper == nullptr) {
+      m_slot = &slots[i];
+      break;
+    }
+  }
+  if (m_slot == nullptr && end < kMaxHelpers) {
+    // A new slot is disabled, so CheckMotors() skips it until it is set up
+    m_slot = &slots[end];
+    slotsEnd.store(end + 1, std::memory_order_release);
+  }
+  if (m_slot == nullptr) {
+    m_ownSlot = std::make_unique<Slot>();
+    m_slot = m_ownSlot.get();
+    GetOverflowSlots().push_back(m_slot);
+  }
 
-  std::lock_guard<wpi::mutex> lock(m_listMutex);
-  m_helperList.insert(this);
+  m_slot->enabled.store(false, std::memory_order_relaxed);
+  m_slot->stopTime.store(Timer::GetFastTimestamp(), std::memory_order_relaxed);
+  m_slot->helper = this;
 }
 
 MotorSafetyHelper::~MotorSafetyHelper() {
-  std::lock_guard<wpi::mutex> lock(m_listMutex);
-  m_helperList.erase(this);
+  std::lock_guard<wpi::mutex> lock(GetSlotMutex());
+  m_slot->enabled.store(false, std::memory_order_relaxed);
+  m_slot->helper = nullptr;
+  if (m_ownSlot) {
+    auto& overflow = GetOverflowSlots();
+    overflow.erase(std::remove(overflow.begin(), overflow.end(), m_slot),
+                   overflow.end());
+  }
 }
 
 /**
@@ -53,8 +113,9 @@ MotorSafetyHelper::~MotorSafetyHelper() {
  * Resets the timer on this object that is used to do the timeouts.
  */
 void MotorSafetyHelper::Feed() {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_stopTime = Timer::GetFPGATimestamp() + m_expiration;
+  m_slot->stopTime.store(
+      Timer::GetFastTimestamp() + m_expiration.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
 }
 
 /**
@@ -63,8 +124,7 @@ void MotorSafetyHelper::Feed() {
  * @param expirationTime The timeout value in seconds.
  */
 void MotorSafetyHelper::SetExpiration(double expirationTime) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_expiration = expirationTime;
+  m_expiration.store(expirationTime, std::memory_order_relaxed);
 }
 
 /**
@@ -73,8 +133,7 @@ void MotorSafetyHelper::SetExpiration(double expirationTime) {
  * @return the timeout value in seconds.
  */
 double MotorSafetyHelper::GetExpiration() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_expiration;
+  return m_expiration.load(std::memory_order_relaxed);
 }
 
 /**
@@ -84,8 +143,9 @@ double MotorSafetyHelper::GetExpiration() const {
  * timed out.
  */
 bool MotorSafetyHelper::IsAlive() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return !m_enabled || m_stopTime > Timer::GetFPGATimestamp();
+  return !m_slot->enabled.load(std::memory_order_relaxed) ||
+         m_slot->stopTime.load(std::memory_order_relaxed) >
+             Timer::GetFastTimestamp();
 }
 
 /**
@@ -96,19 +156,13 @@ bool MotorSafetyHelper::IsAlive() const {
  * shut down until its value is updated again.
  */
 void MotorSafetyHelper::Check() {
-  bool enabled;
-  double stopTime;
-
-  {
-    std::lock_guard<wpi::mutex> lock(m_thisMutex);
-    enabled = m_enabled;
-    stopTime = m_stopTime;
-  }
+  bool enabled = m_slot->enabled.load(std::memory_order_relaxed);
+  double stopTime = m_slot->stopTime.load(std::memory_order_relaxed);
 
   DriverStation& ds = DriverStation::GetInstance();
   if (!enabled || ds.IsDisabled() || ds.IsTest()) return;
 
-  if (stopTime < Timer::GetFPGATimestamp()) {
+  if (stopTime < Timer::GetFastTimestamp()) {
     llvm::SmallString<128> buf;
     llvm::raw_svector_ostream desc(buf);
     m_safeObject->GetDescription(desc);
@@ -126,8 +180,7 @@ void MotorSafetyHelper::Check() {
  * @param enabled True if motor safety is enforced for this object
  */
 void MotorSafetyHelper::SetSafetyEnabled(bool enabled) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_enabled = enabled;
+  m_slot->enabled.store(enabled, std::memory_order_relaxed);
 }
 
 /**
@@ -138,8 +191,7 @@ void MotorSafetyHelper::SetSafetyEnabled(bool enabled) {
  * @return True if motor safety is enforced for this device
  */
 bool MotorSafetyHelper::IsSafetyEnabled() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_enabled;
+  return m_slot->enabled.load(std::memory_order_relaxed);
 }
 
 /**
@@ -147,10 +199,34 @@ bool MotorSafetyHelper::IsSafetyEnabled() const {
  *
  * This static method is called periodically to poll all the motors and stop any
  * that have timed out.
+ *
+ * The stop times of all motors are kept in one array that is scanned without
+ * locking; only a motor that has timed out is locked and stopped.
  */
 void MotorSafetyHelper::CheckMotors() {
-  std::lock_guard<wpi::mutex> lock(m_listMutex);
-  for (auto elem : m_helperList) {
-    elem->Check();
+  DriverStation& ds = DriverStation::GetInstance();
+  if (ds.IsDisabled() || ds.IsTest()) return;
+
+  double now = Timer::GetFastTimestamp();
+  Slot* slots = GetSlots();
+  size_t end = GetSlotsEnd().load(std::memory_order_acquire);
+  for (size_t i = 0; i < end; i++) {
+    Slot& slot = slots[i];
+    if (!slot.enabled.load(std::memory_order_relaxed) ||
+        slot.stopTime.load(std::memory_order_relaxed) >= now) {
+      continue;
+    }
+    // The mutex keeps the helper from being destroyed while it is checked
+    std::lock_guard<wpi::mutex> lock(GetSlotMutex());
+    if (slot.helper != nullptr) slot.helper->Check();
+  }
+  if (end < kMaxHelpers) return;
+
+  std::lock_guard<wpi::mutex> lock(GetSlotMutex());
+  for (Slot* slot : GetOverflowSlots()) {
+    if (slot->enabled.load(std::memory_order_relaxed) &&
+        slot->stopTime.load(std::memory_order_relaxed) < now) {
+      slot->helper->Check();
+    }
   }
 }
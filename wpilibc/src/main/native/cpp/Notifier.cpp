@@ -7,9 +7,12 @@
 
 #include "Notifier.h"
 
+#include <cmath>
+
 #include <HAL/HAL.h>
 
-#include "Timer.h"
+#include "NotifierExecutor.h"
+#include "RobotController.h"
 #include "Utility.h"
 #include "WPIErrors.h"
 
@@ -24,7 +27,7 @@ using namespace frc;
 Notifier::Notifier(TimerEventHandler handler) {
   if (handler == nullptr)
     wpi_setWPIErrorWithContext(NullParameter, "handler must not be nullptr");
-  m_handler = handler;
+  m_handler = std::make_shared<TimerEventHandler>(handler);
   int32_t status = 0;
   m_notifier = HAL_InitializeNotifier(&status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
@@ -37,26 +40,39 @@ Notifier::Notifier(TimerEventHandler handler) {
       uint64_t curTime = HAL_WaitForNotifierAlarm(notifier, &status);
       if (curTime == 0 || status != 0) break;
 
-      TimerEventHandler handler;
-      {
-        std::lock_guard<wpi::mutex> lock(m_processMutex);
-        handler = m_handler;
-        if (m_periodic) {
-          m_expirationTime += m_period;
-          UpdateAlarm();
-        }
-      }
-
-      // call callback
-      if (handler) handler();
+      ProcessAlarm();
     }
   });
 }
 
+/**
+ * Create a Notifier whose handler is run by a shared executor.
+ *
+ * No thread or HAL notifier is created for this Notifier; the executor's
+ * dispatch thread calls the handler at the notification time instead.
+ *
+ * @param executor The executor to run the handler on, usually
+ *                 NotifierExecutor::GetInstance().
+ * @param handler  The handler is called at the notification time which is set
+ *                 using StartSingle or StartPeriodic.
+ */
+Notifier::Notifier(NotifierExecutor& executor, TimerEventHandler handler) {
+  if (handler == nullptr)
+    wpi_setWPIErrorWithContext(NullParameter, "handler must not be nullptr");
+  m_handler = std::make_shared<TimerEventHandler>(handler);
+  m_executor = &executor;
+}
+
 /**
  * Free the resources for a timer event.
  */
 Notifier::~Notifier() {
+  if (m_executor) {
+    // wait for a handler call in progress on the executor to finish
+    m_executor->Cancel(this);
+    return;
+  }
+
   int32_t status = 0;
   // atomically set handle to 0, then clean
   HAL_NotifierHandle handle = m_notifier.exchange(0);
@@ -73,15 +89,38 @@ Notifier::~Notifier() {
  * Update the HAL alarm time.
  */
 void Notifier::UpdateAlarm() {
+  if (m_executor) {
+    m_executor->Schedule(this, m_expirationTime);
+    return;
+  }
+
   int32_t status = 0;
   // Return if we are being destructed, or were not created successfully
   auto notifier = m_notifier.load();
   if (notifier == 0) return;
-  HAL_UpdateNotifierAlarm(
-      notifier, static_cast<uint64_t>(m_expirationTime * 1e6), &status);
+  HAL_UpdateNotifierAlarm(notifier, m_expirationTime, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
+/**
+ * Call the handler for an expired alarm, requeueing the alarm first if this is
+ * a periodic notifier.
+ */
+void Notifier::ProcessAlarm() {
+  std::shared_ptr<TimerEventHandler> handler;
+  {
+    std::lock_guard<wpi::mutex> lock(m_processMutex);
+    handler = m_handler;
+    if (m_periodic) {
+      m_expirationTime += m_period;
+      UpdateAlarm();
+    }
+  }
+
+  // call callback
+  if (handler && *handler) (*handler)();
+}
+
 /**
  * Change the handler function.
  *
@@ -89,7 +128,7 @@ void Notifier::UpdateAlarm() {
  */
 void Notifier::SetHandler(TimerEventHandler handler) {
   std::lock_guard<wpi::mutex> lock(m_processMutex);
-  m_handler = handler;
+  m_handler = std::make_shared<TimerEventHandler>(handler);
 }
 
 /**
@@ -100,10 +139,21 @@ void Notifier::SetHandler(TimerEventHandler handler) {
  * @param delay Seconds to wait before the handler is called.
  */
 void Notifier::StartSingle(double delay) {
+  StartSingle(std::chrono::microseconds(std::llround(delay * 1e6)));
+}
+
+/**
+ * Register for single event notification.
+ *
+ * A timer event is queued for a single event after the specified delay.
+ *
+ * @param delay Time to wait before the handler is called.
+ */
+void Notifier::StartSingle(std::chrono::microseconds delay) {
   std::lock_guard<wpi::mutex> lock(m_processMutex);
   m_periodic = false;
-  m_period = delay;
-  m_expirationTime = Timer::GetFPGATimestamp() + m_period;
+  m_period = delay.count() > 0 ? delay.count() : 0;
+  m_expirationTime = RobotController::GetFPGATime() + m_period;
   UpdateAlarm();
 }
 
@@ -118,10 +168,25 @@ void Notifier::StartSingle(double delay) {
  *               after the call to this method.
  */
 void Notifier::StartPeriodic(double period) {
+  StartPeriodic(std::chrono::microseconds(std::llround(period * 1e6)));
+}
+
+/**
+ * Register for periodic event notification.
+ *
+ * A timer event is queued for periodic event notification. Each time the
+ * interrupt occurs, the event will be immediately requeued for the same time
+ * interval. Every deadline is an exact multiple of the period after the first,
+ * so the calls don't drift from the schedule however long they run.
+ *
+ * @param period Period to call the handler starting one period after the call
+ *               to this method.
+ */
+void Notifier::StartPeriodic(std::chrono::microseconds period) {
   std::lock_guard<wpi::mutex> lock(m_processMutex);
   m_periodic = true;
-  m_period = period;
-  m_expirationTime = Timer::GetFPGATimestamp() + m_period;
+  m_period = period.count() > 0 ? period.count() : 0;
+  m_expirationTime = RobotController::GetFPGATime() + m_period;
   UpdateAlarm();
 }
 
@@ -135,6 +200,11 @@ void Notifier::StartPeriodic(double period) {
  * will block until the handler call is complete.
  */
 void Notifier::Stop() {
+  if (m_executor) {
+    m_executor->Cancel(this);
+    return;
+  }
+
   int32_t status = 0;
   HAL_CancelNotifierAlarm(m_notifier, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
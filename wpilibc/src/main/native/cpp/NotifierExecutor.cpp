@@ -0,0 +1,131 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "NotifierExecutor.h"
+
+#include <HAL/HAL.h>
+
+#include "Notifier.h"
+#include "Threads.h"
+
+using namespace frc;
+
+/**
+ * Get the shared executor used by Notifiers that don't need their own.
+ */
+NotifierExecutor& NotifierExecutor::GetInstance() {
+  static NotifierExecutor instance;
+  return instance;
+}
+
+/**
+ * Create an executor with its own real-time dispatch thread.
+ *
+ * @param priority Real-time priority of the dispatch thread, 1-99.
+ */
+NotifierExecutor::NotifierExecutor(int priority) {
+  int32_t status = 0;
+  m_notifier = HAL_InitializeNotifier(&status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+
+  m_thread = std::thread([=] { ThreadMain(); });
+  SetThreadPriority(m_thread, true, priority);
+}
+
+/**
+ * Stop the dispatch thread. Notifiers still attached to the executor will no
+ * longer be called.
+ */
+NotifierExecutor::~NotifierExecutor() {
+  int32_t status = 0;
+  // atomically set handle to 0, then clean
+  HAL_NotifierHandle handle = m_notifier.exchange(0);
+  HAL_StopNotifier(handle, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+
+  // Join the thread to ensure the handlers have exited.
+  if (m_thread.joinable()) m_thread.join();
+
+  HAL_CleanNotifier(handle, &status);
+}
+
+void NotifierExecutor::Schedule(Notifier* notifier, uint64_t triggerTime) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  uint64_t sequence = ++m_nextSequence;
+  m_sequences[notifier] = sequence;
+  m_queue.push(Entry{triggerTime, notifier, sequence});
+  // The dispatch thread updates the alarm once it is done running handlers,
+  // so only touch the HAL if the new entry is the earliest deadline.
+  if (m_running == nullptr && m_queue.top().sequence == sequence) {
+    UpdateAlarm();
+  }
+}
+
+void NotifierExecutor::Cancel(Notifier* notifier) {
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  m_sequences.erase(notifier);
+  // A handler that stops its own notifier is already past rescheduling it
+  if (std::this_thread::get_id() == m_thread.get_id()) return;
+  m_runningCond.wait(lock, [&] { return m_running != notifier; });
+  // A periodic notifier reschedules itself before calling its handler, so
+  // drop the deadline a handler running during the wait may have added
+  m_sequences.erase(notifier);
+}
+
+void NotifierExecutor::UpdateAlarm() {
+  // drop stale entries so the alarm is set for a deadline that still exists
+  while (!m_queue.empty()) {
+    auto it = m_sequences.find(m_queue.top().notifier);
+    if (it != m_sequences.end() && it->second == m_queue.top().sequence) break;
+    m_queue.pop();
+  }
+
+  // Return if we are being destructed, or were not created successfully
+  auto notifier = m_notifier.load();
+  if (notifier == 0) return;
+
+  int32_t status = 0;
+  if (m_queue.empty()) {
+    HAL_CancelNotifierAlarm(notifier, &status);
+  } else {
+    HAL_UpdateNotifierAlarm(notifier, m_queue.top().triggerTime, &status);
+  }
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+void NotifierExecutor::ThreadMain() {
+  for (;;) {
+    int32_t status = 0;
+    HAL_NotifierHandle notifier = m_notifier.load();
+    if (notifier == 0) break;
+    uint64_t curTime = HAL_WaitForNotifierAlarm(notifier, &status);
+    if (curTime == 0 || status != 0) break;
+
+    std::unique_lock<wpi::mutex> lock(m_mutex);
+    while (!m_queue.empty()) {
+      Entry entry = m_queue.top();
+      if (entry.triggerTime > curTime) {
+        // Handlers take time to run, so pick up any deadlines that expired
+        // while they did before going back to sleep.
+        curTime = HAL_GetFPGATime(&status);
+        if (entry.triggerTime > curTime) break;
+      }
+      m_queue.pop();
+
+      auto it = m_sequences.find(entry.notifier);
+      if (it == m_sequences.end() || it->second != entry.sequence) continue;
+
+      m_running = entry.notifier;
+      lock.unlock();
+      entry.notifier->ProcessAlarm();
+      lock.lock();
+      m_running = nullptr;
+      m_runningCond.notify_all();
+    }
+    UpdateAlarm();
+  }
+}
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 #include <vector>
 
 #include <HAL/HAL.h>
@@ -16,7 +17,10 @@
 #include "Notifier.h"
 #include "PIDOutput.h"
 #include "PIDSource.h"
+#include "RobotController.h"
 #include "SmartDashboard/SendableBuilder.h"
+#include "Tracing.h"
+#include "WPIErrors.h"
 
 using namespace frc;
 
@@ -25,6 +29,22 @@ constexpr const T& clamp(const T& value, const T& low, const T& high) {
   return std::max(low, std::min(value, high));
 }
 
+// The latest battery voltage, from the brownout predictor's snapshots when it
+// runs, so a control loop doesn't read the power registers itself
+static double GetBatteryVoltage() {
+  BrownoutPrediction prediction = RobotController::GetBrownoutPrediction();
+  if (prediction.sampleCount > 0) return prediction.voltage;
+  return RobotController::GetInputVoltage();
+}
+
+template <typename F>
+void PIDController::UpdateParameters(F&& update) {
+  std::lock_guard<wpi::mutex> lock(m_thisMutex);
+  Parameters params = m_parameters.Load();
+  update(params);
+  m_parameters.Store(params);
+}
+
 /**
  * Allocate a PID object with the given constants for P, I, D.
  *
@@ -59,10 +79,12 @@ PIDController::PIDController(double Kp, double Ki, double Kd, double Kf,
     : SendableBase(false) {
   m_controlLoop = std::make_unique<Notifier>(&PIDController::Calculate, this);
 
-  m_P = Kp;
-  m_I = Ki;
-  m_D = Kd;
-  m_F = Kf;
+  Parameters params;
+  params.P = Kp;
+  params.I = Ki;
+  params.D = Kd;
+  params.F = Kf;
+  m_parameters.Store(params);
 
   // Save original source
   m_origSource = std::shared_ptr<PIDSource>(source, NullDeleter<PIDSource>());
@@ -123,53 +145,44 @@ PIDController::~PIDController() {
 
 /**
  * Read the input, calculate the output accordingly, and write to the output.
- * This should only be called by the Notifier.
+ * This should only be called by the Notifier, or by Update() when the
+ * controller is synchronous.
  */
 void PIDController::Calculate() {
+  FRC_TRACE_SCOPE("PIDController::Calculate");
   if (m_origSource == nullptr || m_pidOutput == nullptr) return;
 
-  bool enabled;
-  {
-    std::lock_guard<wpi::mutex> lock(m_thisMutex);
-    enabled = m_enabled;
-  }
+  if (m_enabled) {
+    // Configuration is read without locking, so slow dashboard readers and
+    // writers never stall the loop
+    Parameters params = m_parameters.Load();
+    State state = m_state.Load();
 
-  if (enabled) {
     double input;
-
-    // Storage for function inputs
-    double P;
-    double I;
-    double D;
-    double feedForward = CalculateFeedForward();
-    double minimumOutput;
-    double maximumOutput;
-
-    // Storage for function input-outputs
-    double prevError;
-    double error;
-    double totalError;
+    auto model = std::atomic_load(&m_feedforward);
+    double feedForward = model
+                             ? CalculateModelFeedForward(*model, params, &state)
+                             : CalculateFeedForward();
 
     {
-      std::lock_guard<wpi::mutex> lock(m_thisMutex);
-
-      input = m_pidInput->PIDGet(m_pidSourceType);
+      std::lock_guard<wpi::mutex> lock(m_inputMutex);
+      input = m_pidInput->PIDGet(params.pidSourceType);
+    }
 
-      P = m_P;
-      I = m_I;
-      D = m_D;
-      minimumOutput = m_minimumOutput;
-      maximumOutput = m_maximumOutput;
+    double P = params.P;
+    double I = params.I;
+    double D = params.D;
+    double minimumOutput = params.minimumOutput;
+    double maximumOutput = params.maximumOutput;
 
-      prevError = m_prevError;
-      error = GetContinuousError(m_setpoint - input);
-      totalError = m_totalError;
-    }
+    double prevError = state.prevError;
+    double error = GetContinuousError(params, params.setpoint - input);
+    double totalError = state.totalError;
 
     // Storage for function outputs
     double result;
 
-    if (m_pidSourceType == PIDSourceType::kRate) {
+    if (params.pidSourceType == PIDSourceType::kRate) {
       if (P != 0) {
         totalError =
             clamp(totalError + error, minimumOutput / P, maximumOutput / P);
@@ -186,25 +199,33 @@ void PIDController::Calculate() {
           P * error + I * totalError + D * (error - prevError) + feedForward;
     }
 
+    if (params.nominalVoltage > 0) {
+      double voltage = GetBatteryVoltage();
+      if (voltage > 0) result *= params.nominalVoltage / voltage;
+    }
     result = clamp(result, minimumOutput, maximumOutput);
 
     {
       // Ensures m_enabled check and PIDWrite() call occur atomically
       std::lock_guard<wpi::mutex> pidWriteLock(m_pidWriteMutex);
-      std::unique_lock<wpi::mutex> mainLock(m_thisMutex);
       if (m_enabled) {
-        // Don't block other PIDController operations on PIDWrite()
-        mainLock.unlock();
-
         m_pidOutput->PIDWrite(result);
       }
     }
 
-    std::lock_guard<wpi::mutex> lock(m_thisMutex);
-    m_prevError = m_error;
-    m_error = error;
-    m_totalError = totalError;
-    m_result = result;
+    if (m_telemetryEnabled) {
+      TelemetrySample sample{Timer::GetFPGATimestamp(), params.setpoint, input,
+                             error, result};
+      if (!m_telemetry->Push(sample)) m_telemetryDrops++;
+    }
+
+    std::lock_guard<wpi::mutex> lock(m_stateMutex);
+    state.prevError = state.error;
+    state.error = error;
+    state.totalError = totalError;
+    state.result = result;
+    state.ffSetpoint = params.setpoint;
+    m_state.Store(state);
   }
 }
 
@@ -224,16 +245,43 @@ void PIDController::Calculate() {
  * the default period in this class's constructor).
  */
 double PIDController::CalculateFeedForward() {
-  if (m_pidSourceType == PIDSourceType::kRate) {
-    return m_F * GetSetpoint();
+  Parameters params = m_parameters.Load();
+  if (params.pidSourceType == PIDSourceType::kRate) {
+    return params.F * params.setpoint;
   } else {
-    double temp = m_F * GetDeltaSetpoint();
-    m_prevSetpoint = m_setpoint;
+    double temp = params.F * GetDeltaSetpoint();
+    m_prevSetpoint = params.setpoint;
     m_setpointTimer.Reset();
     return temp;
   }
 }
 
+/**
+ * Calculate the feed forward term from a model, with the velocity and
+ * acceleration of the setpoint differentiated over the loop period.
+ *
+ * For displacement inputs the setpoint is the model's position; for rate
+ * inputs it is the velocity, and the position is 0.
+ */
+double PIDController::CalculateModelFeedForward(const FeedforwardModel& model,
+                                                const Parameters& params,
+                                                State* state) {
+  double position = 0;
+  double velocity;
+  if (params.pidSourceType == PIDSourceType::kRate) {
+    velocity = params.setpoint;
+  } else {
+    position = params.setpoint;
+    velocity =
+        state->ffPrimed ? (params.setpoint - state->ffSetpoint) / m_period : 0;
+  }
+  double acceleration =
+      state->ffPrimed ? (velocity - state->ffVelocity) / m_period : 0;
+  state->ffVelocity = velocity;
+  state->ffPrimed = true;
+  return model.Calculate(position, velocity, acceleration);
+}
+
 /**
  * Set the PID Controller gain parameters.
  *
@@ -244,12 +292,11 @@ double PIDController::CalculateFeedForward() {
  * @param d Differential coefficient
  */
 void PIDController::SetPID(double p, double i, double d) {
-  {
-    std::lock_guard<wpi::mutex> lock(m_thisMutex);
-    m_P = p;
-    m_I = i;
-    m_D = d;
-  }
+  UpdateParameters([&](Parameters& params) {
+    params.P = p;
+    params.I = i;
+    params.D = d;
+  });
 }
 
 /**
@@ -263,11 +310,12 @@ void PIDController::SetPID(double p, double i, double d) {
  * @param f Feed forward coefficient
  */
 void PIDController::SetPID(double p, double i, double d, double f) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_P = p;
-  m_I = i;
-  m_D = d;
-  m_F = f;
+  UpdateParameters([&](Parameters& params) {
+    params.P = p;
+    params.I = i;
+    params.D = d;
+    params.F = f;
+  });
 }
 
 /**
@@ -276,8 +324,7 @@ void PIDController::SetPID(double p, double i, double d, double f) {
  * @param p proportional coefficient
  */
 void PIDController::SetP(double p) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_P = p;
+  UpdateParameters([&](Parameters& params) { params.P = p; });
 }
 
 /**
@@ -286,8 +333,7 @@ void PIDController::SetP(double p) {
  * @param i integral coefficient
  */
 void PIDController::SetI(double i) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_I = i;
+  UpdateParameters([&](Parameters& params) { params.I = i; });
 }
 
 /**
@@ -296,8 +342,7 @@ void PIDController::SetI(double i) {
  * @param d differential coefficient
  */
 void PIDController::SetD(double d) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_D = d;
+  UpdateParameters([&](Parameters& params) { params.D = d; });
 }
 
 /**
@@ -306,8 +351,7 @@ void PIDController::SetD(double d) {
  * @param f Feed forward coefficient
  */
 void PIDController::SetF(double f) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_F = f;
+  UpdateParameters([&](Parameters& params) { params.F = f; });
 }
 
 /**
@@ -315,39 +359,75 @@ void PIDController::SetF(double f) {
  *
  * @return proportional coefficient
  */
-double PIDController::GetP() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_P;
-}
+double PIDController::GetP() const { return m_parameters.Load().P; }
 
 /**
  * Get the Integral coefficient.
  *
  * @return integral coefficient
  */
-double PIDController::GetI() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_I;
-}
+double PIDController::GetI() const { return m_parameters.Load().I; }
 
 /**
  * Get the Differential coefficient.
  *
  * @return differential coefficient
  */
-double PIDController::GetD() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_D;
-}
+double PIDController::GetD() const { return m_parameters.Load().D; }
 
 /**
  * Get the Feed forward coefficient.
  *
  * @return Feed forward coefficient
  */
-double PIDController::GetF() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_F;
+double PIDController::GetF() const { return m_parameters.Load().F; }
+
+/**
+ * Compute the feed forward term with a model of the mechanism, such as
+ * ArmFeedforward, instead of the F coefficient.
+ *
+ * The model is given the setpoint and its rate of change over each loop
+ * period, so it also feeds forward the velocity and acceleration of a
+ * setpoint that follows a profile.
+ *
+ * @param model The model, or nullptr to go back to the F coefficient
+ */
+void PIDController::SetFeedforward(std::shared_ptr<FeedforwardModel> model) {
+  std::atomic_store(&m_feedforward, std::move(model));
+}
+
+/**
+ * Get the feedforward model, or nullptr if the F coefficient is used.
+ */
+std::shared_ptr<FeedforwardModel> PIDController::GetFeedforward() const {
+  return std::atomic_load(&m_feedforward);
+}
+
+/**
+ * Scale the output by the nominal voltage over the battery voltage, so the
+ * gains behave the same as the battery sags.
+ *
+ * The gains are then tuned as fractions of the nominal voltage. The battery
+ * voltage comes from RobotController::GetBrownoutPrediction() while
+ * RobotController::StartBrownoutPrediction() runs, and is read each loop
+ * otherwise.
+ *
+ * @param nominalVoltage The battery voltage the gains were tuned at
+ */
+void PIDController::EnableVoltageCompensation(double nominalVoltage) {
+  if (nominalVoltage <= 0) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "nominalVoltage");
+    return;
+  }
+  UpdateParameters(
+      [&](Parameters& params) { params.nominalVoltage = nominalVoltage; });
+}
+
+/**
+ * Stop scaling the output for the battery voltage.
+ */
+void PIDController::DisableVoltageCompensation() {
+  UpdateParameters([&](Parameters& params) { params.nominalVoltage = 0; });
 }
 
 /**
@@ -357,10 +437,7 @@ double PIDController::GetF() const {
  *
  * @return the latest calculated output
  */
-double PIDController::Get() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_result;
-}
+double PIDController::Get() const { return m_state.Load().result; }
 
 /**
  * Set the PID controller to consider the input to be continuous,
@@ -372,8 +449,7 @@ double PIDController::Get() const {
  * @param continuous true turns on continuous, false turns off continuous
  */
 void PIDController::SetContinuous(bool continuous) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_continuous = continuous;
+  UpdateParameters([&](Parameters& params) { params.continuous = continuous; });
 }
 
 /**
@@ -383,14 +459,14 @@ void PIDController::SetContinuous(bool continuous) {
  * @param maximumInput the maximum value expected from the output
  */
 void PIDController::SetInputRange(double minimumInput, double maximumInput) {
-  {
-    std::lock_guard<wpi::mutex> lock(m_thisMutex);
-    m_minimumInput = minimumInput;
-    m_maximumInput = maximumInput;
-    m_inputRange = maximumInput - minimumInput;
-  }
-
-  SetSetpoint(m_setpoint);
+  UpdateParameters([&](Parameters& params) {
+    params.minimumInput = minimumInput;
+    params.maximumInput = maximumInput;
+    params.inputRange = maximumInput - minimumInput;
+    if (maximumInput > minimumInput) {
+      params.setpoint = clamp(params.setpoint, minimumInput, maximumInput);
+    }
+  });
 }
 
 /**
@@ -400,9 +476,10 @@ void PIDController::SetInputRange(double minimumInput, double maximumInput) {
  * @param maximumOutput the maximum value to write to the output
  */
 void PIDController::SetOutputRange(double minimumOutput, double maximumOutput) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_minimumOutput = minimumOutput;
-  m_maximumOutput = maximumOutput;
+  UpdateParameters([&](Parameters& params) {
+    params.minimumOutput = minimumOutput;
+    params.maximumOutput = maximumOutput;
+  });
 }
 
 /**
@@ -411,20 +488,18 @@ void PIDController::SetOutputRange(double minimumOutput, double maximumOutput) {
  * @param setpoint the desired setpoint
  */
 void PIDController::SetSetpoint(double setpoint) {
-  {
-    std::lock_guard<wpi::mutex> lock(m_thisMutex);
-
-    if (m_maximumInput > m_minimumInput) {
-      if (setpoint > m_maximumInput)
-        m_setpoint = m_maximumInput;
-      else if (setpoint < m_minimumInput)
-        m_setpoint = m_minimumInput;
+  UpdateParameters([&](Parameters& params) {
+    if (params.maximumInput > params.minimumInput) {
+      if (setpoint > params.maximumInput)
+        params.setpoint = params.maximumInput;
+      else if (setpoint < params.minimumInput)
+        params.setpoint = params.minimumInput;
       else
-        m_setpoint = setpoint;
+        params.setpoint = setpoint;
     } else {
-      m_setpoint = setpoint;
+      params.setpoint = setpoint;
     }
-  }
+  });
 }
 
 /**
@@ -433,8 +508,7 @@ void PIDController::SetSetpoint(double setpoint) {
  * @return the current setpoint
  */
 double PIDController::GetSetpoint() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_setpoint;
+  return m_parameters.Load().setpoint;
 }
 
 /**
@@ -443,21 +517,26 @@ double PIDController::GetSetpoint() const {
  * @return the change in setpoint over time
  */
 double PIDController::GetDeltaSetpoint() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return (m_setpoint - m_prevSetpoint) / m_setpointTimer.Get();
+  return (GetSetpoint() - m_prevSetpoint) / m_setpointTimer.Get();
 }
 
 /**
  * Returns the current difference of the input from the setpoint.
  *
+ * While the controller is enabled this is the error computed by the most
+ * recent loop iteration.
+ *
  * @return the current error
  */
 double PIDController::GetError() const {
-  double setpoint = GetSetpoint();
-  {
-    std::lock_guard<wpi::mutex> lock(m_thisMutex);
-    return GetContinuousError(setpoint - m_pidInput->PIDGet(m_pidSourceType));
-  }
+  // While enabled, report the error of the last loop iteration rather than
+  // reading the input again, so callers never wait on the control loop
+  if (m_enabled) return m_state.Load().error;
+
+  Parameters params = m_parameters.Load();
+  std::lock_guard<wpi::mutex> lock(m_inputMutex);
+  return GetContinuousError(
+      params, params.setpoint - m_pidInput->PIDGet(params.pidSourceType));
 }
 
 /**
@@ -474,7 +553,8 @@ double PIDController::GetAvgError() const { return GetError(); }
  * Sets what type of input the PID controller will use.
  */
 void PIDController::SetPIDSourceType(PIDSourceType pidSource) {
-  m_pidSourceType= pidSource;
+  UpdateParameters(
+      [&](Parameters& params) { params.pidSourceType = pidSource; });
 }
 /**
  * Returns the type of input the PID controller is using.
@@ -482,7 +562,7 @@ void PIDController::SetPIDSourceType(PIDSourceType pidSource) {
  * @return the PID controller input type
  */
 PIDSourceType PIDController::GetPIDSourceType() const {
-    return m_pidSourceType;
+  return m_parameters.Load().pidSourceType;
 }
 
 /*
@@ -492,9 +572,7 @@ PIDSourceType PIDController::GetPIDSourceType() const {
  * @param percentage error which is tolerable
  */
 void PIDController::SetTolerance(double percent) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_toleranceType = kPercentTolerance;
-  m_tolerance = percent;
+  SetPercentTolerance(percent);
 }
 
 /*
@@ -504,9 +582,10 @@ void PIDController::SetTolerance(double percent) {
  * @param percentage error which is tolerable
  */
 void PIDController::SetAbsoluteTolerance(double absTolerance) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_toleranceType = kAbsoluteTolerance;
-  m_tolerance = absTolerance;
+  UpdateParameters([&](Parameters& params) {
+    params.toleranceType = kAbsoluteTolerance;
+    params.tolerance = absTolerance;
+  });
 }
 
 /*
@@ -516,9 +595,10 @@ void PIDController::SetAbsoluteTolerance(double absTolerance) {
  * @param percentage error which is tolerable
  */
 void PIDController::SetPercentTolerance(double percent) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_toleranceType = kPercentTolerance;
-  m_tolerance = percent;
+  UpdateParameters([&](Parameters& params) {
+    params.toleranceType = kPercentTolerance;
+    params.tolerance = percent;
+  });
 }
 
 /*
@@ -532,7 +612,7 @@ void PIDController::SetPercentTolerance(double percent) {
  * @param bufLength Number of previous cycles to average. Defaults to 1.
  */
 void PIDController::SetToleranceBuffer(int bufLength) {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
+  std::lock_guard<wpi::mutex> lock(m_inputMutex);
 
   // Create LinearDigitalFilter with original source as its source argument
   m_filter = LinearDigitalFilter::MovingAverage(m_origSource, bufLength);
@@ -553,13 +633,13 @@ void PIDController::SetToleranceBuffer(int bufLength) {
 bool PIDController::OnTarget() const {
   double error = GetError();
 
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  switch (m_toleranceType) {
+  Parameters params = m_parameters.Load();
+  switch (params.toleranceType) {
     case kPercentTolerance:
-      return std::fabs(error) < m_tolerance / 100 * m_inputRange;
+      return std::fabs(error) < params.tolerance / 100 * params.inputRange;
       break;
     case kAbsoluteTolerance:
-      return std::fabs(error) < m_tolerance;
+      return std::fabs(error) < params.tolerance;
       break;
     case kNoTolerance:
       // TODO: this case needs an error
@@ -571,12 +651,7 @@ bool PIDController::OnTarget() const {
 /**
  * Begin running the PIDController.
  */
-void PIDController::Enable() {
-  {
-    std::lock_guard<wpi::mutex> lock(m_thisMutex);
-    m_enabled = true;
-  }
-}
+void PIDController::Enable() { m_enabled = true; }
 
 /**
  * Stop running the PIDController, this sets the output to zero before stopping.
@@ -585,10 +660,7 @@ void PIDController::Disable() {
   {
     // Ensures m_enabled modification and PIDWrite() call occur atomically
     std::lock_guard<wpi::mutex> pidWriteLock(m_pidWriteMutex);
-    {
-      std::lock_guard<wpi::mutex> mainLock(m_thisMutex);
-      m_enabled = false;
-    }
+    m_enabled = false;
 
     m_pidOutput->PIDWrite(0);
   }
@@ -608,10 +680,7 @@ void PIDController::SetEnabled(bool enable) {
 /**
  * Return true if PIDController is enabled.
  */
-bool PIDController::IsEnabled() const {
-  std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  return m_enabled;
-}
+bool PIDController::IsEnabled() const { return m_enabled; }
 
 /**
  * Reset the previous error, the integral term, and disable the controller.
@@ -619,10 +688,86 @@ bool PIDController::IsEnabled() const {
 void PIDController::Reset() {
   Disable();
 
+  std::lock_guard<wpi::mutex> lock(m_stateMutex);
+  m_state.Store(State());
+}
+
+/**
+ * Set whether the control loop is run by calls to Update() instead of the
+ * controller's own thread.
+ *
+ * A synchronous controller runs on its owner's thread, in order with the rest
+ * of its loop, so its source and output need no locking against it. The loop
+ * then runs as often as Update() is called rather than at the controller's
+ * period, which changes the effect of the I and D gains.
+ *
+ * @param synchronous True to stop the controller's thread and rely on
+ *                    Update()
+ */
+void PIDController::SetSynchronous(bool synchronous) {
+  std::lock_guard<wpi::mutex> lock(m_thisMutex);
+  if (synchronous == m_synchronous) return;
+  m_synchronous = synchronous;
+  if (synchronous) {
+    m_controlLoop->Stop();
+  } else {
+    m_controlLoop->StartPeriodic(m_period);
+  }
+}
+
+/**
+ * Return true if the control loop is run by Update().
+ */
+bool PIDController::IsSynchronous() const { return m_synchronous; }
+
+/**
+ * Run one iteration of the control loop on the calling thread.
+ *
+ * This is for synchronous controllers; see SetSynchronous().
+ */
+void PIDController::Update() { Calculate(); }
+
+/**
+ * Starts or stops recording each iteration of the control loop.
+ *
+ * Samples are queued without locking, so the loop never waits for the thread
+ * reading them; if that thread falls behind by more than 256 samples, new
+ * ones are dropped and counted by GetTelemetryDropCount().
+ *
+ * @param enable True to record samples
+ */
+void PIDController::EnableTelemetry(bool enable) {
   std::lock_guard<wpi::mutex> lock(m_thisMutex);
-  m_prevError = 0;
-  m_totalError = 0;
-  m_result = 0;
+  if (enable && !m_telemetry) m_telemetry = std::make_unique<TelemetryQueue>();
+  m_telemetryEnabled = enable;
+}
+
+/**
+ * Takes the oldest recorded samples, such as for logging or a dashboard.
+ *
+ * Only one thread may read telemetry from a controller.
+ *
+ * @param samples Array to fill
+ * @param count   The size of the array
+ * @return The number of samples taken.
+ */
+int PIDController::ReadTelemetry(TelemetrySample* samples, int count) {
+  TelemetryQueue* queue;
+  {
+    std::lock_guard<wpi::mutex> lock(m_thisMutex);
+    queue = m_telemetry.get();
+  }
+  if (!queue) return 0;
+  int taken = 0;
+  while (taken < count && queue->Pop(&samples[taken])) taken++;
+  return taken;
+}
+
+/**
+ * Returns the number of samples dropped because the queue was full.
+ */
+uint64_t PIDController::GetTelemetryDropCount() const {
+  return m_telemetryDrops;
 }
 
 void PIDController::InitSendable(SendableBuilder& builder) {
@@ -644,19 +789,24 @@ void PIDController::InitSendable(SendableBuilder& builder) {
 
 /**
  * Wraps error around for continuous inputs. The original error is returned if
- * continuous mode is disabled. This is an unsynchronized function.
+ * continuous mode is disabled.
  *
  * @param error The current error of the PID controller.
  * @return Error for continuous inputs.
  */
 double PIDController::GetContinuousError(double error) const {
-  if (m_continuous && m_inputRange != 0) {
-    error = std::fmod(error, m_inputRange);
-    if (std::fabs(error) > m_inputRange / 2) {
+  return GetContinuousError(m_parameters.Load(), error);
+}
+
+double PIDController::GetContinuousError(const Parameters& params,
+                                         double error) {
+  if (params.continuous && params.inputRange != 0) {
+    error = std::fmod(error, params.inputRange);
+    if (std::fabs(error) > params.inputRange / 2) {
       if (error > 0) {
-        return error - m_inputRange;
+        return error - params.inputRange;
       } else {
-        return error + m_inputRange;
+        return error + params.inputRange;
       }
     }
   }
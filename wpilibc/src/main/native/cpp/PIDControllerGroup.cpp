@@ -0,0 +1,393 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "PIDControllerGroup.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <HAL/HAL.h>
+
+#include "Notifier.h"
+#include "PIDOutput.h"
+#include "Timer.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+/**
+ * Create an empty group.
+ *
+ * @param period The loop time of every controller in the group, in seconds.
+ */
+PIDControllerGroup::PIDControllerGroup(double period) : m_period(period) {
+  m_controlLoop =
+      std::make_unique<Notifier>(&PIDControllerGroup::Calculate, this);
+  m_controlLoop->StartPeriodic(m_period);
+
+  static int instances = 0;
+  instances++;
+  HAL_Report(HALUsageReporting::kResourceType_PIDController, instances);
+}
+
+PIDControllerGroup::~PIDControllerGroup() {
+  // forcefully stopping the notifier so the callback can successfully run.
+  m_controlLoop->Stop();
+}
+
+/**
+ * Add a controller to the group. The controller starts disabled.
+ *
+ * @param p      the proportional coefficient
+ * @param i      the integral coefficient
+ * @param d      the derivative coefficient
+ * @param source The PIDSource object that is used to get values
+ * @param output The PIDOutput object that is set to the output value
+ * @return The index of the controller within the group.
+ */
+int PIDControllerGroup::Add(double p, double i, double d, PIDSource& source,
+                            PIDOutput& output) {
+  return Add(p, i, d, 0.0, source, output);
+}
+
+/**
+ * Add a controller to the group. The controller starts disabled.
+ *
+ * @param p      the proportional coefficient
+ * @param i      the integral coefficient
+ * @param d      the derivative coefficient
+ * @param f      the feed forward coefficient
+ * @param source The PIDSource object that is used to get values
+ * @param output The PIDOutput object that is set to the output value
+ * @return The index of the controller within the group.
+ */
+int PIDControllerGroup::Add(double p, double i, double d, double f,
+                            PIDSource& source, PIDOutput& output) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_sources.push_back(&source);
+  m_outputs.push_back(&output);
+  m_sourceTypes.push_back(PIDSourceType::kDisplacement);
+  m_P.push_back(p);
+  m_I.push_back(i);
+  m_D.push_back(d);
+  m_F.push_back(f);
+  m_minimumOutput.push_back(-1.0);
+  m_maximumOutput.push_back(1.0);
+  m_minimumInput.push_back(0.0);
+  m_maximumInput.push_back(0.0);
+  m_continuous.push_back(false);
+  m_enabled.push_back(false);
+  m_setpoint.push_back(0.0);
+
+  m_input.push_back(0.0);
+  m_error.push_back(0.0);
+  m_prevError.push_back(0.0);
+  m_totalError.push_back(0.0);
+  m_prevSetpoint.push_back(0.0);
+  m_result.push_back(0.0);
+  return static_cast<int>(m_sources.size()) - 1;
+}
+
+/**
+ * Returns the number of controllers in the group.
+ */
+int PIDControllerGroup::GetSize() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return static_cast<int>(m_sources.size());
+}
+
+/**
+ * Set the gains of one controller.
+ */
+void PIDControllerGroup::SetPID(int index, double p, double i, double d,
+                                double f) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return;
+  m_P[index] = p;
+  m_I[index] = i;
+  m_D[index] = d;
+  m_F[index] = f;
+}
+
+/**
+ * Set the setpoint of one controller, limited to its input range if one was
+ * set.
+ */
+void PIDControllerGroup::SetSetpoint(int index, double setpoint) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return;
+  if (m_maximumInput[index] > m_minimumInput[index]) {
+    setpoint = std::max(m_minimumInput[index],
+                        std::min(setpoint, m_maximumInput[index]));
+  }
+  m_setpoint[index] = setpoint;
+}
+
+double PIDControllerGroup::GetSetpoint(int index) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return 0.0;
+  return m_setpoint[index];
+}
+
+/**
+ * Sets the maximum and minimum values expected from the input of one
+ * controller.
+ */
+void PIDControllerGroup::SetInputRange(int index, double minimumInput,
+                                       double maximumInput) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (!CheckIndex(index)) return;
+    m_minimumInput[index] = minimumInput;
+    m_maximumInput[index] = maximumInput;
+  }
+
+  SetSetpoint(index, GetSetpoint(index));
+}
+
+/**
+ * Sets the minimum and maximum values one controller writes.
+ */
+void PIDControllerGroup::SetOutputRange(int index, double minimumOutput,
+                                        double maximumOutput) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return;
+  m_minimumOutput[index] = minimumOutput;
+  m_maximumOutput[index] = maximumOutput;
+}
+
+/**
+ * Treat the input range of one controller as continuous, like
+ * PIDController::SetContinuous().
+ */
+void PIDControllerGroup::SetContinuous(int index, bool continuous) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return;
+  m_continuous[index] = continuous;
+}
+
+/**
+ * Sets what type of input one controller uses.
+ */
+void PIDControllerGroup::SetPIDSourceType(int index, PIDSourceType pidSource) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return;
+  m_sourceTypes[index] = pidSource;
+}
+
+/**
+ * Return the latest output of one controller.
+ */
+double PIDControllerGroup::Get(int index) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return 0.0;
+  return m_result[index];
+}
+
+/**
+ * Return the error one controller computed in the latest period.
+ */
+double PIDControllerGroup::GetError(int index) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return 0.0;
+  return m_error[index];
+}
+
+void PIDControllerGroup::Enable(int index) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return;
+  m_enabled[index] = true;
+}
+
+/**
+ * Stop one controller, setting its output to zero.
+ */
+void PIDControllerGroup::Disable(int index) {
+  // Ensures the m_enabled change and PIDWrite() call occur atomically
+  std::lock_guard<wpi::mutex> writeLock(m_writeMutex);
+  PIDOutput* output;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (!CheckIndex(index)) return;
+    m_enabled[index] = false;
+    output = m_outputs[index];
+  }
+  output->PIDWrite(0);
+}
+
+bool PIDControllerGroup::IsEnabled(int index) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return false;
+  return m_enabled[index];
+}
+
+/**
+ * Disable one controller and clear its previous error and integral term.
+ */
+void PIDControllerGroup::Reset(int index) {
+  Disable(index);
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (!CheckIndex(index)) return;
+  m_prevError[index] = 0;
+  m_totalError[index] = 0;
+  m_result[index] = 0;
+}
+
+void PIDControllerGroup::EnableAll() {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  std::fill(m_enabled.begin(), m_enabled.end(), true);
+}
+
+void PIDControllerGroup::DisableAll() {
+  std::lock_guard<wpi::mutex> writeLock(m_writeMutex);
+  std::vector<PIDOutput*> outputs;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    std::fill(m_enabled.begin(), m_enabled.end(), false);
+    outputs = m_outputs;
+  }
+  for (auto output : outputs) output->PIDWrite(0);
+}
+
+/**
+ * Returns how long the latest period took to read, compute and write every
+ * controller, in seconds.
+ */
+double PIDControllerGroup::GetLoopTime() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_loopTime;
+}
+
+/**
+ * Returns the longest time a period has taken since the group was created or
+ * ResetLoopTiming() was called, in seconds.
+ */
+double PIDControllerGroup::GetMaxLoopTime() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_maxLoopTime;
+}
+
+void PIDControllerGroup::ResetLoopTiming() {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_maxLoopTime = 0;
+}
+
+bool PIDControllerGroup::CheckIndex(int index) const {
+  if (index < 0 || index >= static_cast<int>(m_sources.size())) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "PIDControllerGroup index");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * Read every input, compute every loop, then write every output. This should
+ * only be called by the Notifier.
+ *
+ * Like PIDController, sources and outputs are called without m_mutex held, so
+ * a slow source or output doesn't stall the setters and may call back into
+ * the group.
+ */
+void PIDControllerGroup::Calculate() {
+  double start = Timer::GetFPGATimestamp();
+  double dt;
+  size_t size;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    dt = m_lastLoopStart > 0 ? start - m_lastLoopStart : m_period;
+    m_lastLoopStart = start;
+
+    size = m_sources.size();
+    m_io.resize(size);
+    for (size_t i = 0; i < size; i++) {
+      m_io[i].source = m_sources[i];
+      m_io[i].output = m_outputs[i];
+      m_io[i].sourceType = m_sourceTypes[i];
+      m_io[i].enabled = m_enabled[i];
+    }
+  }
+
+  for (auto& io : m_io) {
+    if (io.enabled) io.value = io.source->PIDGet(io.sourceType);
+  }
+
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+
+    // Loops disabled since the read are skipped too
+    for (size_t i = 0; i < size; i++) {
+      if (!m_enabled[i]) m_io[i].enabled = false;
+      if (!m_io[i].enabled) continue;
+      m_input[i] = m_io[i].value;
+      m_prevError[i] = m_error[i];
+      m_error[i] = m_setpoint[i] - m_input[i];
+    }
+
+    // Wrap errors for continuous inputs, as
+    // PIDController::GetContinuousError()
+    for (size_t i = 0; i < size; i++) {
+      double inputRange = m_maximumInput[i] - m_minimumInput[i];
+      if (!m_io[i].enabled || !m_continuous[i] || inputRange == 0) continue;
+      double error = std::fmod(m_error[i], inputRange);
+      if (std::fabs(error) > inputRange / 2) {
+        error += error > 0 ? -inputRange : inputRange;
+      }
+      m_error[i] = error;
+    }
+
+    for (size_t i = 0; i < size; i++) {
+      if (!m_io[i].enabled) continue;
+      double error = m_error[i];
+      double totalError = m_totalError[i];
+      double result;
+      if (m_sourceTypes[i] == PIDSourceType::kRate) {
+        if (m_P[i] != 0) {
+          totalError = std::max(m_minimumOutput[i] / m_P[i],
+                                std::min(totalError + error,
+                                         m_maximumOutput[i] / m_P[i]));
+        }
+        result =
+            m_D[i] * error + m_P[i] * totalError + m_F[i] * m_setpoint[i];
+      } else {
+        if (m_I[i] != 0) {
+          totalError = std::max(m_minimumOutput[i] / m_I[i],
+                                std::min(totalError + error,
+                                         m_maximumOutput[i] / m_I[i]));
+        }
+        double feedForward =
+            m_F[i] * (m_setpoint[i] - m_prevSetpoint[i]) / dt;
+        result = m_P[i] * error + m_I[i] * totalError +
+                 m_D[i] * (error - m_prevError[i]) + feedForward;
+      }
+      m_totalError[i] = totalError;
+      m_prevSetpoint[i] = m_setpoint[i];
+      m_result[i] =
+          std::max(m_minimumOutput[i], std::min(result, m_maximumOutput[i]));
+      m_io[i].value = m_result[i];
+    }
+  }
+
+  {
+    // Ensures the enabled checks and PIDWrite() calls occur atomically with
+    // respect to Disable()
+    std::lock_guard<wpi::mutex> writeLock(m_writeMutex);
+    {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      for (size_t i = 0; i < size; i++) {
+        if (!m_enabled[i]) m_io[i].enabled = false;
+      }
+    }
+    for (auto& io : m_io) {
+      if (io.enabled) io.output->PIDWrite(io.value);
+    }
+  }
+
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_loopTime = Timer::GetFPGATimestamp() - start;
+  m_maxLoopTime = std::max(m_maxLoopTime, m_loopTime);
+}
@@ -7,6 +7,8 @@
 
 #include "PWM.h"
 
+#include <string>
+
 #include <HAL/HAL.h>
 #include <HAL/PWM.h>
 #include <HAL/Ports.h>
@@ -49,12 +51,17 @@ PWM::PWM(int channel) {
 
   HAL_SetPWMDisabled(m_handle, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  m_rawLog.Log(static_cast<int64_t>(0));
   status = 0;
   HAL_SetPWMEliminateDeadband(m_handle, false, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 
   HAL_Report(HALUsageReporting::kResourceType_PWM, channel);
   SetName("PWM", channel);
+  std::string logName = ("PWM/" + llvm::Twine(channel)).str();
+  m_speedLog.Init(DeviceLogClass::kPWM, logName + "/Speed");
+  m_positionLog.Init(DeviceLogClass::kPWM, logName + "/Position");
+  m_rawLog.Init(DeviceLogClass::kPWM, logName + "/Raw");
 }
 
 /**
@@ -167,6 +174,7 @@ void PWM::SetPosition(double pos) {
   int32_t status = 0;
   HAL_SetPWMPosition(m_handle, pos, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  m_positionLog.Log(pos);
 }
 
 /**
@@ -205,6 +213,7 @@ void PWM::SetSpeed(double speed) {
   int32_t status = 0;
   HAL_SetPWMSpeed(m_handle, speed, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  m_speedLog.Log(speed);
 }
 
 /**
@@ -240,6 +249,7 @@ void PWM::SetRaw(uint16_t value) {
   int32_t status = 0;
   HAL_SetPWMRaw(m_handle, value, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  m_rawLog.Log(static_cast<int64_t>(value));
 }
 
 /**
@@ -310,6 +320,34 @@ void PWM::SetZeroLatch() {
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
+/**
+ * Stage speed and position writes of every PWM instead of sending them to the
+ * FPGA immediately. IterativeRobotBase commits the staged outputs once at the
+ * end of each loop iteration; other robot frameworks must call
+ * CommitOutputs() themselves. SetRaw() and SetDisabled() are never deferred.
+ *
+ * @param deferred True to stage writes, false to write them immediately.
+ */
+void PWM::SetOutputsDeferred(bool deferred) {
+  int32_t status = 0;
+  HAL_SetPWMOutputsDeferred(deferred, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Returns true if speed and position writes are staged until CommitOutputs().
+ */
+bool PWM::GetOutputsDeferred() { return HAL_GetPWMOutputsDeferred(); }
+
+/**
+ * Send every staged PWM output to the FPGA.
+ */
+void PWM::CommitOutputs() {
+  int32_t status = 0;
+  HAL_CommitPWMOutputs(&status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
 void PWM::InitSendable(SendableBuilder& builder) {
   builder.SetSmartDashboardType("PWM");
   builder.SetSafeState([=]() { SetDisabled(); });
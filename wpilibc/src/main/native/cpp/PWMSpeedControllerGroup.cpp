@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "PWMSpeedControllerGroup.h"
+
+#include <HAL/HAL.h>
+#include <HAL/PWM.h>
+
+#include "SmartDashboard/SendableBuilder.h"
+
+using namespace frc;
+
+void PWMSpeedControllerGroup::Initialize() {
+  m_handles.reserve(m_speedControllers.size());
+  m_speeds.resize(m_speedControllers.size());
+  for (auto& speedController : m_speedControllers) {
+    PWMSpeedController& controller = speedController.get();
+    // The group feeds one helper for all of its members
+    controller.SetSafetyEnabled(false);
+    m_handles.push_back(controller.m_handle);
+    AddChild(&controller);
+  }
+  m_safetyHelper = std::make_unique<MotorSafetyHelper>(this);
+  m_safetyHelper->SetSafetyEnabled(false);
+  static int instances = 0;
+  ++instances;
+  SetName("PWMSpeedControllerGroup", instances);
+}
+
+/**
+ * Set the speed of every member with one HAL call.
+ *
+ * @param speed The speed value between -1.0 and 1.0 to set.
+ */
+void PWMSpeedControllerGroup::Set(double speed) {
+  if (m_isInverted) speed = -speed;
+  for (size_t i = 0; i < m_speeds.size(); i++) {
+    // Called non-virtually, like the rest of the write path
+    auto& controller = m_speedControllers[i].get();
+    m_speeds[i] = controller.PWMSpeedController::GetInverted() ? -speed : speed;
+  }
+  int32_t status = 0;
+  HAL_SetPWMSpeeds(m_handles.data(), m_speeds.data(), m_handles.size(),
+                   &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  for (size_t i = 0; i < m_speeds.size(); i++) {
+    m_speedControllers[i].get().m_speedLog.Log(m_speeds[i]);
+  }
+  m_safetyHelper->Feed();
+}
+
+/**
+ * Get the speed most recently set for the group.
+ */
+double PWMSpeedControllerGroup::Get() const {
+  return m_speedControllers.front().get().Get() * (m_isInverted ? -1 : 1);
+}
+
+void PWMSpeedControllerGroup::SetInverted(bool isInverted) {
+  m_isInverted = isInverted;
+}
+
+bool PWMSpeedControllerGroup::GetInverted() const { return m_isInverted; }
+
+void PWMSpeedControllerGroup::Disable() {
+  for (auto speedController : m_speedControllers) {
+    speedController.get().Disable();
+  }
+}
+
+void PWMSpeedControllerGroup::StopMotor() {
+  for (auto speedController : m_speedControllers) {
+    speedController.get().StopMotor();
+  }
+}
+
+void PWMSpeedControllerGroup::PIDWrite(double output) { Set(output); }
+
+void PWMSpeedControllerGroup::SetExpiration(double timeout) {
+  m_safetyHelper->SetExpiration(timeout);
+}
+
+double PWMSpeedControllerGroup::GetExpiration() const {
+  return m_safetyHelper->GetExpiration();
+}
+
+bool PWMSpeedControllerGroup::IsAlive() const {
+  return m_safetyHelper->IsAlive();
+}
+
+void PWMSpeedControllerGroup::SetSafetyEnabled(bool enabled) {
+  m_safetyHelper->SetSafetyEnabled(enabled);
+}
+
+bool PWMSpeedControllerGroup::IsSafetyEnabled() const {
+  return m_safetyHelper->IsSafetyEnabled();
+}
+
+void PWMSpeedControllerGroup::GetDescription(llvm::raw_ostream& desc) const {
+  desc << "PWMSpeedControllerGroup";
+}
+
+void PWMSpeedControllerGroup::InitSendable(SendableBuilder& builder) {
+  builder.SetSmartDashboardType("Speed Controller");
+  builder.SetSafeState([=]() { StopMotor(); });
+  builder.AddDoubleProperty("Value", [=]() { return Get(); },
+                            [=](double value) { Set(value); });
+}
@@ -7,6 +7,8 @@
 
 #include "PowerDistributionPanel.h"
 
+#include <string>
+
 #include <HAL/HAL.h>
 #include <HAL/PDP.h>
 #include <HAL/Ports.h>
@@ -33,6 +35,17 @@ PowerDistributionPanel::PowerDistributionPanel(int module) : m_module(module) {
     return;
   }
   SetName("PowerDistributionPanel", module);
+
+  constexpr auto kClass = DeviceLogClass::kPowerDistributionPanel;
+  std::string logName = ("PowerDistributionPanel/" + llvm::Twine(module)).str();
+  m_voltageLog.Init(kClass, logName + "/Voltage");
+  m_temperatureLog.Init(kClass, logName + "/Temperature");
+  for (int i = 0; i < HAL_kPDPNumChannels; i++) {
+    m_currentLogs[i].Init(kClass, logName + "/Current/" + llvm::Twine(i));
+  }
+  m_totalCurrentLog.Init(kClass, logName + "/TotalCurrent");
+  m_totalPowerLog.Init(kClass, logName + "/TotalPower");
+  m_totalEnergyLog.Init(kClass, logName + "/TotalEnergy");
 }
 
 /**
@@ -49,6 +62,7 @@ double PowerDistributionPanel::GetVoltage() const {
     wpi_setWPIErrorWithContext(Timeout, "");
   }
 
+  m_voltageLog.Log(voltage);
   return voltage;
 }
 
@@ -66,6 +80,7 @@ double PowerDistributionPanel::GetTemperature() const {
     wpi_setWPIErrorWithContext(Timeout, "");
   }
 
+  m_temperatureLog.Log(temperature);
   return temperature;
 }
 
@@ -90,6 +105,7 @@ double PowerDistributionPanel::GetCurrent(int channel) const {
     wpi_setWPIErrorWithContext(Timeout, "");
   }
 
+  if (CheckPDPChannel(channel)) m_currentLogs[channel].Log(current);
   return current;
 }
 
@@ -107,6 +123,7 @@ double PowerDistributionPanel::GetTotalCurrent() const {
     wpi_setWPIErrorWithContext(Timeout, "");
   }
 
+  m_totalCurrentLog.Log(current);
   return current;
 }
 
@@ -124,6 +141,7 @@ double PowerDistributionPanel::GetTotalPower() const {
     wpi_setWPIErrorWithContext(Timeout, "");
   }
 
+  m_totalPowerLog.Log(power);
   return power;
 }
 
@@ -141,9 +159,39 @@ double PowerDistributionPanel::GetTotalEnergy() const {
     wpi_setWPIErrorWithContext(Timeout, "");
   }
 
+  m_totalEnergyLog.Log(energy);
   return energy;
 }
 
+/**
+ * Query every channel current, the voltage, temperature, total current, power
+ * and energy at once.
+ *
+ * Each CAN status frame is read and decoded once, rather than once per value.
+ *
+ * @return The values, with the CAN receive time of each status frame
+ */
+HAL_PDPSnapshot PowerDistributionPanel::GetSnapshot() const {
+  int32_t status = 0;
+
+  HAL_PDPSnapshot snapshot = {};
+  HAL_GetPDPSnapshot(m_module, &snapshot, &status);
+
+  if (status) {
+    wpi_setWPIErrorWithContext(Timeout, "");
+  }
+
+  for (int i = 0; i < HAL_kPDPNumChannels; i++) {
+    m_currentLogs[i].Log(snapshot.currents[i]);
+  }
+  m_voltageLog.Log(snapshot.voltage);
+  m_temperatureLog.Log(snapshot.temperature);
+  m_totalCurrentLog.Log(snapshot.totalCurrent);
+  m_totalPowerLog.Log(snapshot.totalPower);
+  m_totalEnergyLog.Log(snapshot.totalEnergy);
+  return snapshot;
+}
+
 /**
  * Reset the total energy drawn from the PDP.
  *
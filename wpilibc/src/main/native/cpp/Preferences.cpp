@@ -8,6 +8,7 @@
 #include "Preferences.h"
 
 #include <algorithm>
+#include <utility>
 
 #include <HAL/HAL.h>
 #include <llvm/StringRef.h>
@@ -28,9 +29,24 @@ Preferences::Preferences()
           nt::NetworkTableEntry entry, std::shared_ptr<nt::Value> value,
           int flags) { entry.SetPersistent(); },
       NT_NOTIFY_NEW | NT_NOTIFY_IMMEDIATE);
+  m_cacheListener = m_table->AddEntryListener(
+      [=](nt::NetworkTable* table, llvm::StringRef name,
+          nt::NetworkTableEntry entry, std::shared_ptr<nt::Value> value,
+          int flags) {
+        std::lock_guard<wpi::mutex> lock(m_mutex);
+        // A staged value replaces this one at the next flush
+        if (m_pending.count(name) != 0) return;
+        UpdateCache(name, (flags & NT_NOTIFY_DELETE) ? nullptr : value.get());
+      },
+      NT_NOTIFY_NEW | NT_NOTIFY_UPDATE | NT_NOTIFY_DELETE);
   HAL_Report(HALUsageReporting::kResourceType_Preferences, 0);
 }
 
+Preferences::~Preferences() {
+  // Stop the flush thread before the members it uses are destroyed
+  m_flushNotifier.reset();
+}
+
 /**
  * Get the one and only {@link Preferences} object.
  *
@@ -58,6 +74,8 @@ std::vector<std::string> Preferences::GetKeys() { return m_table->GetKeys(); }
  */
 std::string Preferences::GetString(llvm::StringRef key,
                                    llvm::StringRef defaultValue) {
+  auto value = GetPending(key);
+  if (value && value->IsString()) return value->GetString();
   return m_table->GetString(key, defaultValue);
 }
 
@@ -70,7 +88,7 @@ std::string Preferences::GetString(llvm::StringRef key,
  * @return either the value in the table, or the defaultValue
  */
 int Preferences::GetInt(llvm::StringRef key, int defaultValue) {
-  return static_cast<int>(m_table->GetNumber(key, defaultValue));
+  return static_cast<int>(GetDouble(key, defaultValue));
 }
 
 /**
@@ -82,6 +100,8 @@ int Preferences::GetInt(llvm::StringRef key, int defaultValue) {
  * @return either the value in the table, or the defaultValue
  */
 double Preferences::GetDouble(llvm::StringRef key, double defaultValue) {
+  auto value = GetPending(key);
+  if (value && value->IsDouble()) return value->GetDouble();
   return m_table->GetNumber(key, defaultValue);
 }
 
@@ -94,7 +114,7 @@ double Preferences::GetDouble(llvm::StringRef key, double defaultValue) {
  * @return either the value in the table, or the defaultValue
  */
 float Preferences::GetFloat(llvm::StringRef key, float defaultValue) {
-  return m_table->GetNumber(key, defaultValue);
+  return GetDouble(key, defaultValue);
 }
 
 /**
@@ -106,6 +126,8 @@ float Preferences::GetFloat(llvm::StringRef key, float defaultValue) {
  * @return either the value in the table, or the defaultValue
  */
 bool Preferences::GetBoolean(llvm::StringRef key, bool defaultValue) {
+  auto value = GetPending(key);
+  if (value && value->IsBoolean()) return value->GetBoolean();
   return m_table->GetBoolean(key, defaultValue);
 }
 
@@ -118,7 +140,7 @@ bool Preferences::GetBoolean(llvm::StringRef key, bool defaultValue) {
  * @return either the value in the table, or the defaultValue
  */
 int64_t Preferences::GetLong(llvm::StringRef key, int64_t defaultValue) {
-  return static_cast<int64_t>(m_table->GetNumber(key, defaultValue));
+  return static_cast<int64_t>(GetDouble(key, defaultValue));
 }
 
 /**
@@ -131,9 +153,7 @@ int64_t Preferences::GetLong(llvm::StringRef key, int64_t defaultValue) {
  * @param value the value
  */
 void Preferences::PutString(llvm::StringRef key, llvm::StringRef value) {
-  auto entry = m_table->GetEntry(key);
-  entry.SetString(value);
-  entry.SetPersistent();
+  Put(key, nt::Value::MakeString(value));
 }
 
 /**
@@ -145,9 +165,7 @@ void Preferences::PutString(llvm::StringRef key, llvm::StringRef value) {
  * @param value the value
  */
 void Preferences::PutInt(llvm::StringRef key, int value) {
-  auto entry = m_table->GetEntry(key);
-  entry.SetDouble(value);
-  entry.SetPersistent();
+  Put(key, nt::Value::MakeDouble(value));
 }
 
 /**
@@ -159,9 +177,7 @@ void Preferences::PutInt(llvm::StringRef key, int value) {
  * @param value the value
  */
 void Preferences::PutDouble(llvm::StringRef key, double value) {
-  auto entry = m_table->GetEntry(key);
-  entry.SetDouble(value);
-  entry.SetPersistent();
+  Put(key, nt::Value::MakeDouble(value));
 }
 
 /**
@@ -173,9 +189,7 @@ void Preferences::PutDouble(llvm::StringRef key, double value) {
  * @param value the value
  */
 void Preferences::PutFloat(llvm::StringRef key, float value) {
-  auto entry = m_table->GetEntry(key);
-  entry.SetDouble(value);
-  entry.SetPersistent();
+  Put(key, nt::Value::MakeDouble(value));
 }
 
 /**
@@ -187,9 +201,7 @@ void Preferences::PutFloat(llvm::StringRef key, float value) {
  * @param value the value
  */
 void Preferences::PutBoolean(llvm::StringRef key, bool value) {
-  auto entry = m_table->GetEntry(key);
-  entry.SetBoolean(value);
-  entry.SetPersistent();
+  Put(key, nt::Value::MakeBoolean(value));
 }
 
 /**
@@ -201,9 +213,7 @@ void Preferences::PutBoolean(llvm::StringRef key, bool value) {
  * @param value the value
  */
 void Preferences::PutLong(llvm::StringRef key, int64_t value) {
-  auto entry = m_table->GetEntry(key);
-  entry.SetDouble(value);
-  entry.SetPersistent();
+  Put(key, nt::Value::MakeDouble(value));
 }
 
 /**
@@ -213,7 +223,7 @@ void Preferences::PutLong(llvm::StringRef key, int64_t value) {
  * @return if there is a value at the given key
  */
 bool Preferences::ContainsKey(llvm::StringRef key) {
-  return m_table->ContainsKey(key);
+  return GetPending(key) != nullptr || m_table->ContainsKey(key);
 }
 
 /**
@@ -221,4 +231,156 @@ bool Preferences::ContainsKey(llvm::StringRef key) {
  *
  * @param key the key
  */
-void Preferences::Remove(llvm::StringRef key) { m_table->Delete(key); }
+void Preferences::Remove(llvm::StringRef key) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_pending.erase(key);
+    UpdateCache(key, nullptr);
+  }
+  m_table->Delete(key);
+}
+
+/**
+ * Returns a handle to a numeric preference that reads without locking or
+ * looking up the table, for use in loops. The handle follows later Puts and
+ * changes made from the dashboard.
+ *
+ * @param key          the key
+ * @param defaultValue the value to read while the preference does not exist
+ */
+Preferences::CachedValue Preferences::GetCached(llvm::StringRef key,
+                                                double defaultValue) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto& entry = m_cache[key];
+  if (!entry) {
+    entry = std::make_shared<CacheEntry>(defaultValue);
+    auto pending = m_pending.find(key);
+    if (pending != m_pending.end()) {
+      UpdateCache(key, pending->getValue().get());
+    } else {
+      UpdateCache(key, m_table->GetEntry(key).GetValue().get());
+    }
+  }
+  return CachedValue(entry);
+}
+
+/**
+ * Stages Puts in memory until Flush(), instead of writing each to the table.
+ *
+ * Staged values are flushed every flush interval on a separate thread, and
+ * when deferred writes are turned off.
+ *
+ * @param deferred true to stage Puts
+ */
+void Preferences::SetDeferredWrites(bool deferred) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_deferred = deferred;
+    if (deferred) {
+      if (!m_flushNotifier) {
+        m_flushNotifier =
+            std::make_unique<Notifier>(&Preferences::Flush, this);
+      }
+      m_flushNotifier->StartPeriodic(m_flushInterval);
+    } else if (m_flushNotifier) {
+      m_flushNotifier->Stop();
+    }
+  }
+  if (!deferred) Flush();
+}
+
+/**
+ * Returns whether Puts are staged until Flush().
+ */
+bool Preferences::GetDeferredWrites() const { return m_deferred; }
+
+/**
+ * Sets how often staged Puts are flushed while writes are deferred.
+ *
+ * @param seconds the time between flushes
+ */
+void Preferences::SetFlushInterval(double seconds) {
+  if (seconds <= 0) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "flush interval");
+    return;
+  }
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_flushInterval = seconds;
+  if (m_deferred && m_flushNotifier) {
+    m_flushNotifier->StartPeriodic(m_flushInterval);
+  }
+}
+
+/**
+ * Writes every staged Put to the table at once.
+ */
+void Preferences::Flush() {
+  llvm::StringMap<std::shared_ptr<nt::Value>> pending;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (m_pending.empty()) return;
+    std::swap(pending, m_pending);
+  }
+  for (auto& value : pending) {
+    auto entry = m_table->GetEntry(value.getKey());
+    entry.SetValue(value.getValue());
+    entry.SetPersistent();
+  }
+}
+
+std::shared_ptr<nt::Value> Preferences::GetPending(llvm::StringRef key) {
+  if (!m_deferred) return nullptr;
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  auto it = m_pending.find(key);
+  if (it == m_pending.end()) return nullptr;
+  return it->getValue();
+}
+
+void Preferences::Put(llvm::StringRef key, std::shared_ptr<nt::Value> value) {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    UpdateCache(key, value.get());
+    if (m_deferred) {
+      m_pending[key] = std::move(value);
+      return;
+    }
+  }
+  auto entry = m_table->GetEntry(key);
+  entry.SetValue(value);
+  entry.SetPersistent();
+}
+
+void Preferences::UpdateCache(llvm::StringRef key, const nt::Value* value) {
+  auto it = m_cache.find(key);
+  if (it == m_cache.end()) return;
+  CacheEntry& entry = *it->getValue();
+  double cached = entry.defaultValue;
+  if (value && value->IsDouble()) {
+    cached = value->GetDouble();
+  } else if (value && value->IsBoolean()) {
+    cached = value->GetBoolean() ? 1.0 : 0.0;
+  }
+  entry.value.store(cached, std::memory_order_relaxed);
+}
+
+Preferences::CachedValue::CachedValue(std::shared_ptr<const CacheEntry> entry)
+    : m_entry(std::move(entry)) {}
+
+/**
+ * Returns the current value, or 0 for a default-constructed handle.
+ */
+double Preferences::CachedValue::GetDouble() const {
+  return m_entry ? m_entry->value.load(std::memory_order_relaxed) : 0.0;
+}
+
+int Preferences::CachedValue::GetInt() const {
+  return static_cast<int>(GetDouble());
+}
+
+int64_t Preferences::CachedValue::GetLong() const {
+  return static_cast<int64_t>(GetDouble());
+}
+
+float Preferences::CachedValue::GetFloat() const { return GetDouble(); }
+
+bool Preferences::CachedValue::GetBoolean() const { return GetDouble() != 0; }
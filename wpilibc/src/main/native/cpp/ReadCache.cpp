@@ -0,0 +1,39 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "ReadCache.h"
+
+using namespace frc;
+
+std::atomic<bool> ReadCache::s_enabled{false};
+
+// The current loop, counted from 1 so that 0 means no value is latched
+static std::atomic<uint64_t> currentLoop{0};
+static thread_local bool isLoopThread = false;
+
+/**
+ * Enable or disable latching sensor reads once per loop.
+ */
+void ReadCache::SetEnabled(bool enabled) { s_enabled = enabled; }
+
+/**
+ * Start a new loop, so the next read of each sensor reads it again.
+ *
+ * Reads are cached on the thread that calls this. IterativeRobotBase calls it
+ * at the start of each loop.
+ */
+void ReadCache::StartLoop() {
+  isLoopThread = true;
+  currentLoop.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Return the current loop, or 0 if reads are not cached on this thread.
+ */
+uint64_t ReadCache::GetLoop() {
+  return isLoopThread ? currentLoop.load(std::memory_order_relaxed) : 0;
+}
@@ -123,50 +123,45 @@ void Relay::Set(Relay::Value value) {
   if (StatusIsFatal()) return;
 
   int32_t status = 0;
+  bool forward = false;
+  bool reverse = false;
 
   switch (value) {
     case kOff:
-      if (m_direction == kBothDirections || m_direction == kForwardOnly) {
-        HAL_SetRelay(m_forwardHandle, false, &status);
-      }
-      if (m_direction == kBothDirections || m_direction == kReverseOnly) {
-        HAL_SetRelay(m_reverseHandle, false, &status);
-      }
       break;
     case kOn:
-      if (m_direction == kBothDirections || m_direction == kForwardOnly) {
-        HAL_SetRelay(m_forwardHandle, true, &status);
-      }
-      if (m_direction == kBothDirections || m_direction == kReverseOnly) {
-        HAL_SetRelay(m_reverseHandle, true, &status);
-      }
+      forward = true;
+      reverse = true;
       break;
     case kForward:
       if (m_direction == kReverseOnly) {
         wpi_setWPIError(IncompatibleMode);
-        break;
-      }
-      if (m_direction == kBothDirections || m_direction == kForwardOnly) {
-        HAL_SetRelay(m_forwardHandle, true, &status);
-      }
-      if (m_direction == kBothDirections) {
-        HAL_SetRelay(m_reverseHandle, false, &status);
+        return;
       }
+      forward = true;
       break;
     case kReverse:
       if (m_direction == kForwardOnly) {
         wpi_setWPIError(IncompatibleMode);
-        break;
-      }
-      if (m_direction == kBothDirections) {
-        HAL_SetRelay(m_forwardHandle, false, &status);
-      }
-      if (m_direction == kBothDirections || m_direction == kReverseOnly) {
-        HAL_SetRelay(m_reverseHandle, true, &status);
+        return;
       }
+      reverse = true;
       break;
   }
 
+  if (m_direction == kBothDirections) {
+    // Set both lines with one update of the relay register
+    uint32_t forwardBit = 1u << m_channel;
+    uint32_t reverseBit = forwardBit << SensorBase::kRelayChannels;
+    HAL_SetRelaysMasked(forwardBit | reverseBit,
+                        (forward ? forwardBit : 0) | (reverse ? reverseBit : 0),
+                        &status);
+  } else if (m_direction == kForwardOnly) {
+    HAL_SetRelay(m_forwardHandle, forward, &status);
+  } else {
+    HAL_SetRelay(m_reverseHandle, reverse, &status);
+  }
+
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -7,6 +7,12 @@
 
 #include "Resource.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <limits>
+
 #include "ErrorBase.h"
 #include "WPIErrors.h"
 
@@ -14,15 +20,30 @@ using namespace frc;
 
 wpi::mutex Resource::m_createMutex;
 
+// Index of the lowest set bit; value must not be 0
+static uint32_t CountTrailingZeros(uint64_t value) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return index;
+#else
+  return __builtin_ctzll(value);
+#endif
+}
+
 /**
  * Allocate storage for a new instance of Resource.
  *
- * Allocate a bool array of values that will get initialized to indicate that no
+ * Allocate a bitset of values that will get initialized to indicate that no
  * resources have been allocated yet. The indicies of the resources are [0 ..
  * elements - 1].
  */
-Resource::Resource(uint32_t elements) {
-  m_isAllocated = std::vector<bool>(elements, false);
+Resource::Resource(uint32_t elements)
+    : m_wordCount((elements + kWordBits - 1) / kWordBits), m_size(elements) {
+  m_words = std::make_unique<std::atomic<uint64_t>[]>(m_wordCount);
+  for (uint32_t i = 0; i < m_wordCount; i++) m_words[i] = 0;
+  uint32_t used = elements % kWordBits;
+  if (used != 0) m_words[m_wordCount - 1] = ~uint64_t{0} << used;
 }
 
 /**
@@ -52,11 +73,14 @@ void Resource::CreateResourceObject(std::unique_ptr<Resource>& r,
  * allocated.
  */
 uint32_t Resource::Allocate(const std::string& resourceDesc) {
-  std::lock_guard<wpi::mutex> lock(m_allocateMutex);
-  for (uint32_t i = 0; i < m_isAllocated.size(); i++) {
-    if (!m_isAllocated[i]) {
-      m_isAllocated[i] = true;
-      return i;
+  for (uint32_t i = 0; i < m_wordCount; i++) {
+    uint64_t word = m_words[i].load(std::memory_order_relaxed);
+    while (word != ~uint64_t{0}) {
+      uint64_t bit = ~word & (word + 1);
+      if (m_words[i].compare_exchange_weak(word, word | bit,
+                                           std::memory_order_acq_rel)) {
+        return i * kWordBits + CountTrailingZeros(bit);
+      }
     }
   }
   wpi_setWPIErrorWithContext(NoAvailableResources, resourceDesc);
@@ -70,19 +94,62 @@ uint32_t Resource::Allocate(const std::string& resourceDesc) {
  * verified unallocated, then returned.
  */
 uint32_t Resource::Allocate(uint32_t index, const std::string& resourceDesc) {
-  std::lock_guard<wpi::mutex> lock(m_allocateMutex);
-  if (index >= m_isAllocated.size()) {
+  if (index >= m_size) {
     wpi_setWPIErrorWithContext(ChannelIndexOutOfRange, resourceDesc);
     return std::numeric_limits<uint32_t>::max();
   }
-  if (m_isAllocated[index]) {
+  uint64_t bit = uint64_t{1} << (index % kWordBits);
+  if (m_words[index / kWordBits].fetch_or(bit, std::memory_order_acq_rel) &
+      bit) {
     wpi_setWPIErrorWithContext(ResourceAlreadyAllocated, resourceDesc);
     return std::numeric_limits<uint32_t>::max();
   }
-  m_isAllocated[index] = true;
   return index;
 }
 
+/**
+ * Allocate several resources at once.
+ *
+ * Free resource values are claimed a word of the bitset at a time, so
+ * allocating many is cheaper than calling Allocate() for each. Either all of
+ * them are allocated, or none are and an error is set.
+ *
+ * @param count        The number of resources to allocate
+ * @param resourceDesc The description used in the error
+ * @return The allocated resource values, in increasing order, or an empty
+ *         vector if there were not enough free resources.
+ */
+std::vector<uint32_t> Resource::AllocateBatch(uint32_t count,
+                                              const std::string& resourceDesc) {
+  std::vector<uint32_t> indices;
+  indices.reserve(count);
+  for (uint32_t i = 0; i < m_wordCount && indices.size() < count; i++) {
+    uint64_t word = m_words[i].load(std::memory_order_relaxed);
+    uint64_t claim;
+    do {
+      // the lowest free bits, up to as many as are still needed
+      claim = 0;
+      uint64_t free = ~word;
+      for (size_t n = indices.size(); free != 0 && n < count; n++) {
+        claim |= free & (~free + 1);
+        free &= free - 1;
+      }
+      if (claim == 0) break;
+    } while (!m_words[i].compare_exchange_weak(word, word | claim,
+                                               std::memory_order_acq_rel));
+    while (claim != 0) {
+      indices.push_back(i * kWordBits + CountTrailingZeros(claim));
+      claim &= claim - 1;
+    }
+  }
+  if (indices.size() < count) {
+    FreeBatch(indices);
+    wpi_setWPIErrorWithContext(NoAvailableResources, resourceDesc);
+    return {};
+  }
+  return indices;
+}
+
 /**
  * Free an allocated resource.
  *
@@ -91,15 +158,22 @@ uint32_t Resource::Allocate(uint32_t index, const std::string& resourceDesc) {
  * be reused somewhere else in the program.
  */
 void Resource::Free(uint32_t index) {
-  std::unique_lock<wpi::mutex> lock(m_allocateMutex);
   if (index == std::numeric_limits<uint32_t>::max()) return;
-  if (index >= m_isAllocated.size()) {
+  if (index >= m_size) {
     wpi_setWPIError(NotAllocated);
     return;
   }
-  if (!m_isAllocated[index]) {
+  uint64_t bit = uint64_t{1} << (index % kWordBits);
+  if (!(m_words[index / kWordBits].fetch_and(~bit, std::memory_order_acq_rel) &
+        bit)) {
     wpi_setWPIError(NotAllocated);
-    return;
   }
-  m_isAllocated[index] = false;
+}
+
+/**
+ * Free several allocated resources, such as those returned by
+ * AllocateBatch().
+ */
+void Resource::FreeBatch(llvm::ArrayRef<uint32_t> indices) {
+  for (uint32_t index : indices) Free(index);
 }
@@ -18,6 +18,7 @@
 #include "LiveWindow/LiveWindow.h"
 #include "RobotState.h"
 #include "SmartDashboard/SmartDashboard.h"
+#include "StartupProfiler.h"
 #include "Utility.h"
 #include "WPILibVersion.h"
 
@@ -38,6 +39,7 @@ std::thread::id RobotBase::m_threadId;
  */
 RobotBase::RobotBase() : m_ds(DriverStation::GetInstance()) {
   m_threadId = std::this_thread::get_id();
+  StartupProfiler::Mark("HAL");
 
   RobotState::SetImplementation(DriverStation::GetInstance());
   HLUsageReporting::SetImplementation(new HardwareHLReporting());
@@ -45,6 +47,7 @@ RobotBase::RobotBase() : m_ds(DriverStation::GetInstance()) {
   auto inst = nt::NetworkTableInstance::GetDefault();
   inst.SetNetworkIdentity("Robot");
   inst.StartServer("/home/lvuser/networktables.ini");
+  StartupProfiler::Mark("NetworkTables");
 
   SmartDashboard::init();
 
@@ -64,6 +67,7 @@ RobotBase::RobotBase() : m_ds(DriverStation::GetInstance()) {
       .SetBoolean(false);
 
   LiveWindow::GetInstance()->SetEnabled(false);
+  StartupProfiler::Mark("RobotBase");
 }
 
 /**
@@ -10,6 +10,10 @@
 #include <HAL/HAL.h>
 
 #include "ErrorBase.h"
+#include "Internal/BrownoutPredictor.h"
+#include "Internal/DeviceLog.h"
+#include "Internal/HealthSampler.h"
+#include "WPIErrors.h"
 
 namespace frc {
 
@@ -56,6 +60,23 @@ uint64_t RobotController::GetFPGATime() {
   return time;
 }
 
+/**
+ * Read the FPGA time from the CPU's monotonic clock, without accessing the
+ * FPGA.
+ *
+ * The CPU clock is re-synced to the FPGA once a second, so the result is
+ * within tens of microseconds of GetFPGATime().
+ *
+ * @return The current time in microseconds according to the FPGA (since FPGA
+ *         reset).
+ */
+uint64_t RobotController::GetFPGATimeFast() {
+  int32_t status = 0;
+  uint64_t time = HAL_GetFPGATimeFast(&status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+  return time;
+}
+
 /**
  * Get the state of the "USER" button on the roboRIO.
  *
@@ -271,6 +292,61 @@ int RobotController::GetFaultCount3V3() {
   return retVal;
 }
 
+/**
+ * Get the input and every rail's voltage, current, enabled state and fault
+ * count at once, with fewer register reads than the separate getters.
+ *
+ * @return The values, with the FPGA time they were read at
+ */
+HAL_PowerSnapshot RobotController::GetPowerSnapshot() {
+  int32_t status = 0;
+  HAL_PowerSnapshot snapshot;
+  HAL_GetPowerSnapshot(&snapshot, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+  return snapshot;
+}
+
+/**
+ * Start taking power snapshots in a background thread, and predicting when
+ * the input voltage will fall to the 6.8 V the roboRIO browns out at.
+ *
+ * A control loop can read the latest snapshot from GetBrownoutPrediction()
+ * without reading the power registers itself, for example to compensate
+ * motor outputs for battery sag.
+ *
+ * @param period       The time between snapshots, in seconds.
+ * @param timeConstant The time constant the voltage and its slope are
+ *                     filtered with, in seconds.
+ */
+void RobotController::StartBrownoutPrediction(double period,
+                                              double timeConstant) {
+  if (period <= 0) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "period");
+    return;
+  }
+  if (timeConstant < 0) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "timeConstant");
+    return;
+  }
+  detail::BrownoutPredictor::GetInstance().Start(period, timeConstant);
+}
+
+/**
+ * Stop the power snapshots of StartBrownoutPrediction().
+ */
+void RobotController::StopBrownoutPrediction() {
+  detail::BrownoutPredictor::GetInstance().Stop();
+}
+
+/**
+ * Get the latest snapshot and prediction from StartBrownoutPrediction().
+ *
+ * @return The prediction, with a sample count of 0 if there are none yet.
+ */
+BrownoutPrediction RobotController::GetBrownoutPrediction() {
+  return detail::BrownoutPredictor::GetInstance().GetPrediction();
+}
+
 CANStatus RobotController::GetCANStatus() {
   int32_t status = 0;
   float percentBusUtilization = 0;
@@ -288,4 +364,149 @@ CANStatus RobotController::GetCANStatus() {
           static_cast<int>(txFullCount), static_cast<int>(receiveErrorCount),
           static_cast<int>(transmitErrorCount)};
 }
+
+/**
+ * Enable or disable the HAL performance counters, which count the calls into
+ * each family of HAL functions and the time spent in them, along with JNI
+ * transitions, notifier lateness and DS packet wake latency.
+ *
+ * Counting is off by default. Each thread counts on its own without locking,
+ * so the counters are cheap enough to leave on in a match.
+ */
+void RobotController::SetPerfCountersEnabled(bool enabled) {
+  HAL_SetPerfCountersEnabled(enabled);
+}
+
+/**
+ * Get the HAL performance counters, summed over every thread.
+ *
+ * The counts and total times only grow; take the difference of two readings
+ * for an interval. Times are in nanoseconds.
+ *
+ * @return The counters, indexed by HAL_PerfCounterType.
+ */
+std::array<HAL_PerfCounter, HAL_kPerfCounterCount>
+RobotController::GetPerfCounters() {
+  std::array<HAL_PerfCounter, HAL_kPerfCounterCount> counters;
+  HAL_GetPerfCounters(counters.data(), counters.size());
+  return counters;
+}
+
+/**
+ * Start a new interval for the longest time of each performance counter.
+ */
+void RobotController::ResetPerfCounterMaximums() {
+  HAL_ResetPerfCounterMaximums();
+}
+
+/**
+ * Enable or disable the HAL bus statistics, which count the calls, errors
+ * and time of the I2C, SPI, serial, CAN, PCM and PDP calls on each port, to
+ * tell whether a slow loop is waiting on a bus.
+ *
+ * The statistics are off by default, when they cost one atomic load a call.
+ */
+void RobotController::SetBusStatisticsEnabled(bool enabled) {
+  HAL_SetBusStatisticsEnabled(enabled);
+}
+
+/**
+ * Get the statistics of each bus port with calls since they were reset.
+ *
+ * Times are in nanoseconds. CAN calls are counted by device number.
+ *
+ * @return The statistics, ordered by bus then port.
+ */
+std::vector<HAL_BusStatistics> RobotController::GetBusStatistics() {
+  std::vector<HAL_BusStatistics> statistics(16);
+  for (;;) {
+    int32_t count = HAL_GetBusStatistics(statistics.data(), statistics.size());
+    if (static_cast<size_t>(count) <= statistics.size()) {
+      statistics.resize(count);
+      return statistics;
+    }
+    // More ports were used than there was room for
+    statistics.resize(count);
+  }
+}
+
+/**
+ * Zero the bus statistics of every port.
+ */
+void RobotController::ResetBusStatistics() { HAL_ResetBusStatistics(); }
+
+/**
+ * Log the values read from and written to devices to the DataLog.
+ *
+ * Encoders, analog inputs, PWMs, solenoids, the driver station control word
+ * and joysticks, and the power distribution panel are logged whenever a value
+ * is read or set. The DataLog must also be started for values to be written.
+ *
+ * @param enabled True to start logging device values, false to stop.
+ */
+void RobotController::EnableDeviceLogging(bool enabled) {
+  detail::SetDeviceLoggingEnabled(enabled);
+}
+
+/**
+ * Get whether device values are being logged.
+ */
+bool RobotController::IsDeviceLoggingEnabled() {
+  return detail::IsDeviceLoggingEnabled();
+}
+
+/**
+ * Only log every Nth value read from or written to each device of a class, to
+ * bound the cost of logging devices that are accessed often.
+ *
+ * @param deviceClass The class of devices.
+ * @param decimation  Log one value in this many; 1 logs every value.
+ */
+void RobotController::SetDeviceLoggingDecimation(DeviceLogClass deviceClass,
+                                                 int decimation) {
+  if (decimation < 1) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "decimation");
+    return;
+  }
+  detail::SetDeviceLoggingDecimation(deviceClass, decimation);
+}
+
+/**
+ * Start sampling the health of the robot controller in a background thread.
+ *
+ * Each sample reads the CPU usage of the system and of each thread of the
+ * robot program, the memory available, the CAN bus status, and how late the
+ * sampling thread woke up, which shows the scheduling latency of the system.
+ * The latest values and their averages and extremes over the latest 60
+ * samples are published to the "RobotHealth" NetworkTable.
+ *
+ * Sampling reads a few small files from /proc each period, so the default
+ * of one second costs well under a millisecond of CPU time per second.
+ *
+ * @param period The time between samples, in seconds.
+ */
+void RobotController::StartHealthSampling(double period) {
+  if (period <= 0) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "period");
+    return;
+  }
+  detail::HealthSampler::GetInstance().Start(period);
+}
+
+/**
+ * Stop sampling the health of the robot controller.
+ */
+void RobotController::StopHealthSampling() {
+  detail::HealthSampler::GetInstance().Stop();
+}
+
+/**
+ * Get the latest health statistics from StartHealthSampling().
+ *
+ * @return The statistics, with a sample count of 0 if there are none yet.
+ */
+RobotHealth RobotController::GetHealth() {
+  return detail::HealthSampler::GetInstance().GetHealth();
+}
+
 }  // namespace frc
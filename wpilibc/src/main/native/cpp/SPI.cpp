@@ -15,6 +15,7 @@
 #include <support/mutex.h>
 
 #include "DigitalSource.h"
+#include "Internal/SeqLock.h"
 #include "Notifier.h"
 #include "WPIErrors.h"
 
@@ -24,8 +25,9 @@ static constexpr int kAccumulateDepth = 2048;
 
 class SPI::Accumulator {
  public:
-  Accumulator(HAL_SPIPort port, int xferSize, int validMask, int validValue,
-              int dataShift, int dataSize, bool isSigned, bool bigEndian)
+  Accumulator(HAL_SPIPort port, double period, int xferSize, int validMask,
+              int validValue, int dataShift, int dataSize, bool isSigned,
+              bool bigEndian)
       : m_notifier([=]() {
           std::lock_guard<wpi::mutex> lock(m_mutex);
           Update();
@@ -39,10 +41,20 @@ class SPI::Accumulator {
         m_xferSize(xferSize),
         m_isSigned(isSigned),
         m_bigEndian(bigEndian),
+        m_period(static_cast<uint64_t>(period * 1e6)),
         m_port(port) {}
   ~Accumulator() { delete[] m_buf; }
 
+  struct Totals {
+    int64_t value;
+    uint32_t count;
+    int32_t lastValue;
+  };
+
   void Update();
+  void ReadTransfers();
+  uint64_t NextTimestamp(uint64_t estimate);
+  Totals GetTotals();
 
   Notifier m_notifier;
   uint8_t* m_buf;
@@ -51,10 +63,15 @@ class SPI::Accumulator {
   int64_t m_value = 0;
   uint32_t m_count = 0;
   int32_t m_lastValue = 0;
+  // The totals as of the last update, for readers that don't take the mutex
+  SeqLock<Totals> m_totals;
 
   int32_t m_center = 0;
   int32_t m_deadband = 0;
 
+  AccumulatorDecoder m_decoder;
+  uint64_t m_lastTimestamp = 0;
+
   int32_t m_validMask;
   int32_t m_validValue;
   int32_t m_dataMax;      // one more than max data value
@@ -63,10 +80,48 @@ class SPI::Accumulator {
   int32_t m_xferSize;     // SPI transfer size, in bytes
   bool m_isSigned;        // is data field signed?
   bool m_bigEndian;       // is response big endian?
+  uint64_t m_period;      // time between transfers, in microseconds
   HAL_SPIPort m_port;
 };
 
+/**
+ * Returns the FPGA time of the next transfer. At a fixed rate the engine runs
+ * off the FPGA clock, so transfers are exactly one period apart; the estimate
+ * from the read time is only used to start, and again if transfers were
+ * dropped. Triggered by a device's data-ready line, transfers follow the
+ * device's clock instead, and the drift is corrected the same way.
+ */
+uint64_t SPI::Accumulator::NextTimestamp(uint64_t estimate) {
+  uint64_t expected = m_lastTimestamp + m_period;
+  if (m_lastTimestamp == 0 || estimate > expected + m_period ||
+      estimate + m_period < expected)
+    m_lastTimestamp = estimate;
+  else
+    m_lastTimestamp = expected;
+  return m_lastTimestamp;
+}
+
+/**
+ * Reads the queued transfers and publishes the new totals. Called with the
+ * mutex held.
+ */
 void SPI::Accumulator::Update() {
+  ReadTransfers();
+  m_totals.Store({m_value, m_count, m_lastValue});
+}
+
+/**
+ * Returns the totals, first reading the queued transfers unless the notifier
+ * or another reader is already doing so, in which case the totals it last
+ * published are returned rather than waiting for it.
+ */
+SPI::Accumulator::Totals SPI::Accumulator::GetTotals() {
+  std::unique_lock<wpi::mutex> lock(m_mutex, std::try_to_lock);
+  if (lock) Update();
+  return m_totals.Load();
+}
+
+void SPI::Accumulator::ReadTransfers() {
   bool done;
   do {
     done = true;
@@ -86,11 +141,21 @@ void SPI::Accumulator::Update() {
     if (numToRead == 0) return;  // no samples
 
     // read buffered data
-    HAL_ReadSPIAutoReceivedData(m_port, m_buf, numToRead, 0, &status);
+    int32_t numRemaining =
+        HAL_ReadSPIAutoReceivedData(m_port, m_buf, numToRead, 0, &status);
     if (status != 0) return;  // error reading
 
+    // the newest transfer still queued completed about now
+    uint64_t now = HAL_GetFPGATime(&status);
+    int32_t transfersAfter = (numToRead + numRemaining) / m_xferSize;
+
     // loop over all responses
     for (int32_t off = 0; off < numToRead; off += m_xferSize) {
+      --transfersAfter;
+      uint64_t timestamp = NextTimestamp(now - transfersAfter * m_period);
+      if (m_decoder)
+        m_decoder(llvm::ArrayRef<uint8_t>(m_buf + off, m_xferSize), timestamp);
+
       // convert from bytes
       uint32_t resp = 0;
       if (m_bigEndian) {
@@ -279,11 +344,40 @@ int SPI::Transaction(uint8_t* dataToSend, uint8_t* dataReceived, int size) {
   return retVal;
 }
 
+/**
+ * Perform several transfers with the device as one transaction.
+ *
+ * The segments go out back to back in a single system call, for example a
+ * register address followed by a burst read.
+ *
+ * @param transfers The segments, in order; at most HAL_kSPIMaxBatchTransfers
+ * @return The total number of bytes transferred, or -1 for an error
+ */
+int SPI::TransactionBatch(llvm::ArrayRef<Transfer> transfers) {
+  if (transfers.size() > HAL_kSPIMaxBatchTransfers) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "transfers.size()");
+    return -1;
+  }
+
+  HAL_SPITransfer halTransfers[HAL_kSPIMaxBatchTransfers];
+  for (size_t i = 0; i < transfers.size(); i++) {
+    halTransfers[i].dataToSend = transfers[i].dataToSend;
+    halTransfers[i].dataReceived = transfers[i].dataReceived;
+    halTransfers[i].size = transfers[i].size;
+    halTransfers[i].csChange = transfers[i].csChange;
+    halTransfers[i].delayMicroseconds = transfers[i].delay;
+  }
+  return HAL_TransactionSPIBatch(m_port, halTransfers, transfers.size());
+}
+
 /**
  * Initialize automatic SPI transfer engine.
  *
- * Only a single engine is available, and use of it blocks use of all other
- * chip select usage on the same physical SPI port while it is running.
+ * The FPGA has a single engine, and use of it blocks use of all other chip
+ * select usage on the same physical SPI port while it is running. A port
+ * initialized while the FPGA engine is in use on the other physical SPI port
+ * gets a software engine instead, with its own buffer and dropped transfer
+ * count. Software engines can only run at a fixed rate (StartAutoRate()).
  *
  * @param bufferSize buffer size in bytes
  */
@@ -423,6 +517,47 @@ int SPI::GetAutoDroppedCount() {
 void SPI::InitAccumulator(double period, int cmd, int xferSize, int validMask,
                           int validValue, int dataShift, int dataSize,
                           bool isSigned, bool bigEndian) {
+  InitAccumulator(nullptr, false, period, cmd, xferSize, validMask, validValue,
+                  dataShift, dataSize, isSigned, bigEndian);
+}
+
+/**
+ * Initialize the accumulator to read the device each time it signals that
+ * new data is ready.
+ *
+ * The FPGA starts a transfer on each edge of the data-ready line, without the
+ * CPU, so each sample is read once as soon as it's ready rather than early,
+ * late or twice as a fixed rate poll would. The accumulator decoder receives
+ * each transfer with its time, estimated from the device's nominal sample
+ * period.
+ *
+ * @param dataReady The device's data-ready output
+ * @param rising    Whether data is ready on the rising edge, rather than the
+ *                  falling one
+ * @param period    The device's nominal time between samples
+ * @param cmd       SPI command to send to request data
+ * @param xferSize  SPI transfer size, in bytes
+ * @param validMask Mask to apply to received data for validity checking
+ * @param validData After valid_mask is applied, required matching value for
+ *                  validity checking
+ * @param dataShift Bit shift to apply to received data to get actual data
+ *                  value
+ * @param dataSize  Size (in bits) of data field
+ * @param isSigned  Is data field signed?
+ * @param bigEndian Is device big endian?
+ */
+void SPI::InitAccumulator(DigitalSource& dataReady, bool rising, double period,
+                          int cmd, int xferSize, int validMask, int validValue,
+                          int dataShift, int dataSize, bool isSigned,
+                          bool bigEndian) {
+  InitAccumulator(&dataReady, rising, period, cmd, xferSize, validMask,
+                  validValue, dataShift, dataSize, isSigned, bigEndian);
+}
+
+void SPI::InitAccumulator(DigitalSource* dataReady, bool rising, double period,
+                          int cmd, int xferSize, int validMask, int validValue,
+                          int dataShift, int dataSize, bool isSigned,
+                          bool bigEndian) {
   InitAuto(xferSize * kAccumulateDepth);
   uint8_t cmdBytes[4] = {0, 0, 0, 0};
   if (bigEndian) {
@@ -440,10 +575,15 @@ void SPI::InitAccumulator(double period, int cmd, int xferSize, int validMask,
     cmdBytes[3] = cmd & 0xff;
   }
   SetAutoTransmitData(cmdBytes, xferSize - 4);
-  StartAutoRate(period);
+  if (dataReady != nullptr) {
+    StartAutoTrigger(*dataReady, rising, !rising);
+  } else {
+    StartAutoRate(period);
+  }
 
-  m_accum.reset(new Accumulator(m_port, xferSize, validMask, validValue,
-                                dataShift, dataSize, isSigned, bigEndian));
+  m_accum.reset(new Accumulator(m_port, period, xferSize, validMask,
+                                validValue, dataShift, dataSize, isSigned,
+                                bigEndian));
   m_accum->m_notifier.StartPeriodic(period * kAccumulateDepth / 2);
 }
 
@@ -464,6 +604,7 @@ void SPI::ResetAccumulator() {
   m_accum->m_value = 0;
   m_accum->m_count = 0;
   m_accum->m_lastValue = 0;
+  m_accum->m_totals.Store({0, 0, 0});
 }
 
 /**
@@ -489,14 +630,30 @@ void SPI::SetAccumulatorDeadband(int deadband) {
   m_accum->m_deadband = deadband;
 }
 
+/**
+ * Set a function to be called with every transfer the accumulator receives.
+ *
+ * The decoder gets a view of the raw transfer, without a copy, and the FPGA
+ * time in microseconds the transfer completed at. Consecutive timestamps are
+ * exactly the accumulator period apart unless transfers were dropped, so
+ * consumers can integrate with the true time step. The built-in accumulation
+ * still runs. The decoder is called from the accumulator's update thread, or
+ * from a thread calling one of the GetAccumulator functions.
+ *
+ * @param decoder function to call, or nullptr to stop calling one
+ */
+void SPI::SetAccumulatorDecoder(AccumulatorDecoder decoder) {
+  if (!m_accum) return;
+  std::lock_guard<wpi::mutex> lock(m_accum->m_mutex);
+  m_accum->m_decoder = decoder;
+}
+
 /**
  * Read the last value read by the accumulator engine.
  */
 int SPI::GetAccumulatorLastValue() const {
   if (!m_accum) return 0;
-  std::lock_guard<wpi::mutex> lock(m_accum->m_mutex);
-  m_accum->Update();
-  return m_accum->m_lastValue;
+  return m_accum->GetTotals().lastValue;
 }
 
 /**
@@ -506,9 +663,7 @@ int SPI::GetAccumulatorLastValue() const {
  */
 int64_t SPI::GetAccumulatorValue() const {
   if (!m_accum) return 0;
-  std::lock_guard<wpi::mutex> lock(m_accum->m_mutex);
-  m_accum->Update();
-  return m_accum->m_value;
+  return m_accum->GetTotals().value;
 }
 
 /**
@@ -521,9 +676,7 @@ int64_t SPI::GetAccumulatorValue() const {
  */
 int64_t SPI::GetAccumulatorCount() const {
   if (!m_accum) return 0;
-  std::lock_guard<wpi::mutex> lock(m_accum->m_mutex);
-  m_accum->Update();
-  return m_accum->m_count;
+  return m_accum->GetTotals().count;
 }
 
 /**
@@ -533,10 +686,9 @@ int64_t SPI::GetAccumulatorCount() const {
  */
 double SPI::GetAccumulatorAverage() const {
   if (!m_accum) return 0;
-  std::lock_guard<wpi::mutex> lock(m_accum->m_mutex);
-  m_accum->Update();
-  if (m_accum->m_count == 0) return 0.0;
-  return static_cast<double>(m_accum->m_value) / m_accum->m_count;
+  auto totals = m_accum->GetTotals();
+  if (totals.count == 0) return 0.0;
+  return static_cast<double>(totals.value) / totals.count;
 }
 
 /**
@@ -554,8 +706,7 @@ void SPI::GetAccumulatorOutput(int64_t& value, int64_t& count) const {
     count = 0;
     return;
   }
-  std::lock_guard<wpi::mutex> lock(m_accum->m_mutex);
-  m_accum->Update();
-  value = m_accum->m_value;
-  count = m_accum->m_count;
+  auto totals = m_accum->GetTotals();
+  value = totals.value;
+  count = totals.count;
 }
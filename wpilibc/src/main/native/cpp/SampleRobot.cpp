@@ -12,6 +12,7 @@
 
 #include "DriverStation.h"
 #include "LiveWindow/LiveWindow.h"
+#include "StartupProfiler.h"
 #include "Timer.h"
 
 using namespace frc;
@@ -29,7 +30,10 @@ using namespace frc;
 void SampleRobot::StartCompetition() {
   LiveWindow* lw = LiveWindow::GetInstance();
 
+  StartupProfiler::Mark("robot constructor");
   RobotInit();
+  StartupProfiler::Mark("RobotInit");
+  StartupProfiler::Finish();
 
   // Tell the DS that the robot is ready to be enabled
   HAL_ObserveUserProgramStarting();
@@ -0,0 +1,171 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "SerialFrameReader.h"
+
+#include <algorithm>
+
+#include <HAL/HAL.h>
+#include <HAL/OSSerialPort.h>
+#include <HAL/SerialPort.h>
+
+#include "SerialPort.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+/**
+ * Frames end with a delimiter byte, which is not part of the frame.
+ */
+SerialFrameReader::Splitter SerialFrameReader::DelimiterSplitter(
+    uint8_t delimiter) {
+  return [=](llvm::MutableArrayRef<uint8_t> data,
+             llvm::ArrayRef<uint8_t>& frame) -> size_t {
+    auto end = std::find(data.begin(), data.end(), delimiter);
+    if (end == data.end()) return 0;
+    size_t length = end - data.begin();
+    frame = data.slice(0, length);
+    return length + 1;
+  };
+}
+
+/**
+ * Frames start with their payload length as a little-endian integer of
+ * prefixSize (1 or 2) bytes.
+ */
+SerialFrameReader::Splitter SerialFrameReader::LengthPrefixSplitter(
+    int prefixSize) {
+  if (prefixSize != 2) prefixSize = 1;
+  return [=](llvm::MutableArrayRef<uint8_t> data,
+             llvm::ArrayRef<uint8_t>& frame) -> size_t {
+    size_t prefix = prefixSize;
+    if (data.size() < prefix) return 0;
+    size_t length = data[0];
+    if (prefix == 2) length |= static_cast<size_t>(data[1]) << 8;
+    if (data.size() < prefix + length) return 0;
+    frame = data.slice(prefix, length);
+    return prefix + length;
+  };
+}
+
+/**
+ * Frames are COBS encoded and end with a zero byte. Frames are decoded in
+ * place; malformed frames are discarded.
+ */
+SerialFrameReader::Splitter SerialFrameReader::COBSSplitter() {
+  return [](llvm::MutableArrayRef<uint8_t> data,
+            llvm::ArrayRef<uint8_t>& frame) -> size_t {
+    auto end = std::find(data.begin(), data.end(), 0);
+    if (end == data.end()) return 0;
+    size_t length = end - data.begin();
+
+    // The decoded data is never longer than what has been read so far, so it
+    // can be written over the encoded data
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+      uint8_t code = data[in++];
+      if (in + code - 1 > length) return length + 1;
+      for (int i = 1; i < code; i++) data[out++] = data[in++];
+      if (code != 0xFF && in < length) data[out++] = 0;
+    }
+    frame = data.slice(0, out);
+    return length + 1;
+  };
+}
+
+/**
+ * Start reading a port.
+ *
+ * @param port       The serial port to read.
+ * @param splitter   Finds frame boundaries in the received bytes.
+ * @param handler    Called on the reader thread with each complete frame.
+ * @param bufferSize The size of the receive buffer, in bytes. It must hold
+ *                   the largest frame; when a full buffer holds no complete
+ *                   frame its contents are dropped.
+ */
+SerialFrameReader::SerialFrameReader(SerialPort& port, Splitter splitter,
+                                     FrameHandler handler, int bufferSize)
+    : m_port(port.m_port),
+      m_osBackend(port.m_backend == SerialPort::kBackend_OS),
+      m_splitter(std::move(splitter)),
+      m_handler(std::move(handler)) {
+  if (bufferSize < 1) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "bufferSize");
+    bufferSize = 1;
+  }
+  m_buffer.resize(bufferSize);
+  m_thread = std::thread(&SerialFrameReader::ThreadMain, this);
+}
+
+SerialFrameReader::~SerialFrameReader() { Stop(); }
+
+/**
+ * Stop the reader thread. Waits for the read in progress to return.
+ */
+void SerialFrameReader::Stop() {
+  m_active = false;
+  if (m_thread.joinable()) m_thread.join();
+}
+
+/**
+ * Returns the number of frames handed to the handler.
+ */
+int64_t SerialFrameReader::GetFrameCount() const { return m_frameCount; }
+
+/**
+ * Returns the number of bytes dropped because the buffer filled up without
+ * holding a complete frame.
+ */
+int64_t SerialFrameReader::GetDroppedBytes() const { return m_droppedBytes; }
+
+void SerialFrameReader::ThreadMain() {
+  auto port = static_cast<HAL_SerialPort>(m_port);
+  while (m_active) {
+    int32_t status = 0;
+    // Wait for a single byte when nothing is queued, so frames are handled as
+    // soon as they arrive rather than when the buffer fills
+    int32_t available = m_osBackend ? HAL_GetOSSerialBytesReceived(port, &status)
+                                    : HAL_GetSerialBytesReceived(port, &status);
+    size_t count = std::max(available, 1);
+    count = std::min(count, m_buffer.size() - m_size);
+    char* data = reinterpret_cast<char*>(m_buffer.data() + m_size);
+    int32_t received = m_osBackend
+                           ? HAL_ReadOSSerial(port, data, count, &status)
+                           : HAL_ReadSerial(port, data, count, &status);
+    if (received <= 0) continue;
+    m_size += received;
+    Split();
+  }
+}
+
+void SerialFrameReader::Split() {
+  size_t start = 0;
+  while (start < m_size) {
+    llvm::ArrayRef<uint8_t> frame;
+    size_t used = m_splitter(
+        llvm::MutableArrayRef<uint8_t>(m_buffer.data() + start, m_size - start),
+        frame);
+    if (used == 0) break;
+    start += std::min(used, m_size - start);
+    if (!frame.empty()) {
+      ++m_frameCount;
+      m_handler(frame);
+    }
+  }
+
+  if (start > 0) {
+    std::copy(m_buffer.begin() + start, m_buffer.begin() + m_size,
+              m_buffer.begin());
+    m_size -= start;
+  }
+
+  if (m_size == m_buffer.size()) {
+    m_droppedBytes += m_size;
+    m_size = 0;
+  }
+}
@@ -8,8 +8,11 @@
 #include "SerialPort.h"
 
 #include <HAL/HAL.h>
+#include <HAL/OSSerialPort.h>
 #include <HAL/SerialPort.h>
 
+#include "WPIErrors.h"
+
 // static ViStatus _VI_FUNCH ioCompleteHandler (ViSession vi, ViEventType
 // eventType, ViEvent event, ViAddr userHandle);
 
@@ -25,25 +28,51 @@ using namespace frc;
  * @param parity   Select the type of parity checking to use.
  * @param stopBits The number of stop bits to use as defined by the enum
  *                 StopBits.
+ * @param backend  Whether to drive the port through NI-VISA or through its
+ *                 termios device.
  */
 SerialPort::SerialPort(int baudRate, Port port, int dataBits,
-                       SerialPort::Parity parity,
-                       SerialPort::StopBits stopBits) {
+                       SerialPort::Parity parity, SerialPort::StopBits stopBits,
+                       SerialPort::Backend backend) {
   int32_t status = 0;
 
   m_port = port;
+  m_backend = backend;
 
-  HAL_InitializeSerialPort(static_cast<HAL_SerialPort>(port), &status);
+  if (m_backend == kBackend_OS) {
+    HAL_InitializeOSSerialPort(static_cast<HAL_SerialPort>(port), &status);
+  } else {
+    HAL_InitializeSerialPort(static_cast<HAL_SerialPort>(port), &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
   // Don't continue if initialization failed
   if (status < 0) return;
-  HAL_SetSerialBaudRate(static_cast<HAL_SerialPort>(port), baudRate, &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialBaudRate(static_cast<HAL_SerialPort>(port), baudRate,
+                            &status);
+  } else {
+    HAL_SetSerialBaudRate(static_cast<HAL_SerialPort>(port), baudRate, &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
-  HAL_SetSerialDataBits(static_cast<HAL_SerialPort>(port), dataBits, &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialDataBits(static_cast<HAL_SerialPort>(port), dataBits,
+                            &status);
+  } else {
+    HAL_SetSerialDataBits(static_cast<HAL_SerialPort>(port), dataBits, &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
-  HAL_SetSerialParity(static_cast<HAL_SerialPort>(port), parity, &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialParity(static_cast<HAL_SerialPort>(port), parity, &status);
+  } else {
+    HAL_SetSerialParity(static_cast<HAL_SerialPort>(port), parity, &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
-  HAL_SetSerialStopBits(static_cast<HAL_SerialPort>(port), stopBits, &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialStopBits(static_cast<HAL_SerialPort>(port), stopBits,
+                            &status);
+  } else {
+    HAL_SetSerialStopBits(static_cast<HAL_SerialPort>(port), stopBits, &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 
   // Set the default timeout to 5 seconds.
@@ -117,7 +146,11 @@ SerialPort::SerialPort(int baudRate, llvm::StringRef portName, Port port,
  */
 SerialPort::~SerialPort() {
   int32_t status = 0;
-  HAL_CloseSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  if (m_backend == kBackend_OS) {
+    HAL_CloseOSSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  } else {
+    HAL_CloseSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -128,8 +161,13 @@ SerialPort::~SerialPort() {
  */
 void SerialPort::SetFlowControl(SerialPort::FlowControl flowControl) {
   int32_t status = 0;
-  HAL_SetSerialFlowControl(static_cast<HAL_SerialPort>(m_port), flowControl,
-                           &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialFlowControl(static_cast<HAL_SerialPort>(m_port), flowControl,
+                               &status);
+  } else {
+    HAL_SetSerialFlowControl(static_cast<HAL_SerialPort>(m_port), flowControl,
+                             &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -144,8 +182,13 @@ void SerialPort::SetFlowControl(SerialPort::FlowControl flowControl) {
  */
 void SerialPort::EnableTermination(char terminator) {
   int32_t status = 0;
-  HAL_EnableSerialTermination(static_cast<HAL_SerialPort>(m_port), terminator,
-                              &status);
+  if (m_backend == kBackend_OS) {
+    HAL_EnableOSSerialTermination(static_cast<HAL_SerialPort>(m_port),
+                                  terminator, &status);
+  } else {
+    HAL_EnableSerialTermination(static_cast<HAL_SerialPort>(m_port), terminator,
+                                &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -154,7 +197,12 @@ void SerialPort::EnableTermination(char terminator) {
  */
 void SerialPort::DisableTermination() {
   int32_t status = 0;
-  HAL_DisableSerialTermination(static_cast<HAL_SerialPort>(m_port), &status);
+  if (m_backend == kBackend_OS) {
+    HAL_DisableOSSerialTermination(static_cast<HAL_SerialPort>(m_port),
+                                   &status);
+  } else {
+    HAL_DisableSerialTermination(static_cast<HAL_SerialPort>(m_port), &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -165,8 +213,14 @@ void SerialPort::DisableTermination() {
  */
 int SerialPort::GetBytesReceived() {
   int32_t status = 0;
-  int retVal =
-      HAL_GetSerialBytesReceived(static_cast<HAL_SerialPort>(m_port), &status);
+  int retVal;
+  if (m_backend == kBackend_OS) {
+    retVal = HAL_GetOSSerialBytesReceived(static_cast<HAL_SerialPort>(m_port),
+                                          &status);
+  } else {
+    retVal = HAL_GetSerialBytesReceived(static_cast<HAL_SerialPort>(m_port),
+                                        &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
   return retVal;
 }
@@ -180,8 +234,14 @@ int SerialPort::GetBytesReceived() {
  */
 int SerialPort::Read(char* buffer, int count) {
   int32_t status = 0;
-  int retVal = HAL_ReadSerial(static_cast<HAL_SerialPort>(m_port), buffer,
+  int retVal;
+  if (m_backend == kBackend_OS) {
+    retVal = HAL_ReadOSSerial(static_cast<HAL_SerialPort>(m_port), buffer,
                               count, &status);
+  } else {
+    retVal = HAL_ReadSerial(static_cast<HAL_SerialPort>(m_port), buffer, count,
+                            &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
   return retVal;
 }
@@ -208,8 +268,14 @@ int SerialPort::Write(const char* buffer, int count) {
  */
 int SerialPort::Write(llvm::StringRef buffer) {
   int32_t status = 0;
-  int retVal = HAL_WriteSerial(static_cast<HAL_SerialPort>(m_port),
+  int retVal;
+  if (m_backend == kBackend_OS) {
+    retVal = HAL_WriteOSSerial(static_cast<HAL_SerialPort>(m_port),
                                buffer.data(), buffer.size(), &status);
+  } else {
+    retVal = HAL_WriteSerial(static_cast<HAL_SerialPort>(m_port), buffer.data(),
+                             buffer.size(), &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
   return retVal;
 }
@@ -224,7 +290,12 @@ int SerialPort::Write(llvm::StringRef buffer) {
  */
 void SerialPort::SetTimeout(double timeout) {
   int32_t status = 0;
-  HAL_SetSerialTimeout(static_cast<HAL_SerialPort>(m_port), timeout, &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialTimeout(static_cast<HAL_SerialPort>(m_port), timeout,
+                           &status);
+  } else {
+    HAL_SetSerialTimeout(static_cast<HAL_SerialPort>(m_port), timeout, &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -242,8 +313,13 @@ void SerialPort::SetTimeout(double timeout) {
  */
 void SerialPort::SetReadBufferSize(int size) {
   int32_t status = 0;
-  HAL_SetSerialReadBufferSize(static_cast<HAL_SerialPort>(m_port), size,
-                              &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialReadBufferSize(static_cast<HAL_SerialPort>(m_port), size,
+                                  &status);
+  } else {
+    HAL_SetSerialReadBufferSize(static_cast<HAL_SerialPort>(m_port), size,
+                                &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -257,8 +333,13 @@ void SerialPort::SetReadBufferSize(int size) {
  */
 void SerialPort::SetWriteBufferSize(int size) {
   int32_t status = 0;
-  HAL_SetSerialWriteBufferSize(static_cast<HAL_SerialPort>(m_port), size,
-                               &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialWriteBufferSize(static_cast<HAL_SerialPort>(m_port), size,
+                                   &status);
+  } else {
+    HAL_SetSerialWriteBufferSize(static_cast<HAL_SerialPort>(m_port), size,
+                                 &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -275,7 +356,12 @@ void SerialPort::SetWriteBufferSize(int size) {
  */
 void SerialPort::SetWriteBufferMode(SerialPort::WriteBufferMode mode) {
   int32_t status = 0;
-  HAL_SetSerialWriteMode(static_cast<HAL_SerialPort>(m_port), mode, &status);
+  if (m_backend == kBackend_OS) {
+    HAL_SetOSSerialWriteMode(static_cast<HAL_SerialPort>(m_port), mode,
+                             &status);
+  } else {
+    HAL_SetSerialWriteMode(static_cast<HAL_SerialPort>(m_port), mode, &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -287,7 +373,11 @@ void SerialPort::SetWriteBufferMode(SerialPort::WriteBufferMode mode) {
  */
 void SerialPort::Flush() {
   int32_t status = 0;
-  HAL_FlushSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  if (m_backend == kBackend_OS) {
+    HAL_FlushOSSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  } else {
+    HAL_FlushSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  }
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
 }
 
@@ -298,6 +388,50 @@ void SerialPort::Flush() {
  */
 void SerialPort::Reset() {
   int32_t status = 0;
-  HAL_ClearSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  if (m_backend == kBackend_OS) {
+    HAL_ClearOSSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  } else {
+    HAL_ClearSerial(static_cast<HAL_SerialPort>(m_port), &status);
+  }
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Set whether the driver passes received bytes on as soon as they arrive.
+ *
+ * USB serial drivers otherwise hold received bytes for several milliseconds
+ * to batch them. USB ports are put in low latency mode when opened. Only
+ * supported by the kBackend_OS backend.
+ *
+ * @param lowLatency True to pass received bytes on immediately.
+ */
+void SerialPort::SetLowLatency(bool lowLatency) {
+  if (m_backend != kBackend_OS) {
+    wpi_setWPIErrorWithContext(IncompatibleMode,
+                               "low latency needs the kBackend_OS backend");
+    return;
+  }
+  int32_t status = 0;
+  HAL_SetOSSerialLowLatency(static_cast<HAL_SerialPort>(m_port), lowLatency,
+                            &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Get a file descriptor to wait on for received data with poll() or select().
+ *
+ * The descriptor is readable once Read() can return without waiting. Bytes
+ * left over from a read stopped by the terminator do not make it readable, so
+ * check GetBytesReceived() before waiting. It must not be read, written or
+ * closed directly.
+ *
+ * @return The file descriptor, or -1 with the kBackend_VISA backend.
+ */
+int SerialPort::GetFileDescriptor() {
+  if (m_backend != kBackend_OS) return -1;
+  int32_t status = 0;
+  int fd = HAL_GetOSSerialFileDescriptor(static_cast<HAL_SerialPort>(m_port),
+                                         &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  return fd;
 }
@@ -0,0 +1,324 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "ShmChannel.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#include "WPIErrors.h"
+
+using namespace frc;
+
+constexpr int ShmChannelBase::kDefaultDepth;
+
+static constexpr uint32_t kMagic = 0x4d485343u;  // "CSHM"
+static constexpr uint32_t kVersion = 1;
+// Slots start a cache line after the header, and are cache line aligned
+static constexpr size_t kCacheLine = 64;
+#ifndef __linux__
+// How often a waiting subscriber without a futex checks for messages
+static constexpr std::chrono::microseconds kPollPeriod{200};
+#endif
+
+struct ShmChannelBase::Header {
+  std::atomic<uint32_t> magic;
+  uint32_t version;
+  uint32_t messageSize;
+  uint32_t depth;
+  // the number of messages published
+  std::atomic<uint64_t> published;
+  // the futex word, changed by every publish
+  std::atomic<uint32_t> doorbell;
+  // the number of subscribers sleeping on the doorbell
+  std::atomic<uint32_t> waiters;
+};
+
+// The message follows the sequence, which is odd while it is written and
+// 2 * (message + 1) once message has been published in the slot
+struct ShmChannelBase::Slot {
+  std::atomic<uint64_t> sequence;
+
+  uint8_t* GetData() { return reinterpret_cast<uint8_t*>(this + 1); }
+};
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "the doorbell must be usable as a futex");
+
+#ifdef __linux__
+static void FutexWait(std::atomic<uint32_t>& word, uint32_t value,
+                      std::chrono::nanoseconds timeout) {
+  struct timespec ts;
+  ts.tv_sec = timeout.count() / 1000000000;
+  ts.tv_nsec = timeout.count() % 1000000000;
+  // Not FUTEX_PRIVATE_FLAG: the word is shared between processes
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, value,
+            &ts, nullptr, 0);
+}
+
+static void FutexWakeAll(std::atomic<uint32_t>& word) {
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX,
+            nullptr, nullptr, 0);
+}
+#endif
+
+/**
+ * Opens a channel.
+ *
+ * @param name        The name of the channel
+ * @param messageSize The size of each message, which every user of the
+ *                    channel must agree on
+ * @param depth       The number of messages the channel holds, which every
+ *                    user of the channel must agree on
+ * @param publisher   True to create the channel and publish to it
+ */
+ShmChannelBase::ShmChannelBase(llvm::StringRef name, size_t messageSize,
+                               int depth, bool publisher)
+    : m_name("/frc_" + name.str()),
+      m_messageSize(messageSize),
+      m_slotStride((sizeof(Slot) + messageSize + kCacheLine - 1) /
+                   kCacheLine * kCacheLine),
+      m_depth(std::max(depth, 1)),
+      m_publisher(publisher) {
+  static_assert(sizeof(Header) <= kCacheLine,
+                "the header must fit before the first slot");
+  m_size = kCacheLine + m_slotStride * m_depth;
+#ifdef _WIN32
+  wpi_setWPIErrorWithContext(IncompatibleMode,
+                             "shared memory is not supported on Windows");
+#else
+  if (m_publisher) {
+    if (!Create()) wpi_setErrnoErrorWithContext(m_name);
+  } else {
+    Attach();
+  }
+#endif
+}
+
+ShmChannelBase::~ShmChannelBase() {
+#ifndef _WIN32
+  // The channel is left for the subscribers, and for the next publisher
+  if (m_header) ::munmap(m_header, m_size);
+#endif
+}
+
+/**
+ * Returns whether the channel is mapped. A subscriber attaches once the
+ * publisher has created the channel.
+ */
+bool ShmChannelBase::IsAttached() {
+  if (!m_header && !m_publisher) Attach();
+  return m_header != nullptr;
+}
+
+/**
+ * Returns the number of messages published to the channel.
+ */
+uint64_t ShmChannelBase::GetPublishedCount() {
+  if (!IsAttached()) return 0;
+  return m_header->published.load(std::memory_order_acquire);
+}
+
+/**
+ * Returns the number of messages a subscriber lost because it fell more than
+ * the depth of the channel behind the publisher. Messages skipped by
+ * GetLatest() aren't counted.
+ */
+uint64_t ShmChannelBase::GetLostCount() const { return m_lost; }
+
+void* ShmChannelBase::BeginWrite() {
+  if (!m_header) return nullptr;
+  Slot* slot = GetSlot(m_next);
+  slot->sequence.store(2 * m_next + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  return slot->GetData();
+}
+
+void ShmChannelBase::EndWrite() {
+  GetSlot(m_next)->sequence.store(2 * m_next + 2, std::memory_order_release);
+  m_header->published.store(++m_next, std::memory_order_release);
+  // A subscriber counts itself as a waiter before checking the doorbell, so
+  // either it is woken here or it sees the new doorbell and doesn't sleep
+  m_header->doorbell++;
+#ifdef __linux__
+  if (m_header->waiters > 0) FutexWakeAll(m_header->doorbell);
+#endif
+}
+
+bool ShmChannelBase::ReadNext(void* data) {
+  if (!IsAttached()) return false;
+  for (;;) {
+    uint64_t published = m_header->published.load(std::memory_order_acquire);
+    // A new publisher started the channel over
+    if (m_next > published) m_next = published;
+    if (m_next == published) return false;
+    if (published - m_next > m_depth) {
+      m_lost += published - m_depth - m_next;
+      m_next = published - m_depth;
+    }
+    if (ReadMessage(m_next++, data)) return true;
+    // overwritten while it was read
+    m_lost++;
+  }
+}
+
+bool ShmChannelBase::ReadLatest(void* data) {
+  if (!IsAttached()) return false;
+  for (;;) {
+    uint64_t published = m_header->published.load(std::memory_order_acquire);
+    if (m_next == published) return false;
+    m_next = published;
+    // Only fails if the publisher lapped the ring while it was read
+    if (ReadMessage(published - 1, data)) return true;
+  }
+}
+
+bool ShmChannelBase::WaitForNext(double timeout) {
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::duration<double>(timeout));
+  for (;;) {
+    auto remaining = deadline - std::chrono::steady_clock::now();
+    if (!IsAttached()) {
+      if (remaining <= remaining.zero()) return false;
+      std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+          remaining, std::chrono::milliseconds(10)));
+      continue;
+    }
+
+#ifdef __linux__
+    m_header->waiters++;
+#endif
+    uint32_t doorbell = m_header->doorbell;
+    uint64_t published = m_header->published.load(std::memory_order_acquire);
+    bool ready = published != m_next;
+    if (!ready && remaining > remaining.zero()) {
+#ifdef __linux__
+      FutexWait(m_header->doorbell, doorbell, remaining);
+#else
+      std::this_thread::sleep_for(
+          std::min<std::chrono::nanoseconds>(remaining, kPollPeriod));
+#endif
+    }
+#ifdef __linux__
+    m_header->waiters--;
+#endif
+    if (ready) return true;
+    if (remaining <= remaining.zero()) return false;
+  }
+}
+
+bool ShmChannelBase::Create() {
+#ifdef _WIN32
+  return false;
+#else
+  int fd = ::shm_open(m_name.c_str(), O_RDWR | O_CREAT, 0666);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0 ||
+      (static_cast<size_t>(st.st_size) < m_size &&
+       ::ftruncate(fd, m_size) != 0)) {
+    int err = errno;
+    ::close(fd);
+    errno = err;
+    return false;
+  }
+  void* mem =
+      ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int err = errno;
+  ::close(fd);
+  if (mem == MAP_FAILED) {
+    errno = err;
+    return false;
+  }
+
+  m_header = static_cast<Header*>(mem);
+  m_slots = static_cast<uint8_t*>(mem) + kCacheLine;
+  if (m_header->magic.load(std::memory_order_acquire) == kMagic &&
+      m_header->version == kVersion &&
+      m_header->messageSize == m_messageSize && m_header->depth == m_depth) {
+    // Continue where the last publisher stopped
+    m_next = m_header->published.load(std::memory_order_acquire);
+    return true;
+  }
+
+  // A new channel, or one left with another layout; subscribers attach once
+  // the magic is set again
+  m_header->magic.store(0, std::memory_order_relaxed);
+  m_header->version = kVersion;
+  m_header->messageSize = m_messageSize;
+  m_header->depth = m_depth;
+  m_header->published.store(0, std::memory_order_relaxed);
+  for (uint32_t i = 0; i < m_depth; i++) {
+    GetSlot(i)->sequence.store(0, std::memory_order_relaxed);
+  }
+  m_header->magic.store(kMagic, std::memory_order_release);
+  return true;
+#endif
+}
+
+bool ShmChannelBase::Attach() {
+#ifdef _WIN32
+  return false;
+#else
+  // Until the publisher creates the channel, there is nothing to report
+  int fd = ::shm_open(m_name.c_str(), O_RDWR, 0);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < m_size) {
+    ::close(fd);
+    return false;
+  }
+  void* mem =
+      ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mem == MAP_FAILED) return false;
+
+  auto header = static_cast<Header*>(mem);
+  if (header->magic.load(std::memory_order_acquire) != kMagic ||
+      header->version != kVersion || header->messageSize != m_messageSize ||
+      header->depth != m_depth) {
+    ::munmap(mem, m_size);
+    return false;
+  }
+  m_header = header;
+  m_slots = static_cast<uint8_t*>(mem) + kCacheLine;
+  // Start with the messages published from now on
+  m_next = header->published.load(std::memory_order_acquire);
+  return true;
+#endif
+}
+
+ShmChannelBase::Slot* ShmChannelBase::GetSlot(uint64_t message) const {
+  return reinterpret_cast<Slot*>(m_slots + (message % m_depth) * m_slotStride);
+}
+
+bool ShmChannelBase::ReadMessage(uint64_t message, void* data) const {
+  Slot* slot = GetSlot(message);
+  uint64_t sequence = 2 * message + 2;
+  if (slot->sequence.load(std::memory_order_acquire) != sequence) return false;
+  std::memcpy(data, slot->GetData(), m_messageSize);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot->sequence.load(std::memory_order_relaxed) == sequence;
+}
@@ -7,14 +7,70 @@
 
 #include "SmartDashboard/SendableBuilderImpl.h"
 
+#include <algorithm>
+
 #include <llvm/SmallString.h>
 
+#include "Internal/TelemetryTransaction.h"
 #include "ntcore_cpp.h"
 
 using namespace frc;
 
+namespace {
+
+// The last value a property published, so an update can skip setting the
+// entry when the getter returns the same value again.
+template <typename T>
+class LastValue {
+ public:
+  bool Update(T value, bool force) {
+    if (!force && m_valid && value == m_value) return false;
+    m_value = value;
+    m_valid = true;
+    return true;
+  }
+
+ private:
+  T m_value{};
+  bool m_valid = false;
+};
+
+template <typename T>
+class LastArray {
+ public:
+  bool Update(llvm::ArrayRef<T> value, bool force) {
+    if (!force && m_valid && value.size() == m_value.size() &&
+        std::equal(value.begin(), value.end(), m_value.begin()))
+      return false;
+    m_value.assign(value.begin(), value.end());
+    m_valid = true;
+    return true;
+  }
+
+ private:
+  std::vector<T> m_value;
+  bool m_valid = false;
+};
+
+class LastString {
+ public:
+  bool Update(llvm::StringRef value, bool force) {
+    if (!force && m_valid && value == m_value) return false;
+    m_value.assign(value.data(), value.size());
+    m_valid = true;
+    return true;
+  }
+
+ private:
+  std::string m_value;
+  bool m_valid = false;
+};
+
+}  // namespace
+
 void SendableBuilderImpl::SetTable(std::shared_ptr<nt::NetworkTable> table) {
   m_table = table;
+  m_forceUpdate = true;
 }
 
 std::shared_ptr<nt::NetworkTable> SendableBuilderImpl::GetTable() {
@@ -24,8 +80,9 @@ std::shared_ptr<nt::NetworkTable> SendableBuilderImpl::GetTable() {
 void SendableBuilderImpl::UpdateTable() {
   uint64_t time = nt::Now();
   for (auto& property : m_properties) {
-    if (property.update) property.update(property.entry, time);
+    if (property.update) property.update(property.entry, time, m_forceUpdate);
   }
+  m_forceUpdate = false;
   if (m_updateTable) m_updateTable();
 }
 
@@ -40,11 +97,13 @@ void SendableBuilderImpl::StopListeners() {
 void SendableBuilderImpl::StartLiveWindowMode() {
   if (m_safeState) m_safeState();
   StartListeners();
+  m_forceUpdate = true;
 }
 
 void SendableBuilderImpl::StopLiveWindowMode() {
   StopListeners();
   if (m_safeState) m_safeState();
+  m_forceUpdate = true;
 }
 
 void SendableBuilderImpl::SetSmartDashboardType(const llvm::Twine& type) {
@@ -68,9 +127,12 @@ void SendableBuilderImpl::AddBooleanProperty(const llvm::Twine& key,
                                              std::function<void(bool)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    LastValue<bool> last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeBoolean(getter(), time));
+                                     uint64_t time, bool force) mutable {
+      bool value = getter();
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(entry, nt::Value::MakeBoolean(value, time));
     };
   }
   if (setter) {
@@ -91,9 +153,12 @@ void SendableBuilderImpl::AddDoubleProperty(
     std::function<void(double)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    LastValue<double> last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeDouble(getter(), time));
+                                     uint64_t time, bool force) mutable {
+      double value = getter();
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(entry, nt::Value::MakeDouble(value, time));
     };
   }
   if (setter) {
@@ -114,9 +179,13 @@ void SendableBuilderImpl::AddStringProperty(
     std::function<void(llvm::StringRef)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    LastString last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeString(getter(), time));
+                                     uint64_t time, bool force) mutable {
+      auto value = getter();
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(
+            entry, nt::Value::MakeString(std::move(value), time));
     };
   }
   if (setter) {
@@ -137,9 +206,13 @@ void SendableBuilderImpl::AddBooleanArrayProperty(
     std::function<void(llvm::ArrayRef<int>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    LastArray<int> last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeBooleanArray(getter(), time));
+                                     uint64_t time, bool force) mutable {
+      auto value = getter();
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(
+            entry, nt::Value::MakeBooleanArray(value, time));
     };
   }
   if (setter) {
@@ -160,9 +233,13 @@ void SendableBuilderImpl::AddDoubleArrayProperty(
     std::function<void(llvm::ArrayRef<double>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    LastArray<double> last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeDoubleArray(getter(), time));
+                                     uint64_t time, bool force) mutable {
+      auto value = getter();
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(
+            entry, nt::Value::MakeDoubleArray(value, time));
     };
   }
   if (setter) {
@@ -183,9 +260,13 @@ void SendableBuilderImpl::AddStringArrayProperty(
     std::function<void(llvm::ArrayRef<std::string>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    LastArray<std::string> last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeStringArray(getter(), time));
+                                     uint64_t time, bool force) mutable {
+      auto value = getter();
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(
+            entry, nt::Value::MakeStringArray(std::move(value), time));
     };
   }
   if (setter) {
@@ -206,9 +287,13 @@ void SendableBuilderImpl::AddRawProperty(
     std::function<void(llvm::StringRef)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    LastString last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(nt::Value::MakeRaw(getter(), time));
+                                     uint64_t time, bool force) mutable {
+      auto value = getter();
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(
+            entry, nt::Value::MakeRaw(std::move(value), time));
     };
   }
   if (setter) {
@@ -230,8 +315,8 @@ void SendableBuilderImpl::AddValueProperty(
   m_properties.emplace_back(*m_table, key);
   if (getter) {
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      entry.SetValue(getter());
+                                     uint64_t time, bool force) {
+      detail::SetTelemetryValue(entry, getter());
     };
   }
   if (setter) {
@@ -250,10 +335,14 @@ void SendableBuilderImpl::AddSmallStringProperty(
     std::function<void(llvm::StringRef)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    llvm::SmallString<128> buf;
+    LastString last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      llvm::SmallString<128> buf;
-      entry.SetValue(nt::Value::MakeString(getter(buf), time));
+                                     uint64_t time, bool force) mutable {
+      buf.clear();
+      auto value = getter(buf);
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(entry, nt::Value::MakeString(value, time));
     };
   }
   if (setter) {
@@ -275,10 +364,15 @@ void SendableBuilderImpl::AddSmallBooleanArrayProperty(
     std::function<void(llvm::ArrayRef<int>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    llvm::SmallVector<int, 16> buf;
+    LastArray<int> last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      llvm::SmallVector<int, 16> buf;
-      entry.SetValue(nt::Value::MakeBooleanArray(getter(buf), time));
+                                     uint64_t time, bool force) mutable {
+      buf.clear();
+      auto value = getter(buf);
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(
+            entry, nt::Value::MakeBooleanArray(value, time));
     };
   }
   if (setter) {
@@ -301,10 +395,15 @@ void SendableBuilderImpl::AddSmallDoubleArrayProperty(
     std::function<void(llvm::ArrayRef<double>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    llvm::SmallVector<double, 16> buf;
+    LastArray<double> last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      llvm::SmallVector<double, 16> buf;
-      entry.SetValue(nt::Value::MakeDoubleArray(getter(buf), time));
+                                     uint64_t time, bool force) mutable {
+      buf.clear();
+      auto value = getter(buf);
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(
+            entry, nt::Value::MakeDoubleArray(value, time));
     };
   }
   if (setter) {
@@ -328,10 +427,15 @@ void SendableBuilderImpl::AddSmallStringArrayProperty(
     std::function<void(llvm::ArrayRef<std::string>)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    llvm::SmallVector<std::string, 16> buf;
+    LastArray<std::string> last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      llvm::SmallVector<std::string, 16> buf;
-      entry.SetValue(nt::Value::MakeStringArray(getter(buf), time));
+                                     uint64_t time, bool force) mutable {
+      buf.clear();
+      auto value = getter(buf);
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(
+            entry, nt::Value::MakeStringArray(value, time));
     };
   }
   if (setter) {
@@ -353,10 +457,14 @@ void SendableBuilderImpl::AddSmallRawProperty(
     std::function<void(llvm::StringRef)> setter) {
   m_properties.emplace_back(*m_table, key);
   if (getter) {
+    llvm::SmallVector<char, 128> buf;
+    LastString last;
     m_properties.back().update = [=](nt::NetworkTableEntry entry,
-                                     uint64_t time) {
-      llvm::SmallVector<char, 128> buf;
-      entry.SetValue(nt::Value::MakeRaw(getter(buf), time));
+                                     uint64_t time, bool force) mutable {
+      buf.clear();
+      auto value = getter(buf);
+      if (last.Update(value, force))
+        detail::SetTelemetryValue(entry, nt::Value::MakeRaw(value, time));
     };
   }
   if (setter) {
@@ -17,3 +17,32 @@ const char* SendableChooserBase::kSelected = "selected";
  * Instantiates a SendableChooser.
  */
 SendableChooserBase::SendableChooserBase() : SendableBase(false) {}
+
+/**
+ * Sets the entry the dashboard writes its selection to and listens to it, so
+ * the selection is known without reading the entry.
+ */
+void SendableChooserBase::SetSelectedEntry(nt::NetworkTableEntry entry) {
+  RemoveSelectionListener();
+  m_selectedEntry = entry;
+  m_selectionListener = m_selectedEntry.AddListener(
+      [=](const nt::EntryNotification& event) {
+        if (event.value && event.value->IsString()) {
+          UpdateSelection(event.value->GetString());
+        } else {
+          UpdateSelection("");
+        }
+      },
+      NT_NOTIFY_IMMEDIATE | NT_NOTIFY_NEW | NT_NOTIFY_UPDATE |
+          NT_NOTIFY_DELETE);
+}
+
+/**
+ * Stops listening to the selected entry. Must be called by the destructor of
+ * the derived class, before the state UpdateSelection() uses is destroyed.
+ */
+void SendableChooserBase::RemoveSelectionListener() {
+  if (m_selectionListener == 0) return;
+  m_selectedEntry.RemoveListener(m_selectionListener);
+  m_selectionListener = 0;
+}
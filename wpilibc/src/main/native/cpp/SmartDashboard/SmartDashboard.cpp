@@ -13,8 +13,10 @@
 #include <support/mutex.h>
 
 #include "HLUsageReporting.h"
+#include "Internal/TelemetryTransaction.h"
 #include "SmartDashboard/Sendable.h"
 #include "SmartDashboard/SendableBuilderImpl.h"
+#include "Tracing.h"
 #include "WPIErrors.h"
 
 using namespace frc;
@@ -25,18 +27,29 @@ class SmartDashboardData {
   SmartDashboardData() = default;
   explicit SmartDashboardData(Sendable* sendable_) : sendable(sendable_) {}
 
+  // Creates the table of the sendable and publishes it
+  void Initialize(nt::NetworkTable& table, llvm::StringRef key);
+
   Sendable* sendable = nullptr;
   SendableBuilderImpl builder;
+  bool initialized = false;
 };
 
 class Singleton {
  public:
   static Singleton& GetInstance();
 
+  nt::NetworkTableEntry GetEntry(llvm::StringRef key);
+
   std::shared_ptr<nt::NetworkTable> table;
   llvm::StringMap<SmartDashboardData> tablesToData;
   wpi::mutex tablesToDataMutex;
 
+  // Entries by key, so repeated calls don't build the full entry path and
+  // look it up in NetworkTables again
+  llvm::StringMap<nt::NetworkTableEntry> entries;
+  wpi::mutex entriesMutex;
+
  private:
   Singleton() {
     table = nt::NetworkTableInstance::GetDefault().GetTable("SmartDashboard");
@@ -53,8 +66,40 @@ Singleton& Singleton::GetInstance() {
   return instance;
 }
 
+nt::NetworkTableEntry Singleton::GetEntry(llvm::StringRef key) {
+  std::lock_guard<wpi::mutex> lock(entriesMutex);
+  auto& entry = entries[key];
+  if (!entry) entry = table->GetEntry(key);
+  return entry;
+}
+
+void SmartDashboardData::Initialize(nt::NetworkTable& table,
+                                    llvm::StringRef key) {
+  auto dataTable = table.GetSubTable(key);
+  builder.SetTable(dataTable);
+  sendable->InitSendable(builder);
+  builder.UpdateTable();
+  builder.StartListeners();
+  dataTable->GetEntry(".name").SetString(key);
+  initialized = true;
+}
+
 void SmartDashboard::init() { Singleton::GetInstance(); }
 
+/**
+ * Returns the NetworkTables entry for a key.
+ *
+ * Entries are cached, so this is cheaper than going through the table. Code
+ * that publishes the same value every loop can also keep the returned entry
+ * and set it directly, skipping the key lookup entirely.
+ *
+ * @param key the key name
+ * @return the entry for the key
+ */
+nt::NetworkTableEntry SmartDashboard::GetEntry(llvm::StringRef key) {
+  return Singleton::GetInstance().GetEntry(key);
+}
+
 /**
  * Determines whether the given key is in this table.
  *
@@ -79,7 +124,7 @@ std::vector<std::string> SmartDashboard::GetKeys(int types) {
  * @param key the key to make persistent
  */
 void SmartDashboard::SetPersistent(llvm::StringRef key) {
-  Singleton::GetInstance().table->GetEntry(key).SetPersistent();
+  Singleton::GetInstance().GetEntry(key).SetPersistent();
 }
 
 /**
@@ -89,7 +134,7 @@ void SmartDashboard::SetPersistent(llvm::StringRef key) {
  * @param key the key name
  */
 void SmartDashboard::ClearPersistent(llvm::StringRef key) {
-  Singleton::GetInstance().table->GetEntry(key).ClearPersistent();
+  Singleton::GetInstance().GetEntry(key).ClearPersistent();
 }
 
 /**
@@ -99,7 +144,7 @@ void SmartDashboard::ClearPersistent(llvm::StringRef key) {
  * @param key the key name
  */
 bool SmartDashboard::IsPersistent(llvm::StringRef key) {
-  return Singleton::GetInstance().table->GetEntry(key).IsPersistent();
+  return Singleton::GetInstance().GetEntry(key).IsPersistent();
 }
 
 /**
@@ -110,7 +155,7 @@ bool SmartDashboard::IsPersistent(llvm::StringRef key) {
  * @param flags the flags to set (bitmask)
  */
 void SmartDashboard::SetFlags(llvm::StringRef key, unsigned int flags) {
-  Singleton::GetInstance().table->GetEntry(key).SetFlags(flags);
+  Singleton::GetInstance().GetEntry(key).SetFlags(flags);
 }
 
 /**
@@ -121,7 +166,7 @@ void SmartDashboard::SetFlags(llvm::StringRef key, unsigned int flags) {
  * @param flags the flags to clear (bitmask)
  */
 void SmartDashboard::ClearFlags(llvm::StringRef key, unsigned int flags) {
-  Singleton::GetInstance().table->GetEntry(key).ClearFlags(flags);
+  Singleton::GetInstance().GetEntry(key).ClearFlags(flags);
 }
 
 /**
@@ -131,7 +176,7 @@ void SmartDashboard::ClearFlags(llvm::StringRef key, unsigned int flags) {
  * @return the flags, or 0 if the key is not defined
  */
 unsigned int SmartDashboard::GetFlags(llvm::StringRef key) {
-  return Singleton::GetInstance().table->GetEntry(key).GetFlags();
+  return Singleton::GetInstance().GetEntry(key).GetFlags();
 }
 
 /**
@@ -149,6 +194,9 @@ void SmartDashboard::Delete(llvm::StringRef key) {
  * The value can be retrieved by calling the get method with a key that is equal
  * to the original key.
  *
+ * The table of the value isn't created until a dashboard connects; the next
+ * UpdateValues() after that publishes it.
+ *
  * @param keyName the key
  * @param value   the value
  */
@@ -162,12 +210,8 @@ void SmartDashboard::PutData(llvm::StringRef key, Sendable* data) {
   auto& sddata = inst.tablesToData[key];
   if (!sddata.sendable || sddata.sendable != data) {
     sddata = SmartDashboardData(data);
-    auto dataTable = inst.table->GetSubTable(key);
-    sddata.builder.SetTable(dataTable);
-    data->InitSendable(sddata.builder);
-    sddata.builder.UpdateTable();
-    sddata.builder.StartListeners();
-    dataTable->GetEntry(".name").SetString(key);
+    if (nt::NetworkTableInstance::GetDefault().IsConnected())
+      sddata.Initialize(*inst.table, key);
   }
 }
 
@@ -218,7 +262,8 @@ Sendable* SmartDashboard::GetData(llvm::StringRef key) {
  */
 bool SmartDashboard::PutValue(llvm::StringRef keyName,
                               std::shared_ptr<nt::Value> value) {
-  return Singleton::GetInstance().table->GetEntry(keyName).SetValue(value);
+  return detail::SetTelemetryValue(Singleton::GetInstance().GetEntry(keyName),
+                                   value);
 }
 
 /**
@@ -230,7 +275,7 @@ bool SmartDashboard::PutValue(llvm::StringRef keyName,
  */
 bool SmartDashboard::SetDefaultValue(llvm::StringRef key,
                                      std::shared_ptr<nt::Value> defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDefaultValue(
+  return Singleton::GetInstance().GetEntry(key).SetDefaultValue(
       defaultValue);
 }
 
@@ -242,7 +287,9 @@ bool SmartDashboard::SetDefaultValue(llvm::StringRef key,
  * @param value   the object to retrieve the value into
  */
 std::shared_ptr<nt::Value> SmartDashboard::GetValue(llvm::StringRef keyName) {
-  return Singleton::GetInstance().table->GetEntry(keyName).GetValue();
+  auto entry = Singleton::GetInstance().GetEntry(keyName);
+  if (auto staged = detail::GetStagedTelemetryValue(entry)) return staged;
+  return entry.GetValue();
 }
 
 /**
@@ -256,7 +303,8 @@ std::shared_ptr<nt::Value> SmartDashboard::GetValue(llvm::StringRef keyName) {
  * @return        False if the table key already exists with a different type
  */
 bool SmartDashboard::PutBoolean(llvm::StringRef keyName, bool value) {
-  return Singleton::GetInstance().table->GetEntry(keyName).SetBoolean(value);
+  return detail::SetTelemetryValue(Singleton::GetInstance().GetEntry(keyName),
+                                   nt::Value::MakeBoolean(value));
 }
 
 /**
@@ -266,7 +314,7 @@ bool SmartDashboard::PutBoolean(llvm::StringRef keyName, bool value) {
  * @returns False if the table key exists with a different type
  */
 bool SmartDashboard::SetDefaultBoolean(llvm::StringRef key, bool defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDefaultBoolean(
+  return Singleton::GetInstance().GetEntry(key).SetDefaultBoolean(
       defaultValue);
 }
 
@@ -279,8 +327,12 @@ bool SmartDashboard::SetDefaultBoolean(llvm::StringRef key, bool defaultValue) {
  * @return the value
  */
 bool SmartDashboard::GetBoolean(llvm::StringRef keyName, bool defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(keyName).GetBoolean(
-      defaultValue);
+  auto entry = Singleton::GetInstance().GetEntry(keyName);
+  auto staged = detail::GetStagedTelemetryValue(entry);
+  if (staged && staged->IsBoolean()) {
+    return staged->GetBoolean();
+  }
+  return entry.GetBoolean(defaultValue);
 }
 
 /**
@@ -294,7 +346,8 @@ bool SmartDashboard::GetBoolean(llvm::StringRef keyName, bool defaultValue) {
  * @return        False if the table key already exists with a different type
  */
 bool SmartDashboard::PutNumber(llvm::StringRef keyName, double value) {
-  return Singleton::GetInstance().table->GetEntry(keyName).SetDouble(value);
+  return detail::SetTelemetryValue(Singleton::GetInstance().GetEntry(keyName),
+                                   nt::Value::MakeDouble(value));
 }
 
 /**
@@ -306,7 +359,7 @@ bool SmartDashboard::PutNumber(llvm::StringRef keyName, double value) {
  */
 bool SmartDashboard::SetDefaultNumber(llvm::StringRef key,
                                       double defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDefaultDouble(
+  return Singleton::GetInstance().GetEntry(key).SetDefaultDouble(
       defaultValue);
 }
 
@@ -319,8 +372,12 @@ bool SmartDashboard::SetDefaultNumber(llvm::StringRef key,
  * @return the value
  */
 double SmartDashboard::GetNumber(llvm::StringRef keyName, double defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(keyName).GetDouble(
-      defaultValue);
+  auto entry = Singleton::GetInstance().GetEntry(keyName);
+  auto staged = detail::GetStagedTelemetryValue(entry);
+  if (staged && staged->IsDouble()) {
+    return staged->GetDouble();
+  }
+  return entry.GetDouble(defaultValue);
 }
 
 /**
@@ -334,7 +391,8 @@ double SmartDashboard::GetNumber(llvm::StringRef keyName, double defaultValue) {
  * @return        False if the table key already exists with a different type
  */
 bool SmartDashboard::PutString(llvm::StringRef keyName, llvm::StringRef value) {
-  return Singleton::GetInstance().table->GetEntry(keyName).SetString(value);
+  return detail::SetTelemetryValue(Singleton::GetInstance().GetEntry(keyName),
+                                   nt::Value::MakeString(value));
 }
 
 /**
@@ -345,7 +403,7 @@ bool SmartDashboard::PutString(llvm::StringRef keyName, llvm::StringRef value) {
  */
 bool SmartDashboard::SetDefaultString(llvm::StringRef key,
                                       llvm::StringRef defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDefaultString(
+  return Singleton::GetInstance().GetEntry(key).SetDefaultString(
       defaultValue);
 }
 
@@ -359,8 +417,12 @@ bool SmartDashboard::SetDefaultString(llvm::StringRef key,
  */
 std::string SmartDashboard::GetString(llvm::StringRef keyName,
                                       llvm::StringRef defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(keyName).GetString(
-      defaultValue);
+  auto entry = Singleton::GetInstance().GetEntry(keyName);
+  auto staged = detail::GetStagedTelemetryValue(entry);
+  if (staged && staged->IsString()) {
+    return staged->GetString().str();
+  }
+  return entry.GetString(defaultValue);
 }
 
 /**
@@ -376,7 +438,8 @@ std::string SmartDashboard::GetString(llvm::StringRef keyName,
  */
 bool SmartDashboard::PutBooleanArray(llvm::StringRef key,
                                      llvm::ArrayRef<int> value) {
-  return Singleton::GetInstance().table->GetEntry(key).SetBooleanArray(value);
+  return detail::SetTelemetryValue(Singleton::GetInstance().GetEntry(key),
+                                   nt::Value::MakeBooleanArray(value));
 }
 
 /**
@@ -388,7 +451,7 @@ bool SmartDashboard::PutBooleanArray(llvm::StringRef key,
  */
 bool SmartDashboard::SetDefaultBooleanArray(llvm::StringRef key,
                                             llvm::ArrayRef<int> defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDefaultBooleanArray(
+  return Singleton::GetInstance().GetEntry(key).SetDefaultBooleanArray(
       defaultValue);
 }
 
@@ -412,8 +475,13 @@ bool SmartDashboard::SetDefaultBooleanArray(llvm::StringRef key,
  */
 std::vector<int> SmartDashboard::GetBooleanArray(
     llvm::StringRef key, llvm::ArrayRef<int> defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).GetBooleanArray(
-      defaultValue);
+  auto entry = Singleton::GetInstance().GetEntry(key);
+  auto staged = detail::GetStagedTelemetryValue(entry);
+  if (staged && staged->IsBooleanArray()) {
+    auto value = staged->GetBooleanArray();
+    return std::vector<int>(value.begin(), value.end());
+  }
+  return entry.GetBooleanArray(defaultValue);
 }
 
 /**
@@ -425,7 +493,8 @@ std::vector<int> SmartDashboard::GetBooleanArray(
  */
 bool SmartDashboard::PutNumberArray(llvm::StringRef key,
                                     llvm::ArrayRef<double> value) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDoubleArray(value);
+  return detail::SetTelemetryValue(Singleton::GetInstance().GetEntry(key),
+                                   nt::Value::MakeDoubleArray(value));
 }
 
 /**
@@ -437,7 +506,7 @@ bool SmartDashboard::PutNumberArray(llvm::StringRef key,
  */
 bool SmartDashboard::SetDefaultNumberArray(
     llvm::StringRef key, llvm::ArrayRef<double> defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDefaultDoubleArray(
+  return Singleton::GetInstance().GetEntry(key).SetDefaultDoubleArray(
       defaultValue);
 }
 
@@ -457,8 +526,13 @@ bool SmartDashboard::SetDefaultNumberArray(
  */
 std::vector<double> SmartDashboard::GetNumberArray(
     llvm::StringRef key, llvm::ArrayRef<double> defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).GetDoubleArray(
-      defaultValue);
+  auto entry = Singleton::GetInstance().GetEntry(key);
+  auto staged = detail::GetStagedTelemetryValue(entry);
+  if (staged && staged->IsDoubleArray()) {
+    auto value = staged->GetDoubleArray();
+    return std::vector<double>(value.begin(), value.end());
+  }
+  return entry.GetDoubleArray(defaultValue);
 }
 
 /**
@@ -470,7 +544,8 @@ std::vector<double> SmartDashboard::GetNumberArray(
  */
 bool SmartDashboard::PutStringArray(llvm::StringRef key,
                                     llvm::ArrayRef<std::string> value) {
-  return Singleton::GetInstance().table->GetEntry(key).SetStringArray(value);
+  return detail::SetTelemetryValue(Singleton::GetInstance().GetEntry(key),
+                                   nt::Value::MakeStringArray(value));
 }
 
 /**
@@ -482,7 +557,7 @@ bool SmartDashboard::PutStringArray(llvm::StringRef key,
  */
 bool SmartDashboard::SetDefaultStringArray(
     llvm::StringRef key, llvm::ArrayRef<std::string> defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDefaultStringArray(
+  return Singleton::GetInstance().GetEntry(key).SetDefaultStringArray(
       defaultValue);
 }
 
@@ -502,8 +577,13 @@ bool SmartDashboard::SetDefaultStringArray(
  */
 std::vector<std::string> SmartDashboard::GetStringArray(
     llvm::StringRef key, llvm::ArrayRef<std::string> defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).GetStringArray(
-      defaultValue);
+  auto entry = Singleton::GetInstance().GetEntry(key);
+  auto staged = detail::GetStagedTelemetryValue(entry);
+  if (staged && staged->IsStringArray()) {
+    auto value = staged->GetStringArray();
+    return std::vector<std::string>(value.begin(), value.end());
+  }
+  return entry.GetStringArray(defaultValue);
 }
 
 /**
@@ -514,7 +594,8 @@ std::vector<std::string> SmartDashboard::GetStringArray(
  * @return False if the table key already exists with a different type
  */
 bool SmartDashboard::PutRaw(llvm::StringRef key, llvm::StringRef value) {
-  return Singleton::GetInstance().table->GetEntry(key).SetRaw(value);
+  return detail::SetTelemetryValue(Singleton::GetInstance().GetEntry(key),
+                                   nt::Value::MakeRaw(value));
 }
 
 /**
@@ -526,7 +607,7 @@ bool SmartDashboard::PutRaw(llvm::StringRef key, llvm::StringRef value) {
  */
 bool SmartDashboard::SetDefaultRaw(llvm::StringRef key,
                                    llvm::StringRef defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).SetDefaultRaw(
+  return Singleton::GetInstance().GetEntry(key).SetDefaultRaw(
       defaultValue);
 }
 
@@ -546,16 +627,51 @@ bool SmartDashboard::SetDefaultRaw(llvm::StringRef key,
  */
 std::string SmartDashboard::GetRaw(llvm::StringRef key,
                                    llvm::StringRef defaultValue) {
-  return Singleton::GetInstance().table->GetEntry(key).GetRaw(defaultValue);
+  auto entry = Singleton::GetInstance().GetEntry(key);
+  auto staged = detail::GetStagedTelemetryValue(entry);
+  if (staged && staged->IsRaw()) {
+    return staged->GetRaw().str();
+  }
+  return entry.GetRaw(defaultValue);
 }
 
 /**
  * Puts all sendable data to the dashboard.
+ *
+ * Nothing is put until a dashboard connects. Sendables put with PutData()
+ * before then get their tables the first time this is called while a
+ * dashboard is connected.
  */
 void SmartDashboard::UpdateValues() {
+  FRC_TRACE_SCOPE("SmartDashboard::UpdateValues");
+  if (!nt::NetworkTableInstance::GetDefault().IsConnected()) return;
   auto& inst = Singleton::GetInstance();
   std::lock_guard<wpi::mutex> lock(inst.tablesToDataMutex);
   for (auto& i : inst.tablesToData) {
-    i.getValue().builder.UpdateTable();
+    auto& sddata = i.getValue();
+    if (sddata.initialized)
+      sddata.builder.UpdateTable();
+    else
+      sddata.Initialize(*inst.table, i.getKey());
   }
 }
+
+/**
+ * Starts staging dashboard writes in memory until CommitTransaction().
+ *
+ * While a transaction is open, values put with this class, the properties of
+ * sendables and the other telemetry the library publishes are kept in memory
+ * instead of being set in NetworkTables, and gets return the staged values.
+ * The robot base classes open a transaction at the start of each loop and
+ * commit it at the end, so everything written during a loop reaches the
+ * dashboard in the same update.
+ */
+void SmartDashboard::BeginTransaction() { detail::BeginTelemetryTransaction(); }
+
+/**
+ * Sets every value staged since BeginTransaction() and flushes NetworkTables,
+ * sending them to the dashboard in one update.
+ */
+void SmartDashboard::CommitTransaction() {
+  detail::CommitTelemetryTransaction();
+}
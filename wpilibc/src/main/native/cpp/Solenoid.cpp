@@ -58,6 +58,9 @@ Solenoid::Solenoid(int moduleNumber, int channel)
   HAL_Report(HALUsageReporting::kResourceType_Solenoid, m_channel,
              m_moduleNumber);
   SetName("Solenoid", m_moduleNumber, m_channel);
+  m_log.Init(DeviceLogClass::kSolenoid,
+             "Solenoid/" + llvm::Twine(m_moduleNumber) + "/" +
+                 llvm::Twine(m_channel));
 }
 
 /**
@@ -75,6 +78,7 @@ void Solenoid::Set(bool on) {
   int32_t status = 0;
   HAL_SetSolenoid(m_solenoidHandle, on, &status);
   wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  m_log.Log(on);
 }
 
 /**
@@ -12,6 +12,26 @@
 
 using namespace frc;
 
+/**
+ * Start holding solenoid changes on a PCM.
+ *
+ * @param module The CAN PCM ID.
+ */
+SolenoidBase::Transaction::Transaction(int module) : m_module(module) {
+  int32_t status = 0;
+  HAL_BeginSolenoidTransaction(m_module, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Send the held solenoid changes.
+ */
+SolenoidBase::Transaction::~Transaction() {
+  int32_t status = 0;
+  HAL_EndSolenoidTransaction(m_module, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
 /**
  * Constructor
  *
@@ -42,6 +62,31 @@ int SolenoidBase::GetAll() const {
   return SolenoidBase::GetAll(m_moduleNumber);
 }
 
+/**
+ * Set several solenoids at once, with a single update of the PCM control
+ * frame.
+ *
+ * @param module the module to write to
+ * @param values the new values of the solenoids, one bit per channel
+ * @param mask   the channels to set, one bit per channel
+ */
+void SolenoidBase::SetAll(int module, int values, int mask) {
+  int32_t status = 0;
+  HAL_SetSolenoids(module, mask, values, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+/**
+ * Set several solenoids at once, with a single update of the PCM control
+ * frame.
+ *
+ * @param values the new values of the solenoids, one bit per channel
+ * @param mask   the channels to set, one bit per channel
+ */
+void SolenoidBase::SetAll(int values, int mask) {
+  SolenoidBase::SetAll(m_moduleNumber, values, mask);
+}
+
 /**
  * Reads complete solenoid blacklist for all 8 solenoids as a single byte.
  *
@@ -0,0 +1,147 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "StartupProfiler.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include <llvm/Format.h>
+#include <llvm/raw_ostream.h>
+#include <networktables/NetworkTableInstance.h>
+#include <support/mutex.h>
+
+#include "Timer.h"
+
+using namespace frc;
+
+const char* StartupProfiler::kFile = "/home/lvuser/startup_timing.txt";
+const char* StartupProfiler::kTable = "StartupTiming";
+
+namespace {
+struct Entry {
+  std::string name;
+  double start;
+  double duration;
+  // Phases are sequential; operations happen within them
+  bool phase;
+  const char* hint;
+};
+
+struct Profile {
+  wpi::mutex mutex;
+  std::vector<Entry> entries;
+  double start = -1;
+  double lastMark = -1;
+  std::atomic_bool finished{false};
+};
+}  // namespace
+
+static Profile& GetProfile() {
+  static Profile profile;
+  return profile;
+}
+
+// Starts the profile on first use; the profile mutex must be held
+static void Begin(Profile& profile, double now) {
+  if (profile.start < 0) {
+    profile.start = now;
+    profile.lastMark = now;
+  }
+}
+
+/**
+ * Starts timing an operation.
+ *
+ * @param name The name to record the operation under
+ * @param hint How to move the operation off the startup path, printed if it
+ *             is slow
+ */
+StartupProfiler::Scope::Scope(llvm::StringRef name, const char* hint)
+    : m_name(name), m_hint(hint), m_start(Timer::GetFPGATimestamp()) {}
+
+StartupProfiler::Scope::~Scope() {
+  if (IsFinished()) return;
+  Record(m_name, m_start, Timer::GetFPGATimestamp() - m_start, m_hint);
+}
+
+/**
+ * Ends the current phase of startup, which began at the previous mark or the
+ * start of the profile.
+ *
+ * @param phase The name of the phase that just ended
+ */
+void StartupProfiler::Mark(llvm::StringRef phase) {
+  Profile& profile = GetProfile();
+  if (profile.finished) return;
+  double now = Timer::GetFPGATimestamp();
+  std::lock_guard<wpi::mutex> lock(profile.mutex);
+  Begin(profile, now);
+  profile.entries.push_back(
+      {phase, profile.lastMark, now - profile.lastMark, true, nullptr});
+  profile.lastMark = now;
+}
+
+/**
+ * Records an operation that happened during startup.
+ *
+ * @param name     The name of the operation
+ * @param start    The FPGA time the operation started, in seconds
+ * @param duration How long the operation took, in seconds
+ * @param hint     How to move the operation off the startup path, printed if
+ *                 it is slow
+ */
+void StartupProfiler::Record(llvm::StringRef name, double start,
+                             double duration, const char* hint) {
+  Profile& profile = GetProfile();
+  if (profile.finished) return;
+  std::lock_guard<wpi::mutex> lock(profile.mutex);
+  Begin(profile, start);
+  profile.entries.push_back({name, start, duration, false, hint});
+}
+
+/**
+ * Ends the profile and reports it. Called by the robot classes just before
+ * they tell the driver station the robot is ready.
+ */
+void StartupProfiler::Finish() {
+  Profile& profile = GetProfile();
+  if (profile.finished.exchange(true)) return;
+  std::lock_guard<wpi::mutex> lock(profile.mutex);
+  double total = profile.lastMark - profile.start;
+
+  std::FILE* file = std::fopen(kFile, "w");
+  auto table = nt::NetworkTableInstance::GetDefault().GetTable(kTable);
+  llvm::outs() << "Robot startup took " << llvm::format("%.3f", total)
+               << "s:\n";
+  for (const auto& entry : profile.entries) {
+    llvm::outs() << (entry.phase ? "  " : "    ") << entry.name << ' '
+                 << llvm::format("%.3f", entry.duration) << "s\n";
+    if (file != nullptr) {
+      std::fprintf(file, "%s,%.6f,%.6f\n", entry.name.c_str(),
+                   entry.start - profile.start, entry.duration);
+    }
+    table->GetEntry(entry.name).SetDouble(entry.duration);
+    if (!entry.phase && entry.duration > kSlowOperation) {
+      llvm::outs() << "Warning: " << entry.name << " delayed startup by "
+                   << llvm::format("%.3f", entry.duration) << "s";
+      if (entry.hint) llvm::outs() << "; " << entry.hint;
+      llvm::outs() << '\n';
+    }
+  }
+  if (file != nullptr) std::fclose(file);
+  table->GetEntry("Total").SetDouble(total);
+  profile.entries.clear();
+  profile.entries.shrink_to_fit();
+}
+
+/**
+ * Returns whether startup has finished and the profile has been reported.
+ */
+bool StartupProfiler::IsFinished() { return GetProfile().finished; }
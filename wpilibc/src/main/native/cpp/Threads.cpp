@@ -82,4 +82,53 @@ bool SetCurrentThreadPriority(bool realTime, int priority) {
   wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
   return ret;
 }
+
+int GetThreadAffinity(std::thread& thread) {
+  int32_t status = 0;
+  auto native = thread.native_handle();
+  auto ret = HAL_GetThreadAffinity(&native, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+  return ret;
+}
+
+bool SetThreadAffinity(std::thread& thread, int cpuMask) {
+  int32_t status = 0;
+  auto native = thread.native_handle();
+  auto ret = HAL_SetThreadAffinity(&native, cpuMask, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+  return ret;
+}
+
+bool SetCurrentThreadAffinity(int cpuMask) {
+  int32_t status = 0;
+  auto ret = HAL_SetCurrentThreadAffinity(cpuMask, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+  return ret;
+}
+
+bool LockProcessMemory(int stackPrefaultSize) {
+  int32_t status = 0;
+  auto ret = HAL_LockProcessMemory(stackPrefaultSize, &status);
+  wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+  return ret;
+}
+
+std::vector<ThreadCPUUsage> GetThreadCPUUsage() {
+  std::vector<ThreadCPUUsage> usage(16);
+  for (;;) {
+    int32_t status = 0;
+    int32_t threads =
+        HAL_GetThreadCPUUsage(usage.data(), usage.size(), &status);
+    if (status != 0) {
+      wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+      return {};
+    }
+    // Threads may have started since the count was taken; read again
+    if (threads <= static_cast<int32_t>(usage.size())) {
+      usage.resize(threads);
+      return usage;
+    }
+    usage.resize(threads + 4);
+  }
+}
 }  // namespace frc
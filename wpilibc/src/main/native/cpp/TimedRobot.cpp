@@ -7,24 +7,44 @@
 
 #include "TimedRobot.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 #include <HAL/HAL.h>
 
+#include "RobotController.h"
+#include "StartupProfiler.h"
+#include "WPIErrors.h"
+
 using namespace frc;
 
+// Converts seconds to whole microseconds
+static uint64_t ToMicroseconds(double seconds) {
+  return seconds > 0.0 ? static_cast<uint64_t>(std::llround(seconds * 1e6))
+                       : 0;
+}
+
 /**
  * Provide an alternate "main loop" via StartCompetition().
  */
 void TimedRobot::StartCompetition() {
+  StartupProfiler::Mark("robot constructor");
   RobotInit();
+  StartupProfiler::Mark("RobotInit");
+  StartupProfiler::Finish();
 
   // Tell the DS that the robot is ready to be enabled
   HAL_ObserveUserProgramStarting();
 
   // Loop forever, calling the appropriate mode-dependent function
-  m_startLoop = true;
-  m_loop->StartPeriodic(m_period);
+  {
+    std::lock_guard<wpi::mutex> lock(m_callbackMutex);
+    m_startLoop = true;
+    m_startTime = RobotController::GetFPGATime();
+    for (auto& callback : m_callbacks) StartCallback(callback, m_startTime);
+    ScheduleNext();
+  }
   while (true) {
     std::this_thread::sleep_for(std::chrono::hours(24));
   }
@@ -41,9 +61,16 @@ void TimedRobot::StartCompetition() {
  */
 void TimedRobot::SetPeriod(double period) {
   m_period = period;
+  GetLoopProfiler().SetPeriod(period);
+  GetWatchdog().SetTimeout(period);
 
+  std::lock_guard<wpi::mutex> lock(m_callbackMutex);
+  auto& loop = m_callbacks.front();
+  // the loop can't run more than once per microsecond
+  loop.period = std::max<uint64_t>(ToMicroseconds(period), 1);
   if (m_startLoop) {
-    m_loop->StartPeriodic(period);
+    loop.expirationTime = RobotController::GetFPGATime() + loop.period;
+    ScheduleNext();
   }
 }
 
@@ -52,8 +79,41 @@ void TimedRobot::SetPeriod(double period) {
  */
 double TimedRobot::GetPeriod() const { return m_period; }
 
+/**
+ * Add a callback to run at its own rate on the main loop's Notifier thread.
+ *
+ * Fast control loops and slow telemetry can be interleaved this way without a
+ * thread each. Callbacks due at the same time run in the order they were
+ * added, after the main loop. If a callback overruns, the periods it missed
+ * are skipped rather than run back to back.
+ *
+ * @param callback The function to call.
+ * @param period   Period in seconds between calls.
+ * @param offset   Phase in seconds of the calls, relative to the start of the
+ *                 main loop, to spread callbacks with the same period across
+ *                 it.
+ */
+void TimedRobot::AddPeriodic(std::function<void()> callback, double period,
+                             double offset) {
+  if (ToMicroseconds(period) == 0) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange, "period");
+    return;
+  }
+
+  std::lock_guard<wpi::mutex> lock(m_callbackMutex);
+  m_callbacks.push_back({std::make_shared<std::function<void()>>(callback),
+                         ToMicroseconds(period), ToMicroseconds(offset), 0});
+  if (m_startLoop) {
+    StartCallback(m_callbacks.back(), RobotController::GetFPGATime());
+    ScheduleNext();
+  }
+}
+
 TimedRobot::TimedRobot() {
-  m_loop = std::make_unique<Notifier>(&TimedRobot::LoopFunc, this);
+  m_callbacks.push_back(
+      {std::make_shared<std::function<void()>>([=] { LoopFunc(); }),
+       std::max<uint64_t>(ToMicroseconds(m_period), 1), 0, 0});
+  m_loop = std::make_unique<Notifier>(&TimedRobot::ProcessCallbacks, this);
 
   // HAL_Report(HALUsageReporting::kResourceType_Framework,
   //            HALUsageReporting::kFramework_Periodic);
@@ -62,3 +122,47 @@ TimedRobot::TimedRobot() {
 }
 
 TimedRobot::~TimedRobot() { m_loop->Stop(); }
+
+void TimedRobot::ProcessCallbacks() {
+  for (;;) {
+    std::shared_ptr<std::function<void()>> func;
+    {
+      std::lock_guard<wpi::mutex> lock(m_callbackMutex);
+      uint64_t now = RobotController::GetFPGATime();
+      Callback* next = nullptr;
+      for (auto& callback : m_callbacks) {
+        if (callback.expirationTime <= now &&
+            (next == nullptr ||
+             callback.expirationTime < next->expirationTime)) {
+          next = &callback;
+        }
+      }
+      if (next == nullptr) {
+        ScheduleNext();
+        return;
+      }
+      func = next->func;
+      next->expirationTime +=
+          next->period * ((now - next->expirationTime) / next->period + 1);
+    }
+
+    // The callback may add callbacks or change the period
+    (*func)();
+  }
+}
+
+void TimedRobot::ScheduleNext() {
+  uint64_t next = m_callbacks.front().expirationTime;
+  for (auto& callback : m_callbacks) {
+    if (callback.expirationTime < next) next = callback.expirationTime;
+  }
+  uint64_t now = RobotController::GetFPGATime();
+  m_loop->StartSingle(
+      std::chrono::microseconds(next > now ? next - now : 0));
+}
+
+void TimedRobot::StartCallback(Callback& callback, uint64_t now) {
+  uint64_t first = m_startTime + callback.offset;
+  uint64_t slots = now >= first ? (now - first) / callback.period + 1 : 0;
+  callback.expirationTime = first + callback.period * slots;
+}
@@ -8,13 +8,36 @@
 #include "Timer.h"
 
 #include <chrono>
+#include <cmath>
 #include <thread>
 
 #include <HAL/HAL.h>
+#include <HAL/Notifier.h>
 
 #include "DriverStation.h"
 #include "RobotController.h"
 
+#ifndef __FRC_ROBORIO__
+namespace {
+// A notifier for Wait() to wait on, kept for the life of the thread so that
+// waits don't create and clean up one each time
+struct WaitNotifier {
+  WaitNotifier() {
+    int32_t status = 0;
+    handle = HAL_InitializeNotifier(&status);
+    if (status != 0) handle = HAL_kInvalidHandle;
+  }
+  ~WaitNotifier() {
+    if (handle == HAL_kInvalidHandle) return;
+    int32_t status = 0;
+    HAL_CleanNotifier(handle, &status);
+  }
+
+  HAL_NotifierHandle handle;
+};
+}  // namespace
+#endif
+
 namespace frc {
 
 /**
@@ -25,9 +48,27 @@ namespace frc {
  * sensors will continue to update. Only the task containing the wait will pause
  * until the wait time is expired.
  *
+ * In simulation the wait is on simulated time, which may be paused or run
+ * faster than the wall clock.
+ *
  * @param seconds Length of time to pause, in seconds.
  */
 void Wait(double seconds) {
+  if (seconds <= 0.0) return;
+#ifndef __FRC_ROBORIO__
+  thread_local WaitNotifier notifier;
+  if (notifier.handle != HAL_kInvalidHandle) {
+    int32_t status = 0;
+    uint64_t now = HAL_GetFPGATime(&status);
+    HAL_UpdateNotifierAlarm(
+        notifier.handle,
+        now + static_cast<uint64_t>(std::llround(seconds * 1e6)), &status);
+    HAL_WaitForNotifierAlarm(notifier.handle, &status);
+    // Tells the sim that nothing runs on the alarm, so stepping continues
+    HAL_CancelNotifierAlarm(notifier.handle, &status);
+    return;
+  }
+#endif
   std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
 }
 
@@ -171,6 +212,19 @@ double Timer::GetFPGATimestamp() {
   return RobotController::GetFPGATime() * 1.0e-6;
 }
 
+/**
+ * Return the FPGA system clock time in seconds, read from the CPU's clock.
+ *
+ * This is much cheaper than GetFPGATimestamp() because it does not access the
+ * FPGA, and it is within tens of microseconds of it. Use it for timeouts and
+ * timing measurements that do not need the exact hardware time.
+ *
+ * @returns Robot running time in seconds.
+ */
+double Timer::GetFastTimestamp() {
+  return RobotController::GetFPGATimeFast() * 1.0e-6;
+}
+
 /**
  * Return the approximate match time.
  *
@@ -0,0 +1,294 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Tracing.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <HAL/HAL.h>
+#include <llvm/SmallString.h>
+#include <llvm/raw_ostream.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "DriverStation.h"
+
+using namespace frc;
+
+constexpr size_t Tracing::kBufferSize;
+constexpr double Tracing::kMinDumpPeriod;
+
+std::atomic<bool> Tracing::s_enabled{false};
+
+namespace {
+struct Span {
+  std::atomic<const char*> name;
+  std::atomic<uint64_t> begin;
+  std::atomic<uint64_t> end;
+};
+
+// Written only by the thread owning it. A span is counted in begun before it
+// is written and in done after, so a dump can tell which of the spans it
+// copied were overwritten while it was copying them.
+struct Buffer {
+  explicit Buffer(int id_) : id(id_) {}
+
+  std::unique_ptr<Span[]> spans{new Span[Tracing::kBufferSize]};
+  std::atomic<uint64_t> begun{0};
+  std::atomic<uint64_t> done{0};
+  // cleared when the thread owning it exits, so another can take it
+  std::atomic<bool> inUse{true};
+  int id;
+};
+
+// The buffer of the calling thread, given up when it exits
+struct ThreadBuffer {
+  ~ThreadBuffer() {
+    if (buffer) buffer->inUse.store(false, std::memory_order_release);
+  }
+  std::shared_ptr<Buffer> buffer;
+};
+
+struct Event {
+  const char* name;
+  uint64_t begin;
+  uint64_t end;
+  int thread;
+};
+
+struct State {
+  wpi::mutex mutex;
+  // shared with the thread each belongs to, which may outlive the state
+  std::vector<std::shared_ptr<Buffer>> buffers;
+
+  wpi::condition_variable dumpCond;
+  std::string dumpDirectory;
+  bool dumpOnOverrun = false;
+  bool dumpPending = false;
+  bool dumpThreadStarted = false;
+  std::atomic<uint64_t> lastDumpTime{0};
+};
+}  // namespace
+
+// Never destroyed, since the dump thread and exiting threads may still use it
+// during static destruction
+static State& GetState() {
+  static State* state = new State;
+  return *state;
+}
+
+static Buffer* GetThreadBuffer() {
+  thread_local ThreadBuffer threadBuffer;
+  if (threadBuffer.buffer) return threadBuffer.buffer.get();
+
+  // Take over the buffer of a thread that has exited, or add a new one
+  State& state = GetState();
+  std::lock_guard<wpi::mutex> lock(state.mutex);
+  for (auto& buffer : state.buffers) {
+    bool inUse = false;
+    if (buffer->inUse.compare_exchange_strong(inUse, true,
+                                              std::memory_order_acquire)) {
+      threadBuffer.buffer = buffer;
+      return buffer.get();
+    }
+  }
+  state.buffers.push_back(std::make_shared<Buffer>(state.buffers.size() + 1));
+  threadBuffer.buffer = state.buffers.back();
+  return threadBuffer.buffer.get();
+}
+
+// Copies the spans of every thread that have not been overwritten
+static std::vector<Event> TakeSnapshot() {
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  {
+    State& state = GetState();
+    std::lock_guard<wpi::mutex> lock(state.mutex);
+    buffers = state.buffers;
+  }
+
+  std::vector<Event> events;
+  for (auto& buffer : buffers) {
+    uint64_t done = buffer->done.load(std::memory_order_acquire);
+    uint64_t first = done > Tracing::kBufferSize ? done - Tracing::kBufferSize
+                                                 : 0;
+    size_t start = events.size();
+    for (uint64_t i = first; i < done; i++) {
+      const Span& span = buffer->spans[i % Tracing::kBufferSize];
+      events.push_back({span.name.load(std::memory_order_relaxed),
+                        span.begin.load(std::memory_order_relaxed),
+                        span.end.load(std::memory_order_relaxed), buffer->id});
+    }
+
+    // Drop the spans the thread started overwriting during the copy
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t begun = buffer->begun.load(std::memory_order_relaxed);
+    uint64_t valid = begun > Tracing::kBufferSize
+                         ? begun - Tracing::kBufferSize
+                         : 0;
+    if (valid > first) {
+      size_t overwritten = std::min(valid, done) - first;
+      events.erase(events.begin() + start,
+                   events.begin() + start + overwritten);
+    }
+  }
+  return events;
+}
+
+static void WriteString(std::FILE* file, const char* str) {
+  std::fputc('"', file);
+  for (; *str != '\0'; str++) {
+    unsigned char c = *str;
+    if (c == '"' || c == '\\') {
+      std::fputc('\\', file);
+      std::fputc(c, file);
+    } else if (c < 0x20) {
+      std::fprintf(file, "\\u%04x", c);
+    } else {
+      std::fputc(c, file);
+    }
+  }
+  std::fputc('"', file);
+}
+
+static void DumpThreadMain() {
+  State& state = GetState();
+  std::unique_lock<wpi::mutex> lock(state.mutex);
+  for (;;) {
+    state.dumpCond.wait(lock, [&] { return state.dumpPending; });
+    state.dumpPending = false;
+
+    std::time_t now = std::time(nullptr);
+    char timeStr[32];
+    std::strftime(timeStr, sizeof(timeStr), "%Y%m%d_%H%M%S",
+                  std::localtime(&now));
+    llvm::SmallString<128> path;
+    llvm::raw_svector_ostream os(path);
+    os << state.dumpDirectory << "/trace_" << timeStr << ".json";
+
+    lock.unlock();
+    if (Tracing::Dump(path)) {
+      DriverStation::ReportWarning("Loop overrun trace written to " +
+                                   path.str());
+    }
+    lock.lock();
+  }
+}
+
+/**
+ * Turns recording spans on or off. Spans already recorded are kept.
+ */
+void Tracing::Enable(bool enabled) { s_enabled = enabled; }
+
+/**
+ * Records a span that has already ended.
+ *
+ * @param name  The name of the span, which must outlive the program's traces.
+ * @param begin FPGA time the span began, in microseconds.
+ * @param end   FPGA time the span ended, in microseconds.
+ */
+void Tracing::Record(const char* name, uint64_t begin, uint64_t end) {
+  Buffer* buffer = GetThreadBuffer();
+  uint64_t index = buffer->done.load(std::memory_order_relaxed);
+  buffer->begun.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  Span& span = buffer->spans[index % kBufferSize];
+  span.name.store(name, std::memory_order_relaxed);
+  span.begin.store(begin, std::memory_order_relaxed);
+  span.end.store(end, std::memory_order_relaxed);
+  buffer->done.store(index + 1, std::memory_order_release);
+}
+
+/**
+ * Writes the buffered spans of every thread to a Chrome trace JSON file.
+ *
+ * Recording continues while the file is written.
+ *
+ * @param path The file to write.
+ * @return True if the file was written.
+ */
+bool Tracing::Dump(llvm::StringRef path) {
+  std::vector<Event> events = TakeSnapshot();
+
+  llvm::SmallString<128> pathStr = path;
+  std::FILE* file = std::fopen(pathStr.c_str(), "w");
+  if (file == nullptr) {
+    DriverStation::ReportError("Could not write trace " + path + ": " +
+                               std::strerror(errno));
+    return false;
+  }
+  std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+  bool first = true;
+  for (const auto& event : events) {
+    if (!first) std::fputc(',', file);
+    first = false;
+    std::fputs("\n{\"name\":", file);
+    WriteString(file, event.name);
+    std::fprintf(file,
+                 ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%llu}",
+                 event.thread, static_cast<unsigned long long>(event.begin),
+                 static_cast<unsigned long long>(event.end - event.begin));
+  }
+  std::fputs("\n]}\n", file);
+  bool ok = !std::ferror(file);
+  if (std::fclose(file) != 0) ok = false;
+  if (!ok) DriverStation::ReportError("Could not write trace " + path);
+  return ok;
+}
+
+/**
+ * Sets whether a trace is written each time a LoopProfiler loop overruns its
+ * period, while tracing is enabled.
+ *
+ * Traces are written by a background thread, at most once per kMinDumpPeriod,
+ * to files named by the time they are written.
+ *
+ * @param dump      True to write a trace on overruns.
+ * @param directory The directory to write the traces to.
+ */
+void Tracing::SetDumpOnOverrun(bool dump, llvm::StringRef directory) {
+  State& state = GetState();
+  std::lock_guard<wpi::mutex> lock(state.mutex);
+  state.dumpOnOverrun = dump;
+  state.dumpDirectory = directory;
+  if (dump && !state.dumpThreadStarted) {
+    state.dumpThreadStarted = true;
+    std::thread(DumpThreadMain).detach();
+  }
+}
+
+/**
+ * Writes a trace in the background if SetDumpOnOverrun() is set. Called by
+ * LoopProfiler at the end of a loop that overran its period.
+ */
+void Tracing::ReportOverrun() {
+  if (!IsEnabled()) return;
+  State& state = GetState();
+  uint64_t now = GetTime();
+  uint64_t last = state.lastDumpTime.load(std::memory_order_relaxed);
+  if (last != 0 && now - last < kMinDumpPeriod * 1e6) return;
+  {
+    std::lock_guard<wpi::mutex> lock(state.mutex);
+    if (!state.dumpOnOverrun) return;
+    state.dumpPending = true;
+    state.lastDumpTime = now;
+  }
+  state.dumpCond.notify_one();
+}
+
+uint64_t Tracing::GetTime() {
+  int32_t status = 0;
+  return HAL_GetFPGATimeFast(&status);
+}
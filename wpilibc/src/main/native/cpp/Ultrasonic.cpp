@@ -7,11 +7,14 @@
 
 #include "Ultrasonic.h"
 
+#include <algorithm>
+
 #include <HAL/HAL.h>
 
 #include "Counter.h"
 #include "DigitalInput.h"
 #include "DigitalOutput.h"
+#include "RobotController.h"
 #include "SmartDashboard/SendableBuilder.h"
 #include "Timer.h"
 #include "Utility.h"
@@ -30,23 +33,122 @@ std::thread Ultrasonic::m_thread;
  * each one in turn. The counter is configured to read the timing of the
  * returned echo pulse.
  *
+ * Sensors in the same ping group are pinged together. The next group is
+ * pinged as soon as every sensor of this one has received its echo or timed
+ * out.
+ *
  * DANGER WILL ROBINSON, DANGER WILL ROBINSON:
  * This code runs as a task and assumes that none of the ultrasonic sensors
  * will change while it's running. Make sure to disable automatic mode before
  * touching the list.
  */
 void Ultrasonic::UltrasonicChecker() {
+  std::vector<Ultrasonic*> group;
   while (m_automaticEnabled) {
-    for (auto& sensor : m_sensors) {
+    bool pinged = false;
+    for (size_t i = 0; i < m_sensors.size(); i++) {
       if (!m_automaticEnabled) break;
 
-      if (sensor->IsEnabled()) {
-        sensor->m_pingChannel->Pulse(kPingTime);  // do the ping
+      Ultrasonic* sensor = m_sensors[i];
+      if (!sensor->IsEnabled()) continue;
+      int id = sensor->m_pingGroup;
+
+      // A group is pinged with its first enabled sensor
+      group.clear();
+      bool first = true;
+      for (size_t j = 0; j < m_sensors.size(); j++) {
+        Ultrasonic* other = m_sensors[j];
+        if (j == i) {
+          group.push_back(other);
+        } else if (id != 0 && other->IsEnabled() && other->m_pingGroup == id) {
+          if (j < i) {
+            first = false;
+            break;
+          }
+          group.push_back(other);
+        }
       }
+      if (!first) continue;
+
+      for (size_t j = 0; j < group.size(); j += kMaxGroupSize) {
+        size_t size =
+            std::min(group.size() - j, static_cast<size_t>(kMaxGroupSize));
+        PingGroup(llvm::ArrayRef<Ultrasonic*>(group.data() + j, size));
+      }
+      pinged = true;
+    }
+    // Don't spin while every sensor is disabled
+    if (!pinged) Wait(kMaxUltrasonicTime);
+  }
+}
+
+/**
+ * Ping the sensors of a group at the same time and wait until each has
+ * received its echo or timed out.
+ *
+ * Sensors without an interrupt are waited for until their timeout.
+ */
+void Ultrasonic::PingGroup(llvm::ArrayRef<Ultrasonic*> group) {
+  uint64_t pingTime = RobotController::GetFPGATime();
+  for (auto sensor : group) sensor->m_pingChannel->Pulse(kPingTime);
+
+  Ultrasonic* waiting[kMaxGroupSize];
+  int count = 0;
+  // Longest timeout of the sensors with no interrupt, in seconds
+  double fixedWait = 0.0;
+  for (auto sensor : group) {
+    if (sensor->m_interrupt != HAL_kInvalidHandle) {
+      waiting[count++] = sensor;
+    } else {
+      fixedWait = std::max(fixedWait, sensor->m_echoTimeout.load());
+    }
+  }
 
-      Wait(0.1);  // wait for ping to return
+  while (count > 0) {
+    double elapsed = (RobotController::GetFPGATime() - pingTime) * 1e-6;
+    double timeout = 0.0;
+    HAL_InterruptHandle handles[kMaxGroupSize];
+    int remaining = 0;
+    for (int i = 0; i < count; i++) {
+      double left = waiting[i]->m_echoTimeout - elapsed;
+      if (left <= 0.0) continue;  // no echo
+      timeout = std::max(timeout, left);
+      waiting[remaining] = waiting[i];
+      handles[remaining++] = waiting[i]->m_interrupt;
     }
+    count = remaining;
+    if (count == 0) break;
+
+    int32_t status = 0;
+    double falling[kMaxGroupSize];
+    int64_t fired = HAL_WaitForMultipleInterrupts(handles, count, timeout,
+                                                  false, nullptr, falling,
+                                                  &status);
+    if (status != 0) {
+      wpi_setGlobalErrorWithContext(status, HAL_GetErrorMessage(status));
+      fixedWait = std::max(fixedWait, elapsed + timeout);
+      break;
+    }
+
+    remaining = 0;
+    for (int i = 0; i < count; i++) {
+      if (fired & (INT64_C(1) << (i + 8))) {
+        // Interrupt timestamps are the low 32 bits of the FPGA time in
+        // microseconds; an edge from before the ping wraps to a huge delay
+        uint32_t delay = static_cast<uint32_t>(falling[i] * 1e6 + 0.5) -
+                         static_cast<uint32_t>(pingTime);
+        if (delay * 1e-6 <= waiting[i]->m_echoTimeout) {
+          waiting[i]->m_rangeTimestamp = (pingTime + delay) * 1e-6;
+          continue;
+        }
+      }
+      waiting[remaining++] = waiting[i];
+    }
+    count = remaining;
   }
+
+  double left = fixedWait - (RobotController::GetFPGATime() - pingTime) * 1e-6;
+  if (left > 0.0) Wait(left);
 }
 
 /**
@@ -184,8 +286,11 @@ Ultrasonic::~Ultrasonic() {
 /**
  * Turn Automatic mode on/off.
  *
- * When in Automatic mode, all sensors will fire in round robin, waiting a set
- * time between each sensor.
+ * When in Automatic mode, all sensors will fire in round robin, each sensor
+ * (or ping group) firing as soon as the echo of the previous one returns or
+ * times out. Each sensor takes one of the 8 interrupts while automatic mode
+ * is on, to be woken by the falling edge of its echo; a sensor that gets
+ * none is given its full echo timeout instead.
  *
  * @param enabling Set to true if round robin scheduling should start for all
  *                 the ultrasonic sensors. This scheduling method assures that
@@ -205,6 +310,8 @@ void Ultrasonic::SetAutomaticMode(bool enabling) {
      */
     for (auto& sensor : m_sensors) {
       sensor->m_counter.Reset();
+      sensor->m_rangeTimestamp = 0.0;
+      sensor->RequestEchoInterrupt();
     }
 
     m_thread = std::thread(&Ultrasonic::UltrasonicChecker);
@@ -222,10 +329,36 @@ void Ultrasonic::SetAutomaticMode(bool enabling) {
     // stopped.
     for (auto& sensor : m_sensors) {
       sensor->m_counter.Reset();
+      sensor->m_rangeTimestamp = 0.0;
+      if (sensor->m_interrupt != HAL_kInvalidHandle) {
+        int32_t status = 0;
+        HAL_CleanInterrupts(sensor->m_interrupt, &status);
+        sensor->m_interrupt = HAL_kInvalidHandle;
+      }
     }
   }
 }
 
+// Takes an interrupt on the falling edge of the echo, if one is free
+void Ultrasonic::RequestEchoInterrupt() {
+  if (m_interrupt != HAL_kInvalidHandle) return;
+  int32_t status = 0;
+  m_interrupt = HAL_InitializeInterrupts(true, &status);
+  if (status != 0) {
+    m_interrupt = HAL_kInvalidHandle;
+    return;
+  }
+  HAL_RequestInterrupts(m_interrupt, m_echoChannel->GetPortHandleForRouting(),
+                        static_cast<HAL_AnalogTriggerType>(
+                            m_echoChannel->GetAnalogTriggerTypeForRouting()),
+                        &status);
+  HAL_SetInterruptUpSourceEdge(m_interrupt, false, true, &status);
+  if (status != 0) {
+    HAL_CleanInterrupts(m_interrupt, &status);
+    m_interrupt = HAL_kInvalidHandle;
+  }
+}
+
 /**
  * Single ping to ultrasonic sensor.
  *
@@ -276,6 +409,44 @@ double Ultrasonic::GetRangeInches() const {
  */
 double Ultrasonic::GetRangeMM() const { return GetRangeInches() * 25.4; }
 
+/**
+ * Put the sensor in a ping group for automatic mode.
+ *
+ * Sensors in the same group are pinged at the same time, so each refreshes
+ * more often. Only group sensors that can't hear each other's pings, such as
+ * ones facing different directions. Group 0, the default, pings alone.
+ *
+ * @param group The group, or 0 for none.
+ */
+void Ultrasonic::SetPingGroup(int group) { m_pingGroup = group; }
+
+/**
+ * Get the ping group of the sensor, or 0 if it pings alone.
+ */
+int Ultrasonic::GetPingGroup() const { return m_pingGroup; }
+
+/**
+ * Set how long automatic mode waits for an echo before pinging the next
+ * sensor. The default of 0.1 seconds covers the full range of common sensors;
+ * a shorter timeout refreshes faster when no target is in range.
+ *
+ * @param seconds The timeout in seconds.
+ */
+void Ultrasonic::SetEchoTimeout(double seconds) { m_echoTimeout = seconds; }
+
+/**
+ * Get how long automatic mode waits for an echo, in seconds.
+ */
+double Ultrasonic::GetEchoTimeout() const { return m_echoTimeout; }
+
+/**
+ * Get the time the echo of the latest range was received in automatic mode.
+ *
+ * @return The FPGA timestamp of the echo in seconds, or 0 if there is none,
+ *         in manual mode or when the sensor has no interrupt.
+ */
+double Ultrasonic::GetRangeTimestamp() const { return m_rangeTimestamp; }
+
 /**
  * Get the range in the current DistanceUnit for the PIDSource base object.
  *
@@ -12,6 +12,7 @@
 #include <execinfo.h>
 #endif
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -233,13 +234,45 @@ static std::string demangle(char const* mangledSymbol) {
 std::string GetStackTrace(int offset) {
   void* stackTrace[128];
   int stackSize = backtrace(stackTrace, 128);
-  char** mangledSymbols = backtrace_symbols(stackTrace, stackSize);
+  if (offset >= stackSize) return std::string();
+  return GetStackTrace(stackTrace + offset, stackSize - offset);
+}
+
+/**
+ * Capture the return addresses of a stack trace, ignoring the first "offset"
+ * symbols, to be symbolized later by GetStackTrace(frames, count).
+ *
+ * This only walks the stack, so it is much cheaper than
+ * GetStackTrace(offset).
+ *
+ * @param frames    Buffer for the return addresses.
+ * @param maxFrames Size of frames.
+ * @param offset    The number of symbols at the top of the stack to ignore
+ * @return The number of frames captured.
+ */
+int CaptureStackTrace(void** frames, int maxFrames, int offset) {
+  void* stackTrace[128];
+  int stackSize = backtrace(stackTrace, 128);
+  int count = std::min(stackSize - offset, maxFrames);
+  if (count <= 0) return 0;
+  std::copy(stackTrace + offset, stackTrace + offset + count, frames);
+  return count;
+}
+
+/**
+ * Symbolize and demangle a stack trace captured by CaptureStackTrace().
+ *
+ * @param frames The return addresses.
+ * @param count  The number of frames.
+ */
+std::string GetStackTrace(void* const* frames, int count) {
+  char** mangledSymbols = backtrace_symbols(frames, count);
   llvm::SmallString<1024> buf;
   llvm::raw_svector_ostream trace(buf);
 
-  for (int i = offset; i < stackSize; i++) {
+  for (int i = 0; i < count; i++) {
     // Only print recursive functions once in a row.
-    if (i == 0 || stackTrace[i] != stackTrace[i - 1]) {
+    if (i == 0 || frames[i] != frames[i - 1]) {
       trace << "\tat " << demangle(mangledSymbols[i]) << "\n";
     }
   }
@@ -255,6 +288,12 @@ static std::string demangle(char const* mangledSymbol) {
 }
 
 std::string GetStackTrace(int offset) { return "no stack trace on windows"; }
+
+int CaptureStackTrace(void** frames, int maxFrames, int offset) { return 0; }
+
+std::string GetStackTrace(void* const* frames, int count) {
+  return "no stack trace on windows";
+}
 #endif
 
 }  // namespace frc
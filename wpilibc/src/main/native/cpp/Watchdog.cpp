@@ -0,0 +1,236 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Watchdog.h"
+
+#include <algorithm>
+
+#include <llvm/SmallString.h>
+#include <llvm/raw_ostream.h>
+
+#include "DriverStation.h"
+#include "NotifierExecutor.h"
+#include "Timer.h"
+
+using namespace frc;
+
+/**
+ * Watchdog constructor.
+ *
+ * The watchdog starts disabled; call Reset() at the top of the watched loop to
+ * arm it.
+ *
+ * @param timeout  The watchdog's timeout in seconds.
+ * @param callback This function is called from the NotifierExecutor thread
+ *                 when the timeout expires. It may be empty.
+ */
+Watchdog::Watchdog(double timeout, std::function<void()> callback)
+    : m_timeout(timeout),
+      m_callback(std::move(callback)),
+      m_notifier(NotifierExecutor::GetInstance(), [this] { TimeoutFunc(); }) {}
+
+/**
+ * Returns the time in seconds since the watchdog was last reset.
+ */
+double Watchdog::GetTime() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return Timer::GetFPGATimestamp() - m_startTime;
+}
+
+/**
+ * Sets the watchdog's timeout. It takes effect at the next reset.
+ *
+ * @param timeout The watchdog's timeout in seconds.
+ */
+void Watchdog::SetTimeout(double timeout) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_timeout = timeout;
+}
+
+/**
+ * Returns the watchdog's timeout in seconds.
+ */
+double Watchdog::GetTimeout() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_timeout;
+}
+
+/**
+ * Returns true if the timeout expired since the watchdog was last reset.
+ */
+bool Watchdog::IsExpired() const { return m_expired; }
+
+/**
+ * Record the time since the previous epoch, or since the last reset, under
+ * the given name.
+ *
+ * Epochs are kept until the next reset and printed when the watchdog times
+ * out. The storage of earlier iterations is reused, so recording the same
+ * stages every iteration does not allocate.
+ *
+ * @param epochName The name of the stage that just finished.
+ */
+void Watchdog::AddEpoch(llvm::StringRef epochName) {
+  double now = Timer::GetFPGATimestamp();
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  RecordEpoch(epochName, now - m_lastEpochTime, now);
+}
+
+/**
+ * Record a stage that was timed elsewhere, such as by a LoopProfiler, under
+ * the given name.
+ *
+ * @param epochName The name of the stage that just finished.
+ * @param time      How long the stage took, in seconds.
+ */
+void Watchdog::AddEpoch(llvm::StringRef epochName, double time) {
+  double now = Timer::GetFPGATimestamp();
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  RecordEpoch(epochName, time, now);
+}
+
+/**
+ * Prints the epochs recorded since the last reset, longest first.
+ */
+void Watchdog::PrintEpochs() { PrintEpochs(Timer::GetFPGATimestamp(), false); }
+
+/**
+ * Reports a stage of the watched loop that took longer than its own budget,
+ * even if the loop as a whole met its timeout.
+ *
+ * Messages are printed at most once per second; each one counts the overruns
+ * since the previous one.
+ *
+ * @param name   The name of the stage.
+ * @param time   How long the stage took, in seconds.
+ * @param budget The stage's budget, in seconds.
+ */
+void Watchdog::ReportBudgetOverrun(llvm::StringRef name, double time,
+                                   double budget) {
+  double now = Timer::GetFPGATimestamp();
+  int overruns;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_budgetOverruns++;
+    if (m_suppressTimeoutMessage ||
+        now - m_lastBudgetPrintTime < kMinPrintPeriod) {
+      return;
+    }
+    m_lastBudgetPrintTime = now;
+    overruns = m_budgetOverruns;
+    m_budgetOverruns = 0;
+  }
+
+  llvm::SmallString<128> buf;
+  llvm::raw_svector_ostream msg(buf);
+  msg << name << " took " << time << "s, over its budget of " << budget
+      << "s (" << overruns << " overruns)";
+  DriverStation::ReportErrorAsync(false, 1, msg.str(), "Watchdog");
+}
+
+/**
+ * Clears the epochs and restarts the timeout. Also enables the watchdog.
+ */
+void Watchdog::Reset() { Enable(); }
+
+/**
+ * Clears the epochs and starts the timeout.
+ */
+void Watchdog::Enable() {
+  double timeout;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_startTime = Timer::GetFPGATimestamp();
+    m_lastEpochTime = m_startTime;
+    m_epochCount = 0;
+    m_enabled = true;
+    m_expired = false;
+    timeout = m_timeout;
+  }
+  m_notifier.StartSingle(timeout);
+}
+
+/**
+ * Stops the timeout, normally at the end of the watched loop iteration.
+ */
+void Watchdog::Disable() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_enabled = false;
+  }
+  m_notifier.Stop();
+}
+
+/**
+ * Enable or disable the message printed when the timeout expires. The
+ * callback is called either way.
+ *
+ * @param suppress Whether to suppress the message.
+ */
+void Watchdog::SuppressTimeoutMessage(bool suppress) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_suppressTimeoutMessage = suppress;
+}
+
+// Must be called with m_mutex held
+void Watchdog::RecordEpoch(llvm::StringRef epochName, double time,
+                           double now) {
+  if (m_epochCount == m_epochs.size()) m_epochs.emplace_back();
+  Epoch& epoch = m_epochs[m_epochCount++];
+  epoch.name.assign(epochName.data(), epochName.size());
+  epoch.time = time;
+  m_lastEpochTime = now;
+}
+
+void Watchdog::TimeoutFunc() {
+  double now = Timer::GetFPGATimestamp();
+  bool print;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    // Ignore an expiry that raced with Reset() or Disable()
+    if (!m_enabled || now - m_startTime < m_timeout) return;
+    m_expired = true;
+    print = !m_suppressTimeoutMessage &&
+            now - m_lastTimeoutPrintTime >= kMinPrintPeriod;
+    if (print) m_lastTimeoutPrintTime = now;
+  }
+
+  if (print) PrintEpochs(now, true);
+  if (m_callback) m_callback();
+}
+
+void Watchdog::PrintEpochs(double now, bool timedOut) {
+  std::vector<Epoch> epochs;
+  double timeout;
+  double elapsed;
+  double running;
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    epochs.assign(m_epochs.begin(), m_epochs.begin() + m_epochCount);
+    timeout = m_timeout;
+    elapsed = now - m_startTime;
+    running = now - m_lastEpochTime;
+  }
+
+  std::stable_sort(
+      epochs.begin(), epochs.end(),
+      [](const Epoch& lhs, const Epoch& rhs) { return lhs.time > rhs.time; });
+
+  llvm::SmallString<256> buf;
+  llvm::raw_svector_ostream msg(buf);
+  if (timedOut) {
+    msg << "Watchdog not fed within " << timeout << "s (" << elapsed << "s):";
+  } else {
+    msg << "Watchdog epochs (" << elapsed << "s):";
+  }
+  for (const auto& epoch : epochs) {
+    msg << " " << epoch.name << " " << epoch.time << "s;";
+  }
+  // The stage after the last epoch is the one still running
+  msg << " in progress " << running << "s";
+  DriverStation::ReportErrorAsync(false, 1, msg.str(), "Watchdog");
+}
@@ -0,0 +1,253 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "Waveform.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include <HAL/AnalogOutput.h>
+#include <HAL/DIO.h>
+#include <HAL/HAL.h>
+#include <HAL/Notifier.h>
+#include <support/mutex.h>
+
+#include "AnalogOutput.h"
+#include "DigitalOutput.h"
+#include "Threads.h"
+#include "WPIErrors.h"
+
+namespace frc {
+
+/**
+ * The thread playing every Waveform, waiting on one HAL notifier.
+ */
+class WaveformEngine : public ErrorBase {
+ public:
+  static WaveformEngine& GetInstance();
+
+  ~WaveformEngine() override;
+
+  void Add(Waveform* waveform);
+  void Remove(Waveform* waveform);
+
+ private:
+  struct Entry {
+    Waveform* waveform;
+    uint64_t nextTime;
+  };
+
+  WaveformEngine();
+
+  // set the HAL alarm to the earliest next sample; m_mutex must be held
+  void UpdateAlarm();
+  void ThreadMain();
+
+  std::thread m_thread;
+  // taken on the real-time thread, so it inherits priority
+  wpi::mutex m_mutex;
+  std::atomic<HAL_NotifierHandle> m_notifier{0};
+  std::vector<Entry> m_entries;
+};
+
+}  // namespace frc
+
+using namespace frc;
+
+constexpr int Waveform::kPriority;
+constexpr double Waveform::kMaxRate;
+
+WaveformEngine& WaveformEngine::GetInstance() {
+  static WaveformEngine instance;
+  return instance;
+}
+
+WaveformEngine::WaveformEngine() {
+  int32_t status = 0;
+  m_notifier = HAL_InitializeNotifier(&status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+
+  m_thread = std::thread([=] { ThreadMain(); });
+  SetThreadPriority(m_thread, true, Waveform::kPriority);
+}
+
+WaveformEngine::~WaveformEngine() {
+  int32_t status = 0;
+  // atomically set handle to 0, then clean
+  HAL_NotifierHandle handle = m_notifier.exchange(0);
+  HAL_StopNotifier(handle, &status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+
+  if (m_thread.joinable()) m_thread.join();
+
+  HAL_CleanNotifier(handle, &status);
+}
+
+void WaveformEngine::Add(Waveform* waveform) {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_entries.push_back(Entry{waveform, waveform->m_startTime});
+  UpdateAlarm();
+}
+
+void WaveformEngine::Remove(Waveform* waveform) {
+  // Samples are written with the lock held, so once it is taken the waveform
+  // isn't being played
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+                                 [=](const Entry& entry) {
+                                   return entry.waveform == waveform;
+                                 }),
+                  m_entries.end());
+  UpdateAlarm();
+}
+
+void WaveformEngine::UpdateAlarm() {
+  // Return if we are being destructed, or were not created successfully
+  auto notifier = m_notifier.load();
+  if (notifier == 0) return;
+
+  int32_t status = 0;
+  if (m_entries.empty()) {
+    HAL_CancelNotifierAlarm(notifier, &status);
+  } else {
+    uint64_t time = m_entries[0].nextTime;
+    for (auto& entry : m_entries) time = std::min(time, entry.nextTime);
+    HAL_UpdateNotifierAlarm(notifier, time, &status);
+  }
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+}
+
+void WaveformEngine::ThreadMain() {
+  for (;;) {
+    int32_t status = 0;
+    HAL_NotifierHandle notifier = m_notifier.load();
+    if (notifier == 0) break;
+    uint64_t curTime = HAL_WaitForNotifierAlarm(notifier, &status);
+    if (curTime == 0 || status != 0) break;
+
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    for (size_t i = 0; i < m_entries.size();) {
+      auto& entry = m_entries[i];
+      if (entry.nextTime <= curTime) {
+        entry.nextTime = entry.waveform->Play(curTime);
+        if (entry.nextTime == 0) {
+          // a one-shot waveform has finished
+          entry.waveform->m_playing = false;
+          m_entries.erase(m_entries.begin() + i);
+          continue;
+        }
+      }
+      i++;
+    }
+    UpdateAlarm();
+  }
+}
+
+/**
+ * Create a waveform played on an analog output.
+ *
+ * @param output   The output to play the waveform on
+ * @param voltages The samples of the waveform, in Volts from 0.0 to +5.0
+ * @param rate     The rate the samples are played at, in samples per second
+ * @param mode     Whether to play the samples once, leaving the output at the
+ *                 last one, or repeat them until stopped
+ */
+Waveform::Waveform(AnalogOutput& output, llvm::ArrayRef<double> voltages,
+                   double rate, Mode mode)
+    : m_handle(output.m_port),
+      m_digital(false),
+      m_samples(voltages.begin(), voltages.end()),
+      m_mode(mode) {
+  SetRate(rate);
+}
+
+/**
+ * Create a waveform played on a digital output.
+ *
+ * @param output The output to play the waveform on
+ * @param values The samples of the waveform, true to drive the output high
+ * @param rate   The rate the samples are played at, in samples per second
+ * @param mode   Whether to play the samples once, leaving the output at the
+ *               last one, or repeat them until stopped
+ */
+Waveform::Waveform(DigitalOutput& output, llvm::ArrayRef<bool> values,
+                   double rate, Mode mode)
+    : m_handle(output.m_handle),
+      m_digital(true),
+      m_samples(values.begin(), values.end()),
+      m_mode(mode) {
+  SetRate(rate);
+}
+
+Waveform::~Waveform() { Stop(); }
+
+/**
+ * Play the waveform from its first sample, restarting it if it is playing.
+ */
+void Waveform::Start() {
+  if (m_samples.empty() || m_period == 0) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "no samples to play");
+    return;
+  }
+  int32_t status = 0;
+  uint64_t time = HAL_GetFPGATime(&status);
+  wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+
+  auto& engine = WaveformEngine::GetInstance();
+  // Taken off the engine before its play state is reset
+  engine.Remove(this);
+  m_startTime = time;
+  m_lastIndex = UINT64_MAX;
+  m_playing = true;
+  engine.Add(this);
+}
+
+/**
+ * Stop playing the waveform, leaving the output at the last sample played.
+ */
+void Waveform::Stop() {
+  if (!m_playing) return;
+  WaveformEngine::GetInstance().Remove(this);
+  m_playing = false;
+}
+
+/**
+ * Returns true while the waveform is playing. A one-shot waveform stops by
+ * itself after its last sample.
+ */
+bool Waveform::IsPlaying() const { return m_playing; }
+
+void Waveform::SetRate(double rate) {
+  if (rate <= 0 || rate > kMaxRate) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange, "rate");
+    return;
+  }
+  m_period = static_cast<uint64_t>(1.0e6 / rate + 0.5);
+}
+
+uint64_t Waveform::Play(uint64_t time) {
+  uint64_t index = (time - m_startTime) / m_period;
+  uint64_t size = m_samples.size();
+  // the last sample of a one-shot waveform may be due after a late wakeup
+  if (m_mode == kOneShot && index >= size) index = size - 1;
+
+  if (index != m_lastIndex) {
+    m_lastIndex = index;
+    double sample = m_samples[index % size];
+    int32_t status = 0;
+    if (m_digital) {
+      HAL_SetDIO(m_handle, sample != 0, &status);
+    } else {
+      HAL_SetAnalogOutput(m_handle, sample, &status);
+    }
+    wpi_setErrorWithContext(status, HAL_GetErrorMessage(status));
+  }
+
+  if (m_mode == kOneShot && index >= size - 1) return 0;
+  return m_startTime + (index + 1) * m_period;
+}
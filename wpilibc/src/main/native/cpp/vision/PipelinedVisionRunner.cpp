@@ -0,0 +1,145 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "vision/PipelinedVisionRunner.h"
+
+#include <thread>
+
+#include <opencv2/core/mat.hpp>
+
+#include "DriverStation.h"
+#include "RobotBase.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+/**
+ * Creates a new pipelined vision runner. It will take images from the {@code
+ * videoSource}, and call the virtual DoProcess() and DoNotify() methods.
+ *
+ * One frame more than there are workers is allocated, so the next frame can
+ * be grabbed while every worker is busy.
+ *
+ * @param videoSource the video source to use to supply images for the pipeline
+ * @param workerCount the number of worker threads
+ */
+PipelinedVisionRunnerBase::PipelinedVisionRunnerBase(
+    cs::VideoSource videoSource, int workerCount)
+    : m_cvSink("PipelinedVisionRunner CvSink"),
+      m_workerCount(workerCount),
+      m_enabled(true) {
+  m_cvSink.SetSource(videoSource);
+  for (int i = 0; i < workerCount + 1; i++) {
+    m_frames.emplace_back(std::make_unique<cv::Mat>());
+    m_freeFrames.push_back(m_frames.back().get());
+  }
+}
+
+// Located here and not in header due to cv::Mat forward declaration.
+PipelinedVisionRunnerBase::~PipelinedVisionRunnerBase() {}
+
+/**
+ * Grabs frames and runs the pipelines on them until Stop() is called.
+ *
+ * Frames are grabbed on the calling thread, and the workers are started on
+ * their own threads. Frames that fail to grab are reported and skipped. This
+ * must be run in a dedicated thread, and cannot be used in the main robot
+ * thread because it will freeze the robot program.
+ */
+void PipelinedVisionRunnerBase::RunForever() {
+  if (std::this_thread::get_id() == RobotBase::GetThreadId()) {
+    wpi_setErrnoErrorWithContext(
+        "PipelinedVisionRunner::RunForever() cannot be called from the main "
+        "robot thread");
+    return;
+  }
+  if (m_workerCount < 1) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange,
+                               "PipelinedVisionRunner needs a pipeline");
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < m_workerCount; i++) {
+    workers.emplace_back(&PipelinedVisionRunnerBase::RunWorker, this, i);
+  }
+
+  while (m_enabled) {
+    cv::Mat* image;
+    {
+      std::unique_lock<wpi::mutex> lock(m_mutex);
+      m_frameFreed.wait(lock,
+                        [&] { return !m_freeFrames.empty() || !m_enabled; });
+      if (!m_enabled) break;
+      image = m_freeFrames.back();
+      m_freeFrames.pop_back();
+    }
+
+    uint64_t frameTime = m_cvSink.GrabFrame(*image);
+
+    std::unique_lock<wpi::mutex> lock(m_mutex);
+    if (frameTime == 0) {
+      m_freeFrames.push_back(image);
+      lock.unlock();
+      auto error = m_cvSink.GetError();
+      DriverStation::ReportError(error);
+      continue;
+    }
+    m_jobs.push_back(Job{image, m_nextSequence++, frameTime});
+    m_jobQueued.notify_one();
+  }
+
+  for (auto& worker : workers) worker.join();
+
+  // Drop the frames no worker started on
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  for (const auto& job : m_jobs) m_freeFrames.push_back(job.image);
+  m_jobs.clear();
+  m_nextNotify = m_nextSequence;
+}
+
+/**
+ * Stop a RunForever() loop. Frames already being processed are finished and
+ * reported first.
+ */
+void PipelinedVisionRunnerBase::Stop() {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  m_enabled = false;
+  m_frameFreed.notify_all();
+  m_jobQueued.notify_all();
+}
+
+void PipelinedVisionRunnerBase::RunWorker(int worker) {
+  for (;;) {
+    Job job;
+    {
+      std::unique_lock<wpi::mutex> lock(m_mutex);
+      m_jobQueued.wait(lock, [&] { return !m_jobs.empty() || !m_enabled; });
+      if (!m_enabled) return;
+      job = m_jobs.front();
+      m_jobs.pop_front();
+    }
+
+    DoProcess(worker, *job.image);
+
+    {
+      // The results are in the pipeline, so the frame can be grabbed into
+      std::unique_lock<wpi::mutex> lock(m_mutex);
+      m_freeFrames.push_back(job.image);
+      m_frameFreed.notify_one();
+      // Report results in frame order; the worker holding the oldest frame
+      // never waits here, so every worker eventually gets its turn
+      m_notified.wait(lock, [&] { return m_nextNotify == job.sequence; });
+    }
+
+    DoNotify(worker, job.frameTime);
+
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_nextNotify++;
+    m_notified.notify_all();
+  }
+}
@@ -0,0 +1,108 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "vision/SharedVideoSink.h"
+
+#include <chrono>
+
+#include <opencv2/core/mat.hpp>
+
+using namespace frc;
+
+/**
+ * Creates a shared video sink and starts grabbing from the source.
+ *
+ * @param name   The name of the underlying CvSink
+ * @param source The video source to grab from
+ */
+SharedVideoSink::SharedVideoSink(llvm::StringRef name, cs::VideoSource source)
+    : m_cvSink(name) {
+  m_cvSink.SetSource(source);
+  m_thread = std::thread(&SharedVideoSink::RunGrabber, this);
+}
+
+SharedVideoSink::~SharedVideoSink() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_active = false;
+    m_frameReady.notify_all();
+  }
+  // GrabFrame() times out, so the grabber sees the flag even without frames
+  m_thread.join();
+}
+
+/**
+ * Waits for a frame newer than the one a consumer last got.
+ *
+ * The frame must not be modified; it is shared with every other consumer.
+ *
+ * @param frame    Set to the newest frame, or reset on timeout
+ * @param sequence The sequence number of the frame the consumer last got (0
+ *                 for none); on success, set to that of the new frame. Frames
+ *                 grabbed in between were skipped.
+ * @param timeout  Time to wait for a frame, in seconds
+ * @return The capture time of the frame in microseconds, or 0 on timeout;
+ *         call GetError() to find out why no frame arrived
+ */
+uint64_t SharedVideoSink::GrabFrame(std::shared_ptr<const cv::Mat>& frame,
+                                    uint64_t& sequence, double timeout) {
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  bool ready = m_frameReady.wait_for(
+      lock, std::chrono::duration<double>(timeout),
+      [&] { return m_sequence > sequence || !m_active; });
+  if (!ready || !m_active) {
+    frame.reset();
+    return 0;
+  }
+  frame = m_frame;
+  sequence = m_sequence;
+  return m_frameTime;
+}
+
+/**
+ * Returns the error of the latest failed grab.
+ */
+std::string SharedVideoSink::GetError() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  if (m_error.empty()) return "timed out waiting for a frame";
+  return m_error;
+}
+
+// Must be called with m_mutex held
+std::shared_ptr<cv::Mat> SharedVideoSink::GetFreeFrame() {
+  // Only a buffer no consumer holds may be overwritten. Consumers get a
+  // buffer from m_frame under the lock, so a count of one can't go up.
+  for (const auto& frame : m_frames) {
+    if (frame.use_count() == 1) return frame;
+  }
+  m_frames.emplace_back(std::make_shared<cv::Mat>());
+  return m_frames.back();
+}
+
+void SharedVideoSink::RunGrabber() {
+  for (;;) {
+    std::shared_ptr<cv::Mat> image;
+    {
+      std::lock_guard<wpi::mutex> lock(m_mutex);
+      if (!m_active) return;
+      image = GetFreeFrame();
+    }
+
+    uint64_t frameTime = m_cvSink.GrabFrame(*image);
+
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    if (frameTime == 0) {
+      m_error = m_cvSink.GetError();
+      continue;
+    }
+    m_frame = std::move(image);
+    m_frameTime = frameTime;
+    m_sequence++;
+    m_error.clear();
+    m_frameReady.notify_all();
+  }
+}
@@ -0,0 +1,198 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "vision/StagedVisionPipeline.h"
+
+#include "Timer.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+/**
+ * Creates an empty staged pipeline.
+ *
+ * @param threadCount The number of threads stages run on, including the one
+ *                    calling Process(); one less are started here.
+ */
+StagedVisionPipeline::StagedVisionPipeline(int threadCount) {
+  if (threadCount < 1) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange,
+                               "threadCount must be at least 1");
+    threadCount = 1;
+  }
+  for (int i = 1; i < threadCount; i++) {
+    m_threads.emplace_back(&StagedVisionPipeline::RunWorker, this);
+  }
+}
+
+StagedVisionPipeline::~StagedVisionPipeline() {
+  {
+    std::lock_guard<wpi::mutex> lock(m_mutex);
+    m_running = false;
+    m_changed.notify_all();
+  }
+  for (auto& thread : m_threads) thread.join();
+}
+
+/**
+ * Adds a stage that runs as a single task.
+ *
+ * Stages must be added before the first call to Process().
+ *
+ * @param name         The name of the stage, for reporting
+ * @param func         The function run with the image passed to Process()
+ * @param dependencies The stages that must finish before this one starts,
+ *                     from earlier calls of AddStage() or AddTiledStage()
+ * @return The index of the stage, or -1 if a dependency is invalid
+ */
+int StagedVisionPipeline::AddStage(llvm::StringRef name,
+                                   std::function<void(cv::Mat&)> func,
+                                   llvm::ArrayRef<int> dependencies) {
+  return AddTiledStage(
+      name, 1, [func](cv::Mat& image, int, int) { func(image); },
+      dependencies);
+}
+
+/**
+ * Adds a stage whose tiles may run in parallel.
+ *
+ * Stages must be added before the first call to Process().
+ *
+ * @param name         The name of the stage, for reporting
+ * @param tileCount    The number of tiles
+ * @param func         The function run for each tile, with the image passed to
+ *                     Process(), the tile index and the tile count
+ * @param dependencies The stages that must finish before this one starts,
+ *                     from earlier calls of AddStage() or AddTiledStage()
+ * @return The index of the stage, or -1 if a dependency or the tile count is
+ *         invalid
+ */
+int StagedVisionPipeline::AddTiledStage(
+    llvm::StringRef name, int tileCount,
+    std::function<void(cv::Mat& image, int tile, int tileCount)> func,
+    llvm::ArrayRef<int> dependencies) {
+  int index = m_stages.size();
+  if (tileCount < 1) {
+    wpi_setWPIErrorWithContext(ParameterOutOfRange,
+                               "tileCount must be at least 1");
+    return -1;
+  }
+  for (int dependency : dependencies) {
+    // Only earlier stages can be dependencies, so the graph has no cycles
+    if (dependency < 0 || dependency >= index) {
+      wpi_setWPIErrorWithContext(ParameterOutOfRange,
+                                 "dependency must be an earlier stage");
+      return -1;
+    }
+  }
+
+  VisionPipelineStage stage;
+  stage.name = name;
+  stage.func = std::move(func);
+  stage.dependencies.assign(dependencies.begin(), dependencies.end());
+  stage.tileCount = tileCount;
+  m_stages.emplace_back(std::move(stage));
+  m_dependents.emplace_back();
+  for (int dependency : dependencies) {
+    m_dependents[dependency].push_back(index);
+  }
+  m_state.resize(m_stages.size());
+  return index;
+}
+
+/**
+ * Runs every stage once on the image, and returns when all have finished.
+ */
+void StagedVisionPipeline::Process(cv::Mat& mat) {
+  double start = Timer::GetFastTimestamp();
+
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  m_image = &mat;
+  m_pendingStages = m_stages.size();
+  for (size_t i = 0; i < m_stages.size(); i++) {
+    StageState& state = m_state[i];
+    state.pendingDependencies = m_stages[i].dependencies.size();
+    state.pendingTiles = m_stages[i].tileCount;
+    state.started = false;
+  }
+  for (size_t i = 0; i < m_stages.size(); i++) {
+    if (m_state[i].pendingDependencies == 0) QueueStage(i);
+  }
+
+  // Work on the stages alongside the pool until all have finished
+  while (m_pendingStages > 0) {
+    if (!RunTask(lock)) m_changed.wait(lock);
+  }
+  m_image = nullptr;
+  m_processTime = Timer::GetFastTimestamp() - start;
+}
+
+int StagedVisionPipeline::GetStageCount() const { return m_stages.size(); }
+
+/**
+ * Returns a stage added with AddStage() or AddTiledStage().
+ */
+const VisionPipelineStage& StagedVisionPipeline::GetStage(int stage) const {
+  return m_stages[stage];
+}
+
+/**
+ * Returns the wall time the stage took in the latest Process() call, in
+ * seconds.
+ */
+double StagedVisionPipeline::GetStageTime(int stage) const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_stages[stage].time;
+}
+
+/**
+ * Returns the time the latest Process() call took, in seconds.
+ */
+double StagedVisionPipeline::GetProcessTime() const {
+  std::lock_guard<wpi::mutex> lock(m_mutex);
+  return m_processTime;
+}
+
+void StagedVisionPipeline::RunWorker() {
+  std::unique_lock<wpi::mutex> lock(m_mutex);
+  while (m_running) {
+    if (!RunTask(lock)) m_changed.wait(lock);
+  }
+}
+
+// Runs one queued task with the lock released; returns false if none is queued
+bool StagedVisionPipeline::RunTask(std::unique_lock<wpi::mutex>& lock) {
+  if (m_tasks.empty()) return false;
+  Task task = m_tasks.front();
+  m_tasks.pop_front();
+  StageState& state = m_state[task.stage];
+  if (!state.started) {
+    state.started = true;
+    state.startTime = Timer::GetFastTimestamp();
+  }
+
+  VisionPipelineStage& stage = m_stages[task.stage];
+  cv::Mat& image = *m_image;
+  lock.unlock();
+  stage.func(image, task.tile, stage.tileCount);
+  lock.lock();
+
+  if (--state.pendingTiles > 0) return true;
+  stage.time = Timer::GetFastTimestamp() - state.startTime;
+  for (int dependent : m_dependents[task.stage]) {
+    if (--m_state[dependent].pendingDependencies == 0) QueueStage(dependent);
+  }
+  if (--m_pendingStages == 0) m_changed.notify_all();
+  return true;
+}
+
+void StagedVisionPipeline::QueueStage(int stage) {
+  for (int tile = 0; tile < m_stages[stage].tileCount; tile++) {
+    m_tasks.push_back(Task{stage, tile});
+  }
+  m_changed.notify_all();
+}
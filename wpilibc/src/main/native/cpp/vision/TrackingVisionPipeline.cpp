@@ -0,0 +1,18 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "vision/TrackingVisionPipeline.h"
+
+#include <opencv2/core/mat.hpp>
+#include <opencv2/core/types.hpp>
+
+using namespace frc;
+
+void TrackingVisionPipeline::Process(cv::Mat& mat) {
+  cv::Rect target;
+  ProcessWindow(mat, cv::Rect(0, 0, mat.cols, mat.rows), target);
+}
@@ -0,0 +1,309 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "vision/VisionKernels.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include <opencv2/core/core.hpp>
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define WPILIB_VISION_NEON 1
+#endif
+
+#include "ErrorBase.h"
+#include "WPIErrors.h"
+
+using namespace frc;
+
+// Rounds 30 * t / diff to the nearest integer, for |t| <= diff
+static inline int HueOffset(int t, int diff) {
+  return (60 * t + (t >= 0 ? diff : -diff)) / (2 * diff);
+}
+
+// The hue of a pixel as cv::cvtColor(COLOR_BGR2HSV) computes it, 0-179
+static inline int Hue(int b, int g, int r, int v, int diff) {
+  if (diff == 0) return 0;
+  int h;
+  if (v == r) {
+    h = HueOffset(g - b, diff);
+  } else if (v == g) {
+    h = 60 + HueOffset(b - r, diff);
+  } else {
+    h = 120 + HueOffset(r - g, diff);
+  }
+  if (h < 0) h += 180;
+  if (h >= 180) h -= 180;
+  return h;
+}
+
+/**
+ * Thresholds a BGR image in HSV space, like cv::cvtColor() to HSV followed by
+ * cv::inRange(), in one pass and without the intermediate HSV image.
+ *
+ * Saturation and value are tested through per-value tables, so only pixels
+ * that pass them need the division for their hue.
+ *
+ * @param bgr   An 8-bit, 3-channel BGR image
+ * @param mask  Set to an 8-bit, 1-channel mask: 255 where the pixel is in
+ *              range, 0 elsewhere
+ * @param range The range to select
+ */
+void frc::HSVThreshold(const cv::Mat& bgr, cv::Mat& mask,
+                       const HSVRange& range) {
+  if (bgr.type() != CV_8UC3) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange,
+                                     "HSVThreshold needs an 8-bit BGR image");
+    return;
+  }
+  mask.create(bgr.rows, bgr.cols, CV_8UC1);
+
+  // For each value, the range of max - min whose saturation is in range; an
+  // empty range where the value itself is out of range
+  int diffLow[256];
+  int diffHigh[256];
+  for (int v = 0; v < 256; v++) {
+    diffLow[v] = 1;
+    diffHigh[v] = 0;
+    if (v < range.valLow || v > range.valHigh) continue;
+    for (int diff = 0; diff <= v; diff++) {
+      int s = v == 0 ? 0 : (255 * diff + v / 2) / v;
+      if (s < range.satLow || s > range.satHigh) continue;
+      if (diffLow[v] > diffHigh[v]) diffLow[v] = diff;
+      diffHigh[v] = diff;
+    }
+  }
+
+  bool hueInRange[180];
+  for (int h = 0; h < 180; h++) {
+    if (range.hueLow <= range.hueHigh) {
+      hueInRange[h] = h >= range.hueLow && h <= range.hueHigh;
+    } else {
+      hueInRange[h] = h >= range.hueLow || h <= range.hueHigh;
+    }
+  }
+
+  for (int y = 0; y < bgr.rows; y++) {
+    const uint8_t* in = bgr.ptr<uint8_t>(y);
+    uint8_t* out = mask.ptr<uint8_t>(y);
+    for (int x = 0; x < bgr.cols; x++, in += 3) {
+      int b = in[0];
+      int g = in[1];
+      int r = in[2];
+      int v = std::max(b, std::max(g, r));
+      int diff = v - std::min(b, std::min(g, r));
+      bool pass = diff >= diffLow[v] && diff <= diffHigh[v] &&
+                  hueInRange[Hue(b, g, r, v, diff)];
+      out[x] = pass ? 255 : 0;
+    }
+  }
+}
+
+namespace {
+
+struct MinOp {
+  uint8_t operator()(uint8_t a, uint8_t b) const { return std::min(a, b); }
+#ifdef WPILIB_VISION_NEON
+  uint8x16_t operator()(uint8x16_t a, uint8x16_t b) const {
+    return vminq_u8(a, b);
+  }
+#endif
+};
+
+struct MaxOp {
+  uint8_t operator()(uint8_t a, uint8_t b) const { return std::max(a, b); }
+#ifdef WPILIB_VISION_NEON
+  uint8x16_t operator()(uint8x16_t a, uint8x16_t b) const {
+    return vmaxq_u8(a, b);
+  }
+#endif
+};
+
+}  // namespace
+
+// A 3x3 rectangular min or max filter, applied as a vertical pass into a row
+// buffer and a horizontal pass from it. Pixels outside the image are ignored,
+// as with OpenCV's default border.
+template <typename Op>
+static void Morphology3x3(const cv::Mat& srcIn, cv::Mat& dst, Op op) {
+  // Work from a copy when filtering in place
+  cv::Mat src = srcIn.data == dst.data ? srcIn.clone() : srcIn;
+  dst.create(src.rows, src.cols, CV_8UC1);
+  int rows = src.rows;
+  int cols = src.cols;
+  if (rows == 0 || cols == 0) return;
+
+  std::vector<uint8_t> column(cols);
+  uint8_t* col = column.data();
+  for (int y = 0; y < rows; y++) {
+    const uint8_t* above = src.ptr<uint8_t>(std::max(y - 1, 0));
+    const uint8_t* row = src.ptr<uint8_t>(y);
+    const uint8_t* below = src.ptr<uint8_t>(std::min(y + 1, rows - 1));
+    int x = 0;
+#ifdef WPILIB_VISION_NEON
+    for (; x + 16 <= cols; x += 16) {
+      vst1q_u8(col + x, op(op(vld1q_u8(above + x), vld1q_u8(row + x)),
+                           vld1q_u8(below + x)));
+    }
+#endif
+    for (; x < cols; x++) col[x] = op(op(above[x], row[x]), below[x]);
+
+    uint8_t* out = dst.ptr<uint8_t>(y);
+    out[0] = op(col[0], col[std::min(1, cols - 1)]);
+    x = 1;
+#ifdef WPILIB_VISION_NEON
+    for (; x + 17 <= cols; x += 16) {
+      vst1q_u8(out + x, op(op(vld1q_u8(col + x - 1), vld1q_u8(col + x)),
+                           vld1q_u8(col + x + 1)));
+    }
+#endif
+    for (; x < cols - 1; x++) out[x] = op(op(col[x - 1], col[x]), col[x + 1]);
+    if (cols > 1) out[cols - 1] = op(col[cols - 2], col[cols - 1]);
+  }
+}
+
+/**
+ * Erodes a mask with a 3x3 rectangle, like cv::erode() with its default
+ * kernel and border.
+ *
+ * @param src An 8-bit, 1-channel image
+ * @param dst Set to the eroded image; may be src
+ */
+void frc::Erode3x3(const cv::Mat& src, cv::Mat& dst) {
+  if (src.type() != CV_8UC1) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange,
+                                     "Erode3x3 needs an 8-bit mask");
+    return;
+  }
+  Morphology3x3(src, dst, MinOp{});
+}
+
+/**
+ * Dilates a mask with a 3x3 rectangle, like cv::dilate() with its default
+ * kernel and border.
+ *
+ * @param src An 8-bit, 1-channel image
+ * @param dst Set to the dilated image; may be src
+ */
+void frc::Dilate3x3(const cv::Mat& src, cv::Mat& dst) {
+  if (src.type() != CV_8UC1) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange,
+                                     "Dilate3x3 needs an 8-bit mask");
+    return;
+  }
+  Morphology3x3(src, dst, MaxOp{});
+}
+
+namespace {
+
+// A horizontal run of set pixels; end is exclusive
+struct Run {
+  int row;
+  int start;
+  int end;
+};
+
+}  // namespace
+
+static int FindRoot(std::vector<int>& parent, int i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+/**
+ * Finds the bounding boxes of the 8-connected components of a mask.
+ *
+ * The mask is labeled by runs of set pixels rather than by pixels, so the
+ * work grows with the number of runs. Boxes are ordered by the first pixel of
+ * their component in raster order.
+ *
+ * @param mask    An 8-bit, 1-channel mask; nonzero pixels are set
+ * @param boxes   Set to one box per component
+ * @param minArea Components with fewer pixels than this are left out
+ */
+void frc::FindComponentBoxes(const cv::Mat& mask,
+                             std::vector<ComponentBox>& boxes, int minArea) {
+  boxes.clear();
+  if (mask.type() != CV_8UC1) {
+    wpi_setGlobalWPIErrorWithContext(ParameterOutOfRange,
+                                     "FindComponentBoxes needs an 8-bit mask");
+    return;
+  }
+
+  std::vector<Run> runs;
+  std::vector<int> parent;
+  size_t prevBegin = 0;
+  size_t prevEnd = 0;
+  for (int y = 0; y < mask.rows; y++) {
+    const uint8_t* row = mask.ptr<uint8_t>(y);
+    size_t rowBegin = runs.size();
+    size_t prev = prevBegin;
+    int x = 0;
+    for (;;) {
+      while (x < mask.cols && row[x] == 0) x++;
+      if (x == mask.cols) break;
+      int start = x;
+      while (x < mask.cols && row[x] != 0) x++;
+
+      int index = runs.size();
+      runs.push_back(Run{y, start, x});
+      parent.push_back(index);
+
+      // Join the runs of the previous row that touch this one, diagonally
+      // included
+      while (prev < prevEnd && runs[prev].end < start) prev++;
+      for (size_t p = prev; p < prevEnd && runs[p].start <= x; p++) {
+        int a = FindRoot(parent, index);
+        int b = FindRoot(parent, p);
+        // The lower index is the root, so a component's root is its first run
+        if (a < b) {
+          parent[b] = a;
+        } else if (b < a) {
+          parent[a] = b;
+        }
+      }
+    }
+    prevBegin = rowBegin;
+    prevEnd = runs.size();
+  }
+
+  // Until the end, width and height hold the right and bottom edges
+  std::vector<int> boxIndex(runs.size(), -1);
+  for (size_t i = 0; i < runs.size(); i++) {
+    const Run& run = runs[i];
+    int root = FindRoot(parent, i);
+    if (boxIndex[root] < 0) {
+      boxIndex[root] = boxes.size();
+      boxes.emplace_back();
+      ComponentBox& box = boxes.back();
+      box.x = run.start;
+      box.y = run.row;
+      box.width = run.end;
+    }
+    ComponentBox& box = boxes[boxIndex[root]];
+    box.x = std::min(box.x, run.start);
+    box.width = std::max(box.width, run.end);
+    box.height = run.row + 1;
+    box.area += run.end - run.start;
+  }
+
+  for (auto& box : boxes) {
+    box.width -= box.x;
+    box.height -= box.y;
+  }
+  boxes.erase(std::remove_if(boxes.begin(), boxes.end(),
+                             [=](const ComponentBox& box) {
+                               return box.area < minArea;
+                             }),
+              boxes.end());
+}
@@ -0,0 +1,169 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "vision/VisionResultPublisher.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <networktables/NetworkTableInstance.h>
+
+using namespace frc;
+
+static constexpr uint8_t kEncodingVersion = 1;
+static constexpr size_t kHeaderSize = 1 + 8 + 8 + 2;
+static constexpr size_t kTargetSize = 6 * 4;
+
+static nt::NetworkTableEntry GetVisionEntry(llvm::StringRef name) {
+  return nt::NetworkTableInstance::GetDefault().GetTable("Vision")->GetEntry(
+      name);
+}
+
+static void PutUint(std::string& buf, uint64_t value, int size) {
+  for (int i = 0; i < size; i++) {
+    buf.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+static uint64_t GetUint(const char* data, int size) {
+  uint64_t value = 0;
+  for (int i = 0; i < size; i++) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+  }
+  return value;
+}
+
+static void PutDouble(std::string& buf, double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  PutUint(buf, bits, 8);
+}
+
+static double GetDouble(const char* data) {
+  uint64_t bits = GetUint(data, 8);
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static void PutFloat(std::string& buf, double value) {
+  float f = static_cast<float>(value);
+  uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+  PutUint(buf, bits, 4);
+}
+
+static double GetFloat(const char* data) {
+  uint32_t bits = static_cast<uint32_t>(GetUint(data, 4));
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+/**
+ * Creates a publisher for the entry of the given name in the "Vision" table.
+ *
+ * @param name The name of the entry
+ */
+VisionResultPublisher::VisionResultPublisher(llvm::StringRef name)
+    : m_entry(GetVisionEntry(name)) {}
+
+/**
+ * Creates a publisher for the given entry.
+ *
+ * @param entry The entry to publish to
+ */
+VisionResultPublisher::VisionResultPublisher(nt::NetworkTableEntry entry)
+    : m_entry(entry) {}
+
+/**
+ * Publishes the targets found in one frame, with the next frame id.
+ *
+ * Target fields are sent as single-precision floats. At most kMaxTargets
+ * targets are sent.
+ *
+ * @param timestamp The FPGA time of the frame, in seconds
+ * @param targets   The targets found in the frame
+ */
+void VisionResultPublisher::Publish(double timestamp,
+                                    llvm::ArrayRef<VisionTarget> targets) {
+  size_t count = std::min(targets.size(), static_cast<size_t>(kMaxTargets));
+
+  m_buffer.clear();
+  m_buffer.reserve(kHeaderSize + count * kTargetSize);
+  PutUint(m_buffer, kEncodingVersion, 1);
+  PutUint(m_buffer, ++m_frameId, 8);
+  PutDouble(m_buffer, timestamp);
+  PutUint(m_buffer, count, 2);
+  for (size_t i = 0; i < count; i++) {
+    const VisionTarget& target = targets[i];
+    PutFloat(m_buffer, target.x);
+    PutFloat(m_buffer, target.y);
+    PutFloat(m_buffer, target.width);
+    PutFloat(m_buffer, target.height);
+    PutFloat(m_buffer, target.area);
+    PutFloat(m_buffer, target.angle);
+  }
+  m_entry.SetRaw(m_buffer);
+}
+
+/**
+ * Returns the frame id of the last published result, or 0 if none was.
+ */
+uint64_t VisionResultPublisher::GetFrameId() const { return m_frameId; }
+
+/**
+ * Creates a reader for the entry of the given name in the "Vision" table.
+ *
+ * @param name The name of the entry
+ */
+VisionResultReader::VisionResultReader(llvm::StringRef name)
+    : m_entry(GetVisionEntry(name)) {}
+
+/**
+ * Creates a reader for the given entry.
+ *
+ * @param entry The entry to read from
+ */
+VisionResultReader::VisionResultReader(nt::NetworkTableEntry entry)
+    : m_entry(entry) {}
+
+/**
+ * Reads the latest published result.
+ *
+ * The storage of the targets vector is reused, so reading a result every
+ * loop does not allocate once the vector has grown. Compare the frame id with
+ * that of the last result read to find out whether it is new.
+ *
+ * @param result Set to the latest result
+ * @return False, leaving result unchanged, if no valid result was published
+ */
+bool VisionResultReader::Get(VisionResult& result) const {
+  auto value = m_entry.GetValue();
+  if (!value || !value->IsRaw()) return false;
+  llvm::StringRef raw = value->GetRaw();
+  if (raw.size() < kHeaderSize) return false;
+  const char* data = raw.data();
+  if (static_cast<uint8_t>(data[0]) != kEncodingVersion) return false;
+  size_t count = GetUint(data + 17, 2);
+  if (raw.size() < kHeaderSize + count * kTargetSize) return false;
+
+  result.frameId = GetUint(data + 1, 8);
+  result.timestamp = GetDouble(data + 9);
+  result.targets.resize(count);
+  data += kHeaderSize;
+  for (auto& target : result.targets) {
+    target.x = GetFloat(data);
+    target.y = GetFloat(data + 4);
+    target.width = GetFloat(data + 8);
+    target.height = GetFloat(data + 12);
+    target.area = GetFloat(data + 16);
+    target.angle = GetFloat(data + 20);
+    data += kTargetSize;
+  }
+  return true;
+}
@@ -7,7 +7,11 @@
 
 #include "vision/VisionRunner.h"
 
+#include <thread>
+
 #include <opencv2/core/mat.hpp>
+#include <opencv2/core/types.hpp>
+#include <support/timestamp.h>
 
 #include "DriverStation.h"
 #include "RobotBase.h"
@@ -23,11 +27,25 @@ using namespace frc;
 VisionRunnerBase::VisionRunnerBase(cs::VideoSource videoSource)
     : m_image(std::make_unique<cv::Mat>()),
       m_cvSink("VisionRunner CvSink"),
-      m_enabled(true) {
+      m_enabled(true),
+      m_target(std::make_unique<cv::Rect>()) {
   m_cvSink.SetSource(videoSource);
 }
 
-// Located here and not in header due to cv::Mat forward declaration.
+/**
+ * Creates a new vision runner that takes images from a shared video sink, and
+ * calls the virtual DoProcess() method.
+ *
+ * @param sharedSink the shared sink to take images from
+ */
+VisionRunnerBase::VisionRunnerBase(std::shared_ptr<SharedVideoSink> sharedSink)
+    : m_image(std::make_unique<cv::Mat>()),
+      m_sharedSink(std::move(sharedSink)),
+      m_enabled(true),
+      m_target(std::make_unique<cv::Rect>()) {}
+
+// Located here and not in header due to cv::Mat and cv::Rect forward
+// declarations.
 VisionRunnerBase::~VisionRunnerBase() {}
 
 /**
@@ -49,12 +67,16 @@ void VisionRunnerBase::RunOnce() {
         "VisionRunner::RunOnce() cannot be called from the main robot thread");
     return;
   }
+  if (m_sharedSink) {
+    RunSharedOnce();
+    return;
+  }
   auto frameTime = m_cvSink.GrabFrame(*m_image);
   if (frameTime == 0) {
     auto error = m_cvSink.GetError();
     DriverStation::ReportError(error);
   } else {
-    DoProcess(*m_image);
+    Process(*m_image, frameTime);
   }
 }
 
@@ -63,6 +85,10 @@ void VisionRunnerBase::RunOnce() {
  * must be run in a dedicated thread, and cannot be used in the main robot
  * thread because it will freeze the robot program.
  *
+ * <p>If stale frames are dropped (see SetDropStaleFrames()), frames are instead
+ * grabbed continuously on a second thread and the pipeline always runs on the
+ * newest one.</p>
+ *
  * <strong>Do not call this method directly from the main thread.</strong>
  */
 void VisionRunnerBase::RunForever() {
@@ -72,6 +98,11 @@ void VisionRunnerBase::RunForever() {
         "thread");
     return;
   }
+  // A shared sink always hands out the newest frame
+  if (m_dropStaleFrames && !m_sharedSink) {
+    RunLatestFrame();
+    return;
+  }
   while (m_enabled) {
     RunOnce();
   }
@@ -80,4 +111,161 @@ void VisionRunnerBase::RunForever() {
 /**
  * Stop a RunForever() loop.
  */
-void VisionRunnerBase::Stop() { m_enabled = false; }
+void VisionRunnerBase::Stop() {
+  std::lock_guard<wpi::mutex> lock(m_frameMutex);
+  m_enabled = false;
+  m_frameReady.notify_all();
+}
+
+/**
+ * Whether RunForever() drops frames that arrive while the pipeline is busy,
+ * so the pipeline always runs on the newest frame and its results lag the
+ * camera by at most one processing time. Takes effect the next time
+ * RunForever() is called.
+ *
+ * @param drop True to drop stale frames
+ */
+void VisionRunnerBase::SetDropStaleFrames(bool drop) {
+  m_dropStaleFrames = drop;
+}
+
+bool VisionRunnerBase::GetDropStaleFrames() const { return m_dropStaleFrames; }
+
+/**
+ * Returns the number of frames grabbed but dropped because a newer one
+ * arrived before the pipeline was free.
+ */
+uint64_t VisionRunnerBase::GetSkippedFrameCount() const {
+  return m_skippedFrames;
+}
+
+/**
+ * Returns the time from the capture of the latest processed frame to the end
+ * of the listener call for it, in seconds.
+ */
+double VisionRunnerBase::GetLatency() const { return m_latency; }
+
+/**
+ * Returns the capture time of the frame the pipeline last ran on, or is
+ * running on, in microseconds.
+ *
+ * @see CameraServer::FrameTimeToFPGATime()
+ */
+uint64_t VisionRunnerBase::GetFrameTime() const { return m_frameTime; }
+
+/**
+ * Sets how far the window searched by a TrackingVisionPipeline extends past
+ * the last target on each side, as a fraction of the target's size. It must
+ * cover how far the target can move between frames.
+ *
+ * @param margin The margin as a fraction of the target's width and height
+ */
+void VisionRunnerBase::SetTrackingMargin(double margin) {
+  m_trackingMargin = margin;
+}
+
+/**
+ * Sets how often a TrackingVisionPipeline searches the whole frame even though
+ * it found the target in its window, so it moves to a better target that came
+ * into view. 1 searches the whole frame every frame.
+ *
+ * @param frames The number of frames between searches of the whole frame
+ */
+void VisionRunnerBase::SetFullScanPeriod(int frames) {
+  m_fullScanPeriod = frames;
+}
+
+/**
+ * Returns the number of frames a TrackingVisionPipeline found the target in
+ * its window without searching the whole frame.
+ */
+uint64_t VisionRunnerBase::GetWindowedFrameCount() const {
+  return m_windowedFrames;
+}
+
+void VisionRunnerBase::ProcessTracking(TrackingVisionPipeline& pipeline,
+                                       cv::Mat& image) {
+  cv::Rect frame(0, 0, image.cols, image.rows);
+  cv::Rect target;
+
+  if (m_hasTarget && ++m_framesSinceScan < m_fullScanPeriod) {
+    double margin = m_trackingMargin;
+    int dx = static_cast<int>(m_target->width * margin);
+    int dy = static_cast<int>(m_target->height * margin);
+    cv::Rect window(m_target->x - dx, m_target->y - dy,
+                    m_target->width + 2 * dx, m_target->height + 2 * dy);
+    window &= frame;
+    if (window.area() > 0) {
+      // A header sharing the frame's pixels, so nothing is copied
+      cv::Mat region = image(window);
+      if (pipeline.ProcessWindow(region, window, target)) {
+        *m_target = target;
+        m_windowedFrames++;
+        return;
+      }
+    }
+  }
+
+  // The target was lost, or is due for a full scan
+  m_framesSinceScan = 0;
+  m_hasTarget = pipeline.ProcessWindow(image, frame, target);
+  if (m_hasTarget) *m_target = target;
+}
+
+void VisionRunnerBase::Process(cv::Mat& image, uint64_t frameTime) {
+  m_frameTime = frameTime;
+  DoProcess(image);
+  // Frame times are in the wpi::Now() timebase
+  m_latency = (wpi::Now() - frameTime) * 1.0e-6;
+}
+
+void VisionRunnerBase::RunSharedOnce() {
+  std::shared_ptr<const cv::Mat> frame;
+  uint64_t lastSequence = m_sharedSequence;
+  auto frameTime = m_sharedSink->GrabFrame(frame, m_sharedSequence);
+  if (frameTime == 0) {
+    auto error = m_sharedSink->GetError();
+    DriverStation::ReportError(error);
+    return;
+  }
+  if (lastSequence != 0) m_skippedFrames += m_sharedSequence - lastSequence - 1;
+
+  // A header sharing the frame's pixels; the pipeline must not write to them
+  *m_image = *frame;
+  Process(*m_image, frameTime);
+  // Let the sink reuse the buffer for a later frame
+  m_image->release();
+}
+
+void VisionRunnerBase::RunGrabber() {
+  while (m_enabled) {
+    auto& frame = m_frames.GetWriteBuffer();
+    if (!frame.image) frame.image = std::make_unique<cv::Mat>();
+    frame.time = m_cvSink.GrabFrame(*frame.image);
+    if (frame.time == 0) {
+      auto error = m_cvSink.GetError();
+      DriverStation::ReportError(error);
+      continue;
+    }
+    if (m_frames.Publish()) m_skippedFrames++;
+    // Passing through the mutex keeps the wakeup from being lost between a
+    // waiter's check of HasNew() and its sleep
+    { std::lock_guard<wpi::mutex> lock(m_frameMutex); }
+    m_frameReady.notify_one();
+  }
+}
+
+void VisionRunnerBase::RunLatestFrame() {
+  std::thread grabber(&VisionRunnerBase::RunGrabber, this);
+  while (m_enabled) {
+    {
+      std::unique_lock<wpi::mutex> lock(m_frameMutex);
+      m_frameReady.wait(lock, [&] { return m_frames.HasNew() || !m_enabled; });
+    }
+    if (!m_enabled) break;
+    m_frames.Update();
+    auto& frame = m_frames.GetReadBuffer();
+    Process(*frame.image, frame.time);
+  }
+  grabber.join();
+}
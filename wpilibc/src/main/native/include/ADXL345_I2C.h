@@ -30,6 +30,16 @@ class ADXL345_I2C : public SensorBase, public Accelerometer {
     double ZAxis;
   };
 
+  /**
+   * One sample read from the FIFO.
+   */
+  struct Sample {
+    double XAxis;
+    double YAxis;
+    double ZAxis;
+    double timestamp;  // FPGA time in seconds, from the sample rate
+  };
+
   explicit ADXL345_I2C(I2C::Port port, Range range = kRange_2G,
                        int deviceAddress = kAddress);
   ~ADXL345_I2C() override = default;
@@ -46,15 +56,23 @@ class ADXL345_I2C : public SensorBase, public Accelerometer {
   virtual double GetAcceleration(Axes axis);
   virtual AllAxes GetAccelerations();
 
+  void StartFIFO(double sampleRate, int watermark = 16);
+  void StopFIFO();
+  int ReadFIFO(Sample* samples, int count);
+
   void InitSendable(SendableBuilder& builder) override;
 
  protected:
   I2C m_i2c;
 
   static constexpr int kAddress = 0x1D;
+  static constexpr int kBWRateRegister = 0x2C;
   static constexpr int kPowerCtlRegister = 0x2D;
   static constexpr int kDataFormatRegister = 0x31;
   static constexpr int kDataRegister = 0x32;
+  static constexpr int kFIFOCtlRegister = 0x38;
+  static constexpr int kFIFOStatusRegister = 0x39;
+  static constexpr int kFIFODepth = 32;
   static constexpr double kGsPerLSB = 0.00390625;
 
   enum PowerCtlFields {
@@ -71,6 +89,10 @@ class ADXL345_I2C : public SensorBase, public Accelerometer {
     kDataFormat_FullRes = 0x08,
     kDataFormat_Justify = 0x04
   };
+
+  enum FIFOCtlFields { kFIFOCtl_Bypass = 0x00, kFIFOCtl_Stream = 0x80 };
+
+  double m_sampleRate = 100.0;
 };
 
 }  // namespace frc
@@ -29,6 +29,16 @@ class ADXL345_SPI : public SensorBase, public Accelerometer {
     double ZAxis;
   };
 
+  /**
+   * One sample read from the FIFO.
+   */
+  struct Sample {
+    double XAxis;
+    double YAxis;
+    double ZAxis;
+    double timestamp;  // FPGA time in seconds, from the sample rate
+  };
+
   explicit ADXL345_SPI(SPI::Port port, Range range = kRange_2G);
   ~ADXL345_SPI() override = default;
 
@@ -44,14 +54,22 @@ class ADXL345_SPI : public SensorBase, public Accelerometer {
   virtual double GetAcceleration(Axes axis);
   virtual AllAxes GetAccelerations();
 
+  void StartFIFO(double sampleRate, int watermark = 16);
+  void StopFIFO();
+  int ReadFIFO(Sample* samples, int count);
+
   void InitSendable(SendableBuilder& builder) override;
 
  protected:
   SPI m_spi;
 
+  static constexpr int kBWRateRegister = 0x2C;
   static constexpr int kPowerCtlRegister = 0x2D;
   static constexpr int kDataFormatRegister = 0x31;
   static constexpr int kDataRegister = 0x32;
+  static constexpr int kFIFOCtlRegister = 0x38;
+  static constexpr int kFIFOStatusRegister = 0x39;
+  static constexpr int kFIFODepth = 32;
   static constexpr double kGsPerLSB = 0.00390625;
 
   enum SPIAddressFields { kAddress_Read = 0x80, kAddress_MultiByte = 0x40 };
@@ -70,6 +88,10 @@ class ADXL345_SPI : public SensorBase, public Accelerometer {
     kDataFormat_FullRes = 0x08,
     kDataFormat_Justify = 0x04
   };
+
+  enum FIFOCtlFields { kFIFOCtl_Bypass = 0x00, kFIFOCtl_Stream = 0x80 };
+
+  double m_sampleRate = 100.0;
 };
 
 }  // namespace frc
@@ -27,6 +27,16 @@ class ADXL362 : public SensorBase, public Accelerometer {
     double ZAxis;
   };
 
+  /**
+   * One sample read from the FIFO.
+   */
+  struct Sample {
+    double XAxis;
+    double YAxis;
+    double ZAxis;
+    double timestamp;  // FPGA time in seconds, from the sample rate
+  };
+
  public:
   explicit ADXL362(Range range = kRange_2G);
   explicit ADXL362(SPI::Port port, Range range = kRange_2G);
@@ -44,11 +54,21 @@ class ADXL362 : public SensorBase, public Accelerometer {
   virtual double GetAcceleration(Axes axis);
   virtual AllAxes GetAccelerations();
 
+  void StartFIFO(double sampleRate, int watermark = 16);
+  void StopFIFO();
+  int ReadFIFO(Sample* samples, int count);
+
   void InitSendable(SendableBuilder& builder) override;
 
  private:
   SPI m_spi;
   double m_gsPerLSB = 0.001;
+  int m_odrCode;
+  double m_sampleRate = 100.0;
+
+  // The axes of a partly read FIFO sample
+  double m_fifoAxes[3];
+  int m_fifoAxesRead = 0;
 };
 
 }  // namespace frc
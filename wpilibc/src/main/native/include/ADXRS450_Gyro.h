@@ -9,11 +9,19 @@
 
 #include <stdint.h>
 
+#include <atomic>
+#include <memory>
+
+#include <llvm/ArrayRef.h>
+#include <support/mutex.h>
+
 #include "GyroBase.h"
 #include "SPI.h"
 
 namespace frc {
 
+class Notifier;
+
 /**
  * Use a rate gyro to return the robots heading relative to a starting position.
  *
@@ -28,19 +36,76 @@ namespace frc {
  */
 class ADXRS450_Gyro : public GyroBase {
  public:
+  enum IntegrationMode {
+    /**
+     * Sum the samples in the SPI accumulator, each weighted by the nominal
+     * sample period. The constructor blocks while calibrating.
+     */
+    kAccumulator,
+    /**
+     * Integrate each sample over the time since the previous one, from the
+     * FPGA timestamps of the SPI transfers. The constructor starts the
+     * calibration in the background, and the bias can follow the temperature
+     * of the sensor. The calibration is tracked by the CalibrationService.
+     */
+    kTimestamped
+  };
+
   ADXRS450_Gyro();
-  explicit ADXRS450_Gyro(SPI::Port port);
-  virtual ~ADXRS450_Gyro() = default;
+  explicit ADXRS450_Gyro(SPI::Port port, IntegrationMode mode = kAccumulator);
+  virtual ~ADXRS450_Gyro();
 
   double GetAngle() const override;
   double GetRate() const override;
   void Reset() override;
   void Calibrate() override;
 
+  void StartCalibration();
+  bool IsCalibrating() const;
+  double GetCalibrationProgress() const;
+
+  void SetBiasTracking(bool enabled);
+
+  void SetTemperatureCoefficient(double coefficient);
+  double GetTemperature() const;
+
  private:
   SPI m_spi;
+  IntegrationMode m_mode;
 
   uint16_t ReadRegister(int reg);
+
+  // Timestamped integration, fed by the SPI accumulator decoder
+  void ProcessSample(llvm::ArrayRef<uint8_t> transfer, uint64_t timestamp);
+  void UpdateTemperature();
+  double GetBias() const;
+
+  mutable wpi::mutex m_mutex;
+  double m_angle = 0.0;
+  double m_rate = 0.0;
+  uint64_t m_lastTimestamp = 0;
+
+  bool m_calibrating = false;
+  uint64_t m_calibrationStart = 0;
+  double m_calibrationProgress = 0.0;
+  int64_t m_calibrationSum = 0;
+  int64_t m_calibrationCount = 0;
+  double m_calibrationTemperatureSum = 0.0;
+  int m_calibrationTemperatureCount = 0;
+
+  double m_bias = 0.0;  // in LSB
+  double m_biasTemperature = 0.0;
+  double m_temperature = 0.0;
+  double m_temperatureCoefficient = 0.0;  // LSB per degree C
+  bool m_haveTemperature = false;
+
+  std::unique_ptr<Notifier> m_temperatureNotifier;
+
+  int m_calibrationJob = 0;
+  std::atomic_bool m_closing{false};
+  bool m_biasTracking = false;
+  // FPGA time of the latest CalibrationService update while disabled
+  std::atomic<uint64_t> m_disabledTime{0};
 };
 
 }  // namespace frc
@@ -7,11 +7,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <HAL/Types.h>
+#include <support/mutex.h>
 
 #include "GyroBase.h"
+#include "ReadCache.h"
 
 namespace frc {
 
@@ -38,15 +41,41 @@ class AnalogGyro : public GyroBase {
   static constexpr double kCalibrationSampleTime = 5.0;
   static constexpr double kDefaultVoltsPerDegreePerSecond = 0.007;
 
-  explicit AnalogGyro(int channel);
-  explicit AnalogGyro(AnalogInput* channel);
-  explicit AnalogGyro(std::shared_ptr<AnalogInput> channel);
+  enum CalibrationMode {
+    /**
+     * The constructor blocks while calibrating.
+     */
+    kBlockingCalibration,
+    /**
+     * The constructor queues the calibration on the CalibrationService, which
+     * runs it while the robot is disabled. The angle is 0 until it is done.
+     */
+    kBackgroundCalibration
+  };
+
+  /**
+   * Gyro state read from a single accumulator read.
+   */
+  struct Snapshot {
+    double angle;      // degrees
+    double rate;       // degrees per second
+    int64_t value;     // raw accumulated value
+    int64_t count;     // number of samples accumulated
+    double timestamp;  // FPGA time in seconds the state was read
+  };
+
+  explicit AnalogGyro(int channel, CalibrationMode mode = kBlockingCalibration);
+  explicit AnalogGyro(AnalogInput* channel,
+                      CalibrationMode mode = kBlockingCalibration);
+  explicit AnalogGyro(std::shared_ptr<AnalogInput> channel,
+                      CalibrationMode mode = kBlockingCalibration);
   AnalogGyro(int channel, int center, double offset);
   AnalogGyro(std::shared_ptr<AnalogInput> channel, int center, double offset);
   virtual ~AnalogGyro();
 
   double GetAngle() const override;
   double GetRate() const override;
+  Snapshot GetSnapshot() const;
   virtual int GetCenter() const;
   virtual double GetOffset() const;
   void SetSensitivity(double voltsPerDegreePerSecond);
@@ -55,11 +84,28 @@ class AnalogGyro : public GyroBase {
   virtual void InitGyro();
   void Calibrate() override;
 
+  void StartCalibration();
+  bool IsCalibrating() const;
+  double GetCalibrationProgress() const;
+
  protected:
   std::shared_ptr<AnalogInput> m_analog;
 
  private:
+  void RunCalibration();
+  void InvalidateReadCache();
+
   HAL_GyroHandle m_gyroHandle = HAL_kInvalidHandle;
+
+  // Serializes Calibrate() with background calibrations
+  wpi::mutex m_calibrationMutex;
+  int m_calibrationJob = 0;
+  std::atomic_bool m_calibrating{false};
+  // FPGA time the running calibration started, 0 while it is queued
+  std::atomic<double> m_calibrationStart{0.0};
+
+  CachedRead<double> m_angleCache;
+  CachedRead<double> m_rateCache;
 };
 
 }  // namespace frc
@@ -10,8 +10,13 @@
 #include <stdint.h>
 
 #include <HAL/Types.h>
+#include <llvm/ArrayRef.h>
+#include <support/mutex.h>
 
+#include "Filters/FixedLinearDigitalFilter.h"
+#include "Internal/DeviceLog.h"
 #include "PIDSource.h"
+#include "ReadCache.h"
 #include "SensorBase.h"
 
 namespace frc {
@@ -31,8 +36,24 @@ namespace frc {
 class AnalogInput : public SensorBase, public PIDSource {
   friend class AnalogTrigger;
   friend class AnalogGyro;
+  friend class DMA;
+  friend class DMASample;
 
  public:
+  /**
+   * Presets trading the noise of GetFilteredVoltage() against its latency.
+   */
+  enum FilterProfile {
+    // No filtering; GetFilteredVoltage() returns GetVoltage()
+    kNone,
+    // No hardware averaging, for the fastest response
+    kLowLatency,
+    // 16 samples averaged in hardware
+    kBalanced,
+    // 256 samples averaged in hardware, then a 4 reading moving average
+    kLowNoise
+  };
+
   static constexpr int kAccumulatorModuleNumber = 1;
   static constexpr int kAccumulatorNumChannels = 2;
   static constexpr int kAccumulatorChannels[kAccumulatorNumChannels] = {0, 1};
@@ -46,6 +67,9 @@ class AnalogInput : public SensorBase, public PIDSource {
   double GetVoltage() const;
   double GetAverageVoltage() const;
 
+  static void GetVoltages(llvm::ArrayRef<const AnalogInput*> inputs,
+                          double* voltages);
+
   int GetChannel() const;
 
   void SetAverageBits(int bits);
@@ -53,6 +77,11 @@ class AnalogInput : public SensorBase, public PIDSource {
   void SetOversampleBits(int bits);
   int GetOversampleBits() const;
 
+  void SetFilterProfile(FilterProfile profile);
+  FilterProfile GetFilterProfile() const;
+  double GetFilteredVoltage() const;
+  double GetFilterGroupDelay() const;
+
   int GetLSBWeight() const;
   int GetOffset() const;
 
@@ -69,15 +98,44 @@ class AnalogInput : public SensorBase, public PIDSource {
   static void SetSampleRate(double samplesPerSecond);
   static double GetSampleRate();
 
+  static void StartMirror(double period);
+  static void StopMirror();
+
+  void StartStreaming(int bufferSize);
+  void StopStreaming();
+  int ReadStream(double* voltages, double* timestamps, int count);
+  int64_t GetStreamOverflowCount() const;
+
   double PIDGet(PIDSourceType pidSource) override;
 
   void InitSendable(SendableBuilder& builder) override;
 
  private:
+  void InvalidateReadCache();
+
   int m_channel;
   // TODO: Adjust HAL to avoid use of raw pointers.
   HAL_AnalogInputHandle m_port;
   int64_t m_accumulatorOffset;
+
+  mutable DeviceLogSignal<DoubleLogEntry> m_voltageLog;
+  mutable DeviceLogSignal<DoubleLogEntry> m_averageVoltageLog;
+
+  // Reads latched once per loop by the ReadCache
+  CachedRead<int> m_valueCache;
+  CachedRead<int> m_averageValueCache;
+  CachedRead<double> m_voltageCache;
+  CachedRead<double> m_averageVoltageCache;
+
+  static constexpr int kSoftwareTaps = 4;
+
+  FilterProfile m_filterProfile = kNone;
+  mutable wpi::mutex m_softwareFilterMutex;
+  mutable FixedLinearDigitalFilter<kSoftwareTaps, 0> m_softwareFilter =
+      MakeMovingAverageFilter<kSoftwareTaps>();
+  // Mean time between GetFilteredVoltage() calls feeding the software stage
+  mutable double m_lastFilterTime = 0.0;
+  mutable double m_filterPeriod = 0.0;
 };
 
 }  // namespace frc
@@ -29,6 +29,8 @@ class AnalogOutput : public ErrorBase, public SendableBase {
   void InitSendable(SendableBuilder& builder) override;
 
  protected:
+  friend class Waveform;
+
   int m_channel;
   HAL_AnalogOutputHandle m_port;
 };
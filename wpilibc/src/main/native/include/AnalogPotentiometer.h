@@ -11,6 +11,7 @@
 
 #include "AnalogInput.h"
 #include "SensorBase.h"
+#include "Units.h"
 #include "interfaces/Potentiometer.h"
 
 namespace frc {
@@ -44,6 +45,18 @@ class AnalogPotentiometer : public SensorBase, public Potentiometer {
   explicit AnalogPotentiometer(int channel, double fullRange = 1.0,
                                double offset = 0.0);
 
+  /**
+   * AnalogPotentiometer constructor for a rotary potentiometer, whose Get()
+   * then returns radians.
+   *
+   * @param channel   The analog channel this potentiometer is plugged into.
+   * @param fullRange The rotation over the full supply voltage.
+   * @param offset    The rotation at 0V.
+   */
+  AnalogPotentiometer(int channel, units::radian_t fullRange,
+                      units::radian_t offset = units::radian_t())
+      : AnalogPotentiometer(channel, fullRange.value(), offset.value()) {}
+
   explicit AnalogPotentiometer(AnalogInput* input, double fullRange = 1.0,
                                double offset = 0.0);
 
@@ -59,6 +72,20 @@ class AnalogPotentiometer : public SensorBase, public Potentiometer {
    */
   double Get() const override;
 
+  /**
+   * Set the filtering preset of the analog input.
+   *
+   * @see AnalogInput::SetFilterProfile()
+   */
+  void SetFilterProfile(AnalogInput::FilterProfile profile);
+
+  /**
+   * Get the delay of Get() due to filtering, in seconds.
+   *
+   * @see AnalogInput::GetFilterGroupDelay()
+   */
+  double GetFilterGroupDelay() const;
+
   /**
    * Implement the PIDSource interface.
    *
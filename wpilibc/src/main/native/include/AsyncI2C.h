@@ -0,0 +1,76 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <llvm/ArrayRef.h>
+
+#include "ErrorBase.h"
+#include "I2C.h"
+
+namespace frc {
+
+/**
+ * Non-blocking I2C access to a device.
+ *
+ * I2C transactions are blocking system calls that can take a millisecond or
+ * more. An AsyncI2C queues transactions to a worker thread owned by the port,
+ * and reports each result through a callback or a future, so the calling
+ * thread never waits on the bus.
+ *
+ * A device can also be read periodically. The worker reads the registers on
+ * its own schedule into a double buffer, and GetPeriodicRead() copies out the
+ * latest complete read without touching the bus.
+ *
+ * All AsyncI2C objects on a port share its worker, so their transactions run
+ * in submission order. Queued transactions run before due periodic reads.
+ */
+class AsyncI2C : public ErrorBase {
+ public:
+  struct Result {
+    bool aborted = true;
+    std::vector<uint8_t> data;
+  };
+
+  using Callback = std::function<void(const Result& result)>;
+
+  AsyncI2C(I2C::Port port, int deviceAddress);
+  ~AsyncI2C() override;
+
+  AsyncI2C(const AsyncI2C&) = delete;
+  AsyncI2C& operator=(const AsyncI2C&) = delete;
+
+  void Transaction(llvm::ArrayRef<uint8_t> dataToSend, int receiveSize,
+                   Callback callback);
+  std::future<Result> Transaction(llvm::ArrayRef<uint8_t> dataToSend,
+                                  int receiveSize);
+  std::future<Result> Write(int registerAddress, uint8_t data);
+  std::future<Result> Read(int registerAddress, int count);
+
+  void StartPeriodicRead(int registerAddress, int count, double period);
+  void StopPeriodicRead();
+  bool GetPeriodicRead(uint8_t* data, int count,
+                       double* timestamp = nullptr) const;
+
+ private:
+  class Worker;
+  struct PeriodicRead;
+
+  HAL_I2CPort m_port;
+  int m_deviceAddress;
+  Worker* m_worker;
+  std::shared_ptr<PeriodicRead> m_periodicRead;
+};
+
+}  // namespace frc
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include "SensorBase.h"
 #include "interfaces/Accelerometer.h"
 
@@ -19,6 +21,22 @@ namespace frc {
  */
 class BuiltInAccelerometer : public SensorBase, public Accelerometer {
  public:
+  struct AllAxes {
+    double XAxis;
+    double YAxis;
+    double ZAxis;
+  };
+
+  /**
+   * One sample read by the background sampler.
+   */
+  struct Sample {
+    double XAxis;
+    double YAxis;
+    double ZAxis;
+    double timestamp;  // FPGA time in seconds
+  };
+
   explicit BuiltInAccelerometer(Range range = kRange_8G);
 
   // Accelerometer interface
@@ -27,6 +45,13 @@ class BuiltInAccelerometer : public SensorBase, public Accelerometer {
   double GetY() override;
   double GetZ() override;
 
+  AllAxes GetAccelerations();
+
+  void StartSampling(int bufferSize);
+  void StopSampling();
+  int ReadSamples(Sample* samples, int count);
+  int64_t GetSampleOverflowCount() const;
+
   void InitSendable(SendableBuilder& builder) override;
 };
 
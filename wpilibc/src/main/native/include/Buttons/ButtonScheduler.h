@@ -18,6 +18,11 @@ class ButtonScheduler {
   virtual ~ButtonScheduler() = default;
   virtual void Execute() = 0;
   void Start();
+  Trigger* GetTrigger() const;
+
+  // Whether Execute() only acts when the trigger changes, so a scheduler in
+  // button edge detection mode can skip it while the trigger is unchanged
+  virtual bool IsEdgeTriggered() const;
 
  protected:
   bool m_pressedLast;
@@ -19,6 +19,9 @@ class HeldButtonScheduler : public ButtonScheduler {
   HeldButtonScheduler(bool last, Trigger* button, Command* orders);
   virtual ~HeldButtonScheduler() = default;
   virtual void Execute();
+
+  // Restarts the command every time it is executed while held
+  bool IsEdgeTriggered() const override;
 };
 
 }  // namespace frc
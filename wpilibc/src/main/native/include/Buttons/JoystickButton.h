@@ -18,6 +18,7 @@ class JoystickButton : public Button {
   virtual ~JoystickButton() = default;
 
   virtual bool Get();
+  bool GetJoystickButton(int* stick, int* button) const override;
 
  private:
   GenericHID* m_joystick;
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <llvm/Twine.h>
@@ -17,17 +18,47 @@
 
 namespace frc {
 
+/**
+ * A button whose state is a boolean NetworkTables entry, as set by a
+ * dashboard.
+ *
+ * The entry and the connection are listened to, so Get() reads cached state
+ * instead of NetworkTables. A button can also be debounced, and latched so a
+ * press shorter than a Scheduler loop still registers.
+ */
 class NetworkButton : public Button {
  public:
   NetworkButton(const llvm::Twine& tableName, const llvm::Twine& field);
   NetworkButton(std::shared_ptr<nt::NetworkTable> table,
                 const llvm::Twine& field);
-  virtual ~NetworkButton() = default;
+  virtual ~NetworkButton();
+
+  NetworkButton(const NetworkButton&) = delete;
+  NetworkButton& operator=(const NetworkButton&) = delete;
 
   virtual bool Get();
 
+  void SetDebouncePeriod(double seconds);
+  void SetLatching(bool latching);
+
  private:
+  void UpdateValue(bool value);
+
   nt::NetworkTableEntry m_entry;
+  NT_EntryListener m_entryListener = 0;
+  NT_ConnectionListener m_connectionListener = 0;
+
+  std::atomic<bool> m_value{false};
+  std::atomic<bool> m_connected{false};
+  // Set on each press, and cleared by Get() when latching
+  std::atomic<bool> m_pressed{false};
+  std::atomic<bool> m_latching{false};
+
+  // FPGA time of the last change of m_value
+  std::atomic<double> m_changeTime{0.0};
+  std::atomic<double> m_debouncePeriod{0.0};
+  // The state Get() reports when debouncing; only used by Get()
+  bool m_debounced = false;
 };
 
 }  // namespace frc
@@ -34,6 +34,8 @@ class Trigger : public SendableBase {
   ~Trigger() override = default;
   bool Grab();
   virtual bool Get() = 0;
+  virtual bool GetJoystickButton(int* stick, int* button) const;
+  bool GetDashboardPressed() const;
   void WhenActive(Command* command);
   void WhileActive(Command* command);
   void WhenInactive(Command* command);
@@ -0,0 +1,73 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <HAL/CAN.h>
+#include <support/mutex.h>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+class Notifier;
+
+/**
+ * Collects CAN messages through stream sessions.
+ *
+ * Polling a device with HAL_CAN_ReceiveMessage() costs one lookup per message
+ * ID per loop. A CANStreamReader instead opens one stream session per ID/mask
+ * filter, and periodically drains each session in batches from a Notifier.
+ * The latest messages of every ID seen are kept in a per-ID history, so
+ * reading many devices costs a few bulk calls per period.
+ */
+class CANStreamReader : public ErrorBase {
+ public:
+  using Message = HAL_CANStreamMessage;
+
+  explicit CANStreamReader(double period = 0.01, int historySize = 8);
+  ~CANStreamReader() override;
+
+  CANStreamReader(const CANStreamReader&) = delete;
+  CANStreamReader& operator=(const CANStreamReader&) = delete;
+
+  bool AddFilter(uint32_t messageID, uint32_t messageIDMask,
+                 uint32_t maxMessages = 64);
+
+  bool GetLatest(uint32_t messageID, Message* message) const;
+  int GetHistory(uint32_t messageID, Message* messages, int count) const;
+
+  int64_t GetMessageCount() const;
+  int64_t GetOverrunCount() const;
+
+ private:
+  // ring of the latest messages of one ID
+  struct History {
+    std::vector<Message> messages;
+    size_t next = 0;
+    size_t size = 0;
+  };
+
+  void Update();
+
+  int m_historySize;
+  std::vector<uint32_t> m_sessions;
+  std::unordered_map<uint32_t, History> m_history;
+  int64_t m_messageCount = 0;
+  int64_t m_overrunCount = 0;
+
+  mutable wpi::mutex m_mutex;
+  std::unique_ptr<Notifier> m_notifier;
+};
+
+}  // namespace frc
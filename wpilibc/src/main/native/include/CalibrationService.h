@@ -0,0 +1,91 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+/**
+ * Calibrates sensors on a background thread while the robot is disabled, so
+ * robot startup does not wait for them.
+ *
+ * Sensors add a job for each calibration. Jobs run one at a time, in the
+ * order they were added, and only start while the robot is disabled; a job
+ * that has started finishes even if the robot is enabled. Once calibrated, a
+ * job may keep running a short update every kDisabledPeriod while the robot
+ * is disabled, for example to track the zero of a gyro that is sitting
+ * still.
+ */
+class CalibrationService : public ErrorBase {
+ public:
+  static constexpr double kDisabledPeriod = 0.1;
+
+  /**
+   * A calibration run by the service.
+   */
+  struct Job {
+    // Calibrates the sensor, blocking the service thread until done
+    std::function<void()> calibrate;
+    // Optional; the fraction of a running calibration done, from 0 to 1
+    std::function<double()> progress;
+    // Optional; called every kDisabledPeriod while disabled once calibrated
+    std::function<void()> whileDisabled;
+  };
+
+  static CalibrationService& GetInstance();
+
+  ~CalibrationService() override;
+
+  CalibrationService(const CalibrationService&) = delete;
+  CalibrationService& operator=(const CalibrationService&) = delete;
+
+  int AddJob(Job job);
+  void RemoveJob(int job);
+  void Recalibrate(int job);
+
+  bool IsReady(int job) const;
+  bool IsReady() const;
+  double GetProgress() const;
+
+ private:
+  CalibrationService() = default;
+
+  struct Entry {
+    int id;
+    Job job;
+    bool ready;
+    // bumped by Recalibrate(), so a calibration that was running when it was
+    // called does not mark the job ready
+    int generation;
+  };
+
+  void ThreadMain();
+  // runs a function of a job with m_mutex unlocked
+  void RunJob(std::unique_lock<wpi::mutex>& lock, int id,
+              const std::function<void()>& func);
+  std::vector<Entry>::iterator Find(int id);
+  std::vector<Entry>::const_iterator Find(int id) const;
+
+  std::thread m_thread;
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::vector<Entry> m_jobs;
+  int m_nextId = 1;
+  int m_running = 0;
+  bool m_stop = false;
+};
+
+}  // namespace frc
@@ -21,7 +21,9 @@
 #include <support/mutex.h>
 
 #include "ErrorBase.h"
+#include "Notifier.h"
 #include "cscore.h"
+#include "vision/SharedVideoSink.h"
 
 namespace frc {
 
@@ -37,6 +39,25 @@ class CameraServer : public ErrorBase {
   static constexpr int kSize320x240 = 1;
   static constexpr int kSize160x120 = 2;
 
+  /**
+   * Settings for the stream a server sends its clients.
+   *
+   * The profile is applied once on the roboRIO, so every client of the server
+   * receives the same reduced stream. Fields left at their defaults keep the
+   * camera's setting.
+   */
+  struct StreamProfile {
+    // Resolution of the stream; 0 keeps the camera's resolution
+    int width = 0;
+    int height = 0;
+    // Maximum frame rate of the stream; 0 for no limit
+    int maxFPS = 0;
+    // JPEG quality of the stream, 0-100; -1 for the server's default
+    int quality = -1;
+    // Whether to send the stream in grayscale
+    bool grayscale = false;
+  };
+
   /**
    * Get the CameraServer instance.
    */
@@ -207,6 +228,35 @@ class CameraServer : public ErrorBase {
    */
   cs::CvSink GetVideo(llvm::StringRef name);
 
+  /**
+   * Get a sink that decodes each frame of the primary camera feed once and
+   * shares it between several consumers, such as VisionRunners for different
+   * targets.
+   *
+   * <p>This is only valid to call after a camera feed has been added
+   * with startAutomaticCapture() or addServer().
+   */
+  std::shared_ptr<SharedVideoSink> GetSharedVideo();
+
+  /**
+   * Get a sink that decodes each frame of the specified camera once and
+   * shares it between several consumers.
+   *
+   * Every call for the same camera returns the same sink while it is in use.
+   *
+   * @param camera Camera (e.g. as returned by startAutomaticCapture).
+   */
+  std::shared_ptr<SharedVideoSink> GetSharedVideo(
+      const cs::VideoSource& camera);
+
+  /**
+   * Get a sink that decodes each frame of the specified camera once and
+   * shares it between several consumers.
+   *
+   * @param name Camera name
+   */
+  std::shared_ptr<SharedVideoSink> GetSharedVideo(llvm::StringRef name);
+
   /**
    * Create a MJPEG stream with OpenCV input. This can be called to pass custom
    * annotated images to the dashboard.
@@ -217,6 +267,18 @@ class CameraServer : public ErrorBase {
    */
   cs::CvSource PutVideo(llvm::StringRef name, int width, int height);
 
+  /**
+   * Create a MJPEG stream with OpenCV input, sent to the dashboard with a
+   * stream profile applied.
+   *
+   * @param name Name to give the stream
+   * @param width Width of the image being sent
+   * @param height Height of the image being sent
+   * @param profile The profile of the stream sent to clients
+   */
+  cs::CvSource PutVideo(llvm::StringRef name, int width, int height,
+                        const StreamProfile& profile);
+
   /**
    * Adds a MJPEG server at the next available port.
    *
@@ -231,6 +293,27 @@ class CameraServer : public ErrorBase {
    */
   cs::MjpegServer AddServer(llvm::StringRef name, int port);
 
+  /**
+   * Adds a MJPEG server at the next available port, with a stream profile.
+   *
+   * @param name Server name
+   * @param profile The profile of the stream sent to clients
+   * @see SetStreamProfile()
+   */
+  cs::MjpegServer AddServer(llvm::StringRef name,
+                            const StreamProfile& profile);
+
+  /**
+   * Adds a MJPEG server with a stream profile.
+   *
+   * @param name Server name
+   * @param port Server port
+   * @param profile The profile of the stream sent to clients
+   * @see SetStreamProfile()
+   */
+  cs::MjpegServer AddServer(llvm::StringRef name, int port,
+                            const StreamProfile& profile);
+
   /**
    * Adds an already created server.
    *
@@ -238,6 +321,19 @@ class CameraServer : public ErrorBase {
    */
   void AddServer(const cs::VideoSink& server);
 
+  /**
+   * Sets the stream profile of a MJPEG server, replacing any earlier profile.
+   *
+   * Frames from the server's source are converted by a thread of their own
+   * and the server sends the converted frames. The server keeps its profile
+   * when its source is changed later; until the change is seen, clients may
+   * briefly receive the unconverted stream.
+   *
+   * @param name Server name
+   * @param profile The profile of the stream sent to clients
+   */
+  void SetStreamProfile(llvm::StringRef name, const StreamProfile& profile);
+
   /**
    * Removes a server by name.
    *
@@ -285,13 +381,46 @@ class CameraServer : public ErrorBase {
    */
   void SetSize(int size);
 
+  /**
+   * Converts a frame time from CvSink::GrabFrame() to FPGA time.
+   *
+   * cscore timestamps frames with wpi::Now(). On the roboRIO that clock is
+   * the FPGA clock once the HAL is initialized; elsewhere the two clocks are
+   * offset from each other, and the offset is measured at the time of the
+   * call.
+   *
+   * @param frameTime The frame time in microseconds
+   * @return The FPGA time of the frame in microseconds, comparable with
+   *         RobotController::GetFPGATime()
+   */
+  static uint64_t FrameTimeToFPGATime(uint64_t frameTime);
+
+  /**
+   * Converts a frame time from CvSink::GrabFrame() to FPGA time in seconds.
+   *
+   * @param frameTime The frame time in microseconds
+   * @return The FPGA time of the frame in seconds, comparable with
+   *         Timer::GetFPGATimestamp()
+   */
+  static double FrameTimeToFPGATimestamp(uint64_t frameTime);
+
  private:
+  class ProfiledStream;
+
   CameraServer();
+  ~CameraServer() override;
 
   std::shared_ptr<nt::NetworkTable> GetSourceTable(CS_Source source);
   std::vector<std::string> GetSinkStreamValues(CS_Sink sink);
   std::vector<std::string> GetSourceStreamValues(CS_Source source);
   void UpdateStreamValues();
+  void PublishStreamValues(nt::NetworkTable* table, CS_Source source,
+                           std::vector<std::string> values);
+  void PublishModeValues(CS_Source source);
+  void SchedulePublish();
+  void PublishPending();
+  ProfiledStream* FindProfiledStream(CS_Sink sink);
+  void RouteProfiledStream(CS_Sink sink);
 
   static constexpr char const* kPublishName = "/CameraPublisher";
 
@@ -300,8 +429,23 @@ class CameraServer : public ErrorBase {
   std::string m_primarySourceName;
   llvm::StringMap<cs::VideoSource> m_sources;
   llvm::StringMap<cs::VideoSink> m_sinks;
+  // Keyed by camera name; a sink is destroyed with its last consumer
+  llvm::StringMap<std::weak_ptr<SharedVideoSink>> m_sharedSinks;
+  // Keyed by server name
+  llvm::StringMap<std::unique_ptr<ProfiledStream>> m_profiledStreams;
   llvm::DenseMap<CS_Source, std::shared_ptr<nt::NetworkTable>> m_tables;
   std::shared_ptr<nt::NetworkTable> m_publishTable;
+
+  // The "streams" and "modes" arrays last published for each source, so
+  // unchanged arrays are not sent again
+  llvm::DenseMap<CS_Source, std::vector<std::string>> m_publishedStreams;
+  llvm::DenseMap<CS_Source, std::vector<std::string>> m_publishedModes;
+  // Work deferred by the video listener, done together by PublishPending()
+  bool m_publishPending = false;
+  bool m_streamsDirty = false;
+  std::vector<CS_Source> m_dirtyModes;
+  std::unique_ptr<Notifier> m_publishNotifier;
+
   cs::VideoListener m_videoListener;
   int m_tableListener;
   int m_nextPort;
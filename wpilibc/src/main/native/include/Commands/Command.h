@@ -14,6 +14,7 @@
 #include <llvm/Twine.h>
 
 #include "ErrorBase.h"
+#include "Executor.h"
 #include "SmartDashboard/SendableBase.h"
 
 namespace frc {
@@ -68,12 +69,18 @@ class Command : public ErrorBase, public SendableBase {
   void SetInterruptible(bool interruptible);
   bool DoesRequire(Subsystem* subsystem) const;
   typedef std::set<Subsystem*> SubsystemSet;
-  SubsystemSet GetRequirements() const;
+  const SubsystemSet& GetRequirements() const;
   CommandGroup* GetGroup() const;
   void SetRunWhenDisabled(bool run);
   bool WillRunWhenDisabled() const;
   int GetID() const;
 
+  void SetExecutionBudget(double budget);
+  double GetExecutionBudget() const;
+  double GetLastExecutionTime() const;
+  double GetMaxExecutionTime() const;
+  int GetBudgetOverruns() const;
+
  protected:
   void SetTimeout(double timeout);
   bool IsTimedOut() const;
@@ -85,6 +92,9 @@ class Command : public ErrorBase, public SendableBase {
   virtual void Initialize();
   virtual void Execute();
 
+  void SetBackgroundExecution(bool enabled);
+  virtual void ExecuteBackground();
+
   /**
    * Returns whether this command is finished.
    *
@@ -111,6 +121,7 @@ class Command : public ErrorBase, public SendableBase {
   virtual void _Execute();
   virtual void _End();
   virtual void _Cancel();
+  virtual void _Removing();
 
   friend class ConditionalCommand;
 
@@ -119,6 +130,8 @@ class Command : public ErrorBase, public SendableBase {
   void Removed();
   void StartRunning();
   void StartTiming();
+  void RecordExecutionTime(double time);
+  void WaitForBackground();
 
   // The time since this command was initialized
   double m_startTime = -1;
@@ -150,9 +163,32 @@ class Command : public ErrorBase, public SendableBase {
   // The CommandGroup this is in
   CommandGroup* m_parent = nullptr;
 
+  // Slot in the Scheduler's running commands (-1 if not running there)
+  int m_schedulerIndex = -1;
+
+  // Whether this command is queued in the Scheduler's additions
+  bool m_pendingAddition = false;
+
+  // The name the Scheduler's watchdog records this command's epochs under
+  std::string m_epochName;
+
   // Whether or not this command has completed running
   bool m_completed = false;
 
+  // The longest time (in seconds) one Run() should take (-1 if no budget)
+  double m_executionBudget = -1;
+
+  // Run() times measured by the Scheduler
+  double m_lastExecutionTime = 0;
+  double m_maxExecutionTime = 0;
+  int m_budgetOverruns = 0;
+
+  // Whether ExecuteBackground() runs on the Executor
+  bool m_backgroundExecution = false;
+
+  // The latest ExecuteBackground() submitted to the Executor
+  Future<void> m_backgroundWork;
+
   int m_commandID = m_commandCounter++;
   static int m_commandCounter;
 
@@ -7,9 +7,12 @@
 
 #pragma once
 
-#include <list>
+#include <stddef.h>
+#include <stdint.h>
+
 #include <vector>
 
+#include <llvm/SmallVector.h>
 #include <llvm/Twine.h>
 
 #include "Commands/Command.h"
@@ -59,13 +62,22 @@ class CommandGroup : public Command {
   virtual void _End();
 
  private:
-  void CancelConflicts(Command* command);
+  void AddEntry(const CommandGroupEntry& entry);
+  uint64_t GetRequirementMask(Command* command);
+  bool Conflicts(const CommandGroupEntry& a, const CommandGroupEntry& b) const;
+  void CancelConflicts(const CommandGroupEntry& entry);
 
   // The commands in this group (stored in entries)
   std::vector<CommandGroupEntry> m_commands;
 
-  // The active children in this group (stored in entries)
-  std::list<CommandGroupEntry> m_children;
+  // The subsystems the commands require, in the order of their mask bits
+  std::vector<Subsystem*> m_subsystems;
+
+  // False if the commands require more subsystems than a mask has bits
+  bool m_masksValid = true;
+
+  // The indices in m_commands of the active children in this group
+  llvm::SmallVector<size_t, 8> m_children;
 
   // The current command, -1 signifies that none have been run
   int m_currentCommandIndex = -1;
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <stdint.h>
+
 namespace frc {
 
 class Command;
@@ -26,6 +28,8 @@ class CommandGroupEntry {
   double m_timeout = -1.0;
   Command* m_command = nullptr;
   Sequence m_state = kSequence_InSequence;
+  // The command's requirements, one bit per subsystem of the group
+  uint64_t m_requirementMask = 0;
 };
 
 }  // namespace frc
@@ -0,0 +1,195 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include <llvm/Twine.h>
+
+#include "Commands/Command.h"
+
+namespace frc {
+
+class Subsystem;
+
+/*
+ * Statically composed commands.
+ *
+ * An action is any type with the methods
+ *
+ *   void Initialize();
+ *   void Execute();
+ *   bool IsFinished();
+ *   void End(bool interrupted);
+ *
+ * which have the same meaning as for a Command. Sequence and Parallel hold
+ * their actions by value in a std::tuple and call them directly, so a whole
+ * composed group is one object with no virtual calls or allocations between
+ * its parts. StaticCommand adapts an action to Command so it can be given to
+ * the Scheduler like any other command.
+ *
+ *   auto command = MakeCommand(
+ *       MakeSequence(MakeInstant([] { shooter.Spin(); }), WaitAction(0.5),
+ *                    MakeParallel(DriveAction(2.0), MakeInstant(...))),
+ *       {&drivetrain, &shooter});
+ *   command->Start();
+ */
+
+/**
+ * An action made of four functions.
+ */
+template <typename InitializeFn, typename ExecuteFn, typename IsFinishedFn,
+          typename EndFn>
+class FunctionAction {
+ public:
+  FunctionAction(InitializeFn initialize, ExecuteFn execute,
+                 IsFinishedFn isFinished, EndFn end);
+
+  void Initialize();
+  void Execute();
+  bool IsFinished();
+  void End(bool interrupted);
+
+ private:
+  InitializeFn m_initialize;
+  ExecuteFn m_execute;
+  IsFinishedFn m_isFinished;
+  EndFn m_end;
+};
+
+/**
+ * An action that calls a function once when it is initialized and then
+ * finishes.
+ */
+template <typename Fn>
+class InstantAction {
+ public:
+  explicit InstantAction(Fn fn);
+
+  void Initialize();
+  void Execute() {}
+  bool IsFinished() { return true; }
+  void End(bool interrupted) {}
+
+ private:
+  Fn m_fn;
+};
+
+/**
+ * An action that finishes after a time has passed.
+ */
+class WaitAction {
+ public:
+  explicit WaitAction(double seconds);
+
+  void Initialize();
+  void Execute() {}
+  bool IsFinished();
+  void End(bool interrupted) {}
+
+ private:
+  double m_seconds;
+  double m_startTime = 0;
+};
+
+/**
+ * Runs actions one after another. When an action finishes, the next one is
+ * initialized and executed in the same call, as in CommandGroup.
+ */
+template <typename... Actions>
+class Sequence {
+ public:
+  static_assert(sizeof...(Actions) > 0, "a sequence needs an action");
+
+  explicit Sequence(Actions... actions);
+
+  void Initialize();
+  void Execute();
+  bool IsFinished();
+  void End(bool interrupted);
+
+ private:
+  std::tuple<Actions...> m_actions;
+  size_t m_index = 0;
+};
+
+/**
+ * Runs actions at the same time, finishing when all of them have finished.
+ * Each action is ended as soon as it finishes.
+ */
+template <typename... Actions>
+class Parallel {
+ public:
+  static_assert(sizeof...(Actions) > 0, "a parallel group needs an action");
+
+  explicit Parallel(Actions... actions);
+
+  void Initialize();
+  void Execute();
+  bool IsFinished();
+  void End(bool interrupted);
+
+ private:
+  std::tuple<Actions...> m_actions;
+  std::array<bool, sizeof...(Actions)> m_running{};
+};
+
+/**
+ * Adapts an action to Command.
+ */
+template <typename Action>
+class StaticCommand : public Command {
+ public:
+  explicit StaticCommand(Action action,
+                         std::initializer_list<Subsystem*> requirements = {});
+  StaticCommand(const llvm::Twine& name, Action action,
+                std::initializer_list<Subsystem*> requirements = {});
+
+  Action& GetAction();
+
+ protected:
+  void Initialize() override;
+  void Execute() override;
+  bool IsFinished() override;
+  void End() override;
+  void Interrupted() override;
+
+ private:
+  Action m_action;
+};
+
+template <typename InitializeFn, typename ExecuteFn, typename IsFinishedFn,
+          typename EndFn>
+FunctionAction<InitializeFn, ExecuteFn, IsFinishedFn, EndFn> MakeAction(
+    InitializeFn initialize, ExecuteFn execute, IsFinishedFn isFinished,
+    EndFn end);
+
+template <typename Fn>
+InstantAction<Fn> MakeInstant(Fn fn);
+
+template <typename... Actions>
+Sequence<typename std::decay<Actions>::type...> MakeSequence(
+    Actions&&... actions);
+
+template <typename... Actions>
+Parallel<typename std::decay<Actions>::type...> MakeParallel(
+    Actions&&... actions);
+
+template <typename Action>
+std::unique_ptr<StaticCommand<typename std::decay<Action>::type>> MakeCommand(
+    Action&& action, std::initializer_list<Subsystem*> requirements = {});
+
+}  // namespace frc
+
+#include "Commands/Composition.inc"
@@ -0,0 +1,54 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include <llvm/Twine.h>
+
+#include "Commands/Command.h"
+#include "MotionProfile/ProfileFollower.h"
+
+namespace frc {
+
+/**
+ * A command that follows a precomputed profile with a ProfileFollower,
+ * finishing after the last setpoint.
+ *
+ * The profile may be anything a ProfileFollower can follow, including a
+ * MappedTrajectory loaded from a file, so a path generated at build time is
+ * followed without any work at runtime. The handler is called on the
+ * follower's notifier thread; see ProfileFollower.
+ */
+template <typename Profile>
+class FollowProfileCommand : public Command {
+ public:
+  using Setpoint = typename Profile::Setpoint;
+  using Handler = std::function<void(const Setpoint&)>;
+
+  FollowProfileCommand(std::shared_ptr<const Profile> profile,
+                       Handler handler);
+  FollowProfileCommand(const llvm::Twine& name,
+                       std::shared_ptr<const Profile> profile,
+                       Handler handler);
+  ~FollowProfileCommand() override = default;
+
+ protected:
+  void Initialize() override;
+  bool IsFinished() override;
+  void End() override;
+
+ private:
+  std::shared_ptr<const Profile> m_profile;
+  ProfileFollower<Profile> m_follower;
+};
+
+}  // namespace frc
+
+#include "Commands/FollowProfileCommand.inc"
@@ -0,0 +1,72 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+
+#include <llvm/Twine.h>
+#include <support/mutex.h>
+
+#include "Commands/Command.h"
+#include "Notifier.h"
+
+namespace frc {
+
+/**
+ * A command with a second execute method, HighRateExecute(), which runs on a
+ * notifier thread at its own rate, for control loops such as path following
+ * that need to run faster than the Scheduler.
+ *
+ * The Scheduler still manages the command as usual: requirements,
+ * interruption, Execute(), IsFinished() and End() all work as for any other
+ * command. HighRateExecute() starts being called after Initialize(), and is
+ * stopped before End() or Interrupted() are called.
+ *
+ * HighRateExecute() is always called with the mutex returned by GetMutex()
+ * held. Lock it in Execute() and the other scheduler-side methods to exchange
+ * setpoints and results with the high-rate loop. To finish from the high-rate
+ * loop, call Finish(); the default IsFinished() returns true once it has been
+ * called.
+ */
+class HighRateCommand : public Command {
+ public:
+  static constexpr double kDefaultPeriod = 0.005;
+
+  explicit HighRateCommand(double period = kDefaultPeriod);
+  HighRateCommand(const llvm::Twine& name, double period = kDefaultPeriod);
+  ~HighRateCommand() override;
+
+  double GetPeriod() const;
+
+ protected:
+  /**
+   * Called every period on the notifier thread while the command runs.
+   */
+  virtual void HighRateExecute() = 0;
+
+  bool IsFinished() override;
+  void Finish();
+  wpi::mutex& GetMutex();
+
+  void _Initialize() override;
+  void _Execute() override;
+  void _Removing() override;
+
+ private:
+  void Run();
+  void Stop();
+
+  double m_period;
+  wpi::mutex m_mutex;
+  bool m_active = false;
+  bool m_started = false;
+  std::atomic_bool m_finished{false};
+  Notifier m_notifier;
+};
+
+}  // namespace frc
@@ -28,9 +28,10 @@ class PIDCommand : public Command, public PIDOutput, public PIDSource {
   PIDCommand(double p, double i, double d);
   PIDCommand(double p, double i, double d, double period);
   PIDCommand(double p, double i, double d, double f, double period);
-  virtual ~PIDCommand() = default;
+  virtual ~PIDCommand();
 
   void SetSetpointRelative(double deltaSetpoint);
+  void SetSynchronous(bool synchronous);
 
   // PIDOutput interface
   void PIDWrite(double output) override;
@@ -36,10 +36,11 @@ class PIDSubsystem : public Subsystem, public PIDOutput, public PIDSource {
   PIDSubsystem(double p, double i, double d);
   PIDSubsystem(double p, double i, double d, double f);
   PIDSubsystem(double p, double i, double d, double f, double period);
-  ~PIDSubsystem() override = default;
+  ~PIDSubsystem() override;
 
   void Enable();
   void Disable();
+  void SetSynchronous(bool synchronous);
 
   // PIDOutput interface
   void PIDWrite(double output) override;
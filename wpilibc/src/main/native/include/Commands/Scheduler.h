@@ -7,8 +7,10 @@
 
 #pragma once
 
+#include <stdint.h>
+
+#include <array>
 #include <memory>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -16,26 +18,55 @@
 #include <support/mutex.h>
 
 #include "Commands/Command.h"
+#include "DriverStation.h"
 #include "ErrorBase.h"
 #include "SmartDashboard/SendableBase.h"
+#include "Watchdog.h"
 
 namespace frc {
 
 class ButtonScheduler;
+class PIDController;
 class Subsystem;
 
 class Scheduler : public ErrorBase, public SendableBase {
  public:
+  /**
+   * Counters and timings of Run(). The times are for the latest iteration, in
+   * seconds.
+   */
+  struct Stats {
+    uint64_t iterations = 0;
+    int runningCommands = 0;
+    int subsystems = 0;
+    double buttonsTime = 0;
+    double subsystemsTime = 0;
+    double controllersTime = 0;
+    double commandsTime = 0;
+    double additionsTime = 0;
+    double defaultsTime = 0;
+    double totalTime = 0;
+    double maxTotalTime = 0;
+  };
+
   static Scheduler* GetInstance();
 
   void AddCommand(Command* command);
   void AddButton(ButtonScheduler* button);
   void RegisterSubsystem(Subsystem* subsystem);
+  void AddController(PIDController* controller);
+  void RemoveController(PIDController* controller);
   void Run();
   void Remove(Command* command);
   void RemoveAll();
   void ResetAll();
   void SetEnabled(bool enabled);
+  void SetDashboardUpdatePeriod(double period);
+  void SetButtonEdgeDetection(bool enabled);
+
+  Stats GetStats() const;
+  void ResetStats();
+  Watchdog& GetWatchdog();
 
   void InitSendable(SendableBuilder& builder) override;
 
@@ -44,16 +75,38 @@ class Scheduler : public ErrorBase, public SendableBase {
   ~Scheduler() override = default;
 
   void ProcessCommandAddition(Command* command);
+  void CompactCommands();
+
+  std::vector<Subsystem*> m_subsystems;
+  // Synchronous PID controllers, updated after the subsystems' Periodic()
+  std::vector<PIDController*> m_controllers;
+  struct ButtonEntry {
+    ButtonScheduler* scheduler;
+    // the joystick button the trigger follows, or -1 if it must be polled
+    int stick = -1;
+    int button = 0;
+    // the trigger state the scheduler last saw, in edge detection mode
+    bool pressed = false;
+  };
+
+  void RunButtons();
 
-  Command::SubsystemSet m_subsystems;
   wpi::mutex m_buttonsMutex;
-  typedef std::vector<ButtonScheduler*> ButtonVector;
+  typedef std::vector<ButtonEntry> ButtonVector;
   ButtonVector m_buttons;
+  bool m_buttonEdgeDetection = false;
+  // the DS packet the joystick buttons were last read from
+  uint64_t m_buttonPacket = 0;
+  std::array<uint32_t, DriverStation::kJoystickPorts> m_stickButtons{};
   typedef std::vector<Command*> CommandVector;
   wpi::mutex m_additionsMutex;
   CommandVector m_additions;
-  typedef std::set<Command*> CommandSet;
-  CommandSet m_commands;
+  // Running commands in the order they were added. Remove() leaves a null
+  // slot while Run() is iterating so indices stay stable; the slots are
+  // compacted once the pass over the commands finishes.
+  CommandVector m_commands;
+  bool m_runningCommands = false;
+  bool m_commandsRemoved = false;
   bool m_adding = false;
   bool m_enabled = true;
   std::vector<std::string> commands;
@@ -63,6 +116,10 @@ class Scheduler : public ErrorBase, public SendableBase {
   nt::NetworkTableEntry m_idsEntry;
   nt::NetworkTableEntry m_cancelEntry;
   bool m_runningCommandsChanged = false;
+  double m_dashboardPeriod = 0.1;
+  double m_lastDashboardUpdate = 0;
+  Stats m_stats;
+  Watchdog m_watchdog;
 };
 
 }  // namespace frc
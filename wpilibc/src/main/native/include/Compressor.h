@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <HAL/Compressor.h>
 #include <HAL/Types.h>
 
 #include "ErrorBase.h"
@@ -53,6 +54,7 @@ class Compressor : public ErrorBase, public SendableBase {
   bool GetCompressorShortedFault() const;
   bool GetCompressorNotConnectedStickyFault() const;
   bool GetCompressorNotConnectedFault() const;
+  HAL_CompressorStatus GetStatus() const;
   void ClearAllPCMStickyFaults();
 
   void InitSendable(SendableBuilder& builder) override;
@@ -0,0 +1,181 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/StringMap.h>
+#include <llvm/StringRef.h>
+#include <support/mutex.h>
+
+#include "ErrorBase.h"
+#include "Notifier.h"
+
+namespace frc {
+
+/**
+ * Read-only configuration constants loaded from a file, without
+ * NetworkTables.
+ *
+ * The file is mapped into memory when the store is constructed. Each key is
+ * looked up once with GetHandle(), after which reading its value with the
+ * handle is an array index and a load from the mapped file, with no locking,
+ * string comparison or allocation, so constants can be read every loop. A
+ * key missing from the file reads as the default passed to the getter.
+ *
+ * Files are written with ConfigStore::Writer, which replaces the file
+ * atomically by writing a temporary file and renaming it over the old one,
+ * so a reader never sees a partly written file. Copy a new file to the robot
+ * the same way, under another name and then renamed over the old one: a file
+ * truncated in place while it is mapped crashes the program when it is read.
+ *
+ * Reload() maps the file again if it changed, and SetReloadPeriod() checks
+ * for changes periodically on a separate thread. Handles stay valid across
+ * reloads. GetGeneration() and AddListener() tell the program the values
+ * changed.
+ *
+ * The file is little endian:
+ *
+ * - Header: the 4 bytes "FRCC", a uint32 format version, a uint32 number of
+ *   entries and a uint32 size of the string pool that follows the entries.
+ * - Entries, sorted by key: a uint32 offset and uint16 length of the key in
+ *   the string pool, a uint8 type (see Type), a uint8 of padding, then 8
+ *   bytes of value: an IEEE double, an int64, an int64 0 or 1 for a boolean,
+ *   or for a string its uint32 offset and uint32 length in the string pool.
+ *
+ * This class is thread safe.
+ */
+class ConfigStore : public ErrorBase {
+  struct Snapshot;
+
+ public:
+  enum Type : uint8_t { kDouble = 1, kInteger = 2, kBoolean = 3, kString = 4 };
+
+  static constexpr uint32_t kVersion = 1;
+
+  /**
+   * A key looked up with GetHandle().
+   */
+  class Handle {
+   public:
+    Handle() = default;
+
+    bool IsValid() const { return m_index >= 0; }
+
+   private:
+    friend class ConfigStore;
+    explicit Handle(int index) : m_index(index) {}
+
+    int m_index = -1;
+  };
+
+  /**
+   * Builds a config file.
+   */
+  class Writer {
+   public:
+    void SetDouble(llvm::StringRef key, double value);
+    void SetInteger(llvm::StringRef key, int64_t value);
+    void SetBoolean(llvm::StringRef key, bool value);
+    void SetString(llvm::StringRef key, llvm::StringRef value);
+
+    bool Write(llvm::StringRef path) const;
+
+   private:
+    struct Value {
+      Type type;
+      double doubleValue;
+      int64_t integerValue;
+      std::string stringValue;
+    };
+
+    std::map<std::string, Value> m_values;
+  };
+
+  explicit ConfigStore(llvm::StringRef path = "/home/lvuser/config.frcc");
+  ~ConfigStore() override;
+
+  ConfigStore(const ConfigStore&) = delete;
+  ConfigStore& operator=(const ConfigStore&) = delete;
+
+  Handle GetHandle(llvm::StringRef key);
+
+  bool Contains(Handle handle) const;
+  double GetDouble(Handle handle, double defaultValue = 0.0) const;
+  int64_t GetInteger(Handle handle, int64_t defaultValue = 0) const;
+  bool GetBoolean(Handle handle, bool defaultValue = false) const;
+  llvm::StringRef GetString(Handle handle,
+                            llvm::StringRef defaultValue = "") const;
+
+  bool Reload();
+  void SetReloadPeriod(double seconds);
+  uint64_t GetGeneration() const;
+
+  int AddListener(std::function<void()> listener);
+  void RemoveListener(int listener);
+
+ private:
+  class Mapping;
+  struct RawEntry;
+
+  struct Snapshot {
+    std::shared_ptr<const Mapping> mapping;
+    // the entry of each handle in the mapping, or null if it has no entry
+    std::vector<const RawEntry*> entries;
+  };
+
+  // Identifies a version of the file; a missing file has a size of -1
+  struct FileId {
+    uint64_t inode;
+    int64_t modified;
+    int64_t size;
+
+    bool operator==(const FileId& other) const {
+      return inode == other.inode && modified == other.modified &&
+             size == other.size;
+    }
+  };
+
+  // The snapshot the entry was found in is returned in snapshotOut
+  const RawEntry* GetEntry(Handle handle,
+                           const Snapshot** snapshotOut = nullptr) const;
+  // Maps the file if it changed since it was last loaded; m_mutex must be held
+  bool Load();
+  // Publishes a snapshot of the mapping for the handles; m_mutex must be held
+  void Publish(std::shared_ptr<const Mapping> mapping);
+  void CheckForChange();
+
+  std::string m_path;
+  // the file last loaded, or tried to be; nothing has this size
+  FileId m_loadedId{0, 0, -2};
+  std::atomic<const Snapshot*> m_snapshot{nullptr};
+  std::atomic<uint64_t> m_generation{0};
+
+  // Held while resolving handles and reloading
+  mutable wpi::mutex m_mutex;
+  std::vector<std::string> m_keys;
+  llvm::StringMap<int> m_handles;
+  // Every snapshot published, so a reader may keep using an old one and the
+  // strings it returned stay valid. Handles are looked up at startup and
+  // reloads are rare, so few are kept.
+  std::vector<std::unique_ptr<Snapshot>> m_snapshots;
+
+  wpi::mutex m_listenerMutex;
+  std::vector<std::function<void()>> m_listeners;
+
+  std::unique_ptr<Notifier> m_reloadNotifier;
+};
+
+}  // namespace frc
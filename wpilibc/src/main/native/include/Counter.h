@@ -39,6 +39,19 @@ class Counter : public SensorBase, public CounterBase {
     kExternalDirection = 3
   };
 
+  /**
+   * Counter state read at a single instant.
+   */
+  struct Snapshot {
+    int count;
+    double period;
+    bool direction;
+    bool stopped;
+    double timestamp;  // FPGA time in seconds the state was read
+  };
+
+  using PulseStatistics = HAL_CounterPulseStatistics;
+
   explicit Counter(Mode mode = kTwoPulse);
   explicit Counter(int channel);
   explicit Counter(DigitalSource* source);
@@ -87,6 +100,14 @@ class Counter : public SensorBase, public CounterBase {
   bool GetStopped() const override;
   bool GetDirection() const override;
 
+  Snapshot GetSnapshot() const;
+
+  void StartPulseStatistics(int windowSize = 256);
+  void StopPulseStatistics();
+  PulseStatistics GetPulseStatistics() const;
+  int GetPulseHistogram(bool widths, double min, double max, int* bins,
+                        int binCount) const;
+
   void SetSamplesToAverage(int samplesToAverage);
   int GetSamplesToAverage() const;
   int GetFPGAIndex() const { return m_index; }
@@ -107,6 +128,8 @@ class Counter : public SensorBase, public CounterBase {
   int m_index = 0;  // The index of this counter.
 
   friend class DigitalGlitchFilter;
+  friend class DMA;
+  friend class DMASample;
 };
 
 }  // namespace frc
@@ -0,0 +1,69 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <HAL/Types.h>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+class AnalogInput;
+class Counter;
+class DigitalSource;
+class DMASample;
+class Encoder;
+
+/**
+ * Captures snapshots of FPGA sensor values with DMA.
+ *
+ * Every source added to a DMA object is latched by the FPGA at the same
+ * instant, either periodically or on an edge of an external trigger. Samples
+ * are buffered by the FPGA, so none are lost between reads as long as the
+ * queue is drained faster than it fills.
+ *
+ * Sources and triggers must be added before StartDMA() is called.
+ */
+class DMA : public ErrorBase {
+  friend class DMASample;
+
+ public:
+  DMA();
+  ~DMA() override;
+
+  DMA(const DMA&) = delete;
+  DMA& operator=(const DMA&) = delete;
+
+  void SetPause(bool pause);
+  void SetRate(int cycles);
+
+  void AddEncoder(const Encoder* encoder);
+  void AddEncoderPeriod(const Encoder* encoder);
+
+  void AddCounter(const Counter* counter);
+  void AddCounterPeriod(const Counter* counter);
+
+  void AddDigitalSource(const DigitalSource* digitalSource);
+
+  void AddAnalogInput(const AnalogInput* analogInput);
+  void AddAveragedAnalogInput(const AnalogInput* analogInput);
+  void AddAnalogAccumulator(const AnalogInput* analogInput);
+
+  void SetExternalTrigger(DigitalSource* source, bool rising, bool falling);
+
+  void StartDMA(int queueDepth);
+  void StopDMA();
+
+  int ReadSamples(DMASample* samples, int count, double timeoutSeconds,
+                  int32_t* remaining);
+
+ private:
+  HAL_DMAHandle dmaHandle = HAL_kInvalidHandle;
+};
+
+}  // namespace frc
@@ -0,0 +1,60 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <HAL/DMA.h>
+
+namespace frc {
+
+class AnalogInput;
+class Counter;
+class DigitalSource;
+class DMA;
+class Encoder;
+
+/**
+ * A single capture from a DMA object.
+ *
+ * The getters take the same source that was added to the DMA object and
+ * return the value it had when the sample was latched. Passing a source that
+ * was not added sets status to an error.
+ */
+class DMASample : public HAL_DMASample {
+ public:
+  HAL_DMAReadStatus Update(const DMA* dma, double timeoutSeconds,
+                           int32_t* remaining, int32_t* status);
+
+  uint64_t GetTime() const;
+  double GetTimeStamp() const;
+
+  int32_t GetEncoderRaw(const Encoder* encoder, int32_t* status) const;
+  double GetEncoderDistance(const Encoder* encoder, int32_t* status) const;
+  int32_t GetEncoderPeriodRaw(const Encoder* encoder, int32_t* status) const;
+
+  int32_t GetCounter(const Counter* counter, int32_t* status) const;
+  int32_t GetCounterPeriod(const Counter* counter, int32_t* status) const;
+
+  bool GetDigitalSource(const DigitalSource* digitalSource,
+                        int32_t* status) const;
+
+  int32_t GetAnalogInputRaw(const AnalogInput* analogInput,
+                            int32_t* status) const;
+  double GetAnalogInputVoltage(const AnalogInput* analogInput,
+                               int32_t* status) const;
+  int32_t GetAveragedAnalogInputRaw(const AnalogInput* analogInput,
+                                    int32_t* status) const;
+  double GetAveragedAnalogInputVoltage(const AnalogInput* analogInput,
+                                       int32_t* status) const;
+
+  void GetAnalogAccumulator(const AnalogInput* analogInput, int64_t* count,
+                            int64_t* value, int32_t* status) const;
+};
+
+}  // namespace frc
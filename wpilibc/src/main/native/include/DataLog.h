@@ -0,0 +1,247 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <llvm/ArrayRef.h>
+#include <llvm/StringRef.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+/**
+ * Logs timestamped values to binary files on the robot.
+ *
+ * Values are appended to typed entries (DoubleLogEntry, IntegerLogEntry and
+ * BooleanLogEntry), which are created once with a name. Appending never
+ * allocates or takes a lock after the first append from a thread: each thread
+ * fills its own ring buffer, which a background thread drains to the file
+ * every kWritePeriod. If a buffer fills up before it is drained, the values
+ * that don't fit are dropped and counted.
+ *
+ * A new file is started in the log directory when the current one reaches
+ * the maximum file size. Each file starts with the 8 byte header "FRCLOG"
+ * followed by the format version as a uint16, then holds a sequence of
+ * records, with fixed size integers little endian and varints in LEB128:
+ *
+ * - Entry start: uint8 0, uint16 entry id, uint8 type (see Type), uint8 name
+ *   length and the name. Every entry is started in each file before its
+ *   first value.
+ * - Block: uint8 2, uint16 entry id, varint value count, varint payload size
+ *   and the payload, which holds the timestamps of the values and then the
+ *   values themselves.
+ *
+ * The writer thread packs the values each entry got in a write period into
+ * one block, encoding each column against the values before it in the same
+ * file (all zero at the start of a file):
+ *
+ * - Timestamps (FPGA time in microseconds) as zigzag varints of the change
+ *   in the interval between values, which is 0 for a steady sample rate.
+ * - Doubles XORed with the previous value, as a bit stream padded to a whole
+ *   byte: bit 0 for an unchanged value; bits 10 followed by the XOR within
+ *   the significant bits of the last value written with 11; or bits 11, the
+ *   number of leading zeros (6 bits), the number of significant bits minus 1
+ *   (6 bits) and the significant bits of the XOR.
+ * - Integers as runs of equal differences from the previous value: a varint
+ *   run length and a zigzag varint difference for each run.
+ * - Booleans as runs of equal values: uint8 first value, then varint run
+ *   lengths of alternating values.
+ *
+ * Blocks of an entry are in order, but blocks of different entries, and
+ * values appended from different threads to one entry, may be out of
+ * timestamp order.
+ */
+class DataLog : public ErrorBase {
+ public:
+  enum Type : uint8_t { kDouble = 0, kInteger = 1, kBoolean = 2 };
+
+  static constexpr uint16_t kVersion = 2;
+  static constexpr double kWritePeriod = 0.05;
+  static constexpr uint64_t kDefaultMaxFileSize = 64 * 1024 * 1024;
+  // Values each thread can buffer between writes
+  static constexpr size_t kBufferSize = 16384;
+
+  /**
+   * Receives the entries and values of the log on the writer thread, as they
+   * are written out, e.g. to stream them off the robot.
+   */
+  class Listener {
+   public:
+    virtual ~Listener() = default;
+
+    // Called once for each entry before its first values, in id order
+    virtual void EntryStarted(int entry, llvm::StringRef name, Type type) = 0;
+    // Called with the values each entry got in a write period
+    virtual void ValuesWritten(int entry, Type type,
+                               llvm::ArrayRef<uint64_t> timestamps,
+                               llvm::ArrayRef<uint64_t> values) = 0;
+    // Called at the end of each write period
+    virtual void PeriodEnded() = 0;
+  };
+
+  // The values a column is encoded against; all zero at the start of a file
+  struct EncoderState {
+    uint64_t lastTimestamp = 0;
+    int64_t lastInterval = 0;
+    uint64_t lastValue = 0;
+  };
+
+  static DataLog& GetInstance();
+
+  static void EncodeBlock(int entry, Type type,
+                          llvm::ArrayRef<uint64_t> timestamps,
+                          llvm::ArrayRef<uint64_t> values,
+                          EncoderState& state, std::vector<uint8_t>& data);
+
+  ~DataLog() override;
+
+  DataLog(const DataLog&) = delete;
+  DataLog& operator=(const DataLog&) = delete;
+
+  void Start(llvm::StringRef directory = "/home/lvuser",
+             uint64_t maxFileSize = kDefaultMaxFileSize);
+  void Stop();
+  bool IsRunning() const;
+
+  uint64_t GetDroppedCount() const;
+
+  void AddListener(Listener* listener);
+  void RemoveListener(Listener* listener);
+
+ private:
+  friend class DataLogEntry;
+
+  struct Record {
+    uint16_t entry;
+    uint64_t timestamp;
+    uint64_t value;
+  };
+
+  // A single producer, single consumer ring of records
+  struct Buffer {
+    std::unique_ptr<Record[]> records{new Record[kBufferSize]};
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+    // cleared when the thread owning it exits, so another can take it
+    std::atomic<bool> inUse{true};
+  };
+
+  // The buffer of the calling thread, given up when it exits
+  struct ThreadBuffer {
+    ~ThreadBuffer();
+    std::shared_ptr<Buffer> buffer;
+  };
+
+  struct EntryInfo {
+    std::string name;
+    Type type;
+  };
+
+  // The values of an entry drained in a write period
+  struct Column {
+    std::vector<uint64_t> timestamps;
+    std::vector<uint64_t> values;
+    EncoderState state;
+  };
+
+  DataLog() = default;
+
+  int StartEntry(llvm::StringRef name, Type type);
+  void Append(int entry, uint64_t value, uint64_t timestamp);
+  Buffer* GetThreadBuffer();
+
+  void ThreadMain();
+  // m_mutex must not be held by these
+  void WriteData();
+  void Flush();
+  void OpenFile();
+  void CloseFile();
+
+  std::atomic<bool> m_running{false};
+  std::atomic<uint64_t> m_dropped{0};
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::thread m_thread;
+  bool m_stop = false;
+  std::string m_directory;
+  uint64_t m_maxFileSize = kDefaultMaxFileSize;
+  std::vector<EntryInfo> m_entries;
+  // shared with the thread each belongs to, which may outlive the log
+  std::vector<std::shared_ptr<Buffer>> m_buffers;
+
+  // Listeners are called with m_listenerMutex held, so removing one waits
+  // for its callbacks to return. New listeners are told about the entries
+  // started so far by the writer thread, before they are called otherwise.
+  wpi::mutex m_listenerMutex;
+  std::vector<Listener*> m_listeners;
+  std::vector<Listener*> m_newListeners;
+
+  // Only used by the writer thread
+  std::FILE* m_file = nullptr;
+  uint64_t m_fileSize = 0;
+  int m_fileIndex = 0;
+  // the entries started so far, which are started again in each new file
+  std::vector<EntryInfo> m_written;
+  std::vector<Column> m_columns;
+  std::vector<uint8_t> m_data;
+};
+
+/**
+ * A named series of values in the DataLog.
+ */
+class DataLogEntry {
+ public:
+  int GetId() const { return m_id; }
+
+ protected:
+  DataLogEntry(llvm::StringRef name, DataLog::Type type);
+
+  void AppendBits(uint64_t value, uint64_t timestamp);
+  void AppendBits(uint64_t value);
+
+ private:
+  int m_id;
+};
+
+class DoubleLogEntry : public DataLogEntry {
+ public:
+  explicit DoubleLogEntry(llvm::StringRef name);
+
+  void Append(double value);
+  void Append(double value, uint64_t timestamp);
+};
+
+class IntegerLogEntry : public DataLogEntry {
+ public:
+  explicit IntegerLogEntry(llvm::StringRef name);
+
+  void Append(int64_t value);
+  void Append(int64_t value, uint64_t timestamp);
+};
+
+class BooleanLogEntry : public DataLogEntry {
+ public:
+  explicit BooleanLogEntry(llvm::StringRef name);
+
+  void Append(bool value);
+  void Append(bool value, uint64_t timestamp);
+};
+
+}  // namespace frc
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "DigitalSource.h"
+#include "ReadCache.h"
 
 namespace frc {
 
@@ -39,6 +40,7 @@ class DigitalInput : public DigitalSource {
  private:
   int m_channel;
   HAL_DigitalHandle m_handle;
+  CachedRead<bool> m_valueCache;
 
   friend class DigitalGlitchFilter;
 };
@@ -0,0 +1,44 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+class DigitalInput;
+
+/**
+ * Reads a group of digital inputs together.
+ *
+ * Each DigitalInput::Get() reads the whole DIO register to extract one bit.
+ * A DigitalInputGroup reads every channel once per Update() and serves the
+ * inputs of the group from that sample.
+ */
+class DigitalInputGroup : public ErrorBase {
+ public:
+  DigitalInputGroup() = default;
+
+  int Add(const DigitalInput& input);
+
+  void Update();
+  bool Get(int index) const;
+  uint32_t GetValues() const;
+  double GetTimestamp() const;
+
+ private:
+  std::vector<int> m_channels;
+  uint32_t m_values = 0;
+  uint64_t m_timestamp = 0;
+};
+
+}  // namespace frc
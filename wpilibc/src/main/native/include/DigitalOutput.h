@@ -8,6 +8,7 @@
 #pragma once
 
 #include <HAL/Types.h>
+#include <llvm/ArrayRef.h>
 
 #include "ErrorBase.h"
 #include "SmartDashboard/SendableBase.h"
@@ -34,10 +35,14 @@ class DigitalOutput : public ErrorBase, public SendableBase {
   void EnablePWM(double initialDutyCycle);
   void DisablePWM();
   void UpdateDutyCycle(double dutyCycle);
+  static void UpdateDutyCycles(llvm::ArrayRef<DigitalOutput*> outputs,
+                               llvm::ArrayRef<double> dutyCycles);
 
   void InitSendable(SendableBuilder& builder) override;
 
  private:
+  friend class Waveform;
+
   int m_channel;
   HAL_DigitalHandle m_handle;
   HAL_DigitalPWMHandle m_pwmGenerator;
@@ -0,0 +1,43 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+class DigitalOutput;
+
+/**
+ * Writes a group of digital outputs together.
+ *
+ * Each DigitalOutput::Set() is a read-modify-write of the DIO register. A
+ * DigitalOutputGroup stages the values of its outputs and writes all of them
+ * with one register update per Update().
+ */
+class DigitalOutputGroup : public ErrorBase {
+ public:
+  DigitalOutputGroup() = default;
+
+  int Add(const DigitalOutput& output);
+
+  void Set(int index, bool value);
+  void SetValues(uint32_t values);
+  void Update();
+
+ private:
+  std::vector<int> m_channels;
+  uint32_t m_mask = 0;
+  uint32_t m_values = 0;
+};
+
+}  // namespace frc
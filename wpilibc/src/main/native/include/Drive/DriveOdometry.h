@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include "Drive/Kinematics.h"
+#include "Encoder.h"
+
+namespace frc {
+
+/**
+ * A robot pose on the field: its position and its heading in radians,
+ * counterclockwise from the field x axis.
+ */
+struct RobotPose {
+  double x = 0;
+  double y = 0;
+  double heading = 0;
+};
+
+/**
+ * Tracks the robot pose by integrating displacements measured in the robot
+ * frame.
+ *
+ * Each displacement is integrated as a constant curvature arc rather than a
+ * straight line, which keeps the pose accurate at low update rates. The
+ * odometry is not locked; update and read it from one thread, such as a
+ * Notifier running the drive control loop.
+ */
+class DriveOdometry {
+ public:
+  explicit DriveOdometry(const RobotPose& pose = RobotPose{});
+
+  void Reset(const RobotPose& pose);
+  const RobotPose& GetPose() const;
+
+  const RobotPose& Update(const ChassisSpeeds& displacement);
+  const RobotPose& Update(const ChassisSpeeds& displacement, double heading);
+
+ private:
+  RobotPose m_pose;
+};
+
+/**
+ * Odometry for a drive whose wheels are measured by encoders.
+ *
+ * Update() takes an Encoder::Snapshot of each wheel, in the wheel order of
+ * the kinematics, and integrates the change in distance since the previous
+ * call. The encoders' distance per pulse must be set so their distances are
+ * in the same units as the kinematics.
+ */
+template <typename Kinematics>
+class EncoderOdometry : public DriveOdometry {
+ public:
+  using Snapshots = std::array<Encoder::Snapshot, Kinematics::kWheels>;
+
+  explicit EncoderOdometry(const Kinematics& kinematics,
+                           const RobotPose& pose = RobotPose{});
+
+  void Reset(const RobotPose& pose);
+
+  const RobotPose& Update(const Snapshots& snapshots);
+  const RobotPose& Update(const Snapshots& snapshots, double heading);
+
+  const ChassisSpeeds& GetVelocity() const;
+
+ private:
+  // Returns the displacement since the previous snapshots, and records them
+  ChassisSpeeds Measure(const Snapshots& snapshots);
+
+  Kinematics m_kinematics;
+  bool m_haveDistances = false;
+  std::array<double, Kinematics::kWheels> m_distances;
+  ChassisSpeeds m_velocity;
+};
+
+}  // namespace frc
+
+#include "Drive/DriveOdometry.inc"
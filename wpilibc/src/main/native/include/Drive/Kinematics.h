@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include <llvm/ArrayRef.h>
+
+#include "Drive/Vector2d.h"
+
+namespace frc {
+
+/**
+ * The velocity of a robot in its own frame: x is forward, y is to the left,
+ * and omega is counterclockwise in radians per second.
+ *
+ * Because kinematics are linear, the same struct also holds a displacement
+ * (distances and an angle in radians) when wheel distances are converted
+ * instead of wheel speeds.
+ */
+struct ChassisSpeeds {
+  ChassisSpeeds() = default;
+  ChassisSpeeds(double vx, double vy, double omega)
+      : vx(vx), vy(vy), omega(omega) {}
+
+  double vx = 0;
+  double vy = 0;
+  double omega = 0;
+};
+
+void DesaturateWheelSpeeds(llvm::MutableArrayRef<double> wheelSpeeds,
+                           double maxSpeed);
+
+/**
+ * Kinematics for a differential (tank) drive. Wheel speeds are ordered
+ * kLeft, kRight.
+ *
+ * The kinematics classes are plain math with no motor or sensor access, so
+ * they can be used from any thread, including high-rate control loops.
+ */
+class DifferentialDriveKinematics {
+ public:
+  static constexpr size_t kWheels = 2;
+  using WheelSpeeds = std::array<double, kWheels>;
+
+  explicit DifferentialDriveKinematics(double trackWidth);
+
+  WheelSpeeds ToWheelSpeeds(const ChassisSpeeds& speeds) const;
+  ChassisSpeeds ToChassisSpeeds(const WheelSpeeds& wheelSpeeds) const;
+
+  double GetTrackWidth() const;
+
+ private:
+  double m_trackWidth;
+};
+
+/**
+ * Kinematics for a mecanum drive with the rollers of each wheel at 45
+ * degrees, in an X pattern when viewed from above. Wheel speeds are ordered
+ * kFrontLeft, kFrontRight, kRearLeft, kRearRight.
+ */
+class MecanumDriveKinematics {
+ public:
+  static constexpr size_t kWheels = 4;
+  using WheelSpeeds = std::array<double, kWheels>;
+
+  MecanumDriveKinematics(double trackWidth, double wheelBase);
+
+  WheelSpeeds ToWheelSpeeds(const ChassisSpeeds& speeds) const;
+  ChassisSpeeds ToChassisSpeeds(const WheelSpeeds& wheelSpeeds) const;
+
+ private:
+  // half the track width plus half the wheel base
+  double m_rotationScale;
+};
+
+/**
+ * Kinematics for a Killough (three omni wheel) drive. Wheel speeds are
+ * ordered kLeft, kRight, kBack.
+ */
+class KilloughDriveKinematics {
+ public:
+  static constexpr size_t kWheels = 3;
+  using WheelSpeeds = std::array<double, kWheels>;
+
+  explicit KilloughDriveKinematics(double radius);
+  KilloughDriveKinematics(const std::array<Vector2d, kWheels>& positions,
+                          const std::array<double, kWheels>& wheelAngles);
+
+  WheelSpeeds ToWheelSpeeds(const ChassisSpeeds& speeds) const;
+  ChassisSpeeds ToChassisSpeeds(const WheelSpeeds& wheelSpeeds) const;
+
+ private:
+  // each wheel's speed for unit vx, vy and omega
+  double m_inverse[kWheels][3];
+  double m_forward[3][kWheels];
+};
+
+namespace detail {
+// Computes the least squares solution matrix (A^T A)^-1 A^T, 3 by rows, of
+// the rows by 3 matrix A. Returns false if A does not have full rank.
+bool PseudoInverse(const double* a, size_t rows, double* result);
+}  // namespace detail
+
+}  // namespace frc
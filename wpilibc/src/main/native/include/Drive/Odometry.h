@@ -0,0 +1,122 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include <support/mutex.h>
+
+#include "Drive/DriveOdometry.h"
+#include "Drive/Kinematics.h"
+#include "Encoder.h"
+#include "ErrorBase.h"
+#include "Internal/SeqLock.h"
+#include "Notifier.h"
+#include "interfaces/Gyro.h"
+
+namespace frc {
+
+/**
+ * Tracks the robot pose on its own Notifier and keeps a history of recent
+ * poses.
+ *
+ * Each period the odometry takes a snapshot of the drive encoders and,
+ * optionally, a gyro, integrates the motion since the previous period, and
+ * records the pose with the encoder timestamp. GetPose() and GetPoseAt() read
+ * without locking, so the main robot thread never waits on the odometry
+ * thread. GetPoseAt() interpolates within the history, which is long enough
+ * to compensate vision measurements for their latency.
+ */
+class Odometry : public ErrorBase {
+ public:
+  static constexpr double kDefaultPeriod = 0.005;
+  // About 1.3 seconds at the default period
+  static constexpr size_t kHistorySize = 256;
+
+  /**
+   * The motion measured in one period.
+   */
+  struct Measurement {
+    // The motion since the previous measurement, in the robot frame
+    ChassisSpeeds displacement;
+    // The current velocity, in the robot frame
+    ChassisSpeeds velocity;
+    // The heading from a gyro in radians, counterclockwise; any offset is
+    // removed by Reset()
+    double heading = 0;
+    bool hasHeading = false;
+    // FPGA time in seconds the measurement was taken
+    double timestamp = 0;
+  };
+
+  using Source = std::function<Measurement()>;
+
+  explicit Odometry(Source source, double period = kDefaultPeriod);
+  Odometry(Encoder& leftEncoder, Encoder& rightEncoder, double trackWidth,
+           Gyro* gyro = nullptr, double period = kDefaultPeriod);
+  template <typename Kinematics>
+  Odometry(const Kinematics& kinematics,
+           const std::array<Encoder*, Kinematics::kWheels>& encoders,
+           Gyro* gyro = nullptr, double period = kDefaultPeriod);
+  ~Odometry() override;
+
+  Odometry(const Odometry&) = delete;
+  Odometry& operator=(const Odometry&) = delete;
+
+  void Reset(const RobotPose& pose = RobotPose{});
+
+  RobotPose GetPose() const;
+  ChassisSpeeds GetVelocity() const;
+  double GetTimestamp() const;
+  RobotPose GetPoseAt(double timestamp) const;
+
+  double GetPeriod() const;
+
+ private:
+  struct Sample {
+    double timestamp;
+    RobotPose pose;
+    ChassisSpeeds velocity;
+  };
+
+  // Measures the motion of a drive from an encoder on each wheel
+  template <typename Kinematics>
+  class EncoderSource;
+
+  // Returns the heading a gyro reads, in radians counterclockwise
+  static double GyroHeading(const Gyro& gyro);
+
+  void Update();
+
+  Source m_source;
+  double m_period;
+
+  // held by Update() and Reset()
+  wpi::mutex m_updateMutex;
+  DriveOdometry m_odometry;
+  double m_headingOffset = 0;
+  double m_lastHeading = 0;
+  bool m_resetHeading = true;
+
+  SeqLock<Sample> m_latest;
+  std::array<SeqLock<Sample>, kHistorySize> m_history;
+  // the number of samples written to m_history since the last reset
+  std::atomic<uint64_t> m_count{0};
+
+  std::unique_ptr<Notifier> m_notifier;
+};
+
+}  // namespace frc
+
+#include "Drive/Odometry.inc"
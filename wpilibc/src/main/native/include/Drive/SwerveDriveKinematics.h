@@ -0,0 +1,54 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include "Drive/Kinematics.h"
+#include "Drive/Vector2d.h"
+
+namespace frc {
+
+/**
+ * The state of one swerve module: its wheel speed, and the direction it
+ * points in radians, counterclockwise from the robot's forward direction.
+ */
+struct SwerveModuleState {
+  double speed = 0;
+  double angle = 0;
+};
+
+/**
+ * Kinematics for a swerve drive with NumModules modules.
+ *
+ * Module positions are relative to the robot's center of rotation, with x
+ * forward and y to the left. ToChassisSpeeds() is the least squares fit of
+ * the chassis velocity to all of the module states.
+ */
+template <size_t NumModules>
+class SwerveDriveKinematics {
+ public:
+  static constexpr size_t kWheels = NumModules;
+  using WheelSpeeds = std::array<SwerveModuleState, NumModules>;
+
+  explicit SwerveDriveKinematics(
+      const std::array<Vector2d, NumModules>& positions);
+
+  WheelSpeeds ToModuleStates(const ChassisSpeeds& speeds) const;
+  ChassisSpeeds ToChassisSpeeds(const WheelSpeeds& moduleStates) const;
+
+ private:
+  std::array<Vector2d, NumModules> m_positions;
+  double m_forward[3][2 * NumModules];
+};
+
+}  // namespace frc
+
+#include "Drive/SwerveDriveKinematics.inc"
@@ -12,8 +12,10 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <HAL/DriverStation.h>
+#include <llvm/StringRef.h>
 #include <llvm/Twine.h>
 #include <support/condition_variable.h>
 #include <support/deprecated.h>
@@ -26,6 +28,7 @@ namespace frc {
 
 struct MatchInfoData;
 class MatchDataSender;
+class DriverStationLog;
 
 /**
  * Provide access to the network communication data to / from the Driver
@@ -38,13 +41,53 @@ class DriverStation : public ErrorBase, public RobotStateInterface {
 
   ~DriverStation() override;
   static DriverStation& GetInstance();
+  // These queue the message for a background thread and return; repeats
+  // within a second and sources over their rate limit are dropped, as for
+  // ReportErrorAsync(). The five argument ReportError() sends synchronously.
   static void ReportError(const llvm::Twine& error);
   static void ReportWarning(const llvm::Twine& error);
   static void ReportError(bool isError, int code, const llvm::Twine& error,
                           const llvm::Twine& location,
                           const llvm::Twine& stack);
+  static void ReportErrorAsync(bool isError, int code,
+                               const llvm::Twine& error,
+                               const llvm::Twine& location,
+                               int stackOffset = -1);
+  static void ReportErrorAsync(bool isError, int code,
+                               const llvm::Twine& error,
+                               const llvm::Twine& location,
+                               void* const* stackFrames, int stackFrameCount);
+  static int64_t GetDroppedErrorCount();
+
+  /**
+   * Counts of the messages reported to the DS since the program started.
+   */
+  struct ErrorReportCounts {
+    int64_t sent = 0;
+    // repeats of a message within a second
+    int64_t repeats = 0;
+    // from a source reporting faster than its rate limit
+    int64_t rateLimited = 0;
+    // with the queue full, or for warnings nearly full
+    int64_t droppedErrors = 0;
+    int64_t droppedWarnings = 0;
+  };
+  static ErrorReportCounts GetErrorReportCounts();
 
   static constexpr int kJoystickPorts = 6;
+  static constexpr int kPacketHistorySize = 16;
+
+  /**
+   * Joystick and control data from one Driver Station packet.
+   */
+  struct JoystickState {
+    uint64_t packetNumber = 0;
+    double timestamp = 0;  // FPGA time in seconds the packet was processed
+    HAL_ControlWord controlWord;
+    std::array<HAL_JoystickAxes, kJoystickPorts> axes;
+    std::array<HAL_JoystickPOVs, kJoystickPorts> povs;
+    std::array<HAL_JoystickButtons, kJoystickPorts> buttons;
+  };
 
   bool GetStickButton(int stick, int button);
   bool GetStickButtonPressed(int stick, int button);
@@ -63,6 +106,10 @@ class DriverStation : public ErrorBase, public RobotStateInterface {
   std::string GetJoystickName(int stick) const;
   int GetJoystickAxisType(int stick, int axis) const;
 
+  JoystickState GetJoystickState() const;
+  int GetJoystickStateHistory(JoystickState* states, int count) const;
+  uint64_t GetPacketNumber() const;
+
   bool IsEnabled() const override;
   bool IsDisabled() const override;
   bool IsAutonomous() const override;
@@ -78,6 +125,8 @@ class DriverStation : public ErrorBase, public RobotStateInterface {
 
   std::string GetGameSpecificMessage() const;
   std::string GetEventName() const;
+  llvm::StringRef GetGameSpecificMessageRef() const;
+  llvm::StringRef GetEventNameRef() const;
   MatchType GetMatchType() const;
   int GetMatchNumber() const;
   int GetReplayNumber() const;
@@ -133,24 +182,53 @@ class DriverStation : public ErrorBase, public RobotStateInterface {
   void ReportJoystickUnpluggedError(const llvm::Twine& message);
   void ReportJoystickUnpluggedWarning(const llvm::Twine& message);
   void Run();
-  void UpdateControlWord(bool force, HAL_ControlWord& controlWord) const;
+  void UpdateControlWord();
+  void UpdateMatchInfo();
+  HAL_ControlWord GetControlWord() const;
   void SendMatchData();
+  void PublishJoystickState(const HAL_ControlWord& controlWord);
+
+  // Run read on the newest published packet; read may be called again if the
+  // packet is overwritten while it runs, so it must not have side effects
+  template <typename F>
+  void ReadLatest(F&& read) const;
 
   // Joystick User Data
   std::unique_ptr<HAL_JoystickAxes[]> m_joystickAxes;
   std::unique_ptr<HAL_JoystickPOVs[]> m_joystickPOVs;
   std::unique_ptr<HAL_JoystickButtons[]> m_joystickButtons;
   std::unique_ptr<HAL_JoystickDescriptor[]> m_joystickDescriptor;
-  std::unique_ptr<MatchInfoData> m_matchInfo;
 
   // Joystick Cached Data
   std::unique_ptr<HAL_JoystickAxes[]> m_joystickAxesCache;
   std::unique_ptr<HAL_JoystickPOVs[]> m_joystickPOVsCache;
   std::unique_ptr<HAL_JoystickButtons[]> m_joystickButtonsCache;
   std::unique_ptr<HAL_JoystickDescriptor[]> m_joystickDescriptorCache;
-  std::unique_ptr<MatchInfoData> m_matchInfoCache;
+
+  // The current match info. A new snapshot is published only when the DS
+  // sends different match info, and snapshots are never freed, so the strings
+  // returned by GetEventNameRef() and GetGameSpecificMessageRef() stay valid.
+  std::atomic<const MatchInfoData*> m_matchInfo{nullptr};
+  // Owns every snapshot; only used by the DS thread
+  std::vector<std::unique_ptr<MatchInfoData>> m_matchInfoHistory;
+  // The match info last read from the HAL; only used by the DS thread
+  HAL_InlineMatchInfo m_lastMatchInfo;
+  // The snapshot last sent to NetworkTables; only used by the DS thread
+  const MatchInfoData* m_sentMatchInfo = nullptr;
 
   std::unique_ptr<MatchDataSender> m_matchDataSender;
+  // Logs each packet while device logging is enabled
+  std::unique_ptr<DriverStationLog> m_deviceLog;
+
+  // History of the last packets, written only by the DS thread. Each slot is
+  // a seqlock: its sequence is odd while being written and 2 * packetNumber
+  // once complete, so readers never need m_cacheDataMutex.
+  struct JoystickStateSlot {
+    std::atomic<uint64_t> sequence{0};
+    JoystickState state;
+  };
+  std::array<JoystickStateSlot, kPacketHistorySize> m_joystickStates;
+  std::atomic<uint64_t> m_packetNumber{0};
 
   // Joystick button rising/falling edge flags
   std::array<uint32_t, kJoystickPorts> m_joystickButtonsPressed;
@@ -164,6 +242,8 @@ class DriverStation : public ErrorBase, public RobotStateInterface {
   wpi::condition_variable m_waitForDataCond;
   int m_waitForDataCounter;
 
+  // Guards the button edge flags; taken by the DS thread and robot loops, so
+  // it inherits priority
   mutable wpi::mutex m_cacheDataMutex;
 
   // Robot state status variables
@@ -172,10 +252,8 @@ class DriverStation : public ErrorBase, public RobotStateInterface {
   bool m_userInTeleop = false;
   bool m_userInTest = false;
 
-  // Control word variables
-  mutable HAL_ControlWord m_controlWordCache;
-  mutable std::chrono::steady_clock::time_point m_lastControlWordUpdate;
-  mutable wpi::mutex m_controlWordMutex;
+  // The HAL_ControlWord bits, published by the DS thread
+  std::atomic<uint32_t> m_controlWord{0};
 
   double m_nextMessageTime = 0;
 };
@@ -13,8 +13,11 @@
 
 #include "Counter.h"
 #include "CounterBase.h"
+#include "Internal/DeviceLog.h"
 #include "PIDSource.h"
+#include "ReadCache.h"
 #include "SensorBase.h"
+#include "Units.h"
 
 namespace frc {
 
@@ -45,6 +48,29 @@ class Encoder : public SensorBase, public CounterBase, public PIDSource {
     kResetOnRisingEdge
   };
 
+  /**
+   * How the rate is computed; see SetVelocityEstimator().
+   */
+  enum VelocityEstimator {
+    kPeriod = HAL_EncoderVelocity_kPeriod,
+    kTimedWindow = HAL_EncoderVelocity_kTimedWindow,
+    kLeastSquares = HAL_EncoderVelocity_kLeastSquares,
+    kAdaptiveWindow = HAL_EncoderVelocity_kAdaptiveWindow
+  };
+
+  /**
+   * Encoder state read at a single instant.
+   */
+  struct Snapshot {
+    int count;
+    double distance;
+    double rate;
+    double period;
+    bool direction;
+    bool stopped;
+    double timestamp;  // FPGA time in seconds the state was read
+  };
+
   Encoder(int aChannel, int bChannel, bool reverseDirection = false,
           EncodingType encodingType = k4X);
   Encoder(std::shared_ptr<DigitalSource> aSource,
@@ -70,12 +96,21 @@ class Encoder : public SensorBase, public CounterBase, public PIDSource {
   double GetRate() const;
   void SetMinRate(double minRate);
   void SetDistancePerPulse(double distancePerPulse);
+  // Distances and rates are then in meters and meters per second
+  void SetDistancePerPulse(units::meter_t distancePerPulse) {
+    SetDistancePerPulse(distancePerPulse.value());
+  }
   double GetDistancePerPulse() const;
   void SetReverseDirection(bool reverseDirection);
   void SetSamplesToAverage(int samplesToAverage);
   int GetSamplesToAverage() const;
+  void SetVelocityEstimator(VelocityEstimator estimator, int windowSize = 8);
+  double GetAcceleration() const;
+  static void SetVelocityUpdatePeriod(double period);
   double PIDGet(PIDSourceType pidSource) override;
 
+  Snapshot GetSnapshot() const;
+
   void SetIndexSource(int channel, IndexingType type = kResetOnRisingEdge);
   void SetIndexSource(const DigitalSource& source,
                       IndexingType type = kResetOnRisingEdge);
@@ -88,13 +123,25 @@ class Encoder : public SensorBase, public CounterBase, public PIDSource {
   void InitEncoder(bool reverseDirection, EncodingType encodingType);
 
   double DecodingScaleFactor() const;
+  HAL_EncoderSnapshot GetCachedSnapshot() const;
+  void InvalidateReadCache();
 
   std::shared_ptr<DigitalSource> m_aSource;  // The A phase of the quad encoder
   std::shared_ptr<DigitalSource> m_bSource;  // The B phase of the quad encoder
   std::shared_ptr<DigitalSource> m_indexSource = nullptr;
   HAL_EncoderHandle m_encoder = HAL_kInvalidHandle;
 
+  mutable DeviceLogSignal<IntegerLogEntry> m_countLog;
+  mutable DeviceLogSignal<DoubleLogEntry> m_distanceLog;
+  mutable DeviceLogSignal<DoubleLogEntry> m_rateLog;
+
+  // Reads latched once per loop by the ReadCache
+  CachedRead<HAL_EncoderSnapshot> m_snapshotCache;
+  CachedRead<double> m_rateCache;
+
   friend class DigitalGlitchFilter;
+  friend class DMA;
+  friend class DMASample;
 };
 
 }  // namespace frc
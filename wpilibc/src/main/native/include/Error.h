@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <string>
 
 #include <llvm/StringRef.h>
@@ -46,6 +47,7 @@ class Error {
   int GetLineNumber() const;
   const ErrorBase* GetOriginatingObject() const;
   double GetTimestamp() const;
+  std::string GetStackTrace() const;
   void Clear();
   void Set(Code code, const llvm::Twine& contextMessage,
            llvm::StringRef filename, llvm::StringRef function, int lineNumber,
@@ -54,13 +56,21 @@ class Error {
  private:
   void Report();
 
-  Code m_code = 0;
+  static constexpr int kMaxStackFrames = 32;
+
+  // Atomic so the global error can be checked without a lock
+  std::atomic<Code> m_code{0};
   std::string m_message;
   std::string m_filename;
   std::string m_function;
   int m_lineNumber = 0;
   const ErrorBase* m_originatingObject = nullptr;
   double m_timestamp = 0.0;
+
+  // Return addresses of the stack when the error was last reported, only
+  // symbolized when the trace is printed
+  void* m_stackFrames[kMaxStackFrames];
+  int m_stackFrameCount = 0;
 };
 
 }  // namespace frc
@@ -114,6 +114,8 @@ class ErrorBase {
   static Error& GetGlobalError();
 
  protected:
+  static void CloneToGlobalError(const Error& error);
+
   mutable Error m_error;
 
   // TODO: Replace globalError with a global list of all errors.
@@ -0,0 +1,215 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+namespace frc {
+
+class Executor;
+
+namespace detail {
+
+// Stands in for the value of a Future<void>
+struct Unit {};
+
+template <typename T>
+struct FutureStorage {
+  using type = T;
+};
+
+template <>
+struct FutureStorage<void> {
+  using type = Unit;
+};
+
+/**
+ * The state shared by a Future and the task completing it.
+ */
+template <typename T>
+class FutureState {
+ public:
+  using Value = typename FutureStorage<T>::type;
+
+  void SetValue(Value value);
+  // Completes the state with an exception, which Wait() rethrows
+  void SetException(std::exception_ptr exception);
+  bool IsReady() const;
+  Value& Wait();
+  // Runs continuation once the value is set, right away if it already is
+  void AddContinuation(std::function<void()> continuation);
+
+ private:
+  void Complete(std::unique_lock<wpi::mutex>& lock);
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  bool m_ready = false;
+  Value m_value{};
+  std::exception_ptr m_exception;
+  std::vector<std::function<void()>> m_continuations;
+};
+
+}  // namespace detail
+
+/**
+ * The result of a task run by an Executor.
+ *
+ * Unlike std::future, a Future can be chained: Then() runs a function on the
+ * result in the pool once it's ready, and ThenOnMainLoop() runs it on the
+ * robot's main loop, so results can be applied without locking.
+ *
+ * If the task throws, the exception is stored in place of the result: Wait()
+ * and Get() rethrow it, and the Futures chained after it fail with it too.
+ *
+ * @tparam T The result type, or void
+ */
+template <typename T>
+class Future {
+ public:
+  Future() = default;
+
+  // Whether this refers to a task; a default constructed Future doesn't
+  bool IsValid() const { return m_state != nullptr; }
+
+  bool IsReady() const;
+  void Wait() const;
+  T Get() const;
+
+  template <typename F>
+  Future<typename std::result_of<F(T)>::type> Then(F&& func) const;
+
+  template <typename F>
+  Future<typename std::result_of<F(T)>::type> ThenOnMainLoop(F&& func) const;
+
+ private:
+  friend class Executor;
+  template <typename U>
+  friend class Future;
+
+  Future(std::shared_ptr<detail::FutureState<T>> state, Executor* executor)
+      : m_state(std::move(state)), m_executor(executor) {}
+
+  template <typename F>
+  Future<typename std::result_of<F(T)>::type> Chain(F&& func,
+                                                     bool onMainLoop) const;
+
+  std::shared_ptr<detail::FutureState<T>> m_state;
+  Executor* m_executor = nullptr;
+};
+
+/**
+ * Future<void> continuations take no argument.
+ */
+template <>
+class Future<void> {
+ public:
+  Future() = default;
+
+  bool IsValid() const { return m_state != nullptr; }
+
+  bool IsReady() const;
+  void Wait() const;
+  void Get() const { Wait(); }
+
+  template <typename F>
+  Future<typename std::result_of<F()>::type> Then(F&& func) const;
+
+  template <typename F>
+  Future<typename std::result_of<F()>::type> ThenOnMainLoop(F&& func) const;
+
+ private:
+  friend class Executor;
+  template <typename U>
+  friend class Future;
+
+  Future(std::shared_ptr<detail::FutureState<void>> state, Executor* executor)
+      : m_state(std::move(state)), m_executor(executor) {}
+
+  template <typename F>
+  Future<typename std::result_of<F()>::type> Chain(F&& func,
+                                                    bool onMainLoop) const;
+
+  std::shared_ptr<detail::FutureState<void>> m_state;
+  Executor* m_executor = nullptr;
+};
+
+/**
+ * A pool of low priority threads for work that shouldn't run on the robot's
+ * real-time threads, such as path generation, file logging or vision
+ * post-processing.
+ *
+ * Each worker keeps its own queue. Tasks posted from a worker go to its own
+ * queue and run newest first, while idle workers steal the oldest tasks from
+ * the others, so nested work stays on one core and the pool stays busy
+ * without a shared queue to contend on.
+ *
+ * The workers are normal priority threads even when created from a real-time
+ * thread, so they never delay the robot's loops. Tasks must not block waiting
+ * for other tasks with Future::Get(); chain them with Future::Then() instead.
+ */
+class Executor {
+ public:
+  static constexpr int kDefaultReservedCores = 1;
+
+  static Executor& GetInstance();
+  static void SetReservedCores(int cores);
+
+  explicit Executor(int threads);
+  ~Executor();
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  int GetThreadCount() const;
+
+  void Post(std::function<void()> task);
+
+  template <typename F>
+  Future<typename std::result_of<F()>::type> Submit(F&& func);
+
+  static void PostToMainLoop(std::function<void()> task);
+  static void RunMainLoopTasks();
+
+ private:
+  struct Worker {
+    wpi::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+    std::thread thread;
+  };
+
+  void WorkerMain(size_t index);
+  bool TryPop(size_t index, std::function<void()>* task);
+  bool TrySteal(size_t thief, std::function<void()>* task);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::atomic<size_t> m_nextWorker{0};
+
+  // Tasks queued and not yet taken, guarded by m_sleepMutex for the waits
+  wpi::mutex m_sleepMutex;
+  wpi::condition_variable m_sleepCond;
+  size_t m_pending = 0;
+  bool m_stop = false;
+};
+
+}  // namespace frc
+
+#include "Executor.inc"
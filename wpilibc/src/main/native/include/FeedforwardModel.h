@@ -0,0 +1,83 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+namespace frc {
+
+/**
+ * Computes the output needed to follow a setpoint trajectory, from a model of
+ * the mechanism, for PIDController::SetFeedforward().
+ *
+ * Outputs are in the units of the controller's output, such as a fraction of
+ * the nominal battery voltage when it compensates for voltage.
+ */
+class FeedforwardModel {
+ public:
+  virtual ~FeedforwardModel() = default;
+
+  /**
+   * Returns the feedforward output.
+   *
+   * @param position     The setpoint position
+   * @param velocity     The setpoint velocity, per second
+   * @param acceleration The setpoint acceleration, per second squared
+   */
+  virtual double Calculate(double position, double velocity,
+                           double acceleration) const = 0;
+};
+
+/**
+ * The feedforward of a DC motor driving a load: a static friction term in the
+ * direction of motion, plus terms proportional to the velocity and to the
+ * acceleration.
+ */
+class SimpleMotorFeedforward : public FeedforwardModel {
+ public:
+  SimpleMotorFeedforward(double kS, double kV, double kA = 0.0);
+
+  double Calculate(double position, double velocity,
+                   double acceleration) const override;
+
+ protected:
+  double m_kS;
+  double m_kV;
+  double m_kA;
+};
+
+/**
+ * The feedforward of an elevator: a simple motor feedforward plus a constant
+ * term that holds the carriage against gravity.
+ */
+class ElevatorFeedforward : public SimpleMotorFeedforward {
+ public:
+  ElevatorFeedforward(double kS, double kG, double kV, double kA = 0.0);
+
+  double Calculate(double position, double velocity,
+                   double acceleration) const override;
+
+ private:
+  double m_kG;
+};
+
+/**
+ * The feedforward of an arm: a simple motor feedforward plus a term that holds
+ * the arm against gravity, proportional to the cosine of its angle. Positions
+ * are angles in radians, 0 when the arm is horizontal.
+ */
+class ArmFeedforward : public SimpleMotorFeedforward {
+ public:
+  ArmFeedforward(double kS, double kCos, double kV, double kA = 0.0);
+
+  double Calculate(double position, double velocity,
+                   double acceleration) const override;
+
+ private:
+  double m_kCos;
+};
+
+}  // namespace frc
@@ -0,0 +1,76 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include <llvm/ArrayRef.h>
+
+namespace frc {
+
+/**
+ * A linear digital filter with the number of feedforward and feedback gains
+ * fixed at compile time.
+ *
+ * It computes the same filters as LinearDigitalFilter:<br>
+ *  y[n] = (b0 * x[n] + b1 * x[n-1] + … + bP * x[n-P]) -
+ *         (a0 * y[n-1] + a2 * y[n-2] + … + aQ * y[n-Q])
+ *
+ * It is meant for high-rate filtering of raw samples. Values are passed to
+ * Calculate() rather than read from a PIDSource. Each delay line is stored
+ * twice over in a contiguous array, so the newest NumFF (or NumFB) samples are
+ * always adjacent. Each step is then two fixed-length dot products with no
+ * wrap-around indexing, which the compiler can unroll and vectorize.
+ *
+ * @tparam NumFF The number of feedforward (FIR) gains
+ * @tparam NumFB The number of feedback (IIR) gains
+ */
+template <size_t NumFF, size_t NumFB>
+class FixedLinearDigitalFilter {
+  static_assert(NumFF > 0, "a filter needs at least one feedforward gain");
+
+ public:
+  FixedLinearDigitalFilter(const std::array<double, NumFF>& ffGains,
+                           const std::array<double, NumFB>& fbGains);
+
+  double Calculate(double input);
+  void Calculate(llvm::ArrayRef<double> inputs,
+                 llvm::MutableArrayRef<double> outputs);
+
+  double Get() const { return m_output; }
+  void Reset();
+
+ private:
+  static double Dot(const double* values, const double* gains, size_t size);
+
+  std::array<double, NumFF> m_inputGains;
+  std::array<double, NumFB> m_outputGains;
+
+  // Each sample is written at [pos] and [pos + size], so [pos, pos + size)
+  // always holds the newest samples, newest first
+  std::array<double, 2 * NumFF> m_inputs;
+  std::array<double, 2 * NumFB> m_outputs;
+  size_t m_inputPos = 0;
+  size_t m_outputPos = 0;
+
+  double m_output = 0.0;
+};
+
+// Factories for the commonly used filters, matching LinearDigitalFilter's
+FixedLinearDigitalFilter<1, 1> MakeSinglePoleIIRFilter(double timeConstant,
+                                                       double period);
+FixedLinearDigitalFilter<2, 1> MakeHighPassFilter(double timeConstant,
+                                                  double period);
+template <size_t Taps>
+FixedLinearDigitalFilter<Taps, 0> MakeMovingAverageFilter();
+
+}  // namespace frc
+
+#include "FixedLinearDigitalFilter.inc"
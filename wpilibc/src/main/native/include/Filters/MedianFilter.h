@@ -0,0 +1,54 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <memory>
+#include <set>
+
+#include "Filter.h"
+#include "circular_buffer.h"
+
+namespace frc {
+
+/**
+ * A moving-window median filter.
+ *
+ * A median filter rejects outliers, such as single bad ultrasonic or vision
+ * readings, without the lag a moving average trades for the same rejection.
+ *
+ * The window is kept split into a lower and an upper half, each an ordered
+ * multiset, so the median is always at the boundary. Inserting the newest
+ * sample and removing the oldest each take O(log n) in the window size,
+ * instead of sorting the window every sample.
+ *
+ * Like the other filters, PIDGet() should be called on a regular period.
+ */
+class MedianFilter : public Filter {
+ public:
+  MedianFilter(PIDSource& source, int size);
+  MedianFilter(std::shared_ptr<PIDSource> source, int size);
+
+  double Calculate(double input);
+
+  // Filter interface
+  double Get() const override;
+  void Reset() override;
+
+  // PIDSource interface
+  double PIDGet(PIDSourceType pidSource) override;
+
+ private:
+  void Rebalance();
+
+  circular_buffer<double> m_window;
+  std::multiset<double> m_lower;
+  std::multiset<double> m_upper;
+  size_t m_size;
+};
+
+}  // namespace frc
@@ -0,0 +1,45 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <memory>
+
+#include "Filter.h"
+
+namespace frc {
+
+/**
+ * Limits how fast a signal may change.
+ *
+ * The output follows the input, but moves at no more than the rate limit
+ * (in input units per second). Time is measured between calls, so it's
+ * correct even if PIDGet() isn't called on an exact period. A typical use is
+ * ramping joystick or motor commands so the wheels don't slip and the robot
+ * doesn't tip.
+ */
+class SlewRateLimiter : public Filter {
+ public:
+  SlewRateLimiter(PIDSource& source, double rateLimit);
+  SlewRateLimiter(std::shared_ptr<PIDSource> source, double rateLimit);
+
+  double Calculate(double input);
+
+  // Filter interface
+  double Get() const override;
+  void Reset() override;
+
+  // PIDSource interface
+  double PIDGet(PIDSourceType pidSource) override;
+
+ private:
+  double m_rateLimit;
+  double m_output = 0.0;
+  double m_prevTime = 0.0;
+};
+
+}  // namespace frc
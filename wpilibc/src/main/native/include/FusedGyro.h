@@ -0,0 +1,117 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <memory>
+
+#include <support/mutex.h>
+
+#include "GyroBase.h"
+#include "Internal/SeqLock.h"
+#include "StateSpace/KalmanFilter.h"
+#include "StateSpace/LinearSystem.h"
+
+namespace frc {
+
+class Accelerometer;
+class Encoder;
+class Notifier;
+
+/**
+ * Fuses a rate gyro with an absolute angle measurement to remove the drift of
+ * the integrated gyro angle.
+ *
+ * The gyro's rate is integrated every period on a Notifier thread and pulled
+ * towards a reference angle, either the tilt measured by an accelerometer or
+ * the heading from the difference of two drivetrain encoders. The gyro's bias
+ * is estimated along the way, so the rate returned is corrected too.
+ *
+ * The estimate is published after each update and read without locking, so
+ * GetAngle(), GetRate() and GetBias() never wait for the filter.
+ */
+class FusedGyro : public GyroBase {
+ public:
+  enum FilterType {
+    /**
+     * Blend the integrated gyro angle with the reference angle, trusting the
+     * gyro over timescales shorter than the time constant.
+     */
+    kComplementary,
+    /**
+     * Estimate the angle and gyro bias with a Kalman filter, weighting the
+     * gyro and reference by their noise.
+     */
+    kKalman
+  };
+
+  enum TiltAxis { kRoll, kPitch };
+
+  static constexpr double kDefaultPeriod = 0.005;
+
+  FusedGyro(Gyro& gyro, Accelerometer& accelerometer, TiltAxis axis,
+            FilterType type = kComplementary, double period = kDefaultPeriod);
+  FusedGyro(Gyro& gyro, Encoder& leftEncoder, Encoder& rightEncoder,
+            double trackWidth, FilterType type = kComplementary,
+            double period = kDefaultPeriod);
+  ~FusedGyro() override;
+
+  double GetAngle() const override;
+  double GetRate() const override;
+  void Reset() override;
+  void Calibrate() override;
+
+  double GetBias() const;
+
+  void SetTimeConstant(double timeConstant);
+  void SetBiasGain(double gain);
+  void SetNoise(double gyroNoise, double biasDrift, double referenceNoise);
+
+  void InitSendable(SendableBuilder& builder) override;
+
+ private:
+  struct Estimate {
+    double angle;
+    double rate;
+    double bias;
+  };
+
+  FusedGyro(Gyro& gyro, FilterType type, double period);
+
+  void Start();
+  double GetReference();
+  void Update();
+  void ResetFilter(double angle);
+
+  Gyro& m_gyro;
+  FilterType m_type;
+  double m_period;
+
+  Accelerometer* m_accelerometer = nullptr;
+  TiltAxis m_axis = kRoll;
+  Encoder* m_leftEncoder = nullptr;
+  Encoder* m_rightEncoder = nullptr;
+  double m_trackWidth = 1.0;
+  double m_headingOffset = 0.0;  // encoder heading at the last Reset()
+
+  // Serializes updates with Reset() and filter changes
+  wpi::mutex m_mutex;
+  double m_timeConstant = 1.0;
+  double m_biasGain = 0.01;
+  double m_angle = 0.0;
+  double m_bias = 0.0;
+
+  // x = [angle, bias], u = [gyro rate], y = [reference angle]
+  LinearSystem<2, 1, 1> m_plant;
+  // Rebuilt by SetNoise()
+  std::unique_ptr<KalmanFilter<2, 1, 1>> m_kalman;
+
+  SeqLock<Estimate> m_estimate;
+  std::unique_ptr<Notifier> m_notifier;
+};
+
+}  // namespace frc
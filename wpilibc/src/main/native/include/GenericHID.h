@@ -11,6 +11,8 @@
 
 #include <string>
 
+#include <HAL/DriverStation.h>
+
 #include "ErrorBase.h"
 
 namespace frc {
@@ -46,6 +48,27 @@ class GenericHID : public ErrorBase {
 
   enum JoystickHand { kLeftHand = 0, kRightHand = 1 };
 
+  /**
+   * The axes, buttons and POVs of the HID from one Driver Station packet.
+   *
+   * Reading a snapshot takes no locks and reports no errors: missing axes
+   * read as 0, missing buttons as released, and missing POVs as -1. Take one
+   * snapshot per loop with GetSnapshot() and read every input from it.
+   */
+  struct Snapshot {
+    uint64_t packetNumber;
+    double timestamp;  // FPGA time in seconds the packet was processed
+    HAL_JoystickAxes axes;
+    HAL_JoystickPOVs povs;
+    HAL_JoystickButtons buttons;
+
+    bool GetRawButton(int button) const;
+    bool GetRawButtonPressed(const Snapshot& previous, int button) const;
+    bool GetRawButtonReleased(const Snapshot& previous, int button) const;
+    double GetRawAxis(int axis) const;
+    int GetPOV(int pov = 0) const;
+  };
+
   explicit GenericHID(int port);
   virtual ~GenericHID() = default;
 
@@ -59,6 +82,8 @@ class GenericHID : public ErrorBase {
   double GetRawAxis(int axis) const;
   int GetPOV(int pov = 0) const;
 
+  Snapshot GetSnapshot() const;
+
   int GetAxisCount() const;
   int GetPOVCount() const;
   int GetButtonCount() const;
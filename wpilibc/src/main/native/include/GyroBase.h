@@ -9,6 +9,7 @@
 
 #include "PIDSource.h"
 #include "SensorBase.h"
+#include "Units.h"
 #include "interfaces/Gyro.h"
 
 namespace frc {
@@ -19,6 +20,14 @@ namespace frc {
  */
 class GyroBase : public Gyro, public SensorBase, public PIDSource {
  public:
+  // GetAngle() and GetRate() converted from degrees
+  units::radian_t GetRotation() const {
+    return units::degrees(GetAngle());
+  }
+  units::radians_per_second_t GetAngularRate() const {
+    return units::degrees_per_second(GetRate());
+  }
+
   // PIDSource interface
   double PIDGet(PIDSourceType pidSource) override;
 
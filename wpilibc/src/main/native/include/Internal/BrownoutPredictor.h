@@ -0,0 +1,64 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <thread>
+
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "RobotController.h"
+
+namespace frc {
+namespace detail {
+
+/**
+ * Takes power snapshots from a background thread for
+ * RobotController::StartBrownoutPrediction(), and extrapolates the input
+ * voltage to the brownout voltage.
+ *
+ * The voltage and its slope are each smoothed with a first order filter, so
+ * single noisy readings don't predict a brownout.
+ */
+class BrownoutPredictor {
+ public:
+  // The input voltage the roboRIO disables its outputs below
+  static constexpr double kBrownoutVoltage = 6.8;
+
+  static BrownoutPredictor& GetInstance();
+
+  ~BrownoutPredictor();
+
+  BrownoutPredictor(const BrownoutPredictor&) = delete;
+  BrownoutPredictor& operator=(const BrownoutPredictor&) = delete;
+
+  void Start(double period, double timeConstant);
+  void Stop();
+  BrownoutPrediction GetPrediction() const;
+
+ private:
+  BrownoutPredictor() = default;
+
+  void ThreadMain();
+  // only called by the predictor thread, without m_mutex held
+  void Sample();
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::thread m_thread;
+  bool m_stop = false;
+  std::chrono::steady_clock::duration m_period;
+  double m_timeConstant = 0;
+  BrownoutPrediction m_prediction;
+};
+
+}  // namespace detail
+}  // namespace frc
@@ -0,0 +1,21 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+namespace frc {
+namespace detail {
+
+// Data written by different threads is separated by this much padding, so
+// the threads don't contend for the same cache line. Padding is used rather
+// than alignas, since C++11 new can't allocate over-aligned types.
+constexpr size_t kCacheLineSize = 64;
+
+}  // namespace detail
+}  // namespace frc
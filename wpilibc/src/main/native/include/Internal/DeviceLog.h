@@ -0,0 +1,76 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <llvm/Twine.h>
+
+#include "DataLog.h"
+#include "RobotController.h"
+
+namespace frc {
+
+namespace detail {
+void SetDeviceLoggingEnabled(bool enabled);
+bool IsDeviceLoggingEnabled();
+// decimation must be at least 1, which logs every value
+void SetDeviceLoggingDecimation(DeviceLogClass deviceClass,
+                                uint32_t decimation);
+uint32_t GetDeviceLoggingDecimation(DeviceLogClass deviceClass);
+}  // namespace detail
+
+/**
+ * A value of a device that is logged to the DataLog while device logging is
+ * enabled with RobotController::EnableDeviceLogging().
+ *
+ * Only every Nth logged value is appended, as set by the decimation of the
+ * device class. The DataLog entry is created the first time a value is
+ * appended, so devices that are never logged don't add entries. Log() only
+ * reads an atomic flag while device logging is disabled.
+ */
+template <typename Entry>
+class DeviceLogSignal {
+ public:
+  DeviceLogSignal() = default;
+
+  DeviceLogSignal(const DeviceLogSignal&) = delete;
+  DeviceLogSignal& operator=(const DeviceLogSignal&) = delete;
+
+  // Must be called before the first Log(), usually when the device is created
+  void Init(DeviceLogClass deviceClass, const llvm::Twine& name) {
+    m_class = deviceClass;
+    m_name = name.str();
+  }
+
+  template <typename T>
+  void Log(T value) {
+    if (!detail::IsDeviceLoggingEnabled()) return;
+    if (m_count.fetch_add(1, std::memory_order_relaxed) %
+            detail::GetDeviceLoggingDecimation(m_class) !=
+        0) {
+      return;
+    }
+    std::call_once(m_created, [&] { m_entry.reset(new Entry(m_name)); });
+    m_entry->Append(value, RobotController::GetFPGATimeFast());
+  }
+
+ private:
+  DeviceLogClass m_class = DeviceLogClass::kEncoder;
+  std::string m_name;
+  std::atomic<uint32_t> m_count{0};
+  std::once_flag m_created;
+  std::unique_ptr<Entry> m_entry;
+};
+
+}  // namespace frc
@@ -0,0 +1,113 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <networktables/NetworkTableEntry.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "RobotController.h"
+#include "static_circular_buffer.h"
+
+namespace nt {
+class NetworkTable;
+}  // namespace nt
+
+namespace frc {
+namespace detail {
+
+/**
+ * Samples the health of the robot controller from a background thread for
+ * RobotController::StartHealthSampling().
+ *
+ * Each sample reads the CPU time of the system and of every thread of the
+ * program from /proc, the memory available, the CAN bus status, and how late
+ * the sampler woke up, which shows how long the scheduler keeps a runnable
+ * thread waiting. The rolling statistics are published to the "RobotHealth"
+ * NetworkTable after each sample.
+ */
+class HealthSampler {
+ public:
+  // Samples the rolling statistics are taken over
+  static constexpr size_t kWindow = 60;
+
+  static HealthSampler& GetInstance();
+
+  ~HealthSampler();
+
+  HealthSampler(const HealthSampler&) = delete;
+  HealthSampler& operator=(const HealthSampler&) = delete;
+
+  void Start(double period);
+  void Stop();
+  RobotHealth GetHealth() const;
+
+ private:
+  struct ThreadTimes {
+    std::string name;
+    uint64_t ticks;
+    // the sample the thread was last seen in
+    uint64_t sample;
+  };
+
+  HealthSampler();
+
+  void ThreadMain();
+  // these are only called by the sampler thread, without m_mutex held
+  void Sample(double latency);
+  bool SampleCPU(double* percent);
+  void SampleThreads(double elapsed, std::vector<ThreadCPULoad>* threads);
+  void Publish(const RobotHealth& health);
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  std::thread m_thread;
+  bool m_stop = false;
+  std::chrono::steady_clock::duration m_period;
+  RobotHealth m_health;
+  static_circular_buffer<double, kWindow> m_cpuHistory;
+  static_circular_buffer<double, kWindow> m_latencyHistory;
+  static_circular_buffer<double, kWindow> m_canHistory;
+  static_circular_buffer<uint64_t, kWindow> m_memoryHistory;
+
+  // Only used by the sampler thread
+  uint64_t m_lastTotalTicks = 0;
+  uint64_t m_lastIdleTicks = 0;
+  std::unordered_map<int, ThreadTimes> m_threadTimes;
+  uint64_t m_threadSample = 0;
+  std::chrono::steady_clock::time_point m_lastSampleTime;
+  std::vector<std::string> m_threadNames;
+  std::vector<double> m_threadPercents;
+
+  std::shared_ptr<nt::NetworkTable> m_table;
+  nt::NetworkTableEntry m_cpuEntry;
+  nt::NetworkTableEntry m_averageCPUEntry;
+  nt::NetworkTableEntry m_maxCPUEntry;
+  nt::NetworkTableEntry m_threadNamesEntry;
+  nt::NetworkTableEntry m_threadCPUEntry;
+  nt::NetworkTableEntry m_memoryAvailableEntry;
+  nt::NetworkTableEntry m_minMemoryAvailableEntry;
+  nt::NetworkTableEntry m_processMemoryEntry;
+  nt::NetworkTableEntry m_latencyEntry;
+  nt::NetworkTableEntry m_maxLatencyEntry;
+  nt::NetworkTableEntry m_canEntry;
+  nt::NetworkTableEntry m_maxCANEntry;
+  nt::NetworkTableEntry m_canErrorsEntry;
+};
+
+}  // namespace detail
+}  // namespace frc
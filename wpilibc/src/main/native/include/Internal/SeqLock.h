@@ -0,0 +1,59 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace frc {
+
+/**
+ * Holds a small, trivially copyable value that one thread publishes and any
+ * number of threads read without locking.
+ *
+ * Readers copy the value and retry if a store ran meanwhile, so a reader
+ * never blocks the writer and always sees a value from a single Store().
+ * Stores must be serialized by the caller.
+ */
+template <typename T>
+class SeqLock {
+ public:
+  SeqLock() = default;
+  explicit SeqLock(const T& value) : m_value(value) {}
+
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  void Store(const T& value) {
+    uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+    // odd while the value is being written
+    m_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_value = value;
+    m_sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  T Load() const {
+    T value;
+    uint32_t sequence;
+    do {
+      sequence = m_sequence.load(std::memory_order_acquire);
+      value = m_value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((sequence & 1) ||
+             m_sequence.load(std::memory_order_relaxed) != sequence);
+    return value;
+  }
+
+ private:
+  std::atomic<uint32_t> m_sequence{0};
+  T m_value{};
+};
+
+}  // namespace frc
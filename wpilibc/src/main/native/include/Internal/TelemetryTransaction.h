@@ -0,0 +1,36 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <memory>
+
+#include <networktables/NetworkTableEntry.h>
+#include <networktables/NetworkTableValue.h>
+
+namespace frc {
+namespace detail {
+
+// While a transaction is open, dashboard values are staged in memory rather
+// than set, and committing sets them all at once and flushes NetworkTables,
+// so the values written in one robot loop reach the dashboard together. See
+// SmartDashboard::BeginTransaction().
+void BeginTelemetryTransaction();
+void CommitTelemetryTransaction();
+
+// Sets the value of a dashboard entry, or stages it in an open transaction.
+// Like NetworkTableEntry::SetValue(), returns false if the entry already has
+// a value of another type.
+bool SetTelemetryValue(nt::NetworkTableEntry entry,
+                       std::shared_ptr<nt::Value> value);
+
+// The value staged for an entry in the open transaction, or nullptr
+std::shared_ptr<nt::Value> GetStagedTelemetryValue(
+    nt::NetworkTableEntry entry);
+
+}  // namespace detail
+}  // namespace frc
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <HAL/Interrupts.h>
+#include <llvm/ArrayRef.h>
 
 #include "AnalogTriggerType.h"
 #include "SensorBase.h"
@@ -23,6 +24,8 @@ class InterruptableSensorBase : public SensorBase {
     kBoth = 0x101,
   };
 
+  using Event = HAL_InterruptEvent;
+
   InterruptableSensorBase() = default;
 
   virtual HAL_Handle GetPortHandleForRouting() const = 0;
@@ -32,6 +35,13 @@ class InterruptableSensorBase : public SensorBase {
   virtual void RequestInterrupts(HAL_InterruptHandlerFunction handler,
                                  void* param);
 
+  // Asynchronous handler run on the shared interrupt dispatch threads.
+  void RequestInterruptsThreaded(HAL_InterruptHandlerFunction handler,
+                                 void* param, int priority = 0);
+
+  static void ConfigureInterruptDispatch(int threadCount, bool realTime,
+                                         int priority, uint32_t cpuMask = 0);
+
   // Synchronous wait version.
   virtual void RequestInterrupts();
 
@@ -42,6 +52,11 @@ class InterruptableSensorBase : public SensorBase {
   virtual WaitResult WaitForInterrupt(double timeout,
                                       bool ignorePrevious = true);
 
+  // Synchronous wait on several sensors.
+  static int WaitForMultipleInterrupts(
+      llvm::ArrayRef<InterruptableSensorBase*> sensors, double timeout,
+      bool ignorePrevious = true);
+
   // Enable interrupts - after finishing setup.
   virtual void EnableInterrupts();
 
@@ -56,6 +71,11 @@ class InterruptableSensorBase : public SensorBase {
 
   virtual void SetUpSourceEdge(bool risingEdge, bool fallingEdge);
 
+  // Queue every edge instead of keeping only the latest timestamps.
+  void SetEventQueueSize(int size);
+  int ReadEvents(Event* events, int count);
+  int64_t GetEventOverflowCount();
+
  protected:
   HAL_InterruptHandle m_interrupt = HAL_kInvalidHandle;
   void AllocateInterrupts(bool watcher);
@@ -7,7 +7,9 @@
 
 #pragma once
 
+#include "LoopProfiler.h"
 #include "RobotBase.h"
+#include "Watchdog.h"
 
 namespace frc {
 
@@ -54,7 +56,11 @@ class IterativeRobotBase : public RobotBase {
   virtual void TeleopPeriodic();
   virtual void TestPeriodic();
 
+  LoopProfiler& GetLoopProfiler();
+  Watchdog& GetWatchdog();
+
  protected:
+  IterativeRobotBase();
   virtual ~IterativeRobotBase() = default;
 
   void LoopFunc();
@@ -63,6 +69,8 @@ class IterativeRobotBase : public RobotBase {
   enum class Mode { kNone, kDisabled, kAutonomous, kTeleop, kTest };
 
   Mode m_lastMode = Mode::kNone;
+  LoopProfiler m_loopProfiler;
+  Watchdog m_watchdog;
 };
 
 }  // namespace frc
@@ -67,6 +67,9 @@ class LiveWindow {
   void DisableTelemetry(Sendable* component);
   void DisableAllTelemetry();
 
+  void SetUpdatePeriod(double period);
+  void SetUpdatePeriod(Sendable* component, double period);
+
   bool IsEnabled() const;
   void SetEnabled(bool enabled);
 
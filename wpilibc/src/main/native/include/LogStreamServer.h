@@ -0,0 +1,155 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "DataLog.h"
+#include "ErrorBase.h"
+
+namespace wpi {
+class NetworkAcceptor;
+class NetworkStream;
+}  // namespace wpi
+
+namespace frc {
+
+/**
+ * Streams the live DataLog to tools on a laptop over TCP.
+ *
+ * Values are streamed as the DataLog writes them, so the DataLog must be
+ * started. A client receives the log header and the start record of every
+ * entry, then the blocks of the entries it subscribed to, in the DataLog file
+ * format. Streamed blocks are encoded on their own rather than against the
+ * entry's earlier blocks, so any of them can be dropped.
+ *
+ * A client subscribes by sending commands:
+ *
+ * - Subscribe: uint8 0, uint8 prefix length and a name prefix. Subscribes to
+ *   every entry whose name starts with the prefix, including entries started
+ *   later; an empty prefix subscribes to everything.
+ * - Unsubscribe: uint8 1. Drops every subscription.
+ *
+ * All clients share a bandwidth budget, which keeps the stream within the
+ * field's limit and leaves the radio to the robot's control traffic. Blocks
+ * wait in a queue for each client. When a client's link can't keep up and
+ * the queue passes half of kMaxQueueTime worth of bandwidth, new blocks of
+ * kLow priority entries are dropped; when it is full, queued blocks are
+ * dropped lowest priority first, oldest first. Dropped values are reported to
+ * the client with a gap record: uint8 3, uint16 entry id and a varint count
+ * of the dropped values.
+ */
+class LogStreamServer : public ErrorBase, private DataLog::Listener {
+ public:
+  enum Priority : uint8_t { kLow = 0, kNormal = 1, kHigh = 2 };
+
+  // Ports 5800-5810 are open to teams on the field
+  static constexpr int kDefaultPort = 5809;
+  // In bytes per second, well below the field's limit for each robot
+  static constexpr double kDefaultBandwidth = 125000;
+  // Seconds of bandwidth a client's queue can hold
+  static constexpr double kMaxQueueTime = 0.5;
+  static constexpr double kSendPeriod = 0.01;
+
+  static LogStreamServer& GetInstance();
+
+  ~LogStreamServer() override;
+
+  LogStreamServer(const LogStreamServer&) = delete;
+  LogStreamServer& operator=(const LogStreamServer&) = delete;
+
+  void Start(int port = kDefaultPort, double bandwidth = kDefaultBandwidth);
+  void Stop();
+
+  void SetPriority(const DataLogEntry& entry, Priority priority);
+
+  int GetClientCount() const;
+  uint64_t GetDroppedCount() const;
+
+ private:
+  struct EntryInfo {
+    std::string name;
+    DataLog::Type type;
+  };
+
+  struct Block {
+    int entry;
+    Priority priority;
+    uint32_t count;
+    // shared by the clients the block is sent to
+    std::shared_ptr<const std::vector<uint8_t>> data;
+    size_t offset;
+    size_t size;
+  };
+
+  struct Client {
+    std::unique_ptr<wpi::NetworkStream> stream;
+    std::vector<std::string> prefixes;
+    std::vector<bool> subscribed;
+    // header, entry starts and gaps, which are never dropped
+    std::vector<uint8_t> control;
+    std::deque<Block> queue;
+    size_t queuedBytes = 0;
+    std::vector<uint64_t> gaps;
+    bool hasGaps = false;
+    // bytes being sent
+    std::vector<uint8_t> sending;
+    size_t sent = 0;
+    // the start of a command that hasn't fully arrived
+    std::vector<uint8_t> received;
+  };
+
+  LogStreamServer() = default;
+
+  void EntryStarted(int entry, llvm::StringRef name,
+                    DataLog::Type type) override;
+  void ValuesWritten(int entry, DataLog::Type type,
+                     llvm::ArrayRef<uint64_t> timestamps,
+                     llvm::ArrayRef<uint64_t> values) override;
+  void PeriodEnded() override;
+
+  void AcceptMain();
+  void SendMain();
+
+  // m_mutex must be held by these
+  void AddClient(std::unique_ptr<wpi::NetworkStream> stream);
+  void Enqueue(Client& client, const Block& block);
+  void Drop(Client& client, const Block& block);
+  bool Receive(Client& client);
+  void Subscribe(Client& client, llvm::StringRef prefix);
+  bool Send(Client& client, double& budget);
+
+  mutable wpi::mutex m_mutex;
+  wpi::condition_variable m_cond;
+  bool m_stop = false;
+  double m_bandwidth = kDefaultBandwidth;
+  std::unique_ptr<wpi::NetworkAcceptor> m_acceptor;
+  std::thread m_acceptThread;
+  std::thread m_sendThread;
+  std::vector<EntryInfo> m_entries;
+  std::vector<Priority> m_priorities;
+  std::vector<std::unique_ptr<Client>> m_clients;
+  std::atomic<int> m_clientCount{0};
+  std::atomic<uint64_t> m_dropped{0};
+
+  // Only used by the DataLog writer thread
+  std::vector<uint8_t> m_period;
+  std::vector<Block> m_periodBlocks;
+};
+
+}  // namespace frc
@@ -0,0 +1,112 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/StringRef.h>
+#include <networktables/NetworkTableEntry.h>
+
+namespace nt {
+class NetworkTable;
+}  // namespace nt
+
+namespace frc {
+
+class Watchdog;
+
+/**
+ * Measures how long each stage of a periodic loop takes.
+ *
+ * Call StartLoop() at the top of the loop, AddEpoch() after each stage, and
+ * EndLoop() at the bottom. Each AddEpoch() records the time since the
+ * previous epoch under the stage's name. EndLoop() counts overruns of the
+ * period, files the loop time in a histogram of multiples of the period, and
+ * reports the stage times when the loop overruns.
+ *
+ * The measurements are published to the "LoopProfiler" NetworkTable so they
+ * can be watched from a dashboard. All methods must be called from the loop's
+ * thread.
+ *
+ * A Watchdog attached with SetWatchdog() is reset, fed the stage times and
+ * disabled by the profiler, so the loop only records its stages once.
+ */
+class LoopProfiler {
+ public:
+  // Each bucket is a quarter period wide; the last holds everything longer
+  static constexpr int kHistogramBuckets = 8;
+
+  explicit LoopProfiler(double period);
+
+  LoopProfiler(const LoopProfiler&) = delete;
+  LoopProfiler& operator=(const LoopProfiler&) = delete;
+
+  void SetPeriod(double period);
+  double GetPeriod() const;
+  void SetOverrunReporting(bool enabled);
+  void SetWatchdog(Watchdog* watchdog);
+
+  void StartLoop();
+  void AddEpoch(llvm::StringRef name);
+  void EndLoop();
+
+  double GetLoopTime() const;
+  double GetMaxLoopTime() const;
+  double GetStageTime(llvm::StringRef name) const;
+  double GetMaxStageTime(llvm::StringRef name) const;
+  uint64_t GetLoopCount() const;
+  uint64_t GetOverrunCount() const;
+  std::array<uint64_t, kHistogramBuckets> GetHistogram() const;
+  void Reset();
+
+ private:
+  struct Stage {
+    std::string name;
+    double time = 0;
+    double maxTime = 0;
+  };
+
+  const Stage* FindStage(llvm::StringRef name) const;
+  void ReportOverrun() const;
+  void Publish();
+
+  double m_period;
+  bool m_reportOverruns = true;
+  Watchdog* m_watchdog = nullptr;
+
+  double m_loopStart = 0;
+  double m_epochStart = 0;
+  double m_loopTime = 0;
+  double m_maxLoopTime = 0;
+  double m_lastOverrunReport = 0;
+  uint64_t m_loopCount = 0;
+  uint64_t m_overrunCount = 0;
+  std::array<uint64_t, kHistogramBuckets> m_histogram{};
+  std::vector<Stage> m_stages;
+
+  // Published copies, reused every loop
+  std::vector<std::string> m_stageNames;
+  std::vector<double> m_stageTimes;
+  std::vector<double> m_histogramValues;
+  bool m_stagesChanged = false;
+
+  std::shared_ptr<nt::NetworkTable> m_table;
+  nt::NetworkTableEntry m_loopTimeEntry;
+  nt::NetworkTableEntry m_maxLoopTimeEntry;
+  nt::NetworkTableEntry m_overrunsEntry;
+  nt::NetworkTableEntry m_stageNamesEntry;
+  nt::NetworkTableEntry m_stageTimesEntry;
+  nt::NetworkTableEntry m_histogramEntry;
+};
+
+}  // namespace frc
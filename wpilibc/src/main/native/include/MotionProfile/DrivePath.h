@@ -0,0 +1,79 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <future>
+#include <vector>
+
+#include <llvm/ArrayRef.h>
+
+#include "MotionProfile/MotionProfile.h"
+
+namespace frc {
+
+/**
+ * A pose the path passes through. The heading is in radians, counterclockwise
+ * from the x axis.
+ */
+struct Waypoint {
+  double x = 0;
+  double y = 0;
+  double heading = 0;
+};
+
+/**
+ * The state of a drive path at one point in time: the profile of each side of
+ * the drivetrain and the pose of the robot center.
+ */
+struct DrivePathSetpoint {
+  MotionSetpoint left;
+  MotionSetpoint right;
+  double x = 0;
+  double y = 0;
+  double heading = 0;
+};
+
+/**
+ * A precomputed path for a differential drivetrain through a list of
+ * waypoints, sampled every period.
+ *
+ * The waypoints are joined by cubic Hermite splines. The robot starts and
+ * ends at rest, and its speed along the path is limited so that neither side
+ * exceeds the maximum velocity in turns and the center does not exceed the
+ * maximum acceleration. Generation is slow compared to a control loop; use
+ * GenerateAsync() to generate a path on another thread before it is needed.
+ */
+class DrivePath {
+ public:
+  using Setpoint = DrivePathSetpoint;
+
+  DrivePath() = default;
+
+  static DrivePath Generate(llvm::ArrayRef<Waypoint> waypoints,
+                            double trackWidth, double maxVelocity,
+                            double maxAcceleration,
+                            double period = MotionProfile::kDefaultPeriod);
+  static std::future<DrivePath> GenerateAsync(
+      std::vector<Waypoint> waypoints, double trackWidth, double maxVelocity,
+      double maxAcceleration, double period = MotionProfile::kDefaultPeriod);
+
+  double GetPeriod() const;
+  double GetDuration() const;
+  double GetLength() const;
+  size_t GetSize() const;
+  llvm::ArrayRef<DrivePathSetpoint> GetSetpoints() const;
+
+ private:
+  double m_period = MotionProfile::kDefaultPeriod;
+  double m_length = 0;
+  std::vector<DrivePathSetpoint> m_setpoints;
+};
+
+}  // namespace frc
@@ -0,0 +1,91 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/ArrayRef.h>
+#include <llvm/StringRef.h>
+
+#include "MotionProfile/DrivePath.h"
+#include "MotionProfile/MotionProfile.h"
+
+namespace frc {
+
+/**
+ * A MotionProfile or DrivePath generated ahead of time and mapped into memory
+ * from a file, so following it at runtime costs no generation and no parsing.
+ *
+ * Files are written with Write(), typically by a desktop program linked with
+ * wpilibc at build time, and deployed with the robot program. Load() maps the
+ * file and checks its header and size; the setpoints are then read straight
+ * from the mapping. A MappedTrajectory can be followed by a ProfileFollower
+ * or a FollowProfileCommand like the profile it was written from.
+ *
+ * The file is little endian:
+ *
+ * - Header, 32 bytes: the 4 bytes "FRCT", a uint32 format version, a uint32
+ *   type (1 for a MotionProfile, 2 for a DrivePath), a uint32 number of
+ *   setpoints, then the period in seconds and the length of the path as
+ *   IEEE doubles.
+ * - Setpoints, 8 byte aligned, in the layout of MotionSetpoint (position,
+ *   velocity, acceleration) or DrivePathSetpoint (left, right, x, y,
+ *   heading), each field an IEEE double.
+ *
+ * Replace a deployed file by renaming a new one over it, as a file truncated
+ * in place while it is mapped crashes the program when it is read.
+ */
+template <typename Profile>
+class MappedTrajectory {
+ public:
+  using Setpoint = typename Profile::Setpoint;
+
+  static constexpr uint32_t kVersion = 1;
+
+  static std::shared_ptr<const MappedTrajectory> Load(llvm::StringRef path);
+  static bool Write(llvm::StringRef path, const Profile& profile);
+
+  ~MappedTrajectory();
+
+  MappedTrajectory(const MappedTrajectory&) = delete;
+  MappedTrajectory& operator=(const MappedTrajectory&) = delete;
+
+  double GetPeriod() const;
+  double GetDuration() const;
+  double GetLength() const;
+  size_t GetSize() const;
+  llvm::ArrayRef<Setpoint> GetSetpoints() const;
+
+ private:
+  MappedTrajectory() = default;
+
+  // Returns false with errno set if the file can't be read
+  bool Map(const std::string& path);
+
+  const uint8_t* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  std::vector<uint8_t> m_buffer;
+#endif
+  double m_period = 0;
+  double m_length = 0;
+  llvm::ArrayRef<Setpoint> m_setpoints;
+};
+
+using MappedMotionProfile = MappedTrajectory<MotionProfile>;
+using MappedDrivePath = MappedTrajectory<DrivePath>;
+
+extern template class MappedTrajectory<MotionProfile>;
+extern template class MappedTrajectory<DrivePath>;
+
+}  // namespace frc
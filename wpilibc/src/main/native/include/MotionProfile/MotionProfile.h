@@ -0,0 +1,74 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <future>
+#include <vector>
+
+#include <llvm/ArrayRef.h>
+
+namespace frc {
+
+/**
+ * The state of a profile at one point in time.
+ */
+struct MotionSetpoint {
+  double position = 0;
+  double velocity = 0;
+  double acceleration = 0;
+};
+
+/**
+ * A precomputed one-dimensional motion profile: setpoints sampled every
+ * period, from rest at position 0 to rest at the target distance.
+ *
+ * Profiles are generated ahead of time, so following one is only an array
+ * lookup. The setpoints are stored contiguously. Generation allocates and can
+ * take a while for long profiles; use the Async variants to generate a
+ * profile on another thread, for example in RobotInit(), and only collect it
+ * when it is needed.
+ */
+class MotionProfile {
+ public:
+  using Setpoint = MotionSetpoint;
+
+  static constexpr double kDefaultPeriod = 0.01;
+
+  MotionProfile() = default;
+  MotionProfile(double period, std::vector<MotionSetpoint> setpoints);
+
+  static MotionProfile Trapezoid(double distance, double maxVelocity,
+                                 double maxAcceleration,
+                                 double period = kDefaultPeriod);
+  static MotionProfile SCurve(double distance, double maxVelocity,
+                              double maxAcceleration, double maxJerk,
+                              double period = kDefaultPeriod);
+
+  static std::future<MotionProfile> TrapezoidAsync(
+      double distance, double maxVelocity, double maxAcceleration,
+      double period = kDefaultPeriod);
+  static std::future<MotionProfile> SCurveAsync(double distance,
+                                                double maxVelocity,
+                                                double maxAcceleration,
+                                                double maxJerk,
+                                                double period = kDefaultPeriod);
+
+  double GetPeriod() const;
+  double GetDuration() const;
+  size_t GetSize() const;
+  llvm::ArrayRef<MotionSetpoint> GetSetpoints() const;
+  MotionSetpoint Sample(double time) const;
+
+ private:
+  double m_period = kDefaultPeriod;
+  std::vector<MotionSetpoint> m_setpoints;
+};
+
+}  // namespace frc
@@ -0,0 +1,62 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <functional>
+#include <memory>
+
+#include <support/mutex.h>
+
+#include "Notifier.h"
+
+namespace frc {
+
+/**
+ * Steps through a precomputed profile from a Notifier, calling a handler with
+ * each setpoint in turn.
+ *
+ * The profile may be a MotionProfile, a DrivePath, or any type with the same
+ * Setpoint type, GetPeriod() and GetSetpoints(). The notifier runs at the
+ * profile's period and the setpoint is chosen from the time since Start(), so
+ * a late notifier skips ahead rather than falling behind. The handler is
+ * called on the notifier thread and typically sets a motor controller or PID
+ * setpoint; after the last setpoint the follower stops on its own.
+ */
+template <typename Profile>
+class ProfileFollower {
+ public:
+  using Setpoint = typename Profile::Setpoint;
+  using Handler = std::function<void(const Setpoint&)>;
+
+  explicit ProfileFollower(Handler handler);
+  ~ProfileFollower();
+
+  ProfileFollower(const ProfileFollower&) = delete;
+  ProfileFollower& operator=(const ProfileFollower&) = delete;
+
+  void Start(std::shared_ptr<const Profile> profile);
+  void Stop();
+  bool IsFinished() const;
+
+ private:
+  void Step();
+
+  Handler m_handler;
+  // held while the handler runs and while the profile is changed
+  mutable wpi::mutex m_mutex;
+  std::shared_ptr<const Profile> m_profile;
+  double m_startTime = 0;
+  bool m_finished = true;
+  Notifier m_notifier;
+};
+
+}  // namespace frc
+
+#include "MotionProfile/ProfileFollower.inc"
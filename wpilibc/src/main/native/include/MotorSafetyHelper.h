@@ -7,9 +7,11 @@
 
 #pragma once
 
-#include <set>
+#include <stddef.h>
 
-#include <support/mutex.h>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include "ErrorBase.h"
 
@@ -31,26 +33,30 @@ class MotorSafetyHelper : public ErrorBase {
   static void CheckMotors();
 
  private:
-  // The expiration time for this object
-  double m_expiration;
+  // The shared state of a helper that CheckMotors() scans
+  struct Slot;
 
-  // True if motor safety is enabled for this motor
-  bool m_enabled;
+  // The most helpers kept in GetSlots(); more go in a list CheckMotors()
+  // walks under the slot mutex
+  static constexpr size_t kMaxHelpers = 256;
 
-  // The FPGA clock value when this motor has expired
-  double m_stopTime;
+  static Slot* GetSlots();
+  // The slots of helpers created once GetSlots() was full. Guarded by the
+  // slot mutex.
+  static std::vector<Slot*>& GetOverflowSlots();
 
-  // Protect accesses to the state for this object
-  mutable wpi::mutex m_thisMutex;
+  // The expiration time for this object
+  std::atomic<double> m_expiration;
 
-  // The object that is using the helper
-  MotorSafety* m_safeObject;
+  // The slot in GetSlots() holding the enable flag and stop time
+  Slot* m_slot;
 
-  // List of all existing MotorSafetyHelper objects.
-  static std::set<MotorSafetyHelper*> m_helperList;
+  // Owns m_slot when every slot in GetSlots() is taken, in which case it is
+  // in the overflow list instead
+  std::unique_ptr<Slot> m_ownSlot;
 
-  // Protect accesses to the list of helpers
-  static wpi::mutex m_listMutex;
+  // The object that is using the helper
+  MotorSafety* m_safeObject;
 };
 
 }  // namespace frc
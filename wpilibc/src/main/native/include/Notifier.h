@@ -10,24 +10,34 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <chrono>
 #include <functional>
+#include <memory>
 #include <thread>
+#include <type_traits>
 #include <utility>
 
 #include <HAL/Notifier.h>
 #include <support/mutex.h>
 
 #include "ErrorBase.h"
+#include "Units.h"
 
 namespace frc {
 
+class NotifierExecutor;
+
 typedef std::function<void()> TimerEventHandler;
 
 class Notifier : public ErrorBase {
  public:
   explicit Notifier(TimerEventHandler handler);
+  Notifier(NotifierExecutor& executor, TimerEventHandler handler);
 
-  template <typename Callable, typename Arg, typename... Args>
+  template <typename Callable, typename Arg, typename... Args,
+            typename = typename std::enable_if<
+                !std::is_same<typename std::decay<Callable>::type,
+                              NotifierExecutor>::value>::type>
   Notifier(Callable&& f, Arg&& arg, Args&&... args)
       : Notifier(std::bind(std::forward<Callable>(f), std::forward<Arg>(arg),
                            std::forward<Args>(args)...)) {}
@@ -39,27 +49,39 @@ class Notifier : public ErrorBase {
 
   void SetHandler(TimerEventHandler handler);
   void StartSingle(double delay);
+  void StartSingle(std::chrono::microseconds delay);
   void StartPeriodic(double period);
+  void StartPeriodic(std::chrono::microseconds period);
+  void StartSingle(units::second_t delay) { StartSingle(delay.value()); }
+  void StartPeriodic(units::second_t period) { StartPeriodic(period.value()); }
   void Stop();
 
  private:
+  friend class NotifierExecutor;
+
   // update the HAL alarm
   void UpdateAlarm();
+  // run the handler for an expired alarm and requeue it if periodic
+  void ProcessAlarm();
+  // the shared executor, or nullptr if this notifier has its own thread
+  NotifierExecutor* m_executor = nullptr;
   // the thread waiting on the HAL alarm
   std::thread m_thread;
-  // held while updating process information
+  // held while updating process information; taken on the real-time thread
+  // processing alarms, so it inherits priority
   wpi::mutex m_processMutex;
   // HAL handle, atomic for proper destruction
   std::atomic<HAL_NotifierHandle> m_notifier{0};
 
-  // Address of the handler
-  TimerEventHandler m_handler;
+  // The handler, shared so calling it does not copy (and allocate) it
+  std::shared_ptr<TimerEventHandler> m_handler;
 
-  // The absolute expiration time
-  double m_expirationTime = 0;
+  // The absolute expiration time in FPGA microseconds
+  uint64_t m_expirationTime = 0;
 
-  // The relative time (either periodic or single)
-  double m_period = 0;
+  // The relative time (either periodic or single) in microseconds. Integer so
+  // periodic deadlines stay exact multiples of it however long they run.
+  uint64_t m_period = 0;
 
   // True if this is a periodic event
   bool m_periodic = false;
@@ -0,0 +1,88 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <HAL/Notifier.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+class Notifier;
+
+/**
+ * Runs the handlers of many Notifiers from a single thread.
+ *
+ * Each Notifier normally owns a thread blocked on its own HAL notifier. A
+ * NotifierExecutor instead keeps the deadlines of all attached Notifiers in a
+ * min-heap and waits on one HAL notifier set to the earliest deadline, so many
+ * periodic tasks cost one wakeup per deadline rather than one thread each.
+ *
+ * Handlers attached to the same executor run sequentially; a slow handler
+ * delays every other handler on that executor.
+ */
+class NotifierExecutor : public ErrorBase {
+ public:
+  static constexpr int kDefaultPriority = 40;
+
+  static NotifierExecutor& GetInstance();
+
+  explicit NotifierExecutor(int priority = kDefaultPriority);
+  ~NotifierExecutor() override;
+
+  NotifierExecutor(const NotifierExecutor&) = delete;
+  NotifierExecutor& operator=(const NotifierExecutor&) = delete;
+
+ private:
+  friend class Notifier;
+
+  struct Entry {
+    uint64_t triggerTime;
+    Notifier* notifier;
+    uint64_t sequence;
+
+    bool operator>(const Entry& rhs) const {
+      return triggerTime > rhs.triggerTime;
+    }
+  };
+
+  // schedule a notifier, replacing any deadline it already had
+  void Schedule(Notifier* notifier, uint64_t triggerTime);
+  // drop any pending deadline for a notifier, waiting for a running handler
+  // of the notifier to return
+  void Cancel(Notifier* notifier);
+
+  // update the HAL alarm to the earliest deadline; m_mutex must be held
+  void UpdateAlarm();
+  void ThreadMain();
+
+  std::thread m_thread;
+  wpi::mutex m_mutex;
+  wpi::condition_variable m_runningCond;
+  std::atomic<HAL_NotifierHandle> m_notifier{0};
+
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> m_queue;
+  // current sequence number of each attached notifier; heap entries with an
+  // older sequence are stale and skipped
+  std::unordered_map<Notifier*, uint64_t> m_sequences;
+  uint64_t m_nextSequence = 0;
+  Notifier* m_running = nullptr;
+};
+
+}  // namespace frc
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -15,10 +16,13 @@
 
 #include "Base.h"
 #include "Controller.h"
+#include "FeedforwardModel.h"
 #include "Filters/LinearDigitalFilter.h"
+#include "Internal/SeqLock.h"
 #include "Notifier.h"
 #include "PIDInterface.h"
 #include "PIDSource.h"
+#include "SPSCQueue.h"
 #include "SmartDashboard/SendableBase.h"
 #include "Timer.h"
 
@@ -38,6 +42,18 @@ class PIDOutput;
  */
 class PIDController : public SendableBase, public PIDInterface {
  public:
+  /**
+   * One iteration of the control loop, as recorded by telemetry.
+   */
+  struct TelemetrySample {
+    // FPGA time of the iteration, in seconds
+    double timestamp;
+    double setpoint;
+    double input;
+    double error;
+    double output;
+  };
+
   PIDController(double p, double i, double d, PIDSource* source,
                 PIDOutput* output, double period = 0.05);
   PIDController(double p, double i, double d, double f, PIDSource* source,
@@ -66,6 +82,11 @@ class PIDController : public SendableBase, public PIDInterface {
   double GetD() const override;
   virtual double GetF() const;
 
+  void SetFeedforward(std::shared_ptr<FeedforwardModel> model);
+  std::shared_ptr<FeedforwardModel> GetFeedforward() const;
+  void EnableVoltageCompensation(double nominalVoltage = 12.0);
+  void DisableVoltageCompensation();
+
   void SetSetpoint(double setpoint) override;
   double GetSetpoint() const override;
   double GetDeltaSetpoint() const;
@@ -95,6 +116,14 @@ class PIDController : public SendableBase, public PIDInterface {
 
   void Reset() override;
 
+  void SetSynchronous(bool synchronous);
+  bool IsSynchronous() const;
+  void Update();
+
+  void EnableTelemetry(bool enable = true);
+  int ReadTelemetry(TelemetrySample* samples, int count);
+  uint64_t GetTelemetryDropCount() const;
+
   void InitSendable(SendableBuilder& builder) override;
 
  protected:
@@ -106,72 +135,121 @@ class PIDController : public SendableBase, public PIDInterface {
   double GetContinuousError(double error) const;
 
  private:
-  // Factor for "proportional" control
-  double m_P;
+  enum ToleranceType { kAbsoluteTolerance, kPercentTolerance, kNoTolerance };
 
-  // Factor for "integral" control
-  double m_I;
+  // Configuration, only changed under m_thisMutex and read by Calculate()
+  // without locking
+  struct Parameters {
+    // Factor for "proportional" control
+    double P = 0;
 
-  // Factor for "derivative" control
-  double m_D;
+    // Factor for "integral" control
+    double I = 0;
 
-  // Factor for "feed forward" control
-  double m_F;
+    // Factor for "derivative" control
+    double D = 0;
 
-  // |maximum output|
-  double m_maximumOutput = 1.0;
+    // Factor for "feed forward" control
+    double F = 0;
 
-  // |minimum output|
-  double m_minimumOutput = -1.0;
+    // |maximum output|
+    double maximumOutput = 1.0;
 
-  // Maximum input - limit setpoint to this
-  double m_maximumInput = 0;
+    // |minimum output|
+    double minimumOutput = -1.0;
 
-  // Minimum input - limit setpoint to this
-  double m_minimumInput = 0;
+    // Maximum input - limit setpoint to this
+    double maximumInput = 0;
 
-  // input range - difference between maximum and minimum
-  double m_inputRange = 0;
+    // Minimum input - limit setpoint to this
+    double minimumInput = 0;
 
-  // Do the endpoints wrap around? eg. Absolute encoder
-  bool m_continuous = false;
+    // input range - difference between maximum and minimum
+    double inputRange = 0;
 
-  // Is the pid controller enabled
-  bool m_enabled = false;
+    // Do the endpoints wrap around? eg. Absolute encoder
+    bool continuous = false;
+
+    ToleranceType toleranceType = kNoTolerance;
+
+    // The percetage or absolute error that is considered on target.
+    double tolerance = 0.05;
+
+    double setpoint = 0;
+
+    PIDSourceType pidSourceType = PIDSourceType::kDisplacement;
+
+    // The battery voltage the output is scaled to; 0 when output isn't
+    // compensated for voltage
+    double nominalVoltage = 0;
+  };
 
-  // The prior error (used to compute velocity)
-  double m_prevError = 0;
+  // Results of the last Calculate(), published for lock-free reads
+  struct State {
+    // The prior error (used to compute velocity)
+    double prevError = 0;
 
-  // The sum of the errors for use in the integral calc
-  double m_totalError = 0;
+    // The sum of the errors for use in the integral calc
+    double totalError = 0;
 
-  enum {
-    kAbsoluteTolerance,
-    kPercentTolerance,
-    kNoTolerance
-  } m_toleranceType = kNoTolerance;
+    double error = 0;
+    double result = 0;
 
-  // The percetage or absolute error that is considered on target.
-  double m_tolerance = 0.05;
+    // The last setpoint and its velocity, which a feedforward model
+    // differentiates
+    double ffSetpoint = 0;
+    double ffVelocity = 0;
+    bool ffPrimed = false;
+  };
 
-  double m_setpoint = 0;
-  double m_prevSetpoint = 0;
-  double m_error = 0;
-  double m_result = 0;
+  template <typename F>
+  void UpdateParameters(F&& update);
+  static double GetContinuousError(const Parameters& params, double error);
+  double CalculateModelFeedForward(const FeedforwardModel& model,
+                                   const Parameters& params, State* state);
+
+  SeqLock<Parameters> m_parameters;
+  SeqLock<State> m_state;
+
+  // Is the pid controller enabled
+  std::atomic<bool> m_enabled{false};
+
+  // Is the loop run by the owner's Update() calls instead of m_controlLoop
+  std::atomic<bool> m_synchronous{false};
+
+  std::atomic<double> m_prevSetpoint{0};
   double m_period;
 
   std::shared_ptr<PIDSource> m_origSource;
 
-  PIDSourceType m_pidSourceType = PIDSourceType::kDisplacement;
-  
+  // Replaces CalculateFeedForward() when set; accessed atomically
+  std::shared_ptr<FeedforwardModel> m_feedforward;
+
   LinearDigitalFilter m_filter{nullptr, {}, {}};
 
+  // Serializes parameter updates; never taken by Calculate()
   mutable wpi::mutex m_thisMutex;
 
+  // The locks taken by Calculate() inherit priority, since it runs on the
+  // real-time notifier thread; see HAL/Threads.h
+
+  // Serializes reads of m_pidInput, which the filter makes stateful
+  mutable wpi::mutex m_inputMutex;
+
+  // Serializes writers of m_state
+  wpi::mutex m_stateMutex;
+
   // Ensures when Disable() is called, PIDWrite() won't run if Calculate()
   // is already running at that time.
   mutable wpi::mutex m_pidWriteMutex;
 
+  // Samples Calculate() hands to the one thread calling ReadTelemetry();
+  // allocated by the first EnableTelemetry()
+  typedef SPSCQueue<TelemetrySample, 256> TelemetryQueue;
+  std::unique_ptr<TelemetryQueue> m_telemetry;
+  std::atomic<bool> m_telemetryEnabled{false};
+  std::atomic<uint64_t> m_telemetryDrops{0};
+
   std::unique_ptr<Notifier> m_controlLoop;
   Timer m_setpointTimer;
 };
@@ -0,0 +1,123 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include <support/mutex.h>
+
+#include "ErrorBase.h"
+#include "PIDSource.h"
+
+namespace frc {
+
+class Notifier;
+class PIDOutput;
+
+/**
+ * Runs many PID loops from a single periodic callback.
+ *
+ * Each PIDController owns a Notifier, so N controllers cost N threads and N
+ * wakeups per period, and their loops run at unrelated phases. A
+ * PIDControllerGroup reads every source, then computes every loop, then
+ * writes every output, all from one Notifier. Every loop in the group sees
+ * inputs sampled in the same period.
+ *
+ * The loop math is the same as PIDController's. Controller state is stored as
+ * one array per field, so the compute pass runs over contiguous data.
+ */
+class PIDControllerGroup : public ErrorBase {
+ public:
+  explicit PIDControllerGroup(double period = 0.05);
+  ~PIDControllerGroup() override;
+
+  PIDControllerGroup(const PIDControllerGroup&) = delete;
+  PIDControllerGroup& operator=(const PIDControllerGroup&) = delete;
+
+  int Add(double p, double i, double d, PIDSource& source, PIDOutput& output);
+  int Add(double p, double i, double d, double f, PIDSource& source,
+          PIDOutput& output);
+  int GetSize() const;
+
+  void SetPID(int index, double p, double i, double d, double f = 0.0);
+  void SetSetpoint(int index, double setpoint);
+  double GetSetpoint(int index) const;
+  void SetInputRange(int index, double minimumInput, double maximumInput);
+  void SetOutputRange(int index, double minimumOutput, double maximumOutput);
+  void SetContinuous(int index, bool continuous = true);
+  void SetPIDSourceType(int index, PIDSourceType pidSource);
+
+  double Get(int index) const;
+  double GetError(int index) const;
+
+  void Enable(int index);
+  void Disable(int index);
+  bool IsEnabled(int index) const;
+  void Reset(int index);
+
+  void EnableAll();
+  void DisableAll();
+
+  double GetLoopTime() const;
+  double GetMaxLoopTime() const;
+  void ResetLoopTiming();
+
+ private:
+  bool CheckIndex(int index) const;
+  void Calculate();
+
+  // Configuration, one entry per controller
+  std::vector<PIDSource*> m_sources;
+  std::vector<PIDOutput*> m_outputs;
+  std::vector<PIDSourceType> m_sourceTypes;
+  std::vector<double> m_P;
+  std::vector<double> m_I;
+  std::vector<double> m_D;
+  std::vector<double> m_F;
+  std::vector<double> m_minimumOutput;
+  std::vector<double> m_maximumOutput;
+  std::vector<double> m_minimumInput;
+  std::vector<double> m_maximumInput;
+  std::vector<uint8_t> m_continuous;
+  std::vector<uint8_t> m_enabled;
+  std::vector<double> m_setpoint;
+
+  // Loop state, one entry per controller
+  std::vector<double> m_input;
+  std::vector<double> m_error;
+  std::vector<double> m_prevError;
+  std::vector<double> m_totalError;
+  std::vector<double> m_prevSetpoint;
+  std::vector<double> m_result;
+
+  // What the Notifier reads and writes outside m_mutex, copied each period
+  struct LoopIO {
+    PIDSource* source = nullptr;
+    PIDOutput* output = nullptr;
+    PIDSourceType sourceType = PIDSourceType::kDisplacement;
+    bool enabled = false;
+    // the input read, then the result to write
+    double value = 0;
+  };
+  std::vector<LoopIO> m_io;
+
+  double m_period;
+  double m_lastLoopStart = 0;
+  double m_loopTime = 0;
+  double m_maxLoopTime = 0;
+
+  mutable wpi::mutex m_mutex;
+  // Held while writing outputs; taken before m_mutex
+  wpi::mutex m_writeMutex;
+  std::unique_ptr<Notifier> m_controlLoop;
+};
+
+}  // namespace frc
@@ -12,6 +12,7 @@
 #include <HAL/Types.h>
 
 #include "ErrorBase.h"
+#include "Internal/DeviceLog.h"
 #include "SmartDashboard/SendableBase.h"
 
 namespace frc {
@@ -22,7 +23,8 @@ namespace frc {
  * The values supplied as arguments for PWM outputs range from -1.0 to 1.0. They
  * are mapped to the hardware dependent values, in this case 0-2000 for the
  * FPGA. Changes are immediately sent to the FPGA, and the update occurs at the
- * next FPGA cycle (5.005ms). There is no delay.
+ * next FPGA cycle (5.005ms). There is no delay, unless outputs are deferred
+ * with SetOutputsDeferred().
  *
  * As of revision 0.1.10 of the FPGA, the FPGA interprets the 0-2000 values as
  * follows:
@@ -73,12 +75,23 @@ class PWM : public ErrorBase, public SendableBase {
                     int32_t* deadbandMin, int32_t* min);
   int GetChannel() const { return m_channel; }
 
+  static void SetOutputsDeferred(bool deferred);
+  static bool GetOutputsDeferred();
+  static void CommitOutputs();
+
  protected:
   void InitSendable(SendableBuilder& builder) override;
 
  private:
+  friend class PWMSpeedControllerGroup;
+
   int m_channel;
   HAL_DigitalHandle m_handle;
+
+  DeviceLogSignal<DoubleLogEntry> m_speedLog;
+  DeviceLogSignal<DoubleLogEntry> m_positionLog;
+  // also logs 0 when the output is disabled
+  DeviceLogSignal<IntegerLogEntry> m_rawLog;
 };
 
 }  // namespace frc
@@ -0,0 +1,78 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <HAL/Types.h>
+#include <llvm/raw_ostream.h>
+
+#include "ErrorBase.h"
+#include "MotorSafety.h"
+#include "MotorSafetyHelper.h"
+#include "PWMSpeedController.h"
+#include "SmartDashboard/SendableBase.h"
+#include "SpeedController.h"
+
+namespace frc {
+
+/**
+ * A group of PWM speed controllers driven together, like
+ * SpeedControllerGroup but writing every member with one HAL call.
+ *
+ * The members' HAL handles are resolved when the group is created, and
+ * Set() writes all of their channels through HAL_SetPWMSpeeds() with no
+ * virtual calls per member. Motor safety is handled once for the whole group:
+ * the members' own motor safety is disabled, and the group's is fed by each
+ * Set(). Each member's SetInverted() still applies, as does the group's.
+ */
+class PWMSpeedControllerGroup : public ErrorBase,
+                                public SendableBase,
+                                public SpeedController,
+                                public MotorSafety {
+ public:
+  template <class... PWMSpeedControllers>
+  explicit PWMSpeedControllerGroup(PWMSpeedController& speedController,
+                                   PWMSpeedControllers&... speedControllers);
+  ~PWMSpeedControllerGroup() override = default;
+
+  // SpeedController interface
+  void Set(double speed) override;
+  double Get() const override;
+  void SetInverted(bool isInverted) override;
+  bool GetInverted() const override;
+  void Disable() override;
+  void StopMotor() override;
+  void PIDWrite(double output) override;
+
+  // MotorSafety interface
+  void SetExpiration(double timeout) override;
+  double GetExpiration() const override;
+  bool IsAlive() const override;
+  void SetSafetyEnabled(bool enabled) override;
+  bool IsSafetyEnabled() const override;
+  void GetDescription(llvm::raw_ostream& desc) const override;
+
+  void InitSendable(SendableBuilder& builder) override;
+
+ private:
+  void Initialize();
+
+  bool m_isInverted = false;
+  std::vector<std::reference_wrapper<PWMSpeedController>> m_speedControllers;
+  std::vector<HAL_DigitalHandle> m_handles;
+  // Reused by Set() so it does not allocate
+  std::vector<double> m_speeds;
+  std::unique_ptr<MotorSafetyHelper> m_safetyHelper;
+};
+
+}  // namespace frc
+
+#include "PWMSpeedControllerGroup.inc"
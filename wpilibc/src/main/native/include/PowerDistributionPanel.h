@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <HAL/PDP.h>
+
+#include "Internal/DeviceLog.h"
 #include "SensorBase.h"
 
 namespace frc {
@@ -26,6 +29,7 @@ class PowerDistributionPanel : public SensorBase {
   double GetTotalCurrent() const;
   double GetTotalPower() const;
   double GetTotalEnergy() const;
+  HAL_PDPSnapshot GetSnapshot() const;
   void ResetTotalEnergy();
   void ClearStickyFaults();
 
@@ -33,6 +37,13 @@ class PowerDistributionPanel : public SensorBase {
 
  private:
   int m_module;
+
+  mutable DeviceLogSignal<DoubleLogEntry> m_voltageLog;
+  mutable DeviceLogSignal<DoubleLogEntry> m_temperatureLog;
+  mutable DeviceLogSignal<DoubleLogEntry> m_currentLogs[HAL_kPDPNumChannels];
+  mutable DeviceLogSignal<DoubleLogEntry> m_totalCurrentLog;
+  mutable DeviceLogSignal<DoubleLogEntry> m_totalPowerLog;
+  mutable DeviceLogSignal<DoubleLogEntry> m_totalEnergyLog;
 };
 
 }  // namespace frc
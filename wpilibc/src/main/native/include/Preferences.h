@@ -9,13 +9,17 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <llvm/StringMap.h>
 #include <networktables/NetworkTable.h>
+#include <support/mutex.h>
 
 #include "ErrorBase.h"
+#include "Notifier.h"
 
 namespace frc {
 
@@ -30,11 +34,43 @@ namespace frc {
  *
  * This class is thread safe.
  *
+ * By default every Put writes through to NetworkTables, and each change may
+ * cause the whole preferences file to be rewritten. With
+ * SetDeferredWrites(true), Puts are staged in memory instead and written
+ * together by Flush(), which also runs periodically on its own thread, so a
+ * burst of changes reaches the file at once. Gets see staged values. For
+ * values read every loop, GetCached() returns a handle that reads an atomic
+ * copy of the value, kept current by a listener, without any table lookup.
+ *
  * This will also interact with {@link NetworkTable} by creating a table called
  * "Preferences" with all the key-value pairs.
  */
 class Preferences : public ErrorBase {
+  struct CacheEntry;
+
  public:
+  static constexpr double kDefaultFlushInterval = 1.0;
+
+  /**
+   * A numeric preference read without locking. Booleans read as 1 or 0.
+   */
+  class CachedValue {
+   public:
+    CachedValue() = default;
+
+    double GetDouble() const;
+    int GetInt() const;
+    int64_t GetLong() const;
+    float GetFloat() const;
+    bool GetBoolean() const;
+
+   private:
+    friend class Preferences;
+    explicit CachedValue(std::shared_ptr<const CacheEntry> entry);
+
+    std::shared_ptr<const CacheEntry> m_entry;
+  };
+
   static Preferences* GetInstance();
 
   std::vector<std::string> GetKeys();
@@ -53,13 +89,43 @@ class Preferences : public ErrorBase {
   bool ContainsKey(llvm::StringRef key);
   void Remove(llvm::StringRef key);
 
+  CachedValue GetCached(llvm::StringRef key, double defaultValue = 0.0);
+
+  void SetDeferredWrites(bool deferred);
+  bool GetDeferredWrites() const;
+  void SetFlushInterval(double seconds);
+  void Flush();
+
  protected:
   Preferences();
-  virtual ~Preferences() = default;
+  virtual ~Preferences();
 
  private:
+  struct CacheEntry {
+    explicit CacheEntry(double defaultValue)
+        : value(defaultValue), defaultValue(defaultValue) {}
+
+    std::atomic<double> value;
+    double defaultValue;
+  };
+
+  std::shared_ptr<nt::Value> GetPending(llvm::StringRef key);
+  void Put(llvm::StringRef key, std::shared_ptr<nt::Value> value);
+  // Updates the cached copy of a preference, if any; m_mutex must be held
+  void UpdateCache(llvm::StringRef key, const nt::Value* value);
+
   std::shared_ptr<nt::NetworkTable> m_table;
   NT_EntryListener m_listener;
+  NT_EntryListener m_cacheListener;
+
+  // Held while using the staged values and the cache
+  mutable wpi::mutex m_mutex;
+  llvm::StringMap<std::shared_ptr<nt::Value>> m_pending;
+  llvm::StringMap<std::shared_ptr<CacheEntry>> m_cache;
+
+  std::atomic_bool m_deferred{false};
+  double m_flushInterval = kDefaultFlushInterval;
+  std::unique_ptr<Notifier> m_flushNotifier;
 };
 
 }  // namespace frc
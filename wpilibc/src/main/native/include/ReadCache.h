@@ -0,0 +1,82 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+namespace frc {
+
+/**
+ * Latches sensor reads once per robot loop.
+ *
+ * Odometry, a PID source and a dashboard update often read the same sensor
+ * in one loop, and each read is a HAL call. While the cache is enabled, the
+ * first read of a sensor value in a loop is latched, and later reads of it in
+ * the same loop return the latched value, so they cost a memory load and
+ * every consumer sees the same value.
+ *
+ * IterativeRobotBase starts a new loop at the beginning of each LoopFunc();
+ * other robot bases can call StartLoop() themselves. Only reads on the thread
+ * that started the loop are cached: reads on other threads, such as a
+ * PIDController's, always read the sensor. Resetting or reconfiguring a
+ * sensor drops its latched values.
+ *
+ * The cache is off by default. Encoder, AnalogInput, AnalogGyro and
+ * DigitalInput values are cached.
+ */
+class ReadCache {
+ public:
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  static void StartLoop();
+  static uint64_t GetLoop();
+  // Whether reads on this thread are being cached
+  static bool IsCaching() { return IsEnabled() && GetLoop() != 0; }
+
+ private:
+  static std::atomic<bool> s_enabled;
+};
+
+/**
+ * A sensor value latched by the ReadCache.
+ */
+template <typename T>
+class CachedRead {
+ public:
+  /**
+   * Returns the value latched in this loop, calling read() to latch it if
+   * there is none, or just calls read() if reads are not being cached on
+   * this thread.
+   */
+  template <typename F>
+  T Get(F&& read) const {
+    uint64_t loop = ReadCache::IsEnabled() ? ReadCache::GetLoop() : 0;
+    if (loop == 0) return read();
+    if (m_loop.load(std::memory_order_relaxed) != loop) {
+      m_value = read();
+      m_loop.store(loop, std::memory_order_relaxed);
+    }
+    return m_value;
+  }
+
+  // Drops the latched value, so the next read reads the sensor
+  void Invalidate() { m_loop.store(0, std::memory_order_relaxed); }
+
+ private:
+  // Only the loop thread uses the value
+  mutable T m_value{};
+  // the loop the value was latched in, or 0 if none
+  mutable std::atomic<uint64_t> m_loop{0};
+};
+
+}  // namespace frc
@@ -9,10 +9,12 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <llvm/ArrayRef.h>
 #include <support/mutex.h>
 
 #include "ErrorBase.h"
@@ -28,6 +30,10 @@ namespace frc {
  * The Resource class does not allocate the hardware channels or other
  * resources; it just tracks which indices were marked in use by Allocate and
  * not yet freed by Free.
+ *
+ * The allocation state is a bitset of atomic words, so allocating and freeing
+ * never lock: a free index is found by counting the trailing ones of a word
+ * and claimed with a compare and swap.
  */
 class Resource : public ErrorBase {
  public:
@@ -41,11 +47,19 @@ class Resource : public ErrorBase {
   explicit Resource(uint32_t size);
   uint32_t Allocate(const std::string& resourceDesc);
   uint32_t Allocate(uint32_t index, const std::string& resourceDesc);
+  std::vector<uint32_t> AllocateBatch(uint32_t count,
+                                      const std::string& resourceDesc);
   void Free(uint32_t index);
+  void FreeBatch(llvm::ArrayRef<uint32_t> indices);
 
  private:
-  std::vector<bool> m_isAllocated;
-  wpi::mutex m_allocateMutex;
+  static constexpr uint32_t kWordBits = 64;
+
+  // Bit i of word i / kWordBits is set while index i is allocated; the bits
+  // past the last index are always set
+  std::unique_ptr<std::atomic<uint64_t>[]> m_words;
+  uint32_t m_wordCount;
+  uint32_t m_size;
 
   static wpi::mutex m_createMutex;
 };
@@ -9,6 +9,15 @@
 
 #include <stdint.h>
 
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <HAL/BusStatistics.h>
+#include <HAL/PerfCounters.h>
+#include <HAL/Power.h>
+
 namespace frc {
 
 struct CANStatus {
@@ -19,12 +28,72 @@ struct CANStatus {
   int transmitErrorCount;
 };
 
+// CPU time of one thread of the robot program over the latest sample period
+struct ThreadCPULoad {
+  std::string name;
+  int id = 0;
+  // percent of one core
+  double percent = 0;
+};
+
+// Rolling statistics from RobotController::StartHealthSampling(). Averages,
+// maximums and minimums are over the latest samples in the sampler's window.
+struct RobotHealth {
+  uint64_t sampleCount = 0;
+
+  // percent of all cores
+  double cpuPercent = 0;
+  double averageCPUPercent = 0;
+  double maxCPUPercent = 0;
+  // busiest first
+  std::vector<ThreadCPULoad> threads;
+
+  // bytes
+  uint64_t memoryTotal = 0;
+  uint64_t memoryAvailable = 0;
+  uint64_t minMemoryAvailable = 0;
+  uint64_t processMemory = 0;
+
+  // how late the sampler thread woke up, in seconds
+  double wakeupLatency = 0;
+  double averageWakeupLatency = 0;
+  double maxWakeupLatency = 0;
+
+  double averageCANUtilization = 0;
+  double maxCANUtilization = 0;
+  CANStatus can = {};
+};
+
+// The latest values from RobotController::StartBrownoutPrediction()
+struct BrownoutPrediction {
+  uint64_t sampleCount = 0;
+  HAL_PowerSnapshot power = {};
+
+  // the filtered input voltage, in volts, and its slope in volts per second
+  double voltage = 0;
+  double voltageSlope = 0;
+  // seconds until the input voltage falls to the brownout voltage at its
+  // current slope; infinite while it isn't falling, and 0 once it's there
+  double timeToBrownout = std::numeric_limits<double>::infinity();
+};
+
+// The classes of devices logged by RobotController::EnableDeviceLogging()
+enum class DeviceLogClass {
+  kEncoder,
+  kAnalogInput,
+  kPWM,
+  kSolenoid,
+  kDriverStation,
+  kPowerDistributionPanel
+};
+
 class RobotController {
  public:
   RobotController() = delete;
   static int GetFPGAVersion();
   static int64_t GetFPGARevision();
   static uint64_t GetFPGATime();
+  static uint64_t GetFPGATimeFast();
   static bool GetUserButton();
   static bool IsSysActive();
   static bool IsBrownedOut();
@@ -42,6 +111,24 @@ class RobotController {
   static double GetCurrent6V();
   static bool GetEnabled6V();
   static int GetFaultCount6V();
+  static HAL_PowerSnapshot GetPowerSnapshot();
+  static void StartBrownoutPrediction(double period = 0.005,
+                                      double timeConstant = 0.02);
+  static void StopBrownoutPrediction();
+  static BrownoutPrediction GetBrownoutPrediction();
   static CANStatus GetCANStatus();
+  static void SetPerfCountersEnabled(bool enabled);
+  static std::array<HAL_PerfCounter, HAL_kPerfCounterCount> GetPerfCounters();
+  static void ResetPerfCounterMaximums();
+  static void SetBusStatisticsEnabled(bool enabled);
+  static std::vector<HAL_BusStatistics> GetBusStatistics();
+  static void ResetBusStatistics();
+  static void EnableDeviceLogging(bool enabled = true);
+  static bool IsDeviceLoggingEnabled();
+  static void SetDeviceLoggingDecimation(DeviceLogClass deviceClass,
+                                         int decimation);
+  static void StartHealthSampling(double period = 1.0);
+  static void StopHealthSampling();
+  static RobotHealth GetHealth();
 };
 }  // namespace frc
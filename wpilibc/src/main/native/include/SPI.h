@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 
+#include <functional>
 #include <memory>
 
 #include <llvm/ArrayRef.h>
@@ -32,6 +33,24 @@ class SPI : public ErrorBase {
  public:
   enum Port { kOnboardCS0 = 0, kOnboardCS1, kOnboardCS2, kOnboardCS3, kMXP };
 
+  /**
+   * One segment of a TransactionBatch(). Either buffer may be null to only
+   * receive or only send.
+   */
+  // Receives one accumulator transfer and its FPGA timestamp (microseconds)
+  using AccumulatorDecoder =
+      std::function<void(llvm::ArrayRef<uint8_t> transfer, uint64_t timestamp)>;
+
+  struct Transfer {
+    const uint8_t* dataToSend;
+    uint8_t* dataReceived;
+    int size;
+    // Deselect the chip between this segment and the next
+    bool csChange;
+    // Delay after this segment, in microseconds
+    int delay;
+  };
+
   explicit SPI(Port port);
   ~SPI() override;
 
@@ -55,6 +74,7 @@ class SPI : public ErrorBase {
   virtual int Write(uint8_t* data, int size);
   virtual int Read(bool initiate, uint8_t* dataReceived, int size);
   virtual int Transaction(uint8_t* dataToSend, uint8_t* dataReceived, int size);
+  int TransactionBatch(llvm::ArrayRef<Transfer> transfers);
 
   void InitAuto(int bufferSize);
   void FreeAuto();
@@ -69,6 +89,10 @@ class SPI : public ErrorBase {
   void InitAccumulator(double period, int cmd, int xferSize, int validMask,
                        int validValue, int dataShift, int dataSize,
                        bool isSigned, bool bigEndian);
+  void InitAccumulator(DigitalSource& dataReady, bool rising, double period,
+                       int cmd, int xferSize, int validMask, int validValue,
+                       int dataShift, int dataSize, bool isSigned,
+                       bool bigEndian);
   void FreeAccumulator();
   void ResetAccumulator();
   void SetAccumulatorCenter(int center);
@@ -78,6 +102,7 @@ class SPI : public ErrorBase {
   int64_t GetAccumulatorCount() const;
   double GetAccumulatorAverage() const;
   void GetAccumulatorOutput(int64_t& value, int64_t& count) const;
+  void SetAccumulatorDecoder(AccumulatorDecoder decoder);
 
  protected:
   HAL_SPIPort m_port;
@@ -87,6 +112,10 @@ class SPI : public ErrorBase {
 
  private:
   void Init();
+  void InitAccumulator(DigitalSource* dataReady, bool rising, double period,
+                       int cmd, int xferSize, int validMask, int validValue,
+                       int dataShift, int dataSize, bool isSigned,
+                       bool bigEndian);
 
   class Accumulator;
   std::unique_ptr<Accumulator> m_accum;
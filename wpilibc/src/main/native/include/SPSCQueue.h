@@ -0,0 +1,100 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+#include <atomic>
+
+#include "Internal/CacheLine.h"
+
+namespace frc {
+
+/**
+ * A bounded lock-free queue for handing values from one thread to another.
+ *
+ * Neither side ever blocks or allocates: Push() fails when the queue is full,
+ * and Pop() when it is empty. The producer and consumer indexes are on their
+ * own cache lines, and each side caches the other's index, so an uncontended
+ * push or pop touches one shared cache line.
+ *
+ * Only one thread may push and only one may pop.
+ *
+ * @tparam T The element type, which is copied in and out
+ * @tparam N The capacity, a power of two
+ */
+template <typename T, size_t N>
+class SPSCQueue {
+  static_assert(N > 0 && (N & (N - 1)) == 0,
+                "the capacity must be a power of two");
+
+ public:
+  SPSCQueue() = default;
+
+  SPSCQueue(const SPSCQueue&) = delete;
+  SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+  /**
+   * Appends a value; called only by the producer.
+   *
+   * @return False, without appending, if the queue is full.
+   */
+  bool Push(const T& value) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_cachedHead == N) {
+      m_cachedHead = m_head.load(std::memory_order_acquire);
+      if (tail - m_cachedHead == N) return false;
+    }
+    m_slots[tail & (N - 1)] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Removes the oldest value; called only by the consumer.
+   *
+   * @return False, leaving value unchanged, if the queue is empty.
+   */
+  bool Pop(T* value) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head == m_cachedTail) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+      if (head == m_cachedTail) return false;
+    }
+    *value = m_slots[head & (N - 1)];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // The number of values queued; exact only when called by either side
+  size_t Size() const {
+    return m_tail.load(std::memory_order_acquire) -
+           m_head.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t Capacity() { return N; }
+
+ private:
+  char m_padding0[detail::kCacheLineSize];
+
+  // Next slot to pop, and the tail as the consumer last saw it
+  std::atomic<size_t> m_head{0};
+  size_t m_cachedTail = 0;
+  char m_padding1[detail::kCacheLineSize];
+
+  // Next slot to push, and the head as the producer last saw it
+  std::atomic<size_t> m_tail{0};
+  size_t m_cachedHead = 0;
+  char m_padding2[detail::kCacheLineSize];
+
+  std::array<T, N> m_slots;
+  char m_padding3[detail::kCacheLineSize];
+};
+
+}  // namespace frc
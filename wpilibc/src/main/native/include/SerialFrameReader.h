@@ -0,0 +1,88 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <llvm/ArrayRef.h>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+class SerialPort;
+
+/**
+ * Reads a serial port from a background thread and hands complete frames to
+ * a callback.
+ *
+ * Received bytes are appended to a buffer owned by the reader thread. After
+ * each read a splitter finds the complete frames at the front of the buffer,
+ * and the handler is called with a view of each frame inside the buffer, so
+ * frames are never copied. Only the bytes of an unfinished frame are moved
+ * back to the front of the buffer.
+ *
+ * The handler runs on the reader thread and must not keep the frame view after
+ * it returns. While a reader is attached, the port must not be read from
+ * anywhere else. Stopping waits for the current read to time out, so keep the
+ * port timeout (SerialPort::SetTimeout()) short.
+ */
+class SerialFrameReader : public ErrorBase {
+ public:
+  /**
+   * Finds the first frame in data.
+   *
+   * Returns the number of bytes the frame occupies, or 0 if data does not yet
+   * hold a complete frame. Sets frame to the payload, which may be decoded in
+   * place in data. Leaving frame empty discards the consumed bytes.
+   */
+  using Splitter = std::function<size_t(llvm::MutableArrayRef<uint8_t> data,
+                                        llvm::ArrayRef<uint8_t>& frame)>;
+  using FrameHandler = std::function<void(llvm::ArrayRef<uint8_t> frame)>;
+
+  static Splitter DelimiterSplitter(uint8_t delimiter = '\n');
+  static Splitter LengthPrefixSplitter(int prefixSize = 1);
+  static Splitter COBSSplitter();
+
+  SerialFrameReader(SerialPort& port, Splitter splitter, FrameHandler handler,
+                    int bufferSize = 4096);
+  ~SerialFrameReader() override;
+
+  SerialFrameReader(const SerialFrameReader&) = delete;
+  SerialFrameReader& operator=(const SerialFrameReader&) = delete;
+
+  void Stop();
+
+  int64_t GetFrameCount() const;
+  int64_t GetDroppedBytes() const;
+
+ private:
+  void ThreadMain();
+  void Split();
+
+  int m_port;
+  bool m_osBackend;
+  Splitter m_splitter;
+  FrameHandler m_handler;
+
+  // only touched by the reader thread
+  std::vector<uint8_t> m_buffer;
+  size_t m_size = 0;
+
+  std::atomic<int64_t> m_frameCount{0};
+  std::atomic<int64_t> m_droppedBytes{0};
+  std::atomic_bool m_active{true};
+  std::thread m_thread;
+};
+
+}  // namespace frc
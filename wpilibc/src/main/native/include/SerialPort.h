@@ -27,6 +27,13 @@ namespace frc {
  *   http://www.ni.com/pdf/manuals/370423a.pdf
  * and the NI-VISA Programmer's Reference Manual here:
  *   http://www.ni.com/pdf/manuals/370132c.pdf
+ *
+ * The kBackend_OS backend instead drives the port's termios device directly.
+ * Each call then costs one system call rather than a VISA session, USB ports
+ * are put in low latency mode, consecutive writes in kFlushWhenFull mode are
+ * coalesced into one writev(), and GetFileDescriptor() gives a descriptor to
+ * wait on with poll(). It supports neither 1.5 stop bits nor DTR/DSR flow
+ * control.
  */
 class SerialPort : public ErrorBase {
  public:
@@ -55,8 +62,11 @@ class SerialPort : public ErrorBase {
 
   enum Port { kOnboard = 0, kMXP = 1, kUSB = 2, kUSB1 = 2, kUSB2 = 3 };
 
+  enum Backend { kBackend_VISA = 0, kBackend_OS = 1 };
+
   SerialPort(int baudRate, Port port = kOnboard, int dataBits = 8,
-             Parity parity = kParity_None, StopBits stopBits = kStopBits_One);
+             Parity parity = kParity_None, StopBits stopBits = kStopBits_One,
+             Backend backend = kBackend_VISA);
   WPI_DEPRECATED("Will be removed for 2019")
   SerialPort(int baudRate, llvm::StringRef portName, Port port = kOnboard,
              int dataBits = 8, Parity parity = kParity_None,
@@ -79,12 +89,17 @@ class SerialPort : public ErrorBase {
   void SetWriteBufferMode(WriteBufferMode mode);
   void Flush();
   void Reset();
+  void SetLowLatency(bool lowLatency);
+  int GetFileDescriptor();
 
  private:
+  friend class SerialFrameReader;
+
   int m_resourceManagerHandle = 0;
   int m_portHandle = 0;
   bool m_consoleModeEnabled = false;
   int m_port;
+  Backend m_backend = kBackend_VISA;
 };
 
 }  // namespace frc
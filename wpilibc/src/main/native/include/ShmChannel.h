@@ -0,0 +1,179 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <type_traits>
+
+#include <llvm/StringRef.h>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+/**
+ * Non-template base class for ShmPublisher and ShmSubscriber.
+ *
+ * A channel is a POSIX shared memory object, "/frc_" followed by the channel
+ * name, holding a ring of fixed-size message slots and a doorbell. It has one
+ * publisher, which writes each message straight into the next slot, and any
+ * number of subscribers in this or other processes, which copy messages out
+ * of the slots under a per-slot seqlock. Neither side ever waits on the
+ * other: a subscriber that falls more than a ring behind loses the oldest
+ * messages, and counts them.
+ *
+ * The doorbell is a futex in the shared memory, so a subscriber waiting for
+ * a message is woken directly by the publisher's system call, in
+ * microseconds, without a socket or serialization in between. On systems
+ * other than Linux waiting subscribers poll instead. Shared memory is not
+ * supported on Windows.
+ *
+ * The publisher creates the channel, and reuses it if a channel of the same
+ * message size and depth is left from an earlier run, so subscribers keep
+ * their place when the publisher restarts. Subscribers attach to the channel
+ * once it has been created; until then they receive no messages.
+ */
+class ShmChannelBase : public ErrorBase {
+ public:
+  static constexpr int kDefaultDepth = 8;
+
+  ~ShmChannelBase() override;
+
+  ShmChannelBase(const ShmChannelBase&) = delete;
+  ShmChannelBase& operator=(const ShmChannelBase&) = delete;
+
+  bool IsAttached();
+  uint64_t GetPublishedCount();
+  uint64_t GetLostCount() const;
+
+ protected:
+  ShmChannelBase(llvm::StringRef name, size_t messageSize, int depth,
+                 bool publisher);
+
+  // Returns the slot of the next message, or null if the channel isn't
+  // mapped; EndWrite() publishes it
+  void* BeginWrite();
+  void EndWrite();
+
+  // Copy a message into data; return false if there is none
+  bool ReadNext(void* data);
+  bool ReadLatest(void* data);
+  // Waits until a message after the last one read is published
+  bool WaitForNext(double timeout);
+
+ private:
+  struct Header;
+  struct Slot;
+
+  bool Create();
+  bool Attach();
+  Slot* GetSlot(uint64_t message) const;
+  bool ReadMessage(uint64_t message, void* data) const;
+
+  std::string m_name;
+  size_t m_messageSize;
+  size_t m_slotStride;
+  uint32_t m_depth;
+  bool m_publisher;
+  size_t m_size;
+  Header* m_header = nullptr;
+  uint8_t* m_slots = nullptr;
+  // the next message to read, or to write
+  uint64_t m_next = 0;
+  uint64_t m_lost = 0;
+};
+
+/**
+ * Publishes messages of type T to a shared memory channel.
+ *
+ * T is copied byte for byte, so it must be trivially copyable and contain no
+ * pointers; a large buffer is a struct with a fixed-size array. Use
+ * BeginPublish() and EndPublish() to build a message in place in the shared
+ * memory rather than copying it there.
+ *
+ * @see ShmChannelBase
+ */
+template <typename T>
+class ShmPublisher : public ShmChannelBase {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "shared memory messages must be trivially copyable");
+  static_assert(alignof(T) <= 8,
+                "shared memory messages are only 8 byte aligned");
+
+ public:
+  explicit ShmPublisher(llvm::StringRef name, int depth = kDefaultDepth)
+      : ShmChannelBase(name, sizeof(T), depth, true) {}
+
+  /**
+   * Publishes a copy of a message.
+   */
+  void Publish(const T& value) {
+    if (T* message = BeginPublish()) {
+      *message = value;
+      EndPublish();
+    }
+  }
+
+  /**
+   * Returns the next message, to be filled in in shared memory and published
+   * with EndPublish(), or null if the channel couldn't be created. Its
+   * contents are those of an older message.
+   */
+  T* BeginPublish() { return static_cast<T*>(BeginWrite()); }
+
+  void EndPublish() { EndWrite(); }
+};
+
+/**
+ * Receives messages of type T from a shared memory channel.
+ *
+ * Typically polled with GetLatest() from robot code or a VisionRunner
+ * listener, or read in order with WaitForNext() on a dedicated thread.
+ *
+ * @see ShmChannelBase
+ */
+template <typename T>
+class ShmSubscriber : public ShmChannelBase {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "shared memory messages must be trivially copyable");
+  static_assert(alignof(T) <= 8,
+                "shared memory messages are only 8 byte aligned");
+
+ public:
+  explicit ShmSubscriber(llvm::StringRef name, int depth = kDefaultDepth)
+      : ShmChannelBase(name, sizeof(T), depth, false) {}
+
+  /**
+   * Gets the next message not yet read, in the order published.
+   *
+   * @return False if every published message has been read
+   */
+  bool GetNext(T& value) { return ReadNext(&value); }
+
+  /**
+   * Gets the newest message, skipping any not yet read.
+   *
+   * @return False if nothing new has been published since the last read
+   */
+  bool GetLatest(T& value) { return ReadLatest(&value); }
+
+  /**
+   * Waits for the next message not yet read and gets it.
+   *
+   * @param timeout The longest time to wait, in seconds
+   * @return False if no message was published before the timeout
+   */
+  bool WaitForNext(T& value, double timeout) {
+    return ShmChannelBase::WaitForNext(timeout) && ReadNext(&value);
+  }
+};
+
+}  // namespace frc
@@ -181,7 +181,9 @@ class SendableBuilderImpl : public SendableBuilder {
 
     nt::NetworkTableEntry entry;
     NT_EntryListener listener = 0;
-    std::function<void(nt::NetworkTableEntry entry, uint64_t time)> update;
+    // force is set when the value must be published even if unchanged
+    std::function<void(nt::NetworkTableEntry entry, uint64_t time, bool force)>
+        update;
     std::function<NT_EntryListener(nt::NetworkTableEntry entry)> createListener;
   };
 
@@ -189,6 +191,7 @@ class SendableBuilderImpl : public SendableBuilder {
   std::function<void()> m_safeState;
   std::function<void()> m_updateTable;
   std::shared_ptr<nt::NetworkTable> m_table;
+  bool m_forceUpdate = true;
 };
 
 }  // namespace frc
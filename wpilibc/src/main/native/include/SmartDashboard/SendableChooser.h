@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <string>
 
 #include <llvm/StringMap.h>
 #include <llvm/StringRef.h>
@@ -26,6 +29,11 @@ namespace frc {
  * to have a list of options appear on the laptop. Once autonomous starts,
  * simply ask the SendableChooser what the selected value is.
  *
+ * The chooser listens for the dashboard's selection, so GetSelected() only
+ * reads a cached pointer and is cheap enough to call every loop. OnChange()
+ * runs a callback whenever the selection changes, for example to build the
+ * selected autonomous command while the robot is disabled.
+ *
  * @tparam T The type of values to be stored
  * @see SmartDashboard
  */
@@ -43,14 +51,32 @@ class SendableChooser : public SendableChooserBase {
   static std::weak_ptr<U> _unwrap_smart_ptr(const std::shared_ptr<U>& value);
 
  public:
-  ~SendableChooser() override = default;
+  using Selected = decltype(_unwrap_smart_ptr(m_choices[""]));
+
+  ~SendableChooser() override;
 
   void AddObject(llvm::StringRef name, T object);
   void AddDefault(llvm::StringRef name, T object);
 
   auto GetSelected() -> decltype(_unwrap_smart_ptr(m_choices[""]));
 
+  void OnChange(std::function<void(Selected)> callback);
+
   void InitSendable(SendableBuilder& builder) override;
+
+ protected:
+  void UpdateSelection(llvm::StringRef selected) override;
+
+ private:
+  void Select(std::unique_lock<wpi::mutex>& lock, bool replaced = false);
+
+  // The name the dashboard selected, empty for none
+  std::string m_selectedName;
+
+  // Points into m_choices, whose elements never move; null for none
+  std::atomic<const T*> m_selected{nullptr};
+
+  std::function<void(Selected)> m_onChange;
 };
 
 }  // namespace frc
@@ -9,7 +9,9 @@
 
 #include <string>
 
+#include <llvm/StringRef.h>
 #include <networktables/NetworkTableEntry.h>
+#include <support/mutex.h>
 
 #include "SmartDashboard/SendableBase.h"
 
@@ -27,12 +29,26 @@ class SendableChooserBase : public SendableBase {
   ~SendableChooserBase() override = default;
 
  protected:
+  void SetSelectedEntry(nt::NetworkTableEntry entry);
+  void RemoveSelectionListener();
+
+  /**
+   * Called with the name of the selected option whenever it changes, and
+   * with an empty name when the dashboard has selected nothing. Runs on the
+   * NetworkTables listener thread or the caller of SetSelectedEntry().
+   */
+  virtual void UpdateSelection(llvm::StringRef selected) = 0;
+
   static const char* kDefault;
   static const char* kOptions;
   static const char* kSelected;
 
   std::string m_defaultChoice;
   nt::NetworkTableEntry m_selectedEntry;
+  NT_EntryListener m_selectionListener = 0;
+
+  // Serializes selection updates with changes to the options
+  wpi::mutex m_mutex;
 };
 
 }  // namespace frc
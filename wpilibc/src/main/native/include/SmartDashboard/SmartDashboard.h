@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 
+#include <networktables/NetworkTableEntry.h>
 #include <networktables/NetworkTableValue.h>
 
 #include "SensorBase.h"
@@ -25,6 +26,8 @@ class SmartDashboard : public SensorBase {
 
   static bool ContainsKey(llvm::StringRef key);
 
+  static nt::NetworkTableEntry GetEntry(llvm::StringRef key);
+
   static std::vector<std::string> GetKeys(int types = 0);
 
   static void SetPersistent(llvm::StringRef key);
@@ -86,6 +89,9 @@ class SmartDashboard : public SensorBase {
 
   static void UpdateValues();
 
+  static void BeginTransaction();
+  static void CommitTransaction();
+
  private:
   virtual ~SmartDashboard() = default;
 };
@@ -0,0 +1,109 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <llvm/StringRef.h>
+#include <networktables/NetworkTableEntry.h>
+
+#include "DataLog.h"
+#include "SmartDashboard/SendableBuilder.h"
+
+namespace frc {
+
+/**
+ * A field of a struct published by a TelemetryStruct: a key and a pointer to
+ * a double, bool or int member.
+ */
+template <typename T>
+class TelemetryField {
+ public:
+  TelemetryField(llvm::StringRef name, double T::*member)
+      : m_name(name), m_type(kDouble), m_double(member) {}
+  TelemetryField(llvm::StringRef name, bool T::*member)
+      : m_name(name), m_type(kBoolean), m_boolean(member) {}
+  TelemetryField(llvm::StringRef name, int T::*member)
+      : m_name(name), m_type(kInteger), m_integer(member) {}
+
+ private:
+  template <typename U>
+  friend class TelemetryStruct;
+
+  enum Type { kDouble, kBoolean, kInteger };
+
+  std::string m_name;
+  Type m_type;
+  double T::*m_double = nullptr;
+  bool T::*m_boolean = nullptr;
+  int T::*m_integer = nullptr;
+};
+
+/**
+ * Publishes the fields of a struct to the SmartDashboard, listing the fields
+ * once instead of writing a Put call with a key for each.
+ *
+ * The entries are looked up when the TelemetryStruct is constructed, so
+ * Publish() does no string work. While the DataLog is running, Publish() also
+ * appends each field to the log under the same key.
+ *
+ * @code
+ * struct DriveState {
+ *   double leftVelocity;
+ *   double rightVelocity;
+ *   bool highGear;
+ * };
+ *
+ * TelemetryStruct<DriveState> telemetry(
+ *     "Drive", {{"LeftVel", &DriveState::leftVelocity},
+ *               {"RightVel", &DriveState::rightVelocity},
+ *               {"HighGear", &DriveState::highGear}});
+ *
+ * telemetry.Publish(state);  // Drive/LeftVel, Drive/RightVel, ...
+ * @endcode
+ */
+template <typename T>
+class TelemetryStruct {
+ public:
+  TelemetryStruct(llvm::StringRef prefix,
+                  std::initializer_list<TelemetryField<T>> fields);
+
+  TelemetryStruct(const TelemetryStruct&) = delete;
+  TelemetryStruct& operator=(const TelemetryStruct&) = delete;
+
+  void Publish(const T& value);
+  void AddProperties(SendableBuilder& builder, std::function<T()> getter);
+
+ private:
+  struct Field {
+    explicit Field(const TelemetryField<T>& field_) : field(field_) {}
+
+    TelemetryField<T> field;
+    std::string key;
+    nt::NetworkTableEntry entry;
+    // the one matching the type of the field
+    std::unique_ptr<DoubleLogEntry> doubleLog;
+    std::unique_ptr<BooleanLogEntry> booleanLog;
+    std::unique_ptr<IntegerLogEntry> integerLog;
+  };
+
+  void StartLog();
+
+  std::vector<Field> m_fields;
+  bool m_logStarted = false;
+};
+
+}  // namespace frc
+
+#include "SmartDashboard/TelemetryStruct.inc"
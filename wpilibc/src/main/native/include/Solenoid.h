@@ -9,6 +9,7 @@
 
 #include <HAL/Types.h>
 
+#include "Internal/DeviceLog.h"
 #include "SolenoidBase.h"
 
 namespace frc {
@@ -35,6 +36,7 @@ class Solenoid : public SolenoidBase {
  private:
   HAL_SolenoidHandle m_solenoidHandle = HAL_kInvalidHandle;
   int m_channel;  // The channel on the module to control
+  DeviceLogSignal<BooleanLogEntry> m_log;
 };
 
 }  // namespace frc
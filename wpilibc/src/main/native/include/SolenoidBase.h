@@ -18,8 +18,29 @@ namespace frc {
  */
 class SolenoidBase : public ErrorBase, public SendableBase {
  public:
+  /**
+   * Holds solenoid changes on one PCM while in scope, then sends them all in a
+   * single control frame update.
+   *
+   * Solenoids set within the scope of a Transaction change together instead
+   * of one control frame update per Set() call.
+   */
+  class Transaction {
+   public:
+    explicit Transaction(int module);
+    ~Transaction();
+
+    Transaction(const Transaction&) = delete;
+    Transaction& operator=(const Transaction&) = delete;
+
+   private:
+    int m_module;
+  };
+
   static int GetAll(int module);
   int GetAll() const;
+  static void SetAll(int module, int values, int mask);
+  void SetAll(int values, int mask = 0xFF);
 
   static int GetPCMSolenoidBlackList(int module);
   int GetPCMSolenoidBlackList() const;
@@ -0,0 +1,60 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <string>
+
+#include <llvm/StringRef.h>
+
+namespace frc {
+
+/**
+ * Records how long each phase of robot program startup takes, from the start
+ * of RobotBase construction until the robot tells the driver station it is
+ * ready.
+ *
+ * RobotBase and the robot classes mark their own phases. Operations known to
+ * be slow, such as gyro calibration and USB camera enumeration, time
+ * themselves with a Scope, and a warning names any that take longer than
+ * kSlowOperation so they can be moved off the startup path. When startup
+ * finishes the timings are printed, written to kFile and published to the
+ * kTable NetworkTables table, in seconds.
+ *
+ * Once startup has finished, recording does nothing.
+ */
+class StartupProfiler {
+ public:
+  static constexpr double kSlowOperation = 0.25;
+  static const char* kFile;
+  static const char* kTable;
+
+  /**
+   * Times an operation from construction to destruction.
+   */
+  class Scope {
+   public:
+    Scope(llvm::StringRef name, const char* hint = nullptr);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    std::string m_name;
+    const char* m_hint;
+    double m_start;
+  };
+
+  static void Mark(llvm::StringRef phase);
+  static void Record(llvm::StringRef name, double start, double duration,
+                     const char* hint = nullptr);
+  static void Finish();
+  static bool IsFinished();
+};
+
+}  // namespace frc
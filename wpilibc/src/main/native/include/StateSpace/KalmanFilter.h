@@ -0,0 +1,68 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include "StateSpace/LinearSystem.h"
+#include "StateSpace/Matrix.h"
+
+namespace frc {
+
+/**
+ * A Kalman filter, which estimates the state of a plant from its inputs and
+ * noisy measurements of its outputs.
+ *
+ * Each control loop calls Predict() with the inputs applied, then Correct()
+ * with the latest measurements, for example encoder and gyro readings and a
+ * vision pose. The error covariance is propagated every step, so the filter
+ * weights each measurement by how much it is trusted. A step costs a fixed
+ * number of small matrix products and one solve of an Outputs x Outputs
+ * system, with no allocation, so it can run from a fast Notifier.
+ *
+ * @tparam States  The number of states
+ * @tparam Inputs  The number of inputs
+ * @tparam Outputs The number of outputs
+ */
+template <size_t States, size_t Inputs, size_t Outputs>
+class KalmanFilter {
+ public:
+  KalmanFilter(const LinearSystem<States, Inputs, Outputs>& plant,
+               const Matrix<States, States>& Q,
+               const Matrix<Outputs, Outputs>& R);
+
+  static Matrix<States, States> MakeProcessNoise(
+      const std::array<double, States>& stdDevs);
+  static Matrix<Outputs, Outputs> MakeMeasurementNoise(
+      const std::array<double, Outputs>& stdDevs);
+
+  void Predict(const Vector<Inputs>& u);
+  bool Correct(const Vector<Inputs>& u, const Vector<Outputs>& y);
+
+  const Vector<States>& Xhat() const { return m_xHat; }
+  double Xhat(size_t index) const { return m_xHat(index); }
+  void SetXhat(const Vector<States>& xHat) { m_xHat = xHat; }
+
+  const Matrix<States, States>& P() const { return m_P; }
+  void SetP(const Matrix<States, States>& P) { m_P = P; }
+
+  void Reset();
+
+ private:
+  const LinearSystem<States, Inputs, Outputs>& m_plant;
+  Matrix<States, States> m_Q;
+  Matrix<Outputs, Outputs> m_R;
+  Vector<States> m_xHat;
+  Matrix<States, States> m_P;
+};
+
+}  // namespace frc
+
+#include "KalmanFilter.inc"
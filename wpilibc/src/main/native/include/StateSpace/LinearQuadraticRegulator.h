@@ -0,0 +1,72 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+
+#include "StateSpace/LinearSystem.h"
+#include "StateSpace/Matrix.h"
+
+namespace frc {
+
+/**
+ * A state feedback controller, u = K * (r - x), with its gain K either given
+ * or computed from a plant and the costs of state error and input.
+ *
+ * The gain is the infinite-horizon LQR gain, found by solving the discrete
+ * algebraic Riccati equation with the doubling algorithm. Computing it takes
+ * a few dozen matrix inversions, so it belongs at initialization or offline.
+ * Calculate() is only a matrix-vector product, clamped to the input limits.
+ *
+ * @tparam States The number of states
+ * @tparam Inputs The number of inputs
+ */
+template <size_t States, size_t Inputs>
+class LinearQuadraticRegulator {
+ public:
+  explicit LinearQuadraticRegulator(const Matrix<Inputs, States>& K);
+  template <size_t Outputs>
+  LinearQuadraticRegulator(const LinearSystem<States, Inputs, Outputs>& plant,
+                           const Matrix<States, States>& Q,
+                           const Matrix<Inputs, Inputs>& R);
+
+  static bool ComputeGain(const Matrix<States, States>& A,
+                          const Matrix<States, Inputs>& B,
+                          const Matrix<States, States>& Q,
+                          const Matrix<Inputs, Inputs>& R,
+                          Matrix<Inputs, States>* K);
+  static Matrix<States, States> MakeStateCost(
+      const std::array<double, States>& tolerances);
+  static Matrix<Inputs, Inputs> MakeInputCost(
+      const std::array<double, Inputs>& tolerances);
+
+  // False if the gain couldn't be computed; the gain is then 0
+  bool IsValid() const { return m_valid; }
+  const Matrix<Inputs, States>& K() const { return m_K; }
+
+  void SetInputLimits(const Vector<Inputs>& minimum,
+                      const Vector<Inputs>& maximum);
+
+  Vector<Inputs> Calculate(const Vector<States>& x, const Vector<States>& r);
+  const Vector<Inputs>& GetU() const { return m_u; }
+  void Reset() { m_u = Vector<Inputs>(); }
+
+ private:
+  Matrix<Inputs, States> m_K;
+  bool m_valid = true;
+  bool m_limited = false;
+  Vector<Inputs> m_uMin;
+  Vector<Inputs> m_uMax;
+  Vector<Inputs> m_u;
+};
+
+}  // namespace frc
+
+#include "LinearQuadraticRegulator.inc"
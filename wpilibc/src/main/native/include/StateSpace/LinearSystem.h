@@ -0,0 +1,65 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include "StateSpace/Matrix.h"
+
+namespace frc {
+
+/**
+ * A discrete linear plant model:<br>
+ *  x[k+1] = A * x[k] + B * u[k]<br>
+ *  y[k] = C * x[k] + D * u[k]
+ *
+ * where x is the state, u the inputs and y the outputs, with a fixed time
+ * step between k and k+1. Discretize() makes one from a continuous model.
+ *
+ * @tparam States  The number of states
+ * @tparam Inputs  The number of inputs
+ * @tparam Outputs The number of outputs
+ */
+template <size_t States, size_t Inputs, size_t Outputs>
+class LinearSystem {
+ public:
+  LinearSystem(const Matrix<States, States>& A,
+               const Matrix<States, Inputs>& B,
+               const Matrix<Outputs, States>& C,
+               const Matrix<Outputs, Inputs>& D, double period);
+
+  static LinearSystem Discretize(const Matrix<States, States>& contA,
+                                 const Matrix<States, Inputs>& contB,
+                                 const Matrix<Outputs, States>& C,
+                                 const Matrix<Outputs, Inputs>& D,
+                                 double period);
+
+  const Matrix<States, States>& A() const { return m_A; }
+  const Matrix<States, Inputs>& B() const { return m_B; }
+  const Matrix<Outputs, States>& C() const { return m_C; }
+  const Matrix<Outputs, Inputs>& D() const { return m_D; }
+
+  // The time step, in seconds
+  double GetPeriod() const { return m_period; }
+
+  Vector<States> CalculateX(const Vector<States>& x,
+                            const Vector<Inputs>& u) const;
+  Vector<Outputs> CalculateY(const Vector<States>& x,
+                             const Vector<Inputs>& u) const;
+
+ private:
+  Matrix<States, States> m_A;
+  Matrix<States, Inputs> m_B;
+  Matrix<Outputs, States> m_C;
+  Matrix<Outputs, Inputs> m_D;
+  double m_period;
+};
+
+}  // namespace frc
+
+#include "LinearSystem.inc"
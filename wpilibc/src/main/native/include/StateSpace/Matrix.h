@@ -0,0 +1,98 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <array>
+#include <initializer_list>
+
+namespace frc {
+
+/**
+ * A dense matrix with its dimensions fixed at compile time.
+ *
+ * Elements are stored row-major in a std::array, so matrices can live on the
+ * stack or inside other objects, and no operation allocates memory.
+ * Dimension mismatches are compile errors. The operations are meant for the
+ * small matrices of state-space models, a handful of rows and columns.
+ *
+ * @tparam Rows The number of rows
+ * @tparam Cols The number of columns
+ */
+template <size_t Rows, size_t Cols>
+class Matrix {
+  static_assert(Rows > 0 && Cols > 0, "a matrix needs at least one element");
+
+ public:
+  Matrix() { m_data.fill(0.0); }
+  Matrix(std::initializer_list<double> values);
+
+  static Matrix Zero() { return Matrix(); }
+  static Matrix Identity();
+
+  static constexpr size_t kRows = Rows;
+  static constexpr size_t kCols = Cols;
+
+  double& operator()(size_t row, size_t col) {
+    return m_data[row * Cols + col];
+  }
+  double operator()(size_t row, size_t col) const {
+    return m_data[row * Cols + col];
+  }
+
+  // Element access for column vectors
+  double& operator()(size_t index) { return m_data[index]; }
+  double operator()(size_t index) const { return m_data[index]; }
+
+  Matrix<Cols, Rows> Transpose() const;
+  Matrix operator-() const;
+
+  Matrix& operator+=(const Matrix& rhs);
+  Matrix& operator-=(const Matrix& rhs);
+  Matrix& operator*=(double rhs);
+
+  double Norm() const;
+
+  const double* data() const { return m_data.data(); }
+
+ private:
+  std::array<double, Rows * Cols> m_data;
+};
+
+// Column vectors
+template <size_t Size>
+using Vector = Matrix<Size, 1>;
+
+template <size_t Rows, size_t Cols>
+Matrix<Rows, Cols> operator+(Matrix<Rows, Cols> lhs,
+                             const Matrix<Rows, Cols>& rhs);
+template <size_t Rows, size_t Cols>
+Matrix<Rows, Cols> operator-(Matrix<Rows, Cols> lhs,
+                             const Matrix<Rows, Cols>& rhs);
+template <size_t Rows, size_t Cols>
+Matrix<Rows, Cols> operator*(Matrix<Rows, Cols> lhs, double rhs);
+template <size_t Rows, size_t Cols>
+Matrix<Rows, Cols> operator*(double lhs, Matrix<Rows, Cols> rhs);
+template <size_t Rows, size_t Inner, size_t Cols>
+Matrix<Rows, Cols> operator*(const Matrix<Rows, Inner>& lhs,
+                             const Matrix<Inner, Cols>& rhs);
+
+template <size_t Size>
+Matrix<Size, Size> Diagonal(const std::array<double, Size>& values);
+template <size_t Size>
+bool Inverse(const Matrix<Size, Size>& matrix, Matrix<Size, Size>* inverse);
+template <size_t Size, size_t Cols>
+bool Solve(const Matrix<Size, Size>& lhs, const Matrix<Size, Cols>& rhs,
+           Matrix<Size, Cols>* solution);
+template <size_t Size>
+Matrix<Size, Size> Exp(const Matrix<Size, Size>& matrix);
+
+}  // namespace frc
+
+#include "Matrix.inc"
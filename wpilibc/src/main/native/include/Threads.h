@@ -8,6 +8,9 @@
 #pragma once
 
 #include <thread>
+#include <vector>
+
+#include <HAL/Threads.h>
 
 namespace frc {
 
@@ -16,4 +19,12 @@ int GetCurrentThreadPriority(bool* isRealTime);
 bool SetThreadPriority(std::thread& thread, bool realTime, int priority);
 bool SetCurrentThreadPriority(bool realTime, int priority);
 
+using ThreadCPUUsage = HAL_ThreadCPUUsage;
+
+int GetThreadAffinity(std::thread& thread);
+bool SetThreadAffinity(std::thread& thread, int cpuMask);
+bool SetCurrentThreadAffinity(int cpuMask);
+bool LockProcessMemory(int stackPrefaultSize = 512 * 1024);
+std::vector<ThreadCPUUsage> GetThreadCPUUsage();
+
 }  // namespace frc
@@ -7,8 +7,14 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <vector>
+
+#include <support/mutex.h>
 
 #include "IterativeRobotBase.h"
 #include "Notifier.h"
@@ -22,7 +28,8 @@ namespace frc {
  * robot program.
  *
  * Periodic() functions from the base class are called on an interval by a
- * Notifier instance.
+ * Notifier instance. Callbacks added with AddPeriodic() run on the same
+ * Notifier thread.
  */
 class TimedRobot : public IterativeRobotBase {
  public:
@@ -33,15 +40,43 @@ class TimedRobot : public IterativeRobotBase {
   void SetPeriod(double seconds);
   double GetPeriod() const;
 
+  void AddPeriodic(std::function<void()> callback, double period,
+                   double offset = 0.0);
+
  protected:
   TimedRobot();
   virtual ~TimedRobot();
 
  private:
+  // Times are in integer FPGA microseconds so every call lands on an exact
+  // multiple of the period from the start of the loop
+  struct Callback {
+    // Shared so running a callback does not copy (and allocate) it
+    std::shared_ptr<std::function<void()>> func;
+    uint64_t period;
+    uint64_t offset;
+    // The absolute time of the next call
+    uint64_t expirationTime;
+  };
+
+  // Run every due callback, then wait for the next one
+  void ProcessCallbacks();
+  // Arm the notifier for the earliest callback; m_callbackMutex must be held
+  void ScheduleNext();
+  // Set the next call of a callback to its first slot after now;
+  // m_callbackMutex must be held
+  void StartCallback(Callback& callback, uint64_t now);
+
   std::atomic<double> m_period{kDefaultPeriod};
 
+  wpi::mutex m_callbackMutex;
+  // The main loop is the first callback
+  std::vector<Callback> m_callbacks;
+
   // Prevents loop from starting if user calls SetPeriod() in RobotInit()
   bool m_startLoop = false;
+  // The time the loop started, which callback offsets are relative to
+  uint64_t m_startTime = 0;
 
   std::unique_ptr<Notifier> m_loop;
 };
@@ -11,12 +11,14 @@
 #include <support/mutex.h>
 
 #include "Base.h"
+#include "Units.h"
 
 namespace frc {
 
 typedef void (*TimerInterruptHandler)(void* param);
 
 void Wait(double seconds);
+inline void Wait(units::second_t time) { Wait(time.value()); }
 WPI_DEPRECATED("Use Timer::GetFPGATimestamp() instead.")
 double GetClock();
 double GetTime();
@@ -43,8 +45,12 @@ class Timer {
   void Start();
   void Stop();
   bool HasPeriodPassed(double period);
+  bool HasPeriodPassed(units::second_t period) {
+    return HasPeriodPassed(period.value());
+  }
 
   static double GetFPGATimestamp();
+  static double GetFastTimestamp();
   static double GetMatchTime();
 
   // The time, in seconds, at which the 32-bit FPGA timestamp rolls over to 0
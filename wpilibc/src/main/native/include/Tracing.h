@@ -0,0 +1,89 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include <llvm/StringRef.h>
+
+#define FRC_TRACE_CONCAT2(a, b) a##b
+#define FRC_TRACE_CONCAT(a, b) FRC_TRACE_CONCAT2(a, b)
+
+/**
+ * Traces the rest of the enclosing scope under a name, which must be a string
+ * literal or otherwise outlive the program's traces.
+ */
+#define FRC_TRACE_SCOPE(name) \
+  ::frc::Tracing::Scope FRC_TRACE_CONCAT(frcTraceScope, __LINE__)(name)
+
+namespace frc {
+
+/**
+ * Records when named spans of robot code begin and end, for finding where
+ * loop time goes.
+ *
+ * Spans are marked with FRC_TRACE_SCOPE("Drive::Update"), which records the
+ * FPGA time at the start and end of the enclosing scope. Each thread keeps its
+ * latest kBufferSize spans in its own ring buffer, so recording takes no lock
+ * and never allocates after a thread's first span; older spans are
+ * overwritten. While tracing is disabled, which is the default, a span costs
+ * one atomic load.
+ *
+ * Dump() writes the buffered spans of every thread as a Chrome trace JSON
+ * file, which can be opened in chrome://tracing or ui.perfetto.dev. With
+ * SetDumpOnOverrun(), a trace is also written in the background each time a
+ * LoopProfiler loop overruns its period, at most once per kMinDumpPeriod.
+ */
+class Tracing {
+ public:
+  // Spans each thread keeps
+  static constexpr size_t kBufferSize = 4096;
+  // Shortest time between two traces dumped because of overruns, in seconds
+  static constexpr double kMinDumpPeriod = 10.0;
+
+  /**
+   * Records a span from construction to destruction.
+   */
+  class Scope {
+   public:
+    explicit Scope(const char* name) : m_name(name) {
+      if (IsEnabled()) m_begin = GetTime();
+    }
+    ~Scope() {
+      if (m_begin != 0) Record(m_name, m_begin, GetTime());
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    const char* m_name;
+    uint64_t m_begin = 0;
+  };
+
+  static void Enable(bool enabled = true);
+  static bool IsEnabled() {
+    return s_enabled.load(std::memory_order_relaxed);
+  }
+
+  static void Record(const char* name, uint64_t begin, uint64_t end);
+
+  static bool Dump(llvm::StringRef path);
+  static void SetDumpOnOverrun(bool dump,
+                               llvm::StringRef directory = "/home/lvuser");
+  static void ReportOverrun();
+
+ private:
+  static uint64_t GetTime();
+
+  static std::atomic<bool> s_enabled;
+};
+
+}  // namespace frc
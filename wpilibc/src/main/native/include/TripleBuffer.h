@@ -0,0 +1,110 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+#include "Internal/CacheLine.h"
+
+namespace frc {
+
+/**
+ * Hands the latest value from one thread to another without either waiting.
+ *
+ * The producer fills a back buffer and publishes it by swapping it with the
+ * middle buffer; the consumer takes the middle buffer by swapping it with its
+ * front buffer. Each swap is one atomic exchange, so a fast producer never
+ * waits for a slow consumer, and the consumer always gets the newest complete
+ * value. Values are written and read in place, so large ones, such as
+ * images, aren't copied.
+ *
+ * Only one thread may produce and only one may consume; for several readers
+ * of a small value, see SeqLock.
+ *
+ * @tparam T The value type
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  TripleBuffer() = default;
+
+  TripleBuffer(const TripleBuffer&) = delete;
+  TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+  // The buffer the producer fills before Publish()
+  T& GetWriteBuffer() { return m_buffers[m_back].value; }
+
+  /**
+   * Publishes the write buffer; called only by the producer.
+   *
+   * @return True if this replaced a value the consumer hadn't taken yet.
+   */
+  bool Publish() {
+    uint8_t old = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel);
+    m_back = old & kIndexMask;
+    return (old & kFresh) != 0;
+  }
+
+  /**
+   * Copies a value into the write buffer and publishes it.
+   *
+   * @return True if this replaced a value the consumer hadn't taken yet.
+   */
+  bool Write(const T& value) {
+    GetWriteBuffer() = value;
+    return Publish();
+  }
+
+  // Whether a value was published since the consumer last took one
+  bool HasNew() const {
+    return (m_middle.load(std::memory_order_acquire) & kFresh) != 0;
+  }
+
+  /**
+   * Takes the newest published value into the read buffer; called only by the
+   * consumer.
+   *
+   * @return False, leaving the read buffer unchanged, if nothing new was
+   *         published.
+   */
+  bool Update() {
+    if (!HasNew()) return false;
+    uint8_t old = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = old & kIndexMask;
+    return true;
+  }
+
+  // The value the consumer last took
+  T& GetReadBuffer() { return m_buffers[m_front].value; }
+
+ private:
+  static constexpr uint8_t kIndexMask = 3;
+  static constexpr uint8_t kFresh = 4;
+
+  struct Buffer {
+    T value{};
+    char padding[detail::kCacheLineSize];
+  };
+
+  char m_padding0[detail::kCacheLineSize];
+  std::array<Buffer, 3> m_buffers;
+  // Only used by the producer
+  uint8_t m_back = 0;
+  char m_padding1[detail::kCacheLineSize];
+  // The index of the middle buffer, and kFresh if it holds an untaken value
+  std::atomic<uint8_t> m_middle{1};
+  char m_padding2[detail::kCacheLineSize];
+  // Only used by the consumer
+  uint8_t m_front = 2;
+  char m_padding3[detail::kCacheLineSize];
+};
+
+}  // namespace frc
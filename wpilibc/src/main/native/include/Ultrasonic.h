@@ -12,6 +12,9 @@
 #include <thread>
 #include <vector>
 
+#include <HAL/Types.h>
+#include <llvm/ArrayRef.h>
+
 #include "Counter.h"
 #include "PIDSource.h"
 #include "SensorBase.h"
@@ -54,6 +57,11 @@ class Ultrasonic : public SensorBase, public PIDSource {
   double GetRangeMM() const;
   bool IsEnabled() const { return m_enabled; }
   void SetEnabled(bool enable) { m_enabled = enable; }
+  void SetPingGroup(int group);
+  int GetPingGroup() const;
+  void SetEchoTimeout(double seconds);
+  double GetEchoTimeout() const;
+  double GetRangeTimestamp() const;
 
   double PIDGet(PIDSourceType pidSource) override;
   void SetDistanceUnits(DistanceUnit units);
@@ -65,6 +73,8 @@ class Ultrasonic : public SensorBase, public PIDSource {
   void Initialize();
 
   static void UltrasonicChecker();
+  static void PingGroup(llvm::ArrayRef<Ultrasonic*> group);
+  void RequestEchoInterrupt();
 
   // Time (sec) for the ping trigger pulse.
   static constexpr double kPingTime = 10 * 1e-6;
@@ -72,8 +82,11 @@ class Ultrasonic : public SensorBase, public PIDSource {
   // Priority that the ultrasonic round robin task runs.
   static constexpr int kPriority = 64;
 
-  // Max time (ms) between readings.
+  // Default time (sec) to wait for an echo.
   static constexpr double kMaxUltrasonicTime = 0.1;
+
+  // Most sensors pinged together, the number of interrupts one wait can watch.
+  static constexpr int kMaxGroupSize = 8;
   static constexpr double kSpeedOfSoundInchesPerSec = 1130.0 * 12.0;
 
   // Thread doing the round-robin automatic sensing
@@ -90,6 +103,13 @@ class Ultrasonic : public SensorBase, public PIDSource {
   bool m_enabled = false;
   Counter m_counter;
   DistanceUnit m_units;
+
+  // Signals the falling edge of the echo in automatic mode, or invalid if no
+  // interrupt was free
+  HAL_InterruptHandle m_interrupt = HAL_kInvalidHandle;
+  std::atomic<int> m_pingGroup{0};
+  std::atomic<double> m_echoTimeout{kMaxUltrasonicTime};
+  std::atomic<double> m_rangeTimestamp{0.0};
 };
 
 }  // namespace frc
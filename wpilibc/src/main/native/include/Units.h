@@ -0,0 +1,216 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+namespace frc {
+namespace units {
+
+/**
+ * A quantity whose dimensions are part of its type, so mixing up units is a
+ * compile error rather than a control bug.
+ *
+ * Every quantity is stored in SI units (meters, seconds, radians), and other
+ * units only exist as constexpr factories and accessors such as feet() and
+ * to_degrees(). A conversion is then a multiplication by a constant, which the
+ * compiler folds, so typed code costs the same as the bare doubles it
+ * replaces.
+ *
+ * @tparam Length The exponent of meters
+ * @tparam Time   The exponent of seconds
+ * @tparam Angle  The exponent of radians
+ */
+template <int Length, int Time, int Angle>
+class Quantity {
+ public:
+  constexpr Quantity() : m_value(0.0) {}
+  constexpr explicit Quantity(double value) : m_value(value) {}
+
+  // The value in SI units
+  constexpr double value() const { return m_value; }
+
+  constexpr Quantity operator-() const { return Quantity(-m_value); }
+  constexpr Quantity operator+(Quantity rhs) const {
+    return Quantity(m_value + rhs.m_value);
+  }
+  constexpr Quantity operator-(Quantity rhs) const {
+    return Quantity(m_value - rhs.m_value);
+  }
+  constexpr Quantity operator*(double rhs) const {
+    return Quantity(m_value * rhs);
+  }
+  constexpr Quantity operator/(double rhs) const {
+    return Quantity(m_value / rhs);
+  }
+  // A ratio of quantities of the same dimensions is a plain number
+  constexpr double operator/(Quantity rhs) const {
+    return m_value / rhs.m_value;
+  }
+
+  Quantity& operator+=(Quantity rhs) {
+    m_value += rhs.m_value;
+    return *this;
+  }
+  Quantity& operator-=(Quantity rhs) {
+    m_value -= rhs.m_value;
+    return *this;
+  }
+  Quantity& operator*=(double rhs) {
+    m_value *= rhs;
+    return *this;
+  }
+  Quantity& operator/=(double rhs) {
+    m_value /= rhs;
+    return *this;
+  }
+
+  constexpr bool operator==(Quantity rhs) const {
+    return m_value == rhs.m_value;
+  }
+  constexpr bool operator!=(Quantity rhs) const {
+    return m_value != rhs.m_value;
+  }
+  constexpr bool operator<(Quantity rhs) const { return m_value < rhs.m_value; }
+  constexpr bool operator<=(Quantity rhs) const {
+    return m_value <= rhs.m_value;
+  }
+  constexpr bool operator>(Quantity rhs) const { return m_value > rhs.m_value; }
+  constexpr bool operator>=(Quantity rhs) const {
+    return m_value >= rhs.m_value;
+  }
+
+ private:
+  double m_value;
+};
+
+template <int L, int T, int A>
+constexpr Quantity<L, T, A> operator*(double lhs, Quantity<L, T, A> rhs) {
+  return rhs * lhs;
+}
+
+template <int L1, int T1, int A1, int L2, int T2, int A2>
+constexpr Quantity<L1 + L2, T1 + T2, A1 + A2> operator*(
+    Quantity<L1, T1, A1> lhs, Quantity<L2, T2, A2> rhs) {
+  return Quantity<L1 + L2, T1 + T2, A1 + A2>(lhs.value() * rhs.value());
+}
+
+template <int L1, int T1, int A1, int L2, int T2, int A2>
+constexpr Quantity<L1 - L2, T1 - T2, A1 - A2> operator/(
+    Quantity<L1, T1, A1> lhs, Quantity<L2, T2, A2> rhs) {
+  return Quantity<L1 - L2, T1 - T2, A1 - A2>(lhs.value() / rhs.value());
+}
+
+using meter_t = Quantity<1, 0, 0>;
+using second_t = Quantity<0, 1, 0>;
+using radian_t = Quantity<0, 0, 1>;
+using meters_per_second_t = Quantity<1, -1, 0>;
+using meters_per_second_squared_t = Quantity<1, -2, 0>;
+using radians_per_second_t = Quantity<0, -1, 1>;
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr double kMetersPerFoot = 0.3048;
+constexpr double kMetersPerInch = 0.0254;
+constexpr double kRadiansPerDegree = kPi / 180.0;
+
+// Factories from other units
+constexpr meter_t meters(double value) { return meter_t(value); }
+constexpr meter_t feet(double value) { return meter_t(value * kMetersPerFoot); }
+constexpr meter_t inches(double value) {
+  return meter_t(value * kMetersPerInch);
+}
+constexpr second_t seconds(double value) { return second_t(value); }
+constexpr second_t milliseconds(double value) {
+  return second_t(value * 1.0e-3);
+}
+constexpr second_t microseconds(double value) {
+  return second_t(value * 1.0e-6);
+}
+constexpr radian_t radians(double value) { return radian_t(value); }
+constexpr radian_t degrees(double value) {
+  return radian_t(value * kRadiansPerDegree);
+}
+constexpr radian_t rotations(double value) {
+  return radian_t(value * 2.0 * kPi);
+}
+constexpr radians_per_second_t degrees_per_second(double value) {
+  return radians_per_second_t(value * kRadiansPerDegree);
+}
+
+// Accessors in other units
+constexpr double to_feet(meter_t value) {
+  return value.value() / kMetersPerFoot;
+}
+constexpr double to_inches(meter_t value) {
+  return value.value() / kMetersPerInch;
+}
+constexpr double to_milliseconds(second_t value) {
+  return value.value() * 1.0e3;
+}
+constexpr double to_degrees(radian_t value) {
+  return value.value() / kRadiansPerDegree;
+}
+constexpr double to_rotations(radian_t value) {
+  return value.value() / (2.0 * kPi);
+}
+constexpr double to_degrees_per_second(radians_per_second_t value) {
+  return value.value() / kRadiansPerDegree;
+}
+
+/**
+ * Literals for writing constants, as in 6_in or 20_ms.
+ */
+namespace literals {
+
+constexpr meter_t operator"" _m(long double value) {
+  return meter_t(static_cast<double>(value));
+}
+constexpr meter_t operator"" _ft(long double value) {
+  return feet(static_cast<double>(value));
+}
+constexpr meter_t operator"" _in(long double value) {
+  return inches(static_cast<double>(value));
+}
+constexpr second_t operator"" _s(long double value) {
+  return second_t(static_cast<double>(value));
+}
+constexpr second_t operator"" _ms(long double value) {
+  return milliseconds(static_cast<double>(value));
+}
+constexpr radian_t operator"" _rad(long double value) {
+  return radian_t(static_cast<double>(value));
+}
+constexpr radian_t operator"" _deg(long double value) {
+  return degrees(static_cast<double>(value));
+}
+
+constexpr meter_t operator"" _m(unsigned long long value) {
+  return meter_t(static_cast<double>(value));
+}
+constexpr meter_t operator"" _ft(unsigned long long value) {
+  return feet(static_cast<double>(value));
+}
+constexpr meter_t operator"" _in(unsigned long long value) {
+  return inches(static_cast<double>(value));
+}
+constexpr second_t operator"" _s(unsigned long long value) {
+  return second_t(static_cast<double>(value));
+}
+constexpr second_t operator"" _ms(unsigned long long value) {
+  return milliseconds(static_cast<double>(value));
+}
+constexpr radian_t operator"" _rad(unsigned long long value) {
+  return radian_t(static_cast<double>(value));
+}
+constexpr radian_t operator"" _deg(unsigned long long value) {
+  return degrees(static_cast<double>(value));
+}
+
+}  // namespace literals
+
+}  // namespace units
+}  // namespace frc
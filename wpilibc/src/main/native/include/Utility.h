@@ -64,5 +64,7 @@ uint64_t GetFPGATime();
 WPI_DEPRECATED("Use RobotController static class method")
 bool GetUserButton();
 std::string GetStackTrace(int offset);
+int CaptureStackTrace(void** frames, int maxFrames, int offset);
+std::string GetStackTrace(void* const* frames, int count);
 
 }  // namespace frc
@@ -75,6 +75,10 @@ S(SmartDashboardMissingKey, -43, "SmartDashboard data does not exist");
 S(CommandIllegalUse, -50, "Illegal use of Command");
 S(UnsupportedInSimulation, -80, "Unsupported in simulation");
 S(CameraServerError, -90, "CameraServer error");
+S(ConfigFileCorrupt, -100,
+  "Config file is corrupt or has an unsupported version");
+S(TrajectoryFileError, -101,
+  "Trajectory file can't be read, is corrupt or has an unsupported version");
 
 // Warnings
 S(SampleRateTooHigh, 1, "Analog module sample rate is too high");
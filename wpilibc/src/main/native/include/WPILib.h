@@ -18,13 +18,19 @@
 #include "AnalogPotentiometer.h"
 #include "AnalogTrigger.h"
 #include "AnalogTriggerOutput.h"
+#include "AsyncI2C.h"
 #include "BuiltInAccelerometer.h"
 #include "Buttons/InternalButton.h"
 #include "Buttons/JoystickButton.h"
 #include "Buttons/NetworkButton.h"
+#include "CANStreamReader.h"
+#include "CalibrationService.h"
 #include "CameraServer.h"
 #include "Commands/Command.h"
 #include "Commands/CommandGroup.h"
+#include "Commands/Composition.h"
+#include "Commands/FollowProfileCommand.h"
+#include "Commands/HighRateCommand.h"
 #include "Commands/PIDCommand.h"
 #include "Commands/PIDSubsystem.h"
 #include "Commands/PrintCommand.h"
@@ -35,20 +41,34 @@
 #include "Commands/WaitForChildren.h"
 #include "Commands/WaitUntilCommand.h"
 #include "Compressor.h"
+#include "ConfigStore.h"
 #include "ControllerPower.h"
 #include "Counter.h"
+#include "DMA.h"
+#include "DMASample.h"
 #include "DMC60.h"
+#include "DataLog.h"
 #include "DigitalInput.h"
+#include "DigitalInputGroup.h"
 #include "DigitalOutput.h"
+#include "DigitalOutputGroup.h"
 #include "DigitalSource.h"
 #include "DoubleSolenoid.h"
 #include "Drive/DifferentialDrive.h"
+#include "Drive/DriveOdometry.h"
+#include "Drive/Kinematics.h"
 #include "Drive/KilloughDrive.h"
 #include "Drive/MecanumDrive.h"
+#include "Drive/Odometry.h"
+#include "Drive/SwerveDriveKinematics.h"
 #include "DriverStation.h"
 #include "Encoder.h"
 #include "ErrorBase.h"
+#include "Executor.h"
+#include "Filters/FixedLinearDigitalFilter.h"
 #include "Filters/LinearDigitalFilter.h"
+#include "Filters/MedianFilter.h"
+#include "Filters/SlewRateLimiter.h"
 #include "GearTooth.h"
 #include "GenericHID.h"
 #include "I2C.h"
@@ -56,17 +76,27 @@
 #include "IterativeRobot.h"
 #include "Jaguar.h"
 #include "Joystick.h"
+#include "LogStreamServer.h"
+#include "LoopProfiler.h"
+#include "MotionProfile/DrivePath.h"
+#include "MotionProfile/MappedTrajectory.h"
+#include "MotionProfile/MotionProfile.h"
+#include "MotionProfile/ProfileFollower.h"
 #include "NidecBrushless.h"
 #include "Notifier.h"
+#include "NotifierExecutor.h"
 #include "PIDController.h"
+#include "PIDControllerGroup.h"
 #include "PIDOutput.h"
 #include "PIDSource.h"
 #include "PWM.h"
 #include "PWMSpeedController.h"
+#include "PWMSpeedControllerGroup.h"
 #include "PWMTalonSRX.h"
 #include "PWMVictorSPX.h"
 #include "PowerDistributionPanel.h"
 #include "Preferences.h"
+#include "ReadCache.h"
 #include "Relay.h"
 #include "RobotBase.h"
 #include "RobotController.h"
@@ -75,25 +105,38 @@
 #include "SPI.h"
 #include "SampleRobot.h"
 #include "SensorBase.h"
+#include "SerialFrameReader.h"
 #include "SerialPort.h"
 #include "Servo.h"
+#include "ShmChannel.h"
 #include "SmartDashboard/SendableChooser.h"
 #include "SmartDashboard/SmartDashboard.h"
+#include "SmartDashboard/TelemetryStruct.h"
 #include "Solenoid.h"
 #include "Spark.h"
 #include "SpeedController.h"
 #include "SpeedControllerGroup.h"
+#include "StartupProfiler.h"
 #include "Talon.h"
 #include "Threads.h"
 #include "TimedRobot.h"
 #include "Timer.h"
+#include "Tracing.h"
 #include "Ultrasonic.h"
+#include "Units.h"
 #include "Utility.h"
 #include "Victor.h"
 #include "VictorSP.h"
 #include "WPIErrors.h"
+#include "Waveform.h"
 #include "XboxController.h"
 #include "interfaces/Accelerometer.h"
 #include "interfaces/Gyro.h"
 #include "interfaces/Potentiometer.h"
+#include "vision/PipelinedVisionRunner.h"
+#include "vision/SharedVideoSink.h"
+#include "vision/StagedVisionPipeline.h"
+#include "vision/TrackingVisionPipeline.h"
+#include "vision/VisionKernels.h"
+#include "vision/VisionResultPublisher.h"
 #include "vision/VisionRunner.h"
@@ -0,0 +1,94 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stddef.h>
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <llvm/StringRef.h>
+#include <support/mutex.h>
+
+#include "Notifier.h"
+
+namespace frc {
+
+/**
+ * Watches a periodic loop and reports when an iteration runs past its
+ * timeout, while the overrunning code is still running.
+ *
+ * Call Reset() at the top of the loop, AddEpoch() after each stage and
+ * Disable() at the bottom. If the timeout passes before Disable() is called,
+ * the watchdog prints the stages recorded so far, longest first, together
+ * with the time spent since the last epoch, and calls the timeout callback.
+ * Both happen on the shared NotifierExecutor thread, so the loop is never
+ * blocked by them.
+ */
+class Watchdog {
+ public:
+  Watchdog(double timeout, std::function<void()> callback);
+  ~Watchdog() = default;
+
+  Watchdog(const Watchdog&) = delete;
+  Watchdog& operator=(const Watchdog&) = delete;
+
+  double GetTime() const;
+  void SetTimeout(double timeout);
+  double GetTimeout() const;
+  bool IsExpired() const;
+
+  void AddEpoch(llvm::StringRef epochName);
+  void AddEpoch(llvm::StringRef epochName, double time);
+  void PrintEpochs();
+  void ReportBudgetOverrun(llvm::StringRef name, double time, double budget);
+
+  void Reset();
+  void Enable();
+  void Disable();
+
+  void SuppressTimeoutMessage(bool suppress);
+
+ private:
+  // Shortest time between two timeout messages, in seconds
+  static constexpr double kMinPrintPeriod = 1.0;
+
+  struct Epoch {
+    std::string name;
+    double time = 0;
+  };
+
+  void RecordEpoch(llvm::StringRef epochName, double time, double now);
+  void TimeoutFunc();
+  void PrintEpochs(double now, bool timedOut);
+
+  mutable wpi::mutex m_mutex;
+  double m_timeout;
+  std::function<void()> m_callback;
+
+  double m_startTime = 0;
+  double m_lastEpochTime = 0;
+  // Entries past m_epochCount are kept so their strings are reused
+  std::vector<Epoch> m_epochs;
+  size_t m_epochCount = 0;
+
+  bool m_enabled = false;
+  bool m_suppressTimeoutMessage = false;
+  double m_lastTimeoutPrintTime = 0;
+  double m_lastBudgetPrintTime = 0;
+  // Overruns since the last budget message
+  int m_budgetOverruns = 0;
+  std::atomic<bool> m_expired{false};
+
+  // Declared last so its handler is stopped before the rest is destroyed
+  Notifier m_notifier;
+};
+
+}  // namespace frc
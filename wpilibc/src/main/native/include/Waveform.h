@@ -0,0 +1,81 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include <HAL/Types.h>
+#include <llvm/ArrayRef.h>
+
+#include "ErrorBase.h"
+
+namespace frc {
+
+class AnalogOutput;
+class DigitalOutput;
+class WaveformEngine;
+
+/**
+ * Plays a table of samples on an AnalogOutput or DigitalOutput at a fixed
+ * rate, for ramps, sine waves, LED patterns and test fixtures.
+ *
+ * Every playing Waveform is driven by one shared real-time thread waiting on
+ * one HAL notifier, which is set to the earliest next sample of all of them,
+ * so a waveform costs a HAL write per sample rather than a Notifier thread.
+ * The sample played is picked from the time since Start(), so a late wakeup
+ * skips samples rather than stretching the waveform.
+ *
+ * The output must outlive the Waveform, and shouldn't be set elsewhere while
+ * the waveform plays.
+ */
+class Waveform : public ErrorBase {
+ public:
+  enum Mode { kOneShot, kLoop };
+
+  // Real-time priority of the thread playing every waveform
+  static constexpr int kPriority = 45;
+  // The FPGA notifier can't reliably wake a thread faster than this
+  static constexpr double kMaxRate = 10000;
+
+  Waveform(AnalogOutput& output, llvm::ArrayRef<double> voltages, double rate,
+           Mode mode = kLoop);
+  Waveform(DigitalOutput& output, llvm::ArrayRef<bool> values, double rate,
+           Mode mode = kLoop);
+  ~Waveform() override;
+
+  Waveform(const Waveform&) = delete;
+  Waveform& operator=(const Waveform&) = delete;
+
+  void Start();
+  void Stop();
+  bool IsPlaying() const;
+
+ private:
+  friend class WaveformEngine;
+
+  void SetRate(double rate);
+
+  // Writes the sample due at the given FPGA time, and returns the time of the
+  // next one, or 0 if a one-shot waveform has finished. Called by the engine
+  // with its lock held.
+  uint64_t Play(uint64_t time);
+
+  HAL_Handle m_handle;
+  bool m_digital;
+  std::vector<double> m_samples;
+  uint64_t m_period = 0;
+  Mode m_mode;
+  uint64_t m_startTime = 0;
+  uint64_t m_lastIndex = 0;
+  std::atomic_bool m_playing{false};
+};
+
+}  // namespace frc
@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <llvm/ArrayRef.h>
+
+namespace frc {
+
+/**
+ * A circular buffer like circular_buffer, with its capacity fixed at compile
+ * time and its elements stored inline, so it never allocates.
+ *
+ * Indexes wrap with a mask when the capacity is a power of two, and with a
+ * compare otherwise, rather than a division. The elements are at most two
+ * contiguous runs, which first_span() and second_span() expose for bulk
+ * copies.
+ *
+ * @tparam T The element type
+ * @tparam N The capacity
+ */
+template <class T, size_t N>
+class static_circular_buffer {
+  static_assert(N > 0, "a circular buffer needs a capacity");
+
+ public:
+  static_circular_buffer() { reset(); }
+
+  typedef T value_type;
+  typedef value_type& reference;
+  typedef const value_type& const_reference;
+  typedef value_type* pointer;
+  typedef size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  size_type size() const { return m_length; }
+  static constexpr size_type capacity() { return N; }
+  bool empty() const { return m_length == 0; }
+  bool full() const { return m_length == N; }
+
+  T& front() { return (*this)[0]; }
+  const T& front() const { return (*this)[0]; }
+  T& back() { return (*this)[m_length - 1]; }
+  const T& back() const { return (*this)[m_length - 1]; }
+  void push_front(T value);
+  void push_back(T value);
+  T pop_front();
+  T pop_back();
+  void reset();
+
+  T& operator[](size_t index) { return m_data[Wrap(m_front + index)]; }
+  const T& operator[](size_t index) const {
+    return m_data[Wrap(m_front + index)];
+  }
+
+  llvm::ArrayRef<T> first_span() const;
+  llvm::ArrayRef<T> second_span() const;
+  size_t copy_to(T* output, size_t count) const;
+
+ private:
+  static constexpr bool kPowerOfTwo = (N & (N - 1)) == 0;
+
+  // Wraps an index below 2 * N
+  static size_t Wrap(size_t index) {
+    if (kPowerOfTwo) return index & (N - 1);
+    return index < N ? index : index - N;
+  }
+
+  std::array<T, N> m_data;
+
+  // Index of element at front of buffer
+  size_t m_front = 0;
+
+  // Number of elements used in buffer
+  size_t m_length = 0;
+};
+
+}  // namespace frc
+
+#include "static_circular_buffer.inc"
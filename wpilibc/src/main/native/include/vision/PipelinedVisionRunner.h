@@ -0,0 +1,113 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "ErrorBase.h"
+#include "cscore.h"
+#include "vision/VisionPipeline.h"
+
+namespace frc {
+
+/**
+ * Non-template base class for PipelinedVisionRunner.
+ */
+class PipelinedVisionRunnerBase : public ErrorBase {
+ public:
+  PipelinedVisionRunnerBase(cs::VideoSource videoSource, int workerCount);
+  ~PipelinedVisionRunnerBase() override;
+
+  PipelinedVisionRunnerBase(const PipelinedVisionRunnerBase&) = delete;
+  PipelinedVisionRunnerBase& operator=(const PipelinedVisionRunnerBase&) =
+      delete;
+
+  void RunForever();
+
+  void Stop();
+
+ protected:
+  // Runs the pipeline of the given worker on its worker thread
+  virtual void DoProcess(int worker, cv::Mat& image) = 0;
+
+  // Reports the result of the given worker; called in frame order
+  virtual void DoNotify(int worker, uint64_t frameTime) = 0;
+
+ private:
+  struct Job {
+    cv::Mat* image;
+    uint64_t sequence;
+    uint64_t frameTime;
+  };
+
+  void RunWorker(int worker);
+
+  cs::CvSink m_cvSink;
+  int m_workerCount;
+  std::atomic_bool m_enabled;
+
+  wpi::mutex m_mutex;
+  // Signaled when a frame is returned to m_freeFrames
+  wpi::condition_variable m_frameFreed;
+  // Signaled when a job is queued or the runner stops
+  wpi::condition_variable m_jobQueued;
+  // Signaled when m_nextNotify advances
+  wpi::condition_variable m_notified;
+
+  // Every frame, allocated once so grabbing reuses their buffers
+  std::vector<std::unique_ptr<cv::Mat>> m_frames;
+  std::vector<cv::Mat*> m_freeFrames;
+  std::deque<Job> m_jobs;
+  uint64_t m_nextSequence = 0;
+  uint64_t m_nextNotify = 0;
+};
+
+/**
+ * A vision runner that grabs the next frame while earlier frames are still
+ * being processed.
+ *
+ * RunForever() grabs frames on the calling thread into a fixed pool of
+ * frames and hands each to one of the worker threads, each of which runs its
+ * own pipeline. The listener is called with the worker's pipeline and the
+ * capture time of the frame, on the worker's thread, in the order the frames
+ * were grabbed. With one pipeline this overlaps capture with processing; with
+ * more, several frames are processed at once.
+ *
+ * The listener calls are serialized, so the listener does not need to lock
+ * against itself, but it must copy out what it needs from the pipeline: the
+ * pipeline is reused for a later frame as soon as the listener returns.
+ *
+ * @see VisionRunner
+ */
+template <typename T>
+class PipelinedVisionRunner : public PipelinedVisionRunnerBase {
+ public:
+  PipelinedVisionRunner(cs::VideoSource videoSource, std::vector<T*> pipelines,
+                        std::function<void(T&, uint64_t)> listener);
+  virtual ~PipelinedVisionRunner() = default;
+
+ protected:
+  void DoProcess(int worker, cv::Mat& image) override;
+  void DoNotify(int worker, uint64_t frameTime) override;
+
+ private:
+  std::vector<T*> m_pipelines;
+  std::function<void(T&, uint64_t)> m_listener;
+};
+}  // namespace frc
+
+#include "PipelinedVisionRunner.inc"
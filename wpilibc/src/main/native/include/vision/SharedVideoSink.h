@@ -0,0 +1,75 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <llvm/StringRef.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "cscore.h"
+
+namespace cv {
+class Mat;
+}  // namespace cv
+
+namespace frc {
+
+/**
+ * A video sink that decodes each frame of a source once and shares it with
+ * any number of consumers.
+ *
+ * A thread of its own grabs frames continuously. Consumers get the newest
+ * frame as a reference-counted, read-only image, which stays valid for as
+ * long as they hold it; a frame buffer is reused for a later frame once no
+ * consumer holds it any more. A consumer slower than the camera skips the
+ * frames it was too slow for.
+ *
+ * Get one from CameraServer::GetSharedVideo() and pass it to each VisionRunner
+ * that processes the camera.
+ */
+class SharedVideoSink {
+ public:
+  SharedVideoSink(llvm::StringRef name, cs::VideoSource source);
+  ~SharedVideoSink();
+
+  SharedVideoSink(const SharedVideoSink&) = delete;
+  SharedVideoSink& operator=(const SharedVideoSink&) = delete;
+
+  uint64_t GrabFrame(std::shared_ptr<const cv::Mat>& frame, uint64_t& sequence,
+                     double timeout = 0.225);
+
+  std::string GetError() const;
+
+ private:
+  std::shared_ptr<cv::Mat> GetFreeFrame();
+  void RunGrabber();
+
+  cs::CvSink m_cvSink;
+
+  mutable wpi::mutex m_mutex;
+  // Signaled when a frame is published or the sink is destroyed
+  wpi::condition_variable m_frameReady;
+  // Every frame buffer; one whose only owner is this list is free
+  std::vector<std::shared_ptr<cv::Mat>> m_frames;
+  std::shared_ptr<cv::Mat> m_frame;
+  uint64_t m_frameTime = 0;
+  uint64_t m_sequence = 0;
+  std::string m_error;
+  bool m_active = true;
+
+  std::thread m_thread;
+};
+
+}  // namespace frc
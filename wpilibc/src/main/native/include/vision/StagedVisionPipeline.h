@@ -0,0 +1,117 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <llvm/ArrayRef.h>
+#include <llvm/StringRef.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "ErrorBase.h"
+#include "vision/VisionPipeline.h"
+
+namespace frc {
+
+/**
+ * One stage of a StagedVisionPipeline.
+ *
+ * A stage runs once its dependencies have finished. A tiled stage is split
+ * into tiles that may run in parallel; its function is called once per tile
+ * with the tile index and count, and decides itself which part of the image
+ * (for example which rows) a tile covers.
+ */
+struct VisionPipelineStage {
+  std::string name;
+  std::function<void(cv::Mat& image, int tile, int tileCount)> func;
+  std::vector<int> dependencies;
+  int tileCount = 1;
+  // The wall time of the latest run, from its first tile starting to its last
+  // tile finishing, in seconds
+  double time = 0;
+};
+
+/**
+ * A vision pipeline built from stages that form a dependency graph, run
+ * across a small pool of threads.
+ *
+ * Stages whose dependencies have finished run at the same time, as do the
+ * tiles of a tiled stage, so a pipeline can use every core of the processor.
+ * Stages pass their results to each other through members of the subclass
+ * (or captured variables); a stage must only read the results of stages it
+ * depends on.
+ *
+ * Process() runs the whole graph once, using the calling thread and the
+ * pool's threads, and returns when every stage has finished. The time of each
+ * stage is kept for GetStageTime().
+ */
+class StagedVisionPipeline : public VisionPipeline, public ErrorBase {
+ public:
+  static constexpr int kDefaultThreadCount = 2;
+
+  explicit StagedVisionPipeline(int threadCount = kDefaultThreadCount);
+  ~StagedVisionPipeline() override;
+
+  StagedVisionPipeline(const StagedVisionPipeline&) = delete;
+  StagedVisionPipeline& operator=(const StagedVisionPipeline&) = delete;
+
+  int AddStage(llvm::StringRef name, std::function<void(cv::Mat&)> func,
+               llvm::ArrayRef<int> dependencies = {});
+  int AddTiledStage(
+      llvm::StringRef name, int tileCount,
+      std::function<void(cv::Mat& image, int tile, int tileCount)> func,
+      llvm::ArrayRef<int> dependencies = {});
+
+  void Process(cv::Mat& mat) override;
+
+  int GetStageCount() const;
+  const VisionPipelineStage& GetStage(int stage) const;
+  double GetStageTime(int stage) const;
+  double GetProcessTime() const;
+
+ private:
+  struct Task {
+    int stage;
+    int tile;
+  };
+
+  struct StageState {
+    int pendingDependencies = 0;
+    int pendingTiles = 0;
+    double startTime = 0;
+    bool started = false;
+  };
+
+  void RunWorker();
+  bool RunTask(std::unique_lock<wpi::mutex>& lock);
+  void QueueStage(int stage);
+
+  std::vector<VisionPipelineStage> m_stages;
+  // dependents of each stage, the reverse of the dependency lists
+  std::vector<std::vector<int>> m_dependents;
+  double m_processTime = 0;
+
+  mutable wpi::mutex m_mutex;
+  // Signaled when a task is queued, the last stage of a run finishes, or the
+  // pool stops
+  wpi::condition_variable m_changed;
+  std::deque<Task> m_tasks;
+  std::vector<StageState> m_state;
+  cv::Mat* m_image = nullptr;
+  int m_pendingStages = 0;
+  bool m_running = true;
+
+  std::vector<std::thread> m_threads;
+};
+
+}  // namespace frc
@@ -0,0 +1,56 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include "vision/VisionPipeline.h"
+
+namespace cv {
+template <typename T>
+class Rect_;
+}  // namespace cv
+
+namespace frc {
+
+/**
+ * A vision pipeline that can search part of an image for its target.
+ *
+ * When run by a VisionRunner, the pipeline is given a window around where the
+ * target was last found rather than the whole frame, so the cost of each frame
+ * scales with the size of the target instead of the resolution of the camera.
+ * The runner searches the whole frame when the target isn't found in the
+ * window, and periodically regardless (see
+ * VisionRunnerBase::SetFullScanPeriod()), so a closer target coming into view
+ * isn't missed while tracking the first.
+ *
+ * Parameters of type cv::Rect_<int> are cv::Rect.
+ *
+ * @see VisionRunner
+ */
+class TrackingVisionPipeline : public VisionPipeline {
+ public:
+  /**
+   * Searches part of a frame for the target and sets the result objects.
+   *
+   * @param image  The part of the frame to search. It shares the frame's
+   *               pixels; for the frame's coordinates, add the window's
+   *               top-left corner to those in the image.
+   * @param window Where the image is in the frame
+   * @param target Set to the bounding box of the target, in the frame's
+   *               coordinates, if it was found
+   * @return True if the target was found
+   */
+  virtual bool ProcessWindow(cv::Mat& image, const cv::Rect_<int>& window,
+                             cv::Rect_<int>& target) = 0;
+
+  /**
+   * Searches the whole image for the target.
+   */
+  void Process(cv::Mat& mat) override;
+};
+
+}  // namespace frc
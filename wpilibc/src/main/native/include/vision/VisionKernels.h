@@ -0,0 +1,54 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <vector>
+
+namespace cv {
+class Mat;
+}  // namespace cv
+
+namespace frc {
+
+/**
+ * An HSV range for HSVThreshold(), in OpenCV's 8-bit HSV units: hue 0-179,
+ * saturation and value 0-255. All bounds are inclusive.
+ *
+ * A hue range whose low bound is above its high bound wraps around, which
+ * selects reds without two thresholds.
+ */
+struct HSVRange {
+  int hueLow = 0;
+  int hueHigh = 179;
+  int satLow = 0;
+  int satHigh = 255;
+  int valLow = 0;
+  int valHigh = 255;
+};
+
+/**
+ * The bounding box and pixel count of one connected component of a mask.
+ */
+struct ComponentBox {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+  int area = 0;
+};
+
+void HSVThreshold(const cv::Mat& bgr, cv::Mat& mask, const HSVRange& range);
+
+void Erode3x3(const cv::Mat& src, cv::Mat& dst);
+
+void Dilate3x3(const cv::Mat& src, cv::Mat& dst);
+
+void FindComponentBoxes(const cv::Mat& mask, std::vector<ComponentBox>& boxes,
+                        int minArea = 0);
+
+}  // namespace frc
@@ -0,0 +1,86 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <llvm/ArrayRef.h>
+#include <llvm/StringRef.h>
+#include <networktables/NetworkTableEntry.h>
+
+namespace frc {
+
+/**
+ * One target found by a vision pipeline. The units are the pipeline's own,
+ * typically pixels and degrees.
+ */
+struct VisionTarget {
+  double x = 0;
+  double y = 0;
+  double width = 0;
+  double height = 0;
+  double area = 0;
+  double angle = 0;
+};
+
+/**
+ * The targets a vision pipeline found in one frame.
+ */
+struct VisionResult {
+  // Incremented by the publisher for every published result
+  uint64_t frameId = 0;
+  // The FPGA time of the frame, in seconds
+  double timestamp = 0;
+  std::vector<VisionTarget> targets;
+};
+
+/**
+ * Publishes the results of a vision pipeline as one raw NetworkTables value
+ * per frame.
+ *
+ * A result is encoded as little-endian binary: a version byte, the frame id
+ * (8 bytes), the timestamp (8-byte double), the target count (2 bytes) and
+ * six 4-byte floats per target. Because the whole result is one value, a
+ * VisionResultReader never sees targets of different frames mixed together.
+ */
+class VisionResultPublisher {
+ public:
+  static constexpr int kMaxTargets = 0xffff;
+
+  explicit VisionResultPublisher(llvm::StringRef name);
+  explicit VisionResultPublisher(nt::NetworkTableEntry entry);
+
+  void Publish(double timestamp, llvm::ArrayRef<VisionTarget> targets);
+
+  uint64_t GetFrameId() const;
+
+ private:
+  nt::NetworkTableEntry m_entry;
+  uint64_t m_frameId = 0;
+  // Reused so publishing does not allocate once it has grown
+  std::string m_buffer;
+};
+
+/**
+ * Reads the results published by a VisionResultPublisher.
+ */
+class VisionResultReader {
+ public:
+  explicit VisionResultReader(llvm::StringRef name);
+  explicit VisionResultReader(nt::NetworkTableEntry entry);
+
+  bool Get(VisionResult& result) const;
+
+ private:
+  nt::NetworkTableEntry m_entry;
+};
+
+}  // namespace frc
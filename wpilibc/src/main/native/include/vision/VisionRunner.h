@@ -7,12 +7,21 @@
 
 #pragma once
 
+#include <stdint.h>
+
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <type_traits>
+
+#include <support/condition_variable.h>
+#include <support/mutex.h>
 
 #include "ErrorBase.h"
+#include "TripleBuffer.h"
 #include "cscore.h"
+#include "vision/SharedVideoSink.h"
+#include "vision/TrackingVisionPipeline.h"
 #include "vision/VisionPipeline.h"
 
 namespace frc {
@@ -23,6 +32,7 @@ namespace frc {
 class VisionRunnerBase : public ErrorBase {
  public:
   explicit VisionRunnerBase(cs::VideoSource videoSource);
+  explicit VisionRunnerBase(std::shared_ptr<SharedVideoSink> sharedSink);
   ~VisionRunnerBase() override;
 
   VisionRunnerBase(const VisionRunnerBase&) = delete;
@@ -34,13 +44,56 @@ class VisionRunnerBase : public ErrorBase {
 
   void Stop();
 
+  void SetDropStaleFrames(bool drop);
+  bool GetDropStaleFrames() const;
+  uint64_t GetSkippedFrameCount() const;
+  double GetLatency() const;
+  uint64_t GetFrameTime() const;
+
+  void SetTrackingMargin(double margin);
+  void SetFullScanPeriod(int frames);
+  uint64_t GetWindowedFrameCount() const;
+
  protected:
   virtual void DoProcess(cv::Mat& image) = 0;
 
+  // Runs a tracking pipeline on the window predicted from the last target
+  void ProcessTracking(TrackingVisionPipeline& pipeline, cv::Mat& image);
+
  private:
+  void Process(cv::Mat& image, uint64_t frameTime);
+  void RunSharedOnce();
+  void RunGrabber();
+  void RunLatestFrame();
+
   std::unique_ptr<cv::Mat> m_image;
   cs::CvSink m_cvSink;
+  std::shared_ptr<SharedVideoSink> m_sharedSink;
+  uint64_t m_sharedSequence = 0;
   std::atomic_bool m_enabled;
+  std::atomic_bool m_dropStaleFrames{false};
+  std::atomic<uint64_t> m_skippedFrames{0};
+  std::atomic<double> m_latency{0};
+  std::atomic<uint64_t> m_frameTime{0};
+
+  // Tracking state, only used by the thread running the pipeline
+  std::unique_ptr<cv::Rect_<int>> m_target;
+  bool m_hasTarget = false;
+  int m_framesSinceScan = 0;
+  std::atomic<double> m_trackingMargin{0.5};
+  std::atomic<int> m_fullScanPeriod{10};
+  std::atomic<uint64_t> m_windowedFrames{0};
+
+  // Latest-frame-wins mode: the grabber thread fills the write buffer and
+  // publishes it, and RunLatestFrame() takes the newest frame, without either
+  // waiting on the other. The mutex only guards sleeping on m_frameReady.
+  struct Frame {
+    std::unique_ptr<cv::Mat> image;
+    uint64_t time = 0;
+  };
+  TripleBuffer<Frame> m_frames;
+  wpi::mutex m_frameMutex;
+  wpi::condition_variable m_frameReady;
 };
 
 /**
@@ -48,6 +101,9 @@ class VisionRunnerBase : public ErrorBase {
  * pipelines from robot code. The easiest way to use this is to run it in a
  * std::thread and use the listener to take snapshots of the pipeline's outputs.
  *
+ * If T is a TrackingVisionPipeline, the pipeline searches a window around the
+ * last target rather than the whole frame.
+ *
  * @see VisionPipeline
  */
 template <typename T>
@@ -55,14 +111,26 @@ class VisionRunner : public VisionRunnerBase {
  public:
   VisionRunner(cs::VideoSource videoSource, T* pipeline,
                std::function<void(T&)> listener);
+  VisionRunner(cs::VideoSource videoSource, T* pipeline,
+               std::function<void(T&, uint64_t)> listener);
+  VisionRunner(std::shared_ptr<SharedVideoSink> sharedSink, T* pipeline,
+               std::function<void(T&)> listener);
+  VisionRunner(std::shared_ptr<SharedVideoSink> sharedSink, T* pipeline,
+               std::function<void(T&, uint64_t)> listener);
   virtual ~VisionRunner() = default;
 
  protected:
   void DoProcess(cv::Mat& image) override;
 
  private:
+  template <typename P>
+  void RunPipeline(P& pipeline, cv::Mat& image, std::true_type);
+  template <typename P>
+  void RunPipeline(P& pipeline, cv::Mat& image, std::false_type);
+
   T* m_pipeline;
   std::function<void(T&)> m_listener;
+  std::function<void(T&, uint64_t)> m_timedListener;
 };
 }  // namespace frc
 
@@ -0,0 +1,92 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "SPSCQueue.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+TEST(SPSCQueueTest, FirstInFirstOut) {
+  SPSCQueue<int, 4> queue;
+  int value = -1;
+  EXPECT_FALSE(queue.Pop(&value));
+  EXPECT_EQ(-1, value);
+
+  for (int i = 0; i < 3; i++) EXPECT_TRUE(queue.Push(i));
+  EXPECT_EQ(3u, queue.Size());
+  for (int i = 0; i < 3; i++) {
+    EXPECT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_FALSE(queue.Pop(&value));
+  EXPECT_EQ(0u, queue.Size());
+}
+
+TEST(SPSCQueueTest, FullQueueRejectsPush) {
+  SPSCQueue<int, 4> queue;
+  for (int i = 0; i < 4; i++) EXPECT_TRUE(queue.Push(i));
+  EXPECT_FALSE(queue.Push(4));
+  EXPECT_EQ(4u, queue.Size());
+
+  int value;
+  EXPECT_TRUE(queue.Pop(&value));
+  EXPECT_EQ(0, value);
+  EXPECT_TRUE(queue.Push(4));
+  for (int i = 1; i <= 4; i++) {
+    EXPECT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(i, value);
+  }
+}
+
+TEST(SPSCQueueTest, WrapAround) {
+  SPSCQueue<int, 4> queue;
+  int value;
+  for (int i = 0; i < 100; i++) {
+    EXPECT_TRUE(queue.Push(i));
+    EXPECT_TRUE(queue.Push(i + 1000));
+    EXPECT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(i, value);
+    EXPECT_TRUE(queue.Pop(&value));
+    EXPECT_EQ(i + 1000, value);
+  }
+}
+
+TEST(SPSCQueueTest, HeapAllocated) {
+  std::unique_ptr<SPSCQueue<double, 256>> queue(new SPSCQueue<double, 256>);
+  EXPECT_TRUE(queue->Push(1.5));
+  double value = 0;
+  EXPECT_TRUE(queue->Pop(&value));
+  EXPECT_EQ(1.5, value);
+}
+
+TEST(SPSCQueueTest, ProducerAndConsumerThreads) {
+  static constexpr int kCount = 100000;
+  SPSCQueue<int, 64> queue;
+
+  std::thread producer([&] {
+    for (int i = 0; i < kCount; i++) {
+      while (!queue.Push(i)) std::this_thread::yield();
+    }
+  });
+
+  int expected = 0;
+  while (expected < kCount) {
+    int value;
+    if (!queue.Pop(&value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(expected, value);
+    expected++;
+  }
+  producer.join();
+  EXPECT_EQ(0u, queue.Size());
+}
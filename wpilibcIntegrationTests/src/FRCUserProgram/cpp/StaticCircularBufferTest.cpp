@@ -0,0 +1,162 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "static_circular_buffer.h"  // NOLINT(build/include_order)
+
+#include <array>
+
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+static const std::array<double, 10> values = {
+    751.848, 766.366, 342.657, 234.252, 716.126,
+    132.344, 445.697, 22.727,  421.125, 799.913};
+
+static const std::array<double, 8> pushFrontOut = {
+    799.913, 421.125, 22.727, 445.697, 132.344, 716.126, 234.252, 342.657};
+
+static const std::array<double, 8> pushBackOut = {
+    342.657, 234.252, 716.126, 132.344, 445.697, 22.727, 421.125, 799.913};
+
+TEST(StaticCircularBufferTest, PushFrontTest) {
+  static_circular_buffer<double, 8> queue;
+
+  for (auto& value : values) {
+    queue.push_front(value);
+  }
+
+  ASSERT_EQ(pushFrontOut.size(), queue.size());
+  for (size_t i = 0; i < pushFrontOut.size(); i++) {
+    EXPECT_EQ(pushFrontOut[i], queue[i]);
+  }
+}
+
+TEST(StaticCircularBufferTest, PushBackTest) {
+  static_circular_buffer<double, 8> queue;
+
+  for (auto& value : values) {
+    queue.push_back(value);
+  }
+
+  ASSERT_EQ(pushBackOut.size(), queue.size());
+  for (size_t i = 0; i < pushBackOut.size(); i++) {
+    EXPECT_EQ(pushBackOut[i], queue[i]);
+  }
+}
+
+TEST(StaticCircularBufferTest, PushPopTest) {
+  // A capacity that isn't a power of two wraps with a compare
+  static_circular_buffer<double, 3> queue;
+
+  queue.push_back(1.0);
+  queue.push_back(2.0);
+  queue.push_back(3.0);
+  EXPECT_TRUE(queue.full());
+
+  queue.push_back(4.0);  // Overwrite 1 with 4
+  queue.push_back(5.0);  // Overwrite 2 with 5
+
+  // The buffer now contains 3, 4 and 5
+  EXPECT_EQ(3u, queue.size());
+  EXPECT_EQ(3.0, queue.front());
+  EXPECT_EQ(5.0, queue.back());
+
+  EXPECT_EQ(5.0, queue.pop_back());
+  EXPECT_EQ(3.0, queue.pop_front());
+
+  // Leaving only one element with value == 4
+  EXPECT_EQ(1u, queue.size());
+  EXPECT_EQ(4.0, queue[0]);
+
+  // push_front() wraps below index 0, and overwrites the back when full
+  queue.push_front(2.0);
+  queue.push_front(1.0);
+  queue.push_front(0.0);  // Overwrite 4 with 0
+  EXPECT_EQ(0.0, queue[0]);
+  EXPECT_EQ(1.0, queue[1]);
+  EXPECT_EQ(2.0, queue[2]);
+
+  EXPECT_EQ(2.0, queue.pop_back());
+  EXPECT_EQ(1.0, queue.pop_back());
+  EXPECT_EQ(0.0, queue.pop_back());
+  EXPECT_TRUE(queue.empty());
+
+  // Popping an empty buffer returns the default value
+  EXPECT_EQ(0.0, queue.pop_back());
+  EXPECT_EQ(0.0, queue.pop_front());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(StaticCircularBufferTest, ResetTest) {
+  static_circular_buffer<double, 5> queue;
+
+  for (size_t i = 1; i < 6; i++) {
+    queue.push_back(i);
+  }
+
+  queue.reset();
+
+  EXPECT_TRUE(queue.empty());
+  for (size_t i = 0; i < 5; i++) {
+    EXPECT_EQ(0.0, queue[i]);
+  }
+}
+
+TEST(StaticCircularBufferTest, SpanTest) {
+  static_circular_buffer<int, 4> queue;
+
+  /* Buffer contains {_, _, 1, 2}
+   *                        ^ front
+   */
+  queue.push_back(0);
+  queue.push_back(0);
+  queue.push_back(1);
+  queue.push_back(2);
+  queue.pop_front();
+  queue.pop_front();
+
+  EXPECT_EQ(2u, queue.first_span().size());
+  EXPECT_TRUE(queue.second_span().empty());
+
+  /* Buffer contains {3, 4, 1, 2}
+   *                        ^ front
+   */
+  queue.push_back(3);
+  queue.push_back(4);
+
+  auto first = queue.first_span();
+  auto second = queue.second_span();
+  ASSERT_EQ(2u, first.size());
+  ASSERT_EQ(2u, second.size());
+  EXPECT_EQ(1, first[0]);
+  EXPECT_EQ(2, first[1]);
+  EXPECT_EQ(3, second[0]);
+  EXPECT_EQ(4, second[1]);
+}
+
+TEST(StaticCircularBufferTest, CopyToTest) {
+  static_circular_buffer<int, 5> queue;
+
+  // Wrap the front past the end of the storage
+  for (int i = 0; i < 8; i++) {
+    queue.push_back(i);
+  }
+
+  std::array<int, 6> output{};
+  EXPECT_EQ(5u, queue.copy_to(output.data(), output.size()));
+  for (int i = 0; i < 5; i++) {
+    EXPECT_EQ(i + 3, output[i]);
+  }
+
+  output.fill(-1);
+  EXPECT_EQ(3u, queue.copy_to(output.data(), 3));
+  EXPECT_EQ(3, output[0]);
+  EXPECT_EQ(4, output[1]);
+  EXPECT_EQ(5, output[2]);
+  EXPECT_EQ(-1, output[3]);
+}
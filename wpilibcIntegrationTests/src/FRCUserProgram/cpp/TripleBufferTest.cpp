@@ -0,0 +1,93 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "TripleBuffer.h"  // NOLINT(build/include_order)
+
+#include <memory>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+TEST(TripleBufferTest, NothingPublished) {
+  TripleBuffer<int> buffer;
+  EXPECT_FALSE(buffer.HasNew());
+  EXPECT_FALSE(buffer.Update());
+  EXPECT_EQ(0, buffer.GetReadBuffer());
+}
+
+TEST(TripleBufferTest, WriteAndUpdate) {
+  TripleBuffer<int> buffer;
+  EXPECT_FALSE(buffer.Write(1));
+  EXPECT_TRUE(buffer.HasNew());
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(1, buffer.GetReadBuffer());
+
+  // Taking the value leaves it in the read buffer
+  EXPECT_FALSE(buffer.HasNew());
+  EXPECT_FALSE(buffer.Update());
+  EXPECT_EQ(1, buffer.GetReadBuffer());
+}
+
+TEST(TripleBufferTest, NewestValueWins) {
+  TripleBuffer<int> buffer;
+  EXPECT_FALSE(buffer.Write(1));
+  EXPECT_TRUE(buffer.Write(2));
+  EXPECT_TRUE(buffer.Write(3));
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(3, buffer.GetReadBuffer());
+  EXPECT_FALSE(buffer.Update());
+}
+
+TEST(TripleBufferTest, WriteInPlace) {
+  TripleBuffer<int> buffer;
+  buffer.GetWriteBuffer() = 5;
+  EXPECT_FALSE(buffer.HasNew());
+  EXPECT_FALSE(buffer.Publish());
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(5, buffer.GetReadBuffer());
+}
+
+TEST(TripleBufferTest, HeapAllocated) {
+  std::unique_ptr<TripleBuffer<double>> buffer(new TripleBuffer<double>);
+  buffer->Write(2.5);
+  EXPECT_TRUE(buffer->Update());
+  EXPECT_EQ(2.5, buffer->GetReadBuffer());
+}
+
+// The consumer only ever sees complete values, in increasing order
+TEST(TripleBufferTest, ProducerAndConsumerThreads) {
+  struct Pair {
+    int a = 0;
+    int b = 0;
+  };
+  static constexpr int kCount = 100000;
+  TripleBuffer<Pair> buffer;
+
+  std::thread producer([&] {
+    for (int i = 1; i <= kCount; i++) {
+      Pair& pair = buffer.GetWriteBuffer();
+      pair.a = i;
+      pair.b = -i;
+      buffer.Publish();
+    }
+  });
+
+  int last = 0;
+  while (last < kCount) {
+    if (!buffer.Update()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const Pair& pair = buffer.GetReadBuffer();
+    ASSERT_EQ(-pair.a, pair.b);
+    ASSERT_GT(pair.a, last);
+    last = pair.a;
+  }
+  producer.join();
+}
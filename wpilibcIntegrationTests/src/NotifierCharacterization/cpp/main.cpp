@@ -0,0 +1,361 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+/*
+ * Measures how late notifiers wake up on the roboRIO.
+ *
+ * Each notifier given on the command line runs periodically at its rate and
+ * thread priority and records how long after its trigger time it woke, while
+ * optional load runs alongside it. A histogram of the wake latency of each
+ * notifier is printed and written as CSV when the run ends.
+ *
+ * Usage: NotifierCharacterization [options] <rate Hz>[:<priority>] ...
+ *
+ *   --seconds <s>  how long to run (default 30)
+ *   --hal          wait on HAL notifiers directly rather than frc::Notifier,
+ *                  recording the time HAL_WaitForNotifierAlarm() returned
+ *   --nt <n>       update n NetworkTables entries every millisecond and send
+ *                  them to a client connected over loopback
+ *   --camera       start streaming USB camera 0; connect a dashboard to the
+ *                  stream so the frames are encoded
+ *   --burn <n>     run n busy threads at normal priority
+ *   --csv <path>   where to write the histograms (default
+ *                  /home/lvuser/notifier_characterization.csv)
+ *
+ * A priority of 0 or none leaves the notifier at normal priority; 1 to 99 runs
+ * it real time at that priority. For example
+ *
+ *   NotifierCharacterization --nt 50 --burn 2 200:40 50:0
+ *
+ * runs a 200 Hz notifier at real time priority 40 and a 50 Hz one at normal
+ * priority, with NetworkTables traffic and both cores busy.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <HAL/HAL.h>
+#include <llvm/Format.h>
+#include <llvm/raw_ostream.h>
+#include <networktables/NetworkTableInstance.h>
+
+#include "CameraServer.h"
+#include "Notifier.h"
+#include "Threads.h"
+#include "Timer.h"
+
+using namespace frc;
+
+// The histogram has bins this many microseconds wide, plus one for anything
+// later than the last bin
+static constexpr int kBinWidth = 25;
+static constexpr int kBins = 80;
+
+static constexpr int kBarWidth = 50;
+
+static constexpr const char* kDefaultCsv =
+    "/home/lvuser/notifier_characterization.csv";
+
+namespace {
+struct Options {
+  double seconds = 30;
+  bool hal = false;
+  int ntEntries = 0;
+  bool camera = false;
+  int burners = 0;
+  std::string csv = kDefaultCsv;
+};
+
+// One notifier being measured. The samples are preallocated so recording one
+// does not allocate; only the thread running the notifier writes them.
+class Loop {
+ public:
+  Loop(double rate, int priority, double seconds)
+      : m_rate(rate),
+        m_priority(priority),
+        m_period(static_cast<uint64_t>(1e6 / rate)),
+        m_samples(static_cast<size_t>(rate * seconds) + 1) {}
+
+  void Start(bool hal);
+  void Stop();
+
+  void Print() const;
+  void WriteCsv(std::FILE* file) const;
+
+ private:
+  void SetPriority();
+  void Record(int64_t latency);
+
+  double m_rate;
+  int m_priority;
+  uint64_t m_period;
+
+  std::vector<int32_t> m_samples;
+  size_t m_count = 0;
+
+  // frc::Notifier mode: the Notifier and the trigger time it is waiting for,
+  // accumulated the same way the Notifier does
+  std::unique_ptr<Notifier> m_notifier;
+  double m_expirationTime = 0;
+  bool m_prioritySet = false;
+
+  // HAL mode: the thread waiting on the HAL notifier
+  std::thread m_thread;
+  std::atomic<HAL_NotifierHandle> m_halNotifier{0};
+};
+}  // namespace
+
+void Loop::SetPriority() {
+  if (m_priority <= 0) return;
+  if (!SetCurrentThreadPriority(true, m_priority)) {
+    llvm::errs() << "could not set priority " << m_priority << " for "
+                 << m_rate << " Hz notifier\n";
+  }
+}
+
+void Loop::Record(int64_t latency) {
+  if (m_count < m_samples.size()) m_samples[m_count++] = latency;
+}
+
+void Loop::Start(bool hal) {
+  if (!hal) {
+    m_notifier = std::make_unique<Notifier>([this] {
+      int32_t status = 0;
+      uint64_t now = HAL_GetFPGATime(&status);
+      if (!m_prioritySet) {
+        SetPriority();
+        m_prioritySet = true;
+      }
+      m_expirationTime += 1.0 / m_rate;
+      Record(static_cast<int64_t>(now) -
+             static_cast<int64_t>(m_expirationTime * 1e6));
+    });
+    // The Notifier reads the time again when starting, so this trigger time
+    // is up to a few microseconds early
+    m_expirationTime = Timer::GetFPGATimestamp();
+    m_notifier->StartPeriodic(1.0 / m_rate);
+    return;
+  }
+
+  int32_t status = 0;
+  m_halNotifier = HAL_InitializeNotifier(&status);
+  if (status != 0) {
+    llvm::errs() << "could not create HAL notifier: "
+                 << HAL_GetErrorMessage(status) << "\n";
+    return;
+  }
+  m_thread = std::thread([this] {
+    SetPriority();
+    int32_t status = 0;
+    HAL_NotifierHandle notifier = m_halNotifier.load();
+    uint64_t trigger = HAL_GetFPGATime(&status) + m_period;
+    HAL_UpdateNotifierAlarm(notifier, trigger, &status);
+    for (;;) {
+      uint64_t now = HAL_WaitForNotifierAlarm(notifier, &status);
+      if (now == 0 || status != 0) break;
+      Record(static_cast<int64_t>(now) - static_cast<int64_t>(trigger));
+      // Like frc::Notifier, late ticks are not skipped
+      trigger += m_period;
+      HAL_UpdateNotifierAlarm(notifier, trigger, &status);
+    }
+  });
+}
+
+void Loop::Stop() {
+  if (m_notifier) {
+    m_notifier->Stop();
+    m_notifier.reset();
+  }
+  HAL_NotifierHandle handle = m_halNotifier.exchange(0);
+  if (handle == 0) return;
+  int32_t status = 0;
+  HAL_StopNotifier(handle, &status);
+  if (m_thread.joinable()) m_thread.join();
+  HAL_CleanNotifier(handle, &status);
+}
+
+static int GetBin(int32_t latency) {
+  if (latency < 0) return 0;
+  return std::min(latency / kBinWidth, kBins);
+}
+
+void Loop::Print() const {
+  llvm::outs() << llvm::format("%.1f Hz", m_rate) << ", priority "
+               << m_priority << ": " << m_count << " wakeups\n";
+  if (m_count == 0) return;
+
+  std::vector<int32_t> sorted(m_samples.begin(), m_samples.begin() + m_count);
+  std::sort(sorted.begin(), sorted.end());
+  auto percentile = [&](double p) {
+    return sorted[std::min(m_count - 1, static_cast<size_t>(p * m_count))];
+  };
+  double mean = 0;
+  size_t late = 0;
+  for (int32_t latency : sorted) {
+    mean += latency;
+    // late enough that the next tick was already due
+    if (latency >= static_cast<int64_t>(m_period)) late++;
+  }
+  mean /= m_count;
+  llvm::outs() << llvm::format(
+      "  latency us: min %d mean %.1f p50 %d p99 %d p99.9 %d max %d\n",
+      sorted.front(), mean, percentile(0.5), percentile(0.99),
+      percentile(0.999), sorted.back());
+  llvm::outs() << "  " << late << " wakeups a period or more late\n";
+
+  std::vector<size_t> bins(kBins + 1);
+  for (int32_t latency : sorted) bins[GetBin(latency)]++;
+  size_t most = *std::max_element(bins.begin(), bins.end());
+  for (int i = 0; i <= kBins; i++) {
+    if (bins[i] == 0) continue;
+    if (i < kBins) {
+      llvm::outs() << llvm::format("  %5d-%-5d", i * kBinWidth,
+                                   (i + 1) * kBinWidth);
+    } else {
+      llvm::outs() << llvm::format("  %5d+     ", kBins * kBinWidth);
+    }
+    llvm::outs() << llvm::format(" %8zu %6.2f%% ", bins[i],
+                                 100.0 * bins[i] / m_count);
+    int width = static_cast<int>(kBarWidth * bins[i] / most);
+    llvm::outs() << std::string(std::max(width, 1), '#') << "\n";
+  }
+}
+
+void Loop::WriteCsv(std::FILE* file) const {
+  std::vector<size_t> bins(kBins + 1);
+  for (size_t i = 0; i < m_count; i++) bins[GetBin(m_samples[i])]++;
+  for (int i = 0; i <= kBins; i++) {
+    std::fprintf(file, "%g,%d,%d,%zu\n", m_rate, m_priority, i * kBinWidth,
+                 bins[i]);
+  }
+}
+
+static void PrintUsage() {
+  llvm::errs() << "usage: NotifierCharacterization [--seconds <s>] [--hal] "
+                  "[--nt <entries>]\n"
+                  "           [--camera] [--burn <threads>] [--csv <path>] "
+                  "<rate Hz>[:<priority>] ...\n";
+}
+
+int main(int argc, char** argv) {
+  Options options;
+  std::vector<std::unique_ptr<Loop>> loops;
+  std::vector<std::pair<double, int>> specs;
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) {
+      options.seconds = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--hal") == 0) {
+      options.hal = true;
+    } else if (std::strcmp(argv[i], "--nt") == 0 && hasValue) {
+      options.ntEntries = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--camera") == 0) {
+      options.camera = true;
+    } else if (std::strcmp(argv[i], "--burn") == 0 && hasValue) {
+      options.burners = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+      options.csv = argv[++i];
+    } else {
+      char* end;
+      double rate = std::strtod(argv[i], &end);
+      int priority = *end == ':' ? std::atoi(end + 1) : 0;
+      if (rate <= 0 || (*end != '\0' && *end != ':') || priority < 0 ||
+          priority > 99) {
+        PrintUsage();
+        return 1;
+      }
+      specs.emplace_back(rate, priority);
+    }
+  }
+  if (specs.empty() || options.seconds <= 0) {
+    PrintUsage();
+    return 1;
+  }
+
+  if (!HAL_Initialize(500, 0)) {
+    llvm::errs() << "FATAL ERROR: HAL could not be initialized\n";
+    return 1;
+  }
+
+  // Start the load first so the measurements only see it running steadily
+  std::atomic<bool> running{true};
+  std::vector<std::thread> loadThreads;
+  for (int i = 0; i < options.burners; i++) {
+    loadThreads.emplace_back([&] {
+      volatile uint64_t spin = 0;
+      while (running) spin = spin + 1;
+    });
+  }
+
+  auto server = nt::NetworkTableInstance::GetDefault();
+  auto client = nt::NetworkTableInstance::Create();
+  if (options.ntEntries > 0) {
+    server.StartServer("/home/lvuser/networktables.ini");
+    client.StartClient("localhost");
+    loadThreads.emplace_back([&] {
+      auto table = server.GetTable("NotifierCharacterization");
+      std::vector<nt::NetworkTableEntry> entries;
+      for (int i = 0; i < options.ntEntries; i++) {
+        entries.push_back(table->GetEntry("load" + llvm::Twine(i)));
+      }
+      double value = 0;
+      while (running) {
+        value++;
+        for (auto& entry : entries) entry.SetDouble(value);
+        server.Flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+  }
+
+  if (options.camera) CameraServer::GetInstance()->StartAutomaticCapture();
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  llvm::outs() << "Measuring " << specs.size() << " notifiers for "
+               << options.seconds << " s using "
+               << (options.hal ? "HAL notifiers" : "frc::Notifier") << "\n";
+  for (auto& spec : specs) {
+    loops.emplace_back(
+        std::make_unique<Loop>(spec.first, spec.second, options.seconds));
+    loops.back()->Start(options.hal);
+  }
+  std::this_thread::sleep_for(
+      std::chrono::duration<double>(options.seconds));
+  for (auto& loop : loops) loop->Stop();
+
+  running = false;
+  for (auto& thread : loadThreads) thread.join();
+  if (options.ntEntries > 0) client.StopClient();
+  nt::NetworkTableInstance::Destroy(client);
+
+  for (auto& loop : loops) loop->Print();
+
+  std::FILE* file = std::fopen(options.csv.c_str(), "w");
+  if (!file) {
+    llvm::errs() << "could not write " << options.csv << "\n";
+    return 1;
+  }
+  std::fprintf(file, "rate,priority,bin_start_us,count\n");
+  for (auto& loop : loops) loop->WriteCsv(file);
+  std::fclose(file);
+  llvm::outs() << "Histograms written to " << options.csv << "\n";
+
+  // The camera server's threads are not stopped cleanly at exit
+  llvm::outs().flush();
+  std::quick_exit(0);
+}
@@ -0,0 +1,227 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "SimTestBench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <HAL/HAL.h>
+#include <MockData/AccelerometerData.h>
+#include <MockData/AnalogInData.h>
+#include <MockData/AnalogOutData.h>
+#include <MockData/DIOData.h>
+#include <MockData/DriverStationData.h>
+#include <MockData/EncoderData.h>
+#include <MockData/MockHooks.h>
+#include <MockData/RelayData.h>
+
+#include "TestBench.h"
+
+using namespace frc;
+
+// Quadrature states in the order a forward turning encoder goes through them,
+// as B << 1 | A
+static constexpr int32_t kQuadratureSignals[4] = {0, 1, 3, 2};
+
+static int32_t QuadratureState(bool a, bool b) {
+  int32_t signals = (b ? 2 : 0) | (a ? 1 : 0);
+  for (int32_t i = 0; i < 4; i++) {
+    if (kQuadratureSignals[i] == signals) return i;
+  }
+  return 0;
+}
+
+/**
+ * Wires the simulated devices together and starts stepping simulated time.
+ * HAL_Initialize() must have been called first.
+ */
+void SimTestBench::Start() {
+  if (m_running) return;
+
+  int32_t numDIO = HAL_GetNumDigitalChannels();
+  m_dioLoopbacks.assign(numDIO, -1);
+  m_dioLoopbacks[TestBench::kLoop1OutputChannel] =
+      TestBench::kLoop1InputChannel;
+  m_dioLoopbacks[TestBench::kLoop2OutputChannel] =
+      TestBench::kLoop2InputChannel;
+
+  m_motors.clear();
+  m_motors.push_back(Motor(TestBench::kTalonChannel,
+                           TestBench::kTalonEncoderChannelA,
+                           TestBench::kTalonEncoderChannelB));
+  m_motors.push_back(Motor(TestBench::kVictorChannel,
+                           TestBench::kVictorEncoderChannelA,
+                           TestBench::kVictorEncoderChannelB));
+  m_motors.push_back(Motor(TestBench::kJaguarChannel,
+                           TestBench::kJaguarEncoderChannelA,
+                           TestBench::kJaguarEncoderChannelB));
+  m_decoders.assign(HAL_GetNumEncoders(), Decoder{});
+
+  // Every DIO is watched, since encoders may be allocated on any of them
+  m_channels.clear();
+  for (int32_t i = 0; i < numDIO; i++) m_channels.push_back(Channel{this, i});
+  m_dioCallbacks.clear();
+  for (auto& channel : m_channels) {
+    m_dioCallbacks.push_back(HALSIM_RegisterDIOValueCallback(
+        channel.channel, &SimTestBench::DIOCallback, &channel, false));
+  }
+  m_analogCallback = HALSIM_RegisterAnalogOutVoltageCallback(
+      TestBench::kAnalogOutputChannel, &SimTestBench::AnalogCallback, this,
+      true);
+  m_relayForwardCallback = HALSIM_RegisterRelayForwardCallback(
+      TestBench::kRelayChannel, &SimTestBench::RelayForwardCallback, this,
+      true);
+  m_relayReverseCallback = HALSIM_RegisterRelayReverseCallback(
+      TestBench::kRelayChannel, &SimTestBench::RelayReverseCallback, this,
+      true);
+
+  // The roboRIO is mounted on its side, with Y up
+  HALSIM_SetAccelerometerY(0, 1.0);
+
+  HALSIM_PauseTiming();
+  int32_t status = 0;
+  m_lastStep = HAL_GetFPGATime(&status);
+  m_stepCallback = hal::sim::GetExtensionHost().RegisterStepCallback(
+      &SimTestBench::StepCallback, this);
+
+  m_running = true;
+  m_clock = std::thread(&SimTestBench::ClockMain, this);
+}
+
+/**
+ * Stops stepping simulated time, which then runs with the wall clock again,
+ * and removes the wiring.
+ */
+void SimTestBench::Stop() {
+  if (!m_running) return;
+  m_running = false;
+  m_clock.join();
+
+  hal::sim::GetExtensionHost().CancelStepCallback(m_stepCallback);
+  for (size_t i = 0; i < m_dioCallbacks.size(); i++) {
+    HALSIM_CancelDIOValueCallback(i, m_dioCallbacks[i]);
+  }
+  HALSIM_CancelAnalogOutVoltageCallback(TestBench::kAnalogOutputChannel,
+                                        m_analogCallback);
+  HALSIM_CancelRelayForwardCallback(TestBench::kRelayChannel,
+                                    m_relayForwardCallback);
+  HALSIM_CancelRelayReverseCallback(TestBench::kRelayChannel,
+                                    m_relayReverseCallback);
+  HALSIM_ResumeTiming();
+}
+
+void SimTestBench::DIOCallback(const char* name, void* param,
+                               const HAL_Value* value) {
+  auto channel = static_cast<Channel*>(param);
+  SimTestBench& bench = *channel->bench;
+  int32_t input = bench.m_dioLoopbacks[channel->channel];
+  if (input >= 0) HALSIM_SetDIOValue(input, value->data.v_boolean);
+  int32_t status = 0;
+  bench.Decode(channel->channel, HAL_GetFPGATime(&status));
+}
+
+void SimTestBench::AnalogCallback(const char* name, void* param,
+                                  const HAL_Value* value) {
+  HALSIM_SetAnalogInVoltage(TestBench::kFakeAnalogOutputChannel,
+                            value->data.v_double);
+}
+
+void SimTestBench::RelayForwardCallback(const char* name, void* param,
+                                        const HAL_Value* value) {
+  HALSIM_SetDIOValue(TestBench::kFakeRelayForward, value->data.v_boolean);
+}
+
+void SimTestBench::RelayReverseCallback(const char* name, void* param,
+                                        const HAL_Value* value) {
+  HALSIM_SetDIOValue(TestBench::kFakeRelayReverse, value->data.v_boolean);
+}
+
+void SimTestBench::StepCallback(void* param, uint64_t time) {
+  static_cast<SimTestBench*>(param)->Step(time);
+}
+
+// Counts an edge of an encoder's signals, if the channel is one of them
+void SimTestBench::Decode(int32_t channel, uint64_t time) {
+  int32_t index = HALSIM_FindEncoderForChannel(channel);
+  if (index < 0) return;
+  int32_t channelA = HALSIM_GetEncoderDigitalChannelA(index);
+  int32_t channelB = HALSIM_GetEncoderDigitalChannelB(index);
+  if (channelA < 0 || channelB < 0) return;
+  int32_t state = QuadratureState(HALSIM_GetDIOValue(channelA),
+                                  HALSIM_GetDIOValue(channelB));
+
+  std::lock_guard<wpi::mutex> lock(m_decoderMutex);
+  Decoder& decoder = m_decoders[index];
+  if (decoder.channelA != channelA || decoder.channelB != channelB) {
+    // A new encoder starts from the signals as they are
+    decoder.channelA = channelA;
+    decoder.channelB = channelB;
+    decoder.state = state;
+    decoder.lastEdge = time;
+    return;
+  }
+
+  int32_t delta = (state - decoder.state + 4) % 4;
+  decoder.state = state;
+  // Two states at once is a missed edge, which has no direction
+  if (delta != 1 && delta != 3) return;
+  int32_t direction = delta == 1 ? 1 : -1;
+  if (HALSIM_GetEncoderReverseDirection(index)) direction = -direction;
+
+  double period = std::max<uint64_t>(time - decoder.lastEdge, 1) * 1.0e-6;
+  decoder.lastEdge = time;
+  decoder.stopped = false;
+  HALSIM_SetEncoderCount(index, HALSIM_GetEncoderCount(index) + direction);
+  HALSIM_SetEncoderPeriod(index, direction * period);
+  HALSIM_SetEncoderDirection(index, direction > 0);
+}
+
+// Turns the motors by a step of simulated time
+void SimTestBench::Step(uint64_t time) {
+  double dt = (time - m_lastStep) * 1.0e-6;
+  m_lastStep = time;
+
+  bool enabled = HALSIM_GetDriverStationEnabled();
+  hal::sim::DeviceTables tables =
+      hal::sim::GetExtensionHost().GetDeviceTables();
+  double response = std::min(dt / kMotorTimeConstant, 1.0);
+  for (auto& motor : m_motors) {
+    double target =
+        enabled ? tables.pwmSpeeds[motor.pwmChannel] * kMotorFreeSpeed : 0.0;
+    motor.speed += (target - motor.speed) * response;
+
+    int64_t from = static_cast<int64_t>(std::floor(motor.phase));
+    motor.phase += motor.speed * dt;
+    int64_t to = static_cast<int64_t>(std::floor(motor.phase));
+    // Step the signals through every state between, so none are missed
+    int64_t direction = to > from ? 1 : -1;
+    for (int64_t i = from; i != to; i += direction) {
+      int32_t signals = kQuadratureSignals[((i + direction) % 4 + 4) % 4];
+      HALSIM_SetDIOValue(motor.channelA, (signals & 1) != 0);
+      HALSIM_SetDIOValue(motor.channelB, (signals & 2) != 0);
+    }
+  }
+
+  // Encoders without an edge for a while have stopped
+  std::lock_guard<wpi::mutex> lock(m_decoderMutex);
+  for (size_t i = 0; i < m_decoders.size(); i++) {
+    Decoder& decoder = m_decoders[i];
+    if (decoder.stopped || time - decoder.lastEdge < kStoppedTime) continue;
+    decoder.stopped = true;
+    HALSIM_SetEncoderPeriod(i, std::numeric_limits<double>::max());
+  }
+}
+
+void SimTestBench::ClockMain() {
+  while (m_running) {
+    HALSIM_StepTiming(kClockStep);
+    // Let the threads woken by the step run before the next one
+    std::this_thread::yield();
+  }
+}
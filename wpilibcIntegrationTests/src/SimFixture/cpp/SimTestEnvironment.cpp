@@ -0,0 +1,68 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <cstdlib>
+
+#include <HAL/HAL.h>
+#include <MockData/DriverStationData.h>
+#include <llvm/raw_ostream.h>
+
+#include "LiveWindow/LiveWindow.h"
+#include "SimTestBench.h"
+#include "gtest/gtest.h"
+
+using namespace frc;
+
+// Tests of hardware the simulator doesn't model: the PCM, PDP, gyro and SPI
+// accelerometer, DIO PWM generators and encoder index pulses
+static const char* kUnsupportedTests =
+    "-PCMTest.*:PowerDistributionPanelTest.*:TiltPanCameraTest.*:"
+    "DIOLoopTest.DIOPWM:FakeEncoderTest.TestReset*";
+
+namespace {
+// Runs before main() parses the command line, so --gtest_filter still
+// overrides it
+struct DefaultFilter {
+  DefaultFilter() { testing::GTEST_FLAG(filter) = kUnsupportedTests; }
+} defaultFilter;
+}  // namespace
+
+/**
+ * Runs the integration tests against the simulator HAL, with the test stand's
+ * wiring simulated by SimTestBench in place of MockDS and the real stand.
+ */
+class SimTestEnvironment : public testing::Environment {
+  bool m_alreadySetUp = false;
+  SimTestBench m_testBench;
+
+ public:
+  void SetUp() override {
+    /* Only set up once.  This allows gtest_repeat to be used to
+            automatically repeat tests. */
+    if (m_alreadySetUp) return;
+    m_alreadySetUp = true;
+
+    if (!HAL_Initialize(500, 0)) {
+      llvm::errs() << "FATAL ERROR: HAL could not be initialized\n";
+      std::exit(-1);
+    }
+
+    HALSIM_SetDriverStationDsAttached(true);
+    HALSIM_SetDriverStationEnabled(true);
+    HALSIM_NotifyDriverStationNewData();
+
+    m_testBench.Start();
+
+    HAL_ObserveUserProgramStarting();
+    LiveWindow::GetInstance()->SetEnabled(false);
+  }
+
+  void TearDown() override { m_testBench.Stop(); }
+};
+
+testing::Environment* const environment =
+    testing::AddGlobalTestEnvironment(new SimTestEnvironment);
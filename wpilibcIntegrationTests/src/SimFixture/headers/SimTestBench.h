@@ -0,0 +1,109 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <stdint.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <HAL/SimExtension.h>
+#include <MockData/HAL_Value.h>
+#include <support/mutex.h>
+
+namespace frc {
+
+/**
+ * The wiring of the test stand, on the simulator HAL.
+ *
+ * DIO, analog and relay loopbacks copy each output to the input it is wired
+ * to, and each motor turns a quadrature encoder whose DIO signals are decoded
+ * into the counts of the encoder allocated on them. Simulated time is paused
+ * and stepped as fast as the robot program keeps up, so waits take no wall
+ * clock time.
+ */
+class SimTestBench {
+ public:
+  // Simulated time advanced per step, in microseconds
+  static constexpr uint64_t kClockStep = 100;
+
+  // Encoder counts per second of a motor at full speed, and the time constant
+  // of its speed, in seconds
+  static constexpr double kMotorFreeSpeed = 2500.0;
+  static constexpr double kMotorTimeConstant = 0.05;
+
+  // Time without an edge after which an encoder is seen as stopped, in
+  // microseconds
+  static constexpr uint64_t kStoppedTime = 500000;
+
+  SimTestBench() = default;
+  ~SimTestBench() { Stop(); }
+
+  SimTestBench(const SimTestBench&) = delete;
+  SimTestBench& operator=(const SimTestBench&) = delete;
+
+  void Start();
+  void Stop();
+
+ private:
+  struct Motor {
+    Motor(int32_t pwmChannel, int32_t channelA, int32_t channelB)
+        : pwmChannel(pwmChannel), channelA(channelA), channelB(channelB) {}
+
+    int32_t pwmChannel;
+    int32_t channelA;
+    int32_t channelB;
+    double speed = 0.0;  // counts per second
+    double phase = 0.0;  // counts, driving the quadrature signals
+  };
+
+  struct Decoder {
+    int32_t channelA = -1;
+    int32_t channelB = -1;
+    int32_t state = 0;
+    uint64_t lastEdge = 0;
+    bool stopped = true;
+  };
+
+  struct Channel {
+    SimTestBench* bench;
+    int32_t channel;
+  };
+
+  static void DIOCallback(const char* name, void* param,
+                          const HAL_Value* value);
+  static void AnalogCallback(const char* name, void* param,
+                             const HAL_Value* value);
+  static void RelayForwardCallback(const char* name, void* param,
+                                   const HAL_Value* value);
+  static void RelayReverseCallback(const char* name, void* param,
+                                   const HAL_Value* value);
+  static void StepCallback(void* param, uint64_t time);
+
+  void Decode(int32_t channel, uint64_t time);
+  void Step(uint64_t time);
+  void ClockMain();
+
+  std::vector<Channel> m_channels;
+  std::vector<int32_t> m_dioLoopbacks;  // input wired to each DIO, or -1
+  std::vector<Motor> m_motors;
+  std::vector<Decoder> m_decoders;  // per encoder
+  wpi::mutex m_decoderMutex;
+  std::vector<int32_t> m_dioCallbacks;
+  int32_t m_analogCallback = 0;
+  int32_t m_relayForwardCallback = 0;
+  int32_t m_relayReverseCallback = 0;
+  int32_t m_stepCallback = -1;
+  uint64_t m_lastStep = 0;
+
+  std::thread m_clock;
+  std::atomic<bool> m_running{false};
+};
+
+}  // namespace frc
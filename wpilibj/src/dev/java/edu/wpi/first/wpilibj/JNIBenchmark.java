@@ -0,0 +1,128 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+package edu.wpi.first.wpilibj;
+
+import java.io.FileWriter;
+import java.io.IOException;
+import java.io.PrintWriter;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+
+import edu.wpi.first.wpilibj.hal.DIOJNI;
+import edu.wpi.first.wpilibj.hal.EncoderJNI;
+import edu.wpi.first.wpilibj.hal.HAL;
+import edu.wpi.first.wpilibj.hal.HALUtil;
+import edu.wpi.first.wpilibj.hal.ReadGroupJNI;
+import edu.wpi.first.wpilibj.hal.SPIJNI;
+
+/**
+ * Measures the per-call latency of representative HAL JNI bindings.
+ *
+ * <p>Each call is timed on its own with System.nanoTime(), after a warmup, and the median and
+ * 99th percentile are printed with the cost of the timer itself subtracted. Runs on athena and
+ * sim. With a file name argument, one CSV line per binding is appended to that file (time, runtime
+ * type, name, p50 ns, p99 ns), so results can be compared over time.
+ *
+ * <p>Run with {@code gradlew :wpilibj:jniBenchmark}, optionally with
+ * {@code -PbenchmarkOutput=file.csv}.
+ */
+public final class JNIBenchmark {
+  private static final int kWarmupCalls = 20000;
+  private static final int kMeasuredCalls = 100000;
+
+  private final List<String> m_results = new ArrayList<>();
+  private final long[] m_samples = new long[kMeasuredCalls];
+  private long m_timerOverhead;
+
+  private JNIBenchmark() {
+  }
+
+  /**
+   * Main entry point.
+   */
+  public static void main(String[] args) throws IOException {
+    if (!HAL.initialize(500, 0)) {
+      throw new IllegalStateException("Failed to initialize the HAL");
+    }
+    new JNIBenchmark().run(args.length > 0 ? args[0] : null);
+  }
+
+  private void run(String outputFile) throws IOException {
+    m_timerOverhead = measure(() -> { });
+    System.out.println("timer overhead: " + m_timerOverhead + " ns");
+
+    final int dio = DIOJNI.initializeDIOPort(DIOJNI.getPort((byte) 0), true);
+    final int dioB = DIOJNI.initializeDIOPort(DIOJNI.getPort((byte) 1), true);
+    final int encoder = EncoderJNI.initializeEncoder(dio, 0, dioB, 0, false,
+        CounterBase.EncodingType.k4X.value);
+    final float[] axes = new float[HAL.kMaxJoystickAxes];
+    final int spiPort = SPI.Port.kOnboardCS0.value;
+    SPIJNI.spiInitialize(spiPort);
+    final ByteBuffer spiSend = ByteBuffer.allocateDirect(4);
+    final ByteBuffer spiReceive = ByteBuffer.allocateDirect(4);
+
+    final ByteBuffer snapshot =
+        ByteBuffer.allocateDirect(HAL.kDSSnapshotSize).order(ByteOrder.nativeOrder());
+    HAL.setDSSnapshotBuffer(snapshot);
+    final int readGroup = ReadGroupJNI.initializeReadGroup(
+        new int[] {ReadGroupJNI.kDIO, ReadGroupJNI.kEncoderCount},
+        new int[] {dioB, encoder});
+    final ByteBuffer readGroupBuffer =
+        ByteBuffer.allocateDirect(2 * ReadGroupJNI.kEntrySize).order(ByteOrder.nativeOrder());
+
+    benchmark("getFPGATime", HALUtil::getFPGATime);
+    benchmark("getDIO", () -> DIOJNI.getDIO(dio));
+    benchmark("getEncoder", () -> EncoderJNI.getEncoder(encoder));
+    benchmark("getJoystickAxes", () -> HAL.getJoystickAxes((byte) 0, axes));
+    benchmark("spiTransaction", () -> SPIJNI.spiTransaction(spiPort, spiSend, spiReceive,
+        (byte) 4));
+    // The batched calls, to compare against their unbatched equivalents
+    benchmark("getDSSnapshot", HAL::getDSSnapshot);
+    benchmark("readGroup(2)", () -> ReadGroupJNI.readGroup(readGroup, readGroupBuffer));
+
+    ReadGroupJNI.freeReadGroup(readGroup);
+    HAL.setDSSnapshotBuffer(null);
+    SPIJNI.spiClose(spiPort);
+    EncoderJNI.freeEncoder(encoder);
+    DIOJNI.freeDIOPort(dioB);
+    DIOJNI.freeDIOPort(dio);
+
+    if (outputFile != null) {
+      try (PrintWriter writer = new PrintWriter(new FileWriter(outputFile, true))) {
+        m_results.forEach(writer::println);
+      }
+    }
+  }
+
+  private void benchmark(String name, Runnable call) {
+    long p50 = measure(call) - m_timerOverhead;
+    long p99 = m_samples[kMeasuredCalls * 99 / 100] - m_timerOverhead;
+    System.out.println(name + ": p50 " + p50 + " ns, p99 " + p99 + " ns");
+    m_results.add(System.currentTimeMillis() + "," + HALUtil.getHALRuntimeType() + "," + name
+        + "," + p50 + "," + p99);
+  }
+
+  /**
+   * Times each call, and returns the median. m_samples is left sorted.
+   */
+  private long measure(Runnable call) {
+    for (int i = 0; i < kWarmupCalls; i++) {
+      call.run();
+    }
+    for (int i = 0; i < kMeasuredCalls; i++) {
+      long start = System.nanoTime();
+      call.run();
+      m_samples[i] = System.nanoTime() - start;
+    }
+    Arrays.sort(m_samples);
+    return m_samples[kMeasuredCalls / 2];
+  }
+}
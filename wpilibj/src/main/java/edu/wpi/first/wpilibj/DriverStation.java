@@ -8,6 +8,8 @@
 package edu.wpi.first.wpilibj;
 
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.locks.Condition;
 import java.util.concurrent.locks.Lock;
@@ -143,8 +145,10 @@ public class DriverStation implements RobotState.Interface {
   HALJoystickButtons[] m_joystickButtonsPressed = new HALJoystickButtons[kJoystickPorts];
   HALJoystickButtons[] m_joystickButtonsReleased = new HALJoystickButtons[kJoystickPorts];
 
-  // preallocated byte buffer for button count
-  private ByteBuffer m_buttonCountBuffer = ByteBuffer.allocateDirect(1);
+  // Filled by HAL.getDSSnapshot() with the whole DS state at once
+  private final ByteBuffer m_snapshotBuffer =
+      ByteBuffer.allocateDirect(HAL.kDSSnapshotSize).order(ByteOrder.nativeOrder());
+  private final byte[] m_snapshotString = new byte[HAL.kDSSnapshotStringSize];
 
   private MatchDataSender m_matchDataSender;
 
@@ -207,6 +211,8 @@ public class DriverStation implements RobotState.Interface {
     m_controlWordCache = new ControlWord();
     m_lastControlWordUpdate = 0;
 
+    HAL.setDSSnapshotBuffer(m_snapshotBuffer);
+
     m_matchDataSender = new MatchDataSender();
 
     m_thread = new Thread(new DriverStationTask(this), "FRCDriverStation");
@@ -1020,20 +1026,42 @@ public class DriverStation implements RobotState.Interface {
    * otherwise the data will be copied from the DS polling loop.
    */
   protected void getData() {
-    // Get the status of all of the joysticks
-    for (byte stick = 0; stick < kJoystickPorts; stick++) {
-      m_joystickAxesCache[stick].m_count =
-          HAL.getJoystickAxes(stick, m_joystickAxesCache[stick].m_axes);
-      m_joystickPOVsCache[stick].m_count =
-          HAL.getJoystickPOVs(stick, m_joystickPOVsCache[stick].m_povs);
-      m_joystickButtonsCache[stick].m_buttons = HAL.getJoystickButtons(stick, m_buttonCountBuffer);
-      m_joystickButtonsCache[stick].m_count = m_buttonCountBuffer.get(0);
+    // Get the control word, joysticks and match info in one call
+    HAL.getDSSnapshot();
+    ByteBuffer snapshot = m_snapshotBuffer;
+
+    for (int stick = 0; stick < kJoystickPorts; stick++) {
+      int offset = HAL.kDSSnapshotJoysticksOffset + stick * HAL.kDSSnapshotJoystickSize;
+      HALJoystickAxes axes = m_joystickAxesCache[stick];
+      axes.m_count = (short) (snapshot.get(offset + HAL.kDSSnapshotAxisCountOffset) & 0xff);
+      for (int i = 0; i < axes.m_axes.length; i++) {
+        axes.m_axes[i] = snapshot.getFloat(offset + HAL.kDSSnapshotAxesOffset + 4 * i);
+      }
+      HALJoystickPOVs povs = m_joystickPOVsCache[stick];
+      povs.m_count = (short) (snapshot.get(offset + HAL.kDSSnapshotPOVCountOffset) & 0xff);
+      for (int i = 0; i < povs.m_povs.length; i++) {
+        povs.m_povs[i] = snapshot.getShort(offset + HAL.kDSSnapshotPOVsOffset + 2 * i);
+      }
+      HALJoystickButtons buttons = m_joystickButtonsCache[stick];
+      buttons.m_buttons = snapshot.getInt(offset + HAL.kDSSnapshotButtonsOffset);
+      buttons.m_count = snapshot.get(offset + HAL.kDSSnapshotButtonCountOffset);
     }
 
-    HAL.getMatchInfo(m_matchInfoCache);
+    int messageSize = Math.min(HAL.kDSSnapshotStringSize,
+        Math.max(0, snapshot.getInt(HAL.kDSSnapshotGameSpecificMessageSizeOffset)));
+    m_matchInfoCache.setData(
+        getSnapshotString(HAL.kDSSnapshotEventNameOffset, HAL.kDSSnapshotStringSize, true),
+        getSnapshotString(HAL.kDSSnapshotGameSpecificMessageOffset, messageSize, false),
+        snapshot.getInt(HAL.kDSSnapshotMatchNumberOffset),
+        snapshot.getInt(HAL.kDSSnapshotReplayNumberOffset),
+        snapshot.getInt(HAL.kDSSnapshotMatchTypeOffset));
 
-    // Force a control word update, to make sure the data is the newest.
-    updateControlWord(true);
+    // Update the control word cache, to make sure the data is the newest.
+    synchronized (m_controlWordMutex) {
+      HAL.decodeControlWord(snapshot.getInt(HAL.kDSSnapshotControlWordOffset),
+          m_controlWordCache);
+      m_lastControlWordUpdate = System.currentTimeMillis();
+    }
 
     // lock joystick mutex to swap cache data
     synchronized (m_cacheDataMutex) {
@@ -1073,6 +1101,18 @@ public class DriverStation implements RobotState.Interface {
     sendMatchData();
   }
 
+  /**
+   * Decodes a string from the snapshot buffer, optionally ending at the first null.
+   */
+  private String getSnapshotString(int offset, int length, boolean nullTerminated) {
+    int size = 0;
+    while (size < length && (!nullTerminated || m_snapshotBuffer.get(offset + size) != 0)) {
+      m_snapshotString[size] = m_snapshotBuffer.get(offset + size);
+      size++;
+    }
+    return new String(m_snapshotString, 0, size, StandardCharsets.UTF_8);
+  }
+
   /**
    * Reports errors related to unplugged joysticks Throttles the errors so that they don't overwhelm
    * the DS.
@@ -57,6 +57,7 @@ public class Notifier {
     if (notifier == 0) {
       return;
     }
+    NotifierJNI.setNotifierPeriodic(notifier, m_periodic ? (long) (m_period * 1e6) : 0);
     NotifierJNI.updateNotifierAlarm(notifier, (long) (m_expirationTime * 1e6));
   }
 
@@ -81,14 +82,11 @@ public class Notifier {
           break;
         }
 
+        // Periodic alarms are re-armed by the HAL
         Runnable handler = null;
         m_processLock.lock();
         try {
           handler = m_handler;
-          if (m_periodic) {
-            m_expirationTime += m_period;
-            updateAlarm();
-          }
         } finally {
           m_processLock.unlock();
         }
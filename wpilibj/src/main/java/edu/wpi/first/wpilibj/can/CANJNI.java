@@ -21,6 +21,13 @@ public class CANJNI extends JNIWrapper {
   public static final int CAN_IS_FRAME_REMOTE = 0x80000000;
   public static final int CAN_IS_FRAME_11BIT = 0x40000000;
 
+  /* Layout of each message ReadStreamSession() writes, in native byte order */
+  public static final int kStreamMessageSize = 20;
+  public static final int kStreamMessageIDOffset = 0;
+  public static final int kStreamMessageTimeStampOffset = 4;
+  public static final int kStreamMessageDataOffset = 8;
+  public static final int kStreamMessageDataSizeOffset = 16;
+
   @SuppressWarnings("MethodName")
   public static native void FRCNetCommCANSessionMuxSendMessage(int messageID,
                                                                byte[] data,
@@ -30,6 +37,36 @@ public class CANJNI extends JNIWrapper {
   public static native byte[] FRCNetCommCANSessionMuxReceiveMessage(
       IntBuffer messageID, int messageIDMask, ByteBuffer timeStamp);
 
+  /**
+   * Receives a message into direct buffers instead of allocating an array.
+   *
+   * @return the number of data bytes, or -1 if no matching message has been received
+   */
+  @SuppressWarnings("MethodName")
+  public static native int FRCNetCommCANSessionMuxReceiveMessageDirect(
+      IntBuffer messageID, int messageIDMask, ByteBuffer data, ByteBuffer timeStamp);
+
+  /**
+   * Opens a session that buffers up to maxMessages matching messages for ReadStreamSession().
+   *
+   * @return the session handle
+   */
+  @SuppressWarnings("MethodName")
+  public static native int OpenStreamSession(int messageID, int messageIDMask, int maxMessages);
+
+  @SuppressWarnings("MethodName")
+  public static native void CloseStreamSession(int sessionHandle);
+
+  /**
+   * Reads up to messagesToRead buffered messages into a direct buffer, kStreamMessageSize bytes
+   * each.
+   *
+   * @return the number of messages read
+   */
+  @SuppressWarnings("MethodName")
+  public static native int ReadStreamSession(int sessionHandle, ByteBuffer messages,
+                                             int messagesToRead);
+
 
   @SuppressWarnings("MethodName")
   public static native void GetCANStatus(CANStatus status);
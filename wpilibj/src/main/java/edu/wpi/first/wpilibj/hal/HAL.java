@@ -56,7 +56,13 @@ public class HAL extends JNIWrapper {
 
   @SuppressWarnings("JavadocMethod")
   public static void getControlWord(ControlWord controlWord) {
-    int word = nativeGetControlWord();
+    decodeControlWord(nativeGetControlWord(), controlWord);
+  }
+
+  /**
+   * Sets a control word from its native representation.
+   */
+  public static void decodeControlWord(int word, ControlWord controlWord) {
     controlWord.update((word & 1) != 0, ((word >> 1) & 1) != 0, ((word >> 2) & 1) != 0,
         ((word >> 3) & 1) != 0, ((word >> 4) & 1) != 0, ((word >> 5) & 1) != 0);
   }
@@ -120,6 +126,40 @@ public class HAL extends JNIWrapper {
 
   public static native int getMatchInfo(MatchInfoData info);
 
+  // Layout of the DS snapshot buffer, in native byte order. The event name is
+  // null-terminated; the game specific message is as long as its size field.
+  public static final int kDSSnapshotSize = 640;
+  public static final int kDSSnapshotControlWordOffset = 0;
+  public static final int kDSSnapshotAllianceStationOffset = 4;
+  public static final int kDSSnapshotMatchTypeOffset = 8;
+  public static final int kDSSnapshotMatchNumberOffset = 12;
+  public static final int kDSSnapshotReplayNumberOffset = 16;
+  public static final int kDSSnapshotGameSpecificMessageSizeOffset = 20;
+  public static final int kDSSnapshotJoysticksOffset = 32;
+  public static final int kDSSnapshotJoystickSize = 80;
+  public static final int kDSSnapshotButtonsOffset = 0;
+  public static final int kDSSnapshotButtonCountOffset = 4;
+  public static final int kDSSnapshotAxisCountOffset = 5;
+  public static final int kDSSnapshotPOVCountOffset = 6;
+  public static final int kDSSnapshotAxesOffset = 8;
+  public static final int kDSSnapshotPOVsOffset = 56;
+  public static final int kDSSnapshotEventNameOffset = 512;
+  public static final int kDSSnapshotGameSpecificMessageOffset = 576;
+  public static final int kDSSnapshotStringSize = 64;
+
+  /**
+   * Registers the direct buffer getDSSnapshot() fills. It must hold at least kDSSnapshotSize
+   * bytes, and should be in native byte order.
+   */
+  public static native void setDSSnapshotBuffer(ByteBuffer buffer);
+
+  /**
+   * Fills the registered buffer with the control word, alliance station, every joystick and the
+   * match info, in one call. Returns 0 on success; the match info is left alone if it could not
+   * be read.
+   */
+  public static native int getDSSnapshot();
+
   public static native int sendError(boolean isError, int errorCode, boolean isLVCode,
                                      String details, String location, String callStack,
                                      boolean printMsg);
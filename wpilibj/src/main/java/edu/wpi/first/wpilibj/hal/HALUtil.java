@@ -7,6 +7,8 @@
 
 package edu.wpi.first.wpilibj.hal;
 
+import java.nio.ByteBuffer;
+
 @SuppressWarnings("AbbreviationAsWordInName")
 public class HALUtil extends JNIWrapper {
   public static final int NULL_PARAMETER = -1005;
@@ -37,4 +39,52 @@ public class HALUtil extends JNIWrapper {
   public static String getHALstrerror() {
     return getHALstrerror(getHALErrno());
   }
+
+  /**
+   * Logs one in every {@code period} JNI calls by name, to see which HAL functions robot code
+   * calls most. A period of 0 disables tracing.
+   */
+  public static native void setJNITracePeriod(int period);
+
+  // HAL performance counter indices; see HAL/PerfCounters.h
+  public static final int kPerfCounterDIO = 0;
+  public static final int kPerfCounterAnalog = 1;
+  public static final int kPerfCounterPWM = 2;
+  public static final int kPerfCounterEncoder = 3;
+  public static final int kPerfCounterCounter = 4;
+  public static final int kPerfCounterSPI = 5;
+  public static final int kPerfCounterI2C = 6;
+  public static final int kPerfCounterSerial = 7;
+  public static final int kPerfCounterCAN = 8;
+  public static final int kPerfCounterDriverStation = 9;
+  public static final int kPerfCounterNotifier = 10;
+  public static final int kPerfCounterInterrupt = 11;
+  public static final int kPerfCounterJNI = 12;
+  public static final int kPerfCounterNotifierLateness = 13;
+  public static final int kPerfCounterDSWakeLatency = 14;
+  public static final int kPerfCounterCount = 15;
+
+  /**
+   * The size of one counter in the getPerfCounters() buffer: three native order longs, the count,
+   * the total time in nanoseconds and the longest time since resetPerfCounterMaximums().
+   */
+  public static final int kPerfCounterEntrySize = 24;
+  public static final int kPerfCounterCountOffset = 0;
+  public static final int kPerfCounterTotalTimeOffset = 8;
+  public static final int kPerfCounterMaxTimeOffset = 16;
+
+  /**
+   * Enables counting of HAL calls and JNI transitions. Off by default.
+   */
+  public static native void setPerfCountersEnabled(boolean enabled);
+
+  /**
+   * Copies the totals of every counter, summed over all threads, into a direct buffer of up to
+   * kPerfCounterCount entries.
+   *
+   * @return the number of counters copied
+   */
+  public static native int getPerfCounters(ByteBuffer buffer);
+
+  public static native void resetPerfCounterMaximums();
 }
@@ -19,6 +19,26 @@ public class I2CJNI extends JNIWrapper {
   public static native int i2CTransactionB(int port, byte address, byte[] dataToSend,
                                            byte sendSize, byte[] dataReceived, byte receiveSize);
 
+  /**
+   * The size in bytes of one i2CTransactionBatch descriptor. Descriptors are five native order
+   * ints: the device address, send offset, send size, receive offset and receive size. An
+   * offset of -1 means no data.
+   */
+  public static final int kBatchDescriptorSize = 20;
+  public static final int kBatchAddress = 0;
+  public static final int kBatchSendOffset = 4;
+  public static final int kBatchSendSize = 8;
+  public static final int kBatchReceiveOffset = 12;
+  public static final int kBatchReceiveSize = 16;
+
+  /**
+   * Runs several transactions in one call, stopping at the first that fails. The buffer is direct
+   * and starts with count descriptors; their offsets refer to data elsewhere in the same buffer.
+   *
+   * @return the number of transactions that completed
+   */
+  public static native int i2CTransactionBatch(int port, ByteBuffer buffer, int count);
+
   public static native int i2CWrite(int port, byte address, ByteBuffer dataToSend, byte sendSize);
 
   public static native int i2CWriteB(int port, byte address, byte[] dataToSend, byte sendSize);
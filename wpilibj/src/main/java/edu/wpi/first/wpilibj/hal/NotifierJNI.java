@@ -35,6 +35,12 @@ public class NotifierJNI extends JNIWrapper {
    */
   public static native void updateNotifierAlarm(int notifierHandle, long triggerTime);
 
+  /**
+   * Makes each alarm re-arm itself period microseconds after it was due, so a periodic waiter
+   * doesn't need to call updateNotifierAlarm() every tick. A period of 0 makes alarms one-shot.
+   */
+  public static native void setNotifierPeriodic(int notifierHandle, long period);
+
   /**
    * Cancels any pending wakeups set by updateNotifierAlarm().  Does NOT wake
    * up any waiters.
@@ -0,0 +1,57 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+package edu.wpi.first.wpilibj.hal;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Reads a fixed group of sensors in one native call.
+ *
+ * <p>A group is created once from a list of (type, handle) pairs. Each read then fills a direct
+ * buffer, in native byte order, with one kEntrySize entry per pair: the value as a double at
+ * kValueOffset and the HAL status as an int at kStatusOffset. Failed reads do not throw; check
+ * the status of each entry instead.
+ */
+@SuppressWarnings("AbbreviationAsWordInName")
+public class ReadGroupJNI extends JNIWrapper {
+  public static final int kEncoderCount = 0;
+  public static final int kEncoderRaw = 1;
+  public static final int kEncoderDistance = 2;
+  public static final int kEncoderRate = 3;
+  public static final int kEncoderPeriod = 4;
+  public static final int kCounterCount = 5;
+  public static final int kCounterPeriod = 6;
+  public static final int kAnalogValue = 7;
+  public static final int kAnalogAverageValue = 8;
+  public static final int kAnalogVoltage = 9;
+  public static final int kAnalogAverageVoltage = 10;
+  public static final int kDIO = 11;
+  public static final int kAnalogGyroAngle = 12;
+  public static final int kAnalogGyroRate = 13;
+
+  public static final int kEntrySize = 16;
+  public static final int kValueOffset = 0;
+  public static final int kStatusOffset = 8;
+
+  /**
+   * Creates a read group. The arrays must be the same length.
+   *
+   * @return the read group handle
+   */
+  public static native int initializeReadGroup(int[] types, int[] handles);
+
+  public static native void freeReadGroup(int readGroupHandle);
+
+  /**
+   * Reads every sensor of the group into the buffer, which must be direct and hold at least
+   * kEntrySize bytes per sensor.
+   *
+   * @return the number of sensors whose read failed
+   */
+  public static native int readGroup(int readGroupHandle, ByteBuffer buffer);
+}
@@ -19,6 +19,27 @@ public class SPIJNI extends JNIWrapper {
   public static native int spiTransactionB(int port, byte[] dataToSend,
                                            byte[] dataReceived, byte size);
 
+  /**
+   * The size in bytes of one spiTransactionBatch descriptor. Descriptors are five native order
+   * ints: the send offset, receive offset (either -1 for none), size, whether to change chip
+   * select after the transfer and a delay in microseconds before the next one.
+   */
+  public static final int kBatchDescriptorSize = 20;
+  public static final int kBatchSendOffset = 0;
+  public static final int kBatchReceiveOffset = 4;
+  public static final int kBatchSize = 8;
+  public static final int kBatchCSChange = 12;
+  public static final int kBatchDelay = 16;
+  public static final int kMaxBatchTransfers = 32;
+
+  /**
+   * Runs several transfers in one call. The buffer is direct and starts with count descriptors;
+   * their offsets refer to data elsewhere in the same buffer.
+   *
+   * @return the total number of bytes transferred, or -1 on failure
+   */
+  public static native int spiTransactionBatch(int port, ByteBuffer buffer, int count);
+
   public static native int spiWrite(int port, ByteBuffer dataToSend, byte sendSize);
 
   public static native int spiWriteB(int port, byte[] dataToSend, byte sendSize);
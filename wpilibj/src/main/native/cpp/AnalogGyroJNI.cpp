@@ -20,11 +20,7 @@ using namespace frc;
 // set the logging level
 TLogLevel analogGyroJNILogLevel = logWARNING;
 
-#define ANALOGGYROJNI_LOG(level)     \
-  if (level > analogGyroJNILogLevel) \
-    ;                           \
-  else                          \
-  Log().Get(level)
+#define ANALOGGYROJNI_LOG(level) JNI_LOG(analogGyroJNILogLevel, level)
 
 extern "C" {
 /*
@@ -34,7 +30,7 @@ extern "C" {
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_initializeAnalogGyro(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI initializeAnalogGyro";
+  JNI_TRACE("ANALOGGYROJNI initializeAnalogGyro");
   ANALOGGYROJNI_LOG(logDEBUG) << "Analog Input Handle = " << (HAL_AnalogInputHandle)id;
   int32_t status = 0;
   HAL_GyroHandle handle = HAL_InitializeAnalogGyro((HAL_AnalogInputHandle)id, &status);
@@ -52,7 +48,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_initializeAn
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_setupAnalogGyro(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI setupAnalogGyro";
+  JNI_TRACE("ANALOGGYROJNI setupAnalogGyro");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   HAL_SetupAnalogGyro((HAL_GyroHandle)id, &status);
@@ -67,7 +63,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_setupAnalogG
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_freeAnalogGyro(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI freeAnalogGyro";
+  JNI_TRACE("ANALOGGYROJNI freeAnalogGyro");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   HAL_FreeAnalogGyro((HAL_GyroHandle)id);
 }
@@ -79,7 +75,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_freeAnalogGy
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_setAnalogGyroParameters(
     JNIEnv* env, jclass, jint id, jdouble vPDPS, jdouble offset, jint center) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI setAnalogGyroParameters";
+  JNI_TRACE("ANALOGGYROJNI setAnalogGyroParameters");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   HAL_SetAnalogGyroParameters((HAL_GyroHandle)id, vPDPS, offset, center, &status);
@@ -94,7 +90,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_setAnalogGyr
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_setAnalogGyroVoltsPerDegreePerSecond(
     JNIEnv* env, jclass, jint id, jdouble vPDPS) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI setAnalogGyroVoltsPerDegreePerSecond";
+  JNI_TRACE("ANALOGGYROJNI setAnalogGyroVoltsPerDegreePerSecond");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   ANALOGGYROJNI_LOG(logDEBUG) << "vPDPS = " << vPDPS;
   int32_t status = 0;
@@ -110,7 +106,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_setAnalogGyr
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_resetAnalogGyro(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI resetAnalogGyro";
+  JNI_TRACE("ANALOGGYROJNI resetAnalogGyro");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   HAL_ResetAnalogGyro((HAL_GyroHandle)id, &status);
@@ -125,7 +121,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_resetAnalogG
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_calibrateAnalogGyro(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI calibrateAnalogGyro";
+  JNI_TRACE("ANALOGGYROJNI calibrateAnalogGyro");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   HAL_CalibrateAnalogGyro((HAL_GyroHandle)id, &status);
@@ -140,7 +136,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_calibrateAna
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_setAnalogGyroDeadband(
     JNIEnv* env, jclass, jint id, jdouble deadband) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI setAnalogGyroDeadband";
+  JNI_TRACE("ANALOGGYROJNI setAnalogGyroDeadband");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   HAL_SetAnalogGyroDeadband((HAL_GyroHandle)id, deadband, &status);
@@ -155,7 +151,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_setAnalogGyr
  */
 JNIEXPORT jdouble JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_getAnalogGyroAngle(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI getAnalogGyroAngle";
+  JNI_TRACE("ANALOGGYROJNI getAnalogGyroAngle");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   jdouble value = HAL_GetAnalogGyroAngle((HAL_GyroHandle)id, &status);
@@ -172,7 +168,7 @@ JNIEXPORT jdouble JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_getAnalog
  */
 JNIEXPORT jdouble JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_getAnalogGyroRate(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI getAnalogGyroRate";
+  JNI_TRACE("ANALOGGYROJNI getAnalogGyroRate");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   jdouble value = HAL_GetAnalogGyroRate((HAL_GyroHandle)id, &status);
@@ -189,7 +185,7 @@ JNIEXPORT jdouble JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_getAnalog
  */
 JNIEXPORT jdouble JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_getAnalogGyroOffset(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI getAnalogGyroOffset";
+  JNI_TRACE("ANALOGGYROJNI getAnalogGyroOffset");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   jdouble value = HAL_GetAnalogGyroOffset((HAL_GyroHandle)id, &status);
@@ -206,7 +202,7 @@ JNIEXPORT jdouble JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_getAnalog
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogGyroJNI_getAnalogGyroCenter(
     JNIEnv* env, jclass, jint id) {
-  ANALOGGYROJNI_LOG(logDEBUG) << "Calling ANALOGGYROJNI getAnalogGyroCenter";
+  JNI_TRACE("ANALOGGYROJNI getAnalogGyroCenter");
   ANALOGGYROJNI_LOG(logDEBUG) << "Gyro Handle = " << (HAL_GyroHandle)id;
   int32_t status = 0;
   jint value = HAL_GetAnalogGyroCenter((HAL_GyroHandle)id, &status);
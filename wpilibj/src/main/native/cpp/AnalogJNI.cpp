@@ -24,11 +24,7 @@ using namespace frc;
 // set the logging level
 TLogLevel analogJNILogLevel = logWARNING;
 
-#define ANALOGJNI_LOG(level)     \
-  if (level > analogJNILogLevel) \
-    ;                            \
-  else                           \
-  Log().Get(level)
+#define ANALOGJNI_LOG(level) JNI_LOG(analogJNILogLevel, level)
 
 extern "C" {
 
@@ -144,7 +140,7 @@ Java_edu_wpi_first_wpilibj_hal_AnalogJNI_checkAnalogOutputChannel(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_AnalogJNI_setAnalogOutput(
     JNIEnv *env, jclass, jint id, jdouble voltage) {
-  ANALOGJNI_LOG(logDEBUG) << "Calling setAnalogOutput";
+  JNI_TRACE("setAnalogOutput");
   ANALOGJNI_LOG(logDEBUG) << "Voltage = " << voltage;
   ANALOGJNI_LOG(logDEBUG) << "Analog Handle = " << id;
   int32_t status = 0;
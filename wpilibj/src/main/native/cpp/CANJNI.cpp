@@ -19,15 +19,16 @@
 using namespace frc;
 using namespace wpi::java;
 
+// ReadStreamSession() writes messages straight into the Java buffer, so the
+// layout must match the kStreamMessage constants in CANJNI.java
+static_assert(sizeof(HAL_CANStreamMessage) == 20,
+              "stream message layout must match CANJNI.java");
+
 // set the logging level
 // TLogLevel canJNILogLevel = logDEBUG;
 TLogLevel canJNILogLevel = logERROR;
 
-#define CANJNI_LOG(level)     \
-  if (level > canJNILogLevel) \
-    ;                         \
-  else                        \
-  Log().Get(level)
+#define CANJNI_LOG(level) JNI_LOG(canJNILogLevel, level)
 
 extern "C" {
 
@@ -40,8 +41,7 @@ JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_can_CANJNI_FRCNetCommCANSessionMuxSendMessage(
     JNIEnv *env, jclass, jint messageID, jbyteArray data, jint periodMs) {
 
-  CANJNI_LOG(logDEBUG)
-      << "Calling CANJNI FRCNetCommCANSessionMuxSendMessage";
+  JNI_TRACE("CANJNI FRCNetCommCANSessionMuxSendMessage");
 
   JByteArrayRef dataArray{env, data};
 
@@ -85,8 +85,7 @@ Java_edu_wpi_first_wpilibj_can_CANJNI_FRCNetCommCANSessionMuxReceiveMessage(
     JNIEnv *env, jclass, jobject messageID, jint messageIDMask,
     jobject timeStamp) {
 
-  CANJNI_LOG(logDEBUG)
-      << "Calling CANJNI FRCNetCommCANSessionMuxReceiveMessage";
+  JNI_TRACE("CANJNI FRCNetCommCANSessionMuxReceiveMessage");
 
   uint32_t *messageIDPtr = (uint32_t *)env->GetDirectBufferAddress(messageID);
   uint32_t *timeStampPtr = (uint32_t *)env->GetDirectBufferAddress(timeStamp);
@@ -125,6 +124,109 @@ Java_edu_wpi_first_wpilibj_can_CANJNI_FRCNetCommCANSessionMuxReceiveMessage(
                         static_cast<size_t>(dataSize)});
 }
 
+/*
+ * Class:     edu_wpi_first_wpilibj_can_CANJNI
+ * Method:    FRCNetCommCANSessionMuxReceiveMessageDirect
+ * Signature: (Ljava/nio/IntBuffer;ILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_wpilibj_can_CANJNI_FRCNetCommCANSessionMuxReceiveMessageDirect(
+    JNIEnv *env, jclass, jobject messageID, jint messageIDMask, jobject data,
+    jobject timeStamp) {
+  JNI_TRACE("CANJNI FRCNetCommCANSessionMuxReceiveMessageDirect");
+
+  uint32_t *messageIDPtr = (uint32_t *)env->GetDirectBufferAddress(messageID);
+  uint8_t *dataPtr = (uint8_t *)env->GetDirectBufferAddress(data);
+  uint32_t *timeStampPtr = (uint32_t *)env->GetDirectBufferAddress(timeStamp);
+  if (!messageIDPtr || !dataPtr || !timeStampPtr ||
+      env->GetDirectBufferCapacity(data) < 8) {
+    ThrowIllegalArgumentException(
+        env, "CAN receive needs direct buffers, with room for 8 data bytes");
+    return -1;
+  }
+
+  uint8_t dataSize = 0;
+  int32_t status = 0;
+  HAL_CAN_ReceiveMessage(messageIDPtr, messageIDMask, dataPtr, &dataSize,
+                         timeStampPtr, &status);
+
+  CANJNI_LOG(logDEBUG) << "Status: " << status;
+
+  // Polling for a message that hasn't arrived is the common case, so it is
+  // reported without the cost of an exception
+  if (status == HAL_ERR_CANSessionMux_MessageNotFound) return -1;
+  if (!CheckCANStatus(env, status, *messageIDPtr)) return -1;
+  return dataSize;
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_can_CANJNI
+ * Method:    OpenStreamSession
+ * Signature: (III)I
+ */
+JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_can_CANJNI_OpenStreamSession(
+    JNIEnv *env, jclass, jint messageID, jint messageIDMask,
+    jint maxMessages) {
+  JNI_TRACE("CANJNI OpenStreamSession");
+
+  uint32_t sessionHandle = 0;
+  int32_t status = 0;
+  HAL_CAN_OpenStreamSession(&sessionHandle, messageID, messageIDMask,
+                            maxMessages, &status);
+
+  CANJNI_LOG(logDEBUG) << "Status: " << status;
+  if (!CheckCANStatus(env, status, messageID)) return 0;
+  return static_cast<jint>(sessionHandle);
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_can_CANJNI
+ * Method:    CloseStreamSession
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_can_CANJNI_CloseStreamSession(
+    JNIEnv *, jclass, jint sessionHandle) {
+  JNI_TRACE("CANJNI CloseStreamSession");
+
+  HAL_CAN_CloseStreamSession(static_cast<uint32_t>(sessionHandle));
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_can_CANJNI
+ * Method:    ReadStreamSession
+ * Signature: (ILjava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_can_CANJNI_ReadStreamSession(
+    JNIEnv *env, jclass, jint sessionHandle, jobject messages,
+    jint messagesToRead) {
+  JNI_TRACE("CANJNI ReadStreamSession");
+
+  auto messagesPtr = static_cast<HAL_CANStreamMessage *>(
+      env->GetDirectBufferAddress(messages));
+  if (!messagesPtr || messagesToRead < 0 ||
+      env->GetDirectBufferCapacity(messages) <
+          static_cast<jlong>(messagesToRead) *
+              static_cast<jlong>(sizeof(HAL_CANStreamMessage))) {
+    ThrowIllegalArgumentException(
+        env, "CAN stream messages must be a direct buffer of "
+             "kStreamMessageSize bytes per message");
+    return 0;
+  }
+
+  uint32_t messagesRead = 0;
+  int32_t status = 0;
+  HAL_CAN_ReadStreamSession(static_cast<uint32_t>(sessionHandle), messagesPtr,
+                            messagesToRead, &messagesRead, &status);
+
+  CANJNI_LOG(logDEBUG) << "Messages Read: " << messagesRead;
+  CANJNI_LOG(logDEBUG) << "Status: " << status;
+
+  // An empty stream is not an error when polling
+  if (status == HAL_ERR_CANSessionMux_MessageNotFound) return 0;
+  if (!CheckCANStatus(env, status, 0)) return 0;
+  return static_cast<jint>(messagesRead);
+}
+
 /*
  * Class:     edu_wpi_first_wpilibj_can_CANJNI
  * Method:    GetCANStatus
@@ -132,8 +234,7 @@ Java_edu_wpi_first_wpilibj_can_CANJNI_FRCNetCommCANSessionMuxReceiveMessage(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_can_CANJNI_GetCANStatus
 (JNIEnv *env, jclass, jobject canStatus) {
-  CANJNI_LOG(logDEBUG)
-  << "Calling CANJNI HAL_CAN_GetCANStatus";
+  JNI_TRACE("CANJNI HAL_CAN_GetCANStatus");
 
   float percentBusUtilization = 0;
   uint32_t busOffCount = 0;
@@ -0,0 +1,99 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include "CallbackDispatcher.h"
+
+#include <string>
+
+#include "HALUtil.h"
+
+using namespace frc;
+
+CallbackDispatcher& CallbackDispatcher::GetInstance() {
+  // Never destroyed: the threads stay attached until the JVM exits
+  static CallbackDispatcher* instance = new CallbackDispatcher;
+  return *instance;
+}
+
+CallbackDispatcher::CallbackDispatcher()
+    : m_workers(new Worker[kThreadCount]) {
+  for (int i = 0; i < kThreadCount; i++) {
+    std::thread(&CallbackDispatcher::Main, this, std::ref(m_workers[i]), i)
+        .detach();
+  }
+}
+
+bool CallbackDispatcher::Dispatch(const void* key, Func func, void* context,
+                                  uint64_t value) {
+  Worker& worker = GetWorker(key);
+  if (!worker.queue.Push(Callback{func, context, value})) return false;
+  Wakeup(worker);
+  return true;
+}
+
+void CallbackDispatcher::DispatchBlocking(const void* key, Func func,
+                                          void* context, uint64_t value) {
+  Worker& worker = GetWorker(key);
+  while (!worker.queue.Push(Callback{func, context, value})) {
+    Wakeup(worker);
+    std::this_thread::yield();
+  }
+  Wakeup(worker);
+}
+
+int64_t CallbackDispatcher::GetOverflowCount() const {
+  int64_t count = 0;
+  for (int i = 0; i < kThreadCount; i++) {
+    count += m_workers[i].queue.GetOverflowCount();
+  }
+  return count;
+}
+
+CallbackDispatcher::Worker& CallbackDispatcher::GetWorker(const void* key) {
+  // drop the low bits, which are the same for every aligned object
+  auto hash = reinterpret_cast<uintptr_t>(key) >> 4;
+  return m_workers[hash % kThreadCount];
+}
+
+void CallbackDispatcher::Wakeup(Worker& worker) {
+  // Pairs with the fence in Main(): either the thread sees the callback
+  // before sleeping, or we see it waiting and wake it under its mutex
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!worker.waiting.load(std::memory_order_relaxed)) return;
+  std::lock_guard<wpi::mutex> lock(worker.mutex);
+  worker.wakeup.notify_one();
+}
+
+void CallbackDispatcher::Main(Worker& worker, int index) {
+  std::string name = "Callback" + std::to_string(index);
+  JNIEnv* env;
+  JavaVMAttachArgs args;
+  args.version = JNI_VERSION_1_2;
+  args.name = const_cast<char*>(name.c_str());
+  args.group = nullptr;
+  jint rs = jvm->AttachCurrentThreadAsDaemon(reinterpret_cast<void**>(&env),
+                                             &args);
+  if (rs != JNI_OK) return;
+
+  Callback callback;
+  for (;;) {
+    if (!worker.queue.Pop(&callback)) {
+      std::unique_lock<wpi::mutex> lock(worker.mutex);
+      worker.waiting.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      bool popped = worker.queue.Pop(&callback);
+      if (!popped) worker.wakeup.wait(lock);
+      worker.waiting.store(false, std::memory_order_relaxed);
+      if (!popped) continue;
+    }
+    callback.func(env, callback.context, callback.value);
+    if (env->ExceptionCheck()) {
+      env->ExceptionDescribe();
+      env->ExceptionClear();
+    }
+  }
+}
@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#ifndef CALLBACKDISPATCHER_H
+#define CALLBACKDISPATCHER_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <jni.h>
+#include <support/condition_variable.h>
+#include <support/mutex.h>
+
+#include "HAL/cpp/BoundedMPSCQueue.h"
+
+namespace frc {
+
+// Runs native to Java callbacks on a small pool of threads.
+//
+// JNI's AttachCurrentThread() creates a Java Thread object on every
+// invocation, which is both time inefficient and causes issues with Eclipse
+// (which tries to keep a thread list up-to-date and thus gets swamped).
+// Instead, the pool's threads are attached once, as daemons, and live for the
+// rest of the program. Native code queues a callback without taking a lock,
+// so it can do so from a HAL callback thread, and a pool thread makes the
+// call into Java.
+//
+// Each callback is queued on the thread chosen by its key, so callbacks with
+// the same key (for example the same interrupt) run in order, one at a time.
+class CallbackDispatcher {
+ public:
+  using Func = void (*)(JNIEnv* env, void* context, uint64_t value);
+
+  static CallbackDispatcher& GetInstance();
+
+  CallbackDispatcher(const CallbackDispatcher&) = delete;
+  CallbackDispatcher& operator=(const CallbackDispatcher&) = delete;
+
+  // Queues func(env, context, value). Returns false, dropping the callback,
+  // if the queue of the key's thread is full.
+  bool Dispatch(const void* key, Func func, void* context, uint64_t value = 0);
+
+  // Like Dispatch(), but waits for room instead of dropping the callback; for
+  // callbacks that must run, such as freeing a context.
+  void DispatchBlocking(const void* key, Func func, void* context,
+                        uint64_t value = 0);
+
+  // The number of times a callback found its queue full
+  int64_t GetOverflowCount() const;
+
+ private:
+  static constexpr int kThreadCount = 2;
+  static constexpr size_t kQueueSize = 256;
+
+  struct Callback {
+    Func func;
+    void* context;
+    uint64_t value;
+  };
+
+  struct Worker {
+    hal::BoundedMPSCQueue<Callback, kQueueSize> queue;
+    wpi::mutex mutex;
+    wpi::condition_variable wakeup;
+    // set while the thread is about to sleep, so writers know to wake it
+    std::atomic_bool waiting{false};
+  };
+
+  CallbackDispatcher();
+
+  Worker& GetWorker(const void* key);
+  void Wakeup(Worker& worker);
+  void Main(Worker& worker, int index);
+
+  std::unique_ptr<Worker[]> m_workers;
+};
+
+}  // namespace frc
+
+#endif  // CALLBACKDISPATCHER_H
@@ -19,11 +19,7 @@ using namespace frc;
 // set the logging level
 TLogLevel constantsJNILogLevel = logWARNING;
 
-#define CONSTANTSJNI_LOG(level)     \
-  if (level > constantsJNILogLevel) \
-    ;                         \
-  else                        \
-  Log().Get(level)
+#define CONSTANTSJNI_LOG(level) JNI_LOG(constantsJNILogLevel, level)
 
 extern "C" {
 /*
@@ -34,7 +30,7 @@ extern "C" {
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_ConstantsJNI_getSystemClockTicksPerMicrosecond(
     JNIEnv *env, jclass) {
-  CONSTANTSJNI_LOG(logDEBUG) << "Calling ConstantsJNI getSystemClockTicksPerMicrosecond";
+  JNI_TRACE("ConstantsJNI getSystemClockTicksPerMicrosecond");
   jint value = HAL_GetSystemClockTicksPerMicrosecond();
   CONSTANTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
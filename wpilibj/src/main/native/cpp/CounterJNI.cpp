@@ -20,11 +20,7 @@ using namespace frc;
 // set the logging level
 TLogLevel counterJNILogLevel = logWARNING;
 
-#define COUNTERJNI_LOG(level)     \
-  if (level > counterJNILogLevel) \
-    ;                             \
-  else                            \
-  Log().Get(level)
+#define COUNTERJNI_LOG(level) JNI_LOG(counterJNILogLevel, level)
 
 extern "C" {
 
@@ -36,7 +32,7 @@ extern "C" {
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_initializeCounter(
     JNIEnv* env, jclass, jint mode, jobject index) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI initializeCounter";
+  JNI_TRACE("COUNTERJNI initializeCounter");
   COUNTERJNI_LOG(logDEBUG) << "Mode = " << mode;
   jint* indexPtr = (jint*)env->GetDirectBufferAddress(index);
   COUNTERJNI_LOG(logDEBUG) << "Index Ptr = " << (int32_t*)indexPtr;
@@ -56,7 +52,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_initializeCounter(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_CounterJNI_freeCounter(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI freeCounter";
+  JNI_TRACE("COUNTERJNI freeCounter");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   HAL_FreeCounter((HAL_CounterHandle)id, &status);
@@ -72,7 +68,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_CounterJNI_freeCounter(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterAverageSize(
     JNIEnv* env, jclass, jint id, jint value) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterAverageSize";
+  JNI_TRACE("COUNTERJNI setCounterAverageSize");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "AverageSize = " << value;
   int32_t status = 0;
@@ -90,7 +86,7 @@ JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterUpSource(
     JNIEnv* env, jclass, jint id, jint digitalSourceHandle,
     jint analogTriggerType) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterUpSource";
+  JNI_TRACE("COUNTERJNI setCounterUpSource");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "digitalSourceHandle = " << digitalSourceHandle;
   COUNTERJNI_LOG(logDEBUG) << "analogTriggerType = " << analogTriggerType;
@@ -109,7 +105,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterUpSource(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterUpSourceEdge(
     JNIEnv* env, jclass, jint id, jboolean valueRise, jboolean valueFall) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterUpSourceEdge";
+  JNI_TRACE("COUNTERJNI setCounterUpSourceEdge");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "Rise = " << (jint)valueRise;
   COUNTERJNI_LOG(logDEBUG) << "Fall = " << (jint)valueFall;
@@ -127,7 +123,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterUpSourceEdge(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_clearCounterUpSource(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI clearCounterUpSource";
+  JNI_TRACE("COUNTERJNI clearCounterUpSource");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   HAL_ClearCounterUpSource((HAL_CounterHandle)id, &status);
@@ -144,7 +140,7 @@ JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterDownSource(
     JNIEnv* env, jclass, jint id, jint digitalSourceHandle,
     jint analogTriggerType) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterDownSource";
+  JNI_TRACE("COUNTERJNI setCounterDownSource");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "digitalSourceHandle = " << digitalSourceHandle;
   COUNTERJNI_LOG(logDEBUG) << "analogTriggerType = " << analogTriggerType;
@@ -169,7 +165,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterDownSource(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterDownSourceEdge(
     JNIEnv* env, jclass, jint id, jboolean valueRise, jboolean valueFall) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterDownSourceEdge";
+  JNI_TRACE("COUNTERJNI setCounterDownSourceEdge");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "Rise = " << (jint)valueRise;
   COUNTERJNI_LOG(logDEBUG) << "Fall = " << (jint)valueFall;
@@ -187,7 +183,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterDownSourceEdge(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_clearCounterDownSource(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI clearCounterDownSource";
+  JNI_TRACE("COUNTERJNI clearCounterDownSource");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   HAL_ClearCounterDownSource((HAL_CounterHandle)id, &status);
@@ -203,7 +199,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_clearCounterDownSource(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterUpDownMode(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterUpDownMode";
+  JNI_TRACE("COUNTERJNI setCounterUpDownMode");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   HAL_SetCounterUpDownMode((HAL_CounterHandle)id, &status);
@@ -219,8 +215,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterUpDownMode(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterExternalDirectionMode(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG)
-      << "Calling COUNTERJNI setCounterExternalDirectionMode";
+  JNI_TRACE("COUNTERJNI setCounterExternalDirectionMode");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   HAL_SetCounterExternalDirectionMode((HAL_CounterHandle)id, &status);
@@ -236,7 +231,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterExternalDirectionMode(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterSemiPeriodMode(
     JNIEnv* env, jclass, jint id, jboolean value) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterSemiPeriodMode";
+  JNI_TRACE("COUNTERJNI setCounterSemiPeriodMode");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "SemiPeriodMode = " << (jint)value;
   int32_t status = 0;
@@ -253,7 +248,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterSemiPeriodMode(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterPulseLengthMode(
     JNIEnv* env, jclass, jint id, jdouble value) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterPulseLengthMode";
+  JNI_TRACE("COUNTERJNI setCounterPulseLengthMode");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "PulseLengthMode = " << value;
   int32_t status = 0;
@@ -270,7 +265,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterPulseLengthMode(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounterSamplesToAverage(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI getCounterSamplesToAverage";
+  JNI_TRACE("COUNTERJNI getCounterSamplesToAverage");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   jint returnValue = HAL_GetCounterSamplesToAverage((HAL_CounterHandle)id, &status);
@@ -289,7 +284,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounterSamplesToAverage(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterSamplesToAverage(
     JNIEnv* env, jclass, jint id, jint value) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterSamplesToAverage";
+  JNI_TRACE("COUNTERJNI setCounterSamplesToAverage");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "SamplesToAverage = " << value;
   int32_t status = 0;
@@ -309,7 +304,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterSamplesToAverage(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_CounterJNI_resetCounter(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI resetCounter";
+  JNI_TRACE("COUNTERJNI resetCounter");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   HAL_ResetCounter((HAL_CounterHandle)id, &status);
@@ -342,7 +337,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounter(
 JNIEXPORT jdouble JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounterPeriod(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI getCounterPeriod";
+  JNI_TRACE("COUNTERJNI getCounterPeriod");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   jdouble returnValue = HAL_GetCounterPeriod((HAL_CounterHandle)id, &status);
@@ -360,7 +355,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounterPeriod(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterMaxPeriod(
     JNIEnv* env, jclass, jint id, jdouble value) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterMaxPeriod";
+  JNI_TRACE("COUNTERJNI setCounterMaxPeriod");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "MaxPeriod = " << value;
   int32_t status = 0;
@@ -377,7 +372,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterMaxPeriod(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterUpdateWhenEmpty(
     JNIEnv* env, jclass, jint id, jboolean value) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterMaxPeriod";
+  JNI_TRACE("COUNTERJNI setCounterMaxPeriod");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "UpdateWhenEmpty = " << (jint)value;
   int32_t status = 0;
@@ -394,7 +389,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterUpdateWhenEmpty(
 JNIEXPORT jboolean JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounterStopped(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI getCounterStopped";
+  JNI_TRACE("COUNTERJNI getCounterStopped");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   jboolean returnValue = HAL_GetCounterStopped((HAL_CounterHandle)id, &status);
@@ -412,7 +407,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounterStopped(
 JNIEXPORT jboolean JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounterDirection(
     JNIEnv* env, jclass, jint id) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI getCounterDirection";
+  JNI_TRACE("COUNTERJNI getCounterDirection");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   int32_t status = 0;
   jboolean returnValue = HAL_GetCounterDirection((HAL_CounterHandle)id, &status);
@@ -431,7 +426,7 @@ Java_edu_wpi_first_wpilibj_hal_CounterJNI_getCounterDirection(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_CounterJNI_setCounterReverseDirection(
     JNIEnv* env, jclass, jint id, jboolean value) {
-  COUNTERJNI_LOG(logDEBUG) << "Calling COUNTERJNI setCounterReverseDirection";
+  JNI_TRACE("COUNTERJNI setCounterReverseDirection");
   COUNTERJNI_LOG(logDEBUG) << "Counter Handle = " << (HAL_CounterHandle)id;
   COUNTERJNI_LOG(logDEBUG) << "ReverseDirection = " << (jint)value;
   int32_t status = 0;
@@ -22,11 +22,7 @@ using namespace frc;
 // set the logging level
 TLogLevel dioJNILogLevel = logWARNING;
 
-#define DIOJNI_LOG(level)     \
-  if (level > dioJNILogLevel) \
-    ;                         \
-  else                        \
-  Log().Get(level)
+#define DIOJNI_LOG(level) JNI_LOG(dioJNILogLevel, level)
 
 extern "C" {
 
@@ -38,7 +34,7 @@ extern "C" {
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_DIOJNI_initializeDIOPort(
     JNIEnv *env, jclass, jint id, jboolean input) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI initializeDIOPort";
+  JNI_TRACE("DIOJNI initializeDIOPort");
   DIOJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_PortHandle)id;
   DIOJNI_LOG(logDEBUG) << "Input = " << (jint)input;
   int32_t status = 0;
@@ -57,7 +53,7 @@ Java_edu_wpi_first_wpilibj_hal_DIOJNI_initializeDIOPort(
 */
 JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_checkDIOChannel(
     JNIEnv *env, jclass, jint channel) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI checkDIOChannel";
+  JNI_TRACE("DIOJNI checkDIOChannel");
   DIOJNI_LOG(logDEBUG) << "Channel = " << channel;
   return HAL_CheckDIOChannel(channel);
 }
@@ -69,7 +65,7 @@ JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_checkDIOChannel
 */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_freeDIOPort(
     JNIEnv *env, jclass, jint id) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI freeDIOPort";
+  JNI_TRACE("DIOJNI freeDIOPort");
   DIOJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_DigitalHandle)id;
   HAL_FreeDIOPort((HAL_DigitalHandle)id);
 }
@@ -131,7 +127,7 @@ Java_edu_wpi_first_wpilibj_hal_DIOJNI_getDIO(JNIEnv *env, jclass, jint id) {
 JNIEXPORT jboolean JNICALL
 Java_edu_wpi_first_wpilibj_hal_DIOJNI_getDIODirection(
     JNIEnv *env, jclass, jint id) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI getDIODirection (RR upd)";
+  JNI_TRACE("DIOJNI getDIODirection (RR upd)");
   // DIOJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_DigitalHandle)id;
   int32_t status = 0;
   jboolean returnValue = HAL_GetDIODirection((HAL_DigitalHandle)id, &status);
@@ -148,7 +144,7 @@ Java_edu_wpi_first_wpilibj_hal_DIOJNI_getDIODirection(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_pulse(
     JNIEnv *env, jclass, jint id, jdouble value) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI pulse (RR upd)";
+  JNI_TRACE("DIOJNI pulse (RR upd)");
   // DIOJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_DigitalHandle)id;
   // DIOJNI_LOG(logDEBUG) << "Value = " << value;
   int32_t status = 0;
@@ -164,7 +160,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_pulse(
  */
 JNIEXPORT jboolean JNICALL
 Java_edu_wpi_first_wpilibj_hal_DIOJNI_isPulsing(JNIEnv *env, jclass, jint id) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI isPulsing (RR upd)";
+  JNI_TRACE("DIOJNI isPulsing (RR upd)");
   // DIOJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_DigitalHandle)id;
   int32_t status = 0;
   jboolean returnValue = HAL_IsPulsing((HAL_DigitalHandle)id, &status);
@@ -181,7 +177,7 @@ Java_edu_wpi_first_wpilibj_hal_DIOJNI_isPulsing(JNIEnv *env, jclass, jint id) {
  */
 JNIEXPORT jboolean JNICALL
 Java_edu_wpi_first_wpilibj_hal_DIOJNI_isAnyPulsing(JNIEnv *env, jclass) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI isAnyPulsing (RR upd)";
+  JNI_TRACE("DIOJNI isAnyPulsing (RR upd)");
   int32_t status = 0;
   jboolean returnValue = HAL_IsAnyPulsing(&status);
   // DIOJNI_LOG(logDEBUG) << "Status = " << status;
@@ -197,7 +193,7 @@ Java_edu_wpi_first_wpilibj_hal_DIOJNI_isAnyPulsing(JNIEnv *env, jclass) {
  */
 JNIEXPORT jshort JNICALL
 Java_edu_wpi_first_wpilibj_hal_DIOJNI_getLoopTiming(JNIEnv *env, jclass) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI getLoopTimeing";
+  JNI_TRACE("DIOJNI getLoopTimeing");
   int32_t status = 0;
   jshort returnValue = HAL_GetPWMLoopTiming(&status);
   DIOJNI_LOG(logDEBUG) << "Status = " << status;
@@ -214,7 +210,7 @@ Java_edu_wpi_first_wpilibj_hal_DIOJNI_getLoopTiming(JNIEnv *env, jclass) {
  */
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_DIOJNI_allocateDigitalPWM(JNIEnv* env, jclass) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI allocateDigitalPWM";
+  JNI_TRACE("DIOJNI allocateDigitalPWM");
   int32_t status = 0;
   auto pwm = HAL_AllocateDigitalPWM(&status);
   DIOJNI_LOG(logDEBUG) << "Status = " << status;
@@ -230,7 +226,7 @@ Java_edu_wpi_first_wpilibj_hal_DIOJNI_allocateDigitalPWM(JNIEnv* env, jclass) {
  */
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_DIOJNI_freeDigitalPWM(JNIEnv* env, jclass, jint id) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI freeDigitalPWM";
+  JNI_TRACE("DIOJNI freeDigitalPWM");
   DIOJNI_LOG(logDEBUG) << "PWM Handle = " << (HAL_DigitalPWMHandle)id;
   int32_t status = 0;
   HAL_FreeDigitalPWM((HAL_DigitalPWMHandle)id, &status);
@@ -245,7 +241,7 @@ Java_edu_wpi_first_wpilibj_hal_DIOJNI_freeDigitalPWM(JNIEnv* env, jclass, jint i
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_setDigitalPWMRate(
     JNIEnv* env, jclass, jdouble value) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI setDigitalPWMRate";
+  JNI_TRACE("DIOJNI setDigitalPWMRate");
   DIOJNI_LOG(logDEBUG) << "Rate= " << value;
   int32_t status = 0;
   HAL_SetDigitalPWMRate(value, &status);
@@ -260,7 +256,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_setDigitalPWMRate(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_setDigitalPWMDutyCycle(
     JNIEnv* env, jclass, jint id, jdouble value) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI setDigitalPWMDutyCycle";
+  JNI_TRACE("DIOJNI setDigitalPWMDutyCycle");
   DIOJNI_LOG(logDEBUG) << "PWM Handle = " << (HAL_DigitalPWMHandle)id;
   DIOJNI_LOG(logDEBUG) << "DutyCycle= " << value;
   int32_t status = 0;
@@ -277,7 +273,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_DIOJNI_setDigitalPWMDutyCy
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_DIOJNI_setDigitalPWMOutputChannel(
     JNIEnv* env, jclass, jint id, jint value) {
-  DIOJNI_LOG(logDEBUG) << "Calling DIOJNI setDigitalPWMOutputChannel";
+  JNI_TRACE("DIOJNI setDigitalPWMOutputChannel");
   DIOJNI_LOG(logDEBUG) << "PWM Handle = " << (HAL_DigitalPWMHandle)id;
   DIOJNI_LOG(logDEBUG) << "Channel= " << value;
   int32_t status = 0;
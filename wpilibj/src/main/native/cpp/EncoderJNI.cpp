@@ -20,11 +20,7 @@ using namespace frc;
 // set the logging level
 TLogLevel encoderJNILogLevel = logWARNING;
 
-#define ENCODERJNI_LOG(level)     \
-  if (level > encoderJNILogLevel) \
-    ;                             \
-  else                            \
-  Log().Get(level)
+#define ENCODERJNI_LOG(level) JNI_LOG(encoderJNILogLevel, level)
 
 extern "C" {
 
@@ -38,7 +34,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_initializeEncoder(
     JNIEnv* env, jclass, jint digitalSourceHandleA, jint analogTriggerTypeA,
     jint digitalSourceHandleB, jint analogTriggerTypeB, jboolean reverseDirection,
     jint encodingType) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI initializeEncoder";
+  JNI_TRACE("ENCODERJNI initializeEncoder");
   ENCODERJNI_LOG(logDEBUG) << "Source Handle A = " << digitalSourceHandleA;
   ENCODERJNI_LOG(logDEBUG) << "Analog Trigger Type A = "
                            << analogTriggerTypeA;
@@ -66,7 +62,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_initializeEncoder(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_freeEncoder(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI freeEncoder";
+  JNI_TRACE("ENCODERJNI freeEncoder");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   HAL_FreeEncoder((HAL_EncoderHandle)id, &status);
@@ -81,7 +77,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_freeEncoder(
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoder(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoder";
+  JNI_TRACE("ENCODERJNI getEncoder");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jint returnValue = HAL_GetEncoder((HAL_EncoderHandle)id, &status);
@@ -98,7 +94,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoder(
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderRaw(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderRaw";
+  JNI_TRACE("ENCODERJNI getEncoderRaw");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jint returnValue = HAL_GetEncoderRaw((HAL_EncoderHandle)id, &status);
@@ -115,7 +111,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderRaw(
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncodingScaleFactor(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncodingScaleFactor";
+  JNI_TRACE("ENCODERJNI getEncodingScaleFactor");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jint returnValue = HAL_GetEncoderEncodingScale((HAL_EncoderHandle)id, &status);
@@ -132,7 +128,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncodingScal
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_resetEncoder(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI resetEncoder";
+  JNI_TRACE("ENCODERJNI resetEncoder");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   HAL_ResetEncoder((HAL_EncoderHandle)id, &status);
@@ -148,7 +144,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_EncoderJNI_resetEncoder(
 JNIEXPORT jdouble JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderPeriod(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderPeriod";
+  JNI_TRACE("ENCODERJNI getEncoderPeriod");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   double returnValue = HAL_GetEncoderPeriod((HAL_EncoderHandle)id, &status);
@@ -166,7 +162,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderPeriod(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderMaxPeriod(
     JNIEnv* env, jclass, jint id, jdouble value) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI setEncoderMaxPeriod";
+  JNI_TRACE("ENCODERJNI setEncoderMaxPeriod");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   HAL_SetEncoderMaxPeriod((HAL_EncoderHandle)id, value, &status);
@@ -182,7 +178,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderMaxPeriod(
 JNIEXPORT jboolean JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderStopped(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderStopped";
+  JNI_TRACE("ENCODERJNI getEncoderStopped");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jboolean returnValue = HAL_GetEncoderStopped((HAL_EncoderHandle)id, &status);
@@ -200,7 +196,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderStopped(
 JNIEXPORT jboolean JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderDirection(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderDirection";
+  JNI_TRACE("ENCODERJNI getEncoderDirection");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jboolean returnValue = HAL_GetEncoderDirection((HAL_EncoderHandle)id, &status);
@@ -218,7 +214,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderDirection(
 JNIEXPORT jdouble JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderDistance(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderDistance";
+  JNI_TRACE("ENCODERJNI getEncoderDistance");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jdouble returnValue = HAL_GetEncoderDistance((HAL_EncoderHandle)id, &status);
@@ -236,7 +232,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderDistance(
 JNIEXPORT jdouble JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderRate(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderRate";
+  JNI_TRACE("ENCODERJNI getEncoderRate");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jdouble returnValue = HAL_GetEncoderRate((HAL_EncoderHandle)id, &status);
@@ -254,7 +250,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderRate(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderMinRate(
     JNIEnv* env, jclass, jint id, jdouble value) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI setEncoderMinRate";
+  JNI_TRACE("ENCODERJNI setEncoderMinRate");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   HAL_SetEncoderMinRate((HAL_EncoderHandle)id, value, &status);
@@ -270,7 +266,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderMinRate(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderDistancePerPulse(
     JNIEnv* env, jclass, jint id, jdouble value) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI setEncoderDistancePerPulse";
+  JNI_TRACE("ENCODERJNI setEncoderDistancePerPulse");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   HAL_SetEncoderDistancePerPulse((HAL_EncoderHandle)id, value, &status);
@@ -286,7 +282,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderDistancePerPulse(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderReverseDirection(
     JNIEnv* env, jclass, jint id, jboolean value) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI setEncoderReverseDirection";
+  JNI_TRACE("ENCODERJNI setEncoderReverseDirection");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   HAL_SetEncoderReverseDirection((HAL_EncoderHandle)id, value, &status);
@@ -302,7 +298,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderReverseDirection(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderSamplesToAverage(
     JNIEnv* env, jclass, jint id, jint value) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI setEncoderSamplesToAverage";
+  JNI_TRACE("ENCODERJNI setEncoderSamplesToAverage");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   HAL_SetEncoderSamplesToAverage((HAL_EncoderHandle)id, value, &status);
@@ -322,7 +318,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderSamplesToAverage(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderSamplesToAverage(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderSamplesToAverage";
+  JNI_TRACE("ENCODERJNI getEncoderSamplesToAverage");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jint returnValue = HAL_GetEncoderSamplesToAverage((HAL_EncoderHandle)id, &status);
@@ -342,7 +338,7 @@ JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderIndexSource(
     JNIEnv* env, jclass, jint id, jint digitalSourceHandle,
     jint analogTriggerType, jint type) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI setEncoderIndexSource";
+  JNI_TRACE("ENCODERJNI setEncoderIndexSource");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   ENCODERJNI_LOG(logDEBUG) << "Source Handle = " << digitalSourceHandle;
   ENCODERJNI_LOG(logDEBUG) << "Analog Trigger Type = "
@@ -364,7 +360,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_setEncoderIndexSource(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderFPGAIndex(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderSamplesToAverage";
+  JNI_TRACE("ENCODERJNI getEncoderSamplesToAverage");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jint returnValue = HAL_GetEncoderFPGAIndex((HAL_EncoderHandle)id, &status);
@@ -383,7 +379,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderFPGAIndex(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderEncodingScale(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderSamplesToAverage";
+  JNI_TRACE("ENCODERJNI getEncoderSamplesToAverage");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jint returnValue = HAL_GetEncoderEncodingScale((HAL_EncoderHandle)id, &status);
@@ -402,7 +398,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderEncodingScale(
 JNIEXPORT jdouble JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderDecodingScaleFactor(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderSamplesToAverage";
+  JNI_TRACE("ENCODERJNI getEncoderSamplesToAverage");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jdouble returnValue = HAL_GetEncoderDecodingScaleFactor((HAL_EncoderHandle)id, &status);
@@ -421,7 +417,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderDecodingScaleFactor(
 JNIEXPORT jdouble JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderDistancePerPulse(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderSamplesToAverage";
+  JNI_TRACE("ENCODERJNI getEncoderSamplesToAverage");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jdouble returnValue = HAL_GetEncoderDistancePerPulse((HAL_EncoderHandle)id, &status);
@@ -440,7 +436,7 @@ Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderDistancePerPulse(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_EncoderJNI_getEncoderEncodingType(
     JNIEnv* env, jclass, jint id) {
-  ENCODERJNI_LOG(logDEBUG) << "Calling ENCODERJNI getEncoderSamplesToAverage";
+  JNI_TRACE("ENCODERJNI getEncoderSamplesToAverage");
   ENCODERJNI_LOG(logDEBUG) << "Encoder Handle = " << (HAL_EncoderHandle)id;
   int32_t status = 0;
   jint returnValue = HAL_GetEncoderEncodingType((HAL_EncoderHandle)id, &status);
@@ -23,11 +23,45 @@ using namespace wpi::java;
 // set the logging level
 static TLogLevel netCommLogLevel = logWARNING;
 
-#define NETCOMM_LOG(level)     \
-  if (level > netCommLogLevel) \
-    ;                          \
-  else                         \
-  Log().Get(level)
+#define NETCOMM_LOG(level) JNI_LOG(netCommLogLevel, level)
+
+namespace {
+// Layout of the buffer filled by getDSSnapshot(); it must match the
+// kDSSnapshot constants in HAL.java. Values are in native byte order.
+struct DSSnapshotJoystick {
+  uint32_t buttons;
+  uint8_t buttonCount;
+  uint8_t axisCount;
+  uint8_t povCount;
+  uint8_t reserved;
+  float axes[HAL_kMaxJoystickAxes];
+  int16_t povs[HAL_kMaxJoystickPOVs];
+};
+
+constexpr int32_t kDSSnapshotJoysticks = 6;
+
+struct DSSnapshot {
+  int32_t controlWord;
+  int32_t allianceStation;
+  int32_t matchType;
+  int32_t matchNumber;
+  int32_t replayNumber;
+  int32_t gameSpecificMessageSize;
+  int32_t reserved[2];
+  DSSnapshotJoystick joysticks[kDSSnapshotJoysticks];
+  char eventName[HAL_kMaxEventNameLength];
+  char gameSpecificMessage[HAL_kMaxGameSpecificMessageLength];
+};
+
+static_assert(sizeof(DSSnapshotJoystick) == 80,
+              "DS snapshot joystick layout must match HAL.java");
+static_assert(sizeof(DSSnapshot) == 640,
+              "DS snapshot layout must match HAL.java");
+}  // namespace
+
+// The buffer registered by setDSSnapshotBuffer(); only the DS thread uses it
+static jobject dsSnapshotBuffer = nullptr;
+static DSSnapshot* dsSnapshot = nullptr;
 
 extern "C" {
 
@@ -119,7 +153,7 @@ Java_edu_wpi_first_wpilibj_hal_HAL_report(
  */
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_nativeGetControlWord(JNIEnv*, jclass) {
-  NETCOMM_LOG(logDEBUG) << "Calling HAL Control Word";
+  JNI_TRACE("HAL Control Word");
   static_assert(sizeof(HAL_ControlWord) == sizeof(jint),
       "Java int must match the size of control word");
   HAL_ControlWord controlWord;
@@ -137,7 +171,7 @@ Java_edu_wpi_first_wpilibj_hal_HAL_nativeGetControlWord(JNIEnv*, jclass) {
  */
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_nativeGetAllianceStation(JNIEnv*, jclass) {
-  NETCOMM_LOG(logDEBUG) << "Calling HAL Alliance Station";
+  JNI_TRACE("HAL Alliance Station");
   int32_t status = 0;
   auto allianceStation = HAL_GetAllianceStation(&status);
   return static_cast<jint>(allianceStation);
@@ -152,7 +186,7 @@ JNIEXPORT jshort JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickAxes(JNIEnv* env, jclass,
                                                    jbyte joystickNum,
                                                    jfloatArray axesArray) {
-  NETCOMM_LOG(logDEBUG) << "Calling HALJoystickAxes";
+  JNI_TRACE("HALJoystickAxes");
   HAL_JoystickAxes axes;
   HAL_GetJoystickAxes(joystickNum, &axes);
 
@@ -176,7 +210,7 @@ JNIEXPORT jshort JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickPOVs(JNIEnv* env, jclass,
                                                    jbyte joystickNum,
                                                    jshortArray povsArray) {
-  NETCOMM_LOG(logDEBUG) << "Calling HALJoystickPOVs";
+  JNI_TRACE("HALJoystickPOVs");
   HAL_JoystickPOVs povs;
   HAL_GetJoystickPOVs(joystickNum, &povs);
 
@@ -200,7 +234,7 @@ JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickButtons(JNIEnv* env, jclass,
                                                       jbyte joystickNum,
                                                       jobject count) {
-  NETCOMM_LOG(logDEBUG) << "Calling HALJoystickButtons";
+  JNI_TRACE("HALJoystickButtons");
   HAL_JoystickButtons joystickButtons;
   HAL_GetJoystickButtons(joystickNum, &joystickButtons);
   jbyte *countPtr = (jbyte *)env->GetDirectBufferAddress(count);
@@ -236,7 +270,7 @@ Java_edu_wpi_first_wpilibj_hal_HAL_setJoystickOutputs(JNIEnv*, jclass,
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickIsXbox(JNIEnv*, jclass,
                                                      jbyte port) {
-  NETCOMM_LOG(logDEBUG) << "Calling HAL_GetJoystickIsXbox";
+  JNI_TRACE("HAL_GetJoystickIsXbox");
   return HAL_GetJoystickIsXbox(port);
 }
 
@@ -248,7 +282,7 @@ Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickIsXbox(JNIEnv*, jclass,
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickType(JNIEnv*, jclass,
                                                    jbyte port) {
-  NETCOMM_LOG(logDEBUG) << "Calling HAL_GetJoystickType";
+  JNI_TRACE("HAL_GetJoystickType");
   return HAL_GetJoystickType(port);
 }
 
@@ -260,7 +294,7 @@ Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickType(JNIEnv*, jclass,
 JNIEXPORT jstring JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickName(JNIEnv* env, jclass,
                                                    jbyte port) {
-  NETCOMM_LOG(logDEBUG) << "Calling HAL_GetJoystickName";
+  JNI_TRACE("HAL_GetJoystickName");
   char *joystickName = HAL_GetJoystickName(port);
   jstring str = MakeJString(env, joystickName);
   HAL_FreeJoystickName(joystickName);
@@ -276,7 +310,7 @@ JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_HAL_getJoystickAxisType(JNIEnv*, jclass,
                                                        jbyte joystickNum,
                                                        jbyte axis) {
-  NETCOMM_LOG(logDEBUG) << "Calling HAL_GetJoystickAxisType";
+  JNI_TRACE("HAL_GetJoystickAxisType");
   return HAL_GetJoystickAxisType(joystickNum, axis);
 }
 
@@ -375,6 +409,78 @@ Java_edu_wpi_first_wpilibj_hal_HAL_getMatchInfo
   return status;
 }
 
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_HAL
+ * Method:    setDSSnapshotBuffer
+ * Signature: (Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_wpilibj_hal_HAL_setDSSnapshotBuffer
+(JNIEnv * env, jclass, jobject buffer) {
+  void* address = buffer ? env->GetDirectBufferAddress(buffer) : nullptr;
+  if (buffer && (!address || env->GetDirectBufferCapacity(buffer) <
+                                 static_cast<jlong>(sizeof(DSSnapshot)))) {
+    ThrowIllegalArgumentException(
+        env, "DS snapshot buffer must be a direct buffer of kDSSnapshotSize "
+             "bytes");
+    return;
+  }
+  // Hold a reference, so the buffer outlives the Java side dropping it
+  if (dsSnapshotBuffer) env->DeleteGlobalRef(dsSnapshotBuffer);
+  dsSnapshotBuffer = buffer ? env->NewGlobalRef(buffer) : nullptr;
+  dsSnapshot = static_cast<DSSnapshot*>(address);
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_HAL
+ * Method:    getDSSnapshot
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_wpilibj_hal_HAL_getDSSnapshot
+(JNIEnv *, jclass) {
+  DSSnapshot* snapshot = dsSnapshot;
+  if (!snapshot) return -1;
+
+  HAL_ControlWord controlWord;
+  std::memset(&controlWord, 0, sizeof(HAL_ControlWord));
+  HAL_GetControlWord(&controlWord);
+  std::memcpy(&snapshot->controlWord, &controlWord, sizeof(HAL_ControlWord));
+  int32_t status = 0;
+  snapshot->allianceStation = HAL_GetAllianceStation(&status);
+
+  for (int32_t stick = 0; stick < kDSSnapshotJoysticks; stick++) {
+    DSSnapshotJoystick& joystick = snapshot->joysticks[stick];
+    HAL_JoystickAxes axes;
+    HAL_GetJoystickAxes(stick, &axes);
+    HAL_JoystickPOVs povs;
+    HAL_GetJoystickPOVs(stick, &povs);
+    HAL_JoystickButtons buttons;
+    HAL_GetJoystickButtons(stick, &buttons);
+
+    joystick.buttons = buttons.buttons;
+    joystick.buttonCount = buttons.count;
+    joystick.axisCount = axes.count;
+    joystick.povCount = povs.count;
+    std::memcpy(joystick.axes, axes.axes, sizeof(joystick.axes));
+    std::memcpy(joystick.povs, povs.povs, sizeof(joystick.povs));
+  }
+
+  HAL_InlineMatchInfo matchInfo;
+  status = HAL_GetInlineMatchInfo(&matchInfo);
+  if (status == 0) {
+    snapshot->matchType = matchInfo.matchType;
+    snapshot->matchNumber = matchInfo.matchNumber;
+    snapshot->replayNumber = matchInfo.replayNumber;
+    snapshot->gameSpecificMessageSize = matchInfo.gameSpecificMessageSize;
+    std::memcpy(snapshot->eventName, matchInfo.eventName,
+                sizeof(snapshot->eventName));
+    std::memcpy(snapshot->gameSpecificMessage, matchInfo.gameSpecificMessage,
+                sizeof(snapshot->gameSpecificMessage));
+  }
+  return status;
+}
+
 /*
  * Class: edu_wpi_first_wpilibj_hal_HAL
  * Method:    HAL_SendError
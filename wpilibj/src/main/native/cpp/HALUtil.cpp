@@ -11,9 +11,12 @@
 #include <errno.h>
 #include <jni.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "HAL/CAN.h"
 #include "HAL/HAL.h"
@@ -24,17 +27,14 @@
 #include "llvm/SmallString.h"
 #include "llvm/raw_ostream.h"
 #include "support/jni_util.h"
+#include "support/mutex.h"
 
 using namespace wpi::java;
 
 // set the logging level
 TLogLevel halUtilLogLevel = logWARNING;
 
-#define HALUTIL_LOG(level)     \
-  if (level > halUtilLogLevel) \
-    ;                          \
-  else                         \
-  Log().Get(level)
+#define HALUTIL_LOG(level) JNI_LOG(halUtilLogLevel, level)
 
 #define kRioStatusOffset -63000
 #define kRioStatusSuccess 0
@@ -59,8 +59,78 @@ static JClass canStatusCls;
 static JClass matchInfoDataCls;
 static JClass accumulatorResultCls;
 
+// Looked up in JNI_OnLoad, so no error path has to
+static jmethodID canInvalidBufferExCtor;
+static jmethodID canMessageNotFoundExCtor;
+static jmethodID canNotInitializedExCtor;
+static jmethodID boundaryExGetMessage;
+static jmethodID boundaryExCtor;
+static jmethodID pwmConfigDataResultCtor;
+static jmethodID canStatusSetStatus;
+static jmethodID matchInfoDataSetData;
+static jmethodID accumulatorResultSet;
+
+namespace {
+// A status recently sent to the DS. Reporting the same status again within
+// kStatusRepeatPeriod only counts it, so a sensor that fails every loop does
+// not fetch a Java stack trace and send an error each time.
+struct StatusReport {
+  int32_t status;
+  uint64_t lastSendTime;
+  int32_t suppressed;
+};
+
+constexpr uint64_t kStatusRepeatPeriod = 1000000;  // us
+constexpr size_t kMaxStatusReports = 16;
+}  // namespace
+
+static wpi::mutex statusReportMutex;
+static std::vector<StatusReport> statusReports;
+
+// Returns false if the status was sent too recently to send again; otherwise
+// sets suppressed to the number of reports dropped since it was last sent.
+static bool ShouldSendStatus(int32_t status, int32_t* suppressed) {
+  int32_t timeStatus = 0;
+  uint64_t now = HAL_GetFPGATime(&timeStatus);
+  std::lock_guard<wpi::mutex> lock(statusReportMutex);
+  StatusReport* oldest = nullptr;
+  for (auto& report : statusReports) {
+    if (report.status == status) {
+      if (now - report.lastSendTime < kStatusRepeatPeriod) {
+        report.suppressed++;
+        return false;
+      }
+      *suppressed = report.suppressed;
+      report.lastSendTime = now;
+      report.suppressed = 0;
+      return true;
+    }
+    if (!oldest || report.lastSendTime < oldest->lastSendTime)
+      oldest = &report;
+  }
+  *suppressed = 0;
+  if (statusReports.size() < kMaxStatusReports) {
+    statusReports.push_back(StatusReport{status, now, 0});
+  } else {
+    *oldest = StatusReport{status, now, 0};
+  }
+  return true;
+}
+
+static std::atomic<uint32_t> jniTraceCount{0};
+
 namespace frc {
 
+std::atomic<int32_t> jniTracePeriod{0};
+
+void TraceJNICall(const char *name) {
+  int32_t period = jniTracePeriod.load(std::memory_order_relaxed);
+  if (period <= 0) return;
+  uint32_t count = jniTraceCount.fetch_add(1, std::memory_order_relaxed);
+  if (count % period != 0) return;
+  Log().Get(logINFO) << "JNI trace: " << name << " (1 in " << period << ")";
+}
+
 void ThrowAllocationException(JNIEnv *env, int32_t minRange, int32_t maxRange,
     int32_t requestedValue, int32_t status) {
   const char *message = HAL_GetErrorMessage(status);
@@ -69,7 +139,6 @@ void ThrowAllocationException(JNIEnv *env, int32_t minRange, int32_t maxRange,
   oss << " Code: " << status << ". " << message << ", Minimum Value: "
       << minRange << ", Maximum Value: " << maxRange << ", Requested Value: "
       << requestedValue;
-  env->ThrowNew(allocationExCls, buf.c_str());
   allocationExCls.Throw(env, buf.c_str());
 }
 
@@ -85,6 +154,7 @@ void ReportError(JNIEnv *env, int32_t status, bool doThrow) {
   if (status == 0) return;
   if (status == HAL_HANDLE_ERROR) {
     ThrowHalHandleException(env, status);
+    return;
   }
   const char *message = HAL_GetErrorMessage(status);
   if (doThrow && status < 0) {
@@ -93,9 +163,17 @@ void ReportError(JNIEnv *env, int32_t status, bool doThrow) {
     oss << " Code: " << status << ". " << message;
     runtimeExCls.Throw(env, buf.c_str());
   } else {
+    int32_t suppressed;
+    if (!ShouldSendStatus(status, &suppressed)) return;
+    llvm::SmallString<256> details{message};
+    if (suppressed > 0) {
+      llvm::raw_svector_ostream oss(details);
+      oss << " (repeated " << suppressed << " more times)";
+    }
     std::string func;
     auto stack = GetJavaStackTrace(env, &func, "edu.wpi.first.wpilibj");
-    HAL_SendError(1, status, 0, message, func.c_str(), stack.c_str(), 1);
+    HAL_SendError(1, status, 0, details.c_str(), func.c_str(), stack.c_str(),
+                  1);
   }
 }
 
@@ -106,9 +184,11 @@ void ThrowError(JNIEnv *env, int32_t status, int32_t minRange, int32_t maxRange,
       status == RESOURCE_IS_ALLOCATED ||
       status == RESOURCE_OUT_OF_RANGE) {
     ThrowAllocationException(env, minRange, maxRange, requestedValue, status);
+    return;
   }
   if (status == HAL_HANDLE_ERROR) {
     ThrowHalHandleException(env, status);
+    return;
   }
   const char *message = HAL_GetErrorMessage(status);
   llvm::SmallString<1024> buf;
@@ -125,23 +205,15 @@ void ReportCANError(JNIEnv *env, int32_t status, int message_id) {
       break;
     case HAL_ERR_CANSessionMux_InvalidBuffer:
     case kRIOStatusBufferInvalidSize: {
-      static jmethodID invalidBufConstruct = nullptr;
-      if (!invalidBufConstruct)
-        invalidBufConstruct =
-            env->GetMethodID(canInvalidBufferExCls, "<init>", "()V");
       jobject exception =
-          env->NewObject(canInvalidBufferExCls, invalidBufConstruct);
+          env->NewObject(canInvalidBufferExCls, canInvalidBufferExCtor);
       env->Throw(static_cast<jthrowable>(exception));
       break;
     }
     case HAL_ERR_CANSessionMux_MessageNotFound:
     case kRIOStatusOperationTimedOut: {
-      static jmethodID messageNotFoundConstruct = nullptr;
-      if (!messageNotFoundConstruct)
-        messageNotFoundConstruct =
-            env->GetMethodID(canMessageNotFoundExCls, "<init>", "()V");
       jobject exception =
-          env->NewObject(canMessageNotFoundExCls, messageNotFoundConstruct);
+          env->NewObject(canMessageNotFoundExCls, canMessageNotFoundExCtor);
       env->Throw(static_cast<jthrowable>(exception));
       break;
     }
@@ -155,12 +227,8 @@ void ReportCANError(JNIEnv *env, int32_t status, int message_id) {
     }
     case HAL_ERR_CANSessionMux_NotInitialized:
     case kRIOStatusResourceNotInitialized: {
-      static jmethodID notInitConstruct = nullptr;
-      if (!notInitConstruct)
-        notInitConstruct =
-            env->GetMethodID(canNotInitializedExCls, "<init>", "()V");
       jobject exception =
-          env->NewObject(canNotInitializedExCls, notInitConstruct);
+          env->NewObject(canNotInitializedExCls, canNotInitializedExCtor);
       env->Throw(static_cast<jthrowable>(exception));
       break;
     }
@@ -180,33 +248,20 @@ void ThrowIllegalArgumentException(JNIEnv *env, const char *msg) {
 
 void ThrowBoundaryException(JNIEnv *env, double value, double lower,
                             double upper) {
-  static jmethodID getMessage = nullptr;
-  if (!getMessage)
-    getMessage = env->GetStaticMethodID(boundaryExCls, "getMessage",
-                                        "(DDD)Ljava/lang/String;");
-
-  static jmethodID constructor = nullptr;
-  if (!constructor)
-    constructor =
-        env->GetMethodID(boundaryExCls, "<init>", "(Ljava/lang/String;)V");
-
   jobject msg =
-      env->CallStaticObjectMethod(boundaryExCls, getMessage,
+      env->CallStaticObjectMethod(boundaryExCls, boundaryExGetMessage,
                                   static_cast<jdouble>(value),
                                   static_cast<jdouble>(lower),
                                   static_cast<jdouble>(upper));
-  jobject ex = env->NewObject(boundaryExCls, constructor, msg);
+  jobject ex = env->NewObject(boundaryExCls, boundaryExCtor, msg);
   env->Throw(static_cast<jthrowable>(ex));
 }
 
 jobject CreatePWMConfigDataResult(JNIEnv *env, int32_t maxPwm,
                   int32_t deadbandMaxPwm, int32_t centerPwm,
                   int32_t deadbandMinPwm, int32_t minPwm) {
-  static jmethodID constructor =
-      env->GetMethodID(pwmConfigDataResultCls, "<init>",
-                       "(IIIII)V");
-  return env->NewObject(pwmConfigDataResultCls, constructor, maxPwm,
-                        deadbandMaxPwm, centerPwm, deadbandMinPwm,
+  return env->NewObject(pwmConfigDataResultCls, pwmConfigDataResultCtor,
+                        maxPwm, deadbandMaxPwm, centerPwm, deadbandMinPwm,
                         minPwm);
 }
 
@@ -215,19 +270,14 @@ void SetCanStatusObject(JNIEnv *env, jobject canStatus,
                         uint32_t busOffCount, uint32_t txFullCount,
                         uint32_t receiveErrorCount,
                         uint32_t transmitErrorCount) {
-  static jmethodID func = env->GetMethodID(canStatusCls, "setStatus",
-                                           "(DIIII)V");
-  env->CallObjectMethod(canStatus, func, (jdouble)percentBusUtilization,
+  env->CallObjectMethod(canStatus, canStatusSetStatus, (jdouble)percentBusUtilization,
                         (jint)busOffCount, (jint)txFullCount,
                         (jint)receiveErrorCount, (jint)transmitErrorCount);
 }
 
 void SetMatchInfoObject(JNIEnv* env, jobject matchStatus,
                         const HAL_MatchInfo& matchInfo) {
-  static jmethodID func = env->GetMethodID(matchInfoDataCls, "setData",
-      "(Ljava/lang/String;Ljava/lang/String;III)V");
-
-  env->CallObjectMethod(matchStatus, func,
+  env->CallObjectMethod(matchStatus, matchInfoDataSetData,
       MakeJString(env, matchInfo.eventName),
       MakeJString(env, matchInfo.gameSpecificMessage),
       (jint)matchInfo.matchNumber,
@@ -237,10 +287,8 @@ void SetMatchInfoObject(JNIEnv* env, jobject matchStatus,
 
 void SetAccumulatorResultObject(JNIEnv* env, jobject accumulatorResult,
                                 int64_t value, int64_t count) {
-  static jmethodID func = env->GetMethodID(accumulatorResultCls, "set",
-      "(JJ)V");
-
-  env->CallObjectMethod(accumulatorResult, func, (jlong)value, (jlong)count);
+  env->CallObjectMethod(accumulatorResult, accumulatorResultSet, (jlong)value,
+                        (jlong)count);
 }
 
 }  // namespace frc
@@ -304,6 +352,41 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
   accumulatorResultCls = JClass(env, "edu/wpi/first/wpilibj/AccumulatorResult");
   if (!accumulatorResultCls) return JNI_ERR;
 
+  canInvalidBufferExCtor =
+      env->GetMethodID(canInvalidBufferExCls, "<init>", "()V");
+  if (!canInvalidBufferExCtor) return JNI_ERR;
+
+  canMessageNotFoundExCtor =
+      env->GetMethodID(canMessageNotFoundExCls, "<init>", "()V");
+  if (!canMessageNotFoundExCtor) return JNI_ERR;
+
+  canNotInitializedExCtor =
+      env->GetMethodID(canNotInitializedExCls, "<init>", "()V");
+  if (!canNotInitializedExCtor) return JNI_ERR;
+
+  boundaryExGetMessage = env->GetStaticMethodID(
+      boundaryExCls, "getMessage", "(DDD)Ljava/lang/String;");
+  if (!boundaryExGetMessage) return JNI_ERR;
+
+  boundaryExCtor =
+      env->GetMethodID(boundaryExCls, "<init>", "(Ljava/lang/String;)V");
+  if (!boundaryExCtor) return JNI_ERR;
+
+  pwmConfigDataResultCtor =
+      env->GetMethodID(pwmConfigDataResultCls, "<init>", "(IIIII)V");
+  if (!pwmConfigDataResultCtor) return JNI_ERR;
+
+  canStatusSetStatus = env->GetMethodID(canStatusCls, "setStatus", "(DIIII)V");
+  if (!canStatusSetStatus) return JNI_ERR;
+
+  matchInfoDataSetData =
+      env->GetMethodID(matchInfoDataCls, "setData",
+                       "(Ljava/lang/String;Ljava/lang/String;III)V");
+  if (!matchInfoDataSetData) return JNI_ERR;
+
+  accumulatorResultSet = env->GetMethodID(accumulatorResultCls, "set", "(JJ)V");
+  if (!accumulatorResultSet) return JNI_ERR;
+
   return JNI_VERSION_1_6;
 }
 
@@ -325,6 +408,7 @@ JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
   pwmConfigDataResultCls.free(env);
   canStatusCls.free(env);
   matchInfoDataCls.free(env);
+  accumulatorResultCls.free(env);
   jvm = nullptr;
 }
 
@@ -335,7 +419,7 @@ JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
  */
 JNIEXPORT jshort JNICALL
 Java_edu_wpi_first_wpilibj_hal_HALUtil_getFPGAVersion(JNIEnv *env, jclass) {
-  HALUTIL_LOG(logDEBUG) << "Calling HALUtil getFPGAVersion";
+  JNI_TRACE("HALUtil getFPGAVersion");
   int32_t status = 0;
   jshort returnValue = HAL_GetFPGAVersion(&status);
   HALUTIL_LOG(logDEBUG) << "Status = " << status;
@@ -351,7 +435,7 @@ Java_edu_wpi_first_wpilibj_hal_HALUtil_getFPGAVersion(JNIEnv *env, jclass) {
  */
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_HALUtil_getFPGARevision(JNIEnv *env, jclass) {
-  HALUTIL_LOG(logDEBUG) << "Calling HALUtil getFPGARevision";
+  JNI_TRACE("HALUtil getFPGARevision");
   int32_t status = 0;
   jint returnValue = HAL_GetFPGARevision(&status);
   HALUTIL_LOG(logDEBUG) << "Status = " << status;
@@ -442,4 +526,60 @@ JNIEXPORT jstring JNICALL Java_edu_wpi_first_wpilibj_hal_HALUtil_getHALstrerror(
   return MakeJString(env, msg);
 }
 
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_HALUtil
+ * Method:    setJNITracePeriod
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_wpilibj_hal_HALUtil_setJNITracePeriod(JNIEnv *, jclass,
+                                                         jint period) {
+  jniTracePeriod = period > 0 ? period : 0;
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_HALUtil
+ * Method:    setPerfCountersEnabled
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_wpilibj_hal_HALUtil_setPerfCountersEnabled(
+    JNIEnv *, jclass, jboolean enabled) {
+  HAL_SetPerfCountersEnabled(enabled);
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_HALUtil
+ * Method:    getPerfCounters
+ * Signature: (Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_HALUtil_getPerfCounters(
+    JNIEnv *env, jclass, jobject buffer) {
+  void *data = env->GetDirectBufferAddress(buffer);
+  jlong capacity = env->GetDirectBufferCapacity(buffer);
+  if (!data || capacity < 0) {
+    ThrowIllegalArgumentException(env, "buffer must be a direct buffer");
+    return 0;
+  }
+  static_assert(sizeof(HAL_PerfCounter) == 24,
+                "HALUtil.kPerfCounterEntrySize must match");
+  HAL_PerfCounter counters[HAL_kPerfCounterCount];
+  int32_t count = HAL_GetPerfCounters(
+      counters, std::min<jlong>(capacity / sizeof(HAL_PerfCounter),
+                                HAL_kPerfCounterCount));
+  std::memcpy(data, counters, count * sizeof(HAL_PerfCounter));
+  return count;
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_HALUtil
+ * Method:    resetPerfCounterMaximums
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_wpilibj_hal_HALUtil_resetPerfCounterMaximums(JNIEnv *,
+                                                                jclass) {
+  HAL_ResetPerfCounterMaximums();
+}
+
 }  // extern "C"
@@ -10,14 +10,51 @@
 
 #include <stdint.h>
 
+#include <atomic>
+
 #include <jni.h>
 
+#include "HAL/cpp/Log.h"
+#include "HAL/cpp/PerfCounters.h"
+
+// The per-file JNI debug log macros are built on JNI_LOG. They compile to
+// nothing unless WPILIBJ_JNI_LOGGING is defined (build with -PjniLogging), so
+// release builds don't pay for a level check on every call.
+#ifdef WPILIBJ_JNI_LOGGING
+#define JNI_LOG(reportingLevel, level) \
+  if (level > reportingLevel)          \
+    ;                                  \
+  else                                 \
+    Log().Get(level)
+#else
+#define JNI_LOG(reportingLevel, level) \
+  if (true)                            \
+    ;                                  \
+  else                                 \
+    Log().Get(level)
+#endif
+
+// Counts the call in the HAL JNI performance counter, and logs a sample of
+// JNI calls by name while tracing is enabled with HALUtil.setJNITracePeriod().
+// With both off, only reads two atomic flags.
+#define JNI_TRACE(name)                                               \
+  hal::CountPerfEvent(HAL_kPerfCounterJNI);                           \
+  if (frc::jniTracePeriod.load(std::memory_order_relaxed) == 0)       \
+    ;                                                                 \
+  else                                                                \
+    frc::TraceJNICall(name)
+
 extern JavaVM *jvm;
 
 struct HAL_MatchInfo;
 
 namespace frc {
 
+// One in every jniTracePeriod traced calls is logged; 0 disables tracing
+extern std::atomic<int32_t> jniTracePeriod;
+
+void TraceJNICall(const char *name);
+
 void ReportError(JNIEnv *env, int32_t status, bool doThrow = true);
 
 void ThrowError(JNIEnv *env, int32_t status, int32_t minRange, int32_t maxRange,
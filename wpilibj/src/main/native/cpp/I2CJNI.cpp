@@ -7,6 +7,7 @@
 
 #include <assert.h>
 #include <jni.h>
+#include <cstring>
 #include "HAL/cpp/Log.h"
 
 #include "edu_wpi_first_wpilibj_hal_I2CJNI.h"
@@ -21,11 +22,27 @@ using namespace wpi::java;
 // set the logging level
 TLogLevel i2cJNILogLevel = logWARNING;
 
-#define I2CJNI_LOG(level)     \
-  if (level > i2cJNILogLevel) \
-    ;                         \
-  else                        \
-  Log().Get(level)
+#define I2CJNI_LOG(level) JNI_LOG(i2cJNILogLevel, level)
+
+namespace {
+// One transfer of i2CTransactionBatch, as laid out in the Java buffer. The
+// offsets are into the same buffer; -1 means no data.
+struct I2CBatchDescriptor {
+  int32_t deviceAddress;
+  int32_t sendOffset;
+  int32_t sendSize;
+  int32_t receiveOffset;
+  int32_t receiveSize;
+};
+static_assert(sizeof(I2CBatchDescriptor) == 20,
+              "I2CJNI.kBatchDescriptorSize must match");
+
+bool InBuffer(int32_t offset, int32_t size, jlong capacity) {
+  if (offset == -1) return size == 0;
+  return offset >= 0 && size >= 0 &&
+         offset + static_cast<jlong>(size) <= capacity;
+}
+}  // namespace
 
 extern "C" {
 
@@ -36,7 +53,7 @@ extern "C" {
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CInitialize(
     JNIEnv* env, jclass, jint port) {
-  I2CJNI_LOG(logDEBUG) << "Calling I2CJNI i2CInititalize";
+  JNI_TRACE("I2CJNI i2CInititalize");
   I2CJNI_LOG(logDEBUG) << "Port: " << port;
   int32_t status = 0;
   HAL_InitializeI2C(static_cast<HAL_I2CPort>(port), &status);
@@ -52,7 +69,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CInitialize(
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CTransaction(
     JNIEnv* env, jclass, jint port, jbyte address, jobject dataToSend,
     jbyte sendSize, jobject dataReceived, jbyte receiveSize) {
-  I2CJNI_LOG(logDEBUG) << "Calling I2CJNI i2CTransaction";
+  JNI_TRACE("I2CJNI i2CTransaction");
   I2CJNI_LOG(logDEBUG) << "Port = " << port;
   I2CJNI_LOG(logDEBUG) << "Address = " << (jint)address;
   uint8_t* dataToSendPtr = nullptr;
@@ -79,7 +96,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CTransaction(
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CTransactionB(
     JNIEnv* env, jclass, jint port, jbyte address, jbyteArray dataToSend,
     jbyte sendSize, jbyteArray dataReceived, jbyte receiveSize) {
-  I2CJNI_LOG(logDEBUG) << "Calling I2CJNI i2CTransactionB";
+  JNI_TRACE("I2CJNI i2CTransactionB");
   I2CJNI_LOG(logDEBUG) << "Port = " << port;
   I2CJNI_LOG(logDEBUG) << "Address = " << (jint)address;
   I2CJNI_LOG(logDEBUG) << "SendSize = " << (jint)sendSize;
@@ -105,7 +122,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CTransactionB(
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CWrite(
     JNIEnv* env, jclass, jint port, jbyte address, jobject dataToSend,
     jbyte sendSize) {
-  I2CJNI_LOG(logDEBUG) << "Calling I2CJNI i2CWrite";
+  JNI_TRACE("I2CJNI i2CWrite");
   I2CJNI_LOG(logDEBUG) << "Port = " << port;
   I2CJNI_LOG(logDEBUG) << "Address = " << (jint)address;
   uint8_t* dataToSendPtr = nullptr;
@@ -128,7 +145,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CWrite(
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CWriteB(
     JNIEnv* env, jclass, jint port, jbyte address, jbyteArray dataToSend,
     jbyte sendSize) {
-  I2CJNI_LOG(logDEBUG) << "Calling I2CJNI i2CWrite";
+  JNI_TRACE("I2CJNI i2CWrite");
   I2CJNI_LOG(logDEBUG) << "Port = " << port;
   I2CJNI_LOG(logDEBUG) << "Address = " << (jint)address;
   I2CJNI_LOG(logDEBUG) << "SendSize = " << (jint)sendSize;
@@ -149,7 +166,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CWriteB(
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CRead(
     JNIEnv* env, jclass, jint port, jbyte address, jobject dataReceived,
     jbyte receiveSize) {
-  I2CJNI_LOG(logDEBUG) << "Calling I2CJNI i2CRead";
+  JNI_TRACE("I2CJNI i2CRead");
   I2CJNI_LOG(logDEBUG) << "Port = " << port;
   I2CJNI_LOG(logDEBUG) << "Address = " << address;
   uint8_t* dataReceivedPtr =
@@ -169,7 +186,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CRead(
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CReadB(
     JNIEnv* env, jclass, jint port, jbyte address, jbyteArray dataReceived,
     jbyte receiveSize) {
-  I2CJNI_LOG(logDEBUG) << "Calling I2CJNI i2CRead";
+  JNI_TRACE("I2CJNI i2CRead");
   I2CJNI_LOG(logDEBUG) << "Port = " << port;
   I2CJNI_LOG(logDEBUG) << "Address = " << address;
   I2CJNI_LOG(logDEBUG) << "ReceiveSize = " << receiveSize;
@@ -182,6 +199,60 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CReadB(
   return returnValue;
 }
 
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_I2CJNI
+ * Method:    i2CTransactionBatch
+ * Signature: (ILjava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CTransactionBatch(JNIEnv* env, jclass,
+                                                          jint port,
+                                                          jobject buffer,
+                                                          jint count) {
+  JNI_TRACE("I2CJNI i2CTransactionBatch");
+  I2CJNI_LOG(logDEBUG) << "Port = " << port;
+  I2CJNI_LOG(logDEBUG) << "Count = " << count;
+  uint8_t* base = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
+  jlong capacity = env->GetDirectBufferCapacity(buffer);
+  if (count < 0 || !base ||
+      capacity < count * static_cast<jlong>(sizeof(I2CBatchDescriptor))) {
+    ThrowIllegalArgumentException(
+        env, "I2C batch buffer must be direct and hold every descriptor");
+    return 0;
+  }
+
+  // Validate the whole table first, so a bad descriptor does not leave the
+  // batch half done
+  for (jint i = 0; i < count; i++) {
+    I2CBatchDescriptor desc;
+    std::memcpy(&desc, base + i * sizeof(I2CBatchDescriptor), sizeof(desc));
+    if (!InBuffer(desc.sendOffset, desc.sendSize, capacity) ||
+        !InBuffer(desc.receiveOffset, desc.receiveSize, capacity)) {
+      ThrowIllegalArgumentException(
+          env, "I2C batch transfer is outside of the buffer");
+      return 0;
+    }
+  }
+
+  // The HAL has no batched I2C call, so the transfers are run here, still
+  // saving a JNI transition and a set of buffer lookups per transfer
+  jint completed = 0;
+  for (; completed < count; completed++) {
+    I2CBatchDescriptor desc;
+    std::memcpy(&desc, base + completed * sizeof(I2CBatchDescriptor),
+                sizeof(desc));
+    uint8_t* send = desc.sendOffset == -1 ? nullptr : base + desc.sendOffset;
+    uint8_t* recv =
+        desc.receiveOffset == -1 ? nullptr : base + desc.receiveOffset;
+    if (HAL_TransactionI2C(static_cast<HAL_I2CPort>(port), desc.deviceAddress,
+                           send, desc.sendSize, recv, desc.receiveSize) < 0) {
+      break;
+    }
+  }
+  I2CJNI_LOG(logDEBUG) << "Completed = " << completed;
+  return completed;
+}
+
 /*
  * Class:     edu_wpi_first_wpilibj_hal_I2CJNI
  * Method:    i2CClose
@@ -189,7 +260,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CReadB(
  */
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_I2CJNI_i2CClose(JNIEnv*, jclass, jint port) {
-  I2CJNI_LOG(logDEBUG) << "Calling I2CJNI i2CClose";
+  JNI_TRACE("I2CJNI i2CClose");
   HAL_CloseI2C(static_cast<HAL_I2CPort>(port));
 }
 
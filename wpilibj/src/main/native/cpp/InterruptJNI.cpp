@@ -8,114 +8,73 @@
 #include <assert.h>
 #include <jni.h>
 #include <atomic>
-#include <thread>
+#include <unordered_map>
 
 #include <support/mutex.h>
 
 #include "HAL/cpp/Log.h"
 
+#include "CallbackDispatcher.h"
 #include "HAL/Interrupts.h"
 #include "HALUtil.h"
 #include "edu_wpi_first_wpilibj_hal_InterruptJNI.h"
-#include "support/SafeThread.h"
 
 using namespace frc;
 
 TLogLevel interruptJNILogLevel = logERROR;
 
-#define INTERRUPTJNI_LOG(level)     \
-  if (level > interruptJNILogLevel) \
-    ;                               \
-  else                              \
-  Log().Get(level)
+#define INTERRUPTJNI_LOG(level) JNI_LOG(interruptJNILogLevel, level)
 
-// Thread where callbacks are actually performed.
-//
-// JNI's AttachCurrentThread() creates a Java Thread object on every
-// invocation, which is both time inefficient and causes issues with Eclipse
-// (which tries to keep a thread list up-to-date and thus gets swamped).
-//
-// Instead, this class attaches just once.  When a hardware notification
-// occurs, a condition variable wakes up this thread and this thread actually
-// makes the call into Java.
+// Interrupt handler state. Callbacks into Java are made by the
+// CallbackDispatcher, keyed by this object, so they run one at a time.
 //
 // We don't want to use a FIFO here. If the user code takes too long to
 // process, we will just ignore the redundant wakeup.
-class InterruptThreadJNI : public wpi::SafeThread {
- public:
-  void Main();
-
-  bool m_notify = false;
-  uint32_t m_mask = 0;
-  jobject m_func = nullptr;
-  jmethodID m_mid;
-  jobject m_param = nullptr;
+struct InterruptJNI {
+  jobject func = nullptr;
+  jmethodID mid;
+  jobject param = nullptr;
+  std::atomic<uint32_t> mask{0};
+  // set while a callback is queued
+  std::atomic_bool pending{false};
+  std::atomic_bool active{true};
 };
 
-class InterruptJNI : public wpi::SafeThreadOwner<InterruptThreadJNI> {
- public:
-  void SetFunc(JNIEnv* env, jobject func, jmethodID mid, jobject param);
+// attached handlers by interrupt handle, so cleanInterrupts can free them
+static wpi::mutex interruptJNIMutex;
+static std::unordered_map<HAL_InterruptHandle, InterruptJNI*> interruptJNIs;
 
-  void Notify(uint32_t mask) {
-    auto thr = GetThread();
-    if (!thr) return;
-    thr->m_notify = true;
-    thr->m_mask = mask;
-    thr->m_cond.notify_one();
-  }
-};
-
-void InterruptJNI::SetFunc(JNIEnv* env, jobject func, jmethodID mid,
-                           jobject param) {
-  auto thr = GetThread();
-  if (!thr) return;
-  // free global references
-  if (thr->m_func) env->DeleteGlobalRef(thr->m_func);
-  if (thr->m_param) env->DeleteGlobalRef(thr->m_param);
-  // create global references
-  thr->m_func = env->NewGlobalRef(func);
-  thr->m_param = param ? env->NewGlobalRef(param) : nullptr;
-  thr->m_mid = mid;
+static void CallInterruptHandler(JNIEnv* env, void* context, uint64_t) {
+  auto intr = static_cast<InterruptJNI*>(context);
+  intr->pending = false;
+  if (!intr->active) return;
+  env->CallVoidMethod(intr->func, intr->mid, static_cast<jint>(intr->mask),
+                      intr->param);
 }
 
-void InterruptThreadJNI::Main() {
-  JNIEnv* env;
-  JavaVMAttachArgs args;
-  args.version = JNI_VERSION_1_2;
-  args.name = const_cast<char*>("Interrupt");
-  args.group = nullptr;
-  jint rs = jvm->AttachCurrentThreadAsDaemon(reinterpret_cast<void**>(&env),
-                                             &args);
-  if (rs != JNI_OK) return;
-
-  std::unique_lock<wpi::mutex> lock(m_mutex);
-  while (m_active) {
-    m_cond.wait(lock, [&] { return !m_active || m_notify; });
-    if (!m_active) break;
-    m_notify = false;
-    if (!m_func) continue;
-    jobject func = m_func;
-    jmethodID mid = m_mid;
-    uint32_t mask = m_mask;
-    jobject param = m_param;
-    lock.unlock();  // don't hold mutex during callback execution
-    env->CallVoidMethod(func, mid, static_cast<jint>(mask), param);
-    if (env->ExceptionCheck()) {
-      env->ExceptionDescribe();
-      env->ExceptionClear();
-    }
-    lock.lock();
-  }
-
+static void FreeInterruptJNI(JNIEnv* env, void* context, uint64_t) {
+  auto intr = static_cast<InterruptJNI*>(context);
   // free global references
-  if (m_func) env->DeleteGlobalRef(m_func);
-  if (m_param) env->DeleteGlobalRef(m_param);
+  env->DeleteGlobalRef(intr->func);
+  if (intr->param) env->DeleteGlobalRef(intr->param);
+  delete intr;
+}
 
-  jvm->DetachCurrentThread();
+// Frees the handler once any callback already queued for it has run
+static void RetireInterruptJNI(InterruptJNI* intr) {
+  intr->active = false;
+  CallbackDispatcher::GetInstance().DispatchBlocking(intr, FreeInterruptJNI,
+                                                     intr);
 }
 
 void interruptHandler(uint32_t mask, void* param) {
-  static_cast<InterruptJNI*>(param)->Notify(mask);
+  auto intr = static_cast<InterruptJNI*>(param);
+  intr->mask = mask;
+  if (intr->pending.exchange(true)) return;
+  if (!CallbackDispatcher::GetInstance().Dispatch(intr, CallInterruptHandler,
+                                                  intr)) {
+    intr->pending = false;
+  }
 }
 
 extern "C" {
@@ -128,7 +87,7 @@ extern "C" {
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_initializeInterrupts(
     JNIEnv* env, jclass, jboolean watcher) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI initializeInterrupts";
+  JNI_TRACE("INTERRUPTJNI initializeInterrupts");
   INTERRUPTJNI_LOG(logDEBUG) << "watcher = " << (bool)watcher;
 
   int32_t status = 0;
@@ -149,7 +108,7 @@ Java_edu_wpi_first_wpilibj_hal_InterruptJNI_initializeInterrupts(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_cleanInterrupts(
     JNIEnv* env, jclass, jint interruptHandle) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI cleanInterrupts";
+  JNI_TRACE("INTERRUPTJNI cleanInterrupts");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
 
   int32_t status = 0;
@@ -157,6 +116,13 @@ Java_edu_wpi_first_wpilibj_hal_InterruptJNI_cleanInterrupts(
 
   INTERRUPTJNI_LOG(logDEBUG) << "Status = " << status;
 
+  std::lock_guard<wpi::mutex> lock(interruptJNIMutex);
+  auto it = interruptJNIs.find((HAL_InterruptHandle)interruptHandle);
+  if (it != interruptJNIs.end()) {
+    RetireInterruptJNI(it->second);
+    interruptJNIs.erase(it);
+  }
+
   // ignore status, as an invalid handle just needs to be ignored.
 }
 
@@ -169,7 +135,7 @@ JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_waitForInterrupt(
     JNIEnv* env, jclass, jint interruptHandle, jdouble timeout,
     jboolean ignorePrevious) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI waitForInterrupt";
+  JNI_TRACE("INTERRUPTJNI waitForInterrupt");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
 
   int32_t status = 0;
@@ -190,7 +156,7 @@ Java_edu_wpi_first_wpilibj_hal_InterruptJNI_waitForInterrupt(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_enableInterrupts(
     JNIEnv* env, jclass, jint interruptHandle) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI enableInterrupts";
+  JNI_TRACE("INTERRUPTJNI enableInterrupts");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
 
   int32_t status = 0;
@@ -209,7 +175,7 @@ Java_edu_wpi_first_wpilibj_hal_InterruptJNI_enableInterrupts(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_disableInterrupts(
     JNIEnv* env, jclass, jint interruptHandle) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI disableInterrupts";
+  JNI_TRACE("INTERRUPTJNI disableInterrupts");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
 
   int32_t status = 0;
@@ -228,7 +194,7 @@ Java_edu_wpi_first_wpilibj_hal_InterruptJNI_disableInterrupts(
 JNIEXPORT jdouble JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_readInterruptRisingTimestamp(
     JNIEnv* env, jclass, jint interruptHandle) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI readInterruptRisingTimestamp";
+  JNI_TRACE("INTERRUPTJNI readInterruptRisingTimestamp");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
 
   int32_t status = 0;
@@ -247,7 +213,7 @@ Java_edu_wpi_first_wpilibj_hal_InterruptJNI_readInterruptRisingTimestamp(
 JNIEXPORT jdouble JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_readInterruptFallingTimestamp(
     JNIEnv* env, jclass, jint interruptHandle) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI readInterruptFallingTimestamp";
+  JNI_TRACE("INTERRUPTJNI readInterruptFallingTimestamp");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
 
   int32_t status = 0;
@@ -267,7 +233,7 @@ JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_requestInterrupts(
     JNIEnv* env, jclass, jint interruptHandle, jint digitalSourceHandle,
     jint analogTriggerType) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI requestInterrupts";
+  JNI_TRACE("INTERRUPTJNI requestInterrupts");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
   INTERRUPTJNI_LOG(logDEBUG) << "digitalSourceHandle = " << digitalSourceHandle;
   INTERRUPTJNI_LOG(logDEBUG) << "analogTriggerType = " << analogTriggerType;
@@ -290,7 +256,7 @@ JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_attachInterruptHandler(
     JNIEnv* env, jclass, jint interruptHandle, jobject handler,
     jobject param) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI attachInterruptHandler";
+  JNI_TRACE("INTERRUPTJNI attachInterruptHandler");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
 
   jclass cls = env->GetObjectClass(handler);
@@ -309,14 +275,22 @@ Java_edu_wpi_first_wpilibj_hal_InterruptJNI_attachInterruptHandler(
   }
 
   InterruptJNI* intr = new InterruptJNI;
-  intr->Start();
-  intr->SetFunc(env, handler, mid, param);
+  intr->func = env->NewGlobalRef(handler);
+  intr->mid = mid;
+  intr->param = param ? env->NewGlobalRef(param) : nullptr;
 
-  INTERRUPTJNI_LOG(logDEBUG) << "InterruptThreadJNI Ptr = " << intr;
+  INTERRUPTJNI_LOG(logDEBUG) << "InterruptJNI Ptr = " << intr;
 
   int32_t status = 0;
   HAL_AttachInterruptHandler((HAL_InterruptHandle)interruptHandle, interruptHandler, intr,
                          &status);
+  {
+    std::lock_guard<wpi::mutex> lock(interruptJNIMutex);
+    // replaces an earlier handler, which the HAL no longer calls
+    auto& attached = interruptJNIs[(HAL_InterruptHandle)interruptHandle];
+    if (attached) RetireInterruptJNI(attached);
+    attached = intr;
+  }
 
   INTERRUPTJNI_LOG(logDEBUG) << "Status = " << status;
   CheckStatus(env, status);
@@ -331,7 +305,7 @@ JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_InterruptJNI_setInterruptUpSourceEdge(
     JNIEnv* env, jclass, jint interruptHandle, jboolean risingEdge,
     jboolean fallingEdge) {
-  INTERRUPTJNI_LOG(logDEBUG) << "Calling INTERRUPTJNI setInterruptUpSourceEdge";
+  JNI_TRACE("INTERRUPTJNI setInterruptUpSourceEdge");
   INTERRUPTJNI_LOG(logDEBUG) << "Interrupt Handle = " << (HAL_InterruptHandle)interruptHandle;
   INTERRUPTJNI_LOG(logDEBUG) << "Rising Edge = " << (bool)risingEdge;
   INTERRUPTJNI_LOG(logDEBUG) << "Falling Edge = " << (bool)fallingEdge;
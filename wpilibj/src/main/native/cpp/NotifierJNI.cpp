@@ -18,11 +18,7 @@ using namespace frc;
 // set the logging level
 TLogLevel notifierJNILogLevel = logWARNING;
 
-#define NOTIFIERJNI_LOG(level)     \
-  if (level > notifierJNILogLevel) \
-    ;                              \
-  else                             \
-  Log().Get(level)
+#define NOTIFIERJNI_LOG(level) JNI_LOG(notifierJNILogLevel, level)
 
 extern "C" {
 
@@ -34,7 +30,7 @@ extern "C" {
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_NotifierJNI_initializeNotifier(
     JNIEnv *env, jclass) {
-  NOTIFIERJNI_LOG(logDEBUG) << "Calling NOTIFIERJNI initializeNotifier";
+  JNI_TRACE("NOTIFIERJNI initializeNotifier");
 
   int32_t status = 0;
   HAL_NotifierHandle notifierHandle = HAL_InitializeNotifier(&status);
@@ -57,7 +53,7 @@ Java_edu_wpi_first_wpilibj_hal_NotifierJNI_initializeNotifier(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_NotifierJNI_stopNotifier(
     JNIEnv *env, jclass cls, jint notifierHandle) {
-  NOTIFIERJNI_LOG(logDEBUG) << "Calling NOTIFIERJNI stopNotifier";
+  JNI_TRACE("NOTIFIERJNI stopNotifier");
 
   NOTIFIERJNI_LOG(logDEBUG) << "Notifier Handle = " << notifierHandle;
 
@@ -74,7 +70,7 @@ Java_edu_wpi_first_wpilibj_hal_NotifierJNI_stopNotifier(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_NotifierJNI_cleanNotifier(
     JNIEnv *env, jclass, jint notifierHandle) {
-  NOTIFIERJNI_LOG(logDEBUG) << "Calling NOTIFIERJNI cleanNotifier";
+  JNI_TRACE("NOTIFIERJNI cleanNotifier");
 
   NOTIFIERJNI_LOG(logDEBUG) << "Notifier Handle = " << notifierHandle;
 
@@ -92,7 +88,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_NotifierJNI_cleanNotifier(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_NotifierJNI_updateNotifierAlarm(
     JNIEnv *env, jclass cls, jint notifierHandle, jlong triggerTime) {
-  NOTIFIERJNI_LOG(logDEBUG) << "Calling NOTIFIERJNI updateNotifierAlarm";
+  JNI_TRACE("NOTIFIERJNI updateNotifierAlarm");
 
   NOTIFIERJNI_LOG(logDEBUG) << "Notifier Handle = " << notifierHandle;
 
@@ -104,6 +100,27 @@ Java_edu_wpi_first_wpilibj_hal_NotifierJNI_updateNotifierAlarm(
   CheckStatus(env, status);
 }
 
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_NotifierJNI
+ * Method:    setNotifierPeriodic
+ * Signature: (IJ)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_wpilibj_hal_NotifierJNI_setNotifierPeriodic(
+    JNIEnv *env, jclass cls, jint notifierHandle, jlong period) {
+  JNI_TRACE("NOTIFIERJNI setNotifierPeriodic");
+
+  NOTIFIERJNI_LOG(logDEBUG) << "Notifier Handle = " << notifierHandle;
+
+  NOTIFIERJNI_LOG(logDEBUG) << "period = " << period;
+
+  int32_t status = 0;
+  HAL_SetNotifierPeriodic((HAL_NotifierHandle)notifierHandle,
+                          (uint64_t)period, &status);
+  NOTIFIERJNI_LOG(logDEBUG) << "Status = " << status;
+  CheckStatus(env, status);
+}
+
 /*
  * Class:     edu_wpi_first_wpilibj_hal_NotifierJNI
  * Method:    cancelNotifierAlarm
@@ -112,7 +129,7 @@ Java_edu_wpi_first_wpilibj_hal_NotifierJNI_updateNotifierAlarm(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_NotifierJNI_cancelNotifierAlarm(
     JNIEnv *env, jclass cls, jint notifierHandle) {
-  NOTIFIERJNI_LOG(logDEBUG) << "Calling NOTIFIERJNI cancelNotifierAlarm";
+  JNI_TRACE("NOTIFIERJNI cancelNotifierAlarm");
 
   NOTIFIERJNI_LOG(logDEBUG) << "Notifier Handle = " << notifierHandle;
 
@@ -130,7 +147,7 @@ Java_edu_wpi_first_wpilibj_hal_NotifierJNI_cancelNotifierAlarm(
 JNIEXPORT jlong JNICALL
 Java_edu_wpi_first_wpilibj_hal_NotifierJNI_waitForNotifierAlarm(
     JNIEnv *env, jclass cls, jint notifierHandle) {
-  NOTIFIERJNI_LOG(logDEBUG) << "Calling NOTIFIERJNI waitForNotifierAlarm";
+  JNI_TRACE("NOTIFIERJNI waitForNotifierAlarm");
 
   NOTIFIERJNI_LOG(logDEBUG) << "Notifier Handle = " << notifierHandle;
 
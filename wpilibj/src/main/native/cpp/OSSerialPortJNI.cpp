@@ -21,11 +21,7 @@ using namespace wpi::java;
 // set the logging level
 TLogLevel osserialJNILogLevel = logWARNING;
 
-#define SERIALJNI_LOG(level)       \
-  if (level > osserialJNILogLevel) \
-    ;                              \
-  else                             \
-  Log().Get(level)
+#define SERIALJNI_LOG(level) JNI_LOG(osserialJNILogLevel, level)
 
 extern "C" {
 
@@ -37,7 +33,7 @@ extern "C" {
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_OSSerialPortJNI_serialInitializePort(
     JNIEnv* env, jclass, jbyte port) {
-  SERIALJNI_LOG(logDEBUG) << "Calling Serial Initialize";
+  JNI_TRACE("Serial Initialize");
   SERIALJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   int32_t status = 0;
   HAL_InitializeOSSerialPort(static_cast<HAL_SerialPort>(port), &status);
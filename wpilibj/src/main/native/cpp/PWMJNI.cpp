@@ -22,11 +22,7 @@ using namespace frc;
 // set the logging level
 TLogLevel pwmJNILogLevel = logWARNING;
 
-#define PWMJNI_LOG(level)     \
-  if (level > pwmJNILogLevel) \
-    ;                         \
-  else                        \
-  Log().Get(level)
+#define PWMJNI_LOG(level) JNI_LOG(pwmJNILogLevel, level)
 
 extern "C" {
 
@@ -38,7 +34,7 @@ extern "C" {
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PWMJNI_initializePWMPort(
     JNIEnv *env, jclass, jint id) {
-  PWMJNI_LOG(logDEBUG) << "Calling PWMJNI initializePWMPort";
+  JNI_TRACE("PWMJNI initializePWMPort");
   PWMJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_PortHandle)id;
   int32_t status = 0;
   auto pwm = HAL_InitializePWMPort((HAL_PortHandle)id, &status);
@@ -56,7 +52,7 @@ Java_edu_wpi_first_wpilibj_hal_PWMJNI_initializePWMPort(
 */
 JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_checkPWMChannel(
     JNIEnv *env, jclass, jint channel) {
-  PWMJNI_LOG(logDEBUG) << "Calling PWMJNI checkPWMChannel";
+  JNI_TRACE("PWMJNI checkPWMChannel");
   PWMJNI_LOG(logDEBUG) << "Channel = " << channel;
   return HAL_CheckPWMChannel(channel);
 }
@@ -68,7 +64,7 @@ JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_checkPWMChannel
 */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_freePWMPort(
     JNIEnv *env, jclass, jint id) {
-  PWMJNI_LOG(logDEBUG) << "Calling PWMJNI freePWMPort";
+  JNI_TRACE("PWMJNI freePWMPort");
   PWMJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_DigitalHandle)id;
   int32_t status = 0;
   HAL_FreePWMPort((HAL_DigitalHandle)id, &status);
@@ -83,7 +79,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_freePWMPort(
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_setPWMConfigRaw(
     JNIEnv *env, jclass, jint id, jint maxPwm, jint deadbandMaxPwm, 
     jint centerPwm, jint deadbandMinPwm, jint minPwm) {
-  PWMJNI_LOG(logDEBUG) << "Calling PWMJNI setPWMConfigRaw";
+  JNI_TRACE("PWMJNI setPWMConfigRaw");
   PWMJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_DigitalHandle)id;
   int32_t status = 0;
   HAL_SetPWMConfigRaw((HAL_DigitalHandle)id, maxPwm, deadbandMaxPwm, centerPwm, 
@@ -99,7 +95,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_setPWMConfigRaw(
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_setPWMConfig(
     JNIEnv *env, jclass, jint id, jdouble maxPwm, jdouble deadbandMaxPwm, 
     jdouble centerPwm, jdouble deadbandMinPwm, jdouble minPwm) {
-  PWMJNI_LOG(logDEBUG) << "Calling PWMJNI setPWMConfig";
+  JNI_TRACE("PWMJNI setPWMConfig");
   PWMJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_DigitalHandle)id;
   int32_t status = 0;
   HAL_SetPWMConfig((HAL_DigitalHandle)id, maxPwm, deadbandMaxPwm, centerPwm, 
@@ -114,7 +110,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_setPWMConfig(
 */
 JNIEXPORT jobject JNICALL Java_edu_wpi_first_wpilibj_hal_PWMJNI_getPWMConfigRaw(
     JNIEnv *env, jclass, jint id) {
-  PWMJNI_LOG(logDEBUG) << "Calling PWMJNI getPWMConfigRaw";
+  JNI_TRACE("PWMJNI getPWMConfigRaw");
   PWMJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_DigitalHandle)id;
   int32_t status = 0;
   int32_t maxPwm = 0;
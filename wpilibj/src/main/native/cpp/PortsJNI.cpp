@@ -19,11 +19,7 @@ using namespace frc;
 // set the logging level
 TLogLevel portsJNILogLevel = logWARNING;
 
-#define PORTSJNI_LOG(level)     \
-  if (level > portsJNILogLevel) \
-    ;                         \
-  else                        \
-  Log().Get(level)
+#define PORTSJNI_LOG(level) JNI_LOG(portsJNILogLevel, level)
 
 extern "C" {
 /*
@@ -34,7 +30,7 @@ extern "C" {
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumAccumulators(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumAccumulators";
+  JNI_TRACE("PortsJNI getNumAccumulators");
   jint value = HAL_GetNumAccumulators();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -49,7 +45,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumAccumulators(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumAnalogTriggers(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumAnalogTriggers";
+  JNI_TRACE("PortsJNI getNumAnalogTriggers");
   jint value = HAL_GetNumAnalogTriggers();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -64,7 +60,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumAnalogTriggers(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumAnalogInputs(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumAnalogInputs";
+  JNI_TRACE("PortsJNI getNumAnalogInputs");
   jint value = HAL_GetNumAnalogInputs();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -79,7 +75,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumAnalogInputs(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumAnalogOutputs(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumAnalogOutputs";
+  JNI_TRACE("PortsJNI getNumAnalogOutputs");
   jint value = HAL_GetNumAnalogOutputs();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -94,7 +90,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumAnalogOutputs(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumCounters(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumCounters";
+  JNI_TRACE("PortsJNI getNumCounters");
   jint value = HAL_GetNumCounters();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -109,7 +105,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumCounters(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumDigitalHeaders(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumDigitalHeaders";
+  JNI_TRACE("PortsJNI getNumDigitalHeaders");
   jint value = HAL_GetNumDigitalHeaders();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -124,7 +120,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumDigitalHeaders(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPWMHeaders(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumPWMHeaders";
+  JNI_TRACE("PortsJNI getNumPWMHeaders");
   jint value = HAL_GetNumPWMHeaders();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -139,7 +135,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPWMHeaders(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumDigitalChannels(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumDigitalChannels";
+  JNI_TRACE("PortsJNI getNumDigitalChannels");
   jint value = HAL_GetNumDigitalChannels();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -154,7 +150,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumDigitalChannels(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPWMChannels(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumPWMChannels";
+  JNI_TRACE("PortsJNI getNumPWMChannels");
   jint value = HAL_GetNumPWMChannels();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -169,7 +165,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPWMChannels(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumDigitalPWMOutputs(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumDigitalPWMOutputs";
+  JNI_TRACE("PortsJNI getNumDigitalPWMOutputs");
   jint value = HAL_GetNumDigitalPWMOutputs();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -184,7 +180,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumDigitalPWMOutputs(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumEncoders(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumEncoders";
+  JNI_TRACE("PortsJNI getNumEncoders");
   jint value = HAL_GetNumEncoders();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -199,7 +195,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumEncoders(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumInterrupts(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumInterrupts";
+  JNI_TRACE("PortsJNI getNumInterrupts");
   jint value = HAL_GetNumInterrupts();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -214,7 +210,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumInterrupts(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumRelayChannels(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumRelayChannels";
+  JNI_TRACE("PortsJNI getNumRelayChannels");
   jint value = HAL_GetNumRelayChannels();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -229,7 +225,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumRelayChannels(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumRelayHeaders(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumRelayHeaders";
+  JNI_TRACE("PortsJNI getNumRelayHeaders");
   jint value = HAL_GetNumRelayHeaders();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -244,7 +240,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumRelayHeaders(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPCMModules(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumPCMModules";
+  JNI_TRACE("PortsJNI getNumPCMModules");
   jint value = HAL_GetNumPCMModules();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -259,7 +255,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPCMModules(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumSolenoidChannels(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumSolenoidChannels";
+  JNI_TRACE("PortsJNI getNumSolenoidChannels");
   jint value = HAL_GetNumSolenoidChannels();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -274,7 +270,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumSolenoidChannels(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPDPModules(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumPDPModules";
+  JNI_TRACE("PortsJNI getNumPDPModules");
   jint value = HAL_GetNumPDPModules();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
@@ -289,7 +285,7 @@ Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPDPModules(
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_PortsJNI_getNumPDPChannels(
     JNIEnv *env, jclass) {
-  PORTSJNI_LOG(logDEBUG) << "Calling PortsJNI getNumPDPChannels";
+  JNI_TRACE("PortsJNI getNumPDPChannels");
   jint value = HAL_GetNumPDPChannels();
   PORTSJNI_LOG(logDEBUG) << "Value = " << value;
   return value;
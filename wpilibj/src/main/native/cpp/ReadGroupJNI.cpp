@@ -0,0 +1,176 @@
+/*----------------------------------------------------------------------------*/
+/* Copyright (c) 2018 FIRST. All Rights Reserved.                             */
+/* Open Source Software - may be modified and shared by FRC teams. The code   */
+/* must be accompanied by the FIRST BSD license file in the root directory of */
+/* the project.                                                               */
+/*----------------------------------------------------------------------------*/
+
+#include <jni.h>
+
+#include <memory>
+#include <vector>
+
+#include "edu_wpi_first_wpilibj_hal_ReadGroupJNI.h"
+
+#include "HAL/AnalogGyro.h"
+#include "HAL/AnalogInput.h"
+#include "HAL/Counter.h"
+#include "HAL/DIO.h"
+#include "HAL/Encoder.h"
+#include "HAL/Errors.h"
+#include "HAL/handles/UnlimitedHandleResource.h"
+#include "HALUtil.h"
+
+using namespace frc;
+
+namespace {
+// Sensor types, matching the constants in ReadGroupJNI.java
+enum ReadType : int32_t {
+  kEncoderCount = 0,
+  kEncoderRaw,
+  kEncoderDistance,
+  kEncoderRate,
+  kEncoderPeriod,
+  kCounterCount,
+  kCounterPeriod,
+  kAnalogValue,
+  kAnalogAverageValue,
+  kAnalogVoltage,
+  kAnalogAverageVoltage,
+  kDIO,
+  kAnalogGyroAngle,
+  kAnalogGyroRate,
+  kReadTypeCount
+};
+
+struct ReadEntry {
+  double value;
+  int32_t status;
+  int32_t reserved;
+};
+
+static_assert(sizeof(ReadEntry) == 16, "entry layout must match Java");
+
+struct ReadGroup {
+  std::vector<int32_t> types;
+  std::vector<HAL_Handle> handles;
+};
+}  // namespace
+
+static hal::UnlimitedHandleResource<HAL_Handle, ReadGroup,
+                                    hal::HAL_HandleEnum::Vendor>
+    readGroupHandles;
+
+static double ReadValue(int32_t type, HAL_Handle handle, int32_t* status) {
+  switch (type) {
+    case kEncoderCount:
+      return HAL_GetEncoder(handle, status);
+    case kEncoderRaw:
+      return HAL_GetEncoderRaw(handle, status);
+    case kEncoderDistance:
+      return HAL_GetEncoderDistance(handle, status);
+    case kEncoderRate:
+      return HAL_GetEncoderRate(handle, status);
+    case kEncoderPeriod:
+      return HAL_GetEncoderPeriod(handle, status);
+    case kCounterCount:
+      return HAL_GetCounter(handle, status);
+    case kCounterPeriod:
+      return HAL_GetCounterPeriod(handle, status);
+    case kAnalogValue:
+      return HAL_GetAnalogValue(handle, status);
+    case kAnalogAverageValue:
+      return HAL_GetAnalogAverageValue(handle, status);
+    case kAnalogVoltage:
+      return HAL_GetAnalogVoltage(handle, status);
+    case kAnalogAverageVoltage:
+      return HAL_GetAnalogAverageVoltage(handle, status);
+    case kDIO:
+      return HAL_GetDIO(handle, status);
+    case kAnalogGyroAngle:
+      return HAL_GetAnalogGyroAngle(handle, status);
+    case kAnalogGyroRate:
+      return HAL_GetAnalogGyroRate(handle, status);
+    default:
+      *status = PARAMETER_OUT_OF_RANGE;
+      return 0;
+  }
+}
+
+extern "C" {
+
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_ReadGroupJNI
+ * Method:    initializeReadGroup
+ * Signature: ([I[I)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_wpilibj_hal_ReadGroupJNI_initializeReadGroup(
+    JNIEnv* env, jclass, jintArray types, jintArray handles) {
+  if (!types || !handles ||
+      env->GetArrayLength(types) != env->GetArrayLength(handles)) {
+    ThrowIllegalArgumentException(
+        env, "read group types and handles must be the same length");
+    return HAL_kInvalidHandle;
+  }
+  auto group = std::make_shared<ReadGroup>();
+  jsize count = env->GetArrayLength(types);
+  group->types.resize(count);
+  group->handles.resize(count);
+  env->GetIntArrayRegion(types, 0, count, group->types.data());
+  env->GetIntArrayRegion(handles, 0, count,
+                         reinterpret_cast<jint*>(group->handles.data()));
+  for (int32_t type : group->types) {
+    if (type < 0 || type >= kReadTypeCount) {
+      ThrowIllegalArgumentException(env, "invalid read group sensor type");
+      return HAL_kInvalidHandle;
+    }
+  }
+  return readGroupHandles.Allocate(std::move(group));
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_ReadGroupJNI
+ * Method:    freeReadGroup
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL
+Java_edu_wpi_first_wpilibj_hal_ReadGroupJNI_freeReadGroup(JNIEnv*, jclass,
+                                                          jint id) {
+  readGroupHandles.Free(id);
+}
+
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_ReadGroupJNI
+ * Method:    readGroup
+ * Signature: (ILjava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_ReadGroupJNI_readGroup(
+    JNIEnv* env, jclass, jint id, jobject buffer) {
+  auto group = readGroupHandles.Get(id);
+  if (!group) {
+    CheckStatus(env, HAL_HANDLE_ERROR);
+    return 0;
+  }
+  size_t count = group->types.size();
+  auto entries = static_cast<ReadEntry*>(
+      buffer ? env->GetDirectBufferAddress(buffer) : nullptr);
+  if (!entries || env->GetDirectBufferCapacity(buffer) <
+                      static_cast<jlong>(count * sizeof(ReadEntry))) {
+    ThrowIllegalArgumentException(
+        env, "read group buffer must be a direct buffer of kEntrySize bytes "
+             "per sensor");
+    return 0;
+  }
+
+  jint failed = 0;
+  for (size_t i = 0; i < count; i++) {
+    int32_t status = 0;
+    entries[i].value = ReadValue(group->types[i], group->handles[i], &status);
+    entries[i].status = status;
+    if (status != 0) failed++;
+  }
+  return failed;
+}
+
+}  // extern "C"
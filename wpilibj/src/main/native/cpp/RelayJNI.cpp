@@ -21,11 +21,7 @@ using namespace frc;
 // set the logging level
 TLogLevel relayJNILogLevel = logWARNING;
 
-#define RELAYJNI_LOG(level)     \
-  if (level > relayJNILogLevel) \
-    ;                           \
-  else                          \
-  Log().Get(level)
+#define RELAYJNI_LOG(level) JNI_LOG(relayJNILogLevel, level)
 
 extern "C" {
 
@@ -36,7 +32,7 @@ extern "C" {
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_RelayJNI_initializeRelayPort(
     JNIEnv* env, jclass, jint id, jboolean fwd) {
-  RELAYJNI_LOG(logDEBUG) << "Calling RELAYJNI initializeRelayPort";
+  JNI_TRACE("RELAYJNI initializeRelayPort");
   RELAYJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_PortHandle)id;
   RELAYJNI_LOG(logDEBUG) << "Forward = " << (jint)fwd;
   int32_t status = 0;
@@ -55,7 +51,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_RelayJNI_initializeRelayPo
 */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_RelayJNI_freeRelayPort(
     JNIEnv *env, jclass, jint id) {
-  RELAYJNI_LOG(logDEBUG) << "Calling RELAYJNI freeRelayPort";
+  JNI_TRACE("RELAYJNI freeRelayPort");
   RELAYJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_RelayHandle)id;
   HAL_FreeRelayPort((HAL_RelayHandle)id);
 }
@@ -67,7 +63,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_RelayJNI_freeRelayPort(
 */
 JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_RelayJNI_checkRelayChannel(
     JNIEnv *env, jclass, jint channel) {
-  RELAYJNI_LOG(logDEBUG) << "Calling RELAYJNI checkRelayChannel";
+  JNI_TRACE("RELAYJNI checkRelayChannel");
   RELAYJNI_LOG(logDEBUG) << "Channel = " << channel;
   return (jboolean)HAL_CheckRelayChannel((uint8_t) channel);
 }
@@ -79,7 +75,7 @@ JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_RelayJNI_checkRelayCha
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_RelayJNI_setRelay(
     JNIEnv* env, jclass, jint id, jboolean value) {
-  RELAYJNI_LOG(logDEBUG) << "Calling RELAYJNI setRelay";
+  JNI_TRACE("RELAYJNI setRelay");
   RELAYJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_RelayHandle)id;
   RELAYJNI_LOG(logDEBUG) << "Flag = " << (jint)value;
   int32_t status = 0;
@@ -96,7 +92,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_RelayJNI_setRelay(
 JNIEXPORT jboolean JNICALL
 Java_edu_wpi_first_wpilibj_hal_RelayJNI_getRelay(
     JNIEnv* env, jclass, jint id) {
-  RELAYJNI_LOG(logDEBUG) << "Calling RELAYJNI getRelay";
+  JNI_TRACE("RELAYJNI getRelay");
   RELAYJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_RelayHandle)id;
   int32_t status = 0;
   jboolean returnValue = HAL_GetRelay((HAL_RelayHandle)id, &status);
@@ -7,6 +7,7 @@
 
 #include <assert.h>
 #include <jni.h>
+#include <cstring>
 #include "HAL/cpp/Log.h"
 
 #include "edu_wpi_first_wpilibj_hal_SPIJNI.h"
@@ -21,11 +22,21 @@ using namespace wpi::java;
 // set the logging level
 TLogLevel spiJNILogLevel = logWARNING;
 
-#define SPIJNI_LOG(level)     \
-  if (level > spiJNILogLevel) \
-    ;                         \
-  else                        \
-  Log().Get(level)
+#define SPIJNI_LOG(level) JNI_LOG(spiJNILogLevel, level)
+
+namespace {
+// One transfer of spiTransactionBatch, as laid out in the Java buffer. The
+// offsets are into the same buffer; -1 means no data.
+struct SPIBatchDescriptor {
+  int32_t sendOffset;
+  int32_t receiveOffset;
+  int32_t size;
+  int32_t csChange;
+  int32_t delayMicroseconds;
+};
+static_assert(sizeof(SPIBatchDescriptor) == 20,
+              "SPIJNI.kBatchDescriptorSize must match");
+}  // namespace
 
 extern "C" {
 
@@ -36,7 +47,7 @@ extern "C" {
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiInitialize(
     JNIEnv *env, jclass, jint port) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiInitialize";
+  JNI_TRACE("SPIJNI spiInitialize");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   int32_t status = 0;
   HAL_InitializeSPI(static_cast<HAL_SPIPort>(port), &status);
@@ -52,7 +63,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiInitialize(
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiTransaction(
     JNIEnv *env, jclass, jint port, jobject dataToSend, jobject dataReceived,
     jbyte size) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiTransaction";
+  JNI_TRACE("SPIJNI spiTransaction");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   uint8_t *dataToSendPtr = nullptr;
   if (dataToSend != 0) {
@@ -76,7 +87,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiTransaction(
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiTransactionB(
     JNIEnv *env, jclass, jint port, jbyteArray dataToSend, jbyteArray dataReceived,
     jbyte size) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiTransactionB";
+  JNI_TRACE("SPIJNI spiTransactionB");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   SPIJNI_LOG(logDEBUG) << "Size = " << (jint)size;
   llvm::SmallVector<uint8_t, 128> recvBuf;
@@ -92,6 +103,64 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiTransactionB(
   return retVal;
 }
 
+/*
+ * Class:     edu_wpi_first_wpilibj_hal_SPIJNI
+ * Method:    spiTransactionBatch
+ * Signature: (ILjava/nio/ByteBuffer;I)I
+ */
+JNIEXPORT jint JNICALL
+Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiTransactionBatch(JNIEnv *env, jclass,
+                                                          jint port,
+                                                          jobject buffer,
+                                                          jint count) {
+  JNI_TRACE("SPIJNI spiTransactionBatch");
+  SPIJNI_LOG(logDEBUG) << "Port = " << port;
+  SPIJNI_LOG(logDEBUG) << "Count = " << count;
+  if (count < 0 || count > HAL_kSPIMaxBatchTransfers) {
+    ThrowIllegalArgumentException(env, "SPI batch transfer count out of range");
+    return 0;
+  }
+  uint8_t *base = static_cast<uint8_t *>(env->GetDirectBufferAddress(buffer));
+  jlong capacity = env->GetDirectBufferCapacity(buffer);
+  if (!base || capacity < count * static_cast<jlong>(
+                                      sizeof(SPIBatchDescriptor))) {
+    ThrowIllegalArgumentException(
+        env, "SPI batch buffer must be direct and hold every descriptor");
+    return 0;
+  }
+
+  // The Java side writes the table with a ByteBuffer, which need not be
+  // aligned, so copy each descriptor out
+  HAL_SPITransfer transfers[HAL_kSPIMaxBatchTransfers];
+  for (jint i = 0; i < count; i++) {
+    SPIBatchDescriptor desc;
+    std::memcpy(&desc, base + i * sizeof(SPIBatchDescriptor), sizeof(desc));
+    if (desc.size < 0 ||
+        (desc.sendOffset != -1 &&
+         (desc.sendOffset < 0 ||
+          desc.sendOffset + static_cast<jlong>(desc.size) > capacity)) ||
+        (desc.receiveOffset != -1 &&
+         (desc.receiveOffset < 0 ||
+          desc.receiveOffset + static_cast<jlong>(desc.size) > capacity))) {
+      ThrowIllegalArgumentException(
+          env, "SPI batch transfer is outside of the buffer");
+      return 0;
+    }
+    transfers[i].dataToSend =
+        desc.sendOffset == -1 ? nullptr : base + desc.sendOffset;
+    transfers[i].dataReceived =
+        desc.receiveOffset == -1 ? nullptr : base + desc.receiveOffset;
+    transfers[i].size = desc.size;
+    transfers[i].csChange = desc.csChange;
+    transfers[i].delayMicroseconds = desc.delayMicroseconds;
+  }
+
+  jint retVal =
+      HAL_TransactionSPIBatch(static_cast<HAL_SPIPort>(port), transfers, count);
+  SPIJNI_LOG(logDEBUG) << "ReturnValue = " << retVal;
+  return retVal;
+}
+
 /*
  * Class:     edu_wpi_first_wpilibj_hal_SPIJNI
  * Method:    spiWrite
@@ -99,7 +168,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiTransactionB(
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiWrite(
     JNIEnv *env, jclass, jint port, jobject dataToSend, jbyte size) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiWrite";
+  JNI_TRACE("SPIJNI spiWrite");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   uint8_t *dataToSendPtr = nullptr;
   if (dataToSend != 0) {
@@ -119,7 +188,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiWrite(
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiWriteB(
     JNIEnv *env, jclass, jint port, jbyteArray dataToSend, jbyte size) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiWriteB";
+  JNI_TRACE("SPIJNI spiWriteB");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   SPIJNI_LOG(logDEBUG) << "Size = " << (jint)size;
   jint retVal = HAL_WriteSPI(static_cast<HAL_SPIPort>(port),
@@ -137,7 +206,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiWriteB(
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiRead(
     JNIEnv *env, jclass, jint port, jboolean initiate, jobject dataReceived, jbyte size) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiRead";
+  JNI_TRACE("SPIJNI spiRead");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   SPIJNI_LOG(logDEBUG) << "Initiate = " << (jboolean)initiate;
   uint8_t *dataReceivedPtr =
@@ -163,7 +232,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiRead(
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiReadB(
     JNIEnv *env, jclass, jint port, jboolean initiate, jbyteArray dataReceived, jbyte size) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiReadB";
+  JNI_TRACE("SPIJNI spiReadB");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   SPIJNI_LOG(logDEBUG) << "Initiate = " << (jboolean)initiate;
   SPIJNI_LOG(logDEBUG) << "Size = " << (jint)size;
@@ -190,7 +259,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiReadB(
  */
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiClose(JNIEnv *, jclass, jint port) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiClose";
+  JNI_TRACE("SPIJNI spiClose");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   HAL_CloseSPI(static_cast<HAL_SPIPort>(port));
 }
@@ -202,7 +271,7 @@ Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiClose(JNIEnv *, jclass, jint port) {
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetSpeed(
     JNIEnv *, jclass, jint port, jint speed) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiSetSpeed";
+  JNI_TRACE("SPIJNI spiSetSpeed");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   SPIJNI_LOG(logDEBUG) << "Speed = " << (jint)speed;
   HAL_SetSPISpeed(static_cast<HAL_SPIPort>(port), speed);
@@ -216,7 +285,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetSpeed(
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetOpts(
     JNIEnv *, jclass, jint port, jint msb_first, jint sample_on_trailing,
     jint clk_idle_high) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiSetOpts";
+  JNI_TRACE("SPIJNI spiSetOpts");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   SPIJNI_LOG(logDEBUG) << "msb_first = " << msb_first;
   SPIJNI_LOG(logDEBUG) << "sample_on_trailing = " << sample_on_trailing;
@@ -232,7 +301,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetOpts(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetChipSelectActiveHigh(
     JNIEnv *env, jclass, jint port) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiSetCSActiveHigh";
+  JNI_TRACE("SPIJNI spiSetCSActiveHigh");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   int32_t status = 0;
   HAL_SetSPIChipSelectActiveHigh(static_cast<HAL_SPIPort>(port), &status);
@@ -248,7 +317,7 @@ Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetChipSelectActiveHigh(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetChipSelectActiveLow(
     JNIEnv *env, jclass, jint port) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiSetCSActiveLow";
+  JNI_TRACE("SPIJNI spiSetCSActiveLow");
   SPIJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   int32_t status = 0;
   HAL_SetSPIChipSelectActiveLow(static_cast<HAL_SPIPort>(port), &status);
@@ -263,7 +332,7 @@ Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetChipSelectActiveLow(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiInitAuto
   (JNIEnv *env, jclass, jint port, jint bufferSize) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiInitAuto";
+  JNI_TRACE("SPIJNI spiInitAuto");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   SPIJNI_LOG(logDEBUG) << "BufferSize = " << bufferSize;
   int32_t status = 0;
@@ -279,7 +348,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiInitAuto
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiFreeAuto
   (JNIEnv *env, jclass, jint port) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiFreeAuto";
+  JNI_TRACE("SPIJNI spiFreeAuto");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   int32_t status = 0;
   HAL_FreeSPIAuto(static_cast<HAL_SPIPort>(port), &status);
@@ -294,7 +363,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiFreeAuto
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiStartAutoRate
   (JNIEnv *env, jclass, jint port, jdouble period) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiStartAutoRate";
+  JNI_TRACE("SPIJNI spiStartAutoRate");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   SPIJNI_LOG(logDEBUG) << "Period = " << period;
   int32_t status = 0;
@@ -310,7 +379,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiStartAutoRate
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiStartAutoTrigger
   (JNIEnv *env, jclass, jint port, jint digitalSourceHandle, jint analogTriggerType, jboolean triggerRising, jboolean triggerFalling) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiStartAutoTrigger";
+  JNI_TRACE("SPIJNI spiStartAutoTrigger");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   SPIJNI_LOG(logDEBUG) << "DigitalSourceHandle = " << digitalSourceHandle;
   SPIJNI_LOG(logDEBUG) << "AnalogTriggerType = " << analogTriggerType;
@@ -331,7 +400,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiStartAutoTrigger
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiStopAuto
   (JNIEnv *env, jclass, jint port) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiStopAuto";
+  JNI_TRACE("SPIJNI spiStopAuto");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   int32_t status = 0;
   HAL_StopSPIAuto(static_cast<HAL_SPIPort>(port), &status);
@@ -346,7 +415,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiStopAuto
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetAutoTransmitData
   (JNIEnv *env, jclass, jint port, jbyteArray dataToSend, jint zeroSize) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiSetAutoTransmitData";
+  JNI_TRACE("SPIJNI spiSetAutoTransmitData");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   SPIJNI_LOG(logDEBUG) << "ZeroSize = " << zeroSize;
   JByteArrayRef jarr(env, dataToSend);
@@ -365,7 +434,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiSetAutoTransmitD
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiForceAutoRead
   (JNIEnv *env, jclass, jint port) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiForceAutoRead";
+  JNI_TRACE("SPIJNI spiForceAutoRead");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   int32_t status = 0;
   HAL_ForceSPIAutoRead(static_cast<HAL_SPIPort>(port), &status);
@@ -380,7 +449,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiForceAutoRead
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiReadAutoReceivedData__ILjava_nio_ByteBuffer_2ID
   (JNIEnv *env, jclass, jint port, jobject buffer, jint numToRead, jdouble timeout) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiReadAutoReceivedData";
+  JNI_TRACE("SPIJNI spiReadAutoReceivedData");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   SPIJNI_LOG(logDEBUG) << "NumToRead = " << numToRead;
   SPIJNI_LOG(logDEBUG) << "Timeout = " << timeout;
@@ -400,7 +469,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiReadAutoReceived
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiReadAutoReceivedData__I_3BID
   (JNIEnv *env, jclass, jint port, jbyteArray buffer, jint numToRead, jdouble timeout) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiReadAutoReceivedData";
+  JNI_TRACE("SPIJNI spiReadAutoReceivedData");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   SPIJNI_LOG(logDEBUG) << "NumToRead = " << numToRead;
   SPIJNI_LOG(logDEBUG) << "Timeout = " << timeout;
@@ -425,7 +494,7 @@ JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiReadAutoReceived
  */
 JNIEXPORT jint JNICALL Java_edu_wpi_first_wpilibj_hal_SPIJNI_spiGetAutoDroppedCount
   (JNIEnv *env, jclass, jint port) {
-  SPIJNI_LOG(logDEBUG) << "Calling SPIJNI spiGetAutoDroppedCount";
+  JNI_TRACE("SPIJNI spiGetAutoDroppedCount");
   SPIJNI_LOG(logDEBUG) << "Port = " << port;
   int32_t status = 0;
   auto retval = HAL_GetSPIAutoDroppedCount(static_cast<HAL_SPIPort>(port), &status);
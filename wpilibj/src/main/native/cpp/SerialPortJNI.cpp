@@ -21,11 +21,7 @@ using namespace wpi::java;
 // set the logging level
 TLogLevel serialJNILogLevel = logWARNING;
 
-#define SERIALJNI_LOG(level)     \
-  if (level > serialJNILogLevel) \
-    ;                            \
-  else                           \
-  Log().Get(level)
+#define SERIALJNI_LOG(level) JNI_LOG(serialJNILogLevel, level)
 
 extern "C" {
 
@@ -37,7 +33,7 @@ extern "C" {
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_SerialPortJNI_serialInitializePort(
     JNIEnv* env, jclass, jbyte port) {
-  SERIALJNI_LOG(logDEBUG) << "Calling Serial Initialize";
+  JNI_TRACE("Serial Initialize");
   SERIALJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   int32_t status = 0;
   HAL_InitializeSerialPort(static_cast<HAL_SerialPort>(port), &status);
@@ -53,7 +49,7 @@ Java_edu_wpi_first_wpilibj_hal_SerialPortJNI_serialInitializePort(
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_SerialPortJNI_serialInitializePortDirect(
     JNIEnv* env, jclass, jbyte port, jstring portName) {
-  SERIALJNI_LOG(logDEBUG) << "Calling Serial Initialize Direct";
+  JNI_TRACE("Serial Initialize Direct");
   SERIALJNI_LOG(logDEBUG) << "Port = " << (jint)port;
   JStringRef portNameRef{env, portName};
   SERIALJNI_LOG(logDEBUG) << "PortName = " << portNameRef.c_str();
@@ -19,11 +19,7 @@ using namespace frc;
 
 TLogLevel solenoidJNILogLevel = logERROR;
 
-#define SOLENOIDJNI_LOG(level)     \
-  if (level > solenoidJNILogLevel) \
-    ;                              \
-  else                             \
-  Log().Get(level)
+#define SOLENOIDJNI_LOG(level) JNI_LOG(solenoidJNILogLevel, level)
 
 extern "C" {
 
@@ -35,7 +31,7 @@ extern "C" {
 JNIEXPORT jint JNICALL
 Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_initializeSolenoidPort(
     JNIEnv *env, jclass, jint id) {
-  SOLENOIDJNI_LOG(logDEBUG) << "Calling SolenoidJNI initializeSolenoidPort";
+  JNI_TRACE("SolenoidJNI initializeSolenoidPort");
 
   SOLENOIDJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_PortHandle)id;
 
@@ -59,7 +55,7 @@ Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_initializeSolenoidPort(
 */
 JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_checkSolenoidChannel(
     JNIEnv *env, jclass, jint channel) {
-  SOLENOIDJNI_LOG(logDEBUG) << "Calling SolenoidJNI checkSolenoidChannel";
+  JNI_TRACE("SolenoidJNI checkSolenoidChannel");
   SOLENOIDJNI_LOG(logDEBUG) << "Channel = " << channel;
   return HAL_CheckSolenoidChannel(channel);
 }
@@ -71,7 +67,7 @@ JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_checkSolen
 */
 JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_checkSolenoidModule(
     JNIEnv *env, jclass, jint module) {
-  SOLENOIDJNI_LOG(logDEBUG) << "Calling SolenoidJNI checkSolenoidModule";
+  JNI_TRACE("SolenoidJNI checkSolenoidModule");
   SOLENOIDJNI_LOG(logDEBUG) << "Module = " << module;
   return HAL_CheckSolenoidModule(module);
 }
@@ -84,7 +80,7 @@ JNIEXPORT jboolean JNICALL Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_checkSolen
 JNIEXPORT void JNICALL
 Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_freeSolenoidPort(
     JNIEnv *env, jclass, jint id) {
-  SOLENOIDJNI_LOG(logDEBUG) << "Calling SolenoidJNI initializeSolenoidPort";
+  JNI_TRACE("SolenoidJNI initializeSolenoidPort");
 
   SOLENOIDJNI_LOG(logDEBUG) << "Port Handle = " << (HAL_SolenoidHandle)id;
   HAL_FreeSolenoidPort((HAL_SolenoidHandle)id);
@@ -97,7 +93,7 @@ Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_freeSolenoidPort(
  */
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_setSolenoid(
     JNIEnv *env, jclass, jint solenoid_port, jboolean value) {
-  SOLENOIDJNI_LOG(logDEBUG) << "Calling SolenoidJNI SetSolenoid";
+  JNI_TRACE("SolenoidJNI SetSolenoid");
 
   SOLENOIDJNI_LOG(logDEBUG) << "Solenoid Port Handle = "
                             << (HAL_SolenoidHandle)solenoid_port;
@@ -195,7 +191,7 @@ Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_clearAllPCMStickyFaults(
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_setOneShotDuration
   (JNIEnv *env, jclass, jint solenoid_port, jlong durationMS)
 {
-  SOLENOIDJNI_LOG(logDEBUG) << "Calling SolenoidJNI SetOneShotDuration";
+  JNI_TRACE("SolenoidJNI SetOneShotDuration");
 
   SOLENOIDJNI_LOG(logDEBUG) << "Solenoid Port Handle = "
                             << (HAL_SolenoidHandle)solenoid_port;
@@ -214,7 +210,7 @@ JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_setOneShotDura
 JNIEXPORT void JNICALL Java_edu_wpi_first_wpilibj_hal_SolenoidJNI_fireOneShot
   (JNIEnv *env, jclass, jint solenoid_port)
 {
-  SOLENOIDJNI_LOG(logDEBUG) << "Calling SolenoidJNI fireOneShot";
+  JNI_TRACE("SolenoidJNI fireOneShot");
 
   SOLENOIDJNI_LOG(logDEBUG) << "Solenoid Port Handle = "
                             << (HAL_SolenoidHandle)solenoid_port;
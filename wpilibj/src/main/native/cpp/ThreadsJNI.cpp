@@ -19,11 +19,7 @@ using namespace frc;
 // set the logging level
 TLogLevel threadsJNILogLevel = logWARNING;
 
-#define THREADSJNI_LOG(level)     \
-  if (level > threadsJNILogLevel) \
-    ;                            \
-  else                           \
-  Log().Get(level)
+#define THREADSJNI_LOG(level) JNI_LOG(threadsJNILogLevel, level)
 
 extern "C" {
 /*